@@ -4,7 +4,13 @@
 
 #include "keplar_app.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono> 
+#include <cstdlib>
+#include <future>
+#include <string_view>
+#include <thread>
 
 #include "keplar_config.hpp"
 #include "platform/platform.hpp"
@@ -12,14 +18,117 @@
 #include "vulkan/vulkan_context.hpp"
 #include "vulkan/vulkan_utils.hpp"
 #include "graphics/renderer.hpp"
+#include "utils/allocation_tracker.hpp"
+#include "utils/asset_pack.hpp"
+#include "utils/cpu_topology.hpp"
+#include "utils/frame_arena.hpp"
 #include "utils/logger.hpp"
+#include "utils/profiler.hpp"
+#include "utils/startup_timer.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace 
+{
+    // frames of a benchmark run when --benchmark is given without a count
+    constexpr uint32_t kDefaultBenchmarkFrames = 1000;
+
+    // the message pump of a threaded run wakes at least this often to notice the end of the render thread
+    constexpr uint32_t kEventWaitTimeoutMs = 5;
+
+    // on-demand runs: an idle message pump wakes at least this often, an idle render thread (which has no messages to
+    // wait on) polls its deferred events this often
+    constexpr uint32_t kIdleWaitTimeoutMs = 250;
+    constexpr uint32_t kIdlePollMs = 2;
+}
 
 namespace keplar
 {
+    KeplarAppOptions KeplarAppOptions::fromCommandLine(int argc, char* argv[]) noexcept
+    {
+        KeplarAppOptions options{};
+        options.mBenchmarkOutput = config::kCacheDir / "benchmark.json";
+
+        bool isWindowed = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            if (arg == "--headless")
+            {
+                options.mHeadless = true;
+            }
+            else if (arg == "--windowed")
+            {
+                isWindowed = true;
+            }
+            else if (arg == "--benchmark")
+            {
+                // optional frame count
+                options.mBenchmarkFrames = kDefaultBenchmarkFrames;
+                if (i + 1 < argc && argv[i + 1][0] != '-')
+                {
+                    const long frames = std::strtol(argv[++i], nullptr, 10);
+                    options.mBenchmarkFrames = (frames > 0) ? static_cast<uint32_t>(frames) : kDefaultBenchmarkFrames;
+                }
+            }
+            else if (arg == "--benchmark-output" && i + 1 < argc)
+            {
+                options.mBenchmarkOutput = argv[++i];
+            }
+            else if (arg == "--render-thread")
+            {
+                options.mRenderThread = true;
+            }
+            else if (arg == "--pipelined")
+            {
+                options.mPipelined = true;
+            }
+            else if (arg == "--on-demand")
+            {
+                options.mOnDemand = true;
+            }
+            else if (arg == "--assert-zero-alloc")
+            {
+                options.mAssertZeroAlloc = true;
+            }
+            else if (arg == "--record-input" && i + 1 < argc)
+            {
+                options.mRecordInput = argv[++i];
+            }
+            else if (arg == "--replay-input" && i + 1 < argc)
+            {
+                options.mReplayInput = argv[++i];
+            }
+            else if (arg == "--telemetry" && i + 1 < argc)
+            {
+                options.mTelemetryChannel = argv[++i];
+            }
+            else
+            {
+                VK_LOG_WARN("KeplarAppOptions::fromCommandLine : ignoring unknown argument '%s'", argv[i]);
+            }
+        }
+
+        // benchmarks target ci machines without a display unless asked to show the run
+        if (options.mBenchmarkFrames > 0 && !isWindowed)
+        {
+            options.mHeadless = true;
+        }
+
+        return options;
+    }
+
     KeplarApp::KeplarApp() noexcept
         : m_platform(nullptr)
         , m_vulkanContext(nullptr)
         , m_renderer(nullptr)
+        , m_simulationLag(0.0f)
+        , m_isFocused(true)
+        , m_hasDisplayRefresh(false)
+        , m_isRefreshFullscreen(false)
+        , m_refreshMonitor(nullptr)
+        , m_variableRefreshCap(0.0f)
+        , m_isIdle(false)
+        , m_steadyFrameCount(0)
     {
         // set frame rate
         m_framePacer.setTargetFps(keplar::config::kDefaultFrameRate);
@@ -30,8 +139,13 @@ namespace keplar
         shutdown();
     }
 
-    bool KeplarApp::initialize(std::unique_ptr<Renderer> renderer) noexcept
+    bool KeplarApp::initialize(std::unique_ptr<Renderer> renderer, const KeplarAppOptions& options) noexcept
     {
+        m_options = options;
+
+        // time to first frame is broken down from here to the first present (see StartupTimer)
+        StartupTimer::getInstance().begin();
+
         // acquire renderer
         m_renderer = std::move(renderer);
         if (!m_renderer) 
@@ -40,47 +154,469 @@ namespace keplar
             return false;
         }
 
+        // cpu trace of the whole run (debug builds only)
+        KEPLAR_PROFILE_BEGIN_SESSION(config::kCacheDir / "cpu_trace.json");
+
+        // assets resolve through the resource pack from here on, when there is one
+        if constexpr (!config::kShaderHotReload)
+        {
+            std::error_code errorCode;
+            if (std::filesystem::exists(config::kResourcePack, errorCode))
+            {
+                AssetPack::getInstance().open(config::kResourcePack);
+            }
+        }
+
+        // the renderer's file reads overlap window, instance and device creation; an early return still joins them
+        const auto preloadStart = std::chrono::steady_clock::now();
+        std::future<void> preload = std::async(std::launch::async, [this]()
+        {
+            KEPLAR_PROFILE_ZONE("Renderer::preload");
+            KEPLAR_STARTUP_PHASE("Renderer::preload");
+            m_renderer->preload();
+        });
+
         // high-level orchestration of subsystem creation
-        if (!initializePlatform())   { return false; }
-        if (!initializeContext())    { return false; }
-        if (!initializeRenderer())   { return false; }
+        if (!KEPLAR_STARTUP_STEP(initializePlatform()))         { return false; }
+        if (!KEPLAR_STARTUP_STEP(initializeContext()))          { return false; }
+
+        const auto preloadWait = std::chrono::steady_clock::now();
+        KEPLAR_STARTUP_STEP(preload.wait());
+        const auto preloadEnd = std::chrono::steady_clock::now();
+        VK_LOG_DEBUG("KeplarApp::initialize : preload overlapped %.2f ms of platform and context setup, waited %.2f ms",
+                     std::chrono::duration<double, std::milli>(preloadWait - preloadStart).count(),
+                     std::chrono::duration<double, std::milli>(preloadEnd - preloadWait).count());
+
+        if (!KEPLAR_STARTUP_STEP(initializeRenderer()))         { return false; }
+        if (!KEPLAR_STARTUP_STEP(initializeInputRecording()))   { return false; }
+
+        if (m_options.mAssertZeroAlloc && !AllocationTracker::isEnabled())
+        {
+            VK_LOG_WARN("KeplarApp::initialize : --assert-zero-alloc needs a KEPLAR_TRACK_ALLOCATIONS build, ignored");
+        }
 
+        StartupTimer::getInstance().markInitialized();
         VK_LOG_INFO("KeplarApp::initialize successful");
         return true;
     }
 
     int KeplarApp::run() noexcept
     {
-        while (!m_platform->shouldClose())
+        // benchmark runs play the renderer's scripted path unpaced and end on their own
+        const bool isBenchmark = m_options.mBenchmarkFrames > 0;
+        if (isBenchmark && !m_renderer->startBenchmark(m_options.mBenchmarkFrames, m_options.mBenchmarkOutput))
         {
+            VK_LOG_FATAL("KeplarApp::run : renderer does not support benchmark runs");
+            return EXIT_FAILURE;
+        }
+
+        // telemetry is for monitoring, a renderer without it runs anyway
+        if (!m_options.mTelemetryChannel.empty() && !m_renderer->startTelemetry(m_options.mTelemetryChannel))
+        {
+            VK_LOG_WARN("KeplarApp::run : renderer does not publish telemetry to '%s'", m_options.mTelemetryChannel.c_str());
+        }
+
+        if (m_options.mRenderThread)
+        {
+            return runRenderThread(isBenchmark);
+        }
+
+        if (m_options.mPipelined)
+        {
+            if (m_renderer->supportsPipelinedFrames())
+            {
+                return runPipelined(isBenchmark);
+            }
+            VK_LOG_WARN("KeplarApp::run : renderer does not support pipelined frames, running serially");
+        }
+
+        AllocationTracker::markFrameThread();
+        while (!m_platform->shouldClose() && !isRunComplete(isBenchmark))
+        {
+            KEPLAR_PROFILE_ZONE("KeplarApp::frame");
+
             // process platform events
-            m_platform->pollEvents();
+            {
+                KEPLAR_PROFILE_ZONE("Platform::pollEvents");
+                m_platform->pollEvents();
+            }
 
-            // update state and submit the current frame
-            m_renderer->update(m_time.tick());
-            if (!m_renderer->render()) 
-                return EXIT_FAILURE; 
-            
-            // frame pacing
-            m_framePacer.wait();
+            if (!applyPowerPolicy(isBenchmark) || !waitForRedraw(isBenchmark))
+                continue;
+
+            if (!runFrame(isBenchmark))
+                return EXIT_FAILURE;
         }
 
         return EXIT_SUCCESS;
     }
 
+    bool KeplarApp::runFrame(bool isBenchmark) noexcept
+    {
+        // scratch of the previous frame is dead by now; update state and submit the current frame
+        FrameArena::getThreadArena().reset();
+        updateSimulation(isBenchmark);
+        if (!m_renderer->render()) 
+            return false; 
+        reportStartup();
+
+        // benchmarks measure unpaced frames
+        if (!isBenchmark)
+        {
+            paceFrame();
+        }
+        checkAllocations();
+        return true;
+    }
+
+    void KeplarApp::reportStartup() noexcept
+    {
+        // the first presented frame ends startup
+        StartupTimer& startupTimer = StartupTimer::getInstance();
+        if (startupTimer.isRecording())
+        {
+            startupTimer.finish(config::kCacheDir / "startup_timings.json");
+        }
+    }
+
+    void KeplarApp::updateSimulation(bool isBenchmark) noexcept
+    {
+        // replays hand the recorded input to the listeners and simulate the recorded step; recordings store the input
+        // dispatched since the previous update along with this update's step
+        float frameTime = m_time.tick();
+        if (m_inputReplay)
+        {
+            if (m_inputReplay->nextFrame(m_replayFrame))
+            {
+                m_platform->replayInputFrame(m_replayFrame);
+                frameTime = m_replayFrame.mDeltaTime;
+            }
+        }
+        else if (m_inputRecorder)
+        {
+            m_inputRecorder->endFrame(frameTime);
+        }
+
+        // benchmarks step once per frame with the renderer's own fixed step
+        if (!config::kFixedTimestep || isBenchmark)
+        {
+            m_renderer->update(frameTime);
+            m_renderer->setInterpolation(1.0f);
+            return;
+        }
+
+        // consume the elapsed time in whole steps; a stall longer than the step budget is dropped, not caught up
+        constexpr float kStep = 1.0f / config::kSimulationRate;
+        m_simulationLag += frameTime;
+        uint32_t steps = 0;
+        while (m_simulationLag >= kStep && steps < config::kMaxSimulationSteps)
+        {
+            m_renderer->update(kStep);
+            m_simulationLag -= kStep;
+            ++steps;
+        }
+        m_simulationLag = std::min(m_simulationLag, kStep);
+
+        // the frame is rendered this far past the last step
+        m_renderer->setInterpolation(m_simulationLag / kStep);
+    }
+
+    void KeplarApp::paceFrame() noexcept
+    {
+        // frame pacing: aligned to present completion when the renderer supports it, otherwise on the cpu clock.
+        // background frames always pace on the clock, at the reduced rate, and so do variable refresh displays: their
+        // presents complete whenever a frame arrives, so only the clock's cap keeps frames inside the variable range
+        KEPLAR_PROFILE_ZONE("KeplarApp::pacing");
+        if (m_isFocused && !m_framePacer.isVariableRefresh() && m_renderer->waitForPresent())
+        {
+            m_framePacer.resetSchedule();
+        }
+        else
+        {
+            m_framePacer.wait();
+        }
+    }
+
+    bool KeplarApp::applyPowerPolicy(bool isBenchmark) noexcept
+    {
+        // benchmarks measure unthrottled frames
+        if (isBenchmark)
+        {
+            return true;
+        }
+
+        // minimized: nothing is visible and the surface has no extent. block until a message arrives instead of
+        // spinning on swapchain errors; the render thread has no message queue of its own and sleeps instead
+        if (m_platform->isWindowMinimized())
+        {
+            KEPLAR_PROFILE_ZONE("KeplarApp::minimized");
+            if (m_options.mRenderThread)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(config::kMinimizedWaitMs));
+            }
+            else
+            {
+                m_platform->waitEvents(config::kMinimizedWaitMs);
+            }
+            m_framePacer.resetSchedule();
+            return false;
+        }
+
+        // unfocused: keep the window live at a low rate so background instances leave the cpu and gpu to the foreground
+        const bool isRefreshChanged = updateDisplayRefresh();
+        const bool isFocused = m_platform->isWindowFocused();
+        if (isFocused != m_isFocused || isRefreshChanged)
+        {
+            m_isFocused = isFocused;
+            const bool isVariableRefresh = isFocused && m_variableRefreshCap > 0.0f;
+            m_framePacer.setVariableRefresh(isVariableRefresh);
+            m_framePacer.setTargetFps(isVariableRefresh ? m_variableRefreshCap : (isFocused ? config::kDefaultFrameRate : config::kBackgroundFrameRate));
+            VK_LOG_DEBUG("KeplarApp::applyPowerPolicy : window %s, pacing at %.0f fps%s", isFocused ? "focused" : "unfocused",
+                         m_framePacer.getFrameRate(), isVariableRefresh ? " (variable refresh)" : "");
+        }
+        return true;
+    }
+
+    bool KeplarApp::updateDisplayRefresh() noexcept
+    {
+        // the refresh changes with the monitor the window is on, and when going fullscreen switches the display mode
+        void* monitor = m_platform->getMonitorHandle();
+        const bool isFullscreen = m_platform->getFullscreenMode() != FullscreenMode::kWindowed;
+        if (m_hasDisplayRefresh && monitor == m_refreshMonitor && isFullscreen == m_isRefreshFullscreen)
+        {
+            return false;
+        }
+        m_hasDisplayRefresh   = true;
+        m_refreshMonitor      = monitor;
+        m_isRefreshFullscreen = isFullscreen;
+
+        const DisplayRefresh refresh = m_platform->getDisplayRefresh();
+        const float refreshCap = (config::kVariableRefreshPacing && refresh.mIsVariable) ? FramePacer::getVariableRefreshCap(refresh.mRefreshRate) : 0.0f;
+        if (refresh.mRefreshRate > 0.0f)
+        {
+            VK_LOG_INFO("KeplarApp::updateDisplayRefresh : %.0f hz display%s", refresh.mRefreshRate,
+                        (refreshCap > 0.0f) ? ", variable refresh, pacing below its maximum" : "");
+        }
+
+        if (refreshCap == m_variableRefreshCap)
+        {
+            return false;
+        }
+        m_variableRefreshCap = refreshCap;
+        return true;
+    }
+
+    bool KeplarApp::waitForRedraw(bool isBenchmark) noexcept
+    {
+        // replays run every frame: their input only reaches the renderer once the frame updates
+        if (!m_options.mOnDemand || isBenchmark || m_inputReplay || m_renderer->needsRedraw())
+        {
+            // resuming: the idle gap is not simulated
+            if (m_isIdle)
+            {
+                m_isIdle = false;
+                m_time.reset();
+                m_simulationLag = 0.0f;
+            }
+            return true;
+        }
+
+        // nothing changed since the last presented frame: it stays on screen while this thread blocks until the next
+        // os event, which the next iteration hands to the renderer
+        KEPLAR_PROFILE_ZONE("KeplarApp::idle");
+        if (m_options.mRenderThread)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kIdlePollMs));
+        }
+        else
+        {
+            m_platform->waitEvents(kIdleWaitTimeoutMs);
+        }
+        m_isIdle = true;
+        m_framePacer.resetSchedule();
+        return false;
+    }
+
+    bool KeplarApp::isRunComplete(bool isBenchmark) const noexcept
+    {
+        // benchmarks end with their scripted run, replays once the recording is exhausted
+        return (isBenchmark && m_renderer->isBenchmarkComplete()) || (m_inputReplay && m_inputReplay->isComplete());
+    }
+
+    void KeplarApp::checkAllocations() noexcept
+    {
+    #ifdef KEPLAR_TRACK_ALLOCATIONS
+        // frames leading into the steady state (and those following any change of it) may still allocate
+        const AllocationSample sample = AllocationTracker::sampleFrame();
+        if (!m_renderer->isSteadyState())
+        {
+            m_steadyFrameCount = 0;
+            return;
+        }
+        if (m_steadyFrameCount < config::kAllocationWarmupFrames)
+        {
+            ++m_steadyFrameCount;
+            return;
+        }
+
+        if (m_options.mAssertZeroAlloc && sample.mFrameThreadAllocations > 0)
+        {
+            VK_LOG_FATAL("KeplarApp::checkAllocations : steady state frame allocated %llu times on frame threads (%llu allocations, %llu bytes on all threads)",
+                         static_cast<unsigned long long>(sample.mFrameThreadAllocations), static_cast<unsigned long long>(sample.mAllocations),
+                         static_cast<unsigned long long>(sample.mBytes));
+            Logger::getInstance().flush();
+            std::abort();
+        }
+    #endif
+    }
+
+    int KeplarApp::runPipelined(bool isBenchmark) noexcept
+    {
+        // frame N is recorded and submitted on a worker while this thread updates frame N+1. the renderer only
+        // shares state between both at prepareFrame, which runs once frame N's job is done; listeners are invoked
+        // at the same point, so events are deferred to it
+        m_frameThreadPool = std::make_unique<ThreadPool>(1, 0, "frame");
+        m_platform->setDeferredEventDispatch(true);
+        AllocationTracker::markFrameThread();
+
+        bool isFailed = false;
+        TaskFuture<bool> submitted;
+        while (!m_platform->shouldClose() && !isRunComplete(isBenchmark))
+        {
+            KEPLAR_PROFILE_ZONE("KeplarApp::frame");
+            {
+                KEPLAR_PROFILE_ZONE("Platform::pollEvents");
+                m_platform->pollEvents();
+            }
+
+            // a minimized window submits nothing; the frame in flight is joined once rendering resumes
+            if (!applyPowerPolicy(isBenchmark))
+            {
+                continue;
+            }
+
+            // simulate the next frame while the previous one records, each on its own thread's arena
+            FrameArena::getThreadArena().reset();
+            updateSimulation(isBenchmark);
+
+            // join the previous frame before its state is touched again
+            if (submitted.isValid() && !submitted.get())
+            {
+                isFailed = true;
+                break;
+            }
+            m_platform->dispatchDeferredEvents();
+
+            // on-demand: the renderer sees this iteration's events only now; an idle one skips the frame and waits
+            if (!waitForRedraw(isBenchmark))
+            {
+                continue;
+            }
+
+            // pace on the previous frame's present, then capture this frame and hand it to the worker
+            if (!isBenchmark)
+            {
+                paceFrame();
+            }
+
+            if (!m_renderer->prepareFrame())
+            {
+                isFailed = true;
+                break;
+            }
+            submitted = m_frameThreadPool->dispatch(TaskPriority::kFrameCritical, [this]()
+            {
+                AllocationTracker::markFrameThread();
+                FrameArena::getThreadArena().reset();
+                const bool isSubmitted = m_renderer->submitFrame();
+                if (isSubmitted)
+                {
+                    reportStartup();
+                }
+                return isSubmitted;
+            });
+            checkAllocations();
+        }
+
+        // the last frame is finished before the renderer can be torn down
+        if (submitted.isValid() && !isFailed)
+        {
+            isFailed = !submitted.get();
+        }
+        m_frameThreadPool.reset();
+        m_platform->setDeferredEventDispatch(false);
+
+        return isFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    int KeplarApp::runRenderThread(bool isBenchmark) noexcept
+    {
+        // the main thread keeps pumping messages (modal resize and move loops included) while frames are produced on
+        // the render thread; events reach the listeners there, once per frame
+        m_platform->setDeferredEventDispatch(true);
+
+        std::atomic<bool> stopRequested(false);
+        std::atomic<bool> renderFinished(false);
+        std::atomic<bool> renderFailed(false);
+        std::thread renderThread([&]()
+        {
+            setCurrentThreadName("render");
+            AllocationTracker::markFrameThread();
+            while (!stopRequested.load(std::memory_order_acquire) && !isRunComplete(isBenchmark))
+            {
+                KEPLAR_PROFILE_ZONE("KeplarApp::frame");
+                m_platform->dispatchDeferredEvents();
+                if (!applyPowerPolicy(isBenchmark) || !waitForRedraw(isBenchmark))
+                {
+                    continue;
+                }
+
+                if (!runFrame(isBenchmark))
+                {
+                    renderFailed.store(true, std::memory_order_release);
+                    break;
+                }
+            }
+            renderFinished.store(true, std::memory_order_release);
+        });
+
+        while (!m_platform->shouldClose() && !renderFinished.load(std::memory_order_acquire))
+        {
+            KEPLAR_PROFILE_ZONE("Platform::pollEvents");
+            m_platform->pollEvents();
+            m_platform->waitEvents(kEventWaitTimeoutMs);
+        }
+
+        stopRequested.store(true, std::memory_order_release);
+        renderThread.join();
+        m_platform->setDeferredEventDispatch(false);
+
+        VK_LOG_INFO("KeplarApp::runRenderThread : render thread finished");
+        return renderFailed.load(std::memory_order_acquire) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
     void KeplarApp::shutdown() noexcept
     {
         // teardown subsystems in reverse order
+        if (m_inputRecorder)
+        {
+            m_platform->removeListener(m_inputRecorder);
+            m_inputRecorder->close();
+            m_inputRecorder.reset();
+        }
         m_platform->removeListener(m_renderer);
         m_renderer.reset();
         m_vulkanContext.reset();
         m_platform.reset();
+
+        // close the trace once nothing records into it
+        KEPLAR_PROFILE_END_SESSION();
     }
 
     bool KeplarApp::initializePlatform() noexcept
     {
         // create platform-specific implementation
-        m_platform = platform::createPlatform();
+        m_platform = platform::createPlatform(m_options.mHeadless);
         if (!m_platform)
         {
             VK_LOG_FATAL("Failed to create platform instance");
@@ -97,6 +633,38 @@ namespace keplar
         return true;
     }
 
+    bool KeplarApp::initializeInputRecording() noexcept
+    {
+        // a replay replaces the live input, so the two exclude each other
+        if (!m_options.mReplayInput.empty())
+        {
+            m_inputReplay = std::make_unique<InputReplay>();
+            if (!m_inputReplay->load(m_options.mReplayInput))
+            {
+                VK_LOG_FATAL("KeplarApp::initializeInputRecording : failed to load input recording %s", m_options.mReplayInput.string().c_str());
+                return false;
+            }
+            m_platform->setInputReplay(true);
+            if (!m_options.mRecordInput.empty())
+            {
+                VK_LOG_WARN("KeplarApp::initializeInputRecording : --record-input is ignored while replaying");
+            }
+            return true;
+        }
+
+        if (!m_options.mRecordInput.empty())
+        {
+            m_inputRecorder = std::make_shared<InputRecorder>();
+            if (!m_inputRecorder->open(m_options.mRecordInput))
+            {
+                VK_LOG_FATAL("KeplarApp::initializeInputRecording : failed to open %s", m_options.mRecordInput.string().c_str());
+                return false;
+            }
+            m_platform->addListener(m_inputRecorder);
+        }
+        return true;
+    }
+
     bool KeplarApp::initializeContext() noexcept
     {
         // prepare vulkan configuration
@@ -5,8 +5,13 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
+#include <string>
+#include <filesystem>
+
 #include "utils/time.hpp"
 #include "utils/frame_pacer.hpp"
+#include "platform/input_recording.hpp"
 
 namespace keplar
 {
@@ -14,6 +19,34 @@ namespace keplar
     class Platform;
     class VulkanContext;
     class Renderer;
+    class ThreadPool;
+
+    // run options, usually parsed from the command line:
+    //   --headless                 no window, render offscreen
+    //   --benchmark [frames]       scripted benchmark run (implies --headless unless --windowed is given)
+    //   --benchmark-output <path>  benchmark summary json (default: cache/benchmark.json)
+    //   --render-thread            update and render on a dedicated thread, the main thread only pumps messages
+    //   --pipelined                record and submit frame N on a worker while frame N+1 is updated (if supported)
+    //   --on-demand                render only frames the renderer reports a change for, block on os events otherwise
+    //   --assert-zero-alloc        abort once a steady state frame allocates on a frame thread (KEPLAR_TRACK_ALLOCATIONS builds)
+    //   --record-input <path>      write every frame's input and time step to a .kinput recording
+    //   --replay-input <path>      feed a recording's input and time steps instead of the live ones, exit at its end
+    //   --telemetry <channel>      publish live frame telemetry to a shared memory channel (tools/telemetry_reader)
+    struct KeplarAppOptions
+    {
+        bool                    mHeadless        = false;
+        bool                    mRenderThread    = false;
+        bool                    mPipelined       = false;
+        bool                    mOnDemand        = false;
+        bool                    mAssertZeroAlloc = false;
+        uint32_t                mBenchmarkFrames = 0;       // 0: interactive run
+        std::filesystem::path   mBenchmarkOutput;
+        std::filesystem::path   mRecordInput;
+        std::filesystem::path   mReplayInput;
+        std::string             mTelemetryChannel;          // empty: no telemetry
+
+        static KeplarAppOptions fromCommandLine(int argc, char* argv[]) noexcept;
+    };
 
     class KeplarApp final
     {
@@ -29,7 +62,7 @@ namespace keplar
             KeplarApp& operator=(KeplarApp&&) = delete;
 
             // app lifecycle functions
-            bool initialize(std::unique_ptr<Renderer> renderer) noexcept;
+            bool initialize(std::unique_ptr<Renderer> renderer, const KeplarAppOptions& options = {}) noexcept;
             int run() noexcept;
             void shutdown() noexcept;
 
@@ -38,12 +71,41 @@ namespace keplar
             bool initializePlatform() noexcept;
             bool initializeContext() noexcept;
             bool initializeRenderer() noexcept;
+            bool initializeInputRecording() noexcept;
+
+            // frame loop helpers
+            bool runFrame(bool isBenchmark) noexcept;
+            void reportStartup() noexcept;
+            void updateSimulation(bool isBenchmark) noexcept;
+            int runRenderThread(bool isBenchmark) noexcept;
+            int runPipelined(bool isBenchmark) noexcept;
+            void paceFrame() noexcept;
+            bool applyPowerPolicy(bool isBenchmark) noexcept;
+            bool updateDisplayRefresh() noexcept;
+            bool waitForRedraw(bool isBenchmark) noexcept;
+            bool isRunComplete(bool isBenchmark) const noexcept;
+            void checkAllocations() noexcept;
 
         private:
             std::shared_ptr<Platform>       m_platform;
             std::shared_ptr<VulkanContext>  m_vulkanContext;
             std::shared_ptr<Renderer>       m_renderer;
+            KeplarAppOptions                m_options;
             Time                            m_time;
+            float                           m_simulationLag;        // fixed-step: frame time not yet simulated
             FramePacer                      m_framePacer;
+            bool                            m_isFocused;            // last focus the pacer's target rate was set for
+            bool                            m_hasDisplayRefresh;    // the monitor's refresh was queried at least once
+            bool                            m_isRefreshFullscreen;  // fullscreen state and monitor it was queried for
+            void*                           m_refreshMonitor;
+            float                           m_variableRefreshCap;   // focused frame rate on a variable refresh display, 0 otherwise
+            bool                            m_isIdle;               // on-demand: the last loop iteration rendered nothing
+            uint32_t                        m_steadyFrameCount;     // consecutive steady state frames, for --assert-zero-alloc
+            std::unique_ptr<ThreadPool>     m_frameThreadPool;      // pipelined runs: records and submits frames
+
+            // --record-input and --replay-input: one frame record per simulation update
+            std::shared_ptr<InputRecorder>  m_inputRecorder;
+            std::unique_ptr<InputReplay>    m_inputReplay;
+            InputFrame                      m_replayFrame;
     };
 }   // namespace keplar
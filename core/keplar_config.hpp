@@ -3,6 +3,7 @@
 // ────────────────────────────────────────────
 
 #pragma once
+#include <cstdint>
 #include <filesystem>
 
 namespace keplar::config 
@@ -13,7 +14,42 @@ namespace keplar::config
     inline constexpr bool kStartMaximized                  = true;
     inline constexpr float kDefaultFrameRate               = 360.0f;
 
+    // focused windows on a variable refresh display pace on the cpu clock at a cap just below the display's maximum
+    // refresh (see FramePacer::getVariableRefreshCap) instead of kDefaultFrameRate or present completion
+    inline constexpr bool kVariableRefreshPacing           = true;
+
+    // frames the cpu records ahead of the gpu. renderers size their per-frame rings (uniforms, descriptor sets, command
+    // buffers, sync objects) for a fixed number of frame slots and cycle through this many of them, however many
+    // images the driver gives the swapchain: queue depth, latency and memory stay the same across drivers
+    inline constexpr uint32_t kFramesInFlight              = 2;
+
+    // power policy of interactive runs: an unfocused window renders at kBackgroundFrameRate on the cpu clock, a
+    // minimized one renders nothing and blocks in the message pump, waking at least every kMinimizedWaitMs
+    inline constexpr float kBackgroundFrameRate            = 30.0f;
+    inline constexpr uint32_t kMinimizedWaitMs             = 100;
+
+    // --assert-zero-alloc: frames after kAllocationWarmupFrames consecutive steady state frames must not allocate
+    inline constexpr uint32_t kAllocationWarmupFrames      = 120;
+
+    // fixed-step simulation at kSimulationRate, rendered interpolated between the last two steps
+    // (false: update() receives the variable frame time). long stalls run at most kMaxSimulationSteps
+    inline constexpr bool kFixedTimestep                   = true;
+    inline constexpr float kSimulationRate                 = 120.0f;
+    inline constexpr uint32_t kMaxSimulationSteps          = 8;
+
+    // debug builds watch kShaderDir and rebuild the pipelines of a rewritten .spv in the background
+#ifndef NDEBUG
+    inline constexpr bool kShaderHotReload                 = true;
+#else
+    inline constexpr bool kShaderHotReload                 = false;
+#endif
+
     static inline const std::filesystem::path kShaderDir   = "resources/shaders/";
     static inline const std::filesystem::path kTextureDir  = "resources/textures/";
     static inline const std::filesystem::path kModelDir    = "resources/models/";
+    static inline const std::filesystem::path kCacheDir    = "cache/";
+
+    // release builds read models, textures and shaders from this pack when it exists (built by the pack_resources
+    // target), files it lacks stay loose; hot reloading builds always read the loose files
+    static inline const std::filesystem::path kResourcePack = "resources.kpak";
 } // namespace keplar::config
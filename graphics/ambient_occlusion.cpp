@@ -0,0 +1,534 @@
+// ────────────────────────────────────────────
+//  File: ambient_occlusion.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "ambient_occlusion.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // must match local_size_x/y of ao_depth.comp and ao.comp
+    constexpr uint32_t kWorkgroupSize = 8;
+
+    // descriptor bindings of every set (set: 0): source (sampled), destination (storage)
+    constexpr uint32_t kSourceBinding      = 0;
+    constexpr uint32_t kDestinationBinding = 1;
+
+    // view depth of pixels nothing was drawn into; ao.comp leaves them unoccluded
+    constexpr float kEmptyViewDepth = 1.0e6f;
+
+    // longest horizon search in half-resolution texels, however close the surface
+    constexpr float kMaxRadiusTexels = 64.0f;
+
+    // push constants: must match ao_depth.comp
+    struct DepthPushConstants
+    {
+        glm::uvec4 extents;     // xy: source region, zw: destination region
+        glm::vec4  params;      // x: projection[3][2], y: projection[2][2], z: 1 from the scene depth, w: empty view depth
+    };
+
+    // push constants: must match ao.comp
+    struct OcclusionPushConstants
+    {
+        glm::uvec4 extents;     // xy: half-resolution region, zw: rendered region
+        glm::vec4  projection;  // xy: 1 / projection[0][0], 1 / projection[1][1], z: last level, w: empty view depth
+        glm::vec4  params;      // x: radius, y: intensity, z: max radius in texels
+    };
+
+    VkExtent2D halfExtent(VkExtent2D extent) noexcept
+    {
+        return { std::max(1u, (extent.width + 1) / 2), std::max(1u, (extent.height + 1) / 2) };
+    }
+}
+
+namespace keplar
+{
+    AmbientOcclusion::AmbientOcclusion() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDepthSets{}
+        , m_vkOcclusionSet(VK_NULL_HANDLE)
+        , m_vkDepthView(VK_NULL_HANDLE)
+        , m_depthImage(VK_NULL_HANDLE)
+        , m_depthPyramidView(VK_NULL_HANDLE)
+        , m_depthLevelViews{}
+        , m_occlusionImage(VK_NULL_HANDLE)
+        , m_occlusionView(VK_NULL_HANDLE)
+        , m_extent{}
+        , m_halfExtent{}
+        , m_isInitialized(false)
+    {
+    }
+
+    AmbientOcclusion::~AmbientOcclusion()
+    {
+        destroy();
+    }
+
+    bool AmbientOcclusion::initialize(const VulkanDevice& device, const AmbientOcclusionShaders& shaders, VkExtent2D extent) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_extent = extent;
+        m_halfExtent = halfExtent(extent);
+
+        // every pyramid level must be at least one texel
+        if (std::min(m_halfExtent.width, m_halfExtent.height) < (1u << (kDepthLevelCount - 1)))
+        {
+            VK_LOG_ERROR("AmbientOcclusion::initialize :: %ux%u is too small for %u depth levels", extent.width, extent.height, kDepthLevelCount);
+            destroy();
+            return false;
+        }
+
+        // both images are written as storage images and read through a sampler
+        if (!device.isFormatSupported(kDepthFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) ||
+            !device.isFormatSupported(kOcclusionFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        {
+            VK_LOG_ERROR("AmbientOcclusion::initialize :: image formats not supported");
+            destroy();
+            return false;
+        }
+
+        // point sampling: the reduction fetches texels, the trace picks a level per step
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = static_cast<float>(kDepthLevelCount);
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createImages() || !createDescriptorResources(device) || !createPipelines(device, shaders))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("AmbientOcclusion::initialize successful (%ux%u)", m_halfExtent.width, m_halfExtent.height);
+        return true;
+    }
+
+    void AmbientOcclusion::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_depthPipeline.destroy();
+        m_occlusionPipeline.destroy();
+
+        // the sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDepthSets.fill(VK_NULL_HANDLE);
+        m_vkOcclusionSet = VK_NULL_HANDLE;
+
+        for (VkImageView& imageView : m_depthLevelViews)
+        {
+            if (imageView != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, imageView, nullptr);
+                imageView = VK_NULL_HANDLE;
+            }
+        }
+
+        for (VkImageView* imageView : { &m_vkDepthView, &m_depthPyramidView, &m_occlusionView })
+        {
+            if (*imageView != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, *imageView, nullptr);
+                *imageView = VK_NULL_HANDLE;
+            }
+        }
+
+        for (VkImage* image : { &m_depthImage, &m_occlusionImage })
+        {
+            if (*image != VK_NULL_HANDLE)
+            {
+                vkDestroyImage(m_vkDevice, *image, nullptr);
+                *image = VK_NULL_HANDLE;
+            }
+        }
+
+        if (m_memoryAllocator != nullptr)
+        {
+            m_memoryAllocator->free(m_depthAllocation);
+            m_memoryAllocator->free(m_occlusionAllocation);
+        }
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_extent = {};
+        m_halfExtent = {};
+        m_isInitialized = false;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("ambient occlusion destroyed successfully");
+    }
+
+    bool AmbientOcclusion::bindDepth(VkImage depthImage, VkFormat depthFormat) noexcept
+    {
+        if (m_vkOcclusionSet == VK_NULL_HANDLE || depthImage == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("AmbientOcclusion::bindDepth :: invalid depth image or pass not initialized");
+            return false;
+        }
+
+        // depth-only view: a sampled view of a depth-stencil image may name a single aspect
+        if (m_vkDepthView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkDepthView, nullptr);
+            m_vkDepthView = VK_NULL_HANDLE;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = depthImage;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = depthFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        const VkResult vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkDepthView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("AmbientOcclusion :: vkCreateImageView failed for depth : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDepthView = VK_NULL_HANDLE;
+            return false;
+        }
+
+        // level 0 reduces the depth, every further level its predecessor; the trace reads every level through one view
+        for (uint32_t level = 0; level < kDepthLevelCount; ++level)
+        {
+            if (level == 0)
+            {
+                writeSet(m_vkDepthSets[level], m_vkDepthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_depthLevelViews[level]);
+            }
+            else
+            {
+                writeSet(m_vkDepthSets[level], m_depthLevelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL, m_depthLevelViews[level]);
+            }
+        }
+        writeSet(m_vkOcclusionSet, m_depthPyramidView, VK_IMAGE_LAYOUT_GENERAL, m_occlusionView);
+        return true;
+    }
+
+    void AmbientOcclusion::record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const glm::mat4& projection,
+                                  const AmbientOcclusionSettings& settings, bool isEnabled) noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        // the consumer keeps both images bound in GENERAL from the first frame on, traced or not
+        if (!m_isInitialized)
+        {
+            std::array<VkImageMemoryBarrier, 2> imageBarriers{};
+            for (VkImageMemoryBarrier& imageBarrier : imageBarriers)
+            {
+                imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarrier.pNext                           = nullptr;
+                imageBarrier.srcAccessMask                   = 0;
+                imageBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+                imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+                imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                imageBarrier.subresourceRange.baseMipLevel   = 0;
+                imageBarrier.subresourceRange.baseArrayLayer = 0;
+                imageBarrier.subresourceRange.layerCount     = 1;
+            }
+            imageBarriers[0].image                       = m_depthImage;
+            imageBarriers[0].subresourceRange.levelCount = kDepthLevelCount;
+            imageBarriers[1].image                       = m_occlusionImage;
+            imageBarriers[1].subresourceRange.levelCount = 1;
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+            m_isInitialized = true;
+        }
+
+        if (!isEnabled)
+        {
+            return;
+        }
+
+        // the previous frame's consumer may still read both images (write-after-read)
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        // each level, and the trace after them, waits on what it reads
+        VkMemoryBarrier writeBarrier{};
+        writeBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        writeBarrier.pNext         = nullptr;
+        writeBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        writeBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        renderExtent = { std::clamp(renderExtent.width, 1u, m_extent.width), std::clamp(renderExtent.height, 1u, m_extent.height) };
+        const VkExtent2D traceExtent = halfExtent(renderExtent);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_depthPipeline.get());
+        VkExtent2D sourceExtent = renderExtent;
+        VkExtent2D levelExtent = traceExtent;
+        for (uint32_t level = 0; level < kDepthLevelCount; ++level)
+        {
+            DepthPushConstants pushConstants{};
+            pushConstants.extents = glm::uvec4(sourceExtent.width, sourceExtent.height, levelExtent.width, levelExtent.height);
+            pushConstants.params  = glm::vec4(projection[3][2], projection[2][2], level == 0 ? 1.0f : 0.0f, kEmptyViewDepth);
+
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_depthPipeline.getLayout(), 0, 1, &m_vkDepthSets[level], 0, nullptr);
+            vkCmdPushConstants(commandBuffer, m_depthPipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+            vkCmdDispatch(commandBuffer, (levelExtent.width + kWorkgroupSize - 1) / kWorkgroupSize, (levelExtent.height + kWorkgroupSize - 1) / kWorkgroupSize, 1);
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &writeBarrier, 0, nullptr, 0, nullptr);
+
+            sourceExtent = levelExtent;
+            levelExtent = halfExtent(levelExtent);
+        }
+
+        OcclusionPushConstants pushConstants{};
+        pushConstants.extents    = glm::uvec4(traceExtent.width, traceExtent.height, renderExtent.width, renderExtent.height);
+        pushConstants.projection = glm::vec4(1.0f / projection[0][0], 1.0f / projection[1][1], static_cast<float>(kDepthLevelCount - 1), kEmptyViewDepth);
+        pushConstants.params     = glm::vec4(std::max(settings.mRadius, 0.01f), std::max(settings.mIntensity, 0.0f), kMaxRadiusTexels, 0.0f);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_occlusionPipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_occlusionPipeline.getLayout(), 0, 1, &m_vkOcclusionSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_occlusionPipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (traceExtent.width + kWorkgroupSize - 1) / kWorkgroupSize, (traceExtent.height + kWorkgroupSize - 1) / kWorkgroupSize, 1);
+
+        // the visibility and depth level 0 are the consumer's next read
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &writeBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    bool AmbientOcclusion::createImages() noexcept
+    {
+        auto createImage = [this](VkFormat format, uint32_t levelCount, VkImage& image, VulkanAllocation& allocation) noexcept
+        {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.pNext         = nullptr;
+            imageInfo.flags         = 0;
+            imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+            imageInfo.format        = format;
+            imageInfo.extent        = { m_halfExtent.width, m_halfExtent.height, 1 };
+            imageInfo.mipLevels     = levelCount;
+            imageInfo.arrayLayers   = 1;
+            imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage         = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            const VkResult result = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &image);
+            if (result != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("AmbientOcclusion :: vkCreateImage failed : %s (code: %d)", string_VkResult(result), result);
+                image = VK_NULL_HANDLE;
+                return false;
+            }
+
+            if (!m_memoryAllocator->allocateImageMemory(image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, allocation, VulkanMemoryCategory::kAttachment))
+            {
+                VK_LOG_FATAL("AmbientOcclusion :: failed to allocate image memory");
+                return false;
+            }
+            return true;
+        };
+
+        auto createView = [this](VkImage image, VkFormat format, uint32_t baseLevel, uint32_t levelCount, VkImageView& imageView) noexcept
+        {
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.pNext                           = nullptr;
+            viewInfo.flags                           = 0;
+            viewInfo.image                           = image;
+            viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format                          = format;
+            viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                         VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+            viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.baseMipLevel   = baseLevel;
+            viewInfo.subresourceRange.levelCount     = levelCount;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount     = 1;
+
+            const VkResult result = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &imageView);
+            if (result != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("AmbientOcclusion :: vkCreateImageView failed : %s (code: %d)", string_VkResult(result), result);
+                imageView = VK_NULL_HANDLE;
+                return false;
+            }
+            return true;
+        };
+
+        if (!createImage(kDepthFormat, kDepthLevelCount, m_depthImage, m_depthAllocation) ||
+            !createImage(kOcclusionFormat, 1, m_occlusionImage, m_occlusionAllocation) ||
+            !createView(m_depthImage, kDepthFormat, 0, kDepthLevelCount, m_depthPyramidView) ||
+            !createView(m_occlusionImage, kOcclusionFormat, 0, 1, m_occlusionView))
+        {
+            return false;
+        }
+
+        for (uint32_t level = 0; level < kDepthLevelCount; ++level)
+        {
+            if (!createView(m_depthImage, kDepthFormat, level, 1, m_depthLevelViews[level]))
+            {
+                return false;
+            }
+        }
+
+        m_isInitialized = false;
+        return true;
+    }
+
+    bool AmbientOcclusion::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        // one layout for every set: the reductions and the trace each read one image and write another
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { kSourceBinding,      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kDestinationBinding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        m_vkSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        constexpr uint32_t kSetCount = kDepthLevelCount + 1;
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kSetCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, kSetCount }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = kSetCount;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("AmbientOcclusion :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        std::array<VkDescriptorSetLayout, kSetCount> setLayouts{};
+        setLayouts.fill(m_vkSetLayout);
+        std::array<VkDescriptorSet, kSetCount> sets{};
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = kSetCount;
+        allocateInfo.pSetLayouts        = setLayouts.data();
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, sets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("AmbientOcclusion :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        std::copy_n(sets.begin(), kDepthLevelCount, m_vkDepthSets.begin());
+        m_vkOcclusionSet = sets[kDepthLevelCount];
+        return true;
+    }
+
+    bool AmbientOcclusion::createPipelines(const VulkanDevice& device, const AmbientOcclusionShaders& shaders) noexcept
+    {
+        VulkanShader depthShader;
+        VulkanShader occlusionShader;
+        if (!depthShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mDepthFile) ||
+            !occlusionShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mOcclusionFile))
+        {
+            VK_LOG_ERROR("AmbientOcclusion :: compute shaders '%s' / '%s' unavailable", shaders.mDepthFile.c_str(), shaders.mOcclusionFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig depthConfig{};
+        depthConfig.mShaderStage          = depthShader.getShaderStageInfo();
+        depthConfig.mDescriptorSetLayouts = { m_vkSetLayout };
+        depthConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DepthPushConstants) } };
+
+        ComputePipelineConfig occlusionConfig{};
+        occlusionConfig.mShaderStage          = occlusionShader.getShaderStageInfo();
+        occlusionConfig.mDescriptorSetLayouts = { m_vkSetLayout };
+        occlusionConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(OcclusionPushConstants) } };
+
+        if (!m_depthPipeline.initialize(m_vkDevice, depthConfig, device.getPipelineCache().get()) ||
+            !m_occlusionPipeline.initialize(m_vkDevice, occlusionConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("AmbientOcclusion :: failed to create the compute pipelines");
+            return false;
+        }
+        return true;
+    }
+
+    void AmbientOcclusion::writeSet(VkDescriptorSet descriptorSet, VkImageView sourceView, VkImageLayout sourceLayout,
+                                    VkImageView destinationView) const noexcept
+    {
+        const VkDescriptorImageInfo sourceInfo{ m_vkSampler, sourceView, sourceLayout };
+        const VkDescriptorImageInfo destinationInfo{ VK_NULL_HANDLE, destinationView, VK_IMAGE_LAYOUT_GENERAL };
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        for (auto& write : writes)
+        {
+            write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext            = nullptr;
+            write.dstSet           = descriptorSet;
+            write.dstArrayElement  = 0;
+            write.descriptorCount  = 1;
+            write.pBufferInfo      = nullptr;
+            write.pTexelBufferView = nullptr;
+        }
+        writes[0].dstBinding     = kSourceBinding;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo     = &sourceInfo;
+        writes[1].dstBinding     = kDestinationBinding;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo     = &destinationInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+}   // namespace keplar
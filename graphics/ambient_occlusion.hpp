@@ -0,0 +1,108 @@
+// ────────────────────────────────────────────
+//  File: ambient_occlusion.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the two compute passes
+    struct AmbientOcclusionShaders
+    {
+        std::string mDepthFile;             // ao_depth.comp
+        std::string mOcclusionFile;         // ao.comp
+    };
+
+    // tunables, read every record
+    struct AmbientOcclusionSettings
+    {
+        float mRadius    = 0.75f;           // world distance the horizons are searched over
+        float mIntensity = 1.5f;            // exponent of the visibility
+    };
+
+    // screen-space ambient occlusion at half resolution. the scene depth is reduced into a short pyramid of linear view
+    // depth (level 0 half the depth extent, nearest of each 2x2 block) and ao.comp traces ground truth ambient
+    // occlusion over it into a half-resolution visibility image. nothing is upsampled here: the consumer reads both
+    // half-resolution images and weights the four texels around each pixel by their depth against the pixel's own
+    // (see deferred_lighting.comp), so the full-resolution pass never exists. both images stay in
+    // VK_IMAGE_LAYOUT_GENERAL and the pass synchronizes them itself, before and after its dispatches. needs reverse-z
+    // depth; runs over the rendered region only (see dynamic resolution)
+    class AmbientOcclusion final
+    {
+        public:
+            static constexpr VkFormat kDepthFormat      = VK_FORMAT_R32_SFLOAT;
+            static constexpr VkFormat kOcclusionFormat  = VK_FORMAT_R32_SFLOAT;  // r8 and r16f are extended storage formats
+            static constexpr uint32_t kDepthLevelCount  = 4;
+
+            // creation and destruction
+            AmbientOcclusion() noexcept;
+            ~AmbientOcclusion();
+
+            // disable copy and move semantics to enforce unique ownership
+            AmbientOcclusion(const AmbientOcclusion&) = delete;
+            AmbientOcclusion& operator=(const AmbientOcclusion&) = delete;
+            AmbientOcclusion(AmbientOcclusion&&) = delete;
+            AmbientOcclusion& operator=(AmbientOcclusion&&) = delete;
+
+            // usage: extent is the one of the scene depth; the images are half of it
+            bool initialize(const VulkanDevice& device, const AmbientOcclusionShaders& shaders, VkExtent2D extent) noexcept;
+            void destroy() noexcept;
+
+            // usage: the single-sampled scene depth, sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            bool bindDepth(VkImage depthImage, VkFormat depthFormat) noexcept;
+
+            // usage: outside render passes, once the depth is written. moves both images into GENERAL on its first call
+            // even when isEnabled is false, so a consumer may keep them bound; projection is the one the depth was
+            // rendered with
+            void record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const glm::mat4& projection, const AmbientOcclusionSettings& settings,
+                        bool isEnabled) noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_occlusionPipeline.isValid() && m_vkDepthView != VK_NULL_HANDLE; }
+            VkImageView getOcclusionView() const noexcept { return m_occlusionView; }
+            VkImageView getDepthView() const noexcept { return m_depthLevelViews[0]; }     // level 0, the occlusion's resolution
+            VkExtent2D getExtent() const noexcept { return m_halfExtent; }
+
+        private:
+            bool createImages() noexcept;
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipelines(const VulkanDevice& device, const AmbientOcclusionShaders& shaders) noexcept;
+            void writeSet(VkDescriptorSet descriptorSet, VkImageView sourceView, VkImageLayout sourceLayout, VkImageView destinationView) const noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                                        m_vkDevice;
+            VulkanMemoryAllocator*                          m_memoryAllocator;
+            VkSampler                                       m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout                           m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorPool                                m_vkDescriptorPool;
+            std::array<VkDescriptorSet, kDepthLevelCount>   m_vkDepthSets;          // level 0 reads the scene depth
+            VkDescriptorSet                                 m_vkOcclusionSet;
+            VulkanPipeline                                  m_depthPipeline;
+            VulkanPipeline                                  m_occlusionPipeline;
+            VkImageView                                     m_vkDepthView;          // depth aspect of the bound depth image
+
+            // half-resolution linear view depth pyramid and visibility
+            VkImage                                         m_depthImage;
+            VulkanAllocation                                m_depthAllocation;
+            VkImageView                                     m_depthPyramidView;
+            std::array<VkImageView, kDepthLevelCount>       m_depthLevelViews;
+            VkImage                                         m_occlusionImage;
+            VulkanAllocation                                m_occlusionAllocation;
+            VkImageView                                     m_occlusionView;
+            VkExtent2D                                      m_extent;
+            VkExtent2D                                      m_halfExtent;
+            bool                                            m_isInitialized;        // images moved into GENERAL
+    };
+}   // namespace keplar
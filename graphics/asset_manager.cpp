@@ -0,0 +1,266 @@
+// ────────────────────────────────────────────
+//  File: asset_manager.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "asset_manager.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include "model_cache.hpp"
+#include "core/keplar_config.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/logger.hpp"
+#include "utils/profiler.hpp"
+
+namespace
+{
+    // 64-bit fnv-1a over 8-byte words, then the tail bytes; tells contents apart, not collision resistant
+    uint64_t hashContents(const uint8_t* data, size_t size) noexcept
+    {
+        constexpr uint64_t kPrime = 0x100000001B3ull;
+        uint64_t hash = 0xCBF29CE484222325ull ^ static_cast<uint64_t>(size);
+        size_t offset = 0;
+        for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, data + offset, sizeof(uint64_t));
+            hash = (hash ^ word) * kPrime;
+        }
+        for (; offset < size; ++offset)
+        {
+            hash = (hash ^ data[offset]) * kPrime;
+        }
+        return hash;
+    }
+
+    std::string toHex(uint64_t value)
+    {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+}
+
+namespace keplar
+{
+    AssetManager::AssetManager() noexcept
+        : m_residentBytes(0)
+        , m_frame(0)
+        , m_hitCount(0)
+        , m_missCount(0)
+    {
+    }
+
+    AssetManager::~AssetManager()
+    {
+        destroy();
+    }
+
+    void AssetManager::initialize(const AssetManagerConfig& config) noexcept
+    {
+        destroy();
+        m_config = config;
+        VK_LOG_DEBUG("AssetManager::initialize successful (budget: %llu MiB)", static_cast<unsigned long long>(config.mMemoryBudget >> 20));
+    }
+
+    void AssetManager::destroy() noexcept
+    {
+        // models first: they hold handles to the shared textures
+        for (auto& [key, asset] : m_assets)
+        {
+            asset.mModel.reset();
+        }
+        m_assets.clear();
+        m_sourceHashes.clear();
+        m_residentBytes = 0;
+        m_frame = 0;
+        m_hitCount = 0;
+        m_missCount = 0;
+    }
+
+    std::shared_ptr<Texture> AssetManager::loadTexture(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::filesystem::path& filepath,
+                                                       VkFormat format, bool flipY, bool genMips) noexcept
+    {
+        // source, upload format and decode options
+        const std::string sourceKey = makeSourceKey(keplar::config::kTextureDir / filepath);
+        uint64_t hash = 0;
+        if (!getContentHash(sourceKey, hash))
+        {
+            VK_LOG_ERROR("AssetManager::loadTexture :: failed to read texture: %s", filepath.string().c_str());
+            return nullptr;
+        }
+
+        const uint32_t options = static_cast<uint32_t>(format) | (flipY ? 1u << 30 : 0u) | (genMips ? 1u << 31 : 0u);
+        const std::string key = "texture|" + sourceKey + "|" + std::to_string(options) + "|" + toHex(hash);
+        if (Asset* asset = findAsset(key))
+        {
+            return asset->mTexture;
+        }
+
+        KEPLAR_PROFILE_ZONE("AssetManager::loadTexture");
+        auto texture = std::make_shared<Texture>();
+        if (!texture->load(device, stagingBelt, sourceKey, format, flipY, genMips))
+        {
+            VK_LOG_ERROR("AssetManager::loadTexture :: failed to load texture: %s", filepath.string().c_str());
+            return nullptr;
+        }
+
+        Asset& asset = m_assets[key];
+        asset.mTexture = texture;
+        asset.mSize = texture->getMemorySize();
+        asset.mLastUsedFrame = m_frame;
+        m_residentBytes += asset.mSize;
+        ++m_missCount;
+        evict();
+        return texture;
+    }
+
+    std::shared_ptr<GLTFModel> AssetManager::loadModel(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filename,
+                                                       const GLTFLoadConfig& config) noexcept
+    {
+        // the hash covers the main file; external buffers and images of a .gltf are not tracked
+        uint64_t hash = 0;
+        if (!getContentHash(makeSourceKey(keplar::config::kModelDir / filename), hash))
+        {
+            VK_LOG_ERROR("AssetManager::loadModel :: failed to read model: %s", filename.c_str());
+            return nullptr;
+        }
+
+        const std::string key = "model|" + makeModelKey(filename, config) + "|" + toHex(hash);
+        if (Asset* asset = findAsset(key))
+        {
+            return asset->mModel;
+        }
+
+        // the model loads its own external images through the manager as well
+        KEPLAR_PROFILE_ZONE("AssetManager::loadModel");
+        GLTFLoadConfig modelConfig = config;
+        modelConfig.mAssetManager = this;
+        auto model = std::make_shared<GLTFModel>();
+        if (!model->load(device, stagingBelt, filename, modelConfig))
+        {
+            VK_LOG_ERROR("AssetManager::loadModel :: failed to load model: %s", filename.c_str());
+            return nullptr;
+        }
+
+        Asset& asset = m_assets[key];
+        asset.mModel = model;
+        asset.mSize = model->getMemorySize();
+        asset.mLastUsedFrame = m_frame;
+        m_residentBytes += asset.mSize;
+        ++m_missCount;
+        evict();
+        return model;
+    }
+
+    void AssetManager::update() noexcept
+    {
+        // handles alive this update keep their assets young
+        ++m_frame;
+        for (auto& [key, asset] : m_assets)
+        {
+            if (asset.isReferenced())
+            {
+                asset.mLastUsedFrame = m_frame;
+            }
+        }
+        evict();
+    }
+
+    std::string AssetManager::makeModelKey(const std::string& filename, const GLTFLoadConfig& config) noexcept
+    {
+        // options that change the loaded buffers or textures
+        const uint32_t options = (config.mOptimizeMeshes ? 1u : 0u) | (config.mUseBakedCache ? 2u : 0u) | (config.mStreamTextures ? 4u : 0u) |
+                                 (config.mGenerateLods ? 8u : 0u) | (config.mBuildMeshlets ? 16u : 0u) | (config.mMipGenerator ? 32u : 0u) |
+                                 (static_cast<uint32_t>(config.mMipFilter) << 8) | (static_cast<uint32_t>(config.mVertexFormat) << 12);
+        return makeSourceKey(keplar::config::kModelDir / filename) + "|" + std::to_string(options);
+    }
+
+    std::string AssetManager::makeSourceKey(const std::filesystem::path& filepath) noexcept
+    {
+        // the same file reached through different relative paths is one asset
+        std::error_code errorCode;
+        std::filesystem::path path = std::filesystem::weakly_canonical(filepath, errorCode);
+        if (errorCode)
+        {
+            path = std::filesystem::absolute(filepath, errorCode).lexically_normal();
+        }
+        return path.generic_string();
+    }
+
+    bool AssetManager::getContentHash(const std::string& sourceKey, uint64_t& hash) noexcept
+    {
+        // unchanged size and write time: the last hash still holds
+        ModelCacheKey stamp{};
+        if (!getModelCacheKey(sourceKey, stamp))
+        {
+            return false;
+        }
+
+        SourceHash& source = m_sourceHashes[sourceKey];
+        if (source.mHash != 0 && source.mSize == stamp.mSourceSize && source.mTime == stamp.mSourceTime)
+        {
+            hash = source.mHash;
+            return true;
+        }
+
+        MappedFile mappedFile;
+        if (!mappedFile.open(sourceKey))
+        {
+            m_sourceHashes.erase(sourceKey);
+            return false;
+        }
+
+        source.mSize = stamp.mSourceSize;
+        source.mTime = stamp.mSourceTime;
+        source.mHash = std::max<uint64_t>(hashContents(mappedFile.getData(), mappedFile.getSize()), 1);
+        hash = source.mHash;
+        return true;
+    }
+
+    AssetManager::Asset* AssetManager::findAsset(const std::string& key) noexcept
+    {
+        const auto found = m_assets.find(key);
+        if (found == m_assets.end())
+        {
+            return nullptr;
+        }
+
+        found->second.mLastUsedFrame = m_frame;
+        ++m_hitCount;
+        return &found->second;
+    }
+
+    void AssetManager::evict() noexcept
+    {
+        // least recently used first, among assets no handle holds and no frame in flight reads
+        while (m_residentBytes > m_config.mMemoryBudget)
+        {
+            auto victim = m_assets.end();
+            for (auto it = m_assets.begin(); it != m_assets.end(); ++it)
+            {
+                const Asset& asset = it->second;
+                if (asset.isReferenced() || m_frame - asset.mLastUsedFrame < m_config.mRetireFrames)
+                {
+                    continue;
+                }
+
+                if (victim == m_assets.end() || asset.mLastUsedFrame < victim->second.mLastUsedFrame)
+                {
+                    victim = it;
+                }
+            }
+
+            if (victim == m_assets.end())
+            {
+                return;
+            }
+
+            VK_LOG_DEBUG("AssetManager::evict :: evicted %s (%llu KiB)", victim->first.c_str(), static_cast<unsigned long long>(victim->second.mSize >> 10));
+            m_residentBytes -= victim->second.mSize;
+            m_assets.erase(victim);
+        }
+    }
+}   // namespace keplar
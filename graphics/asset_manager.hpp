@@ -0,0 +1,101 @@
+// ────────────────────────────────────────────
+//  File: asset_manager.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+
+#include "texture.hpp"
+#include "gltf_model.hpp"
+
+namespace keplar
+{
+    // asset cache limits
+    struct AssetManagerConfig
+    {
+        VkDeviceSize mMemoryBudget = 1ull << 30;                            // device memory the cache may keep resident
+        uint32_t     mRetireFrames = 2 * (GLTFModel::kMaxFramesInFlight + 1); // updates an asset stays after its last handle went
+    };
+
+    // shared textures and models, each loaded once per source and options. assets are keyed by their canonical path,
+    // the load options that change their data and a hash of the source's contents (rehashed only when its size or write
+    // time changes), so a rewritten file loads anew and other paths to the same file share one asset. handles are shared
+    // pointers; an asset none is left for stays cached and is evicted least recently used first while the cache is over
+    // budget, once mRetireFrames updates passed so no frame in flight still reads it. models loaded through the manager
+    // with GLTFLoadConfig::mAssetManager set share their external image files with each other and with loadTexture.
+    // not thread-safe: use it from the thread recording uploads
+    class AssetManager final
+    {
+        public:
+            // creation and destruction
+            AssetManager() noexcept;
+            ~AssetManager();
+
+            // disable copy and move semantics to enforce unique ownership
+            AssetManager(const AssetManager&) = delete;
+            AssetManager& operator=(const AssetManager&) = delete;
+            AssetManager(AssetManager&&) = delete;
+            AssetManager& operator=(AssetManager&&) = delete;
+
+            // usage: destroy drops every cached asset at once (handles still held keep theirs), so only with the device idle
+            void initialize(const AssetManagerConfig& config = {}) noexcept;
+            void destroy() noexcept;
+
+            // usage: null when loading fails. paths as for Texture::load (texture directory) and GLTFModel::load (model directory);
+            // uploads are recorded into the belt, and a model's are flushed by its load
+            std::shared_ptr<Texture> loadTexture(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::filesystem::path& filepath,
+                                                 VkFormat format, bool flipY = false, bool genMips = true) noexcept;
+            std::shared_ptr<GLTFModel> loadModel(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filename,
+                                                 const GLTFLoadConfig& config = {}) noexcept;
+
+            // per frame: ages unreferenced assets and evicts them while over budget
+            void update() noexcept;
+
+            // canonical path and option bits of a model load; equal keys load equal data from an unchanged file
+            static std::string makeModelKey(const std::string& filename, const GLTFLoadConfig& config) noexcept;
+
+            // accessors
+            size_t getAssetCount() const noexcept           { return m_assets.size(); }
+            VkDeviceSize getResidentBytes() const noexcept  { return m_residentBytes; }
+            VkDeviceSize getMemoryBudget() const noexcept   { return m_config.mMemoryBudget; }
+            uint64_t getHitCount() const noexcept           { return m_hitCount; }
+            uint64_t getMissCount() const noexcept          { return m_missCount; }
+
+        private:
+            struct Asset
+            {
+                std::shared_ptr<Texture>    mTexture;
+                std::shared_ptr<GLTFModel>  mModel;
+                VkDeviceSize                mSize = 0;
+                uint64_t                    mLastUsedFrame = 0;     // last update a handle outside the cache was alive
+
+                bool isReferenced() const noexcept { return (mTexture ? mTexture.use_count() : mModel.use_count()) > 1; }
+            };
+
+            // contents hash of a source, valid while its size and write time are unchanged
+            struct SourceHash
+            {
+                uint64_t mSize = 0;
+                int64_t  mTime = 0;
+                uint64_t mHash = 0;
+            };
+
+            static std::string makeSourceKey(const std::filesystem::path& filepath) noexcept;
+            bool getContentHash(const std::string& sourceKey, uint64_t& hash) noexcept;
+            Asset* findAsset(const std::string& key) noexcept;
+            void evict() noexcept;
+
+        private:
+            AssetManagerConfig                              m_config;
+            std::unordered_map<std::string, Asset>          m_assets;
+            std::unordered_map<std::string, SourceHash>     m_sourceHashes;
+            VkDeviceSize                                    m_residentBytes;
+            uint64_t                                        m_frame;
+            uint64_t                                        m_hitCount;
+            uint64_t                                        m_missCount;
+    };
+}   // namespace keplar
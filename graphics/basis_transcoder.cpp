@@ -0,0 +1,135 @@
+// ────────────────────────────────────────────
+//  File: basis_transcoder.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "basis_transcoder.hpp"
+
+#include <mutex>
+#include <cstring>
+#include <algorithm>
+
+#ifdef KEPLAR_HAS_BASISU
+    #include <basisu_transcoder.h>
+#endif
+
+#include "texture.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // ktx2 identifier and the offset of the vkFormat field that follows it
+    constexpr uint8_t kKTX2Identifier[12]  = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+    constexpr size_t  kKTX2VkFormatOffset  = sizeof(kKTX2Identifier);
+}
+
+namespace keplar::basis_transcoder
+{
+    bool isAvailable() noexcept
+    {
+    #ifdef KEPLAR_HAS_BASISU
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    bool isTranscodable(const uint8_t* data, size_t size) noexcept
+    {
+        // basis payloads are stored with an undefined vulkan format
+        if (data == nullptr || size < kKTX2VkFormatOffset + sizeof(uint32_t) || std::memcmp(data, kKTX2Identifier, sizeof(kKTX2Identifier)) != 0)
+        {
+            return false;
+        }
+
+        uint32_t vkFormat = 0;
+        std::memcpy(&vkFormat, data + kKTX2VkFormatOffset, sizeof(vkFormat));
+        return vkFormat == VK_FORMAT_UNDEFINED;
+    }
+
+    bool transcodeKTX2(const uint8_t* data, size_t size, VkFormat targetFormat, const std::string& name, TextureData& textureData) noexcept
+    {
+    #ifdef KEPLAR_HAS_BASISU
+        // global selector tables are built once, before the first transcode on any thread
+        static std::once_flag s_initFlag;
+        std::call_once(s_initFlag, []() { basist::basisu_transcoder_init(); });
+
+        // map the device format chosen by the caller onto a transcoder target
+        basist::transcoder_texture_format transcodeFormat = basist::transcoder_texture_format::cTFRGBA32;
+        uint32_t channels = 4;
+        switch (targetFormat)
+        {
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:          transcodeFormat = basist::transcoder_texture_format::cTFBC7_RGBA; break;
+            case VK_FORMAT_BC5_UNORM_BLOCK:         transcodeFormat = basist::transcoder_texture_format::cTFBC5_RG; channels = 2; break;
+            case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:     transcodeFormat = basist::transcoder_texture_format::cTFASTC_4x4_RGBA; break;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:           transcodeFormat = basist::transcoder_texture_format::cTFRGBA32; break;
+            default:
+                VK_LOG_ERROR("basis_transcoder::transcodeKTX2 :: unsupported target format %s: %s", string_VkFormat(targetFormat), name.c_str());
+                return false;
+        }
+
+        // one transcoder per call keeps worker threads independent
+        basist::ktx2_transcoder transcoder;
+        if (!transcoder.init(data, static_cast<uint32_t>(size)) || !transcoder.start_transcoding())
+        {
+            VK_LOG_ERROR("basis_transcoder::transcodeKTX2 :: invalid basis ktx2 data: %s", name.c_str());
+            return false;
+        }
+
+        if (transcoder.get_layers() > 1 || transcoder.get_faces() != 1)
+        {
+            VK_LOG_ERROR("basis_transcoder::transcodeKTX2 :: only single 2d images are supported: %s", name.c_str());
+            return false;
+        }
+
+        // lay out every level back to back, largest first
+        textureData = TextureData{};
+        textureData.mName = name;
+        const uint32_t levelCount = std::max(1u, transcoder.get_levels());
+        const bool isUncompressed = basist::basis_transcoder_format_is_uncompressed(transcodeFormat);
+        std::vector<uint32_t> levelUnits(levelCount);
+
+        VkDeviceSize totalSize = 0;
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            basist::ktx2_image_level_info levelInfo{};
+            if (!transcoder.get_image_level_info(levelInfo, level, 0, 0))
+            {
+                VK_LOG_ERROR("basis_transcoder::transcodeKTX2 :: failed to query level %u: %s", level, name.c_str());
+                return false;
+            }
+
+            // output buffers are sized in blocks for compressed targets and in pixels for rgba32
+            const VkExtent2D extent = { levelInfo.m_orig_width, levelInfo.m_orig_height };
+            levelUnits[level] = isUncompressed ? extent.width * extent.height : levelInfo.m_total_blocks;
+            textureData.mMipExtents.push_back(extent);
+            textureData.mMipOffsets.push_back(totalSize);
+            totalSize += Texture::getLevelSize(targetFormat, extent.width, extent.height, channels);
+        }
+
+        textureData.mPixels.resize(static_cast<size_t>(totalSize));
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            if (!transcoder.transcode_image_level(level, 0, 0, textureData.mPixels.data() + textureData.mMipOffsets[level], levelUnits[level], transcodeFormat))
+            {
+                VK_LOG_ERROR("basis_transcoder::transcodeKTX2 :: failed to transcode level %u: %s", level, name.c_str());
+                textureData = TextureData{};
+                return false;
+            }
+        }
+
+        textureData.mChannels = channels;
+        textureData.mFormat   = targetFormat;
+        return true;
+    #else
+        (void)data;
+        (void)size;
+        (void)targetFormat;
+        (void)textureData;
+        VK_LOG_ERROR("basis_transcoder::transcodeKTX2 :: built without the basis universal transcoder: %s", name.c_str());
+        return false;
+    #endif
+    }
+}   // namespace keplar::basis_transcoder
@@ -0,0 +1,30 @@
+// ────────────────────────────────────────────
+//  File: basis_transcoder.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    struct TextureData;
+}
+
+// basis universal (etc1s / uastc) ktx2 transcoding for KHR_texture_basisu. the transcoder is optional:
+// it is compiled in when the basis_universal sources are present in external/basisu (KEPLAR_HAS_BASISU)
+namespace keplar::basis_transcoder
+{
+    // true when the build links the transcoder
+    bool isAvailable() noexcept;
+
+    // true for ktx2 data that must be transcoded (BasisLZ/etc1s or uastc payload, with or without zstd)
+    bool isTranscodable(const uint8_t* data, size_t size) noexcept;
+
+    // transcode every mip level of a ktx2 image into targetFormat; supported targets are BC7, BC5,
+    // ASTC 4x4 and R8G8B8A8 (srgb or unorm). safe to call from worker threads
+    bool transcodeKTX2(const uint8_t* data, size_t size, VkFormat targetFormat, const std::string& name, TextureData& textureData) noexcept;
+}   // namespace keplar::basis_transcoder
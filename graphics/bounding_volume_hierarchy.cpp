@@ -0,0 +1,538 @@
+// ────────────────────────────────────────────
+//  File: bounding_volume_hierarchy.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "bounding_volume_hierarchy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "utils/thread_pool.hpp"
+
+namespace
+{
+    // leaves grow by this share of their largest side, so small motion stays inside the stored bounds
+    constexpr float kFatMargin = 0.1f;
+
+    // subtrees with at least this many leaves are built as separate tasks
+    constexpr uint32_t kParallelLeafCount = 1024;
+
+    constexpr uint32_t kAllPlanes = (1u << keplar::Frustum::kPlaneCount) - 1;
+
+    // half the surface area, the cost measure of the insertion descent
+    float getArea(const keplar::BoundingBox& box) noexcept
+    {
+        const glm::vec3 size = box.mMax - box.mMin;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    keplar::BoundingBox getUnion(const keplar::BoundingBox& a, const keplar::BoundingBox& b) noexcept
+    {
+        keplar::BoundingBox box = a;
+        box.expand(b);
+        return box;
+    }
+
+    bool contains(const keplar::BoundingBox& outer, const keplar::BoundingBox& inner) noexcept
+    {
+        return glm::all(glm::lessThanEqual(outer.mMin, inner.mMin)) && glm::all(glm::lessThanEqual(inner.mMax, outer.mMax));
+    }
+
+    bool overlaps(const keplar::BoundingBox& a, const keplar::BoundingBox& b) noexcept
+    {
+        return glm::all(glm::lessThanEqual(a.mMin, b.mMax)) && glm::all(glm::lessThanEqual(b.mMin, a.mMax));
+    }
+
+    keplar::BoundingBox fatten(const keplar::BoundingBox& box) noexcept
+    {
+        const glm::vec3 size = box.mMax - box.mMin;
+        const float margin = kFatMargin * std::max(size.x, std::max(size.y, size.z));
+        keplar::BoundingBox fat;
+        fat.mMin = box.mMin - glm::vec3(margin);
+        fat.mMax = box.mMax + glm::vec3(margin);
+        return fat;
+    }
+
+    // planes of mask the box is not fully inside of, or ~0u when it lies fully outside one
+    uint32_t classify(const keplar::Frustum& frustum, const keplar::BoundingBox& box, uint32_t mask) noexcept
+    {
+        const glm::vec3 center = box.getCenter();
+        const glm::vec3 extent = box.getExtent();
+        for (uint32_t i = 0; i < keplar::Frustum::kPlaneCount; ++i)
+        {
+            if ((mask & (1u << i)) == 0)
+            {
+                continue;
+            }
+
+            const glm::vec4& plane = frustum.mPlanes[i];
+            const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            const float radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+            if (distance < -radius)
+            {
+                return ~0u;
+            }
+            if (distance >= radius)
+            {
+                mask &= ~(1u << i);
+            }
+        }
+        return mask;
+    }
+
+    // slab test: entry distance of the ray into the box, or a negative value when it misses within maxDistance
+    float intersectRay(const keplar::BoundingBox& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) noexcept
+    {
+        const glm::vec3 t0 = (box.mMin - origin) * inverseDirection;
+        const glm::vec3 t1 = (box.mMax - origin) * inverseDirection;
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+        const float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        return entry <= exit ? entry : -1.0f;
+    }
+}   // namespace
+
+namespace keplar
+{
+    BoundingVolumeHierarchy::BoundingVolumeHierarchy() noexcept
+        : m_root(kNullNode)
+        , m_leafCount(0)
+        , m_reinsertCount(0)
+    {
+    }
+
+    uint32_t BoundingVolumeHierarchy::insert(const BoundingBox& bounds, uint32_t userData) noexcept
+    {
+        if (!bounds.isValid())
+        {
+            return kInvalidProxy;
+        }
+
+        // reuse a removed leaf when there is one
+        uint32_t proxy = static_cast<uint32_t>(m_leaves.size());
+        if (!m_freeLeaves.empty())
+        {
+            proxy = m_freeLeaves.back();
+            m_freeLeaves.pop_back();
+        }
+        else
+        {
+            m_leaves.emplace_back();
+        }
+
+        Leaf& leaf = m_leaves[proxy];
+        leaf.mBounds = bounds;
+        leaf.mFatBounds = fatten(bounds);
+        leaf.mUserData = userData;
+        leaf.mIsLive = true;
+        insertLeaf(proxy);
+        ++m_leafCount;
+        return proxy;
+    }
+
+    void BoundingVolumeHierarchy::remove(uint32_t proxy) noexcept
+    {
+        if (proxy >= m_leaves.size() || !m_leaves[proxy].mIsLive)
+        {
+            return;
+        }
+
+        removeLeaf(proxy);
+        m_leaves[proxy] = Leaf{};
+        m_freeLeaves.push_back(proxy);
+        --m_leafCount;
+    }
+
+    void BoundingVolumeHierarchy::clear() noexcept
+    {
+        m_nodes.clear();
+        m_freeNodes.clear();
+        m_leaves.clear();
+        m_freeLeaves.clear();
+        m_root = kNullNode;
+        m_leafCount = 0;
+        m_reinsertCount = 0;
+    }
+
+    bool BoundingVolumeHierarchy::update(uint32_t proxy, const BoundingBox& bounds) noexcept
+    {
+        if (proxy >= m_leaves.size() || !m_leaves[proxy].mIsLive || !bounds.isValid())
+        {
+            return false;
+        }
+
+        // motion within the fattened bounds leaves the tree as is
+        Leaf& leaf = m_leaves[proxy];
+        leaf.mBounds = bounds;
+        if (contains(leaf.mFatBounds, bounds))
+        {
+            return false;
+        }
+
+        removeLeaf(proxy);
+        leaf.mFatBounds = fatten(bounds);
+        insertLeaf(proxy);
+        ++m_reinsertCount;
+        return true;
+    }
+
+    void BoundingVolumeHierarchy::rebuild(ThreadPool* threadPool) noexcept
+    {
+        std::vector<uint32_t> proxies;
+        proxies.reserve(m_leafCount);
+        for (uint32_t proxy = 0; proxy < m_leaves.size(); ++proxy)
+        {
+            if (m_leaves[proxy].mIsLive)
+            {
+                proxies.push_back(proxy);
+            }
+        }
+
+        // a subtree of n leaves takes n - 1 internal nodes, so every range knows where its nodes go up front
+        m_nodes.assign(proxies.size() > 1 ? proxies.size() - 1 : 0, Node{});
+        m_freeNodes.clear();
+        m_reinsertCount = 0;
+        if (proxies.empty())
+        {
+            m_root = kNullNode;
+            return;
+        }
+
+        if (threadPool != nullptr && proxies.size() >= kParallelLeafCount)
+        {
+            TaskGroup taskGroup(*threadPool);
+            m_root = buildRange(proxies.data(), static_cast<uint32_t>(proxies.size()), 0, kNullNode, &taskGroup);
+            taskGroup.wait();
+        }
+        else
+        {
+            m_root = buildRange(proxies.data(), static_cast<uint32_t>(proxies.size()), 0, kNullNode, nullptr);
+        }
+    }
+
+    uint32_t BoundingVolumeHierarchy::buildRange(uint32_t* proxies, uint32_t count, uint32_t nodeIndex, uint32_t parent, TaskGroup* taskGroup) noexcept
+    {
+        if (count == 1)
+        {
+            m_leaves[proxies[0]].mParent = parent;
+            return proxies[0] | kLeafBit;
+        }
+
+        // the node's bounds come from its leaves directly, so the children need no join before it is complete
+        Node& node = m_nodes[nodeIndex];
+        node.mParent = parent;
+        node.mBounds = BoundingBox{};
+        BoundingBox centers;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const BoundingBox& fatBounds = m_leaves[proxies[i]].mFatBounds;
+            node.mBounds.expand(fatBounds);
+            centers.expand(fatBounds.getCenter());
+        }
+
+        // median split along the axis the centers spread the most on
+        const glm::vec3 spread = centers.mMax - centers.mMin;
+        const int axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+        const uint32_t half = count / 2;
+        std::nth_element(proxies, proxies + half, proxies + count, [this, axis](uint32_t a, uint32_t b)
+        {
+            return m_leaves[a].mFatBounds.getCenter()[axis] < m_leaves[b].mFatBounds.getCenter()[axis];
+        });
+
+        // the left range's internal nodes follow this one, the right range's follow those
+        const uint32_t leftNode = nodeIndex + 1;
+        const uint32_t rightNode = nodeIndex + half;
+        if (taskGroup != nullptr && half >= kParallelLeafCount)
+        {
+            taskGroup->dispatch([this, proxies, half, leftNode, nodeIndex, taskGroup]()
+            {
+                m_nodes[nodeIndex].mChildren[0] = buildRange(proxies, half, leftNode, nodeIndex, taskGroup);
+            });
+        }
+        else
+        {
+            node.mChildren[0] = buildRange(proxies, half, leftNode, nodeIndex, taskGroup);
+        }
+        node.mChildren[1] = buildRange(proxies + half, count - half, rightNode, nodeIndex, taskGroup);
+        return nodeIndex;
+    }
+
+    void BoundingVolumeHierarchy::query(const Frustum& frustum, std::vector<uint32_t>& results) const noexcept
+    {
+        if (m_root == kNullNode)
+        {
+            return;
+        }
+
+        // each entry carries the planes its ancestors were not fully inside of
+        std::vector<std::pair<uint32_t, uint32_t>> stack;
+        stack.emplace_back(m_root, kAllPlanes);
+        while (!stack.empty())
+        {
+            const auto [reference, parentMask] = stack.back();
+            stack.pop_back();
+
+            if ((reference & kLeafBit) != 0)
+            {
+                const Leaf& leaf = m_leaves[reference & ~kLeafBit];
+                if (parentMask == 0 || classify(frustum, leaf.mBounds, parentMask) != ~0u)
+                {
+                    results.push_back(leaf.mUserData);
+                }
+                continue;
+            }
+
+            const Node& node = m_nodes[reference];
+            const uint32_t mask = parentMask == 0 ? 0 : classify(frustum, node.mBounds, parentMask);
+            if (mask != ~0u)
+            {
+                stack.emplace_back(node.mChildren[0], mask);
+                stack.emplace_back(node.mChildren[1], mask);
+            }
+        }
+    }
+
+    void BoundingVolumeHierarchy::query(const BoundingBox& bounds, std::vector<uint32_t>& results) const noexcept
+    {
+        if (m_root == kNullNode || !bounds.isValid())
+        {
+            return;
+        }
+
+        std::vector<uint32_t> stack;
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            const uint32_t reference = stack.back();
+            stack.pop_back();
+
+            if ((reference & kLeafBit) != 0)
+            {
+                const Leaf& leaf = m_leaves[reference & ~kLeafBit];
+                if (overlaps(leaf.mBounds, bounds))
+                {
+                    results.push_back(leaf.mUserData);
+                }
+                continue;
+            }
+
+            const Node& node = m_nodes[reference];
+            if (overlaps(node.mBounds, bounds))
+            {
+                stack.push_back(node.mChildren[0]);
+                stack.push_back(node.mChildren[1]);
+            }
+        }
+    }
+
+    bool BoundingVolumeHierarchy::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, uint32_t& userData,
+                                          float& distance) const noexcept
+    {
+        if (m_root == kNullNode)
+        {
+            return false;
+        }
+
+        // axes the ray runs parallel to get a huge but finite inverse, keeping the slab products free of nans
+        constexpr float kMinComponent = 1e-30f;
+        glm::vec3 inverseDirection;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            inverseDirection[axis] = 1.0f / (std::abs(direction[axis]) > kMinComponent ? direction[axis] : std::copysign(kMinComponent, direction[axis]));
+        }
+
+        // nearest first: a subtree entered beyond the closest hit so far is skipped
+        bool isHit = false;
+        float closest = maxDistance;
+        std::vector<std::pair<uint32_t, float>> stack;
+        stack.emplace_back(m_root, 0.0f);
+        while (!stack.empty())
+        {
+            const auto [reference, entry] = stack.back();
+            stack.pop_back();
+            if (entry > closest)
+            {
+                continue;
+            }
+
+            if ((reference & kLeafBit) != 0)
+            {
+                const Leaf& leaf = m_leaves[reference & ~kLeafBit];
+                const float hit = intersectRay(leaf.mBounds, origin, inverseDirection, closest);
+                if (hit >= 0.0f)
+                {
+                    isHit = true;
+                    closest = hit;
+                    userData = leaf.mUserData;
+                }
+                continue;
+            }
+
+            // the nearer child goes on top
+            const Node& node = m_nodes[reference];
+            std::array<std::pair<uint32_t, float>, 2> children{};
+            uint32_t childCount = 0;
+            for (uint32_t child : node.mChildren)
+            {
+                const float hit = intersectRay(getTreeBounds(child), origin, inverseDirection, closest);
+                if (hit >= 0.0f)
+                {
+                    children[childCount++] = { child, hit };
+                }
+            }
+            if (childCount == 2 && children[0].second < children[1].second)
+            {
+                std::swap(children[0], children[1]);
+            }
+            for (uint32_t i = 0; i < childCount; ++i)
+            {
+                stack.push_back(children[i]);
+            }
+        }
+
+        if (isHit)
+        {
+            distance = closest;
+        }
+        return isHit;
+    }
+
+    BoundingBox BoundingVolumeHierarchy::getRootBounds() const noexcept
+    {
+        return m_root == kNullNode ? BoundingBox{} : getTreeBounds(m_root);
+    }
+
+    const BoundingBox& BoundingVolumeHierarchy::getTreeBounds(uint32_t reference) const noexcept
+    {
+        return (reference & kLeafBit) != 0 ? m_leaves[reference & ~kLeafBit].mFatBounds : m_nodes[reference].mBounds;
+    }
+
+    void BoundingVolumeHierarchy::setParent(uint32_t reference, uint32_t parent) noexcept
+    {
+        if ((reference & kLeafBit) != 0)
+        {
+            m_leaves[reference & ~kLeafBit].mParent = parent;
+        }
+        else
+        {
+            m_nodes[reference].mParent = parent;
+        }
+    }
+
+    uint32_t BoundingVolumeHierarchy::allocateNode() noexcept
+    {
+        if (!m_freeNodes.empty())
+        {
+            const uint32_t node = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            return node;
+        }
+
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    void BoundingVolumeHierarchy::insertLeaf(uint32_t proxy) noexcept
+    {
+        const uint32_t leafReference = proxy | kLeafBit;
+        if (m_root == kNullNode)
+        {
+            m_leaves[proxy].mParent = kNullNode;
+            m_root = leafReference;
+            return;
+        }
+
+        // descend towards the sibling whose union with the leaf adds the least area: making the leaf a sibling here costs
+        // the combined area, descending costs the growth of this node plus that of the cheaper child
+        const BoundingBox& leafBounds = m_leaves[proxy].mFatBounds;
+        uint32_t sibling = m_root;
+        while ((sibling & kLeafBit) == 0)
+        {
+            const Node& node = m_nodes[sibling];
+            const float combinedArea = getArea(getUnion(node.mBounds, leafBounds));
+            const float siblingCost = 2.0f * combinedArea;
+            const float inheritedCost = 2.0f * (combinedArea - getArea(node.mBounds));
+
+            float childCosts[2];
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                const uint32_t child = node.mChildren[i];
+                const BoundingBox& childBounds = getTreeBounds(child);
+                const float unionArea = getArea(getUnion(childBounds, leafBounds));
+                childCosts[i] = ((child & kLeafBit) != 0 ? unionArea : unionArea - getArea(childBounds)) + inheritedCost;
+            }
+
+            if (siblingCost < childCosts[0] && siblingCost < childCosts[1])
+            {
+                break;
+            }
+            sibling = node.mChildren[childCosts[0] < childCosts[1] ? 0 : 1];
+        }
+
+        // a new parent takes the sibling's place and holds both
+        const uint32_t oldParent = (sibling & kLeafBit) != 0 ? m_leaves[sibling & ~kLeafBit].mParent : m_nodes[sibling].mParent;
+        const uint32_t newParent = allocateNode();
+        Node& node = m_nodes[newParent];
+        node.mParent = oldParent;
+        node.mChildren[0] = sibling;
+        node.mChildren[1] = leafReference;
+        node.mBounds = getUnion(getTreeBounds(sibling), leafBounds);
+        setParent(sibling, newParent);
+        m_leaves[proxy].mParent = newParent;
+
+        if (oldParent == kNullNode)
+        {
+            m_root = newParent;
+        }
+        else
+        {
+            Node& grandparent = m_nodes[oldParent];
+            grandparent.mChildren[grandparent.mChildren[0] == sibling ? 0 : 1] = newParent;
+            refit(oldParent);
+        }
+    }
+
+    void BoundingVolumeHierarchy::removeLeaf(uint32_t proxy) noexcept
+    {
+        const uint32_t leafReference = proxy | kLeafBit;
+        const uint32_t parent = m_leaves[proxy].mParent;
+        m_leaves[proxy].mParent = kNullNode;
+        if (parent == kNullNode)
+        {
+            m_root = kNullNode;
+            return;
+        }
+
+        // the sibling takes the parent's place
+        const Node& parentNode = m_nodes[parent];
+        const uint32_t sibling = parentNode.mChildren[parentNode.mChildren[0] == leafReference ? 1 : 0];
+        const uint32_t grandparent = parentNode.mParent;
+        setParent(sibling, grandparent);
+        if (grandparent == kNullNode)
+        {
+            m_root = sibling;
+        }
+        else
+        {
+            Node& grandparentNode = m_nodes[grandparent];
+            grandparentNode.mChildren[grandparentNode.mChildren[0] == parent ? 0 : 1] = sibling;
+            refit(grandparent);
+        }
+
+        m_nodes[parent] = Node{};
+        m_freeNodes.push_back(parent);
+    }
+
+    void BoundingVolumeHierarchy::refit(uint32_t node) noexcept
+    {
+        // ancestors up to the root enclose their children again
+        while (node != kNullNode)
+        {
+            Node& current = m_nodes[node];
+            current.mBounds = getUnion(getTreeBounds(current.mChildren[0]), getTreeBounds(current.mChildren[1]));
+            node = current.mParent;
+        }
+    }
+}   // namespace keplar
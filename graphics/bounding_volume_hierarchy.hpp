@@ -0,0 +1,108 @@
+// ────────────────────────────────────────────
+//  File: bounding_volume_hierarchy.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "math3d.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class ThreadPool;
+    class TaskGroup;
+
+    // dynamic aabb tree over caller bounds (instances, primitives), answering frustum, box and ray queries in logarithmic
+    // time. leaves are kept in the tree with fattened bounds, so an update that stays inside them only stores the new
+    // bounds; one that leaves them reinserts the leaf along the cheapest surface area path. reinsertion degrades the tree
+    // over time: rebuild() replaces it with a top-down median split build, with large subtrees built on a thread pool.
+    // proxies stay valid across rebuilds until removed. queries test the exact bounds at the leaves. not thread-safe
+    class BoundingVolumeHierarchy final
+    {
+        public:
+            static constexpr uint32_t kInvalidProxy = ~0u;
+
+            // creation and destruction
+            BoundingVolumeHierarchy() noexcept;
+            ~BoundingVolumeHierarchy() = default;
+
+            // disable copy semantics, trees are rebuilt rather than duplicated
+            BoundingVolumeHierarchy(const BoundingVolumeHierarchy&) = delete;
+            BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&) = delete;
+
+            // move semantics
+            BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) noexcept = default;
+            BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&&) noexcept = default;
+
+            // usage: bounds must be valid; userData is what queries report for the leaf
+            uint32_t insert(const BoundingBox& bounds, uint32_t userData) noexcept;
+            void remove(uint32_t proxy) noexcept;
+            void clear() noexcept;
+
+            // usage: true when the leaf left its fattened bounds and was reinserted
+            bool update(uint32_t proxy, const BoundingBox& bounds) noexcept;
+
+            // usage: rebuilds the tree from its leaves. with a pool, subtrees of many leaves are built by its workers;
+            // the call returns once the whole tree is done
+            void rebuild(ThreadPool* threadPool = nullptr) noexcept;
+
+            // queries: append the user data of every leaf whose bounds touch the volume (the frustum test is conservative
+            // like Frustum::intersectsBox; subtrees fully inside skip the remaining plane tests)
+            void query(const Frustum& frustum, std::vector<uint32_t>& results) const noexcept;
+            void query(const BoundingBox& bounds, std::vector<uint32_t>& results) const noexcept;
+
+            // nearest leaf bounds the ray enters within maxDistance (direction need not be normalized; distances are in
+            // its units). false when none is hit
+            bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, uint32_t& userData, float& distance) const noexcept;
+
+            // accessors
+            uint32_t getLeafCount() const noexcept { return m_leafCount; }
+            uint32_t getUserData(uint32_t proxy) const noexcept { return m_leaves[proxy].mUserData; }
+            const BoundingBox& getBounds(uint32_t proxy) const noexcept { return m_leaves[proxy].mBounds; }
+            BoundingBox getRootBounds() const noexcept;
+            uint32_t getReinsertCount() const noexcept { return m_reinsertCount; }    // since the last rebuild
+            bool isRebuildRecommended() const noexcept { return m_reinsertCount > m_leafCount / 2 + 16; }
+
+        private:
+            static constexpr uint32_t kNullNode = ~0u;
+            static constexpr uint32_t kLeafBit = 1u << 31;      // child references with the bit name a leaf
+
+            struct Node
+            {
+                BoundingBox mBounds;                            // union of the children's fattened bounds
+                uint32_t    mParent = kNullNode;
+                uint32_t    mChildren[2] = { kNullNode, kNullNode };
+            };
+
+            struct Leaf
+            {
+                BoundingBox mBounds;                            // as given, tested by queries
+                BoundingBox mFatBounds;                         // as stored in the tree
+                uint32_t    mParent = kNullNode;
+                uint32_t    mUserData = 0;
+                bool        mIsLive = false;
+            };
+
+            const BoundingBox& getTreeBounds(uint32_t reference) const noexcept;
+            void setParent(uint32_t reference, uint32_t parent) noexcept;
+            uint32_t allocateNode() noexcept;
+
+            void insertLeaf(uint32_t proxy) noexcept;
+            void removeLeaf(uint32_t proxy) noexcept;
+            void refit(uint32_t node) noexcept;
+
+            uint32_t buildRange(uint32_t* proxies, uint32_t count, uint32_t nodeIndex, uint32_t parent, TaskGroup* taskGroup) noexcept;
+
+        private:
+            std::vector<Node>       m_nodes;
+            std::vector<uint32_t>   m_freeNodes;
+            std::vector<Leaf>       m_leaves;
+            std::vector<uint32_t>   m_freeLeaves;
+            uint32_t                m_root;                 // child reference, kNullNode when empty
+            uint32_t                m_leafCount;
+            uint32_t                m_reinsertCount;
+    };
+}   // namespace keplar
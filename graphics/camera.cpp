@@ -4,6 +4,7 @@
 
 #include "camera.hpp"
 #include <algorithm>
+#include "utils/profiler.hpp"
 
 namespace 
 {
@@ -29,6 +30,9 @@ namespace keplar
         , m_zfar(zfar)
         , m_width(1.0f)
         , m_height(1.0f)
+        , m_isReverseDepth(false)
+        , m_preRotation(0.0f)
+        , m_jitter(0.0f)
         , m_position(0.0f, 0.0f, 3.0f)
         , m_front(0.0f, 0.0f, -1.0f)
         , m_up(0.0f, 1.0f, 0.0f)
@@ -41,10 +45,13 @@ namespace keplar
         , m_speed(CAMERA_DEFAULT_SPEED)
         , m_keys{}
         , m_viewMatrix(1.0f)
+        , m_previousPosition(m_position)
+        , m_previousOrientation(m_orientation)
         , m_lastMouseX(0.0)
         , m_lastMouseY(0.0)
         , m_firstMouse(true)
         , m_dragging(false)
+        , m_hasRawMotion(false)
         , m_dragStartX(0.0)
         , m_dragStartY(0.0)
         , m_dragStartYaw(0.0f)
@@ -81,7 +88,11 @@ namespace keplar
 
     void Camera::update(float dt)
     {
+        KEPLAR_PROFILE_FUNCTION();
+
         // update camera state for current frame
+        m_previousPosition = m_position;
+        m_previousOrientation = m_orientation;
         processKeyboard(dt);
         processMouse(dt);
         updateVectors();
@@ -127,6 +138,14 @@ namespace keplar
             case Mode::Fps:
             case Mode::Cinematic:
                 {
+                    // raw motion drives the look, the cursor position is only kept current
+                    if (m_hasRawMotion)
+                    {
+                        m_lastMouseX = xpos;
+                        m_lastMouseY = ypos;
+                        return;
+                    }
+
                     // skip first event to prevent sudden jump
                     if (m_firstMouse)
                     {
@@ -150,12 +169,7 @@ namespace keplar
                         return;
                     }
 
-                    // update yaw and pitch based on mouse movement and sensitivity
-                    glm::quat yaw = glm::angleAxis(glm::radians(static_cast<float>(-dx) * m_sensitivity), glm::vec3(0.0f, 1.0f, 0.0f));    
-                    glm::quat pitch = glm::angleAxis(glm::radians(static_cast<float>(dy) * m_sensitivity), glm::vec3(1.0f, 0.0f, 0.0f)); 
-                    
-                    // apply pitch then yaw to target orientation
-                    m_targetOrientation = glm::normalize(yaw * m_targetOrientation * pitch);
+                    rotateLook(dx, dy);
                 }
                 break;
 
@@ -204,6 +218,18 @@ namespace keplar
         }
     }
 
+    void Camera::onMouseRawMotion(double dx, double dy)
+    {
+        // device counts summed over one pump: no warp or first-event jump to discard. turntable drags stay on positions
+        if (m_mode == Mode::Turntable)
+        {
+            return;
+        }
+
+        m_hasRawMotion = true;
+        rotateLook(dx, dy);
+    }
+
     void Camera::onMouseScroll(double yoffset) 
     {
         if (m_mode == Mode::Turntable)
@@ -267,6 +293,48 @@ namespace keplar
         updateProjection();
     }
 
+    void Camera::setReverseDepth(bool isReverseDepth) noexcept
+    {
+        m_isReverseDepth = isReverseDepth;
+        updateProjection();
+    }
+
+    void Camera::setPreRotation(float degrees) noexcept
+    {
+        if (m_preRotation == degrees)
+        {
+            return;
+        }
+
+        m_preRotation = degrees;
+        updateProjection();
+    }
+
+    void Camera::setJitter(const glm::vec2& clipOffset) noexcept
+    {
+        m_jitter = clipOffset;
+    }
+
+    glm::mat4 Camera::getJitteredProjectionMatrix() const noexcept
+    {
+        // offsets clip xy by jitter * w, i.e. the whole image by a constant fraction of a pixel after the divide
+        return glm::translate(glm::mat4(1.0f), glm::vec3(m_jitter, 0.0f)) * m_projectionMatrix;
+    }
+
+    glm::mat4 Camera::getEyeViewMatrix(const glm::mat4& viewMatrix, float eyeOffset) noexcept
+    {
+        return glm::translate(glm::mat4(1.0f), glm::vec3(-eyeOffset, 0.0f, 0.0f)) * viewMatrix;
+    }
+
+    glm::mat4 Camera::getStereoCullingMatrix(const glm::mat4& viewMatrix, float interpupillaryDistance) const noexcept
+    {
+        // the narrower half angle, so the pre-rotated projection (extents swapped) is covered as well
+        const float tanHalfFovY = std::tan(glm::radians(m_fovy) * 0.5f);
+        const float tanHalfFov = std::min(tanHalfFovY, tanHalfFovY * m_aspect);
+        const float pullBack = 0.5f * std::abs(interpupillaryDistance) / std::max(tanHalfFov, 1e-4f);
+        return m_projectionMatrix * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -pullBack)) * viewMatrix;
+    }
+
     void Camera::setSpeed(float speed) noexcept
     {
         m_speed = speed;
@@ -297,11 +365,71 @@ namespace keplar
         m_orbitTarget = target; 
     }
 
+    void Camera::setOrbit(float yaw, float pitch, float distance) noexcept
+    {
+        if (m_mode != Mode::Turntable)
+        {
+            return;
+        }
+
+        // current and target state agree, so update() does not smooth towards the previous pose
+        m_orbitYaw = m_orbitTargetYaw = std::remainder(yaw, glm::two_pi<float>());
+        m_orbitPitch = m_orbitTargetPitch = glm::clamp(pitch, -ORBIT_PITCH_LIMIT, ORBIT_PITCH_LIMIT);
+        m_orbitDistance = m_orbitTargetDistance = std::clamp(distance, 0.05f, 500.0f);
+        m_orientation = m_targetOrientation = buildOrbitOrientation(m_orbitYaw, m_orbitPitch);
+        updateVectors();
+
+        // a scripted pose is not blended with the one it replaces
+        m_previousPosition = m_position;
+        m_previousOrientation = m_orientation;
+    }
+
+    glm::mat4 Camera::getInterpolatedViewMatrix(float alpha) const noexcept
+    {
+        if (alpha >= 1.0f)
+        {
+            return m_viewMatrix;
+        }
+
+        // turntable poses look at the orbit target along -z of the orientation as well, so one form covers all modes
+        const glm::quat orientation = glm::slerp(m_previousOrientation, m_orientation, glm::max(alpha, 0.0f));
+        const glm::vec3 position = getInterpolatedPosition(alpha);
+        const glm::vec3 front = glm::normalize(orientation * glm::vec3(0.0f, 0.0f, -1.0f));
+        const glm::vec3 up = glm::normalize(orientation * glm::vec3(0.0f, 1.0f, 0.0f));
+        return glm::lookAt(position, position + front, up);
+    }
+
+    glm::vec3 Camera::getInterpolatedPosition(float alpha) const noexcept
+    {
+        return glm::mix(m_previousPosition, m_position, glm::clamp(alpha, 0.0f, 1.0f));
+    }
+
     void Camera::updateProjection() noexcept
     {
-        // build perspective projection and flip Y axis for vulkan clip space
-        m_projectionMatrix = glm::perspective(glm::radians(m_fovy), m_aspect, m_znear, m_zfar);
+        if (m_isReverseDepth)
+        {
+            // reverse-z with the far plane at infinity: clip z is the near distance and w the view depth, so depth
+            // falls from 1 at the near plane towards 0 and float depth keeps its precision where 1/z compresses it
+            const float focal = 1.0f / std::tan(glm::radians(m_fovy) * 0.5f);
+            m_projectionMatrix = glm::mat4(0.0f);
+            m_projectionMatrix[0][0] = focal / m_aspect;
+            m_projectionMatrix[1][1] = focal;
+            m_projectionMatrix[2][3] = -1.0f;
+            m_projectionMatrix[3][2] = m_znear;
+        }
+        else
+        {
+            m_projectionMatrix = glm::perspective(glm::radians(m_fovy), m_aspect, m_znear, m_zfar);
+        }
+
+        // flip Y axis for vulkan clip space
         m_projectionMatrix[1][1] *= -1.0f;
+
+        // rotate clip space into the orientation the swapchain images are scanned out in
+        if (m_preRotation != 0.0f)
+        {
+            m_projectionMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(m_preRotation), glm::vec3(0.0f, 0.0f, 1.0f)) * m_projectionMatrix;
+        }
     }
 
     void Camera::updateVectors() noexcept
@@ -372,6 +500,16 @@ namespace keplar
         }
     }
 
+    void Camera::rotateLook(double dx, double dy) noexcept
+    {
+        // update yaw and pitch based on mouse movement and sensitivity
+        glm::quat yaw = glm::angleAxis(glm::radians(static_cast<float>(-dx) * m_sensitivity), glm::vec3(0.0f, 1.0f, 0.0f));    
+        glm::quat pitch = glm::angleAxis(glm::radians(static_cast<float>(dy) * m_sensitivity), glm::vec3(1.0f, 0.0f, 0.0f)); 
+        
+        // apply pitch then yaw to target orientation
+        m_targetOrientation = glm::normalize(yaw * m_targetOrientation * pitch);
+    }
+
     void Camera::processMouse(float dt) noexcept
     {
         switch (m_mode)
@@ -8,6 +8,7 @@
 
 #include "platform/event_listener.hpp"
 #include "math3d.hpp"
+#include "frustum_culling.hpp"
 
 namespace keplar
 {
@@ -33,6 +34,7 @@ namespace keplar
             void onKeyPressed(uint32_t key) override;
             void onKeyReleased(uint32_t key) override;
             void onMouseMove(double xpos, double ypos) override;
+            void onMouseRawMotion(double dx, double dy) override;
             void onMouseScroll(double yoffset) override;
             void onMouseButtonPressed(uint32_t button, int xpos, int ypos) override;
             void onMouseButtonReleased(uint32_t button, int xpos, int ypos) override;
@@ -40,15 +42,32 @@ namespace keplar
             // accessors
             const glm::mat4& getViewMatrix() const noexcept         { return m_viewMatrix; }
             const glm::mat4& getProjectionMatrix() const noexcept   { return m_projectionMatrix; }
+            glm::mat4 getJitteredProjectionMatrix() const noexcept;
+            const glm::vec2& getJitter() const noexcept             { return m_jitter; }
+            Frustum getFrustum() const noexcept                     { return Frustum::fromMatrix(m_projectionMatrix * m_viewMatrix); }
+            CullingFrustum getCullingFrustum() const noexcept       { return CullingFrustum::fromFrustum(getFrustum()); }
             const glm::vec3& getPosition() const noexcept           { return m_position; }
             const glm::vec3& getFront() const noexcept              { return m_front; }
             const glm::vec3& getUp() const noexcept                 { return m_up; }
             const glm::vec3& getRight() const noexcept              { return m_right; }
+
+            // pose blended from the previous update() (alpha 0) to the latest one (alpha 1)
+            glm::mat4 getInterpolatedViewMatrix(float alpha) const noexcept;
+            glm::vec3 getInterpolatedPosition(float alpha) const noexcept;
+
+            // stereo: parallel eyes eyeOffset along the view's right axis (negative: left) sharing the projection, and
+            // world to clip space of one frustum containing both eyes' (the view pulled back until its sides pass
+            // through either eye; the far plane comes that much closer)
+            static glm::mat4 getEyeViewMatrix(const glm::mat4& viewMatrix, float eyeOffset) noexcept;
+            glm::mat4 getStereoCullingMatrix(const glm::mat4& viewMatrix, float interpupillaryDistance) const noexcept;
             
             float getFov() const noexcept                           { return m_fovy; }
             float getAspectRatio() const noexcept                   { return m_aspect; }
             float getNearClip() const noexcept                      { return m_znear; }
             float getFarClip() const noexcept                       { return m_zfar; }
+            bool isReverseDepth() const noexcept                    { return m_isReverseDepth; }
+            bool hasMoved() const noexcept                          { return m_position != m_previousPosition || m_orientation != m_previousOrientation; }
+            float getPreRotation() const noexcept                   { return m_preRotation; }
             float getSpeed() const noexcept                         { return m_speed; }
             float getSensitivity() const noexcept                   { return m_sensitivity; }
             float getScrollSpeed() const noexcept                   { return m_scrollSpeed; }
@@ -59,6 +78,15 @@ namespace keplar
             void setFov(float fovy) noexcept;
             void setClipPlanes(float znear, float zfar) noexcept;
             void setAspectRatio(float aspect) noexcept;
+            void setReverseDepth(bool isReverseDepth) noexcept;
+
+            // clip space turned by the swapchain's pre-rotation (VulkanSwapchain::getPreRotation); the aspect ratio stays
+            // the one of the window
+            void setPreRotation(float degrees) noexcept;
+
+            // sub-pixel clip-space offset of getJitteredProjectionMatrix (temporal anti-aliasing); the frustum and the
+            // unjittered projection ignore it
+            void setJitter(const glm::vec2& clipOffset) noexcept;
             void setSpeed(float speed) noexcept;
             void setSensitivity(float sensitivity) noexcept;
             void setScrollSpeed(float speed) noexcept;
@@ -66,12 +94,16 @@ namespace keplar
             void setRotationDamping(float damping) noexcept;
             void setOrbitTarget(const glm::vec3& target) noexcept;
 
+            // turntable pose applied without damping (scripted paths); ignored by the other modes
+            void setOrbit(float yaw, float pitch, float distance) noexcept;
+
         private:
             // internal helpers
             void updateProjection() noexcept;
             void updateVectors() noexcept;
             void processKeyboard(float dt) noexcept;
             void processMouse(float dt) noexcept;
+            void rotateLook(double dx, double dy) noexcept;
 
             // turntable helpers
             void initOrbitState() noexcept;
@@ -89,6 +121,9 @@ namespace keplar
             float m_zfar;
             float m_width;
             float m_height;
+            bool  m_isReverseDepth;     // near at depth 1, far plane at infinity; m_zfar still bounds shading and shadows
+            float m_preRotation;        // degrees
+            glm::vec2 m_jitter;         // clip space, applied after the pre-rotation
 
             // transform
             glm::vec3 m_position;
@@ -113,11 +148,16 @@ namespace keplar
             glm::mat4 m_viewMatrix;
             glm::mat4 m_projectionMatrix;
 
+            // pose before the latest update, for interpolated rendering
+            glm::vec3 m_previousPosition;
+            glm::quat m_previousOrientation;
+
             // mouse tracking 
             double m_lastMouseX;
             double m_lastMouseY;
             bool m_firstMouse;
             bool m_dragging; 
+            bool m_hasRawMotion;        // fps and cinematic look follows raw deltas once the platform delivers them
 
             // turntable camera state
             glm::vec3 m_orbitTarget;
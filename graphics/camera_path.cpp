@@ -0,0 +1,91 @@
+// ────────────────────────────────────────────
+//  File: camera_path.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "camera_path.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // keys of the generated orbit (the last key closes the revolution)
+    constexpr int kOrbitKeyCount = 9;
+
+    // uniform catmull-rom through p1 and p2
+    float catmullRom(float p0, float p1, float p2, float p3, float t) noexcept
+    {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        return 0.5f * ((2.0f * p1) + (-p0 + p2) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+    }
+}
+
+namespace keplar
+{
+    void CameraPath::addKey(const CameraPathKey& key) noexcept
+    {
+        m_keys.push_back(key);
+    }
+
+    CameraPathKey CameraPath::evaluate(float time) const noexcept
+    {
+        if (m_keys.empty())
+        {
+            return CameraPathKey{};
+        }
+
+        // clamp to the ends of the path
+        if (m_keys.size() == 1 || time <= m_keys.front().mTime)
+        {
+            return m_keys.front();
+        }
+
+        if (time >= m_keys.back().mTime)
+        {
+            return m_keys.back();
+        }
+
+        // segment [i, i + 1] containing time, with the neighbouring keys repeated at the ends
+        const auto next = std::upper_bound(m_keys.begin(), m_keys.end(), time, [](float value, const CameraPathKey& key)
+        {
+            return value < key.mTime;
+        });
+
+        const size_t i  = static_cast<size_t>(std::distance(m_keys.begin(), next)) - 1;
+        const auto& k0  = m_keys[(i > 0) ? i - 1 : i];
+        const auto& k1  = m_keys[i];
+        const auto& k2  = m_keys[i + 1];
+        const auto& k3  = m_keys[std::min(i + 2, m_keys.size() - 1)];
+
+        const float span = k2.mTime - k1.mTime;
+        const float t = (span > 0.0f) ? (time - k1.mTime) / span : 0.0f;
+
+        CameraPathKey key{};
+        key.mTime     = time;
+        key.mYaw      = catmullRom(k0.mYaw, k1.mYaw, k2.mYaw, k3.mYaw, t);
+        key.mPitch    = catmullRom(k0.mPitch, k1.mPitch, k2.mPitch, k3.mPitch, t);
+        key.mDistance = std::max(catmullRom(k0.mDistance, k1.mDistance, k2.mDistance, k3.mDistance, t), 0.05f);
+        return key;
+    }
+
+    CameraPath CameraPath::createOrbit(float duration, float distance, float pitch) noexcept
+    {
+        constexpr float kTwoPi = 6.28318530718f;
+
+        CameraPath path;
+        for (int i = 0; i < kOrbitKeyCount; ++i)
+        {
+            const float u = static_cast<float>(i) / static_cast<float>(kOrbitKeyCount - 1);
+
+            CameraPathKey key{};
+            key.mTime     = u * duration;
+            key.mYaw      = u * kTwoPi;
+            key.mPitch    = pitch * std::sin(u * kTwoPi);
+            key.mDistance = distance * (1.0f - 0.5f * std::sin(u * kTwoPi * 0.5f));
+            path.addKey(key);
+        }
+
+        return path;
+    }
+}   // namespace keplar
@@ -0,0 +1,45 @@
+// ────────────────────────────────────────────
+//  File: camera_path.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+namespace keplar
+{
+    // turntable pose at a point in time: angles in radians, yaw unwrapped so consecutive keys may exceed two pi
+    struct CameraPathKey
+    {
+        float mTime     = 0.0f;
+        float mYaw      = 0.0f;
+        float mPitch    = 0.0f;
+        float mDistance = 1.0f;
+    };
+
+    // scripted camera path for reproducible runs: keys are interpolated with catmull-rom splines and evaluate()
+    // clamps to the first and last key, so a fixed time step always replays the same frames
+    class CameraPath
+    {
+        public:
+            // creation and destruction
+            CameraPath() noexcept = default;
+
+            // keys are expected in increasing time
+            void addKey(const CameraPathKey& key) noexcept;
+            void clear() noexcept                       { m_keys.clear(); }
+
+            // usage
+            CameraPathKey evaluate(float time) const noexcept;
+
+            // accessors
+            float getDuration() const noexcept          { return m_keys.empty() ? 0.0f : m_keys.back().mTime; }
+            bool isEmpty() const noexcept               { return m_keys.empty(); }
+
+            // one revolution around the target with a slow tilt and a dolly towards it and back
+            static CameraPath createOrbit(float duration, float distance, float pitch) noexcept;
+
+        private:
+            std::vector<CameraPathKey> m_keys;
+    };
+}   // namespace keplar
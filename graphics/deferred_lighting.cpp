@@ -0,0 +1,342 @@
+// ────────────────────────────────────────────
+//  File: deferred_lighting.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "deferred_lighting.hpp"
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // must match local_size_x/y of deferred_lighting.comp
+    constexpr uint32_t kLightingWorkgroupSize = 8;
+
+    // set: 1 of deferred_lighting.comp
+    constexpr uint32_t kAlbedoBinding = 0;
+    constexpr uint32_t kNormalBinding = 1;
+    constexpr uint32_t kDepthBinding  = 2;
+    constexpr uint32_t kSceneBinding  = 3;
+    constexpr uint32_t kOcclusionBinding      = 4;
+    constexpr uint32_t kOcclusionDepthBinding = 5;
+
+    // push constants: must match deferred_lighting.comp
+    struct LightingPushConstants
+    {
+        glm::mat4  inverseViewProjection;
+        glm::uvec4 extents;     // xy: rendered region, zw: image extent
+        glm::uvec4 occlusion;   // x: 1 when applied, yz: half-resolution region
+    };
+}
+
+namespace keplar
+{
+    DeferredLighting::DeferredLighting() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSet(VK_NULL_HANDLE)
+        , m_vkDepthView(VK_NULL_HANDLE)
+        , m_extent{}
+        , m_occlusionExtent{}
+    {
+    }
+
+    DeferredLighting::~DeferredLighting()
+    {
+        destroy();
+    }
+
+    bool DeferredLighting::initialize(const VulkanDevice& device, const DeferredLightingShaders& shaders, VkExtent2D extent,
+                                      VkDescriptorSetLayout cameraLayout, VkDescriptorSetLayout lightLayout) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_extent = extent;
+        if (extent.width == 0 || extent.height == 0 || cameraLayout == VK_NULL_HANDLE || lightLayout == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("DeferredLighting::initialize :: invalid extent or scene layouts");
+            destroy();
+            return false;
+        }
+
+        // the lit result is accumulated into the scene target in place
+        if (!device.isFormatSupported(kSceneFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) ||
+            !device.isFormatSupported(kAlbedoFormat, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) ||
+            !device.isFormatSupported(kNormalFormat, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT))
+        {
+            VK_LOG_ERROR("DeferredLighting::initialize :: g-buffer formats not supported");
+            destroy();
+            return false;
+        }
+
+        // every read is a texel fetch of the pixel's own g-buffer texel
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = 0.0f;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createDescriptorResources(device) || !createPipeline(device, shaders, cameraLayout, lightLayout))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("DeferredLighting::initialize successful (%ux%u)", extent.width, extent.height);
+        return true;
+    }
+
+    void DeferredLighting::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        if (m_vkDepthView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkDepthView, nullptr);
+            m_vkDepthView = VK_NULL_HANDLE;
+        }
+
+        // the set is freed with its pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDescriptorSet = VK_NULL_HANDLE;
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_extent = {};
+        m_occlusionExtent = {};
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("deferred lighting destroyed successfully");
+    }
+
+    bool DeferredLighting::bindImages(VkImageView albedoView, VkImageView normalView, VkImage depthImage, VkFormat depthFormat,
+                                      VkImageView sceneView) noexcept
+    {
+        if (m_vkDescriptorSet == VK_NULL_HANDLE || albedoView == VK_NULL_HANDLE || normalView == VK_NULL_HANDLE ||
+            depthImage == VK_NULL_HANDLE || sceneView == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("DeferredLighting::bindImages :: invalid images or pass not initialized");
+            return false;
+        }
+
+        // depth-only view: a sampled view of a depth-stencil image may name a single aspect
+        if (m_vkDepthView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkDepthView, nullptr);
+            m_vkDepthView = VK_NULL_HANDLE;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = depthImage;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = depthFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        const VkResult vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkDepthView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("DeferredLighting :: vkCreateImageView failed for depth : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDepthView = VK_NULL_HANDLE;
+            return false;
+        }
+
+        const VkDescriptorImageInfo albedoInfo{ m_vkSampler, albedoView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo normalInfo{ m_vkSampler, normalView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo depthInfo{ m_vkSampler, m_vkDepthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo sceneInfo{ VK_NULL_HANDLE, sceneView, VK_IMAGE_LAYOUT_GENERAL };
+
+        std::array<VkWriteDescriptorSet, 6> writes{};
+        for (auto& write : writes)
+        {
+            write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet          = m_vkDescriptorSet;
+            write.descriptorCount = 1;
+            write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        }
+        writes[0].dstBinding     = kAlbedoBinding;
+        writes[0].pImageInfo     = &albedoInfo;
+        writes[1].dstBinding     = kNormalBinding;
+        writes[1].pImageInfo     = &normalInfo;
+        writes[2].dstBinding     = kDepthBinding;
+        writes[2].pImageInfo     = &depthInfo;
+        writes[3].dstBinding     = kSceneBinding;
+        writes[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[3].pImageInfo     = &sceneInfo;
+        // placeholders until bindOcclusion: the shader only reads them while the occlusion is applied
+        writes[4].dstBinding     = kOcclusionBinding;
+        writes[4].pImageInfo     = &depthInfo;
+        writes[5].dstBinding     = kOcclusionDepthBinding;
+        writes[5].pImageInfo     = &depthInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        m_occlusionExtent = {};
+        return true;
+    }
+
+    bool DeferredLighting::bindOcclusion(VkImageView occlusionView, VkImageView occlusionDepthView, VkExtent2D occlusionExtent) noexcept
+    {
+        if (m_vkDepthView == VK_NULL_HANDLE || occlusionView == VK_NULL_HANDLE || occlusionDepthView == VK_NULL_HANDLE ||
+            occlusionExtent.width == 0 || occlusionExtent.height == 0)
+        {
+            VK_LOG_ERROR("DeferredLighting::bindOcclusion :: invalid images or g-buffer not bound");
+            return false;
+        }
+
+        const VkDescriptorImageInfo occlusionInfo{ m_vkSampler, occlusionView, VK_IMAGE_LAYOUT_GENERAL };
+        const VkDescriptorImageInfo depthInfo{ m_vkSampler, occlusionDepthView, VK_IMAGE_LAYOUT_GENERAL };
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        for (auto& write : writes)
+        {
+            write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet          = m_vkDescriptorSet;
+            write.descriptorCount = 1;
+            write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        }
+        writes[0].dstBinding = kOcclusionBinding;
+        writes[0].pImageInfo = &occlusionInfo;
+        writes[1].dstBinding = kOcclusionDepthBinding;
+        writes[1].pImageInfo = &depthInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        m_occlusionExtent = occlusionExtent;
+        return true;
+    }
+
+    void DeferredLighting::record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const glm::mat4& inverseViewProjection,
+                                  bool isOcclusionApplied) const noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        // the render graph transitions and synchronizes the g-buffer; the caller binds the scene's sets around set 1
+        renderExtent = { std::clamp(renderExtent.width, 1u, m_extent.width), std::clamp(renderExtent.height, 1u, m_extent.height) };
+
+        LightingPushConstants pushConstants{};
+        pushConstants.inverseViewProjection = inverseViewProjection;
+        pushConstants.extents = glm::uvec4(renderExtent.width, renderExtent.height, m_extent.width, m_extent.height);
+
+        // the occlusion was traced over the half of the rendered region
+        if (isOcclusionApplied && m_occlusionExtent.width != 0)
+        {
+            pushConstants.occlusion = glm::uvec4(1u, std::min((renderExtent.width + 1) / 2, m_occlusionExtent.width),
+                                                 std::min((renderExtent.height + 1) / 2, m_occlusionExtent.height), 0u);
+        }
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 1, 1, &m_vkDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (renderExtent.width + kLightingWorkgroupSize - 1) / kLightingWorkgroupSize,
+                      (renderExtent.height + kLightingWorkgroupSize - 1) / kLightingWorkgroupSize, 1);
+    }
+
+    bool DeferredLighting::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { kAlbedoBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kNormalBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kDepthBinding,  VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kSceneBinding,  VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kOcclusionBinding,      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kOcclusionDepthBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        m_vkSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 5 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("DeferredLighting :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkSetLayout;
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &m_vkDescriptorSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("DeferredLighting :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorSet = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool DeferredLighting::createPipeline(const VulkanDevice& device, const DeferredLightingShaders& shaders, VkDescriptorSetLayout cameraLayout,
+                                          VkDescriptorSetLayout lightLayout) noexcept
+    {
+        VulkanShader lightingShader;
+        if (!lightingShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mLightingFile))
+        {
+            VK_LOG_ERROR("DeferredLighting :: compute shader '%s' unavailable", shaders.mLightingFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = lightingShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { cameraLayout, m_vkSetLayout, lightLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(LightingPushConstants) } };
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("DeferredLighting :: failed to create the lighting pipeline");
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
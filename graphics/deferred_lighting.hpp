@@ -0,0 +1,90 @@
+// ────────────────────────────────────────────
+//  File: deferred_lighting.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the compute pass
+    struct DeferredLightingShaders
+    {
+        std::string mLightingFile;          // deferred_lighting.comp (or its ray query build)
+    };
+
+    // lighting of the deferred shading path. the scene passes write a compact g-buffer instead of shading: emissive and
+    // ambient occlusion into the hdr scene target, base color and metallic (kAlbedoFormat) and an octahedral normal with
+    // the roughness (kNormalFormat), 8 bytes per pixel on top of the scene target. one compute pass then reconstructs
+    // each pixel's position from the depth and lights it with the sun, the clustered point lights LightClusters binned
+    // and the baked environment, adding the result to the emissive term in place. it shares the camera (set 0) and
+    // light (set 2) sets of the scene pipelines, the g-buffer is its own set 1. pixels at the clear depth keep the
+    // clear color. screen-space ambient occlusion (AmbientOcclusion, half resolution) is upsampled here, weighting the
+    // four texels around each pixel by their depth against the pixel's, and darkens the ambient term only. runs over the
+    // rendered region only (see dynamic resolution); rebuilt with the render graph that owns the g-buffer
+    class DeferredLighting final
+    {
+        public:
+            static constexpr VkFormat kSceneFormat  = VK_FORMAT_R16G16B16A16_SFLOAT;    // PostProcess::kSourceFormat
+            static constexpr VkFormat kAlbedoFormat = VK_FORMAT_R8G8B8A8_SRGB;
+            static constexpr VkFormat kNormalFormat = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+
+            // creation and destruction
+            DeferredLighting() noexcept;
+            ~DeferredLighting();
+
+            // disable copy and move semantics to enforce unique ownership
+            DeferredLighting(const DeferredLighting&) = delete;
+            DeferredLighting& operator=(const DeferredLighting&) = delete;
+            DeferredLighting(DeferredLighting&&) = delete;
+            DeferredLighting& operator=(DeferredLighting&&) = delete;
+
+            // usage: extent is the one of the g-buffer; cameraLayout and lightLayout are the scene's sets 0 and 2, whose
+            // bindings must include the compute stage
+            bool initialize(const VulkanDevice& device, const DeferredLightingShaders& shaders, VkExtent2D extent,
+                            VkDescriptorSetLayout cameraLayout, VkDescriptorSetLayout lightLayout) noexcept;
+            void destroy() noexcept;
+
+            // usage: albedo, normal and depth (single-sampled) sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, the
+            // scene target read and written as a storage image in VK_IMAGE_LAYOUT_GENERAL
+            bool bindImages(VkImageView albedoView, VkImageView normalView, VkImage depthImage, VkFormat depthFormat, VkImageView sceneView) noexcept;
+
+            // usage: after bindImages, the half-resolution visibility and view depth of AmbientOcclusion, both sampled in
+            // VK_IMAGE_LAYOUT_GENERAL. until then the occlusion bindings hold the depth and are never read
+            bool bindOcclusion(VkImageView occlusionView, VkImageView occlusionDepthView, VkExtent2D occlusionExtent) noexcept;
+
+            // usage: outside render passes, with sets 0 and 2 bound at the compute bind point through getPipelineLayout;
+            // inverseViewProjection takes the clip space the scene rendered with (jitter included) back to world space;
+            // isOcclusionApplied when the bound occlusion was traced this frame
+            void record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const glm::mat4& inverseViewProjection, bool isOcclusionApplied) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && m_vkDescriptorSet != VK_NULL_HANDLE && m_vkDepthView != VK_NULL_HANDLE; }
+            VkPipelineLayout getPipelineLayout() const noexcept { return m_pipeline.getLayout(); }
+
+        private:
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipeline(const VulkanDevice& device, const DeferredLightingShaders& shaders, VkDescriptorSetLayout cameraLayout,
+                                VkDescriptorSetLayout lightLayout) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkSampler                       m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout           m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorPool                m_vkDescriptorPool;
+            VkDescriptorSet                 m_vkDescriptorSet;
+            VulkanPipeline                  m_pipeline;
+            VkImageView                     m_vkDepthView;          // depth aspect of the bound depth image
+            VkExtent2D                      m_extent;
+            VkExtent2D                      m_occlusionExtent;      // 0 until bindOcclusion
+    };
+}   // namespace keplar
@@ -0,0 +1,125 @@
+// ────────────────────────────────────────────
+//  File: dynamic_resolution.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "dynamic_resolution.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    // weight of a new sample in the smoothed time that steps up are predicted from
+    constexpr float kFilterWeight = 0.2f;
+
+    // scales closer than this are the same step
+    constexpr float kScaleEpsilon = 1e-4f;
+
+    // smallest scale either bound may take
+    constexpr float kLowestScale = 0.1f;
+}
+
+namespace keplar
+{
+    DynamicResolution::DynamicResolution() noexcept
+        : m_scale(1.0f)
+        , m_filteredMs(0.0f)
+        , m_settleFrames(0)
+    {
+    }
+
+    void DynamicResolution::initialize(const DynamicResolutionConfig& config) noexcept
+    {
+        m_config = config;
+        m_config.mStep = std::max(m_config.mStep, 0.01f);
+        m_config.mMaxStepsDown = std::max(m_config.mMaxStepsDown, 1u);
+        m_config.mGranularity = std::max(m_config.mGranularity, 1u);
+        setTargetMs(m_config.mTargetMs);
+        setScaleRange(m_config.mMinScale, m_config.mMaxScale);
+        reset();
+    }
+
+    void DynamicResolution::reset() noexcept
+    {
+        m_scale = m_config.mMaxScale;
+        m_filteredMs = 0.0f;
+        m_settleFrames = 0;
+    }
+
+    bool DynamicResolution::update(float gpuMilliseconds) noexcept
+    {
+        if (gpuMilliseconds <= 0.0f)
+        {
+            return false;
+        }
+
+        // until the settle period is over the samples still measure frames rendered at the previous scale
+        if (m_settleFrames > 0)
+        {
+            --m_settleFrames;
+            return false;
+        }
+        m_filteredMs = m_filteredMs > 0.0f ? m_filteredMs + kFilterWeight * (gpuMilliseconds - m_filteredMs) : gpuMilliseconds;
+
+        float scale = m_scale;
+        const float targetMs = m_config.mTargetMs;
+        if (gpuMilliseconds > targetMs)
+        {
+            // over budget: the scale that would have fit, in whole steps down (at least one)
+            const float fitScale = m_scale * std::sqrt(targetMs / gpuMilliseconds);
+            const float steps = std::ceil((m_scale - fitScale) / m_config.mStep - kScaleEpsilon);
+            scale = m_scale - std::clamp(steps, 1.0f, static_cast<float>(m_config.mMaxStepsDown)) * m_config.mStep;
+        }
+        else
+        {
+            // under budget: one step up once the smoothed time predicts it still leaves the headroom
+            const float nextScale = m_scale + m_config.mStep;
+            const float pixelRatio = (nextScale * nextScale) / (m_scale * m_scale);
+            if (m_filteredMs * pixelRatio <= targetMs * m_config.mHeadroom)
+            {
+                scale = nextScale;
+            }
+        }
+
+        scale = std::clamp(scale, m_config.mMinScale, m_config.mMaxScale);
+        if (std::abs(scale - m_scale) < kScaleEpsilon)
+        {
+            return false;
+        }
+
+        // the smoothed time restarts at the new scale
+        m_scale = scale;
+        m_filteredMs = 0.0f;
+        m_settleFrames = m_config.mSettleFrames;
+        return true;
+    }
+
+    void DynamicResolution::setTargetMs(float targetMs) noexcept
+    {
+        m_config.mTargetMs = std::max(targetMs, 0.1f);
+    }
+
+    void DynamicResolution::setScaleRange(float minScale, float maxScale) noexcept
+    {
+        m_config.mMinScale = std::clamp(minScale, kLowestScale, 1.0f);
+        m_config.mMaxScale = std::clamp(maxScale, m_config.mMinScale, 1.0f);
+        m_scale = std::clamp(m_scale, m_config.mMinScale, m_config.mMaxScale);
+    }
+
+    VkExtent2D DynamicResolution::getRenderExtent(VkExtent2D outputExtent) const noexcept
+    {
+        if (m_scale >= 1.0f - kScaleEpsilon)
+        {
+            return outputExtent;
+        }
+
+        // snapped down to the granularity, never below one granule (or the output itself when it is smaller)
+        const uint32_t granularity = m_config.mGranularity;
+        auto scaleAxis = [this, granularity](uint32_t size)
+        {
+            const uint32_t scaled = static_cast<uint32_t>(static_cast<float>(size) * m_scale) / granularity * granularity;
+            return std::clamp(scaled, std::min(granularity, size), size);
+        };
+        return { scaleAxis(outputExtent.width), scaleAxis(outputExtent.height) };
+    }
+}   // namespace keplar
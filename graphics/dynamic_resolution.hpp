@@ -0,0 +1,64 @@
+// ────────────────────────────────────────────
+//  File: dynamic_resolution.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    struct DynamicResolutionConfig
+    {
+        float    mTargetMs      = 1000.0f / 60.0f;  // gpu frame time to hold
+        float    mHeadroom      = 0.85f;            // a step up has to keep the predicted time below this share of the target
+        float    mMinScale      = 0.5f;             // per axis, of the output extent
+        float    mMaxScale      = 1.0f;
+        float    mStep          = 0.05f;            // scales are multiples of this
+        uint32_t mMaxStepsDown  = 4;                // largest drop per update, so a spike is absorbed within a frame or two
+        uint32_t mSettleFrames  = 4;                // updates ignored after a change, until timings reflect the new scale
+        uint32_t mGranularity   = 8;                // render extents snap to multiples of this many pixels
+    };
+
+    // gpu-time driven render scale. shaded pixels grow with the square of the per-axis scale, so the scale that fits
+    // the target is predicted from the ratio of target and measured time:
+    // - over the target it drops right away (by up to mMaxStepsDown steps), following the raw sample
+    // - under it, it rises one step at a time, and only while the smoothed time predicted for the next step keeps
+    //   mHeadroom; the gap between both thresholds is the hysteresis that keeps it from oscillating
+    // the timings lag the frames in flight, hence the settle period after every change
+    class DynamicResolution final
+    {
+        public:
+            // creation and destruction
+            DynamicResolution() noexcept;
+            ~DynamicResolution() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            DynamicResolution(const DynamicResolution&) = delete;
+            DynamicResolution& operator=(const DynamicResolution&) = delete;
+            DynamicResolution(DynamicResolution&&) = delete;
+            DynamicResolution& operator=(DynamicResolution&&) = delete;
+
+            void initialize(const DynamicResolutionConfig& config = {}) noexcept;
+            void reset() noexcept;
+
+            // usage: once per frame with the gpu time of the latest resolved frame; returns true when the scale changed
+            bool update(float gpuMilliseconds) noexcept;
+
+            // usage: runtime tuning (ui); the scale is clamped into the new range
+            void setTargetMs(float targetMs) noexcept;
+            void setScaleRange(float minScale, float maxScale) noexcept;
+
+            // accessors: the top-left region of an outputExtent target the scene renders into
+            VkExtent2D getRenderExtent(VkExtent2D outputExtent) const noexcept;
+            const DynamicResolutionConfig& getConfig() const noexcept  { return m_config; }
+            float getScale() const noexcept                             { return m_scale; }
+            float getFilteredMs() const noexcept                        { return m_filteredMs; }
+
+        private:
+            DynamicResolutionConfig     m_config;
+            float                       m_scale;
+            float                       m_filteredMs;       // exponential average of the samples, 0 until the first one
+            uint32_t                    m_settleFrames;     // updates left before the next change
+    };
+}   // namespace keplar
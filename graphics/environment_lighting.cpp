@@ -0,0 +1,837 @@
+// ────────────────────────────────────────────
+//  File: environment_lighting.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "environment_lighting.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <glm/gtc/packing.hpp>
+
+#include "asset_io.hpp"
+#include "math3d.hpp"
+#include "model_cache.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_samplers.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/asset_pack.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // every map is rgba16f: 8 bytes per texel
+    constexpr VkFormat     kFormat        = VK_FORMAT_R16G16B16A16_SFLOAT;
+    constexpr VkDeviceSize kTexelSize     = 8;
+    constexpr uint32_t     kCubeFaces     = 6;
+
+    // must match local_size_x/y in the ibl_*.comp shaders
+    constexpr uint32_t kTileSize = 8;
+
+    // descriptor bindings (set: 0), shared by every bake pass
+    constexpr uint32_t kInputBinding  = 0;
+    constexpr uint32_t kOutputBinding = 1;
+
+    // bake passes, in recording order
+    enum BakePass : uint32_t { kEquirectPass, kIrradiancePass, kPrefilterPass, kBrdfLutPass, kBakePassCount };
+    constexpr const char* kBakeShaders[kBakePassCount] =
+    {
+        "pbr/ibl_equirect.comp.spv", "pbr/ibl_irradiance.comp.spv", "pbr/ibl_prefilter.comp.spv", "pbr/ibl_brdf_lut.comp.spv"
+    };
+
+    // one set per pass, one per prefiltered level
+    constexpr uint32_t kBakeSetCount = 3 + keplar::EnvironmentLighting::kPrefilteredMipLevels;
+
+    // sample counts: irradiance steps sqrt(count) per angle, prefiltering relies on filtered importance sampling
+    constexpr uint32_t kIrradianceSamples = 64 * 64;
+    constexpr uint32_t kPrefilterSamples  = 1024;
+    constexpr uint32_t kBrdfLutSamples    = 1024;
+
+    // procedural sky used when no environment file is given (equirectangular, 2:1)
+    constexpr uint32_t kSkyWidth  = 512;
+    constexpr uint32_t kSkyHeight = 256;
+
+    // cache layout, bumped whenever the baked sizes or formats change; stored in the archive key's format field
+    constexpr uint32_t kCacheLayout         = 1;
+    constexpr uint32_t kCacheFlagProcedural = 1u << 0;
+
+    // push constants: x roughness, y environment face size, z sample count, w environment mip count
+    struct BakePushConstants
+    {
+        glm::vec4 params;
+    };
+
+    uint32_t getGroupCount(uint32_t extent) noexcept
+    {
+        return (extent + kTileSize - 1) / kTileSize;
+    }
+
+    VkDeviceSize getImageSize(VkExtent2D extent, uint32_t mipLevels, uint32_t layers) noexcept
+    {
+        VkDeviceSize size = 0;
+        for (uint32_t level = 0; level < mipLevels; ++level)
+        {
+            size += VkDeviceSize(std::max(extent.width >> level, 1u)) * std::max(extent.height >> level, 1u) * layers * kTexelSize;
+        }
+        return size;
+    }
+
+    void imageBarrier(VkCommandBuffer commandBuffer, VkImage image, uint32_t baseMipLevel, uint32_t levelCount, uint32_t layers,
+                      VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+                      VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage) noexcept
+    {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext                           = nullptr;
+        barrier.srcAccessMask                   = srcAccess;
+        barrier.dstAccessMask                   = dstAccess;
+        barrier.oldLayout                       = oldLayout;
+        barrier.newLayout                       = newLayout;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = image;
+        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel   = baseMipLevel;
+        barrier.subresourceRange.levelCount     = levelCount;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount     = layers;
+        keplar::VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    // one copy region per level containing every layer, levels packed back to back from bufferOffset
+    std::vector<VkBufferImageCopy> getLevelCopies(VkExtent2D extent, uint32_t mipLevels, uint32_t layers, VkDeviceSize bufferOffset) noexcept
+    {
+        std::vector<VkBufferImageCopy> copies(mipLevels);
+        for (uint32_t level = 0; level < mipLevels; ++level)
+        {
+            const VkExtent2D levelExtent = { std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u) };
+            VkBufferImageCopy& copy              = copies[level];
+            copy.bufferOffset                    = bufferOffset;
+            copy.bufferRowLength                 = 0;
+            copy.bufferImageHeight               = 0;
+            copy.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            copy.imageSubresource.mipLevel       = level;
+            copy.imageSubresource.baseArrayLayer = 0;
+            copy.imageSubresource.layerCount     = layers;
+            copy.imageOffset                     = { 0, 0, 0 };
+            copy.imageExtent                     = { levelExtent.width, levelExtent.height, 1 };
+            bufferOffset += VkDeviceSize(levelExtent.width) * levelExtent.height * layers * kTexelSize;
+        }
+        return copies;
+    }
+
+    // clear sky over a darker ground with a small sun, in the layout ibl_equirect.comp reads (top row up)
+    std::vector<uint64_t> generateSky() noexcept
+    {
+        constexpr float kPi = 3.14159265359f;
+        const glm::vec3 zenith(0.20f, 0.40f, 0.85f);
+        const glm::vec3 horizon(1.00f, 0.95f, 0.90f);
+        const glm::vec3 ground(0.30f, 0.26f, 0.22f);
+        const glm::vec3 sunDir = glm::normalize(glm::vec3(0.4f, 0.6f, 0.3f));
+        const glm::vec3 sunColor(20.0f, 18.0f, 15.0f);
+
+        std::vector<uint64_t> pixels(static_cast<size_t>(kSkyWidth) * kSkyHeight);
+        for (uint32_t y = 0; y < kSkyHeight; ++y)
+        {
+            const float theta = (float(y) + 0.5f) / float(kSkyHeight) * kPi;
+            for (uint32_t x = 0; x < kSkyWidth; ++x)
+            {
+                const float phi = ((float(x) + 0.5f) / float(kSkyWidth) - 0.5f) * 2.0f * kPi;
+                const glm::vec3 dir(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+
+                glm::vec3 color = dir.y >= 0.0f ? glm::mix(horizon, zenith, std::sqrt(dir.y)) : glm::mix(horizon * 0.5f, ground, std::sqrt(-dir.y));
+                color += sunColor * std::pow(std::max(glm::dot(dir, sunDir), 0.0f), 2000.0f);
+                pixels[static_cast<size_t>(y) * kSkyWidth + x] = glm::packHalf4x16(glm::vec4(color, 1.0f));
+            }
+        }
+        return pixels;
+    }
+
+    keplar::ModelCacheKey getCacheKey(const std::filesystem::path& environmentFile) noexcept
+    {
+        keplar::ModelCacheKey key{};
+        key.mVertexFormat = kCacheLayout;
+        if (environmentFile.empty() || !keplar::getModelCacheKey(environmentFile, key))
+        {
+            key.mFlags = kCacheFlagProcedural;
+        }
+        return key;
+    }
+}
+
+namespace keplar
+{
+    EnvironmentLighting::EnvironmentLighting() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_isValid(false)
+    {
+    }
+
+    EnvironmentLighting::~EnvironmentLighting()
+    {
+        destroy();
+    }
+
+    bool EnvironmentLighting::initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const VulkanSamplers& samplers,
+                                         const std::filesystem::path& environmentFile, const std::filesystem::path& cachePath) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+
+        if (!createTargets())
+        {
+            destroy();
+            return false;
+        }
+
+        // a cache baked from the same source only needs uploading
+        if (loadCache(stagingBelt, cachePath, environmentFile))
+        {
+            if (!stagingBelt.flush())
+            {
+                VK_LOG_ERROR("EnvironmentLighting :: failed to flush the cached maps");
+                destroy();
+                return false;
+            }
+
+            m_isValid = true;
+            VK_LOG_DEBUG("EnvironmentLighting::initialize loaded baked maps from %s", cachePath.string().c_str());
+            return true;
+        }
+
+        // not fatal: without the bake the maps are cleared to black and stay bindable
+        BakeResources bakeResources;
+        const bool isBaked = bake(device, stagingBelt, samplers, environmentFile, bakeResources);
+        if (!isBaked)
+        {
+            VkCommandBuffer commandBuffer = stagingBelt.getGraphicsCommandBuffer();
+            if (commandBuffer == VK_NULL_HANDLE)
+            {
+                VK_LOG_ERROR("EnvironmentLighting :: failed to get staging belt graphics command buffer");
+                stagingBelt.flush(true);
+                destroyBake(bakeResources);
+                destroy();
+                return false;
+            }
+            recordClear(commandBuffer);
+        }
+
+        // the bake's temporaries and readback are only released once the gpu is done with them
+        if (!stagingBelt.flush(true))
+        {
+            VK_LOG_ERROR("EnvironmentLighting :: failed to flush the bake");
+            destroyBake(bakeResources);
+            destroy();
+            return false;
+        }
+
+        if (isBaked)
+        {
+            saveCache(bakeResources, cachePath, environmentFile);
+        }
+        destroyBake(bakeResources);
+
+        m_isValid = isBaked;
+        if (isBaked)
+        {
+            VK_LOG_DEBUG("EnvironmentLighting::initialize baked maps from %s", environmentFile.empty() ? "procedural sky" : environmentFile.string().c_str());
+        }
+        return isBaked;
+    }
+
+    void EnvironmentLighting::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        destroyImage(m_irradiance);
+        destroyImage(m_prefiltered);
+        destroyImage(m_brdfLut);
+        m_isValid  = false;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("environment lighting destroyed successfully");
+    }
+
+    bool EnvironmentLighting::createImage(Image& image, VkExtent2D extent, uint32_t mipLevels, uint32_t layers, VkImageUsageFlags usage) noexcept
+    {
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.pNext         = nullptr;
+        imageCreateInfo.flags         = layers == kCubeFaces ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        imageCreateInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format        = kFormat;
+        imageCreateInfo.extent        = { extent.width, extent.height, 1 };
+        imageCreateInfo.mipLevels     = mipLevels;
+        imageCreateInfo.arrayLayers   = layers;
+        imageCreateInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage         = usage;
+        imageCreateInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &image.mImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("EnvironmentLighting :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        if (!m_memoryAllocator->allocateImageMemory(image.mImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image.mAllocation))
+        {
+            VK_LOG_FATAL("EnvironmentLighting :: failed to allocate image memory");
+            return false;
+        }
+
+        image.mExtent    = extent;
+        image.mMipLevels = mipLevels;
+        image.mLayers    = layers;
+
+        // sampled view of the whole chain
+        image.mView = createView(image, layers == kCubeFaces ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_2D, 0, mipLevels);
+        return image.mView != VK_NULL_HANDLE;
+    }
+
+    VkImageView EnvironmentLighting::createView(const Image& image, VkImageViewType viewType, uint32_t baseMipLevel, uint32_t levelCount) noexcept
+    {
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = image.mImage;
+        viewInfo.viewType                        = viewType;
+        viewInfo.format                          = kFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = baseMipLevel;
+        viewInfo.subresourceRange.levelCount     = levelCount;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = image.mLayers;
+
+        VkImageView imageView = VK_NULL_HANDLE;
+        VkResult vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &imageView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("EnvironmentLighting :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return VK_NULL_HANDLE;
+        }
+        return imageView;
+    }
+
+    void EnvironmentLighting::destroyImage(Image& image) noexcept
+    {
+        if (image.mView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, image.mView, nullptr);
+        }
+        if (image.mImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, image.mImage, nullptr);
+        }
+        if (image.mAllocation.isValid())
+        {
+            m_memoryAllocator->free(image.mAllocation);
+        }
+        image = Image{};
+    }
+
+    bool EnvironmentLighting::createTargets() noexcept
+    {
+        // written by the bake passes or the cache upload, read back for the cache, or cleared when nothing produced them
+        const VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT |
+                                        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        return createImage(m_irradiance, { kIrradianceSize, kIrradianceSize }, 1, kCubeFaces, usage) &&
+               createImage(m_prefiltered, { kPrefilteredSize, kPrefilteredSize }, kPrefilteredMipLevels, kCubeFaces, usage) &&
+               createImage(m_brdfLut, { kBrdfLutSize, kBrdfLutSize }, 1, 1, usage);
+    }
+
+    bool EnvironmentLighting::loadCache(VulkanStagingBelt& stagingBelt, const std::filesystem::path& cachePath, const std::filesystem::path& environmentFile) noexcept
+    {
+        ModelCacheReader reader;
+        if (!reader.open(cachePath, getCacheKey(environmentFile)))
+        {
+            return false;
+        }
+
+        // every map is one blob of its levels, validated before anything is recorded
+        Image* targets[] = { &m_irradiance, &m_prefiltered, &m_brdfLut };
+        const void* blobs[3] = {};
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            size_t size = 0;
+            if (!reader.readBlob(blobs[i], size) || size != getImageSize(targets[i]->mExtent, targets[i]->mMipLevels, targets[i]->mLayers))
+            {
+                VK_LOG_WARN("EnvironmentLighting :: ignoring malformed cache file %s", cachePath.string().c_str());
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            const Image& target = *targets[i];
+            VkBuffer stagingBuffer = VK_NULL_HANDLE;
+            VkDeviceSize stagingOffset = 0;
+            if (!stagingBelt.stage(blobs[i], getImageSize(target.mExtent, target.mMipLevels, target.mLayers), kTexelSize, stagingBuffer, stagingOffset))
+            {
+                VK_LOG_ERROR("EnvironmentLighting :: failed to stage cached maps");
+                return false;
+            }
+
+            // the three maps share one transition barrier and one hand-over barrier in the belt batch
+            VkImageSubresourceRange subresourceRange{};
+            subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            subresourceRange.baseMipLevel   = 0;
+            subresourceRange.levelCount     = target.mMipLevels;
+            subresourceRange.baseArrayLayer = 0;
+            subresourceRange.layerCount     = target.mLayers;
+
+            const std::vector<VkBufferImageCopy> copies = getLevelCopies(target.mExtent, target.mMipLevels, target.mLayers, stagingOffset);
+            if (!stagingBelt.copyToImage(stagingBuffer, target.mImage, subresourceRange, static_cast<uint32_t>(copies.size()), copies.data()))
+            {
+                return false;
+            }
+
+            stagingBelt.transferImageOwnership(target.mImage, subresourceRange,
+                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                               VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+        }
+
+        return true;
+    }
+
+    bool EnvironmentLighting::saveCache(const BakeResources& bake, const std::filesystem::path& cachePath, const std::filesystem::path& environmentFile) const noexcept
+    {
+        std::error_code errorCode;
+        std::filesystem::create_directories(cachePath.parent_path(), errorCode);
+
+        // the readback holds the three maps back to back, in the order loadCache reads them
+        const uint8_t* readback = static_cast<const uint8_t*>(bake.mReadbackBuffer.getMappedData());
+        if (readback == nullptr || !bake.mReadbackBuffer.invalidate())
+        {
+            return false;
+        }
+
+        ModelCacheWriter writer;
+        VkDeviceSize offset = 0;
+        for (const Image* target : { &m_irradiance, &m_prefiltered, &m_brdfLut })
+        {
+            const VkDeviceSize size = getImageSize(target->mExtent, target->mMipLevels, target->mLayers);
+            writer.writeBlob(readback + offset, static_cast<size_t>(size));
+            offset += size;
+        }
+
+        return writer.save(cachePath, getCacheKey(environmentFile));
+    }
+
+    bool EnvironmentLighting::bake(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const VulkanSamplers& samplers,
+                                   const std::filesystem::path& environmentFile, BakeResources& bake) noexcept
+    {
+        // rgba16f storage, blits and linear filtering are required formats; check anyway for broken drivers
+        if (!device.isFormatSupported(kFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+                                               VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT))
+        {
+            VK_LOG_WARN("EnvironmentLighting :: rgba16f storage images are not supported");
+            return false;
+        }
+
+        // pipelines first: a missing shader fails before anything is recorded
+        if (!createBakePipelines(device, bake) || !uploadSource(stagingBelt, environmentFile, bake))
+        {
+            return false;
+        }
+
+        // environment cubemap with a full mip chain for the filtered importance sampling
+        const uint32_t environmentMips = static_cast<uint32_t>(std::log2(kEnvironmentSize)) + 1;
+        if (!createImage(bake.mEnvironment, { kEnvironmentSize, kEnvironmentSize }, environmentMips, kCubeFaces,
+                         VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT))
+        {
+            return false;
+        }
+
+        // host-visible copy of the results for the cache
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.pNext       = nullptr;
+        bufferInfo.flags       = 0;
+        bufferInfo.size        = getImageSize(m_irradiance.mExtent, m_irradiance.mMipLevels, m_irradiance.mLayers) +
+                                 getImageSize(m_prefiltered.mExtent, m_prefiltered.mMipLevels, m_prefiltered.mLayers) +
+                                 getImageSize(m_brdfLut.mExtent, m_brdfLut.mMipLevels, m_brdfLut.mLayers);
+        bufferInfo.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!bake.mReadbackBuffer.createHostVisible(device, bufferInfo, nullptr, 0, true))
+        {
+            VK_LOG_ERROR("EnvironmentLighting :: failed to create readback buffer");
+            return false;
+        }
+
+        // recorded after the ownership acquire of the source, on the graphics queue
+        VkCommandBuffer commandBuffer = stagingBelt.getGraphicsCommandBuffer();
+        if (commandBuffer == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("EnvironmentLighting :: failed to get staging belt graphics command buffer");
+            return false;
+        }
+        return recordBake(commandBuffer, samplers, bake);
+    }
+
+    bool EnvironmentLighting::uploadSource(VulkanStagingBelt& stagingBelt, const std::filesystem::path& environmentFile, BakeResources& bake) noexcept
+    {
+        // hdr pixels converted to half floats, or the procedural sky
+        std::vector<uint64_t> pixels;
+        VkExtent2D extent = { kSkyWidth, kSkyHeight };
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::vector<uint8_t> packedStorage;
+        const uint8_t* packedData = nullptr;
+        size_t packedSize = 0;
+        float* hdrPixels = nullptr;
+        if (!environmentFile.empty() && AssetPack::getInstance().load(environmentFile, packedStorage, packedData, packedSize))
+        {
+            hdrPixels = stbi_loadf_from_memory(packedData, static_cast<int>(packedSize), &width, &height, &channels, 4);
+        }
+        else if (!environmentFile.empty())
+        {
+            hdrPixels = stbi_loadf(environmentFile.string().c_str(), &width, &height, &channels, 4);
+        }
+        if (hdrPixels != nullptr && width > 0 && height > 0)
+        {
+            extent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+            pixels.resize(static_cast<size_t>(width) * height);
+            for (size_t i = 0; i < pixels.size(); ++i)
+            {
+                pixels[i] = glm::packHalf4x16(glm::vec4(hdrPixels[i * 4 + 0], hdrPixels[i * 4 + 1], hdrPixels[i * 4 + 2], 1.0f));
+            }
+        }
+        else
+        {
+            if (!environmentFile.empty())
+            {
+                VK_LOG_WARN("EnvironmentLighting :: failed to load %s, using the procedural sky", environmentFile.string().c_str());
+            }
+            pixels = generateSky();
+        }
+        stbi_image_free(hdrPixels);
+
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        if (!stagingBelt.stage(pixels.data(), pixels.size() * sizeof(uint64_t), kTexelSize, stagingBuffer, stagingOffset))
+        {
+            VK_LOG_ERROR("EnvironmentLighting :: failed to stage the environment");
+            return false;
+        }
+
+        if (!createImage(bake.mSource, extent, 1, 1, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT))
+        {
+            return false;
+        }
+
+        VkImageSubresourceRange subresourceRange{};
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = 0;
+        subresourceRange.levelCount     = 1;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = 1;
+
+        const std::vector<VkBufferImageCopy> copies = getLevelCopies(extent, 1, 1, stagingOffset);
+        if (!stagingBelt.copyToImage(stagingBuffer, bake.mSource.mImage, subresourceRange, static_cast<uint32_t>(copies.size()), copies.data()))
+        {
+            return false;
+        }
+
+        stagingBelt.transferImageOwnership(bake.mSource.mImage, subresourceRange,
+                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                           VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+        return true;
+    }
+
+    bool EnvironmentLighting::createBakePipelines(const VulkanDevice& device, BakeResources& bake) noexcept
+    {
+        // set: 0, bindings: sampled input, storage output
+        const std::array<VkDescriptorSetLayoutBinding, 2> bindings
+        {{
+            { kInputBinding,  VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kOutputBinding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = nullptr;
+        layoutInfo.flags        = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings    = bindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &bake.mDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("EnvironmentLighting :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // private pool released with the bake
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kBakeSetCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          kBakeSetCount }
+        }};
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = kBakeSetCount;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &bake.mDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("EnvironmentLighting :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // missing spir-v is not fatal; the maps stay black and shading falls back to flat ambient
+        for (uint32_t pass = 0; pass < kBakePassCount; ++pass)
+        {
+            VulkanShader computeShader;
+            if (!computeShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, kBakeShaders[pass]))
+            {
+                VK_LOG_WARN("EnvironmentLighting :: compute shader '%s' unavailable", kBakeShaders[pass]);
+                return false;
+            }
+
+            ComputePipelineConfig pipelineConfig{};
+            pipelineConfig.mShaderStage          = computeShader.getShaderStageInfo();
+            pipelineConfig.mDescriptorSetLayouts = { bake.mDescriptorSetLayout };
+            pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(BakePushConstants) } };
+            if (!bake.mPipelines[pass].initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+            {
+                VK_LOG_ERROR("EnvironmentLighting :: failed to create compute pipeline for '%s'", kBakeShaders[pass]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool EnvironmentLighting::recordBake(VkCommandBuffer commandBuffer, const VulkanSamplers& samplers, BakeResources& bake) noexcept
+    {
+        // descriptor set per dispatch: (sampled input, storage output view)
+        struct Dispatch
+        {
+            BakePass        mPass;
+            VkImageView     mInput;
+            VkSampler       mSampler;
+            const Image*    mOutput;
+            uint32_t        mLevel;
+            glm::vec4       mParams;
+        };
+
+        const float environmentMips = float(bake.mEnvironment.mMipLevels);
+        const VkSampler cubeSampler = samplers.get(VulkanSamplers::Type::LinearClamp);
+        std::vector<Dispatch> dispatches;
+        dispatches.push_back({ kEquirectPass, bake.mSource.mView, samplers.get(VulkanSamplers::Type::LinearRepeat), &bake.mEnvironment, 0, glm::vec4(0.0f) });
+        dispatches.push_back({ kIrradiancePass, bake.mEnvironment.mView, cubeSampler, &m_irradiance, 0,
+                               glm::vec4(0.0f, float(kEnvironmentSize), float(kIrradianceSamples), environmentMips) });
+        for (uint32_t level = 0; level < kPrefilteredMipLevels; ++level)
+        {
+            const float roughness = float(level) / float(kPrefilteredMipLevels - 1);
+            dispatches.push_back({ kPrefilterPass, bake.mEnvironment.mView, cubeSampler, &m_prefiltered, level,
+                                   glm::vec4(roughness, float(kEnvironmentSize), float(kPrefilterSamples), environmentMips) });
+        }
+        dispatches.push_back({ kBrdfLutPass, bake.mEnvironment.mView, cubeSampler, &m_brdfLut, 0, glm::vec4(0.0f, 0.0f, float(kBrdfLutSamples), 0.0f) });
+
+        std::array<VkDescriptorSetLayout, kBakeSetCount> layouts;
+        layouts.fill(bake.mDescriptorSetLayout);
+        std::array<VkDescriptorSet, kBakeSetCount> descriptorSets{};
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = bake.mDescriptorPool;
+        allocateInfo.descriptorSetCount = kBakeSetCount;
+        allocateInfo.pSetLayouts        = layouts.data();
+
+        VkResult vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, descriptorSets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("EnvironmentLighting :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        for (size_t i = 0; i < dispatches.size(); ++i)
+        {
+            const Dispatch& dispatch = dispatches[i];
+            const VkImageView storageView = createView(*dispatch.mOutput, dispatch.mOutput->mLayers == kCubeFaces ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
+                                                       dispatch.mLevel, 1);
+            if (storageView == VK_NULL_HANDLE)
+            {
+                return false;
+            }
+            bake.mStorageViews.push_back(storageView);
+
+            const VkDescriptorImageInfo imageInfos[2] =
+            {
+                { dispatch.mSampler, dispatch.mInput, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL },
+                { VK_NULL_HANDLE,    storageView,     VK_IMAGE_LAYOUT_GENERAL }
+            };
+
+            std::array<VkWriteDescriptorSet, 2> writes{};
+            for (uint32_t j = 0; j < writes.size(); ++j)
+            {
+                writes[j].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[j].pNext            = nullptr;
+                writes[j].dstSet           = descriptorSets[i];
+                writes[j].dstBinding       = j == 0 ? kInputBinding : kOutputBinding;
+                writes[j].dstArrayElement  = 0;
+                writes[j].descriptorCount  = 1;
+                writes[j].descriptorType   = j == 0 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                writes[j].pImageInfo       = &imageInfos[j];
+                writes[j].pBufferInfo      = nullptr;
+                writes[j].pTexelBufferView = nullptr;
+            }
+            vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        // every written image starts in general for storage writes
+        const Image& environment = bake.mEnvironment;
+        const Image* writtenImages[] = { &environment, &m_irradiance, &m_prefiltered, &m_brdfLut };
+        for (const Image* image : writtenImages)
+        {
+            imageBarrier(commandBuffer, image->mImage, 0, image->mMipLevels, image->mLayers, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                         0, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+        }
+
+        auto recordDispatch = [&](size_t index)
+        {
+            const Dispatch& dispatch = dispatches[index];
+            const uint32_t size = std::max(dispatch.mOutput->mExtent.width >> dispatch.mLevel, 1u);
+            const BakePushConstants pushConstants{ dispatch.mParams };
+            const VulkanPipeline& pipeline = bake.mPipelines[dispatch.mPass];
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.get());
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.getLayout(), 0, 1, &descriptorSets[index], 0, nullptr);
+            vkCmdPushConstants(commandBuffer, pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(BakePushConstants), &pushConstants);
+            vkCmdDispatch(commandBuffer, getGroupCount(size), getGroupCount(size), dispatch.mOutput->mLayers);
+        };
+
+        // resample the source into the environment's level 0
+        recordDispatch(0);
+
+        // environment mips by linear blits, level after level, then the whole chain is sampled by the filters
+        imageBarrier(commandBuffer, environment.mImage, 0, 1, kCubeFaces, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                     VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        for (uint32_t level = 1; level < environment.mMipLevels; ++level)
+        {
+            imageBarrier(commandBuffer, environment.mImage, level, 1, kCubeFaces, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                         0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+            const int32_t srcSize = static_cast<int32_t>(std::max(kEnvironmentSize >> (level - 1), 1u));
+            const int32_t dstSize = static_cast<int32_t>(std::max(kEnvironmentSize >> level, 1u));
+            VkImageBlit blit{};
+            blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, kCubeFaces };
+            blit.srcOffsets[1]  = { srcSize, srcSize, 1 };
+            blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, kCubeFaces };
+            blit.dstOffsets[1]  = { dstSize, dstSize, 1 };
+            vkCmdBlitImage(commandBuffer, environment.mImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, environment.mImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1, &blit, VK_FILTER_LINEAR);
+
+            imageBarrier(commandBuffer, environment.mImage, level, 1, kCubeFaces, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                         VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        }
+        imageBarrier(commandBuffer, environment.mImage, 0, environment.mMipLevels, kCubeFaces, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                     VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+        // irradiance, prefiltered levels and the lut are independent of each other
+        for (size_t i = 1; i < dispatches.size(); ++i)
+        {
+            recordDispatch(i);
+        }
+
+        // read back for the cache, then hand the maps to the fragment stage
+        VkDeviceSize readbackOffset = 0;
+        for (const Image* target : { &m_irradiance, &m_prefiltered, &m_brdfLut })
+        {
+            imageBarrier(commandBuffer, target->mImage, 0, target->mMipLevels, target->mLayers, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                         VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+            const std::vector<VkBufferImageCopy> copies = getLevelCopies(target->mExtent, target->mMipLevels, target->mLayers, readbackOffset);
+            vkCmdCopyImageToBuffer(commandBuffer, target->mImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, bake.mReadbackBuffer.get(),
+                                   static_cast<uint32_t>(copies.size()), copies.data());
+            readbackOffset += getImageSize(target->mExtent, target->mMipLevels, target->mLayers);
+
+            imageBarrier(commandBuffer, target->mImage, 0, target->mMipLevels, target->mLayers, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                         0, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+        }
+
+        VkBufferMemoryBarrier readbackBarrier{};
+        readbackBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        readbackBarrier.pNext               = nullptr;
+        readbackBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        readbackBarrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+        readbackBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        readbackBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        readbackBarrier.buffer              = bake.mReadbackBuffer.get();
+        readbackBarrier.offset              = 0;
+        readbackBarrier.size                = VK_WHOLE_SIZE;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &readbackBarrier, 0, nullptr);
+        return true;
+    }
+
+    void EnvironmentLighting::destroyBake(BakeResources& bake) noexcept
+    {
+        for (VkImageView imageView : bake.mStorageViews)
+        {
+            vkDestroyImageView(m_vkDevice, imageView, nullptr);
+        }
+        bake.mStorageViews.clear();
+
+        for (auto& pipeline : bake.mPipelines)
+        {
+            pipeline.destroy();
+        }
+
+        // descriptor sets are freed with their pool
+        if (bake.mDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, bake.mDescriptorPool, nullptr);
+            bake.mDescriptorPool = VK_NULL_HANDLE;
+        }
+
+        if (bake.mDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(m_vkDevice, bake.mDescriptorSetLayout, nullptr);
+            bake.mDescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        destroyImage(bake.mSource);
+        destroyImage(bake.mEnvironment);
+        bake.mReadbackBuffer = VulkanBuffer{};
+    }
+
+    void EnvironmentLighting::recordClear(VkCommandBuffer commandBuffer) noexcept
+    {
+        const VkClearColorValue black = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+        for (const Image* target : { &m_irradiance, &m_prefiltered, &m_brdfLut })
+        {
+            imageBarrier(commandBuffer, target->mImage, 0, target->mMipLevels, target->mLayers, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                         0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+            VkImageSubresourceRange subresourceRange{};
+            subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            subresourceRange.baseMipLevel   = 0;
+            subresourceRange.levelCount     = target->mMipLevels;
+            subresourceRange.baseArrayLayer = 0;
+            subresourceRange.layerCount     = target->mLayers;
+            vkCmdClearColorImage(commandBuffer, target->mImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &black, 1, &subresourceRange);
+
+            imageBarrier(commandBuffer, target->mImage, 0, target->mMipLevels, target->mLayers, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                         VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+        }
+    }
+}   // namespace keplar
@@ -0,0 +1,116 @@
+// ────────────────────────────────────────────
+//  File: environment_lighting.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class VulkanStagingBelt;
+    class VulkanSamplers;
+
+    // precomputed image-based lighting for the split-sum approximation: a diffuse irradiance cubemap, a ggx-prefiltered
+    // specular cubemap with one roughness per mip, and the brdf scale/bias lut (ibl_*.comp). bakes run once on the
+    // graphics queue and are cached to disk, so later runs only upload them and shading costs three fetches per pixel.
+    // the environment is an equirectangular hdr file, or a procedural sky when none is given
+    class EnvironmentLighting final
+    {
+        public:
+            // baked sizes; every image is rgba16f (the only 16-bit float storage format every device supports)
+            static constexpr uint32_t kEnvironmentSize      = 512;     // intermediate cubemap face resampled from the source
+            static constexpr uint32_t kIrradianceSize       = 32;
+            static constexpr uint32_t kPrefilteredSize      = 128;
+            static constexpr uint32_t kPrefilteredMipLevels = 5;       // roughness 0 to 1, the last level is 8x8
+            static constexpr uint32_t kBrdfLutSize          = 256;
+
+            // creation and destruction
+            EnvironmentLighting() noexcept;
+            ~EnvironmentLighting();
+
+            // disable copy and move semantics to enforce unique ownership
+            EnvironmentLighting(const EnvironmentLighting&) = delete;
+            EnvironmentLighting& operator=(const EnvironmentLighting&) = delete;
+            EnvironmentLighting(EnvironmentLighting&&) = delete;
+            EnvironmentLighting& operator=(EnvironmentLighting&&) = delete;
+
+            // false when neither the cache nor a bake produced the maps; hasImages() then still holds black maps that can
+            // stay bound. environmentFile may be empty for the procedural sky. flushes the belt before returning
+            bool initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const VulkanSamplers& samplers,
+                            const std::filesystem::path& environmentFile, const std::filesystem::path& cachePath) noexcept;
+            void destroy() noexcept;
+
+            // accessors
+            bool isValid() const noexcept                       { return m_isValid; }
+            bool hasImages() const noexcept                     { return m_brdfLut.mView != VK_NULL_HANDLE; }
+            VkImageView getIrradianceView() const noexcept      { return m_irradiance.mView; }
+            VkImageView getPrefilteredView() const noexcept     { return m_prefiltered.mView; }
+            VkImageView getBrdfLutView() const noexcept         { return m_brdfLut.mView; }
+
+        private:
+            // device-local rgba16f image with its sampled view (cube views for six-layer images)
+            struct Image
+            {
+                VkImage             mImage = VK_NULL_HANDLE;
+                VkImageView         mView = VK_NULL_HANDLE;
+                VulkanAllocation    mAllocation;
+                VkExtent2D          mExtent = { 0, 0 };
+                uint32_t            mMipLevels = 0;
+                uint32_t            mLayers = 0;
+            };
+
+            // baking resources released once the bake has completed
+            struct BakeResources
+            {
+                Image                           mSource;
+                Image                           mEnvironment;
+                VkDescriptorSetLayout           mDescriptorSetLayout = VK_NULL_HANDLE;
+                VkDescriptorPool                mDescriptorPool = VK_NULL_HANDLE;
+                std::vector<VkImageView>        mStorageViews;
+                std::array<VulkanPipeline, 4>   mPipelines;
+                VulkanBuffer                    mReadbackBuffer;
+            };
+
+            bool createImage(Image& image, VkExtent2D extent, uint32_t mipLevels, uint32_t layers, VkImageUsageFlags usage) noexcept;
+            VkImageView createView(const Image& image, VkImageViewType viewType, uint32_t baseMipLevel, uint32_t levelCount) noexcept;
+            void destroyImage(Image& image) noexcept;
+            bool createTargets() noexcept;
+
+            // cache: raw level data of the three maps, keyed by the source file
+            bool loadCache(VulkanStagingBelt& stagingBelt, const std::filesystem::path& cachePath, const std::filesystem::path& environmentFile) noexcept;
+            bool saveCache(const BakeResources& bake, const std::filesystem::path& cachePath, const std::filesystem::path& environmentFile) const noexcept;
+
+            // bake: source upload, then equirect resample, environment mips, irradiance, prefilter and lut passes
+            bool bake(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const VulkanSamplers& samplers,
+                      const std::filesystem::path& environmentFile, BakeResources& bake) noexcept;
+            bool uploadSource(VulkanStagingBelt& stagingBelt, const std::filesystem::path& environmentFile, BakeResources& bake) noexcept;
+            bool createBakePipelines(const VulkanDevice& device, BakeResources& bake) noexcept;
+            bool recordBake(VkCommandBuffer commandBuffer, const VulkanSamplers& samplers, BakeResources& bake) noexcept;
+            void destroyBake(BakeResources& bake) noexcept;
+
+            // black maps for a failed bake, so the descriptors stay valid
+            void recordClear(VkCommandBuffer commandBuffer) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                m_vkDevice;
+            VulkanMemoryAllocator*  m_memoryAllocator;
+
+            // baked maps sampled by the fragment stage
+            Image                   m_irradiance;
+            Image                   m_prefiltered;
+            Image                   m_brdfLut;
+            bool                    m_isValid;
+    };
+}   // namespace keplar
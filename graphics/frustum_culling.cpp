@@ -0,0 +1,252 @@
+// ────────────────────────────────────────────
+//  File: frustum_culling.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "frustum_culling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "utils/thread_pool.hpp"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace
+{
+    // one box: outside once the center lies further behind a plane than the box reaches toward it
+    inline bool testBox(const keplar::CullingFrustum& frustum, const keplar::CullingBounds& bounds, uint32_t index) noexcept
+    {
+        const float centerX = bounds.getCenterX()[index];
+        const float centerY = bounds.getCenterY()[index];
+        const float centerZ = bounds.getCenterZ()[index];
+        const float extentX = bounds.getExtentX()[index];
+        const float extentY = bounds.getExtentY()[index];
+        const float extentZ = bounds.getExtentZ()[index];
+        for (int plane = 0; plane < keplar::Frustum::kPlaneCount; ++plane)
+        {
+            const float distance = frustum.mNormalX[plane] * centerX + frustum.mNormalY[plane] * centerY + frustum.mNormalZ[plane] * centerZ + frustum.mDistance[plane];
+            const float radius = frustum.mAbsNormalX[plane] * extentX + frustum.mAbsNormalY[plane] * extentY + frustum.mAbsNormalZ[plane] * extentZ;
+            if (distance + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // a batch of kCullingBatchSize boxes from first: bit i set when box first + i touches the frustum. the planes are
+    // tested without early out, a batch is only skipped once every lane is outside some plane
+#if defined(__AVX2__)
+    inline uint32_t testBatch(const keplar::CullingFrustum& frustum, const keplar::CullingBounds& bounds, uint32_t first) noexcept
+    {
+        const __m256 centerX = _mm256_loadu_ps(bounds.getCenterX() + first);
+        const __m256 centerY = _mm256_loadu_ps(bounds.getCenterY() + first);
+        const __m256 centerZ = _mm256_loadu_ps(bounds.getCenterZ() + first);
+        const __m256 extentX = _mm256_loadu_ps(bounds.getExtentX() + first);
+        const __m256 extentY = _mm256_loadu_ps(bounds.getExtentY() + first);
+        const __m256 extentZ = _mm256_loadu_ps(bounds.getExtentZ() + first);
+        const __m256 zero = _mm256_setzero_ps();
+
+        __m256 outside = zero;
+        for (int plane = 0; plane < keplar::Frustum::kPlaneCount; ++plane)
+        {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(frustum.mNormalX[plane]), centerX), _mm256_set1_ps(frustum.mDistance[plane]));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(frustum.mNormalY[plane]), centerY));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(frustum.mNormalZ[plane]), centerZ));
+            __m256 radius = _mm256_mul_ps(_mm256_set1_ps(frustum.mAbsNormalX[plane]), extentX);
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(frustum.mAbsNormalY[plane]), extentY));
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(frustum.mAbsNormalZ[plane]), extentZ));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+        }
+        return ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xffu;
+    }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    inline uint32_t testBatch(const keplar::CullingFrustum& frustum, const keplar::CullingBounds& bounds, uint32_t first) noexcept
+    {
+        const __m128 centerX = _mm_loadu_ps(bounds.getCenterX() + first);
+        const __m128 centerY = _mm_loadu_ps(bounds.getCenterY() + first);
+        const __m128 centerZ = _mm_loadu_ps(bounds.getCenterZ() + first);
+        const __m128 extentX = _mm_loadu_ps(bounds.getExtentX() + first);
+        const __m128 extentY = _mm_loadu_ps(bounds.getExtentY() + first);
+        const __m128 extentZ = _mm_loadu_ps(bounds.getExtentZ() + first);
+        const __m128 zero = _mm_setzero_ps();
+
+        __m128 outside = zero;
+        for (int plane = 0; plane < keplar::Frustum::kPlaneCount; ++plane)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.mNormalX[plane]), centerX), _mm_set1_ps(frustum.mDistance[plane]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(frustum.mNormalY[plane]), centerY));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(frustum.mNormalZ[plane]), centerZ));
+            __m128 radius = _mm_mul_ps(_mm_set1_ps(frustum.mAbsNormalX[plane]), extentX);
+            radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(frustum.mAbsNormalY[plane]), extentY));
+            radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(frustum.mAbsNormalZ[plane]), extentZ));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+        return ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xfu;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    inline uint32_t testBatch(const keplar::CullingFrustum& frustum, const keplar::CullingBounds& bounds, uint32_t first) noexcept
+    {
+        const float32x4_t centerX = vld1q_f32(bounds.getCenterX() + first);
+        const float32x4_t centerY = vld1q_f32(bounds.getCenterY() + first);
+        const float32x4_t centerZ = vld1q_f32(bounds.getCenterZ() + first);
+        const float32x4_t extentX = vld1q_f32(bounds.getExtentX() + first);
+        const float32x4_t extentY = vld1q_f32(bounds.getExtentY() + first);
+        const float32x4_t extentZ = vld1q_f32(bounds.getExtentZ() + first);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (int plane = 0; plane < keplar::Frustum::kPlaneCount; ++plane)
+        {
+            float32x4_t distance = vaddq_f32(vmulq_n_f32(centerX, frustum.mNormalX[plane]), vdupq_n_f32(frustum.mDistance[plane]));
+            distance = vaddq_f32(distance, vmulq_n_f32(centerY, frustum.mNormalY[plane]));
+            distance = vaddq_f32(distance, vmulq_n_f32(centerZ, frustum.mNormalZ[plane]));
+            float32x4_t radius = vmulq_n_f32(extentX, frustum.mAbsNormalX[plane]);
+            radius = vaddq_f32(radius, vmulq_n_f32(extentY, frustum.mAbsNormalY[plane]));
+            radius = vaddq_f32(radius, vmulq_n_f32(extentZ, frustum.mAbsNormalZ[plane]));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, radius), zero));
+        }
+
+        // no movemask on neon: weight each lane's bit and sum across
+        static const uint32_t kLaneBits[4] = { 1u, 2u, 4u, 8u };
+        return vaddvq_u32(vbicq_u32(vld1q_u32(kLaneBits), outside));
+    }
+#else
+    inline uint32_t testBatch(const keplar::CullingFrustum& frustum, const keplar::CullingBounds& bounds, uint32_t first) noexcept
+    {
+        return testBox(frustum, bounds, first) ? 1u : 0u;
+    }
+#endif
+}
+
+namespace keplar
+{
+    CullingFrustum CullingFrustum::fromFrustum(const Frustum& frustum) noexcept
+    {
+        CullingFrustum culling{};
+        for (int plane = 0; plane < Frustum::kPlaneCount; ++plane)
+        {
+            const glm::vec4& source = frustum.mPlanes[plane];
+            culling.mNormalX[plane]    = source.x;
+            culling.mNormalY[plane]    = source.y;
+            culling.mNormalZ[plane]    = source.z;
+            culling.mAbsNormalX[plane] = std::abs(source.x);
+            culling.mAbsNormalY[plane] = std::abs(source.y);
+            culling.mAbsNormalZ[plane] = std::abs(source.z);
+            culling.mDistance[plane]   = source.w;
+        }
+        return culling;
+    }
+
+    void CullingBounds::clear() noexcept
+    {
+        m_centerX.clear();
+        m_centerY.clear();
+        m_centerZ.clear();
+        m_extentX.clear();
+        m_extentY.clear();
+        m_extentZ.clear();
+    }
+
+    void CullingBounds::reserve(size_t capacity)
+    {
+        m_centerX.reserve(capacity);
+        m_centerY.reserve(capacity);
+        m_centerZ.reserve(capacity);
+        m_extentX.reserve(capacity);
+        m_extentY.reserve(capacity);
+        m_extentZ.reserve(capacity);
+    }
+
+    void CullingBounds::resize(size_t count)
+    {
+        m_centerX.resize(count, 0.0f);
+        m_centerY.resize(count, 0.0f);
+        m_centerZ.resize(count, 0.0f);
+        m_extentX.resize(count, std::numeric_limits<float>::lowest());
+        m_extentY.resize(count, std::numeric_limits<float>::lowest());
+        m_extentZ.resize(count, std::numeric_limits<float>::lowest());
+    }
+
+    void CullingBounds::push(const BoundingBox& bounds)
+    {
+        resize(m_centerX.size() + 1);
+        set(size() - 1, bounds);
+    }
+
+    void CullingBounds::set(uint32_t index, const BoundingBox& bounds) noexcept
+    {
+        // an empty box gets the most negative extent: every plane with a normal sees it fully behind
+        const bool isValid = bounds.isValid();
+        const glm::vec3 center = isValid ? bounds.getCenter() : glm::vec3(0.0f);
+        const glm::vec3 extent = isValid ? bounds.getExtent() : glm::vec3(std::numeric_limits<float>::lowest());
+        m_centerX[index] = center.x;
+        m_centerY[index] = center.y;
+        m_centerZ[index] = center.z;
+        m_extentX[index] = extent.x;
+        m_extentY[index] = extent.y;
+        m_extentZ[index] = extent.z;
+    }
+
+    uint32_t cullBounds(const CullingFrustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* visible) noexcept
+    {
+        // full batches, then the remainder one box at a time. every lane is written and the count only advances past
+        // visible ones, so compaction has no branch to mispredict; the write stays inside the output since count never
+        // passes the lane's own index
+        uint32_t count = 0;
+        uint32_t index = begin;
+        for (; index + kCullingBatchSize <= end; index += kCullingBatchSize)
+        {
+            const uint32_t mask = testBatch(frustum, bounds, index);
+            for (uint32_t lane = 0; lane < kCullingBatchSize; ++lane)
+            {
+                visible[count] = index + lane;
+                count += (mask >> lane) & 1u;
+            }
+        }
+
+        for (; index < end; ++index)
+        {
+            visible[count] = index;
+            count += testBox(frustum, bounds, index) ? 1 : 0;
+        }
+        return count;
+    }
+
+    uint32_t cullBounds(const CullingFrustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible, ThreadPool* threadPool)
+    {
+        const uint32_t boundsCount = bounds.size();
+        const uint32_t chunkCount = (boundsCount + kCullingChunkSize - 1) / kCullingChunkSize;
+        visible.resize(boundsCount);
+        if (!threadPool || chunkCount < 2)
+        {
+            visible.resize(cullBounds(frustum, bounds, 0, boundsCount, visible.data()));
+            return static_cast<uint32_t>(visible.size());
+        }
+
+        // every chunk writes its visible indices at its own offset, then one pass closes the gaps between chunks
+        std::vector<uint32_t> chunkCounts(chunkCount, 0);
+        threadPool->parallelFor(TaskPriority::kFrameCritical, chunkCount, 1, [&](size_t chunk)
+        {
+            const uint32_t begin = static_cast<uint32_t>(chunk) * kCullingChunkSize;
+            const uint32_t end = std::min(boundsCount, begin + kCullingChunkSize);
+            chunkCounts[chunk] = cullBounds(frustum, bounds, begin, end, visible.data() + begin);
+        }).wait();
+
+        uint32_t visibleCount = chunkCounts[0];
+        for (uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+        {
+            const auto first = visible.begin() + chunk * kCullingChunkSize;
+            std::copy(first, first + chunkCounts[chunk], visible.begin() + visibleCount);
+            visibleCount += chunkCounts[chunk];
+        }
+        visible.resize(visibleCount);
+        return visibleCount;
+    }
+}   // namespace keplar
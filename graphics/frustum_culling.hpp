@@ -0,0 +1,88 @@
+// ────────────────────────────────────────────
+//  File: frustum_culling.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "math3d.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class ThreadPool;
+
+    // boxes one kernel step tests: 8 with avx2, 4 with sse2 or neon, 1 on other targets. picked at compile time, so an
+    // avx2 kernel needs the build to target it (-mavx2, /arch:AVX2)
+#if defined(__AVX2__)
+    inline constexpr uint32_t kCullingBatchSize = 8;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || (defined(__ARM_NEON) && defined(__aarch64__))
+    inline constexpr uint32_t kCullingBatchSize = 4;
+#else
+    inline constexpr uint32_t kCullingBatchSize = 1;
+#endif
+
+    // boxes one pool task culls when the work is split across a thread pool
+    inline constexpr uint32_t kCullingChunkSize = 8192;
+
+    // frustum planes split into components, each broadcast to a whole register when a batch of boxes is tested
+    struct CullingFrustum
+    {
+        std::array<float, Frustum::kPlaneCount> mNormalX{};
+        std::array<float, Frustum::kPlaneCount> mNormalY{};
+        std::array<float, Frustum::kPlaneCount> mNormalZ{};
+        std::array<float, Frustum::kPlaneCount> mAbsNormalX{};
+        std::array<float, Frustum::kPlaneCount> mAbsNormalY{};
+        std::array<float, Frustum::kPlaneCount> mAbsNormalZ{};
+        std::array<float, Frustum::kPlaneCount> mDistance{};
+
+        static CullingFrustum fromFrustum(const Frustum& frustum) noexcept;
+    };
+
+    // axis-aligned boxes as separate center and extent arrays (structure of arrays), so one load fills a register with
+    // the same coordinate of consecutive boxes. invalid boxes are stored so that they fail every plane
+    class CullingBounds final
+    {
+        public:
+            // creation and destruction
+            CullingBounds() = default;
+            ~CullingBounds() = default;
+
+            // usage
+            void clear() noexcept;
+            void reserve(size_t capacity);
+            void resize(size_t count);
+            void push(const BoundingBox& bounds);
+            void set(uint32_t index, const BoundingBox& bounds) noexcept;
+
+            // accessors
+            uint32_t size() const noexcept          { return static_cast<uint32_t>(m_centerX.size()); }
+            bool empty() const noexcept             { return m_centerX.empty(); }
+            const float* getCenterX() const noexcept { return m_centerX.data(); }
+            const float* getCenterY() const noexcept { return m_centerY.data(); }
+            const float* getCenterZ() const noexcept { return m_centerZ.data(); }
+            const float* getExtentX() const noexcept { return m_extentX.data(); }
+            const float* getExtentY() const noexcept { return m_extentY.data(); }
+            const float* getExtentZ() const noexcept { return m_extentZ.data(); }
+
+        private:
+            std::vector<float> m_centerX;
+            std::vector<float> m_centerY;
+            std::vector<float> m_centerZ;
+            std::vector<float> m_extentX;
+            std::vector<float> m_extentY;
+            std::vector<float> m_extentZ;
+    };
+
+    // tests boxes [begin, end) against the frustum and writes the indices of those touching it to visible, ascending;
+    // returns their count. visible must hold end - begin indices. conservative like Frustum::intersectsBox
+    uint32_t cullBounds(const CullingFrustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* visible) noexcept;
+
+    // the same over every box into visible (resized to the count). with a pool and more than one chunk of boxes, the
+    // chunks are culled by its workers and compacted in order afterwards; the call returns once all are done
+    uint32_t cullBounds(const CullingFrustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible,
+                        ThreadPool* threadPool = nullptr);
+}   // namespace keplar
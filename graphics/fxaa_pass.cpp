@@ -0,0 +1,234 @@
+// ────────────────────────────────────────────
+//  File: fxaa_pass.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "fxaa_pass.hpp"
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // must match local_size_x/y of fxaa.comp
+    constexpr uint32_t kFxaaWorkgroupSize = 8;
+
+    // push constants: must match fxaa.comp
+    struct FxaaPushConstants
+    {
+        glm::uvec4 extents;     // xy: rendered region, zw: image extent
+        glm::vec4  params;      // x: sub-pixel quality, y: edge threshold, z: minimum edge threshold
+    };
+}
+
+namespace keplar
+{
+    FxaaPass::FxaaPass() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSet(VK_NULL_HANDLE)
+        , m_extent{}
+    {
+    }
+
+    FxaaPass::~FxaaPass()
+    {
+        destroy();
+    }
+
+    bool FxaaPass::initialize(const VulkanDevice& device, const FxaaPassShaders& shaders, VkExtent2D extent) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_extent = extent;
+        if (extent.width == 0 || extent.height == 0)
+        {
+            VK_LOG_ERROR("FxaaPass::initialize :: invalid extent");
+            destroy();
+            return false;
+        }
+
+        // the edge search walks the source with bilinear taps
+        if (!device.isFormatSupported(kFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                               VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+        {
+            VK_LOG_ERROR("FxaaPass::initialize :: %s cannot be a filtered storage image", string_VkFormat(kFormat));
+            destroy();
+            return false;
+        }
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_LINEAR;
+        samplerInfo.minFilter    = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = 0.0f;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createDescriptorResources(device) || !createPipeline(device, shaders))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("FxaaPass::initialize successful (%ux%u)", extent.width, extent.height);
+        return true;
+    }
+
+    void FxaaPass::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // the set is freed with its pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDescriptorSet = VK_NULL_HANDLE;
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_extent = {};
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("fxaa pass destroyed successfully");
+    }
+
+    void FxaaPass::bindImages(VkImageView sourceView, VkImageView destinationView) noexcept
+    {
+        if (m_vkDescriptorSet == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        const VkDescriptorImageInfo sourceInfo{ m_vkSampler, sourceView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo destinationInfo{ VK_NULL_HANDLE, destinationView, VK_IMAGE_LAYOUT_GENERAL };
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet          = m_vkDescriptorSet;
+        writes[0].dstBinding      = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo      = &sourceInfo;
+        writes[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet          = m_vkDescriptorSet;
+        writes[1].dstBinding      = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo      = &destinationInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void FxaaPass::record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const FxaaSettings& settings) noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        // the render graph transitions and synchronizes source and destination
+        renderExtent = { std::clamp(renderExtent.width, 1u, m_extent.width), std::clamp(renderExtent.height, 1u, m_extent.height) };
+
+        FxaaPushConstants pushConstants{};
+        pushConstants.extents = glm::uvec4(renderExtent.width, renderExtent.height, m_extent.width, m_extent.height);
+        pushConstants.params  = glm::vec4(glm::clamp(settings.mSubpixelQuality, 0.0f, 1.0f), settings.mEdgeThreshold, settings.mEdgeThresholdMin, 0.0f);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (renderExtent.width + kFxaaWorkgroupSize - 1) / kFxaaWorkgroupSize,
+                      (renderExtent.height + kFxaaWorkgroupSize - 1) / kFxaaWorkgroupSize, 1);
+    }
+
+    bool FxaaPass::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        m_vkSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("FxaaPass :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkSetLayout;
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &m_vkDescriptorSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("FxaaPass :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorSet = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool FxaaPass::createPipeline(const VulkanDevice& device, const FxaaPassShaders& shaders) noexcept
+    {
+        VulkanShader fxaaShader;
+        if (!fxaaShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mFxaaFile))
+        {
+            VK_LOG_ERROR("FxaaPass :: compute shader '%s' unavailable", shaders.mFxaaFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = fxaaShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FxaaPushConstants) } };
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("FxaaPass :: failed to create the fxaa pipeline");
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
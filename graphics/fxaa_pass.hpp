@@ -0,0 +1,80 @@
+// ────────────────────────────────────────────
+//  File: fxaa_pass.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the compute pass
+    struct FxaaPassShaders
+    {
+        std::string mFxaaFile;              // fxaa.comp
+    };
+
+    // per-frame controls
+    struct FxaaSettings
+    {
+        float mSubpixelQuality  = 0.75f;    // blend towards the neighbourhood on sub-pixel aliasing, [0, 1]
+        float mEdgeThreshold    = 0.166f;   // local contrast, relative to the brightest neighbour, an edge needs
+        float mEdgeThresholdMin = 0.0833f;  // absolute contrast below which dark regions are left alone
+    };
+
+    // post-process anti-aliasing for devices where neither msaa nor temporal aa fit the budget: one compute pass over
+    // the tonemapped, gamma-encoded display color (fxaa 3.11 quality). every pixel whose luma contrast crosses the
+    // thresholds is classified as a horizontal or vertical edge, the edge is searched along in both directions for its
+    // ends, and the pixel is resampled across the edge by its distance to the nearer end (or by the sub-pixel blend
+    // where that is larger). runs over the rendered region only (see dynamic resolution), after the post process and
+    // before the upscale pass. rebuilt with the render graph that owns the source and destination
+    class FxaaPass final
+    {
+        public:
+            static constexpr VkFormat kFormat = VK_FORMAT_R8G8B8A8_UNORM;     // PostProcess::kDestinationFormat
+
+            // creation and destruction
+            FxaaPass() noexcept;
+            ~FxaaPass();
+
+            // disable copy and move semantics to enforce unique ownership
+            FxaaPass(const FxaaPass&) = delete;
+            FxaaPass& operator=(const FxaaPass&) = delete;
+            FxaaPass(FxaaPass&&) = delete;
+            FxaaPass& operator=(FxaaPass&&) = delete;
+
+            // usage: extent is the one of the source and destination images
+            bool initialize(const VulkanDevice& device, const FxaaPassShaders& shaders, VkExtent2D extent) noexcept;
+            void destroy() noexcept;
+
+            // usage: source (kFormat) sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, destination (kFormat) written
+            // as a storage image in VK_IMAGE_LAYOUT_GENERAL
+            void bindImages(VkImageView sourceView, VkImageView destinationView) noexcept;
+
+            // usage: outside render passes; renderExtent is the region of the source the scene rendered into
+            void record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const FxaaSettings& settings) noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && m_vkDescriptorSet != VK_NULL_HANDLE; }
+
+        private:
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipeline(const VulkanDevice& device, const FxaaPassShaders& shaders) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkSampler                       m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout           m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorPool                m_vkDescriptorPool;
+            VkDescriptorSet                 m_vkDescriptorSet;
+            VulkanPipeline                  m_pipeline;
+            VkExtent2D                      m_extent;
+    };
+}   // namespace keplar
@@ -0,0 +1,250 @@
+// ────────────────────────────────────────────
+//  File: geometry_arena.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "geometry_arena.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // storage buffer range offsets at this granularity are valid on every device
+    constexpr uint32_t kStorageOffsetAlignment = 256;
+}
+
+namespace keplar
+{
+    GeometryArena::GeometryArena() noexcept
+        : m_vertexStride(0)
+        , m_vertexAlignment(1)
+        , m_vertexCapacity(0)
+        , m_indexCapacity(0)
+        , m_usedVertexCount(0)
+        , m_usedIndexCount(0)
+    {
+    }
+
+    GeometryArena::~GeometryArena()
+    {
+        destroy();
+    }
+
+    bool GeometryArena::initialize(const VulkanDevice& device, uint32_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity) noexcept
+    {
+        // validate layout and capacities
+        if (vertexStride == 0 || vertexCapacity == 0 || indexCapacity == 0)
+        {
+            VK_LOG_ERROR("GeometryArena::initialize :: invalid stride or capacity");
+            return false;
+        }
+
+        // vertex pool: bound for vertex input, fetched by the mesh stage and by address for vertex pulling
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                 (device.isBufferDeviceAddressEnabled() ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : 0);
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.size = static_cast<VkDeviceSize>(vertexStride) * vertexCapacity;
+        if (!m_vertexBuffer.createDeviceLocal(device, bufferCreateInfo))
+        {
+            VK_LOG_ERROR("GeometryArena::initialize :: failed to create vertex buffer (%u vertices)", vertexCapacity);
+            return false;
+        }
+
+        // index pool: uint32 indices relative to each range's first vertex, also read by acceleration structure builds
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                 (device.isRayQueryEnabled() ? (VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | 
+                                                                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) : 0);
+        bufferCreateInfo.size = static_cast<VkDeviceSize>(sizeof(uint32_t)) * indexCapacity;
+        if (!m_indexBuffer.createDeviceLocal(device, bufferCreateInfo))
+        {
+            VK_LOG_ERROR("GeometryArena::initialize :: failed to create index buffer (%u indices)", indexCapacity);
+            m_vertexBuffer = VulkanBuffer();
+            return false;
+        }
+
+        // the smallest vertex count whose byte size is a multiple of the storage offset alignment
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_vertexStride = vertexStride;
+        m_vertexAlignment = std::lcm(vertexStride, kStorageOffsetAlignment) / vertexStride;
+        m_vertexCapacity = vertexCapacity;
+        m_indexCapacity = indexCapacity;
+        m_freeVertices = { { 0, vertexCapacity } };
+        m_freeIndices = { { 0, indexCapacity } };
+        m_usedVertexCount = 0;
+        m_usedIndexCount = 0;
+
+        VK_LOG_DEBUG("GeometryArena::initialize successful (stride: %u, vertices: %u, indices: %u)", vertexStride, vertexCapacity, indexCapacity);
+        return true;
+    }
+
+    void GeometryArena::destroy() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_usedVertexCount > 0 || m_usedIndexCount > 0)
+        {
+            VK_LOG_WARN("GeometryArena::destroy :: released with live ranges (%u vertices, %u indices)", m_usedVertexCount, m_usedIndexCount);
+        }
+
+        m_vertexBuffer = VulkanBuffer();
+        m_indexBuffer = VulkanBuffer();
+        m_freeVertices.clear();
+        m_freeIndices.clear();
+        m_vertexCapacity = 0;
+        m_indexCapacity = 0;
+        m_usedVertexCount = 0;
+        m_usedIndexCount = 0;
+    }
+
+    bool GeometryArena::allocate(uint32_t vertexCount, uint32_t indexCount, GeometryRange& range) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!isValid())
+        {
+            return false;
+        }
+
+        // both ranges or neither
+        GeometryRange taken{};
+        if (vertexCount > 0 && !takeRange(m_freeVertices, vertexCount, m_vertexAlignment, taken.mFirstVertex))
+        {
+            return false;
+        }
+        if (indexCount > 0 && !takeRange(m_freeIndices, indexCount, 1, taken.mFirstIndex))
+        {
+            if (vertexCount > 0)
+            {
+                releaseRange(m_freeVertices, taken.mFirstVertex, vertexCount);
+            }
+            return false;
+        }
+
+        taken.mVertexCount = vertexCount;
+        taken.mIndexCount = indexCount;
+        m_usedVertexCount += vertexCount;
+        m_usedIndexCount += indexCount;
+        range = taken;
+        return true;
+    }
+
+    void GeometryArena::release(GeometryRange& range) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (range.mVertexCount > 0)
+        {
+            releaseRange(m_freeVertices, range.mFirstVertex, range.mVertexCount);
+            m_usedVertexCount -= range.mVertexCount;
+        }
+        if (range.mIndexCount > 0)
+        {
+            releaseRange(m_freeIndices, range.mFirstIndex, range.mIndexCount);
+            m_usedIndexCount -= range.mIndexCount;
+        }
+        range = GeometryRange{};
+    }
+
+    bool GeometryArena::upload(VulkanStagingBelt& stagingBelt, const GeometryRange& range, const void* vertices, const uint32_t* indices) const noexcept
+    {
+        if (range.mVertexCount > 0 && !stagingBelt.uploadBuffer(m_vertexBuffer.get(), vertices, static_cast<VkDeviceSize>(m_vertexStride) * range.mVertexCount,
+                                                                static_cast<VkDeviceSize>(m_vertexStride) * range.mFirstVertex))
+        {
+            VK_LOG_ERROR("GeometryArena::upload :: failed to stage %u vertices", range.mVertexCount);
+            return false;
+        }
+
+        if (range.mIndexCount > 0 && !stagingBelt.uploadBuffer(m_indexBuffer.get(), indices, sizeof(uint32_t) * static_cast<VkDeviceSize>(range.mIndexCount),
+                                                               sizeof(uint32_t) * static_cast<VkDeviceSize>(range.mFirstIndex)))
+        {
+            VK_LOG_ERROR("GeometryArena::upload :: failed to stage %u indices", range.mIndexCount);
+            return false;
+        }
+        return true;
+    }
+
+    void GeometryArena::bind(VkCommandBuffer commandBuffer) const noexcept
+    {
+        const VkBuffer vertexBuffer = m_vertexBuffer.get();
+        const VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer.get(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+    uint32_t GeometryArena::getUsedVertexCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_usedVertexCount;
+    }
+
+    uint32_t GeometryArena::getUsedIndexCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_usedIndexCount;
+    }
+
+    bool GeometryArena::takeRange(std::vector<FreeRange>& freeRanges, uint32_t count, uint32_t alignment, uint32_t& offset) noexcept
+    {
+        for (size_t i = 0; i < freeRanges.size(); ++i)
+        {
+            // first fit once the start is aligned
+            FreeRange& freeRange = freeRanges[i];
+            const uint64_t start = (static_cast<uint64_t>(freeRange.mOffset) + alignment - 1) / alignment * alignment;
+            const uint64_t padding = start - freeRange.mOffset;
+            if (padding + count > freeRange.mCount)
+            {
+                continue;
+            }
+
+            // the padding in front stays free, as does the remainder behind
+            const FreeRange remainder{ static_cast<uint32_t>(start + count), static_cast<uint32_t>(freeRange.mCount - padding - count) };
+            if (padding > 0)
+            {
+                freeRange.mCount = static_cast<uint32_t>(padding);
+                if (remainder.mCount > 0)
+                {
+                    freeRanges.insert(freeRanges.begin() + static_cast<std::ptrdiff_t>(i) + 1, remainder);
+                }
+            }
+            else if (remainder.mCount > 0)
+            {
+                freeRange = remainder;
+            }
+            else
+            {
+                freeRanges.erase(freeRanges.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+
+            offset = static_cast<uint32_t>(start);
+            return true;
+        }
+        return false;
+    }
+
+    void GeometryArena::releaseRange(std::vector<FreeRange>& freeRanges, uint32_t offset, uint32_t count) noexcept
+    {
+        // sorted insert, then merge with the neighbours it touches
+        auto it = std::lower_bound(freeRanges.begin(), freeRanges.end(), offset, [](const FreeRange& range, uint32_t value) { return range.mOffset < value; });
+        it = freeRanges.insert(it, { offset, count });
+
+        auto next = it + 1;
+        if (next != freeRanges.end() && it->mOffset + it->mCount == next->mOffset)
+        {
+            it->mCount += next->mCount;
+            freeRanges.erase(next);
+        }
+
+        if (it != freeRanges.begin())
+        {
+            auto previous = it - 1;
+            if (previous->mOffset + previous->mCount == it->mOffset)
+            {
+                previous->mCount += it->mCount;
+                freeRanges.erase(it);
+            }
+        }
+    }
+}   // namespace keplar
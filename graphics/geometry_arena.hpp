@@ -0,0 +1,102 @@
+// ────────────────────────────────────────────
+//  File: geometry_arena.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class VulkanStagingBelt;
+
+    // one model's static vertices and indices inside a GeometryArena
+    struct GeometryRange
+    {
+        uint32_t mFirstVertex = 0;      // vertexOffset of the model's draws
+        uint32_t mVertexCount = 0;
+        uint32_t mFirstIndex  = 0;      // added to the firstIndex of the model's draws
+        uint32_t mIndexCount  = 0;
+
+        bool isValid() const noexcept { return mVertexCount > 0 || mIndexCount > 0; }
+    };
+
+    // large device-local vertex and index buffers shared by every model of one vertex layout, so a whole world binds
+    // them once and draws of different models can share a batch. ranges are taken first-fit from sorted free lists
+    // whose neighbours coalesce on free. vertex ranges start on 256-byte boundaries (every legal
+    // minStorageBufferOffsetAlignment), so each can also be bound as a storage buffer range, e.g. for meshlet fetch
+    class GeometryArena final
+    {
+        public:
+            static constexpr uint32_t kDefaultVertexCapacity = 2u * 1024 * 1024;
+            static constexpr uint32_t kDefaultIndexCapacity  = 8u * 1024 * 1024;
+
+            // creation and destruction
+            GeometryArena() noexcept;
+            ~GeometryArena();
+
+            // disable copy and move semantics to enforce unique ownership
+            GeometryArena(const GeometryArena&) = delete;
+            GeometryArena& operator=(const GeometryArena&) = delete;
+            GeometryArena(GeometryArena&&) = delete;
+            GeometryArena& operator=(GeometryArena&&) = delete;
+
+            // usage: vertexStride is the layout every model in the arena shares; capacities are in vertices and uint32 indices
+            bool initialize(const VulkanDevice& device, uint32_t vertexStride, uint32_t vertexCapacity = kDefaultVertexCapacity,
+                            uint32_t indexCapacity = kDefaultIndexCapacity) noexcept;
+            void destroy() noexcept;
+
+            // usage: false, with nothing taken, when either range does not fit. safe to call from several loading threads
+            bool allocate(uint32_t vertexCount, uint32_t indexCount, GeometryRange& range) noexcept;
+            // usage: once no frame in flight draws from the range; resets it
+            void release(GeometryRange& range) noexcept;
+
+            // usage: stage a range's contents (valid once the belt is flushed); indices are relative to the range's first vertex
+            bool upload(VulkanStagingBelt& stagingBelt, const GeometryRange& range, const void* vertices, const uint32_t* indices) const noexcept;
+
+            // usage: vertex buffer on binding 0 and the uint32 index buffer, both at offset 0
+            void bind(VkCommandBuffer commandBuffer) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_vertexBuffer.get() != VK_NULL_HANDLE && m_indexBuffer.get() != VK_NULL_HANDLE; }
+            const VulkanBuffer& getVertexBuffer() const noexcept { return m_vertexBuffer; }
+            const VulkanBuffer& getIndexBuffer() const noexcept { return m_indexBuffer; }
+            uint32_t getVertexStride() const noexcept { return m_vertexStride; }
+            uint32_t getVertexCapacity() const noexcept { return m_vertexCapacity; }
+            uint32_t getIndexCapacity() const noexcept { return m_indexCapacity; }
+            uint32_t getUsedVertexCount() const noexcept;
+            uint32_t getUsedIndexCount() const noexcept;
+
+        private:
+            struct FreeRange
+            {
+                uint32_t mOffset;
+                uint32_t mCount;
+            };
+
+            static bool takeRange(std::vector<FreeRange>& freeRanges, uint32_t count, uint32_t alignment, uint32_t& offset) noexcept;
+            static void releaseRange(std::vector<FreeRange>& freeRanges, uint32_t offset, uint32_t count) noexcept;
+
+        private:
+            // device-local pools
+            VulkanBuffer                m_vertexBuffer;
+            VulkanBuffer                m_indexBuffer;
+            uint32_t                    m_vertexStride;
+            uint32_t                    m_vertexAlignment;      // in vertices, for 256-byte aligned range starts
+            uint32_t                    m_vertexCapacity;
+            uint32_t                    m_indexCapacity;
+
+            // free lists sorted by offset, and what is taken from each (alignment padding stays free)
+            std::vector<FreeRange>      m_freeVertices;
+            std::vector<FreeRange>      m_freeIndices;
+            uint32_t                    m_usedVertexCount;
+            uint32_t                    m_usedIndexCount;
+            mutable std::mutex          m_mutex;
+    };
+}   // namespace keplar
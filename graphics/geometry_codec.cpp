@@ -0,0 +1,279 @@
+// ────────────────────────────────────────────
+//  File: geometry_codec.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "geometry_codec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "asset_io.hpp"
+#include "utils/thread_pool.hpp"
+
+// zlib compressor of stb_image_write (implemented in graphics/external_libs.cpp)
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+namespace
+{
+    // stb deflate effort for baked geometry
+    constexpr int kCompressionQuality = 8;
+
+    // a varint never spans more than five bytes for a 32-bit value
+    constexpr size_t kMaxVarintSize = 5;
+
+    size_t getBlockCount(size_t count, size_t blockSize) noexcept
+    {
+        return (count + blockSize - 1) / blockSize;
+    }
+
+    // deflates each raw block that encodeBlock produces and frames them behind the offset table
+    template<typename EncodeBlock>
+    bool encodeBlocks(size_t blockCount, std::vector<uint8_t>& encoded, EncodeBlock&& encodeBlock) noexcept
+    {
+        if (blockCount > std::numeric_limits<uint32_t>::max())
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> table(blockCount + 1);
+        table[0] = static_cast<uint32_t>(blockCount);
+        std::vector<uint8_t> streams;
+        std::vector<uint8_t> raw;
+        for (size_t i = 0; i < blockCount; ++i)
+        {
+            raw.clear();
+            encodeBlock(i, raw);
+            if (raw.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+            {
+                return false;
+            }
+
+            int streamSize = 0;
+            unsigned char* stream = stbi_zlib_compress(raw.data(), static_cast<int>(raw.size()), &streamSize, kCompressionQuality);
+            if (!stream)
+            {
+                return false;
+            }
+
+            streams.insert(streams.end(), stream, stream + streamSize);
+            std::free(stream);
+            if (streams.size() > std::numeric_limits<uint32_t>::max())
+            {
+                return false;
+            }
+            table[i + 1] = static_cast<uint32_t>(streams.size());
+        }
+
+        encoded.resize(table.size() * sizeof(uint32_t) + streams.size());
+        std::memcpy(encoded.data(), table.data(), table.size() * sizeof(uint32_t));
+        if (!streams.empty())
+        {
+            std::memcpy(encoded.data() + table.size() * sizeof(uint32_t), streams.data(), streams.size());
+        }
+        return true;
+    }
+
+    // validates the framing and runs decodeBlock(index, stream, streamSize) for every block, in parallel when a pool is
+    // given and there is more than one block
+    template<typename DecodeBlock>
+    bool decodeBlocks(const uint8_t* encoded, size_t encodedSize, size_t blockCount, keplar::ThreadPool* threadPool, DecodeBlock&& decodeBlock) noexcept
+    {
+        uint32_t storedCount = 0;
+        if (encodedSize < sizeof(uint32_t))
+        {
+            return false;
+        }
+        std::memcpy(&storedCount, encoded, sizeof(uint32_t));
+
+        const size_t tableSize = (static_cast<size_t>(storedCount) + 1) * sizeof(uint32_t);
+        if (storedCount != blockCount || tableSize > encodedSize)
+        {
+            return false;
+        }
+
+        const uint8_t* streams = encoded + tableSize;
+        const size_t streamsSize = encodedSize - tableSize;
+        auto runBlock = [&](size_t index) noexcept
+        {
+            // the block before ends where this one begins; the first begins at the streams
+            uint32_t begin = 0;
+            uint32_t end = 0;
+            if (index > 0)
+            {
+                std::memcpy(&begin, encoded + index * sizeof(uint32_t), sizeof(uint32_t));
+            }
+            std::memcpy(&end, encoded + (index + 1) * sizeof(uint32_t), sizeof(uint32_t));
+            if (begin > end || end > streamsSize || end - begin > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+            {
+                return false;
+            }
+            return decodeBlock(index, streams + begin, static_cast<size_t>(end - begin));
+        };
+
+        if (!threadPool || blockCount < 2)
+        {
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                if (!runBlock(i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::atomic<bool> isDecoded{ true };
+        keplar::TaskGroup group(*threadPool, keplar::TaskPriority::kBackground);
+        group.parallelFor(blockCount, 1, [&](size_t index)
+        {
+            if (isDecoded.load(std::memory_order_relaxed) && !runBlock(index))
+            {
+                isDecoded.store(false, std::memory_order_relaxed);
+            }
+        });
+        group.wait();
+        return isDecoded.load(std::memory_order_relaxed);
+    }
+
+    bool inflate(const uint8_t* stream, size_t streamSize, std::vector<uint8_t>& raw) noexcept
+    {
+        const int size = stbi_zlib_decode_buffer(reinterpret_cast<char*>(raw.data()), static_cast<int>(raw.size()),
+                                                 reinterpret_cast<const char*>(stream), static_cast<int>(streamSize));
+        if (size < 0)
+        {
+            return false;
+        }
+        raw.resize(static_cast<size_t>(size));
+        return true;
+    }
+}
+
+namespace keplar
+{
+    bool encodeVertexStream(const void* vertices, size_t vertexCount, size_t stride, std::vector<uint8_t>& encoded) noexcept
+    {
+        if (stride == 0)
+        {
+            return false;
+        }
+
+        const uint8_t* source = static_cast<const uint8_t*>(vertices);
+        return encodeBlocks(getBlockCount(vertexCount, kGeometryCodecVertexBlock), encoded, [&](size_t block, std::vector<uint8_t>& raw)
+        {
+            // plane k holds byte k of every record, each minus the same byte of the record before it
+            const size_t first = block * kGeometryCodecVertexBlock;
+            const size_t count = std::min(kGeometryCodecVertexBlock, vertexCount - first);
+            raw.resize(count * stride);
+            for (size_t v = 0; v < count; ++v)
+            {
+                const uint8_t* record = source + (first + v) * stride;
+                for (size_t k = 0; k < stride; ++k)
+                {
+                    const uint8_t previous = v > 0 ? record[k - stride] : 0;
+                    raw[k * count + v] = static_cast<uint8_t>(record[k] - previous);
+                }
+            }
+        });
+    }
+
+    bool decodeVertexStream(const uint8_t* encoded, size_t encodedSize, void* vertices, size_t vertexCount, size_t stride,
+                            ThreadPool* threadPool) noexcept
+    {
+        if (stride == 0)
+        {
+            return false;
+        }
+
+        uint8_t* destination = static_cast<uint8_t*>(vertices);
+        return decodeBlocks(encoded, encodedSize, getBlockCount(vertexCount, kGeometryCodecVertexBlock), threadPool,
+                            [&](size_t block, const uint8_t* stream, size_t streamSize) noexcept
+        {
+            const size_t first = block * kGeometryCodecVertexBlock;
+            const size_t count = std::min(kGeometryCodecVertexBlock, vertexCount - first);
+            std::vector<uint8_t> raw(count * stride);
+            if (!inflate(stream, streamSize, raw) || raw.size() != count * stride)
+            {
+                return false;
+            }
+
+            uint8_t* records = destination + first * stride;
+            for (size_t v = 0; v < count; ++v)
+            {
+                uint8_t* record = records + v * stride;
+                for (size_t k = 0; k < stride; ++k)
+                {
+                    const uint8_t previous = v > 0 ? record[k - stride] : 0;
+                    record[k] = static_cast<uint8_t>(raw[k * count + v] + previous);
+                }
+            }
+            return true;
+        });
+    }
+
+    bool encodeIndexStream(const uint32_t* indices, size_t indexCount, std::vector<uint8_t>& encoded) noexcept
+    {
+        return encodeBlocks(getBlockCount(indexCount, kGeometryCodecIndexBlock), encoded, [&](size_t block, std::vector<uint8_t>& raw)
+        {
+            const size_t first = block * kGeometryCodecIndexBlock;
+            const size_t count = std::min(kGeometryCodecIndexBlock, indexCount - first);
+            raw.reserve(count * 2);
+            uint32_t previous = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const uint32_t index = indices[first + i];
+                const int32_t delta = static_cast<int32_t>(index - previous);
+                uint32_t value = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+                previous = index;
+                while (value >= 0x80)
+                {
+                    raw.push_back(static_cast<uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                raw.push_back(static_cast<uint8_t>(value));
+            }
+        });
+    }
+
+    bool decodeIndexStream(const uint8_t* encoded, size_t encodedSize, uint32_t* indices, size_t indexCount, ThreadPool* threadPool) noexcept
+    {
+        return decodeBlocks(encoded, encodedSize, getBlockCount(indexCount, kGeometryCodecIndexBlock), threadPool,
+                            [&](size_t block, const uint8_t* stream, size_t streamSize) noexcept
+        {
+            const size_t first = block * kGeometryCodecIndexBlock;
+            const size_t count = std::min(kGeometryCodecIndexBlock, indexCount - first);
+            std::vector<uint8_t> raw(count * kMaxVarintSize);
+            if (!inflate(stream, streamSize, raw))
+            {
+                return false;
+            }
+
+            // every varint must be complete and the block must hold exactly count of them
+            size_t offset = 0;
+            uint32_t previous = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                uint32_t value = 0;
+                uint32_t shift = 0;
+                uint8_t byte = 0;
+                do
+                {
+                    if (offset == raw.size() || shift > 28)
+                    {
+                        return false;
+                    }
+                    byte = raw[offset++];
+                    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                    shift += 7;
+                } while (byte & 0x80);
+
+                const uint32_t delta = (value >> 1) ^ (0u - (value & 1));
+                previous += delta;
+                indices[first + i] = previous;
+            }
+            return offset == raw.size();
+        });
+    }
+}   // namespace keplar
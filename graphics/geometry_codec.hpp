@@ -0,0 +1,32 @@
+// ────────────────────────────────────────────
+//  File: geometry_codec.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace keplar
+{
+    class ThreadPool;
+
+    // compact streams for baked geometry, in blocks that decode independently (across the pool's workers when one is
+    // given) straight into the destination:
+    //  - vertices: fixed-stride records are split into one byte plane per offset and delta coded against the previous
+    //    record, so the zero-heavy planes of positions, normals and uvs deflate well
+    //  - indices: zigzag deltas against the previous index as varints, which keeps the locality of optimized index
+    //    buffers to a byte or two per index before deflate
+    // stream layout: uint32_t block count, uint32_t end offset of each block's stream, then the zlib streams
+    inline constexpr size_t kGeometryCodecVertexBlock   = 8192;     // records per block
+    inline constexpr size_t kGeometryCodecIndexBlock    = 32768;    // indices per block
+
+    bool encodeVertexStream(const void* vertices, size_t vertexCount, size_t stride, std::vector<uint8_t>& encoded) noexcept;
+    bool decodeVertexStream(const uint8_t* encoded, size_t encodedSize, void* vertices, size_t vertexCount, size_t stride,
+                            ThreadPool* threadPool = nullptr) noexcept;
+
+    bool encodeIndexStream(const uint32_t* indices, size_t indexCount, std::vector<uint8_t>& encoded) noexcept;
+    bool decodeIndexStream(const uint8_t* encoded, size_t encodedSize, uint32_t* indices, size_t indexCount,
+                           ThreadPool* threadPool = nullptr) noexcept;
+}   // namespace keplar
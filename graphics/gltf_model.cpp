@@ -3,11 +3,42 @@
 // ────────────────────────────────────────────
 
 #include "gltf_model.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <glm/gtc/packing.hpp>
+
+#include "mesh_optimizer.hpp"
+#include "model_cache.hpp"
+#include "geometry_codec.hpp"
+#include "mip_generator.hpp"
+#include "texture_streamer.hpp"
+#include "vertex_layout.hpp"
+#include "basis_transcoder.hpp"
+#include "asset_manager.hpp"
 #include "core/keplar_config.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_command_recorder.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "vulkan/vulkan_dispatch.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/asset_pack.hpp"
+#include "utils/async_file_io.hpp"
 #include "utils/logger.hpp"
+#include "utils/profiler.hpp"
 
 namespace
 {
+    // workers of the model's pool kept for per-frame transform updates while background loads fill the rest
+    static constexpr size_t kReservedFrameWorkers        = 1;
+
     // descriptor set layout bindings
     static constexpr uint32_t kBaseColorBinding          = 1; 
     static constexpr uint32_t kMetallicRoughnessBinding  = 2; 
@@ -15,899 +46,6183 @@ namespace
     static constexpr uint32_t kOcclusionBinding          = 4; 
     static constexpr uint32_t kEmissiveBinding           = 5; 
 
+    // material sets are written from one image info per map in binding order, through the update template of the
+    // maps the material samples (bit i: binding kBaseColorBinding + i)
+    static constexpr uint32_t kMaterialTextureCount      = 5;
+    using MaterialDescriptorImages = std::array<VkDescriptorImageInfo, kMaterialTextureCount>;
+
+    // bindless descriptor set layout bindings: material table, per-frame object records and one texture array shared by every material
+    static constexpr uint32_t kBindlessMaterialBinding   = 0;
+    static constexpr uint32_t kBindlessObjectBinding     = 1;
+    static constexpr uint32_t kBindlessTextureBinding    = 2;
+    static constexpr uint32_t kMaxBindlessTextures       = 4096;
+
+    // meshlet descriptor set layout bindings: meshlet records, their vertex indices and triangles, and the static vertex pool
+    static constexpr uint32_t kMeshletBinding            = 0;
+    static constexpr uint32_t kMeshletVertexBinding      = 1;
+    static constexpr uint32_t kMeshletTriangleBinding    = 2;
+    static constexpr uint32_t kMeshletVertexDataBinding  = 3;
+
     // push constants: model matrix and pbr material properties
     struct alignas(16) PushConstants
     {
-        glm::mat4 model;
-        glm::vec4 baseColor;
-        glm::vec4 pbrFactors;
-        glm::vec4 emissiveColor;
+        glm::mat4  model;
+        glm::vec4  baseColor;
+        glm::vec4  pbrFactors;
+        glm::vec4  emissiveColor;   // w: occlusion factor
+        glm::uvec4 materialInfo;    // x: material index into the bindless material table; meshlet draws: y: first meshlet,
+                                    // z: meshlet count, w: 1 if double-sided (no cone culling); pulled indirect draws: y: 1 if
+                                    // packed vertices, zw: vertex pool device address (low, high)
     }; 
-}
+    static_assert(sizeof(PushConstants) <= 128, "push constants must fit the guaranteed minimum maxPushConstantsSize");
 
-namespace keplar
-{
-    // ─────────────────────────────────────────────
-    // GLTF model structures for meshes, nodes, primitives, and materials
-    // ─────────────────────────────────────────────
-    struct GLTFModel::Vertex
+    // push constants of the bindless cpu path (pbr_object.vert): a draw reads the object record at
+    // objectIndex + gl_DrawID * drawStride + gl_InstanceIndex; gl_DrawID is 0 outside multi-draws
+    struct ObjectPushConstants
     {
-        glm::vec4 mPosition;
-        glm::vec3 mNormal;
-        glm::vec2 mUV;
-        glm::vec4 mTangent;
+        uint32_t objectIndex;
+        uint32_t drawStride;        // records per draw of a multi-draw, i.e. its instance count
     };
 
-    // range of indices with a single material
-    struct GLTFModel::Primitive 
-    {
-        uint32_t mFirstIndex;
-        uint32_t mIndexCount;
-        int32_t  mMaterialIndex;
-    };
+    // draws of one vkCmdDrawMultiIndexedEXT on the bindless cpu path, gathered on the stack
+    static constexpr uint32_t kMaxMultiDrawBatch = 64;
 
-    // mesh containing multiple primitives
-    struct GLTFModel::Mesh
+    // material record of the bindless table (std430, matches pbr_bindless.frag); unused texture slots are -1
+    struct alignas(16) BindlessMaterial
     {
-        std::string mName;
-        std::vector<Primitive> mPrimitives;
+        glm::vec4  baseColor;
+        glm::vec4  pbrFactors;
+        glm::vec4  emissiveColor;   // w: occlusion factor
+        glm::ivec4 textures;        // x: base color, y: metallic roughness, z: normal, w: occlusion
+        glm::ivec4 extraTextures;   // x: emissive, y: 1 if occlusion is the red channel of the metallic roughness map
     };
 
-    // scene node with transform hierarchy
-    struct GLTFModel::Node 
+    // vertex input binding of per-draw records for indirect rendering
+    static constexpr uint32_t kDrawDataVertexBinding = 1;
+
+    // dirty hierarchies at least this large are updated across the thread pool, in subtrees of at most kTransformChunkSize nodes
+    static constexpr size_t kParallelTransformThreshold = 2048;
+    static constexpr size_t kTransformChunkSize         = 256;
+
+    // baked cache key flags: load options that change the baked output
+    static constexpr uint32_t kBakedFlagOptimizedMeshes = 1u << 0;
+    static constexpr uint32_t kBakedFlagKaiserMips      = 1u << 1;
+    static constexpr uint32_t kBakedFlagLods            = 1u << 2;
+    static constexpr uint32_t kBakedFlagMeshlets        = 1u << 3;
+
+    // lod chain: each level aims at half the indices of the previous one, and is dropped when that saves under a quarter
+    // or costs more than kMaxLodError of the primitive's extent
+    static constexpr float kLodReduction     = 0.5f;
+    static constexpr float kMinLodReduction  = 0.75f;
+    static constexpr float kMaxLodError      = 0.05f;
+    static constexpr uint32_t kMinLodIndices = 3 * 64;
+
+    // 64-bit draw sort key, most significant first: alpha class (2 bits, opaque, masked, blended), material permutation
+    // (4 bits, the pipeline), vertex pool, material (16 bits), primitive (20 bits) so instances of one mesh are adjacent, and
+    // view depth (21 bits). non-negative floats order like their bit patterns, so depth sorts front to back within a run.
+    // blended draws follow the depth alone, inverted to back to front, with the state bits below it.
+    // wider indices alias, which costs batching only
+    uint64_t makeDrawSortKey(keplar::GLTFAlphaMode alphaMode, uint32_t permutation, bool isSkinned, int32_t materialIndex, uint32_t primitive, 
+                             float depth) noexcept
     {
-        std::string           mName;
-        int32_t               mMeshIndex;
-        int32_t               mParentIndex;
-        glm::mat4             mLocalTransform;
-        glm::mat4             mWorldTransform;
-        std::vector<int32_t>  mChildren;
-    };
+        uint32_t depthBits = 0;
+        const float clampedDepth = std::max(depth, 0.0f);
+        std::memcpy(&depthBits, &clampedDepth, sizeof(depthBits));
+        const uint64_t alphaClass = static_cast<uint64_t>(alphaMode) << 62;
+        if (alphaMode == keplar::GLTFAlphaMode::kBlend)
+        {
+            return alphaClass | 
+                   (static_cast<uint64_t>(~depthBits >> 2) << 32) | 
+                   (static_cast<uint64_t>(permutation & 0xFu) << 28) | 
+                   (static_cast<uint64_t>(isSkinned ? 1u : 0u) << 27) | 
+                   (static_cast<uint64_t>(static_cast<uint32_t>(materialIndex) & 0xFFFFu) << 11) | 
+                   static_cast<uint64_t>(primitive & 0x7FFu);
+        }
+        return alphaClass | 
+               (static_cast<uint64_t>(permutation & 0xFu) << 58) | 
+               (static_cast<uint64_t>(isSkinned ? 1u : 0u) << 57) | 
+               (static_cast<uint64_t>(static_cast<uint32_t>(materialIndex) & 0xFFFFu) << 41) | 
+               (static_cast<uint64_t>(primitive & 0xFFFFFu) << 21) | 
+               static_cast<uint64_t>(depthBits >> 11);
+    }
 
-    // scene with root node indices
-    struct GLTFModel::Scene
+    // read a float accessor (scalar or vector) into a tightly packed array
+    bool readFloatAccessor(const tinygltf::Model& model, int accessorIndex, uint32_t componentCount, std::vector<float>& values) noexcept
     {
-        std::string mName;
-        std::vector<int32_t> mRootNodes; 
-    };
+        if (accessorIndex < 0 || accessorIndex >= static_cast<int>(model.accessors.size()))
+        {
+            return false;
+        }
 
-    // pbr material data and descriptor
-    struct GLTFModel::Material 
-    {
-        glm::vec4 mBaseColor;
-        float     mMetallic;
-        float     mRoughness;
-        float     mSpecular;
-        glm::vec3 mEmissive;
+        // only float data is supported; quantized animation outputs are rejected
+        const auto& accessor = model.accessors[accessorIndex];
+        if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.bufferView < 0)
+        {
+            return false;
+        }
 
-        std::optional<uint32_t> mBaseColorTex; 
-        std::optional<uint32_t> mMetallicRoughnessTex;
-        std::optional<uint32_t> mNormalTex;
-        std::optional<uint32_t> mOcclusionTex;
-        std::optional<uint32_t> mEmissiveTex;
+        const auto& view    = model.bufferViews[accessor.bufferView];
+        const float* buffer = reinterpret_cast<const float*>(&model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]);
+        const size_t stride = view.byteStride ? view.byteStride / sizeof(float) : componentCount;
 
-        VkDescriptorSet mDescriptorSet;
-    };
+        values.resize(accessor.count * componentCount);
+        for (size_t i = 0; i < accessor.count; ++i)
+        {
+            std::copy_n(&buffer[i * stride], componentCount, &values[i * componentCount]);
+        }
+        return true;
+    }
 
-    // ─────────────────────────────────────────────
-    // GLTFModel implementation
-    // ─────────────────────────────────────────────
-    GLTFModel::GLTFModel() noexcept
-        : m_vkDevice(VK_NULL_HANDLE)
-        , m_vertexCount(0)
-        , m_indexCount(0)
+    // read one element (up to 4 components) of a float or unsigned integer accessor, optionally normalizing integers to [0, 1]
+    glm::vec4 readAccessorElement(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t index, bool normalize) noexcept
     {
+        const auto& view            = model.bufferViews[accessor.bufferView];
+        const size_t componentSize  = static_cast<size_t>(tinygltf::GetComponentSizeInBytes(accessor.componentType));
+        const size_t componentCount = static_cast<size_t>(tinygltf::GetNumComponentsInType(accessor.type));
+        const size_t stride         = view.byteStride ? view.byteStride : componentSize * componentCount;
+        const uint8_t* data         = &model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset + index * stride];
+
+        glm::vec4 value(0.0f);
+        for (size_t c = 0; c < std::min<size_t>(4, componentCount); ++c)
+        {
+            switch (accessor.componentType)
+            {
+                case TINYGLTF_COMPONENT_TYPE_FLOAT:
+                {
+                    std::memcpy(&value[static_cast<int>(c)], data + c * sizeof(float), sizeof(float));
+                    break;
+                }
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                {
+                    value[static_cast<int>(c)] = static_cast<float>(data[c]) / (normalize ? 255.0f : 1.0f);
+                    break;
+                }
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                {
+                    uint16_t component = 0;
+                    std::memcpy(&component, data + c * sizeof(uint16_t), sizeof(uint16_t));
+                    value[static_cast<int>(c)] = static_cast<float>(component) / (normalize ? 65535.0f : 1.0f);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        return value;
     }
 
-    GLTFModel::~GLTFModel()
+    // convert count elements of one component type to floats: byte strides on the source, float strides on the destination.
+    // one tight loop per type without branches inside, so the compiler vectorizes the conversion
+    template<typename T, bool kIsSignedNormalized>
+    void convertComponents(const uint8_t* source, size_t sourceStride, size_t count, size_t componentCount, float scale,
+                           float* destination, size_t destinationStride) noexcept
     {
-        // clear model resources
-        m_textures.clear();
-        m_materials.clear();
-        m_scenes.clear();
-        m_nodes.clear();
-        m_meshes.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t* element = source + i * sourceStride;
+            float* output = destination + i * destinationStride;
+            for (size_t c = 0; c < componentCount; ++c)
+            {
+                T value;
+                std::memcpy(&value, element + c * sizeof(T), sizeof(T));
+                output[c] = kIsSignedNormalized ? std::max(static_cast<float>(value) * scale, -1.0f) : static_cast<float>(value) * scale;
+            }
+        }
     }
 
-    bool GLTFModel::load(const VulkanDevice& device, const VulkanCommandPool& commandPool, const std::string& filename) noexcept
+    // bulk decode of a vertex attribute into interleaved floats (destinationStride in floats): float data and the integer
+    // types of KHR_mesh_quantization, normalized ones mapped to [0, 1] (unsigned) or [-1, 1] (signed). the element stride is
+    // the view's, or tight; components beyond the accessor's keep what the destination holds
+    bool decodeAttribute(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t componentCount, size_t count,
+                         float* destination, size_t destinationStride) noexcept
     {
-        // ─────────────────────────────────────────
-        // load glTF model using TinyGLTF (binary .glb or ASCII .gltf)
-        // ─────────────────────────────────────────
-        tinygltf::TinyGLTF tinygltf;
-        tinygltf::Model model;
-        std::string error;
-        std::string warning;
-        bool status = false;
-
-        // construct full file path
-        const std::filesystem::path filepath = keplar::config::kModelDir / filename;
-        std::string extension = filepath.extension().string();
-        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (accessor.bufferView < 0 || accessor.bufferView >= static_cast<int>(model.bufferViews.size()))
+        {
+            return false;
+        }
 
-        // load model based on extension (binary: glb; ascii: gltf)
-        if (extension == ".glb")
+        const int componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+        const int accessorComponents = tinygltf::GetNumComponentsInType(accessor.type);
+        if (componentSize <= 0 || accessorComponents <= 0)
         {
-            status = tinygltf.LoadBinaryFromFile(&model, &error, &warning, filepath.string());
+            return false;
         }
-        else if (extension == ".gltf")
+
+        // the last element must lie inside the buffer
+        const auto& view         = model.bufferViews[accessor.bufferView];
+        const auto& buffer       = model.buffers[view.buffer].data;
+        const size_t elementSize = static_cast<size_t>(componentSize) * static_cast<size_t>(accessorComponents);
+        const size_t stride      = view.byteStride ? view.byteStride : elementSize;
+        const size_t offset      = accessor.byteOffset + view.byteOffset;
+        count = std::min(count, accessor.count);
+        componentCount = std::min(componentCount, static_cast<size_t>(accessorComponents));
+        if (count == 0 || offset + (count - 1) * stride + elementSize > buffer.size())
         {
-            status = tinygltf.LoadASCIIFromFile(&model, &error, &warning, filepath.string());
+            return count == 0;
         }
-        else 
+
+        const uint8_t* source = buffer.data() + offset;
+        const bool isNormalized = accessor.normalized;
+        switch (accessor.componentType)
         {
-            VK_LOG_ERROR("GLTFModel::load :: unsupported model format: %s", filename.c_str());
-            return false;
+            case TINYGLTF_COMPONENT_TYPE_FLOAT:
+                convertComponents<float, false>(source, stride, count, componentCount, 1.0f, destination, destinationStride);
+                return true;
+            case TINYGLTF_COMPONENT_TYPE_BYTE:
+                isNormalized ? convertComponents<int8_t, true>(source, stride, count, componentCount, 1.0f / 127.0f, destination, destinationStride)
+                             : convertComponents<int8_t, false>(source, stride, count, componentCount, 1.0f, destination, destinationStride);
+                return true;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                convertComponents<uint8_t, false>(source, stride, count, componentCount, isNormalized ? 1.0f / 255.0f : 1.0f, destination, destinationStride);
+                return true;
+            case TINYGLTF_COMPONENT_TYPE_SHORT:
+                isNormalized ? convertComponents<int16_t, true>(source, stride, count, componentCount, 1.0f / 32767.0f, destination, destinationStride)
+                             : convertComponents<int16_t, false>(source, stride, count, componentCount, 1.0f, destination, destinationStride);
+                return true;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                convertComponents<uint16_t, false>(source, stride, count, componentCount, isNormalized ? 1.0f / 65535.0f : 1.0f, destination, destinationStride);
+                return true;
+            default:
+                return false;
         }
+    }
 
-        // log warnings
-        if (!warning.empty())
+    // widen count indices of any gltf index type into destination, offset by baseVertex
+    template<typename T>
+    void widenIndices(const uint8_t* source, size_t count, uint32_t baseVertex, uint32_t* destination) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
         {
-            VK_LOG_WARN("GLTFModel::load :: tinygltf - %s: %s", filepath.c_str(), warning.c_str());
+            T index;
+            std::memcpy(&index, source + i * sizeof(T), sizeof(T));
+            destination[i] = static_cast<uint32_t>(index) + baseVertex;
         }
+    }
 
-        // check for errors
-        if (!status || !error.empty())
+    bool decodeIndices(const tinygltf::Model& model, const tinygltf::Accessor& accessor, uint32_t baseVertex, size_t count, uint32_t* destination) noexcept
+    {
+        if (accessor.bufferView < 0 || accessor.bufferView >= static_cast<int>(model.bufferViews.size()))
         {
-            VK_LOG_ERROR("GLTFModel::load :: tinygltf failed to load model: %s (error: %s)", filepath.c_str(), error.c_str());
             return false;
         }
 
-        // ─────────────────────────────────────────
-        // load individual model components: meshes, nodes, scenes, textures, materials
-        // ─────────────────────────────────────────
-        if (!loadMeshes(model, device, commandPool))
+        const int indexSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+        const auto& view    = model.bufferViews[accessor.bufferView];
+        const auto& buffer  = model.buffers[view.buffer].data;
+        const size_t offset = accessor.byteOffset + view.byteOffset;
+        count = std::min(count, accessor.count);
+        if (indexSize <= 0 || offset + count * static_cast<size_t>(indexSize) > buffer.size())
         {
-            VK_LOG_ERROR("GLTFModel::load :: failed to load meshes");
             return false;
         }
 
-        if (!loadSceneGraph(model))
+        const uint8_t* source = buffer.data() + offset;
+        switch (accessor.componentType)
         {
-            VK_LOG_ERROR("GLTFModel::load :: failed to load nodes and scenes");
-            return false;
+            case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:   widenIndices<uint32_t>(source, count, baseVertex, destination); return true;
+            case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT: widenIndices<uint16_t>(source, count, baseVertex, destination); return true;
+            case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:  widenIndices<uint8_t>(source, count, baseVertex, destination); return true;
+            default: return false;
         }
+    }
 
-        if (!loadTextures(model, device, commandPool))
+    // decode a morph target's vec3 deltas like decodeAttribute, also from sparse accessors: the base view (zero when it has
+    // none), then each substituted element written over its index
+    bool decodeMorphAttribute(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t count, float* destination, 
+                              size_t destinationStride) noexcept
+    {
+        if (accessor.bufferView >= 0 && !decodeAttribute(model, accessor, 3, count, destination, destinationStride))
         {
-            VK_LOG_ERROR("GLTFModel::load :: failed to load textures");
             return false;
         }
+        if (!accessor.sparse.isSparse || accessor.sparse.count <= 0)
+        {
+            return accessor.bufferView >= 0 || accessor.sparse.isSparse;
+        }
 
-        if (!loadMaterials(model))
+        // the substitutions are tightly packed accessors of their own over the sparse views
+        const size_t sparseCount = static_cast<size_t>(accessor.sparse.count);
+        tinygltf::Accessor indexAccessor{};
+        indexAccessor.bufferView    = accessor.sparse.indices.bufferView;
+        indexAccessor.byteOffset    = accessor.sparse.indices.byteOffset;
+        indexAccessor.componentType = accessor.sparse.indices.componentType;
+        indexAccessor.count         = sparseCount;
+
+        tinygltf::Accessor valueAccessor = accessor;
+        valueAccessor.bufferView = accessor.sparse.values.bufferView;
+        valueAccessor.byteOffset = accessor.sparse.values.byteOffset;
+        valueAccessor.count      = sparseCount;
+
+        std::vector<uint32_t> indices(sparseCount);
+        std::vector<float> values(sparseCount * 3, 0.0f);
+        if (!decodeIndices(model, indexAccessor, 0, sparseCount, indices.data()) ||
+            !decodeAttribute(model, valueAccessor, 3, sparseCount, values.data(), 3))
         {
-            VK_LOG_ERROR("GLTFModel::load :: failed to load materials");
             return false;
         }
 
-        // store device for later use
-        m_vkDevice = device.getDevice();
-        VK_LOG_DEBUG("GLTFModel::load :: model loaded successfully: %s", filename.c_str());
+        for (size_t i = 0; i < sparseCount; ++i)
+        {
+            if (indices[i] < count)
+            {
+                std::copy_n(&values[i * 3], 3, destination + indices[i] * destinationStride);
+            }
+        }
         return true;
     }
 
-    void GLTFModel::render(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) noexcept
+    // tinygltf image callback: nothing is decoded while parsing. images in a buffer view keep no copy and are decoded straight
+    // from the view (see getEmbeddedImage); data uris, whose bytes live nowhere else, keep theirs encoded
+    bool keepEncodedImage(tinygltf::Image* image, const int, std::string*, std::string*, int, int, const unsigned char* bytes, int size, void*)
     {
-        // skip if no meshes or scenes
-        if (m_meshes.empty() || m_scenes.empty())
+        image->as_is = true;
+        if (image->bufferView < 0 && bytes != nullptr && size > 0)
         {
-            VK_LOG_DEBUG("GLTFModel::render :: no meshes or scenes loaded");
-            return;
+            image->image.assign(bytes, bytes + size);
         }
+        return true;
+    }
 
-        // render default scene
-        const Scene& scene = m_scenes[0];
-
-        // iterative stack-based traversal 
-        std::vector<int> stack;
-        stack.reserve(m_nodes.size());
-
-        // push root nodes
-        for (int rootIdx : scene.mRootNodes)
+    // encoded bytes of an image stored in a buffer view, or null when it has its own copy or a uri
+    const uint8_t* getEmbeddedImage(const tinygltf::Model& model, const tinygltf::Image& image, size_t& size) noexcept
+    {
+        size = 0;
+        if (!image.image.empty() || image.bufferView < 0 || image.bufferView >= static_cast<int>(model.bufferViews.size()))
         {
-            stack.push_back(rootIdx);
+            return nullptr;
         }
 
-        // bind vertex and index buffers 
-        VkBuffer vertexBuffers[] = { m_vertexBuffer.get() };
-        VkDeviceSize offsets[]   = { 0 };
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-        vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer.get(), 0, VK_INDEX_TYPE_UINT32);
-
-        while (!stack.empty())
+        const auto& view = model.bufferViews[image.bufferView];
+        if (view.buffer < 0 || view.buffer >= static_cast<int>(model.buffers.size()) || view.byteOffset + view.byteLength > model.buffers[view.buffer].data.size())
         {
-            auto nodeIdx = stack.back();
-            stack.pop_back();
-
-            // validate node index
-            if (nodeIdx < 0 || nodeIdx >= static_cast<int>(m_nodes.size()))
-            {
-                continue;
-            }
+            return nullptr;
+        }
 
-            // push children
-            Node& node = m_nodes[nodeIdx];
-            for (int childIdx : node.mChildren)
-            {
-                stack.push_back(childIdx);
-            }
+        size = view.byteLength;
+        return model.buffers[view.buffer].data.data() + view.byteOffset;
+    }
 
-            // skip nodes with invalid mesh
-            if (node.mMeshIndex < 0 || node.mMeshIndex >= static_cast<int>(m_meshes.size()))
-            {
-                continue;
-            }
+    // image sampled by a gltf texture: the KHR_texture_basisu source when it can be transcoded, otherwise the fallback source
+    int getTextureImageIndex(const tinygltf::Model& model, int textureIndex) noexcept
+    {
+        if (textureIndex < 0 || textureIndex >= static_cast<int>(model.textures.size()))
+        {
+            return -1;
+        }
 
-            // record rendering commands for the mesh
-            VkDescriptorSet lastBoundMaterial = VK_NULL_HANDLE;
-            for (const auto& primitive : m_meshes[node.mMeshIndex].mPrimitives)
+        const auto& texture = model.textures[textureIndex];
+        const auto basisu = texture.extensions.find("KHR_texture_basisu");
+        if (keplar::basis_transcoder::isAvailable() && basisu != texture.extensions.end() && basisu->second.Has("source"))
+        {
+            const int imageIndex = basisu->second.Get("source").GetNumberAsInt();
+            if (imageIndex >= 0 && imageIndex < static_cast<int>(model.images.size()))
             {
-                // skip rendering primitive if it has no material
-                if (primitive.mMaterialIndex < 0 || primitive.mMaterialIndex >= static_cast<int32_t>(m_materials.size()))
-                {
-                    VK_LOG_DEBUG("GLTFModel::render :: invalid material, primitive skipped");
-                    continue;
-                }         
-                
-                // avoid redundant binds when consecutive primitives share the same material
-                const Material& material = m_materials[primitive.mMaterialIndex];
-                if (lastBoundMaterial != material.mDescriptorSet)
-                {
-                    // bind material descriptor set (set: 1)
-                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &material.mDescriptorSet, 0, nullptr);
-                    lastBoundMaterial = material.mDescriptorSet;
-                }
-
-                // prepare push constants
-                PushConstants pushConstants{};
-                pushConstants.model         = node.mWorldTransform;
-                pushConstants.baseColor     = material.mBaseColor;
-                pushConstants.pbrFactors    = glm::vec4(material.mMetallic, material.mRoughness, material.mSpecular, 0.0f);
-                pushConstants.emissiveColor = glm::vec4(material.mEmissive, 0.0f);
-        
-                // record push constants and issue indexed draw call 
-                vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
-                vkCmdDrawIndexed(commandBuffer, primitive.mIndexCount, 1, primitive.mFirstIndex, 0, 0);
+                return imageIndex;
             }
         }
+        return texture.source;
     }
 
-    void GLTFModel::update(float /* dt */) noexcept
-    {
-    }
+    // deflate expands a stream by at most this factor; bounds the element count a baked stream may claim
+    constexpr uint64_t kMaxInflateRatio = 1032;
 
-    bool GLTFModel::allocateDescriptorSets(VkDescriptorPool descriptorPool) noexcept
+    // baked geometry arrays: element count, then the encoded stream (see geometry_codec.hpp)
+    bool writeVertexStream(keplar::ModelCacheWriter& writer, const void* data, size_t count, size_t stride) noexcept
     {
-        // validate materials 
-        if (m_materials.empty())
+        std::vector<uint8_t> encoded;
+        if (!keplar::encodeVertexStream(data, count, stride, encoded))
         {
-            VK_LOG_DEBUG("GLTFModel::allocateDescriptorSets :: no materials to allocate descriptor sets");
-            return true;
+            return false;
         }
 
-        // validate descriptor set layout
-        if (s_descriptorSetLayout == VK_NULL_HANDLE)
+        writer.write(static_cast<uint64_t>(count));
+        writer.writeArray(encoded);
+        return true;
+    }
+
+    bool writeIndexStream(keplar::ModelCacheWriter& writer, const std::vector<uint32_t>& indices) noexcept
+    {
+        std::vector<uint8_t> encoded;
+        if (!keplar::encodeIndexStream(indices.data(), indices.size(), encoded))
         {
-            VK_LOG_ERROR("GLTFModel::allocateDescriptorSets :: shared descriptor set layout not initialized");
             return false;
         }
 
-        // descriptor set allocation info
-        std::vector<VkDescriptorSetLayout> layouts(m_materials.size(), s_descriptorSetLayout);
-        VkDescriptorSetAllocateInfo allocateInfo{};
-        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocateInfo.descriptorPool = descriptorPool;
-        allocateInfo.descriptorSetCount = static_cast<uint32_t>(m_materials.size());
-        allocateInfo.pSetLayouts = layouts.data();
+        writer.write(static_cast<uint64_t>(indices.size()));
+        writer.writeArray(encoded);
+        return true;
+    }
 
-        // allocate descriptor sets for each material
-        std::vector<VkDescriptorSet> descriptorSets(m_materials.size());
-        VkResult vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, descriptorSets.data());
-        if (vkResult != VK_SUCCESS)
+    // decodes into values, whose elements tile the records (stride is a multiple of sizeof(T))
+    template<typename T>
+    bool readVertexStream(keplar::ModelCacheReader& reader, std::vector<T>& values, size_t stride, keplar::ThreadPool* threadPool) noexcept
+    {
+        uint64_t count = 0;
+        const uint8_t* encoded = nullptr;
+        size_t encodedSize = 0;
+        if (!reader.read(count) || !reader.readView(encoded, encodedSize) || stride % sizeof(T) != 0 ||
+            count > (encodedSize * kMaxInflateRatio) / stride)
         {
-            VK_LOG_FATAL("GLTFModel::allocateDescriptorSets :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // assign sets to materials
-        for (size_t i = 0; i < m_materials.size(); i++)
+        values.resize(static_cast<size_t>(count) * (stride / sizeof(T)));
+        return keplar::decodeVertexStream(encoded, encodedSize, values.data(), static_cast<size_t>(count), stride, threadPool);
+    }
+
+    bool readIndexStream(keplar::ModelCacheReader& reader, std::vector<uint32_t>& indices, keplar::ThreadPool* threadPool) noexcept
+    {
+        uint64_t count = 0;
+        const uint8_t* encoded = nullptr;
+        size_t encodedSize = 0;
+        if (!reader.read(count) || !reader.readView(encoded, encodedSize) || count > encodedSize * kMaxInflateRatio)
         {
-            m_materials[i].mDescriptorSet = descriptorSets[i];
+            return false;
         }
 
-        VK_LOG_DEBUG("GLTFModel::allocateDescriptorSets :: descriptor sets allocation successful");
-        return true;
+        indices.resize(static_cast<size_t>(count));
+        return keplar::decodeIndexStream(encoded, encodedSize, indices.data(), indices.size(), threadPool);
     }
 
-    void GLTFModel::updateDescriptorSets(const VulkanSamplers& sampler) noexcept
+    // true when every texel of an uncompressed rgba8 base level repeats the first one
+    bool isConstantImage(const keplar::TextureData& textureData) noexcept
     {
-        // skip if no materials or invalid layout
-        if (m_materials.empty() || s_descriptorSetLayout == VK_NULL_HANDLE)
+        if (textureData.mFormat != VK_FORMAT_UNDEFINED || textureData.mChannels != 4 || textureData.mMipExtents.empty())
         {
-            VK_LOG_DEBUG("GLTFModel::allocateDescriptorSets :: no materials or shared layout to update descriptor sets");
-            return;
+            return false;
         }
 
-        // temporary storage for descriptor writes and their image info
-        std::vector<VkWriteDescriptorSet> writes;
-        std::vector<VkDescriptorImageInfo> imageInfos;
-
-        // pre-allocate
-        const size_t maxTexturesPerMaterial = 5;
-        writes.reserve(m_materials.size() * maxTexturesPerMaterial);
-        imageInfos.reserve(m_materials.size() * maxTexturesPerMaterial);
-
-        // select the best available sampler
-        VkSampler vkSampler = sampler.get(VulkanSamplers::Type::AnisotropicRepeat);
-        if (vkSampler == VK_NULL_HANDLE)
+        const VkExtent2D extent = textureData.mMipExtents[0];
+        const size_t size = static_cast<size_t>(extent.width) * extent.height * 4;
+        if (size == 0 || textureData.mPixels.size() < size)
         {
-            vkSampler = sampler.get(VulkanSamplers::Type::LinearRepeat);
+            return false;
         }
 
-        // prepare descriptor updates per material
-        for (const auto& material : m_materials)
+        const uint8_t* pixels = textureData.mPixels.data();
+        for (size_t offset = 4; offset < size; offset += 4)
         {
-            std::array<std::pair<uint32_t, std::optional<int>>, 5> textureBindings = 
-            {{
-                { kBaseColorBinding,          material.mBaseColorTex },
-                { kNormalBinding,             material.mNormalTex },
-                { kMetallicRoughnessBinding,  material.mMetallicRoughnessTex },
-                { kOcclusionBinding,          material.mOcclusionTex },
-                { kEmissiveBinding,           material.mEmissiveTex }
-            }};
-            
-            for (const auto& [binding, texIndex] : textureBindings)
-            {
-                // validate texture index
-                if (!texIndex.has_value()) 
-                    continue;
-
-                // image info
-                imageInfos.emplace_back();
-                VkDescriptorImageInfo& info = imageInfos.back();
-                info.sampler     = vkSampler;
-                info.imageView   = m_textures[texIndex.value()].getImageView();
-                info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-                // write descriptor set
-                VkWriteDescriptorSet write{};
-                write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                write.pNext            = nullptr;
-                write.dstSet           = material.mDescriptorSet;
-                write.dstBinding       = binding;
-                write.dstArrayElement  = 0;
-                write.descriptorCount  = 1;
-                write.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                write.pImageInfo       = &info;
-                write.pBufferInfo      = nullptr;
-                write.pTexelBufferView = nullptr;
-
-                writes.emplace_back(write);
+            if (std::memcmp(pixels + offset, pixels, 4) != 0)
+            {
+                return false;
             }
         }
-
-        // TODO: update skin matrices (single write for all skinned objects)
-
-        // commit batch-update for all descriptor sets
-        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
-        VK_LOG_DEBUG("GLTFModel::updateDescriptorSets :: updated descriptor sets successful");
+        return true;
     }
 
-    DescriptorRequirements GLTFModel::getDescriptorRequirements() const noexcept
+    // the value a sampler returns for an rgba8 texel: srgb formats decode the color channels, alpha stays linear
+    glm::vec4 sampleTexel(const uint8_t* texel, bool isSrgb) noexcept
     {
-        // each material will have one descriptor set
-        DescriptorRequirements requirements{};
-        requirements.mMaxSets= static_cast<uint32_t>(m_materials.size());
-
-        // count how many textures will be used across all materials
-        for (const auto& material : m_materials)
+        glm::vec4 color = glm::vec4(texel[0], texel[1], texel[2], texel[3]) / 255.0f;
+        if (isSrgb)
         {
-            if (material.mBaseColorTex.has_value())         { requirements.mSamplerCount++; }
-            if (material.mNormalTex.has_value())            { requirements.mSamplerCount++; }
-            if (material.mMetallicRoughnessTex.has_value()) { requirements.mSamplerCount++; }
-            if (material.mEmissiveTex.has_value())          { requirements.mSamplerCount++; }
-            if (material.mOcclusionTex.has_value())         { requirements.mSamplerCount++; }
+            for (int c = 0; c < 3; ++c)
+            {
+                color[c] = color[c] <= 0.04045f ? color[c] / 12.92f : std::pow((color[c] + 0.055f) / 1.055f, 2.4f);
+            }
         }
+        return color;
+    }
 
-        // uniform buffer count for pbr factors (one per material)
-        requirements.mUniformCount = static_cast<uint32_t>(m_materials.size());
-        return requirements;
+    // a constant normal map that decodes to the tangent-space up vector within a step of 8-bit quantization
+    bool isFlatNormal(const glm::vec4& color) noexcept
+    {
+        constexpr float kTolerance = 1.0f / 255.0f;
+        return std::abs(color.x - 0.5f) <= kTolerance && std::abs(color.y - 0.5f) <= kTolerance && color.z > 0.5f;
     }
 
-    bool GLTFModel::loadMeshes(const tinygltf::Model& model, const VulkanDevice& device, const VulkanCommandPool& commandPool) noexcept
+    // milliseconds since a load stage started (GLTFLoadTimings)
+    double getMillisecondsSince(std::chrono::steady_clock::time_point start) noexcept
     {
-        // clear previous data
-        m_meshes.clear();
-        m_vertexCount = 0;
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // adds its lifetime to a nanosecond total shared by the workers of a parallel load stage
+    class ScopedStageTime final
+    {
+        public:
+            explicit ScopedStageTime(std::atomic<uint64_t>& total) noexcept
+                : m_total(total)
+                , m_start(std::chrono::steady_clock::now())
+            {
+            }
+
+            ~ScopedStageTime()
+            {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+                m_total.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+            }
+
+            ScopedStageTime(const ScopedStageTime&) = delete;
+            ScopedStageTime& operator=(const ScopedStageTime&) = delete;
+
+        private:
+            std::atomic<uint64_t>&                  m_total;
+            std::chrono::steady_clock::time_point   m_start;
+    };
+}
+
+namespace keplar
+{
+    // ─────────────────────────────────────────────
+    // GLTF model structures for meshes, nodes, primitives, and materials
+    // ─────────────────────────────────────────────
+    struct GLTFModel::Vertex
+    {
+        glm::vec4 mPosition;
+        glm::vec3 mNormal;
+        glm::vec2 mUV;
+        glm::vec4 mTangent;
+    };
+
+    // compact vertex (24 bytes) decoded by the vertex input formats, so existing shaders read it unchanged.
+    // position is quantized to the primitive bounds and restored by its dequantize matrix; normal and tangent
+    // are pre-scaled by the same bounds so the shader's inverse-transpose of (model * dequantize) stays correct
+    struct GLTFModel::PackedVertex
+    {
+        uint16_t mPosition[4];      // unorm16, w = 1
+        int16_t  mNormal[4];        // snorm16, w unused
+        uint32_t mUV;               // half2
+        int8_t   mTangent[4];       // snorm8, w: handedness
+    };
+
+    // simplified index range of a primitive over the same vertices; error is in the primitive's local units
+    struct GLTFModel::PrimitiveLod
+    {
+        uint32_t mFirstIndex;
+        uint32_t mIndexCount;
+        float    mError;
+    };
+
+    // range of indices with a single material
+    struct GLTFModel::Primitive 
+    {
+        uint32_t    mFirstIndex;
+        uint32_t    mIndexCount;
+        uint32_t    mLodCount;      // simplified levels in mLods, coarser with each
+        std::array<PrimitiveLod, GLTFModel::kMaxLodCount> mLods;
+        uint32_t    mFirstVertex;   // within the static or skinned vertex pool
+        uint32_t    mVertexCount;
+        uint32_t    mFirstMeshlet;  // full-detail meshlets (none for skinned primitives)
+        uint32_t    mMeshletCount;
+        int32_t     mMaterialIndex;
+        bool        mIsSkinned;     // indices address the skinned vertex pool
+        BoundingBox mBounds;        // local space
+        glm::mat4   mDequantize;    // packed position -> local space (identity for float vertices)
+    };
+
+    // mesh containing multiple primitives
+    struct GLTFModel::Mesh
+    {
+        std::string mName;
+        std::vector<Primitive> mPrimitives;
+        uint32_t mFirstMorphWeight;     // the mesh's run in the model-wide morph weights
+        uint32_t mMorphWeightCount;
+    };
+
+    // scene node as parsed from gltf; runtime transforms live in the flattened hierarchy
+    struct GLTFModel::Node 
+    {
+        std::string           mName;
+        int32_t               mMeshIndex;
+        int32_t               mSkinIndex;
+        glm::vec3             mTranslation;
+        glm::quat             mRotation;
+        glm::vec3             mScale;
+        glm::mat4             mLocalTransform;
+        std::vector<int32_t>  mChildren;
+    };
+
+    // scene with root node indices
+    struct GLTFModel::Scene
+    {
+        std::string mName;
+        std::vector<int32_t> mRootNodes; 
+    };
+
+    // pbr material data and descriptor
+    struct GLTFModel::Material 
+    {
+        glm::vec4 mBaseColor;
+        float     mMetallic;
+        float     mRoughness;
+        float     mSpecular;
+        glm::vec3 mEmissive;
+        float     mOcclusion;           // ambient occlusion factor, from a constant occlusion image
+
+        std::optional<uint32_t> mBaseColorTex; 
+        std::optional<uint32_t> mMetallicRoughnessTex;
+        std::optional<uint32_t> mNormalTex;
+        std::optional<uint32_t> mOcclusionTex;
+        std::optional<uint32_t> mEmissiveTex;
+        bool                    mIsOcclusionPacked;     // occlusion is the red channel of the metallic roughness map
+
+        // kMask discards below the cutoff; kBlend blends where a pipeline has a blended permutation, opaque otherwise
+        float     mAlphaCutoff;
+        GLTFAlphaMode mAlphaMode;
+        bool      mIsDoubleSided;
+        uint32_t  mFeatures;            // GLTFMaterialFeature bits
+        uint32_t  mPermutation;         // index into m_materialPermutations
+
+        VkDescriptorSet mDescriptorSet;
+        VkDescriptorSet mSpareDescriptorSet;    // idle copy while streaming textures
+        uint64_t        mDescriptorSwapFrame;   // streaming update that made mDescriptorSet the bound copy
+        bool            mIsDescriptorStale;     // a texture was swapped since mDescriptorSet was written
+    };
+
+    // what loadTextures found in a decoded image for loadMaterials: material slots sampling a single-color image fold
+    // into the factors, and an occlusion image copied into the unused red channel of a metallic roughness image is read
+    // from there
+    struct GLTFModel::ImageFold
+    {
+        glm::vec4 mColor            = glm::vec4(1.0f);  // what every sample returns when mIsConstant
+        bool      mIsConstant       = false;
+        int32_t   mPackedOcclusion  = -1;               // occlusion image held in the red channel, -1 for none
+    };
+
+    // sampler state of a gltf sampler (raw gltf enums, -1 when unspecified); stored as is in baked caches
+    struct GLTFModel::TextureSampler
+    {
+        int32_t mMagFilter = -1;
+        int32_t mMinFilter = -1;
+        int32_t mWrapS     = TINYGLTF_TEXTURE_WRAP_REPEAT;
+        int32_t mWrapT     = TINYGLTF_TEXTURE_WRAP_REPEAT;
+    };
+
+    // where a texture packed by packTextureArrays lives: a layer of one of the model's image arrays
+    struct GLTFModel::TextureLayer
+    {
+        uint32_t mArray = UINT32_MAX;   // index into m_textureArrays, UINT32_MAX when the texture has an image of its own
+        uint32_t mLayer = 0;
+    };
+
+    // primitive instanced by a flattened node, with cached world-space bounds
+    struct GLTFModel::DrawItem
+    {
+        uint32_t    mNode;              // index into the flattened hierarchy
+        uint32_t    mFirstIndex;
+        uint32_t    mIndexCount;
+        uint32_t    mLodCount;
+        std::array<PrimitiveLod, GLTFModel::kMaxLodCount> mLods;
+        uint32_t    mBaseVertex;        // primitive's first vertex in its pool, which its indices are relative to
+        uint32_t    mFirstMeshlet;
+        uint32_t    mMeshletCount;
+        int32_t     mMaterialIndex;
+        uint32_t    mPrimitive;         // dense mesh primitive id; equal ids draw the same geometry
+        bool        mIsSkinned;
+        glm::mat4   mDequantize;
+        BoundingBox mLocalBounds;
+        BoundingBox mWorldBounds;
+    };
+
+    // visible draw item, its sort key and level of detail (0: full), rebuilt by every render call
+    struct GLTFModel::DrawListEntry
+    {
+        uint64_t mKey;
+        uint32_t mItem;
+        uint32_t mLod;
+        uint32_t mPlacement;
+    };
+
+    // consecutive draw list entries recorded as one (instanced) draw
+    struct GLTFModel::DrawRun
+    {
+        uint32_t mFirst;            // first draw list entry
+        uint32_t mCount;            // entries, i.e. instances
+        uint32_t mInstanceBase;     // first instance matrix or object record
+        glm::mat4 mModel;           // push constant transform of an unmerged run, captured at prepare time
+    };
+
+    // per-object record of the bindless cpu path, indexed by the pushed object index (std430, matches pbr_object.vert)
+    struct alignas(16) GLTFModel::ObjectData
+    {
+        glm::mat4  mModel;
+        glm::uvec4 mInfo;               // x: material index
+    };
+
+    // per-draw record read by the culling shader and, as instance attributes, by the vertex stage (std430)
+    struct GLTFModel::DrawData
+    {
+        glm::mat4  mModel;
+        glm::vec4  mBoundingSphere;     // xyz: world-space center, w: radius
+        glm::uvec4 mDrawInfo;           // x: first index, y: index count, z: batch first command, w: batch index
+        glm::ivec4 mDrawOffsets;        // x: vertex offset of the draw's pool (its geometry arena range), yzw: unused
+    };
+
+    // vertex input of every pipeline variant, derived from the structs above (locations match the pbr shaders). the
+    // packed layout keeps the locations and is decoded by fixed-function format conversion; indirect and pulled draws
+    // read the draw record's model matrix at locations 4-7, and instanced draws the same columns from bare matrices
+    struct GLTFModel::VertexLayouts
+    {
+        using VertexAttributes = VertexBinding<0, Vertex, VK_VERTEX_INPUT_RATE_VERTEX,
+                                               KEPLAR_VERTEX_ATTRIBUTE(0, Vertex, mPosition),
+                                               KEPLAR_VERTEX_ATTRIBUTE(1, Vertex, mNormal),
+                                               KEPLAR_VERTEX_ATTRIBUTE(2, Vertex, mUV),
+                                               KEPLAR_VERTEX_ATTRIBUTE(3, Vertex, mTangent)>;
+        using PackedAttributes = VertexBinding<0, PackedVertex, VK_VERTEX_INPUT_RATE_VERTEX,
+                                               KEPLAR_VERTEX_ATTRIBUTE_AS(0, PackedVertex, mPosition, VK_FORMAT_R16G16B16A16_UNORM),
+                                               KEPLAR_VERTEX_ATTRIBUTE_AS(1, PackedVertex, mNormal, VK_FORMAT_R16G16B16A16_SNORM),
+                                               KEPLAR_VERTEX_ATTRIBUTE_AS(2, PackedVertex, mUV, VK_FORMAT_R16G16_SFLOAT),
+                                               KEPLAR_VERTEX_ATTRIBUTE_AS(3, PackedVertex, mTangent, VK_FORMAT_R8G8B8A8_SNORM)>;
+        using DrawAttributes   = VertexBinding<kDrawDataVertexBinding, DrawData, VK_VERTEX_INPUT_RATE_INSTANCE,
+                                               KEPLAR_VERTEX_ATTRIBUTE(4, DrawData, mModel)>;
+        using MatrixAttributes = VertexStream<kDrawDataVertexBinding, 4, glm::mat4, VK_VERTEX_INPUT_RATE_INSTANCE>;
+
+        using Standard         = VertexLayout<VertexAttributes>;
+        using Packed           = VertexLayout<PackedAttributes>;
+        using Indirect         = VertexLayout<VertexAttributes, DrawAttributes>;
+        using PackedIndirect   = VertexLayout<PackedAttributes, DrawAttributes>;
+        using Instanced        = VertexLayout<VertexAttributes, MatrixAttributes>;
+        using PackedInstanced  = VertexLayout<PackedAttributes, MatrixAttributes>;
+        using Pulled           = VertexLayout<DrawAttributes>;
+
+        // depth pre-pass: the position stream alone, tightly packed
+        using Depth            = VertexLayout<VertexStream<0, 0, decltype(Vertex::mPosition)>>;
+        using PackedDepth      = VertexLayout<VertexBinding<0, decltype(PackedVertex::mPosition), VK_VERTEX_INPUT_RATE_VERTEX,
+                                                            VertexAttribute<0, decltype(PackedVertex::mPosition), 0, VK_FORMAT_R16G16B16A16_UNORM>>>;
+
+        static_assert(offsetof(DrawData, mModel) == 0, "instanced and indirect draws share the model matrix attributes");
+        static_assert(offsetof(Vertex, mPosition) == 0 && offsetof(PackedVertex, mPosition) == 0, "position streams copy the leading member");
+    };
+
+    // meshlet record read by the task and mesh stages (std430, matches pbr_meshlet.task/.mesh). bounds are in the space the
+    // draw's model matrix maps from, i.e. quantized for packed vertices; vertices index the static pool
+    struct alignas(16) GLTFModel::MeshletData
+    {
+        glm::vec4  mBoundingSphere;     // xyz: center, w: radius
+        glm::vec4  mCone;               // xyz: axis, w: cutoff (> 1: never culled)
+        glm::vec4  mConeApex;           // xyz: apex
+        glm::uvec4 mInfo;               // x: first meshlet vertex, y: first meshlet triangle, z: vertex count, w: triangle count
+    };
+
+    // keyframes of one animated property; cubic spline outputs are (in-tangent, value, out-tangent) triplets. every output
+    // is mWidth vec4s: one for a transform, the weights of every target four at a time for morph weights
+    struct GLTFModel::AnimationSampler
+    {
+        enum class Interpolation : uint8_t { kLinear, kStep, kCubicSpline };
+
+        Interpolation           mInterpolation;
+        std::vector<float>      mInputs;
+        std::vector<glm::vec4>  mOutputs;
+        uint32_t                mWidth;
+    };
+
+    // binds a sampler to the translation, rotation or scale of a flattened node, or to the morph weights of its mesh
+    struct GLTFModel::AnimationChannel
+    {
+        enum class Path : uint8_t { kTranslation, kRotation, kScale, kWeights };
+
+        Path     mPath;
+        uint32_t mNode;
+        uint32_t mSampler;
+        uint32_t mFirstWeight;      // kWeights: run in the model-wide morph weights
+        uint32_t mWeightCount;
+    };
+
+    struct GLTFModel::Animation
+    {
+        std::string                     mName;
+        std::vector<AnimationSampler>   mSamplers;
+        std::vector<AnimationChannel>   mChannels;
+        float                           mStart;
+        float                           mEnd;
+    };
+
+    // contiguous range of indirect commands sharing one material
+    struct GLTFModel::DrawBatch
+    {
+        int32_t  mMaterialIndex;
+        uint32_t mFirstCommand;
+        uint32_t mCommandCount;
+        bool     mIsSkinned;
+    };
+
+    // per-vertex skin influences (std430); joints index the model-wide joint matrix array
+    struct GLTFModel::SkinVertex
+    {
+        glm::uvec4 mJoints;
+        glm::vec4  mWeights;
+    };
+
+    // displacement of one vertex by one morph target (std430, see skinning.comp); a vertex's deltas are contiguous and
+    // mTarget indexes the model-wide morph weights
+    struct GLTFModel::MorphDelta
+    {
+        glm::vec3  mPosition;
+        uint32_t   mTarget;
+        glm::vec4  mNormal;         // xyz
+        glm::vec4  mTangent;        // xyz; the handedness never morphs
+    };
+
+    // skin bound to one mesh node of the default scene; its joint matrices start at mJointOffset
+    struct GLTFModel::Skin
+    {
+        std::string             mName;
+        std::vector<uint32_t>   mJoints;                // flattened node indices
+        std::vector<glm::mat4>  mInverseBindMatrices;
+        uint32_t                mMeshNode;
+        uint32_t                mJointOffset;
+    };
+
+    // cpu output of the tinygltf path kept alive for the baked cache instead of being released after upload
+    struct GLTFModel::BakeData
+    {
+        std::vector<uint8_t>        mVertexData;        // static pool in its final (standard or packed) layout
+        std::vector<Vertex>         mSkinnedVertices;
+        std::vector<uint32_t>       mIndices;
+        std::vector<SkinVertex>     mSkinVertices;      // joints rebased into the model-wide array
+        std::vector<glm::uvec2>     mMorphRanges;       // first delta and count per skinned vertex
+        std::vector<MorphDelta>     mMorphDeltas;
+        std::vector<MeshletData>    mMeshlets;
+        std::vector<uint32_t>       mMeshletVertices;
+        std::vector<uint32_t>       mMeshletTriangles;
+        std::vector<TextureData>    mTextures;
+        std::vector<VkFormat>       mTextureFormats;
+    };
+
+    // gpu-ready blobs of a baked model; geometry points into the decoded storage below, everything else into the
+    // mapped cache file
+    struct GLTFModel::BakedView
+    {
+        const uint8_t*                  mVertexData = nullptr;
+        size_t                          mVertexDataSize = 0;
+        const Vertex*                   mSkinnedVertices = nullptr;
+        size_t                          mSkinnedVertexCount = 0;
+        const uint32_t*                 mIndices = nullptr;
+        size_t                          mIndexCount = 0;
+        const SkinVertex*               mSkinVertices = nullptr;
+        size_t                          mSkinVertexCount = 0;
+        const glm::uvec2*               mMorphRanges = nullptr;
+        size_t                          mMorphRangeCount = 0;
+        const MorphDelta*               mMorphDeltas = nullptr;
+        size_t                          mMorphDeltaCount = 0;
+        const MeshletData*              mMeshlets = nullptr;
+        size_t                          mMeshletCount = 0;
+        const uint32_t*                 mMeshletVertices = nullptr;
+        size_t                          mMeshletVertexCount = 0;
+        const uint32_t*                 mMeshletTriangles = nullptr;
+        size_t                          mMeshletTriangleCount = 0;
+        std::vector<TextureDataView>    mTextures;
+        std::vector<VkFormat>           mTextureFormats;
+        std::vector<std::string>        mTextureNames;
+
+        // geometry decoded out of its compressed streams
+        std::vector<uint8_t>            mVertexStorage;
+        std::vector<Vertex>             mSkinnedVertexStorage;
+        std::vector<uint32_t>           mIndexStorage;
+        std::vector<SkinVertex>         mSkinVertexStorage;
+        std::vector<uint32_t>           mMeshletVertexStorage;
+        std::vector<uint32_t>           mMeshletTriangleStorage;
+    };
+
+    // cpu output of an asynchronous load waiting for uploadPending; the view points into the cache mapping or m_bakeData
+    struct GLTFModel::PendingUpload
+    {
+        std::unique_ptr<ModelCacheReader>   mReader;            // keeps a baked cache mapped until it is staged
+        BakedView                           mBaked;
+        std::filesystem::path               mCachePath;         // written once uploaded when the load bakes
+        ModelCacheKey                       mCacheKey{};
+        bool                                mIsBaking = false;
+    };
+
+    // ─────────────────────────────────────────────
+    // GLTFModel implementation
+    // ─────────────────────────────────────────────
+    GLTFModel::GLTFModel() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_geometryArena(nullptr)
+        , m_vertexCount(0)
+        , m_indexCount(0)
+        , m_indexType(VK_INDEX_TYPE_UINT32)
+        , m_vertexFormat(VertexFormat::kStandard)
+        , m_revisionCounter(0)
+        , m_drawCount(0)
+        , m_isMultiDrawEnabled(false)
+        , m_hasVertexAddresses(false)
+        , m_hasRayTracingInputs(false)
+        , m_isVertexPullingEnabled(false)
+        , m_isDynamicCullModeEnabled(false)
+        , m_skinnedVertexCount(0)
+        , m_isGpuSkinningEnabled(false)
+        , m_activeMorphTargetCount(0)
+        , m_bindlessDescriptorSet(VK_NULL_HANDLE)
+        , m_spareBindlessDescriptorSet(VK_NULL_HANDLE)
+        , m_isBindlessEnabled(false)
+        , m_objectCapacity(0)
+        , m_multiDrawLimit(0)
+        , m_meshletCount(0)
+        , m_meshletDescriptorSet(VK_NULL_HANDLE)
+        , m_repeatedDrawCount(0)
+        , m_isInstancingEnabled(false)
+        , m_maxPlacements(1)
+        , m_isPlacementBoundsDirty(true)
+        , m_vkFallbackSampler(VK_NULL_HANDLE)
+        , m_lodViewPosition(0.0f)
+        , m_lodProjectionScale(0.0f)
+        , m_lodPixelError(1.0f)
+        , m_lodIndexCount(0)
+        , m_drawnTriangleCount(0)
+        , m_fullDetailTriangleCount(0)
+        , m_activeAnimation(0)
+        , m_animationTime(0.0f)
+        , m_isLoadDecoded(false)
+        , m_uploadTicket(0)
+        , m_loadState(GLTFLoadState::kEmpty)
+        , m_streamingFrame(0)
+        , m_bindlessSwapFrame(0)
+        , m_isBindlessDescriptorStale(false)
+    {
+    }
+
+    GLTFModel::~GLTFModel()
+    {
+        // an asynchronous load still decoding writes into the model
+        m_loadTask.wait();
+
+        // clear model resources
+        m_drawBatches.clear();
+        m_drawItems.clear();
+        m_animations.clear();
+        m_skins.clear();
+        m_textureStreamer.reset();
+        m_textures.clear();
+        m_sharedTextures.clear();
+        m_textureArrays.clear();
+        m_textureLayers.clear();
+        m_materials.clear();
+        m_scenes.clear();
+        m_nodes.clear();
+        m_meshes.clear();
+        releaseGeometry();
+    }
+
+    bool GLTFModel::load(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filename, const GLTFLoadConfig& config) noexcept
+    {
+        // an asynchronous load still decoding finishes first and is then replaced
+        m_loadTask.wait();
+        m_loadTask = TaskHandle{};
+        m_pendingUpload.reset();
+    #ifdef KEPLAR_COROUTINES
+        m_loadQueue.clear();
+        m_loadCoroutine.reset();
+    #endif
+
+        m_loadState = loadSource(device, &stagingBelt, filename, config) ? GLTFLoadState::kResident : GLTFLoadState::kFailed;
+        return m_loadState == GLTFLoadState::kResident;
+    }
+
+    TaskHandle GLTFModel::loadAsync(const VulkanDevice& device, const std::string& filename, const GLTFLoadConfig& config) noexcept
+    {
+        // one load at a time per model
+        m_loadTask.wait();
+        m_pendingUpload = std::make_unique<PendingUpload>();
+        m_isLoadDecoded = false;
+        m_loadState = GLTFLoadState::kDecoding;
+
+        // the task does cpu work only; everything recording into the belt waits for pollLoad or finishLoad
+        if (!m_threadPool)
+        {
+            m_threadPool = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()), kReservedFrameWorkers, "model");
+        }
+    #ifdef KEPLAR_COROUTINES
+        // runs up to its hop onto the pool, which stores the decode task's handle
+        m_loadQueue.clear();
+        m_loadCoroutine = runLoad(device, filename, config);
+        m_loadCoroutine.start();
+    #else
+        m_loadTask = m_threadPool->dispatch(TaskPriority::kBackground, [this, &device, filename, config]()
+        {
+            m_isLoadDecoded = loadSource(device, nullptr, filename, config);
+        });
+    #endif
+        return m_loadTask;
+    }
+
+#ifdef KEPLAR_COROUTINES
+    AsyncTask<bool> GLTFModel::runLoad(const VulkanDevice& device, std::string filename, GLTFLoadConfig config) noexcept
+    {
+        // parse and decode as a pool task, which completes once the coroutine moves on to the polling thread
+        co_await resumeOn(*m_threadPool, TaskPriority::kBackground, &m_loadTask);
+        m_isLoadDecoded = loadSource(device, nullptr, filename, config);
+        if (!m_isLoadDecoded)
+        {
+            co_return false;
+        }
+
+        // stage the whole model from the thread polling the load and submit it without waiting
+        co_await m_loadQueue.schedule();
+        if (!uploadPending(device, *m_loadBelt, false))
+        {
+            co_return false;
+        }
+
+        // resident once the copies, and the graphics work depending on them, completed
+        m_uploadTicket = m_loadBelt->getLastSubmittedTicket();
+        m_loadState = GLTFLoadState::kUploading;
+        co_await m_loadQueue.until([this]() { return m_loadBelt->isComplete(m_uploadTicket); });
+        co_return true;
+    }
+#endif
+
+    GLTFLoadState GLTFModel::pollLoad(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept
+    {
+    #ifdef KEPLAR_COROUTINES
+        // the coroutine records with the belt of the poll resuming it
+        (void)device;
+        m_loadBelt = &stagingBelt;
+        m_loadQueue.poll();
+        if ((m_loadState == GLTFLoadState::kDecoding || m_loadState == GLTFLoadState::kUploading) && m_loadCoroutine.isDone())
+        {
+            m_loadTask = TaskHandle{};
+            m_loadState = m_loadCoroutine.getResult() ? GLTFLoadState::kResident : GLTFLoadState::kFailed;
+            m_loadCoroutine.reset();
+            if (m_loadState == GLTFLoadState::kFailed)
+            {
+                VK_LOG_ERROR("GLTFModel::pollLoad :: asynchronous load failed");
+                m_pendingUpload.reset();
+            }
+        }
+        return m_loadState;
+    #else
+        // decoded: stage the whole model and submit it without waiting
+        if (m_loadState == GLTFLoadState::kDecoding && m_loadTask.isDone())
+        {
+            m_loadTask = TaskHandle{};
+            if (!m_isLoadDecoded || !uploadPending(device, stagingBelt, false))
+            {
+                VK_LOG_ERROR("GLTFModel::pollLoad :: asynchronous load failed");
+                m_pendingUpload.reset();
+                m_loadState = GLTFLoadState::kFailed;
+                return m_loadState;
+            }
+
+            m_uploadTicket = stagingBelt.getLastSubmittedTicket();
+            m_loadState = GLTFLoadState::kUploading;
+        }
+
+        // resident once the copies, and the graphics work depending on them, completed
+        if (m_loadState == GLTFLoadState::kUploading && stagingBelt.isComplete(m_uploadTicket))
+        {
+            m_loadState = GLTFLoadState::kResident;
+        }
+        return m_loadState;
+    #endif
+    }
+
+    bool GLTFModel::finishLoad(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept
+    {
+    #ifdef KEPLAR_COROUTINES
+        // drive the coroutine from here: decode first, then staging, then block on its upload
+        m_loadTask.wait();
+        while (m_loadCoroutine.isValid() && !m_loadCoroutine.isDone())
+        {
+            pollLoad(device, stagingBelt);
+            if (m_loadState == GLTFLoadState::kUploading && !m_loadCoroutine.isDone() && !stagingBelt.wait(m_uploadTicket))
+            {
+                VK_LOG_ERROR("GLTFModel::finishLoad :: asynchronous load failed");
+                m_loadQueue.clear();
+                m_loadCoroutine.reset();
+                m_loadState = GLTFLoadState::kFailed;
+                return false;
+            }
+        }
+        return pollLoad(device, stagingBelt) == GLTFLoadState::kResident;
+    #else
+        if (m_loadState == GLTFLoadState::kDecoding)
+        {
+            m_loadTask.wait();
+            m_loadTask = TaskHandle{};
+            if (!m_isLoadDecoded || !uploadPending(device, stagingBelt, true))
+            {
+                VK_LOG_ERROR("GLTFModel::finishLoad :: asynchronous load failed");
+                m_pendingUpload.reset();
+                m_loadState = GLTFLoadState::kFailed;
+                return false;
+            }
+            m_loadState = GLTFLoadState::kResident;
+        }
+
+        // submitted by an earlier pollLoad
+        if (m_loadState == GLTFLoadState::kUploading)
+        {
+            m_loadState = stagingBelt.isComplete(m_uploadTicket) || stagingBelt.wait(m_uploadTicket) ? GLTFLoadState::kResident : GLTFLoadState::kFailed;
+        }
+        return m_loadState == GLTFLoadState::kResident;
+    #endif
+    }
+
+    bool GLTFModel::uploadPending(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, bool waitForCompletion) noexcept
+    {
+        KEPLAR_PROFILE_ZONE("GLTFModel::uploadPending");
+
+        // the tinygltf path left its output in the bake layout; view it as if it had been read from a cache file
+        PendingUpload& pending = *m_pendingUpload;
+        BakedView& baked = pending.mBaked;
+        if (!pending.mReader)
+        {
+            const BakeData& bake = *m_bakeData;
+            baked.mVertexData           = bake.mVertexData.data();
+            baked.mVertexDataSize       = bake.mVertexData.size();
+            baked.mSkinnedVertices      = bake.mSkinnedVertices.data();
+            baked.mSkinnedVertexCount   = bake.mSkinnedVertices.size();
+            baked.mIndices              = bake.mIndices.data();
+            baked.mIndexCount           = bake.mIndices.size();
+            baked.mSkinVertices         = bake.mSkinVertices.data();
+            baked.mSkinVertexCount      = bake.mSkinVertices.size();
+            baked.mMorphRanges          = bake.mMorphRanges.data();
+            baked.mMorphRangeCount      = bake.mMorphRanges.size();
+            baked.mMorphDeltas          = bake.mMorphDeltas.data();
+            baked.mMorphDeltaCount      = bake.mMorphDeltas.size();
+            baked.mMeshlets             = bake.mMeshlets.data();
+            baked.mMeshletCount         = bake.mMeshlets.size();
+            baked.mMeshletVertices      = bake.mMeshletVertices.data();
+            baked.mMeshletVertexCount   = bake.mMeshletVertices.size();
+            baked.mMeshletTriangles     = bake.mMeshletTriangles.data();
+            baked.mMeshletTriangleCount = bake.mMeshletTriangles.size();
+            baked.mTextureFormats       = bake.mTextureFormats;
+            baked.mTextures.resize(bake.mTextures.size());
+            for (size_t i = 0; i < bake.mTextures.size(); ++i)
+            {
+                const TextureData& texture = bake.mTextures[i];
+                TextureDataView& view = baked.mTextures[i];
+                view.mPixels     = texture.mPixels.data();
+                view.mSize       = texture.mPixels.size();
+                view.mMipExtents = texture.mMipExtents.data();
+                view.mMipOffsets = texture.mMipOffsets.data();
+                view.mMipLevels  = static_cast<uint32_t>(texture.mMipExtents.size());
+                view.mChannels   = texture.mChannels;
+                view.mFormat     = texture.mFormat;
+                view.mName       = texture.mName.c_str();
+            }
+        }
+
+        // staging copies every blob into the ring, so neither the mapping nor the cpu output is needed after this
+        if (!uploadBakedModel(device, stagingBelt, baked, waitForCompletion))
+        {
+            VK_LOG_ERROR("GLTFModel::uploadPending :: failed to upload decoded model");
+            return false;
+        }
+
+        // bake for the next launch with the formats the textures were created in; a failed write only costs the cache
+        if (pending.mIsBaking)
+        {
+            for (size_t i = 0; i < m_textures.size() && i < m_bakeData->mTextureFormats.size(); ++i)
+            {
+                if (baked.mTextures[i].mMipLevels != 0)
+                {
+                    m_bakeData->mTextureFormats[i] = m_textures[i].getFormat();
+                }
+            }
+
+            if (!writeBakedModel(pending.mCachePath, pending.mCacheKey))
+            {
+                VK_LOG_WARN("GLTFModel::uploadPending :: failed to write baked cache: %s", pending.mCachePath.string().c_str());
+            }
+        }
+        m_bakeData.reset();
+        m_pendingUpload.reset();
+
+        resolveTextureSamplers(device);
+        m_vkDevice = device.getDevice();
+        return true;
+    }
+
+    bool GLTFModel::loadSource(const VulkanDevice& device, VulkanStagingBelt* stagingBelt, const std::string& filename, const GLTFLoadConfig& config) noexcept
+    {
+        KEPLAR_PROFILE_ZONE("GLTFModel::load");
+        m_loadTimings = GLTFLoadTimings{};
+        const auto loadStart = std::chrono::steady_clock::now();
+        auto stageStart = loadStart;
+
+        // ─────────────────────────────────────────
+        // load glTF model using TinyGLTF (binary .glb or ASCII .gltf)
+        // ─────────────────────────────────────────
+        tinygltf::TinyGLTF tinygltf;
+        tinygltf::Model model;
+        std::string error;
+        std::string warning;
+        bool status = false;
+
+        // keep embedded images encoded, in place where possible; they are decoded in parallel by loadTextures
+        tinygltf.SetImagesAsIs(true);
+        tinygltf.SetImageLoader(keepEncodedImage, nullptr);
+
+        // construct full file path
+        const std::filesystem::path filepath = keplar::config::kModelDir / filename;
+        std::string extension = filepath.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        // ─────────────────────────────────────────
+        // baked cache: map a matching .kmodel and stream its blobs into the staging belt, skipping parsing and decoding.
+        // the key covers the main file only; external .bin and image files of a .gltf are not tracked
+        // ─────────────────────────────────────────
+        ModelCacheKey cacheKey{};
+        const std::filesystem::path cachePath = getModelCachePath(filepath);
+        m_bakeData.reset();
+
+        // static geometry goes into the shared arena when it fits (see createMeshBuffers)
+        releaseGeometry();
+        m_geometryArena = config.mGeometryArena;
+        m_maxPlacements = std::max(config.mMaxPlacements, 1u);
+        m_placements.clear();
+        m_isPlacementBoundsDirty = true;
+
+        // streamed textures keep their decoded chains; replaced images outlive every frame that may still bind them
+        m_textureStreamer.reset();
+        if (config.mStreamTextures)
+        {
+            TextureStreamerConfig streamerConfig{};
+            streamerConfig.mRetireFrames = 2 * (kMaxFramesInFlight + 1);
+            streamerConfig.mUseSparseResidency = config.mSparseTextures;
+            m_textureStreamer = std::make_unique<TextureStreamer>();
+            m_textureStreamer->initialize(streamerConfig);
+        }
+        if (config.mUseBakedCache && getModelCacheKey(filepath, cacheKey))
+        {
+            cacheKey.mVertexFormat = static_cast<uint32_t>(config.mVertexFormat);
+            cacheKey.mFlags        = (config.mOptimizeMeshes ? kBakedFlagOptimizedMeshes : 0) | 
+                                     (config.mMipFilter == MipFilter::kKaiser ? kBakedFlagKaiserMips : 0) |
+                                     (config.mGenerateLods ? kBakedFlagLods : 0) |
+                                     (config.mBuildMeshlets ? kBakedFlagMeshlets : 0);
+
+            // a deferred load keeps the mapping open in m_pendingUpload until uploadPending stages it
+            auto reader = std::make_unique<ModelCacheReader>();
+            BakedView localBaked{};
+            BakedView& baked = stagingBelt ? localBaked : m_pendingUpload->mBaked;
+            if (reader->open(cachePath, cacheKey))
+            {
+                if (readBakedModel(*reader, baked))
+                {
+                    std::error_code errorCode;
+                    const uintmax_t cacheSize = std::filesystem::file_size(cachePath, errorCode);
+                    m_loadTimings.mSourceBytes = errorCode ? 0 : static_cast<uint64_t>(cacheSize);
+                    m_loadTimings.mIsFromCache = true;
+                    m_loadTimings.mParse = getMillisecondsSince(stageStart);
+                    if (!stagingBelt)
+                    {
+                        m_pendingUpload->mReader = std::move(reader);
+                        m_loadTimings.mTotal = getMillisecondsSince(loadStart);
+                        VK_LOG_DEBUG("GLTFModel::load :: model read from baked cache: %s", cachePath.string().c_str());
+                        return true;
+                    }
+
+                    stageStart = std::chrono::steady_clock::now();
+                    if (!uploadBakedModel(device, *stagingBelt, baked))
+                    {
+                        VK_LOG_ERROR("GLTFModel::load :: failed to upload baked model: %s", cachePath.string().c_str());
+                        return false;
+                    }
+
+                    resolveTextureSamplers(device);
+                    m_vkDevice = device.getDevice();
+                    m_loadTimings.mUpload = getMillisecondsSince(stageStart);
+                    m_loadTimings.mTotal = getMillisecondsSince(loadStart);
+                    VK_LOG_DEBUG("GLTFModel::load :: model loaded from baked cache: %s", cachePath.string().c_str());
+                    return true;
+                }
+                VK_LOG_WARN("GLTFModel::load :: baked cache %s is malformed, rebaking", cachePath.string().c_str());
+                baked = BakedView{};
+            }
+
+            // no usable cache: keep the cpu output of this load for baking
+            m_bakeData = std::make_unique<BakeData>();
+            if (!stagingBelt)
+            {
+                m_pendingUpload->mCachePath = cachePath;
+                m_pendingUpload->mCacheKey  = cacheKey;
+                m_pendingUpload->mIsBaking  = true;
+            }
+        }
+
+        // a deferred load captures its gpu-bound output the same way, for uploadPending
+        if (!stagingBelt && !m_bakeData)
+        {
+            m_bakeData = std::make_unique<BakeData>();
+        }
+
+        // load model based on extension (binary: glb; ascii: gltf)
+        if (extension == ".glb")
+        {
+            // parse straight from the resource pack (a compressed entry is decoded once) or a read-only mapping rather
+            // than a heap copy of the file; the mapping closes once tinygltf has copied out the binary chunk
+            std::vector<uint8_t> packedStorage;
+            const uint8_t* packedData = nullptr;
+            size_t packedSize = 0;
+            MappedFile mappedFile;
+            if (AssetPack::getInstance().load(filepath, packedStorage, packedData, packedSize) && packedSize <= std::numeric_limits<unsigned int>::max())
+            {
+                status = tinygltf.LoadBinaryFromMemory(&model, &error, &warning, packedData, static_cast<unsigned int>(packedSize),
+                                                       filepath.parent_path().string());
+                m_loadTimings.mSourceBytes = packedSize;
+            }
+            else if (mappedFile.open(filepath) && mappedFile.getSize() <= std::numeric_limits<unsigned int>::max())
+            {
+                status = tinygltf.LoadBinaryFromMemory(&model, &error, &warning, mappedFile.getData(), static_cast<unsigned int>(mappedFile.getSize()),
+                                                       filepath.parent_path().string());
+                m_loadTimings.mSourceBytes = mappedFile.getSize();
+            }
+            else
+            {
+                status = tinygltf.LoadBinaryFromFile(&model, &error, &warning, filepath.string());
+            }
+        }
+        else if (extension == ".gltf")
+        {
+            // the json may be packed; its external buffers and images resolve like any other asset
+            std::vector<uint8_t> packedStorage;
+            const uint8_t* packedData = nullptr;
+            size_t packedSize = 0;
+            if (AssetPack::getInstance().load(filepath, packedStorage, packedData, packedSize) && packedSize <= std::numeric_limits<unsigned int>::max())
+            {
+                status = tinygltf.LoadASCIIFromString(&model, &error, &warning, reinterpret_cast<const char*>(packedData),
+                                                      static_cast<unsigned int>(packedSize), filepath.parent_path().string());
+            }
+            else
+            {
+                status = tinygltf.LoadASCIIFromFile(&model, &error, &warning, filepath.string());
+            }
+        }
+        else 
+        {
+            VK_LOG_ERROR("GLTFModel::load :: unsupported model format: %s", filename.c_str());
+            return false;
+        }
+
+        // log warnings
+        if (!warning.empty())
+        {
+            VK_LOG_WARN("GLTFModel::load :: tinygltf - %s: %s", filepath.c_str(), warning.c_str());
+        }
+
+        // check for errors
+        if (!status || !error.empty())
+        {
+            VK_LOG_ERROR("GLTFModel::load :: tinygltf failed to load model: %s (error: %s)", filepath.c_str(), error.c_str());
+            return false;
+        }
+
+        // files read by tinygltf itself: the main file only, external buffers and images are not counted
+        if (m_loadTimings.mSourceBytes == 0)
+        {
+            std::error_code errorCode;
+            const uintmax_t fileSize = std::filesystem::file_size(filepath, errorCode);
+            m_loadTimings.mSourceBytes = errorCode ? 0 : static_cast<uint64_t>(fileSize);
+        }
+        m_loadTimings.mParse = getMillisecondsSince(stageStart);
+        stageStart = std::chrono::steady_clock::now();
+
+        // ─────────────────────────────────────────
+        // load individual model components: meshes, nodes, scenes, textures, materials
+        // ─────────────────────────────────────────
+        if (!loadMeshes(model, device, stagingBelt, config))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to load meshes");
+            return false;
+        }
+        m_loadTimings.mMeshes = getMillisecondsSince(stageStart);
+        stageStart = std::chrono::steady_clock::now();
+
+        if (!loadSceneGraph(model))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to load nodes and scenes");
+            return false;
+        }
+
+        if (!loadSkins(model, device, stagingBelt))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to load skins");
+            return false;
+        }
+
+        if (!loadAnimations(model))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to load animations");
+            return false;
+        }
+        m_loadTimings.mSceneGraph = getMillisecondsSince(stageStart);
+        stageStart = std::chrono::steady_clock::now();
+
+        std::vector<ImageFold> imageFolds;
+        if (!loadTextures(model, device, stagingBelt, config, imageFolds))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to load textures");
+            return false;
+        }
+        m_loadTimings.mTextures = getMillisecondsSince(stageStart);
+        stageStart = std::chrono::steady_clock::now();
+
+        if (!loadMaterials(model, imageFolds))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to load materials");
+            return false;
+        }
+
+        // deferred: what is left records gpu work
+        if (!stagingBelt)
+        {
+            m_loadTimings.mMaterials = getMillisecondsSince(stageStart);
+            m_loadTimings.mTotal = getMillisecondsSince(loadStart);
+            VK_LOG_DEBUG("GLTFModel::load :: model decoded: %s", filename.c_str());
+            return true;
+        }
+
+        if (!createDrawBuffers(device, *stagingBelt))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to create draw buffers");
+            return false;
+        }
+
+        if (!createMaterialBuffer(device, *stagingBelt))
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to create material buffer");
+            return false;
+        }
+        m_loadTimings.mMaterials = getMillisecondsSince(stageStart);
+        stageStart = std::chrono::steady_clock::now();
+
+        // submit every buffer and texture upload of the model as one batch
+        if (!stagingBelt->flush())
+        {
+            VK_LOG_ERROR("GLTFModel::load :: failed to flush staged uploads");
+            return false;
+        }
+        m_loadTimings.mUpload = getMillisecondsSince(stageStart);
+        stageStart = std::chrono::steady_clock::now();
+
+        // bake for the next launch; a failed write only costs the cache
+        if (m_bakeData)
+        {
+            if (!writeBakedModel(cachePath, cacheKey))
+            {
+                VK_LOG_WARN("GLTFModel::load :: failed to write baked cache: %s", cachePath.string().c_str());
+            }
+            m_bakeData.reset();
+        }
+        m_loadTimings.mBake = getMillisecondsSince(stageStart);
+
+        // store device for later use
+        resolveTextureSamplers(device);
+        m_vkDevice = device.getDevice();
+        m_loadTimings.mTotal = getMillisecondsSince(loadStart);
+        VK_LOG_DEBUG("GLTFModel::load :: model loaded successfully: %s", filename.c_str());
+        return true;
+    }
+
+    void GLTFModel::render(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, const Frustum* frustum) noexcept
+    {
+        // gather and sort on this thread, then record every run
+        const uint32_t runCount = prepareDraws(frameIndex, frustum);
+        recordDraws(commandBuffer, pipelineLayout, frameIndex, 0, runCount);
+    }
+
+    uint32_t GLTFModel::prepareDraws(uint32_t frameIndex, const Frustum* frustum) noexcept
+    {
+        // skip if the default scene has nothing to draw
+        m_drawList.clear();
+        m_drawRuns.clear();
+        if (m_drawItems.empty())
+        {
+            VK_LOG_DEBUG("GLTFModel::prepareDraws :: no meshes or scenes loaded");
+            return 0;
+        }
+
+        // the near plane doubles as the view direction for depth sorting; without a frustum draws sort by state only
+        const glm::vec4 nearPlane = frustum ? frustum->mPlanes[Frustum::kNear] : glm::vec4(0.0f);
+        m_drawnTriangleCount = 0;
+        m_fullDetailTriangleCount = 0;
+
+        // each placement left by the batch cull walks the hierarchy in model space, with the frustum and view brought into it
+        const uint32_t placementCount = cullPlacements(frustum);
+        for (uint32_t visibleIdx = 0; visibleIdx < placementCount; ++visibleIdx)
+        {
+            const uint32_t placement = m_visiblePlacements[visibleIdx];
+            const glm::mat4 modelToWorld = m_placements.empty() ? glm::mat4(1.0f) : m_placements[placement];
+            Frustum placementFrustum{};
+            if (frustum)
+            {
+                placementFrustum = m_placements.empty() ? *frustum : frustum->transformed(modelToWorld);
+            }
+            const Frustum* localFrustum = frustum ? &placementFrustum : nullptr;
+            const glm::vec3 lodViewPosition = m_placements.empty() ? m_lodViewPosition : glm::vec3(glm::inverse(modelToWorld) * glm::vec4(m_lodViewPosition, 1.0f));
+
+            // gather: linear walk over the flattened hierarchy; culled subtrees are skipped as one contiguous range
+            const uint32_t nodeCount = static_cast<uint32_t>(m_nodeParents.size());
+            for (uint32_t nodeIdx = 0; nodeIdx < nodeCount; )
+            {
+                // subtree has no geometry or lies outside the frustum
+                const BoundingBox& subtreeBounds = m_nodeBounds[nodeIdx];
+                if (!subtreeBounds.isValid() || (localFrustum && !localFrustum->intersectsBox(subtreeBounds)))
+                {
+                    nodeIdx = m_nodeSubtreeEnds[nodeIdx];
+                    continue;
+                }
+
+                // collect the node's visible draw items
+                const glm::uvec2 drawRange = m_nodeDrawRanges[nodeIdx];
+                for (uint32_t itemIdx = drawRange.x; itemIdx < drawRange.x + drawRange.y; ++itemIdx)
+                {
+                    // skip primitives outside the frustum
+                    const DrawItem& item = m_drawItems[itemIdx];
+                    if (localFrustum && !localFrustum->intersectsBox(item.mWorldBounds))
+                    {
+                        continue;
+                    }
+
+                    // levels of one primitive are distinct geometry, so they key (and instance) separately; depth is in world units
+                    const glm::vec3 center(modelToWorld * glm::vec4(item.mWorldBounds.getCenter(), 1.0f));
+                    const float depth = glm::dot(glm::vec3(nearPlane), center) + nearPlane.w;
+                    const Material& material = m_materials[item.mMaterialIndex];
+                    const uint32_t lod = selectLod(item, lodViewPosition);
+                    const uint32_t geometry = item.mPrimitive * (kMaxLodCount + 1) + lod;
+                    const uint64_t key = makeDrawSortKey(material.mAlphaMode, material.mPermutation, item.mIsSkinned, item.mMaterialIndex, geometry, depth);
+                    m_drawList.push_back({ key, itemIdx, lod, placement });
+                    m_drawnTriangleCount += (lod > 0 ? item.mLods[lod - 1].mIndexCount : item.mIndexCount) / 3;
+                    m_fullDetailTriangleCount += item.mIndexCount / 3;
+                }
+
+                ++nodeIdx;
+            }
+        }
+
+        // sort: opaque, masked, then blended draws; state changes happen once per permutation, vertex pool and material within
+        // the first two classes; ties keep traversal order
+        std::sort(m_drawList.begin(), m_drawList.end(), [](const DrawListEntry& a, const DrawListEntry& b) noexcept
+        {
+            if (a.mKey != b.mKey)
+            {
+                return a.mKey < b.mKey;
+            }
+            return a.mPlacement != b.mPlacement ? a.mPlacement < b.mPlacement : a.mItem < b.mItem;
+        });
+
+        // bindless: transforms and material indices go to this frame's region of the object buffer, draws push only an index;
+        // otherwise with instancing, per-instance model matrices go to this frame's instance buffer (instance-rate binding)
+        const bool isObjectData = isObjectDataActive(frameIndex);
+        const bool isInstanced  = isInstancingActive(frameIndex);
+        const bool mergeRuns    = isInstanced || isObjectData;
+        const uint32_t objectBase = isObjectData ? frameIndex * m_objectCapacity : 0;
+        glm::mat4* instances = isInstanced ? static_cast<glm::mat4*>(m_instanceBuffers[frameIndex].getMappedData()) : nullptr;
+        VkDrawIndexedIndirectCommand* runCommands = isInstanced ? static_cast<VkDrawIndexedIndirectCommand*>(m_runCommandBuffers[frameIndex].getMappedData()) : nullptr;
+        m_objectData.clear();
+
+        // group: with instancing or object data, every run of one primitive and material becomes a single draw
+        for (size_t first = 0, last = 0; first < m_drawList.size(); first = last)
+        {
+            const DrawItem& item = m_drawItems[m_drawList[first].mItem];
+            for (last = first + 1; mergeRuns && last < m_drawList.size(); ++last)
+            {
+                const DrawItem& next = m_drawItems[m_drawList[last].mItem];
+                if (next.mPrimitive != item.mPrimitive || next.mMaterialIndex != item.mMaterialIndex || next.mIsSkinned != item.mIsSkinned ||
+                    m_drawList[last].mLod != m_drawList[first].mLod)
+                {
+                    break;
+                }
+            }
+
+            // per-instance data of the run, consecutive from its instance base
+            const uint32_t instanceBase = objectBase + static_cast<uint32_t>(first);
+            for (size_t i = first; i < last && mergeRuns; ++i)
+            {
+                const DrawItem& instance = m_drawItems[m_drawList[i].mItem];
+                const glm::mat4 model = getPlacement(m_drawList[i].mPlacement) * m_nodeWorldTransforms[instance.mNode] * instance.mDequantize;
+                if (isObjectData)
+                {
+                    m_objectData.push_back({ model, glm::uvec4(static_cast<uint32_t>(instance.mMaterialIndex), 0u, 0u, 0u) });
+                }
+                else
+                {
+                    instances[i] = model;
+                }
+            }
+
+            const glm::mat4 runModel = mergeRuns ? glm::mat4(1.0f) : getPlacement(m_drawList[first].mPlacement) * m_nodeWorldTransforms[item.mNode] * item.mDequantize;
+            m_drawRuns.push_back({ static_cast<uint32_t>(first), static_cast<uint32_t>(last - first), instanceBase, runModel });
+
+            // the same draw as an indirect command, for recordIndirectDraws
+            if (runCommands)
+            {
+                const uint32_t lod = m_drawList[first].mLod;
+                VkDrawIndexedIndirectCommand& command = runCommands[m_drawRuns.size() - 1];
+                command.indexCount    = lod > 0 ? item.mLods[lod - 1].mIndexCount : item.mIndexCount;
+                command.instanceCount = static_cast<uint32_t>(last - first);
+                command.firstIndex    = m_geometryRange.mFirstIndex + (lod > 0 ? item.mLods[lod - 1].mFirstIndex : item.mFirstIndex);
+                command.vertexOffset  = getVertexOffset(item.mIsSkinned, item.mBaseVertex);
+                command.firstInstance = instanceBase;
+            }
+        }
+
+        // one copy of the frame's object records; the gpu reads them only when the commands execute
+        if (isObjectData && !m_objectData.empty())
+        {
+            ObjectData* objects = static_cast<ObjectData*>(m_objectBuffer.getMappedData());
+            std::memcpy(objects + objectBase, m_objectData.data(), m_objectData.size() * sizeof(ObjectData));
+            m_objectBuffer.flush(sizeof(ObjectData) * objectBase, sizeof(ObjectData) * m_objectData.size());
+        }
+        else if (isInstanced && !m_drawList.empty())
+        {
+            m_instanceBuffers[frameIndex].flush(0, sizeof(glm::mat4) * m_drawList.size());
+            if (runCommands)
+            {
+                m_runCommandBuffers[frameIndex].flush(0, sizeof(VkDrawIndexedIndirectCommand) * m_drawRuns.size());
+            }
+        }
+
+        return static_cast<uint32_t>(m_drawRuns.size());
+    }
+
+    void GLTFModel::recordDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, uint32_t runCount,
+                                const VkPipeline* permutationPipelines) const noexcept
+    {
+        VulkanCommandRecorder recorder(commandBuffer);
+        recordDraws(recorder, pipelineLayout, frameIndex, firstRun, runCount, permutationPipelines);
+    }
+
+    void GLTFModel::recordDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, uint32_t runCount,
+                                const VkPipeline* permutationPipelines) const noexcept
+    {
+        // clamp to the prepared runs
+        const uint32_t endRun = std::min(firstRun + runCount, static_cast<uint32_t>(m_drawRuns.size()));
+        if (firstRun >= endRun)
+        {
+            return;
+        }
+
+        // bind shared index buffer (all primitives index into the same buffer)
+        recorder.bindIndexBuffer(getIndexBuffer(), 0, m_indexType);
+
+        // bindless: every material is reached through one set, bound once for the whole model
+        if (m_isBindlessEnabled)
+        {
+            recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &m_bindlessDescriptorSet);
+        }
+
+        // must match the modes prepareDraws wrote the run data for
+        const bool isObjectData = isObjectDataActive(frameIndex);
+        const bool isInstanced  = isInstancingActive(frameIndex);
+        if (isInstanced)
+        {
+            const VkBuffer instanceBuffer = m_instanceBuffers[frameIndex].get();
+            const VkDeviceSize offset = 0;
+            recorder.bindVertexBuffers(kDrawDataVertexBinding, 1, &instanceBuffer, &offset);
+        }
+
+        // record in key order; the recorder skips redundant pipeline, cull mode, vertex pool and material binds
+        for (uint32_t runIdx = firstRun; runIdx < endRun; ++runIdx)
+        {
+            const DrawRun& run = m_drawRuns[runIdx];
+            const DrawListEntry& entry = m_drawList[run.mFirst];
+            const DrawItem& item = m_drawItems[entry.mItem];
+            const Material& material = m_materials[item.mMaterialIndex];
+            const uint32_t firstIndex = m_geometryRange.mFirstIndex + (entry.mLod > 0 ? item.mLods[entry.mLod - 1].mFirstIndex : item.mFirstIndex);
+            const uint32_t indexCount = entry.mLod > 0 ? item.mLods[entry.mLod - 1].mIndexCount : item.mIndexCount;
+            const int32_t vertexOffset = getVertexOffset(item.mIsSkinned, item.mBaseVertex);
+
+            // specialized pipeline of the material's permutation; compatible layouts keep the bound sets
+            if (permutationPipelines != nullptr)
+            {
+                recorder.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, permutationPipelines[material.mPermutation]);
+            }
+
+            // sidedness of permutations sharing a pipeline (the per-node pipeline itself keeps its static culling)
+            const VkCullModeFlags cullMode = material.mIsDoubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+            if (permutationPipelines != nullptr && m_isDynamicCullModeEnabled)
+            {
+                recorder.setCullMode(cullMode);
+            }
+
+            // switch between the static and skinned vertex pools
+            const VkBuffer vertexBuffer = item.mIsSkinned ? getSkinnedDrawBuffer(frameIndex).get() : getStaticVertexBuffer().get();
+            const VkDeviceSize poolOffset = 0;
+            recorder.bindVertexBuffers(0, 1, &vertexBuffer, &poolOffset);
+
+            // bind material descriptor set (set: 1), once for consecutive primitives of one material
+            if (!m_isBindlessEnabled)
+            {
+                recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &material.mDescriptorSet);
+            }
+
+            // object data: the run's records are selected by the pushed index plus gl_InstanceIndex
+            const uint32_t multiDrawCount = isObjectData ? getMultiDrawCount(runIdx, endRun, permutationPipelines) : 0;
+            if (multiDrawCount > 1)
+            {
+                // runs of one instance count are consecutive records, so the pushed index plus gl_DrawID strides reach each
+                std::array<VkMultiDrawIndexedInfoEXT, kMaxMultiDrawBatch> drawInfos;
+                for (uint32_t i = 0; i < multiDrawCount; ++i)
+                {
+                    const DrawListEntry& drawEntry = m_drawList[m_drawRuns[runIdx + i].mFirst];
+                    const DrawItem& drawItem = m_drawItems[drawEntry.mItem];
+                    drawInfos[i].firstIndex   = m_geometryRange.mFirstIndex + (drawEntry.mLod > 0 ? drawItem.mLods[drawEntry.mLod - 1].mFirstIndex : drawItem.mFirstIndex);
+                    drawInfos[i].indexCount   = drawEntry.mLod > 0 ? drawItem.mLods[drawEntry.mLod - 1].mIndexCount : drawItem.mIndexCount;
+                    drawInfos[i].vertexOffset = getVertexOffset(drawItem.mIsSkinned, drawItem.mBaseVertex);
+                }
+
+                const ObjectPushConstants objectConstants{ run.mInstanceBase, run.mCount };
+                recorder.pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ObjectPushConstants), &objectConstants);
+                recorder.drawMultiIndexed(multiDrawCount, drawInfos.data(), run.mCount, 0);
+                runIdx += multiDrawCount - 1;
+                continue;
+            }
+
+            if (isObjectData)
+            {
+                const ObjectPushConstants objectConstants{ run.mInstanceBase, 0 };
+                recorder.pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ObjectPushConstants), &objectConstants);
+                recorder.drawIndexed(indexCount, run.mCount, firstIndex, vertexOffset, 0);
+                continue;
+            }
+
+            // prepare push constants
+            PushConstants pushConstants{};
+            pushConstants.model         = run.mModel;
+            pushConstants.baseColor     = material.mBaseColor;
+            pushConstants.pbrFactors    = glm::vec4(material.mMetallic, material.mRoughness, material.mSpecular, material.mAlphaCutoff);
+            pushConstants.emissiveColor = glm::vec4(material.mEmissive, material.mOcclusion);
+            pushConstants.materialInfo  = glm::uvec4(static_cast<uint32_t>(item.mMaterialIndex), 0u, 0u, 0u);
+    
+            // record push constants and issue indexed draw call; instanced runs select their matrices through firstInstance
+            recorder.pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+            recorder.drawIndexed(indexCount, run.mCount, firstIndex, vertexOffset, isInstanced ? run.mInstanceBase : 0);
+        }
+    }
+
+    void GLTFModel::recordIndirectDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                        uint32_t runCount, const VkPipeline* permutationPipelines) const noexcept
+    {
+        VulkanCommandRecorder recorder(commandBuffer);
+        recordIndirectDraws(recorder, pipelineLayout, frameIndex, firstRun, runCount, permutationPipelines);
+    }
+
+    void GLTFModel::recordIndirectDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                        uint32_t runCount, const VkPipeline* permutationPipelines) const noexcept
+    {
+        // commands were written only for runs prepared with instancing
+        if (!isInstancingActive(frameIndex) || m_runCommandBuffers[frameIndex].getMappedData() == nullptr)
+        {
+            recordDraws(recorder, pipelineLayout, frameIndex, firstRun, runCount, permutationPipelines);
+            return;
+        }
+
+        // clamp to the prepared runs
+        const uint32_t endRun = std::min(firstRun + runCount, static_cast<uint32_t>(m_drawRuns.size()));
+        if (firstRun >= endRun)
+        {
+            return;
+        }
+
+        // shared index buffer and this frame's instance transforms, as for instanced recordDraws
+        recorder.bindIndexBuffer(getIndexBuffer(), 0, m_indexType);
+        const VkBuffer instanceBuffer = m_instanceBuffers[frameIndex].get();
+        const VkDeviceSize instanceOffset = 0;
+        recorder.bindVertexBuffers(kDrawDataVertexBinding, 1, &instanceBuffer, &instanceOffset);
+
+        constexpr uint32_t kCommandStride = sizeof(VkDrawIndexedIndirectCommand);
+        const VkBuffer runCommandBuffer = m_runCommandBuffers[frameIndex].get();
+        for (uint32_t runIdx = firstRun; runIdx < endRun; )
+        {
+            const DrawItem& item = m_drawItems[m_drawList[m_drawRuns[runIdx].mFirst].mItem];
+            const Material& material = m_materials[item.mMaterialIndex];
+
+            // runs are sorted by material within a vertex pool: the ones that bind the same state share one call
+            uint32_t lastRun = runIdx + 1;
+            for (; lastRun < endRun; ++lastRun)
+            {
+                const DrawItem& next = m_drawItems[m_drawList[m_drawRuns[lastRun].mFirst].mItem];
+                if (next.mMaterialIndex != item.mMaterialIndex || next.mIsSkinned != item.mIsSkinned)
+                {
+                    break;
+                }
+            }
+
+            if (permutationPipelines != nullptr)
+            {
+                recorder.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, permutationPipelines[material.mPermutation]);
+                if (m_isDynamicCullModeEnabled)
+                {
+                    recorder.setCullMode(material.mIsDoubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT);
+                }
+            }
+
+            const VkBuffer vertexBuffer = item.mIsSkinned ? getSkinnedDrawBuffer(frameIndex).get() : getStaticVertexBuffer().get();
+            const VkDeviceSize poolOffset = 0;
+            recorder.bindVertexBuffers(0, 1, &vertexBuffer, &poolOffset);
+            recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &material.mDescriptorSet);
+
+            // merged runs carry their transforms per instance
+            PushConstants pushConstants{};
+            pushConstants.model         = glm::mat4(1.0f);
+            pushConstants.baseColor     = material.mBaseColor;
+            pushConstants.pbrFactors    = glm::vec4(material.mMetallic, material.mRoughness, material.mSpecular, material.mAlphaCutoff);
+            pushConstants.emissiveColor = glm::vec4(material.mEmissive, material.mOcclusion);
+            pushConstants.materialInfo  = glm::uvec4(static_cast<uint32_t>(item.mMaterialIndex), 0u, 0u, 0u);
+            recorder.pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+
+            const VkDeviceSize commandOffset = static_cast<VkDeviceSize>(runIdx) * kCommandStride;
+            if (m_isMultiDrawEnabled)
+            {
+                recorder.drawIndexedIndirect(runCommandBuffer, commandOffset, lastRun - runIdx, kCommandStride);
+            }
+            else
+            {
+                // without multiDrawIndirect each call may read only one command
+                for (uint32_t i = 0; i < lastRun - runIdx; ++i)
+                {
+                    recorder.drawIndexedIndirect(runCommandBuffer, commandOffset + i * kCommandStride, 1, kCommandStride);
+                }
+            }
+            runIdx = lastRun;
+        }
+    }
+
+    uint32_t GLTFModel::getMultiDrawCount(uint32_t firstRun, uint32_t endRun, const VkPipeline* permutationPipelines) const noexcept
+    {
+        // the following runs join while nothing recordDraws binds per run changes: the permutation pipeline, the cull mode
+        // set with it and the vertex pool (materials come from the object records); one instance count keeps records strided
+        const uint32_t limit = std::min({ m_multiDrawLimit, kMaxMultiDrawBatch, endRun - firstRun });
+        if (limit < 2)
+        {
+            return 0;
+        }
+
+        const DrawRun& run = m_drawRuns[firstRun];
+        const DrawItem& item = m_drawItems[m_drawList[run.mFirst].mItem];
+        const Material& material = m_materials[item.mMaterialIndex];
+        uint32_t count = 1;
+        for (; count < limit; ++count)
+        {
+            const DrawRun& next = m_drawRuns[firstRun + count];
+            const DrawItem& nextItem = m_drawItems[m_drawList[next.mFirst].mItem];
+            const Material& nextMaterial = m_materials[nextItem.mMaterialIndex];
+            if (next.mCount != run.mCount || nextItem.mIsSkinned != item.mIsSkinned ||
+                (permutationPipelines != nullptr && (nextMaterial.mPermutation != material.mPermutation || 
+                                                     nextMaterial.mIsDoubleSided != material.mIsDoubleSided)))
+            {
+                break;
+            }
+        }
+        return count;
+    }
+
+    bool GLTFModel::isObjectDataActive(uint32_t frameIndex) const noexcept
+    {
+        return m_isBindlessEnabled && frameIndex < kMaxFramesInFlight && m_objectBuffer.getMappedData();
+    }
+
+    bool GLTFModel::isInstancingActive(uint32_t frameIndex) const noexcept
+    {
+        return !isObjectDataActive(frameIndex) && m_isInstancingEnabled && frameIndex < kMaxFramesInFlight && m_instanceBuffers[frameIndex].getMappedData();
+    }
+
+    void GLTFModel::recordMeshletDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                       uint32_t runCount, const VkPipeline* permutationPipelines) const noexcept
+    {
+        VulkanCommandRecorder recorder(commandBuffer);
+        recordMeshletDraws(recorder, pipelineLayout, frameIndex, firstRun, runCount, permutationPipelines);
+    }
+
+    void GLTFModel::recordMeshletDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                       uint32_t runCount, const VkPipeline* permutationPipelines) const noexcept
+    {
+        // clamp to the prepared runs; merged runs carry no per-draw transform
+        const uint32_t endRun = std::min(firstRun + runCount, static_cast<uint32_t>(m_drawRuns.size()));
+        if (firstRun >= endRun || m_meshletDescriptorSet == VK_NULL_HANDLE || s_vkCmdDrawMeshTasksEXT == nullptr)
+        {
+            return;
+        }
+
+        if (isObjectDataActive(frameIndex) || isInstancingActive(frameIndex))
+        {
+            VK_LOG_WARN_THROTTLED("GLTFModel::recordMeshletDraws :: runs were prepared for instanced or bindless draws");
+            return;
+        }
+
+        // meshlets and the vertex pool are reached through one set, bound once for the whole model
+        recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 3, 1, &m_meshletDescriptorSet);
+        if (m_isBindlessEnabled)
+        {
+            recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &m_bindlessDescriptorSet);
+        }
+
+        // task draws bypass the recorder's draw calls, so they are counted here
+        uint32_t drawCallCount = 0;
+        for (uint32_t runIdx = firstRun; runIdx < endRun; ++runIdx)
+        {
+            const DrawRun& run = m_drawRuns[runIdx];
+            const DrawItem& item = m_drawItems[m_drawList[run.mFirst].mItem];
+            const Material& material = m_materials[item.mMaterialIndex];
+            if (item.mMeshletCount == 0)
+            {
+                continue;
+            }
+
+            // specialized pipeline of the material's permutation; compatible layouts keep the bound sets
+            if (permutationPipelines != nullptr)
+            {
+                recorder.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, permutationPipelines[material.mPermutation]);
+            }
+
+            // sidedness of permutations sharing a pipeline (the per-node pipeline itself keeps its static culling)
+            const VkCullModeFlags cullMode = material.mIsDoubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+            if (permutationPipelines != nullptr && m_isDynamicCullModeEnabled)
+            {
+                recorder.setCullMode(cullMode);
+            }
+
+            // bind material descriptor set (set: 1) when it changes
+            if (!m_isBindlessEnabled)
+            {
+                recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &material.mDescriptorSet);
+            }
+
+            // the meshlet range rides along with the material factors
+            PushConstants pushConstants{};
+            pushConstants.model         = run.mModel;
+            pushConstants.baseColor     = material.mBaseColor;
+            pushConstants.pbrFactors    = glm::vec4(material.mMetallic, material.mRoughness, material.mSpecular, material.mAlphaCutoff);
+            pushConstants.emissiveColor = glm::vec4(material.mEmissive, material.mOcclusion);
+            pushConstants.materialInfo  = glm::uvec4(static_cast<uint32_t>(item.mMaterialIndex), item.mFirstMeshlet, item.mMeshletCount, 
+                                                     material.mIsDoubleSided ? 1u : 0u);
+
+            // one task invocation per meshlet
+            recorder.pushConstants(pipelineLayout, s_meshletPushConstantRange.stageFlags, 0, sizeof(PushConstants), &pushConstants);
+            s_vkCmdDrawMeshTasksEXT(recorder.get(), (item.mMeshletCount + kMeshletsPerTaskGroup - 1) / kMeshletsPerTaskGroup, 1, 1);
+            ++drawCallCount;
+        }
+
+        VulkanCommandCounters::addDraws(drawCallCount);
+    }
+
+    void GLTFModel::recordDepthDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                     uint32_t runCount, float minPixels, const std::array<VkPipeline, 2>& depthPipelines) const noexcept
+    {
+        VulkanCommandRecorder recorder(commandBuffer);
+        recordDepthDraws(recorder, pipelineLayout, frameIndex, firstRun, runCount, minPixels, depthPipelines);
+    }
+
+    void GLTFModel::recordDepthDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                     uint32_t runCount, float minPixels, const std::array<VkPipeline, 2>& depthPipelines) const noexcept
+    {
+        // clamp to the prepared runs; merged runs carry no per-draw transform
+        const uint32_t endRun = std::min(firstRun + runCount, static_cast<uint32_t>(m_drawRuns.size()));
+        if (firstRun >= endRun || !hasDepthPositions())
+        {
+            return;
+        }
+
+        if (isObjectDataActive(frameIndex) || isInstancingActive(frameIndex))
+        {
+            VK_LOG_WARN_THROTTLED("GLTFModel::recordDepthDraws :: runs were prepared for instanced or bindless draws");
+            return;
+        }
+
+        // the position stream of the static pool, indexed by the shared index buffer
+        const VkBuffer positionBuffer = m_positionBuffer.get();
+        const VkDeviceSize offset = 0;
+        recorder.bindIndexBuffer(getIndexBuffer(), 0, m_indexType);
+        recorder.bindVertexBuffers(0, 1, &positionBuffer, &offset);
+
+        for (uint32_t runIdx = firstRun; runIdx < endRun; ++runIdx)
+        {
+            const DrawRun& run = m_drawRuns[runIdx];
+            const DrawListEntry& entry = m_drawList[run.mFirst];
+            const DrawItem& item = m_drawItems[entry.mItem];
+            const Material& material = m_materials[item.mMaterialIndex];
+            if (item.mIsSkinned || material.mAlphaMode != GLTFAlphaMode::kOpaque)
+            {
+                continue;
+            }
+
+            // small draws occlude little: their screen span at the nearest point of the bounds, as for lod selection
+            if (minPixels > 0.0f && m_lodProjectionScale > 0.0f && item.mWorldBounds.isValid())
+            {
+                const glm::vec3 closestPoint = glm::clamp(m_lodViewPosition, item.mWorldBounds.mMin, item.mWorldBounds.mMax);
+                const float distance = std::max(glm::length(closestPoint - m_lodViewPosition), 1e-3f);
+                const float extent = glm::length(item.mWorldBounds.mMax - item.mWorldBounds.mMin);
+                if (extent * m_lodProjectionScale / distance < minPixels)
+                {
+                    continue;
+                }
+            }
+
+            // culling follows the material, as for its permutation in the main pass
+            const VkPipeline pipeline = depthPipelines[material.mIsDoubleSided ? 1 : 0];
+            recorder.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+            const VkCullModeFlags cullMode = material.mIsDoubleSided ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+            if (m_isDynamicCullModeEnabled)
+            {
+                recorder.setCullMode(cullMode);
+            }
+
+            // only the model matrix of the push constants is read; positions are the model's own, so no arena offset
+            const uint32_t firstIndex = m_geometryRange.mFirstIndex + (entry.mLod > 0 ? item.mLods[entry.mLod - 1].mFirstIndex : item.mFirstIndex);
+            const uint32_t indexCount = entry.mLod > 0 ? item.mLods[entry.mLod - 1].mIndexCount : item.mIndexCount;
+            recorder.pushConstants(pipelineLayout, s_pushConstantRange.stageFlags, 0, sizeof(glm::mat4), &run.mModel);
+            recorder.drawIndexed(indexCount, 1, firstIndex, static_cast<int32_t>(item.mBaseVertex), 0);
+        }
+    }
+
+    void GLTFModel::gatherShadowCasters(const Frustum& frustum, const glm::mat4& modelToWorld, std::vector<ShadowCasterDraw>& casters) const noexcept
+    {
+        if (m_drawItems.empty() || !hasDepthPositions())
+        {
+            return;
+        }
+
+        // the same walk as prepareDraws: each placement culls the hierarchy in its own space
+        const uint32_t placementCount = std::max(static_cast<uint32_t>(m_placements.size()), 1u);
+        for (uint32_t placement = 0; placement < placementCount; ++placement)
+        {
+            const glm::mat4 placementToWorld = modelToWorld * getPlacement(placement);
+            const Frustum localFrustum = frustum.transformed(placementToWorld);
+            const glm::vec3 lodViewPosition = m_placements.empty() ? m_lodViewPosition : glm::vec3(glm::inverse(m_placements[placement]) * glm::vec4(m_lodViewPosition, 1.0f));
+
+            const uint32_t nodeCount = static_cast<uint32_t>(m_nodeParents.size());
+            for (uint32_t nodeIdx = 0; nodeIdx < nodeCount; )
+            {
+                const BoundingBox& subtreeBounds = m_nodeBounds[nodeIdx];
+                if (!subtreeBounds.isValid() || !localFrustum.intersectsBox(subtreeBounds))
+                {
+                    nodeIdx = m_nodeSubtreeEnds[nodeIdx];
+                    continue;
+                }
+
+                const glm::uvec2 drawRange = m_nodeDrawRanges[nodeIdx];
+                for (uint32_t itemIdx = drawRange.x; itemIdx < drawRange.x + drawRange.y; ++itemIdx)
+                {
+                    // skinned draws read the skinned pool, alpha-masked ones would need their texture
+                    const DrawItem& item = m_drawItems[itemIdx];
+                    const Material& material = m_materials[item.mMaterialIndex];
+                    if (item.mIsSkinned || material.mAlphaMode == GLTFAlphaMode::kMask || !localFrustum.intersectsBox(item.mWorldBounds))
+                    {
+                        continue;
+                    }
+
+                    // the main pass's level, so receivers shade against the surface they are drawn with
+                    const uint32_t lod = selectLod(item, lodViewPosition);
+                    ShadowCasterDraw& caster = casters.emplace_back();
+                    caster.mModel         = placementToWorld * m_nodeWorldTransforms[item.mNode] * item.mDequantize;
+                    caster.mFirstIndex    = m_geometryRange.mFirstIndex + (lod > 0 ? item.mLods[lod - 1].mFirstIndex : item.mFirstIndex);
+                    caster.mIndexCount    = lod > 0 ? item.mLods[lod - 1].mIndexCount : item.mIndexCount;
+                    caster.mVertexOffset  = static_cast<int32_t>(item.mBaseVertex);
+                    caster.mIsDoubleSided = material.mIsDoubleSided ? 1u : 0u;
+                }
+
+                ++nodeIdx;
+            }
+        }
+    }
+
+    void GLTFModel::getRayTracingGeometries(std::vector<RayTracingGeometry>& geometries) const noexcept
+    {
+        geometries.clear();
+        if (!m_hasRayTracingInputs || m_drawItems.empty())
+        {
+            return;
+        }
+
+        // primitive ids are dense, so the largest one drawn sizes the list
+        uint32_t primitiveCount = 0;
+        for (const DrawItem& item : m_drawItems)
+        {
+            primitiveCount = std::max(primitiveCount, item.mPrimitive + 1);
+        }
+        geometries.resize(primitiveCount);
+
+        // the position stream holds the static pool only; indices sit after the model's first arena index
+        const bool isPacked = m_vertexFormat == VertexFormat::kPacked;
+        const uint32_t positionStride = static_cast<uint32_t>(isPacked ? sizeof(PackedVertex::mPosition) : sizeof(Vertex::mPosition));
+        const uint32_t positionCount = m_vertexCount - m_skinnedVertexCount;
+        const VkDeviceAddress positionAddress = m_positionBuffer.getDeviceAddress();
+        const VkDeviceAddress indexAddress = m_geometryArena ? m_geometryArena->getIndexBuffer().getDeviceAddress() : m_indexBuffer.getDeviceAddress();
+        const uint32_t indexSize = m_indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+        for (const DrawItem& item : m_drawItems)
+        {
+            // draws of one primitive share its geometry; skinned and alpha-masked ones yield none
+            RayTracingGeometry& geometry = geometries[item.mPrimitive];
+            if (geometry.mTriangleCount > 0 || item.mIsSkinned || m_materials[item.mMaterialIndex].mAlphaMode == GLTFAlphaMode::kMask ||
+                item.mIndexCount < 3 || item.mBaseVertex >= positionCount)
+            {
+                continue;
+            }
+
+            // the highest vertex is bounded by the end of the pool, which is all a build needs to know
+            geometry.mVertexAddress = positionAddress + static_cast<VkDeviceAddress>(item.mBaseVertex) * positionStride;
+            geometry.mVertexFormat  = isPacked ? VK_FORMAT_R16G16B16A16_UNORM : VK_FORMAT_R32G32B32_SFLOAT;
+            geometry.mVertexStride  = positionStride;
+            geometry.mMaxVertex     = positionCount - item.mBaseVertex - 1;
+            geometry.mIndexAddress  = indexAddress + static_cast<VkDeviceAddress>(m_geometryRange.mFirstIndex + item.mFirstIndex) * indexSize;
+            geometry.mIndexType     = m_indexType;
+            geometry.mTriangleCount = item.mIndexCount / 3;
+        }
+    }
+
+    void GLTFModel::gatherRayTracingInstances(const glm::mat4& modelToWorld, std::vector<RayTracingInstance>& instances) const noexcept
+    {
+        if (!m_hasRayTracingInputs)
+        {
+            return;
+        }
+
+        // every static opaque draw, visible or not: shadow rays leave the view frustum
+        const uint32_t placementCount = std::max(static_cast<uint32_t>(m_placements.size()), 1u);
+        for (uint32_t placement = 0; placement < placementCount; ++placement)
+        {
+            const glm::mat4 placementToWorld = modelToWorld * getPlacement(placement);
+            for (const DrawItem& item : m_drawItems)
+            {
+                const Material& material = m_materials[item.mMaterialIndex];
+                if (item.mIsSkinned || material.mAlphaMode == GLTFAlphaMode::kMask || item.mIndexCount < 3)
+                {
+                    continue;
+                }
+
+                RayTracingInstance& instance = instances.emplace_back();
+                instance.mTransform     = placementToWorld * m_nodeWorldTransforms[item.mNode] * item.mDequantize;
+                instance.mGeometry      = item.mPrimitive;
+                instance.mIsDoubleSided = material.mIsDoubleSided ? 1u : 0u;
+            }
+        }
+    }
+
+    uint32_t GLTFModel::getRayTracingInstanceCapacity() const noexcept
+    {
+        uint32_t itemCount = 0;
+        for (const DrawItem& item : m_drawItems)
+        {
+            itemCount += (!item.mIsSkinned && m_materials[item.mMaterialIndex].mAlphaMode != GLTFAlphaMode::kMask && item.mIndexCount >= 3) ? 1u : 0u;
+        }
+        return itemCount * std::max(m_maxPlacements, 1u);
+    }
+
+    void GLTFModel::recordShadowCasters(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const ShadowCasterDraw* casters, uint32_t count,
+                                        const std::array<VkPipeline, 2>& shadowPipelines) const noexcept
+    {
+        if (casters == nullptr || count == 0 || !hasDepthPositions())
+        {
+            return;
+        }
+
+        // the position stream of the static pool, indexed by the shared index buffer
+        const VulkanDeviceDispatch& dispatch = VulkanDispatch::device();
+        const VkBuffer positionBuffer = m_positionBuffer.get();
+        const VkDeviceSize offset = 0;
+        dispatch.mCmdBindIndexBuffer(commandBuffer, getIndexBuffer(), 0, m_indexType);
+        dispatch.mCmdBindVertexBuffers(commandBuffer, 0, 1, &positionBuffer, &offset);
+
+        VkPipeline lastBoundPipeline = VK_NULL_HANDLE;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const ShadowCasterDraw& caster = casters[i];
+            const VkPipeline pipeline = shadowPipelines[caster.mIsDoubleSided];
+            if (lastBoundPipeline != pipeline)
+            {
+                dispatch.mCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                lastBoundPipeline = pipeline;
+            }
+
+            dispatch.mCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &caster.mModel);
+            dispatch.mCmdDrawIndexed(commandBuffer, caster.mIndexCount, 1, caster.mFirstIndex, caster.mVertexOffset, 0);
+        }
+    }
+
+    bool GLTFModel::isDepthPrepassComplete(uint32_t permutation) const noexcept
+    {
+        // merged runs, alpha-tested and blended fragments never reach the pre-pass
+        if (!hasDepthPositions() || m_isInstancingEnabled || m_isBindlessEnabled || permutation >= m_materialPermutations.size() ||
+            (m_materialPermutations[permutation] & (kMaterialAlphaMask | kMaterialAlphaBlend)))
+        {
+            return false;
+        }
+
+        // skinned draws read the skinned pool, which has no position stream
+        return std::none_of(m_drawItems.begin(), m_drawItems.end(), [&](const DrawItem& item)
+        {
+            return item.mIsSkinned && m_materials[item.mMaterialIndex].mPermutation == permutation;
+        });
+    }
+
+    uint32_t GLTFModel::getDrawBatchCount() const noexcept
+    {
+        return static_cast<uint32_t>(m_drawBatches.size());
+    }
+
+    void GLTFModel::renderIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, bool useDrawCount,
+                                   bool isLatePhase) noexcept
+    {
+        // skip if no draws were built
+        if (m_drawBatches.empty())
+        {
+            VK_LOG_DEBUG("GLTFModel::renderIndirect :: no draws to render");
+            return;
+        }
+
+        recordIndirectBatches(commandBuffer, pipelineLayout, frameIndex, useDrawCount, isLatePhase, 0, static_cast<uint32_t>(m_drawBatches.size()));
+    }
+
+    void GLTFModel::renderIndirectPartition(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, bool useDrawCount,
+                                            uint32_t partition) noexcept
+    {
+        const uint32_t batchCount = static_cast<uint32_t>(m_drawBatches.size());
+        const uint32_t firstBatch = partition * kBatchesPerPartition;
+        if (firstBatch >= batchCount)
+        {
+            return;
+        }
+
+        recordIndirectBatches(commandBuffer, pipelineLayout, frameIndex, useDrawCount, false, firstBatch, std::min(firstBatch + kBatchesPerPartition, batchCount));
+    }
+
+    void GLTFModel::recordIndirectBatches(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, bool useDrawCount,
+                                          bool isLatePhase, uint32_t firstBatch, uint32_t endBatch) noexcept
+    {
+        // bind per-draw records (instance rate, selected by firstInstance) and indices
+        const VulkanDeviceDispatch& dispatch = VulkanDispatch::device();
+        VkBuffer drawDataBuffer = m_drawDataBuffer.get();
+        VkDeviceSize offset     = 0;
+        dispatch.mCmdBindVertexBuffers(commandBuffer, kDrawDataVertexBinding, 1, &drawDataBuffer, &offset);
+        dispatch.mCmdBindIndexBuffer(commandBuffer, getIndexBuffer(), 0, m_indexType);
+        uint32_t bindCount = 2;
+        uint32_t drawCallCount = 0;
+
+        // bindless: one set for every batch
+        if (m_isBindlessEnabled)
+        {
+            dispatch.mCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &m_bindlessDescriptorSet, 0, nullptr);
+            ++bindCount;
+        }
+
+        // the late phase reads the second copy of every batch range
+        constexpr uint32_t kCommandStride = sizeof(VkDrawIndexedIndirectCommand);
+        const uint32_t phaseCommandBase = isLatePhase ? m_drawCount : 0u;
+        const uint32_t phaseCountBase = isLatePhase ? static_cast<uint32_t>(m_drawBatches.size()) : 0u;
+        VkBuffer lastBoundVertexBuffer = VK_NULL_HANDLE;
+        VkDeviceAddress vertexAddress = 0;
+        for (uint32_t batchIdx = firstBatch; batchIdx < endBatch; ++batchIdx)
+        {
+            const DrawBatch& batch = m_drawBatches[batchIdx];
+            const Material& material = m_materials[batch.mMaterialIndex];
+
+            // batches never mix the static and skinned vertex pools; pulled draws only switch the address they push
+            const VulkanBuffer& vertexPool = batch.mIsSkinned ? getSkinnedDrawBuffer(frameIndex) : getStaticVertexBuffer();
+            if (lastBoundVertexBuffer != vertexPool.get())
+            {
+                lastBoundVertexBuffer = vertexPool.get();
+                if (m_isVertexPullingEnabled)
+                {
+                    vertexAddress = vertexPool.getDeviceAddress();
+                }
+                else
+                {
+                    dispatch.mCmdBindVertexBuffers(commandBuffer, 0, 1, &lastBoundVertexBuffer, &offset);
+                    ++bindCount;
+                }
+            }
+
+            // bind material descriptor set (set: 1) once per batch
+            if (!m_isBindlessEnabled)
+            {
+                dispatch.mCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &material.mDescriptorSet, 0, nullptr);
+                ++bindCount;
+            }
+
+            // material factors; the model matrix comes from the draw record
+            PushConstants pushConstants{};
+            pushConstants.model         = glm::mat4(1.0f);
+            pushConstants.baseColor     = material.mBaseColor;
+            pushConstants.pbrFactors    = glm::vec4(material.mMetallic, material.mRoughness, material.mSpecular, 0.0f);
+            pushConstants.emissiveColor = glm::vec4(material.mEmissive, material.mOcclusion);
+            pushConstants.materialInfo  = glm::uvec4(static_cast<uint32_t>(batch.mMaterialIndex), 0u, 0u, 0u);
+            if (m_isVertexPullingEnabled)
+            {
+                // skinned pools always hold the standard layout
+                const bool isPacked = !batch.mIsSkinned && m_vertexFormat == VertexFormat::kPacked;
+                pushConstants.materialInfo.y = isPacked ? 1u : 0u;
+                pushConstants.materialInfo.z = static_cast<uint32_t>(vertexAddress & 0xFFFFFFFFull);
+                pushConstants.materialInfo.w = static_cast<uint32_t>(vertexAddress >> 32);
+            }
+            dispatch.mCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+
+            const VkDeviceSize commandOffset = static_cast<VkDeviceSize>(phaseCommandBase + batch.mFirstCommand) * kCommandStride;
+            if (useDrawCount)
+            {
+                // visible draw count produced on the gpu
+                dispatch.mCmdDrawIndexedIndirectCount(commandBuffer, m_indirectBuffer.get(), commandOffset,
+                                                      m_drawCountBuffer.get(), (phaseCountBase + batchIdx) * sizeof(uint32_t), batch.mCommandCount, kCommandStride);
+                ++drawCallCount;
+            }
+            else if (m_isMultiDrawEnabled)
+            {
+                dispatch.mCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer.get(), commandOffset, batch.mCommandCount, kCommandStride);
+                ++drawCallCount;
+            }
+            else
+            {
+                // without multiDrawIndirect each call may read only one command
+                for (uint32_t i = 0; i < batch.mCommandCount; ++i)
+                {
+                    dispatch.mCmdDrawIndexedIndirect(commandBuffer, m_indirectBuffer.get(), commandOffset + i * kCommandStride, 1, kCommandStride);
+                }
+                drawCallCount += batch.mCommandCount;
+            }
+        }
+
+        VulkanCommandCounters::addBinds(bindCount);
+        VulkanCommandCounters::addDraws(drawCallCount);
+    }
+
+    void GLTFModel::resetPartitionRevisions() noexcept
+    {
+        // newer than any recording of the previous batches
+        ++m_revisionCounter;
+        m_partitionRevisions.assign((m_drawBatches.size() + kBatchesPerPartition - 1) / kBatchesPerPartition, m_revisionCounter);
+    }
+
+    void GLTFModel::update(float dt) noexcept
+    {
+        // skip if nothing is animated
+        if (m_animations.empty())
+        {
+            return;
+        }
+
+        // advance and loop the active animation
+        const Animation& animation = m_animations[m_activeAnimation];
+        const float duration = animation.mEnd - animation.mStart;
+        m_animationTime = duration > 0.0f ? std::fmod(m_animationTime + dt, duration) : 0.0f;
+        const float time = animation.mStart + m_animationTime;
+
+        // sample every channel into the local trs of its node, or the morph weights of its mesh
+        for (const auto& channel : animation.mChannels)
+        {
+            const AnimationSampler& sampler = animation.mSamplers[channel.mSampler];
+            if (channel.mPath == AnimationChannel::Path::kWeights)
+            {
+                for (uint32_t weight = 0; weight < channel.mWeightCount; weight += 4)
+                {
+                    const glm::vec4 value = sampleAnimation(sampler, time, false, weight / 4);
+                    for (uint32_t c = 0; c < 4 && weight + c < channel.mWeightCount; ++c)
+                    {
+                        m_morphWeights[channel.mFirstWeight + weight + c] = value[static_cast<int>(c)];
+                    }
+                }
+                continue;
+            }
+
+            const glm::vec4 value = sampleAnimation(sampler, time, channel.mPath == AnimationChannel::Path::kRotation);
+            switch (channel.mPath)
+            {
+                case AnimationChannel::Path::kTranslation:  m_nodeTranslations[channel.mNode] = glm::vec3(value); break;
+                case AnimationChannel::Path::kRotation:     m_nodeRotations[channel.mNode] = glm::quat(value.w, value.x, value.y, value.z); break;
+                case AnimationChannel::Path::kScale:        m_nodeScales[channel.mNode] = glm::vec3(value); break;
+                case AnimationChannel::Path::kWeights:      break;
+            }
+            m_dirtyNodes.push_back(channel.mNode);
+        }
+
+        // rebuild local transforms of the animated nodes only
+        std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end());
+        m_dirtyNodes.erase(std::unique(m_dirtyNodes.begin(), m_dirtyNodes.end()), m_dirtyNodes.end());
+        for (const uint32_t node : m_dirtyNodes)
+        {
+            m_nodeLocalTransforms[node] = glm::translate(glm::mat4(1.0f), m_nodeTranslations[node]) *
+                                          glm::mat4_cast(m_nodeRotations[node]) *
+                                          glm::scale(glm::mat4(1.0f), m_nodeScales[node]);
+        }
+
+        // propagate to the dirty subtrees and their ancestors' bounds
+        updateDirtyTransforms();
+        m_dirtyNodes.clear();
+
+        // skins follow the new joint transforms
+        updateJointMatrices();
+    }
+
+    void GLTFModel::setActiveAnimation(uint32_t index) noexcept
+    {
+        if (index < m_animations.size())
+        {
+            m_activeAnimation = index;
+            m_animationTime = 0.0f;
+        }
+    }
+
+    uint32_t GLTFModel::getAnimationCount() const noexcept
+    {
+        return static_cast<uint32_t>(m_animations.size());
+    }
+
+    bool GLTFModel::hasAnimations() const noexcept
+    {
+        return !m_animations.empty();
+    }
+
+    bool GLTFModel::allocateDescriptorSets(VulkanDescriptorAllocator& descriptorAllocator) noexcept
+    {
+        // validate materials 
+        if (m_materials.empty())
+        {
+            VK_LOG_DEBUG("GLTFModel::allocateDescriptorSets :: no materials to allocate descriptor sets");
+            return true;
+        }
+
+        // validate descriptor set layout
+        if (s_descriptorSetLayout == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("GLTFModel::allocateDescriptorSets :: shared descriptor set layout not initialized");
+            return false;
+        }
+
+        // allocate descriptor sets for each material (two while streaming textures)
+        const size_t setsPerMaterial = isTextureStreamingEnabled() ? 2 : 1;
+        std::vector<VkDescriptorSetLayout> layouts(m_materials.size() * setsPerMaterial, s_descriptorSetLayout);
+        std::vector<VkDescriptorSet> descriptorSets(layouts.size());
+        if (!descriptorAllocator.allocate(layouts.data(), static_cast<uint32_t>(layouts.size()), descriptorSets.data()))
+        {
+            VK_LOG_ERROR("GLTFModel::allocateDescriptorSets :: failed to allocate material descriptor sets");
+            return false;
+        }
+
+        // assign sets to materials
+        for (size_t i = 0; i < m_materials.size(); i++)
+        {
+            m_materials[i].mDescriptorSet = descriptorSets[i * setsPerMaterial];
+            m_materials[i].mSpareDescriptorSet = setsPerMaterial > 1 ? descriptorSets[i * setsPerMaterial + 1] : VK_NULL_HANDLE;
+        }
+
+        VK_LOG_DEBUG("GLTFModel::allocateDescriptorSets :: descriptor sets allocation successful");
+        return true;
+    }
+
+    void GLTFModel::updateDescriptorSets(const VulkanSamplers& sampler) noexcept
+    {
+        // skip if no materials or invalid layout
+        if (m_materials.empty() || s_descriptorSetLayout == VK_NULL_HANDLE)
+        {
+            VK_LOG_DEBUG("GLTFModel::allocateDescriptorSets :: no materials or shared layout to update descriptor sets");
+            return;
+        }
+
+        // select the best available sampler
+        m_vkFallbackSampler = sampler.get(VulkanSamplers::Type::AnisotropicRepeat);
+        if (m_vkFallbackSampler == VK_NULL_HANDLE)
+        {
+            m_vkFallbackSampler = sampler.get(VulkanSamplers::Type::LinearRepeat);
+        }
+
+        // one templated update per material
+        for (auto& material : m_materials)
+        {
+            writeMaterialDescriptors(material, material.mDescriptorSet);
+            material.mIsDescriptorStale = false;
+        }
+
+        // skin matrices need no descriptor here: uploadJointMatrices writes all skins into the frame's joint buffer
+        VK_LOG_DEBUG("GLTFModel::updateDescriptorSets :: updated descriptor sets successful");
+    }
+
+    void GLTFModel::writeMaterialDescriptors(const Material& material, VkDescriptorSet vkDescriptorSet) const noexcept
+    {
+        // maps in binding order, the template of the present ones reads only their slots
+        const std::array<std::optional<int>, kMaterialTextureCount> textures = 
+        {
+            material.mBaseColorTex, material.mMetallicRoughnessTex, material.mNormalTex, material.mOcclusionTex, material.mEmissiveTex
+        };
+        
+        MaterialDescriptorImages images{};
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < kMaterialTextureCount; ++i)
+        {
+            // validate texture index
+            if (!textures[i].has_value()) 
+                continue;
+
+            images[i].sampler     = getTextureSampler(textures[i].value(), m_vkFallbackSampler);
+            images[i].imageView   = getTextureView(textures[i].value());
+            images[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            mask |= 1u << i;
+        }
+
+        if (mask != 0 && s_materialUpdateTemplates[mask] != VK_NULL_HANDLE)
+        {
+            vkUpdateDescriptorSetWithTemplate(m_vkDevice, vkDescriptorSet, s_materialUpdateTemplates[mask], images.data());
+        }
+    }
+
+    DescriptorRequirements GLTFModel::getDescriptorRequirements() const noexcept
+    {
+        // each material will have one descriptor set
+        DescriptorRequirements requirements{};
+        requirements.mMaxSets= static_cast<uint32_t>(m_materials.size());
+
+        // count how many textures will be used across all materials
+        for (const auto& material : m_materials)
+        {
+            if (material.mBaseColorTex.has_value())         { requirements.mSamplerCount++; }
+            if (material.mNormalTex.has_value())            { requirements.mSamplerCount++; }
+            if (material.mMetallicRoughnessTex.has_value()) { requirements.mSamplerCount++; }
+            if (material.mEmissiveTex.has_value())          { requirements.mSamplerCount++; }
+            if (material.mOcclusionTex.has_value())         { requirements.mSamplerCount++; }
+        }
+
+        // uniform buffer count for pbr factors (one per material)
+        requirements.mUniformCount = static_cast<uint32_t>(m_materials.size());
+
+        // streaming double buffers every set
+        if (isTextureStreamingEnabled())
+        {
+            requirements.mMaxSets *= 2;
+            requirements.mSamplerCount *= 2;
+            requirements.mUniformCount *= 2;
+        }
+        return requirements;
+    }
+
+    bool GLTFModel::allocateBindlessDescriptorSet(VulkanDescriptorAllocator& descriptorAllocator) noexcept
+    {
+        // validate bindless layout and material table
+        if (s_bindlessDescriptorSetLayout == VK_NULL_HANDLE || !m_materialBuffer.get() || !m_objectBuffer.get())
+        {
+            VK_LOG_ERROR("GLTFModel::allocateBindlessDescriptorSet :: bindless layout, material or object buffer not initialized");
+            return false;
+        }
+
+        const uint32_t textureCount = std::max(1u, static_cast<uint32_t>(m_textures.size()));
+        if (textureCount > s_maxBindlessTextures)
+        {
+            VK_LOG_ERROR("GLTFModel::allocateBindlessDescriptorSet :: %u textures exceed the bindless limit of %u", textureCount, s_maxBindlessTextures);
+            return false;
+        }
+
+        // the texture array is sized to this model's textures
+        VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo{};
+        variableCountInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+        variableCountInfo.pNext = nullptr;
+        variableCountInfo.descriptorSetCount = 1;
+        variableCountInfo.pDescriptorCounts = &textureCount;
+
+        if (!descriptorAllocator.allocate(s_bindlessDescriptorSetLayout, m_bindlessDescriptorSet, &variableCountInfo))
+        {
+            VK_LOG_ERROR("GLTFModel::allocateBindlessDescriptorSet :: failed to allocate the bindless descriptor set");
+            return false;
+        }
+
+        // streaming rewrites an idle copy instead of the bound set
+        m_spareBindlessDescriptorSet = VK_NULL_HANDLE;
+        if (isTextureStreamingEnabled() && !descriptorAllocator.allocate(s_bindlessDescriptorSetLayout, m_spareBindlessDescriptorSet, &variableCountInfo))
+        {
+            VK_LOG_ERROR("GLTFModel::allocateBindlessDescriptorSet :: failed to allocate the spare bindless descriptor set");
+            return false;
+        }
+
+        VK_LOG_DEBUG("GLTFModel::allocateBindlessDescriptorSet :: bindless descriptor set allocated (%u textures)", textureCount);
+        return true;
+    }
+
+    void GLTFModel::updateBindlessDescriptorSet(const VulkanSamplers& sampler) noexcept
+    {
+        // skip if the set was never allocated
+        if (m_bindlessDescriptorSet == VK_NULL_HANDLE)
+        {
+            VK_LOG_DEBUG("GLTFModel::updateBindlessDescriptorSet :: no bindless descriptor set to update");
+            return;
+        }
+
+        // select the best available sampler
+        m_vkFallbackSampler = sampler.get(VulkanSamplers::Type::AnisotropicRepeat);
+        if (m_vkFallbackSampler == VK_NULL_HANDLE)
+        {
+            m_vkFallbackSampler = sampler.get(VulkanSamplers::Type::LinearRepeat);
+        }
+
+        writeBindlessDescriptorSet(m_bindlessDescriptorSet);
+        m_isBindlessDescriptorStale = false;
+        VK_LOG_DEBUG("GLTFModel::updateBindlessDescriptorSet :: updated bindless descriptor set successful");
+    }
+
+    void GLTFModel::writeBindlessDescriptorSet(VkDescriptorSet vkDescriptorSet) const noexcept
+    {
+        // every loaded texture at its own index; unreferenced images have no view and stay unbound (partially bound array)
+        std::vector<VkDescriptorImageInfo> imageInfos;
+        imageInfos.reserve(m_textures.size());
+        std::vector<VkWriteDescriptorSet> writes;
+        writes.reserve(m_textures.size() + 2);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_textures.size()); ++i)
+        {
+            const VkImageView imageView = getTextureView(i);
+            if (imageView == VK_NULL_HANDLE)
+                continue;
+
+            imageInfos.push_back({ getTextureSampler(i, m_vkFallbackSampler), imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+
+            VkWriteDescriptorSet write{};
+            write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet           = vkDescriptorSet;
+            write.dstBinding       = kBindlessTextureBinding;
+            write.dstArrayElement  = i;
+            write.descriptorCount  = 1;
+            write.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.pImageInfo       = &imageInfos.back();
+            writes.emplace_back(write);
+        }
+
+        // material table and object records (every frame's region, offset by the pushed index)
+        const std::array<VkDescriptorBufferInfo, 2> bufferInfos
+        {
+           {{m_materialBuffer.get(), 0, VK_WHOLE_SIZE},
+            {m_objectBuffer.get(),   0, VK_WHOLE_SIZE}}
+        };
+        const std::array<uint32_t, 2> bufferBindings { kBindlessMaterialBinding, kBindlessObjectBinding };
+
+        for (size_t i = 0; i < bufferInfos.size(); ++i)
+        {
+            VkWriteDescriptorSet write{};
+            write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet           = vkDescriptorSet;
+            write.dstBinding       = bufferBindings[i];
+            write.dstArrayElement  = 0;
+            write.descriptorCount  = 1;
+            write.descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.pBufferInfo      = &bufferInfos[i];
+            writes.emplace_back(write);
+        }
+
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    DescriptorRequirements GLTFModel::getBindlessDescriptorRequirements() const noexcept
+    {
+        // one set: the material table, object records and a texture array sized to the model
+        DescriptorRequirements requirements{};
+        requirements.mMaxSets = 1;
+        requirements.mSamplerCount = std::max(1u, static_cast<uint32_t>(m_textures.size()));
+        requirements.mStorageBufferCount = 2;
+
+        // streaming double buffers the set
+        if (isTextureStreamingEnabled())
+        {
+            requirements.mMaxSets *= 2;
+            requirements.mSamplerCount *= 2;
+            requirements.mStorageBufferCount *= 2;
+        }
+        return requirements;
+    }
+
+    bool GLTFModel::allocateMeshletDescriptorSet(VulkanDescriptorAllocator& descriptorAllocator) noexcept
+    {
+        // validate meshlet layout and buffers
+        if (s_meshletDescriptorSetLayout == VK_NULL_HANDLE || m_meshletCount == 0 || !getStaticVertexBuffer().get())
+        {
+            VK_LOG_ERROR("GLTFModel::allocateMeshletDescriptorSet :: meshlet layout or buffers not initialized");
+            return false;
+        }
+
+        if (!descriptorAllocator.allocate(s_meshletDescriptorSetLayout, m_meshletDescriptorSet))
+        {
+            VK_LOG_ERROR("GLTFModel::allocateMeshletDescriptorSet :: failed to allocate the meshlet descriptor set");
+            return false;
+        }
+
+        // the buffers never change after load, so the set is written once. meshlet vertices index the static pool,
+        // which is the model's range when it lives in the arena (ranges start at storage-aligned offsets)
+        const VkDeviceSize vertexStride = getVertexStride(m_vertexFormat);
+        const VkDeviceSize vertexDataOffset = m_geometryArena ? vertexStride * m_geometryRange.mFirstVertex : 0;
+        const VkDeviceSize vertexDataSize = m_geometryArena ? vertexStride * m_geometryRange.mVertexCount : VK_WHOLE_SIZE;
+        const std::array<VkDescriptorBufferInfo, 4> bufferInfos
+        {
+           {{m_meshletBuffer.get(),            0,                VK_WHOLE_SIZE},
+            {m_meshletVertexBuffer.get(),      0,                VK_WHOLE_SIZE},
+            {m_meshletTriangleBuffer.get(),    0,                VK_WHOLE_SIZE},
+            {getStaticVertexBuffer().get(),    vertexDataOffset, vertexDataSize}}
+        };
+        const std::array<uint32_t, 4> bufferBindings { kMeshletBinding, kMeshletVertexBinding, kMeshletTriangleBinding, kMeshletVertexDataBinding };
+
+        std::array<VkWriteDescriptorSet, 4> writes{};
+        for (size_t i = 0; i < writes.size(); ++i)
+        {
+            writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet           = m_meshletDescriptorSet;
+            writes[i].dstBinding       = bufferBindings[i];
+            writes[i].dstArrayElement  = 0;
+            writes[i].descriptorCount  = 1;
+            writes[i].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo      = &bufferInfos[i];
+        }
+
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        VK_LOG_DEBUG("GLTFModel::allocateMeshletDescriptorSet :: meshlet descriptor set allocated (%u meshlets)", m_meshletCount);
+        return true;
+    }
+
+    DescriptorRequirements GLTFModel::getMeshletDescriptorRequirements() const noexcept
+    {
+        // one set: meshlets, their vertices and triangles, and the vertex pool
+        DescriptorRequirements requirements{};
+        requirements.mMaxSets = 1;
+        requirements.mStorageBufferCount = 4;
+        return requirements;
+    }
+
+    bool GLTFModel::isTextureStreamingEnabled() const noexcept
+    {
+        return m_textureStreamer && m_textureStreamer->getStreamedTextureCount() > 0;
+    }
+
+    void GLTFModel::setPlacements(const glm::mat4* transforms, uint32_t count) noexcept
+    {
+        // the per-frame buffers hold every draw item once per placement of the capacity
+        if (count > m_maxPlacements)
+        {
+            VK_LOG_WARN_THROTTLED("GLTFModel::setPlacements :: %u placements exceed the capacity of %u", count, m_maxPlacements);
+            count = m_maxPlacements;
+        }
+        m_placements.assign(transforms, transforms + count);
+        m_isPlacementBoundsDirty = true;
+    }
+
+    VkDeviceSize GLTFModel::getMemorySize() const noexcept
+    {
+        VkDeviceSize size = m_vertexBuffer.getSize() + m_positionBuffer.getSize() + m_indexBuffer.getSize() + m_drawDataBuffer.getSize() +
+                            m_indirectBuffer.getSize() + m_drawCountBuffer.getSize() + m_skinnedRestBuffer.getSize() + m_skinVertexBuffer.getSize() +
+                            m_materialBuffer.getSize() + m_objectBuffer.getSize() + m_meshletBuffer.getSize() + m_meshletVertexBuffer.getSize() +
+                            m_meshletTriangleBuffer.getSize() + m_morphRangeBuffer.getSize() + m_morphDeltaBuffer.getSize();
+        for (uint32_t i = 0; i < kMaxSkinningFrames; ++i)
+        {
+            size += m_jointMatrixBuffers[i].getSize() + m_skinnedVertexBuffers[i].getSize() + m_morphWeightBuffers[i].getSize();
+        }
+        for (uint32_t i = 0; i < kMaxFramesInFlight; ++i)
+        {
+            size += m_instanceBuffers[i].getSize() + m_runCommandBuffers[i].getSize();
+        }
+        for (const auto& texture : m_textures)
+        {
+            size += texture.getMemorySize();
+        }
+        for (const auto& textureArray : m_textureArrays)
+        {
+            size += textureArray.getMemorySize();
+        }
+        if (m_textureStreamer)
+        {
+            size += m_textureStreamer->getPageCacheBytes();
+        }
+
+        // the arena's buffers are shared; the model's range of them is its own
+        if (m_geometryArena)
+        {
+            size += static_cast<VkDeviceSize>(m_geometryArena->getVertexStride()) * m_geometryRange.mVertexCount + 
+                    sizeof(uint32_t) * static_cast<VkDeviceSize>(m_geometryRange.mIndexCount);
+        }
+        return size;
+    }
+
+    BoundingBox GLTFModel::getBounds() const noexcept
+    {
+        BoundingBox bounds{};
+        for (const auto& item : m_drawItems)
+        {
+            bounds.expand(item.mWorldBounds);
+        }
+        return bounds;
+    }
+
+    uint32_t GLTFModel::cullPlacements(const Frustum* frustum) noexcept
+    {
+        // without placements there is the one identity placement, without a frustum every placement is drawn
+        const uint32_t placementCount = std::max(static_cast<uint32_t>(m_placements.size()), 1u);
+        if (m_placements.empty() || !frustum)
+        {
+            m_visiblePlacements.resize(placementCount);
+            std::iota(m_visiblePlacements.begin(), m_visiblePlacements.end(), 0u);
+            return placementCount;
+        }
+
+        // the roots' subtree bounds are the model's; animation moves them, so placed bounds are rebuilt when they change
+        BoundingBox modelBounds{};
+        for (uint32_t node = 0; node < m_nodeBounds.size(); node = m_nodeSubtreeEnds[node])
+        {
+            modelBounds.expand(m_nodeBounds[node]);
+        }
+        if (m_isPlacementBoundsDirty || modelBounds.mMin != m_placementModelBounds.mMin || modelBounds.mMax != m_placementModelBounds.mMax)
+        {
+            m_placementBounds.resize(m_placements.size());
+            for (uint32_t placement = 0; placement < m_placements.size(); ++placement)
+            {
+                m_placementBounds.set(placement, modelBounds.transformed(m_placements[placement]));
+            }
+            m_placementModelBounds = modelBounds;
+            m_isPlacementBoundsDirty = false;
+        }
+
+        // one simd pass over every placement, split across the model's pool once there are several chunks of them
+        return cullBounds(CullingFrustum::fromFrustum(*frustum), m_placementBounds, m_visiblePlacements, m_threadPool.get());
+    }
+
+    void GLTFModel::setLodView(const glm::vec3& viewPosition, float projectionScale) noexcept
+    {
+        m_lodViewPosition = viewPosition;
+        m_lodProjectionScale = hasLods() ? std::max(projectionScale, 0.0f) : 0.0f;
+    }
+
+    bool GLTFModel::updateTextureStreaming(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const glm::vec3& viewPosition, 
+                                           float projectionScale) noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+        if (!isTextureStreamingEnabled())
+        {
+            return false;
+        }
+        ++m_streamingFrame;
+
+        // camera distance heuristic: a draw's textures span about as many pixels as its bounds' diagonal projects to
+        for (const DrawItem& item : m_drawItems)
+        {
+            if (item.mMaterialIndex < 0 || item.mMaterialIndex >= static_cast<int32_t>(m_materials.size()) || !item.mWorldBounds.isValid())
+            {
+                continue;
+            }
+
+            const glm::vec3 closestPoint = glm::clamp(viewPosition, item.mWorldBounds.mMin, item.mWorldBounds.mMax);
+            const float distance = std::max(glm::length(closestPoint - viewPosition), 1e-3f);
+            const float footprint = glm::length(item.mWorldBounds.mMax - item.mWorldBounds.mMin) * projectionScale / distance;
+
+            const Material& material = m_materials[item.mMaterialIndex];
+            for (const auto& textureIndex : { material.mBaseColorTex, material.mMetallicRoughnessTex, material.mNormalTex, 
+                                              material.mOcclusionTex, material.mEmissiveTex })
+            {
+                if (textureIndex.has_value())
+                {
+                    m_textureStreamer->request(textureIndex.value(), footprint);
+                }
+            }
+        }
+
+        std::vector<uint32_t> swappedTextures;
+        if (!m_textureStreamer->update(device, stagingBelt, m_textures, swappedTextures))
+        {
+            VK_LOG_WARN_THROTTLED("GLTFModel::updateTextureStreaming :: failed to stage texture uploads");
+        }
+
+        // every set sampling a swapped texture is rewritten, into its idle copy
+        for (uint32_t textureIndex : swappedTextures)
+        {
+            m_isBindlessDescriptorStale = true;
+            for (Material& material : m_materials)
+            {
+                for (const auto& materialTexture : { material.mBaseColorTex, material.mMetallicRoughnessTex, material.mNormalTex, 
+                                                     material.mOcclusionTex, material.mEmissiveTex })
+                {
+                    material.mIsDescriptorStale |= materialTexture.has_value() && materialTexture.value() == textureIndex;
+                }
+            }
+        }
+
+        // a copy is idle once every frame that bound it completed; until then the rewrite waits for a later update
+        auto isCopyIdle = [this](uint64_t swapFrame) noexcept { return m_streamingFrame > swapFrame + kMaxFramesInFlight; };
+        bool isChanged = false;
+        const uint64_t revision = m_revisionCounter + 1;
+        for (size_t materialIdx = 0; materialIdx < m_materials.size(); ++materialIdx)
+        {
+            Material& material = m_materials[materialIdx];
+            if (!material.mIsDescriptorStale || material.mSpareDescriptorSet == VK_NULL_HANDLE || !isCopyIdle(material.mDescriptorSwapFrame))
+            {
+                continue;
+            }
+
+            writeMaterialDescriptors(material, material.mSpareDescriptorSet);
+            std::swap(material.mDescriptorSet, material.mSpareDescriptorSet);
+            material.mDescriptorSwapFrame = m_streamingFrame;
+            material.mIsDescriptorStale = false;
+            isChanged = true;
+
+            // only the partitions drawing the material bind its set
+            for (size_t batchIdx = 0; batchIdx < m_drawBatches.size(); ++batchIdx)
+            {
+                if (m_drawBatches[batchIdx].mMaterialIndex == static_cast<int32_t>(materialIdx))
+                {
+                    m_partitionRevisions[batchIdx / kBatchesPerPartition] = revision;
+                }
+            }
+        }
+
+        if (m_isBindlessDescriptorStale && m_spareBindlessDescriptorSet != VK_NULL_HANDLE && isCopyIdle(m_bindlessSwapFrame))
+        {
+            writeBindlessDescriptorSet(m_spareBindlessDescriptorSet);
+            std::swap(m_bindlessDescriptorSet, m_spareBindlessDescriptorSet);
+            m_bindlessSwapFrame = m_streamingFrame;
+            m_isBindlessDescriptorStale = false;
+            isChanged = true;
+            std::fill(m_partitionRevisions.begin(), m_partitionRevisions.end(), revision);
+        }
+
+        m_revisionCounter = isChanged ? revision : m_revisionCounter;
+        return isChanged;
+    }
+
+    bool GLTFModel::loadMeshes(const tinygltf::Model& model, const VulkanDevice& device, VulkanStagingBelt* stagingBelt, const GLTFLoadConfig& config) noexcept
+    {
+        // clear previous data; draw items of an earlier load would describe stale index ranges
+        m_meshes.clear();
+        m_drawItems.clear();
+        m_vertexCount = 0;
         m_indexCount  = 0;
+        m_lodIndexCount = 0;
+        m_meshletCount = 0;
+        m_morphWeights.clear();
+
+        // gather drawable primitives and lay out both pools: each primitive's vertices, indices and skin influences get a
+        // fixed range up front, so primitives decode in place and independently of each other
+        struct PrimitiveSource
+        {
+            const tinygltf::Primitive* mPrimitive;
+            uint32_t    mMesh;
+            bool        mIsSkinned;     // primitives with joint influences or morph targets are written to the skinned pool
+            uint32_t    mFirstVertex;   // within its pool
+            uint32_t    mVertexCount;
+            uint32_t    mFirstIndex;
+            uint32_t    mIndexCount;
+            bool        mHasTangents;
+            BoundingBox mBounds;
+
+            // morph deltas in vertex order and how many each vertex has (decoded in the primitive's task)
+            std::vector<MorphDelta> mMorphDeltas;
+            std::vector<uint32_t>   mMorphCounts;
+        };
+
+        // every target of a morphed mesh gets a model-wide weight, starting at the mesh's defaults
+        std::vector<glm::uvec2> meshMorphWeights(model.meshes.size(), glm::uvec2(0));
+        for (size_t meshIdx = 0; meshIdx < model.meshes.size(); ++meshIdx)
+        {
+            const auto& gltfMesh = model.meshes[meshIdx];
+            size_t targetCount = 0;
+            for (const auto& gltfPrimitive : gltfMesh.primitives)
+            {
+                targetCount = std::max(targetCount, gltfPrimitive.targets.size());
+            }
+
+            meshMorphWeights[meshIdx] = glm::uvec2(static_cast<uint32_t>(m_morphWeights.size()), static_cast<uint32_t>(targetCount));
+            for (size_t t = 0; t < targetCount; ++t)
+            {
+                m_morphWeights.push_back(t < gltfMesh.weights.size() ? static_cast<float>(gltfMesh.weights[t]) : 0.0f);
+            }
+        }
+
+        std::vector<PrimitiveSource> sources;
+        uint32_t staticVertexCount  = 0;
+        uint32_t staticIndexCount   = 0;
+        uint32_t skinnedVertexCount = 0;
+        uint32_t skinnedIndexCount  = 0;
+        for (uint32_t meshIdx = 0; meshIdx < static_cast<uint32_t>(model.meshes.size()); ++meshIdx)
+        {
+            for (const auto& gltfPrimitive : model.meshes[meshIdx].primitives)
+            {
+                // skip if position is missing
+                const auto& attributes = gltfPrimitive.attributes;
+                if (attributes.find("POSITION") == attributes.end() || gltfPrimitive.indices < 0)
+                {
+                    VK_LOG_DEBUG("GLTFModel::loadMeshes : primitive skipped; position or indices missing in mesh: %s", model.meshes[meshIdx].name.c_str());
+                    continue;
+                }
+
+                PrimitiveSource source{};
+                source.mPrimitive   = &gltfPrimitive;
+                source.mMesh        = meshIdx;
+                source.mIsSkinned   = (attributes.find("JOINTS_0") != attributes.end() && attributes.find("WEIGHTS_0") != attributes.end()) ||
+                                      !gltfPrimitive.targets.empty();
+                source.mVertexCount = static_cast<uint32_t>(model.accessors.at(attributes.at("POSITION")).count);
+                source.mIndexCount  = static_cast<uint32_t>(model.accessors.at(gltfPrimitive.indices).count);
+
+                uint32_t& poolVertexCount = source.mIsSkinned ? skinnedVertexCount : staticVertexCount;
+                uint32_t& poolIndexCount  = source.mIsSkinned ? skinnedIndexCount : staticIndexCount;
+                source.mFirstVertex = poolVertexCount;
+                source.mFirstIndex  = poolIndexCount;
+                poolVertexCount += source.mVertexCount;
+                poolIndexCount  += source.mIndexCount;
+                sources.emplace_back(source);
+            }
+        }
+        m_vertexCount = staticVertexCount + skinnedVertexCount;
+        m_indexCount  = staticIndexCount + skinnedIndexCount;
+
+        // skinning.comp reads vertices as tightly packed floats
+        static_assert(sizeof(Vertex) == 13 * sizeof(float), "GLTFModel::Vertex layout must match skinning.comp");
+        constexpr size_t kVertexFloats = sizeof(Vertex) / sizeof(float);
+
+        // aggregated vertex/index data from all meshes, sized for every primitive; attributes a primitive lacks stay zero
+        std::vector<Vertex> vertices(staticVertexCount, Vertex{});
+        std::vector<uint32_t> indices(staticIndexCount, 0u);
+        std::vector<Vertex> skinnedVertices(skinnedVertexCount, Vertex{});
+        std::vector<uint32_t> skinnedIndices(skinnedIndexCount, 0u);
+        m_skinVertices.assign(skinnedVertexCount, SkinVertex{ glm::uvec4(0), glm::vec4(1.0f, 0.0f, 0.0f, 0.0f) });
+
+        // decode, then optimize, one primitive per task: every task writes only its own ranges
+        std::atomic<uint64_t> tangentNanoseconds{0};
+        const auto decodePrimitive = [&](size_t sourceIdx)
+        {
+            PrimitiveSource& source = sources[sourceIdx];
+            const auto& attributes = source.mPrimitive->attributes;
+            auto& poolVertices = source.mIsSkinned ? skinnedVertices : vertices;
+            auto& poolIndices  = source.mIsSkinned ? skinnedIndices : indices;
+
+            // attributes straight into the interleaved vertices, whatever their stride and component type
+            if (source.mVertexCount > 0)
+            {
+                Vertex* primitiveVertices = poolVertices.data() + source.mFirstVertex;
+                const auto decode = [&](const char* name, size_t componentCount, float* destination)
+                {
+                    const auto itr = attributes.find(name);
+                    return itr != attributes.end() && 
+                           decodeAttribute(model, model.accessors.at(itr->second), componentCount, source.mVertexCount, destination, kVertexFloats);
+                };
+
+                if (!decode("POSITION", 3, &primitiveVertices->mPosition.x))
+                {
+                    VK_LOG_WARN("GLTFModel::loadMeshes : unsupported position accessor in mesh: %s", model.meshes[source.mMesh].name.c_str());
+                }
+                decode("NORMAL", 3, &primitiveVertices->mNormal.x);
+                decode("TEXCOORD_0", 2, &primitiveVertices->mUV.x);
+                source.mHasTangents = decode("TANGENT", 4, &primitiveVertices->mTangent.x);
+
+                // positions are points; accumulate the primitive's bounds
+                for (uint32_t i = 0; i < source.mVertexCount; ++i)
+                {
+                    primitiveVertices[i].mPosition.w = 1.0f;
+                    source.mBounds.expand(glm::vec3(primitiveVertices[i].mPosition));
+                }
+            }
+
+            // joint indices are skin-local until loadSkins rebases them; weights are renormalized. morphed primitives without
+            // influences keep the identity joint
+            if (source.mIsSkinned && attributes.find("JOINTS_0") != attributes.end() && attributes.find("WEIGHTS_0") != attributes.end())
+            {
+                const auto& jointAccessor  = model.accessors.at(attributes.at("JOINTS_0"));
+                const auto& weightAccessor = model.accessors.at(attributes.at("WEIGHTS_0"));
+                const size_t influenceCount = std::min<size_t>({ source.mVertexCount, jointAccessor.count, weightAccessor.count });
+                for (size_t i = 0; i < influenceCount; i++)
+                {
+                    SkinVertex& skinVertex = m_skinVertices[source.mFirstVertex + i];
+                    skinVertex.mJoints  = glm::uvec4(readAccessorElement(model, jointAccessor, i, false));
+                    skinVertex.mWeights = readAccessorElement(model, weightAccessor, i, true);
+
+                    const float weightSum = skinVertex.mWeights.x + skinVertex.mWeights.y + skinVertex.mWeights.z + skinVertex.mWeights.w;
+                    if (weightSum > 0.0f)
+                    {
+                        skinVertex.mWeights /= weightSum;
+                    }
+                    else 
+                    {
+                        skinVertex.mJoints  = glm::uvec4(0);
+                        skinVertex.mWeights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+                    }
+                }
+            }
+
+            // pool-absolute indices of any gltf index type
+            if (!decodeIndices(model, model.accessors.at(source.mPrimitive->indices), source.mFirstVertex, source.mIndexCount,
+                               poolIndices.data() + source.mFirstIndex))
+            {
+                VK_LOG_WARN("GLTFModel::loadMeshes : unsupported index accessor in mesh: %s", model.meshes[source.mMesh].name.c_str());
+            }
+
+            // tangents only where the source has none (baked caches keep the generated ones with the vertices)
+            if (!source.mHasTangents)
+            {
+                ScopedStageTime tangentTime(tangentNanoseconds);
+                generateTangents(poolVertices, poolIndices, source.mFirstVertex, source.mVertexCount, source.mFirstIndex, source.mIndexCount);
+            }
+
+            // morph deltas, one target at a time, keeping only the vertices each target moves
+            const auto& targets = source.mPrimitive->targets;
+            const glm::uvec2 morphWeights = meshMorphWeights[source.mMesh];
+            std::vector<uint32_t> morphVertices;
+            if (!targets.empty() && source.mVertexCount > 0)
+            {
+                std::vector<glm::vec3> deltas(static_cast<size_t>(source.mVertexCount) * 3);
+                for (size_t t = 0; t < targets.size() && t < morphWeights.y; ++t)
+                {
+                    const auto decodeDeltas = [&](const char* name, glm::vec3* destination)
+                    {
+                        const auto itr = targets[t].find(name);
+                        return itr != targets[t].end() && itr->second >= 0 && itr->second < static_cast<int>(model.accessors.size()) &&
+                               decodeMorphAttribute(model, model.accessors[itr->second], source.mVertexCount, &destination->x, 9);
+                    };
+
+                    std::fill(deltas.begin(), deltas.end(), glm::vec3(0.0f));
+                    if (targets[t].count("POSITION") && !decodeDeltas("POSITION", &deltas[0]))
+                    {
+                        VK_LOG_WARN("GLTFModel::loadMeshes : unsupported morph target accessor in mesh: %s", model.meshes[source.mMesh].name.c_str());
+                    }
+                    decodeDeltas("NORMAL", &deltas[1]);
+                    decodeDeltas("TANGENT", &deltas[2]);
+
+                    for (uint32_t v = 0; v < source.mVertexCount; ++v)
+                    {
+                        const glm::vec3* vertexDeltas = &deltas[v * 3];
+                        if (vertexDeltas[0] != glm::vec3(0.0f) || vertexDeltas[1] != glm::vec3(0.0f) || vertexDeltas[2] != glm::vec3(0.0f))
+                        {
+                            source.mMorphDeltas.push_back({ vertexDeltas[0], morphWeights.x + static_cast<uint32_t>(t), 
+                                                            glm::vec4(vertexDeltas[1], 0.0f), glm::vec4(vertexDeltas[2], 0.0f) });
+                            morphVertices.push_back(v);
+                        }
+                    }
+                }
+            }
+
+            // reorder the primitive for post-transform cache, overdraw and vertex fetch (local indices)
+            std::vector<uint32_t> remap;
+            if (config.mOptimizeMeshes && source.mIndexCount % 3 == 0)
+            {
+                remap = optimizePrimitive(poolVertices, poolIndices, source.mFirstVertex, source.mVertexCount, source.mFirstIndex, source.mIndexCount, 
+                                          source.mIsSkinned);
+            }
+
+            // deltas follow their vertices, then group by vertex (targets stay in order within each)
+            if (!source.mMorphDeltas.empty())
+            {
+                for (auto& vertex : morphVertices)
+                {
+                    vertex = remap.empty() ? vertex : remap[vertex];
+                }
+
+                std::vector<uint32_t> order(morphVertices.size());
+                std::iota(order.begin(), order.end(), 0u);
+                std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return morphVertices[a] < morphVertices[b]; });
+
+                std::vector<MorphDelta> sortedDeltas(order.size());
+                source.mMorphCounts.assign(source.mVertexCount, 0u);
+                for (size_t i = 0; i < order.size(); ++i)
+                {
+                    sortedDeltas[i] = source.mMorphDeltas[order[i]];
+                    ++source.mMorphCounts[morphVertices[order[i]]];
+                }
+                source.mMorphDeltas = std::move(sortedDeltas);
+            }
+        };
+
+        if (sources.size() > 1)
+        {
+            if (!m_threadPool)
+            {
+                m_threadPool = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()), kReservedFrameWorkers, "model");
+            }
+            m_threadPool->parallelFor(TaskPriority::kBackground, sources.size(), 1, decodePrimitive).wait();
+        }
+        else if (!sources.empty())
+        {
+            decodePrimitive(0);
+        }
+        m_loadTimings.mTangents = static_cast<double>(tangentNanoseconds.load(std::memory_order_relaxed)) / 1.0e6;
+
+        // primitives of each mesh in declaration order; meshes stay indexed like the gltf's
+        m_meshes.resize(model.meshes.size());
+        for (size_t meshIdx = 0; meshIdx < model.meshes.size(); ++meshIdx)
+        {
+            m_meshes[meshIdx].mName = model.meshes[meshIdx].name;
+            m_meshes[meshIdx].mFirstMorphWeight = meshMorphWeights[meshIdx].x;
+            m_meshes[meshIdx].mMorphWeightCount = meshMorphWeights[meshIdx].y;
+        }
+
+        // every skinned vertex addresses its own run of the primitives' deltas, in pool order
+        std::vector<glm::uvec2> morphRanges;
+        std::vector<MorphDelta> morphDeltas;
+        for (auto& source : sources)
+        {
+            if (source.mMorphDeltas.empty())
+            {
+                continue;
+            }
+
+            morphRanges.resize(skinnedVertexCount, glm::uvec2(0));
+            uint32_t firstDelta = static_cast<uint32_t>(morphDeltas.size());
+            for (uint32_t v = 0; v < source.mVertexCount; ++v)
+            {
+                morphRanges[source.mFirstVertex + v] = glm::uvec2(firstDelta, source.mMorphCounts[v]);
+                firstDelta += source.mMorphCounts[v];
+            }
+            morphDeltas.insert(morphDeltas.end(), source.mMorphDeltas.begin(), source.mMorphDeltas.end());
+            source.mMorphDeltas = std::vector<MorphDelta>();
+        }
+
+        for (const auto& source : sources)
+        {
+            Primitive primitive{};
+            primitive.mFirstIndex = source.mFirstIndex;
+            primitive.mIndexCount = source.mIndexCount;
+            primitive.mFirstVertex = source.mFirstVertex;
+            primitive.mVertexCount = source.mVertexCount;
+            primitive.mMaterialIndex = (source.mPrimitive->material >= 0) ? source.mPrimitive->material : -1;
+            primitive.mIsSkinned = source.mIsSkinned;
+            primitive.mBounds = source.mBounds;
+            primitive.mDequantize = glm::mat4(1.0f);
+            m_meshes[source.mMesh].mPrimitives.emplace_back(std::move(primitive));
+        }
+
+        // simplified levels are appended to their pool's indices, after every full-detail range
+        if (config.mGenerateLods)
+        {
+            for (auto& mesh : m_meshes)
+            {
+                for (auto& primitive : mesh.mPrimitives)
+                {
+                    generatePrimitiveLods(primitive.mIsSkinned ? skinnedVertices : vertices, primitive.mIsSkinned ? skinnedIndices : indices, primitive);
+                }
+            }
+        }
+
+        // skinned indices follow the static ones in the shared index buffer
+        const uint32_t skinnedIndexBase = static_cast<uint32_t>(indices.size());
+        for (auto& mesh : m_meshes)
+        {
+            for (auto& primitive : mesh.mPrimitives)
+            {
+                primitive.mFirstIndex += primitive.mIsSkinned ? skinnedIndexBase : 0;
+                for (uint32_t lod = 0; lod < primitive.mLodCount; ++lod)
+                {
+                    primitive.mLods[lod].mFirstIndex += primitive.mIsSkinned ? skinnedIndexBase : 0;
+                }
+            }
+        }
+        indices.insert(indices.end(), skinnedIndices.begin(), skinnedIndices.end());
+        m_skinnedVertexCount = static_cast<uint32_t>(skinnedVertices.size());
+
+        // skinned draws share the pipeline with the float skinning output, so they keep the standard layout
+        m_vertexFormat = config.mVertexFormat;
+        if (m_vertexFormat == VertexFormat::kPacked && !skinnedVertices.empty())
+        {
+            VK_LOG_INFO("GLTFModel::loadMeshes :: packed vertices not supported with skins or morph targets, using standard layout");
+            m_vertexFormat = VertexFormat::kStandard;
+        }
+
+        // quantize static vertices per primitive
+        std::vector<PackedVertex> packedVertices;
+        if (m_vertexFormat == VertexFormat::kPacked)
+        {
+            packedVertices.resize(vertices.size());
+            for (auto& mesh : m_meshes)
+            {
+                for (auto& primitive : mesh.mPrimitives)
+                {
+                    primitive.mDequantize = packVertices(vertices, primitive, packedVertices);
+                }
+            }
+        }
+
+        // meshlets over the full-detail static ranges, once vertices are final (their bounds follow the quantization)
+        std::vector<MeshletData> meshlets;
+        std::vector<uint32_t> meshletVertices;
+        std::vector<uint32_t> meshletTriangles;
+        for (auto& mesh : m_meshes)
+        {
+            for (auto& primitive : mesh.mPrimitives)
+            {
+                primitive.mFirstMeshlet = static_cast<uint32_t>(meshlets.size());
+                primitive.mMeshletCount = 0;
+                if (config.mBuildMeshlets)
+                {
+                    buildPrimitiveMeshlets(vertices, indices, primitive, meshlets, meshletVertices, meshletTriangles);
+                }
+            }
+        }
+
+        // upload the static and skinned pools and the shared index buffer (a deferred load only keeps them)
+        const bool isPacked = m_vertexFormat == VertexFormat::kPacked;
+        const uint8_t* vertexData = isPacked ? reinterpret_cast<const uint8_t*>(packedVertices.data()) : reinterpret_cast<const uint8_t*>(vertices.data());
+        const size_t vertexDataSize = (isPacked ? sizeof(PackedVertex) : sizeof(Vertex)) * vertices.size();
+        if (stagingBelt && !createMeshBuffers(device, *stagingBelt, vertexData, vertexDataSize, skinnedVertices.data(), skinnedVertices.size(), 
+                                              indices.data(), indices.size()))
+        {
+            return false;
+        }
+
+        if (stagingBelt && !createMorphBuffers(device, *stagingBelt, morphRanges.data(), morphRanges.size(), morphDeltas.data(), morphDeltas.size()))
+        {
+            return false;
+        }
+
+        if (stagingBelt && !meshlets.empty() && !createMeshletBuffers(device, *stagingBelt, meshlets.data(), meshlets.size(), meshletVertices.data(), 
+                                                                      meshletVertices.size(), meshletTriangles.data(), meshletTriangles.size()))
+        {
+            return false;
+        }
+
+        // keep the final pools for the baked cache or the deferred upload
+        if (m_bakeData)
+        {
+            m_bakeData->mVertexData.assign(vertexData, vertexData + vertexDataSize);
+            m_bakeData->mSkinnedVertices = std::move(skinnedVertices);
+            m_bakeData->mIndices = std::move(indices);
+            m_bakeData->mMorphRanges = std::move(morphRanges);
+            m_bakeData->mMorphDeltas = std::move(morphDeltas);
+            m_bakeData->mMeshlets = std::move(meshlets);
+            m_bakeData->mMeshletVertices = std::move(meshletVertices);
+            m_bakeData->mMeshletTriangles = std::move(meshletTriangles);
+        }
+
+        VK_LOG_DEBUG("GLTFModel::loadMeshes :: meshes uploaded to device buffer successfully (vertices:%u, indices:%u, lod indices:%u, meshlets:%u)", 
+                     m_vertexCount, m_indexCount, m_lodIndexCount, m_meshletCount);
+        return true;
+    }
+
+    bool GLTFModel::createMeshBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const void* vertexData, size_t vertexDataSize, 
+                                      const Vertex* skinnedVertices, size_t skinnedVertexCount, const uint32_t* indices, size_t indexCount) noexcept
+    {
+        // vertex pools are also read through their address by pulled indirect draws
+        m_hasVertexAddresses = device.isBufferDeviceAddressEnabled();
+        m_isVertexPullingEnabled = m_isVertexPullingEnabled && m_hasVertexAddresses;
+        const VkBufferUsageFlags addressUsage = m_hasVertexAddresses ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : 0;
+
+        // positions and indices are also the geometry of acceleration structure builds
+        const VkBufferUsageFlags buildInputUsage = device.isRayQueryEnabled() ? 
+                                                   (VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) : 0;
+        m_hasRayTracingInputs = false;
+
+        // indices are kept pool-absolute until upload; the gpu copy is relative to each primitive's first vertex
+        std::vector<uint32_t> localIndices(indices, indices + indexCount);
+        const uint32_t maxLocalIndex = rebaseIndices(localIndices);
+
+        // shared arena: one range for the static pool and every index (skinned primitives index their own pool)
+        const size_t vertexStride = getVertexStride(m_vertexFormat);
+        const size_t staticVertexCount = vertexDataSize / vertexStride;
+        if (m_geometryArena && (m_geometryArena->getVertexStride() != vertexStride || 
+            !m_geometryArena->allocate(static_cast<uint32_t>(staticVertexCount), static_cast<uint32_t>(indexCount), m_geometryRange)))
+        {
+            VK_LOG_INFO("GLTFModel::createMeshBuffers :: geometry does not fit the shared arena, using model buffers");
+            m_geometryArena = nullptr;
+        }
+
+        if (m_geometryArena && !m_geometryArena->upload(stagingBelt, m_geometryRange, vertexData, localIndices.data()))
+        {
+            VK_LOG_ERROR("GLTFModel::createMeshBuffers :: failed to upload geometry into the shared arena");
+            return false;
+        }
+
+        // create device-local vertex buffer: positions, normals, uvs, tangents (also fetched by the mesh stage)
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | addressUsage;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.size = vertexDataSize;
+
+        if (!m_geometryArena && vertexDataSize > 0 && !m_vertexBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, vertexData, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMeshBuffers :: failed to create device-local buffer for vertex data");
+            return false;
+        }
+
+        // position-only copy of the static pool for the depth pre-pass: the leading member of either vertex layout
+        const size_t positionSize = m_vertexFormat == VertexFormat::kPacked ? sizeof(PackedVertex::mPosition) : sizeof(Vertex::mPosition);
+        if (staticVertexCount > 0)
+        {
+            std::vector<uint8_t> positions(staticVertexCount * positionSize);
+            const uint8_t* vertexBytes = static_cast<const uint8_t*>(vertexData);
+            for (size_t i = 0; i < staticVertexCount; ++i)
+            {
+                std::memcpy(&positions[i * positionSize], vertexBytes + i * vertexStride, positionSize);
+            }
+
+            // not fatal: without it the model draws without a depth pre-pass (and builds no acceleration structures)
+            bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | buildInputUsage;
+            bufferCreateInfo.size = positions.size();
+            if (!m_positionBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, positions.data(), positions.size()))
+            {
+                VK_LOG_WARN("GLTFModel::createMeshBuffers :: failed to create device-local buffer for positions, depth pre-pass disabled");
+                m_positionBuffer = VulkanBuffer();
+            }
+            m_hasRayTracingInputs = buildInputUsage != 0 && m_positionBuffer.get() != VK_NULL_HANDLE;
+        }
+
+        // skinned pool in bind pose: drawn directly until a compute pass skins it into the per-frame buffers
+        if (skinnedVertexCount > 0)
+        {
+            bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | addressUsage;
+            bufferCreateInfo.size = sizeof(Vertex) * skinnedVertexCount;
+            if (!m_skinnedRestBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, skinnedVertices, bufferCreateInfo.size))
+            {
+                VK_LOG_ERROR("GLTFModel::createMeshBuffers :: failed to create device-local buffer for skinned vertex data");
+                return false;
+            }
+
+            // compute output, one copy per frame in flight (starts in bind pose)
+            for (auto& skinnedVertexBuffer : m_skinnedVertexBuffers)
+            {
+                if (!skinnedVertexBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, skinnedVertices, bufferCreateInfo.size))
+                {
+                    VK_LOG_ERROR("GLTFModel::createMeshBuffers :: failed to create device-local buffer for skinned output");
+                    return false;
+                }
+            }
+        }
+
+        // the arena's indices are 32-bit; the model's own buffer narrows them when every primitive's range fits
+        m_indexType = (!m_geometryArena && maxLocalIndex < 0xFFFFu) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        if (m_geometryArena)
+        {
+            return true;
+        }
+
+        // create device-local index buffer: triangle indices
+        std::vector<uint16_t> shortIndices;
+        if (m_indexType == VK_INDEX_TYPE_UINT16)
+        {
+            shortIndices.assign(localIndices.begin(), localIndices.end());
+        }
+
+        const void* indexData = m_indexType == VK_INDEX_TYPE_UINT16 ? static_cast<const void*>(shortIndices.data()) : localIndices.data();
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | buildInputUsage;
+        bufferCreateInfo.size = (m_indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t)) * indexCount;
+
+        if (!m_indexBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, indexData, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMeshBuffers :: failed to create device-local buffer for index data");
+            return false;
+        }
+
+        VK_LOG_DEBUG("GLTFModel::createMeshBuffers :: %s indices (%zu)", m_indexType == VK_INDEX_TYPE_UINT16 ? "16-bit" : "32-bit", indexCount);
+        return true;
+    }
+
+    uint32_t GLTFModel::rebaseIndices(std::vector<uint32_t>& indices) const noexcept
+    {
+        // every full-detail and simplified range of a primitive addresses the same vertices. parsed models describe their
+        // ranges by mesh primitive, baked ones only by draw item, where primitives repeat, so each index is rebased once
+        uint32_t maxLocalIndex = 0;
+        std::vector<uint8_t> isRebased(indices.size(), 0);
+        const auto rebaseRange = [&](uint32_t firstIndex, uint32_t indexCount, uint32_t baseVertex)
+        {
+            const size_t end = std::min(static_cast<size_t>(firstIndex) + indexCount, indices.size());
+            for (size_t i = firstIndex; i < end; ++i)
+            {
+                if (!isRebased[i])
+                {
+                    indices[i] = indices[i] >= baseVertex ? indices[i] - baseVertex : 0u;
+                    isRebased[i] = 1;
+                }
+                maxLocalIndex = std::max(maxLocalIndex, indices[i]);
+            }
+        };
+
+        for (const auto& mesh : m_meshes)
+        {
+            for (const auto& primitive : mesh.mPrimitives)
+            {
+                rebaseRange(primitive.mFirstIndex, primitive.mIndexCount, primitive.mFirstVertex);
+                for (uint32_t lod = 0; lod < primitive.mLodCount; ++lod)
+                {
+                    rebaseRange(primitive.mLods[lod].mFirstIndex, primitive.mLods[lod].mIndexCount, primitive.mFirstVertex);
+                }
+            }
+        }
+
+        for (const auto& item : m_drawItems)
+        {
+            rebaseRange(item.mFirstIndex, item.mIndexCount, item.mBaseVertex);
+            for (uint32_t lod = 0; lod < item.mLodCount; ++lod)
+            {
+                rebaseRange(item.mLods[lod].mFirstIndex, item.mLods[lod].mIndexCount, item.mBaseVertex);
+            }
+        }
+        return maxLocalIndex;
+    }
+
+    bool GLTFModel::createMeshletBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const MeshletData* meshlets, size_t meshletCount,
+                                         const uint32_t* meshletVertices, size_t meshletVertexCount, const uint32_t* meshletTriangles, 
+                                         size_t meshletTriangleCount) noexcept
+    {
+        // device-local storage buffers read only by the task and mesh stages
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        bufferCreateInfo.size = sizeof(MeshletData) * meshletCount;
+        if (!m_meshletBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, meshlets, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMeshletBuffers :: failed to create device-local buffer for meshlets");
+            return false;
+        }
+
+        bufferCreateInfo.size = sizeof(uint32_t) * meshletVertexCount;
+        if (!m_meshletVertexBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, meshletVertices, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMeshletBuffers :: failed to create device-local buffer for meshlet vertices");
+            return false;
+        }
+
+        bufferCreateInfo.size = sizeof(uint32_t) * meshletTriangleCount;
+        if (!m_meshletTriangleBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, meshletTriangles, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMeshletBuffers :: failed to create device-local buffer for meshlet triangles");
+            return false;
+        }
+
+        m_meshletCount = static_cast<uint32_t>(meshletCount);
+        return true;
+    }
+
+    bool GLTFModel::loadSceneGraph(const tinygltf::Model& model) noexcept
+    {
+        // clear previous data
+        m_nodes.clear();
+        m_scenes.clear();
+
+        // pre-allocate vectors
+        m_nodes.reserve(model.nodes.size());
+        m_scenes.reserve(model.scenes.size());
+
+        // load all nodes
+        for (size_t i = 0; i < model.nodes.size(); i++)
+        {
+            const auto& gltfNode = model.nodes[i];
+            Node node{};
+            node.mName       = gltfNode.name;
+            node.mMeshIndex  = gltfNode.mesh >= 0 ? gltfNode.mesh : -1;
+            node.mSkinIndex  = gltfNode.skin >= 0 ? gltfNode.skin : -1;
+            node.mChildren   = gltfNode.children;
+
+            // instances share their mesh's vertices and so its morph weights: a node's own weights replace them
+            if (node.mMeshIndex >= 0 && node.mMeshIndex < static_cast<int32_t>(m_meshes.size()))
+            {
+                const Mesh& mesh = m_meshes[node.mMeshIndex];
+                for (size_t t = 0; t < gltfNode.weights.size() && t < mesh.mMorphWeightCount; ++t)
+                {
+                    m_morphWeights[mesh.mFirstMorphWeight + t] = static_cast<float>(gltfNode.weights[t]);
+                }
+            }
+
+            // local trs; animated nodes rebuild their transform from it every frame
+            node.mTranslation = glm::vec3(0.0f);
+            node.mRotation    = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+            node.mScale       = glm::vec3(1.0f);
+
+            // compute local transform
+            if (!gltfNode.matrix.empty())
+            {
+                node.mLocalTransform = glm::make_mat4(gltfNode.matrix.data());
+            }
+            else 
+            {
+                glm::vec3& translation = node.mTranslation;
+                glm::quat& rotation    = node.mRotation;
+                glm::vec3& scale       = node.mScale;
+
+                if (!gltfNode.translation.empty())
+                {
+                    translation = glm::vec3(static_cast<float>(gltfNode.translation[0]),
+                                            static_cast<float>(gltfNode.translation[1]),
+                                            static_cast<float>(gltfNode.translation[2]));
+                }
+
+                if (!gltfNode.rotation.empty())
+                {
+                    rotation = glm::quat(static_cast<float>(gltfNode.rotation[3]),
+                                         static_cast<float>(gltfNode.rotation[0]),
+                                         static_cast<float>(gltfNode.rotation[1]),
+                                         static_cast<float>(gltfNode.rotation[2]));
+                }
+                
+                if (!gltfNode.scale.empty())
+                {
+                    scale = glm::vec3(static_cast<float>(gltfNode.scale[0]),
+                                      static_cast<float>(gltfNode.scale[1]),
+                                      static_cast<float>(gltfNode.scale[2]));
+                }
+
+                node.mLocalTransform = glm::translate(glm::mat4(1.0f), translation) *
+                                       glm::mat4_cast(rotation) * 
+                                       glm::scale(glm::mat4(1.0f), scale);
+            }
+
+            m_nodes.emplace_back(std::move(node));
+        }
+
+        // track scene root nodes
+        for (const auto& gltfScene : model.scenes)
+        {
+            Scene scene{};
+            scene.mName       = gltfScene.name;
+            scene.mRootNodes  = gltfScene.nodes;
+
+            m_scenes.emplace_back(std::move(scene));
+            VK_LOG_DEBUG("GLTFModel::loadSceneGraph :: scene loaded: '%s'", gltfScene.name.c_str());
+        }
+
+        // flatten the default scene, then resolve transforms and bounds in linear passes
+        flattenSceneGraph(model);
+        updateWorldTransforms();
+        updateBounds();
+
+        VK_LOG_DEBUG("GLTFModel::loadSceneGraph :: loaded %zu nodes across %zu scenes (%zu flattened, %zu draws)", 
+                     m_nodes.size(), m_scenes.size(), m_nodeParents.size(), m_drawItems.size());
+        return true;
+    }
+
+    void GLTFModel::flattenSceneGraph(const tinygltf::Model& model) noexcept
+    {
+        // clear previous data
+        m_nodeParents.clear();
+        m_nodeFlatIndices.assign(m_nodes.size(), -1);
+        m_nodeTranslations.clear();
+        m_nodeRotations.clear();
+        m_nodeScales.clear();
+        m_nodeLocalTransforms.clear();
+        m_nodeWorldTransforms.clear();
+        m_nodeSubtreeEnds.clear();
+        m_nodeBounds.clear();
+        m_nodeDrawRanges.clear();
+        m_drawItems.clear();
+
+        if (m_scenes.empty())
+        {
+            return;
+        }
+
+        // iterative pre-order traversal: parents precede children and every subtree is contiguous
+        struct StackEntry
+        {
+            int32_t mNodeIndex;
+            int32_t mParent;
+        };
+
+        // dense primitive ids: the primitives of mesh m start at meshPrimitiveBases[m]
+        std::vector<uint32_t> meshPrimitiveBases(m_meshes.size(), 0);
+        for (size_t mesh = 1; mesh < m_meshes.size(); ++mesh)
+        {
+            meshPrimitiveBases[mesh] = meshPrimitiveBases[mesh - 1] + static_cast<uint32_t>(m_meshes[mesh - 1].mPrimitives.size());
+        }
+
+        std::vector<StackEntry> stack;
+        stack.reserve(m_nodes.size());
+        const auto& rootNodes = m_scenes[0].mRootNodes;
+        for (auto itr = rootNodes.rbegin(); itr != rootNodes.rend(); ++itr)
+        {
+            stack.push_back({ *itr, -1 });
+        }
+
+        while (!stack.empty())
+        {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+
+            // validate node index; a node reachable twice would alias its trs
+            if (entry.mNodeIndex < 0 || entry.mNodeIndex >= static_cast<int32_t>(m_nodes.size()) || m_nodeFlatIndices[entry.mNodeIndex] >= 0)
+            {
+                continue;
+            }
+
+            const Node& node = m_nodes[entry.mNodeIndex];
+            const uint32_t flatIndex = static_cast<uint32_t>(m_nodeParents.size());
+            m_nodeFlatIndices[entry.mNodeIndex] = static_cast<int32_t>(flatIndex);
+            m_nodeParents.push_back(entry.mParent);
+            m_nodeTranslations.push_back(node.mTranslation);
+            m_nodeRotations.push_back(node.mRotation);
+            m_nodeScales.push_back(node.mScale);
+            m_nodeLocalTransforms.push_back(node.mLocalTransform);
+
+            // dense draw list, grouped by node in traversal order
+            const uint32_t firstItem = static_cast<uint32_t>(m_drawItems.size());
+            if (node.mMeshIndex >= 0 && node.mMeshIndex < static_cast<int32_t>(m_meshes.size()))
+            {
+                const auto& primitives = m_meshes[node.mMeshIndex].mPrimitives;
+                for (uint32_t primitiveIdx = 0; primitiveIdx < static_cast<uint32_t>(primitives.size()); ++primitiveIdx)
+                {
+                    const auto& primitive = primitives[primitiveIdx];
+                    // primitives without a material are never drawn
+                    if (primitive.mMaterialIndex < 0 || primitive.mMaterialIndex >= static_cast<int32_t>(model.materials.size()))
+                    {
+                        VK_LOG_DEBUG_THROTTLED("GLTFModel::flattenSceneGraph :: invalid material, primitive skipped");
+                        continue;
+                    }
+
+                    DrawItem item{};
+                    item.mNode          = flatIndex;
+                    item.mFirstIndex    = primitive.mFirstIndex;
+                    item.mIndexCount    = primitive.mIndexCount;
+                    item.mLodCount      = primitive.mLodCount;
+                    item.mLods          = primitive.mLods;
+                    item.mBaseVertex    = primitive.mFirstVertex;
+                    item.mFirstMeshlet  = primitive.mFirstMeshlet;
+                    item.mMeshletCount  = primitive.mMeshletCount;
+                    item.mMaterialIndex = primitive.mMaterialIndex;
+                    item.mPrimitive     = meshPrimitiveBases[node.mMeshIndex] + primitiveIdx;
+                    item.mIsSkinned     = primitive.mIsSkinned;
+                    item.mDequantize    = primitive.mDequantize;
+                    item.mLocalBounds   = primitive.mBounds;
+                    m_drawItems.emplace_back(item);
+                }
+            }
+            m_nodeDrawRanges.emplace_back(firstItem, static_cast<uint32_t>(m_drawItems.size()) - firstItem);
+
+            // push children in reverse so they are visited in declaration order
+            for (auto itr = node.mChildren.rbegin(); itr != node.mChildren.rend(); ++itr)
+            {
+                stack.push_back({ *itr, static_cast<int32_t>(flatIndex) });
+            }
+        }
+
+        // subtree of node i spans [i, end): the first later entry whose parent chain leaves i
+        const uint32_t nodeCount = static_cast<uint32_t>(m_nodeParents.size());
+        m_nodeSubtreeEnds.assign(nodeCount, nodeCount);
+        std::vector<uint32_t> openNodes;
+        for (uint32_t i = 0; i < nodeCount; ++i)
+        {
+            while (!openNodes.empty() && static_cast<int32_t>(openNodes.back()) != m_nodeParents[i])
+            {
+                m_nodeSubtreeEnds[openNodes.back()] = i;
+                openNodes.pop_back();
+            }
+            openNodes.push_back(i);
+        }
+
+        m_nodeWorldTransforms.assign(nodeCount, glm::mat4(1.0f));
+        m_nodeBounds.assign(nodeCount, BoundingBox{});
+    }
+
+    void GLTFModel::updateWorldTransforms() noexcept
+    {
+        // parents precede children, so one forward pass resolves the whole hierarchy
+        const size_t nodeCount = m_nodeParents.size();
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            const int32_t parent = m_nodeParents[i];
+            m_nodeWorldTransforms[i] = parent < 0 ? m_nodeLocalTransforms[i] : m_nodeWorldTransforms[parent] * m_nodeLocalTransforms[i];
+        }
+    }
+
+    void GLTFModel::updateBounds() noexcept
+    {
+        // world-space bounds of every draw item, accumulated onto its node
+        std::fill(m_nodeBounds.begin(), m_nodeBounds.end(), BoundingBox{});
+        for (auto& item : m_drawItems)
+        {
+            item.mWorldBounds = item.mLocalBounds.transformed(m_nodeWorldTransforms[item.mNode]);
+            m_nodeBounds[item.mNode].expand(item.mWorldBounds);
+        }
+
+        // children follow parents, so a reverse pass folds each subtree into its root
+        for (size_t i = m_nodeParents.size(); i-- > 0; )
+        {
+            const int32_t parent = m_nodeParents[i];
+            if (parent >= 0)
+            {
+                m_nodeBounds[parent].expand(m_nodeBounds[i]);
+            }
+        }
+    }
+
+    void GLTFModel::updateDirtyTransforms() noexcept
+    {
+        // collapse dirty nodes (sorted) into their outermost subtrees; nested ones are covered by an ancestor
+        m_dirtyRanges.clear();
+        size_t dirtyNodeCount = 0;
+        uint32_t coveredEnd = 0;
+        for (const uint32_t node : m_dirtyNodes)
+        {
+            if (node < coveredEnd)
+            {
+                continue;
+            }
+
+            coveredEnd = m_nodeSubtreeEnds[node];
+            m_dirtyRanges.emplace_back(node, coveredEnd);
+            dirtyNodeCount += coveredEnd - node;
+        }
+
+        if (dirtyNodeCount < kParallelTransformThreshold)
+        {
+            // small update: walk each dirty subtree in order
+            for (const glm::uvec2& range : m_dirtyRanges)
+            {
+                for (uint32_t node = range.x; node < range.y; ++node)
+                {
+                    updateNodeTransform(node);
+                }
+            }
+        }
+        else
+        {
+            // split oversized subtrees at their children: the root is resolved here, children become independent tasks
+            std::vector<glm::uvec2> tasks;
+            std::vector<glm::uvec2> pending(m_dirtyRanges.begin(), m_dirtyRanges.end());
+            while (!pending.empty())
+            {
+                const glm::uvec2 range = pending.back();
+                pending.pop_back();
+                if (range.y - range.x <= kTransformChunkSize)
+                {
+                    tasks.emplace_back(range);
+                    continue;
+                }
+
+                updateNodeTransform(range.x);
+                for (uint32_t child = range.x + 1; child < range.y; child = m_nodeSubtreeEnds[child])
+                {
+                    pending.emplace_back(child, m_nodeSubtreeEnds[child]);
+                }
+            }
+
+            // subtrees write disjoint nodes and draw items, and only read ancestors resolved above
+            if (!m_threadPool)
+            {
+                m_threadPool = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()), kReservedFrameWorkers, "model");
+            }
+
+            TaskGroup transformGroup(*m_threadPool, TaskPriority::kFrameCritical);
+            transformGroup.parallelFor(tasks.size(), 1, [this, &tasks](size_t i)
+            {
+                for (uint32_t node = tasks[i].x; node < tasks[i].y; ++node)
+                {
+                    updateNodeTransform(node);
+                }
+            });
+            transformGroup.wait();
+        }
+
+        // fold bounds within each dirty subtree, children follow parents so a reverse pass suffices
+        std::vector<uint32_t> ancestors;
+        for (const glm::uvec2& range : m_dirtyRanges)
+        {
+            for (uint32_t node = range.x; node < range.y; ++node)
+            {
+                m_nodeBounds[node] = getNodeDrawBounds(node);
+            }
+
+            for (uint32_t node = range.y - 1; node > range.x; --node)
+            {
+                m_nodeBounds[m_nodeParents[node]].expand(m_nodeBounds[node]);
+            }
+
+            for (int32_t parent = m_nodeParents[range.x]; parent >= 0; parent = m_nodeParents[parent])
+            {
+                ancestors.push_back(static_cast<uint32_t>(parent));
+            }
+        }
+
+        // rebuild ancestor bounds from their draws and direct children, deepest first
+        std::sort(ancestors.begin(), ancestors.end(), std::greater<uint32_t>());
+        ancestors.erase(std::unique(ancestors.begin(), ancestors.end()), ancestors.end());
+        for (const uint32_t node : ancestors)
+        {
+            BoundingBox bounds = getNodeDrawBounds(node);
+            for (uint32_t child = node + 1; child < m_nodeSubtreeEnds[node]; child = m_nodeSubtreeEnds[child])
+            {
+                bounds.expand(m_nodeBounds[child]);
+            }
+            m_nodeBounds[node] = bounds;
+        }
+    }
+
+    void GLTFModel::updateNodeTransform(uint32_t node) noexcept
+    {
+        // world transform from an up-to-date parent, then the world bounds of the node's own draws
+        const int32_t parent = m_nodeParents[node];
+        m_nodeWorldTransforms[node] = parent < 0 ? m_nodeLocalTransforms[node] : m_nodeWorldTransforms[parent] * m_nodeLocalTransforms[node];
+
+        const glm::uvec2 drawRange = m_nodeDrawRanges[node];
+        for (uint32_t itemIdx = drawRange.x; itemIdx < drawRange.x + drawRange.y; ++itemIdx)
+        {
+            DrawItem& item = m_drawItems[itemIdx];
+            item.mWorldBounds = item.mLocalBounds.transformed(m_nodeWorldTransforms[node]);
+        }
+    }
+
+    BoundingBox GLTFModel::getNodeDrawBounds(uint32_t node) const noexcept
+    {
+        BoundingBox bounds;
+        const glm::uvec2 drawRange = m_nodeDrawRanges[node];
+        for (uint32_t itemIdx = drawRange.x; itemIdx < drawRange.x + drawRange.y; ++itemIdx)
+        {
+            bounds.expand(m_drawItems[itemIdx].mWorldBounds);
+        }
+        return bounds;
+    }
+
+    bool GLTFModel::loadSkins(const tinygltf::Model& model, const VulkanDevice& device, VulkanStagingBelt* stagingBelt) noexcept
+    {
+        // clear previous data
+        m_skins.clear();
+        m_jointMatrices.clear();
+        if (m_skinVertices.empty())
+        {
+            return true;
+        }
+
+        // slot 0 is an identity joint for skinned primitives without a usable skin
+        m_jointMatrices.emplace_back(1.0f);
+        
+        // one skin instance per skinned mesh node of the default scene; a mesh is skinned by its first instance only
+        std::vector<uint8_t> isMeshSkinned(m_meshes.size(), 0);
+        for (size_t nodeIdx = 0; nodeIdx < m_nodes.size(); ++nodeIdx)
+        {
+            const Node& node = m_nodes[nodeIdx];
+            const int32_t flatIndex = m_nodeFlatIndices[nodeIdx];
+            if (node.mSkinIndex < 0 || node.mSkinIndex >= static_cast<int32_t>(model.skins.size()) || 
+                node.mMeshIndex < 0 || node.mMeshIndex >= static_cast<int32_t>(m_meshes.size()) || flatIndex < 0)
+            {
+                continue;
+            }
+
+            if (isMeshSkinned[node.mMeshIndex])
+            {
+                VK_LOG_WARN("GLTFModel::loadSkins :: mesh '%s' is skinned by more than one node; later instances reuse the first skin", 
+                            m_meshes[node.mMeshIndex].mName.c_str());
+                continue;
+            }
+
+            // joints must be part of the flattened hierarchy
+            const auto& gltfSkin = model.skins[node.mSkinIndex];
+            Skin skin{};
+            skin.mName        = gltfSkin.name;
+            skin.mMeshNode    = static_cast<uint32_t>(flatIndex);
+            skin.mJointOffset = static_cast<uint32_t>(m_jointMatrices.size());
+            bool hasAllJoints = true;
+            for (const int joint : gltfSkin.joints)
+            {
+                if (joint < 0 || joint >= static_cast<int>(m_nodeFlatIndices.size()) || m_nodeFlatIndices[joint] < 0)
+                {
+                    hasAllJoints = false;
+                    break;
+                }
+                skin.mJoints.push_back(static_cast<uint32_t>(m_nodeFlatIndices[joint]));
+            }
+
+            if (!hasAllJoints)
+            {
+                VK_LOG_WARN("GLTFModel::loadSkins :: skin '%s' references joints outside the default scene", gltfSkin.name.c_str());
+                continue;
+            }
+
+            // missing inverse bind matrices default to identity
+            std::vector<float> inverseBindMatrices;
+            readFloatAccessor(model, gltfSkin.inverseBindMatrices, 16, inverseBindMatrices);
+            skin.mInverseBindMatrices.assign(skin.mJoints.size(), glm::mat4(1.0f));
+            for (size_t i = 0; i < skin.mJoints.size() && (i + 1) * 16 <= inverseBindMatrices.size(); ++i)
+            {
+                skin.mInverseBindMatrices[i] = glm::make_mat4(&inverseBindMatrices[i * 16]);
+            }
+
+            // rebase this mesh's joint indices into the model-wide joint array
+            for (const auto& primitive : m_meshes[node.mMeshIndex].mPrimitives)
+            {
+                if (!primitive.mIsSkinned)
+                {
+                    continue;
+                }
+
+                for (uint32_t v = primitive.mFirstVertex; v < primitive.mFirstVertex + primitive.mVertexCount; ++v)
+                {
+                    glm::uvec4& joints = m_skinVertices[v].mJoints;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        joints[c] = joints[c] < skin.mJoints.size() ? joints[c] + skin.mJointOffset : 0;
+                    }
+                }
+            }
+
+            isMeshSkinned[node.mMeshIndex] = 1;
+            m_jointMatrices.resize(m_jointMatrices.size() + skin.mJoints.size(), glm::mat4(1.0f));
+            m_skins.emplace_back(std::move(skin));
+        }
+
+        // meshes without a skin instance keep their bind pose through the identity joint
+        for (size_t meshIdx = 0; meshIdx < m_meshes.size(); ++meshIdx)
+        {
+            for (const auto& primitive : m_meshes[meshIdx].mPrimitives)
+            {
+                if (!primitive.mIsSkinned || isMeshSkinned[meshIdx])
+                {
+                    continue;
+                }
+
+                for (uint32_t v = primitive.mFirstVertex; v < primitive.mFirstVertex + primitive.mVertexCount; ++v)
+                {
+                    m_skinVertices[v].mJoints = glm::uvec4(0);
+                }
+            }
+        }
+
+        updateJointMatrices();
+        if (stagingBelt && !createSkinBuffers(device, *stagingBelt, m_skinVertices.data(), m_skinVertices.size()))
+        {
+            return false;
+        }
+
+        // influences now live in the staging ring; release the cpu copy unless it is being baked or uploaded later
+        if (m_bakeData)
+        {
+            m_bakeData->mSkinVertices = std::move(m_skinVertices);
+        }
+        m_skinVertices = std::vector<SkinVertex>();
+
+        VK_LOG_DEBUG("GLTFModel::loadSkins :: skins loaded: %zu (joints: %zu, skinned vertices: %u)", 
+                     m_skins.size(), m_jointMatrices.size(), m_skinnedVertexCount);
+        return true;
+    }
+
+    bool GLTFModel::createSkinBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const SkinVertex* skinVertices, size_t skinVertexCount) noexcept
+    {
+        // skin influences, read once by the skinning pass
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.size = sizeof(SkinVertex) * skinVertexCount;
+        if (!m_skinVertexBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, skinVertices, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createSkinBuffers :: failed to create device-local buffer for skin vertices");
+            return false;
+        }
+
+        // joint matrices, rewritten by the cpu every frame
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bufferCreateInfo.size = sizeof(glm::mat4) * m_jointMatrices.size();
+        for (auto& jointMatrixBuffer : m_jointMatrixBuffers)
+        {
+            if (!jointMatrixBuffer.createHostVisible(device, bufferCreateInfo, m_jointMatrices.data(), bufferCreateInfo.size, true, true))
+            {
+                VK_LOG_ERROR("GLTFModel::createSkinBuffers :: failed to create host-visible buffer for joint matrices");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool GLTFModel::createMorphBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const glm::uvec2* morphRanges, size_t morphRangeCount,
+                                       const MorphDelta* morphDeltas, size_t morphDeltaCount) noexcept
+    {
+        // an earlier load's targets are gone; nothing is created when no target moves a vertex
+        m_morphRangeBuffer = VulkanBuffer();
+        m_morphDeltaBuffer = VulkanBuffer();
+        m_activeMorphTargetCount = 0;
+        for (auto& morphWeightBuffer : m_morphWeightBuffers)
+        {
+            morphWeightBuffer = VulkanBuffer();
+        }
+
+        if (morphDeltaCount == 0 || morphRangeCount == 0 || m_morphWeights.empty())
+        {
+            return true;
+        }
+
+        // delta runs per skinned vertex and the deltas, read by the skinning pass
+        static_assert(sizeof(MorphDelta) == 12 * sizeof(float), "GLTFModel::MorphDelta layout must match skinning.comp");
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.size = sizeof(glm::uvec2) * morphRangeCount;
+        if (!m_morphRangeBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, morphRanges, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMorphBuffers :: failed to create device-local buffer for morph ranges");
+            return false;
+        }
+
+        bufferCreateInfo.size = sizeof(MorphDelta) * morphDeltaCount;
+        if (!m_morphDeltaBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, morphDeltas, bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMorphBuffers :: failed to create device-local buffer for morph deltas");
+            m_morphRangeBuffer = VulkanBuffer();
+            return false;
+        }
+
+        // target weights, rewritten by the cpu every frame
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bufferCreateInfo.size = sizeof(float) * m_morphWeights.size();
+        for (auto& morphWeightBuffer : m_morphWeightBuffers)
+        {
+            if (!morphWeightBuffer.createHostVisible(device, bufferCreateInfo, m_morphWeights.data(), bufferCreateInfo.size, true, true))
+            {
+                VK_LOG_ERROR("GLTFModel::createMorphBuffers :: failed to create host-visible buffer for morph weights");
+                m_morphDeltaBuffer = VulkanBuffer();
+                return false;
+            }
+        }
+
+        VK_LOG_DEBUG("GLTFModel::createMorphBuffers :: morph targets: %zu (deltas: %zu)", m_morphWeights.size(), morphDeltaCount);
+        return true;
+    }
+
+    void GLTFModel::updateJointMatrices() noexcept
+    {
+        // joint matrices are relative to the mesh node, whose world transform is applied when drawing
+        for (const auto& skin : m_skins)
+        {
+            const glm::mat4 inverseMeshTransform = glm::inverse(m_nodeWorldTransforms[skin.mMeshNode]);
+            for (size_t i = 0; i < skin.mJoints.size(); ++i)
+            {
+                m_jointMatrices[skin.mJointOffset + i] = inverseMeshTransform * m_nodeWorldTransforms[skin.mJoints[i]] * skin.mInverseBindMatrices[i];
+            }
+        }
+    }
+
+    bool GLTFModel::uploadJointMatrices(uint32_t frameIndex) noexcept
+    {
+        // nothing to upload without skins
+        if (m_skins.empty() || frameIndex >= kMaxSkinningFrames)
+        {
+            return true;
+        }
+        return m_jointMatrixBuffers[frameIndex].uploadHostVisible(m_jointMatrices.data(), sizeof(glm::mat4) * m_jointMatrices.size());
+    }
+
+    bool GLTFModel::uploadMorphWeights(uint32_t frameIndex) noexcept
+    {
+        // nothing to upload without morph targets
+        if (!hasMorphTargets() || frameIndex >= kMaxSkinningFrames)
+        {
+            return true;
+        }
+
+        // with every weight at zero the skinning pass skips the blend altogether
+        m_activeMorphTargetCount = static_cast<uint32_t>(std::count_if(m_morphWeights.begin(), m_morphWeights.end(), [](float weight) { return weight != 0.0f; }));
+        return m_morphWeightBuffers[frameIndex].uploadHostVisible(m_morphWeights.data(), sizeof(float) * m_morphWeights.size());
+    }
+
+    uint32_t GLTFModel::getVertexStride(VertexFormat format) noexcept
+    {
+        return static_cast<uint32_t>(format == VertexFormat::kPacked ? sizeof(PackedVertex) : sizeof(Vertex));
+    }
+
+    void GLTFModel::releaseGeometry() noexcept
+    {
+        // frames drawing this model have completed by the time it is reloaded or destroyed
+        if (m_geometryArena)
+        {
+            m_geometryArena->release(m_geometryRange);
+            m_geometryArena = nullptr;
+        }
+        m_geometryRange = GeometryRange{};
+        m_vertexBuffer = VulkanBuffer();
+        m_indexBuffer = VulkanBuffer();
+        m_indexType = VK_INDEX_TYPE_UINT32;
+    }
+
+    const VulkanBuffer& GLTFModel::getSkinnedDrawBuffer(uint32_t frameIndex) const noexcept
+    {
+        // skinned output once the compute pass runs, bind pose otherwise
+        return m_isGpuSkinningEnabled && frameIndex < kMaxSkinningFrames ? m_skinnedVertexBuffers[frameIndex] : m_skinnedRestBuffer;
+    }
+
+    bool GLTFModel::loadAnimations(const tinygltf::Model& model) noexcept
+    {
+        // clear previous data
+        m_animations.clear();
+        m_activeAnimation = 0;
+        m_animationTime = 0.0f;
+
+        for (const auto& gltfAnimation : model.animations)
+        {
+            Animation animation{};
+            animation.mName  = gltfAnimation.name;
+            animation.mStart = std::numeric_limits<float>::max();
+            animation.mEnd   = std::numeric_limits<float>::lowest();
+
+            // keyframe samplers
+            for (const auto& gltfSampler : gltfAnimation.samplers)
+            {
+                AnimationSampler sampler{};
+                sampler.mInterpolation = AnimationSampler::Interpolation::kLinear;
+                sampler.mWidth = 1;
+                if (gltfSampler.interpolation == "STEP")
+                {
+                    sampler.mInterpolation = AnimationSampler::Interpolation::kStep;
+                }
+                else if (gltfSampler.interpolation == "CUBICSPLINE")
+                {
+                    sampler.mInterpolation = AnimationSampler::Interpolation::kCubicSpline;
+                }
+
+                // outputs are vec3 (translation, scale) or vec4 (rotation), both widened to vec4, or scalar morph weights
+                std::vector<float> outputs;
+                const bool hasOutput = gltfSampler.output >= 0 && gltfSampler.output < static_cast<int>(model.accessors.size());
+                const int outputType = hasOutput ? model.accessors[gltfSampler.output].type : TINYGLTF_TYPE_VEC3;
+                const uint32_t componentCount = outputType == TINYGLTF_TYPE_VEC4 ? 4 : (outputType == TINYGLTF_TYPE_SCALAR ? 1 : 3);
+                if (!readFloatAccessor(model, gltfSampler.input, 1, sampler.mInputs) || 
+                    !readFloatAccessor(model, gltfSampler.output, componentCount, outputs))
+                {
+                    VK_LOG_WARN("GLTFModel::loadAnimations :: unsupported sampler data in animation '%s'", gltfAnimation.name.c_str());
+                    sampler.mInputs.clear();
+                }
+
+                const size_t keysPerInput = sampler.mInterpolation == AnimationSampler::Interpolation::kCubicSpline ? 3 : 1;
+                const size_t keyCount = sampler.mInputs.size() * keysPerInput;
+                if (componentCount == 1)
+                {
+                    // every key holds one weight per target, packed four to a vec4
+                    const size_t weightCount = keyCount > 0 && outputs.size() % keyCount == 0 ? outputs.size() / keyCount : 0;
+                    sampler.mWidth = static_cast<uint32_t>((weightCount + 3) / 4);
+                    sampler.mOutputs.assign(weightCount > 0 ? keyCount * sampler.mWidth : 0, glm::vec4(0.0f));
+                    for (size_t key = 0; key < keyCount && weightCount > 0; ++key)
+                    {
+                        for (size_t weight = 0; weight < weightCount; ++weight)
+                        {
+                            sampler.mOutputs[key * sampler.mWidth + weight / 4][static_cast<int>(weight % 4)] = outputs[key * weightCount + weight];
+                        }
+                    }
+                }
+                else
+                {
+                    sampler.mOutputs.reserve(outputs.size() / componentCount);
+                    for (size_t i = 0; i + componentCount <= outputs.size(); i += componentCount)
+                    {
+                        sampler.mOutputs.emplace_back(outputs[i], outputs[i + 1], outputs[i + 2], componentCount == 4 ? outputs[i + 3] : 0.0f);
+                    }
+                }
+
+                // reject samplers whose key count does not match the output count
+                if (sampler.mWidth == 0 || sampler.mOutputs.size() != keyCount * sampler.mWidth)
+                {
+                    sampler.mInputs.clear();
+                    sampler.mOutputs.clear();
+                }
+
+                if (!sampler.mInputs.empty())
+                {
+                    animation.mStart = std::min(animation.mStart, sampler.mInputs.front());
+                    animation.mEnd   = std::max(animation.mEnd, sampler.mInputs.back());
+                }
+                animation.mSamplers.emplace_back(std::move(sampler));
+            }
+
+            // channels targeting nodes of the default scene
+            for (const auto& gltfChannel : gltfAnimation.channels)
+            {
+                const int32_t nodeIndex = gltfChannel.target_node;
+                if (nodeIndex < 0 || nodeIndex >= static_cast<int32_t>(m_nodeFlatIndices.size()) || m_nodeFlatIndices[nodeIndex] < 0 ||
+                    gltfChannel.sampler < 0 || gltfChannel.sampler >= static_cast<int>(animation.mSamplers.size()) ||
+                    animation.mSamplers[gltfChannel.sampler].mInputs.empty())
+                {
+                    continue;
+                }
+
+                AnimationChannel channel{};
+                channel.mNode    = static_cast<uint32_t>(m_nodeFlatIndices[nodeIndex]);
+                channel.mSampler = static_cast<uint32_t>(gltfChannel.sampler);
+                if (gltfChannel.target_path == "translation")
+                {
+                    channel.mPath = AnimationChannel::Path::kTranslation;
+                }
+                else if (gltfChannel.target_path == "rotation")
+                {
+                    channel.mPath = AnimationChannel::Path::kRotation;
+                }
+                else if (gltfChannel.target_path == "scale")
+                {
+                    channel.mPath = AnimationChannel::Path::kScale;
+                }
+                else if (gltfChannel.target_path == "weights")
+                {
+                    // the weights of the node's mesh; the sampler must hold one per target
+                    const int32_t meshIndex = m_nodes[nodeIndex].mMeshIndex;
+                    if (meshIndex < 0 || meshIndex >= static_cast<int32_t>(m_meshes.size()) || m_meshes[meshIndex].mMorphWeightCount == 0 ||
+                        animation.mSamplers[channel.mSampler].mWidth * 4 < m_meshes[meshIndex].mMorphWeightCount)
+                    {
+                        continue;
+                    }
+                    channel.mPath        = AnimationChannel::Path::kWeights;
+                    channel.mFirstWeight = m_meshes[meshIndex].mFirstMorphWeight;
+                    channel.mWeightCount = m_meshes[meshIndex].mMorphWeightCount;
+                }
+                else 
+                {
+                    continue;
+                }
+                animation.mChannels.emplace_back(channel);
+            }
+
+            if (animation.mChannels.empty())
+            {
+                VK_LOG_WARN("GLTFModel::loadAnimations :: animation '%s' has no playable channels", gltfAnimation.name.c_str());
+                continue;
+            }
+
+            m_animations.emplace_back(std::move(animation));
+        }
+
+        VK_LOG_DEBUG("GLTFModel::loadAnimations :: animations loaded: %zu", m_animations.size());
+        return true;
+    }
+
+    glm::vec4 GLTFModel::sampleAnimation(const AnimationSampler& sampler, float time, bool isRotation, uint32_t group) noexcept
+    {
+        // clamp outside the keyframe range; group selects one vec4 of wide (morph weight) outputs
+        const bool isCubic = sampler.mInterpolation == AnimationSampler::Interpolation::kCubicSpline;
+        auto getOutput = [&](size_t output) noexcept { return sampler.mOutputs[output * sampler.mWidth + group]; };
+        auto getValue = [&](size_t key) noexcept { return getOutput(isCubic ? key * 3 + 1 : key); };
+        if (time <= sampler.mInputs.front())
+        {
+            return getValue(0);
+        }
+        if (time >= sampler.mInputs.back())
+        {
+            return getValue(sampler.mInputs.size() - 1);
+        }
+
+        // keyframe interval containing time
+        const size_t next  = static_cast<size_t>(std::upper_bound(sampler.mInputs.begin(), sampler.mInputs.end(), time) - sampler.mInputs.begin());
+        const size_t prev  = next - 1;
+        const float  delta = sampler.mInputs[next] - sampler.mInputs[prev];
+        const float  t     = delta > 0.0f ? (time - sampler.mInputs[prev]) / delta : 0.0f;
+
+        switch (sampler.mInterpolation)
+        {
+            case AnimationSampler::Interpolation::kStep:
+                return getValue(prev);
+
+            case AnimationSampler::Interpolation::kCubicSpline:
+            {
+                // hermite spline with tangents scaled by the key interval
+                const float t2 = t * t;
+                const float t3 = t2 * t;
+                const glm::vec4 value = (2.0f * t3 - 3.0f * t2 + 1.0f) * getValue(prev) +
+                                        (t3 - 2.0f * t2 + t) * delta * getOutput(prev * 3 + 2) +
+                                        (-2.0f * t3 + 3.0f * t2) * getValue(next) +
+                                        (t3 - t2) * delta * getOutput(next * 3);
+                return isRotation ? glm::normalize(value) : value;
+            }
+
+            case AnimationSampler::Interpolation::kLinear:
+            default:
+            {
+                if (isRotation)
+                {
+                    const glm::vec4 a = getValue(prev);
+                    const glm::vec4 b = getValue(next);
+                    const glm::quat q = glm::slerp(glm::quat(a.w, a.x, a.y, a.z), glm::quat(b.w, b.x, b.y, b.z), t);
+                    return glm::vec4(q.x, q.y, q.z, q.w);
+                }
+                return glm::mix(getValue(prev), getValue(next), t);
+            }
+        }
+    }
+
+    bool GLTFModel::loadTextures(const tinygltf::Model& model, const VulkanDevice& device, VulkanStagingBelt* stagingBelt, const GLTFLoadConfig& config,
+                                 std::vector<ImageFold>& imageFolds) noexcept
+    {
+        // clear previous data
+        m_textures.clear();
+        m_textures.reserve(model.images.size());
+        m_sharedTextures.assign(model.images.size(), nullptr);
+        m_textureArrays.clear();
+        m_textureLayers.clear();
+
+        // prepare an array of VkFormat per image defaulting to UNORM
+        std::vector<VkFormat> textureFormats(model.images.size(), VK_FORMAT_R8G8B8A8_UNORM);
+
+        // images sampled by a material; the others (e.g. the png fallback of a basisu texture) are not decoded
+        std::vector<uint8_t> isReferenced(model.images.size(), 0);
+        std::vector<uint8_t> isNormalMap(model.images.size(), 0);
+
+        // assign sRGB to color textures based on materials
+        for (const auto& gltfMaterial : model.materials)
+        {
+            auto setFormat = [&](int textureIndex, bool isColor, bool isNormal = false)
+            {
+                const int imageIndex = getTextureImageIndex(model, textureIndex);
+                if (imageIndex < 0 || imageIndex >= static_cast<int>(textureFormats.size()))
+                    return;
+
+                isReferenced[imageIndex] = 1;
+                isNormalMap[imageIndex] |= isNormal ? 1 : 0;
+                if (isColor)
+                {
+                    textureFormats[imageIndex] = VK_FORMAT_R8G8B8A8_SRGB;
+                }
+                else if (textureFormats[imageIndex] != VK_FORMAT_R8G8B8A8_SRGB)
+                {
+                    textureFormats[imageIndex] = VK_FORMAT_R8G8B8A8_UNORM;
+                }
+            };
+
+            setFormat(gltfMaterial.pbrMetallicRoughness.baseColorTexture.index, true);
+            setFormat(gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index, false);
+            setFormat(gltfMaterial.normalTexture.index, false, true);
+            setFormat(gltfMaterial.occlusionTexture.index, false);
+            setFormat(gltfMaterial.emissiveTexture.index, true);
+        }
+
+        // basis universal images transcode to the best block format the device samples (rgba8 when none is)
+        std::vector<VkFormat> transcodeFormats(model.images.size(), VK_FORMAT_UNDEFINED);
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            if (isReferenced[i])
+            {
+                transcodeFormats[i] = Texture::selectCompressedFormat(device, isNormalMap[i] != 0, textureFormats[i] == VK_FORMAT_R8G8B8A8_SRGB);
+            }
+        }
+
+        // lambda to decide if mipmaps should be generated
+        auto shouldGenerateMipmaps = [](const tinygltf::Image& image) noexcept -> bool 
+        {
+            std::string name = image.name.empty() ? image.uri : image.name;
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+            // skip mipmaps for normal maps; generate for all others
+            return name.find("normal") == std::string::npos;
+        };
+
+        // rgba8 chains can be built by the compute downsampler after upload; bakes keep cpu chains so the cache stores them.
+        // both filters renormalize normals, so normal maps referenced by materials get mips too
+        // streamed textures need their whole chain on the cpu; a bake uploads in full and streams from the next load on
+        MipGenerator* mipGenerator = config.mMipGenerator;
+        const bool streamTextures = m_textureStreamer != nullptr && !m_bakeData;
+        const bool useMipGenerator = mipGenerator != nullptr && mipGenerator->isValid() && !m_bakeData && !streamTextures;
+        auto shouldGenerateMips = [&](size_t imageIndex) noexcept -> bool
+        {
+            return shouldGenerateMipmaps(model.images[imageIndex]) || isNormalMap[imageIndex];
+        };
+
+        // external image files already loaded by another model (or loaded now for the next one) come from the asset manager;
+        // its textures are immutable, so none is shared while streaming, and bakes keep their own chains
+        if (config.mAssetManager && stagingBelt && !m_bakeData && !streamTextures)
+        {
+            for (size_t i = 0; i < model.images.size(); ++i)
+            {
+                const std::string& uri = model.images[i].uri;
+                if (!isReferenced[i] || uri.empty() || uri.rfind("data:", 0) == 0)
+                {
+                    continue;
+                }
+
+                // the pre-compressed sibling is preferred as when decoding; a failed shared load falls back to the model's own copy
+                std::error_code errorCode;
+                std::filesystem::path imagePath = std::filesystem::absolute(keplar::config::kModelDir / uri, errorCode);
+                const std::filesystem::path compressedPath = std::filesystem::path(imagePath).replace_extension(".ktx2");
+                if (compressedPath.extension() != imagePath.extension() && AssetPack::exists(compressedPath))
+                {
+                    imagePath = compressedPath;
+                }
+                m_sharedTextures[i] = config.mAssetManager->loadTexture(device, *stagingBelt, imagePath, textureFormats[i], false, shouldGenerateMips(i));
+            }
+        }
+
+        // external image files the decode needs, preferring the pre-compressed sibling, are read as one overlapped batch
+        // instead of a blocking read per decode task; a file the batch missed is read again by its decode
+        constexpr size_t kNoImageFile = static_cast<size_t>(-1);
+        std::vector<FileRead> imageFiles;
+        std::vector<size_t> imageFileIndices(model.images.size(), kNoImageFile);
+        std::vector<uint8_t> isCompressedFile(model.images.size(), 0);
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            const std::string& uri = model.images[i].uri;
+            if (!isReferenced[i] || m_sharedTextures[i] || uri.empty() || uri.rfind("data:", 0) == 0)
+            {
+                continue;
+            }
+
+            std::filesystem::path imagePath = keplar::config::kModelDir / uri;
+            const std::filesystem::path compressedPath = std::filesystem::path(imagePath).replace_extension(".ktx2");
+            if (compressedPath.extension() != imagePath.extension() && AssetPack::exists(compressedPath))
+            {
+                imagePath = compressedPath;
+                isCompressedFile[i] = 1;
+            }
+            imageFileIndices[i] = imageFiles.size();
+            imageFiles.emplace_back().mPath = std::move(imagePath);
+        }
+        AsyncFileIO::getThreadInstance().readFiles(imageFiles.data(), imageFiles.size());
+
+        // decode every image and its mip chain across the thread pool (cpu work only)
+        std::vector<TextureData> textureData(model.images.size());
+        std::vector<uint8_t> isDecoded(model.images.size(), 0);
+        std::vector<uint8_t> isMipTarget(model.images.size(), 0);
+        std::atomic<uint64_t> imageNanoseconds{0};
+        std::atomic<uint64_t> mipNanoseconds{0};
+        if (!model.images.empty())
+        {
+            const size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), model.images.size());
+            ThreadPool threadPool(threadCount, 0, "decode");
+            threadPool.parallelFor(TaskPriority::kBackground, model.images.size(), 1, [&](size_t i)
+            {
+                ScopedStageTime imageTime(imageNanoseconds);
+
+                // a pre-compressed .ktx2 next to an external image (e.g. bc7 color, bc5 normals) replaces it when the device samples its format
+                const auto& gltfImage = model.images[i];
+                if (!isReferenced[i] || m_sharedTextures[i])
+                {
+                    return;
+                }
+
+                const FileRead* imageFile = (imageFileIndices[i] != kNoImageFile && imageFiles[imageFileIndices[i]].mIsRead) ? &imageFiles[imageFileIndices[i]] : nullptr;
+                if (imageFile && isCompressedFile[i])
+                {
+                    if (Texture::decodeKTX2(imageFile->mData.data(), imageFile->mData.size(), gltfImage.uri, textureData[i], transcodeFormats[i]) &&
+                        Texture::isFormatSupported(device, textureData[i].mFormat))
+                    {
+                        isDecoded[i] = 1;
+                        return;
+                    }
+
+                    // the device cannot sample the sibling: the original file is read by the decode
+                    imageFile = nullptr;
+                }
+
+                // base level only; ktx2 data arrives with its stored levels and is left as is
+                size_t embeddedSize = 0;
+                const uint8_t* embeddedData = getEmbeddedImage(model, gltfImage, embeddedSize);
+                bool flipY = false;
+                if (!embeddedData && imageFile && !imageFile->mData.empty())
+                {
+                    // decoded like Texture::loadImageData decodes a uri image, flip included
+                    embeddedData = imageFile->mData.data();
+                    embeddedSize = imageFile->mData.size();
+                    flipY = true;
+                }
+                isDecoded[i] = Texture::decode(gltfImage, textureFormats[i], false, textureData[i], transcodeFormats[i], embeddedData, embeddedSize, flipY) ? 1 : 0;
+                if (isDecoded[i] && imageFile)
+                {
+                    textureData[i].mName = gltfImage.uri;
+                }
+                if (!isDecoded[i] || !shouldGenerateMips(i) || textureData[i].mFormat != VK_FORMAT_UNDEFINED || textureData[i].mMipExtents.size() != 1)
+                {
+                    return;
+                }
+
+                // the compute downsampler takes rgba8 up to 4096; everything else gets its chain here with the configured filter
+                const VkExtent2D extent = textureData[i].mMipExtents[0];
+                if (useMipGenerator && textureData[i].mChannels == 4 && mipGenerator->canGenerate(extent, Texture::getMipLevelCount(extent.width, extent.height)))
+                {
+                    isMipTarget[i] = 1;
+                    return;
+                }
+
+                const bool isSrgb = textureFormats[i] == VK_FORMAT_R8G8B8A8_SRGB || textureFormats[i] == VK_FORMAT_B8G8R8A8_SRGB;
+                ScopedStageTime mipTime(mipNanoseconds);
+                isDecoded[i] = Texture::generateMips(textureData[i], isSrgb, isNormalMap[i] != 0, config.mMipFilter) ? 1 : 0;
+            }).wait();
+        }
+
+        // thread time summed over the decode workers; the mip chains are part of each image's task
+        const uint64_t mipTotal = mipNanoseconds.load(std::memory_order_relaxed);
+        const uint64_t imageTotal = imageNanoseconds.load(std::memory_order_relaxed);
+        m_loadTimings.mImageDecode   = static_cast<double>(imageTotal > mipTotal ? imageTotal - mipTotal : 0) / 1.0e6;
+        m_loadTimings.mMipGeneration = static_cast<double>(mipTotal) / 1.0e6;
+
+        // single-color images become material factors (see loadMaterials)
+        imageFolds.assign(model.images.size(), ImageFold{});
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            if (isDecoded[i] && isConstantImage(textureData[i]))
+            {
+                imageFolds[i].mIsConstant = true;
+                imageFolds[i].mColor      = sampleTexel(textureData[i].mPixels.data(), textureFormats[i] == VK_FORMAT_R8G8B8A8_SRGB);
+            }
+        }
+
+        // a separate occlusion image moves into the red channel of the metallic roughness image it is paired with, which
+        // gltf leaves unused. the metallic roughness image may be sampled nowhere else, by no material paired with another
+        // occlusion image, and both need matching unorm chains, so the red channel of every level is the occlusion's own
+        constexpr int32_t kConflictingPairs = -2;
+        std::vector<int32_t> occlusionPartners(model.images.size(), -1);
+        std::vector<uint8_t> isSampledElsewhere(model.images.size(), 0);
+        auto getImage = [&](int textureIndex) noexcept -> int
+        {
+            const int imageIndex = getTextureImageIndex(model, textureIndex);
+            return imageIndex >= 0 && imageIndex < static_cast<int>(model.images.size()) ? imageIndex : -1;
+        };
+        for (const auto& gltfMaterial : model.materials)
+        {
+            const int metallicRoughness = getImage(gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index);
+            const int occlusion = getImage(gltfMaterial.occlusionTexture.index);
+            for (const int other : { getImage(gltfMaterial.pbrMetallicRoughness.baseColorTexture.index), getImage(gltfMaterial.normalTexture.index),
+                                     occlusion, getImage(gltfMaterial.emissiveTexture.index) })
+            {
+                if (other >= 0)
+                {
+                    isSampledElsewhere[other] = 1;
+                }
+            }
+
+            if (metallicRoughness >= 0 && occlusion >= 0)
+            {
+                int32_t& partner = occlusionPartners[metallicRoughness];
+                partner = (partner == -1 || partner == occlusion) ? occlusion : kConflictingPairs;
+            }
+        }
+
+        size_t packedCount = 0;
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            const int32_t occlusion = occlusionPartners[i];
+            if (occlusion < 0 || static_cast<size_t>(occlusion) == i || isSampledElsewhere[i] || !isDecoded[i] || !isDecoded[occlusion] ||
+                imageFolds[i].mIsConstant || imageFolds[occlusion].mIsConstant || isNormalMap[occlusion] || isMipTarget[i] != isMipTarget[occlusion] ||
+                textureFormats[i] != VK_FORMAT_R8G8B8A8_UNORM || textureFormats[occlusion] != VK_FORMAT_R8G8B8A8_UNORM)
+            {
+                continue;
+            }
+
+            TextureData& metallicRoughnessData = textureData[i];
+            const TextureData& occlusionData = textureData[occlusion];
+            const bool isMatchingChain = metallicRoughnessData.mFormat == VK_FORMAT_UNDEFINED && occlusionData.mFormat == VK_FORMAT_UNDEFINED &&
+                                         metallicRoughnessData.mChannels == 4 && occlusionData.mChannels == 4 &&
+                                         metallicRoughnessData.mPixels.size() == occlusionData.mPixels.size() &&
+                                         metallicRoughnessData.mMipExtents.size() == occlusionData.mMipExtents.size() &&
+                                         std::equal(metallicRoughnessData.mMipExtents.begin(), metallicRoughnessData.mMipExtents.end(), occlusionData.mMipExtents.begin(),
+                                                    [](const VkExtent2D& a, const VkExtent2D& b) { return a.width == b.width && a.height == b.height; });
+            if (!isMatchingChain)
+            {
+                continue;
+            }
+
+            for (size_t offset = 0; offset < metallicRoughnessData.mPixels.size(); offset += 4)
+            {
+                metallicRoughnessData.mPixels[offset] = occlusionData.mPixels[offset];
+            }
+            imageFolds[i].mPackedOcclusion = occlusion;
+            ++packedCount;
+        }
+
+        // images no slot samples any more are not uploaded; the rules match how loadMaterials resolves the slots
+        std::vector<uint8_t> isSampled(model.images.size(), 0);
+        for (const auto& gltfMaterial : model.materials)
+        {
+            const int metallicRoughness = getImage(gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index);
+            const int occlusion = getImage(gltfMaterial.occlusionTexture.index);
+            auto sample = [&](int image, bool isFolded) noexcept
+            {
+                if (image >= 0 && !isFolded)
+                {
+                    isSampled[image] = 1;
+                }
+            };
+
+            const int baseColor = getImage(gltfMaterial.pbrMetallicRoughness.baseColorTexture.index);
+            const int normal = getImage(gltfMaterial.normalTexture.index);
+            const int emissive = getImage(gltfMaterial.emissiveTexture.index);
+            sample(baseColor, baseColor >= 0 && imageFolds[baseColor].mIsConstant);
+            sample(metallicRoughness, metallicRoughness >= 0 && imageFolds[metallicRoughness].mIsConstant);
+            sample(normal, normal >= 0 && imageFolds[normal].mIsConstant && isFlatNormal(imageFolds[normal].mColor));
+            sample(occlusion, occlusion >= 0 && (imageFolds[occlusion].mIsConstant || occlusion == metallicRoughness ||
+                                                 (metallicRoughness >= 0 && imageFolds[metallicRoughness].mPackedOcclusion == occlusion)));
+            sample(emissive, emissive >= 0 && imageFolds[emissive].mIsConstant);
+        }
+
+        size_t droppedCount = 0;
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            if (isReferenced[i] && !isSampled[i] && isDecoded[i])
+            {
+                isReferenced[i] = 0;
+                textureData[i] = TextureData{};
+                ++droppedCount;
+            }
+        }
+        if (packedCount > 0 || droppedCount > 0)
+        {
+            VK_LOG_DEBUG("Model::loadTextures :: %zu occlusion images packed into metallic roughness, %zu images no longer sampled",
+                         packedCount, droppedCount);
+        }
+
+        // small images of one shape go into image arrays; only plain uploads qualify (mip-generated, streamed, shared and
+        // deferred images keep images of their own, and baked caches store one chain per image)
+        if (stagingBelt && !m_bakeData && !streamTextures && config.mTextureArrayMaxSize > 0)
+        {
+            std::vector<uint8_t> isCandidate(model.images.size(), 0);
+            for (size_t i = 0; i < model.images.size(); ++i)
+            {
+                isCandidate[i] = isReferenced[i] && isDecoded[i] && !isMipTarget[i] && !m_sharedTextures[i] ? 1 : 0;
+            }
+            if (!packTextureArrays(device, *stagingBelt, textureData, textureFormats, isCandidate, config.mTextureArrayMaxSize))
+            {
+                return false;
+            }
+        }
+
+        // upload each decoded image as a vulkan texture; copies are batched into the belt
+        std::vector<MipGenerationJob> mipJobs;
+        for (size_t i = 0; i < model.images.size(); ++i)
+        {
+            const auto& gltfImage = model.images[i];
+            Texture texture;
+            if (!isReferenced[i] || (i < m_textureLayers.size() && m_textureLayers[i].mArray != UINT32_MAX))
+            {
+                // keep texture indices aligned with image indices; the placeholder is baked as an empty entry
+                if (m_bakeData)
+                {
+                    m_bakeData->mTextures.emplace_back();
+                    m_bakeData->mTextureFormats.emplace_back(VK_FORMAT_UNDEFINED);
+                }
+                m_textures.emplace(std::move(texture));
+                continue;
+            }
+
+            // shared: the slot stays empty and getTexture resolves it
+            if (m_sharedTextures[i])
+            {
+                m_textures.emplace(std::move(texture));
+                continue;
+            }
+
+            // deferred: decoded chains wait in the bake data for uploadPending
+            if (!stagingBelt)
+            {
+                if (!isDecoded[i])
+                {
+                    VK_LOG_ERROR("Model::loadTextures :: failed to decode texture: %s", gltfImage.uri.c_str());
+                    return false;
+                }
+
+                m_bakeData->mTextures.emplace_back(std::move(textureData[i]));
+                m_bakeData->mTextureFormats.emplace_back(textureFormats[i]);
+                continue;
+            }
+
+            if (isDecoded[i] && isMipTarget[i])
+            {
+                const VkExtent2D extent = textureData[i].mMipExtents[0];
+                if (!texture.uploadForMipGeneration(device, *stagingBelt, textureData[i], textureFormats[i], Texture::getMipLevelCount(extent.width, extent.height)))
+                {
+                    VK_LOG_ERROR("Model::loadTextures :: failed to load texture: %s", gltfImage.uri.c_str());
+                    return false;
+                }
+
+                MipGenerationJob job{};
+                job.mImage       = texture.getImage();
+                job.mExtent      = extent;
+                job.mMipLevels   = texture.getMipLevels();
+                job.mIsSrgb      = textureFormats[i] == VK_FORMAT_R8G8B8A8_SRGB;
+                job.mIsNormalMap = isNormalMap[i] != 0;
+                mipJobs.push_back(job);
+            }
+            else if (streamTextures && isDecoded[i])
+            {
+                if (!m_textureStreamer->add(device, *stagingBelt, static_cast<uint32_t>(i), std::move(textureData[i]), textureFormats[i], texture))
+                {
+                    VK_LOG_ERROR("Model::loadTextures :: failed to load texture: %s", gltfImage.uri.c_str());
+                    return false;
+                }
+            }
+            else if (!isDecoded[i] || !texture.upload(device, *stagingBelt, textureData[i], textureFormats[i]))
+            {
+                VK_LOG_ERROR("Model::loadTextures :: failed to load texture: %s", gltfImage.uri.c_str());
+                return false;
+            }
+
+            // pixels now live in the staging ring; release the cpu copy early unless it is being baked
+            if (m_bakeData)
+            {
+                m_bakeData->mTextures.emplace_back(std::move(textureData[i]));
+                m_bakeData->mTextureFormats.emplace_back(texture.getFormat());
+            }
+            textureData[i] = TextureData{};
+            m_textures.emplace(std::move(texture));
+        }
+
+        // every remaining chain in one batched dispatch, after the base level copies
+        if (!mipJobs.empty() && !mipGenerator->generate(*stagingBelt, mipJobs))
+        {
+            VK_LOG_ERROR("Model::loadTextures :: failed to generate mipmaps for %zu textures", mipJobs.size());
+            return false;
+        }
+
+        VK_LOG_DEBUG("Model::loadTextures :: textures loaded successfully : %zu", m_textures.size());
+        return true;
+    }
+
+    bool GLTFModel::loadMaterials(const tinygltf::Model& model, const std::vector<ImageFold>& imageFolds) noexcept
+    {
+        // clear previous data
+        m_materials.clear();
+        m_materials.reserve(model.materials.size());
+        m_textureSamplers.assign(m_textures.size(), TextureSampler{});
+        std::vector<bool> isSamplerAssigned(m_textures.size(), false);
+
+        for (const auto& gltfMaterial : model.materials)
+        {
+            Material material{};
+
+            // ─────────────────────────────────────────
+            // base material properties
+            // ─────────────────────────────────────────
+            material.mBaseColor = glm::vec4(1.0f);
+            material.mMetallic  = static_cast<float>(gltfMaterial.pbrMetallicRoughness.metallicFactor);
+            material.mRoughness = static_cast<float>(gltfMaterial.pbrMetallicRoughness.roughnessFactor);
+            material.mSpecular  = 1.0f; // KHR_materials_specular
+            material.mEmissive = glm::vec3(0.0f);
+            material.mOcclusion = 1.0f;
+
+            if (gltfMaterial.pbrMetallicRoughness.baseColorFactor.size() == 4)
+            {
+                const auto& baseColor = gltfMaterial.pbrMetallicRoughness.baseColorFactor;
+                material.mBaseColor = glm::vec4(baseColor[0], baseColor[1], baseColor[2], baseColor[3]);
+            }
+
+            if (gltfMaterial.emissiveFactor.size() == 3)
+            {
+                const auto& emissiveColor = gltfMaterial.emissiveFactor;
+                material.mEmissive = glm::vec3(emissiveColor[0], emissiveColor[1], emissiveColor[2]);
+            }
+
+            // ─────────────────────────────────────────
+            // texture indices
+            // ─────────────────────────────────────────
+            auto getTextureIndex = [&](int index) -> std::optional<uint32_t> 
+            {
+                const int imageIndex = getTextureImageIndex(model, index);
+                if (imageIndex < 0 || imageIndex >= static_cast<int>(m_textures.size()))
+                    return std::nullopt;
+
+                // the first slot to reference an image picks its sampler (images shared under different samplers are rare)
+                const int samplerIndex = model.textures[index].sampler;
+                if (!isSamplerAssigned[imageIndex] && samplerIndex >= 0 && samplerIndex < static_cast<int>(model.samplers.size()))
+                {
+                    const auto& gltfSampler = model.samplers[samplerIndex];
+                    m_textureSamplers[imageIndex] = { gltfSampler.magFilter, gltfSampler.minFilter, gltfSampler.wrapS, gltfSampler.wrapT };
+                }
+                isSamplerAssigned[imageIndex] = true;
+                return imageIndex;
+            };
+
+            material.mBaseColorTex          = getTextureIndex(gltfMaterial.pbrMetallicRoughness.baseColorTexture.index);
+            material.mMetallicRoughnessTex  = getTextureIndex(gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index);
+            material.mNormalTex             = getTextureIndex(gltfMaterial.normalTexture.index);
+            material.mOcclusionTex          = getTextureIndex(gltfMaterial.occlusionTexture.index);
+            material.mEmissiveTex           = getTextureIndex(gltfMaterial.emissiveTexture.index);
+
+            // ─────────────────────────────────────────
+            // texture folding (see loadTextures)
+            // ─────────────────────────────────────────
+            auto getFold = [&](const std::optional<uint32_t>& texture) noexcept -> const ImageFold*
+            {
+                return texture && texture.value() < imageFolds.size() ? &imageFolds[texture.value()] : nullptr;
+            };
+
+            // a constant image is its texel times the factor, transformed as the shader transforms the sample
+            const ImageFold* fold = getFold(material.mBaseColorTex);
+            if (fold && fold->mIsConstant)
+            {
+                material.mBaseColor *= glm::vec4(glm::pow(glm::vec3(fold->mColor), glm::vec3(2.2f)), fold->mColor.a);
+                material.mBaseColorTex.reset();
+            }
+
+            // occlusion before metallic roughness, whose image it may be packed into
+            fold = getFold(material.mOcclusionTex);
+            const ImageFold* metallicRoughnessFold = getFold(material.mMetallicRoughnessTex);
+            if (fold && fold->mIsConstant)
+            {
+                material.mOcclusion = fold->mColor.r;
+                material.mOcclusionTex.reset();
+            }
+            else if (material.mOcclusionTex && material.mMetallicRoughnessTex &&
+                     (material.mOcclusionTex == material.mMetallicRoughnessTex ||
+                      (metallicRoughnessFold && metallicRoughnessFold->mPackedOcclusion == static_cast<int32_t>(material.mOcclusionTex.value()))))
+            {
+                material.mIsOcclusionPacked = true;
+                material.mOcclusionTex.reset();
+            }
+
+            fold = metallicRoughnessFold;
+            if (fold && fold->mIsConstant)
+            {
+                material.mMetallic  *= fold->mColor.b;
+                material.mRoughness *= fold->mColor.g;
+                material.mMetallicRoughnessTex.reset();
+            }
+
+            fold = getFold(material.mNormalTex);
+            if (fold && fold->mIsConstant && isFlatNormal(fold->mColor))
+            {
+                material.mNormalTex.reset();
+            }
+
+            fold = getFold(material.mEmissiveTex);
+            if (fold && fold->mIsConstant)
+            {
+                material.mEmissive *= glm::vec3(fold->mColor);
+                material.mEmissiveTex.reset();
+            }
+
+            // ─────────────────────────────────────────
+            // alpha mode and culling
+            // ─────────────────────────────────────────
+            material.mAlphaMode     = gltfMaterial.alphaMode == "MASK"  ? GLTFAlphaMode::kMask :
+                                      gltfMaterial.alphaMode == "BLEND" ? GLTFAlphaMode::kBlend : GLTFAlphaMode::kOpaque;
+            material.mAlphaCutoff   = material.mAlphaMode == GLTFAlphaMode::kMask ? static_cast<float>(gltfMaterial.alphaCutoff) : 0.0f;
+            material.mIsDoubleSided = gltfMaterial.doubleSided;
+
+            // descriptor set creation is deferred
+            material.mDescriptorSet = VK_NULL_HANDLE;
+            material.mSpareDescriptorSet = VK_NULL_HANDLE;
+            material.mDescriptorSwapFrame = 0;
+            material.mIsDescriptorStale = false;
+            m_materials.emplace_back(std::move(material));
+        }
+
+        buildMaterialPermutations();
+        VK_LOG_DEBUG("GLTFModel::loadMaterials :: materials loaded successfullt: %zu", m_materials.size());
+        return true;
+    }
+
+    void GLTFModel::resolveTextureSamplers(const VulkanDevice& device) noexcept
+    {
+        // gltf sampler state to vulkan: unspecified filters get trilinear anisotropic filtering, like the default preset.
+        // a minification filter without a mipmap mode samples the base level only
+        VulkanSamplerCache& samplerCache = device.getSamplerCache();
+        auto toFilter = [](int32_t filter) noexcept
+        {
+            return (filter == TINYGLTF_TEXTURE_FILTER_NEAREST || filter == TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_NEAREST || 
+                    filter == TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_LINEAR) ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+        };
+        auto toAddressMode = [](int32_t wrap) noexcept
+        {
+            return wrap == TINYGLTF_TEXTURE_WRAP_CLAMP_TO_EDGE   ? VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE :
+                   wrap == TINYGLTF_TEXTURE_WRAP_MIRRORED_REPEAT ? VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT : VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        };
+
+        m_textureSamplers.resize(m_textures.size());
+        m_vkTextureSamplers.assign(m_textures.size(), VK_NULL_HANDLE);
+        for (size_t i = 0; i < m_textureSamplers.size(); ++i)
+        {
+            const TextureSampler& sampler = m_textureSamplers[i];
+            const bool isMipmapped = sampler.mMinFilter != TINYGLTF_TEXTURE_FILTER_NEAREST && sampler.mMinFilter != TINYGLTF_TEXTURE_FILTER_LINEAR;
+            const bool isTrilinear = sampler.mMinFilter < 0 || sampler.mMinFilter == TINYGLTF_TEXTURE_FILTER_LINEAR_MIPMAP_LINEAR;
+            const bool isLinearMip = isTrilinear || sampler.mMinFilter == TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_LINEAR;
+
+            VkSamplerCreateInfo samplerCreateInfo{};
+            samplerCreateInfo.sType                     = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+            samplerCreateInfo.pNext                     = nullptr;
+            samplerCreateInfo.flags                     = 0;
+            samplerCreateInfo.magFilter                 = sampler.mMagFilter == TINYGLTF_TEXTURE_FILTER_NEAREST ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+            samplerCreateInfo.minFilter                 = toFilter(sampler.mMinFilter);
+            samplerCreateInfo.mipmapMode                = isLinearMip ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+            samplerCreateInfo.addressModeU              = toAddressMode(sampler.mWrapS);
+            samplerCreateInfo.addressModeV              = toAddressMode(sampler.mWrapT);
+            samplerCreateInfo.addressModeW              = samplerCreateInfo.addressModeV;
+            samplerCreateInfo.mipLodBias                = 0.0f;
+            samplerCreateInfo.anisotropyEnable          = (isTrilinear && samplerCache.isAnisotropyEnabled()) ? VK_TRUE : VK_FALSE;
+            samplerCreateInfo.maxAnisotropy             = samplerCreateInfo.anisotropyEnable ? samplerCache.getMaxAnisotropy() : 1.0f;
+            samplerCreateInfo.compareEnable             = VK_FALSE;
+            samplerCreateInfo.compareOp                 = VK_COMPARE_OP_ALWAYS;
+            samplerCreateInfo.minLod                    = 0.0f;
+            samplerCreateInfo.maxLod                    = isMipmapped ? VK_LOD_CLAMP_NONE : 0.25f;
+            samplerCreateInfo.borderColor               = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+            samplerCreateInfo.unnormalizedCoordinates   = VK_FALSE;
+            m_vkTextureSamplers[i] = samplerCache.getOrCreate(samplerCreateInfo);
+        }
+
+        VK_LOG_DEBUG("GLTFModel::resolveTextureSamplers :: %zu textures, %zu device samplers", m_vkTextureSamplers.size(), samplerCache.getSamplerCount());
+    }
+
+    VkSampler GLTFModel::getTextureSampler(uint32_t textureIndex, VkSampler fallback) const noexcept
+    {
+        const VkSampler vkSampler = textureIndex < m_vkTextureSamplers.size() ? m_vkTextureSamplers[textureIndex] : VK_NULL_HANDLE;
+        return vkSampler != VK_NULL_HANDLE ? vkSampler : fallback;
+    }
+
+    VkImageView GLTFModel::getTextureView(uint32_t textureIndex) const noexcept
+    {
+        if (textureIndex < m_textureLayers.size() && m_textureLayers[textureIndex].mArray != UINT32_MAX)
+        {
+            const TextureLayer& layer = m_textureLayers[textureIndex];
+            return m_textureArrays[layer.mArray].getLayerView(layer.mLayer);
+        }
+
+        // sparse streamed chains leave their slot empty
+        const VkImageView sparseView = m_textureStreamer ? m_textureStreamer->getSparseView(textureIndex) : VK_NULL_HANDLE;
+        return sparseView != VK_NULL_HANDLE ? sparseView : getTexture(textureIndex).getImageView();
+    }
+
+    bool GLTFModel::packTextureArrays(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, std::vector<TextureData>& textureData,
+                                      const std::vector<VkFormat>& textureFormats, const std::vector<uint8_t>& isCandidate, uint32_t maxSize) noexcept
+    {
+        m_textureLayers.assign(textureData.size(), TextureLayer{});
+
+        // candidates ordered by shape, so every run of equal keys is one group of interchangeable layers
+        auto isSameShape = [&](size_t a, size_t b) noexcept
+        {
+            const TextureData& lhs = textureData[a];
+            const TextureData& rhs = textureData[b];
+            return textureFormats[a] == textureFormats[b] && lhs.mFormat == rhs.mFormat && lhs.mChannels == rhs.mChannels &&
+                   lhs.mPixels.size() == rhs.mPixels.size() && lhs.mMipOffsets == rhs.mMipOffsets &&
+                   lhs.mMipExtents[0].width == rhs.mMipExtents[0].width && lhs.mMipExtents[0].height == rhs.mMipExtents[0].height;
+        };
+        auto isShapeLess = [&](size_t a, size_t b) noexcept
+        {
+            const TextureData& lhs = textureData[a];
+            const TextureData& rhs = textureData[b];
+            const auto lhsKey = std::make_tuple(textureFormats[a], lhs.mFormat, lhs.mChannels, lhs.mMipExtents[0].width, lhs.mMipExtents[0].height,
+                                                lhs.mMipExtents.size(), lhs.mPixels.size());
+            const auto rhsKey = std::make_tuple(textureFormats[b], rhs.mFormat, rhs.mChannels, rhs.mMipExtents[0].width, rhs.mMipExtents[0].height,
+                                                rhs.mMipExtents.size(), rhs.mPixels.size());
+            return lhsKey != rhsKey ? lhsKey < rhsKey : a < b;
+        };
+
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < textureData.size(); ++i)
+        {
+            const TextureData& data = textureData[i];
+            if (isCandidate[i] && !data.mPixels.empty() && !data.mMipExtents.empty() && data.mMipExtents.size() == data.mMipOffsets.size() &&
+                data.mMipExtents[0].width <= maxSize && data.mMipExtents[0].height <= maxSize)
+            {
+                candidates.push_back(i);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), isShapeLess);
+
+        // each array is staged as one region, so it is also bounded by half the belt
+        const uint32_t maxLayers = device.getPhysicalDeviceProperties().limits.maxImageArrayLayers;
+        size_t packedCount = 0;
+        for (size_t begin = 0; begin < candidates.size();)
+        {
+            size_t end = begin + 1;
+            while (end < candidates.size() && isSameShape(candidates[begin], candidates[end]))
+            {
+                ++end;
+            }
+
+            const VkDeviceSize layerSize = textureData[candidates[begin]].mPixels.size();
+            const size_t layersPerArray = std::min<size_t>(maxLayers, std::max<VkDeviceSize>(1, stagingBelt.getCapacity() / 2 / layerSize));
+            for (size_t chunk = begin; chunk < end; chunk += layersPerArray)
+            {
+                const size_t chunkEnd = std::min(end, chunk + layersPerArray);
+                if (chunkEnd - chunk < 2)
+                {
+                    continue;
+                }
+
+                std::vector<const TextureData*> layers;
+                layers.reserve(chunkEnd - chunk);
+                for (size_t c = chunk; c < chunkEnd; ++c)
+                {
+                    layers.push_back(&textureData[candidates[c]]);
+                }
+
+                Texture textureArray;
+                if (!textureArray.uploadArray(device, stagingBelt, layers, textureFormats[candidates[chunk]]))
+                {
+                    VK_LOG_ERROR("Model::packTextureArrays :: failed to load %zu layers of %s", layers.size(), layers.front()->mName.c_str());
+                    return false;
+                }
+
+                const uint32_t arrayIndex = static_cast<uint32_t>(m_textureArrays.size());
+                for (size_t c = chunk; c < chunkEnd; ++c)
+                {
+                    m_textureLayers[candidates[c]] = TextureLayer{ arrayIndex, static_cast<uint32_t>(c - chunk) };
+                    textureData[candidates[c]] = TextureData{};
+                }
+                m_textureArrays.push_back(std::move(textureArray));
+                packedCount += chunkEnd - chunk;
+            }
+            begin = end;
+        }
+
+        if (packedCount > 0)
+        {
+            VK_LOG_DEBUG("Model::packTextureArrays :: %zu images packed into %zu image arrays", packedCount, m_textureArrays.size());
+        }
+        return true;
+    }
+
+    void GLTFModel::buildMaterialPermutations() noexcept
+    {
+        // feature bits from what each material actually uses
+        m_materialPermutations.clear();
+        for (auto& material : m_materials)
+        {
+            material.mFeatures = (material.mBaseColorTex         ? kMaterialBaseColorMap         : 0u) |
+                                 (material.mMetallicRoughnessTex ? kMaterialMetallicRoughnessMap : 0u) |
+                                 (material.mNormalTex            ? kMaterialNormalMap            : 0u) |
+                                 (material.mOcclusionTex         ? kMaterialOcclusionMap         : 0u) |
+                                 (material.mEmissiveTex          ? kMaterialEmissiveMap          : 0u) |
+                                 (material.mAlphaMode == GLTFAlphaMode::kMask  ? kMaterialAlphaMask  : 0u) |
+                                 (material.mAlphaMode == GLTFAlphaMode::kBlend ? kMaterialAlphaBlend : 0u) |
+                                 (material.mIsDoubleSided        ? kMaterialDoubleSided          : 0u) |
+                                 (material.mIsOcclusionPacked    ? kMaterialPackedOcclusion      : 0u);
+            m_materialPermutations.push_back(material.mFeatures);
+        }
+
+        // distinct sets in ascending order; materials refer to theirs by index
+        std::sort(m_materialPermutations.begin(), m_materialPermutations.end());
+        m_materialPermutations.erase(std::unique(m_materialPermutations.begin(), m_materialPermutations.end()), m_materialPermutations.end());
+        for (auto& material : m_materials)
+        {
+            const auto it = std::lower_bound(m_materialPermutations.begin(), m_materialPermutations.end(), material.mFeatures);
+            material.mPermutation = static_cast<uint32_t>(it - m_materialPermutations.begin());
+        }
+
+        VK_LOG_DEBUG("GLTFModel::buildMaterialPermutations :: %zu permutations over %zu materials", m_materialPermutations.size(), m_materials.size());
+    }
+
+    bool GLTFModel::createMaterialBuffer(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept
+    {
+        // skip if the model has no materials
+        if (m_materials.empty())
+        {
+            return true;
+        }
+
+        // one record per material, read by the bindless fragment shader
+        auto getSlot = [](const std::optional<uint32_t>& texture) noexcept -> int32_t
+        {
+            return texture.has_value() ? static_cast<int32_t>(texture.value()) : -1;
+        };
+
+        std::vector<BindlessMaterial> records;
+        records.reserve(m_materials.size());
+        for (const auto& material : m_materials)
+        {
+            BindlessMaterial record{};
+            record.baseColor     = material.mBaseColor;
+            record.pbrFactors    = glm::vec4(material.mMetallic, material.mRoughness, material.mSpecular, 0.0f);
+            record.emissiveColor = glm::vec4(material.mEmissive, material.mOcclusion);
+            record.textures      = glm::ivec4(getSlot(material.mBaseColorTex), getSlot(material.mMetallicRoughnessTex), 
+                                              getSlot(material.mNormalTex), getSlot(material.mOcclusionTex));
+            record.extraTextures = glm::ivec4(getSlot(material.mEmissiveTex), material.mIsOcclusionPacked ? 1 : 0, -1, -1);
+            records.emplace_back(record);
+        }
+
+        // create device-local material table
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.size = sizeof(BindlessMaterial) * records.size();
+
+        if (!m_materialBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, records.data(), bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createMaterialBuffer :: failed to create device-local buffer for material data");
+            return false;
+        }
+        return true;
+    }
+
+    bool GLTFModel::createDrawBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept
+    {
+        // clear previous data
+        m_drawBatches.clear();
+        resetPartitionRevisions();
+        m_drawCount = 0;
+        m_repeatedDrawCount = 0;
+        m_isMultiDrawEnabled = device.getEnabledFeatures().multiDrawIndirect == VK_TRUE;
+
+        // skip if the default scene has nothing to draw
+        if (m_drawItems.empty())
+        {
+            return true;
+        }
+
+        // one record per draw item of the flattened default scene
+        std::vector<DrawData> draws;
+        std::vector<int32_t> drawMaterials;
+        std::vector<uint8_t> drawSkinned;
+        draws.reserve(m_drawItems.size());
+        drawMaterials.reserve(m_drawItems.size());
+        drawSkinned.reserve(m_drawItems.size());
+        for (const auto& item : m_drawItems)
+        {
+            // sphere around the world-space box of this primitive
+            DrawData draw{};
+            draw.mModel          = m_nodeWorldTransforms[item.mNode] * item.mDequantize;
+            draw.mBoundingSphere = glm::vec4(item.mWorldBounds.getCenter(), glm::length(item.mWorldBounds.getExtent()));
+            draw.mDrawInfo       = glm::uvec4(m_geometryRange.mFirstIndex + item.mFirstIndex, item.mIndexCount, 0u, 0u);
+            draw.mDrawOffsets    = glm::ivec4(getVertexOffset(item.mIsSkinned, item.mBaseVertex), 0, 0, 0);
+            draws.emplace_back(draw);
+            drawMaterials.emplace_back(item.mMaterialIndex);
+            drawSkinned.emplace_back(item.mIsSkinned ? 1 : 0);
+        }
+
+        // sort draws by vertex pool, then material, so each batch is a contiguous command range
+        std::vector<uint32_t> order(draws.size());
+        for (uint32_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) 
+        { 
+            return drawSkinned[a] != drawSkinned[b] ? drawSkinned[a] < drawSkinned[b] : drawMaterials[a] < drawMaterials[b]; 
+        });
+
+        std::vector<DrawData> sortedDraws;
+        std::vector<VkDrawIndexedIndirectCommand> commands;
+        sortedDraws.reserve(draws.size());
+        commands.reserve(draws.size() * 2);
+
+        for (uint32_t drawIdx = 0; drawIdx < order.size(); ++drawIdx)
+        {
+            // open a new batch on material or vertex pool change
+            const int32_t materialIndex = drawMaterials[order[drawIdx]];
+            const bool isSkinned = drawSkinned[order[drawIdx]] != 0;
+            if (m_drawBatches.empty() || m_drawBatches.back().mMaterialIndex != materialIndex || m_drawBatches.back().mIsSkinned != isSkinned)
+            {
+                m_drawBatches.push_back({ materialIndex, drawIdx, 0, isSkinned });
+            }
+
+            DrawBatch& batch = m_drawBatches.back();
+            batch.mCommandCount++;
+
+            DrawData draw = draws[order[drawIdx]];
+            draw.mDrawInfo.z = batch.mFirstCommand;
+            draw.mDrawInfo.w = static_cast<uint32_t>(m_drawBatches.size() - 1);
+            sortedDraws.emplace_back(draw);
+
+            // initial commands draw everything, so the buffers are usable before any culling runs
+            VkDrawIndexedIndirectCommand command{};
+            command.indexCount    = draw.mDrawInfo.y;
+            command.instanceCount = 1;
+            command.firstIndex    = draw.mDrawInfo.x;
+            command.vertexOffset  = draw.mDrawOffsets.x;
+            command.firstInstance = drawIdx;
+            commands.emplace_back(command);
+        }
+
+        std::vector<uint32_t> drawCounts;
+        drawCounts.reserve(m_drawBatches.size() * 2);
+        for (const auto& batch : m_drawBatches)
+        {
+            drawCounts.emplace_back(batch.mCommandCount);
+        }
+
+        // second copy for the late occlusion phase: nothing drawn until a culling pass writes it
+        const size_t earlyCommandCount = commands.size();
+        for (size_t i = 0; i < earlyCommandCount; ++i)
+        {
+            VkDrawIndexedIndirectCommand command = commands[i];
+            command.instanceCount = 0;
+            commands.emplace_back(command);
+        }
+        drawCounts.resize(m_drawBatches.size() * 2, 0u);
+
+        // create device-local draw record buffer: culling input and instance-rate model matrices
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.size = sizeof(DrawData) * sortedDraws.size();
+
+        if (!m_drawDataBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, sortedDraws.data(), bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createDrawBuffers :: failed to create device-local buffer for draw data");
+            return false;
+        }
+
+        // create device-local indirect command buffer: written by the culling pass
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.size = sizeof(VkDrawIndexedIndirectCommand) * commands.size();
+
+        if (!m_indirectBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, commands.data(), bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createDrawBuffers :: failed to create device-local buffer for indirect commands");
+            return false;
+        }
+
+        // create device-local per-batch draw count buffer
+        bufferCreateInfo.size = sizeof(uint32_t) * drawCounts.size();
+
+        if (!m_drawCountBuffer.createDeviceLocal(device, stagingBelt, bufferCreateInfo, drawCounts.data(), bufferCreateInfo.size))
+        {
+            VK_LOG_ERROR("GLTFModel::createDrawBuffers :: failed to create device-local buffer for draw counts");
+            return false;
+        }
+
+        // per-frame instance transforms for instanced cpu-recorded draws, rewritten while recording
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bufferCreateInfo.size = sizeof(glm::mat4) * m_drawItems.size() * m_maxPlacements;
+        for (auto& instanceBuffer : m_instanceBuffers)
+        {
+            if (!instanceBuffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true, true))
+            {
+                VK_LOG_ERROR("GLTFModel::createDrawBuffers :: failed to create host-visible buffer for instance transforms");
+                return false;
+            }
+        }
+
+        // per-frame indirect commands of the instanced runs, at most one run per instance
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+        bufferCreateInfo.size = sizeof(VkDrawIndexedIndirectCommand) * m_drawItems.size() * m_maxPlacements;
+        for (auto& runCommandBuffer : m_runCommandBuffers)
+        {
+            if (!runCommandBuffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true, true))
+            {
+                VK_LOG_ERROR("GLTFModel::createDrawBuffers :: failed to create host-visible buffer for run commands");
+                return false;
+            }
+        }
+
+        // per-object records of the bindless path: one region of every draw item per frame in flight
+        m_objectCapacity = std::max(1u, static_cast<uint32_t>(m_drawItems.size()) * m_maxPlacements);
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bufferCreateInfo.size = sizeof(ObjectData) * m_objectCapacity * kMaxFramesInFlight;
+        if (!m_objectBuffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true, true))
+        {
+            VK_LOG_ERROR("GLTFModel::createDrawBuffers :: failed to create host-visible buffer for object data");
+            return false;
+        }
+
+        // draw items that repeat an earlier item's primitive and material (the draws instancing saves)
+        std::vector<uint64_t> instanceKeys;
+        instanceKeys.reserve(m_drawItems.size());
+        for (const auto& item : m_drawItems)
+        {
+            instanceKeys.push_back((static_cast<uint64_t>(item.mPrimitive) << 32) | static_cast<uint32_t>(item.mMaterialIndex));
+        }
+        std::sort(instanceKeys.begin(), instanceKeys.end());
+        m_repeatedDrawCount = static_cast<uint32_t>(instanceKeys.size() - static_cast<size_t>(std::unique(instanceKeys.begin(), instanceKeys.end()) - instanceKeys.begin()));
+
+        m_drawCount = static_cast<uint32_t>(sortedDraws.size());
+        resetPartitionRevisions();
+        VK_LOG_DEBUG("GLTFModel::createDrawBuffers :: draw buffers created (draws:%u, batches:%zu, repeated:%u)", m_drawCount, m_drawBatches.size(), m_repeatedDrawCount);
+        return true;
+    }
+
+    bool GLTFModel::writeBakedModel(const std::filesystem::path& filepath, const ModelCacheKey& key) const noexcept
+    {
+        // sections follow the order readBakedModel consumes them
+        const BakeData& bake = *m_bakeData;
+        ModelCacheWriter writer;
+
+        // mesh pools in their final gpu layout, as compressed streams; meshlet descriptors stay raw
+        const size_t vertexStride = m_vertexFormat == VertexFormat::kPacked ? sizeof(PackedVertex) : sizeof(Vertex);
+        writer.write(m_vertexCount);
+        writer.write(m_indexCount);
+        writer.write(m_skinnedVertexCount);
+        writer.write(static_cast<uint32_t>(m_vertexFormat));
+        if (!writeVertexStream(writer, bake.mVertexData.data(), bake.mVertexData.size() / vertexStride, vertexStride) ||
+            !writeVertexStream(writer, bake.mSkinnedVertices.data(), bake.mSkinnedVertices.size(), sizeof(Vertex)) ||
+            !writeIndexStream(writer, bake.mIndices) ||
+            !writeVertexStream(writer, bake.mSkinVertices.data(), bake.mSkinVertices.size(), sizeof(SkinVertex)))
+        {
+            VK_LOG_WARN("GLTFModel::writeBakedModel :: failed to encode geometry for %s", filepath.string().c_str());
+            return false;
+        }
+        writer.writeArray(bake.mMeshlets);
+        if (!writeIndexStream(writer, bake.mMeshletVertices) ||
+            !writeVertexStream(writer, bake.mMeshletTriangles.data(), bake.mMeshletTriangles.size(), sizeof(uint32_t)))
+        {
+            VK_LOG_WARN("GLTFModel::writeBakedModel :: failed to encode meshlets for %s", filepath.string().c_str());
+            return false;
+        }
+
+        // sparse morph deltas and the weights of every target as loaded
+        writer.writeArray(bake.mMorphRanges);
+        writer.writeArray(bake.mMorphDeltas);
+        writer.writeArray(m_morphWeights);
+
+        // flattened default scene; world transforms and bounds are resolved again on load
+        writer.writeArray(m_nodeParents);
+        writer.writeArray(m_nodeFlatIndices);
+        writer.writeArray(m_nodeTranslations);
+        writer.writeArray(m_nodeRotations);
+        writer.writeArray(m_nodeScales);
+        writer.writeArray(m_nodeLocalTransforms);
+        writer.writeArray(m_nodeSubtreeEnds);
+        writer.writeArray(m_nodeDrawRanges);
+        writer.writeArray(m_drawItems);
+
+        // skins, with joints already in flattened indices
+        writer.write(static_cast<uint32_t>(m_skins.size()));
+        for (const auto& skin : m_skins)
+        {
+            writer.writeString(skin.mName);
+            writer.writeArray(skin.mJoints);
+            writer.writeArray(skin.mInverseBindMatrices);
+            writer.write(skin.mMeshNode);
+            writer.write(skin.mJointOffset);
+        }
+        writer.write(static_cast<uint32_t>(m_jointMatrices.size()));
 
-        // precompute total vertex and index counts
-        for (const auto& mesh : model.meshes)
+        // animations
+        writer.write(static_cast<uint32_t>(m_animations.size()));
+        for (const auto& animation : m_animations)
         {
-            for (const auto& primitive : mesh.primitives)
+            writer.writeString(animation.mName);
+            writer.write(animation.mStart);
+            writer.write(animation.mEnd);
+            writer.write(static_cast<uint32_t>(animation.mSamplers.size()));
+            for (const auto& sampler : animation.mSamplers)
             {
-                // skip invalid primitive
-                if (primitive.attributes.find("POSITION") == primitive.attributes.end() || primitive.indices < 0)
-                    continue;
+                writer.write(sampler.mInterpolation);
+                writer.write(sampler.mWidth);
+                writer.writeArray(sampler.mInputs);
+                writer.writeArray(sampler.mOutputs);
+            }
+            writer.writeArray(animation.mChannels);
+        }
+
+        // decoded textures with their full mip chains
+        writer.write(static_cast<uint32_t>(bake.mTextures.size()));
+        for (size_t i = 0; i < bake.mTextures.size(); ++i)
+        {
+            const TextureData& texture = bake.mTextures[i];
+            writer.writeString(texture.mName);
+            writer.write(bake.mTextureFormats[i]);
+            writer.write(texture.mChannels);
+            writer.writeArray(texture.mMipExtents);
+            writer.writeArray(texture.mMipOffsets);
+            writer.writeArray(texture.mPixels);
+        }
 
-                const auto& posAccessor  = model.accessors.at(primitive.attributes.at("POSITION"));
-                const auto& indexAccessor = model.accessors.at(primitive.indices);
+        // materials; absent textures are stored as -1
+        auto writeTextureIndex = [&writer](const std::optional<uint32_t>& index) noexcept
+        {
+            writer.write(index ? static_cast<int32_t>(index.value()) : -1);
+        };
 
-                // update counts
-                m_vertexCount += static_cast<uint32_t>(posAccessor.count);
-                m_indexCount  += static_cast<uint32_t>(indexAccessor.count);
-            }
+        writer.write(static_cast<uint32_t>(m_materials.size()));
+        for (const auto& material : m_materials)
+        {
+            writer.write(material.mBaseColor);
+            writer.write(material.mMetallic);
+            writer.write(material.mRoughness);
+            writer.write(material.mSpecular);
+            writer.write(material.mEmissive);
+            writer.write(material.mOcclusion);
+            writeTextureIndex(material.mBaseColorTex);
+            writeTextureIndex(material.mMetallicRoughnessTex);
+            writeTextureIndex(material.mNormalTex);
+            writeTextureIndex(material.mOcclusionTex);
+            writeTextureIndex(material.mEmissiveTex);
+            writer.write(material.mAlphaCutoff);
+            writer.write(static_cast<uint32_t>((material.mAlphaMode == GLTFAlphaMode::kMask ? 1u : 0u) | (material.mIsDoubleSided ? 2u : 0u) | 
+                                               (material.mIsOcclusionPacked ? 4u : 0u) | (material.mAlphaMode == GLTFAlphaMode::kBlend ? 8u : 0u)));
         }
+        writer.writeArray(m_textureSamplers);
+
+        return writer.save(filepath, key);
+    }
 
-        // aggregated vertex/index data from all meshes
-        std::vector<Vertex> vertices;
-        std::vector<uint32_t> indices;
-        bool hasTangents = false;
+    bool GLTFModel::readBakedModel(ModelCacheReader& reader, BakedView& baked) noexcept
+    {
+        // mesh pools: compressed streams decoded block by block across the model's pool, then staged from storage
+        uint32_t vertexFormat = 0;
+        if (!reader.read(m_vertexCount) || !reader.read(m_indexCount) || !reader.read(m_skinnedVertexCount) || !reader.read(vertexFormat) ||
+            vertexFormat > static_cast<uint32_t>(VertexFormat::kPacked))
+        {
+            return false;
+        }
+        m_vertexFormat = static_cast<VertexFormat>(vertexFormat);
 
-        // pre-allocate vectors
-        m_meshes.reserve(model.meshes.size());
-        vertices.reserve(m_vertexCount);
-        indices.reserve(m_indexCount);
+        if (!m_threadPool)
+        {
+            m_threadPool = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()), kReservedFrameWorkers, "model");
+        }
 
-        // process meshes and their primitives
-        uint32_t vertexOffset = 0;
-        uint32_t indexOffset = 0;
+        ThreadPool* threadPool = m_threadPool.get();
+        const size_t vertexStride = m_vertexFormat == VertexFormat::kPacked ? sizeof(PackedVertex) : sizeof(Vertex);
+        if (!readVertexStream(reader, baked.mVertexStorage, vertexStride, threadPool) ||
+            !readVertexStream(reader, baked.mSkinnedVertexStorage, sizeof(Vertex), threadPool) ||
+            !readIndexStream(reader, baked.mIndexStorage, threadPool) ||
+            !readVertexStream(reader, baked.mSkinVertexStorage, sizeof(SkinVertex), threadPool) ||
+            !reader.readView(baked.mMeshlets, baked.mMeshletCount) ||
+            !readIndexStream(reader, baked.mMeshletVertexStorage, threadPool) ||
+            !readVertexStream(reader, baked.mMeshletTriangleStorage, sizeof(uint32_t), threadPool))
+        {
+            return false;
+        }
 
-        for (const auto& gltfMesh : model.meshes)
+        baked.mVertexData           = baked.mVertexStorage.data();
+        baked.mVertexDataSize       = baked.mVertexStorage.size();
+        baked.mSkinnedVertices      = baked.mSkinnedVertexStorage.data();
+        baked.mSkinnedVertexCount   = baked.mSkinnedVertexStorage.size();
+        baked.mIndices              = baked.mIndexStorage.data();
+        baked.mIndexCount           = baked.mIndexStorage.size();
+        baked.mSkinVertices         = baked.mSkinVertexStorage.data();
+        baked.mSkinVertexCount      = baked.mSkinVertexStorage.size();
+        baked.mMeshletVertices      = baked.mMeshletVertexStorage.data();
+        baked.mMeshletVertexCount   = baked.mMeshletVertexStorage.size();
+        baked.mMeshletTriangles     = baked.mMeshletTriangleStorage.data();
+        baked.mMeshletTriangleCount = baked.mMeshletTriangleStorage.size();
+        if (baked.mSkinnedVertexCount != m_skinnedVertexCount || (baked.mSkinVertexCount != 0 && baked.mSkinVertexCount != baked.mSkinnedVertexCount))
         {
-            Mesh mesh{};
-            mesh.mName = gltfMesh.name;
-            mesh.mPrimitives.reserve(gltfMesh.primitives.size());
+            return false;
+        }
 
-            for (const auto& gltfPrimitive : gltfMesh.primitives)
+        // meshlets stay inside their arrays and index the static pool
+        const size_t staticVertexCount = baked.mVertexDataSize / (m_vertexFormat == VertexFormat::kPacked ? sizeof(PackedVertex) : sizeof(Vertex));
+        for (size_t i = 0; i < baked.mMeshletCount; ++i)
+        {
+            const glm::uvec4& info = baked.mMeshlets[i].mInfo;
+            if (info.z > kMeshletMaxVertices || info.w > kMeshletMaxTriangles || info.x > baked.mMeshletVertexCount || 
+                info.z > baked.mMeshletVertexCount - info.x || info.y > baked.mMeshletTriangleCount || info.w > baked.mMeshletTriangleCount - info.y)
             {
-                // skip if position is missing
-                const auto& attributes = gltfPrimitive.attributes;
-                if (attributes.find("POSITION") == attributes.end() || gltfPrimitive.indices < 0)
+                return false;
+            }
+
+            for (uint32_t t = 0; t < info.w; ++t)
+            {
+                const uint32_t packed = baked.mMeshletTriangles[info.y + t];
+                if ((packed & 0xFFu) >= info.z || ((packed >> 8) & 0xFFu) >= info.z || ((packed >> 16) & 0xFFu) >= info.z)
                 {
-                    VK_LOG_DEBUG("GLTFModel::loadMeshes : primitive skipped; position or indices missing in mesh: %s", gltfMesh.name.c_str());
-                    continue;
+                    return false;
                 }
+            }
+        }
+
+        for (size_t i = 0; i < baked.mMeshletVertexCount; ++i)
+        {
+            if (baked.mMeshletVertices[i] >= staticVertexCount)
+            {
+                return false;
+            }
+        }
+
+        // morph runs cover the skinned pool and stay inside the deltas, whose targets index the weights
+        if (!reader.readView(baked.mMorphRanges, baked.mMorphRangeCount) || !reader.readView(baked.mMorphDeltas, baked.mMorphDeltaCount) ||
+            !reader.readArray(m_morphWeights) || (baked.mMorphRangeCount != 0 && baked.mMorphRangeCount != m_skinnedVertexCount))
+        {
+            return false;
+        }
 
-                // pointers to vertex attribute data for current primitive
-                const float* positionBuffer = nullptr;
-                const float* normalBuffer   = nullptr;
-                const float* uvBuffer       = nullptr;
-                const float* tangentBuffer  = nullptr;
+        for (size_t i = 0; i < baked.mMorphRangeCount; ++i)
+        {
+            const glm::uvec2& range = baked.mMorphRanges[i];
+            if (range.x > baked.mMorphDeltaCount || range.y > baked.mMorphDeltaCount - range.x)
+            {
+                return false;
+            }
+        }
 
-                // stride in floats for interleaved attributes
-                size_t vertexCount    = 0;
-                size_t positionStride = 0;
-                size_t normalStride   = 0;
-                size_t uvStride       = 0;
-                size_t tangentStride  = 0;
+        for (size_t i = 0; i < baked.mMorphDeltaCount; ++i)
+        {
+            if (baked.mMorphDeltas[i].mTarget >= m_morphWeights.size())
+            {
+                return false;
+            }
+        }
 
-                // position 
-                if (const auto& itr = attributes.find("POSITION"); itr != attributes.end())
-                {
-                    const auto& accessor = model.accessors.at(itr->second);
-                    const auto& view     = model.bufferViews[accessor.bufferView];
-                    positionBuffer       = reinterpret_cast<const float*>(&model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]);
-                    positionStride       = view.byteStride ? view.byteStride / sizeof(float) : 3;
-                    vertexCount          = accessor.count;
-                }
+        // flattened default scene
+        if (!reader.readArray(m_nodeParents) || !reader.readArray(m_nodeFlatIndices) || !reader.readArray(m_nodeTranslations) ||
+            !reader.readArray(m_nodeRotations) || !reader.readArray(m_nodeScales) || !reader.readArray(m_nodeLocalTransforms) ||
+            !reader.readArray(m_nodeSubtreeEnds) || !reader.readArray(m_nodeDrawRanges) || !reader.readArray(m_drawItems))
+        {
+            return false;
+        }
+
+        // every per-node array shares one index, and parents precede children
+        const size_t nodeCount = m_nodeParents.size();
+        if (m_nodeTranslations.size() != nodeCount || m_nodeRotations.size() != nodeCount || m_nodeScales.size() != nodeCount ||
+            m_nodeLocalTransforms.size() != nodeCount || m_nodeSubtreeEnds.size() != nodeCount || m_nodeDrawRanges.size() != nodeCount)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            const glm::uvec2& range = m_nodeDrawRanges[i];
+            if (m_nodeParents[i] >= static_cast<int32_t>(i) || m_nodeSubtreeEnds[i] <= i || m_nodeSubtreeEnds[i] > nodeCount ||
+                range.x > m_drawItems.size() || range.y > m_drawItems.size() - range.x)
+            {
+                return false;
+            }
+        }
+
+        for (const auto& item : m_drawItems)
+        {
+            if (item.mNode >= nodeCount || item.mFirstIndex > baked.mIndexCount || item.mIndexCount > baked.mIndexCount - item.mFirstIndex ||
+                item.mLodCount > kMaxLodCount || item.mFirstMeshlet > baked.mMeshletCount || item.mMeshletCount > baked.mMeshletCount - item.mFirstMeshlet)
+            {
+                return false;
+            }
 
-                // normal
-                if (const auto& itr = attributes.find("NORMAL"); itr != attributes.end())
+            for (uint32_t lod = 0; lod < item.mLodCount; ++lod)
+            {
+                if (item.mLods[lod].mFirstIndex > baked.mIndexCount || item.mLods[lod].mIndexCount > baked.mIndexCount - item.mLods[lod].mFirstIndex)
                 {
-                    const auto& accessor = model.accessors.at(itr->second);
-                    const auto& view     = model.bufferViews[accessor.bufferView];
-                    normalBuffer         = reinterpret_cast<const float*>(&model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]);
-                    normalStride         = view.byteStride ? view.byteStride / sizeof(float) : 3;
+                    return false;
                 }
+            }
+        }
+
+        // simplified levels follow the full-detail indices
+        if (baked.mIndexCount < m_indexCount)
+        {
+            return false;
+        }
+        m_lodIndexCount = static_cast<uint32_t>(baked.mIndexCount - m_indexCount);
+
+        // skins
+        uint32_t skinCount = 0;
+        uint32_t jointCount = 0;
+        if (!reader.read(skinCount))
+        {
+            return false;
+        }
+
+        m_skins.clear();
+        m_skins.resize(skinCount);
+        for (auto& skin : m_skins)
+        {
+            if (!reader.readString(skin.mName) || !reader.readArray(skin.mJoints) || !reader.readArray(skin.mInverseBindMatrices) ||
+                !reader.read(skin.mMeshNode) || !reader.read(skin.mJointOffset) ||
+                skin.mInverseBindMatrices.size() != skin.mJoints.size() || skin.mMeshNode >= nodeCount)
+            {
+                return false;
+            }
 
-                // texcoords
-                if (const auto& itr = attributes.find("TEXCOORD_0"); itr != attributes.end())
+            for (const uint32_t joint : skin.mJoints)
+            {
+                if (joint >= nodeCount)
                 {
-                    const auto& accessor = model.accessors.at(itr->second);
-                    const auto& view     = model.bufferViews[accessor.bufferView];
-                    uvBuffer             = reinterpret_cast<const float*>(&model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]);
-                    uvStride             = view.byteStride ? view.byteStride / sizeof(float) : 2;
+                    return false;
                 }
+            }
+        }
+
+        if (!reader.read(jointCount))
+        {
+            return false;
+        }
+
+        for (const auto& skin : m_skins)
+        {
+            if (skin.mJointOffset > jointCount || skin.mJoints.size() > jointCount - skin.mJointOffset)
+            {
+                return false;
+            }
+        }
+
+        // animations
+        uint32_t animationCount = 0;
+        if (!reader.read(animationCount))
+        {
+            return false;
+        }
+
+        m_animations.clear();
+        m_animations.resize(animationCount);
+        for (auto& animation : m_animations)
+        {
+            uint32_t samplerCount = 0;
+            if (!reader.readString(animation.mName) || !reader.read(animation.mStart) || !reader.read(animation.mEnd) || !reader.read(samplerCount))
+            {
+                return false;
+            }
 
-                // tangent
-                if (const auto& itr = attributes.find("TANGENT"); itr != attributes.end())
+            animation.mSamplers.resize(samplerCount);
+            for (auto& sampler : animation.mSamplers)
+            {
+                if (!reader.read(sampler.mInterpolation) || !reader.read(sampler.mWidth) || !reader.readArray(sampler.mInputs) || 
+                    !reader.readArray(sampler.mOutputs))
                 {
-                    const auto& accessor = model.accessors.at(itr->second);
-                    const auto& view     = model.bufferViews[accessor.bufferView];
-                    tangentBuffer        = reinterpret_cast<const float*>(&model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]);
-                    tangentStride        = view.byteStride ? view.byteStride / sizeof(float) : 4;
-                    hasTangents          = true;
+                    return false;
                 }
 
-                // append vertex data for current primitive
-                for (size_t i = 0; i < vertexCount; i++)
+                const size_t keysPerInput = sampler.mInterpolation == AnimationSampler::Interpolation::kCubicSpline ? 3 : 1;
+                if (sampler.mInterpolation > AnimationSampler::Interpolation::kCubicSpline || sampler.mWidth == 0 ||
+                    sampler.mOutputs.size() != sampler.mInputs.size() * keysPerInput * sampler.mWidth)
                 {
-                    Vertex vertex{};
-                    vertex.mPosition = glm::vec4(glm::make_vec3(&positionBuffer[i * positionStride]), 1.0f);
-                    vertex.mNormal   = normalBuffer  ? glm::make_vec3(&normalBuffer[i * normalStride])    : glm::vec3(0.0f);
-                    vertex.mUV       = uvBuffer      ? glm::make_vec2(&uvBuffer[i * uvStride])            : glm::vec2(0.0f);
-                    vertex.mTangent  = tangentBuffer ? glm::make_vec4(&tangentBuffer[i * tangentStride])  : glm::vec4(0.0f);
-                    vertices.emplace_back(std::move(vertex));
+                    return false;
                 }
+            }
 
-                // indices
-                const auto& indexAccessor = model.accessors[gltfPrimitive.indices];
-                const auto& indexView     = model.bufferViews[indexAccessor.bufferView];
-                const auto& indexBuffer   = model.buffers[indexView.buffer].data;
-                const void* dataPtr       = &indexBuffer[indexAccessor.byteOffset + indexView.byteOffset];
+            if (!reader.readArray(animation.mChannels))
+            {
+                return false;
+            }
 
-                // append index data for current primitive
-                switch (indexAccessor.componentType)
+            for (const auto& channel : animation.mChannels)
+            {
+                if (channel.mNode >= nodeCount || channel.mSampler >= animation.mSamplers.size() || channel.mPath > AnimationChannel::Path::kWeights)
                 {
-                    case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT: 
-                    {
-                        const uint32_t* buffer = static_cast<const uint32_t*>(dataPtr);
-                        for (size_t i = 0; i < indexAccessor.count; i++)
-                            indices.emplace_back(buffer[i] + vertexOffset);
-                        break;
-                    }
-                    case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT: 
-                    {
-                        const uint16_t* buffer = static_cast<const uint16_t*>(dataPtr);
-                        for (size_t i = 0; i < indexAccessor.count; i++)
-                            indices.emplace_back(static_cast<uint32_t>(buffer[i]) + vertexOffset);
-                        break;
-                    }
-                    case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE: 
-                    {
-                        const uint8_t* buffer = static_cast<const uint8_t*>(dataPtr);
-                        for (size_t i = 0; i < indexAccessor.count; i++)
-                            indices.emplace_back(static_cast<uint32_t>(buffer[i]) + vertexOffset);
-                        break;
-                    }
-                    default:
-                        VK_LOG_WARN("GLTFModel::loadMeshes : unsupported index component type");
-                        break;
+                    return false;
                 }
 
-                // append primitive info for current mesh
-                Primitive primitive{};
-                primitive.mFirstIndex = indexOffset;
-                primitive.mIndexCount = static_cast<uint32_t>(indexAccessor.count);
-                primitive.mMaterialIndex = (gltfPrimitive.material >= 0) ? gltfPrimitive.material : -1;
-                mesh.mPrimitives.emplace_back(std::move(primitive));
-
-                // update offsets for next primitive
-                vertexOffset += static_cast<uint32_t>(vertexCount);
-                indexOffset += static_cast<uint32_t>(indexAccessor.count);
+                if (channel.mPath == AnimationChannel::Path::kWeights && 
+                    (channel.mFirstWeight > m_morphWeights.size() || channel.mWeightCount > m_morphWeights.size() - channel.mFirstWeight ||
+                     animation.mSamplers[channel.mSampler].mWidth * 4 < channel.mWeightCount))
+                {
+                    return false;
+                }
             }
-            m_meshes.emplace_back(std::move(mesh));
         }
 
-        if (!hasTangents)
+        // textures: pixels stay in the mapping until the belt stages them
+        uint32_t textureCount = 0;
+        if (!reader.read(textureCount))
         {
-            generateTangents(vertices, indices);
+            return false;
         }
 
-        // create device-local vertex buffer: positions, normals, uvs, tangents
-        VkBufferCreateInfo bufferCreateInfo{};
-        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferCreateInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        bufferCreateInfo.size = sizeof(Vertex) * vertices.size();
+        baked.mTextures.resize(textureCount);
+        baked.mTextureFormats.resize(textureCount);
+        baked.mTextureNames.resize(textureCount);
+        for (uint32_t i = 0; i < textureCount; ++i)
+        {
+            TextureDataView& texture = baked.mTextures[i];
+            size_t extentCount = 0;
+            size_t offsetCount = 0;
+            size_t pixelCount  = 0;
+            if (!reader.readString(baked.mTextureNames[i]) || !reader.read(baked.mTextureFormats[i]) || !reader.read(texture.mChannels) ||
+                !reader.readView(texture.mMipExtents, extentCount) || !reader.readView(texture.mMipOffsets, offsetCount) ||
+                !reader.readView(texture.mPixels, pixelCount))
+            {
+                return false;
+            }
+
+            // images no material samples are stored empty
+            if (extentCount == 0 && offsetCount == 0 && pixelCount == 0)
+            {
+                texture.mName = baked.mTextureNames[i].c_str();
+                continue;
+            }
+
+            // every mip level must lie inside the pixel blob
+            if (extentCount == 0 || extentCount != offsetCount || pixelCount == 0)
+            {
+                return false;
+            }
+
+            for (size_t level = 0; level < extentCount; ++level)
+            {
+                const VkExtent2D& extent = texture.mMipExtents[level];
+                const VkDeviceSize levelSize = Texture::getLevelSize(baked.mTextureFormats[i], extent.width, extent.height, texture.mChannels);
+                if (texture.mMipOffsets[level] > pixelCount || levelSize > pixelCount - texture.mMipOffsets[level])
+                {
+                    return false;
+                }
+            }
+
+            // the stored format is the one uploaded last time; upload re-checks device support for it
+            texture.mSize      = pixelCount;
+            texture.mMipLevels = static_cast<uint32_t>(extentCount);
+            texture.mFormat    = baked.mTextureFormats[i];
+            texture.mName      = baked.mTextureNames[i].c_str();
+        }
 
-        if (!m_vertexBuffer.createDeviceLocal(device, commandPool, bufferCreateInfo, vertices.data(), bufferCreateInfo.size))
+        // materials
+        uint32_t materialCount = 0;
+        if (!reader.read(materialCount))
         {
-            VK_LOG_ERROR("GLTFModel::loadMeshes :: failed to create device-local buffer for vertex data");
             return false;
         }
 
-        // create device-local index buffer: triangle indices
-        bufferCreateInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        bufferCreateInfo.size = sizeof(uint32_t) * indices.size();
+        auto readTextureIndex = [&](std::optional<uint32_t>& index) noexcept -> bool
+        {
+            int32_t value = -1;
+            if (!reader.read(value) || value >= static_cast<int32_t>(textureCount))
+            {
+                return false;
+            }
+
+            index = value >= 0 ? std::optional<uint32_t>(static_cast<uint32_t>(value)) : std::nullopt;
+            return true;
+        };
+
+        m_materials.clear();
+        m_materials.resize(materialCount);
+        for (auto& material : m_materials)
+        {
+            if (!reader.read(material.mBaseColor) || !reader.read(material.mMetallic) || !reader.read(material.mRoughness) ||
+                !reader.read(material.mSpecular) || !reader.read(material.mEmissive) || !reader.read(material.mOcclusion) ||
+                !readTextureIndex(material.mBaseColorTex) || !readTextureIndex(material.mMetallicRoughnessTex) ||
+                !readTextureIndex(material.mNormalTex) || !readTextureIndex(material.mOcclusionTex) || !readTextureIndex(material.mEmissiveTex))
+            {
+                return false;
+            }
+
+            uint32_t alphaFlags = 0;
+            if (!reader.read(material.mAlphaCutoff) || !reader.read(alphaFlags))
+            {
+                return false;
+            }
+            material.mAlphaMode     = (alphaFlags & 1u) ? GLTFAlphaMode::kMask : ((alphaFlags & 8u) ? GLTFAlphaMode::kBlend : GLTFAlphaMode::kOpaque);
+            material.mIsDoubleSided = (alphaFlags & 2u) != 0;
+            material.mIsOcclusionPacked = (alphaFlags & 4u) != 0;
+            material.mDescriptorSet = VK_NULL_HANDLE;
+            material.mSpareDescriptorSet = VK_NULL_HANDLE;
+            material.mDescriptorSwapFrame = 0;
+            material.mIsDescriptorStale = false;
+        }
+        buildMaterialPermutations();
 
-        if (!m_indexBuffer.createDeviceLocal(device, commandPool, bufferCreateInfo, indices.data(), bufferCreateInfo.size))
+        // per-texture sampler state
+        if (!reader.readArray(m_textureSamplers) || m_textureSamplers.size() != textureCount)
         {
-            VK_LOG_ERROR("GLTFModel::loadMeshes :: failed to create device-local buffer for index data");
             return false;
         }
 
-        VK_LOG_DEBUG("GLTFModel::loadMeshes :: meshes uploaded to device buffer successfully (vertices:%u, indices:%u)", m_vertexCount, m_indexCount);
+        for (const auto& item : m_drawItems)
+        {
+            if (item.mMaterialIndex < 0 || item.mMaterialIndex >= static_cast<int32_t>(materialCount))
+            {
+                return false;
+            }
+        }
+
+        // load-time gltf structures are not needed once the hierarchy is flat
+        m_meshes.clear();
+        m_nodes.clear();
+        m_scenes.clear();
+        m_activeAnimation = 0;
+        m_animationTime = 0.0f;
+
+        // resolve transforms, bounds and joint matrices from the baked locals
+        m_nodeWorldTransforms.assign(nodeCount, glm::mat4(1.0f));
+        m_nodeBounds.assign(nodeCount, BoundingBox{});
+        m_jointMatrices.assign(jointCount, glm::mat4(1.0f));
+        updateWorldTransforms();
+        updateBounds();
+        updateJointMatrices();
         return true;
     }
 
-    bool GLTFModel::loadSceneGraph(const tinygltf::Model& model) noexcept
+    bool GLTFModel::uploadBakedModel(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const BakedView& baked, bool waitForCompletion) noexcept
     {
-        // clear previous data
-        m_nodes.clear();
-        m_scenes.clear();
+        // the belt copies straight out of the mapped pages into the staging ring
+        if (!createMeshBuffers(device, stagingBelt, baked.mVertexData, baked.mVertexDataSize, 
+                               baked.mSkinnedVertices, baked.mSkinnedVertexCount, baked.mIndices, baked.mIndexCount))
+        {
+            return false;
+        }
 
-        // pre-allocate vectors
-        m_nodes.reserve(model.nodes.size());
-        m_scenes.reserve(model.scenes.size());
+        if (baked.mSkinVertexCount > 0 && !createSkinBuffers(device, stagingBelt, baked.mSkinVertices, baked.mSkinVertexCount))
+        {
+            return false;
+        }
 
-        // load all nodes
-        for (size_t i = 0; i < model.nodes.size(); i++)
+        if (!createMorphBuffers(device, stagingBelt, baked.mMorphRanges, baked.mMorphRangeCount, baked.mMorphDeltas, baked.mMorphDeltaCount))
         {
-            const auto& gltfNode = model.nodes[i];
-            Node node{};
-            node.mName       = gltfNode.name;
-            node.mMeshIndex  = gltfNode.mesh >= 0 ? gltfNode.mesh : -1;
-            node.mChildren   = gltfNode.children;
+            return false;
+        }
 
-            // compute local transform
-            if (!gltfNode.matrix.empty())
-            {
-                node.mLocalTransform = glm::make_mat4(gltfNode.matrix.data());
-            }
-            else 
-            {
-                glm::vec3 translation(0.0f);
-                glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
-                glm::vec3 scale(1.0f);
+        m_meshletCount = 0;
+        if (baked.mMeshletCount > 0 && !createMeshletBuffers(device, stagingBelt, baked.mMeshlets, baked.mMeshletCount, baked.mMeshletVertices, 
+                                                             baked.mMeshletVertexCount, baked.mMeshletTriangles, baked.mMeshletTriangleCount))
+        {
+            return false;
+        }
 
-                if (!gltfNode.translation.empty())
+        // textures are already decoded with their mip chains; streamed ones are copied out of the mapping
+        m_textures.clear();
+        m_sharedTextures.clear();
+        m_textureArrays.clear();
+        m_textureLayers.clear();
+        m_textures.reserve(baked.mTextures.size());
+        for (size_t i = 0; i < baked.mTextures.size(); ++i)
+        {
+            const TextureDataView& view = baked.mTextures[i];
+            Texture texture;
+            if (m_textureStreamer && view.mMipLevels > 1)
+            {
+                TextureData textureData{};
+                textureData.mPixels.assign(view.mPixels, view.mPixels + view.mSize);
+                textureData.mMipExtents.assign(view.mMipExtents, view.mMipExtents + view.mMipLevels);
+                textureData.mMipOffsets.assign(view.mMipOffsets, view.mMipOffsets + view.mMipLevels);
+                textureData.mChannels = view.mChannels;
+                textureData.mFormat   = view.mFormat;
+                textureData.mName     = view.mName;
+                if (!m_textureStreamer->add(device, stagingBelt, static_cast<uint32_t>(i), std::move(textureData), baked.mTextureFormats[i], texture))
                 {
-                    translation = glm::vec3(static_cast<float>(gltfNode.translation[0]),
-                                            static_cast<float>(gltfNode.translation[1]),
-                                            static_cast<float>(gltfNode.translation[2]));
+                    VK_LOG_ERROR("GLTFModel::uploadBakedModel :: failed to upload texture: %s", view.mName);
+                    return false;
                 }
+            }
+            else if (view.mMipLevels != 0 && !texture.upload(device, stagingBelt, view, baked.mTextureFormats[i]))
+            {
+                VK_LOG_ERROR("GLTFModel::uploadBakedModel :: failed to upload texture: %s", view.mName);
+                return false;
+            }
+            m_textures.emplace(std::move(texture));
+        }
 
-                if (!gltfNode.rotation.empty())
-                {
-                    rotation = glm::quat(static_cast<float>(gltfNode.rotation[3]),
-                                         static_cast<float>(gltfNode.rotation[0]),
-                                         static_cast<float>(gltfNode.rotation[1]),
-                                         static_cast<float>(gltfNode.rotation[2]));
-                }
-                
-                if (!gltfNode.scale.empty())
-                {
-                    scale = glm::vec3(static_cast<float>(gltfNode.scale[0]),
-                                      static_cast<float>(gltfNode.scale[1]),
-                                      static_cast<float>(gltfNode.scale[2]));
-                }
+        if (!createDrawBuffers(device, stagingBelt))
+        {
+            VK_LOG_ERROR("GLTFModel::uploadBakedModel :: failed to create draw buffers");
+            return false;
+        }
 
-                node.mLocalTransform = glm::translate(glm::mat4(1.0f), translation) *
-                                       glm::mat4_cast(rotation) * 
-                                       glm::scale(glm::mat4(1.0f), scale);
-            }
+        if (!createMaterialBuffer(device, stagingBelt))
+        {
+            VK_LOG_ERROR("GLTFModel::uploadBakedModel :: failed to create material buffer");
+            return false;
+        }
 
-            m_nodes.emplace_back(std::move(node));
+        // submit while the mapping is still alive
+        if (!stagingBelt.flush(waitForCompletion))
+        {
+            VK_LOG_ERROR("GLTFModel::uploadBakedModel :: failed to flush staged uploads");
+            return false;
         }
 
-        // link child nodes to their parent for scene hierarchy
-        for (size_t parentIdx = 0; parentIdx < m_nodes.size(); parentIdx++)
+        VK_LOG_DEBUG("GLTFModel::uploadBakedModel :: baked model uploaded (vertices:%u, indices:%zu, textures:%zu)", 
+                     m_vertexCount, baked.mIndexCount, m_textures.size());
+        return true;
+    }
+
+    std::vector<uint32_t> GLTFModel::optimizePrimitive(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t firstVertex, 
+                                                       uint32_t vertexCount, uint32_t firstIndex, uint32_t indexCount, bool isSkinned) noexcept
+    {
+        // work on primitive-local indices; skip if any index is out of range (no remap)
+        uint32_t* localIndices = indices.data() + firstIndex;
+        for (size_t i = 0; i < indexCount; ++i)
         {
-            for (size_t childIdx : m_nodes[parentIdx].mChildren)
+            localIndices[i] -= firstVertex;
+            if (localIndices[i] >= vertexCount)
             {
-                if (childIdx >= 0 && childIdx < static_cast<int>(m_nodes.size()))
+                VK_LOG_WARN("GLTFModel::optimizePrimitive :: index out of range, primitive left unoptimized");
+                for (size_t j = 0; j <= i; ++j)
                 {
-                    m_nodes[childIdx].mParentIndex = static_cast<int32_t>(parentIdx);
+                    localIndices[j] += firstVertex;
                 }
+                return {};
             }
         }
 
-        // track scene root nodes
-        for (const auto& gltfScene : model.scenes)
+        std::vector<glm::vec3> positions(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
         {
-            Scene scene{};
-            scene.mName       = gltfScene.name;
-            scene.mRootNodes  = gltfScene.nodes;
+            positions[v] = glm::vec3(vertices[firstVertex + v].mPosition);
+        }
 
-            m_scenes.emplace_back(std::move(scene));
-            VK_LOG_DEBUG("GLTFModel::loadSceneGraph :: scene loaded: '%s'", gltfScene.name.c_str());
+        mesh_optimizer::optimizeVertexCache(localIndices, indexCount, vertexCount);
+        mesh_optimizer::optimizeOverdraw(localIndices, indexCount, positions);
+        std::vector<uint32_t> remap = mesh_optimizer::optimizeVertexFetch(localIndices, indexCount, vertexCount);
+
+        // skin influences stay aligned with the skinned pool
+        mesh_optimizer::remapVertices(vertices.data() + firstVertex, vertexCount, remap);
+        if (isSkinned)
+        {
+            mesh_optimizer::remapVertices(m_skinVertices.data() + firstVertex, vertexCount, remap);
         }
 
-        // recursive lambda to compute world transforms for a node and its children
-        std::function<void(int, const glm::mat4&)> computeWorldTransform;
-        computeWorldTransform = [this, &computeWorldTransform](int nodeIdx, const glm::mat4& parentTransform)
+        for (size_t i = 0; i < indexCount; ++i)
         {
-            // validate node index
-            if (nodeIdx < 0 || nodeIdx >= static_cast<int>(m_nodes.size())) 
-                return;
+            localIndices[i] += firstVertex;
+        }
+        return remap;
+    }
 
-            // compute world transform
-            Node& node = m_nodes[nodeIdx];
-            node.mWorldTransform = parentTransform * node.mLocalTransform;
+    void GLTFModel::generatePrimitiveLods(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, Primitive& primitive) noexcept
+    {
+        // small primitives cost too little to be worth simplifying
+        primitive.mLodCount = 0;
+        if (primitive.mIndexCount < kMinLodIndices || primitive.mIndexCount % 3 != 0)
+        {
+            return;
+        }
 
-            // recursively update children
-            for (int childIdx : node.mChildren)
+        // work on primitive-local indices over the primitive's own positions
+        std::vector<uint32_t> source(indices.begin() + primitive.mFirstIndex, indices.begin() + primitive.mFirstIndex + primitive.mIndexCount);
+        for (auto& index : source)
+        {
+            index -= primitive.mFirstVertex;
+            if (index >= primitive.mVertexCount)
             {
-                computeWorldTransform(childIdx, node.mWorldTransform);
+                VK_LOG_WARN("GLTFModel::generatePrimitiveLods :: index out of range, primitive left without lods");
+                return;
             }
-        };
+        }
+
+        std::vector<glm::vec3> positions(primitive.mVertexCount);
+        for (uint32_t v = 0; v < primitive.mVertexCount; ++v)
+        {
+            positions[v] = glm::vec3(vertices[primitive.mFirstVertex + v].mPosition);
+        }
 
-        // compute world transforms for all scenes
-        for (const auto& scene : m_scenes)
+        // each level simplifies the previous one, so its error bound adds up along the chain
+        const float maxError = glm::length(primitive.mBounds.mMax - primitive.mBounds.mMin) * kMaxLodError;
+        float chainError = 0.0f;
+        while (primitive.mLodCount < kMaxLodCount && source.size() >= kMinLodIndices)
         {
-            for (int rootIdx : scene.mRootNodes)
+            const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(source.size()) * kLodReduction) / 3 * 3;
+            float error = 0.0f;
+            std::vector<uint32_t> simplified = mesh_optimizer::simplify(source.data(), source.size(), positions, targetIndexCount, maxError, error);
+            if (simplified.empty() || static_cast<float>(simplified.size()) > static_cast<float>(source.size()) * kMinLodReduction)
             {
-                computeWorldTransform(rootIdx, glm::mat4(1.0f));
+                break;
+            }
+            mesh_optimizer::optimizeVertexCache(simplified.data(), simplified.size(), positions.size());
+
+            chainError += error;
+            PrimitiveLod& lod = primitive.mLods[primitive.mLodCount++];
+            lod.mFirstIndex = static_cast<uint32_t>(indices.size());
+            lod.mIndexCount = static_cast<uint32_t>(simplified.size());
+            lod.mError      = chainError;
+            for (const uint32_t index : simplified)
+            {
+                indices.push_back(index + primitive.mFirstVertex);
             }
-        }
 
-        VK_LOG_DEBUG("GLTFModel::loadSceneGraph :: loaded %zu nodes across %zu scenes", m_nodes.size(), m_scenes.size());
-        return true;
+            m_lodIndexCount += lod.mIndexCount;
+            source = std::move(simplified);
+        }
     }
 
-    bool GLTFModel::loadTextures(const tinygltf::Model& model, const VulkanDevice& device, const VulkanCommandPool& commandPool) noexcept
+    uint32_t GLTFModel::selectLod(const DrawItem& item, const glm::vec3& viewPosition) const noexcept
     {
-        // clear previous data
-        m_textures.clear();
-        m_textures.reserve(model.images.size());
-
-        // prepare an array of VkFormat per image defaulting to UNORM
-        std::vector<VkFormat> textureFormats(model.images.size(), VK_FORMAT_R8G8B8A8_UNORM);
-
-        // assign sRGB to color textures based on materials
-        for (const auto& gltfMaterial : model.materials)
+        if (item.mLodCount == 0 || m_lodProjectionScale <= 0.0f || !item.mWorldBounds.isValid())
         {
-            auto setFormat = [&](int textureIndex, bool isColor)
-            {
-                if (textureIndex < 0 || textureIndex >= static_cast<int>(model.textures.size()))
-                    return;
-
-                int imageIndex = model.textures[textureIndex].source;
-                if (imageIndex < 0 || imageIndex >= static_cast<int>(textureFormats.size()))
-                    return;
-
-                if (isColor)
-                {
-                    textureFormats[imageIndex] = VK_FORMAT_R8G8B8A8_SRGB;
-                }
-                else if (textureFormats[imageIndex] != VK_FORMAT_R8G8B8A8_SRGB)
-                {
-                    textureFormats[imageIndex] = VK_FORMAT_R8G8B8A8_UNORM;
-                }
-            };
+            return 0;
+        }
 
-            setFormat(gltfMaterial.pbrMetallicRoughness.baseColorTexture.index, true);
-            setFormat(gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index, false);
-            setFormat(gltfMaterial.normalTexture.index, false);
-            setFormat(gltfMaterial.occlusionTexture.index, false);
-            setFormat(gltfMaterial.emissiveTexture.index, true);
+        // the local error grows with the node's largest axis scale and is projected at the nearest point of the bounds
+        const glm::mat4& worldTransform = m_nodeWorldTransforms[item.mNode];
+        const float scale = std::max({ glm::length(glm::vec3(worldTransform[0])), glm::length(glm::vec3(worldTransform[1])), 
+                                       glm::length(glm::vec3(worldTransform[2])) });
+        const glm::vec3 closestPoint = glm::clamp(viewPosition, item.mWorldBounds.mMin, item.mWorldBounds.mMax);
+        const float distance = std::max(glm::length(closestPoint - viewPosition), 1e-3f);
+        const float pixelsPerUnit = scale * m_lodProjectionScale / distance;
+
+        // coarsest level still within the threshold
+        uint32_t lod = 0;
+        while (lod < item.mLodCount && item.mLods[lod].mError * pixelsPerUnit <= m_lodPixelError)
+        {
+            ++lod;
         }
+        return lod;
+    }
 
-        // lambda to decide if mipmaps should be generated
-        auto shouldGenerateMipmaps = [](const tinygltf::Image& image) noexcept -> bool 
+    glm::mat4 GLTFModel::packVertices(const std::vector<Vertex>& vertices, const Primitive& primitive, std::vector<PackedVertex>& packedVertices) noexcept
+    {
+        // quantization box; degenerate axes keep a unit size so the matrix stays invertible
+        const glm::vec3 offset = primitive.mBounds.isValid() ? primitive.mBounds.mMin : glm::vec3(0.0f);
+        glm::vec3 size = primitive.mBounds.isValid() ? primitive.mBounds.mMax - primitive.mBounds.mMin : glm::vec3(1.0f);
+        for (int axis = 0; axis < 3; ++axis)
         {
-            std::string name = image.name.empty() ? image.uri : image.name;
-            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            size[axis] = size[axis] > 0.0f ? size[axis] : 1.0f;
+        }
 
-            // skip mipmaps for normal maps; generate for all others
-            return name.find("normal") == std::string::npos;
+        // directions pre-scaled by the box, re-normalized for snorm storage
+        auto encodeDirection = [&size](const glm::vec3& direction) noexcept
+        {
+            const glm::vec3 scaled = size * direction;
+            const float length = glm::length(scaled);
+            return length > 0.0f ? scaled / length : glm::vec3(0.0f, 0.0f, 1.0f);
         };
 
-        // load each glTF image as a vulkan texture
-        for (size_t i = 0; i < model.images.size(); ++i)
+        for (uint32_t v = primitive.mFirstVertex; v < primitive.mFirstVertex + primitive.mVertexCount; ++v)
         {
-            const auto& gltfImage = model.images[i];
-            VkFormat& format = textureFormats[i];
+            const Vertex& vertex = vertices[v];
+            PackedVertex& packed = packedVertices[v];
 
-            Texture texture;
-            if (!texture.load(device, commandPool, gltfImage, format, shouldGenerateMipmaps(gltfImage)))
+            const glm::vec3 position = glm::clamp((glm::vec3(vertex.mPosition) - offset) / size, 0.0f, 1.0f);
+            const glm::vec3 normal   = encodeDirection(vertex.mNormal);
+            const glm::vec3 tangent  = encodeDirection(glm::vec3(vertex.mTangent));
+            for (int c = 0; c < 3; ++c)
             {
-                VK_LOG_ERROR("Model::loadTextures :: failed to load texture: %s", gltfImage.uri.c_str());
-                return false;
+                packed.mPosition[c] = static_cast<uint16_t>(std::lround(position[c] * 65535.0f));
+                packed.mNormal[c]   = static_cast<int16_t>(std::lround(normal[c] * 32767.0f));
+                packed.mTangent[c]  = static_cast<int8_t>(std::lround(tangent[c] * 127.0f));
             }
-
-            m_textures.emplace_back(std::move(texture));
+            packed.mPosition[3] = 65535;
+            packed.mNormal[3]   = 0;
+            packed.mTangent[3]  = vertex.mTangent.w < 0.0f ? -127 : 127;
+            packed.mUV          = glm::packHalf2x16(vertex.mUV);
         }
 
-        VK_LOG_DEBUG("Model::loadTextures :: textures loaded successfully : %zu", m_textures.size());
-        return true;
+        return glm::translate(glm::mat4(1.0f), offset) * glm::scale(glm::mat4(1.0f), size);
     }
 
-    bool GLTFModel::loadMaterials(const tinygltf::Model& model) noexcept
+    void GLTFModel::buildPrimitiveMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, Primitive& primitive, 
+                                           std::vector<MeshletData>& meshlets, std::vector<uint32_t>& meshletVertices, 
+                                           std::vector<uint32_t>& meshletTriangles) const noexcept
     {
-        // clear previous data
-        m_materials.clear();
-        m_materials.reserve(model.materials.size());
-
-        for (const auto& gltfMaterial : model.materials)
+        // the skinned pool moves every frame, so its primitives keep the vertex pipeline
+        if (primitive.mIsSkinned || primitive.mIndexCount == 0 || primitive.mIndexCount % 3 != 0)
         {
-            Material material{};
-
-            // ─────────────────────────────────────────
-            // base material properties
-            // ─────────────────────────────────────────
-            material.mBaseColor = glm::vec4(1.0f);
-            material.mMetallic  = static_cast<float>(gltfMaterial.pbrMetallicRoughness.metallicFactor);
-            material.mRoughness = static_cast<float>(gltfMaterial.pbrMetallicRoughness.roughnessFactor);
-            material.mSpecular  = 1.0f; // KHR_materials_specular
-            material.mEmissive = glm::vec3(0.0f);
-
-            if (gltfMaterial.pbrMetallicRoughness.baseColorFactor.size() == 4)
-            {
-                const auto& baseColor = gltfMaterial.pbrMetallicRoughness.baseColorFactor;
-                material.mBaseColor = glm::vec4(baseColor[0], baseColor[1], baseColor[2], baseColor[3]);
-            }
-
-            if (gltfMaterial.emissiveFactor.size() == 3)
-            {
-                const auto& emissiveColor = gltfMaterial.emissiveFactor;
-                material.mEmissive = glm::vec3(emissiveColor[0], emissiveColor[1], emissiveColor[2]);
-            }
-
-            // ─────────────────────────────────────────
-            // texture indices
-            // ─────────────────────────────────────────
-            auto getTextureIndex = [&](int index) -> std::optional<uint32_t> 
-            {
-                if (index < 0 || index >= static_cast<int>(model.textures.size()))
-                    return std::nullopt;
-
-                int imageIndex = model.textures[index].source;
-                if (imageIndex < 0 || imageIndex >= m_textures.size())
-                    return std::nullopt;
+            return;
+        }
 
-                return imageIndex;
-            };
+        // positions in the space the pushed model matrix maps from, so the task stage tests bounds without dequantizing
+        const glm::mat4 quantize = glm::inverse(primitive.mDequantize);
+        std::vector<glm::vec3> positions(primitive.mVertexCount);
+        for (uint32_t i = 0; i < primitive.mVertexCount; ++i)
+        {
+            positions[i] = glm::vec3(quantize * vertices[primitive.mFirstVertex + i].mPosition);
+        }
 
-            material.mBaseColorTex          = getTextureIndex(gltfMaterial.pbrMetallicRoughness.baseColorTexture.index);
-            material.mMetallicRoughnessTex  = getTextureIndex(gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index);
-            material.mNormalTex             = getTextureIndex(gltfMaterial.normalTexture.index);
-            material.mOcclusionTex          = getTextureIndex(gltfMaterial.occlusionTexture.index);
-            material.mEmissiveTex           = getTextureIndex(gltfMaterial.emissiveTexture.index);
+        std::vector<uint32_t> localIndices(indices.begin() + primitive.mFirstIndex, indices.begin() + primitive.mFirstIndex + primitive.mIndexCount);
+        for (uint32_t& index : localIndices)
+        {
+            index -= primitive.mFirstVertex;
+        }
 
-            // descriptor set creation is deferred
-            material.mDescriptorSet = VK_NULL_HANDLE;
-            m_materials.emplace_back(std::move(material));
+        // meshlet vertices index the static pool like the index buffer does
+        const size_t firstMeshletVertex = meshletVertices.size();
+        const std::vector<mesh_optimizer::Meshlet> built = mesh_optimizer::buildMeshlets(localIndices.data(), localIndices.size(), positions, 
+                                                                                        kMeshletMaxVertices, kMeshletMaxTriangles, 
+                                                                                        meshletVertices, meshletTriangles);
+        for (size_t i = firstMeshletVertex; i < meshletVertices.size(); ++i)
+        {
+            meshletVertices[i] += primitive.mFirstVertex;
         }
 
-        VK_LOG_DEBUG("GLTFModel::loadMaterials :: materials loaded successfullt: %zu", m_materials.size());
-        return true;
+        for (const auto& meshlet : built)
+        {
+            MeshletData data{};
+            data.mBoundingSphere = glm::vec4(meshlet.mCenter, meshlet.mRadius);
+            data.mCone           = glm::vec4(meshlet.mConeAxis, meshlet.mConeCutoff);
+            data.mConeApex       = glm::vec4(meshlet.mConeApex, 0.0f);
+            data.mInfo           = glm::uvec4(meshlet.mVertexOffset, meshlet.mTriangleOffset, meshlet.mVertexCount, meshlet.mTriangleCount);
+            meshlets.push_back(data);
+        }
+        primitive.mMeshletCount = static_cast<uint32_t>(built.size());
     }
 
-    void GLTFModel::generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) noexcept
+    void GLTFModel::generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t firstVertex, uint32_t vertexCount,
+                                     uint32_t firstIndex, uint32_t indexCount) noexcept
     {
-        std::vector<glm::vec3> tan1(vertices.size(), glm::vec3(0.0f));
-        std::vector<glm::vec3> tan2(vertices.size(), glm::vec3(0.0f));
-
-        for (size_t i = 0; i < indices.size(); i += 3)
+        // follows mikktspace's per-vertex construction: each corner contributes its face's uv tangent projected onto the
+        // vertex normal's plane and normalized, weighted by the corner angle; the bitangent sign comes from the same sums
+        std::vector<glm::vec3> tangents(vertexCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> bitangents(vertexCount, glm::vec3(0.0f));
+        const auto getNormal = [&](uint32_t vertex)
         {
-            uint32_t i0 = indices[i];
-            uint32_t i1 = indices[i + 1];
-            uint32_t i2 = indices[i + 2];
-
-            glm::vec3 v0 = glm::vec3(vertices[i0].mPosition);
-            glm::vec3 v1 = glm::vec3(vertices[i1].mPosition);
-            glm::vec3 v2 = glm::vec3(vertices[i2].mPosition);
-
-            glm::vec2 w0 = vertices[i0].mUV;
-            glm::vec2 w1 = vertices[i1].mUV;
-            glm::vec2 w2 = vertices[i2].mUV;
+            const glm::vec3& normal = vertices[vertex].mNormal;
+            const float length = glm::length(normal);
+            return length > 1e-12f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+        };
 
-            glm::vec3 edge1 = v1 - v0;
-            glm::vec3 edge2 = v2 - v0;
+        const uint32_t endIndex = std::min(firstIndex + indexCount, static_cast<uint32_t>(indices.size()));
+        for (uint32_t i = firstIndex; i + 2 < endIndex; i += 3)
+        {
+            const uint32_t corners[3] = { indices[i], indices[i + 1], indices[i + 2] };
+            if (corners[0] - firstVertex >= vertexCount || corners[1] - firstVertex >= vertexCount || corners[2] - firstVertex >= vertexCount)
+            {
+                continue;
+            }
 
-            glm::vec2 deltaUV1 = w1 - w0;
-            glm::vec2 deltaUV2 = w2 - w0;
+            const glm::vec3 positions[3] = { glm::vec3(vertices[corners[0]].mPosition), glm::vec3(vertices[corners[1]].mPosition),
+                                             glm::vec3(vertices[corners[2]].mPosition) };
+            const glm::vec2 deltaUV1 = vertices[corners[1]].mUV - vertices[corners[0]].mUV;
+            const glm::vec2 deltaUV2 = vertices[corners[2]].mUV - vertices[corners[0]].mUV;
+            const glm::vec3 edge1 = positions[1] - positions[0];
+            const glm::vec3 edge2 = positions[2] - positions[0];
 
-            float r = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
-            if (fabs(r) < 1e-6f) {
-                // degenerate UV, skip this triangle's tangent calculation
+            // degenerate uv mapping: the triangle defines no tangent frame
+            const float r = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+            if (std::fabs(r) < 1e-12f)
+            {
                 continue;
             }
-            float f = 1.0f / r;
-
-            glm::vec3 sdir = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
-            glm::vec3 tdir = f * (-deltaUV2.x * edge1 + deltaUV1.x * edge2);
 
-            tan1[i0] += sdir;
-            tan1[i1] += sdir;
-            tan1[i2] += sdir;
+            // the sign of r flips with mirrored uvs, which is what the handedness records
+            const glm::vec3 faceTangent   = (deltaUV2.y * edge1 - deltaUV1.y * edge2) / r;
+            const glm::vec3 faceBitangent = (deltaUV1.x * edge2 - deltaUV2.x * edge1) / r;
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                // corner angle between the two edges leaving it
+                const glm::vec3 toNext = positions[(c + 1) % 3] - positions[c];
+                const glm::vec3 toPrevious = positions[(c + 2) % 3] - positions[c];
+                const float edgeLengths = glm::length(toNext) * glm::length(toPrevious);
+                if (edgeLengths <= 1e-20f)
+                {
+                    continue;
+                }
+                const float angle = std::acos(glm::clamp(glm::dot(toNext, toPrevious) / edgeLengths, -1.0f, 1.0f));
 
-            tan2[i0] += tdir;
-            tan2[i1] += tdir;
-            tan2[i2] += tdir;
+                const glm::vec3 normal = getNormal(corners[c]);
+                const glm::vec3 projected = faceTangent - normal * glm::dot(normal, faceTangent);
+                const float projectedLength = glm::length(projected);
+                if (projectedLength > 1e-12f)
+                {
+                    tangents[corners[c] - firstVertex] += angle * (projected / projectedLength);
+                }
+                bitangents[corners[c] - firstVertex] += angle * faceBitangent;
+            }
         }
 
-        for (size_t i = 0; i < vertices.size(); ++i)
+        for (uint32_t v = 0; v < vertexCount; ++v)
         {
-            glm::vec3 n = glm::normalize(vertices[i].mNormal);
-            glm::vec3 t = tan1[i];
-            glm::vec3 tangent = glm::normalize(t - n * glm::dot(n, t));
+            // gram-schmidt against the normal; vertices without a uv frame get any perpendicular direction
+            const glm::vec3 normal = getNormal(firstVertex + v);
+            glm::vec3 tangent = tangents[v] - normal * glm::dot(normal, tangents[v]);
+            if (glm::length(tangent) <= 1e-12f)
+            {
+                const glm::vec3 axis = std::fabs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                tangent = glm::cross(axis, normal);
+            }
 
-            float handedness = (glm::dot(glm::cross(n, t), tan2[i]) < 0.0f) ? -1.0f : 1.0f;
-            vertices[i].mTangent = glm::vec4(tangent, handedness);
+            const float handedness = glm::dot(glm::cross(normal, tangent), bitangents[v]) < 0.0f ? -1.0f : 1.0f;
+            vertices[firstVertex + v].mTangent = glm::vec4(glm::normalize(tangent), handedness);
         }
     }
 
@@ -945,6 +6260,35 @@ namespace keplar
             VK_LOG_FATAL("GLTFModel::initSharedResources :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
         }
 
+        // one update template per combination of sampled maps, each entry reading its slot of MaterialDescriptorImages
+        static_assert((1u << kMaterialTextureCount) <= std::tuple_size_v<decltype(s_materialUpdateTemplates)>);
+        for (uint32_t mask = 1; mask < (1u << kMaterialTextureCount) && s_descriptorSetLayout != VK_NULL_HANDLE; ++mask)
+        {
+            std::vector<VkDescriptorUpdateTemplateEntry> entries;
+            for (uint32_t i = 0; i < kMaterialTextureCount; ++i)
+            {
+                if (mask & (1u << i))
+                {
+                    entries.push_back({ kBaseColorBinding + i, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 
+                                        i * sizeof(VkDescriptorImageInfo), sizeof(VkDescriptorImageInfo) });
+                }
+            }
+
+            VkDescriptorUpdateTemplateCreateInfo templateInfo{};
+            templateInfo.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+            templateInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+            templateInfo.pDescriptorUpdateEntries   = entries.data();
+            templateInfo.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+            templateInfo.descriptorSetLayout        = s_descriptorSetLayout;
+
+            vkResult = vkCreateDescriptorUpdateTemplate(vkDevice, &templateInfo, nullptr, &s_materialUpdateTemplates[mask]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("GLTFModel::initSharedResources :: vkCreateDescriptorUpdateTemplate failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                s_materialUpdateTemplates[mask] = VK_NULL_HANDLE;
+            }
+        }
+
         // ─────────────────────────────────────────────
         // push constant range: model + material data
         // ─────────────────────────────────────────────
@@ -952,28 +6296,180 @@ namespace keplar
         s_pushConstantRange.offset     = 0;
         s_pushConstantRange.size       = sizeof(PushConstants); 
 
+        // bindless cpu path: the first object record and the records per draw
+        s_objectPushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        s_objectPushConstantRange.offset     = 0;
+        s_objectPushConstantRange.size       = sizeof(ObjectPushConstants);
+    }
+
+    VkPipelineVertexInputStateCreateInfo GLTFModel::getVertexInputState(VertexFormat format) noexcept
+    {
+        return format == VertexFormat::kPacked ? VertexLayouts::Packed::getInputState() : VertexLayouts::Standard::getInputState();
+    }
+
+    VkPipelineVertexInputStateCreateInfo GLTFModel::getIndirectVertexInputState(VertexFormat format) noexcept
+    {
+        return format == VertexFormat::kPacked ? VertexLayouts::PackedIndirect::getInputState() : VertexLayouts::Indirect::getInputState();
+    }
+
+    VkPipelineVertexInputStateCreateInfo GLTFModel::getInstancedVertexInputState(VertexFormat format) noexcept
+    {
+        return format == VertexFormat::kPacked ? VertexLayouts::PackedInstanced::getInputState() : VertexLayouts::Instanced::getInputState();
+    }
+
+    VkPipelineVertexInputStateCreateInfo GLTFModel::getDepthVertexInputState(VertexFormat format) noexcept
+    {
+        return format == VertexFormat::kPacked ? VertexLayouts::PackedDepth::getInputState() : VertexLayouts::Depth::getInputState();
+    }
+
+    VkPipelineVertexInputStateCreateInfo GLTFModel::getPulledVertexInputState() noexcept
+    {
+        return VertexLayouts::Pulled::getInputState();
+    }
+
+    bool GLTFModel::initBindlessResources(const VulkanDevice& device) noexcept
+    {
+        // early exit if the bindless layout is already initialized
+        if (s_bindlessDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            return true;
+        }
+
+        // runtime-sized, partially bound arrays need descriptor indexing
+        if (!device.isDescriptorIndexingEnabled())
+        {
+            VK_LOG_INFO("GLTFModel::initBindlessResources :: descriptor indexing not enabled");
+            return false;
+        }
+
+        // the texture array is capped by the device's per-stage and per-set sampler limits
+        const VkPhysicalDeviceLimits& limits = device.getPhysicalDeviceProperties().limits;
+        s_maxBindlessTextures = std::min({ kMaxBindlessTextures, limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages,
+                                           limits.maxDescriptorSetSamplers, limits.maxDescriptorSetSampledImages });
+
         // ─────────────────────────────────────────────
-        // vertex input binding (single interleaved buffer)
+        // descriptor set layout bindings: the variable-count array must be the last binding
         // ─────────────────────────────────────────────
-        s_vertexBindings = 
-        {{
-            {0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX}
-        }};
+        std::array<VkDescriptorSetLayoutBinding, 3> descriptorBindings
+        {
+           {{kBindlessMaterialBinding,  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1,                     VK_SHADER_STAGE_FRAGMENT_BIT, nullptr},
+            {kBindlessObjectBinding,    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1,                     VK_SHADER_STAGE_VERTEX_BIT,   nullptr},
+            {kBindlessTextureBinding,   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, s_maxBindlessTextures, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr}}
+        };
+
+        const std::array<VkDescriptorBindingFlags, 3> bindingFlags
+        {
+            0,
+            0,
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT
+        };
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+        bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsInfo.pNext = nullptr;
+        bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+        bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext = &bindingFlagsInfo;
+        layoutInfo.flags = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(descriptorBindings.size());
+        layoutInfo.pBindings = descriptorBindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(device.getDevice(), &layoutInfo, nullptr, &s_bindlessDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GLTFModel::initBindlessResources :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            s_bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool GLTFModel::initMeshletResources(const VulkanDevice& device) noexcept
+    {
+        // early exit if the meshlet layout is already initialized
+        if (s_meshletDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            return true;
+        }
+
+        // task and mesh stages need VK_EXT_mesh_shader
+        if (!device.isMeshShaderEnabled())
+        {
+            VK_LOG_INFO("GLTFModel::initMeshletResources :: mesh shaders not enabled");
+            return false;
+        }
+
+        auto vkCmdDrawMeshTasksEXT = (PFN_vkCmdDrawMeshTasksEXT)vkGetDeviceProcAddr(device.getDevice(), "vkCmdDrawMeshTasksEXT");
+        if (!vkCmdDrawMeshTasksEXT)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get vkCmdDrawMeshTasksEXT function pointer");
+            return false;
+        }
 
         // ─────────────────────────────────────────────
-        // vertex input attributes
+        // descriptor set layout bindings: the task stage culls with the meshlet records, the mesh stage emits them
         // ─────────────────────────────────────────────
-        s_vertexAttributes = 
-        {{
-            {0, 0, VK_FORMAT_R32G32B32A32_SFLOAT,  offsetof(Vertex, mPosition)},  // position
-            {1, 0, VK_FORMAT_R32G32B32_SFLOAT,     offsetof(Vertex, mNormal)},    // normal
-            {2, 0, VK_FORMAT_R32G32_SFLOAT,        offsetof(Vertex, mUV)},        // uv
-            {3, 0, VK_FORMAT_R32G32B32A32_SFLOAT,  offsetof(Vertex, mTangent)}    // tangent
-        }};
+        std::array<VkDescriptorSetLayoutBinding, 4> descriptorBindings
+        {
+           {{kMeshletBinding,           VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT, nullptr},
+            {kMeshletVertexBinding,     VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, nullptr},
+            {kMeshletTriangleBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, nullptr},
+            {kMeshletVertexDataBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, nullptr}}
+        };
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext = nullptr;
+        layoutInfo.flags = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(descriptorBindings.size());
+        layoutInfo.pBindings = descriptorBindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(device.getDevice(), &layoutInfo, nullptr, &s_meshletDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GLTFModel::initMeshletResources :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            s_meshletDescriptorSetLayout = VK_NULL_HANDLE;
+            return false;
+        }
+
+        // the full push constants, with the meshlet range in materialInfo
+        s_meshletPushConstantRange.stageFlags = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        s_meshletPushConstantRange.offset     = 0;
+        s_meshletPushConstantRange.size       = sizeof(PushConstants);
+        s_vkCmdDrawMeshTasksEXT = vkCmdDrawMeshTasksEXT;
+        return true;
     }
 
     void GLTFModel::destroySharedResources(VkDevice vkDevice) noexcept
     {
+        // destroy meshlet descriptor set layout
+        if (s_meshletDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(vkDevice, s_meshletDescriptorSetLayout, nullptr);
+            s_meshletDescriptorSetLayout = VK_NULL_HANDLE;
+            s_vkCmdDrawMeshTasksEXT = nullptr;
+        }
+
+        // destroy bindless descriptor set layout
+        if (s_bindlessDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(vkDevice, s_bindlessDescriptorSetLayout, nullptr);
+            s_bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        // destroy material update templates
+        for (VkDescriptorUpdateTemplate& updateTemplate : s_materialUpdateTemplates)
+        {
+            if (updateTemplate != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorUpdateTemplate(vkDevice, updateTemplate, nullptr);
+                updateTemplate = VK_NULL_HANDLE;
+            }
+        }
+
         // destroy shared descriptor set layout
         if (s_descriptorSetLayout != VK_NULL_HANDLE)
         {
@@ -4,79 +4,660 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <optional>
+#include <algorithm>
+#include <filesystem>
 
 #include "asset_io.hpp"
 #include "math3d.hpp"
 
 #include "vulkan/vulkan_config.hpp"
 #include "vulkan/vulkan_buffer.hpp"
-#include "vulkan/vulkan_descriptor_pool.hpp"
+#include "vulkan/vulkan_descriptor_allocator.hpp"
 #include "vulkan/vulkan_samplers.hpp"
 #include "graphics/texture.hpp"
+#include "graphics/geometry_arena.hpp"
+#include "graphics/frustum_culling.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/async_task.hpp"
 
 namespace keplar
 {
+    // forward declarations
+    class AssetManager;
+    class TextureStreamer;
+    class MipGenerator;
+    class VulkanCommandRecorder;
+    class ModelCacheReader;
+    struct ModelCacheKey;
+
+    // static vertex layout: 52-byte float vertices, or 24-byte quantized ones read by the same shaders
+    enum class GLTFVertexFormat : uint8_t { kStandard, kPacked };
+
+    // material feature bits, the MATERIAL_FEATURES specialization constant of pbr.frag: maps a material samples,
+    // alpha mask (discard below the cutoff), alpha blend, double-sided (no culling, back faces flip the normal) and
+    // occlusion packed into the metallic roughness map
+    enum GLTFMaterialFeature : uint32_t
+    {
+        kMaterialBaseColorMap         = 1u << 0,
+        kMaterialMetallicRoughnessMap = 1u << 1,
+        kMaterialNormalMap            = 1u << 2,
+        kMaterialOcclusionMap         = 1u << 3,
+        kMaterialEmissiveMap          = 1u << 4,
+        kMaterialAlphaMask            = 1u << 5,
+        kMaterialDoubleSided          = 1u << 6,
+        kMaterialPackedOcclusion      = 1u << 7,    // occlusion read from the red channel of the metallic roughness map
+        kMaterialAlphaBlend           = 1u << 8,    // blended over the opaque scene: no depth writes, alpha output
+        kMaterialAllMaps              = 0x1Fu       // the shader's default: every map, opaque, single-sided
+    };
+
+    // material classes by gltf alphaMode, in the order draws are recorded: opaque first so they keep early depth testing
+    // undisturbed by discarding fragments, then alpha-masked, then blended back to front over both
+    enum class GLTFAlphaMode : uint8_t { kOpaque, kMask, kBlend };
+
+    // model load options
+    struct GLTFLoadConfig
+    {
+        GLTFVertexFormat mVertexFormat = GLTFVertexFormat::kStandard;
+        bool mOptimizeMeshes = false;       // reorder indices and vertices for cache, overdraw and fetch locality
+        bool mUseBakedCache = false;        // load from a .kmodel baked next to the source, writing it on first load
+        MipGenerator* mMipGenerator = nullptr;  // build rgba8 mip chains with batched compute instead of on the cpu (not while baking)
+        MipFilter mMipFilter = MipFilter::kBox; // cpu (and baked) mip chains; kKaiser is sharper and worth it when baking
+        bool mStreamTextures = false;       // upload only mip tails and stream the rest (see updateTextureStreaming); not while baking
+        bool mSparseTextures = false;       // streamed chains as partially resident images (TextureStreamerConfig::mUseSparseResidency)
+        uint32_t mTextureArrayMaxSize = 512;    // images up to this extent sharing format and mip chain become layers of one
+                                                // image array (0: every image on its own); not while baking or streaming
+        bool mGenerateLods = false;         // simplified index ranges per primitive, drawn by screen-space error (see setLodView)
+        bool mBuildMeshlets = false;        // split static primitives into meshlets for mesh shading (see recordMeshletDraws)
+        GeometryArena* mGeometryArena = nullptr;    // static vertices and indices go into its shared buffers when its stride
+                                                    // matches the layout and they fit; must outlive the model
+        uint32_t mMaxPlacements = 1;        // placements (see setPlacements) the instance and object buffers are sized for
+        AssetManager* mAssetManager = nullptr;  // external image files come from its shared textures (not while baking, streaming
+                                                // or loading asynchronously); must outlive the model
+    };
+
+    // where the last load of a model spent its time (milliseconds, see GLTFModel::getLoadTimings). stages are wall time on
+    // the loading thread; tangents, image decode and mip generation run across the model's workers and are summed thread
+    // time within the mesh and texture stages. stages a load skipped stay zero
+    struct GLTFLoadTimings
+    {
+        double   mParse         = 0.0;      // reading and parsing the file, or mapping and reading the baked cache
+        double   mMeshes        = 0.0;      // vertex decode and transcode, tangents, optimization and geometry staging
+        double   mTangents      = 0.0;
+        double   mSceneGraph    = 0.0;      // nodes, skins and animations
+        double   mTextures      = 0.0;      // image decode, cpu mip chains and texture staging
+        double   mImageDecode   = 0.0;
+        double   mMipGeneration = 0.0;
+        double   mMaterials     = 0.0;      // materials, draw buffers and the material buffer
+        double   mUpload        = 0.0;      // submitting the staged uploads (the baked cache's uploads included)
+        double   mBake          = 0.0;      // writing the baked cache
+        double   mTotal         = 0.0;
+        uint64_t mSourceBytes   = 0;        // bytes read: the model file, or the baked cache
+        bool     mIsFromCache   = false;
+    };
+
+    // one shadow caster captured by GLTFModel::gatherShadowCasters: a static draw of the position stream
+    struct ShadowCasterDraw
+    {
+        glm::mat4 mModel;               // model to world, the gather's transform included
+        uint32_t  mFirstIndex;
+        uint32_t  mIndexCount;
+        int32_t   mVertexOffset;
+        uint32_t  mIsDoubleSided;       // selects the double-sided pipeline
+    };
+
+    // triangles of one static opaque primitive (see GLTFModel::getRayTracingGeometries), read by a bottom-level
+    // acceleration structure build straight from the position stream and the index buffer
+    struct RayTracingGeometry
+    {
+        VkDeviceAddress mVertexAddress = 0;     // the primitive's first position
+        VkFormat        mVertexFormat = VK_FORMAT_UNDEFINED;    // unorm16 x4 (packed, see RayTracingInstance) or float x3
+        uint32_t        mVertexStride = 0;
+        uint32_t        mMaxVertex = 0;
+        VkDeviceAddress mIndexAddress = 0;      // the primitive's first index, relative to its first vertex
+        VkIndexType     mIndexType = VK_INDEX_TYPE_UINT32;
+        uint32_t        mTriangleCount = 0;     // 0: the primitive is skinned, alpha-masked or never drawn
+    };
+
+    // one placed draw of a geometry captured by GLTFModel::gatherRayTracingInstances
+    struct RayTracingInstance
+    {
+        glm::mat4 mTransform;               // geometry to world: the gather's transform, placement, node and dequantization
+        uint32_t  mGeometry;                // index into getRayTracingGeometries
+        uint32_t  mIsDoubleSided;
+    };
+
+    // progress of an asynchronous load (see GLTFModel::loadAsync); load goes straight to kResident or kFailed
+    enum class GLTFLoadState : uint8_t { kEmpty, kDecoding, kUploading, kResident, kFailed };
+
     class GLTFModel
     {
         public:
+            // per-frame buffers (skinning output, instance transforms); matches the samples' frames-in-flight cap
+            static constexpr uint32_t kMaxFramesInFlight = 3;
+            static constexpr uint32_t kMaxSkinningFrames = kMaxFramesInFlight;
+            static constexpr uint32_t kMaxLodCount = 3;     // simplified levels per primitive, after the full one
+            static constexpr uint32_t kMeshletMaxVertices   = 64;   // pbr_meshlet.mesh output limits
+            static constexpr uint32_t kMeshletMaxTriangles  = 124;
+            static constexpr uint32_t kMeshletsPerTaskGroup = 32;   // pbr_meshlet.task workgroup size
+            using VertexFormat = GLTFVertexFormat;
+
             // creation and destruction
             GLTFModel() noexcept;
             ~GLTFModel();
 
             // model lifecycle: load, render and update
-            bool load(const VulkanDevice& device, const VulkanCommandPool& commandPool, const std::string& filename) noexcept;
-            void render(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) noexcept;
+            // packed vertices fall back to the standard layout for models with skins
+            bool load(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filename, 
+                      const GLTFLoadConfig& config = {}) noexcept;
+            // asynchronous load: parsing and decoding (or reading the baked cache) run as one task on the model's thread pool,
+            // whose handle is returned at once and completes with them. pollLoad, once per frame from the thread recording
+            // uploads, then stages the decoded model into the belt (copies run on its transfer queue) without waiting for them,
+            // and reports kResident once they completed; finishLoad blocks for both instead. rgba8 chains are built on the cpu.
+            // until resident the model must be neither drawn nor updated; device and the config's mip generator and arena
+            // must outlive the load
+            TaskHandle loadAsync(const VulkanDevice& device, const std::string& filename, const GLTFLoadConfig& config = {}) noexcept;
+            GLTFLoadState pollLoad(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept;
+            bool finishLoad(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept;
+            GLTFLoadState getLoadState() const noexcept { return m_loadState; }
+            bool isResident() const noexcept { return m_loadState == GLTFLoadState::kResident; }
+            // stage timings of the last synchronous load, or of the decode of the last asynchronous one
+            const GLTFLoadTimings& getLoadTimings() const noexcept { return m_loadTimings; }
+            // frustum (in model space) skips nodes and primitives whose bounds are outside it; visible primitives are
+            // recorded sorted by vertex pool, material and front-to-back depth (along the frustum's near plane);
+            // frameIndex selects the skinned vertex buffer written by that frame's skinning pass
+            void render(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, const Frustum* frustum = nullptr) noexcept;
+            // render split for parallel recording: prepareDraws gathers, sorts and groups the visible draws into runs and
+            // writes their per-frame instance data (returns the run count); recordDraws then records a range of those runs
+            // and only reads model state, so disjoint ranges can be recorded concurrently into separate command buffers.
+            // transforms are captured by prepareDraws, so recording may also overlap update() of the next frame
+            // permutationPipelines (indexed like getMaterialPermutations, layouts compatible with pipelineLayout) are bound
+            // per run when given; otherwise every run draws with the pipeline bound by the caller. binds go through a
+            // VulkanCommandRecorder, so state repeated between runs is recorded once; the command buffer overloads use their own
+            uint32_t prepareDraws(uint32_t frameIndex, const Frustum* frustum = nullptr) noexcept;
+            void recordDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, uint32_t runCount,
+                             const VkPipeline* permutationPipelines = nullptr) const noexcept;
+            void recordDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, uint32_t runCount,
+                             const VkPipeline* permutationPipelines = nullptr) const noexcept;
+            // dynamic culling (extended dynamic state): permutation and depth pre-pass pipelines are built with
+            // VK_DYNAMIC_STATE_CULL_MODE, and recordDraws, recordMeshletDraws and recordDepthDraws set back-face culling per
+            // draw from the material's sidedness, so one pipeline serves single- and double-sided materials
+            void setDynamicCullModeEnabled(bool enabled) noexcept { m_isDynamicCullModeEnabled = enabled; }
+            bool isDynamicCullModeEnabled() const noexcept { return m_isDynamicCullModeEnabled; }
+            // instancing: runs of one mesh primitive and material become one draw with per-instance model matrices
+            // (frameIndex's instance buffer on the indirect binding). needs a pipeline built with getInstancedVertexInputState
+            void setInstancingEnabled(bool enabled) noexcept { m_isInstancingEnabled = enabled; }
+            bool isInstancingEnabled() const noexcept { return m_isInstancingEnabled; }
+            uint32_t getRepeatedDrawCount() const noexcept { return m_repeatedDrawCount; }
+            // instanced indirect draws: prepareDraws with instancing also writes each run's indexed indirect command into frameIndex's
+            // run command buffer, and recordIndirectDraws records a range of those runs like recordDraws, with consecutive runs of
+            // one material and vertex pool drawn by a single vkCmdDrawIndexedIndirect (one call per run without multiDrawIndirect).
+            // runs prepared without instancing are recorded by recordDraws instead
+            void recordIndirectDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                     uint32_t runCount, const VkPipeline* permutationPipelines = nullptr) const noexcept;
+            void recordIndirectDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                     uint32_t runCount, const VkPipeline* permutationPipelines = nullptr) const noexcept;
+            // placements: the cpu-recorded paths draw the model once per model-to-world transform, so several placements of
+            // one loaded asset (e.g. scene instances) share its buffers, textures and draws. while any are set, prepareDraws
+            // takes its frustum and setLodView's position in world space and culls, sorts and instances the draws of every
+            // placement together. at most GLTFLoadConfig::mMaxPlacements are kept; none draws the model once as loaded.
+            // the indirect path ignores placements
+            void setPlacements(const glm::mat4* transforms, uint32_t count) noexcept;
+            uint32_t getPlacementCount() const noexcept { return static_cast<uint32_t>(m_placements.size()); }
+            uint32_t getMaxPlacements() const noexcept { return m_maxPlacements; }
+            // union of the draw bounds in model space, as of the last update
+            BoundingBox getBounds() const noexcept;
+            // device memory of the model's buffers, arena range and own textures (shared textures are counted by their manager)
+            VkDeviceSize getMemorySize() const noexcept;
+            // advance the active animation; only animated subtrees have transforms and bounds recomputed
             void update(float dt) noexcept;
 
-            // descriptor management: allocation and updates
-            bool allocateDescriptorSets(VkDescriptorPool descriptorPool) noexcept;
+            // animation playback
+            void setActiveAnimation(uint32_t index) noexcept;
+            uint32_t getAnimationCount() const noexcept;
+            bool hasAnimations() const noexcept;
+
+            // gpu-driven rendering: one indirect draw per material batch over the culled command buffer.
+            // useDrawCount reads per-batch counts written by a compact GpuCulling pass (vkCmdDrawIndexedIndirectCount).
+            // the command and count buffers hold a second copy of the batch ranges for the late OcclusionCulling phase
+            void renderIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, bool useDrawCount,
+                                bool isLatePhase = false) noexcept;
+            // partitions: consecutive runs of kBatchesPerPartition batches (so of materials, in draw order), each recordable into
+            // its own cached command buffer. a partition's revision changes with what its recording binds: a material set swapped
+            // by texture streaming, the bindless set, or draw buffers rebuilt by a load. recordings made at an older revision are stale
+            static constexpr uint32_t kBatchesPerPartition = 16;
+            void renderIndirectPartition(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, bool useDrawCount,
+                                         uint32_t partition) noexcept;
+            uint32_t getIndirectPartitionCount() const noexcept { return static_cast<uint32_t>(m_partitionRevisions.size()); }
+            uint64_t getIndirectPartitionRevision(uint32_t partition) const noexcept { return m_partitionRevisions[partition]; }
+            // vertex pulling (buffer device address): renderIndirect binds no vertex pool and instead passes the pool's
+            // address in materialInfo.zw (y: 1 for the packed layout), fetched by pbr_pulled.vert. pipelines built with
+            // getPulledVertexInputState are then independent of the vertex format. needs the device feature before load
+            void setVertexPullingEnabled(bool enabled) noexcept { m_isVertexPullingEnabled = enabled && m_hasVertexAddresses; }
+            bool isVertexPullingEnabled() const noexcept { return m_isVertexPullingEnabled; }
+            VkBuffer getDrawDataBuffer() const noexcept { return m_drawDataBuffer.get(); }
+            VkBuffer getIndirectBuffer() const noexcept { return m_indirectBuffer.get(); }
+            VkBuffer getDrawCountBuffer() const noexcept { return m_drawCountBuffer.get(); }
+            uint32_t getDrawCount() const noexcept { return m_drawCount; }
+            uint32_t getDrawBatchCount() const noexcept;
+
+            // skinning: skinned primitives live in their own vertex pool, which a compute pass (GpuSkinning)
+            // transforms into per-frame vertex buffers. until enabled, skinned meshes draw in bind pose
+            bool hasSkins() const noexcept { return m_skinnedVertexCount > 0; }
+            bool uploadJointMatrices(uint32_t frameIndex) noexcept;
+            void setGpuSkinningEnabled(bool enabled) noexcept { m_isGpuSkinningEnabled = enabled; }
+            uint32_t getSkinnedVertexCount() const noexcept { return m_skinnedVertexCount; }
+            VkBuffer getSkinnedRestBuffer() const noexcept { return m_skinnedRestBuffer.get(); }
+            VkBuffer getSkinVertexBuffer() const noexcept { return m_skinVertexBuffer.get(); }
+            VkBuffer getJointMatrixBuffer(uint32_t frameIndex) const noexcept { return m_jointMatrixBuffers[frameIndex].get(); }
+            VkBuffer getSkinnedVertexBuffer(uint32_t frameIndex) const noexcept { return m_skinnedVertexBuffers[frameIndex].get(); }
+
+            // morph targets: morphed primitives live in the skinned pool too, their position, normal and tangent deltas stored
+            // sparsely (per vertex, only the targets that move it) and blended by the skinning pass ahead of the joints.
+            // weights come from the meshes, their nodes and animation channels; targets at zero weight are skipped
+            bool hasMorphTargets() const noexcept { return m_morphDeltaBuffer.get() != VK_NULL_HANDLE; }
+            bool uploadMorphWeights(uint32_t frameIndex) noexcept;
+            uint32_t getMorphTargetCount() const noexcept { return static_cast<uint32_t>(m_morphWeights.size()); }
+            uint32_t getActiveMorphTargetCount() const noexcept { return m_activeMorphTargetCount; }    // of the last upload
+            VkBuffer getMorphRangeBuffer() const noexcept { return m_morphRangeBuffer.get(); }
+            VkBuffer getMorphDeltaBuffer() const noexcept { return m_morphDeltaBuffer.get(); }
+            VkBuffer getMorphWeightBuffer(uint32_t frameIndex) const noexcept { return m_morphWeightBuffers[frameIndex].get(); }
+
+            // vertex layout chosen at load; select matching bindings and attributes with it
+            VertexFormat getVertexFormat() const noexcept { return m_vertexFormat; }
+            // indices are relative to their primitive's first vertex (passed as the draws' vertexOffset), so models in their own
+            // buffers whose primitives each span at most 64K vertices use 16-bit indices; arena models keep 32-bit ones
+            VkIndexType getIndexType() const noexcept { return m_indexType; }
+            static uint32_t getVertexStride(VertexFormat format) noexcept;
+
+            // shared geometry: the range this model's static pool and indices take in GLTFLoadConfig::mGeometryArena (draws
+            // offset into it), or null when the model owns its buffers
+            const GeometryArena* getGeometryArena() const noexcept { return m_geometryArena; }
+            const GeometryRange& getGeometryRange() const noexcept { return m_geometryRange; }
+
+            // material permutations: the distinct GLTFMaterialFeature sets of the model's materials, in ascending order.
+            // cpu-recorded draws sort by permutation first, so each specialized pipeline is bound once per pass
+            static constexpr uint32_t kMaterialFeatureConstantId = 0;
+            const std::vector<uint32_t>& getMaterialPermutations() const noexcept { return m_materialPermutations; }
+
+            // descriptor management: allocation and updates. textures sample with their gltf sampler's filtering and
+            // wrapping (shared through the device sampler cache); the given presets cover textures without one
+            bool allocateDescriptorSets(VulkanDescriptorAllocator& descriptorAllocator) noexcept;
             void updateDescriptorSets(const VulkanSamplers& sampler) noexcept;
             DescriptorRequirements getDescriptorRequirements() const noexcept;
 
+            // bindless materials (descriptor indexing): one set holds the material table, per-frame object records and every
+            // texture, so the whole model draws without rebinding set 1. cpu-recorded draws write transforms and material
+            // indices to the object buffer and push only an object index (getObjectPushConstantRange, pbr_object.vert);
+            // indirect draws keep the full push constants and pass the material index in materialInfo
+            bool allocateBindlessDescriptorSet(VulkanDescriptorAllocator& descriptorAllocator) noexcept;
+            void updateBindlessDescriptorSet(const VulkanSamplers& sampler) noexcept;
+            DescriptorRequirements getBindlessDescriptorRequirements() const noexcept;
+            void setBindlessEnabled(bool enabled) noexcept { m_isBindlessEnabled = enabled && m_bindlessDescriptorSet != VK_NULL_HANDLE; }
+            bool isBindlessEnabled() const noexcept { return m_isBindlessEnabled; }
+            // cpu-recorded bindless draws: consecutive runs sharing pipeline, cull mode and vertex pool go out as one
+            // vkCmdDrawMultiIndexedEXT of up to maxDrawCount draws (VulkanDevice::isMultiDrawEnabled), which the object vertex
+            // shader must tell apart by gl_DrawID (pbr_object_multi.vert); 0 or 1 records a draw per run
+            void setMultiDrawLimit(uint32_t maxDrawCount) noexcept { m_multiDrawLimit = maxDrawCount; }
+
+            // texture streaming (GLTFLoadConfig::mStreamTextures): once per frame, before recording. viewPosition is the camera
+            // in model space and projectionScale the pixels a unit spans at unit distance (0.5 * viewport height * projection[1][1]).
+            // each draw requests its textures' level from its bounds' projected size; swapped textures are written into the idle
+            // copy of the descriptor sets using them (sets are double buffered while streaming, and a copy is only rewritten once
+            // the frames that bound it completed). returns true when bound sets changed, so recorded draws are stale
+            bool updateTextureStreaming(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const glm::vec3& viewPosition, 
+                                        float projectionScale) noexcept;
+            bool isTextureStreamingEnabled() const noexcept;
+            const TextureStreamer* getTextureStreamer() const noexcept { return m_textureStreamer.get(); }
+
+            // level of detail (GLTFLoadConfig::mGenerateLods): prepareDraws draws each primitive at its coarsest level whose
+            // simplification error projects to at most the pixel threshold. viewPosition and projectionScale as for
+            // updateTextureStreaming; a projectionScale of 0 draws full detail. the indirect path always draws full detail
+            void setLodView(const glm::vec3& viewPosition, float projectionScale) noexcept;
+            void setLodPixelError(float pixels) noexcept { m_lodPixelError = std::max(pixels, 0.0f); }
+            float getLodPixelError() const noexcept { return m_lodPixelError; }
+            bool hasLods() const noexcept { return m_lodIndexCount > 0; }
+            uint32_t getLodIndexCount() const noexcept { return m_lodIndexCount; }
+            uint64_t getDrawnTriangleCount() const noexcept { return m_drawnTriangleCount; }         // by the last prepareDraws
+            uint64_t getFullDetailTriangleCount() const noexcept { return m_fullDetailTriangleCount; } // the same draws at full detail
+
+            // meshlets (GLTFLoadConfig::mBuildMeshlets, VK_EXT_mesh_shader): static primitives are split into clusters of at most
+            // kMeshletMaxVertices vertices and kMeshletMaxTriangles triangles, whose bounding spheres and backface cones a task
+            // shader tests before mesh workgroups emit the survivors (pbr_meshlet.task/.mesh, set 3: getMeshletDescriptorSetLayout,
+            // and the packed vertex decode selected by kVertexFormatConstantId). recordMeshletDraws records runs of prepareDraws
+            // like recordDraws, one vkCmdDrawMeshTasksEXT each and always at full detail; runs must be prepared without instancing
+            // or bindless object data, and skinned primitives (which have no meshlets) are skipped
+            static constexpr uint32_t kVertexFormatConstantId = 1;
+            void recordMeshletDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                    uint32_t runCount, const VkPipeline* permutationPipelines = nullptr) const noexcept;
+            void recordMeshletDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                    uint32_t runCount, const VkPipeline* permutationPipelines = nullptr) const noexcept;
+            bool allocateMeshletDescriptorSet(VulkanDescriptorAllocator& descriptorAllocator) noexcept;
+            DescriptorRequirements getMeshletDescriptorRequirements() const noexcept;
+            bool hasMeshlets() const noexcept { return m_meshletCount > 0; }
+            uint32_t getMeshletCount() const noexcept { return m_meshletCount; }
+
+            // depth pre-pass: recordDepthDraws lays down depth for runs of prepareDraws from a position-only copy of the static
+            // pool (getDepthVertexInputState), at the same level of detail as the main pass. alpha-masked and skinned
+            // draws are left to the main pass, as are draws whose bounds span fewer than minPixels on screen (projected as by
+            // setLodView). runs must be prepared without instancing or bindless object data. depthPipelines: single-sided
+            // (back faces culled) and double-sided, laid out like the main pipeline for set 0 and the push constants (one
+            // pipeline twice with dynamic culling)
+            void recordDepthDraws(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                  uint32_t runCount, float minPixels, const std::array<VkPipeline, 2>& depthPipelines) const noexcept;
+            void recordDepthDraws(VulkanCommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t firstRun, 
+                                  uint32_t runCount, float minPixels, const std::array<VkPipeline, 2>& depthPipelines) const noexcept;
+            // true when a pre-pass with minPixels 0 covers every draw of the permutation, so its main pass may test EQUAL
+            bool isDepthPrepassComplete(uint32_t permutation) const noexcept;
+            bool hasDepthPositions() const noexcept { return m_positionBuffer.get() != VK_NULL_HANDLE; }
+
+            // shadow casters: gatherShadowCasters appends the static opaque draws of every placement whose bounds touch frustum
+            // (world space, modelToWorld maps the model's space, placements included, into it) with their transforms captured,
+            // at the level of detail setLodView selects; recordShadowCasters then draws them from the position stream and only
+            // reads buffers, so it may overlap update(). alpha-masked and skinned draws cast no shadows. shadowPipelines:
+            // single-sided and double-sided, reading the vertex-stage model matrix at offset 0 of pipelineLayout's push constants
+            void gatherShadowCasters(const Frustum& frustum, const glm::mat4& modelToWorld, std::vector<ShadowCasterDraw>& casters) const noexcept;
+            void recordShadowCasters(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const ShadowCasterDraw* casters, uint32_t count,
+                                     const std::array<VkPipeline, 2>& shadowPipelines) const noexcept;
+
+            // ray tracing inputs (models loaded on a device with ray query enabled): getRayTracingGeometries lists the full
+            // detail triangles of every primitive, indexed by the dense primitive id, from the position stream. skinned
+            // and alpha-masked primitives, which a static opaque structure cannot represent, have none. the gather then
+            // appends one instance per static opaque draw of every placement (modelToWorld as for gatherShadowCasters);
+            // getRayTracingInstanceCapacity bounds its count for the model's placement capacity
+            bool hasRayTracingGeometry() const noexcept { return m_hasRayTracingInputs; }
+            void getRayTracingGeometries(std::vector<RayTracingGeometry>& geometries) const noexcept;
+            void gatherRayTracingInstances(const glm::mat4& modelToWorld, std::vector<RayTracingInstance>& instances) const noexcept;
+            uint32_t getRayTracingInstanceCapacity() const noexcept;
+
             // manage shared vulkan resources: descriptor set layout, push constants
             static void initSharedResources(VkDevice vkDevice) noexcept;
             static void destroySharedResources(VkDevice vkDevice) noexcept;
-            static const std::vector<VkVertexInputBindingDescription>& getBindings() noexcept { return s_vertexBindings; }
-            static const std::vector<VkVertexInputAttributeDescription>& getAttributes() noexcept { return s_vertexAttributes; }
+            static bool initBindlessResources(const VulkanDevice& device) noexcept;
+            static bool initMeshletResources(const VulkanDevice& device) noexcept;
+            // vertex input of each pipeline variant, in the vertex layout's format (see VertexLayout); the descriptions are
+            // static, so the returned state stays valid for the program's lifetime
+            static VkPipelineVertexInputStateCreateInfo getVertexInputState(VertexFormat format = VertexFormat::kStandard) noexcept;
+            // indirect rendering: the vertices plus the draw records as an instance-rate binding
+            static VkPipelineVertexInputStateCreateInfo getIndirectVertexInputState(VertexFormat format = VertexFormat::kStandard) noexcept;
+            // instanced draws: the indirect attributes over a binding of tightly packed model matrices
+            static VkPipelineVertexInputStateCreateInfo getInstancedVertexInputState(VertexFormat format = VertexFormat::kStandard) noexcept;
+            // depth pre-pass: position only, in the vertex layout's format
+            static VkPipelineVertexInputStateCreateInfo getDepthVertexInputState(VertexFormat format = VertexFormat::kStandard) noexcept;
+            // vertex pulling: the per-draw records alone, for any vertex format
+            static VkPipelineVertexInputStateCreateInfo getPulledVertexInputState() noexcept;
             static VkDescriptorSetLayout getDescriptorSetLayout() noexcept { return s_descriptorSetLayout; }
+            static VkDescriptorSetLayout getBindlessDescriptorSetLayout() noexcept { return s_bindlessDescriptorSetLayout; }
             static VkPushConstantRange getPushConstantRange() noexcept { return s_pushConstantRange; }
+            static VkPushConstantRange getObjectPushConstantRange() noexcept { return s_objectPushConstantRange; }
+            static VkDescriptorSetLayout getMeshletDescriptorSetLayout() noexcept { return s_meshletDescriptorSetLayout; }
+            static VkPushConstantRange getMeshletPushConstantRange() noexcept { return s_meshletPushConstantRange; }
 
         private:
             // forward declarations
             struct Vertex;
+            struct PackedVertex;
+            struct PrimitiveLod;
             struct Primitive;
             struct Mesh;
             struct Scene;
             struct Node;
             struct Material;
+            struct TextureSampler;
+            struct TextureLayer;
+            struct ImageFold;
+            struct DrawItem;
+            struct DrawListEntry;
+            struct DrawRun;
+            struct ObjectData;
+            struct DrawData;
+            struct VertexLayouts;
+            struct DrawBatch;
+            struct MeshletData;
+            struct AnimationSampler;
+            struct AnimationChannel;
+            struct Animation;
+            struct SkinVertex;
+            struct Skin;
+            struct MorphDelta;
+            struct BakeData;
+            struct BakedView;
+            struct PendingUpload;
 
-            // internal helpers for loading model
-            bool loadMeshes(const tinygltf::Model& model, const VulkanDevice& device, const VulkanCommandPool& commandPool) noexcept;
+            // internal helpers for loading model; without a staging belt the gpu-bound output is kept in m_bakeData and
+            // m_pendingUpload for uploadPending instead of being uploaded
+            bool loadSource(const VulkanDevice& device, VulkanStagingBelt* stagingBelt, const std::string& filename, const GLTFLoadConfig& config) noexcept;
+            bool uploadPending(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, bool waitForCompletion) noexcept;
+        #ifdef KEPLAR_COROUTINES
+            AsyncTask<bool> runLoad(const VulkanDevice& device, std::string filename, GLTFLoadConfig config) noexcept;
+        #endif
+            bool loadMeshes(const tinygltf::Model& model, const VulkanDevice& device, VulkanStagingBelt* stagingBelt, const GLTFLoadConfig& config) noexcept;
             bool loadSceneGraph(const tinygltf::Model& model) noexcept;
-            bool loadTextures(const tinygltf::Model& model, const VulkanDevice& device, const VulkanCommandPool& commandPool) noexcept;
-            bool loadMaterials(const tinygltf::Model& model) noexcept;
-            void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) noexcept;
+            bool loadTextures(const tinygltf::Model& model, const VulkanDevice& device, VulkanStagingBelt* stagingBelt, const GLTFLoadConfig& config,
+                              std::vector<ImageFold>& imageFolds) noexcept;
+            bool loadMaterials(const tinygltf::Model& model, const std::vector<ImageFold>& imageFolds) noexcept;
+            bool packTextureArrays(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, std::vector<TextureData>& textureData,
+                                   const std::vector<VkFormat>& textureFormats, const std::vector<uint8_t>& isCandidate, uint32_t maxSize) noexcept;
+            void buildMaterialPermutations() noexcept;
+            void resolveTextureSamplers(const VulkanDevice& device) noexcept;
+            VkSampler getTextureSampler(uint32_t textureIndex, VkSampler fallback) const noexcept;
+            VkImageView getTextureView(uint32_t textureIndex) const noexcept;
+            void writeMaterialDescriptors(const Material& material, VkDescriptorSet vkDescriptorSet) const noexcept;
+            void writeBindlessDescriptorSet(VkDescriptorSet vkDescriptorSet) const noexcept;
+            void flattenSceneGraph(const tinygltf::Model& model) noexcept;
+            void updateWorldTransforms() noexcept;
+            void updateBounds() noexcept;
+            bool loadSkins(const tinygltf::Model& model, const VulkanDevice& device, VulkanStagingBelt* stagingBelt) noexcept;
+            void updateJointMatrices() noexcept;
+            const VulkanBuffer& getSkinnedDrawBuffer(uint32_t frameIndex) const noexcept;
+            const VulkanBuffer& getStaticVertexBuffer() const noexcept { return m_geometryArena ? m_geometryArena->getVertexBuffer() : m_vertexBuffer; }
+            VkBuffer getIndexBuffer() const noexcept { return m_geometryArena ? m_geometryArena->getIndexBuffer().get() : m_indexBuffer.get(); }
+            int32_t getVertexOffset(bool isSkinned, uint32_t baseVertex) const noexcept 
+            { 
+                return static_cast<int32_t>((isSkinned ? 0 : m_geometryRange.mFirstVertex) + baseVertex); 
+            }
+            void releaseGeometry() noexcept;
+            const Texture& getTexture(uint32_t index) const noexcept
+            {
+                return index < m_sharedTextures.size() && m_sharedTextures[index] ? *m_sharedTextures[index] : m_textures[index];
+            }
+            bool isObjectDataActive(uint32_t frameIndex) const noexcept;
+            // runs from firstRun that recordDraws submits as one multi-draw; 0 when multi-draw is off
+            uint32_t getMultiDrawCount(uint32_t firstRun, uint32_t endRun, const VkPipeline* permutationPipelines) const noexcept;
+            bool isInstancingActive(uint32_t frameIndex) const noexcept;
+            glm::mat4 getPlacement(uint32_t placement) const noexcept { return m_placements.empty() ? glm::mat4(1.0f) : m_placements[placement]; }
+            bool loadAnimations(const tinygltf::Model& model) noexcept;
+            static glm::vec4 sampleAnimation(const AnimationSampler& sampler, float time, bool isRotation, uint32_t group = 0) noexcept;
+
+            // incremental updates of dirty subtrees
+            void updateDirtyTransforms() noexcept;
+            void updateNodeTransform(uint32_t node) noexcept;
+            BoundingBox getNodeDrawBounds(uint32_t node) const noexcept;
+            bool createDrawBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept;
+            void recordIndirectBatches(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, bool useDrawCount,
+                                       bool isLatePhase, uint32_t firstBatch, uint32_t endBatch) noexcept;
+            void resetPartitionRevisions() noexcept;
+            bool createMaterialBuffer(const VulkanDevice& device, VulkanStagingBelt& stagingBelt) noexcept;
+            bool createMeshBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const void* vertexData, size_t vertexDataSize, 
+                                   const Vertex* skinnedVertices, size_t skinnedVertexCount, const uint32_t* indices, size_t indexCount) noexcept;
+            uint32_t rebaseIndices(std::vector<uint32_t>& indices) const noexcept;
+            bool createSkinBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const SkinVertex* skinVertices, size_t skinVertexCount) noexcept;
+            bool createMorphBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const glm::uvec2* morphRanges, size_t morphRangeCount,
+                                    const MorphDelta* morphDeltas, size_t morphDeltaCount) noexcept;
+            bool createMeshletBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const MeshletData* meshlets, size_t meshletCount,
+                                      const uint32_t* meshletVertices, size_t meshletVertexCount, const uint32_t* meshletTriangles, 
+                                      size_t meshletTriangleCount) noexcept;
+
+            // baked cache: the tinygltf path captures its cpu output into m_bakeData, which is written once loading succeeds
+            bool readBakedModel(ModelCacheReader& reader, BakedView& baked) noexcept;
+            bool uploadBakedModel(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const BakedView& baked, bool waitForCompletion = true) noexcept;
+            bool writeBakedModel(const std::filesystem::path& filepath, const ModelCacheKey& key) const noexcept;
+            void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t firstVertex, uint32_t vertexCount,
+                                  uint32_t firstIndex, uint32_t indexCount) noexcept;
+            std::vector<uint32_t> optimizePrimitive(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t firstVertex, 
+                                                    uint32_t vertexCount, uint32_t firstIndex, uint32_t indexCount, bool isSkinned) noexcept;
+            void generatePrimitiveLods(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, Primitive& primitive) noexcept;
+            uint32_t selectLod(const DrawItem& item, const glm::vec3& viewPosition) const noexcept;
+            uint32_t cullPlacements(const Frustum* frustum) noexcept;
+            void buildPrimitiveMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, Primitive& primitive, 
+                                        std::vector<MeshletData>& meshlets, std::vector<uint32_t>& meshletVertices, 
+                                        std::vector<uint32_t>& meshletTriangles) const noexcept;
+            static glm::mat4 packVertices(const std::vector<Vertex>& vertices, const Primitive& primitive, std::vector<PackedVertex>& packedVertices) noexcept;
 
         private:
             // vulkan resources
             VkDevice              m_vkDevice;
             VulkanBuffer          m_vertexBuffer;       
+            VulkanBuffer          m_positionBuffer;     // positions of the static pool for the depth pre-pass
             VulkanBuffer          m_indexBuffer;
+            GeometryArena*        m_geometryArena;      // replaces the two buffers above when set
+            GeometryRange         m_geometryRange;
             uint32_t              m_vertexCount;
             uint32_t              m_indexCount;
+            VkIndexType           m_indexType;          // of the bound index buffer, arena or own
+            VertexFormat          m_vertexFormat;
+
+            // gpu-driven draw data: per-draw records, indirect commands and per-batch counts
+            VulkanBuffer            m_drawDataBuffer;
+            VulkanBuffer            m_indirectBuffer;
+            VulkanBuffer            m_drawCountBuffer;
+            std::vector<DrawBatch>  m_drawBatches;
+            std::vector<uint64_t>   m_partitionRevisions;       // per kBatchesPerPartition batches, from m_revisionCounter
+            uint64_t                m_revisionCounter;
+            uint32_t                m_drawCount;
+            bool                    m_isMultiDrawEnabled;
+            bool                    m_hasVertexAddresses;       // vertex pools created with device address usage
+            bool                    m_hasRayTracingInputs;      // positions and indices created with build input usage
+            bool                    m_isVertexPullingEnabled;
+            bool                    m_isDynamicCullModeEnabled;
+
+            // skinning: bind-pose pool, per-vertex influences, and per-frame joint matrices and skinned output
+            VulkanBuffer            m_skinnedRestBuffer;
+            VulkanBuffer            m_skinVertexBuffer;
+            VulkanBuffer            m_jointMatrixBuffers[kMaxSkinningFrames];
+            VulkanBuffer            m_skinnedVertexBuffers[kMaxSkinningFrames];
+            uint32_t                m_skinnedVertexCount;
+            bool                    m_isGpuSkinningEnabled;
+            std::vector<Skin>       m_skins;
+            std::vector<glm::mat4>  m_jointMatrices;
+            std::vector<SkinVertex> m_skinVertices;     // load-time only
+            std::unique_ptr<BakeData> m_bakeData;       // set only while baking a cache file or decoding asynchronously
+
+            // morph targets: delta run of every skinned vertex, the deltas, and per-frame weights of every target
+            VulkanBuffer            m_morphRangeBuffer;
+            VulkanBuffer            m_morphDeltaBuffer;
+            VulkanBuffer            m_morphWeightBuffers[kMaxSkinningFrames];
+            std::vector<float>      m_morphWeights;             // the targets of each morphed mesh in a contiguous run
+            uint32_t                m_activeMorphTargetCount;
+
+            // bindless materials: material table and the set indexing it with every texture
+            VulkanBuffer            m_materialBuffer;
+            VkDescriptorSet         m_bindlessDescriptorSet;
+            VkDescriptorSet         m_spareBindlessDescriptorSet;   // idle copy while streaming textures
+            bool                    m_isBindlessEnabled;
+            VulkanBuffer            m_objectBuffer;         // kMaxFramesInFlight regions of m_objectCapacity records
+            uint32_t                m_objectCapacity;
+            uint32_t                m_multiDrawLimit;       // draws per multi-draw of the object path, < 2 when off
+            std::vector<ObjectData> m_objectData;           // per-render scratch, copied to the frame's region at once
+
+            // meshlets of the static pool, and the set binding them with the vertex pool for the mesh stage
+            VulkanBuffer            m_meshletBuffer;
+            VulkanBuffer            m_meshletVertexBuffer;
+            VulkanBuffer            m_meshletTriangleBuffer;
+            uint32_t                m_meshletCount;
+            VkDescriptorSet         m_meshletDescriptorSet;
+
+            // instancing: per-frame instance transforms and the draws it merges
+            VulkanBuffer            m_instanceBuffers[kMaxFramesInFlight];
+            VulkanBuffer            m_runCommandBuffers[kMaxFramesInFlight];    // indexed indirect command per instanced run
+            uint32_t                m_repeatedDrawCount;
+            bool                    m_isInstancingEnabled;
+
+            // placements: model-to-world transforms drawn by prepareDraws, up to the capacity the per-frame buffers hold
+            std::vector<glm::mat4>  m_placements;
+            uint32_t                m_maxPlacements;
+            CullingBounds           m_placementBounds;          // per placement: the whole model's bounds, in world space
+            BoundingBox             m_placementModelBounds;     // model bounds m_placementBounds was built from
+            bool                    m_isPlacementBoundsDirty;
+            std::vector<uint32_t>   m_visiblePlacements;        // per-render scratch: placements left by the batch cull
 
             // scene data
             std::vector<Mesh>     m_meshes;
             std::vector<Node>     m_nodes;
             std::vector<Scene>    m_scenes;
-            std::vector<Texture>  m_textures;
+            TexturePool           m_textures;       // never removed from, so dense indices are the gltf image indices
+            std::vector<std::shared_ptr<Texture>> m_sharedTextures;  // per texture: the AssetManager's copy, with m_textures left empty
+            std::vector<Texture>        m_textureArrays;    // small same-shape images packed as layers, with m_textures left empty
+            std::vector<TextureLayer>   m_textureLayers;    // per texture: its layer of m_textureArrays, if packed
+            std::vector<TextureSampler> m_textureSamplers;  // per texture: gltf sampler state of the first material slot using it
+            std::vector<VkSampler>      m_vkTextureSamplers; // per texture: cached sampler, VK_NULL_HANDLE for the preset
+            VkSampler                   m_vkFallbackSampler; // preset given to the last descriptor update
             std::vector<Material> m_materials;
+            std::vector<uint32_t> m_materialPermutations;
+
+            // default scene flattened in pre-order (parents precede children, subtrees are contiguous).
+            // per-node arrays share one index; draw ranges index into m_drawItems
+            std::vector<int32_t>     m_nodeParents;
+            std::vector<int32_t>     m_nodeFlatIndices;         // gltf node -> flattened index, -1 if not in the default scene
+            std::vector<glm::vec3>   m_nodeTranslations;
+            std::vector<glm::quat>   m_nodeRotations;
+            std::vector<glm::vec3>   m_nodeScales;
+            std::vector<glm::mat4>   m_nodeLocalTransforms;
+            std::vector<glm::mat4>   m_nodeWorldTransforms;
+            std::vector<uint32_t>    m_nodeSubtreeEnds;
+            std::vector<BoundingBox> m_nodeBounds;
+            std::vector<glm::uvec2>  m_nodeDrawRanges;
+            std::vector<DrawItem>    m_drawItems;
+            std::vector<DrawListEntry> m_drawList;      // per-render scratch: visible items sorted by state and depth
+            std::vector<DrawRun>    m_drawRuns;         // per-render scratch: draw list grouped into recorded draws
+
+            // level of detail selection
+            glm::vec3               m_lodViewPosition;
+            float                   m_lodProjectionScale;
+            float                   m_lodPixelError;
+            uint32_t                m_lodIndexCount;            // indices of every simplified level in the index buffer
+            uint64_t                m_drawnTriangleCount;
+            uint64_t                m_fullDetailTriangleCount;
+
+            // animation state: nodes touched this frame and the subtrees they invalidate
+            std::vector<Animation>      m_animations;
+            uint32_t                    m_activeAnimation;
+            float                       m_animationTime;
+            std::vector<uint32_t>       m_dirtyNodes;
+            std::vector<glm::uvec2>     m_dirtyRanges;
+            std::unique_ptr<ThreadPool> m_threadPool;
+
+            // asynchronous load: the decode task and its result, what it left for upload, and the belt batch uploading it
+            TaskHandle                      m_loadTask;
+            bool                            m_isLoadDecoded;    // written by the task, read once it is done
+            std::unique_ptr<PendingUpload>  m_pendingUpload;
+            uint64_t                        m_uploadTicket;
+            GLTFLoadState                   m_loadState;
+            GLTFLoadTimings                 m_loadTimings;
+        #ifdef KEPLAR_COROUTINES
+            // the load as one coroutine: decode on the pool, staging and upload completion on the thread polling it
+            AsyncTask<bool>                 m_loadCoroutine;
+            AsyncQueue                      m_loadQueue;
+            VulkanStagingBelt*              m_loadBelt = nullptr;
+        #endif
+
+            // texture streaming: mip residency, and the streaming update since which each idle descriptor copy is unused
+            std::unique_ptr<TextureStreamer> m_textureStreamer;
+            uint64_t                    m_streamingFrame;
+            uint64_t                    m_bindlessSwapFrame;
+            bool                        m_isBindlessDescriptorStale;
 
-            // shared vulkan resources: bindings, attributes, descriptor set layout and push constants
-            inline static std::vector<VkVertexInputBindingDescription>   s_vertexBindings;
-            inline static std::vector<VkVertexInputAttributeDescription> s_vertexAttributes;
+            // shared vulkan resources: descriptor set layout and push constants
             inline static VkDescriptorSetLayout                          s_descriptorSetLayout  = VK_NULL_HANDLE;
+            inline static std::array<VkDescriptorUpdateTemplate, 32>     s_materialUpdateTemplates{};   // by mask of the maps a material samples
+            inline static VkDescriptorSetLayout                          s_bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+            inline static uint32_t                                       s_maxBindlessTextures  = 0;
             inline static VkPushConstantRange                            s_pushConstantRange{};
+            inline static VkPushConstantRange                            s_objectPushConstantRange{};
+            inline static VkDescriptorSetLayout                          s_meshletDescriptorSetLayout = VK_NULL_HANDLE;
+            inline static VkPushConstantRange                            s_meshletPushConstantRange{};
+            inline static PFN_vkCmdDrawMeshTasksEXT                      s_vkCmdDrawMeshTasksEXT = nullptr;
     };
 }   // namespace keplar
@@ -0,0 +1,270 @@
+// ────────────────────────────────────────────
+//  File: gpu_culling.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "gpu_culling.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // preferred workgroup size, specialized into local_size_x_id in frustum_cull.comp (clamped to device limits)
+    constexpr uint32_t kWorkgroupSize = 64;
+    constexpr uint32_t kWorkgroupSizeConstantId = 0;
+
+    // descriptor bindings (set: 0)
+    constexpr uint32_t kDrawDataBinding  = 0;
+    constexpr uint32_t kIndirectBinding  = 1;
+    constexpr uint32_t kDrawCountBinding = 2;
+
+    // push constants: frustum planes and dispatch parameters
+    struct alignas(16) CullPushConstants
+    {
+        glm::vec4  planes[keplar::Frustum::kPlaneCount];
+        glm::uvec4 params;      // x: draw count, y: compact
+    };
+}
+
+namespace keplar
+{
+    GpuCulling::GpuCulling() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSet(VK_NULL_HANDLE)
+        , m_workgroupSize(kWorkgroupSize)
+        , m_drawCountBuffer(VK_NULL_HANDLE)
+    {
+    }
+
+    GpuCulling::~GpuCulling()
+    {
+        destroy();
+    }
+
+    bool GpuCulling::initialize(const VulkanDevice& device, const std::string& spirvFile) noexcept
+    {
+        m_vkDevice = device.getDevice();
+
+        if (!createDescriptorResources() || !createPipeline(device, spirvFile))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("GpuCulling::initialize successful");
+        return true;
+    }
+
+    void GpuCulling::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // descriptor set is freed with its pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+            m_vkDescriptorSet = VK_NULL_HANDLE;
+        }
+
+        if (m_vkDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(m_vkDevice, m_vkDescriptorSetLayout, nullptr);
+            m_vkDescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        m_drawCountBuffer = VK_NULL_HANDLE;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("gpu culling pass destroyed successfully");
+    }
+
+    void GpuCulling::bindBuffers(VkBuffer drawDataBuffer, VkBuffer indirectBuffer, VkBuffer drawCountBuffer) noexcept
+    {
+        if (m_vkDescriptorSet == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // whole-buffer ranges for each storage binding
+        const std::array<VkDescriptorBufferInfo, 3> bufferInfos
+        {{
+            { drawDataBuffer,  0, VK_WHOLE_SIZE },
+            { indirectBuffer,  0, VK_WHOLE_SIZE },
+            { drawCountBuffer, 0, VK_WHOLE_SIZE }
+        }};
+
+        std::array<VkWriteDescriptorSet, 3> writes{};
+        for (uint32_t i = 0; i < writes.size(); ++i)
+        {
+            writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].pNext            = nullptr;
+            writes[i].dstSet           = m_vkDescriptorSet;
+            writes[i].dstBinding       = i;
+            writes[i].dstArrayElement  = 0;
+            writes[i].descriptorCount  = 1;
+            writes[i].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pImageInfo       = nullptr;
+            writes[i].pBufferInfo      = &bufferInfos[i];
+            writes[i].pTexelBufferView = nullptr;
+        }
+
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        m_drawCountBuffer = drawCountBuffer;
+    }
+
+    void GpuCulling::record(VkCommandBuffer commandBuffer, const Frustum& frustum, uint32_t drawCount, bool compact) const noexcept
+    {
+        if (!isValid() || drawCount == 0)
+        {
+            return;
+        }
+
+        // the previous frame may still be reading commands on this queue, or copying its counts back (write-after-read)
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        // compacted output appends into per-batch counters, reset them first
+        if (compact)
+        {
+            vkCmdFillBuffer(commandBuffer, m_drawCountBuffer, 0, VK_WHOLE_SIZE, 0);
+
+            VkMemoryBarrier clearBarrier{};
+            clearBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            clearBarrier.pNext         = nullptr;
+            clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        // frustum and dispatch parameters
+        CullPushConstants pushConstants{};
+        for (uint32_t i = 0; i < Frustum::kPlaneCount; ++i)
+        {
+            pushConstants.planes[i] = frustum.mPlanes[i];
+        }
+        pushConstants.params = glm::uvec4(drawCount, compact ? 1u : 0u, 0u, 0u);
+
+        // one invocation per draw
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (drawCount + m_workgroupSize - 1) / m_workgroupSize, 1, 1);
+
+        // make written commands and counts visible to the indirect draws
+        VkMemoryBarrier cullBarrier{};
+        cullBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        cullBarrier.pNext         = nullptr;
+        cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                             0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    bool GpuCulling::createDescriptorResources() noexcept
+    {
+        // set: 0, bindings: draw data (read), indirect commands (write), draw counts (atomic)
+        std::array<VkDescriptorSetLayoutBinding, 3> bindings
+        {{
+            { kDrawDataBinding,  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kIndirectBinding,  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kDrawCountBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = nullptr;
+        layoutInfo.flags        = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings    = bindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &m_vkDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GpuCulling :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // private pool sized for the single set of this pass
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSize.descriptorCount = static_cast<uint32_t>(bindings.size());
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes    = &poolSize;
+
+        vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GpuCulling :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkDescriptorSetLayout;
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &m_vkDescriptorSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GpuCulling :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GpuCulling::createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept
+    {
+        // missing spir-v is not fatal; callers fall back to cpu-recorded draws
+        VulkanShader computeShader;
+        if (!computeShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, spirvFile))
+        {
+            VK_LOG_WARN("GpuCulling :: compute shader '%s' unavailable", spirvFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = computeShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkDescriptorSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants) } };
+
+        // local_size_x is a specialization constant so the workgroup size can follow the device
+        const VkPhysicalDeviceLimits& limits = device.getPhysicalDeviceProperties().limits;
+        m_workgroupSize = std::min({ kWorkgroupSize, limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations });
+        pipelineConfig.addSpecializationConstant(kWorkgroupSizeConstantId, m_workgroupSize);
+
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("GpuCulling :: failed to create compute pipeline");
+            return false;
+        }
+
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,62 @@
+// ────────────────────────────────────────────
+//  File: gpu_culling.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // compute pass that frustum-culls per-draw bounding spheres into a VkDrawIndexedIndirectCommand buffer.
+    // compact mode appends visible draws per batch through an atomic count buffer (for vkCmdDrawIndexedIndirectCount);
+    // otherwise every command is rewritten in place with instanceCount 0 or 1.
+    class GpuCulling final
+    {
+        public:
+            // creation and destruction
+            GpuCulling() noexcept;
+            ~GpuCulling();
+
+            // disable copy and move semantics to enforce unique ownership
+            GpuCulling(const GpuCulling&) = delete;
+            GpuCulling& operator=(const GpuCulling&) = delete;
+            GpuCulling(GpuCulling&&) = delete;
+            GpuCulling& operator=(GpuCulling&&) = delete;
+
+            bool initialize(const VulkanDevice& device, const std::string& spirvFile) noexcept;
+            void destroy() noexcept;
+
+            // usage: point the pass at the draw data, command and per-batch count buffers
+            void bindBuffers(VkBuffer drawDataBuffer, VkBuffer indirectBuffer, VkBuffer drawCountBuffer) noexcept;
+
+            // usage: record outside a render pass, before the indirect draws that consume the commands
+            void record(VkCommandBuffer commandBuffer, const Frustum& frustum, uint32_t drawCount, bool compact) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && m_vkDescriptorSet != VK_NULL_HANDLE; }
+
+        private:
+            bool createDescriptorResources() noexcept;
+            bool createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                m_vkDevice;
+            VkDescriptorSetLayout   m_vkDescriptorSetLayout;
+            VkDescriptorPool        m_vkDescriptorPool;
+            VkDescriptorSet         m_vkDescriptorSet;
+            VulkanPipeline          m_pipeline;
+            uint32_t                m_workgroupSize;
+
+            // bound buffers
+            VkBuffer                m_drawCountBuffer;
+    };
+}   // namespace keplar
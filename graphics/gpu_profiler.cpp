@@ -0,0 +1,373 @@
+// ────────────────────────────────────────────
+//  File: gpu_profiler.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "gpu_profiler.hpp"
+
+#include <fstream>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_utils.hpp"
+#include "vulkan/vulkan_debug_label.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // exponential moving average weight of the latest frame
+    constexpr float kResultSmoothing = 0.1f;
+
+    // values per statistics query (one per bit of GpuProfiler::kPipelineStatistics), plus its availability
+    constexpr uint32_t kStatisticCount = 6;
+    static_assert(sizeof(keplar::GpuPipelineStatistics) == kStatisticCount * sizeof(uint64_t), "one field per pipeline statistic");
+
+    // graphics queue family timestamp bits (0: no timestamp support)
+    uint32_t getTimestampValidBits(VkPhysicalDevice vkPhysicalDevice, uint32_t queueFamilyIndex) noexcept
+    {
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(vkPhysicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(vkPhysicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+
+        if (queueFamilyIndex >= queueFamilyCount)
+        {
+            return 0;
+        }
+
+        return queueFamilyProperties[queueFamilyIndex].timestampValidBits;
+    }
+}
+
+namespace keplar
+{
+    GpuProfiler::Scope::Scope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name) noexcept
+        : m_profiler(profiler)
+        , m_vkCommandBuffer(commandBuffer)
+        , m_scopeIndex(profiler.beginScope(commandBuffer, name))
+    {
+    }
+
+    GpuProfiler::Scope::~Scope()
+    {
+        m_profiler.endScope(m_vkCommandBuffer, m_scopeIndex);
+    }
+
+    GpuProfiler::GpuProfiler() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_currentFrame(0)
+        , m_maxScopes(0)
+        , m_depth(0)
+        , m_statisticsScope(UINT32_MAX)
+        , m_isStatisticsEnabled(false)
+        , m_isStatisticsInherited(false)
+        , m_timestampPeriod(0.0f)
+        , m_timestampMask(0)
+    {
+    }
+
+    GpuProfiler::~GpuProfiler()
+    {
+        destroy();
+    }
+
+    bool GpuProfiler::initialize(const VulkanDevice& device, uint32_t frameCount, uint32_t maxScopes) noexcept
+    {
+        destroy();
+
+        // validate input
+        if (frameCount == 0 || maxScopes == 0)
+        {
+            VK_LOG_ERROR("GpuProfiler::initialize failed: frame count or scope count is zero");
+            return false;
+        }
+
+        // timestamps must be supported on the queue the frame is recorded for
+        const auto& limits = device.getPhysicalDeviceProperties().limits;
+        const uint32_t validBits = getTimestampValidBits(device.getPhysicalDevice(), device.getQueueFamilyIndices().mGraphicsFamily.value_or(0));
+        if (validBits == 0 || limits.timestampPeriod <= 0.0f)
+        {
+            VK_LOG_WARN("GpuProfiler::initialize skipped: graphics queue has no timestamp support");
+            return false;
+        }
+
+        m_vkDevice        = device.getDevice();
+        m_maxScopes       = maxScopes;
+        m_timestampPeriod = limits.timestampPeriod;
+        m_timestampMask   = (validBits >= 64) ? ~uint64_t(0) : ((uint64_t(1) << validBits) - 1);
+
+        // two timestamps per scope, per frame slot
+        VkQueryPoolCreateInfo queryPoolCreateInfo{};
+        queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolCreateInfo.pNext = nullptr;
+        queryPoolCreateInfo.flags = 0;
+        queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolCreateInfo.queryCount = maxScopes * 2;
+        queryPoolCreateInfo.pipelineStatistics = 0;
+
+        // one statistics query per scope, per frame slot, where the device counts them
+        const auto& enabledFeatures = device.getEnabledFeatures();
+        VkQueryPoolCreateInfo statisticsPoolCreateInfo = queryPoolCreateInfo;
+        statisticsPoolCreateInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        statisticsPoolCreateInfo.queryCount = maxScopes;
+        statisticsPoolCreateInfo.pipelineStatistics = kPipelineStatistics;
+
+        m_frames.resize(frameCount);
+        for (auto& frame : m_frames)
+        {
+            VkResult vkResult = vkCreateQueryPool(m_vkDevice, &queryPoolCreateInfo, nullptr, &frame.mQueryPool);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("vkCreateQueryPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                destroy();
+                return false;
+            }
+
+            if (enabledFeatures.pipelineStatisticsQuery)
+            {
+                vkResult = vkCreateQueryPool(m_vkDevice, &statisticsPoolCreateInfo, nullptr, &frame.mStatisticsPool);
+                if (vkResult != VK_SUCCESS)
+                {
+                    VK_LOG_FATAL("vkCreateQueryPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                    destroy();
+                    return false;
+                }
+            }
+
+            frame.mNames.reserve(maxScopes);
+            frame.mDepths.reserve(maxScopes);
+            frame.mHasStatistics.reserve(maxScopes);
+        }
+        m_isStatisticsEnabled   = enabledFeatures.pipelineStatisticsQuery == VK_TRUE;
+        m_isStatisticsInherited = m_isStatisticsEnabled && enabledFeatures.inheritedQueries == VK_TRUE;
+
+        VK_LOG_DEBUG("GpuProfiler::initialize successful (%u frames, %u scopes, %.3f ns/tick, pipeline statistics %s)", frameCount, maxScopes, 
+                     m_timestampPeriod, m_isStatisticsEnabled ? (m_isStatisticsInherited ? "on" : "on, inline passes only") : "off");
+        return true;
+    }
+
+    void GpuProfiler::destroy() noexcept
+    {
+        for (auto& frame : m_frames)
+        {
+            if (frame.mQueryPool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(m_vkDevice, frame.mQueryPool, nullptr);
+            }
+            if (frame.mStatisticsPool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(m_vkDevice, frame.mStatisticsPool, nullptr);
+            }
+        }
+
+        m_frames.clear();
+        m_results.clear();
+        m_currentFrame = 0;
+        m_depth = 0;
+        m_statisticsScope = UINT32_MAX;
+        m_isStatisticsEnabled = false;
+        m_isStatisticsInherited = false;
+    }
+
+    void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept
+    {
+        if (!isValid() || frameIndex >= m_frames.size())
+        {
+            return;
+        }
+
+        // the slot's previous submission has completed: read what it measured before reusing the pool
+        auto& frame = m_frames[frameIndex];
+        if (frame.mIsRecorded)
+        {
+            resolveFrame(frame);
+        }
+
+        vkCmdResetQueryPool(commandBuffer, frame.mQueryPool, 0, m_maxScopes * 2);
+        if (frame.mStatisticsPool != VK_NULL_HANDLE)
+        {
+            vkCmdResetQueryPool(commandBuffer, frame.mStatisticsPool, 0, m_maxScopes);
+        }
+        frame.mNames.clear();
+        frame.mDepths.clear();
+        frame.mHasStatistics.clear();
+        frame.mIsRecorded = true;
+        m_currentFrame = frameIndex;
+        m_depth = 0;
+        m_statisticsScope = UINT32_MAX;
+    }
+
+    uint32_t GpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char* name, bool isStatistics) noexcept
+    {
+        // labels are recorded even without timestamp support
+        VulkanDebugLabel::begin(commandBuffer, name);
+        if (!isValid())
+        {
+            return UINT32_MAX;
+        }
+
+        // scopes past the pool size are dropped
+        auto& frame = m_frames[m_currentFrame];
+        const uint32_t scopeIndex = static_cast<uint32_t>(frame.mNames.size());
+        if (scopeIndex >= m_maxScopes)
+        {
+            return UINT32_MAX;
+        }
+
+        frame.mNames.emplace_back(name);
+        frame.mDepths.push_back(m_depth++);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.mQueryPool, scopeIndex * 2);
+
+        // one statistics query may be active at a time
+        const bool hasStatistics = isStatistics && frame.mStatisticsPool != VK_NULL_HANDLE && m_statisticsScope == UINT32_MAX;
+        frame.mHasStatistics.push_back(hasStatistics ? 1 : 0);
+        if (hasStatistics)
+        {
+            vkCmdBeginQuery(commandBuffer, frame.mStatisticsPool, scopeIndex, 0);
+            m_statisticsScope = scopeIndex;
+        }
+        return scopeIndex;
+    }
+
+    void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex) noexcept
+    {
+        VulkanDebugLabel::end(commandBuffer);
+        if (!isValid() || scopeIndex >= m_maxScopes)
+        {
+            return;
+        }
+
+        m_depth = (m_depth > 0) ? m_depth - 1 : 0;
+        auto& frame = m_frames[m_currentFrame];
+        if (scopeIndex == m_statisticsScope)
+        {
+            vkCmdEndQuery(commandBuffer, frame.mStatisticsPool, scopeIndex);
+            m_statisticsScope = UINT32_MAX;
+        }
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.mQueryPool, scopeIndex * 2 + 1);
+    }
+
+    void GpuProfiler::resolveFrame(FrameQueries& frame) noexcept
+    {
+        const uint32_t scopeCount = static_cast<uint32_t>(frame.mNames.size());
+        if (scopeCount == 0)
+        {
+            return;
+        }
+
+        // value + availability pairs; no wait bit, results not yet available are skipped
+        std::vector<uint64_t> queryData(scopeCount * 2 * 2, 0);
+        VkResult vkResult = vkGetQueryPoolResults(m_vkDevice, frame.mQueryPool, 0, scopeCount * 2, queryData.size() * sizeof(uint64_t), 
+                                                  queryData.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (vkResult != VK_SUCCESS && vkResult != VK_NOT_READY)
+        {
+            VK_LOG_ERROR_THROTTLED("vkGetQueryPoolResults failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return;
+        }
+
+        // a different scope layout starts the averages over
+        bool isSameLayout = m_results.size() == scopeCount;
+        for (uint32_t i = 0; isSameLayout && i < scopeCount; ++i)
+        {
+            isSameLayout = m_results[i].mName == frame.mNames[i];
+        }
+
+        if (!isSameLayout)
+        {
+            m_results.resize(scopeCount);
+            for (uint32_t i = 0; i < scopeCount; ++i)
+            {
+                m_results[i] = GpuProfileResult{ frame.mNames[i], frame.mDepths[i], 0.0f, 0.0f };
+            }
+        }
+
+        for (uint32_t i = 0; i < scopeCount; ++i)
+        {
+            const uint64_t* begin = &queryData[i * 4];
+            const uint64_t* end   = &queryData[i * 4 + 2];
+            if (begin[1] == 0 || end[1] == 0)
+            {
+                continue;
+            }
+
+            const uint64_t ticks = ((end[0] & m_timestampMask) - (begin[0] & m_timestampMask)) & m_timestampMask;
+            auto& result = m_results[i];
+            result.mMilliseconds = static_cast<float>(static_cast<double>(ticks) * m_timestampPeriod * 1e-6);
+            result.mAverageMilliseconds = (result.mAverageMilliseconds == 0.0f) ? result.mMilliseconds 
+                                        : result.mAverageMilliseconds + (result.mMilliseconds - result.mAverageMilliseconds) * kResultSmoothing;
+        }
+
+        if (frame.mStatisticsPool != VK_NULL_HANDLE)
+        {
+            resolveStatistics(frame);
+        }
+    }
+
+    void GpuProfiler::resolveStatistics(const FrameQueries& frame) noexcept
+    {
+        // statistics + availability per scope, scopes that did not query stay unavailable
+        const uint32_t scopeCount = static_cast<uint32_t>(frame.mNames.size());
+        constexpr uint32_t kStride = kStatisticCount + 1;
+        std::vector<uint64_t> queryData(scopeCount * kStride, 0);
+        VkResult vkResult = vkGetQueryPoolResults(m_vkDevice, frame.mStatisticsPool, 0, scopeCount, queryData.size() * sizeof(uint64_t),
+                                                  queryData.data(), kStride * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (vkResult != VK_SUCCESS && vkResult != VK_NOT_READY)
+        {
+            VK_LOG_ERROR_THROTTLED("vkGetQueryPoolResults failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return;
+        }
+
+        for (uint32_t i = 0; i < scopeCount; ++i)
+        {
+            auto& result = m_results[i];
+            result.mHasStatistics = frame.mHasStatistics[i] != 0;
+            const uint64_t* values = &queryData[i * kStride];
+            if (!result.mHasStatistics || values[kStatisticCount] == 0)
+            {
+                continue;
+            }
+
+            result.mStatistics.mInputPrimitives     = values[0];
+            result.mStatistics.mVertexInvocations   = values[1];
+            result.mStatistics.mClippingInvocations = values[2];
+            result.mStatistics.mClippingPrimitives  = values[3];
+            result.mStatistics.mFragmentInvocations = values[4];
+            result.mStatistics.mComputeInvocations  = values[5];
+        }
+    }
+
+    bool GpuProfiler::exportCsv(const std::filesystem::path& filepath) const noexcept
+    {
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            VK_LOG_ERROR("GpuProfiler::exportCsv : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        file << "scope,depth,gpu_ms,gpu_avg_ms,input_primitives,vertex_invocations,clipping_invocations,clipping_primitives,fragment_invocations,"
+                "compute_invocations\n";
+        for (const auto& result : m_results)
+        {
+            file << result.mName << ',' << result.mDepth << ',' << result.mMilliseconds << ',' << result.mAverageMilliseconds;
+            if (result.mHasStatistics)
+            {
+                const GpuPipelineStatistics& statistics = result.mStatistics;
+                file << ',' << statistics.mInputPrimitives << ',' << statistics.mVertexInvocations << ',' << statistics.mClippingInvocations
+                     << ',' << statistics.mClippingPrimitives << ',' << statistics.mFragmentInvocations << ',' << statistics.mComputeInvocations << '\n';
+            }
+            else
+            {
+                file << ",,,,,,\n";
+            }
+        }
+
+        VK_LOG_INFO("GpuProfiler::exportCsv : %zu scopes written to %s", m_results.size(), filepath.string().c_str());
+        return static_cast<bool>(file);
+    }
+}   // namespace keplar
@@ -0,0 +1,138 @@
+// ────────────────────────────────────────────
+//  File: gpu_profiler.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "vulkan/vulkan_config.hpp"
+#include "utils/profiler.hpp"
+
+// cpu zone plus gpu timestamp scope and debug label of the same name, so cpu traces and gpu captures line up
+#define KEPLAR_GPU_ZONE(profiler, commandBuffer, name) \
+    KEPLAR_PROFILE_ZONE(name); \
+    keplar::GpuProfiler::Scope KEPLAR_PROFILE_CONCAT(_gpuZone, __LINE__)(profiler, commandBuffer, name)
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // pipeline statistics of one scope, in the order the query writes them (GpuProfiler::kPipelineStatistics)
+    struct GpuPipelineStatistics
+    {
+        uint64_t mInputPrimitives     = 0;  // primitives the input assembler read
+        uint64_t mVertexInvocations   = 0;
+        uint64_t mClippingInvocations = 0;  // primitives that reached clipping
+        uint64_t mClippingPrimitives  = 0;  // and that it output (culled ones excluded)
+        uint64_t mFragmentInvocations = 0;
+        uint64_t mComputeInvocations  = 0;
+    };
+
+    // gpu time of one profiled scope, in milliseconds
+    struct GpuProfileResult
+    {
+        std::string             mName;
+        uint32_t                mDepth;                         // nesting level of the scope
+        float                   mMilliseconds;                  // latest resolved frame
+        float                   mAverageMilliseconds;           // smoothed over frames
+        GpuPipelineStatistics   mStatistics{};                  // latest resolved frame, when mHasStatistics
+        bool                    mHasStatistics = false;
+    };
+
+    // timestamp query scopes (mirrored as debug utils labels) with one query pool per frame in flight. beginFrame() resolves the slot's previous
+    // queries without waiting (they completed once the slot's fence or timeline value was reached; unavailable
+    // results keep the last values) and resets the pool, then Scope/beginScope/endScope bracket gpu work.
+    // where the device enables pipelineStatisticsQuery, scopes begun with isStatistics also count what the gpu
+    // processed in them in a second pool per frame. statistics queries cannot nest, so a statistics scope inside another
+    // only gets its timestamps; a scope that executes secondaries needs getInheritedStatistics in their inheritance info
+    class GpuProfiler final
+    {
+        public:
+            static constexpr VkQueryPipelineStatisticFlags kPipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+                                                                                  VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                                                                                  VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+                                                                                  VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                                                                                  VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+                                                                                  VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+            // raii scope: begin timestamp on construction, end timestamp on destruction
+            class Scope final
+            {
+                public:
+                    Scope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name) noexcept;
+                    ~Scope();
+
+                    // disable copy and move semantics to enforce unique ownership
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+                    Scope(Scope&&) = delete;
+                    Scope& operator=(Scope&&) = delete;
+
+                private:
+                    GpuProfiler&    m_profiler;
+                    VkCommandBuffer m_vkCommandBuffer;
+                    uint32_t        m_scopeIndex;
+            };
+
+            // creation and destruction
+            GpuProfiler() noexcept;
+            ~GpuProfiler();
+
+            // disable copy and move semantics to enforce unique ownership
+            GpuProfiler(const GpuProfiler&) = delete;
+            GpuProfiler& operator=(const GpuProfiler&) = delete;
+            GpuProfiler(GpuProfiler&&) = delete;
+            GpuProfiler& operator=(GpuProfiler&&) = delete;
+
+            // fails when the graphics queue family has no timestamp support
+            bool initialize(const VulkanDevice& device, uint32_t frameCount, uint32_t maxScopes = 32) noexcept;
+            void destroy() noexcept;
+
+            // usage: record beginFrame outside a render pass, before any scope of the frame
+            void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept;
+            uint32_t beginScope(VkCommandBuffer commandBuffer, const char* name, bool isStatistics = false) noexcept;
+            void endScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex) noexcept;
+
+            // usage: results as csv (name, depth, latest ms, average ms, then the pipeline statistics, empty where not queried)
+            bool exportCsv(const std::filesystem::path& filepath) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept                                   { return !m_frames.empty(); }
+            bool isStatisticsEnabled() const noexcept                       { return m_isStatisticsEnabled; }
+            const std::vector<GpuProfileResult>& getResults() const noexcept { return m_results; }
+            // pipelineStatistics of secondaries executed inside a statistics scope (0: such scopes skip their statistics)
+            VkQueryPipelineStatisticFlags getInheritedStatistics() const noexcept { return m_isStatisticsInherited ? kPipelineStatistics : 0; }
+
+        private:
+            // scopes recorded into one frame slot's query pool
+            struct FrameQueries
+            {
+                VkQueryPool                 mQueryPool = VK_NULL_HANDLE;
+                VkQueryPool                 mStatisticsPool = VK_NULL_HANDLE;   // one query per scope, when enabled
+                std::vector<std::string>    mNames;
+                std::vector<uint32_t>       mDepths;
+                std::vector<uint8_t>        mHasStatistics;                     // per scope, its statistics query was begun
+                bool                        mIsRecorded = false;
+            };
+
+            void resolveFrame(FrameQueries& frame) noexcept;
+            void resolveStatistics(const FrameQueries& frame) noexcept;
+
+        private:
+            VkDevice                        m_vkDevice;
+            std::vector<FrameQueries>       m_frames;
+            uint32_t                        m_currentFrame;
+            uint32_t                        m_maxScopes;
+            uint32_t                        m_depth;
+            uint32_t                        m_statisticsScope;      // scope whose statistics query is active, UINT32_MAX for none
+            bool                            m_isStatisticsEnabled;
+            bool                            m_isStatisticsInherited; // inheritedQueries enabled too
+            float                           m_timestampPeriod;      // ns per tick
+            uint64_t                        m_timestampMask;        // valid bits of the graphics queue family
+            std::vector<GpuProfileResult>   m_results;
+    };
+}   // namespace keplar
@@ -0,0 +1,262 @@
+// ────────────────────────────────────────────
+//  File: gpu_skinning.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "gpu_skinning.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // preferred workgroup size, specialized into local_size_x_id in skinning.comp (clamped to device limits)
+    constexpr uint32_t kWorkgroupSize = 64;
+    constexpr uint32_t kWorkgroupSizeConstantId = 0;
+
+    // descriptor bindings (set: 0)
+    constexpr uint32_t kRestVertexBinding    = 0;
+    constexpr uint32_t kSkinVertexBinding    = 1;
+    constexpr uint32_t kJointMatrixBinding   = 2;
+    constexpr uint32_t kSkinnedVertexBinding = 3;
+    constexpr uint32_t kMorphRangeBinding    = 4;
+    constexpr uint32_t kMorphDeltaBinding    = 5;
+    constexpr uint32_t kMorphWeightBinding   = 6;
+    constexpr uint32_t kBindingCount         = 7;
+
+    // push constants: dispatch parameters
+    struct SkinPushConstants
+    {
+        uint32_t vertexCount;
+        uint32_t isMorphed;
+    };
+}
+
+namespace keplar
+{
+    GpuSkinning::GpuSkinning() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_workgroupSize(kWorkgroupSize)
+    {
+    }
+
+    GpuSkinning::~GpuSkinning()
+    {
+        destroy();
+    }
+
+    bool GpuSkinning::initialize(const VulkanDevice& device, const std::string& spirvFile, uint32_t frameCount) noexcept
+    {
+        m_vkDevice = device.getDevice();
+
+        if (!createDescriptorResources(frameCount) || !createPipeline(device, spirvFile))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("GpuSkinning::initialize successful");
+        return true;
+    }
+
+    void GpuSkinning::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // descriptor sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDescriptorSets.clear();
+
+        if (m_vkDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(m_vkDevice, m_vkDescriptorSetLayout, nullptr);
+            m_vkDescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("gpu skinning pass destroyed successfully");
+    }
+
+    void GpuSkinning::bindBuffers(uint32_t frameIndex, VkBuffer restVertexBuffer, VkBuffer skinVertexBuffer, VkBuffer jointMatrixBuffer, 
+                                  VkBuffer skinnedVertexBuffer, VkBuffer morphRangeBuffer, VkBuffer morphDeltaBuffer, VkBuffer morphWeightBuffer) noexcept
+    {
+        if (frameIndex >= m_vkDescriptorSets.size())
+        {
+            return;
+        }
+
+        // without morph targets the bind-pose vertices stand in for their bindings, which are then never read
+        const bool hasMorphTargets = morphRangeBuffer != VK_NULL_HANDLE && morphDeltaBuffer != VK_NULL_HANDLE && morphWeightBuffer != VK_NULL_HANDLE;
+
+        // whole-buffer ranges for each storage binding
+        const std::array<VkDescriptorBufferInfo, kBindingCount> bufferInfos
+        {{
+            { restVertexBuffer,    0, VK_WHOLE_SIZE },
+            { skinVertexBuffer,    0, VK_WHOLE_SIZE },
+            { jointMatrixBuffer,   0, VK_WHOLE_SIZE },
+            { skinnedVertexBuffer, 0, VK_WHOLE_SIZE },
+            { hasMorphTargets ? morphRangeBuffer : restVertexBuffer,  0, VK_WHOLE_SIZE },
+            { hasMorphTargets ? morphDeltaBuffer : restVertexBuffer,  0, VK_WHOLE_SIZE },
+            { hasMorphTargets ? morphWeightBuffer : restVertexBuffer, 0, VK_WHOLE_SIZE }
+        }};
+
+        std::array<VkWriteDescriptorSet, kBindingCount> writes{};
+        for (uint32_t i = 0; i < writes.size(); ++i)
+        {
+            writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].pNext            = nullptr;
+            writes[i].dstSet           = m_vkDescriptorSets[frameIndex];
+            writes[i].dstBinding       = i;
+            writes[i].dstArrayElement  = 0;
+            writes[i].descriptorCount  = 1;
+            writes[i].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pImageInfo       = nullptr;
+            writes[i].pBufferInfo      = &bufferInfos[i];
+            writes[i].pTexelBufferView = nullptr;
+        }
+
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void GpuSkinning::record(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t vertexCount, bool isMorphed) const noexcept
+    {
+        if (!isValid() || frameIndex >= m_vkDescriptorSets.size() || vertexCount == 0)
+        {
+            return;
+        }
+
+        // joint matrices and morph weights are written by the host before submission; the submit makes them visible
+        SkinPushConstants pushConstants{};
+        pushConstants.vertexCount = vertexCount;
+        pushConstants.isMorphed   = isMorphed ? 1u : 0u;
+
+        // one invocation per skinned vertex
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSets[frameIndex], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SkinPushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (vertexCount + m_workgroupSize - 1) / m_workgroupSize, 1, 1);
+
+        // make skinned vertices visible to vertex input
+        VkMemoryBarrier skinBarrier{};
+        skinBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        skinBarrier.pNext         = nullptr;
+        skinBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        skinBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &skinBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    bool GpuSkinning::createDescriptorResources(uint32_t frameCount) noexcept
+    {
+        // set: 0, bindings: bind-pose vertices, influences, joint matrices (read), skinned vertices (write), morph delta runs,
+        // deltas and weights (read)
+        std::array<VkDescriptorSetLayoutBinding, kBindingCount> bindings
+        {{
+            { kRestVertexBinding,    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kSkinVertexBinding,    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kJointMatrixBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kSkinnedVertexBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kMorphRangeBinding,    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kMorphDeltaBinding,    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kMorphWeightBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = nullptr;
+        layoutInfo.flags        = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings    = bindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &m_vkDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GpuSkinning :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // private pool sized for one set per frame
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSize.descriptorCount = static_cast<uint32_t>(bindings.size()) * frameCount;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = frameCount;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes    = &poolSize;
+
+        vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GpuSkinning :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        std::vector<VkDescriptorSetLayout> layouts(frameCount, m_vkDescriptorSetLayout);
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = frameCount;
+        allocateInfo.pSetLayouts        = layouts.data();
+
+        m_vkDescriptorSets.resize(frameCount, VK_NULL_HANDLE);
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, m_vkDescriptorSets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("GpuSkinning :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorSets.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GpuSkinning::createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept
+    {
+        // missing spir-v is not fatal; callers fall back to bind-pose vertices
+        VulkanShader computeShader;
+        if (!computeShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, spirvFile))
+        {
+            VK_LOG_WARN("GpuSkinning :: compute shader '%s' unavailable", spirvFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = computeShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkDescriptorSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SkinPushConstants) } };
+
+        // local_size_x is a specialization constant so the workgroup size can follow the device
+        const VkPhysicalDeviceLimits& limits = device.getPhysicalDeviceProperties().limits;
+        m_workgroupSize = std::min({ kWorkgroupSize, limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations });
+        pipelineConfig.addSpecializationConstant(kWorkgroupSizeConstantId, m_workgroupSize);
+
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("GpuSkinning :: failed to create compute pipeline");
+            return false;
+        }
+
+        return true;
+    }
+}   // namespace keplar
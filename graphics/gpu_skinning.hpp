@@ -0,0 +1,64 @@
+// ────────────────────────────────────────────
+//  File: gpu_skinning.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // compute pass that skins a bind-pose vertex pool with per-frame joint matrices into a vertex buffer.
+    // one descriptor set per frame in flight, so joint uploads and outputs never alias an in-flight frame.
+    // morph targets blend into the bind pose first, in the same invocation: each vertex walks its own run of sparse
+    // deltas and skips those whose target weighs zero, so unmorphed vertices cost one range read.
+    class GpuSkinning final
+    {
+        public:
+            // creation and destruction
+            GpuSkinning() noexcept;
+            ~GpuSkinning();
+
+            // disable copy and move semantics to enforce unique ownership
+            GpuSkinning(const GpuSkinning&) = delete;
+            GpuSkinning& operator=(const GpuSkinning&) = delete;
+            GpuSkinning(GpuSkinning&&) = delete;
+            GpuSkinning& operator=(GpuSkinning&&) = delete;
+
+            bool initialize(const VulkanDevice& device, const std::string& spirvFile, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: point a frame's set at the bind-pose vertices, influences, joint matrices and skinned output, and the
+            // morph delta runs, deltas and target weights when the pool has any (see GLTFModel::hasMorphTargets)
+            void bindBuffers(uint32_t frameIndex, VkBuffer restVertexBuffer, VkBuffer skinVertexBuffer, VkBuffer jointMatrixBuffer, 
+                             VkBuffer skinnedVertexBuffer, VkBuffer morphRangeBuffer = VK_NULL_HANDLE, VkBuffer morphDeltaBuffer = VK_NULL_HANDLE,
+                             VkBuffer morphWeightBuffer = VK_NULL_HANDLE) noexcept;
+
+            // usage: record outside a render pass, before the draws that read the skinned vertices; isMorphed while any
+            // bound target weighs more than zero
+            void record(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t vertexCount, bool isMorphed = false) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && !m_vkDescriptorSets.empty(); }
+
+        private:
+            bool createDescriptorResources(uint32_t frameCount) noexcept;
+            bool createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkDescriptorSetLayout           m_vkDescriptorSetLayout;
+            VkDescriptorPool                m_vkDescriptorPool;
+            std::vector<VkDescriptorSet>    m_vkDescriptorSets;
+            VulkanPipeline                  m_pipeline;
+            uint32_t                        m_workgroupSize;
+    };
+}   // namespace keplar
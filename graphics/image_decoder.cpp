@@ -0,0 +1,192 @@
+// ────────────────────────────────────────────
+//  File: image_decoder.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "image_decoder.hpp"
+
+#include <cstring>
+#include <limits>
+
+#ifdef KEPLAR_HAS_TURBOJPEG
+    #include <turbojpeg.h>
+#endif
+
+#ifdef KEPLAR_HAS_SPNG
+    #include <spng.h>
+#endif
+
+#include "asset_io.hpp"
+
+namespace
+{
+    // file signatures the dedicated decoders are picked by
+    constexpr uint8_t kJpegSignature[3] = { 0xFF, 0xD8, 0xFF };
+    constexpr uint8_t kPngSignature[8]  = { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    // larger images are rejected before any allocation
+    constexpr uint32_t kMaxDimension = 16384;
+
+    bool hasSignature(const uint8_t* data, size_t size, const uint8_t* signature, size_t signatureSize) noexcept
+    {
+        return data != nullptr && size >= signatureSize && std::memcmp(data, signature, signatureSize) == 0;
+    }
+
+    [[maybe_unused]] bool isJpeg(const uint8_t* data, size_t size) noexcept { return hasSignature(data, size, kJpegSignature, sizeof(kJpegSignature)); }
+    [[maybe_unused]] bool isPng(const uint8_t* data, size_t size) noexcept  { return hasSignature(data, size, kPngSignature, sizeof(kPngSignature)); }
+
+    bool isValidExtent(uint32_t width, uint32_t height) noexcept
+    {
+        return width > 0 && height > 0 && width <= kMaxDimension && height <= kMaxDimension;
+    }
+
+#ifdef KEPLAR_HAS_TURBOJPEG
+    // one decompressor per thread, reused across images
+    struct TurboJpegHandle
+    {
+        tjhandle mHandle = tjInitDecompress();
+        ~TurboJpegHandle() { if (mHandle) { tjDestroy(mHandle); } }
+    };
+
+    bool decodeTurboJpeg(const uint8_t* data, size_t size, bool flipY, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) noexcept
+    {
+        thread_local TurboJpegHandle tl_decompressor;
+        int jpegWidth = 0;
+        int jpegHeight = 0;
+        int subsampling = 0;
+        int colorspace = 0;
+        if (!tl_decompressor.mHandle || size > std::numeric_limits<unsigned long>::max() ||
+            tjDecompressHeader3(tl_decompressor.mHandle, data, static_cast<unsigned long>(size), &jpegWidth, &jpegHeight, &subsampling, &colorspace) != 0 ||
+            !isValidExtent(static_cast<uint32_t>(jpegWidth), static_cast<uint32_t>(jpegHeight)))
+        {
+            return false;
+        }
+
+        // the color conversion writes rgba directly, bottom-up rows give the flip for free
+        pixels.resize(static_cast<size_t>(jpegWidth) * jpegHeight * 4);
+        const int flags = flipY ? TJFLAG_BOTTOMUP : 0;
+        if (tjDecompress2(tl_decompressor.mHandle, data, static_cast<unsigned long>(size), pixels.data(), jpegWidth, 0, jpegHeight, TJPF_RGBA, flags) != 0)
+        {
+            return false;
+        }
+
+        width  = static_cast<uint32_t>(jpegWidth);
+        height = static_cast<uint32_t>(jpegHeight);
+        return true;
+    }
+#endif
+
+#ifdef KEPLAR_HAS_SPNG
+    bool decodeSpng(const uint8_t* data, size_t size, bool flipY, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) noexcept
+    {
+        spng_ctx* context = spng_ctx_new(0);
+        if (!context)
+        {
+            return false;
+        }
+
+        // rows are decoded one at a time straight into their final (possibly flipped) place
+        spng_ihdr header{};
+        size_t imageSize = 0;
+        bool isDecoded = spng_set_image_limits(context, kMaxDimension, kMaxDimension) == 0 && spng_set_png_buffer(context, data, size) == 0 &&
+                         spng_get_ihdr(context, &header) == 0 && isValidExtent(header.width, header.height) &&
+                         spng_decoded_image_size(context, SPNG_FMT_RGBA8, &imageSize) == 0 &&
+                         spng_decode_image(context, nullptr, 0, SPNG_FMT_RGBA8, SPNG_DECODE_TRNS | SPNG_DECODE_PROGRESSIVE) == 0;
+        if (isDecoded)
+        {
+            const size_t rowSize = static_cast<size_t>(header.width) * 4;
+            pixels.resize(imageSize);
+            int result = 0;
+            spng_row_info rowInfo{};
+            while ((result = spng_get_row_info(context, &rowInfo)) == 0)
+            {
+                const size_t row = flipY ? header.height - 1 - rowInfo.row_num : rowInfo.row_num;
+                result = spng_decode_row(context, pixels.data() + row * rowSize, rowSize);
+                if (result != 0)
+                {
+                    break;
+                }
+            }
+            isDecoded = result == SPNG_EOI;
+        }
+
+        spng_ctx_free(context);
+        if (isDecoded)
+        {
+            width  = header.width;
+            height = header.height;
+        }
+        return isDecoded;
+    }
+#endif
+
+    bool decodeStb(const uint8_t* data, size_t size, bool flipY, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) noexcept
+    {
+        if (size > static_cast<size_t>(std::numeric_limits<int>::max()))
+        {
+            return false;
+        }
+
+        // flip state is per thread, images may be decoded on worker threads
+        int stbWidth = 0;
+        int stbHeight = 0;
+        int channels = 0;
+        stbi_set_flip_vertically_on_load_thread(flipY ? 1 : 0);
+        stbi_uc* decoded = stbi_load_from_memory(data, static_cast<int>(size), &stbWidth, &stbHeight, &channels, STBI_rgb_alpha);
+        if (!decoded || !isValidExtent(static_cast<uint32_t>(stbWidth), static_cast<uint32_t>(stbHeight)))
+        {
+            if (decoded) { stbi_image_free(decoded); }
+            return false;
+        }
+
+        width  = static_cast<uint32_t>(stbWidth);
+        height = static_cast<uint32_t>(stbHeight);
+        pixels.assign(decoded, decoded + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(decoded);
+        return true;
+    }
+}
+
+namespace keplar::image_decoder
+{
+    const char* getBackendName(const uint8_t* data, size_t size) noexcept
+    {
+    #ifdef KEPLAR_HAS_TURBOJPEG
+        if (isJpeg(data, size))
+        {
+            return "libjpeg-turbo";
+        }
+    #endif
+    #ifdef KEPLAR_HAS_SPNG
+        if (isPng(data, size))
+        {
+            return "spng";
+        }
+    #endif
+        (void)data;
+        (void)size;
+        return "stb_image";
+    }
+
+    bool decodeRGBA8(const uint8_t* data, size_t size, bool flipY, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) noexcept
+    {
+        if (data == nullptr || size == 0)
+        {
+            return false;
+        }
+
+        // a dedicated decoder that rejects the data (an unsupported colorspace, a truncated file) leaves it to stb
+    #ifdef KEPLAR_HAS_TURBOJPEG
+        if (isJpeg(data, size) && decodeTurboJpeg(data, size, flipY, pixels, width, height))
+        {
+            return true;
+        }
+    #endif
+    #ifdef KEPLAR_HAS_SPNG
+        if (isPng(data, size) && decodeSpng(data, size, flipY, pixels, width, height))
+        {
+            return true;
+        }
+    #endif
+        return decodeStb(data, size, flipY, pixels, width, height);
+    }
+}   // namespace keplar::image_decoder
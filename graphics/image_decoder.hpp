@@ -0,0 +1,22 @@
+// ────────────────────────────────────────────
+//  File: image_decoder.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 8-bit image decoding for textures. jpeg goes through libjpeg-turbo (KEPLAR_HAS_TURBOJPEG) and png through spng
+// (KEPLAR_HAS_SPNG) when the build finds them, everything else and every failure of those through stb_image.
+// every backend expands to rgba8 and flips while it writes the rows, so there is no conversion pass afterwards;
+// srgb stays encoded in the bytes and is resolved by the image format on the gpu
+namespace keplar::image_decoder
+{
+    // backend that decodes this data: "libjpeg-turbo", "spng" or "stb_image"
+    const char* getBackendName(const uint8_t* data, size_t size) noexcept;
+
+    // decode into pixels, resized to width * height * 4 bytes, rows top first unless flipY. safe to call from worker threads
+    bool decodeRGBA8(const uint8_t* data, size_t size, bool flipY, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) noexcept;
+}   // namespace keplar::image_decoder
@@ -27,14 +27,13 @@ namespace keplar
         , m_vkDevice(VK_NULL_HANDLE)
         , m_vkInstance(VK_NULL_HANDLE)
         , m_initInfo{}
+        , m_isVisible(true)
+        , m_hasDraws(false)
     {
     }
 
     ImGuiLayer::~ImGuiLayer()
     {
-        // destroy vulkan resources 
-        m_commandPool.deallocate(m_commandBuffers);
-
         // shutdown imgui backend
         ImGui_ImplVulkan_Shutdown();
         ImGui_ImplWin32_Shutdown();
@@ -57,14 +56,16 @@ namespace keplar
         m_vkDevice = device->getDevice();
         m_queueFamily = device->getQueueFamilyIndices().mGraphicsFamily.value();
         m_imageCount = m_swapchain.getImageCount();
-        m_imageExtent = m_swapchain.getExtent();
         m_maxFramesInFlight = maxFramesInFlight;
 
         // initialize vulkan resources for imgui
         if (!createResourcePool())                       { return false; }
-        if (!createCommandBuffers())                     { return false; }
         if (!createRenderPass())                         { return false; } 
-        if (!createFramebuffers())                       { return false; }
+        if (!m_frameArena.initialize(kFrameArenaSize))
+        {
+            VK_LOG_ERROR("ImGuiLayer::initialize : failed to allocate the frame arena");
+            return false;
+        }
         if (!createImGuiBackend(platform, *device))      { return false; }
 
         VK_LOG_DEBUG("ImGuiLayer::initialize successful");
@@ -73,23 +74,32 @@ namespace keplar
     
     void ImGuiLayer::recreate(uint32_t maxFramesInFlight) noexcept
     {
-        // teardown vulkan resources
-        m_framebuffers.clear();
+        // blocking: the backend pipeline is replaced in place, so no frame may still use it
         m_renderPass.destroy();
-        m_commandPool.deallocate(m_commandBuffers);
 
-        // store vulkan handles and swapchain info
+        // store swapchain info
         m_imageCount  = m_swapchain.getImageCount();
-        m_imageExtent = m_swapchain.getExtent();
         m_maxFramesInFlight = maxFramesInFlight;
 
-        // recreate vulkan resources
-        if (!createCommandBuffers())  { return; }
+        // recreate the compatibility pass (the swapchain format may have changed) and the pipeline built for it
         if (!createRenderPass())      { return; } 
-        if (!createFramebuffers())    { return; }
-        
-        // reset render pass to imgui
         m_initInfo.PipelineInfoMain.RenderPass = m_renderPass.get();
+        m_initInfo.PipelineInfoMain.Subpass    = 0;
+        ImGui_ImplVulkan_CreateMainPipeline(&m_initInfo.PipelineInfoMain);
+    }
+
+    void ImGuiLayer::setTargetPass(VkRenderPass renderPass, uint32_t subpass) noexcept
+    {
+        if (renderPass == VK_NULL_HANDLE)
+        {
+            renderPass = m_renderPass.get();
+            subpass = 0;
+        }
+
+        // blocking: the backend pipeline is replaced in place
+        m_initInfo.PipelineInfoMain.RenderPass = renderPass;
+        m_initInfo.PipelineInfoMain.Subpass    = subpass;
+        ImGui_ImplVulkan_CreateMainPipeline(&m_initInfo.PipelineInfoMain);
     }
 
     void ImGuiLayer::renderControlPanel() noexcept
@@ -105,9 +115,9 @@ namespace keplar
         ImGui::Begin("Render Control Panel", nullptr, window_flags);
 
         // invoke registered imgui widgets
-        for (auto& widgetCallback : m_widgetCallbacks)
+        for (const auto& widget : m_widgets)
         {
-            widgetCallback();
+            widget(m_frameArena);
         }
 
         if (ImGui::TreeNodeEx("About", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
@@ -121,6 +131,8 @@ namespace keplar
             ImGui::BulletText("TinyGLTF - glTF 3D model loading");
             ImGui::BulletText("GLM - Mathematics library");
             ImGui::Separator();
+            ImGui::TextWrapped("F1 hides and shows this panel.");
+            ImGui::Separator();
             ImGui::TextWrapped("© 2025 Yash Patel");
             ImGui::TreePop();
         }
@@ -129,76 +141,67 @@ namespace keplar
         ImGui::End();
     }
 
-    VkCommandBuffer ImGuiLayer::recordFrame(uint32_t frameIndex, uint32_t imageIndex) noexcept
+    bool ImGuiLayer::buildFrame() noexcept
     {
-        // validate frame index
-        if (frameIndex >= m_commandBuffers.size())
-        {
-            return VK_NULL_HANDLE;
-        }
-
-        // start a new imgui frame
+        // start a new imgui frame; input is still processed while the panel is hidden
         ImGui_ImplVulkan_NewFrame();
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
 
-        renderControlPanel();
+        // the previous frame's labels were consumed when its draw data was built
+        m_frameArena.reset();
+
+        if (ImGui::IsKeyPressed(ImGuiKey_F1, false))
+        {
+            m_isVisible = !m_isVisible;
+        }
+
+        if (m_isVisible)
+        {
+            renderControlPanel();
+        }
 
-        // retrieve imgui draw data
+        // retrieve imgui draw data; nothing to draw (hidden, minimized) records nothing at all
         ImGui::Render();
         ImDrawData* drawData = ImGui::GetDrawData();
-        if (drawData == NULL)
+        m_hasDraws = drawData != nullptr && drawData->TotalVtxCount > 0 && drawData->DisplaySize.x > 0.0f && drawData->DisplaySize.y > 0.0f;
+        if (!m_hasDraws)
         {
-            return VK_NULL_HANDLE;
+            return false;
         }
 
-        // begin recording 
-        auto& commandBuffer = m_commandBuffers[frameIndex];
-        commandBuffer.reset();
-        commandBuffer.begin();
-
-        VkClearValue clearValue = { 0.0f, 0.0f, 0.0f, 1.0f };
-        VkRenderPassBeginInfo renderPassInfo{};
-        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = m_renderPass.get();
-        renderPassInfo.framebuffer = m_framebuffers[imageIndex].get();
-        renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = m_imageExtent;
-        renderPassInfo.clearValueCount = 1;
-        renderPassInfo.pClearValues = &clearValue;
-
-        commandBuffer.beginRenderPass(renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        // render imgui draw data
-        ImGui_ImplVulkan_RenderDrawData(drawData, commandBuffer.get());
-
-        // end recording 
-        commandBuffer.endRenderPass();
-        commandBuffer.end();
-        return commandBuffer.get();
+        // texture uploads submit to the graphics queue: run them here, on the thread that prepares frames, rather
+        // than from inside the frame recording
+        if (drawData->Textures != nullptr)
+        {
+            for (ImTextureData* texture : *drawData->Textures)
+            {
+                if (texture->Status != ImTextureStatus_OK)
+                {
+                    ImGui_ImplVulkan_UpdateTexture(texture);
+                }
+            }
+        }
+        return true;
     }
 
-    void ImGuiLayer::registerWidget(std::function<void()> callback)
+    void ImGuiLayer::recordDraws(VkCommandBuffer commandBuffer) const noexcept
     {
-        m_widgetCallbacks.emplace_back(callback);
+        // the draw data stays valid until the next buildFrame; the backend uploads it into its next vertex buffers
+        if (!m_hasDraws)
+        {
+            return;
+        }
+        ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
     }
 
-    bool ImGuiLayer::createResourcePool() noexcept
+    void ImGuiLayer::registerWidget(Widget widget)
     {
-        // command pool creation info
-        VkCommandPoolCreateInfo vkCommandPoolCreateInfo{};
-        vkCommandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        vkCommandPoolCreateInfo.pNext = nullptr;
-        vkCommandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        vkCommandPoolCreateInfo.queueFamilyIndex = m_queueFamily;
-
-        // setup command pool
-        if (!m_commandPool.initialize(m_vkDevice, vkCommandPoolCreateInfo))
-        {
-            VK_LOG_ERROR("ImGuiLayer::createResourcePool : failed to initialize command pool.");
-            return false;
-        }
+        m_widgets.push_back(std::move(widget));
+    }
 
+    bool ImGuiLayer::createResourcePool() noexcept
+    {
         // descriptor set requirements
         DescriptorRequirements requirements{};
         requirements.mMaxSets       = IMGUI_IMPL_VULKAN_MINIMUM_IMAGE_SAMPLER_POOL_SIZE;
@@ -218,21 +221,9 @@ namespace keplar
         return true;
     }
 
-    bool ImGuiLayer::createCommandBuffers() noexcept
-    {
-        // allocate command buffer per swapchain image
-        m_commandBuffers = m_commandPool.allocatePrimaries(m_maxFramesInFlight);
-        if (m_commandBuffers.empty())
-        {
-            VK_LOG_ERROR("ImGuiLayer::createCommandBuffers : failed to allocate command buffers.");
-            return false;
-        }
-
-        return true;
-    }
-
     bool ImGuiLayer::createRenderPass() noexcept
     {
+        // never begun: only its attachment format and sample count matter, for the render passes the overlay draws in
         // color attachment
         VkAttachmentDescription colorAttachment{};
         colorAttachment.flags          = 0;
@@ -243,7 +234,7 @@ namespace keplar
         colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
         // attachment reference 
         VkAttachmentReference colorAttachmentRef{};
@@ -277,41 +268,6 @@ namespace keplar
         return true;
     }
 
-    bool ImGuiLayer::createFramebuffers() noexcept
-    {
-        // get swapchain properties
-        const auto& swapchainImageViews = m_swapchain.getColorImageViews();
-        const auto& swapchainExtent     = m_swapchain.getExtent();
-        
-        // resize framebuffers
-        m_framebuffers.resize(m_imageCount);
-
-        // framebuffer creation info
-        VkFramebufferCreateInfo framebufferCreateInfo{};
-        framebufferCreateInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferCreateInfo.pNext           = nullptr;
-        framebufferCreateInfo.flags           = 0;
-        framebufferCreateInfo.renderPass      = m_renderPass.get();  
-        framebufferCreateInfo.attachmentCount = 1;
-        framebufferCreateInfo.width           = swapchainExtent.width;
-        framebufferCreateInfo.height          = swapchainExtent.height;
-        framebufferCreateInfo.layers          = 1;
-
-        for (uint32_t i = 0; i < m_imageCount; ++i)
-        {
-            // initialize framebuffer
-            const VkImageView attachment = swapchainImageViews[i];
-            framebufferCreateInfo.pAttachments = &attachment;
-            if (!m_framebuffers[i].initialize(m_vkDevice, framebufferCreateInfo))
-            {
-                VK_LOG_ERROR("ImGuiLayer::createFramebuffers failed at swapchain image index %u", i);
-                return false;
-            }
-        }
-
-        return true;
-    }
-
     bool ImGuiLayer::createImGuiBackend(const Platform& platform, const VulkanDevice& device) noexcept
     {
         // create imgui context
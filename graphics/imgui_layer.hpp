@@ -4,26 +4,37 @@
 
 #pragma once
 
-#include <functional>
+#include <vector>
 #include <imgui.h>
 
 #include "platform/platform.hpp"
+#include "utils/frame_arena.hpp"
+#include "utils/inplace_function.hpp"
 #include "vulkan/vulkan_context.hpp"
 #include "vulkan/vulkan_swapchain.hpp"
-#include "vulkan/vulkan_command_pool.hpp"
-#include "vulkan/vulkan_command_buffer.hpp"
 #include "vulkan/vulkan_descriptor_pool.hpp"
 #include "vulkan/vulkan_render_pass.hpp"
-#include "vulkan/vulkan_framebuffer.hpp"
 
 #include <backends/imgui_impl_vulkan.h>
 #include <backends/imgui_impl_win32.h>
 
 namespace keplar
 {
+    // the overlay draws into the last render pass of the frame instead of a pass of its own: buildFrame captures the
+    // ui on the thread that owns the renderer settings, recordDraws then blends it over the swapchain image inside any
+    // render pass compatible with getRenderPass() (one single-sampled color attachment of the swapchain format).
+    // a hidden panel (toggled with F1) or a minimized window records nothing, so the overlay costs no gpu time.
+    // widgets are stored inline and format their labels and values into a frame arena reset by every buildFrame, so
+    // building the ui does not touch the heap once imgui's own buffers have grown to the panel
     class ImGuiLayer 
     {
         public:
+            static constexpr size_t kWidgetCapacity   = 32;           // bytes a widget may capture
+            static constexpr size_t kFrameArenaSize   = 64 * 1024;
+
+            using Widget = InplaceFunction<void(FrameArena&), kWidgetCapacity>;
+
+
             // creation and destruction
             explicit ImGuiLayer(const VulkanSwapchain& swapchain) noexcept;
             ~ImGuiLayer();
@@ -32,16 +43,27 @@ namespace keplar
             bool initialize(const Platform& platform, const VulkanContext& context, uint32_t maxFramesInFlight) noexcept;
             void recreate(uint32_t maxFramesInFlight) noexcept;
 
-            // usage
-            VkCommandBuffer recordFrame(uint32_t frameIndex, uint32_t imageIndex) noexcept;
-            void registerWidget(std::function<void()> callback);
+            // usage: blocking, no frame in flight may draw the overlay. rebuilds the pipeline for a subpass that is not
+            // compatible with getRenderPass() (it must still write one single-sampled swapchain color attachment);
+            // VK_NULL_HANDLE returns to getRenderPass()
+            void setTargetPass(VkRenderPass renderPass, uint32_t subpass) noexcept;
+
+            // usage: buildFrame once per frame, returns whether the frame has anything to draw; recordDraws then
+            // records those draws into the caller's render pass, at most once, before the next buildFrame
+            bool buildFrame() noexcept;
+            void recordDraws(VkCommandBuffer commandBuffer) const noexcept;
+            void registerWidget(Widget widget);
+
+            // accessors
+            VkRenderPass getRenderPass() const noexcept { return m_renderPass.get(); }
+            bool isVisible() const noexcept             { return m_isVisible; }
+            bool hasDraws() const noexcept              { return m_hasDraws; }
+            const FrameArena& getFrameArena() const noexcept { return m_frameArena; }
 
         private:
             // internal helpers 
             bool createResourcePool() noexcept;
-            bool createCommandBuffers() noexcept;
             bool createRenderPass() noexcept;
-            bool createFramebuffers() noexcept;
             bool createImGuiBackend(const Platform& platform, const VulkanDevice& device) noexcept;
             void renderControlPanel() noexcept;
 
@@ -54,16 +76,17 @@ namespace keplar
             ImGui_ImplVulkan_InitInfo           m_initInfo;
             VkInstance                          m_vkInstance;
             VkDevice                            m_vkDevice;
-            VulkanCommandPool                   m_commandPool;
             VulkanDescriptorPool                m_descriptorPool;
-            VulkanRenderPass                    m_renderPass;
-            std::vector<VulkanCommandBuffer>    m_commandBuffers;
-            std::vector<VulkanFramebuffer>      m_framebuffers;
+            VulkanRenderPass                    m_renderPass;           // compatibility pass the backend pipeline is built for
             uint32_t                            m_queueFamily;
             uint32_t                            m_imageCount;
-            VkExtent2D                          m_imageExtent;
 
-            // registered callbacks
-            std::vector<std::function<void()>>  m_widgetCallbacks;
+            // state of the last built frame
+            bool                                m_isVisible;
+            bool                                m_hasDraws;
+
+            // registered widgets and their per-frame scratch
+            std::vector<Widget>                 m_widgets;
+            FrameArena                          m_frameArena;
     };  
 }   // namespace keplar
@@ -0,0 +1,818 @@
+// ────────────────────────────────────────────
+//  File: impostor_atlas.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "impostor_atlas.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "vertex_layout.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // descriptor bindings of the draw set (set: 1) and the bake set (set: 0)
+    constexpr uint32_t kAlbedoBinding      = 0;
+    constexpr uint32_t kNormalDepthBinding = 1;
+    constexpr uint32_t kBakeViewBinding    = 0;
+
+    constexpr uint32_t kFrameCount = keplar::ImpostorAtlas::kFramesPerSide * keplar::ImpostorAtlas::kFramesPerSide;
+
+    // one transform per instance on binding 0, locations 0-3
+    using InstanceLayout = keplar::VertexLayout<keplar::VertexStream<0, 0, glm::mat4, VK_VERTEX_INPUT_RATE_INSTANCE>>;
+
+    // dynamic uniform of one frame: must match impostor_bake.vert and impostor_bake.frag
+    struct BakeView
+    {
+        glm::mat4 viewProjection;   // model space to the frame's orthographic clip space
+        glm::vec4 direction;        // xyz: from the center towards the frame's camera
+    };
+
+    // push constants: must match impostor.vert
+    struct DrawPushConstants
+    {
+        glm::vec4  bounds;          // xyz: bounding sphere center (model space), w: radius
+        glm::uvec4 atlas;           // x: frames per side
+    };
+
+    // octahedral grid over the whole sphere: must match octahedralDecode of impostor.vert
+    glm::vec3 octahedralDecode(const glm::vec2& uv) noexcept
+    {
+        const glm::vec2 f = uv * 2.0f - 1.0f;
+        glm::vec3 direction(f.x, f.y, 1.0f - std::abs(f.x) - std::abs(f.y));
+        const float fold = std::max(-direction.z, 0.0f);
+        direction.x += direction.x >= 0.0f ? -fold : fold;
+        direction.y += direction.y >= 0.0f ? -fold : fold;
+        return glm::normalize(direction);
+    }
+
+    // frame basis looking along -direction: must match frameBasis of impostor.vert
+    void frameBasis(const glm::vec3& direction, glm::vec3& right, glm::vec3& up) noexcept
+    {
+        const glm::vec3 reference = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        right = glm::normalize(glm::cross(reference, direction));
+        up = glm::cross(direction, right);
+    }
+
+    // orthographic clip space of a frame: the bounding sphere spans [-1, 1] in x and y (up at the top of the frame)
+    // and [0, 1] in depth from its front plane to its back
+    glm::mat4 frameViewProjection(const glm::vec3& direction, const glm::vec3& center, float radius) noexcept
+    {
+        glm::vec3 right;
+        glm::vec3 up;
+        frameBasis(direction, right, up);
+
+        const float inverseRadius = 1.0f / radius;
+        const float inverseDiameter = 0.5f * inverseRadius;
+        glm::mat4 viewProjection(0.0f);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            viewProjection[axis][0] =  right[axis] * inverseRadius;
+            viewProjection[axis][1] = -up[axis] * inverseRadius;
+            viewProjection[axis][2] = -direction[axis] * inverseDiameter;
+        }
+        viewProjection[3][0] = -glm::dot(center, right) * inverseRadius;
+        viewProjection[3][1] =  glm::dot(center, up) * inverseRadius;
+        viewProjection[3][2] =  0.5f + glm::dot(center, direction) * inverseDiameter;
+        viewProjection[3][3] =  1.0f;
+        return viewProjection;
+    }
+}
+
+namespace keplar
+{
+    ImpostorAtlas::ImpostorAtlas() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkBakeSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSet(VK_NULL_HANDLE)
+        , m_albedoImage(VK_NULL_HANDLE)
+        , m_albedoView(VK_NULL_HANDLE)
+        , m_normalDepthImage(VK_NULL_HANDLE)
+        , m_normalDepthView(VK_NULL_HANDLE)
+        , m_instanceCounts{}
+        , m_maxInstances(0)
+        , m_center(0.0f)
+        , m_radius(0.0f)
+        , m_isBaked(false)
+    {
+    }
+
+    ImpostorAtlas::~ImpostorAtlas()
+    {
+        destroy();
+    }
+
+    bool ImpostorAtlas::initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, GLTFModel& model, const ImpostorShaders& shaders,
+                                   uint32_t maxInstances) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_maxInstances = std::max(1u, maxInstances);
+
+        // frames are fitted to the sphere around the model's bounds
+        const BoundingBox bounds = model.getBounds();
+        if (!bounds.isValid() || model.getPlacementCount() != 0)
+        {
+            VK_LOG_ERROR("ImpostorAtlas::initialize :: model has no bounds or already has placements");
+            destroy();
+            return false;
+        }
+        m_center = bounds.getCenter();
+        m_radius = std::max(glm::length(bounds.getExtent()), 1e-4f);
+
+        // both atlases are rendered into and sampled
+        constexpr VkFormatFeatureFlags kFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        if (!device.isFormatSupported(kAlbedoFormat, kFeatures) || !device.isFormatSupported(kNormalDepthFormat, kFeatures))
+        {
+            VK_LOG_ERROR("ImpostorAtlas::initialize :: atlas formats not supported");
+            destroy();
+            return false;
+        }
+
+        // linear within a frame; the quads never sample past their frame's edge
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_LINEAR;
+        samplerInfo.minFilter    = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = 0.0f;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createImages() || !createDescriptorResources(device) || !createInstanceBuffers(device))
+        {
+            destroy();
+            return false;
+        }
+
+        // the bake's temporaries are only released once the gpu is done with them
+        BakeResources bakeResources{};
+        const bool isBaked = bake(device, stagingBelt, model, shaders, bakeResources);
+        if (!stagingBelt.flush(true) || !isBaked)
+        {
+            VK_LOG_ERROR("ImpostorAtlas::initialize :: failed to bake the frames");
+            destroyBake(bakeResources);
+            destroy();
+            return false;
+        }
+        destroyBake(bakeResources);
+
+        // the frames exist: the draw set can be written and drawn with
+        const VkDescriptorImageInfo albedoInfo{ m_vkSampler, m_albedoView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo normalDepthInfo{ m_vkSampler, m_normalDepthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        for (auto& write : writes)
+        {
+            write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext            = nullptr;
+            write.dstSet           = m_vkDescriptorSet;
+            write.dstArrayElement  = 0;
+            write.descriptorCount  = 1;
+            write.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.pBufferInfo      = nullptr;
+            write.pTexelBufferView = nullptr;
+        }
+        writes[0].dstBinding = kAlbedoBinding;
+        writes[0].pImageInfo = &albedoInfo;
+        writes[1].dstBinding = kNormalDepthBinding;
+        writes[1].pImageInfo = &normalDepthInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        m_isBaked = true;
+
+        VK_LOG_DEBUG("ImpostorAtlas::initialize successful (%u frames of %u texels, radius %.2f)", kFrameCount, kFrameSize, m_radius);
+        return true;
+    }
+
+    void ImpostorAtlas::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        for (auto& instanceBuffer : m_instanceBuffers)
+        {
+            instanceBuffer = VulkanBuffer();
+        }
+        m_instanceCounts.fill(0);
+
+        // the set is freed with its pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDescriptorSet = VK_NULL_HANDLE;
+
+        for (VkImageView* imageView : { &m_albedoView, &m_normalDepthView })
+        {
+            if (*imageView != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, *imageView, nullptr);
+                *imageView = VK_NULL_HANDLE;
+            }
+        }
+
+        for (VkImage* image : { &m_albedoImage, &m_normalDepthImage })
+        {
+            if (*image != VK_NULL_HANDLE)
+            {
+                vkDestroyImage(m_vkDevice, *image, nullptr);
+                *image = VK_NULL_HANDLE;
+            }
+        }
+
+        if (m_memoryAllocator != nullptr)
+        {
+            m_memoryAllocator->free(m_albedoAllocation);
+            m_memoryAllocator->free(m_normalDepthAllocation);
+        }
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkBakeSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_maxInstances = 0;
+        m_isBaked = false;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("impostor atlas destroyed successfully");
+    }
+
+    uint32_t ImpostorAtlas::setInstances(uint32_t frameIndex, const glm::mat4* transforms, uint32_t count) noexcept
+    {
+        const uint32_t slot = frameIndex % kMaxFramesInFlight;
+        if (!isValid())
+        {
+            return 0;
+        }
+
+        if (count > m_maxInstances)
+        {
+            VK_LOG_WARN_THROTTLED("ImpostorAtlas::setInstances :: %u instances exceed the capacity of %u", count, m_maxInstances);
+            count = m_maxInstances;
+        }
+
+        // the slot's previous frame completed before this one began recording
+        VulkanBuffer& instanceBuffer = m_instanceBuffers[slot];
+        if (count > 0)
+        {
+            std::memcpy(instanceBuffer.getMappedData(), transforms, count * sizeof(glm::mat4));
+            instanceBuffer.flush(0, count * sizeof(glm::mat4));
+        }
+        m_instanceCounts[slot] = count;
+        return count;
+    }
+
+    void ImpostorAtlas::record(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex) const noexcept
+    {
+        const uint32_t slot = frameIndex % kMaxFramesInFlight;
+        if (!isValid() || m_instanceCounts[slot] == 0)
+        {
+            return;
+        }
+
+        DrawPushConstants pushConstants{};
+        pushConstants.bounds = glm::vec4(m_center, m_radius);
+        pushConstants.atlas  = glm::uvec4(kFramesPerSide, 0, 0, 0);
+
+        // one strip of four corners per instance, built in the vertex stage
+        const VkBuffer instanceBuffer = m_instanceBuffers[slot].get();
+        const VkDeviceSize offset = 0;
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &m_vkDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &instanceBuffer, &offset);
+        vkCmdDraw(commandBuffer, 4, m_instanceCounts[slot], 0, 0);
+    }
+
+    VkDescriptorSetLayout ImpostorAtlas::getDescriptorSetLayout(const VulkanDevice& device) noexcept
+    {
+        // the layout cache hands every atlas, and the renderer's pipeline, the same layout
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { kAlbedoBinding,      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr },
+            { kNormalDepthBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr }
+        };
+        return device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+    }
+
+    VkPipelineVertexInputStateCreateInfo ImpostorAtlas::getVertexInputState() noexcept
+    {
+        return InstanceLayout::getInputState();
+    }
+
+    VkPushConstantRange ImpostorAtlas::getPushConstantRange() noexcept
+    {
+        return { VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawPushConstants) };
+    }
+
+    bool ImpostorAtlas::createImages() noexcept
+    {
+        auto createImage = [this](VkFormat format, VkImage& image, VulkanAllocation& allocation, VkImageView& imageView) noexcept
+        {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.pNext         = nullptr;
+            imageInfo.flags         = 0;
+            imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+            imageInfo.format        = format;
+            imageInfo.extent        = { kAtlasSize, kAtlasSize, 1 };
+            imageInfo.mipLevels     = 1;
+            imageInfo.arrayLayers   = 1;
+            imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            VkResult result = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &image);
+            if (result != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("ImpostorAtlas :: vkCreateImage failed : %s (code: %d)", string_VkResult(result), result);
+                image = VK_NULL_HANDLE;
+                return false;
+            }
+
+            if (!m_memoryAllocator->allocateImageMemory(image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, allocation, VulkanMemoryCategory::kTexture))
+            {
+                VK_LOG_FATAL("ImpostorAtlas :: failed to allocate image memory");
+                return false;
+            }
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.pNext                           = nullptr;
+            viewInfo.flags                           = 0;
+            viewInfo.image                           = image;
+            viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format                          = format;
+            viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                         VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+            viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.baseMipLevel   = 0;
+            viewInfo.subresourceRange.levelCount     = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount     = 1;
+
+            result = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &imageView);
+            if (result != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("ImpostorAtlas :: vkCreateImageView failed : %s (code: %d)", string_VkResult(result), result);
+                imageView = VK_NULL_HANDLE;
+                return false;
+            }
+            return true;
+        };
+
+        return createImage(kAlbedoFormat, m_albedoImage, m_albedoAllocation, m_albedoView) &&
+               createImage(kNormalDepthFormat, m_normalDepthImage, m_normalDepthAllocation, m_normalDepthView);
+    }
+
+    bool ImpostorAtlas::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        // draw set: both atlases; bake set: the frame views, one dynamic offset per frame
+        m_vkSetLayout = getDescriptorSetLayout(device);
+        const std::vector<VkDescriptorSetLayoutBinding> bakeBindings
+        {
+            { kBakeViewBinding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr }
+        };
+        m_vkBakeSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bakeBindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE || m_vkBakeSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2 },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 2;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkSetLayout;
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &m_vkDescriptorSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorSet = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool ImpostorAtlas::createInstanceBuffers(const VulkanDevice& device) noexcept
+    {
+        // rewritten by the cpu every frame, read once per instance
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.pNext       = nullptr;
+        bufferInfo.flags       = 0;
+        bufferInfo.size        = static_cast<VkDeviceSize>(m_maxInstances) * sizeof(glm::mat4);
+        bufferInfo.usage       = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        for (auto& instanceBuffer : m_instanceBuffers)
+        {
+            if (!instanceBuffer.createHostVisible(device, bufferInfo, nullptr, 0, true))
+            {
+                VK_LOG_ERROR("ImpostorAtlas :: failed to create an instance buffer");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ImpostorAtlas::bake(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, GLTFModel& model, const ImpostorShaders& shaders,
+                             BakeResources& bakeResources) noexcept
+    {
+        if (!createBakeTarget(bakeResources) || !createBakePipeline(device, model, shaders, bakeResources))
+        {
+            return false;
+        }
+
+        // one orthographic view per frame, at the center of its octahedral cell
+        const VkDeviceSize alignment = std::max<VkDeviceSize>(device.getPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment, 1);
+        bakeResources.mViewStride = static_cast<uint32_t>((sizeof(BakeView) + alignment - 1) / alignment * alignment);
+        std::vector<uint8_t> views(static_cast<size_t>(bakeResources.mViewStride) * kFrameCount);
+        for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+        {
+            const glm::vec2 cell(static_cast<float>(frame % kFramesPerSide) + 0.5f, static_cast<float>(frame / kFramesPerSide) + 0.5f);
+            const glm::vec3 direction = octahedralDecode(cell / static_cast<float>(kFramesPerSide));
+
+            BakeView view{};
+            view.viewProjection = frameViewProjection(direction, m_center, m_radius);
+            view.direction      = glm::vec4(direction, 0.0f);
+            std::memcpy(views.data() + static_cast<size_t>(frame) * bakeResources.mViewStride, &view, sizeof(view));
+        }
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.pNext       = nullptr;
+        bufferInfo.flags       = 0;
+        bufferInfo.size        = views.size();
+        bufferInfo.usage       = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!bakeResources.mViewBuffer.createHostVisible(device, bufferInfo, views.data(), views.size()))
+        {
+            VK_LOG_ERROR("ImpostorAtlas :: failed to create the bake view buffer");
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkBakeSetLayout;
+
+        const VkResult vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &bakeResources.mViewSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        const VkDescriptorBufferInfo viewInfo{ bakeResources.mViewBuffer.get(), 0, sizeof(BakeView) };
+        VkWriteDescriptorSet write{};
+        write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext            = nullptr;
+        write.dstSet           = bakeResources.mViewSet;
+        write.dstBinding       = kBakeViewBinding;
+        write.dstArrayElement  = 0;
+        write.descriptorCount  = 1;
+        write.descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        write.pImageInfo       = nullptr;
+        write.pBufferInfo      = &viewInfo;
+        write.pTexelBufferView = nullptr;
+        vkUpdateDescriptorSets(m_vkDevice, 1, &write, 0, nullptr);
+
+        VkCommandBuffer commandBuffer = stagingBelt.getGraphicsCommandBuffer();
+        if (commandBuffer == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("ImpostorAtlas :: failed to get staging belt graphics command buffer");
+            return false;
+        }
+
+        // nothing covered: no coverage, a neutral normal at the back plane
+        std::array<VkClearValue, 3> clearValues{};
+        clearValues[0].color        = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+        clearValues[1].color        = { { 0.5f, 0.5f, 1.0f, 1.0f } };
+        clearValues[2].depthStencil = { 1.0f, 0 };
+
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.pNext             = nullptr;
+        renderPassInfo.renderPass        = bakeResources.mRenderPass;
+        renderPassInfo.framebuffer       = bakeResources.mFramebuffer;
+        renderPassInfo.renderArea.offset = { 0, 0 };
+        renderPassInfo.renderArea.extent = { kAtlasSize, kAtlasSize };
+        renderPassInfo.clearValueCount   = static_cast<uint32_t>(clearValues.size());
+        renderPassInfo.pClearValues      = clearValues.data();
+
+        // the draws are gathered once, as loaded and without culling, and recorded again into every frame
+        const uint32_t runCount = model.prepareDraws(0, nullptr);
+        const VkPipelineLayout pipelineLayout = bakeResources.mPipeline.getLayout();
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bakeResources.mPipeline.get());
+        for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+        {
+            const VkViewport viewport{ static_cast<float>((frame % kFramesPerSide) * kFrameSize), static_cast<float>((frame / kFramesPerSide) * kFrameSize),
+                                       static_cast<float>(kFrameSize), static_cast<float>(kFrameSize), 0.0f, 1.0f };
+            const VkRect2D scissor{ { static_cast<int32_t>(viewport.x), static_cast<int32_t>(viewport.y) }, { kFrameSize, kFrameSize } };
+            const uint32_t viewOffset = frame * bakeResources.mViewStride;
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &bakeResources.mViewSet, 1, &viewOffset);
+            model.recordDraws(commandBuffer, pipelineLayout, 0, 0, runCount);
+        }
+        vkCmdEndRenderPass(commandBuffer);
+        return true;
+    }
+
+    bool ImpostorAtlas::createBakeTarget(BakeResources& bakeResources) noexcept
+    {
+        // both atlases end up sampled; the depth only orders the model's own triangles
+        std::array<VkAttachmentDescription, 3> attachments{};
+        for (auto& attachment : attachments)
+        {
+            attachment.flags          = 0;
+            attachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+            attachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+            attachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachment.finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+        attachments[0].format      = kAlbedoFormat;
+        attachments[1].format      = kNormalDepthFormat;
+        attachments[2].format      = kBakeDepthFormat;
+        attachments[2].storeOp     = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[2].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        const std::array<VkAttachmentReference, 2> colorReferences
+        {{
+            { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL },
+            { 1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }
+        }};
+        const VkAttachmentReference depthReference{ 2, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount    = static_cast<uint32_t>(colorReferences.size());
+        subpass.pColorAttachments       = colorReferences.data();
+        subpass.pDepthStencilAttachment = &depthReference;
+
+        // the frames are sampled by every later draw
+        VkSubpassDependency dependency{};
+        dependency.srcSubpass    = 0;
+        dependency.dstSubpass    = VK_SUBPASS_EXTERNAL;
+        dependency.srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.dstStageMask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.pNext           = nullptr;
+        renderPassInfo.flags           = 0;
+        renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        renderPassInfo.pAttachments    = attachments.data();
+        renderPassInfo.subpassCount    = 1;
+        renderPassInfo.pSubpasses      = &subpass;
+        renderPassInfo.dependencyCount = 1;
+        renderPassInfo.pDependencies   = &dependency;
+
+        VkResult vkResult = vkCreateRenderPass(m_vkDevice, &renderPassInfo, nullptr, &bakeResources.mRenderPass);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkCreateRenderPass failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            bakeResources.mRenderPass = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.pNext         = nullptr;
+        imageInfo.flags         = 0;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = kBakeDepthFormat;
+        imageInfo.extent        = { kAtlasSize, kAtlasSize, 1 };
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        vkResult = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &bakeResources.mDepthImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkCreateImage failed for depth : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            bakeResources.mDepthImage = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (!m_memoryAllocator->allocateImageMemory(bakeResources.mDepthImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bakeResources.mDepthAllocation,
+                                                    VulkanMemoryCategory::kAttachment))
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: failed to allocate depth memory");
+            return false;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = bakeResources.mDepthImage;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = kBakeDepthFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &bakeResources.mDepthView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkCreateImageView failed for depth : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            bakeResources.mDepthView = VK_NULL_HANDLE;
+            return false;
+        }
+
+        const std::array<VkImageView, 3> framebufferViews{ m_albedoView, m_normalDepthView, bakeResources.mDepthView };
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.pNext           = nullptr;
+        framebufferInfo.flags           = 0;
+        framebufferInfo.renderPass      = bakeResources.mRenderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(framebufferViews.size());
+        framebufferInfo.pAttachments    = framebufferViews.data();
+        framebufferInfo.width           = kAtlasSize;
+        framebufferInfo.height          = kAtlasSize;
+        framebufferInfo.layers          = 1;
+
+        vkResult = vkCreateFramebuffer(m_vkDevice, &framebufferInfo, nullptr, &bakeResources.mFramebuffer);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ImpostorAtlas :: vkCreateFramebuffer failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            bakeResources.mFramebuffer = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool ImpostorAtlas::createBakePipeline(const VulkanDevice& device, const GLTFModel& model, const ImpostorShaders& shaders,
+                                           BakeResources& bakeResources) noexcept
+    {
+        VulkanShader vertexShader;
+        VulkanShader fragmentShader;
+        if (!vertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, shaders.mBakeVertexFile) ||
+            !fragmentShader.initialize(m_vkDevice, VK_SHADER_STAGE_FRAGMENT_BIT, shaders.mBakeFragmentFile))
+        {
+            VK_LOG_ERROR("ImpostorAtlas :: bake shaders '%s' / '%s' unavailable", shaders.mBakeVertexFile.c_str(), shaders.mBakeFragmentFile.c_str());
+            return false;
+        }
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // one viewport and scissor per frame, set while recording
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount  = 1;
+
+        static constexpr std::array<VkDynamicState, 2> kDynamicStates{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = static_cast<uint32_t>(kDynamicStates.size());
+        dynamicState.pDynamicStates    = kDynamicStates.data();
+
+        // open and double-sided surfaces are seen from every side
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        rasterizationState.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizationState.cullMode    = VK_CULL_MODE_NONE;
+        rasterizationState.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizationState.lineWidth   = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        multisampleState.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencilState{};
+        depthStencilState.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencilState.depthTestEnable  = VK_TRUE;
+        depthStencilState.depthWriteEnable = VK_TRUE;
+        depthStencilState.depthCompareOp   = VK_COMPARE_OP_LESS;
+
+        std::array<VkPipelineColorBlendAttachmentState, 2> blendAttachments{};
+        for (auto& blendAttachment : blendAttachments)
+        {
+            blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+            blendAttachment.blendEnable    = VK_FALSE;
+        }
+
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+        colorBlendState.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlendState.attachmentCount = static_cast<uint32_t>(blendAttachments.size());
+        colorBlendState.pAttachments    = blendAttachments.data();
+
+        // set 0: the frame's view, set 1: the model's materials, bound by its draws
+        GraphicsPipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStages         = { vertexShader.getShaderStageInfo(), fragmentShader.getShaderStageInfo() };
+        pipelineConfig.mVertexInputState     = GLTFModel::getVertexInputState(model.getVertexFormat());
+        pipelineConfig.mInputAssemblyState   = inputAssembly;
+        pipelineConfig.mViewportState        = viewportState;
+        pipelineConfig.mRasterizationState   = rasterizationState;
+        pipelineConfig.mMultisampleState     = multisampleState;
+        pipelineConfig.mDepthStencilState    = depthStencilState;
+        pipelineConfig.mColorBlendState      = colorBlendState;
+        pipelineConfig.mDynamicState         = dynamicState;
+        pipelineConfig.mRenderPass           = bakeResources.mRenderPass;
+        pipelineConfig.mSubpassIndex         = 0;
+        pipelineConfig.mDescriptorSetLayouts = { m_vkBakeSetLayout, GLTFModel::getDescriptorSetLayout() };
+        pipelineConfig.mPushConstantRanges   = { GLTFModel::getPushConstantRange() };
+
+        if (!bakeResources.mPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("ImpostorAtlas :: failed to create the bake pipeline");
+            return false;
+        }
+        return true;
+    }
+
+    void ImpostorAtlas::destroyBake(BakeResources& bakeResources) noexcept
+    {
+        bakeResources.mPipeline.destroy();
+        bakeResources.mViewBuffer = VulkanBuffer();
+        bakeResources.mViewSet = VK_NULL_HANDLE;    // freed with the pool
+
+        if (bakeResources.mFramebuffer != VK_NULL_HANDLE)
+        {
+            vkDestroyFramebuffer(m_vkDevice, bakeResources.mFramebuffer, nullptr);
+            bakeResources.mFramebuffer = VK_NULL_HANDLE;
+        }
+
+        if (bakeResources.mDepthView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, bakeResources.mDepthView, nullptr);
+            bakeResources.mDepthView = VK_NULL_HANDLE;
+        }
+
+        if (bakeResources.mDepthImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, bakeResources.mDepthImage, nullptr);
+            bakeResources.mDepthImage = VK_NULL_HANDLE;
+        }
+        m_memoryAllocator->free(bakeResources.mDepthAllocation);
+
+        if (bakeResources.mRenderPass != VK_NULL_HANDLE)
+        {
+            vkDestroyRenderPass(m_vkDevice, bakeResources.mRenderPass, nullptr);
+            bakeResources.mRenderPass = VK_NULL_HANDLE;
+        }
+    }
+}   // namespace keplar
@@ -0,0 +1,139 @@
+// ────────────────────────────────────────────
+//  File: impostor_atlas.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "math3d.hpp"
+#include "gltf_model.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class VulkanStagingBelt;
+
+    // spir-v of the bake pass; the draw pipeline belongs to the renderer (see record)
+    struct ImpostorShaders
+    {
+        std::string mBakeVertexFile;        // impostor_bake.vert
+        std::string mBakeFragmentFile;      // impostor_bake.frag
+    };
+
+    // octahedral impostor of one model: the model is rendered once per direction of a kFramesPerSide x kFramesPerSide
+    // octahedral grid over the whole sphere, orthographically and fitted to its bounding sphere, into the frames of two
+    // atlases: base color with coverage in alpha (kAlbedoFormat), and the model-space normal with the depth below the
+    // frame's front plane in alpha (kNormalDepthFormat). at runtime every instance is one quad facing the frame nearest
+    // to its view direction, drawn instanced from a per-frame transform buffer; the fragment stage alpha-tests the
+    // coverage, relights the baked normal and pushes the depth back onto the baked surface, so impostors intersect the
+    // full meshes around them. frames are kFrameSize texels: a placement is meant to switch once its bounds span fewer
+    // pixels than that, where the flat frame and the nearest-direction snap no longer show
+    class ImpostorAtlas final
+    {
+        public:
+            static constexpr uint32_t kFramesPerSide     = 12;
+            static constexpr uint32_t kFrameSize         = 64;
+            static constexpr uint32_t kAtlasSize         = kFramesPerSide * kFrameSize;
+            static constexpr VkFormat kAlbedoFormat      = VK_FORMAT_R8G8B8A8_SRGB;
+            static constexpr VkFormat kNormalDepthFormat = VK_FORMAT_R8G8B8A8_UNORM;
+            static constexpr VkFormat kBakeDepthFormat   = VK_FORMAT_D16_UNORM;      // always a depth attachment format
+            static constexpr uint32_t kMaxFramesInFlight = GLTFModel::kMaxFramesInFlight;
+
+            // creation and destruction
+            ImpostorAtlas() noexcept;
+            ~ImpostorAtlas();
+
+            // disable copy and move semantics to enforce unique ownership
+            ImpostorAtlas(const ImpostorAtlas&) = delete;
+            ImpostorAtlas& operator=(const ImpostorAtlas&) = delete;
+            ImpostorAtlas(ImpostorAtlas&&) = delete;
+            ImpostorAtlas& operator=(ImpostorAtlas&&) = delete;
+
+            // usage: bakes model as loaded, so before its placements are set and with instancing off, once its material sets
+            // are updated. the bake is recorded on the belt's graphics command buffer and flushed before returning;
+            // maxInstances sizes the per-frame transform buffers
+            bool initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, GLTFModel& model, const ImpostorShaders& shaders,
+                            uint32_t maxInstances) noexcept;
+            void destroy() noexcept;
+
+            // usage: model-to-world transforms (uniformly scaled) of the instances drawn this frame, at most getMaxInstances;
+            // returns the count kept
+            uint32_t setInstances(uint32_t frameIndex, const glm::mat4* transforms, uint32_t count) noexcept;
+
+            // usage: inside a render pass, with a pipeline bound whose set 1 is getDescriptorSetLayout, vertex input
+            // getVertexInputState, push constants getPushConstantRange and topology triangle strip; set 0 holds the camera
+            // (projection and view, vertex stage)
+            void record(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex) const noexcept;
+
+            // pipeline interface of the draw, the same for every atlas
+            static VkDescriptorSetLayout getDescriptorSetLayout(const VulkanDevice& device) noexcept;
+            static VkPipelineVertexInputStateCreateInfo getVertexInputState() noexcept;
+            static VkPushConstantRange getPushConstantRange() noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_isBaked; }
+            uint32_t getMaxInstances() const noexcept { return m_maxInstances; }
+            uint32_t getInstanceCount(uint32_t frameIndex) const noexcept { return m_instanceCounts[frameIndex % kMaxFramesInFlight]; }
+            const glm::vec3& getCenter() const noexcept { return m_center; }     // bounding sphere, model space
+            float getRadius() const noexcept { return m_radius; }
+
+        private:
+            // the bake's render pass, framebuffer, pipeline and view buffer, released once it completed
+            struct BakeResources
+            {
+                VkRenderPass            mRenderPass = VK_NULL_HANDLE;
+                VkFramebuffer           mFramebuffer = VK_NULL_HANDLE;
+                VkImage                 mDepthImage = VK_NULL_HANDLE;
+                VulkanAllocation        mDepthAllocation;
+                VkImageView             mDepthView = VK_NULL_HANDLE;
+                VkDescriptorSet         mViewSet = VK_NULL_HANDLE;
+                VulkanBuffer            mViewBuffer;
+                VulkanPipeline          mPipeline;
+                uint32_t                mViewStride = 0;
+            };
+
+            bool createImages() noexcept;
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createInstanceBuffers(const VulkanDevice& device) noexcept;
+            bool bake(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, GLTFModel& model, const ImpostorShaders& shaders,
+                      BakeResources& bakeResources) noexcept;
+            bool createBakeTarget(BakeResources& bakeResources) noexcept;
+            bool createBakePipeline(const VulkanDevice& device, const GLTFModel& model, const ImpostorShaders& shaders, BakeResources& bakeResources) noexcept;
+            void destroyBake(BakeResources& bakeResources) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                                        m_vkDevice;
+            VulkanMemoryAllocator*                          m_memoryAllocator;
+            VkSampler                                       m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout                           m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorSetLayout                           m_vkBakeSetLayout;      // owned by the device layout cache
+            VkDescriptorPool                                m_vkDescriptorPool;
+            VkDescriptorSet                                 m_vkDescriptorSet;
+
+            // baked frames
+            VkImage                                         m_albedoImage;
+            VulkanAllocation                                m_albedoAllocation;
+            VkImageView                                     m_albedoView;
+            VkImage                                         m_normalDepthImage;
+            VulkanAllocation                                m_normalDepthAllocation;
+            VkImageView                                     m_normalDepthView;
+
+            // per-frame instance transforms, persistently mapped
+            std::array<VulkanBuffer, kMaxFramesInFlight>    m_instanceBuffers;
+            std::array<uint32_t, kMaxFramesInFlight>        m_instanceCounts;
+            uint32_t                                        m_maxInstances;
+
+            // bounding sphere the frames are fitted to
+            glm::vec3                                       m_center;
+            float                                           m_radius;
+            bool                                            m_isBaked;              // frames rendered, draw set written
+    };
+}   // namespace keplar
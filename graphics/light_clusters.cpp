@@ -0,0 +1,319 @@
+// ────────────────────────────────────────────
+//  File: light_clusters.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "light_clusters.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // preferred workgroup size, specialized into local_size_x_id in light_cluster.comp (clamped to device limits)
+    constexpr uint32_t kWorkgroupSize = 64;
+    constexpr uint32_t kWorkgroupSizeConstantId = 0;
+
+    // descriptor bindings (set: 0)
+    constexpr uint32_t kLightBinding   = 0;
+    constexpr uint32_t kClusterBinding = 1;
+    constexpr uint32_t kBindingCount   = 2;
+
+    // push constants: camera and grid
+    struct alignas(16) ClusterPushConstants
+    {
+        glm::mat4  view;
+        glm::vec4  frustum;     // xy: tangent of the half fov, z: near, w: far
+        glm::uvec4 grid;        // xyz: grid dimensions, w: light count
+    };
+
+    static_assert(sizeof(keplar::LightClusters::PointLight) == 32, "PointLight layout must match light_cluster.comp");
+    static_assert(sizeof(ClusterPushConstants) <= 128, "push constants must fit the guaranteed minimum");
+}
+
+namespace keplar
+{
+    LightClusters::LightClusters() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_workgroupSize(kWorkgroupSize)
+    {
+    }
+
+    LightClusters::~LightClusters()
+    {
+        destroy();
+    }
+
+    bool LightClusters::initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& spirvFile, uint32_t frameCount) noexcept
+    {
+        m_vkDevice = device.getDevice();
+
+        if (!createBuffers(device, stagingBelt, frameCount))
+        {
+            destroy();
+            return false;
+        }
+
+        // the buffers outlive a missing compute pass, fragments can still shade every uploaded light
+        if (!createDescriptorResources(frameCount) || !createPipeline(device, spirvFile))
+        {
+            return false;
+        }
+
+        VK_LOG_DEBUG("LightClusters::initialize successful (%u clusters, %u lights)", kClusterCount, kMaxLights);
+        return true;
+    }
+
+    void LightClusters::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // descriptor sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDescriptorSets.clear();
+
+        if (m_vkDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(m_vkDevice, m_vkDescriptorSetLayout, nullptr);
+            m_vkDescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        m_lightBuffers.clear();
+        m_clusterBuffers.clear();
+        m_lightCounts.clear();
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("light cluster pass destroyed successfully");
+    }
+
+    uint32_t LightClusters::uploadLights(uint32_t frameIndex, const PointLight* lights, uint32_t count) noexcept
+    {
+        if (frameIndex >= m_lightBuffers.size())
+        {
+            return 0;
+        }
+
+        // the frame slot is idle once its fence or timeline wait returned, so its buffer is written in place
+        count = (lights != nullptr) ? std::min(count, kMaxLights) : 0;
+        if (count > 0)
+        {
+            std::memcpy(m_lightBuffers[frameIndex].getMappedData(), lights, sizeof(PointLight) * count);
+            m_lightBuffers[frameIndex].flush(0, sizeof(PointLight) * count);
+        }
+
+        m_lightCounts[frameIndex] = count;
+        return count;
+    }
+
+    void LightClusters::record(VkCommandBuffer commandBuffer, uint32_t frameIndex, const glm::mat4& view, const glm::vec4& frustum) const noexcept
+    {
+        if (!isValid() || frameIndex >= m_vkDescriptorSets.size())
+        {
+            return;
+        }
+
+        // lights are written by the host before submission; the submit makes them visible
+        ClusterPushConstants pushConstants{};
+        pushConstants.view    = view;
+        pushConstants.frustum = frustum;
+        pushConstants.grid    = glm::uvec4(kGridX, kGridY, kGridZ, m_lightCounts[frameIndex]);
+
+        // one invocation per cluster, every record is rewritten (empty clusters store a zero count)
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSets[frameIndex], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ClusterPushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (kClusterCount + m_workgroupSize - 1) / m_workgroupSize, 1, 1);
+
+        // make cluster records visible to the shading pass (fragment shaders, or the compute pass of deferred shading)
+        VkMemoryBarrier clusterBarrier{};
+        clusterBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        clusterBarrier.pNext         = nullptr;
+        clusterBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        clusterBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &clusterBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    glm::vec2 LightClusters::getSliceParams(float znear, float zfar) noexcept
+    {
+        // inverse of the exponential slice depths used by the cluster pass: near * (far / near)^(slice / kGridZ)
+        const float logRatio = std::log(zfar / znear);
+        const float scale = static_cast<float>(kGridZ) / logRatio;
+        return glm::vec2(scale, -scale * std::log(znear));
+    }
+
+    bool LightClusters::createBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, uint32_t frameCount) noexcept
+    {
+        m_lightBuffers.resize(frameCount);
+        m_clusterBuffers.resize(frameCount);
+        m_lightCounts.assign(frameCount, 0);
+
+        // cluster records start empty; the pass rewrites all of them every frame
+        const std::vector<uint32_t> emptyClusters(kClusterCount * kClusterStride, 0);
+
+        for (uint32_t i = 0; i < frameCount; ++i)
+        {
+            VkBufferCreateInfo bufferCreateInfo{};
+            bufferCreateInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferCreateInfo.pNext       = nullptr;
+            bufferCreateInfo.flags       = 0;
+            bufferCreateInfo.usage       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            bufferCreateInfo.size        = sizeof(PointLight) * kMaxLights;
+
+            if (!m_lightBuffers[i].createHostVisible(device, bufferCreateInfo, nullptr, 0, true, true))
+            {
+                VK_LOG_ERROR("LightClusters::createBuffers :: failed to create light buffer for frame %u", i);
+                return false;
+            }
+
+            bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            bufferCreateInfo.size  = sizeof(uint32_t) * emptyClusters.size();
+            if (!m_clusterBuffers[i].createDeviceLocal(device, stagingBelt, bufferCreateInfo, emptyClusters.data(), bufferCreateInfo.size))
+            {
+                VK_LOG_ERROR("LightClusters::createBuffers :: failed to create cluster buffer for frame %u", i);
+                return false;
+            }
+        }
+
+        // cluster records are read from the first frame on
+        return stagingBelt.flush();
+    }
+
+    bool LightClusters::createDescriptorResources(uint32_t frameCount) noexcept
+    {
+        // set: 0, bindings: lights (read), cluster records (write)
+        std::array<VkDescriptorSetLayoutBinding, kBindingCount> bindings
+        {{
+            { kLightBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kClusterBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = nullptr;
+        layoutInfo.flags        = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings    = bindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &m_vkDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("LightClusters :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // private pool sized for one set per frame
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSize.descriptorCount = static_cast<uint32_t>(bindings.size()) * frameCount;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = frameCount;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes    = &poolSize;
+
+        vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("LightClusters :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        std::vector<VkDescriptorSetLayout> layouts(frameCount, m_vkDescriptorSetLayout);
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = frameCount;
+        allocateInfo.pSetLayouts        = layouts.data();
+
+        m_vkDescriptorSets.resize(frameCount, VK_NULL_HANDLE);
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, m_vkDescriptorSets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("LightClusters :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorSets.clear();
+            return false;
+        }
+
+        // every frame's set points at its own light and cluster buffers
+        for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+        {
+            const std::array<VkDescriptorBufferInfo, kBindingCount> bufferInfos
+            {{
+                { m_lightBuffers[frameIndex].get(),   0, VK_WHOLE_SIZE },
+                { m_clusterBuffers[frameIndex].get(), 0, VK_WHOLE_SIZE }
+            }};
+
+            std::array<VkWriteDescriptorSet, kBindingCount> writes{};
+            for (uint32_t i = 0; i < writes.size(); ++i)
+            {
+                writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[i].pNext            = nullptr;
+                writes[i].dstSet           = m_vkDescriptorSets[frameIndex];
+                writes[i].dstBinding       = i;
+                writes[i].dstArrayElement  = 0;
+                writes[i].descriptorCount  = 1;
+                writes[i].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[i].pImageInfo       = nullptr;
+                writes[i].pBufferInfo      = &bufferInfos[i];
+                writes[i].pTexelBufferView = nullptr;
+            }
+
+            vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        return true;
+    }
+
+    bool LightClusters::createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept
+    {
+        // missing spir-v is not fatal; callers fall back to shading every light
+        VulkanShader computeShader;
+        if (!computeShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, spirvFile))
+        {
+            VK_LOG_WARN("LightClusters :: compute shader '%s' unavailable", spirvFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = computeShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkDescriptorSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ClusterPushConstants) } };
+
+        // local_size_x is a specialization constant so the workgroup size can follow the device
+        const VkPhysicalDeviceLimits& limits = device.getPhysicalDeviceProperties().limits;
+        m_workgroupSize = std::min({ kWorkgroupSize, limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations });
+        pipelineConfig.addSpecializationConstant(kWorkgroupSizeConstantId, m_workgroupSize);
+
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("LightClusters :: failed to create compute pipeline");
+            return false;
+        }
+
+        return true;
+    }
+}   // namespace keplar
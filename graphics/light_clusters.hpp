@@ -0,0 +1,94 @@
+// ────────────────────────────────────────────
+//  File: light_clusters.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class VulkanStagingBelt;
+
+    // compute pass that bins punctual lights into a froxel grid (screen tiles by exponential depth slices) for
+    // clustered forward shading: every cluster record holds its light count followed by up to kMaxLightsPerCluster
+    // light indices, so fragments only shade the lights whose range reaches their cluster.
+    // light and cluster buffers exist once per frame in flight, so uploads never alias an in-flight frame.
+    class LightClusters final
+    {
+        public:
+            // grid and capacity, mirrored by light_cluster.comp and the pbr fragment shaders
+            static constexpr uint32_t kGridX                = 16;
+            static constexpr uint32_t kGridY                = 9;
+            static constexpr uint32_t kGridZ                = 24;
+            static constexpr uint32_t kClusterCount         = kGridX * kGridY * kGridZ;
+            static constexpr uint32_t kMaxLights            = 4096;
+            static constexpr uint32_t kMaxLightsPerCluster  = 63;
+            static constexpr uint32_t kClusterStride        = kMaxLightsPerCluster + 1;     // uints per cluster record
+
+            // std430 light record
+            struct PointLight
+            {
+                glm::vec4 mPositionRadius;      // xyz: world-space position, w: range
+                glm::vec4 mColorIntensity;      // rgb: color, w: intensity
+            };
+
+            // creation and destruction
+            LightClusters() noexcept;
+            ~LightClusters();
+
+            // disable copy and move semantics to enforce unique ownership
+            LightClusters(const LightClusters&) = delete;
+            LightClusters& operator=(const LightClusters&) = delete;
+            LightClusters(LightClusters&&) = delete;
+            LightClusters& operator=(LightClusters&&) = delete;
+
+            // false without the compute pass; the light buffers are still usable when hasBuffers() holds
+            bool initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& spirvFile, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: write a frame's lights (clamped to kMaxLights), returns the count the frame will bin
+            uint32_t uploadLights(uint32_t frameIndex, const PointLight* lights, uint32_t count) noexcept;
+
+            // usage: record outside a render pass, before the draws that read the clusters.
+            // frustum: xy tangent of the horizontal and vertical half fov, z near, w far
+            void record(VkCommandBuffer commandBuffer, uint32_t frameIndex, const glm::mat4& view, const glm::vec4& frustum) const noexcept;
+
+            // depth slice mapping for the fragment stage: slice = log(viewDepth) * x + y
+            static glm::vec2 getSliceParams(float znear, float zfar) noexcept;
+
+            // accessors
+            bool isValid() const noexcept                                   { return m_pipeline.isValid() && !m_vkDescriptorSets.empty(); }
+            bool hasBuffers() const noexcept                                { return !m_lightBuffers.empty(); }
+            uint32_t getLightCount(uint32_t frameIndex) const noexcept      { return m_lightCounts[frameIndex]; }
+            VkBuffer getLightBuffer(uint32_t frameIndex) const noexcept     { return m_lightBuffers[frameIndex].get(); }
+            VkBuffer getClusterBuffer(uint32_t frameIndex) const noexcept   { return m_clusterBuffers[frameIndex].get(); }
+
+        private:
+            bool createBuffers(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, uint32_t frameCount) noexcept;
+            bool createDescriptorResources(uint32_t frameCount) noexcept;
+            bool createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkDescriptorSetLayout           m_vkDescriptorSetLayout;
+            VkDescriptorPool                m_vkDescriptorPool;
+            std::vector<VkDescriptorSet>    m_vkDescriptorSets;
+            VulkanPipeline                  m_pipeline;
+            uint32_t                        m_workgroupSize;
+
+            // per-frame lights (host-visible, persistently mapped) and cluster records (device-local)
+            std::vector<VulkanBuffer>       m_lightBuffers;
+            std::vector<VulkanBuffer>       m_clusterBuffers;
+            std::vector<uint32_t>           m_lightCounts;
+    };
+}   // namespace keplar
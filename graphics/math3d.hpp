@@ -20,3 +20,139 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #pragma warning(pop)
+
+#include <limits>
+#include <utility>
+
+namespace keplar
+{
+    // axis-aligned bounding box; default constructed empty (min > max)
+    struct BoundingBox
+    {
+        glm::vec3 mMin = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 mMax = glm::vec3(std::numeric_limits<float>::lowest());
+
+        bool isValid() const noexcept { return mMin.x <= mMax.x && mMin.y <= mMax.y && mMin.z <= mMax.z; }
+        glm::vec3 getCenter() const noexcept { return 0.5f * (mMin + mMax); }
+        glm::vec3 getExtent() const noexcept { return 0.5f * (mMax - mMin); }
+
+        void expand(const glm::vec3& point) noexcept
+        {
+            mMin = glm::min(mMin, point);
+            mMax = glm::max(mMax, point);
+        }
+
+        void expand(const BoundingBox& other) noexcept
+        {
+            if (other.isValid())
+            {
+                mMin = glm::min(mMin, other.mMin);
+                mMax = glm::max(mMax, other.mMax);
+            }
+        }
+
+        // box enclosing this one under an affine transform (center/extent form, no corner loop)
+        BoundingBox transformed(const glm::mat4& transform) const noexcept
+        {
+            if (!isValid())
+            {
+                return *this;
+            }
+
+            const glm::vec3 center = glm::vec3(transform * glm::vec4(getCenter(), 1.0f));
+            const glm::mat3 absolute(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2])));
+            const glm::vec3 extent = absolute * getExtent();
+
+            BoundingBox box;
+            box.mMin = center - extent;
+            box.mMax = center + extent;
+            return box;
+        }
+    };
+
+    // view frustum as six inward-facing planes (xyz: normal, w: distance)
+    struct Frustum
+    {
+        enum Plane { kLeft = 0, kRight, kBottom, kTop, kNear, kFar, kPlaneCount };
+        glm::vec4 mPlanes[kPlaneCount];
+
+        // extract planes from a projection * view (* model) matrix, zero-to-one depth. reverse-z projections swap
+        // the near and far planes; an infinite far plane comes out as one that keeps everything
+        static Frustum fromMatrix(const glm::mat4& viewProjection) noexcept
+        {
+            const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+            const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+            const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+            const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+            Frustum frustum{};
+            frustum.mPlanes[kLeft]   = row3 + row0;
+            frustum.mPlanes[kRight]  = row3 - row0;
+            frustum.mPlanes[kBottom] = row3 + row1;
+            frustum.mPlanes[kTop]    = row3 - row1;
+            frustum.mPlanes[kNear]   = row2;
+            frustum.mPlanes[kFar]    = row3 - row2;
+
+            // depth grows towards the viewer (or stays constant, far at infinity) under reverse-z
+            const glm::vec3 depthRow(row2);
+            if (glm::dot(depthRow, glm::vec3(row3)) < 0.0f || glm::dot(depthRow, depthRow) == 0.0f)
+            {
+                std::swap(frustum.mPlanes[kNear], frustum.mPlanes[kFar]);
+            }
+
+            // normalize so plane distances are in world units
+            for (auto& plane : frustum.mPlanes)
+            {
+                plane = normalizePlane(plane);
+            }
+            return frustum;
+        }
+
+        // the same volume in the space a model-to-world transform maps from, e.g. to cull a placed model in its own space
+        Frustum transformed(const glm::mat4& modelToWorld) const noexcept
+        {
+            Frustum frustum{};
+            const glm::mat4 planeTransform = glm::transpose(modelToWorld);
+            for (int i = 0; i < kPlaneCount; ++i)
+            {
+                frustum.mPlanes[i] = normalizePlane(planeTransform * mPlanes[i]);
+            }
+            return frustum;
+        }
+
+        // conservative test: false only when the box lies fully outside one plane
+        bool intersectsBox(const BoundingBox& box) const noexcept
+        {
+            const glm::vec3 center = box.getCenter();
+            const glm::vec3 extent = box.getExtent();
+            for (const auto& plane : mPlanes)
+            {
+                const glm::vec3 normal(plane);
+                if (glm::dot(normal, center) + plane.w < -glm::dot(glm::abs(normal), extent))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool intersectsSphere(const glm::vec3& center, float radius) const noexcept
+        {
+            for (const auto& plane : mPlanes)
+            {
+                if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // unit normal; a plane without one (the far plane at infinity) becomes one every point lies inside
+        static glm::vec4 normalizePlane(const glm::vec4& plane) noexcept
+        {
+            const float length = glm::length(glm::vec3(plane));
+            return length > 0.0f ? plane / length : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    };
+}   // namespace keplar
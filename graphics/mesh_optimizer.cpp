@@ -0,0 +1,681 @@
+// ────────────────────────────────────────────
+//  File: mesh_optimizer.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "mesh_optimizer.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+    // modeled lru cache for scoring; larger than real hardware so scores stay smooth
+    constexpr int32_t kScoreCacheSize    = 32;
+    constexpr float   kLastTriangleScore = 0.75f;
+    constexpr float   kCacheDecayPower   = 1.5f;
+    constexpr float   kValenceBoostScale = 2.0f;
+    constexpr float   kValenceBoostPower = 0.5f;
+
+    // fifo cache used to find cold-cache cluster boundaries for overdraw sorting
+    constexpr uint32_t kFifoCacheSize = 16;
+
+    float scoreVertex(int32_t cachePosition, uint32_t liveTriangles) noexcept
+    {
+        // vertices with no triangles left are never picked
+        if (liveTriangles == 0)
+        {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // the last triangle's vertices get a fixed score to avoid immediately re-using its edge
+            if (cachePosition < 3)
+            {
+                score = kLastTriangleScore;
+            }
+            else 
+            {
+                const float scale = 1.0f / static_cast<float>(kScoreCacheSize - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, kCacheDecayPower);
+            }
+        }
+
+        // boost vertices with few triangles left so they retire early
+        return score + kValenceBoostScale * std::pow(static_cast<float>(liveTriangles), -kValenceBoostPower);
+    }
+
+    // symmetric 4x4 error quadric of a set of planes: the summed squared distance of a point to all of them
+    struct Quadric
+    {
+        double mXX = 0.0, mXY = 0.0, mXZ = 0.0, mXW = 0.0;
+        double mYY = 0.0, mYZ = 0.0, mYW = 0.0;
+        double mZZ = 0.0, mZW = 0.0;
+        double mWW = 0.0;
+
+        void addPlane(const glm::dvec3& normal, double distance) noexcept
+        {
+            mXX += normal.x * normal.x; mXY += normal.x * normal.y; mXZ += normal.x * normal.z; mXW += normal.x * distance;
+            mYY += normal.y * normal.y; mYZ += normal.y * normal.z; mYW += normal.y * distance;
+            mZZ += normal.z * normal.z; mZW += normal.z * distance;
+            mWW += distance * distance;
+        }
+
+        void add(const Quadric& other) noexcept
+        {
+            mXX += other.mXX; mXY += other.mXY; mXZ += other.mXZ; mXW += other.mXW;
+            mYY += other.mYY; mYZ += other.mYZ; mYW += other.mYW;
+            mZZ += other.mZZ; mZW += other.mZW;
+            mWW += other.mWW;
+        }
+
+        double evaluate(const glm::dvec3& p) const noexcept
+        {
+            const double error = p.x * p.x * mXX + p.y * p.y * mYY + p.z * p.z * mZZ + mWW +
+                                 2.0 * (p.x * p.y * mXY + p.x * p.z * mXZ + p.y * p.z * mYZ + p.x * mXW + p.y * mYW + p.z * mZW);
+            return std::max(error, 0.0);
+        }
+    };
+
+    // directed collapse of mFrom onto mTo
+    struct Collapse
+    {
+        uint32_t mFrom;
+        uint32_t mTo;
+        double   mError;
+    };
+
+    inline uint64_t makeEdgeKey(uint32_t a, uint32_t b) noexcept
+    {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    // normals that deviate this much from the average (cosine) leave too narrow a cone to ever cull
+    constexpr float kMinConeSpread = 0.1f;
+
+    // sphere around the meshlet's box and the cone containing its triangle normals
+    void computeMeshletBounds(keplar::mesh_optimizer::Meshlet& meshlet, const std::vector<uint32_t>& meshletVertices, 
+                              const std::vector<uint32_t>& meshletTriangles, const std::vector<glm::vec3>& positions) noexcept
+    {
+        const uint32_t* vertices = &meshletVertices[meshlet.mVertexOffset];
+        glm::vec3 minBounds = positions[vertices[0]];
+        glm::vec3 maxBounds = minBounds;
+        for (uint32_t i = 1; i < meshlet.mVertexCount; ++i)
+        {
+            minBounds = glm::min(minBounds, positions[vertices[i]]);
+            maxBounds = glm::max(maxBounds, positions[vertices[i]]);
+        }
+
+        meshlet.mCenter = 0.5f * (minBounds + maxBounds);
+        meshlet.mRadius = 0.0f;
+        for (uint32_t i = 0; i < meshlet.mVertexCount; ++i)
+        {
+            meshlet.mRadius = std::max(meshlet.mRadius, glm::length(positions[vertices[i]] - meshlet.mCenter));
+        }
+
+        // area-weighted average normal, then the widest deviation from it
+        std::vector<glm::vec3> normals;
+        normals.reserve(meshlet.mTriangleCount);
+        glm::vec3 axis(0.0f);
+        for (uint32_t t = 0; t < meshlet.mTriangleCount; ++t)
+        {
+            const uint32_t packed = meshletTriangles[meshlet.mTriangleOffset + t];
+            const glm::vec3& p0 = positions[vertices[packed & 0xFFu]];
+            const glm::vec3& p1 = positions[vertices[(packed >> 8) & 0xFFu]];
+            const glm::vec3& p2 = positions[vertices[(packed >> 16) & 0xFFu]];
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal);
+            axis += normal;
+            normals.push_back(area > 0.0f ? normal / area : glm::vec3(0.0f));
+        }
+
+        meshlet.mConeApex = meshlet.mCenter;
+        meshlet.mConeAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+        meshlet.mConeCutoff = 2.0f;
+        const float axisLength = glm::length(axis);
+        if (axisLength <= 0.0f)
+        {
+            return;
+        }
+        axis /= axisLength;
+
+        float minDot = 1.0f;
+        for (const glm::vec3& normal : normals)
+        {
+            minDot = std::min(minDot, glm::dot(normal, axis));
+        }
+        if (minDot <= kMinConeSpread)
+        {
+            return;
+        }
+
+        // apex: moved back along the axis until it lies behind every triangle's plane
+        float maxOffset = 0.0f;
+        for (uint32_t t = 0; t < meshlet.mTriangleCount; ++t)
+        {
+            const glm::vec3& p0 = positions[vertices[meshletTriangles[meshlet.mTriangleOffset + t] & 0xFFu]];
+            const float offset = glm::dot(meshlet.mCenter - p0, normals[t]) / glm::dot(axis, normals[t]);
+            maxOffset = std::max(maxOffset, offset);
+        }
+
+        meshlet.mConeApex = meshlet.mCenter - axis * maxOffset;
+        meshlet.mConeAxis = axis;
+        meshlet.mConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+namespace keplar::mesh_optimizer
+{
+    void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) noexcept
+    {
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2 || vertexCount == 0)
+        {
+            return;
+        }
+
+        // vertex -> triangle adjacency (compressed rows)
+        std::vector<uint32_t> liveTriangles(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            liveTriangles[indices[i]]++;
+        }
+
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+        }
+
+        std::vector<uint32_t> adjacency(adjacencyOffsets[vertexCount]);
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t tri = 0; tri < triangleCount; ++tri)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                adjacency[fill[indices[tri * 3 + c]]++] = tri;
+            }
+        }
+
+        // initial scores
+        std::vector<int32_t> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            vertexScores[v] = scoreVertex(-1, liveTriangles[v]);
+        }
+
+        std::vector<uint8_t> isEmitted(triangleCount, 0);
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+
+        // lru cache with room for the three incoming vertices
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> nextCache;
+        cache.reserve(kScoreCacheSize + 3);
+        nextCache.reserve(kScoreCacheSize + 3);
+
+        size_t scanCursor = 0;
+        int64_t bestTriangle = -1;
+        for (size_t emitted = 0; emitted < triangleCount; ++emitted)
+        {
+            // no cached candidate: take the next unemitted triangle in input order
+            if (bestTriangle < 0)
+            {
+                while (isEmitted[scanCursor])
+                {
+                    scanCursor++;
+                }
+                bestTriangle = static_cast<int64_t>(scanCursor);
+            }
+
+            // emit and retire the triangle from its vertices' adjacency
+            const uint32_t tri = static_cast<uint32_t>(bestTriangle);
+            isEmitted[tri] = 1;
+            for (int c = 0; c < 3; ++c)
+            {
+                const uint32_t vertex = indices[tri * 3 + c];
+                output.push_back(vertex);
+
+                uint32_t* begin = &adjacency[adjacencyOffsets[vertex]];
+                uint32_t* end   = begin + liveTriangles[vertex];
+                uint32_t* itr   = std::find(begin, end, tri);
+                if (itr != end)
+                {
+                    *itr = *(end - 1);
+                    liveTriangles[vertex]--;
+                }
+            }
+
+            // move the triangle's vertices to the front of the cache
+            nextCache.clear();
+            for (int c = 0; c < 3; ++c)
+            {
+                nextCache.push_back(indices[tri * 3 + c]);
+            }
+            for (const uint32_t vertex : cache)
+            {
+                if (vertex != nextCache[0] && vertex != nextCache[1] && vertex != nextCache[2])
+                {
+                    nextCache.push_back(vertex);
+                }
+            }
+
+            // evicted vertices fall out of the cache
+            for (size_t i = kScoreCacheSize; i < nextCache.size(); ++i)
+            {
+                cachePositions[nextCache[i]] = -1;
+                vertexScores[nextCache[i]] = scoreVertex(-1, liveTriangles[nextCache[i]]);
+            }
+            nextCache.resize(std::min<size_t>(nextCache.size(), kScoreCacheSize));
+            std::swap(cache, nextCache);
+
+            // rescore cached vertices
+            for (size_t i = 0; i < cache.size(); ++i)
+            {
+                cachePositions[cache[i]] = static_cast<int32_t>(i);
+                vertexScores[cache[i]] = scoreVertex(static_cast<int32_t>(i), liveTriangles[cache[i]]);
+            }
+
+            // score live triangles touching the cache and pick the best one
+            bestTriangle = -1;
+            float bestScore = -1.0f;
+            for (const uint32_t vertex : cache)
+            {
+                for (uint32_t a = 0; a < liveTriangles[vertex]; ++a)
+                {
+                    const uint32_t candidate = adjacency[adjacencyOffsets[vertex] + a];
+                    const float score = vertexScores[indices[candidate * 3]] + vertexScores[indices[candidate * 3 + 1]] + vertexScores[indices[candidate * 3 + 2]];
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = candidate;
+                    }
+                }
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    void optimizeOverdraw(uint32_t* indices, size_t indexCount, const std::vector<glm::vec3>& positions) noexcept
+    {
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2 || positions.empty())
+        {
+            return;
+        }
+
+        // split where all three vertices miss a fifo cache: reordering at those points costs no cache hits
+        std::vector<uint32_t> clusterStarts;
+        std::vector<uint32_t> cacheTimestamps(positions.size(), 0);
+        uint32_t timestamp = kFifoCacheSize + 1;
+        for (uint32_t tri = 0; tri < triangleCount; ++tri)
+        {
+            uint32_t misses = 0;
+            for (int c = 0; c < 3; ++c)
+            {
+                const uint32_t vertex = indices[tri * 3 + c];
+                if (timestamp - cacheTimestamps[vertex] > kFifoCacheSize)
+                {
+                    cacheTimestamps[vertex] = timestamp++;
+                    misses++;
+                }
+            }
+
+            if (tri == 0 || misses == 3)
+            {
+                clusterStarts.push_back(tri);
+            }
+        }
+
+        if (clusterStarts.size() < 2)
+        {
+            return;
+        }
+
+        // area-weighted centroid and normal per cluster, plus the mesh centroid
+        struct Cluster
+        {
+            uint32_t  mFirstTriangle;
+            uint32_t  mTriangleCount;
+            glm::vec3 mCentroid;
+            glm::vec3 mNormal;
+            float     mSortKey;
+        };
+
+        std::vector<Cluster> clusters(clusterStarts.size());
+        glm::vec3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+        for (size_t i = 0; i < clusters.size(); ++i)
+        {
+            Cluster& cluster = clusters[i];
+            cluster.mFirstTriangle = clusterStarts[i];
+            cluster.mTriangleCount = (i + 1 < clusterStarts.size() ? clusterStarts[i + 1] : static_cast<uint32_t>(triangleCount)) - clusterStarts[i];
+            cluster.mCentroid = glm::vec3(0.0f);
+            cluster.mNormal = glm::vec3(0.0f);
+
+            float clusterArea = 0.0f;
+            for (uint32_t tri = cluster.mFirstTriangle; tri < cluster.mFirstTriangle + cluster.mTriangleCount; ++tri)
+            {
+                const glm::vec3& p0 = positions[indices[tri * 3]];
+                const glm::vec3& p1 = positions[indices[tri * 3 + 1]];
+                const glm::vec3& p2 = positions[indices[tri * 3 + 2]];
+                const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                const float area = glm::length(normal);
+
+                cluster.mCentroid += (p0 + p1 + p2) * (area / 3.0f);
+                cluster.mNormal += normal;
+                clusterArea += area;
+            }
+
+            meshCentroid += cluster.mCentroid;
+            meshArea += clusterArea;
+            cluster.mCentroid = clusterArea > 0.0f ? cluster.mCentroid / clusterArea : positions[indices[cluster.mFirstTriangle * 3]];
+        }
+        meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+        // clusters facing away from the center are likely occluders, draw them first
+        for (auto& cluster : clusters)
+        {
+            const float normalLength = glm::length(cluster.mNormal);
+            cluster.mSortKey = normalLength > 0.0f ? glm::dot(cluster.mCentroid - meshCentroid, cluster.mNormal / normalLength) : 0.0f;
+        }
+        std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.mSortKey > b.mSortKey; });
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (const auto& cluster : clusters)
+        {
+            output.insert(output.end(), indices + cluster.mFirstTriangle * 3, indices + (cluster.mFirstTriangle + cluster.mTriangleCount) * 3);
+        }
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    std::vector<uint32_t> optimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount) noexcept
+    {
+        // first use assigns the next slot
+        constexpr uint32_t kUnassigned = ~0u;
+        std::vector<uint32_t> remap(vertexCount, kUnassigned);
+        uint32_t nextVertex = 0;
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            uint32_t& slot = remap[indices[i]];
+            if (slot == kUnassigned)
+            {
+                slot = nextVertex++;
+            }
+            indices[i] = slot;
+        }
+
+        // keep unreferenced vertices so vertex counts stay unchanged
+        for (auto& slot : remap)
+        {
+            if (slot == kUnassigned)
+            {
+                slot = nextVertex++;
+            }
+        }
+        return remap;
+    }
+
+    std::vector<uint32_t> simplify(const uint32_t* indices, size_t indexCount, const std::vector<glm::vec3>& positions,
+                                   size_t targetIndexCount, float maxError, float& resultError) noexcept
+    {
+        std::vector<uint32_t> result(indices, indices + indexCount);
+        const size_t vertexCount = positions.size();
+        resultError = 0.0f;
+        if (indexCount % 3 != 0 || indexCount <= targetIndexCount || vertexCount == 0)
+        {
+            return result;
+        }
+
+        // one plane per triangle on each of its corners
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i < indexCount; i += 3)
+        {
+            const glm::dvec3 p0(positions[indices[i + 0]]);
+            const glm::dvec3 p1(positions[indices[i + 1]]);
+            const glm::dvec3 p2(positions[indices[i + 2]]);
+            const glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const double area = glm::length(normal);
+            if (area <= 0.0)
+            {
+                continue;
+            }
+
+            const glm::dvec3 unitNormal = normal / area;
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                quadrics[indices[i + corner]].addPlane(unitNormal, -glm::dot(unitNormal, p0));
+            }
+        }
+
+        // edges used by a single triangle are open; their vertices are locked
+        std::unordered_map<uint64_t, uint32_t> edgeUses;
+        edgeUses.reserve(indexCount);
+        for (size_t i = 0; i < indexCount; i += 3)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                edgeUses[makeEdgeKey(indices[i + corner], indices[i + (corner + 1) % 3])]++;
+            }
+        }
+
+        std::vector<uint8_t> isLocked(vertexCount, 0);
+        for (const auto& [key, uses] : edgeUses)
+        {
+            if (uses == 1)
+            {
+                isLocked[static_cast<uint32_t>(key >> 32)] = 1;
+                isLocked[static_cast<uint32_t>(key)] = 1;
+            }
+        }
+
+        const double maxQuadricError = static_cast<double>(maxError) * static_cast<double>(maxError);
+        double acceptedError = 0.0;
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint8_t> isTouched(vertexCount);
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+        std::vector<uint32_t> adjacency;
+        std::vector<Collapse> collapses;
+
+        // passes of independent collapses, cheapest first, until the target or the error bound is reached
+        while (result.size() > targetIndexCount)
+        {
+            const size_t triangleCount = result.size() / 3;
+
+            // vertex -> triangle adjacency of the current list (compressed rows)
+            std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+            for (const uint32_t index : result)
+            {
+                adjacencyOffsets[index + 1]++;
+            }
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+            }
+
+            adjacency.resize(result.size());
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    adjacency[fill[result[t * 3 + corner]]++] = static_cast<uint32_t>(t);
+                }
+            }
+
+            // the cheaper direction of every edge with an unlocked end (interior edges are listed once per triangle)
+            collapses.clear();
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    const uint32_t a = result[t * 3 + corner];
+                    const uint32_t b = result[t * 3 + (corner + 1) % 3];
+                    Quadric quadric = quadrics[a];
+                    quadric.add(quadrics[b]);
+                    const double errorAB = isLocked[a] ? HUGE_VAL : quadric.evaluate(glm::dvec3(positions[b]));
+                    const double errorBA = isLocked[b] ? HUGE_VAL : quadric.evaluate(glm::dvec3(positions[a]));
+                    if (errorAB == HUGE_VAL && errorBA == HUGE_VAL)
+                    {
+                        continue;
+                    }
+                    collapses.push_back(errorAB <= errorBA ? Collapse{ a, b, errorAB } : Collapse{ b, a, errorBA });
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.mError < y.mError; });
+
+            // a collapse freezes the one-ring of its source for the rest of the pass, so the flip test stays valid
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                remap[v] = static_cast<uint32_t>(v);
+            }
+            std::fill(isTouched.begin(), isTouched.end(), 0);
+
+            size_t remainingIndexCount = result.size();
+            size_t collapseCount = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (collapse.mError > maxQuadricError || remainingIndexCount <= targetIndexCount)
+                {
+                    break;
+                }
+                if (isTouched[collapse.mFrom] || isTouched[collapse.mTo])
+                {
+                    continue;
+                }
+
+                // reject collapses that flip a surviving triangle around the source
+                bool isFlipped = false;
+                uint32_t removedTriangles = 0;
+                for (uint32_t i = adjacencyOffsets[collapse.mFrom]; i < adjacencyOffsets[collapse.mFrom + 1] && !isFlipped; ++i)
+                {
+                    const uint32_t* triangle = &result[adjacency[i] * 3];
+                    if (triangle[0] == collapse.mTo || triangle[1] == collapse.mTo || triangle[2] == collapse.mTo)
+                    {
+                        removedTriangles++;
+                        continue;
+                    }
+
+                    glm::vec3 corners[3];
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        corners[corner] = positions[triangle[corner] == collapse.mFrom ? collapse.mTo : triangle[corner]];
+                    }
+                    const glm::vec3 before = glm::cross(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]);
+                    const glm::vec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                    isFlipped = glm::dot(before, after) <= 0.0f;
+                }
+                if (isFlipped)
+                {
+                    continue;
+                }
+
+                remap[collapse.mFrom] = collapse.mTo;
+                quadrics[collapse.mTo].add(quadrics[collapse.mFrom]);
+                for (uint32_t i = adjacencyOffsets[collapse.mFrom]; i < adjacencyOffsets[collapse.mFrom + 1]; ++i)
+                {
+                    const uint32_t* triangle = &result[adjacency[i] * 3];
+                    isTouched[triangle[0]] = isTouched[triangle[1]] = isTouched[triangle[2]] = 1;
+                }
+
+                acceptedError = std::max(acceptedError, collapse.mError);
+                remainingIndexCount -= std::min<size_t>(remainingIndexCount, removedTriangles * 3);
+                collapseCount++;
+            }
+
+            if (collapseCount == 0)
+            {
+                break;
+            }
+
+            // apply the pass and drop the triangles that collapsed to an edge
+            size_t writeIndex = 0;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const uint32_t a = remap[result[t * 3 + 0]];
+                const uint32_t b = remap[result[t * 3 + 1]];
+                const uint32_t c = remap[result[t * 3 + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    result[writeIndex++] = a;
+                    result[writeIndex++] = b;
+                    result[writeIndex++] = c;
+                }
+            }
+            result.resize(writeIndex);
+        }
+
+        resultError = static_cast<float>(std::sqrt(acceptedError));
+        return result;
+    }
+
+    std::vector<Meshlet> buildMeshlets(const uint32_t* indices, size_t indexCount, const std::vector<glm::vec3>& positions,
+                                       size_t maxVertices, size_t maxTriangles, std::vector<uint32_t>& meshletVertices, 
+                                       std::vector<uint32_t>& meshletTriangles) noexcept
+    {
+        std::vector<Meshlet> meshlets;
+        maxVertices = std::min<size_t>(maxVertices, 256);
+        if (indexCount % 3 != 0 || maxVertices < 3 || maxTriangles == 0)
+        {
+            return meshlets;
+        }
+
+        // local slot of each vertex in the open meshlet
+        std::unordered_map<uint32_t, uint32_t> localSlots;
+        Meshlet meshlet{};
+        meshlet.mVertexOffset = static_cast<uint32_t>(meshletVertices.size());
+        meshlet.mTriangleOffset = static_cast<uint32_t>(meshletTriangles.size());
+
+        auto closeMeshlet = [&]() noexcept
+        {
+            computeMeshletBounds(meshlet, meshletVertices, meshletTriangles, positions);
+            meshlets.push_back(meshlet);
+            meshlet = Meshlet{};
+            meshlet.mVertexOffset = static_cast<uint32_t>(meshletVertices.size());
+            meshlet.mTriangleOffset = static_cast<uint32_t>(meshletTriangles.size());
+            localSlots.clear();
+        };
+
+        for (size_t t = 0; t < indexCount; t += 3)
+        {
+            // vertices the triangle would add to the open meshlet
+            uint32_t newVertices = 0;
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const bool isRepeated = (corner > 0 && indices[t + corner] == indices[t]) || (corner > 1 && indices[t + 2] == indices[t + 1]);
+                newVertices += (!isRepeated && localSlots.find(indices[t + corner]) == localSlots.end()) ? 1u : 0u;
+            }
+
+            if (meshlet.mVertexCount + newVertices > maxVertices || meshlet.mTriangleCount + 1 > maxTriangles)
+            {
+                closeMeshlet();
+            }
+
+            uint32_t packed = 0;
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                auto [slot, isInserted] = localSlots.try_emplace(indices[t + corner], meshlet.mVertexCount);
+                if (isInserted)
+                {
+                    ++meshlet.mVertexCount;
+                    meshletVertices.push_back(indices[t + corner]);
+                }
+                packed |= slot->second << (8 * corner);
+            }
+            meshletTriangles.push_back(packed);
+            ++meshlet.mTriangleCount;
+        }
+
+        if (meshlet.mTriangleCount > 0)
+        {
+            closeMeshlet();
+        }
+        return meshlets;
+    }
+}   // namespace keplar::mesh_optimizer
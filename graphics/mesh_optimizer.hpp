@@ -0,0 +1,68 @@
+// ────────────────────────────────────────────
+//  File: mesh_optimizer.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "math3d.hpp"
+
+// load-time index and vertex reordering for triangle lists. indices are local to one primitive,
+// i.e. in [0, vertexCount). run in order: vertex cache, overdraw, then vertex fetch.
+namespace keplar::mesh_optimizer
+{
+    // triangle cluster for mesh shading, with bounds for per-cluster culling (in the units of the positions given)
+    struct Meshlet
+    {
+        uint32_t  mVertexOffset;    // first entry in the meshlet vertex array
+        uint32_t  mTriangleOffset;  // first entry in the meshlet triangle array
+        uint32_t  mVertexCount;
+        uint32_t  mTriangleCount;
+        glm::vec3 mCenter;          // bounding sphere
+        float     mRadius;
+        glm::vec3 mConeApex;        // backface cone: every triangle faces away from a viewer at v when
+        glm::vec3 mConeAxis;        // dot(normalize(mConeApex - v), mConeAxis) >= mConeCutoff
+        float     mConeCutoff;      // > 1 when the normals spread too far for a cone (never culled)
+    };
+
+    // reorder triangles for post-transform cache hits (Forsyth's linear-speed algorithm)
+    void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) noexcept;
+
+    // reorder cache-coherent triangle clusters so outward-facing ones are drawn first.
+    // clusters are split where the cache would be cold anyway, so cache efficiency is preserved
+    void optimizeOverdraw(uint32_t* indices, size_t indexCount, const std::vector<glm::vec3>& positions) noexcept;
+
+    // renumber vertices in first-use order; returns old -> new remap (unreferenced vertices are moved to the end)
+    std::vector<uint32_t> optimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount) noexcept;
+
+    // quadric error edge collapse onto existing vertices, so the result indexes the same vertex data. vertices on open
+    // edges (mesh borders and attribute seams, where vertices are split) never move. collapses stop at targetIndexCount
+    // or once the next one would exceed maxError; resultError is the largest error accepted, a conservative distance
+    // in position units. returns the simplified triangle list
+    std::vector<uint32_t> simplify(const uint32_t* indices, size_t indexCount, const std::vector<glm::vec3>& positions,
+                                   size_t targetIndexCount, float maxError, float& resultError) noexcept;
+
+    // split a triangle list into meshlets of at most maxVertices (<= 256) vertices and maxTriangles triangles, in index
+    // order, so run it after optimizeVertexCache. meshletVertices receives each meshlet's vertices (the given indices),
+    // meshletTriangles one word per triangle holding three 8-bit indices into its meshlet's vertices; both are appended to,
+    // so several primitives can share the arrays. bounds come from geometric normals, so degenerate triangles never cull
+    std::vector<Meshlet> buildMeshlets(const uint32_t* indices, size_t indexCount, const std::vector<glm::vec3>& positions,
+                                       size_t maxVertices, size_t maxTriangles, std::vector<uint32_t>& meshletVertices, 
+                                       std::vector<uint32_t>& meshletTriangles) noexcept;
+
+    // apply a remap from optimizeVertexFetch to a per-vertex array
+    template<typename T>
+    void remapVertices(T* vertices, size_t vertexCount, const std::vector<uint32_t>& remap)
+    {
+        std::vector<T> reordered(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            reordered[remap[i]] = vertices[i];
+        }
+        std::copy(reordered.begin(), reordered.end(), vertices);
+    }
+}   // namespace keplar::mesh_optimizer
@@ -0,0 +1,511 @@
+// ────────────────────────────────────────────
+//  File: mip_generator.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "mip_generator.hpp"
+
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // must match local_size_x and the 64x64 tile in mip_downsample.comp
+    constexpr uint32_t kTileSize = 64;
+
+    // descriptor bindings (set: 0)
+    constexpr uint32_t kImageBinding   = 0;
+    constexpr uint32_t kJobBinding     = 1;
+    constexpr uint32_t kCounterBinding = 2;
+
+    // job flags
+    constexpr uint32_t kFlagSrgb      = 1u << 0;
+    constexpr uint32_t kFlagNormalMap = 1u << 1;
+
+    // mip_downsample.comp MipJob (std430)
+    struct MipJob
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipLevels;
+        uint32_t flags;
+        uint32_t tileBase;
+        uint32_t tilesX;
+        uint32_t tileCount;
+        uint32_t imageBase;
+    };
+
+    // push constants: dispatch parameters
+    struct MipPushConstants
+    {
+        uint32_t jobCount;
+    };
+
+    // per-slot buffer regions; 256 bytes satisfies every legal minStorageBufferOffsetAlignment
+    constexpr VkDeviceSize kJobRegionSize     = keplar::MipGenerator::kMaxBatchSize * sizeof(MipJob);
+    constexpr VkDeviceSize kCounterRegionSize = 256;
+    static_assert(kJobRegionSize % 256 == 0, "job table regions must stay storage-buffer aligned");
+    static_assert(keplar::MipGenerator::kMaxBatchSize * sizeof(uint32_t) <= kCounterRegionSize, "counter region too small for a batch");
+
+    uint32_t getTileCount(uint32_t extent) noexcept
+    {
+        return (extent + kTileSize - 1) / kTileSize;
+    }
+}
+
+namespace keplar
+{
+    MipGenerator::MipGenerator() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_nextSlot(0)
+        , m_batchSize(0)
+        , m_maxWorkgroupCount(0)
+    {
+    }
+
+    MipGenerator::~MipGenerator()
+    {
+        destroy();
+    }
+
+    bool MipGenerator::initialize(const VulkanDevice& device, const std::string& spirvFile) noexcept
+    {
+        m_vkDevice = device.getDevice();
+
+        // the shader indexes the level views of each job with a workgroup-uniform index
+        if (device.getEnabledFeatures().shaderStorageImageArrayDynamicIndexing != VK_TRUE)
+        {
+            VK_LOG_WARN("MipGenerator :: shaderStorageImageArrayDynamicIndexing is not enabled");
+            destroy();
+            return false;
+        }
+
+        if (!device.isFormatSupported(VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT))
+        {
+            VK_LOG_WARN("MipGenerator :: rgba8 storage images are not supported");
+            destroy();
+            return false;
+        }
+
+        // batch as many images as the per-stage storage image limit allows
+        const VkPhysicalDeviceLimits& limits = device.getPhysicalDeviceProperties().limits;
+        const uint32_t maxImages = std::min(limits.maxPerStageDescriptorStorageImages, limits.maxDescriptorSetStorageImages);
+        m_batchSize = std::min(kMaxBatchSize, maxImages / kMaxMipLevels);
+        m_maxWorkgroupCount = limits.maxComputeWorkGroupCount[0];
+        if (m_batchSize == 0)
+        {
+            VK_LOG_WARN("MipGenerator :: storage image limit %u is too low", maxImages);
+            destroy();
+            return false;
+        }
+
+        if (!createDescriptorResources(device) || !createPipeline(device, spirvFile))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("MipGenerator::initialize successful (batch size: %u)", m_batchSize);
+        return true;
+    }
+
+    void MipGenerator::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // callers destroy the generator once the device is idle, so pending slots can be released directly
+        for (auto& slot : m_slots)
+        {
+            releaseSlot(slot);
+            slot.mDescriptorSet = VK_NULL_HANDLE;
+        }
+
+        m_pipeline.destroy();
+
+        // descriptor sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+
+        if (m_vkDescriptorSetLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(m_vkDevice, m_vkDescriptorSetLayout, nullptr);
+            m_vkDescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        m_jobBuffer     = VulkanBuffer{};
+        m_counterBuffer = VulkanBuffer{};
+        m_nextSlot      = 0;
+        m_batchSize     = 0;
+        m_vkDevice      = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("mip generator destroyed successfully");
+    }
+
+    bool MipGenerator::canGenerate(const VkExtent2D& extent, uint32_t mipLevels) const noexcept
+    {
+        return isValid() && extent.width > 0 && extent.height > 0 && mipLevels > 1 && mipLevels <= kMaxMipLevels &&
+               getTileCount(extent.width) * getTileCount(extent.height) <= m_maxWorkgroupCount;
+    }
+
+    bool MipGenerator::generate(VulkanStagingBelt& stagingBelt, const std::vector<MipGenerationJob>& jobs) noexcept
+    {
+        if (!isValid())
+        {
+            VK_LOG_ERROR("MipGenerator::generate :: generator is not initialized");
+            return false;
+        }
+
+        for (const auto& job : jobs)
+        {
+            if (job.mImage == VK_NULL_HANDLE || !canGenerate(job.mExtent, job.mMipLevels))
+            {
+                VK_LOG_ERROR("MipGenerator::generate :: unsupported job (%ux%u, %u levels)", job.mExtent.width, job.mExtent.height, job.mMipLevels);
+                return false;
+            }
+        }
+
+        // split into batches bounded by the descriptor array and the dispatch size
+        size_t first = 0;
+        while (first < jobs.size())
+        {
+            size_t last = first;
+            uint32_t tileCount = 0;
+            while (last < jobs.size() && last - first < m_batchSize)
+            {
+                const uint32_t jobTiles = getTileCount(jobs[last].mExtent.width) * getTileCount(jobs[last].mExtent.height);
+                if (tileCount + jobTiles > m_maxWorkgroupCount)
+                {
+                    break;
+                }
+                tileCount += jobTiles;
+                ++last;
+            }
+
+            if (!recordBatch(stagingBelt, jobs.data() + first, static_cast<uint32_t>(last - first)))
+            {
+                return false;
+            }
+            first = last;
+        }
+
+        return true;
+    }
+
+    bool MipGenerator::acquireSlot(VulkanStagingBelt& stagingBelt, Slot*& slot) noexcept
+    {
+        const uint32_t slotIndex = m_nextSlot;
+        m_nextSlot = (m_nextSlot + 1) % kSlotCount;
+        slot = &m_slots[slotIndex];
+
+        // reuse the slot only once the batch that read its views and job table has completed
+        if (slot->mTicket != VulkanStagingBelt::kInvalidTicket)
+        {
+            const bool isRecording = slot->mTicket > stagingBelt.getLastSubmittedTicket();
+            if (isRecording ? !stagingBelt.flush(true) : (!stagingBelt.isComplete(slot->mTicket) && !stagingBelt.wait(slot->mTicket)))
+            {
+                VK_LOG_ERROR("MipGenerator :: failed to wait for the batch using slot %u", slotIndex);
+                return false;
+            }
+        }
+
+        releaseSlot(*slot);
+        return true;
+    }
+
+    bool MipGenerator::recordBatch(VulkanStagingBelt& stagingBelt, const MipGenerationJob* jobs, uint32_t jobCount) noexcept
+    {
+        Slot* slot = nullptr;
+        if (jobCount == 0 || !acquireSlot(stagingBelt, slot))
+        {
+            return false;
+        }
+
+        const uint32_t slotIndex = static_cast<uint32_t>(slot - m_slots.data());
+        MipJob* jobTable = reinterpret_cast<MipJob*>(static_cast<uint8_t*>(m_jobBuffer.getMappedData()) + slotIndex * kJobRegionSize);
+
+        // storage views of every level; levels a job does not have alias its level 0 so the whole array stays valid
+        std::vector<VkDescriptorImageInfo> imageInfos(static_cast<size_t>(m_batchSize) * kMaxMipLevels);
+        uint32_t tileBase = 0;
+        for (uint32_t i = 0; i < jobCount; ++i)
+        {
+            const MipGenerationJob& job = jobs[i];
+            for (uint32_t level = 0; level < job.mMipLevels; ++level)
+            {
+                // srgb images are written through a unorm view; the shader encodes srgb itself
+                VkImageViewCreateInfo viewInfo{};
+                viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                viewInfo.pNext                           = nullptr;
+                viewInfo.flags                           = 0;
+                viewInfo.image                           = job.mImage;
+                viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.format                          = VK_FORMAT_R8G8B8A8_UNORM;
+                viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                             VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+                viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                viewInfo.subresourceRange.baseMipLevel   = level;
+                viewInfo.subresourceRange.levelCount     = 1;
+                viewInfo.subresourceRange.baseArrayLayer = 0;
+                viewInfo.subresourceRange.layerCount     = 1;
+
+                VkImageView imageView = VK_NULL_HANDLE;
+                VkResult vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &imageView);
+                if (vkResult != VK_SUCCESS)
+                {
+                    VK_LOG_FATAL("MipGenerator :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                    return false;
+                }
+                slot->mImageViews.push_back(imageView);
+            }
+
+            const VkImageView* levelViews = slot->mImageViews.data() + (slot->mImageViews.size() - job.mMipLevels);
+            for (uint32_t level = 0; level < kMaxMipLevels; ++level)
+            {
+                VkDescriptorImageInfo& imageInfo = imageInfos[i * kMaxMipLevels + level];
+                imageInfo.sampler     = VK_NULL_HANDLE;
+                imageInfo.imageView   = levelViews[level < job.mMipLevels ? level : 0];
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            }
+
+            // one workgroup per 64x64 tile of level 0, numbered across the batch
+            MipJob& mipJob   = jobTable[i];
+            mipJob.width     = job.mExtent.width;
+            mipJob.height    = job.mExtent.height;
+            mipJob.mipLevels = job.mMipLevels;
+            mipJob.flags     = (job.mIsSrgb ? kFlagSrgb : 0u) | (job.mIsNormalMap ? kFlagNormalMap : 0u);
+            mipJob.tileBase  = tileBase;
+            mipJob.tilesX    = getTileCount(job.mExtent.width);
+            mipJob.tileCount = mipJob.tilesX * getTileCount(job.mExtent.height);
+            mipJob.imageBase = i * kMaxMipLevels;
+            tileBase += mipJob.tileCount;
+        }
+
+        m_jobBuffer.flush(static_cast<VkDeviceSize>(slotIndex) * kJobRegionSize, sizeof(MipJob) * jobCount);
+
+        // unused array elements repeat the first view
+        for (size_t i = static_cast<size_t>(jobCount) * kMaxMipLevels; i < imageInfos.size(); ++i)
+        {
+            imageInfos[i] = imageInfos[0];
+        }
+
+        VkWriteDescriptorSet write{};
+        write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext            = nullptr;
+        write.dstSet           = slot->mDescriptorSet;
+        write.dstBinding       = kImageBinding;
+        write.dstArrayElement  = 0;
+        write.descriptorCount  = static_cast<uint32_t>(imageInfos.size());
+        write.descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        write.pImageInfo       = imageInfos.data();
+        write.pBufferInfo      = nullptr;
+        write.pTexelBufferView = nullptr;
+        vkUpdateDescriptorSets(m_vkDevice, 1, &write, 0, nullptr);
+
+        // recorded after the ownership acquires of the uploads, on the graphics queue
+        VkCommandBuffer commandBuffer = stagingBelt.getGraphicsCommandBuffer();
+        if (commandBuffer == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("MipGenerator :: failed to get staging belt graphics command buffer");
+            return false;
+        }
+        slot->mTicket = stagingBelt.getLastSubmittedTicket() + 1;
+
+        MipPushConstants pushConstants{};
+        pushConstants.jobCount = jobCount;
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &slot->mDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MipPushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, tileBase, 1, 1);
+
+        // whole chains go to shader-read for sampling
+        std::vector<VkImageMemoryBarrier> barriers(jobCount);
+        for (uint32_t i = 0; i < jobCount; ++i)
+        {
+            VkImageMemoryBarrier& barrier           = barriers[i];
+            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.pNext                           = nullptr;
+            barrier.srcAccessMask                   = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image                           = jobs[i].mImage;
+            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.baseMipLevel   = 0;
+            barrier.subresourceRange.levelCount     = jobs[i].mMipLevels;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount     = 1;
+        }
+
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+        return true;
+    }
+
+    void MipGenerator::releaseSlot(Slot& slot) noexcept
+    {
+        for (VkImageView imageView : slot.mImageViews)
+        {
+            vkDestroyImageView(m_vkDevice, imageView, nullptr);
+        }
+        slot.mImageViews.clear();
+        slot.mTicket = VulkanStagingBelt::kInvalidTicket;
+    }
+
+    bool MipGenerator::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        // set: 0, bindings: level views of every job in the batch, job table, workgroup counters
+        const uint32_t imageCount = m_batchSize * kMaxMipLevels;
+        const std::array<VkDescriptorSetLayoutBinding, 3> bindings
+        {{
+            { kImageBinding,   VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  imageCount, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kJobBinding,     VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1,          VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kCounterBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1,          VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = nullptr;
+        layoutInfo.flags        = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings    = bindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &m_vkDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("MipGenerator :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // private pool sized for one set per slot
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  imageCount * kSlotCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 * kSlotCount }
+        }};
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = kSlotCount;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("MipGenerator :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        std::array<VkDescriptorSetLayout, kSlotCount> layouts;
+        layouts.fill(m_vkDescriptorSetLayout);
+        std::array<VkDescriptorSet, kSlotCount> descriptorSets{};
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = kSlotCount;
+        allocateInfo.pSetLayouts        = layouts.data();
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, descriptorSets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("MipGenerator :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // host-written job tables and zeroed counters (each dispatch leaves its counters at zero again)
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.pNext       = nullptr;
+        bufferInfo.flags       = 0;
+        bufferInfo.size        = kJobRegionSize * kSlotCount;
+        bufferInfo.usage       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_jobBuffer.createHostVisible(device, bufferInfo, nullptr, 0, true))
+        {
+            VK_LOG_ERROR("MipGenerator :: failed to create job buffer");
+            return false;
+        }
+
+        const std::vector<uint8_t> zeroCounters(static_cast<size_t>(kCounterRegionSize * kSlotCount), 0);
+        bufferInfo.size = kCounterRegionSize * kSlotCount;
+        if (!m_counterBuffer.createHostVisible(device, bufferInfo, zeroCounters.data(), zeroCounters.size()))
+        {
+            VK_LOG_ERROR("MipGenerator :: failed to create counter buffer");
+            return false;
+        }
+
+        // buffer bindings never change; image bindings are written per batch
+        for (uint32_t i = 0; i < kSlotCount; ++i)
+        {
+            m_slots[i].mDescriptorSet = descriptorSets[i];
+
+            const std::array<VkDescriptorBufferInfo, 2> bufferInfos
+            {{
+                { m_jobBuffer.get(),     i * kJobRegionSize,     kJobRegionSize },
+                { m_counterBuffer.get(), i * kCounterRegionSize, kCounterRegionSize }
+            }};
+
+            std::array<VkWriteDescriptorSet, 2> writes{};
+            for (uint32_t j = 0; j < writes.size(); ++j)
+            {
+                writes[j].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[j].pNext            = nullptr;
+                writes[j].dstSet           = descriptorSets[i];
+                writes[j].dstBinding       = j == 0 ? kJobBinding : kCounterBinding;
+                writes[j].dstArrayElement  = 0;
+                writes[j].descriptorCount  = 1;
+                writes[j].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[j].pImageInfo       = nullptr;
+                writes[j].pBufferInfo      = &bufferInfos[j];
+                writes[j].pTexelBufferView = nullptr;
+            }
+            vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        return true;
+    }
+
+    bool MipGenerator::createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept
+    {
+        // missing spir-v is not fatal; callers keep generating mips on the cpu
+        VulkanShader computeShader;
+        if (!computeShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, spirvFile))
+        {
+            VK_LOG_WARN("MipGenerator :: compute shader '%s' unavailable", spirvFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = computeShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkDescriptorSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MipPushConstants) } };
+
+        // constant_id 0 sizes the storage image array to the batch
+        pipelineConfig.addSpecializationConstant(0, m_batchSize * kMaxMipLevels);
+
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("MipGenerator :: failed to create compute pipeline");
+            return false;
+        }
+
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,95 @@
+// ────────────────────────────────────────────
+//  File: mip_generator.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // rgba8 image whose levels 1..mMipLevels-1 are generated from level 0
+    struct MipGenerationJob
+    {
+        VkImage     mImage          = VK_NULL_HANDLE;
+        VkExtent2D  mExtent         = { 0, 0 };
+        uint32_t    mMipLevels      = 0;
+        bool        mIsSrgb         = false;    // filter in linear space (image needs VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT)
+        bool        mIsNormalMap    = false;    // average as vectors and renormalize
+    };
+
+    // compute downsampler that builds the mip chains of many textures in one dispatch (see mip_downsample.comp),
+    // replacing per-texture vkCmdBlitImage chains and their linear-blit format requirement.
+    // dispatches are recorded into the staging belt's graphics command buffer; every batch owns a descriptor set,
+    // level views and a job table slot that are recycled once the belt batch that read them has completed
+    class MipGenerator final
+    {
+        public:
+            // 4096 base level: one tile pass to level 6, one last-workgroup pass to level 12
+            static constexpr uint32_t kMaxMipLevels = 13;
+            static constexpr uint32_t kMaxBatchSize = 32;
+            static constexpr uint32_t kSlotCount    = 4;
+
+            // creation and destruction
+            MipGenerator() noexcept;
+            ~MipGenerator();
+
+            // disable copy and move semantics to enforce unique ownership
+            MipGenerator(const MipGenerator&) = delete;
+            MipGenerator& operator=(const MipGenerator&) = delete;
+            MipGenerator(MipGenerator&&) = delete;
+            MipGenerator& operator=(MipGenerator&&) = delete;
+
+            bool initialize(const VulkanDevice& device, const std::string& spirvFile) noexcept;
+            void destroy() noexcept;
+
+            // usage: images are in VK_IMAGE_LAYOUT_GENERAL with level 0 acquired by the graphics queue for compute
+            // reads and writes; they leave in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for fragment sampling
+            bool generate(VulkanStagingBelt& stagingBelt, const std::vector<MipGenerationJob>& jobs) noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid(); }
+            bool canGenerate(const VkExtent2D& extent, uint32_t mipLevels) const noexcept;
+            uint32_t getBatchSize() const noexcept { return m_batchSize; }
+
+        private:
+            // resources of one recorded batch
+            struct Slot
+            {
+                VkDescriptorSet             mDescriptorSet = VK_NULL_HANDLE;
+                std::vector<VkImageView>    mImageViews;
+                VulkanStagingBelt::Ticket   mTicket = VulkanStagingBelt::kInvalidTicket;
+            };
+
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipeline(const VulkanDevice& device, const std::string& spirvFile) noexcept;
+            bool acquireSlot(VulkanStagingBelt& stagingBelt, Slot*& slot) noexcept;
+            bool recordBatch(VulkanStagingBelt& stagingBelt, const MipGenerationJob* jobs, uint32_t jobCount) noexcept;
+            void releaseSlot(Slot& slot) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                            m_vkDevice;
+            VkDescriptorSetLayout               m_vkDescriptorSetLayout;
+            VkDescriptorPool                    m_vkDescriptorPool;
+            VulkanPipeline                      m_pipeline;
+
+            // per-batch job tables and workgroup counters, one region per slot
+            VulkanBuffer                        m_jobBuffer;
+            VulkanBuffer                        m_counterBuffer;
+            std::array<Slot, kSlotCount>        m_slots;
+            uint32_t                            m_nextSlot;
+            uint32_t                            m_batchSize;
+            uint32_t                            m_maxWorkgroupCount;
+    };
+}   // namespace keplar
@@ -0,0 +1,243 @@
+// ────────────────────────────────────────────
+//  File: model_cache.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "model_cache.hpp"
+
+#include <fstream>
+#include <system_error>
+
+#include "utils/asset_pack.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // file layout: header, then the payload written by ModelCacheWriter
+    constexpr uint32_t kModelCacheMagic   = 0x4c444d4b;   // "KMDL"
+    constexpr uint32_t kModelCacheVersion = 11;     // bumped whenever a baked struct layout changes
+
+    struct alignas(16) ModelCacheFileHeader
+    {
+        uint32_t              mMagic;
+        uint32_t              mVersion;
+        keplar::ModelCacheKey mKey;
+        uint64_t              mPayloadSize;
+    };
+
+    static_assert(sizeof(ModelCacheFileHeader) % keplar::ModelCacheWriter::kAlignment == 0, "ModelCacheFileHeader must keep the payload aligned");
+
+    constexpr size_t alignUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+namespace keplar
+{
+    // ─────────────────────────────────────────────
+    // ModelCacheWriter implementation
+    // ─────────────────────────────────────────────
+    void ModelCacheWriter::writeBlob(const void* data, size_t size) noexcept
+    {
+        // size prefix, then the bytes on an aligned boundary
+        write(static_cast<uint64_t>(size));
+        m_payload.resize(alignUp(m_payload.size(), kAlignment), 0);
+        append(data, size);
+    }
+
+    void ModelCacheWriter::writeString(const std::string& value) noexcept
+    {
+        write(static_cast<uint64_t>(value.size()));
+        append(value.data(), value.size());
+    }
+
+    bool ModelCacheWriter::save(const std::filesystem::path& filepath, const ModelCacheKey& key) const noexcept
+    {
+        ModelCacheFileHeader header{};
+        header.mMagic       = kModelCacheMagic;
+        header.mVersion     = kModelCacheVersion;
+        header.mKey         = key;
+        header.mPayloadSize = m_payload.size();
+
+        // write to a temporary file and swap it in, so a crash never leaves a torn cache
+        std::error_code errorCode;
+        const std::filesystem::path tempPath = filepath.string() + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                VK_LOG_WARN("ModelCacheWriter::save :: failed to open %s for writing", tempPath.string().c_str());
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+            if (!file.good())
+            {
+                VK_LOG_WARN("ModelCacheWriter::save :: failed to write %s", tempPath.string().c_str());
+                file.close();
+                std::filesystem::remove(tempPath, errorCode);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, filepath, errorCode);
+        if (errorCode)
+        {
+            VK_LOG_WARN("ModelCacheWriter::save :: failed to replace %s : %s", filepath.string().c_str(), errorCode.message().c_str());
+            std::filesystem::remove(tempPath, errorCode);
+            return false;
+        }
+
+        VK_LOG_DEBUG("ModelCacheWriter::save :: wrote %zu bytes to %s", m_payload.size(), filepath.string().c_str());
+        return true;
+    }
+
+    void ModelCacheWriter::append(const void* data, size_t size) noexcept
+    {
+        if (size == 0)
+        {
+            return;
+        }
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_payload.insert(m_payload.end(), bytes, bytes + size);
+    }
+
+    // ─────────────────────────────────────────────
+    // ModelCacheReader implementation
+    // ─────────────────────────────────────────────
+    bool ModelCacheReader::open(const std::filesystem::path& filepath, const ModelCacheKey& key) noexcept
+    {
+        close();
+        if (!m_file.open(filepath))
+        {
+            return false;
+        }
+
+        // validate the header against the source asset and load options
+        ModelCacheFileHeader header{};
+        if (m_file.getSize() < sizeof(header))
+        {
+            VK_LOG_WARN("ModelCacheReader :: ignoring truncated cache file %s", filepath.string().c_str());
+            close();
+            return false;
+        }
+
+        std::memcpy(&header, m_file.getData(), sizeof(header));
+        const bool isCompatible = header.mMagic == kModelCacheMagic &&
+                                  header.mVersion == kModelCacheVersion &&
+                                  header.mKey.mSourceSize == key.mSourceSize &&
+                                  header.mKey.mSourceTime == key.mSourceTime &&
+                                  header.mKey.mVertexFormat == key.mVertexFormat &&
+                                  header.mKey.mFlags == key.mFlags &&
+                                  header.mPayloadSize == m_file.getSize() - sizeof(header);
+        if (!isCompatible)
+        {
+            VK_LOG_INFO("ModelCacheReader :: cache file %s is stale, rebaking", filepath.string().c_str());
+            close();
+            return false;
+        }
+
+        m_offset = sizeof(header);
+        m_end    = m_file.getSize();
+        return true;
+    }
+
+    void ModelCacheReader::close() noexcept
+    {
+        m_file.close();
+        m_offset = 0;
+        m_end    = 0;
+    }
+
+    bool ModelCacheReader::readBlob(const void*& data, size_t& size) noexcept
+    {
+        uint64_t blobSize = 0;
+        if (!read(blobSize) || blobSize > m_end)
+        {
+            return false;
+        }
+
+        // offsets are relative to the page-aligned mapping, so aligned offsets are aligned pointers
+        const uint8_t* blob = consume(static_cast<size_t>(blobSize), ModelCacheWriter::kAlignment);
+        if (blob == nullptr)
+        {
+            return false;
+        }
+
+        data = blob;
+        size = static_cast<size_t>(blobSize);
+        return true;
+    }
+
+    bool ModelCacheReader::readString(std::string& value) noexcept
+    {
+        uint64_t length = 0;
+        if (!read(length) || length > m_end)
+        {
+            return false;
+        }
+
+        const uint8_t* data = consume(static_cast<size_t>(length), 1);
+        if (data == nullptr)
+        {
+            return false;
+        }
+
+        value.assign(reinterpret_cast<const char*>(data), static_cast<size_t>(length));
+        return true;
+    }
+
+    const uint8_t* ModelCacheReader::consume(size_t size, size_t alignment) noexcept
+    {
+        const size_t offset = alignUp(m_offset, alignment);
+        if (!m_file.isOpen() || offset > m_end || size > m_end - offset)
+        {
+            return nullptr;
+        }
+
+        m_offset = offset + size;
+        return m_file.getData() + offset;
+    }
+
+    // ─────────────────────────────────────────────
+    // helpers
+    // ─────────────────────────────────────────────
+    std::filesystem::path getModelCachePath(const std::filesystem::path& sourcePath) noexcept
+    {
+        std::filesystem::path cachePath = sourcePath;
+        cachePath.replace_extension(".kmodel");
+        return cachePath;
+    }
+
+    bool getModelCacheKey(const std::filesystem::path& sourcePath, ModelCacheKey& key) noexcept
+    {
+        // a packed source changes with the pack
+        const AssetPack& assetPack = AssetPack::getInstance();
+        size_t packedSize = 0;
+        if (assetPack.getSize(sourcePath, packedSize))
+        {
+            key.mSourceSize = static_cast<uint64_t>(packedSize);
+            key.mSourceTime = assetPack.getWriteTime();
+            return true;
+        }
+
+        std::error_code errorCode;
+        const uintmax_t fileSize = std::filesystem::file_size(sourcePath, errorCode);
+        if (errorCode)
+        {
+            return false;
+        }
+
+        const auto writeTime = std::filesystem::last_write_time(sourcePath, errorCode);
+        if (errorCode)
+        {
+            return false;
+        }
+
+        key.mSourceSize = static_cast<uint64_t>(fileSize);
+        key.mSourceTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,135 @@
+// ────────────────────────────────────────────
+//  File: model_cache.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#include "utils/mapped_file.hpp"
+
+namespace keplar
+{
+    // identifies the source asset and load options a baked file was produced from; any mismatch rebakes
+    struct ModelCacheKey
+    {
+        uint64_t mSourceSize    = 0;
+        int64_t  mSourceTime    = 0;        // last write time of the source, in filesystem clock ticks
+        uint32_t mVertexFormat  = 0;
+        uint32_t mFlags         = 0;
+    };
+
+    // sequential binary archive for baked models. every array starts on a kAlignment boundary,
+    // so the reader can hand out pointers into the mapped file instead of copying
+    class ModelCacheWriter
+    {
+        public:
+            static constexpr size_t kAlignment = 16;
+
+            // usage: append values in the order the reader consumes them, then save
+            template<typename T>
+            void write(const T& value) noexcept
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "ModelCacheWriter::write requires a trivially copyable type");
+                append(&value, sizeof(T));
+            }
+
+            template<typename T>
+            void writeArray(const std::vector<T>& values) noexcept
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "ModelCacheWriter::writeArray requires a trivially copyable type");
+                writeBlob(values.data(), values.size() * sizeof(T));
+            }
+
+            void writeBlob(const void* data, size_t size) noexcept;
+            void writeString(const std::string& value) noexcept;
+
+            // writes header and payload to a temporary file and swaps it in
+            bool save(const std::filesystem::path& filepath, const ModelCacheKey& key) const noexcept;
+
+        private:
+            void append(const void* data, size_t size) noexcept;
+
+        private:
+            std::vector<uint8_t> m_payload;
+    };
+
+    // reads a baked file through a read-only mapping; blobs and views point into the mapping
+    // and stay valid until the reader is closed or destroyed
+    class ModelCacheReader
+    {
+        public:
+            // usage: open fails on a missing, truncated or stale file
+            bool open(const std::filesystem::path& filepath, const ModelCacheKey& key) noexcept;
+            void close() noexcept;
+
+            template<typename T>
+            bool read(T& value) noexcept
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "ModelCacheReader::read requires a trivially copyable type");
+                const uint8_t* data = consume(sizeof(T), 1);
+                if (data == nullptr)
+                {
+                    return false;
+                }
+
+                std::memcpy(&value, data, sizeof(T));
+                return true;
+            }
+
+            template<typename T>
+            bool readArray(std::vector<T>& values) noexcept
+            {
+                const T* data = nullptr;
+                size_t count = 0;
+                if (!readView(data, count))
+                {
+                    return false;
+                }
+
+                values.assign(data, data + count);
+                return true;
+            }
+
+            template<typename T>
+            bool readView(const T*& data, size_t& count) noexcept
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "ModelCacheReader::readView requires a trivially copyable type");
+                static_assert(alignof(T) <= ModelCacheWriter::kAlignment, "ModelCacheReader::readView alignment exceeds the archive alignment");
+                const void* blob = nullptr;
+                size_t size = 0;
+                if (!readBlob(blob, size) || size % sizeof(T) != 0)
+                {
+                    return false;
+                }
+
+                data  = static_cast<const T*>(blob);
+                count = size / sizeof(T);
+                return true;
+            }
+
+            bool readBlob(const void*& data, size_t& size) noexcept;
+            bool readString(std::string& value) noexcept;
+
+            // accessors
+            bool isOpen() const noexcept { return m_file.isOpen(); }
+
+        private:
+            const uint8_t* consume(size_t size, size_t alignment) noexcept;
+
+        private:
+            MappedFile  m_file;
+            size_t      m_offset = 0;
+            size_t      m_end = 0;
+    };
+
+    // baked file path for a source asset: the source path with a .kmodel extension
+    std::filesystem::path getModelCachePath(const std::filesystem::path& sourcePath) noexcept;
+
+    // size and timestamp of the source asset; false when it cannot be queried
+    bool getModelCacheKey(const std::filesystem::path& sourcePath, ModelCacheKey& key) noexcept;
+}   // namespace keplar
@@ -12,11 +12,12 @@ namespace keplar
 {
     MsaaTarget::MsaaTarget() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
         , m_colorImage(VK_NULL_HANDLE)
-        , m_colorMemory(VK_NULL_HANDLE)
+        , m_colorAllocation{}
         , m_colorImageView(VK_NULL_HANDLE)
         , m_depthImage(VK_NULL_HANDLE)
-        , m_depthMemory(VK_NULL_HANDLE)
+        , m_depthAllocation{}
         , m_depthImageView(VK_NULL_HANDLE)
         , m_extent{}
         , m_sampleCount(VK_SAMPLE_COUNT_1_BIT)
@@ -30,22 +31,24 @@ namespace keplar
 
     MsaaTarget::MsaaTarget(MsaaTarget&& other) noexcept
         : m_vkDevice(other.m_vkDevice)
+        , m_memoryAllocator(other.m_memoryAllocator)
         , m_colorImage(other.m_colorImage)
-        , m_colorMemory(other.m_colorMemory)
+        , m_colorAllocation(other.m_colorAllocation)
         , m_colorImageView(other.m_colorImageView)
         , m_depthImage(other.m_depthImage)
-        , m_depthMemory(other.m_depthMemory)
+        , m_depthAllocation(other.m_depthAllocation)
         , m_depthImageView(other.m_depthImageView)
         , m_extent(other.m_extent)
         , m_sampleCount(other.m_sampleCount)
     {
         // reset the other
         other.m_vkDevice = VK_NULL_HANDLE;
+        other.m_memoryAllocator = nullptr;
         other.m_colorImage = VK_NULL_HANDLE;
-        other.m_colorMemory = VK_NULL_HANDLE;
+        other.m_colorAllocation = VulkanAllocation{};
         other.m_colorImageView = VK_NULL_HANDLE;
         other.m_depthImage = VK_NULL_HANDLE;
-        other.m_depthMemory = VK_NULL_HANDLE;
+        other.m_depthAllocation = VulkanAllocation{};
         other.m_depthImageView = VK_NULL_HANDLE;
     }
 
@@ -59,22 +62,24 @@ namespace keplar
 
             // transfer ownership
             m_vkDevice = other.m_vkDevice;
+            m_memoryAllocator = other.m_memoryAllocator;
             m_colorImage = other.m_colorImage;
-            m_colorMemory = other.m_colorMemory;
+            m_colorAllocation = other.m_colorAllocation;
             m_colorImageView = other.m_colorImageView;
             m_depthImage = other.m_depthImage;
-            m_depthMemory = other.m_depthMemory;
+            m_depthAllocation = other.m_depthAllocation;
             m_depthImageView = other.m_depthImageView;
             m_extent = other.m_extent;
             m_sampleCount = other.m_sampleCount;
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
+            other.m_memoryAllocator = nullptr;
             other.m_colorImage = VK_NULL_HANDLE;
-            other.m_colorMemory = VK_NULL_HANDLE;
+            other.m_colorAllocation = VulkanAllocation{};
             other.m_colorImageView = VK_NULL_HANDLE;
             other.m_depthImage = VK_NULL_HANDLE;
-            other.m_depthMemory = VK_NULL_HANDLE;
+            other.m_depthAllocation = VulkanAllocation{};
             other.m_depthImageView = VK_NULL_HANDLE;
         }
 
@@ -83,8 +88,9 @@ namespace keplar
 
     bool MsaaTarget::initialize(const VulkanDevice& device, const VulkanSwapchain& swapchain, VkSampleCountFlagBits desiredSampleCount) noexcept
     {
-        // save device handle for cleanup
+        // save device handle and allocator for cleanup
         m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
         m_extent   = swapchain.getExtent();
 
         // retrieve device properties once
@@ -133,10 +139,9 @@ namespace keplar
         }
 
         // free depth memory
-        if (m_depthMemory != VK_NULL_HANDLE)
+        if (m_memoryAllocator && m_depthAllocation.isValid())
         {
-            vkFreeMemory(m_vkDevice, m_depthMemory, nullptr);
-            m_depthMemory = VK_NULL_HANDLE;
+            m_memoryAllocator->free(m_depthAllocation);
         }
 
         // destroy color image view
@@ -154,19 +159,30 @@ namespace keplar
         }
 
         // free color memory
-        if (m_colorMemory != VK_NULL_HANDLE)
+        if (m_memoryAllocator && m_colorAllocation.isValid())
         {
-            vkFreeMemory(m_vkDevice, m_colorMemory, nullptr);
-            m_colorMemory = VK_NULL_HANDLE;
+            m_memoryAllocator->free(m_colorAllocation);
         }
     }
 
     bool MsaaTarget::chooseSampleCount(const VkPhysicalDeviceProperties& deviceProperties, VkSampleCountFlagBits desiredSampleCount) noexcept
+    {
+        m_sampleCount = selectSampleCount(deviceProperties, desiredSampleCount);
+        if (m_sampleCount == VK_SAMPLE_COUNT_1_BIT)
+        {
+            // failure
+            VK_LOG_WARN("msaa is not supported beyond sample count 1");
+            return false;
+        }
+
+        // success
+        return true;
+    }
+
+    VkSampleCountFlagBits MsaaTarget::selectSampleCount(const VkPhysicalDeviceProperties& deviceProperties, VkSampleCountFlagBits desiredSampleCount) noexcept
     {
         // supported counts for color and depth
-        VkSampleCountFlags colorCounts = deviceProperties.limits.framebufferColorSampleCounts;
-        VkSampleCountFlags depthCounts = deviceProperties.limits.framebufferDepthSampleCounts;
-        VkSampleCountFlags supportedCounts = colorCounts & depthCounts;
+        const VkSampleCountFlags supportedCounts = getSupportedSampleCounts(deviceProperties);
 
         // candidate msaa levels
         const VkSampleCountFlagBits candidates[] = 
@@ -184,15 +200,16 @@ namespace keplar
         {
             if (count <= desiredSampleCount && (supportedCounts & count)) 
             {
-                // success
-                m_sampleCount = count;
-                return true;
+                return count;
             }
         }
 
-        // failure
-        VK_LOG_WARN("msaa is not supported beyond sample count 1");
-        return false;
+        return VK_SAMPLE_COUNT_1_BIT;
+    }
+
+    VkSampleCountFlags MsaaTarget::getSupportedSampleCounts(const VkPhysicalDeviceProperties& deviceProperties) noexcept
+    {
+        return (deviceProperties.limits.framebufferColorSampleCounts & deviceProperties.limits.framebufferDepthSampleCounts) | VK_SAMPLE_COUNT_1_BIT;
     }
 
     bool MsaaTarget::createColorTarget(const VulkanDevice& device, const VulkanSwapchain& swapchain) noexcept
@@ -230,38 +247,17 @@ namespace keplar
         VkMemoryRequirements memoryRequirements{};
         vkGetImageMemoryRequirements(m_vkDevice, m_colorImage, &memoryRequirements);
 
-        // find suitable memory type
-        auto memoryTypeIndex = device.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
-        if (!memoryTypeIndex.has_value())
-        {
-            memoryTypeIndex = device.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        }
-        if (!memoryTypeIndex.has_value())
-        {
-            VK_LOG_FATAL("findMemoryType failed to find suitable memory type for msaa color image");
-            return false;
-        }
-
-        // memory allocation info
-        VkMemoryAllocateInfo allocationInfo{};
-        allocationInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocationInfo.pNext = nullptr;
-        allocationInfo.allocationSize = memoryRequirements.size;
-        allocationInfo.memoryTypeIndex = *memoryTypeIndex;
-
-        // allocate device memory
-        vkResult = vkAllocateMemory(m_vkDevice, &allocationInfo, nullptr, &m_colorMemory);
-        if (vkResult != VK_SUCCESS)
+        // prefer lazily allocated memory for transient attachments, fall back to device local
+        VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+        if (!device.findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags).has_value())
         {
-            VK_LOG_FATAL("vkAllocateMemory failed to allocate memory for msaa color image : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            return false;
+            propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
         }
 
-        // bind msaa color image to device memory
-        vkResult = vkBindImageMemory(m_vkDevice, m_colorImage, m_colorMemory, 0);
-        if (vkResult != VK_SUCCESS)
+        // allocate and bind msaa color image memory
+        if (!m_memoryAllocator->allocateImageMemory(m_colorImage, propertyFlags, m_colorAllocation, VulkanMemoryCategory::kAttachment))
         {
-            VK_LOG_FATAL("vkBindImageMemory failed to bind msaa color image to device memory : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("MsaaTarget :: failed to allocate memory for msaa color image");
             return false;
         }
 
@@ -330,38 +326,17 @@ namespace keplar
         VkMemoryRequirements memoryRequirements{};
         vkGetImageMemoryRequirements(m_vkDevice, m_depthImage, &memoryRequirements);
 
-        // find suitable memory type
-        auto memoryTypeIndex = device.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
-        if (!memoryTypeIndex.has_value())
-        {
-            memoryTypeIndex = device.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        }
-        if (!memoryTypeIndex.has_value())
-        {
-            VK_LOG_FATAL("findMemoryType failed to find suitable memory type for msaa depth image");
-            return false;
-        }
-
-        // memory allocation info
-        VkMemoryAllocateInfo allocationInfo{};
-        allocationInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocationInfo.pNext = nullptr;
-        allocationInfo.allocationSize = memoryRequirements.size;
-        allocationInfo.memoryTypeIndex = *memoryTypeIndex;
-
-        // allocate device memory
-        vkResult = vkAllocateMemory(m_vkDevice, &allocationInfo, nullptr, &m_depthMemory);
-        if (vkResult != VK_SUCCESS)
+        // prefer lazily allocated memory for transient attachments, fall back to device local
+        VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+        if (!device.findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags).has_value())
         {
-            VK_LOG_FATAL("vkAllocateMemory failed to allocate memory for msaa depth image : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            return false;
+            propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
         }
 
-        // bind msaa depth image to device memory
-        vkResult = vkBindImageMemory(m_vkDevice, m_depthImage, m_depthMemory, 0);
-        if (vkResult != VK_SUCCESS)
+        // allocate and bind msaa depth image memory
+        if (!m_memoryAllocator->allocateImageMemory(m_depthImage, propertyFlags, m_depthAllocation, VulkanMemoryCategory::kAttachment))
         {
-            VK_LOG_FATAL("vkBindImageMemory failed to bind msaa depth image to device memory : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("MsaaTarget :: failed to allocate memory for msaa depth image");
             return false;
         }
 
@@ -5,6 +5,7 @@
 #pragma once 
 
 #include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
 
 namespace keplar
 {
@@ -12,6 +13,9 @@ namespace keplar
     class VulkanDevice;
     class VulkanSwapchain;
 
+    // multisampled color and depth-stencil targets consumed within the pass (resolved or discarded, never stored).
+    // created as transient attachments on lazily allocated memory where available, so tile-based gpus keep them on chip;
+    // render passes using them must use VK_ATTACHMENT_STORE_OP_DONT_CARE
     class MsaaTarget
     {
         public:
@@ -38,6 +42,12 @@ namespace keplar
             VkImageView getDepthImageView() const noexcept { return m_depthImageView; }
             VkExtent2D getExtent() const noexcept { return m_extent; }
             VkSampleCountFlagBits getSampleCount() const noexcept { return m_sampleCount; }
+
+            // highest color and depth sample count <= desired; VK_SAMPLE_COUNT_1_BIT when msaa is unsupported
+            static VkSampleCountFlagBits selectSampleCount(const VkPhysicalDeviceProperties& deviceProperties, VkSampleCountFlagBits desiredSampleCount) noexcept;
+
+            // sample counts both color and depth attachments support (VK_SAMPLE_COUNT_1_BIT always included)
+            static VkSampleCountFlags getSupportedSampleCounts(const VkPhysicalDeviceProperties& deviceProperties) noexcept;
             
         private:
             // helper functions for msaa setup
@@ -48,15 +58,16 @@ namespace keplar
         private:
             // vulkan handles
             VkDevice                m_vkDevice;
+            VulkanMemoryAllocator*  m_memoryAllocator;
 
             // color target 
             VkImage                 m_colorImage;
-            VkDeviceMemory          m_colorMemory;
+            VulkanAllocation        m_colorAllocation;
             VkImageView             m_colorImageView;
 
             // depth-stencil target
             VkImage                 m_depthImage;
-            VkDeviceMemory          m_depthMemory;
+            VulkanAllocation        m_depthAllocation;
             VkImageView             m_depthImageView;
 
             // msaa properties
@@ -0,0 +1,730 @@
+// ────────────────────────────────────────────
+//  File: occlusion_culling.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "occlusion_culling.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // preferred workgroup size, specialized into local_size_x_id in occlusion_cull.comp (clamped to device limits)
+    constexpr uint32_t kWorkgroupSize = 64;
+    constexpr uint32_t kWorkgroupSizeConstantId = 0;
+
+    // must match local_size_x/y in hiz_reduce.comp and hiz_reduce_ms.comp
+    constexpr uint32_t kReduceTileSize = 8;
+
+    // descriptor bindings of the cull set (set: 0)
+    constexpr uint32_t kDrawDataBinding   = 0;
+    constexpr uint32_t kIndirectBinding   = 1;
+    constexpr uint32_t kDrawCountBinding  = 2;
+    constexpr uint32_t kVisibilityBinding = 3;
+    constexpr uint32_t kPyramidBinding    = 4;
+
+    // descriptor bindings of a reduce set (set: 0), one set per pyramid level
+    constexpr uint32_t kReduceSourceBinding      = 0;
+    constexpr uint32_t kReduceDestinationBinding = 1;
+
+    // cull phases
+    constexpr uint32_t kEarlyPhase = 0;
+    constexpr uint32_t kLatePhase  = 1;
+
+    // pyramid format: single-channel float keeps every depth format exact enough for a min or max reduction
+    constexpr VkFormat kPyramidFormat = VK_FORMAT_R32_SFLOAT;
+
+    // push constants: camera, dispatch parameters and pyramid mapping
+    struct alignas(16) CullPushConstants
+    {
+        glm::mat4  viewProjection;
+        glm::uvec4 params;      // x: draw count, y: compact, z: batch count, w: phase
+        glm::vec4  pyramid;     // xy: depth extent in level 0 texels, z: level count, w: reverse-z
+    };
+
+    // push constants: source and destination extents of one reduction
+    struct ReducePushConstants
+    {
+        glm::uvec4 extents;     // xy: source, zw: destination
+        glm::uvec4 params;      // x: source sample count, y: reverse-z
+    };
+
+    static_assert(sizeof(CullPushConstants) <= 128, "cull push constants exceed the guaranteed minimum range");
+}
+
+namespace keplar
+{
+    OcclusionCulling::OcclusionCulling() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkCullSetLayout(VK_NULL_HANDLE)
+        , m_vkReduceSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkCullSet(VK_NULL_HANDLE)
+        , m_vkReduceSets{}
+        , m_workgroupSize(kWorkgroupSize)
+        , m_depthSampleCount(1)
+        , m_drawCountBuffer(VK_NULL_HANDLE)
+        , m_pyramidImage(VK_NULL_HANDLE)
+        , m_pyramidView(VK_NULL_HANDLE)
+        , m_pyramidLevelViews{}
+        , m_depthView(VK_NULL_HANDLE)
+        , m_depthExtent{}
+        , m_viewportExtent{}
+        , m_pyramidExtent{}
+        , m_pyramidLevelCount(0)
+        , m_isPyramidInitialized(false)
+        , m_isReverseDepth(false)
+    {
+    }
+
+    OcclusionCulling::~OcclusionCulling()
+    {
+        destroy();
+    }
+
+    bool OcclusionCulling::initialize(const VulkanDevice& device, const OcclusionCullingShaders& shaders, VkSampleCountFlagBits depthSamples,
+                                      uint32_t drawCount) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_depthSampleCount = static_cast<uint32_t>(depthSamples);
+
+        // the pyramid is written as a storage image and read through a sampler
+        if (!device.isFormatSupported(kPyramidFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        {
+            VK_LOG_WARN("OcclusionCulling :: r32 float storage images are not supported");
+            destroy();
+            return false;
+        }
+
+        if (depthSamples != VK_SAMPLE_COUNT_1_BIT && (device.getPhysicalDeviceProperties().limits.sampledImageDepthSampleCounts & depthSamples) == 0)
+        {
+            VK_LOG_WARN("OcclusionCulling :: depth with %u samples cannot be sampled", m_depthSampleCount);
+            destroy();
+            return false;
+        }
+
+        // nearest reads only; texelFetch ignores the lod clamp but the view spans every level
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        // nothing was visible before the first frame: the first late phase draws everything it does not cull
+        const size_t visibilitySize = sizeof(uint32_t) * std::max(drawCount, 1u);
+        const std::vector<uint32_t> visibility(visibilitySize / sizeof(uint32_t), 0u);
+
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext       = nullptr;
+        bufferCreateInfo.flags       = 0;
+        bufferCreateInfo.size        = visibilitySize;
+        bufferCreateInfo.usage       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_visibilityBuffer.createHostVisible(device, bufferCreateInfo, visibility.data(), visibilitySize, false, true))
+        {
+            VK_LOG_ERROR("OcclusionCulling :: failed to create visibility buffer");
+            destroy();
+            return false;
+        }
+
+        if (!createDescriptorResources() || !createPipelines(device, shaders, depthSamples))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("OcclusionCulling::initialize successful (depth samples: %u)", m_depthSampleCount);
+        return true;
+    }
+
+    void OcclusionCulling::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        destroyPyramid();
+        m_cullPipeline.destroy();
+        m_reducePipeline.destroy();
+        m_reduceMultisamplePipeline.destroy();
+
+        // descriptor sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+            m_vkCullSet = VK_NULL_HANDLE;
+            m_vkReduceSets.fill(VK_NULL_HANDLE);
+        }
+
+        for (VkDescriptorSetLayout* setLayout : { &m_vkCullSetLayout, &m_vkReduceSetLayout })
+        {
+            if (*setLayout != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorSetLayout(m_vkDevice, *setLayout, nullptr);
+                *setLayout = VK_NULL_HANDLE;
+            }
+        }
+
+        m_visibilityBuffer = VulkanBuffer{};
+        m_drawCountBuffer = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("occlusion culling pass destroyed successfully");
+    }
+
+    void OcclusionCulling::bindBuffers(VkBuffer drawDataBuffer, VkBuffer indirectBuffer, VkBuffer drawCountBuffer) noexcept
+    {
+        if (m_vkCullSet == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // whole-buffer ranges: both phases index their half themselves
+        const std::array<VkDescriptorBufferInfo, 4> bufferInfos
+        {{
+            { drawDataBuffer,               0, VK_WHOLE_SIZE },
+            { indirectBuffer,               0, VK_WHOLE_SIZE },
+            { drawCountBuffer,              0, VK_WHOLE_SIZE },
+            { m_visibilityBuffer.get(),     0, VK_WHOLE_SIZE }
+        }};
+
+        std::array<VkWriteDescriptorSet, 4> writes{};
+        for (uint32_t i = 0; i < writes.size(); ++i)
+        {
+            writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].pNext            = nullptr;
+            writes[i].dstSet           = m_vkCullSet;
+            writes[i].dstBinding       = i;
+            writes[i].dstArrayElement  = 0;
+            writes[i].descriptorCount  = 1;
+            writes[i].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pImageInfo       = nullptr;
+            writes[i].pBufferInfo      = &bufferInfos[i];
+            writes[i].pTexelBufferView = nullptr;
+        }
+
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        m_drawCountBuffer = drawCountBuffer;
+    }
+
+    bool OcclusionCulling::bindDepth(VkImage depthImage, VkFormat depthFormat, VkExtent2D extent) noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE || depthImage == VK_NULL_HANDLE || extent.width == 0 || extent.height == 0)
+        {
+            VK_LOG_ERROR("OcclusionCulling::bindDepth :: invalid depth image or pass not initialized");
+            return false;
+        }
+
+        // the callers rebuild the pass with their graph, so a rebind only happens after the device went idle
+        destroyPyramid();
+        if (!createPyramid(depthImage, depthFormat, extent))
+        {
+            destroyPyramid();
+            return false;
+        }
+
+        // level 0 reduces the depth (sampled in shader-read layout), every further level its predecessor
+        for (uint32_t level = 0; level < m_pyramidLevelCount; ++level)
+        {
+            const VkDescriptorImageInfo sourceInfo = level == 0
+                ? VkDescriptorImageInfo{ m_vkSampler, m_depthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }
+                : VkDescriptorImageInfo{ m_vkSampler, m_pyramidLevelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL };
+            const VkDescriptorImageInfo destinationInfo{ VK_NULL_HANDLE, m_pyramidLevelViews[level], VK_IMAGE_LAYOUT_GENERAL };
+
+            std::array<VkWriteDescriptorSet, 2> writes{};
+            for (auto& write : writes)
+            {
+                write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.pNext            = nullptr;
+                write.dstSet           = m_vkReduceSets[level];
+                write.dstArrayElement  = 0;
+                write.descriptorCount  = 1;
+                write.pBufferInfo      = nullptr;
+                write.pTexelBufferView = nullptr;
+            }
+            writes[0].dstBinding     = kReduceSourceBinding;
+            writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[0].pImageInfo     = &sourceInfo;
+            writes[1].dstBinding     = kReduceDestinationBinding;
+            writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[1].pImageInfo     = &destinationInfo;
+            vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        // the cull reads every level through one view
+        const VkDescriptorImageInfo pyramidInfo{ m_vkSampler, m_pyramidView, VK_IMAGE_LAYOUT_GENERAL };
+        VkWriteDescriptorSet pyramidWrite{};
+        pyramidWrite.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        pyramidWrite.pNext            = nullptr;
+        pyramidWrite.dstSet           = m_vkCullSet;
+        pyramidWrite.dstBinding       = kPyramidBinding;
+        pyramidWrite.dstArrayElement  = 0;
+        pyramidWrite.descriptorCount  = 1;
+        pyramidWrite.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        pyramidWrite.pImageInfo       = &pyramidInfo;
+        pyramidWrite.pBufferInfo      = nullptr;
+        pyramidWrite.pTexelBufferView = nullptr;
+        vkUpdateDescriptorSets(m_vkDevice, 1, &pyramidWrite, 0, nullptr);
+
+        VK_LOG_DEBUG("OcclusionCulling :: depth pyramid %ux%u with %u levels", m_pyramidExtent.width, m_pyramidExtent.height, m_pyramidLevelCount);
+        return true;
+    }
+
+    void OcclusionCulling::setReverseDepth(bool isReverseDepth) noexcept
+    {
+        m_isReverseDepth = isReverseDepth;
+    }
+
+    void OcclusionCulling::setViewportExtent(VkExtent2D extent) noexcept
+    {
+        if (m_depthExtent.width == 0 || m_depthExtent.height == 0)
+        {
+            return;
+        }
+
+        // a reduced viewport maps clip space onto fewer level 0 texels; the rest of the depth stays cleared (far),
+        // which only makes the pyramid more conservative along the region's edge
+        m_viewportExtent = { std::clamp(extent.width, 1u, m_depthExtent.width), std::clamp(extent.height, 1u, m_depthExtent.height) };
+    }
+
+    void OcclusionCulling::recordEarly(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t drawCount, uint32_t batchCount,
+                                       bool compact) noexcept
+    {
+        if (!isValid() || drawCount == 0)
+        {
+            return;
+        }
+
+        // the previous frame may still be reading commands on this queue or copying its counts back (write-after-read),
+        // and its late phase wrote the visibility this phase reads
+        VkMemoryBarrier visibilityBarrier{};
+        visibilityBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        visibilityBarrier.pNext         = nullptr;
+        visibilityBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        visibilityBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &visibilityBarrier, 0, nullptr, 0, nullptr);
+
+        // compacted output appends into per-batch counters of both phases, reset them first
+        if (compact)
+        {
+            vkCmdFillBuffer(commandBuffer, m_drawCountBuffer, 0, VK_WHOLE_SIZE, 0);
+
+            VkMemoryBarrier clearBarrier{};
+            clearBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            clearBarrier.pNext         = nullptr;
+            clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        // only the late phase reads the pyramid, but its descriptor is bound (in GENERAL) from the first dispatch on
+        if (!m_isPyramidInitialized)
+        {
+            VkImageMemoryBarrier imageBarrier{};
+            imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            imageBarrier.pNext                           = nullptr;
+            imageBarrier.srcAccessMask                   = 0;
+            imageBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+            imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            imageBarrier.image                           = m_pyramidImage;
+            imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            imageBarrier.subresourceRange.baseMipLevel   = 0;
+            imageBarrier.subresourceRange.levelCount     = m_pyramidLevelCount;
+            imageBarrier.subresourceRange.baseArrayLayer = 0;
+            imageBarrier.subresourceRange.layerCount     = 1;
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+            m_isPyramidInitialized = true;
+        }
+
+        recordCull(commandBuffer, viewProjection, drawCount, batchCount, compact, kEarlyPhase);
+    }
+
+    void OcclusionCulling::recordLate(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t drawCount, uint32_t batchCount,
+                                      bool compact) noexcept
+    {
+        if (!isValid() || drawCount == 0 || !m_isPyramidInitialized)
+        {
+            return;
+        }
+
+        // the early phase read the visibility and the previous late phase the pyramid (write-after-read)
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        recordPyramid(commandBuffer);
+        recordCull(commandBuffer, viewProjection, drawCount, batchCount, compact, kLatePhase);
+    }
+
+    void OcclusionCulling::recordPyramid(VkCommandBuffer commandBuffer) noexcept
+    {
+        // each level waits on the one it reduces
+        VkMemoryBarrier levelBarrier{};
+        levelBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        levelBarrier.pNext         = nullptr;
+        levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        VkExtent2D sourceExtent = m_depthExtent;
+        VkExtent2D levelExtent = m_pyramidExtent;
+        for (uint32_t level = 0; level < m_pyramidLevelCount; ++level)
+        {
+            const VulkanPipeline& pipeline = (level == 0 && m_depthSampleCount > 1) ? m_reduceMultisamplePipeline : m_reducePipeline;
+
+            ReducePushConstants pushConstants{};
+            pushConstants.extents = glm::uvec4(sourceExtent.width, sourceExtent.height, levelExtent.width, levelExtent.height);
+            pushConstants.params  = glm::uvec4(level == 0 ? m_depthSampleCount : 1u, m_isReverseDepth ? 1u : 0u, 0u, 0u);
+
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.get());
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.getLayout(), 0, 1, &m_vkReduceSets[level], 0, nullptr);
+            vkCmdPushConstants(commandBuffer, pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReducePushConstants), &pushConstants);
+            vkCmdDispatch(commandBuffer, (levelExtent.width + kReduceTileSize - 1) / kReduceTileSize, (levelExtent.height + kReduceTileSize - 1) / kReduceTileSize, 1);
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &levelBarrier, 0, nullptr, 0, nullptr);
+
+            // each texel covers the 2x2 block below it, the last row and column clamped
+            sourceExtent = levelExtent;
+            levelExtent = { std::max(1u, (levelExtent.width + 1) / 2), std::max(1u, (levelExtent.height + 1) / 2) };
+        }
+    }
+
+    void OcclusionCulling::recordCull(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t drawCount, uint32_t batchCount,
+                                      bool compact, uint32_t phase) const noexcept
+    {
+        CullPushConstants pushConstants{};
+        pushConstants.viewProjection = viewProjection;
+        pushConstants.params         = glm::uvec4(drawCount, compact ? 1u : 0u, batchCount, phase);
+        pushConstants.pyramid        = glm::vec4(0.5f * static_cast<float>(m_viewportExtent.width), 0.5f * static_cast<float>(m_viewportExtent.height),
+                                                 static_cast<float>(m_pyramidLevelCount), m_isReverseDepth ? 1.0f : 0.0f);
+
+        // one invocation per draw
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipeline.getLayout(), 0, 1, &m_vkCullSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_cullPipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (drawCount + m_workgroupSize - 1) / m_workgroupSize, 1, 1);
+
+        // make written commands and counts visible to the indirect draws, and the visibility to the next phase
+        VkMemoryBarrier cullBarrier{};
+        cullBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        cullBarrier.pNext         = nullptr;
+        cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    bool OcclusionCulling::createDescriptorResources() noexcept
+    {
+        // cull set: draw data (read), indirect commands (write), draw counts (atomic), visibility (read-write), pyramid
+        const std::array<VkDescriptorSetLayoutBinding, 5> cullBindings
+        {{
+            { kDrawDataBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kIndirectBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kDrawCountBinding,  VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kVisibilityBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kPyramidBinding,    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        // reduce set: source level (or depth), destination level
+        const std::array<VkDescriptorSetLayoutBinding, 2> reduceBindings
+        {{
+            { kReduceSourceBinding,      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kReduceDestinationBinding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        }};
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = nullptr;
+        layoutInfo.flags        = 0;
+        layoutInfo.bindingCount = static_cast<uint32_t>(cullBindings.size());
+        layoutInfo.pBindings    = cullBindings.data();
+
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &m_vkCullSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("OcclusionCulling :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        layoutInfo.bindingCount = static_cast<uint32_t>(reduceBindings.size());
+        layoutInfo.pBindings    = reduceBindings.data();
+        vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &layoutInfo, nullptr, &m_vkReduceSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("OcclusionCulling :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // private pool sized for the cull set and one reduce set per possible level
+        const std::array<VkDescriptorPoolSize, 3> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         4 },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 + kMaxPyramidLevels },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          kMaxPyramidLevels }
+        }};
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 1 + kMaxPyramidLevels;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("OcclusionCulling :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // every set up front; bindDepth only rewrites them
+        std::array<VkDescriptorSetLayout, 1 + kMaxPyramidLevels> setLayouts{};
+        setLayouts.fill(m_vkReduceSetLayout);
+        setLayouts[0] = m_vkCullSetLayout;
+
+        std::array<VkDescriptorSet, 1 + kMaxPyramidLevels> sets{};
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+        allocateInfo.pSetLayouts        = setLayouts.data();
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, sets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("OcclusionCulling :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        m_vkCullSet = sets[0];
+        std::copy(sets.begin() + 1, sets.end(), m_vkReduceSets.begin());
+        return true;
+    }
+
+    bool OcclusionCulling::createPipelines(const VulkanDevice& device, const OcclusionCullingShaders& shaders, VkSampleCountFlagBits depthSamples) noexcept
+    {
+        // missing spir-v is not fatal; callers fall back to frustum culling only
+        VulkanShader cullShader;
+        VulkanShader reduceShader;
+        if (!cullShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mCullFile) ||
+            !reduceShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mReduceFile))
+        {
+            VK_LOG_WARN("OcclusionCulling :: compute shaders '%s' / '%s' unavailable", shaders.mCullFile.c_str(), shaders.mReduceFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig cullConfig{};
+        cullConfig.mShaderStage          = cullShader.getShaderStageInfo();
+        cullConfig.mDescriptorSetLayouts = { m_vkCullSetLayout };
+        cullConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants) } };
+
+        // local_size_x is a specialization constant so the workgroup size can follow the device
+        const VkPhysicalDeviceLimits& limits = device.getPhysicalDeviceProperties().limits;
+        m_workgroupSize = std::min({ kWorkgroupSize, limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations });
+        cullConfig.addSpecializationConstant(kWorkgroupSizeConstantId, m_workgroupSize);
+
+        if (!m_cullPipeline.initialize(m_vkDevice, cullConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("OcclusionCulling :: failed to create cull pipeline");
+            return false;
+        }
+
+        ComputePipelineConfig reduceConfig{};
+        reduceConfig.mShaderStage          = reduceShader.getShaderStageInfo();
+        reduceConfig.mDescriptorSetLayouts = { m_vkReduceSetLayout };
+        reduceConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReducePushConstants) } };
+        if (!m_reducePipeline.initialize(m_vkDevice, reduceConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("OcclusionCulling :: failed to create reduce pipeline");
+            return false;
+        }
+
+        if (depthSamples == VK_SAMPLE_COUNT_1_BIT)
+        {
+            return true;
+        }
+
+        // multisampled depth: level 0 takes the farthest sample of each pixel
+        VulkanShader reduceMultisampleShader;
+        if (!reduceMultisampleShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mReduceMultisampleFile))
+        {
+            VK_LOG_WARN("OcclusionCulling :: compute shader '%s' unavailable", shaders.mReduceMultisampleFile.c_str());
+            return false;
+        }
+
+        reduceConfig.mShaderStage = reduceMultisampleShader.getShaderStageInfo();
+        if (!m_reduceMultisamplePipeline.initialize(m_vkDevice, reduceConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("OcclusionCulling :: failed to create multisample reduce pipeline");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool OcclusionCulling::createPyramid(VkImage depthImage, VkFormat depthFormat, VkExtent2D extent) noexcept
+    {
+        m_depthExtent = extent;
+        m_viewportExtent = extent;
+        m_pyramidExtent = { std::max(1u, (extent.width + 1) / 2), std::max(1u, (extent.height + 1) / 2) };
+
+        // full chain down to 1x1
+        m_pyramidLevelCount = 1;
+        for (uint32_t size = std::max(m_pyramidExtent.width, m_pyramidExtent.height); size > 1; size = (size + 1) / 2)
+        {
+            ++m_pyramidLevelCount;
+        }
+
+        if (m_pyramidLevelCount > kMaxPyramidLevels)
+        {
+            VK_LOG_ERROR("OcclusionCulling :: %ux%u depth needs %u pyramid levels (max %u)", extent.width, extent.height, m_pyramidLevelCount, kMaxPyramidLevels);
+            return false;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.pNext         = nullptr;
+        imageInfo.flags         = 0;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = kPyramidFormat;
+        imageInfo.extent        = { m_pyramidExtent.width, m_pyramidExtent.height, 1 };
+        imageInfo.mipLevels     = m_pyramidLevelCount;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &m_pyramidImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("OcclusionCulling :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        if (!m_memoryAllocator->allocateImageMemory(m_pyramidImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_pyramidAllocation, VulkanMemoryCategory::kAttachment))
+        {
+            VK_LOG_FATAL("OcclusionCulling :: failed to allocate memory for depth pyramid");
+            return false;
+        }
+
+        auto createView = [this](VkImage image, VkFormat format, VkImageAspectFlags aspect, uint32_t baseLevel, uint32_t levelCount,
+                                 VkImageView& imageView) noexcept
+        {
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.pNext                           = nullptr;
+            viewInfo.flags                           = 0;
+            viewInfo.image                           = image;
+            viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format                          = format;
+            viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                         VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+            viewInfo.subresourceRange.aspectMask     = aspect;
+            viewInfo.subresourceRange.baseMipLevel   = baseLevel;
+            viewInfo.subresourceRange.levelCount     = levelCount;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount     = 1;
+
+            const VkResult result = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &imageView);
+            if (result != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("OcclusionCulling :: vkCreateImageView failed : %s (code: %d)", string_VkResult(result), result);
+                return false;
+            }
+            return true;
+        };
+
+        // depth-only view: a sampled view of a depth-stencil image may name a single aspect
+        if (!createView(depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, m_depthView) ||
+            !createView(m_pyramidImage, kPyramidFormat, VK_IMAGE_ASPECT_COLOR_BIT, 0, m_pyramidLevelCount, m_pyramidView))
+        {
+            return false;
+        }
+
+        for (uint32_t level = 0; level < m_pyramidLevelCount; ++level)
+        {
+            if (!createView(m_pyramidImage, kPyramidFormat, VK_IMAGE_ASPECT_COLOR_BIT, level, 1, m_pyramidLevelViews[level]))
+            {
+                return false;
+            }
+        }
+
+        m_isPyramidInitialized = false;
+        return true;
+    }
+
+    void OcclusionCulling::destroyPyramid() noexcept
+    {
+        for (VkImageView& imageView : m_pyramidLevelViews)
+        {
+            if (imageView != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, imageView, nullptr);
+                imageView = VK_NULL_HANDLE;
+            }
+        }
+
+        for (VkImageView* imageView : { &m_pyramidView, &m_depthView })
+        {
+            if (*imageView != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, *imageView, nullptr);
+                *imageView = VK_NULL_HANDLE;
+            }
+        }
+
+        if (m_pyramidImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, m_pyramidImage, nullptr);
+            m_pyramidImage = VK_NULL_HANDLE;
+        }
+
+        if (m_memoryAllocator != nullptr)
+        {
+            m_memoryAllocator->free(m_pyramidAllocation);
+        }
+
+        m_pyramidLevelCount = 0;
+        m_isPyramidInitialized = false;
+    }
+}   // namespace keplar
@@ -0,0 +1,120 @@
+// ────────────────────────────────────────────
+//  File: occlusion_culling.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the three compute passes
+    struct OcclusionCullingShaders
+    {
+        std::string mCullFile;              // occlusion_cull.comp
+        std::string mReduceFile;            // hiz_reduce.comp
+        std::string mReduceMultisampleFile; // hiz_reduce_ms.comp, only loaded for multisampled depth
+    };
+
+    // two-phase hierarchical-z occlusion culling of the per-draw bounding spheres (see occlusion_cull.comp).
+    // - early phase: draws that were visible last frame and pass the frustum go to the first half of the commands
+    // - the caller renders them, then reduces their depth into a farthest-depth pyramid (recordLate)
+    // - late phase: every draw in the frustum is tested against the pyramid; the visibility of the next early
+    //   phase is recorded, and draws that turned visible go to the second half of the commands
+    // the command and count buffers therefore hold two copies of the batch ranges (GLTFModel::renderIndirect).
+    // compact mode appends through per-batch counts like GpuCulling; otherwise commands are rewritten in place
+    class OcclusionCulling final
+    {
+        public:
+            static constexpr uint32_t kMaxPyramidLevels = 16;
+
+            // creation and destruction
+            OcclusionCulling() noexcept;
+            ~OcclusionCulling();
+
+            // disable copy and move semantics to enforce unique ownership
+            OcclusionCulling(const OcclusionCulling&) = delete;
+            OcclusionCulling& operator=(const OcclusionCulling&) = delete;
+            OcclusionCulling(OcclusionCulling&&) = delete;
+            OcclusionCulling& operator=(OcclusionCulling&&) = delete;
+
+            bool initialize(const VulkanDevice& device, const OcclusionCullingShaders& shaders, VkSampleCountFlagBits depthSamples,
+                            uint32_t drawCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: point the pass at the draw data, command and per-batch count buffers (both halves)
+            void bindBuffers(VkBuffer drawDataBuffer, VkBuffer indirectBuffer, VkBuffer drawCountBuffer) noexcept;
+
+            // usage: the depth image the early draws render into; it is sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            bool bindDepth(VkImage depthImage, VkFormat depthFormat, VkExtent2D extent) noexcept;
+
+            // usage: the depth holds reverse-z (near 1, far 0): the pyramid keeps minimums and the test flips
+            void setReverseDepth(bool isReverseDepth) noexcept;
+
+            // usage: the top-left region of the depth the scene viewport covers (the whole depth after bindDepth)
+            void setViewportExtent(VkExtent2D extent) noexcept;
+
+            // usage: record outside render passes; early before the first scene draws, late once they wrote depth
+            void recordEarly(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t drawCount, uint32_t batchCount,
+                             bool compact) noexcept;
+            void recordLate(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t drawCount, uint32_t batchCount,
+                            bool compact) noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_cullPipeline.isValid() && m_pyramidImage != VK_NULL_HANDLE; }
+            uint32_t getPyramidLevelCount() const noexcept { return m_pyramidLevelCount; }
+            VkExtent2D getPyramidExtent() const noexcept { return m_pyramidExtent; }
+
+        private:
+            bool createDescriptorResources() noexcept;
+            bool createPipelines(const VulkanDevice& device, const OcclusionCullingShaders& shaders, VkSampleCountFlagBits depthSamples) noexcept;
+            bool createPyramid(VkImage depthImage, VkFormat depthFormat, VkExtent2D extent) noexcept;
+            void destroyPyramid() noexcept;
+            void recordCull(VkCommandBuffer commandBuffer, const glm::mat4& viewProjection, uint32_t drawCount, uint32_t batchCount,
+                            bool compact, uint32_t phase) const noexcept;
+            void recordPyramid(VkCommandBuffer commandBuffer) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                                        m_vkDevice;
+            VulkanMemoryAllocator*                          m_memoryAllocator;
+            VkSampler                                       m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout                           m_vkCullSetLayout;
+            VkDescriptorSetLayout                           m_vkReduceSetLayout;
+            VkDescriptorPool                                m_vkDescriptorPool;
+            VkDescriptorSet                                 m_vkCullSet;
+            std::array<VkDescriptorSet, kMaxPyramidLevels>  m_vkReduceSets;
+            VulkanPipeline                                  m_cullPipeline;
+            VulkanPipeline                                  m_reducePipeline;       // reads level 0 from the depth when it is single-sampled
+            VulkanPipeline                                  m_reduceMultisamplePipeline;
+            uint32_t                                        m_workgroupSize;
+            uint32_t                                        m_depthSampleCount;
+
+            // per-draw visibility of the last late phase, read by the next early phase
+            VulkanBuffer                                    m_visibilityBuffer;
+            VkBuffer                                        m_drawCountBuffer;
+
+            // farthest-depth pyramid: level 0 is half the depth extent, kept in VK_IMAGE_LAYOUT_GENERAL
+            VkImage                                         m_pyramidImage;
+            VulkanAllocation                                m_pyramidAllocation;
+            VkImageView                                     m_pyramidView;
+            std::array<VkImageView, kMaxPyramidLevels>      m_pyramidLevelViews;
+            VkImageView                                     m_depthView;
+            VkExtent2D                                      m_depthExtent;
+            VkExtent2D                                      m_viewportExtent;       // region clip space maps onto
+            VkExtent2D                                      m_pyramidExtent;
+            uint32_t                                        m_pyramidLevelCount;
+            bool                                            m_isPyramidInitialized;
+            bool                                            m_isReverseDepth;
+    };
+}   // namespace keplar
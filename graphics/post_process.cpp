@@ -0,0 +1,789 @@
+// ────────────────────────────────────────────
+//  File: post_process.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "post_process.hpp"
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // must match local_size_x/y of bloom_downsample.comp and tonemap.comp (exposure.comp runs one bin per invocation)
+    constexpr uint32_t kBloomWorkgroupSize   = 8;
+    constexpr uint32_t kToneMapWorkgroupSize = 16;
+
+    // metered luminance range in log2 units; darker pixels land in bin 0, which the exposure ignores
+    constexpr float kMinLogLuminance   = -10.0f;
+    constexpr float kLogLuminanceRange = 16.0f;
+
+    // descriptor bindings of the bloom sets (set: 0)
+    constexpr uint32_t kBloomSourceBinding      = 0;
+    constexpr uint32_t kBloomDestinationBinding = 1;
+
+    // descriptor bindings of the tonemap set (set: 0)
+    constexpr uint32_t kSceneBinding       = 0;
+    constexpr uint32_t kBloomChainBinding  = 1;
+    constexpr uint32_t kOutputBinding      = 2;
+    constexpr uint32_t kExposureBinding    = 3;
+
+    // descriptor bindings of the tile-local tonemap set (set: 0)
+    constexpr uint32_t kTileSceneBinding    = 0;
+    constexpr uint32_t kTileExposureBinding = 1;
+
+    // the tile-local tonemap meters one pixel out of each square of this many pixels a side, which keeps its global
+    // atomics to a pixel in 16 without moving the average
+    constexpr uint32_t kTileMeteringStride = 4;
+
+    // push constants: one bloom mip, must match bloom_downsample.comp
+    struct BloomPushConstants
+    {
+        glm::uvec4 extents;     // xy: written region of the destination mip, zw: valid region of the source
+        glm::vec4  params;      // xy: source texel size in uv, z: source lod, w: threshold (0: plain downsample)
+    };
+
+    // push constants: shared by tonemap.comp, tonemap_tile.frag and exposure.comp
+    struct ToneMapPushConstants
+    {
+        glm::uvec4 extents;     // xy: rendered region, zw: bloom mip 0 extent (tile: z 1 when metering, w metering stride)
+        glm::vec4  exposure;    // x: fixed exposure, y: 1 when metered, z: bloom strength (0: none), w: bloom mips
+        glm::vec4  histogram;   // x: min log2 luminance, y: log2 luminance range, z: adaptation blend, w: compensation scale
+    };
+
+    // histogram bins, then the adapted exposure
+    constexpr VkDeviceSize kExposureBufferSize = (keplar::PostProcess::kHistogramBinCount + 4) * sizeof(uint32_t);
+
+    // region a mip of the chain holds for a rendered region (mip 0 is at half resolution)
+    VkExtent2D getBloomRegion(VkExtent2D renderExtent, uint32_t mip) noexcept
+    {
+        const uint32_t shift = mip + 1;
+        const uint32_t round = (1u << shift) - 1;
+        return { std::max((renderExtent.width + round) >> shift, 1u), std::max((renderExtent.height + round) >> shift, 1u) };
+    }
+
+    void recordComputeBarrier(VkCommandBuffer commandBuffer) noexcept
+    {
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        keplar::VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+}
+
+namespace keplar
+{
+    PostProcess::PostProcess() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkBloomSetLayout(VK_NULL_HANDLE)
+        , m_vkToneMapSetLayout(VK_NULL_HANDLE)
+        , m_vkTileSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkToneMapSet(VK_NULL_HANDLE)
+        , m_vkTileSet(VK_NULL_HANDLE)
+        , m_vkBloomImage(VK_NULL_HANDLE)
+        , m_vkBloomView(VK_NULL_HANDLE)
+        , m_bloomMipCount(0)
+        , m_bloomExtent{}
+        , m_extent{}
+        , m_isInitialized(false)
+    {
+    }
+
+    PostProcess::~PostProcess()
+    {
+        destroy();
+    }
+
+    bool PostProcess::initialize(const VulkanDevice& device, const PostProcessShaders& shaders, VkExtent2D extent) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_extent = extent;
+        if (extent.width == 0 || extent.height == 0)
+        {
+            VK_LOG_ERROR("PostProcess::initialize :: invalid extent");
+            destroy();
+            return false;
+        }
+
+        if (!device.isFormatSupported(kDestinationFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        {
+            VK_LOG_ERROR("PostProcess::initialize :: %s cannot be a storage image", string_VkFormat(kDestinationFormat));
+            destroy();
+            return false;
+        }
+
+        // bilinear reads clamped to the edge, explicit lods only; the shaders keep them inside the rendered regions
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_LINEAR;
+        samplerInfo.minFilter    = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = static_cast<float>(kBloomMipCount);
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createBloomImage(device) || !createExposureBuffer(device) || !createDescriptorResources(device) || !createPipelines(device, shaders))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("PostProcess::initialize successful (%ux%u, bloom mips: %u)", extent.width, extent.height, hasBloom() ? m_bloomMipCount : 0u);
+        return true;
+    }
+
+    void PostProcess::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_bloomPipeline.destroy();
+        m_toneMapPipeline.destroy();
+        m_exposurePipeline.destroy();
+        m_tileToneMapPipeline.destroy();
+
+        // the sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkBloomSets.clear();
+        m_vkToneMapSet = VK_NULL_HANDLE;
+        m_vkTileSet = VK_NULL_HANDLE;
+
+        for (auto view : m_vkBloomMipViews)
+        {
+            vkDestroyImageView(m_vkDevice, view, nullptr);
+        }
+        m_vkBloomMipViews.clear();
+
+        if (m_vkBloomView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkBloomView, nullptr);
+            m_vkBloomView = VK_NULL_HANDLE;
+        }
+
+        if (m_vkBloomImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, m_vkBloomImage, nullptr);
+            m_vkBloomImage = VK_NULL_HANDLE;
+        }
+
+        if (m_memoryAllocator != nullptr)
+        {
+            m_memoryAllocator->free(m_bloomAllocation);
+        }
+
+        m_exposureBuffer = VulkanBuffer{};
+        m_vkTileSetLayout = VK_NULL_HANDLE;
+        m_vkToneMapSetLayout = VK_NULL_HANDLE;
+        m_vkBloomSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_bloomMipCount = 0;
+        m_bloomExtent = {};
+        m_extent = {};
+        m_isInitialized = false;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("post process destroyed successfully");
+    }
+
+    void PostProcess::bindImages(VkImageView sourceView, VkImageView destinationView) noexcept
+    {
+        if (m_vkToneMapSet == VK_NULL_HANDLE || sourceView == VK_NULL_HANDLE || destinationView == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        const VkDescriptorImageInfo sourceInfo{ m_vkSampler, sourceView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo bloomInfo{ m_vkSampler, m_vkBloomView, VK_IMAGE_LAYOUT_GENERAL };
+        const VkDescriptorImageInfo destinationInfo{ VK_NULL_HANDLE, destinationView, VK_IMAGE_LAYOUT_GENERAL };
+        const VkDescriptorBufferInfo exposureInfo{ m_exposureBuffer.get(), 0, VK_WHOLE_SIZE };
+
+        std::array<VkWriteDescriptorSet, 4> writes{};
+        for (auto& write : writes)
+        {
+            write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet          = m_vkToneMapSet;
+            write.descriptorCount = 1;
+        }
+        writes[0].dstBinding     = kSceneBinding;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo     = &sourceInfo;
+        writes[1].dstBinding     = kBloomChainBinding;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[1].pImageInfo     = &bloomInfo;
+        writes[2].dstBinding     = kOutputBinding;
+        writes[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[2].pImageInfo     = &destinationInfo;
+        writes[3].dstBinding     = kExposureBinding;
+        writes[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[3].pBufferInfo    = &exposureInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+        // mip 0 of the chain reads the scene, each further mip the one above it
+        for (uint32_t mip = 0; mip < m_vkBloomSets.size(); ++mip)
+        {
+            const VkDescriptorImageInfo mipSourceInfo = mip == 0 ? sourceInfo : bloomInfo;
+            const VkDescriptorImageInfo mipDestinationInfo{ VK_NULL_HANDLE, m_vkBloomMipViews[mip], VK_IMAGE_LAYOUT_GENERAL };
+
+            std::array<VkWriteDescriptorSet, 2> bloomWrites{};
+            for (auto& write : bloomWrites)
+            {
+                write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet          = m_vkBloomSets[mip];
+                write.descriptorCount = 1;
+            }
+            bloomWrites[0].dstBinding     = kBloomSourceBinding;
+            bloomWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bloomWrites[0].pImageInfo     = &mipSourceInfo;
+            bloomWrites[1].dstBinding     = kBloomDestinationBinding;
+            bloomWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bloomWrites[1].pImageInfo     = &mipDestinationInfo;
+            vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(bloomWrites.size()), bloomWrites.data(), 0, nullptr);
+        }
+    }
+
+    void PostProcess::record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float dt, const PostProcessSettings& settings) noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        renderExtent = { std::clamp(renderExtent.width, 1u, m_extent.width), std::clamp(renderExtent.height, 1u, m_extent.height) };
+        if (!m_isInitialized)
+        {
+            recordSetup(commandBuffer);
+        }
+        else
+        {
+            // the previous frame's chain and exposure writes, same queue
+            recordComputeBarrier(commandBuffer);
+        }
+
+        const bool isBloom = settings.mBloom && settings.mBloomStrength > 0.0f && hasBloom();
+        if (isBloom)
+        {
+            recordBloom(commandBuffer, renderExtent, std::max(settings.mBloomThreshold, 0.0f));
+        }
+
+        // a fixed exposure is the compensation alone; metered ones scale the exposure that maps the average to mid grey
+        const float compensation = std::exp2(settings.mExposureCompensation);
+        ToneMapPushConstants pushConstants{};
+        pushConstants.extents   = glm::uvec4(renderExtent.width, renderExtent.height, m_bloomExtent.width, m_bloomExtent.height);
+        pushConstants.exposure  = glm::vec4(compensation, settings.mAutoExposure ? 1.0f : 0.0f, isBloom ? settings.mBloomStrength : 0.0f,
+                                            static_cast<float>(m_bloomMipCount));
+        pushConstants.histogram = glm::vec4(kMinLogLuminance, kLogLuminanceRange, 1.0f - std::exp(-std::max(dt, 0.0f) * settings.mAdaptationSpeed),
+                                            compensation);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_toneMapPipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_toneMapPipeline.getLayout(), 0, 1, &m_vkToneMapSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_toneMapPipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (renderExtent.width + kToneMapWorkgroupSize - 1) / kToneMapWorkgroupSize,
+                      (renderExtent.height + kToneMapWorkgroupSize - 1) / kToneMapWorkgroupSize, 1);
+
+        // the histogram is complete: reduce it into the next frame's exposure and clear it (same layout and set)
+        recordComputeBarrier(commandBuffer);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_exposurePipeline.get());
+        vkCmdDispatch(commandBuffer, 1, 1, 1);
+    }
+
+    bool PostProcess::initializeTileToneMap(const VulkanDevice& device, const PostProcessShaders& shaders, VkRenderPass renderPass, uint32_t subpass) noexcept
+    {
+        // the histogram is binned by fragments
+        if (m_vkTileSet == VK_NULL_HANDLE || !device.getEnabledFeatures().fragmentStoresAndAtomics)
+        {
+            VK_LOG_WARN("PostProcess::initializeTileToneMap :: needs fragmentStoresAndAtomics");
+            return false;
+        }
+
+        VulkanShader vertexShader;
+        VulkanShader fragmentShader;
+        if (!vertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, shaders.mTileVertexFile) ||
+            !fragmentShader.initialize(m_vkDevice, VK_SHADER_STAGE_FRAGMENT_BIT, shaders.mTileToneMapFile))
+        {
+            VK_LOG_WARN("PostProcess :: shaders '%s' / '%s' unavailable", shaders.mTileVertexFile.c_str(), shaders.mTileToneMapFile.c_str());
+            return false;
+        }
+
+        // one triangle from gl_VertexIndex over the whole attachment
+        VkPipelineVertexInputStateCreateInfo vertexInputState{};
+        vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(m_extent.width), static_cast<float>(m_extent.height), 0.0f, 1.0f };
+        const VkRect2D scissor{ { 0, 0 }, m_extent };
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.pViewports    = &viewport;
+        viewportState.scissorCount  = 1;
+        viewportState.pScissors     = &scissor;
+
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        rasterizationState.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizationState.cullMode    = VK_CULL_MODE_NONE;
+        rasterizationState.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizationState.lineWidth   = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        multisampleState.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable    = VK_FALSE;
+
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+        colorBlendState.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlendState.attachmentCount = 1;
+        colorBlendState.pAttachments    = &colorBlendAttachment;
+
+        GraphicsPipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStages         = { vertexShader.getShaderStageInfo(), fragmentShader.getShaderStageInfo() };
+        pipelineConfig.mVertexInputState     = vertexInputState;
+        pipelineConfig.mInputAssemblyState   = inputAssembly;
+        pipelineConfig.mViewportState        = viewportState;
+        pipelineConfig.mRasterizationState   = rasterizationState;
+        pipelineConfig.mMultisampleState     = multisampleState;
+        pipelineConfig.mColorBlendState      = colorBlendState;
+        pipelineConfig.mRenderPass           = renderPass;
+        pipelineConfig.mSubpassIndex         = subpass;
+        pipelineConfig.mDescriptorSetLayouts = { m_vkTileSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ToneMapPushConstants) } };
+        if (!m_tileToneMapPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("PostProcess :: failed to create tile-local tonemap pipeline");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PostProcess::initializeTileToneMap successful (subpass: %u)", subpass);
+        return true;
+    }
+
+    void PostProcess::bindTileSource(VkImageView sourceView) noexcept
+    {
+        if (m_vkTileSet == VK_NULL_HANDLE || sourceView == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // the exposure pass reads the buffer through the tonemap set, whose images the tile-local path never binds
+        const VkDescriptorImageInfo sourceInfo{ VK_NULL_HANDLE, sourceView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorBufferInfo exposureInfo{ m_exposureBuffer.get(), 0, VK_WHOLE_SIZE };
+
+        std::array<VkWriteDescriptorSet, 3> writes{};
+        for (auto& write : writes)
+        {
+            write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet          = m_vkTileSet;
+            write.descriptorCount = 1;
+        }
+        writes[0].dstBinding     = kTileSceneBinding;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        writes[0].pImageInfo     = &sourceInfo;
+        writes[1].dstBinding     = kTileExposureBinding;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].pBufferInfo    = &exposureInfo;
+        writes[2].dstSet         = m_vkToneMapSet;
+        writes[2].dstBinding     = kExposureBinding;
+        writes[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[2].pBufferInfo    = &exposureInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void PostProcess::recordTileToneMap(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const PostProcessSettings& settings) const noexcept
+    {
+        if (!isTileToneMapValid())
+        {
+            return;
+        }
+
+        // until recordExposure cleared the buffer once, the fixed exposure applies and nothing is binned
+        renderExtent = { std::clamp(renderExtent.width, 1u, m_extent.width), std::clamp(renderExtent.height, 1u, m_extent.height) };
+        const float compensation = std::exp2(settings.mExposureCompensation);
+        ToneMapPushConstants pushConstants{};
+        pushConstants.extents   = glm::uvec4(renderExtent.width, renderExtent.height, m_isInitialized ? 1u : 0u, kTileMeteringStride);
+        pushConstants.exposure  = glm::vec4(compensation, (m_isInitialized && settings.mAutoExposure) ? 1.0f : 0.0f, 0.0f, 0.0f);
+        pushConstants.histogram = glm::vec4(kMinLogLuminance, kLogLuminanceRange, 0.0f, compensation);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_tileToneMapPipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_tileToneMapPipeline.getLayout(), 0, 1, &m_vkTileSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_tileToneMapPipeline.getLayout(), VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    }
+
+    void PostProcess::recordExposure(VkCommandBuffer commandBuffer, float dt, const PostProcessSettings& settings) noexcept
+    {
+        if (!isTileToneMapValid())
+        {
+            return;
+        }
+
+        if (!m_isInitialized)
+        {
+            recordSetup(commandBuffer);
+        }
+        else
+        {
+            // this frame's histogram, binned by the tonemap fragments
+            VkMemoryBarrier memoryBarrier{};
+            memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            memoryBarrier.pNext         = nullptr;
+            memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        const float compensation = std::exp2(settings.mExposureCompensation);
+        ToneMapPushConstants pushConstants{};
+        pushConstants.exposure  = glm::vec4(compensation, settings.mAutoExposure ? 1.0f : 0.0f, 0.0f, 0.0f);
+        pushConstants.histogram = glm::vec4(kMinLogLuminance, kLogLuminanceRange, 1.0f - std::exp(-std::max(dt, 0.0f) * settings.mAdaptationSpeed),
+                                            compensation);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_exposurePipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_exposurePipeline.getLayout(), 0, 1, &m_vkToneMapSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_exposurePipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, 1, 1, 1);
+
+        // the next frame's tonemap fragments read the exposure and bin into the cleared histogram
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    void PostProcess::recordSetup(VkCommandBuffer commandBuffer) noexcept
+    {
+        // the chain stays in the general layout; a zero exposure makes the first frame take the metered one outright
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.pNext                           = nullptr;
+        imageBarrier.srcAccessMask                   = 0;
+        imageBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+        imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image                           = m_vkBloomImage;
+        imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBarrier.subresourceRange.baseMipLevel   = 0;
+        imageBarrier.subresourceRange.levelCount     = std::max(m_bloomMipCount, 1u);
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount     = 1;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+        vkCmdFillBuffer(commandBuffer, m_exposureBuffer.get(), 0, VK_WHOLE_SIZE, 0);
+
+        VkBufferMemoryBarrier bufferBarrier{};
+        bufferBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferBarrier.pNext               = nullptr;
+        bufferBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        bufferBarrier.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferBarrier.buffer              = m_exposureBuffer.get();
+        bufferBarrier.offset              = 0;
+        bufferBarrier.size                = VK_WHOLE_SIZE;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+        m_isInitialized = true;
+    }
+
+    void PostProcess::recordBloom(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float threshold) const noexcept
+    {
+        // each mip halves the region above it, the first also keeps only what exceeds the threshold
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_bloomPipeline.get());
+        VkExtent2D sourceRegion = renderExtent;
+        VkExtent2D sourceExtent = m_extent;
+        for (uint32_t mip = 0; mip < m_bloomMipCount; ++mip)
+        {
+            const VkExtent2D region = getBloomRegion(renderExtent, mip);
+            BloomPushConstants pushConstants{};
+            pushConstants.extents = glm::uvec4(region.width, region.height, sourceRegion.width, sourceRegion.height);
+            pushConstants.params  = glm::vec4(1.0f / static_cast<float>(sourceExtent.width), 1.0f / static_cast<float>(sourceExtent.height),
+                                              mip == 0 ? 0.0f : static_cast<float>(mip - 1), mip == 0 ? std::max(threshold, 1e-4f) : 0.0f);
+
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_bloomPipeline.getLayout(), 0, 1, &m_vkBloomSets[mip], 0, nullptr);
+            vkCmdPushConstants(commandBuffer, m_bloomPipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+            vkCmdDispatch(commandBuffer, (region.width + kBloomWorkgroupSize - 1) / kBloomWorkgroupSize,
+                          (region.height + kBloomWorkgroupSize - 1) / kBloomWorkgroupSize, 1);
+            recordComputeBarrier(commandBuffer);
+
+            sourceRegion = region;
+            sourceExtent = { std::max(m_bloomExtent.width >> mip, 1u), std::max(m_bloomExtent.height >> mip, 1u) };
+        }
+    }
+
+    bool PostProcess::createBloomImage(const VulkanDevice& device) noexcept
+    {
+        // optional: without a storage capable half float format the pass tonemaps without bloom
+        const VkFormatFeatureFlags features = VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                              VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        m_bloomExtent = { std::max(m_extent.width / 2, 1u), std::max(m_extent.height / 2, 1u) };
+        m_bloomMipCount = 0;
+        while (m_bloomMipCount < kBloomMipCount && (m_bloomExtent.width >> m_bloomMipCount) > 0 && (m_bloomExtent.height >> m_bloomMipCount) > 0)
+        {
+            ++m_bloomMipCount;
+        }
+
+        if (!device.isFormatSupported(kSourceFormat, features))
+        {
+            VK_LOG_WARN("PostProcess :: %s cannot be a filtered storage image, bloom disabled", string_VkFormat(kSourceFormat));
+            m_bloomMipCount = 0;
+        }
+
+        // a 1x1 placeholder keeps the tonemap set complete when bloom is unavailable
+        const uint32_t mipCount = std::max(m_bloomMipCount, 1u);
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.pNext         = nullptr;
+        imageInfo.flags         = 0;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = kSourceFormat;
+        imageInfo.extent        = m_bloomMipCount > 0 ? VkExtent3D{ m_bloomExtent.width, m_bloomExtent.height, 1 } : VkExtent3D{ 1, 1, 1 };
+        imageInfo.mipLevels     = mipCount;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | (m_bloomMipCount > 0 ? VK_IMAGE_USAGE_STORAGE_BIT : 0);
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &m_vkBloomImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("PostProcess :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        if (!m_memoryAllocator->allocateImageMemory(m_vkBloomImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_bloomAllocation, VulkanMemoryCategory::kAttachment))
+        {
+            VK_LOG_FATAL("PostProcess :: failed to allocate memory for the bloom chain");
+            return false;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = m_vkBloomImage;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = kSourceFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = mipCount;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkBloomView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("PostProcess :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        m_vkBloomMipViews.assign(m_bloomMipCount, VK_NULL_HANDLE);
+        for (uint32_t mip = 0; mip < m_bloomMipCount; ++mip)
+        {
+            viewInfo.subresourceRange.baseMipLevel = mip;
+            viewInfo.subresourceRange.levelCount   = 1;
+            vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkBloomMipViews[mip]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("PostProcess :: vkCreateImageView failed for bloom mip %u : %s (code: %d)", mip, string_VkResult(vkResult), vkResult);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool PostProcess::createExposureBuffer(const VulkanDevice& device) noexcept
+    {
+        // written by the gpu only; cleared on the first record
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext       = nullptr;
+        bufferCreateInfo.flags       = 0;
+        bufferCreateInfo.size        = kExposureBufferSize;
+        bufferCreateInfo.usage       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (!m_exposureBuffer.createDeviceLocal(device, bufferCreateInfo))
+        {
+            VK_LOG_FATAL("PostProcess :: failed to create exposure buffer");
+            return false;
+        }
+        return true;
+    }
+
+    bool PostProcess::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        const std::vector<VkDescriptorSetLayoutBinding> bloomBindings
+        {
+            { kBloomSourceBinding,      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kBloomDestinationBinding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        const std::vector<VkDescriptorSetLayoutBinding> toneMapBindings
+        {
+            { kSceneBinding,      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kBloomChainBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kOutputBinding,     VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kExposureBinding,   VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        const std::vector<VkDescriptorSetLayoutBinding> tileBindings
+        {
+            { kTileSceneBinding,    VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr },
+            { kTileExposureBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,   1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr }
+        };
+        m_vkBloomSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bloomBindings);
+        m_vkToneMapSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(toneMapBindings);
+        m_vkTileSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(tileBindings);
+        if (m_vkBloomSetLayout == VK_NULL_HANDLE || m_vkToneMapSetLayout == VK_NULL_HANDLE || m_vkTileSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        // private pool for the sets; bindImages and bindTileSource only rewrite them
+        const uint32_t setCount = m_bloomMipCount + 2;
+        const std::array<VkDescriptorPoolSize, 4> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_bloomMipCount + 2 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, m_bloomMipCount + 1 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 },
+            { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1 }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = setCount;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("PostProcess :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // the tonemap and tile sets first, then one per bloom mip
+        std::vector<VkDescriptorSetLayout> layouts(setCount, m_vkBloomSetLayout);
+        layouts[0] = m_vkToneMapSetLayout;
+        layouts[1] = m_vkTileSetLayout;
+        std::vector<VkDescriptorSet> sets(setCount, VK_NULL_HANDLE);
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = setCount;
+        allocateInfo.pSetLayouts        = layouts.data();
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, sets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("PostProcess :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        m_vkToneMapSet = sets[0];
+        m_vkTileSet = sets[1];
+        m_vkBloomSets.assign(sets.begin() + 2, sets.end());
+        return true;
+    }
+
+    bool PostProcess::createPipelines(const VulkanDevice& device, const PostProcessShaders& shaders) noexcept
+    {
+        VulkanShader toneMapShader;
+        VulkanShader exposureShader;
+        if (!toneMapShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mToneMapFile) ||
+            !exposureShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mExposureFile))
+        {
+            VK_LOG_ERROR("PostProcess :: compute shaders '%s' or '%s' unavailable", shaders.mToneMapFile.c_str(), shaders.mExposureFile.c_str());
+            return false;
+        }
+
+        // tonemap and exposure share the set and the push constant block
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = toneMapShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkToneMapSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ToneMapPushConstants) } };
+        if (!m_toneMapPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("PostProcess :: failed to create tonemap pipeline");
+            return false;
+        }
+
+        pipelineConfig.mShaderStage = exposureShader.getShaderStageInfo();
+        if (!m_exposurePipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("PostProcess :: failed to create exposure pipeline");
+            return false;
+        }
+
+        // not fatal: the pass tonemaps without bloom
+        if (m_bloomMipCount == 0)
+        {
+            return true;
+        }
+
+        VulkanShader bloomShader;
+        if (!bloomShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mBloomFile))
+        {
+            VK_LOG_WARN("PostProcess :: compute shader '%s' unavailable, bloom disabled", shaders.mBloomFile.c_str());
+            return true;
+        }
+
+        pipelineConfig.mShaderStage          = bloomShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkBloomSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(BloomPushConstants) } };
+        if (!m_bloomPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_WARN("PostProcess :: failed to create bloom pipeline, bloom disabled");
+        }
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,135 @@
+// ────────────────────────────────────────────
+//  File: post_process.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the compute passes
+    struct PostProcessShaders
+    {
+        std::string mBloomFile;             // bloom_downsample.comp
+        std::string mToneMapFile;           // tonemap.comp
+        std::string mExposureFile;          // exposure.comp
+        std::string mTileVertexFile;        // fullscreen.vert, tile-local tonemap only
+        std::string mTileToneMapFile;       // tonemap_tile.frag, tile-local tonemap only
+    };
+
+    // per-frame controls
+    struct PostProcessSettings
+    {
+        bool  mAutoExposure         = true;
+        float mExposureCompensation = 0.0f;     // ev on top of the metered (or the fixed unit) exposure
+        float mAdaptationSpeed      = 1.5f;     // per second, towards the metered exposure
+        bool  mBloom                = true;
+        float mBloomStrength        = 0.04f;
+        float mBloomThreshold       = 1.0f;     // scene luminance bloom starts at
+    };
+
+    // hdr scene color to the display target in one compute pass: an optional bloom chain downsampled from the
+    // bright parts of the scene, then one invocation per pixel that adds the bloom, applies the exposure and
+    // tonemap and bins the pixel's luminance into a histogram, which a last single-group dispatch reduces into the
+    // exposure the next frame uses. all of it runs over the rendered region only (see dynamic resolution), once
+    // per pixel after the msaa resolve. the histogram and the bloom chain are shared by every frame in flight:
+    // frames record them in queue order. rebuilt with the render graph that owns the source and destination.
+    // tiled gpus can instead tonemap in a subpass of the scene's render pass: a fullscreen fragment pass reads the
+    // scene color as an input attachment, so it never leaves tile memory, and bins a sparse grid of pixels into the
+    // histogram; the exposure is then reduced after the render pass. that variant has no bloom
+    class PostProcess final
+    {
+        public:
+            static constexpr VkFormat kSourceFormat      = VK_FORMAT_R16G16B16A16_SFLOAT;
+            static constexpr VkFormat kDestinationFormat = VK_FORMAT_R8G8B8A8_UNORM;     // gamma encoded, storage capable everywhere
+            static constexpr uint32_t kBloomMipCount     = 5;
+            static constexpr uint32_t kHistogramBinCount = 256;
+
+            // creation and destruction
+            PostProcess() noexcept;
+            ~PostProcess();
+
+            // disable copy and move semantics to enforce unique ownership
+            PostProcess(const PostProcess&) = delete;
+            PostProcess& operator=(const PostProcess&) = delete;
+            PostProcess(PostProcess&&) = delete;
+            PostProcess& operator=(PostProcess&&) = delete;
+
+            // usage: extent is the one of the source and destination images
+            bool initialize(const VulkanDevice& device, const PostProcessShaders& shaders, VkExtent2D extent) noexcept;
+            void destroy() noexcept;
+
+            // usage: source (kSourceFormat) sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, destination (kDestinationFormat)
+            // written as a storage image in VK_IMAGE_LAYOUT_GENERAL
+            void bindImages(VkImageView sourceView, VkImageView destinationView) noexcept;
+
+            // usage: outside render passes; renderExtent is the region of the source the scene rendered into, dt the
+            // simulated time the exposure adapts over
+            void record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float dt, const PostProcessSettings& settings) noexcept;
+
+            // usage: tile-local variant, after initialize (needs fragmentStoresAndAtomics). renderPass and subpass are the
+            // graph's tonemap pass: the scene as its only input attachment, one color attachment of the extent written
+            // with the gamma-encoded values the compute pass would store into the destination
+            bool initializeTileToneMap(const VulkanDevice& device, const PostProcessShaders& shaders, VkRenderPass renderPass, uint32_t subpass) noexcept;
+
+            // usage: the input attachment view of the scene (kSourceFormat), in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            void bindTileSource(VkImageView sourceView) noexcept;
+
+            // usage: inside the tonemap subpass, then recordExposure outside the render pass to reduce what it binned
+            void recordTileToneMap(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, const PostProcessSettings& settings) const noexcept;
+            void recordExposure(VkCommandBuffer commandBuffer, float dt, const PostProcessSettings& settings) noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_toneMapPipeline.isValid() && m_exposurePipeline.isValid() && m_vkToneMapSet != VK_NULL_HANDLE; }
+            bool isTileToneMapValid() const noexcept { return m_tileToneMapPipeline.isValid() && m_exposurePipeline.isValid() && m_vkTileSet != VK_NULL_HANDLE; }
+            bool hasBloom() const noexcept { return m_bloomPipeline.isValid() && m_bloomMipCount > 0; }
+
+        private:
+            bool createBloomImage(const VulkanDevice& device) noexcept;
+            bool createExposureBuffer(const VulkanDevice& device) noexcept;
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipelines(const VulkanDevice& device, const PostProcessShaders& shaders) noexcept;
+            void recordBloom(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float threshold) const noexcept;
+            void recordSetup(VkCommandBuffer commandBuffer) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VulkanMemoryAllocator*          m_memoryAllocator;
+            VkSampler                       m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout           m_vkBloomSetLayout;     // owned by the device layout cache
+            VkDescriptorSetLayout           m_vkToneMapSetLayout;   // owned by the device layout cache
+            VkDescriptorSetLayout           m_vkTileSetLayout;      // owned by the device layout cache
+            VkDescriptorPool                m_vkDescriptorPool;
+            std::vector<VkDescriptorSet>    m_vkBloomSets;          // per bloom mip: its source and its storage view
+            VkDescriptorSet                 m_vkToneMapSet;         // shared by the tonemap and exposure dispatches
+            VkDescriptorSet                 m_vkTileSet;            // input attachment and exposure of the tile-local tonemap
+            VulkanPipeline                  m_bloomPipeline;
+            VulkanPipeline                  m_toneMapPipeline;
+            VulkanPipeline                  m_exposurePipeline;
+            VulkanPipeline                  m_tileToneMapPipeline;
+
+            // bloom chain at half the extent and below, kept in VK_IMAGE_LAYOUT_GENERAL
+            VkImage                         m_vkBloomImage;
+            VkImageView                     m_vkBloomView;          // every mip, sampled
+            std::vector<VkImageView>        m_vkBloomMipViews;      // one per mip, written
+            VulkanAllocation                m_bloomAllocation;
+            uint32_t                        m_bloomMipCount;
+            VkExtent2D                      m_bloomExtent;
+
+            // histogram bins followed by the adapted exposure
+            VulkanBuffer                    m_exposureBuffer;
+            VkExtent2D                      m_extent;
+            bool                            m_isInitialized;        // bloom layout and exposure buffer set up on the gpu
+    };
+}   // namespace keplar
@@ -0,0 +1,497 @@
+// ────────────────────────────────────────────
+//  File: ray_traced_shadows.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "ray_traced_shadows.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // bottom levels are built once and traced every frame; top levels are refit every frame
+    constexpr VkBuildAccelerationStructureFlagsKHR kBottomLevelFlags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+                                                                       VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+    constexpr VkBuildAccelerationStructureFlagsKHR kTopLevelFlags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+                                                                    VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+
+    inline VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // row-major 3x4 geometry-to-world transform of an instance
+    VkTransformMatrixKHR toTransformMatrix(const glm::mat4& transform) noexcept
+    {
+        VkTransformMatrixKHR matrix{};
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            for (uint32_t column = 0; column < 4; ++column)
+            {
+                matrix.matrix[row][column] = transform[column][row];
+            }
+        }
+        return matrix;
+    }
+
+    // opaque triangles, so ray queries commit the first hit without a candidate loop
+    VkAccelerationStructureGeometryKHR makeTriangleGeometry(const keplar::RayTracingGeometry& geometry) noexcept
+    {
+        VkAccelerationStructureGeometryKHR geometryDesc{};
+        geometryDesc.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+        geometryDesc.pNext = nullptr;
+        geometryDesc.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+        geometryDesc.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+        geometryDesc.geometry.triangles.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+        geometryDesc.geometry.triangles.pNext = nullptr;
+        geometryDesc.geometry.triangles.vertexFormat = geometry.mVertexFormat;
+        geometryDesc.geometry.triangles.vertexData.deviceAddress = geometry.mVertexAddress;
+        geometryDesc.geometry.triangles.vertexStride = geometry.mVertexStride;
+        geometryDesc.geometry.triangles.maxVertex = geometry.mMaxVertex;
+        geometryDesc.geometry.triangles.indexType = geometry.mIndexType;
+        geometryDesc.geometry.triangles.indexData.deviceAddress = geometry.mIndexAddress;
+        geometryDesc.geometry.triangles.transformData.deviceAddress = 0;
+        return geometryDesc;
+    }
+
+    VkAccelerationStructureGeometryKHR makeInstanceGeometry(VkDeviceAddress instanceAddress) noexcept
+    {
+        VkAccelerationStructureGeometryKHR geometryDesc{};
+        geometryDesc.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+        geometryDesc.pNext = nullptr;
+        geometryDesc.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+        geometryDesc.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+        geometryDesc.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+        geometryDesc.geometry.instances.pNext = nullptr;
+        geometryDesc.geometry.instances.arrayOfPointers = VK_FALSE;
+        geometryDesc.geometry.instances.data.deviceAddress = instanceAddress;
+        return geometryDesc;
+    }
+
+    VkAccelerationStructureBuildGeometryInfoKHR makeBuildInfo(VkAccelerationStructureTypeKHR type, VkBuildAccelerationStructureFlagsKHR flags,
+                                                              const VkAccelerationStructureGeometryKHR* geometry) noexcept
+    {
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
+        buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        buildInfo.pNext = nullptr;
+        buildInfo.type = type;
+        buildInfo.flags = flags;
+        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        buildInfo.srcAccelerationStructure = VK_NULL_HANDLE;
+        buildInfo.dstAccelerationStructure = VK_NULL_HANDLE;
+        buildInfo.geometryCount = 1;
+        buildInfo.pGeometries = geometry;
+        buildInfo.ppGeometries = nullptr;
+        buildInfo.scratchData.deviceAddress = 0;
+        return buildInfo;
+    }
+}
+
+namespace keplar
+{
+    RayTracedShadows::RayTracedShadows() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_scratchAlignment(1)
+        , m_bottomLevelCount(0)
+        , m_buildBytes(0)
+        , m_compactedBytes(0)
+        , m_maxInstanceCount(0)
+    {
+    }
+
+    RayTracedShadows::~RayTracedShadows()
+    {
+        destroy();
+    }
+
+    bool RayTracedShadows::initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const GLTFModel& model, uint32_t frameCount) noexcept
+    {
+        if (!device.isRayQueryEnabled() || !model.hasRayTracingGeometry() || frameCount == 0)
+        {
+            VK_LOG_WARN("RayTracedShadows::initialize :: ray query or the model's ray tracing inputs are unavailable");
+            return false;
+        }
+
+        destroy();
+        m_vkDevice = device.getDevice();
+
+        const VkPhysicalDeviceAccelerationStructurePropertiesKHR& properties = device.getAccelerationStructureProperties();
+        m_scratchAlignment = std::max<VkDeviceSize>(properties.minAccelerationStructureScratchOffsetAlignment, 1);
+
+        std::vector<RayTracingGeometry> geometries;
+        model.getRayTracingGeometries(geometries);
+
+        // packed positions are built from as unorm16, which devices need not support as a vertex format
+        const bool isPacked = std::any_of(geometries.begin(), geometries.end(), [](const RayTracingGeometry& geometry)
+        {
+            return geometry.mTriangleCount > 0 && geometry.mVertexFormat == VK_FORMAT_R16G16B16A16_UNORM;
+        });
+        if (isPacked)
+        {
+            VkFormatProperties formatProperties{};
+            vkGetPhysicalDeviceFormatProperties(device.getPhysicalDevice(), VK_FORMAT_R16G16B16A16_UNORM, &formatProperties);
+            if ((formatProperties.bufferFeatures & VK_FORMAT_FEATURE_ACCELERATION_STRUCTURE_VERTEX_BUFFER_BIT_KHR) == 0)
+            {
+                VK_LOG_WARN("RayTracedShadows::initialize :: packed positions are not a supported acceleration structure vertex format");
+                destroy();
+                return false;
+            }
+        }
+
+        const uint64_t maxInstanceCount = std::min<uint64_t>(properties.maxInstanceCount, std::numeric_limits<uint32_t>::max());
+        m_maxInstanceCount = static_cast<uint32_t>(std::min<uint64_t>(model.getRayTracingInstanceCapacity(), maxInstanceCount));
+        if (!buildBottomLevels(device, stagingBelt, geometries) || m_maxInstanceCount == 0 || !createFrames(device, frameCount))
+        {
+            VK_LOG_WARN("RayTracedShadows::initialize :: failed to build acceleration structures for the model");
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("RayTracedShadows::initialize successful (%u bottom levels compacted from %llu to %llu bytes, %u instances per frame)",
+                     m_bottomLevelCount, static_cast<unsigned long long>(m_buildBytes), static_cast<unsigned long long>(m_compactedBytes),
+                     m_maxInstanceCount);
+        return true;
+    }
+
+    void RayTracedShadows::destroy() noexcept
+    {
+        m_frames.clear();
+        m_bottomLevels.clear();
+        m_bottomLevelCount = 0;
+        m_buildBytes = 0;
+        m_compactedBytes = 0;
+        m_maxInstanceCount = 0;
+        m_scratchAlignment = 1;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    void RayTracedShadows::prepare(uint32_t frameIndex, const GLTFModel& model, const glm::mat4& modelToWorld) noexcept
+    {
+        if (!isValid() || frameIndex >= m_frames.size())
+        {
+            return;
+        }
+
+        Frame& frame = m_frames[frameIndex];
+        frame.mInstances.clear();
+        model.gatherRayTracingInstances(modelToWorld, frame.mInstances);
+
+        // instances of geometries without a bottom level are dropped, the rest written as the build reads them
+        auto* instances = static_cast<VkAccelerationStructureInstanceKHR*>(frame.mInstanceBuffer.getMappedData());
+        uint32_t count = 0;
+        for (const RayTracingInstance& instance : frame.mInstances)
+        {
+            if (count == m_maxInstanceCount)
+            {
+                break;
+            }
+            if (instance.mGeometry >= m_bottomLevels.size() || !m_bottomLevels[instance.mGeometry].isValid())
+            {
+                continue;
+            }
+
+            VkAccelerationStructureInstanceKHR& output = instances[count++];
+            output.transform = toTransformMatrix(instance.mTransform);
+            output.instanceCustomIndex = instance.mGeometry;
+            output.mask = 0xFF;
+            output.instanceShaderBindingTableRecordOffset = 0;
+            output.flags = VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR | (instance.mIsDoubleSided ? VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR : 0);
+            output.accelerationStructureReference = m_bottomLevels[instance.mGeometry].getDeviceAddress();
+        }
+
+        frame.mInstanceCount = count;
+        frame.mInstanceBuffer.flush(0, static_cast<VkDeviceSize>(count) * sizeof(VkAccelerationStructureInstanceKHR));
+    }
+
+    void RayTracedShadows::record(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept
+    {
+        if (!isValid() || frameIndex >= m_frames.size())
+        {
+            return;
+        }
+
+        // refit in place while the instance count holds, rebuild when it changes or the refits grew the bounds too often
+        Frame& frame = m_frames[frameIndex];
+        const bool isRefit = frame.mIsBuilt && frame.mInstanceCount == frame.mBuiltInstanceCount && frame.mRefitCount < kMaxRefitCount;
+
+        const VkAccelerationStructureGeometryKHR geometry = makeInstanceGeometry(frame.mInstanceBuffer.getDeviceAddress());
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo = makeBuildInfo(VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR, kTopLevelFlags, &geometry);
+        buildInfo.mode = isRefit ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        buildInfo.srcAccelerationStructure = isRefit ? frame.mTopLevel.get() : VK_NULL_HANDLE;
+        buildInfo.dstAccelerationStructure = frame.mTopLevel.get();
+        buildInfo.scratchData.deviceAddress = alignScratch(frame.mScratchBuffer);
+
+        VkAccelerationStructureBuildRangeInfoKHR rangeInfo{};
+        rangeInfo.primitiveCount = frame.mInstanceCount;
+        const VkAccelerationStructureBuildRangeInfoKHR* rangeInfos = &rangeInfo;
+
+        // earlier builds (the bottom levels, this slot's last top level) before the build reads or rewrites them,
+        // then the new top level before the fragment shaders (or the deferred lighting pass) trace it
+        VulkanBarrierBatch barriers;
+        barriers.memoryBarrier(VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                               VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                               VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR);
+        barriers.flush(commandBuffer);
+
+        VulkanAccelerationStructure::cmdBuild(commandBuffer, 1, &buildInfo, &rangeInfos);
+
+        barriers.memoryBarrier(VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                               VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR);
+        barriers.flush(commandBuffer);
+
+        if (isRefit)
+        {
+            ++frame.mRefitCount;
+        }
+        else
+        {
+            frame.mBuiltInstanceCount = frame.mInstanceCount;
+            frame.mRefitCount = 0;
+            frame.mIsBuilt = true;
+        }
+    }
+
+    bool RayTracedShadows::buildBottomLevels(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::vector<RayTracingGeometry>& geometries) noexcept
+    {
+        // one opaque triangle geometry per structure, sized for its full-detail triangles
+        struct Build
+        {
+            uint32_t                                    mGeometry;
+            VkAccelerationStructureGeometryKHR          mGeometryDesc;
+            VkAccelerationStructureBuildRangeInfoKHR    mRangeInfo;
+            VkDeviceSize                                mScratchSize;
+            VulkanAccelerationStructure                 mStructure;
+        };
+
+        std::vector<Build> builds;
+        builds.reserve(geometries.size());
+        VkDeviceSize totalScratchSize = 0;
+        VkDeviceSize maxScratchSize = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(geometries.size()); ++i)
+        {
+            if (geometries[i].mTriangleCount == 0)
+            {
+                continue;
+            }
+
+            Build& build = builds.emplace_back();
+            build.mGeometry = i;
+            build.mGeometryDesc = makeTriangleGeometry(geometries[i]);
+            build.mRangeInfo = { geometries[i].mTriangleCount, 0, 0, 0 };
+
+            const VkAccelerationStructureBuildGeometryInfoKHR buildInfo = makeBuildInfo(VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR, kBottomLevelFlags,
+                                                                                        &build.mGeometryDesc);
+            const VkAccelerationStructureBuildSizesInfoKHR sizes = VulkanAccelerationStructure::getBuildSizes(m_vkDevice, buildInfo, &geometries[i].mTriangleCount);
+            if (!build.mStructure.initialize(device, VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR, sizes.accelerationStructureSize))
+            {
+                VK_LOG_ERROR("RayTracedShadows::buildBottomLevels :: failed to create the structure of geometry %u", i);
+                return false;
+            }
+
+            build.mScratchSize = alignUp(sizes.buildScratchSize, m_scratchAlignment);
+            totalScratchSize += build.mScratchSize;
+            maxScratchSize = std::max(maxScratchSize, build.mScratchSize);
+            m_buildBytes += sizes.accelerationStructureSize;
+        }
+
+        if (builds.empty())
+        {
+            VK_LOG_WARN("RayTracedShadows::buildBottomLevels :: the model has no static opaque geometry");
+            return false;
+        }
+
+        // one scratch buffer for every batch: builds of a batch take disjoint ranges, batches reuse it in turn
+        const VkDeviceSize scratchSize = std::max(maxScratchSize, std::min(totalScratchSize, kScratchBudget));
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferCreateInfo.size = scratchSize + m_scratchAlignment;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VulkanBuffer scratchBuffer;
+        if (!scratchBuffer.createDeviceLocal(device, bufferCreateInfo))
+        {
+            VK_LOG_ERROR("RayTracedShadows::buildBottomLevels :: failed to create a %llu byte scratch buffer", static_cast<unsigned long long>(scratchSize));
+            return false;
+        }
+
+        // compacted sizes are written into queries after the builds
+        const uint32_t buildCount = static_cast<uint32_t>(builds.size());
+        VkQueryPoolCreateInfo queryPoolCreateInfo{};
+        queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolCreateInfo.pNext = nullptr;
+        queryPoolCreateInfo.flags = 0;
+        queryPoolCreateInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        queryPoolCreateInfo.queryCount = buildCount;
+        queryPoolCreateInfo.pipelineStatistics = 0;
+
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        VkResult result = vkCreateQueryPool(m_vkDevice, &queryPoolCreateInfo, nullptr, &queryPool);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkCreateQueryPool failed with error code %d", result);
+            return false;
+        }
+
+        // earlier uploads (the model's positions and indices) complete before the builds read them
+        VkCommandBuffer commandBuffer = stagingBelt.flush(true) ? stagingBelt.getGraphicsCommandBuffer() : VK_NULL_HANDLE;
+        if (commandBuffer == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("RayTracedShadows::buildBottomLevels :: failed to get staging belt graphics command buffer");
+            vkDestroyQueryPool(m_vkDevice, queryPool, nullptr);
+            return false;
+        }
+        vkCmdResetQueryPool(commandBuffer, queryPool, 0, buildCount);
+
+        // batches of builds up to the scratch size, each one call; a barrier lets the next batch reuse the scratch
+        // and, after the last, the size queries read the structures
+        const VkDeviceAddress scratchAddress = alignScratch(scratchBuffer);
+        std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos;
+        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> rangeInfos;
+        VkDeviceSize scratchOffset = 0;
+        VulkanBarrierBatch barriers;
+        auto recordBatch = [&]()
+        {
+            VulkanAccelerationStructure::cmdBuild(commandBuffer, static_cast<uint32_t>(buildInfos.size()), buildInfos.data(), rangeInfos.data());
+            barriers.memoryBarrier(VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                                   VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                   VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR);
+            barriers.flush(commandBuffer);
+            buildInfos.clear();
+            rangeInfos.clear();
+            scratchOffset = 0;
+        };
+
+        uint32_t batchCount = 0;
+        for (Build& build : builds)
+        {
+            if (!buildInfos.empty() && scratchOffset + build.mScratchSize > scratchSize)
+            {
+                recordBatch();
+                ++batchCount;
+            }
+
+            VkAccelerationStructureBuildGeometryInfoKHR& buildInfo = buildInfos.emplace_back(
+                makeBuildInfo(VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR, kBottomLevelFlags, &build.mGeometryDesc));
+            buildInfo.dstAccelerationStructure = build.mStructure.get();
+            buildInfo.scratchData.deviceAddress = scratchAddress + scratchOffset;
+            rangeInfos.push_back(&build.mRangeInfo);
+            scratchOffset += build.mScratchSize;
+        }
+        recordBatch();
+        ++batchCount;
+
+        std::vector<VkAccelerationStructureKHR> structures(buildCount);
+        std::transform(builds.begin(), builds.end(), structures.begin(), [](const Build& build) { return build.mStructure.get(); });
+        VulkanAccelerationStructure::cmdWriteCompactedSizes(commandBuffer, buildCount, structures.data(), queryPool, 0);
+
+        std::vector<VkDeviceSize> compactedSizes(buildCount, 0);
+        bool isBuilt = stagingBelt.flush(true);
+        if (isBuilt)
+        {
+            result = vkGetQueryPoolResults(m_vkDevice, queryPool, 0, buildCount, compactedSizes.size() * sizeof(VkDeviceSize), compactedSizes.data(),
+                                           sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+            isBuilt = result == VK_SUCCESS;
+        }
+        vkDestroyQueryPool(m_vkDevice, queryPool, nullptr);
+        if (!isBuilt)
+        {
+            VK_LOG_ERROR("RayTracedShadows::buildBottomLevels :: builds or their compacted size queries failed");
+            return false;
+        }
+
+        // the scratch is free again: the builds completed
+        scratchBuffer = VulkanBuffer();
+
+        // copy each structure into one of its compacted size; those that would not shrink are kept as built
+        commandBuffer = stagingBelt.getGraphicsCommandBuffer();
+        if (commandBuffer == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("RayTracedShadows::buildBottomLevels :: failed to get staging belt graphics command buffer");
+            return false;
+        }
+
+        m_bottomLevels.resize(geometries.size());
+        for (uint32_t i = 0; i < buildCount; ++i)
+        {
+            Build& build = builds[i];
+            VulkanAccelerationStructure& bottomLevel = m_bottomLevels[build.mGeometry];
+            if (compactedSizes[i] == 0 || compactedSizes[i] >= build.mStructure.getSize() ||
+                !bottomLevel.initialize(device, VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR, compactedSizes[i]))
+            {
+                bottomLevel = std::move(build.mStructure);
+            }
+            else
+            {
+                VulkanAccelerationStructure::cmdCompact(commandBuffer, build.mStructure.get(), bottomLevel.get());
+            }
+            m_compactedBytes += bottomLevel.getSize();
+        }
+
+        // the build-sized originals are released once the copies completed
+        if (!stagingBelt.flush(true))
+        {
+            VK_LOG_ERROR("RayTracedShadows::buildBottomLevels :: compacting copies failed");
+            return false;
+        }
+
+        m_bottomLevelCount = buildCount;
+        VK_LOG_DEBUG("RayTracedShadows::buildBottomLevels :: %u structures in %u batches over %llu scratch bytes", buildCount, batchCount,
+                     static_cast<unsigned long long>(scratchSize));
+        return true;
+    }
+
+    bool RayTracedShadows::createFrames(const VulkanDevice& device, uint32_t frameCount) noexcept
+    {
+        // sized for every placement's draws, so a rebuild never outgrows the structure
+        const VkAccelerationStructureGeometryKHR geometry = makeInstanceGeometry(0);
+        const VkAccelerationStructureBuildGeometryInfoKHR buildInfo = makeBuildInfo(VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR, kTopLevelFlags, &geometry);
+        const VkAccelerationStructureBuildSizesInfoKHR sizes = VulkanAccelerationStructure::getBuildSizes(m_vkDevice, buildInfo, &m_maxInstanceCount);
+
+        VkBufferCreateInfo scratchCreateInfo{};
+        scratchCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        scratchCreateInfo.pNext = nullptr;
+        scratchCreateInfo.flags = 0;
+        scratchCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        scratchCreateInfo.size = std::max(sizes.buildScratchSize, sizes.updateScratchSize) + m_scratchAlignment;
+        scratchCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        // the cpu rewrites the instances every frame, so they stay mapped (in device-local memory when the device has it)
+        VkBufferCreateInfo instanceCreateInfo{};
+        instanceCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        instanceCreateInfo.pNext = nullptr;
+        instanceCreateInfo.flags = 0;
+        instanceCreateInfo.usage = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        instanceCreateInfo.size = static_cast<VkDeviceSize>(m_maxInstanceCount) * sizeof(VkAccelerationStructureInstanceKHR);
+        instanceCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        m_frames.resize(frameCount);
+        for (uint32_t i = 0; i < frameCount; ++i)
+        {
+            Frame& frame = m_frames[i];
+            if (!frame.mTopLevel.initialize(device, VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR, sizes.accelerationStructureSize) ||
+                !frame.mScratchBuffer.createDeviceLocal(device, scratchCreateInfo) ||
+                !frame.mInstanceBuffer.createHostVisible(device, instanceCreateInfo, nullptr, 0, true, true))
+            {
+                VK_LOG_ERROR("RayTracedShadows::createFrames :: failed to create the top level of frame %u", i);
+                m_frames.clear();
+                return false;
+            }
+            frame.mInstances.reserve(m_maxInstanceCount);
+        }
+        return true;
+    }
+
+    VkDeviceAddress RayTracedShadows::alignScratch(const VulkanBuffer& scratchBuffer) const noexcept
+    {
+        // scratch buffers are created an alignment larger than they need
+        return alignUp(scratchBuffer.getDeviceAddress(), m_scratchAlignment);
+    }
+}   // namespace keplar
@@ -0,0 +1,100 @@
+// ────────────────────────────────────────────
+//  File: ray_traced_shadows.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "math3d.hpp"
+#include "gltf_model.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_acceleration_structure.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class VulkanStagingBelt;
+
+    // acceleration structures the pbr fragment shaders trace shadow rays against with ray queries, in place of shadow
+    // maps. one bottom-level structure per static opaque primitive of the model, built once (prefer fast trace, with
+    // compaction) in batches sharing one scratch buffer, then compacted into structures of their queried size; the
+    // build-sized originals are released once the compacting copies completed. every frame in flight owns a top-level
+    // structure over the model's placed draws, refit in place from the frame's instance transforms while their count
+    // is unchanged, and rebuilt when it changes or after kMaxRefitCount refits, whose bounds only ever grow
+    class RayTracedShadows final
+    {
+        public:
+            // refits of a top-level structure before it is rebuilt to restore its trace performance
+            static constexpr uint32_t kMaxRefitCount = 120;
+
+            // bytes of scratch a batch of bottom-level builds may share (raised to the largest single build)
+            static constexpr VkDeviceSize kScratchBudget = 32ull * 1024 * 1024;
+
+            // creation and destruction
+            RayTracedShadows() noexcept;
+            ~RayTracedShadows();
+
+            // disable copy and move semantics to enforce unique ownership
+            RayTracedShadows(const RayTracedShadows&) = delete;
+            RayTracedShadows& operator=(const RayTracedShadows&) = delete;
+            RayTracedShadows(RayTracedShadows&&) = delete;
+            RayTracedShadows& operator=(RayTracedShadows&&) = delete;
+
+            // builds and compacts the model's bottom-level structures through the staging belt, waiting for both
+            // submissions, and sizes the top-level structures for the model's instance capacity. false without ray
+            // query, or when the model has no ray tracing inputs or no static opaque geometry
+            bool initialize(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const GLTFModel& model, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame once its slot is free; writes the frame's instances (every placed static opaque draw,
+            // modelToWorld as for GLTFModel::gatherRayTracingInstances) for the next record
+            void prepare(uint32_t frameIndex, const GLTFModel& model, const glm::mat4& modelToWorld) noexcept;
+
+            // usage: record outside a render pass before the passes tracing the frame's top-level structure; its build
+            // is made visible to fragment shader ray queries
+            void record(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept;
+
+            // accessors
+            bool isValid() const noexcept                                       { return !m_frames.empty(); }
+            VkAccelerationStructureKHR getTopLevel(uint32_t frameIndex) const noexcept { return m_frames[frameIndex].mTopLevel.get(); }
+            uint32_t getInstanceCount(uint32_t frameIndex) const noexcept       { return m_frames[frameIndex].mInstanceCount; }
+            uint32_t getBottomLevelCount() const noexcept                       { return m_bottomLevelCount; }
+            VkDeviceSize getBuildBytes() const noexcept                         { return m_buildBytes; }      // bottom levels before compaction
+            VkDeviceSize getCompactedBytes() const noexcept                     { return m_compactedBytes; }
+
+        private:
+            struct Frame
+            {
+                VulkanAccelerationStructure     mTopLevel;
+                VulkanBuffer                    mInstanceBuffer;        // persistently mapped VkAccelerationStructureInstanceKHR array
+                VulkanBuffer                    mScratchBuffer;
+                std::vector<RayTracingInstance> mInstances;
+                uint32_t                        mInstanceCount = 0;     // written by the last prepare
+                uint32_t                        mBuiltInstanceCount = 0;    // of the last full build, kept by refits
+                uint32_t                        mRefitCount = 0;
+                bool                            mIsBuilt = false;
+            };
+
+            bool buildBottomLevels(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::vector<RayTracingGeometry>& geometries) noexcept;
+            bool createFrames(const VulkanDevice& device, uint32_t frameCount) noexcept;
+            VkDeviceAddress alignScratch(const VulkanBuffer& scratchBuffer) const noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                                    m_vkDevice;
+            VkDeviceSize                                m_scratchAlignment;
+
+            // compacted bottom levels, indexed by geometry (invalid for geometries without triangles)
+            std::vector<VulkanAccelerationStructure>    m_bottomLevels;
+            uint32_t                                    m_bottomLevelCount;
+            VkDeviceSize                                m_buildBytes;
+            VkDeviceSize                                m_compactedBytes;
+
+            // per frame in flight: instances and the top level built over them
+            std::vector<Frame>                          m_frames;
+            uint32_t                                    m_maxInstanceCount;
+    };
+}   // namespace keplar
@@ -0,0 +1,1007 @@
+// ────────────────────────────────────────────
+//  File: render_graph.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "render_graph.hpp"
+
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "gpu_profiler.hpp"
+#include "utils/frame_arena.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // attachment-only usage qualifies for transient (lazily allocated) memory
+    constexpr VkImageUsageFlags kAttachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                                                   VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+
+    // how a subpass uses an attachment; shading rate and input attachments are only ever read
+    enum class AttachmentRole { kColor, kDepthStencil, kShadingRate, kInput };
+
+    AttachmentRole getAttachmentRole(const keplar::RenderGraphImageDesc& desc) noexcept
+    {
+        return (desc.mAspect & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0 ? AttachmentRole::kDepthStencil : AttachmentRole::kColor;
+    }
+
+    VkPipelineStageFlags getAttachmentStages(AttachmentRole role) noexcept
+    {
+        switch (role)
+        {
+            case AttachmentRole::kDepthStencil: return VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            case AttachmentRole::kShadingRate:  return VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+            case AttachmentRole::kInput:        return VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            default:                            return VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        }
+    }
+
+    VkAccessFlags getAttachmentAccess(AttachmentRole role) noexcept
+    {
+        switch (role)
+        {
+            case AttachmentRole::kDepthStencil: return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            case AttachmentRole::kShadingRate:  return VK_ACCESS_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR;
+            case AttachmentRole::kInput:        return VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+            default:                            return VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        }
+    }
+
+    VkAccessFlags getAttachmentWriteAccess(AttachmentRole role) noexcept
+    {
+        switch (role)
+        {
+            case AttachmentRole::kDepthStencil: return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            case AttachmentRole::kShadingRate:
+            case AttachmentRole::kInput:        return 0;
+            default:                            return VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        }
+    }
+
+    VkImageLayout getAttachmentLayout(AttachmentRole role) noexcept
+    {
+        switch (role)
+        {
+            case AttachmentRole::kDepthStencil: return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            case AttachmentRole::kShadingRate:  return VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+            case AttachmentRole::kInput:        return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            default:                            return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        }
+    }
+
+    // every image the pass writes (attachments and storage)
+    template <typename Fn>
+    void forEachWrite(const keplar::RenderGraphPassDesc& desc, Fn&& fn)
+    {
+        for (const auto& attachment : desc.mColorAttachments) { fn(attachment.mImage); }
+        for (const auto image : desc.mResolveAttachments)     { fn(image); }
+        if (desc.mDepthStencilAttachment)                     { fn(desc.mDepthStencilAttachment->mImage); }
+        for (const auto image : desc.mStorageImages)          { fn(image); }
+    }
+
+    // every image the pass touches
+    template <typename Fn>
+    void forEachImage(const keplar::RenderGraphPassDesc& desc, Fn&& fn)
+    {
+        forEachWrite(desc, fn);
+        for (const auto image : desc.mSampledImages)                            { fn(image); }
+        for (const auto image : desc.mInputAttachments)                         { fn(image); }
+        if (desc.mShadingRateAttachment != keplar::kInvalidRenderGraphHandle)   { fn(desc.mShadingRateAttachment); }
+    }
+}   // namespace
+
+namespace keplar
+{
+    RenderGraph::RenderGraph() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_extent{}
+        , m_transientMemorySize(0)
+        , m_importCount(1)
+        , m_firstImportPass(0)
+        , m_isCompiled(false)
+        , m_profiler(nullptr)
+    {
+    }
+
+    RenderGraph::~RenderGraph()
+    {
+        destroy();
+    }
+
+    RenderGraphHandle RenderGraph::importImage(const std::string& name, const RenderGraphImageDesc& desc, const std::vector<VkImage>& images,
+                                               const std::vector<VkImageView>& imageViews, VkImageLayout initialLayout, VkImageLayout finalLayout) noexcept
+    {
+        // multi-image imports are indexed by execute's image index, so they must agree on the count
+        const uint32_t count = static_cast<uint32_t>(images.size());
+        if (m_isCompiled || count == 0 || imageViews.size() != images.size() || (count > 1 && m_importCount > 1 && count != m_importCount))
+        {
+            VK_LOG_ERROR("RenderGraph::importImage :: invalid import '%s'", name.c_str());
+            return kInvalidRenderGraphHandle;
+        }
+
+        Image image{};
+        image.mName          = name;
+        image.mDesc          = desc;
+        image.mIsImported    = true;
+        image.mInitialLayout = initialLayout;
+        image.mFinalLayout   = finalLayout;
+        image.mImages        = images;
+        image.mImageViews    = imageViews;
+        m_images.emplace_back(std::move(image));
+
+        m_importCount = std::max(m_importCount, count);
+        return static_cast<RenderGraphHandle>(m_images.size() - 1);
+    }
+
+    RenderGraphHandle RenderGraph::createImage(const std::string& name, const RenderGraphImageDesc& desc) noexcept
+    {
+        if (m_isCompiled || desc.mFormat == VK_FORMAT_UNDEFINED)
+        {
+            VK_LOG_ERROR("RenderGraph::createImage :: invalid image '%s'", name.c_str());
+            return kInvalidRenderGraphHandle;
+        }
+
+        // vulkan objects are created at compile, once lifetimes are known
+        Image image{};
+        image.mName = name;
+        image.mDesc = desc;
+        m_images.emplace_back(std::move(image));
+        return static_cast<RenderGraphHandle>(m_images.size() - 1);
+    }
+
+    RenderGraphHandle RenderGraph::addPass(RenderGraphPassDesc desc) noexcept
+    {
+        // every referenced image must be declared; compute passes have no attachments
+        bool isValid = !m_isCompiled;
+        forEachImage(desc, [&](RenderGraphHandle image) { isValid = isValid && isValidImage(image); });
+
+        const bool isGraphics = desc.mBindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS;
+        const bool hasAttachments = !desc.mColorAttachments.empty() || desc.mDepthStencilAttachment.has_value();
+        // multiview passes write a layer per view of their mask into every attachment
+        if (desc.mViewMask != 0)
+        {
+            uint32_t viewCount = 0;
+            while ((desc.mViewMask >> viewCount) != 0) { ++viewCount; }
+
+            auto hasLayers = [&](RenderGraphHandle image) { isValid = isValid && (!isValidImage(image) || m_images[image].mDesc.mLayers >= viewCount); };
+            for (const auto& attachment : desc.mColorAttachments) { hasLayers(attachment.mImage); }
+            for (const auto image : desc.mResolveAttachments)     { hasLayers(image); }
+            if (desc.mDepthStencilAttachment)                     { hasLayers(desc.mDepthStencilAttachment->mImage); }
+            isValid = isValid && isGraphics;
+        }
+
+        // input attachments are color images the pass reads, not one of its own outputs (no feedback loops)
+        for (const auto image : desc.mInputAttachments)
+        {
+            isValid = isValid && isGraphics && isValidImage(image) && getAttachmentRole(m_images[image].mDesc) == AttachmentRole::kColor;
+            forEachWrite(desc, [&](RenderGraphHandle output) { isValid = isValid && output != image; });
+        }
+
+        if (!isValid || isGraphics != hasAttachments || desc.mResolveAttachments.size() > desc.mColorAttachments.size())
+        {
+            VK_LOG_ERROR("RenderGraph::addPass :: invalid pass '%s'", desc.mName.c_str());
+            return kInvalidRenderGraphHandle;
+        }
+
+        Pass pass{};
+        pass.mDesc = std::move(desc);
+        m_passes.emplace_back(std::move(pass));
+        return static_cast<RenderGraphHandle>(m_passes.size() - 1);
+    }
+
+    bool RenderGraph::compile(const VulkanDevice& device, VkExtent2D extent) noexcept
+    {
+        // graphs are rebuilt rather than recompiled
+        if (m_isCompiled || m_passes.empty())
+        {
+            VK_LOG_ERROR("RenderGraph::compile :: graph is already compiled or has no passes");
+            return false;
+        }
+
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_extent = extent;
+
+        // lifetimes and usage, then physical passes and memory
+        deriveUsage();
+        mergePasses();
+        if (!createTransientImages(device))
+        {
+            destroy();
+            return false;
+        }
+
+        // walk the physical passes in order, tracking each image's layout and last access
+        std::vector<ImageState> states(m_images.size());
+        for (size_t i = 0; i < m_images.size(); ++i)
+        {
+            const Image& image = m_images[i];
+            if (image.mIsImported)
+            {
+                // imports are synchronized by the caller's waits at the attachment stages (e.g. the acquire semaphore)
+                states[i].mLayout = image.mInitialLayout;
+                states[i].mStages = getAttachmentStages(getAttachmentRole(image.mDesc));
+            }
+        }
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_physicalPasses.size()); ++i)
+        {
+            // transient images reusing aliased memory wait for the previous occupant's last access
+            auto& physicalPass = m_physicalPasses[i];
+            for (size_t image = 0; image < m_images.size(); ++image)
+            {
+                const Image& current = m_images[image];
+                if (current.mIsImported || current.mAliasGroup == UINT32_MAX || m_passes[current.mFirstPass].mPhysicalPass != i)
+                {
+                    continue;
+                }
+
+                for (size_t other = 0; other < m_images.size(); ++other)
+                {
+                    const Image& previous = m_images[other];
+                    if (other != image && previous.mAliasGroup == current.mAliasGroup && previous.mLastPass < current.mFirstPass)
+                    {
+                        states[image].mStages |= states[other].mStages;
+                        states[image].mAccess |= states[other].mAccess;
+                        states[image].mIsWrite = true;
+                    }
+                }
+            }
+
+            collectBarriers(physicalPass, states);
+            if (physicalPass.mIsGraphics && (!createRenderPass(physicalPass, states) || !createFramebuffers(physicalPass)))
+            {
+                destroy();
+                return false;
+            }
+        }
+
+        // passes ahead of the first one on a per-image import (the swapchain) can record before an image is acquired
+        const auto isPerImage = [this](RenderGraphHandle image) { return isValidImage(image) && m_images[image].mImages.size() > 1; };
+        m_firstImportPass = static_cast<uint32_t>(m_physicalPasses.size());
+        for (uint32_t i = 0; i < m_firstImportPass; ++i)
+        {
+            for (uint32_t pass : m_physicalPasses[i].mPasses)
+            {
+                const auto& desc = m_passes[pass].mDesc;
+                bool isImportUsed = (desc.mDepthStencilAttachment && isPerImage(desc.mDepthStencilAttachment->mImage)) || isPerImage(desc.mShadingRateAttachment);
+                for (const auto& attachment : desc.mColorAttachments) { isImportUsed = isImportUsed || isPerImage(attachment.mImage); }
+                for (auto image : desc.mResolveAttachments)            { isImportUsed = isImportUsed || isPerImage(image); }
+                for (auto image : desc.mSampledImages)                 { isImportUsed = isImportUsed || isPerImage(image); }
+                for (auto image : desc.mStorageImages)                 { isImportUsed = isImportUsed || isPerImage(image); }
+                for (auto image : desc.mInputAttachments)              { isImportUsed = isImportUsed || isPerImage(image); }
+                if (isImportUsed)
+                {
+                    m_firstImportPass = i;
+                    break;
+                }
+            }
+        }
+
+        m_isCompiled = true;
+        VK_LOG_DEBUG("RenderGraph::compile successful (passes: %zu, physical passes: %zu, transient memory: %llu bytes)",
+                     m_passes.size(), m_physicalPasses.size(), static_cast<unsigned long long>(m_transientMemorySize));
+        return true;
+    }
+
+    void RenderGraph::execute(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex) const noexcept
+    {
+        execute(commandBuffer, imageIndex, frameIndex, 0, static_cast<uint32_t>(m_physicalPasses.size()));
+    }
+
+    void RenderGraph::execute(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex, uint32_t firstPass, uint32_t endPass) const noexcept
+    {
+        if (!m_isCompiled || (m_importCount > 1 && imageIndex >= m_importCount))
+        {
+            VK_LOG_WARN("RenderGraph::execute :: graph not compiled or invalid image index %u", imageIndex);
+            return;
+        }
+
+        // barrier scratch on the recording thread's arena, given back once recorded
+        FrameArena::Scope arenaScope(FrameArena::getThreadArena());
+        ArenaVector<VkImageMemoryBarrier> imageBarriers;
+        endPass = std::min(endPass, static_cast<uint32_t>(m_physicalPasses.size()));
+        for (uint32_t passIndex = firstPass; passIndex < endPass; ++passIndex)
+        {
+            const auto& physicalPass = m_physicalPasses[passIndex];
+            // pass timing and pipeline statistics include its barriers; statistics around executed secondaries need them inherited
+            uint32_t profileScope = UINT32_MAX;
+            if (m_profiler)
+            {
+                const bool isStatistics = m_profiler->getInheritedStatistics() != 0 ||
+                    std::none_of(physicalPass.mPasses.begin(), physicalPass.mPasses.end(),
+                                 [this](uint32_t pass) { return m_passes[pass].mDesc.mContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS; });
+                profileScope = m_profiler->beginScope(commandBuffer, m_passes[physicalPass.mPasses.front()].mDesc.mName.c_str(), isStatistics);
+            }
+
+            // barriers derived at compile, resolved to this frame's images
+            if (!physicalPass.mBarriers.empty())
+            {
+                imageBarriers.clear();
+                for (const auto& barrier : physicalPass.mBarriers)
+                {
+                    const Image& image = m_images[barrier.mImage];
+                    VkImageMemoryBarrier imageBarrier{};
+                    imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                    imageBarrier.pNext                           = nullptr;
+                    imageBarrier.srcAccessMask                   = barrier.mSrcAccess;
+                    imageBarrier.dstAccessMask                   = barrier.mDstAccess;
+                    imageBarrier.oldLayout                       = barrier.mOldLayout;
+                    imageBarrier.newLayout                       = barrier.mNewLayout;
+                    imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                    imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                    imageBarrier.image                           = image.mImages[image.mImages.size() > 1 ? imageIndex : 0];
+                    imageBarrier.subresourceRange.aspectMask     = image.mDesc.mAspect;
+                    imageBarrier.subresourceRange.baseMipLevel   = 0;
+                    imageBarrier.subresourceRange.levelCount     = 1;
+                    imageBarrier.subresourceRange.baseArrayLayer = 0;
+                    imageBarrier.subresourceRange.layerCount     = image.mDesc.mLayers;
+                    imageBarriers.push_back(imageBarrier);
+                }
+
+                VulkanCommandCounters::addBarrier();
+                vkCmdPipelineBarrier(commandBuffer, physicalPass.mSrcStages, physicalPass.mDstStages, 0, 0, nullptr, 0, nullptr,
+                                     static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+            }
+
+            RenderGraphPassContext context{};
+            context.mExtent     = m_extent;
+            context.mImageIndex = imageIndex;
+            context.mFrameIndex = frameIndex;
+
+            // compute passes record directly
+            if (!physicalPass.mIsGraphics)
+            {
+                const auto& desc = m_passes[physicalPass.mPasses.front()].mDesc;
+                if (desc.mRecord) { desc.mRecord(commandBuffer, context); }
+                if (m_profiler) { m_profiler->endScope(commandBuffer, profileScope); }
+                continue;
+            }
+
+            // graphics passes record their subpasses in declaration order
+            const auto& framebuffer = physicalPass.mFramebuffers[physicalPass.mFramebuffers.size() > 1 ? imageIndex : 0];
+            context.mRenderPass  = physicalPass.mRenderPass.get();
+            context.mFramebuffer = framebuffer.get();
+
+            VkRenderPassBeginInfo renderPassBeginInfo{};
+            renderPassBeginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassBeginInfo.pNext             = nullptr;
+            renderPassBeginInfo.renderPass        = context.mRenderPass;
+            renderPassBeginInfo.framebuffer       = context.mFramebuffer;
+            renderPassBeginInfo.renderArea.offset = { 0, 0 };
+            renderPassBeginInfo.renderArea.extent = m_extent;
+            renderPassBeginInfo.clearValueCount   = static_cast<uint32_t>(physicalPass.mClearValues.size());
+            renderPassBeginInfo.pClearValues      = physicalPass.mClearValues.data();
+
+            for (uint32_t subpass = 0; subpass < static_cast<uint32_t>(physicalPass.mPasses.size()); ++subpass)
+            {
+                const auto& desc = m_passes[physicalPass.mPasses[subpass]].mDesc;
+                if (subpass == 0)
+                {
+                    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, desc.mContents);
+                }
+                else
+                {
+                    vkCmdNextSubpass(commandBuffer, desc.mContents);
+                }
+
+                context.mSubpass = subpass;
+                if (desc.mRecord) { desc.mRecord(commandBuffer, context); }
+            }
+
+            vkCmdEndRenderPass(commandBuffer);
+            if (m_profiler) { m_profiler->endScope(commandBuffer, profileScope); }
+        }
+    }
+
+    void RenderGraph::destroy() noexcept
+    {
+        // render passes and framebuffers release themselves
+        m_physicalPasses.clear();
+
+        // transient images and their (shared) memory
+        for (auto& image : m_images)
+        {
+            if (image.mIsImported)
+            {
+                continue;
+            }
+
+            for (auto imageView : image.mImageViews)
+            {
+                if (imageView != VK_NULL_HANDLE) { vkDestroyImageView(m_vkDevice, imageView, nullptr); }
+            }
+
+            for (auto imageView : image.mLayerViews)
+            {
+                if (imageView != VK_NULL_HANDLE) { vkDestroyImageView(m_vkDevice, imageView, nullptr); }
+            }
+
+            for (auto vkImage : image.mImages)
+            {
+                if (vkImage != VK_NULL_HANDLE) { vkDestroyImage(m_vkDevice, vkImage, nullptr); }
+            }
+        }
+
+        for (auto& aliasGroup : m_aliasGroups)
+        {
+            if (m_memoryAllocator && aliasGroup.mAllocation.isValid())
+            {
+                m_memoryAllocator->free(aliasGroup.mAllocation);
+            }
+        }
+
+        m_images.clear();
+        m_passes.clear();
+        m_aliasGroups.clear();
+        m_transientMemorySize = 0;
+        m_importCount = 1;
+        m_firstImportPass = 0;
+        m_isCompiled = false;
+    }
+
+    VkRenderPass RenderGraph::getRenderPass(RenderGraphHandle pass) const noexcept
+    {
+        if (!m_isCompiled || pass >= m_passes.size())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        return m_physicalPasses[m_passes[pass].mPhysicalPass].mRenderPass.get();
+    }
+
+    uint32_t RenderGraph::getSubpassIndex(RenderGraphHandle pass) const noexcept
+    {
+        return pass < m_passes.size() ? m_passes[pass].mSubpass : 0;
+    }
+
+    VkImage RenderGraph::getImage(RenderGraphHandle image, uint32_t imageIndex) const noexcept
+    {
+        if (!m_isCompiled || !isValidImage(image) || m_images[image].mImages.empty())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // transient images have a single image for every index
+        const auto& images = m_images[image].mImages;
+        return images[images.size() > 1 ? imageIndex % images.size() : 0];
+    }
+
+    VkImageView RenderGraph::getImageView(RenderGraphHandle image, uint32_t imageIndex) const noexcept
+    {
+        if (!m_isCompiled || !isValidImage(image) || m_images[image].mImageViews.empty())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        const auto& imageViews = m_images[image].mImageViews;
+        return imageViews[imageViews.size() > 1 ? imageIndex % imageViews.size() : 0];
+    }
+
+    VkImageView RenderGraph::getLayerView(RenderGraphHandle image, uint32_t layer) const noexcept
+    {
+        if (!m_isCompiled || !isValidImage(image) || layer >= m_images[image].mLayerViews.size())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        return m_images[image].mLayerViews[layer];
+    }
+
+    VkFramebuffer RenderGraph::getFramebuffer(RenderGraphHandle pass, uint32_t imageIndex) const noexcept
+    {
+        if (!m_isCompiled || pass >= m_passes.size())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        const auto& framebuffers = m_physicalPasses[m_passes[pass].mPhysicalPass].mFramebuffers;
+        if (framebuffers.empty())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        return framebuffers.size() > 1 ? (imageIndex < framebuffers.size() ? framebuffers[imageIndex].get() : VK_NULL_HANDLE) : framebuffers[0].get();
+    }
+
+    void RenderGraph::deriveUsage() noexcept
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_passes.size()); ++i)
+        {
+            const auto& desc = m_passes[i].mDesc;
+            forEachImage(desc, [&](RenderGraphHandle handle)
+            {
+                Image& image = m_images[handle];
+                image.mFirstPass = std::min(image.mFirstPass, i);
+                image.mLastPass  = std::max(image.mLastPass, i);
+            });
+
+            for (const auto& attachment : desc.mColorAttachments) { m_images[attachment.mImage].mUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT; }
+            for (const auto image : desc.mResolveAttachments)     { m_images[image].mUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT; }
+            for (const auto image : desc.mSampledImages)          { m_images[image].mUsage |= VK_IMAGE_USAGE_SAMPLED_BIT; }
+            for (const auto image : desc.mStorageImages)          { m_images[image].mUsage |= VK_IMAGE_USAGE_STORAGE_BIT; }
+            for (const auto image : desc.mInputAttachments)       { m_images[image].mUsage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT; }
+            if (desc.mDepthStencilAttachment)
+            {
+                m_images[desc.mDepthStencilAttachment->mImage].mUsage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            }
+            if (desc.mShadingRateAttachment != kInvalidRenderGraphHandle)
+            {
+                m_images[desc.mShadingRateAttachment].mUsage |= VK_IMAGE_USAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+            }
+        }
+    }
+
+    void RenderGraph::mergePasses() noexcept
+    {
+        m_physicalPasses.clear();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_passes.size()); ++i)
+        {
+            auto& pass = m_passes[i];
+            const bool isGraphics = pass.mDesc.mBindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+            // a graphics pass joins the open render pass unless it samples or stores an image written there, or draws
+            // another set of views; input attachments read those images in place
+            bool canMerge = isGraphics && !m_physicalPasses.empty() && m_physicalPasses.back().mIsGraphics &&
+                            m_passes[m_physicalPasses.back().mPasses.front()].mDesc.mViewMask == pass.mDesc.mViewMask;
+            if (canMerge)
+            {
+                std::vector<bool> isWritten(m_images.size(), false);
+                for (const uint32_t previous : m_physicalPasses.back().mPasses)
+                {
+                    forEachWrite(m_passes[previous].mDesc, [&](RenderGraphHandle image) { isWritten[image] = true; });
+                }
+
+                for (const auto image : pass.mDesc.mSampledImages) { canMerge = canMerge && !isWritten[image]; }
+                for (const auto image : pass.mDesc.mStorageImages) { canMerge = canMerge && !isWritten[image]; }
+                if (pass.mDesc.mShadingRateAttachment != kInvalidRenderGraphHandle)
+                {
+                    canMerge = canMerge && !isWritten[pass.mDesc.mShadingRateAttachment];
+                }
+            }
+
+            if (!canMerge)
+            {
+                m_physicalPasses.emplace_back();
+                m_physicalPasses.back().mIsGraphics = isGraphics;
+            }
+
+            auto& physicalPass = m_physicalPasses.back();
+            physicalPass.mPasses.push_back(i);
+            pass.mPhysicalPass = static_cast<uint32_t>(m_physicalPasses.size() - 1);
+            pass.mSubpass = static_cast<uint32_t>(physicalPass.mPasses.size() - 1);
+        }
+    }
+
+    bool RenderGraph::createTransientImages(const VulkanDevice& device) noexcept
+    {
+        // transient images in order of first use
+        std::vector<RenderGraphHandle> transients;
+        for (RenderGraphHandle i = 0; i < static_cast<RenderGraphHandle>(m_images.size()); ++i)
+        {
+            if (!m_images[i].mIsImported && m_images[i].mFirstPass != UINT32_MAX)
+            {
+                transients.push_back(i);
+            }
+        }
+
+        std::sort(transients.begin(), transients.end(), [&](RenderGraphHandle a, RenderGraphHandle b)
+        {
+            return m_images[a].mFirstPass < m_images[b].mFirstPass;
+        });
+
+        std::vector<VkMemoryRequirements> requirements(m_images.size());
+        for (const auto handle : transients)
+        {
+            Image& image = m_images[handle];
+            const bool isTransientAttachment = (image.mUsage & ~kAttachmentUsage) == 0;
+
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.pNext         = nullptr;
+            imageInfo.flags         = 0;
+            imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+            imageInfo.format        = image.mDesc.mFormat;
+            imageInfo.extent        = { m_extent.width, m_extent.height, 1 };
+            imageInfo.mipLevels     = 1;
+            imageInfo.arrayLayers   = std::max(image.mDesc.mLayers, 1u);
+            imageInfo.samples       = image.mDesc.mSamples;
+            imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage         = image.mUsage | (isTransientAttachment ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : 0);
+            imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            image.mImages.assign(1, VK_NULL_HANDLE);
+            image.mImageViews.assign(1, VK_NULL_HANDLE);
+            VkResult vkResult = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &image.mImages[0]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("RenderGraph :: vkCreateImage failed for '%s' : %s (code: %d)", image.mName.c_str(), string_VkResult(vkResult), vkResult);
+                return false;
+            }
+
+            vkGetImageMemoryRequirements(m_vkDevice, image.mImages[0], &requirements[handle]);
+            const VkMemoryRequirements& imageRequirements = requirements[handle];
+
+            // lazily allocated memory only backs attachments that never leave tile memory
+            const VkMemoryPropertyFlags propertyFlags = isTransientAttachment && device.findMemoryType(imageRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+                                                      ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+            // first fit: a group whose occupants are all dead before this image's first use
+            for (uint32_t group = 0; group < static_cast<uint32_t>(m_aliasGroups.size()); ++group)
+            {
+                AliasGroup& aliasGroup = m_aliasGroups[group];
+                const uint32_t sharedTypeBits = aliasGroup.mRequirements.memoryTypeBits & imageRequirements.memoryTypeBits;
+                if (aliasGroup.mLastPass < image.mFirstPass && aliasGroup.mPropertyFlags == propertyFlags && sharedTypeBits != 0 &&
+                    device.findMemoryType(sharedTypeBits, propertyFlags))
+                {
+                    aliasGroup.mRequirements.size           = std::max(aliasGroup.mRequirements.size, imageRequirements.size);
+                    aliasGroup.mRequirements.alignment      = std::max(aliasGroup.mRequirements.alignment, imageRequirements.alignment);
+                    aliasGroup.mRequirements.memoryTypeBits = sharedTypeBits;
+                    aliasGroup.mLastPass = image.mLastPass;
+                    image.mAliasGroup = group;
+                    break;
+                }
+            }
+
+            if (image.mAliasGroup == UINT32_MAX)
+            {
+                AliasGroup aliasGroup{};
+                aliasGroup.mRequirements  = imageRequirements;
+                aliasGroup.mPropertyFlags = propertyFlags;
+                aliasGroup.mLastPass      = image.mLastPass;
+                m_aliasGroups.push_back(aliasGroup);
+                image.mAliasGroup = static_cast<uint32_t>(m_aliasGroups.size() - 1);
+            }
+        }
+
+        // one allocation per group, shared by every image in it
+        for (auto& aliasGroup : m_aliasGroups)
+        {
+            if (!m_memoryAllocator->allocateImageMemory(aliasGroup.mRequirements, aliasGroup.mPropertyFlags, aliasGroup.mAllocation,
+                                                        VulkanMemoryCategory::kAttachment))
+            {
+                VK_LOG_FATAL("RenderGraph :: failed to allocate %llu bytes of transient memory", static_cast<unsigned long long>(aliasGroup.mRequirements.size));
+                return false;
+            }
+            m_transientMemorySize += aliasGroup.mRequirements.size;
+        }
+
+        for (const auto handle : transients)
+        {
+            Image& image = m_images[handle];
+            const VulkanAllocation& allocation = m_aliasGroups[image.mAliasGroup].mAllocation;
+            VkResult vkResult = vkBindImageMemory(m_vkDevice, image.mImages[0], allocation.mMemory, allocation.mOffset);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("RenderGraph :: vkBindImageMemory failed for '%s' : %s (code: %d)", image.mName.c_str(), string_VkResult(vkResult), vkResult);
+                return false;
+            }
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.pNext                           = nullptr;
+            viewInfo.flags                           = 0;
+            viewInfo.image                           = image.mImages[0];
+            viewInfo.viewType                        = image.mDesc.mLayers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format                          = image.mDesc.mFormat;
+            viewInfo.subresourceRange.aspectMask     = image.mDesc.mAspect;
+            viewInfo.subresourceRange.baseMipLevel   = 0;
+            viewInfo.subresourceRange.levelCount     = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount     = std::max(image.mDesc.mLayers, 1u);
+
+            vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &image.mImageViews[0]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("RenderGraph :: vkCreateImageView failed for '%s' : %s (code: %d)", image.mName.c_str(), string_VkResult(vkResult), vkResult);
+                return false;
+            }
+
+            // single layers of multiview targets, for passes that read one view
+            if (image.mDesc.mLayers > 1)
+            {
+                image.mLayerViews.assign(image.mDesc.mLayers, VK_NULL_HANDLE);
+                viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.subresourceRange.layerCount = 1;
+                for (uint32_t layer = 0; layer < image.mDesc.mLayers; ++layer)
+                {
+                    viewInfo.subresourceRange.baseArrayLayer = layer;
+                    vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &image.mLayerViews[layer]);
+                    if (vkResult != VK_SUCCESS)
+                    {
+                        VK_LOG_FATAL("RenderGraph :: vkCreateImageView failed for layer %u of '%s' : %s (code: %d)", layer, image.mName.c_str(),
+                                     string_VkResult(vkResult), vkResult);
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool RenderGraph::createRenderPass(PhysicalPass& physicalPass, std::vector<ImageState>& states) noexcept
+    {
+        const uint32_t subpassCount = static_cast<uint32_t>(physicalPass.mPasses.size());
+        const uint32_t lastPass = physicalPass.mPasses.back();
+
+        // attachment slots in order of first use; the first use decides the load op and clear value
+        std::vector<uint32_t> attachmentIndices(m_images.size(), VK_ATTACHMENT_UNUSED);
+        std::vector<VkAttachmentDescription> attachments;
+        std::vector<VkImageLayout> lastLayouts;
+        std::vector<uint32_t> lastSubpasses;
+        std::vector<AttachmentRole> lastRoles;
+        std::vector<VkPipelineStageFlags> usedStages;
+        std::vector<VkAccessFlags> writeAccess;
+        std::vector<bool> isFinalLayoutFixed;
+
+        auto addAttachment = [&](RenderGraphHandle handle, VkAttachmentLoadOp loadOp, const VkClearValue& clearValue, uint32_t subpass,
+                                 AttachmentRole role) -> uint32_t
+        {
+            const Image& image = m_images[handle];
+            if (attachmentIndices[handle] != VK_ATTACHMENT_UNUSED)
+            {
+                lastSubpasses[attachmentIndices[handle]] = subpass;
+                return attachmentIndices[handle];
+            }
+
+            // results nobody reads after this render pass are never written back (imports always are)
+            const bool isStored = image.mIsImported || isUsedAfter(handle, lastPass);
+            const VkAttachmentStoreOp storeOp = isStored ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            const bool hasStencil = (image.mDesc.mAspect & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+
+            VkAttachmentDescription attachment{};
+            attachment.flags          = 0;
+            attachment.format         = image.mDesc.mFormat;
+            attachment.samples        = image.mDesc.mSamples;
+            attachment.loadOp         = loadOp;
+            attachment.storeOp        = storeOp;
+            attachment.stencilLoadOp  = hasStencil ? loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachment.stencilStoreOp = hasStencil ? storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachment.initialLayout  = loadOp == VK_ATTACHMENT_LOAD_OP_LOAD ? states[handle].mLayout : VK_IMAGE_LAYOUT_UNDEFINED;
+            attachment.finalLayout    = getAttachmentLayout(role);
+
+            // imports leave in their final layout after their last use, everything else in the layout of its last use
+            const bool isImportFinal = image.mIsImported && image.mLastPass <= lastPass && image.mFinalLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+            if (isImportFinal)
+            {
+                attachment.finalLayout = image.mFinalLayout;
+            }
+
+            attachmentIndices[handle] = static_cast<uint32_t>(attachments.size());
+            attachments.push_back(attachment);
+            lastLayouts.push_back(getAttachmentLayout(role));
+            lastSubpasses.push_back(subpass);
+            lastRoles.push_back(role);
+            usedStages.push_back(0);
+            writeAccess.push_back(0);
+            isFinalLayoutFixed.push_back(isImportFinal);
+            physicalPass.mAttachments.push_back(handle);
+            physicalPass.mClearValues.push_back(clearValue);
+            return attachmentIndices[handle];
+        };
+
+        // external dependency into each subpass for attachments it uses first
+        std::vector<VkSubpassDependency> dependencies;
+        auto addDependency = [&](uint32_t srcSubpass, uint32_t dstSubpass, VkPipelineStageFlags srcStages, VkAccessFlags srcAccess,
+                                 VkPipelineStageFlags dstStages, VkAccessFlags dstAccess, VkDependencyFlags flags)
+        {
+            for (auto& dependency : dependencies)
+            {
+                if (dependency.srcSubpass == srcSubpass && dependency.dstSubpass == dstSubpass)
+                {
+                    dependency.srcStageMask    |= srcStages;
+                    dependency.srcAccessMask   |= srcAccess;
+                    dependency.dstStageMask    |= dstStages;
+                    dependency.dstAccessMask   |= dstAccess;
+                    dependency.dependencyFlags &= flags;
+                    return;
+                }
+            }
+
+            dependencies.push_back({ srcSubpass, dstSubpass, srcStages, dstStages, srcAccess, dstAccess, flags });
+        };
+
+        // attachment references per subpass (sized up front so pointers stay valid)
+        std::vector<std::vector<VkAttachmentReference>> inputReferences(subpassCount);
+        std::vector<std::vector<VkAttachmentReference>> colorReferences(subpassCount);
+        std::vector<std::vector<VkAttachmentReference>> resolveReferences(subpassCount);
+        std::vector<VkAttachmentReference> depthReferences(subpassCount);
+        std::vector<VkSubpassDescription> subpasses(subpassCount);
+        std::vector<VulkanShadingRateAttachment> shadingRateAttachments;
+
+        for (uint32_t subpass = 0; subpass < subpassCount; ++subpass)
+        {
+            const auto& desc = m_passes[physicalPass.mPasses[subpass]].mDesc;
+            auto useAttachment = [&](RenderGraphHandle handle, VkAttachmentLoadOp loadOp, const VkClearValue& clearValue, AttachmentRole role) -> uint32_t
+            {
+                const bool isFirstUse = attachmentIndices[handle] == VK_ATTACHMENT_UNUSED;
+                const uint32_t previousSubpass = isFirstUse ? 0 : lastSubpasses[attachmentIndices[handle]];
+                const AttachmentRole previousRole = isFirstUse ? role : lastRoles[attachmentIndices[handle]];
+                const uint32_t index = addAttachment(handle, loadOp, clearValue, subpass, role);
+
+                const VkPipelineStageFlags stages = getAttachmentStages(role);
+                const VkAccessFlags access = getAttachmentAccess(role);
+                if (isFirstUse)
+                {
+                    const ImageState& state = states[handle];
+                    addDependency(VK_SUBPASS_EXTERNAL, subpass, state.mStages, state.mIsWrite ? state.mAccess : 0, stages, access, 0);
+                }
+                else if (previousSubpass != subpass)
+                {
+                    // by region: a later subpass only ever touches the pixels of the earlier one it runs over
+                    addDependency(previousSubpass, subpass, getAttachmentStages(previousRole), getAttachmentWriteAccess(previousRole), stages, access,
+                                  VK_DEPENDENCY_BY_REGION_BIT);
+                }
+
+                lastLayouts[index] = getAttachmentLayout(role);
+                lastRoles[index]   = role;
+                usedStages[index] |= stages;
+                writeAccess[index] |= getAttachmentWriteAccess(role);
+                return index;
+            };
+
+            // written earlier in the render pass, or loaded from memory on first use
+            for (const auto image : desc.mInputAttachments)
+            {
+                inputReferences[subpass].push_back({ useAttachment(image, VK_ATTACHMENT_LOAD_OP_LOAD, VkClearValue{}, AttachmentRole::kInput),
+                                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+            }
+
+            for (const auto& color : desc.mColorAttachments)
+            {
+                colorReferences[subpass].push_back({ useAttachment(color.mImage, color.mLoadOp, color.mClearValue, AttachmentRole::kColor),
+                                                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+            }
+
+            if (!desc.mResolveAttachments.empty())
+            {
+                resolveReferences[subpass].assign(desc.mColorAttachments.size(), { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED });
+                for (size_t i = 0; i < desc.mResolveAttachments.size(); ++i)
+                {
+                    resolveReferences[subpass][i] = { useAttachment(desc.mResolveAttachments[i], VK_ATTACHMENT_LOAD_OP_DONT_CARE, VkClearValue{},
+                                                                    AttachmentRole::kColor), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+                }
+            }
+
+            depthReferences[subpass] = { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED };
+            if (desc.mDepthStencilAttachment)
+            {
+                const auto& depth = *desc.mDepthStencilAttachment;
+                depthReferences[subpass] = { useAttachment(depth.mImage, depth.mLoadOp, depth.mClearValue, AttachmentRole::kDepthStencil),
+                                             VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+            }
+
+            // the rate image is written outside the render pass and has to survive into it
+            if (desc.mShadingRateAttachment != kInvalidRenderGraphHandle)
+            {
+                const uint32_t index = useAttachment(desc.mShadingRateAttachment, VK_ATTACHMENT_LOAD_OP_LOAD, VkClearValue{}, AttachmentRole::kShadingRate);
+                shadingRateAttachments.push_back({ subpass, index, desc.mShadingRateTexelSize });
+            }
+
+            VkSubpassDescription& description = subpasses[subpass];
+            description.flags                   = 0;
+            description.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            description.inputAttachmentCount    = static_cast<uint32_t>(inputReferences[subpass].size());
+            description.pInputAttachments       = inputReferences[subpass].empty() ? nullptr : inputReferences[subpass].data();
+            description.colorAttachmentCount    = static_cast<uint32_t>(colorReferences[subpass].size());
+            description.pColorAttachments       = colorReferences[subpass].data();
+            description.pResolveAttachments     = resolveReferences[subpass].empty() ? nullptr : resolveReferences[subpass].data();
+            description.pDepthStencilAttachment = desc.mDepthStencilAttachment ? &depthReferences[subpass] : nullptr;
+            description.preserveAttachmentCount = 0;
+            description.pPreserveAttachments    = nullptr;
+        }
+
+        // final layout transitions complete before anything outside the render pass
+        for (size_t i = 0; i < attachments.size(); ++i)
+        {
+            const AttachmentRole role = lastRoles[i];
+            if (!isFinalLayoutFixed[i])
+            {
+                attachments[i].finalLayout = lastLayouts[i];
+            }
+            else if (attachments[i].finalLayout != lastLayouts[i])
+            {
+                addDependency(lastSubpasses[i], VK_SUBPASS_EXTERNAL, getAttachmentStages(role), getAttachmentWriteAccess(role),
+                              VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0);
+            }
+
+            // attachments leave written by any subpass (shading rate and input attachments only read), in their final layout
+            const bool isWrite = writeAccess[i] != 0;
+            ImageState& state = states[physicalPass.mAttachments[i]];
+            state.mLayout  = attachments[i].finalLayout;
+            state.mStages  = usedStages[i];
+            state.mAccess  = isWrite ? writeAccess[i] : getAttachmentAccess(role);
+            state.mIsWrite = isWrite;
+        }
+
+        // merged passes share one view mask (see mergePasses)
+        const uint32_t viewMask = m_passes[physicalPass.mPasses.front()].mDesc.mViewMask;
+        if (!physicalPass.mRenderPass.initialize(m_vkDevice, attachments, subpasses, dependencies, shadingRateAttachments, viewMask))
+        {
+            VK_LOG_ERROR("RenderGraph::compile :: failed to create render pass for '%s'", m_passes[physicalPass.mPasses.front()].mDesc.mName.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RenderGraph::createFramebuffers(PhysicalPass& physicalPass) noexcept
+    {
+        // one framebuffer per image index when a multi-image import is attached
+        uint32_t framebufferCount = 1;
+        for (const auto handle : physicalPass.mAttachments)
+        {
+            framebufferCount = std::max(framebufferCount, static_cast<uint32_t>(m_images[handle].mImageViews.size()));
+        }
+
+        std::vector<VkImageView> imageViews(physicalPass.mAttachments.size(), VK_NULL_HANDLE);
+        VkFramebufferCreateInfo framebufferCreateInfo{};
+        framebufferCreateInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferCreateInfo.pNext           = nullptr;
+        framebufferCreateInfo.flags           = 0;
+        framebufferCreateInfo.renderPass      = physicalPass.mRenderPass.get();
+        framebufferCreateInfo.attachmentCount = static_cast<uint32_t>(imageViews.size());
+        framebufferCreateInfo.pAttachments    = imageViews.data();
+        framebufferCreateInfo.width           = m_extent.width;
+        framebufferCreateInfo.height          = m_extent.height;
+        framebufferCreateInfo.layers          = 1;
+
+        physicalPass.mFramebuffers.resize(framebufferCount);
+        for (uint32_t i = 0; i < framebufferCount; ++i)
+        {
+            for (size_t attachment = 0; attachment < imageViews.size(); ++attachment)
+            {
+                const auto& views = m_images[physicalPass.mAttachments[attachment]].mImageViews;
+                imageViews[attachment] = views[views.size() > 1 ? i : 0];
+            }
+
+            if (!physicalPass.mFramebuffers[i].initialize(m_vkDevice, framebufferCreateInfo))
+            {
+                VK_LOG_ERROR("RenderGraph::compile :: failed to create framebuffer %u", i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void RenderGraph::collectBarriers(PhysicalPass& physicalPass, std::vector<ImageState>& states) const noexcept
+    {
+        // shader reads and storage writes synchronize outside the render pass
+        for (const uint32_t passIndex : physicalPass.mPasses)
+        {
+            const auto& desc = m_passes[passIndex].mDesc;
+            const VkPipelineStageFlags stages = desc.mBindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                                                                                                  : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            auto useImage = [&](RenderGraphHandle handle, VkImageLayout layout, VkAccessFlags access, bool isWrite)
+            {
+                ImageState& state = states[handle];
+
+                // reads after reads in the same layout just widen the set of readers a later write must wait for
+                if (!isWrite && !state.mIsWrite && state.mLayout == layout)
+                {
+                    state.mStages |= stages;
+                    state.mAccess |= access;
+                    return;
+                }
+
+                physicalPass.mBarriers.push_back({ handle, state.mLayout, layout, state.mIsWrite ? state.mAccess : 0, access });
+                physicalPass.mSrcStages |= state.mStages;
+                physicalPass.mDstStages |= stages;
+                state = ImageState{ layout, stages, access, isWrite };
+            };
+
+            for (const auto image : desc.mSampledImages) { useImage(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT, false); }
+            for (const auto image : desc.mStorageImages) { useImage(image, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, true); }
+        }
+    }
+
+    bool RenderGraph::isUsedAfter(RenderGraphHandle image, uint32_t pass) const noexcept
+    {
+        return isValidImage(image) && m_images[image].mFirstPass != UINT32_MAX && m_images[image].mLastPass > pass;
+    }
+}   // namespace keplar
@@ -0,0 +1,242 @@
+// ────────────────────────────────────────────
+//  File: render_graph.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+#include "vulkan/vulkan_render_pass.hpp"
+#include "vulkan/vulkan_framebuffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class GpuProfiler;
+
+    // index of a declared image or pass
+    using RenderGraphHandle = uint32_t;
+    inline constexpr RenderGraphHandle kInvalidRenderGraphHandle = UINT32_MAX;
+
+    // image properties; every graph image shares the extent given to compile() (imported shading rate images excepted)
+    struct RenderGraphImageDesc
+    {
+        VkFormat                mFormat  = VK_FORMAT_UNDEFINED;
+        VkSampleCountFlagBits   mSamples = VK_SAMPLE_COUNT_1_BIT;
+        VkImageAspectFlags      mAspect  = VK_IMAGE_ASPECT_COLOR_BIT;
+        uint32_t                mLayers  = 1;                       // one per view of the multiview passes writing it
+    };
+
+    // color or depth-stencil attachment of a graphics pass
+    struct RenderGraphAttachment
+    {
+        RenderGraphHandle       mImage      = kInvalidRenderGraphHandle;
+        VkAttachmentLoadOp      mLoadOp     = VK_ATTACHMENT_LOAD_OP_LOAD;    // CLEAR uses mClearValue, DONT_CARE discards
+        VkClearValue            mClearValue{};
+    };
+
+    // state handed to a pass while it records
+    struct RenderGraphPassContext
+    {
+        VkRenderPass            mRenderPass  = VK_NULL_HANDLE;      // VK_NULL_HANDLE for compute passes
+        uint32_t                mSubpass     = 0;
+        VkFramebuffer           mFramebuffer = VK_NULL_HANDLE;
+        VkExtent2D              mExtent{};
+        uint32_t                mImageIndex  = 0;                   // selects the image of multi-image imports (swapchain)
+        uint32_t                mFrameIndex  = 0;
+    };
+
+    // a pass declares what it touches; the graph derives layouts, load/store ops, dependencies and barriers.
+    // graphics passes record inside their (possibly merged) render pass subpass, compute passes outside render passes
+    struct RenderGraphPassDesc
+    {
+        std::string                             mName;
+        VkPipelineBindPoint                     mBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        VkSubpassContents                       mContents  = VK_SUBPASS_CONTENTS_INLINE;
+
+        // graphics outputs (resolve targets pair with color attachments by index)
+        std::vector<RenderGraphAttachment>      mColorAttachments;
+        std::vector<RenderGraphHandle>          mResolveAttachments;
+        std::optional<RenderGraphAttachment>    mDepthStencilAttachment;
+
+        // shader access: sampled reads and storage writes
+        std::vector<RenderGraphHandle>          mSampledImages;
+        std::vector<RenderGraphHandle>          mStorageImages;
+
+        // tile-local reads (subpassLoad) of color images at the fragment's own pixel, bound as input attachments in
+        // this order. unlike sampled reads they keep the pass in the render pass that wrote the image, so on tiled
+        // gpus the image never leaves tile memory when nothing after the render pass reads it
+        std::vector<RenderGraphHandle>          mInputAttachments;
+
+        // optional fragment shading rate attachment (VK_KHR_fragment_shading_rate), read by the rasterizer; one texel
+        // covers mShadingRateTexelSize pixels, so the image may be that much smaller than the graph extent
+        RenderGraphHandle                       mShadingRateAttachment = kInvalidRenderGraphHandle;
+        VkExtent2D                              mShadingRateTexelSize{};
+
+        // optional multiview (VulkanDevice::isMultiviewEnabled): every draw renders each view of the mask into the
+        // attachment layer of that index, so attachments need a layer per view. passes only merge with equal masks
+        uint32_t                                mViewMask = 0;
+
+        std::function<void(VkCommandBuffer, const RenderGraphPassContext&)> mRecord;
+    };
+
+    // declarative frame graph. passes run in declaration order; compile() turns the declarations into
+    // - render passes: consecutive graphics passes merge into subpasses of one render pass unless a pass samples
+    //   or stores an image written earlier in the same render pass; input attachments read it in place
+    // - attachment load/store ops and layouts: results nobody reads later are never stored
+    // - subpass dependencies and the image barriers required between physical passes
+    // - transient images (owned by the graph) whose memory is aliased across non-overlapping lifetimes; layered ones
+    //   get a 2d array view over every layer and a 2d view per layer
+    // imported images (e.g. the swapchain) are owned by the caller; they enter in their initial layout, synchronized
+    // by the caller's semaphore waits at the attachment stages, and leave in their final layout.
+    // the graph is rebuilt, not patched: destroy() and redeclare on resize
+    class RenderGraph final
+    {
+        public:
+            // creation and destruction
+            RenderGraph() noexcept;
+            ~RenderGraph();
+
+            // disable copy and move semantics to enforce unique ownership
+            RenderGraph(const RenderGraph&) = delete;
+            RenderGraph& operator=(const RenderGraph&) = delete;
+            RenderGraph(RenderGraph&&) = delete;
+            RenderGraph& operator=(RenderGraph&&) = delete;
+
+            // usage: declaration
+            RenderGraphHandle importImage(const std::string& name, const RenderGraphImageDesc& desc, const std::vector<VkImage>& images,
+                                          const std::vector<VkImageView>& imageViews, VkImageLayout initialLayout, VkImageLayout finalLayout) noexcept;
+            RenderGraphHandle createImage(const std::string& name, const RenderGraphImageDesc& desc) noexcept;
+            RenderGraphHandle addPass(RenderGraphPassDesc desc) noexcept;
+
+            // usage: build vulkan objects, then record the whole graph once per frame
+            bool compile(const VulkanDevice& device, VkExtent2D extent) noexcept;
+            void execute(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex) const noexcept;
+            void destroy() noexcept;
+
+            // usage: record the physical passes [firstPass, endPass) only, e.g. those before getFirstImportPass() ahead of
+            // the swapchain acquire and the rest once an image is acquired; in order, the ranges record what execute() does
+            void execute(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t frameIndex, uint32_t firstPass, uint32_t endPass) const noexcept;
+
+            // optional per physical pass gpu timing and pipeline statistics, named after the pass's first declared pass
+            void setProfiler(GpuProfiler* profiler) noexcept { m_profiler = profiler; }
+
+            // accessors: render pass and subpass for pipelines and secondary inheritance
+            VkRenderPass getRenderPass(RenderGraphHandle pass) const noexcept;
+            uint32_t getSubpassIndex(RenderGraphHandle pass) const noexcept;
+            VkFramebuffer getFramebuffer(RenderGraphHandle pass, uint32_t imageIndex) const noexcept;
+
+            // accessors: images for views of their own (e.g. a depth-only view for sampling a depth-stencil image), or the
+            // graph's view over every aspect
+            VkImage getImage(RenderGraphHandle image, uint32_t imageIndex = 0) const noexcept;
+            VkImageView getImageView(RenderGraphHandle image, uint32_t imageIndex = 0) const noexcept;
+            VkImageView getLayerView(RenderGraphHandle image, uint32_t layer) const noexcept;     // transient layered images only
+            uint32_t getPhysicalPassCount() const noexcept { return static_cast<uint32_t>(m_physicalPasses.size()); }
+            uint32_t getFirstImportPass() const noexcept { return m_firstImportPass; }     // first physical pass on a multi-image import, or the pass count
+            VkDeviceSize getTransientMemorySize() const noexcept { return m_transientMemorySize; }
+            bool isCompiled() const noexcept { return m_isCompiled; }
+
+        private:
+            // tracked synchronization state of an image between passes
+            struct ImageState
+            {
+                VkImageLayout               mLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                VkPipelineStageFlags        mStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+                VkAccessFlags               mAccess = 0;        // access of the last use
+                bool                        mIsWrite = false;   // last use wrote the image
+            };
+
+            struct Image
+            {
+                std::string                 mName;
+                RenderGraphImageDesc        mDesc;
+                bool                        mIsImported = false;
+                VkImageLayout               mInitialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                VkImageLayout               mFinalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                std::vector<VkImage>        mImages;            // one per import index, or the single transient image
+                std::vector<VkImageView>    mImageViews;
+                std::vector<VkImageView>    mLayerViews;        // per layer of layered transient images
+
+                // derived at compile
+                VkImageUsageFlags           mUsage = 0;
+                uint32_t                    mFirstPass = UINT32_MAX;
+                uint32_t                    mLastPass = 0;
+                uint32_t                    mAliasGroup = UINT32_MAX;
+            };
+
+            struct Pass
+            {
+                RenderGraphPassDesc         mDesc;
+                uint32_t                    mPhysicalPass = 0;
+                uint32_t                    mSubpass = 0;
+            };
+
+            // barrier recorded before a physical pass (image resolved per import index at execute)
+            struct Barrier
+            {
+                RenderGraphHandle           mImage;
+                VkImageLayout               mOldLayout;
+                VkImageLayout               mNewLayout;
+                VkAccessFlags               mSrcAccess;
+                VkAccessFlags               mDstAccess;
+            };
+
+            struct PhysicalPass
+            {
+                std::vector<uint32_t>           mPasses;            // declared passes, one per subpass
+                bool                            mIsGraphics = false;
+
+                // barriers before the pass
+                std::vector<Barrier>            mBarriers;
+                VkPipelineStageFlags            mSrcStages = 0;
+                VkPipelineStageFlags            mDstStages = 0;
+
+                // render pass objects (graphics only)
+                std::vector<RenderGraphHandle>  mAttachments;
+                std::vector<VkClearValue>       mClearValues;
+                VulkanRenderPass                mRenderPass;
+                std::vector<VulkanFramebuffer>  mFramebuffers;      // one per import index of multi-image attachments
+            };
+
+            // memory shared by transient images with disjoint lifetimes
+            struct AliasGroup
+            {
+                VkMemoryRequirements        mRequirements{};
+                VkMemoryPropertyFlags       mPropertyFlags = 0;
+                uint32_t                    mLastPass = 0;
+                VulkanAllocation            mAllocation;
+            };
+
+            void deriveUsage() noexcept;
+            void mergePasses() noexcept;
+            bool createTransientImages(const VulkanDevice& device) noexcept;
+            bool createRenderPass(PhysicalPass& physicalPass, std::vector<ImageState>& states) noexcept;
+            bool createFramebuffers(PhysicalPass& physicalPass) noexcept;
+            void collectBarriers(PhysicalPass& physicalPass, std::vector<ImageState>& states) const noexcept;
+            bool isUsedAfter(RenderGraphHandle image, uint32_t pass) const noexcept;
+            bool isValidImage(RenderGraphHandle image) const noexcept { return image < m_images.size(); }
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VulkanMemoryAllocator*          m_memoryAllocator;
+            VkExtent2D                      m_extent;
+
+            // declarations and compiled state
+            std::vector<Image>              m_images;
+            std::vector<Pass>               m_passes;
+            std::vector<PhysicalPass>       m_physicalPasses;
+            std::vector<AliasGroup>         m_aliasGroups;
+            VkDeviceSize                    m_transientMemorySize;
+            uint32_t                        m_importCount;
+            uint32_t                        m_firstImportPass;
+            bool                            m_isCompiled;
+            GpuProfiler*                    m_profiler;
+    };
+}   // namespace keplar
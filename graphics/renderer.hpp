@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <filesystem>
+#include <string>
+
 #include "platform/event_listener.hpp"
 #include "platform/platform.hpp"
 #include "vulkan/vulkan_context.hpp"
@@ -20,6 +23,40 @@ namespace keplar
             virtual void update(float dt) noexcept = 0;
             virtual bool render() noexcept = 0;
 
+            // startup overlap: device independent work (file reads of shaders, models, textures) run on a worker while
+            // the window, instance and device are created; initialize only starts once it returned
+            virtual void preload() noexcept {}
+
+            // fixed-step simulation: fraction of a step the next rendered frame lies past the last update()
+            virtual void setInterpolation(float /* alpha */) noexcept {}
+
+            // pipelined frames: prepareFrame captures the frame's packet (uniforms, visible draws, overlay) from the
+            // simulation on the calling thread; submitFrame records, submits and presents it and may run on a worker
+            // while update() simulates the next frame. renderers that support it keep render() == prepare + submit
+            virtual bool supportsPipelinedFrames() const noexcept { return false; }
+            virtual bool prepareFrame() noexcept { return true; }
+            virtual bool submitFrame() noexcept { return render(); }
+
+            // present-synced frame pacing: return true after blocking on the display, which replaces the app's clock pacer
+            virtual bool waitForPresent() noexcept { return false; }
+
+            // on-demand rendering: false while the last presented frame is still current (no input, motion, animation or
+            // streaming since), so the app blocks on os events instead of simulating and rendering. asked on the thread
+            // events are dispatched on, between frames; renderers that always animate keep the default
+            virtual bool needsRedraw() const noexcept { return true; }
+
+            // zero allocation checks: false while frames are expected to allocate (loading, resizing, rebuilding
+            // pipelines, streaming), which restarts the warmup of KeplarAppOptions::mAssertZeroAlloc
+            virtual bool isSteadyState() const noexcept { return true; }
+
+            // scripted benchmark of frameCount frames with its frame time summary written to outputPath; false when unsupported
+            virtual bool startBenchmark(uint32_t /* frameCount */, const std::filesystem::path& /* outputPath */) noexcept { return false; }
+            virtual bool isBenchmarkComplete() const noexcept { return false; }
+
+            // live telemetry published to the named shared memory channel (TelemetryChannel) for external readers; false
+            // when unsupported or the channel could not be created
+            virtual bool startTelemetry(const std::string& /* channelName */) noexcept { return false; }
+
             // configure vulkan instance, layers, extensions, features, and queue preferences
             virtual void configureVulkan(VulkanContextConfig& /* config */) noexcept {}
     };
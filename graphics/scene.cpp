@@ -0,0 +1,344 @@
+// ────────────────────────────────────────────
+//  File: scene.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "scene.hpp"
+
+#include <algorithm>
+
+#include "asset_manager.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    Scene::Scene() noexcept
+        : m_vertexFormat(GLTFVertexFormat::kStandard)
+        , m_instanceCount(0)
+        , m_threadPool(nullptr)
+    {
+    }
+
+    Scene::~Scene()
+    {
+        destroy();
+    }
+
+    bool Scene::initialize(const VulkanDevice& device, GLTFVertexFormat vertexFormat, uint32_t vertexCapacity, uint32_t indexCapacity,
+                           ThreadPool* threadPool) noexcept
+    {
+        // one arena for the static geometry of every model
+        destroy();
+        if (!m_geometryArena.initialize(device, GLTFModel::getVertexStride(vertexFormat), vertexCapacity, indexCapacity))
+        {
+            VK_LOG_ERROR("Scene::initialize :: failed to create geometry arena");
+            return false;
+        }
+
+        m_vertexFormat = vertexFormat;
+        m_threadPool = threadPool;
+        VK_LOG_DEBUG("Scene::initialize successful");
+        return true;
+    }
+
+    void Scene::destroy() noexcept
+    {
+        // models release their ranges before the arena goes
+        m_drawList.clear();
+        m_bvh.clear();
+        m_instances.clear();
+        m_freeInstances.clear();
+        m_instanceCount = 0;
+        m_modelLookup.clear();
+        m_models.clear();
+        m_geometryArena.destroy();
+    }
+
+    uint32_t Scene::loadModel(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filename,
+                              const GLTFLoadConfig& config, uint32_t maxInstances) noexcept
+    {
+        // the scene decides the layout and where the geometry goes
+        GLTFLoadConfig modelConfig = config;
+        modelConfig.mVertexFormat = m_vertexFormat;
+        modelConfig.mGeometryArena = m_geometryArena.isValid() ? &m_geometryArena : nullptr;
+        modelConfig.mMaxPlacements = std::max(maxInstances, 1u);
+
+        // an asset already loaded with the same options is shared
+        const std::string key = AssetManager::makeModelKey(filename, modelConfig);
+        const auto found = m_modelLookup.find(key);
+        if (found != m_modelLookup.end())
+        {
+            if (m_models[found->second].mModel->getMaxPlacements() < modelConfig.mMaxPlacements)
+            {
+                VK_LOG_WARN("Scene::loadModel :: %s is shared with its first load's capacity of %u instances", filename.c_str(),
+                            m_models[found->second].mModel->getMaxPlacements());
+            }
+            return found->second;
+        }
+
+        auto model = std::make_unique<GLTFModel>();
+        if (!model->load(device, stagingBelt, filename, modelConfig))
+        {
+            VK_LOG_ERROR("Scene::loadModel :: failed to load model: %s", filename.c_str());
+            return kInvalidIndex;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(m_models.size());
+        ModelEntry& entry = m_models.emplace_back();
+        entry.mModel = std::move(model);
+        entry.mBounds = entry.mModel->getBounds();
+        m_modelLookup.emplace(key, index);
+        VK_LOG_DEBUG("Scene::loadModel :: model %u loaded: %s", index, filename.c_str());
+        return index;
+    }
+
+    uint32_t Scene::addInstance(uint32_t model, const glm::mat4& transform) noexcept
+    {
+        if (model >= m_models.size())
+        {
+            VK_LOG_ERROR("Scene::addInstance :: invalid model index %u", model);
+            return kInvalidIndex;
+        }
+
+        // every instance may be visible at once, so the model's placement capacity bounds them
+        ModelEntry& entry = m_models[model];
+        if (entry.mInstanceCount >= entry.mModel->getMaxPlacements())
+        {
+            VK_LOG_WARN("Scene::addInstance :: model %u already holds its %u instances", model, entry.mModel->getMaxPlacements());
+            return kInvalidIndex;
+        }
+
+        // reuse a removed slot when there is one
+        uint32_t instance = static_cast<uint32_t>(m_instances.size());
+        if (!m_freeInstances.empty())
+        {
+            instance = m_freeInstances.back();
+            m_freeInstances.pop_back();
+        }
+        else
+        {
+            m_instances.emplace_back();
+        }
+
+        m_instances[instance] = { model, transform, BoundingVolumeHierarchy::kInvalidProxy };
+        updateInstanceBounds(instance);
+        ++entry.mInstanceCount;
+        ++m_instanceCount;
+        return instance;
+    }
+
+    void Scene::removeInstance(uint32_t instance) noexcept
+    {
+        if (instance >= m_instances.size() || m_instances[instance].mModel == kInvalidIndex)
+        {
+            return;
+        }
+
+        --m_models[m_instances[instance].mModel].mInstanceCount;
+        --m_instanceCount;
+        m_bvh.remove(m_instances[instance].mProxy);
+        m_instances[instance] = SceneInstance{};
+        m_freeInstances.push_back(instance);
+    }
+
+    void Scene::setInstanceTransform(uint32_t instance, const glm::mat4& transform) noexcept
+    {
+        if (instance < m_instances.size() && m_instances[instance].mModel != kInvalidIndex)
+        {
+            m_instances[instance].mTransform = transform;
+            updateInstanceBounds(instance);
+        }
+    }
+
+    void Scene::updateInstanceBounds(uint32_t instance) noexcept
+    {
+        // models without bounds have no leaf until they get some
+        SceneInstance& sceneInstance = m_instances[instance];
+        const BoundingBox& bounds = m_models[sceneInstance.mModel].mBounds;
+        if (!bounds.isValid())
+        {
+            m_bvh.remove(sceneInstance.mProxy);
+            sceneInstance.mProxy = BoundingVolumeHierarchy::kInvalidProxy;
+            return;
+        }
+
+        const BoundingBox worldBounds = bounds.transformed(sceneInstance.mTransform);
+        if (sceneInstance.mProxy == BoundingVolumeHierarchy::kInvalidProxy)
+        {
+            sceneInstance.mProxy = m_bvh.insert(worldBounds, instance);
+        }
+        else
+        {
+            m_bvh.update(sceneInstance.mProxy, worldBounds);
+        }
+    }
+
+    void Scene::update(float dt) noexcept
+    {
+        // instances share their model's animation state
+        for (auto& entry : m_models)
+        {
+            if (entry.mInstanceCount > 0 && entry.mModel->hasAnimations())
+            {
+                entry.mModel->update(dt);
+            }
+        }
+    }
+
+    const std::vector<SceneDraw>& Scene::buildDrawList(const Frustum* frustum) noexcept
+    {
+        // animated bounds move with their models, and the leaves of their instances with them
+        m_drawList.clear();
+        bool isBoundsChanged = false;
+        for (auto& entry : m_models)
+        {
+            entry.mPlacements.clear();
+            entry.mIsBoundsChanged = false;
+            if (entry.mInstanceCount > 0)
+            {
+                const BoundingBox bounds = entry.mModel->getBounds();
+                entry.mIsBoundsChanged = bounds.mMin != entry.mBounds.mMin || bounds.mMax != entry.mBounds.mMax;
+                entry.mBounds = bounds;
+                isBoundsChanged = isBoundsChanged || entry.mIsBoundsChanged;
+            }
+        }
+
+        if (isBoundsChanged)
+        {
+            for (uint32_t instanceIdx = 0; instanceIdx < m_instances.size(); ++instanceIdx)
+            {
+                const uint32_t model = m_instances[instanceIdx].mModel;
+                if (model != kInvalidIndex && m_models[model].mIsBoundsChanged)
+                {
+                    updateInstanceBounds(instanceIdx);
+                }
+            }
+        }
+
+        // reinsertions leave the tree looser than a fresh build
+        if (m_bvh.isRebuildRecommended())
+        {
+            m_bvh.rebuild(m_threadPool);
+        }
+
+        // cull: an instance is drawn when its model's bounds, placed in the world, touch the frustum
+        m_visibleInstances.clear();
+        if (frustum)
+        {
+            m_bvh.query(*frustum, m_visibleInstances);
+        }
+        else
+        {
+            for (uint32_t instanceIdx = 0; instanceIdx < m_instances.size(); ++instanceIdx)
+            {
+                if (m_instances[instanceIdx].mProxy != BoundingVolumeHierarchy::kInvalidProxy)
+                {
+                    m_visibleInstances.push_back(instanceIdx);
+                }
+            }
+        }
+
+        const glm::vec4 nearPlane = frustum ? frustum->mPlanes[Frustum::kNear] : glm::vec4(0.0f);
+        for (uint32_t instanceIdx : m_visibleInstances)
+        {
+            const SceneInstance& instance = m_instances[instanceIdx];
+            const BoundingBox& worldBounds = m_bvh.getBounds(instance.mProxy);
+            const float depth = glm::dot(glm::vec3(nearPlane), worldBounds.getCenter()) + nearPlane.w;
+            m_drawList.push_back({ instance.mModel, instanceIdx, depth });
+        }
+
+        // batch by model, front to back within each
+        std::sort(m_drawList.begin(), m_drawList.end(), [](const SceneDraw& a, const SceneDraw& b) noexcept
+        {
+            return a.mModel != b.mModel ? a.mModel < b.mModel : a.mDepth < b.mDepth;
+        });
+
+        // each model draws its visible instances as placements
+        for (const auto& draw : m_drawList)
+        {
+            m_models[draw.mModel].mPlacements.push_back(m_instances[draw.mInstance].mTransform);
+        }
+        for (auto& entry : m_models)
+        {
+            entry.mModel->setPlacements(entry.mPlacements.data(), static_cast<uint32_t>(entry.mPlacements.size()));
+        }
+        return m_drawList;
+    }
+
+    void Scene::queryInstances(const Frustum& frustum, std::vector<uint32_t>& instances) const noexcept
+    {
+        m_bvh.query(frustum, instances);
+    }
+
+    void Scene::queryInstances(const BoundingBox& bounds, std::vector<uint32_t>& instances) const noexcept
+    {
+        m_bvh.query(bounds, instances);
+    }
+
+    uint32_t Scene::pickInstance(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float* distance) const noexcept
+    {
+        uint32_t instance = kInvalidIndex;
+        float hitDistance = 0.0f;
+        if (!m_bvh.raycast(origin, direction, maxDistance, instance, hitDistance))
+        {
+            return kInvalidIndex;
+        }
+
+        if (distance != nullptr)
+        {
+            *distance = hitDistance;
+        }
+        return instance;
+    }
+
+    void Scene::render(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, const Frustum* frustum) noexcept
+    {
+        for (auto& entry : m_models)
+        {
+            // models without visible instances would otherwise draw once as loaded
+            if (!entry.mPlacements.empty())
+            {
+                entry.mModel->render(commandBuffer, pipelineLayout, frameIndex, frustum);
+            }
+        }
+    }
+
+    DescriptorRequirements Scene::getDescriptorRequirements() const noexcept
+    {
+        DescriptorRequirements requirements{};
+        for (const auto& entry : m_models)
+        {
+            const DescriptorRequirements model = entry.mModel->getDescriptorRequirements();
+            requirements.mMaxSets                   += model.mMaxSets;
+            requirements.mUniformCount              += model.mUniformCount;
+            requirements.mSamplerCount              += model.mSamplerCount;
+            requirements.mStorageBufferCount        += model.mStorageBufferCount;
+            requirements.mDynamicUniformCount       += model.mDynamicUniformCount;
+            requirements.mDynamicStorageBufferCount += model.mDynamicStorageBufferCount;
+            requirements.mStorageImageCount         += model.mStorageImageCount;
+            requirements.mAccelerationStructureCount += model.mAccelerationStructureCount;
+        }
+        return requirements;
+    }
+
+    bool Scene::allocateDescriptorSets(VulkanDescriptorAllocator& descriptorAllocator) noexcept
+    {
+        for (uint32_t i = 0; i < m_models.size(); ++i)
+        {
+            if (!m_models[i].mModel->allocateDescriptorSets(descriptorAllocator))
+            {
+                VK_LOG_ERROR("Scene::allocateDescriptorSets :: failed to allocate descriptor sets of model %u", i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Scene::updateDescriptorSets(const VulkanSamplers& sampler) noexcept
+    {
+        for (auto& entry : m_models)
+        {
+            entry.mModel->updateDescriptorSets(sampler);
+        }
+    }
+}   // namespace keplar
@@ -0,0 +1,132 @@
+// ────────────────────────────────────────────
+//  File: scene.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "math3d.hpp"
+#include "gltf_model.hpp"
+#include "geometry_arena.hpp"
+#include "bounding_volume_hierarchy.hpp"
+
+namespace keplar
+{
+    // one visible instance of the combined per-frame draw list
+    struct SceneDraw
+    {
+        uint32_t mModel;
+        uint32_t mInstance;
+        float    mDepth;            // of the instance's bounds center along the view, for front-to-back order
+    };
+
+    // many models and their instances in one world. each asset is loaded once (keyed by its canonical path and the
+    // load options that change its data), so instances share its meshes, textures and materials, and every model's
+    // static geometry goes into one GeometryArena. instance world bounds live in a BoundingVolumeHierarchy, kept up to
+    // date as transforms and animated bounds change and rebuilt (on the thread pool given to initialize) once updates
+    // have degraded it. buildDrawList culls instances through it and hands each model its visible instances as
+    // placements; render then records the models in turn, where instances of one asset are culled, sorted and
+    // instanced together. the same tree answers shadow caster, light volume and picking queries. models stay loaded
+    // until destroy
+    class Scene final
+    {
+        public:
+            static constexpr uint32_t kInvalidIndex = ~0u;
+
+            // creation and destruction
+            Scene() noexcept;
+            ~Scene();
+
+            // disable copy and move semantics to enforce unique ownership
+            Scene(const Scene&) = delete;
+            Scene& operator=(const Scene&) = delete;
+            Scene(Scene&&) = delete;
+            Scene& operator=(Scene&&) = delete;
+
+            // usage: every model of the scene is loaded with vertexFormat (models with skins still fall back to the standard
+            // layout, whose geometry then stays in the model's own buffers); capacities are in vertices and uint32 indices
+            bool initialize(const VulkanDevice& device, GLTFVertexFormat vertexFormat, uint32_t vertexCapacity = GeometryArena::kDefaultVertexCapacity,
+                            uint32_t indexCapacity = GeometryArena::kDefaultIndexCapacity, ThreadPool* threadPool = nullptr) noexcept;
+            void destroy() noexcept;
+
+            // usage: returns the model index, or kInvalidIndex when loading fails. an asset already loaded with the same options
+            // is returned as is; maxInstances (the placement capacity, see GLTFModel::setPlacements) applies to the first load.
+            // the scene's vertex format and arena override those of config
+            uint32_t loadModel(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filename,
+                               const GLTFLoadConfig& config = {}, uint32_t maxInstances = 1) noexcept;
+
+            // usage: returns the instance index, or kInvalidIndex when the model holds its maximum instances; indices of
+            // removed instances are reused
+            uint32_t addInstance(uint32_t model, const glm::mat4& transform) noexcept;
+            void removeInstance(uint32_t instance) noexcept;
+            void setInstanceTransform(uint32_t instance, const glm::mat4& transform) noexcept;
+
+            // per frame: advance animations, then build the draw list (frustum in world space, null draws every instance)
+            void update(float dt) noexcept;
+            const std::vector<SceneDraw>& buildDrawList(const Frustum* frustum) noexcept;
+
+            // queries over the instances' world bounds as of the last buildDrawList (or transform change): append the
+            // instances touching a volume (e.g. a light's frustum for shadow casters, a light's bounds for assignment),
+            // or return the nearest whose bounds a ray enters (kInvalidIndex when none; distance in direction's units)
+            void queryInstances(const Frustum& frustum, std::vector<uint32_t>& instances) const noexcept;
+            void queryInstances(const BoundingBox& bounds, std::vector<uint32_t>& instances) const noexcept;
+            uint32_t pickInstance(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = std::numeric_limits<float>::max(),
+                                  float* distance = nullptr) const noexcept;
+
+            // usage: after buildDrawList; records every model with visible instances through its own cpu-recorded path,
+            // with frustum (the draw list's) culling the instances' primitives
+            void render(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, const Frustum* frustum = nullptr) noexcept;
+
+            // descriptor management for every model's material sets
+            DescriptorRequirements getDescriptorRequirements() const noexcept;
+            bool allocateDescriptorSets(VulkanDescriptorAllocator& descriptorAllocator) noexcept;
+            void updateDescriptorSets(const VulkanSamplers& sampler) noexcept;
+
+            // accessors
+            uint32_t getModelCount() const noexcept { return static_cast<uint32_t>(m_models.size()); }
+            GLTFModel& getModel(uint32_t model) noexcept { return *m_models[model].mModel; }
+            const GLTFModel& getModel(uint32_t model) const noexcept { return *m_models[model].mModel; }
+            uint32_t getInstanceCount() const noexcept { return m_instanceCount; }
+            const std::vector<SceneDraw>& getDrawList() const noexcept { return m_drawList; }
+            const GeometryArena& getGeometryArena() const noexcept { return m_geometryArena; }
+            const BoundingVolumeHierarchy& getBoundingVolumeHierarchy() const noexcept { return m_bvh; }
+
+        private:
+            struct ModelEntry
+            {
+                std::unique_ptr<GLTFModel>  mModel;
+                BoundingBox                 mBounds;                // model space, refreshed by buildDrawList
+                uint32_t                    mInstanceCount = 0;
+                std::vector<glm::mat4>      mPlacements;            // per-frame scratch: transforms of the visible instances
+                bool                        mIsBoundsChanged = false;   // by the last buildDrawList
+            };
+
+            struct SceneInstance
+            {
+                uint32_t  mModel = kInvalidIndex;                   // kInvalidIndex while the slot is free
+                glm::mat4 mTransform = glm::mat4(1.0f);
+                uint32_t  mProxy = BoundingVolumeHierarchy::kInvalidProxy;    // none while the model's bounds are empty
+            };
+
+            void updateInstanceBounds(uint32_t instance) noexcept;
+
+        private:
+            GeometryArena                               m_geometryArena;    // outlives the models, which release into it
+            GLTFVertexFormat                            m_vertexFormat;
+            std::vector<ModelEntry>                     m_models;
+            std::unordered_map<std::string, uint32_t>   m_modelLookup;
+            std::vector<SceneInstance>                  m_instances;
+            std::vector<uint32_t>                       m_freeInstances;
+            uint32_t                                    m_instanceCount;
+            std::vector<SceneDraw>                      m_drawList;
+
+            // culling and queries
+            BoundingVolumeHierarchy                     m_bvh;              // instance world bounds, user data the instance
+            ThreadPool*                                 m_threadPool;       // rebuilds, optional
+            std::vector<uint32_t>                       m_visibleInstances; // per-frame scratch
+    };
+}   // namespace keplar
@@ -0,0 +1,410 @@
+// ────────────────────────────────────────────
+//  File: shading_rate_image.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "shading_rate_image.hpp"
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // tile edge the rates are chosen over, clamped into the device's attachment texel size range
+    constexpr uint32_t kPreferredTexelSize = 16;
+
+    // luminance samples per tile axis; larger tiles are sampled with a stride
+    constexpr uint32_t kSamplesPerAxis = 8;
+
+    // must match local_size_x/y of shading_rate.comp
+    constexpr uint32_t kWorkgroupSize = 8;
+
+    // descriptor bindings (set: 0)
+    constexpr uint32_t kSourceBinding = 0;
+    constexpr uint32_t kRateBinding   = 1;
+
+    // push constants: extents and threshold, must match shading_rate.comp
+    struct ShadingRatePushConstants
+    {
+        glm::uvec4 extents;     // xy: rendered region of the source, zw: rate image
+        glm::uvec4 texel;       // xy: pixels per rate texel, zw: sample stride inside the tile
+        glm::vec4  params;      // x: contrast threshold
+    };
+
+    // attachment texel sizes are powers of two
+    uint32_t clampTexelSize(uint32_t size, uint32_t minSize, uint32_t maxSize) noexcept
+    {
+        return std::clamp(size, std::max(minSize, 1u), std::max({ maxSize, minSize, 1u }));
+    }
+}
+
+namespace keplar
+{
+    ShadingRateImage::ShadingRateImage() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSet(VK_NULL_HANDLE)
+        , m_vkImage(VK_NULL_HANDLE)
+        , m_vkImageView(VK_NULL_HANDLE)
+        , m_framebufferExtent{}
+        , m_texelSize{}
+        , m_extent{}
+        , m_isInitialized(false)
+    {
+    }
+
+    ShadingRateImage::~ShadingRateImage()
+    {
+        destroy();
+    }
+
+    bool ShadingRateImage::initialize(const VulkanDevice& device, const ShadingRateImageShaders& shaders, VkExtent2D extent) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_framebufferExtent = extent;
+        if (!device.isShadingRateAttachmentEnabled() || extent.width == 0 || extent.height == 0)
+        {
+            VK_LOG_ERROR("ShadingRateImage::initialize :: attachment shading rates unavailable or invalid extent");
+            destroy();
+            return false;
+        }
+
+        // the framebuffer may be at most one texel larger than the image covers
+        const VkPhysicalDeviceFragmentShadingRatePropertiesKHR& properties = device.getFragmentShadingRateProperties();
+        m_texelSize.width  = clampTexelSize(kPreferredTexelSize, properties.minFragmentShadingRateAttachmentTexelSize.width,
+                                            properties.maxFragmentShadingRateAttachmentTexelSize.width);
+        m_texelSize.height = clampTexelSize(kPreferredTexelSize, properties.minFragmentShadingRateAttachmentTexelSize.height,
+                                            properties.maxFragmentShadingRateAttachmentTexelSize.height);
+        m_extent = { (extent.width + m_texelSize.width - 1) / m_texelSize.width, (extent.height + m_texelSize.height - 1) / m_texelSize.height };
+
+        // unfiltered reads of the source
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = 0.0f;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createImage(device) || !createDescriptorResources(device) || !createPipeline(device, shaders))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("ShadingRateImage::initialize successful (%ux%u texels of %ux%u pixels)", m_extent.width, m_extent.height,
+                     m_texelSize.width, m_texelSize.height);
+        return true;
+    }
+
+    void ShadingRateImage::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // the set is freed with its pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+            m_vkDescriptorSet = VK_NULL_HANDLE;
+        }
+
+        if (m_vkImageView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkImageView, nullptr);
+            m_vkImageView = VK_NULL_HANDLE;
+        }
+
+        if (m_vkImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, m_vkImage, nullptr);
+            m_vkImage = VK_NULL_HANDLE;
+        }
+
+        if (m_memoryAllocator != nullptr)
+        {
+            m_memoryAllocator->free(m_allocation);
+        }
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_framebufferExtent = {};
+        m_texelSize = {};
+        m_extent = {};
+        m_isInitialized = false;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("shading rate image destroyed successfully");
+    }
+
+    void ShadingRateImage::bindSource(VkImageView sourceView) noexcept
+    {
+        if (m_vkDescriptorSet == VK_NULL_HANDLE || sourceView == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        const VkDescriptorImageInfo sourceInfo{ m_vkSampler, sourceView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo rateInfo{ VK_NULL_HANDLE, m_vkImageView, VK_IMAGE_LAYOUT_GENERAL };
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+        for (auto& write : writes)
+        {
+            write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet          = m_vkDescriptorSet;
+            write.descriptorCount = 1;
+        }
+        writes[0].dstBinding     = kSourceBinding;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo     = &sourceInfo;
+        writes[1].dstBinding     = kRateBinding;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo     = &rateInfo;
+        vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void ShadingRateImage::recordPrepare(VkCommandBuffer commandBuffer) noexcept
+    {
+        if (!isValid() || m_isInitialized)
+        {
+            return;
+        }
+
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.pNext                           = nullptr;
+        imageBarrier.srcAccessMask                   = 0;
+        imageBarrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image                           = m_vkImage;
+        imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBarrier.subresourceRange.baseMipLevel   = 0;
+        imageBarrier.subresourceRange.levelCount     = 1;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount     = 1;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+        // zero is 1x1: nothing is coarse until the first frame was measured
+        const VkClearColorValue clearValue{};
+        vkCmdClearColorImage(commandBuffer, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearValue, 1, &imageBarrier.subresourceRange);
+
+        imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageBarrier.dstAccessMask = VK_ACCESS_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR;
+        imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageBarrier.newLayout     = VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR,
+                             0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+        m_isInitialized = true;
+    }
+
+    void ShadingRateImage::record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float threshold) const noexcept
+    {
+        if (!isValid() || !m_isInitialized)
+        {
+            return;
+        }
+
+        // this frame's attachment reads finish before the rates are rewritten
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.pNext                           = nullptr;
+        imageBarrier.srcAccessMask                   = 0;
+        imageBarrier.dstAccessMask                   = VK_ACCESS_SHADER_WRITE_BIT;
+        imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+        imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+        imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image                           = m_vkImage;
+        imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBarrier.subresourceRange.baseMipLevel   = 0;
+        imageBarrier.subresourceRange.levelCount     = 1;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount     = 1;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+        const glm::uvec2 stride(std::max(1u, m_texelSize.width / kSamplesPerAxis), std::max(1u, m_texelSize.height / kSamplesPerAxis));
+        ShadingRatePushConstants pushConstants{};
+        pushConstants.extents = glm::uvec4(std::clamp(renderExtent.width, 1u, m_framebufferExtent.width),
+                                           std::clamp(renderExtent.height, 1u, m_framebufferExtent.height), m_extent.width, m_extent.height);
+        pushConstants.texel   = glm::uvec4(m_texelSize.width, m_texelSize.height, stride);
+        pushConstants.params  = glm::vec4(std::max(threshold, 0.0f), 0.0f, 0.0f, 0.0f);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (m_extent.width + kWorkgroupSize - 1) / kWorkgroupSize, (m_extent.height + kWorkgroupSize - 1) / kWorkgroupSize, 1);
+
+        // the next frame's render passes read the new rates (same queue, so the barrier orders them too)
+        imageBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        imageBarrier.dstAccessMask = VK_ACCESS_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR;
+        imageBarrier.oldLayout     = VK_IMAGE_LAYOUT_GENERAL;
+        imageBarrier.newLayout     = VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+        VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR,
+                             0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+    }
+
+    bool ShadingRateImage::createImage(const VulkanDevice& device) noexcept
+    {
+        if (!device.isFormatSupported(kFormat, VK_FORMAT_FEATURE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT))
+        {
+            VK_LOG_WARN("ShadingRateImage :: %s cannot be a storage and shading rate attachment", string_VkFormat(kFormat));
+            return false;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.pNext         = nullptr;
+        imageInfo.flags         = 0;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = kFormat;
+        imageInfo.extent        = { m_extent.width, m_extent.height, 1 };
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &m_vkImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadingRateImage :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        if (!m_memoryAllocator->allocateImageMemory(m_vkImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_allocation, VulkanMemoryCategory::kAttachment))
+        {
+            VK_LOG_FATAL("ShadingRateImage :: failed to allocate memory for the rate image");
+            return false;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = m_vkImage;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = kFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkImageView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadingRateImage :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    bool ShadingRateImage::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { kSourceBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kRateBinding,   VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        m_vkSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        // private pool for the one set; bindSource only rewrites it
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadingRateImage :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkSetLayout;
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &m_vkDescriptorSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadingRateImage :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    bool ShadingRateImage::createPipeline(const VulkanDevice& device, const ShadingRateImageShaders& shaders) noexcept
+    {
+        // missing spir-v is not fatal; callers keep the per-pipeline rates only
+        VulkanShader generateShader;
+        if (!generateShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mGenerateFile))
+        {
+            VK_LOG_WARN("ShadingRateImage :: compute shader '%s' unavailable", shaders.mGenerateFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = generateShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ShadingRatePushConstants) } };
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("ShadingRateImage :: failed to create pipeline");
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,88 @@
+// ────────────────────────────────────────────
+//  File: shading_rate_image.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the rate generation pass
+    struct ShadingRateImageShaders
+    {
+        std::string mGenerateFile;          // shading_rate.comp
+    };
+
+    // fragment shading rate attachment derived from the luminance of the previous frame (see shading_rate.comp):
+    // tiles whose luminance barely changes along an axis shade at half rate along it, down to 2x2, the coarsest
+    // rate every implementation supports. the image persists across frames and is kept in
+    // VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR between passes; record() synchronizes its own
+    // write against the attachment reads before and after it, so the graph only sees it as an import
+    class ShadingRateImage final
+    {
+        public:
+            static constexpr VkFormat kFormat = VK_FORMAT_R8_UINT;
+
+            // creation and destruction
+            ShadingRateImage() noexcept;
+            ~ShadingRateImage();
+
+            // disable copy and move semantics to enforce unique ownership
+            ShadingRateImage(const ShadingRateImage&) = delete;
+            ShadingRateImage& operator=(const ShadingRateImage&) = delete;
+            ShadingRateImage(ShadingRateImage&&) = delete;
+            ShadingRateImage& operator=(ShadingRateImage&&) = delete;
+
+            // usage: extent is the framebuffer extent the rates apply to; needs attachment shading rates on the device
+            bool initialize(const VulkanDevice& device, const ShadingRateImageShaders& shaders, VkExtent2D extent) noexcept;
+            void destroy() noexcept;
+
+            // usage: the scene color (of the framebuffer extent) the rates follow, sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            void bindSource(VkImageView sourceView) noexcept;
+
+            // usage: outside render passes and before the first pass reading the attachment; full rate the first time
+            void recordPrepare(VkCommandBuffer commandBuffer) noexcept;
+
+            // usage: outside render passes, once the source holds this frame's color; renderExtent is the region it covers
+            void record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float threshold) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && m_vkImage != VK_NULL_HANDLE; }
+            VkImage getImage() const noexcept { return m_vkImage; }
+            VkImageView getImageView() const noexcept { return m_vkImageView; }
+            VkExtent2D getTexelSize() const noexcept { return m_texelSize; }
+            VkExtent2D getExtent() const noexcept { return m_extent; }
+
+        private:
+            bool createImage(const VulkanDevice& device) noexcept;
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipeline(const VulkanDevice& device, const ShadingRateImageShaders& shaders) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                    m_vkDevice;
+            VulkanMemoryAllocator*      m_memoryAllocator;
+            VkSampler                   m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout       m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorPool            m_vkDescriptorPool;
+            VkDescriptorSet             m_vkDescriptorSet;
+            VulkanPipeline              m_pipeline;
+
+            // one texel per m_texelSize framebuffer pixels
+            VkImage                     m_vkImage;
+            VulkanAllocation            m_allocation;
+            VkImageView                 m_vkImageView;
+            VkExtent2D                  m_framebufferExtent;
+            VkExtent2D                  m_texelSize;
+            VkExtent2D                  m_extent;
+            bool                        m_isInitialized;        // cleared and in the attachment layout
+    };
+}   // namespace keplar
@@ -0,0 +1,686 @@
+// ────────────────────────────────────────────
+//  File: shadow_maps.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "shadow_maps.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // sampled and rendered depth formats, in order of preference
+    constexpr VkFormat kDepthFormats[] = { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM };
+
+    // slope-scaled rasterizer bias against acne; the shaders add a normal offset of a texel or so on top
+    constexpr float kDepthBiasConstant = 1.25f;
+    constexpr float kDepthBiasSlope    = 1.75f;
+
+    // near plane of the cube faces
+    constexpr float kCubeNear = 0.05f;
+
+    // cube face orientations matching the cube map face selection: +x, -x, +y, -y, +z, -z
+    const glm::vec3 kCubeTargets[keplar::ShadowMaps::kCubeFaceCount] =
+    {
+        {  1.0f,  0.0f,  0.0f }, { -1.0f,  0.0f,  0.0f }, {  0.0f,  1.0f,  0.0f },
+        {  0.0f, -1.0f,  0.0f }, {  0.0f,  0.0f,  1.0f }, {  0.0f,  0.0f, -1.0f }
+    };
+    const glm::vec3 kCubeUps[keplar::ShadowMaps::kCubeFaceCount] =
+    {
+        {  0.0f, -1.0f,  0.0f }, {  0.0f, -1.0f,  0.0f }, {  0.0f,  0.0f,  1.0f },
+        {  0.0f,  0.0f, -1.0f }, {  0.0f, -1.0f,  0.0f }, {  0.0f, -1.0f,  0.0f }
+    };
+
+    // push constants: caster model matrix (written by GLTFModel::recordShadowCasters), then the view's projection
+    struct ShadowPushConstants
+    {
+        glm::mat4 model;
+        glm::mat4 viewProjection;
+    };
+
+    static_assert(sizeof(ShadowPushConstants) <= 128, "push constants must fit the guaranteed minimum");
+
+    // orthographic light view over the sphere, snapped to whole texels so cached edges keep their place when refit;
+    // depth spans the sphere and every caster between it and the light
+    glm::mat4 fitCascade(const glm::vec3& center, float radius, const glm::vec3& direction, const keplar::BoundingBox& casterBounds,
+                         uint32_t resolution, float& texelSize) noexcept
+    {
+        const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), direction, up);
+
+        texelSize = 2.0f * radius / static_cast<float>(resolution);
+        glm::vec3 lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+        lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+        lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+
+        // the view looks down -z: casters towards the light have larger z
+        const float minZ = lightCenter.z - radius;
+        float maxZ = lightCenter.z + radius;
+        if (casterBounds.isValid())
+        {
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                const glm::vec3 corner((i & 1) ? casterBounds.mMax.x : casterBounds.mMin.x, (i & 2) ? casterBounds.mMax.y : casterBounds.mMin.y,
+                                       (i & 4) ? casterBounds.mMax.z : casterBounds.mMin.z);
+                maxZ = std::max(maxZ, (lightView * glm::vec4(corner, 1.0f)).z);
+            }
+        }
+
+        // y flipped like the camera's, so winding and culling match the main pass
+        glm::mat4 projection = glm::ortho(lightCenter.x - radius, lightCenter.x + radius, lightCenter.y - radius, lightCenter.y + radius, -maxZ, -minZ);
+        projection[1][1] *= -1.0f;
+        return projection * lightView;
+    }
+}
+
+namespace keplar
+{
+    ShadowMaps::ShadowMaps() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_depthFormat(VK_FORMAT_UNDEFINED)
+        , m_vkSampler(VK_NULL_HANDLE)
+    {
+    }
+
+    ShadowMaps::~ShadowMaps()
+    {
+        destroy();
+    }
+
+    bool ShadowMaps::initialize(const VulkanDevice& device, const std::string& vertexSpirvFile, GLTFVertexFormat vertexFormat, uint32_t frameCount,
+                                const ShadowMapsConfig& config) noexcept
+    {
+        destroy();
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_config = config;
+        m_frames.resize(frameCount);
+
+        // depth formats both sampled and rendered
+        for (const VkFormat format : kDepthFormats)
+        {
+            VkFormatProperties properties{};
+            vkGetPhysicalDeviceFormatProperties(device.getPhysicalDevice(), format, &properties);
+            const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+            if ((properties.optimalTilingFeatures & required) == required)
+            {
+                m_depthFormat = format;
+                break;
+            }
+        }
+
+        if (m_depthFormat == VK_FORMAT_UNDEFINED)
+        {
+            VK_LOG_ERROR("ShadowMaps::initialize :: no sampled depth format available");
+            destroy();
+            return false;
+        }
+
+        if (!createRenderPass() || !createSampler(device) || !createMap(m_cascadeMap, config.mCascadeResolution, kCascadeCount, false) ||
+            !createMap(m_cubeMap, config.mPointResolution, kCubeFaceCount, true))
+        {
+            destroy();
+            return false;
+        }
+
+        // the maps outlive missing pipelines: the first frame clears them, and they read as lit
+        if (!createPipelines(device, vertexSpirvFile, vertexFormat))
+        {
+            return false;
+        }
+
+        VK_LOG_DEBUG("ShadowMaps::initialize successful (%u cascades at %u, cube faces at %u)", kCascadeCount, config.mCascadeResolution,
+                     config.mPointResolution);
+        return true;
+    }
+
+    void ShadowMaps::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        for (auto& pipeline : m_pipelines)
+        {
+            pipeline.destroy();
+        }
+        destroyMap(m_cascadeMap);
+        destroyMap(m_cubeMap);
+        m_renderPass.destroy();
+
+        if (m_vkSampler != VK_NULL_HANDLE)
+        {
+            vkDestroySampler(m_vkDevice, m_vkSampler, nullptr);
+            m_vkSampler = VK_NULL_HANDLE;
+        }
+
+        m_views = {};
+        m_frames.clear();
+        m_depthFormat = VK_FORMAT_UNDEFINED;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("shadow maps destroyed successfully");
+    }
+
+    uint32_t ShadowMaps::prepare(uint32_t frameIndex, const ShadowFrameDesc& desc) noexcept
+    {
+        if (frameIndex >= m_frames.size() || !hasImages())
+        {
+            return 0;
+        }
+
+        // views whose fit went stale take new casters; layers never rendered are cleared once so they can be sampled
+        Frame& frame = m_frames[frameIndex];
+        const uint32_t gatherMask = prepareCascades(desc, frame.mParams) | prepareCube(desc, frame.mParams);
+        frame.mRenderMask = gatherMask;
+        for (uint32_t view = 0; view < kViewCount; ++view)
+        {
+            if (!m_views[view].mIsCleared)
+            {
+                m_views[view].mIsCleared = true;
+                frame.mRenderMask |= 1u << view;
+            }
+
+            if (frame.mRenderMask & (1u << view))
+            {
+                frame.mCasters[view].clear();
+                frame.mViewProjections[view] = m_views[view].mViewProjection;
+            }
+        }
+        return gatherMask;
+    }
+
+    void ShadowMaps::record(VkCommandBuffer commandBuffer, uint32_t frameIndex, const GLTFModel& model) const noexcept
+    {
+        if (frameIndex >= m_frames.size() || !hasImages())
+        {
+            return;
+        }
+
+        // one render pass per rendered layer; its dependencies order it after earlier frames' reads and before this frame's
+        const Frame& frame = m_frames[frameIndex];
+        for (uint32_t view = 0; view < kViewCount; ++view)
+        {
+            if (!(frame.mRenderMask & (1u << view)))
+            {
+                continue;
+            }
+
+            const bool isCube = view >= kCascadeCount;
+            const Map& map = isCube ? m_cubeMap : m_cascadeMap;
+            const uint32_t layer = isCube ? view - kCascadeCount : view;
+
+            VkClearValue clearValue{};
+            clearValue.depthStencil = { 1.0f, 0 };
+
+            VkRenderPassBeginInfo beginInfo{};
+            beginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            beginInfo.pNext             = nullptr;
+            beginInfo.renderPass        = m_renderPass.get();
+            beginInfo.framebuffer       = map.mFramebuffers[layer].get();
+            beginInfo.renderArea        = { { 0, 0 }, { map.mResolution, map.mResolution } };
+            beginInfo.clearValueCount   = 1;
+            beginInfo.pClearValues      = &clearValue;
+            vkCmdBeginRenderPass(commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+            const auto& casters = frame.mCasters[view];
+            if (isValid() && !casters.empty())
+            {
+                const uint32_t first = isCube ? 2 : 0;
+                const VkPipelineLayout pipelineLayout = m_pipelines[first].getLayout();
+                vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, offsetof(ShadowPushConstants, viewProjection),
+                                   sizeof(glm::mat4), &frame.mViewProjections[view]);
+                model.recordShadowCasters(commandBuffer, pipelineLayout, casters.data(), static_cast<uint32_t>(casters.size()),
+                                          { m_pipelines[first].get(), m_pipelines[first + 1].get() });
+            }
+
+            vkCmdEndRenderPass(commandBuffer);
+        }
+    }
+
+    void ShadowMaps::invalidate() noexcept
+    {
+        for (auto& view : m_views)
+        {
+            view.mIsValid = false;
+        }
+    }
+
+    uint32_t ShadowMaps::getRenderedViewCount(uint32_t frameIndex) const noexcept
+    {
+        if (frameIndex >= m_frames.size())
+        {
+            return 0;
+        }
+
+        uint32_t count = 0;
+        for (uint32_t mask = m_frames[frameIndex].mRenderMask; mask != 0; mask &= mask - 1)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    uint32_t ShadowMaps::prepareCascades(const ShadowFrameDesc& desc, ShadingParams& params) noexcept
+    {
+        // no directional light: nothing to fit, shading skips the cascades
+        const float directionLength = glm::length(desc.mLightDirection);
+        if (!isValid() || directionLength < 1e-4f || desc.mFar <= desc.mNear)
+        {
+            for (uint32_t cascade = 0; cascade < kCascadeCount; ++cascade)
+            {
+                m_views[cascade].mIsValid = false;
+            }
+            params.mParams.x = 0.0f;
+            return 0;
+        }
+        const glm::vec3 direction = desc.mLightDirection / directionLength;
+
+        // practical split scheme between logarithmic and uniform slices of the shadowed distance
+        const float nearDepth = desc.mNear;
+        const float farDepth = std::min(desc.mFar, std::max(m_config.mShadowDistance, 2.0f * nearDepth));
+        std::array<float, kCascadeCount + 1> splits{};
+        splits[0] = nearDepth;
+        for (uint32_t i = 1; i <= kCascadeCount; ++i)
+        {
+            const float t = static_cast<float>(i) / static_cast<float>(kCascadeCount);
+            const float logarithmic = nearDepth * std::pow(farDepth / nearDepth, t);
+            const float uniform = nearDepth + (farDepth - nearDepth) * t;
+            splits[i] = m_config.mSplitLambda * logarithmic + (1.0f - m_config.mSplitLambda) * uniform;
+        }
+
+        // camera frustum corner rays in world space; view depth is linear along each. built from the projection's
+        // x and y scale at the near and far depths rather than by unprojecting depth 0 and 1, which an infinite
+        // (reverse-z) far plane has no point for
+        const glm::mat4 inverseView = glm::inverse(desc.mView);
+        std::array<glm::vec3, 4> nearCorners{};
+        std::array<glm::vec3, 4> farCorners{};
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const glm::vec2 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f);
+            const glm::vec2 slope(ndc.x / desc.mProjection[0][0], ndc.y / desc.mProjection[1][1]);
+            nearCorners[i] = glm::vec3(inverseView * glm::vec4(slope * desc.mNear, -desc.mNear, 1.0f));
+            farCorners[i] = glm::vec3(inverseView * glm::vec4(slope * desc.mFar, -desc.mFar, 1.0f));
+        }
+
+        const float depthRange = desc.mFar - desc.mNear;
+        const float cosThreshold = std::cos(glm::radians(m_config.mLightAngleThreshold));
+        uint32_t budget = m_config.mMaxCascadeUpdates;
+        uint32_t mask = 0;
+        for (uint32_t cascade = 0; cascade < kCascadeCount; ++cascade)
+        {
+            // bounding sphere of the slice: its size does not change as the camera turns
+            const float t0 = (splits[cascade] - desc.mNear) / depthRange;
+            const float t1 = (splits[cascade + 1] - desc.mNear) / depthRange;
+            std::array<glm::vec3, 8> corners{};
+            glm::vec3 center(0.0f);
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                corners[i] = glm::mix(nearCorners[i], farCorners[i], t0);
+                corners[4 + i] = glm::mix(nearCorners[i], farCorners[i], t1);
+                center += corners[i] + corners[4 + i];
+            }
+            center /= 8.0f;
+
+            float radius = 0.0f;
+            for (const auto& corner : corners)
+            {
+                radius = std::max(radius, glm::length(corner - center));
+            }
+            radius = std::ceil(radius * 16.0f) / 16.0f;
+
+            // the cached fit holds while its padded sphere contains the slice and is not much larger than it
+            View& view = m_views[cascade];
+            const bool isSameLight = view.mIsValid && glm::dot(view.mDirection, direction) >= cosThreshold;
+            const bool isContained = glm::length(center - view.mCenter) + radius <= view.mRadius &&
+                                     view.mRadius <= 2.0f * radius * (1.0f + m_config.mCacheMargin);
+            const bool isForced = !isSameLight || desc.mCastersMoved;
+            if (isForced || (!isContained && budget > 0))
+            {
+                // a new light or moving casters cannot wait; slices that merely moved share the per-frame budget
+                budget -= isForced ? 0 : 1;
+                view.mCenter    = center;
+                view.mRadius    = radius * (1.0f + m_config.mCacheMargin);
+                view.mDirection = direction;
+                view.mViewProjection = fitCascade(center, view.mRadius, direction, desc.mCasterBounds, m_cascadeMap.mResolution, view.mTexelSize);
+                view.mIsValid   = true;
+                mask |= 1u << cascade;
+            }
+
+            params.mCascadeMatrices[cascade] = view.mViewProjection;
+            params.mCascadeSplits[cascade]   = splits[cascade + 1];
+            params.mCascadeTexels[cascade]   = view.mTexelSize;
+        }
+
+        params.mParams.x = static_cast<float>(kCascadeCount);
+        return mask;
+    }
+
+    uint32_t ShadowMaps::prepareCube(const ShadowFrameDesc& desc, ShadingParams& params) noexcept
+    {
+        // no shadowed point light: shading skips the cube
+        const float range = desc.mPointLight.w;
+        if (!isValid() || range <= kCubeNear)
+        {
+            for (uint32_t face = 0; face < kCubeFaceCount; ++face)
+            {
+                m_views[kCascadeCount + face].mIsValid = false;
+            }
+            params.mPointLight = glm::vec4(0.0f);
+            return 0;
+        }
+
+        // the cached faces hold while the light stays within the threshold of where they were rendered from
+        const glm::vec3 position(desc.mPointLight);
+        View& front = m_views[kCascadeCount];
+        const bool isFit = front.mIsValid && !desc.mCastersMoved && glm::length(position - front.mCenter) <= m_config.mPointMoveThreshold &&
+                           std::abs(range - front.mRadius) <= m_config.mPointMoveThreshold;
+        uint32_t mask = 0;
+        if (!isFit)
+        {
+            const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, kCubeNear, range);
+            for (uint32_t face = 0; face < kCubeFaceCount; ++face)
+            {
+                // unflipped: face texels run the way cube map lookups address them
+                View& view = m_views[kCascadeCount + face];
+                view.mCenter  = position;
+                view.mRadius  = range;
+                view.mViewProjection = projection * glm::lookAt(position, position + kCubeTargets[face], kCubeUps[face]);
+                view.mIsValid = true;
+                mask |= 1u << (kCascadeCount + face);
+            }
+        }
+
+        // the shader rebuilds a face's depth from the major axis of the light-to-fragment vector
+        params.mPointLight = glm::vec4(front.mCenter, 1.0f);
+        params.mParams.y = front.mRadius / (front.mRadius - kCubeNear);
+        params.mParams.z = kCubeNear;
+        params.mParams.w = 2.0f / static_cast<float>(m_cubeMap.mResolution);
+        return mask;
+    }
+
+    bool ShadowMaps::createMap(Map& map, uint32_t resolution, uint32_t layers, bool isCube) noexcept
+    {
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.pNext         = nullptr;
+        imageCreateInfo.flags         = isCube ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        imageCreateInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format        = m_depthFormat;
+        imageCreateInfo.extent        = { resolution, resolution, 1 };
+        imageCreateInfo.mipLevels     = 1;
+        imageCreateInfo.arrayLayers   = layers;
+        imageCreateInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage         = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageCreateInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &map.mImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadowMaps :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        if (!m_memoryAllocator->allocateImageMemory(map.mImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, map.mAllocation))
+        {
+            VK_LOG_FATAL("ShadowMaps :: failed to allocate image memory");
+            return false;
+        }
+        map.mResolution = resolution;
+
+        // sampled view over every layer, then one attachment view and framebuffer per layer
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = map.mImage;
+        viewInfo.viewType                        = isCube ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewInfo.format                          = m_depthFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = layers;
+
+        vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &map.mView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadowMaps :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            map.mView = VK_NULL_HANDLE;
+            return false;
+        }
+
+        map.mLayerViews.resize(layers, VK_NULL_HANDLE);
+        map.mFramebuffers.resize(layers);
+        for (uint32_t layer = 0; layer < layers; ++layer)
+        {
+            viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.subresourceRange.baseArrayLayer = layer;
+            viewInfo.subresourceRange.layerCount     = 1;
+            vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &map.mLayerViews[layer]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("ShadowMaps :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                map.mLayerViews[layer] = VK_NULL_HANDLE;
+                return false;
+            }
+
+            VkFramebufferCreateInfo framebufferInfo{};
+            framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.pNext           = nullptr;
+            framebufferInfo.flags           = 0;
+            framebufferInfo.renderPass      = m_renderPass.get();
+            framebufferInfo.attachmentCount = 1;
+            framebufferInfo.pAttachments    = &map.mLayerViews[layer];
+            framebufferInfo.width           = resolution;
+            framebufferInfo.height          = resolution;
+            framebufferInfo.layers          = 1;
+            if (!map.mFramebuffers[layer].initialize(m_vkDevice, framebufferInfo))
+            {
+                VK_LOG_ERROR("ShadowMaps :: failed to create framebuffer for layer %u", layer);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ShadowMaps::destroyMap(Map& map) noexcept
+    {
+        map.mFramebuffers.clear();
+        for (const VkImageView view : map.mLayerViews)
+        {
+            if (view != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, view, nullptr);
+            }
+        }
+        if (map.mView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, map.mView, nullptr);
+        }
+        if (map.mImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, map.mImage, nullptr);
+        }
+        if (map.mAllocation.isValid())
+        {
+            m_memoryAllocator->free(map.mAllocation);
+        }
+        map = Map{};
+    }
+
+    bool ShadowMaps::createRenderPass() noexcept
+    {
+        // every pass clears its layer, so nothing is loaded; the layer leaves ready to be sampled
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.format          = m_depthFormat;
+        depthAttachment.samples         = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp          = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp         = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkAttachmentReference depthReference{};
+        depthReference.attachment = 0;
+        depthReference.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.pDepthStencilAttachment = &depthReference;
+
+        // earlier frames' shading reads before the writes, the writes before this frame's shading reads (fragment shaders,
+        // or the compute pass of deferred shading)
+        std::vector<VkSubpassDependency> dependencies(2);
+        dependencies[0].srcSubpass      = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass      = 0;
+        dependencies[0].srcStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        dependencies[0].dstStageMask    = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[0].srcAccessMask   = 0;
+        dependencies[0].dstAccessMask   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].srcSubpass      = 0;
+        dependencies[1].dstSubpass      = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask    = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[1].dstStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        dependencies[1].srcAccessMask   = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+
+        if (!m_renderPass.initialize(m_vkDevice, { depthAttachment }, { subpass }, dependencies))
+        {
+            VK_LOG_ERROR("ShadowMaps :: failed to create render pass");
+            return false;
+        }
+        return true;
+    }
+
+    bool ShadowMaps::createSampler(const VulkanDevice& device) noexcept
+    {
+        // hardware comparison, bilinear where the format allows it; outside the maps reads as lit
+        VkFormatProperties properties{};
+        vkGetPhysicalDeviceFormatProperties(device.getPhysicalDevice(), m_depthFormat, &properties);
+        const VkFilter filter = (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType            = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.pNext            = nullptr;
+        samplerInfo.magFilter        = filter;
+        samplerInfo.minFilter        = filter;
+        samplerInfo.mipmapMode       = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU     = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        samplerInfo.addressModeV     = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        samplerInfo.addressModeW     = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        samplerInfo.borderColor      = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+        samplerInfo.compareEnable    = VK_TRUE;
+        samplerInfo.compareOp        = VK_COMPARE_OP_LESS_OR_EQUAL;
+        samplerInfo.minLod           = 0.0f;
+        samplerInfo.maxLod           = 0.0f;
+        samplerInfo.maxAnisotropy    = 1.0f;
+
+        VkResult vkResult = vkCreateSampler(m_vkDevice, &samplerInfo, nullptr, &m_vkSampler);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("ShadowMaps :: vkCreateSampler failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkSampler = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    bool ShadowMaps::createPipelines(const VulkanDevice& device, const std::string& vertexSpirvFile, GLTFVertexFormat vertexFormat) noexcept
+    {
+        // missing spir-v is not fatal; the maps stay cleared and shading reads them as lit
+        VulkanShader vertexShader;
+        if (!vertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, vertexSpirvFile))
+        {
+            VK_LOG_WARN("ShadowMaps :: shader '%s' unavailable, shadows disabled", vertexSpirvFile.c_str());
+            return false;
+        }
+
+        // the position stream of the depth pre-pass
+        const VkPipelineVertexInputStateCreateInfo vertexInputState = GLTFModel::getDepthVertexInputState(vertexFormat);
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        rasterizationState.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizationState.polygonMode             = VK_POLYGON_MODE_FILL;
+        rasterizationState.depthBiasEnable         = VK_TRUE;
+        rasterizationState.depthBiasConstantFactor = kDepthBiasConstant;
+        rasterizationState.depthBiasSlopeFactor    = kDepthBiasSlope;
+        rasterizationState.lineWidth               = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        multisampleState.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencilState{};
+        depthStencilState.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencilState.depthTestEnable  = VK_TRUE;
+        depthStencilState.depthWriteEnable = VK_TRUE;
+        depthStencilState.depthCompareOp   = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+        colorBlendState.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlendState.attachmentCount = 0;
+        colorBlendState.pAttachments    = nullptr;
+
+        GraphicsPipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStages        = { vertexShader.getShaderStageInfo() };
+        pipelineConfig.mVertexInputState    = vertexInputState;
+        pipelineConfig.mInputAssemblyState  = inputAssembly;
+        pipelineConfig.mMultisampleState    = multisampleState;
+        pipelineConfig.mDepthStencilState   = depthStencilState;
+        pipelineConfig.mColorBlendState     = colorBlendState;
+        pipelineConfig.mRenderPass          = m_renderPass.get();
+        pipelineConfig.mSubpassIndex        = 0;
+        pipelineConfig.mPushConstantRanges  = { { VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConstants) } };
+
+        // cascades render y-flipped like the camera, cube faces unflipped, so their front faces wind the other way;
+        // each gets a single-sided (back faces culled) and a double-sided variant
+        const std::array<const Map*, 2> maps = { &m_cascadeMap, &m_cubeMap };
+        const std::array<VkFrontFace, 2> frontFaces = { VK_FRONT_FACE_COUNTER_CLOCKWISE, VK_FRONT_FACE_CLOCKWISE };
+        const std::array<VkCullModeFlags, 2> cullModes = { VK_CULL_MODE_BACK_BIT, VK_CULL_MODE_NONE };
+        for (uint32_t i = 0; i < m_pipelines.size(); ++i)
+        {
+            // the whole layer, fixed per map
+            const float resolution = static_cast<float>(maps[i / 2]->mResolution);
+            const VkViewport viewport{ 0.0f, 0.0f, resolution, resolution, 0.0f, 1.0f };
+            const VkRect2D scissor{ { 0, 0 }, { maps[i / 2]->mResolution, maps[i / 2]->mResolution } };
+            VkPipelineViewportStateCreateInfo viewportState{};
+            viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+            viewportState.viewportCount = 1;
+            viewportState.pViewports    = &viewport;
+            viewportState.scissorCount  = 1;
+            viewportState.pScissors     = &scissor;
+
+            pipelineConfig.mViewportState                = viewportState;
+            pipelineConfig.mRasterizationState           = rasterizationState;
+            pipelineConfig.mRasterizationState.frontFace = frontFaces[i / 2];
+            pipelineConfig.mRasterizationState.cullMode  = cullModes[i % 2];
+            if (!m_pipelines[i].initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+            {
+                VK_LOG_ERROR("ShadowMaps :: failed to create pipeline %u", i);
+                for (auto& pipeline : m_pipelines)
+                {
+                    pipeline.destroy();
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+}   // namespace keplar
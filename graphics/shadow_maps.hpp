@@ -0,0 +1,170 @@
+// ────────────────────────────────────────────
+//  File: shadow_maps.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "math3d.hpp"
+#include "gltf_model.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+#include "vulkan/vulkan_render_pass.hpp"
+#include "vulkan/vulkan_framebuffer.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // shadow map sizes and cache thresholds
+    struct ShadowMapsConfig
+    {
+        uint32_t mCascadeResolution     = 2048;
+        uint32_t mPointResolution       = 512;      // per cube face
+        float    mShadowDistance        = 50.0f;    // view depth the cascades cover, clamped to the camera's far plane
+        float    mSplitLambda           = 0.75f;    // logarithmic (1) to uniform (0) cascade splits
+        float    mCacheMargin           = 0.25f;    // cascade radius padding the camera moves through before a re-render
+        float    mLightAngleThreshold   = 0.5f;     // degrees the directional light turns before its cascades re-render
+        float    mPointMoveThreshold    = 0.05f;    // world units the point light moves before its cube re-renders
+        uint32_t mMaxCascadeUpdates     = 2;        // cached cascades re-rendered per frame, nearest first; the rest wait
+    };
+
+    // what a frame's shadow views are fit to, in world space
+    struct ShadowFrameDesc
+    {
+        glm::mat4   mView = glm::mat4(1.0f);
+        glm::mat4   mProjection = glm::mat4(1.0f);          // perspective; only its x and y scale are read
+        float       mNear = 0.1f;
+        float       mFar = 100.0f;
+        glm::vec3   mLightDirection = glm::vec3(0.0f);      // direction the directional light travels, zero: no cascades
+        glm::vec4   mPointLight = glm::vec4(0.0f);          // xyz: position of the shadowed point light, w: range (0: no cube)
+        BoundingBox mCasterBounds;                          // every caster; bounds the cascades' depth range
+        bool        mCastersMoved = false;                  // animated casters: no view stays cached
+    };
+
+    // cascaded shadow maps for one directional light and a cube map for one point light, rendered depth-only from the
+    // position stream. views are cached across frames: a cascade is fit to a padded sphere around its slice of the camera
+    // frustum, snapped to its texel grid, and re-rendered only once the slice leaves that sphere, the light turns past
+    // mLightAngleThreshold or casters move; the cube likewise once its light moves past mPointMoveThreshold. re-rendered
+    // views draw the casters the caller gathered against their frustums (GLTFModel::gatherShadowCasters), so culling
+    // runs only for the views that changed. one set of maps serves every frame in flight: frames render them in queue
+    // order and each frame's shading parameters describe the maps as its own pass leaves them
+    class ShadowMaps final
+    {
+        public:
+            static constexpr uint32_t kCascadeCount     = 4;
+            static constexpr uint32_t kCubeFaceCount    = 6;
+            static constexpr uint32_t kViewCount        = kCascadeCount + kCubeFaceCount;   // cascades, then cube faces
+
+            // a frame's shadow lookup parameters, mirrored by the light block of the pbr fragment shaders
+            struct ShadingParams
+            {
+                std::array<glm::mat4, kCascadeCount> mCascadeMatrices{};    // world to cascade clip space
+                glm::vec4 mCascadeSplits  = glm::vec4(0.0f);    // view depth each cascade ends at
+                glm::vec4 mCascadeTexels  = glm::vec4(0.0f);    // world size of one texel of each cascade
+                glm::vec4 mPointLight     = glm::vec4(0.0f);    // xyz: position the cube was rendered from, w: 1 when shadowed
+                glm::vec4 mParams         = glm::vec4(0.0f);    // x: cascades in use (0: none), y: cube depth scale far / (far - near),
+                                                                // z: cube near plane, w: cube texel size at unit distance
+            };
+
+            // creation and destruction
+            ShadowMaps() noexcept;
+            ~ShadowMaps();
+
+            // disable copy and move semantics to enforce unique ownership
+            ShadowMaps(const ShadowMaps&) = delete;
+            ShadowMaps& operator=(const ShadowMaps&) = delete;
+            ShadowMaps(ShadowMaps&&) = delete;
+            ShadowMaps& operator=(ShadowMaps&&) = delete;
+
+            // false without the caster pipelines; hasImages() then still holds maps cleared to lit that can stay bound
+            bool initialize(const VulkanDevice& device, const std::string& vertexSpirvFile, GLTFVertexFormat vertexFormat, uint32_t frameCount,
+                            const ShadowMapsConfig& config = {}) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame once its slot is free, returns the mask of views to gather casters for (into getCasters,
+            // against getViewFrustum); views outside it are not rendered by the frame
+            uint32_t prepare(uint32_t frameIndex, const ShadowFrameDesc& desc) noexcept;
+            Frustum getViewFrustum(uint32_t view) const noexcept { return Frustum::fromMatrix(m_views[view].mViewProjection); }
+            std::vector<ShadowCasterDraw>& getCasters(uint32_t frameIndex, uint32_t view) noexcept { return m_frames[frameIndex].mCasters[view]; }
+
+            // usage: record outside a render pass before the passes sampling the maps; only reads the model's buffers
+            void record(VkCommandBuffer commandBuffer, uint32_t frameIndex, const GLTFModel& model) const noexcept;
+
+            // the next prepare re-renders every view
+            void invalidate() noexcept;
+
+            // accessors
+            bool isValid() const noexcept                                           { return m_pipelines[0].isValid() && m_pipelines[2].isValid(); }
+            bool hasImages() const noexcept                                         { return m_cascadeMap.mView != VK_NULL_HANDLE && m_cubeMap.mView != VK_NULL_HANDLE; }
+            const ShadingParams& getShadingParams(uint32_t frameIndex) const noexcept { return m_frames[frameIndex].mParams; }
+            uint32_t getRenderedViewCount(uint32_t frameIndex) const noexcept;
+            VkImageView getCascadeView() const noexcept                             { return m_cascadeMap.mView; }
+            VkImageView getCubeView() const noexcept                                { return m_cubeMap.mView; }
+            VkSampler getSampler() const noexcept                                   { return m_vkSampler; }
+            const ShadowMapsConfig& getConfig() const noexcept                      { return m_config; }
+
+        private:
+            // depth array with its sampled view over every layer and one attachment view per layer
+            struct Map
+            {
+                VkImage                         mImage = VK_NULL_HANDLE;
+                VkImageView                     mView = VK_NULL_HANDLE;
+                std::vector<VkImageView>        mLayerViews;
+                std::vector<VulkanFramebuffer>  mFramebuffers;
+                VulkanAllocation                mAllocation;
+                uint32_t                        mResolution = 0;
+            };
+
+            // cached state of one view, valid until its light or fit goes stale
+            struct View
+            {
+                glm::mat4   mViewProjection = glm::mat4(1.0f);
+                glm::vec3   mCenter = glm::vec3(0.0f);          // cascades: slice sphere center, cube: light position
+                float       mRadius = 0.0f;                     // cascades: padded sphere radius, cube: light range
+                glm::vec3   mDirection = glm::vec3(0.0f);       // cascades: light direction fit to
+                float       mTexelSize = 0.0f;                  // cascades: world size of one texel
+                bool        mIsValid = false;                   // rendered at least once with the current light
+                bool        mIsCleared = false;                 // the image layer has left its undefined layout
+            };
+
+            struct Frame
+            {
+                ShadingParams                                       mParams;
+                uint32_t                                            mRenderMask = 0;
+                std::array<glm::mat4, kViewCount>                   mViewProjections{};
+                std::array<std::vector<ShadowCasterDraw>, kViewCount> mCasters;
+            };
+
+            bool createMap(Map& map, uint32_t resolution, uint32_t layers, bool isCube) noexcept;
+            void destroyMap(Map& map) noexcept;
+            bool createRenderPass() noexcept;
+            bool createSampler(const VulkanDevice& device) noexcept;
+            bool createPipelines(const VulkanDevice& device, const std::string& vertexSpirvFile, GLTFVertexFormat vertexFormat) noexcept;
+            uint32_t prepareCascades(const ShadowFrameDesc& desc, ShadingParams& params) noexcept;
+            uint32_t prepareCube(const ShadowFrameDesc& desc, ShadingParams& params) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VulkanMemoryAllocator*          m_memoryAllocator;
+            VkFormat                        m_depthFormat;
+            VkSampler                       m_vkSampler;
+            VulkanRenderPass                m_renderPass;
+            std::array<VulkanPipeline, 4>   m_pipelines;        // cascades single and double-sided, cube faces single and double-sided
+
+            // maps and their cached views, shared by every frame
+            ShadowMapsConfig                m_config;
+            Map                             m_cascadeMap;
+            Map                             m_cubeMap;
+            std::array<View, kViewCount>    m_views;
+
+            // per frame in flight: the views its pass renders, their casters and the resulting shading parameters
+            std::vector<Frame>              m_frames;
+    };
+}   // namespace keplar
@@ -0,0 +1,526 @@
+// ────────────────────────────────────────────
+//  File: sparse_texture.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "sparse_texture.hpp"
+
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    SparsePageCache::SparsePageCache() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkQueue(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_chunkRequirements{}
+        , m_pageSize(0)
+        , m_maxPages(0)
+        , m_usedPages(0)
+    {
+    }
+
+    SparsePageCache::~SparsePageCache()
+    {
+        destroy();
+    }
+
+    bool SparsePageCache::initialize(const VulkanDevice& device, const VkMemoryRequirements& pageRequirements, VkDeviceSize capacity) noexcept
+    {
+        destroy();
+        if (pageRequirements.alignment == 0 || pageRequirements.memoryTypeBits == 0)
+        {
+            VK_LOG_ERROR("SparsePageCache::initialize :: invalid sparse block requirements");
+            return false;
+        }
+
+        VkFenceCreateInfo fenceCreateInfo{};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCreateInfo.pNext = nullptr;
+        fenceCreateInfo.flags = 0;
+        if (!m_fence.initialize(device.getDevice(), fenceCreateInfo))
+        {
+            return false;
+        }
+
+        m_vkDevice        = device.getDevice();
+        m_vkQueue         = device.getGraphicsQueue();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_pageSize        = pageRequirements.alignment;
+        m_maxPages        = static_cast<uint32_t>(std::max<VkDeviceSize>(capacity / m_pageSize, kPagesPerChunk) / kPagesPerChunk * kPagesPerChunk);
+
+        // a chunk is a whole number of pages aligned to one; the first one settles the memory type
+        m_chunkRequirements                = pageRequirements;
+        m_chunkRequirements.size           = m_pageSize * kPagesPerChunk;
+        m_chunkRequirements.alignment      = m_pageSize;
+        if (!allocateChunk())
+        {
+            destroy();
+            return false;
+        }
+        m_chunkRequirements.memoryTypeBits = 1u << m_chunks.front().mMemoryTypeIndex;
+
+        VK_LOG_DEBUG("SparsePageCache::initialize successful (%u pages of %llu KiB)", m_maxPages,
+                     static_cast<unsigned long long>(m_pageSize / 1024));
+        return true;
+    }
+
+    void SparsePageCache::destroy() noexcept
+    {
+        // every texture bound from the cache is gone by now; the caller idles the device before this
+        for (VulkanAllocation& chunk : m_chunks)
+        {
+            m_memoryAllocator->free(chunk);
+        }
+        m_chunks.clear();
+        m_freePages.clear();
+        m_fence.destroy();
+
+        m_chunkRequirements = {};
+        m_pageSize = 0;
+        m_maxPages = 0;
+        m_usedPages = 0;
+        m_memoryAllocator = nullptr;
+        m_vkQueue = VK_NULL_HANDLE;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    bool SparsePageCache::allocate(uint32_t count, std::vector<SparsePage>& pages) noexcept
+    {
+        if (!isValid() || count > getFreePageCount())
+        {
+            return false;
+        }
+
+        // chunks are only added while the free list runs short, never past the capacity
+        while (m_freePages.size() < count)
+        {
+            if (!allocateChunk())
+            {
+                return false;
+            }
+        }
+
+        pages.insert(pages.end(), m_freePages.end() - count, m_freePages.end());
+        m_freePages.resize(m_freePages.size() - count);
+        m_usedPages += count;
+        return true;
+    }
+
+    void SparsePageCache::free(std::vector<SparsePage>& pages) noexcept
+    {
+        m_freePages.insert(m_freePages.end(), pages.begin(), pages.end());
+        m_usedPages -= std::min(m_usedPages, static_cast<uint32_t>(pages.size()));
+        pages.clear();
+    }
+
+    bool SparsePageCache::bind(const VkSparseImageMemoryBindInfo* imageBinds, const VkSparseImageOpaqueMemoryBindInfo* opaqueBinds, bool wait) noexcept
+    {
+        VkBindSparseInfo bindSparseInfo{};
+        bindSparseInfo.sType                = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        bindSparseInfo.pNext                = nullptr;
+        bindSparseInfo.imageBindCount       = imageBinds && imageBinds->bindCount > 0 ? 1 : 0;
+        bindSparseInfo.pImageBinds          = imageBinds;
+        bindSparseInfo.imageOpaqueBindCount = opaqueBinds && opaqueBinds->bindCount > 0 ? 1 : 0;
+        bindSparseInfo.pImageOpaqueBinds    = opaqueBinds;
+        if (bindSparseInfo.imageBindCount == 0 && bindSparseInfo.imageOpaqueBindCount == 0)
+        {
+            return true;
+        }
+
+        VkResult vkResult = vkQueueBindSparse(m_vkQueue, 1, &bindSparseInfo, wait ? m_fence.get() : VK_NULL_HANDLE);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("SparsePageCache :: vkQueueBindSparse failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // binds are short; waiting keeps the staging belt's copy queue free of cross-queue semaphores
+        return !wait || (m_fence.wait() && m_fence.reset());
+    }
+
+    bool SparsePageCache::isCompatible(const VkMemoryRequirements& requirements) const noexcept
+    {
+        return isValid() && requirements.alignment == m_pageSize && (requirements.memoryTypeBits & m_chunkRequirements.memoryTypeBits) != 0;
+    }
+
+    bool SparsePageCache::allocateChunk() noexcept
+    {
+        VulkanAllocation chunk{};
+        if (!m_memoryAllocator->allocateImageMemory(m_chunkRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, chunk))
+        {
+            VK_LOG_ERROR("SparsePageCache :: failed to allocate %u pages", kPagesPerChunk);
+            return false;
+        }
+
+        for (uint32_t page = 0; page < kPagesPerChunk; ++page)
+        {
+            m_freePages.push_back({ chunk.mMemory, chunk.mOffset + page * m_pageSize });
+        }
+        m_chunks.push_back(chunk);
+        return true;
+    }
+
+    SparseTexture::SparseTexture() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkImage(VK_NULL_HANDLE)
+        , m_vkImageView(VK_NULL_HANDLE)
+        , m_pageCache(nullptr)
+        , m_format(VK_FORMAT_UNDEFINED)
+        , m_channels(0)
+        , m_mipLevels(0)
+        , m_memoryRequirements{}
+        , m_sparseRequirements{}
+        , m_baseLevel(0)
+        , m_committedLevel(0)
+    {
+    }
+
+    SparseTexture::~SparseTexture()
+    {
+        destroy();
+    }
+
+    bool SparseTexture::initialize(const VulkanDevice& device, const TextureData& textureData, const VkFormat& format) noexcept
+    {
+        destroy();
+        if (textureData.mPixels.empty() || textureData.mMipExtents.empty() || textureData.mMipExtents.size() != textureData.mMipOffsets.size())
+        {
+            VK_LOG_ERROR("SparseTexture::initialize :: texture data is empty or has an invalid mip chain: %s", textureData.mName.c_str());
+            return false;
+        }
+
+        m_vkDevice       = device.getDevice();
+        m_format         = Texture::getUploadFormat(textureData, format);
+        m_levelExtents   = textureData.mMipExtents;
+        m_channels       = textureData.mChannels;
+        m_mipLevels      = static_cast<uint32_t>(textureData.mMipExtents.size());
+        m_baseLevel      = m_mipLevels;
+        m_committedLevel = m_mipLevels;
+
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.pNext         = nullptr;
+        imageCreateInfo.flags         = VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+        imageCreateInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format        = m_format;
+        imageCreateInfo.extent        = { m_levelExtents[0].width, m_levelExtents[0].height, 1 };
+        imageCreateInfo.mipLevels     = m_mipLevels;
+        imageCreateInfo.arrayLayers   = 1;
+        imageCreateInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage         = kUsage;
+        imageCreateInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &m_vkImage);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("SparseTexture :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkImage = VK_NULL_HANDLE;
+            destroy();
+            return false;
+        }
+
+        // the color aspect's block shape and mip tail; images whose every level sits in the tail gain nothing from sparse
+        vkGetImageMemoryRequirements(m_vkDevice, m_vkImage, &m_memoryRequirements);
+        uint32_t requirementCount = 0;
+        vkGetImageSparseMemoryRequirements(m_vkDevice, m_vkImage, &requirementCount, nullptr);
+        std::vector<VkSparseImageMemoryRequirements> sparseRequirements(requirementCount);
+        vkGetImageSparseMemoryRequirements(m_vkDevice, m_vkImage, &requirementCount, sparseRequirements.data());
+
+        auto colorRequirements = std::find_if(sparseRequirements.begin(), sparseRequirements.end(), [](const VkSparseImageMemoryRequirements& requirements)
+        {
+            return (requirements.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) != 0;
+        });
+        if (colorRequirements == sparseRequirements.end() || colorRequirements->imageMipTailFirstLod == 0)
+        {
+            destroy();
+            return false;
+        }
+
+        m_sparseRequirements = *colorRequirements;
+        m_levelPages.assign(std::min(m_sparseRequirements.imageMipTailFirstLod, m_mipLevels), {});
+        return true;
+    }
+
+    void SparseTexture::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // destroying the image drops its binds; the pages go back to the cache as they are
+        if (m_vkImageView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkImageView, nullptr);
+            m_vkImageView = VK_NULL_HANDLE;
+        }
+        if (m_vkImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, m_vkImage, nullptr);
+            m_vkImage = VK_NULL_HANDLE;
+        }
+        if (m_pageCache)
+        {
+            for (std::vector<SparsePage>& pages : m_levelPages)
+            {
+                m_pageCache->free(pages);
+            }
+            m_pageCache->free(m_tailPages);
+        }
+        m_levelPages.clear();
+        m_tailPages.clear();
+        m_levelExtents.clear();
+
+        m_pageCache = nullptr;
+        m_format = VK_FORMAT_UNDEFINED;
+        m_channels = 0;
+        m_mipLevels = 0;
+        m_memoryRequirements = {};
+        m_sparseRequirements = {};
+        m_baseLevel = 0;
+        m_committedLevel = 0;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    bool SparseTexture::commit(SparsePageCache& pageCache, uint32_t firstLevel) noexcept
+    {
+        if (!isValid() || (m_pageCache && m_pageCache != &pageCache) || !pageCache.isCompatible(m_memoryRequirements))
+        {
+            return false;
+        }
+        firstLevel = std::min(firstLevel, m_mipLevels - 1);
+        if (firstLevel >= m_committedLevel)
+        {
+            return true;
+        }
+
+        // pages for every newly bound block, and the tail on the first commit
+        const bool isTailBound = !m_tailPages.empty();
+        const uint32_t tailPageCount = static_cast<uint32_t>((m_sparseRequirements.imageMipTailSize + pageCache.getPageSize() - 1) / pageCache.getPageSize());
+        const uint32_t tailFirstLevel = static_cast<uint32_t>(m_levelPages.size());
+        uint32_t pageCount = isTailBound ? 0 : tailPageCount;
+        for (uint32_t level = firstLevel; level < std::min(m_committedLevel, tailFirstLevel); ++level)
+        {
+            pageCount += getLevelPageCount(level);
+        }
+
+        std::vector<SparsePage> pages;
+        if (!pageCache.allocate(pageCount, pages))
+        {
+            return false;
+        }
+        m_pageCache = &pageCache;
+
+        std::vector<VkSparseMemoryBind> opaqueBinds;
+        size_t nextPage = 0;
+        if (!isTailBound)
+        {
+            for (uint32_t page = 0; page < tailPageCount; ++page, ++nextPage)
+            {
+                VkSparseMemoryBind bind{};
+                bind.resourceOffset = m_sparseRequirements.imageMipTailOffset + page * pageCache.getPageSize();
+                bind.size           = pageCache.getPageSize();
+                bind.memory         = pages[nextPage].mMemory;
+                bind.memoryOffset   = pages[nextPage].mOffset;
+                bind.flags          = 0;
+                opaqueBinds.push_back(bind);
+                m_tailPages.push_back(pages[nextPage]);
+            }
+        }
+
+        std::vector<VkSparseImageMemoryBind> imageBinds;
+        for (uint32_t level = firstLevel; level < std::min(m_committedLevel, tailFirstLevel); ++level)
+        {
+            const uint32_t levelPageCount = getLevelPageCount(level);
+            m_levelPages[level].assign(pages.begin() + nextPage, pages.begin() + nextPage + levelPageCount);
+            bindLevel(level, m_levelPages[level], imageBinds);
+            nextPage += levelPageCount;
+        }
+
+        const VkSparseImageMemoryBindInfo imageBindInfo{ m_vkImage, static_cast<uint32_t>(imageBinds.size()), imageBinds.data() };
+        const VkSparseImageOpaqueMemoryBindInfo opaqueBindInfo{ m_vkImage, static_cast<uint32_t>(opaqueBinds.size()), opaqueBinds.data() };
+        if (!pageCache.bind(&imageBindInfo, &opaqueBindInfo, true))
+        {
+            return false;
+        }
+        m_committedLevel = firstLevel;
+        return true;
+    }
+
+    void SparseTexture::release(uint32_t firstLevel) noexcept
+    {
+        if (!isValid() || !m_pageCache)
+        {
+            return;
+        }
+
+        // the tail is never released; unbound blocks read as undefined, but no view covers them
+        const uint32_t endLevel = std::min(firstLevel, static_cast<uint32_t>(m_levelPages.size()));
+        std::vector<VkSparseImageMemoryBind> imageBinds;
+        for (uint32_t level = m_committedLevel; level < endLevel; ++level)
+        {
+            const std::vector<SparsePage> unbound(m_levelPages[level].size());
+            bindLevel(level, unbound, imageBinds);
+        }
+
+        const VkSparseImageMemoryBindInfo imageBindInfo{ m_vkImage, static_cast<uint32_t>(imageBinds.size()), imageBinds.data() };
+        if (!m_pageCache->bind(&imageBindInfo, nullptr, false))
+        {
+            return;
+        }
+
+        // later binds of the pages are queued after this one
+        for (uint32_t level = m_committedLevel; level < endLevel; ++level)
+        {
+            m_pageCache->free(m_levelPages[level]);
+        }
+        m_committedLevel = std::max(m_committedLevel, endLevel);
+    }
+
+    bool SparseTexture::upload(VulkanStagingBelt& stagingBelt, const TextureData& textureData, uint32_t firstLevel, uint32_t endLevel) noexcept
+    {
+        endLevel = std::min(endLevel, m_mipLevels);
+        if (!isValid() || firstLevel >= endLevel || firstLevel < m_committedLevel || textureData.mMipOffsets.size() != m_mipLevels)
+        {
+            return false;
+        }
+
+        // levels are packed in order, so the range is one contiguous span of the chain
+        const VkDeviceSize beginOffset = textureData.mMipOffsets[firstLevel];
+        const VkDeviceSize endOffset = endLevel < m_mipLevels ? textureData.mMipOffsets[endLevel] : textureData.mPixels.size();
+        VkBuffer vkBufferStaging = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        if (!stagingBelt.stage(textureData.mPixels.data() + beginOffset, endOffset - beginOffset, Texture::getStagingAlignment(m_format, m_channels),
+                               vkBufferStaging, stagingOffset))
+        {
+            VK_LOG_ERROR("SparseTexture::upload :: failed to stage levels %u-%u: %s", firstLevel, endLevel - 1, textureData.mName.c_str());
+            return false;
+        }
+
+        VkImageSubresourceRange subresourceRange{};
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = firstLevel;
+        subresourceRange.levelCount     = endLevel - firstLevel;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = 1;
+
+        std::vector<VkBufferImageCopy> bufferImageCopies(endLevel - firstLevel);
+        for (uint32_t level = firstLevel; level < endLevel; ++level)
+        {
+            VkBufferImageCopy& bufferImageCopy = bufferImageCopies[level - firstLevel];
+            bufferImageCopy.bufferOffset = stagingOffset + textureData.mMipOffsets[level] - beginOffset;
+            bufferImageCopy.bufferRowLength = 0;
+            bufferImageCopy.bufferImageHeight = 0;
+            bufferImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            bufferImageCopy.imageSubresource.mipLevel = level;
+            bufferImageCopy.imageSubresource.baseArrayLayer = 0;
+            bufferImageCopy.imageSubresource.layerCount = 1;
+            bufferImageCopy.imageOffset = { 0, 0, 0 };
+            bufferImageCopy.imageExtent = { m_levelExtents[level].width, m_levelExtents[level].height, 1 };
+        }
+
+        // resident levels are not in the range, so the views sampling them are undisturbed
+        if (!stagingBelt.copyToImage(vkBufferStaging, m_vkImage, subresourceRange, static_cast<uint32_t>(bufferImageCopies.size()), bufferImageCopies.data()))
+        {
+            return false;
+        }
+        stagingBelt.transferImageOwnership(m_vkImage, subresourceRange,
+                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                           VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+        return true;
+    }
+
+    bool SparseTexture::setBaseLevel(uint32_t level, VkImageView& retiredView) noexcept
+    {
+        retiredView = VK_NULL_HANDLE;
+        if (!isValid() || level < m_committedLevel || level >= m_mipLevels)
+        {
+            return false;
+        }
+
+        VkImageViewCreateInfo imageViewCreateInfo{};
+        imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        imageViewCreateInfo.pNext = nullptr;
+        imageViewCreateInfo.flags = 0;
+        imageViewCreateInfo.image = m_vkImage;
+        imageViewCreateInfo.format = m_format;
+        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+        imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+        imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+        imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+        imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageViewCreateInfo.subresourceRange.baseMipLevel = level;
+        imageViewCreateInfo.subresourceRange.levelCount = m_mipLevels - level;
+        imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+        imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+        VkImageView vkImageView = VK_NULL_HANDLE;
+        VkResult vkResult = vkCreateImageView(m_vkDevice, &imageViewCreateInfo, nullptr, &vkImageView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("SparseTexture :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        retiredView = m_vkImageView;
+        m_vkImageView = vkImageView;
+        m_baseLevel = level;
+        return true;
+    }
+
+    void SparseTexture::destroyView(VkImageView vkImageView) const noexcept
+    {
+        if (m_vkDevice != VK_NULL_HANDLE && vkImageView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, vkImageView, nullptr);
+        }
+    }
+
+    VkDeviceSize SparseTexture::getResidentBytes() const noexcept
+    {
+        size_t pageCount = m_tailPages.size();
+        for (const std::vector<SparsePage>& pages : m_levelPages)
+        {
+            pageCount += pages.size();
+        }
+        return m_memoryRequirements.alignment * pageCount;
+    }
+
+    void SparseTexture::bindLevel(uint32_t level, const std::vector<SparsePage>& pages, std::vector<VkSparseImageMemoryBind>& binds) const noexcept
+    {
+        // one block per page, row by row; edge blocks are clipped to the level
+        const VkExtent3D granularity = m_sparseRequirements.formatProperties.imageGranularity;
+        const VkExtent2D extent = m_levelExtents[level];
+        size_t page = 0;
+        for (uint32_t y = 0; y < extent.height; y += granularity.height)
+        {
+            for (uint32_t x = 0; x < extent.width && page < pages.size(); x += granularity.width, ++page)
+            {
+                VkSparseImageMemoryBind bind{};
+                bind.subresource  = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0 };
+                bind.offset       = { static_cast<int32_t>(x), static_cast<int32_t>(y), 0 };
+                bind.extent       = { std::min(granularity.width, extent.width - x), std::min(granularity.height, extent.height - y), 1 };
+                bind.memory       = pages[page].mMemory;
+                bind.memoryOffset = pages[page].mOffset;
+                bind.flags        = 0;
+                binds.push_back(bind);
+            }
+        }
+    }
+
+    uint32_t SparseTexture::getLevelPageCount(uint32_t level) const noexcept
+    {
+        const VkExtent3D granularity = m_sparseRequirements.formatProperties.imageGranularity;
+        const VkExtent2D extent = m_levelExtents[level];
+        const uint32_t blocksX = (extent.width + granularity.width - 1) / std::max(granularity.width, 1u);
+        const uint32_t blocksY = (extent.height + granularity.height - 1) / std::max(granularity.height, 1u);
+        return blocksX * blocksY;
+    }
+}   // namespace keplar
@@ -0,0 +1,159 @@
+// ────────────────────────────────────────────
+//  File: sparse_texture.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "texture.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_fence.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+    class VulkanStagingBelt;
+
+    // one sparse block of device memory, bound to at most one image region at a time
+    struct SparsePage
+    {
+        VkDeviceMemory  mMemory = VK_NULL_HANDLE;
+        VkDeviceSize    mOffset = 0;
+    };
+
+    // fixed-capacity pool of sparse blocks shared by every sparse texture of a streamer. pages are sub-allocated in
+    // chunks of kPagesPerChunk as they are first needed, up to the capacity, and recycled through a free list, so the
+    // device memory sparse textures hold is bounded by the capacity however large their chains are. binds go to the
+    // graphics queue, in order with the frames that sample the images
+    class SparsePageCache final
+    {
+        public:
+            static constexpr uint32_t kPagesPerChunk = 64;
+
+            // creation and destruction
+            SparsePageCache() noexcept;
+            ~SparsePageCache();
+
+            // disable copy and move semantics to enforce unique ownership
+            SparsePageCache(const SparsePageCache&) = delete;
+            SparsePageCache& operator=(const SparsePageCache&) = delete;
+            SparsePageCache(SparsePageCache&&) = delete;
+            SparsePageCache& operator=(SparsePageCache&&) = delete;
+
+            // usage: pageRequirements are the memory requirements of the first sparse image; its alignment is the page
+            // size, and the first chunk fixes the memory type every later image must accept (see isCompatible)
+            bool initialize(const VulkanDevice& device, const VkMemoryRequirements& pageRequirements, VkDeviceSize capacity) noexcept;
+            void destroy() noexcept;
+
+            // usage: all or nothing; false when the pages would exceed the capacity
+            bool allocate(uint32_t count, std::vector<SparsePage>& pages) noexcept;
+            void free(std::vector<SparsePage>& pages) noexcept;
+
+            // usage: one vkQueueBindSparse; with wait the call returns once the binds executed, so copies into the
+            // bound regions may be recorded on any queue
+            bool bind(const VkSparseImageMemoryBindInfo* imageBinds, const VkSparseImageOpaqueMemoryBindInfo* opaqueBinds, bool wait) noexcept;
+
+            // accessors
+            bool isValid() const noexcept                   { return m_vkDevice != VK_NULL_HANDLE; }
+            bool isCompatible(const VkMemoryRequirements& requirements) const noexcept;
+            VkDeviceSize getPageSize() const noexcept       { return m_pageSize; }
+            uint32_t getFreePageCount() const noexcept      { return m_maxPages - m_usedPages; }
+            VkDeviceSize getUsedBytes() const noexcept      { return m_pageSize * m_usedPages; }
+            VkDeviceSize getAllocatedBytes() const noexcept { return m_pageSize * kPagesPerChunk * m_chunks.size(); }
+
+        private:
+            bool allocateChunk() noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkQueue                         m_vkQueue;
+            VulkanMemoryAllocator*          m_memoryAllocator;
+            VulkanFence                     m_fence;
+
+            // pages
+            VkMemoryRequirements            m_chunkRequirements;
+            VkDeviceSize                    m_pageSize;
+            uint32_t                        m_maxPages;
+            uint32_t                        m_usedPages;
+            std::vector<VulkanAllocation>   m_chunks;
+            std::vector<SparsePage>         m_freePages;
+    };
+
+    // a decoded chain as one partially resident image (sparseResidencyImage2D) with its full mip chain. the driver's mip
+    // tail is bound on the first commit, and every level above it is bound block by block from a SparsePageCache, so
+    // residency changes bind and unbind pages of the one image instead of replacing it. the sampled view starts at the
+    // base level and never covers levels whose pages are not bound, so no shader needs residency queries
+    class SparseTexture final
+    {
+        public:
+            static constexpr VkImageUsageFlags kUsage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+            // creation and destruction
+            SparseTexture() noexcept;
+            ~SparseTexture();
+
+            // disable copy and move semantics to enforce unique ownership
+            SparseTexture(const SparseTexture&) = delete;
+            SparseTexture& operator=(const SparseTexture&) = delete;
+            SparseTexture(SparseTexture&&) = delete;
+            SparseTexture& operator=(SparseTexture&&) = delete;
+
+            // usage: creates the unbound image for the chain (see Texture::getUploadFormat); no memory and no view yet
+            bool initialize(const VulkanDevice& device, const TextureData& textureData, const VkFormat& format) noexcept;
+            void destroy() noexcept;
+
+            // usage: binds levels [firstLevel, getCommittedLevel()) and waits for the binds; all or nothing. the pages
+            // come from pageCache, which has to outlive the texture
+            bool commit(SparsePageCache& pageCache, uint32_t firstLevel) noexcept;
+
+            // usage: unbinds the levels finer than firstLevel; no frame in flight may still sample them
+            void release(uint32_t firstLevel) noexcept;
+
+            // usage: stages levels [firstLevel, endLevel) of the chain, the range discarded and left in shader-read
+            bool upload(VulkanStagingBelt& stagingBelt, const TextureData& textureData, uint32_t firstLevel, uint32_t endLevel) noexcept;
+
+            // usage: the view over [level, end); the replaced one is handed out to be destroyed (destroyView) once no frame
+            // in flight samples it
+            bool setBaseLevel(uint32_t level, VkImageView& retiredView) noexcept;
+            void destroyView(VkImageView vkImageView) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept                       { return m_vkImage != VK_NULL_HANDLE; }
+            VkImage getImage() const noexcept                   { return m_vkImage; }
+            VkImageView getImageView() const noexcept           { return m_vkImageView; }
+            uint32_t getMipLevels() const noexcept              { return m_mipLevels; }
+            uint32_t getBaseLevel() const noexcept              { return m_baseLevel; }
+            uint32_t getCommittedLevel() const noexcept         { return m_committedLevel; }
+            const VkMemoryRequirements& getMemoryRequirements() const noexcept { return m_memoryRequirements; }
+            VkDeviceSize getResidentBytes() const noexcept;
+
+        private:
+            void bindLevel(uint32_t level, const std::vector<SparsePage>& pages, std::vector<VkSparseImageMemoryBind>& binds) const noexcept;
+            uint32_t getLevelPageCount(uint32_t level) const noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                    m_vkDevice;
+            VkImage                     m_vkImage;
+            VkImageView                 m_vkImageView;
+            SparsePageCache*            m_pageCache;
+
+            // image data
+            VkFormat                    m_format;
+            std::vector<VkExtent2D>     m_levelExtents;
+            uint32_t                    m_channels;
+            uint32_t                    m_mipLevels;
+            VkMemoryRequirements        m_memoryRequirements;
+            VkSparseImageMemoryRequirements m_sparseRequirements;
+
+            // residency: views start at the base level, pages are bound from the committed level on
+            uint32_t                    m_baseLevel;
+            uint32_t                    m_committedLevel;
+            std::vector<std::vector<SparsePage>> m_levelPages;     // per level above the mip tail
+            std::vector<SparsePage>     m_tailPages;
+    };
+}   // namespace keplar
@@ -0,0 +1,486 @@
+// ────────────────────────────────────────────
+//  File: temporal_aa.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "temporal_aa.hpp"
+
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // must match local_size_x/y of taa_resolve.comp
+    constexpr uint32_t kResolveWorkgroupSize = 8;
+
+    // weight of the current frame against a valid history
+    constexpr float kCurrentFrameWeight = 0.1f;
+
+    // descriptor bindings of the resolve sets (set: 0)
+    constexpr uint32_t kSourceBinding             = 0;
+    constexpr uint32_t kDepthBinding              = 1;
+    constexpr uint32_t kHistoryBinding            = 2;
+    constexpr uint32_t kDestinationBinding        = 3;
+    constexpr uint32_t kHistoryDestinationBinding = 4;
+
+    // push constants: must match taa_resolve.comp
+    struct ResolvePushConstants
+    {
+        glm::mat4  reprojection;    // current jittered clip space to the previous frame's clip space
+        glm::uvec4 extents;         // xy: rendered region, zw: image extent
+        glm::vec4  params;          // x: weight of the current frame (1: no history), y: 1 with reverse depth
+    };
+
+    // radical inverse of index in base: low-discrepancy sample positions that stay well spread for any prefix
+    float halton(uint32_t index, uint32_t base) noexcept
+    {
+        float fraction = 1.0f;
+        float result = 0.0f;
+        while (index > 0)
+        {
+            fraction /= static_cast<float>(base);
+            result += fraction * static_cast<float>(index % base);
+            index /= base;
+        }
+        return result;
+    }
+
+    void recordComputeBarrier(VkCommandBuffer commandBuffer) noexcept
+    {
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        keplar::VulkanCommandCounters::addBarrier();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+}
+
+namespace keplar
+{
+    TemporalAA::TemporalAA() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSets{ VK_NULL_HANDLE, VK_NULL_HANDLE }
+        , m_vkDepthView(VK_NULL_HANDLE)
+        , m_vkHistoryImages{ VK_NULL_HANDLE, VK_NULL_HANDLE }
+        , m_vkHistoryViews{ VK_NULL_HANDLE, VK_NULL_HANDLE }
+        , m_extent{}
+        , m_viewProjection(1.0f)
+        , m_reprojection(1.0f)
+        , m_renderExtent{}
+        , m_jitterPhase(0)
+        , m_historyIndex(0)
+        , m_isHistoryValid(false)
+        , m_isInitialized(false)
+    {
+    }
+
+    TemporalAA::~TemporalAA()
+    {
+        destroy();
+    }
+
+    bool TemporalAA::initialize(const VulkanDevice& device, const TemporalAAShaders& shaders, VkExtent2D extent) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_extent = extent;
+        if (extent.width == 0 || extent.height == 0)
+        {
+            VK_LOG_ERROR("TemporalAA::initialize :: invalid extent");
+            destroy();
+            return false;
+        }
+
+        // the history is filtered when reprojected and written by the resolve
+        if (!device.isFormatSupported(kFormat, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                               VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+        {
+            VK_LOG_ERROR("TemporalAA::initialize :: %s cannot be a filtered storage image", string_VkFormat(kFormat));
+            destroy();
+            return false;
+        }
+
+        // bilinear reads clamped to the edge; the shader keeps them inside the rendered region
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_LINEAR;
+        samplerInfo.minFilter    = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = 0.0f;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createHistoryImages(device) || !createDescriptorResources(device) || !createPipeline(device, shaders))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("TemporalAA::initialize successful (%ux%u, %u jitter phases)", extent.width, extent.height, kJitterPhaseCount);
+        return true;
+    }
+
+    void TemporalAA::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // the sets are freed with their pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+        }
+        m_vkDescriptorSets = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+        if (m_vkDepthView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkDepthView, nullptr);
+            m_vkDepthView = VK_NULL_HANDLE;
+        }
+
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            if (m_vkHistoryViews[i] != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, m_vkHistoryViews[i], nullptr);
+                m_vkHistoryViews[i] = VK_NULL_HANDLE;
+            }
+
+            if (m_vkHistoryImages[i] != VK_NULL_HANDLE)
+            {
+                vkDestroyImage(m_vkDevice, m_vkHistoryImages[i], nullptr);
+                m_vkHistoryImages[i] = VK_NULL_HANDLE;
+            }
+
+            if (m_memoryAllocator != nullptr)
+            {
+                m_memoryAllocator->free(m_historyAllocations[i]);
+            }
+        }
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_extent = {};
+        m_renderExtent = {};
+        m_jitterPhase = 0;
+        m_historyIndex = 0;
+        m_isHistoryValid = false;
+        m_isInitialized = false;
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("temporal aa destroyed successfully");
+    }
+
+    bool TemporalAA::bindImages(VkImageView sourceView, VkImage depthImage, VkFormat depthFormat, VkImageView destinationView) noexcept
+    {
+        if (m_vkDescriptorSets[0] == VK_NULL_HANDLE || sourceView == VK_NULL_HANDLE || depthImage == VK_NULL_HANDLE || destinationView == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("TemporalAA::bindImages :: invalid images or pass not initialized");
+            return false;
+        }
+
+        // depth-only view: a sampled view of a depth-stencil image may name a single aspect
+        if (m_vkDepthView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkDepthView, nullptr);
+            m_vkDepthView = VK_NULL_HANDLE;
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.image                           = depthImage;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = depthFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        const VkResult vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkDepthView);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("TemporalAA :: vkCreateImageView failed for depth : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDepthView = VK_NULL_HANDLE;
+            return false;
+        }
+
+        // set i reads the history the previous frame wrote and writes history i
+        const VkDescriptorImageInfo sourceInfo{ m_vkSampler, sourceView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo depthInfo{ m_vkSampler, m_vkDepthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        const VkDescriptorImageInfo destinationInfo{ VK_NULL_HANDLE, destinationView, VK_IMAGE_LAYOUT_GENERAL };
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            const VkDescriptorImageInfo historyInfo{ m_vkSampler, m_vkHistoryViews[i ^ 1], VK_IMAGE_LAYOUT_GENERAL };
+            const VkDescriptorImageInfo historyDestinationInfo{ VK_NULL_HANDLE, m_vkHistoryViews[i], VK_IMAGE_LAYOUT_GENERAL };
+
+            std::array<VkWriteDescriptorSet, 5> writes{};
+            for (auto& write : writes)
+            {
+                write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet          = m_vkDescriptorSets[i];
+                write.descriptorCount = 1;
+            }
+            writes[0].dstBinding     = kSourceBinding;
+            writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[0].pImageInfo     = &sourceInfo;
+            writes[1].dstBinding     = kDepthBinding;
+            writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[1].pImageInfo     = &depthInfo;
+            writes[2].dstBinding     = kHistoryBinding;
+            writes[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[2].pImageInfo     = &historyInfo;
+            writes[3].dstBinding     = kDestinationBinding;
+            writes[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[3].pImageInfo     = &destinationInfo;
+            writes[4].dstBinding     = kHistoryDestinationBinding;
+            writes[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[4].pImageInfo     = &historyDestinationInfo;
+            vkUpdateDescriptorSets(m_vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        m_isHistoryValid = false;
+        return true;
+    }
+
+    glm::vec2 TemporalAA::getJitter(VkExtent2D renderExtent) const noexcept
+    {
+        // halton (2, 3) from index 1, centered on the pixel; one pixel spans 2 / extent in clip space
+        const glm::vec2 offset(halton(m_jitterPhase + 1, 2) - 0.5f, halton(m_jitterPhase + 1, 3) - 0.5f);
+        return 2.0f * offset / glm::vec2(std::max(renderExtent.width, 1u), std::max(renderExtent.height, 1u));
+    }
+
+    void TemporalAA::prepare(const glm::mat4& viewProjection, const glm::mat4& jitteredViewProjection, VkExtent2D renderExtent) noexcept
+    {
+        // the history holds another region's pixels after a render scale change
+        renderExtent = { std::clamp(renderExtent.width, 1u, std::max(m_extent.width, 1u)), std::clamp(renderExtent.height, 1u, std::max(m_extent.height, 1u)) };
+        if (renderExtent.width != m_renderExtent.width || renderExtent.height != m_renderExtent.height)
+        {
+            m_renderExtent = renderExtent;
+            m_isHistoryValid = false;
+        }
+
+        // history is sampled where the previous unjittered camera saw this frame's (jittered) surface
+        m_reprojection = m_viewProjection * glm::inverse(jitteredViewProjection);
+        m_viewProjection = viewProjection;
+        m_jitterPhase = (m_jitterPhase + 1) % kJitterPhaseCount;
+    }
+
+    void TemporalAA::record(VkCommandBuffer commandBuffer) noexcept
+    {
+        if (!isValid() || m_renderExtent.width == 0)
+        {
+            return;
+        }
+
+        if (!m_isInitialized)
+        {
+            // both histories stay in the general layout; the first frame takes its own samples outright
+            std::array<VkImageMemoryBarrier, 2> imageBarriers{};
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                VkImageMemoryBarrier& imageBarrier = imageBarriers[i];
+                imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarrier.pNext                           = nullptr;
+                imageBarrier.srcAccessMask                   = 0;
+                imageBarrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+                imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+                imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.image                           = m_vkHistoryImages[i];
+                imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                imageBarrier.subresourceRange.baseMipLevel   = 0;
+                imageBarrier.subresourceRange.levelCount     = 1;
+                imageBarrier.subresourceRange.baseArrayLayer = 0;
+                imageBarrier.subresourceRange.layerCount     = 1;
+            }
+            VulkanCommandCounters::addBarrier();
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+            m_isInitialized = true;
+            m_isHistoryValid = false;
+        }
+        else
+        {
+            // the previous frame's history write, same queue
+            recordComputeBarrier(commandBuffer);
+        }
+
+        ResolvePushConstants pushConstants{};
+        pushConstants.reprojection = m_reprojection;
+        pushConstants.extents      = glm::uvec4(m_renderExtent.width, m_renderExtent.height, m_extent.width, m_extent.height);
+        pushConstants.params       = glm::vec4(m_isHistoryValid ? kCurrentFrameWeight : 1.0f, 1.0f, 0.0f, 0.0f);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSets[m_historyIndex], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (m_renderExtent.width + kResolveWorkgroupSize - 1) / kResolveWorkgroupSize,
+                      (m_renderExtent.height + kResolveWorkgroupSize - 1) / kResolveWorkgroupSize, 1);
+
+        // the written history is the one the next frame reads
+        m_historyIndex ^= 1;
+        m_isHistoryValid = true;
+    }
+
+    bool TemporalAA::createHistoryImages(const VulkanDevice&) noexcept
+    {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.pNext         = nullptr;
+        imageInfo.flags         = 0;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = kFormat;
+        imageInfo.extent        = { m_extent.width, m_extent.height, 1 };
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.pNext                           = nullptr;
+        viewInfo.flags                           = 0;
+        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = kFormat;
+        viewInfo.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY,
+                                                     VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = 1;
+
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            VkResult vkResult = vkCreateImage(m_vkDevice, &imageInfo, nullptr, &m_vkHistoryImages[i]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("TemporalAA :: vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                return false;
+            }
+
+            if (!m_memoryAllocator->allocateImageMemory(m_vkHistoryImages[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_historyAllocations[i],
+                                                        VulkanMemoryCategory::kAttachment))
+            {
+                VK_LOG_FATAL("TemporalAA :: failed to allocate memory for history %u", i);
+                return false;
+            }
+
+            viewInfo.image = m_vkHistoryImages[i];
+            vkResult = vkCreateImageView(m_vkDevice, &viewInfo, nullptr, &m_vkHistoryViews[i]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("TemporalAA :: vkCreateImageView failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool TemporalAA::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { kSourceBinding,             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kDepthBinding,              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kHistoryBinding,            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kDestinationBinding,        VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { kHistoryDestinationBinding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        };
+        m_vkSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        // private pool for the two sets; bindImages only rewrites them
+        const std::array<VkDescriptorPoolSize, 2> poolSizes
+        {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 6 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 4 }
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 2;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("TemporalAA :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        const std::array<VkDescriptorSetLayout, 2> layouts{ m_vkSetLayout, m_vkSetLayout };
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+        allocateInfo.pSetLayouts        = layouts.data();
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, m_vkDescriptorSets.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("TemporalAA :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorSets = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+            return false;
+        }
+        return true;
+    }
+
+    bool TemporalAA::createPipeline(const VulkanDevice& device, const TemporalAAShaders& shaders) noexcept
+    {
+        VulkanShader resolveShader;
+        if (!resolveShader.initialize(m_vkDevice, VK_SHADER_STAGE_COMPUTE_BIT, shaders.mResolveFile))
+        {
+            VK_LOG_ERROR("TemporalAA :: compute shader '%s' unavailable", shaders.mResolveFile.c_str());
+            return false;
+        }
+
+        ComputePipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStage          = resolveShader.getShaderStageInfo();
+        pipelineConfig.mDescriptorSetLayouts = { m_vkSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ResolvePushConstants) } };
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("TemporalAA :: failed to create resolve pipeline");
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,107 @@
+// ────────────────────────────────────────────
+//  File: temporal_aa.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the compute pass
+    struct TemporalAAShaders
+    {
+        std::string mResolveFile;           // taa_resolve.comp
+    };
+
+    // temporal anti-aliasing in place of msaa: the scene renders one sample per pixel through a projection jittered by
+    // a sub-pixel offset that cycles every kJitterPhaseCount frames, and one compute pass blends it with the history of
+    // the previous frames. each pixel's velocity is reconstructed from its depth and the current and previous camera
+    // transforms (the nearest depth of its 3x3 neighbourhood, so edges move with the foreground); the reprojected
+    // history is clipped to the current neighbourhood's color distribution, which also rejects what moved on its own.
+    // the history pair is owned by the pass and kept in VK_IMAGE_LAYOUT_GENERAL, alternating every frame: one is read
+    // while the other is written with the result alongside the destination. all of it runs over the rendered region
+    // only (see dynamic resolution), whose changes restart the history. rebuilt with the render graph that owns the
+    // source, depth and destination
+    class TemporalAA final
+    {
+        public:
+            static constexpr VkFormat kFormat           = VK_FORMAT_R16G16B16A16_SFLOAT;   // source, history and destination
+            static constexpr uint32_t kJitterPhaseCount = 8;
+
+            // creation and destruction
+            TemporalAA() noexcept;
+            ~TemporalAA();
+
+            // disable copy and move semantics to enforce unique ownership
+            TemporalAA(const TemporalAA&) = delete;
+            TemporalAA& operator=(const TemporalAA&) = delete;
+            TemporalAA(TemporalAA&&) = delete;
+            TemporalAA& operator=(TemporalAA&&) = delete;
+
+            // usage: extent is the one of the source, depth and destination images
+            bool initialize(const VulkanDevice& device, const TemporalAAShaders& shaders, VkExtent2D extent) noexcept;
+            void destroy() noexcept;
+
+            // usage: source (kFormat) and depth (single-sampled) sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            // destination (kFormat) written as a storage image in VK_IMAGE_LAYOUT_GENERAL
+            bool bindImages(VkImageView sourceView, VkImage depthImage, VkFormat depthFormat, VkImageView destinationView) noexcept;
+
+            // usage: per frame; clip-space offset the next frame's projection is translated by, for a render extent
+            glm::vec2 getJitter(VkExtent2D renderExtent) const noexcept;
+
+            // usage: per frame, once its camera is final; viewProjection without the jitter, jitteredViewProjection the
+            // one the scene renders with. advances the jitter sequence
+            void prepare(const glm::mat4& viewProjection, const glm::mat4& jitteredViewProjection, VkExtent2D renderExtent) noexcept;
+
+            // usage: outside render passes, after prepare; resolves the frame and swaps the history
+            void record(VkCommandBuffer commandBuffer) noexcept;
+
+            // usage: the next frame shows its own samples only (camera cuts)
+            void resetHistory() noexcept { m_isHistoryValid = false; }
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && m_vkDescriptorSets[0] != VK_NULL_HANDLE && m_vkDepthView != VK_NULL_HANDLE; }
+            uint32_t getJitterPhase() const noexcept { return m_jitterPhase; }
+
+        private:
+            bool createHistoryImages(const VulkanDevice& device) noexcept;
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipeline(const VulkanDevice& device, const TemporalAAShaders& shaders) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                                m_vkDevice;
+            VulkanMemoryAllocator*                  m_memoryAllocator;
+            VkSampler                               m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout                   m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorPool                        m_vkDescriptorPool;
+            std::array<VkDescriptorSet, 2>          m_vkDescriptorSets;     // per history parity: reads one, writes the other
+            VulkanPipeline                          m_pipeline;
+            VkImageView                             m_vkDepthView;          // depth aspect of the bound depth image
+
+            // history pair of the pass extent
+            std::array<VkImage, 2>                  m_vkHistoryImages;
+            std::array<VkImageView, 2>              m_vkHistoryViews;
+            std::array<VulkanAllocation, 2>         m_historyAllocations;
+            VkExtent2D                              m_extent;
+
+            // frame state set by prepare
+            glm::mat4                               m_viewProjection;       // previous frame's, without jitter
+            glm::mat4                               m_reprojection;         // current jittered clip space to previous clip space
+            VkExtent2D                              m_renderExtent;
+            uint32_t                                m_jitterPhase;
+            uint32_t                                m_historyIndex;         // history the next record writes
+            bool                                    m_isHistoryValid;       // the read history holds a frame of this render extent
+            bool                                    m_isInitialized;        // history layouts set up on the gpu
+    };
+}   // namespace keplar
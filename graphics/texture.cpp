@@ -3,29 +3,363 @@
 // ────────────────────────────────────────────
 
 #include "texture.hpp"
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <utility>
 #include <algorithm>
 
 #include "core/keplar_config.hpp"
 #include "vulkan/vulkan_device.hpp"
-#include "vulkan/vulkan_command_pool.hpp"
-#include "vulkan/vulkan_command_buffer.hpp"
-#include "vulkan/vulkan_fence.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "basis_transcoder.hpp"
+#include "image_decoder.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/asset_pack.hpp"
+#include "utils/async_file_io.hpp"
 #include "utils/logger.hpp"
 
 namespace
 {
-    // cross-platform safe fopen wrapper
-    FILE* fopenSafe(const std::string& filepath, const char* mode) noexcept
-    {
-    #ifdef _WIN32
-        FILE* file = nullptr;
-        if (fopen_s(&file, filepath.c_str(), mode) != 0)
-            return nullptr;
-        return file;
-    #else
-        return std::fopen(path.string().c_str(), mode);
-    #endif
+    // usage of every texture image; transfer source for blitted mips and readbacks
+    constexpr VkImageUsageFlags kTextureUsage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+    // 8-bit srgb to linear conversion table for gamma-correct mip filtering
+    const std::array<float, 256>& srgbToLinearTable() noexcept
+    {
+        static const std::array<float, 256> table = []()
+        {
+            std::array<float, 256> values{};
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                const float c = static_cast<float>(i) / 255.0f;
+                values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    uint8_t linearToSrgb(float value) noexcept
+    {
+        value = std::clamp(value, 0.0f, 1.0f);
+        const float c = (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(c * 255.0f + 0.5f);
+    }
+
+    // 2x2 box filter from one mip level into the next (edge texels are clamped for odd sizes)
+    void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, 
+                    uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight, 
+                    uint32_t channels, bool isSrgb) noexcept
+    {
+        const auto& toLinear = srgbToLinearTable();
+        for (uint32_t y = 0; y < dstHeight; ++y)
+        {
+            const uint32_t y0 = std::min(y * 2, srcHeight - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, srcWidth - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+
+                const uint8_t* t00 = src + (static_cast<size_t>(y0) * srcWidth + x0) * channels;
+                const uint8_t* t01 = src + (static_cast<size_t>(y0) * srcWidth + x1) * channels;
+                const uint8_t* t10 = src + (static_cast<size_t>(y1) * srcWidth + x0) * channels;
+                const uint8_t* t11 = src + (static_cast<size_t>(y1) * srcWidth + x1) * channels;
+                uint8_t* out = dst + (static_cast<size_t>(y) * dstWidth + x) * channels;
+
+                for (uint32_t c = 0; c < channels; ++c)
+                {
+                    // color channels of srgb images are averaged in linear space; alpha is always linear
+                    if (isSrgb && c < 3)
+                    {
+                        const float sum = toLinear[t00[c]] + toLinear[t01[c]] + toLinear[t10[c]] + toLinear[t11[c]];
+                        out[c] = linearToSrgb(sum * 0.25f);
+                    }
+                    else
+                    {
+                        out[c] = static_cast<uint8_t>((t00[c] + t01[c] + t10[c] + t11[c] + 2) / 4);
+                    }
+                }
+            }
+        }
+    }
+
+    // ─────────────────────────────────────────────
+    // float mip filtering: levels are kept in linear space (srgb decoded, normals in [-1, 1]) between passes,
+    // so quantization error does not accumulate down the chain
+    // ─────────────────────────────────────────────
+    float linearToSrgbFloat(float value) noexcept
+    {
+        value = std::clamp(value, 0.0f, 1.0f);
+        return (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    void decodeLevel(const uint8_t* src, size_t texelCount, uint32_t channels, bool isSrgb, bool isNormalMap, float* dst) noexcept
+    {
+        const auto& toLinear = srgbToLinearTable();
+        for (size_t i = 0; i < texelCount * channels; ++i)
+        {
+            const uint32_t c = static_cast<uint32_t>(i % channels);
+            if (isSrgb && c < 3)
+                dst[i] = toLinear[src[i]];
+            else if (isNormalMap && c < 3)
+                dst[i] = static_cast<float>(src[i]) * (2.0f / 255.0f) - 1.0f;
+            else
+                dst[i] = static_cast<float>(src[i]) * (1.0f / 255.0f);
+        }
+    }
+
+    void encodeLevel(float* src, size_t texelCount, uint32_t channels, bool isSrgb, bool isNormalMap, uint8_t* dst) noexcept
+    {
+        for (size_t t = 0; t < texelCount; ++t)
+        {
+            float* texel = src + t * channels;
+
+            // averaged normals are shorter than unit length; the renormalized value also feeds the next level
+            if (isNormalMap && channels >= 3)
+            {
+                const float length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+                const float scale  = length > 1e-6f ? 1.0f / length : 0.0f;
+                texel[0] = length > 1e-6f ? texel[0] * scale : 0.0f;
+                texel[1] = length > 1e-6f ? texel[1] * scale : 0.0f;
+                texel[2] = length > 1e-6f ? texel[2] * scale : 1.0f;
+            }
+
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                float value = texel[c];
+                if (isSrgb && c < 3)
+                    value = linearToSrgbFloat(value);
+                else if (isNormalMap && c < 3)
+                    value = value * 0.5f + 0.5f;
+                dst[t * channels + c] = static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    // 2:1 kaiser-windowed sinc, 4 source taps on each side of the destination texel center
+    constexpr int kKaiserRadius = 4;
+    constexpr float kKaiserAlpha = 4.0f;
+
+    float besselI0(float x) noexcept
+    {
+        // power series; converges quickly for the small arguments of the window
+        float sum = 1.0f;
+        float term = 1.0f;
+        for (int k = 1; k < 16; ++k)
+        {
+            term *= (x * 0.5f) / static_cast<float>(k);
+            sum += term * term;
+        }
+        return sum;
+    }
+
+    const std::array<float, 2 * kKaiserRadius>& kaiserWeights() noexcept
+    {
+        static const std::array<float, 2 * kKaiserRadius> weights = []()
+        {
+            // tap i samples source texel 2x - radius + 1 + i; distances are measured in destination texels
+            std::array<float, 2 * kKaiserRadius> values{};
+            const float support = static_cast<float>(kKaiserRadius) * 0.5f;
+            float total = 0.0f;
+            for (int i = 0; i < 2 * kKaiserRadius; ++i)
+            {
+                const float distance = (static_cast<float>(i - kKaiserRadius + 1) + 0.5f - 1.0f) * 0.5f;
+                const float x = distance * 3.14159265f;
+                const float sinc = std::abs(distance) < 1e-6f ? 1.0f : std::sin(x) / x;
+                const float ratio = distance / support;
+                const float window = besselI0(kKaiserAlpha * std::sqrt(std::max(0.0f, 1.0f - ratio * ratio))) / besselI0(kKaiserAlpha);
+                values[i] = sinc * window;
+                total += values[i];
+            }
+
+            for (float& value : values)
+            {
+                value /= total;
+            }
+            return values;
+        }();
+        return weights;
+    }
+
+    // box or kaiser reduction of one linear level into the next; both are separable, edges are clamped
+    void downsampleFloat(const float* src, uint32_t srcWidth, uint32_t srcHeight, 
+                         float* dst, uint32_t dstWidth, uint32_t dstHeight, 
+                         uint32_t channels, keplar::MipFilter filter, std::vector<float>& scratch) noexcept
+    {
+        const auto& kaiser = kaiserWeights();
+        const int radius = filter == keplar::MipFilter::kKaiser ? kKaiserRadius : 1;
+        const float boxWeights[2] = { 0.5f, 0.5f };
+        const float* weights = filter == keplar::MipFilter::kKaiser ? kaiser.data() : boxWeights;
+
+        // horizontal pass: every source row to the destination width
+        scratch.assign(static_cast<size_t>(dstWidth) * srcHeight * channels, 0.0f);
+        for (uint32_t y = 0; y < srcHeight; ++y)
+        {
+            const float* row = src + static_cast<size_t>(y) * srcWidth * channels;
+            float* out = scratch.data() + static_cast<size_t>(y) * dstWidth * channels;
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                for (int tap = 0; tap < 2 * radius; ++tap)
+                {
+                    const int sx = std::clamp(static_cast<int>(x * 2) - radius + 1 + tap, 0, static_cast<int>(srcWidth) - 1);
+                    const float* texel = row + static_cast<size_t>(sx) * channels;
+                    for (uint32_t c = 0; c < channels; ++c)
+                    {
+                        out[x * channels + c] += texel[c] * weights[tap];
+                    }
+                }
+            }
+        }
+
+        // vertical pass: whole rows at a time so the inner loop runs over contiguous floats
+        const size_t rowSize = static_cast<size_t>(dstWidth) * channels;
+        std::fill(dst, dst + rowSize * dstHeight, 0.0f);
+        for (uint32_t y = 0; y < dstHeight; ++y)
+        {
+            float* out = dst + static_cast<size_t>(y) * rowSize;
+            for (int tap = 0; tap < 2 * radius; ++tap)
+            {
+                const int sy = std::clamp(static_cast<int>(y * 2) - radius + 1 + tap, 0, static_cast<int>(srcHeight) - 1);
+                const float* row = scratch.data() + static_cast<size_t>(sy) * rowSize;
+                const float weight = weights[tap];
+                for (size_t i = 0; i < rowSize; ++i)
+                {
+                    out[i] += row[i] * weight;
+                }
+            }
+        }
+    }
+
+    // texel block layout of the formats texture uploads understand; mBytes == 0 marks an unknown format
+    struct FormatBlockInfo
+    {
+        uint32_t mBytes;
+        uint32_t mWidth;
+        uint32_t mHeight;
+        uint32_t mChannels;
+    };
+
+    FormatBlockInfo getFormatBlockInfo(VkFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R8_UNORM:                    return { 1, 1, 1, 1 };
+            case VK_FORMAT_R8G8_UNORM:                  return { 2, 1, 1, 2 };
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:               return { 4, 1, 1, 4 };
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:         return { 8, 4, 4, 4 };
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:              return { 16, 4, 4, 4 };
+            case VK_FORMAT_BC4_UNORM_BLOCK:             return { 8, 4, 4, 1 };
+            case VK_FORMAT_BC5_UNORM_BLOCK:             return { 16, 4, 4, 2 };
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:           return { 16, 4, 4, 3 };
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:              return { 16, 4, 4, 4 };
+            case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:         return { 16, 4, 4, 4 };
+            case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:         return { 16, 5, 5, 4 };
+            case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:         return { 16, 6, 6, 4 };
+            case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:         return { 16, 8, 8, 4 };
+            default:                                    return { 0, 1, 1, 0 };
+        }
+    }
+
+    bool isBCFormat(VkFormat format) noexcept
+    {
+        return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+    }
+
+    bool isASTCFormat(VkFormat format) noexcept
+    {
+        return format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK && format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK;
+    }
+
+    bool isSrgbFormat(VkFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // swap a payload format to its srgb or unorm twin so the material decides the color space
+    VkFormat matchColorSpace(VkFormat format, bool isSrgb) noexcept
+    {
+        constexpr std::pair<VkFormat, VkFormat> twins[] = 
+        {
+            { VK_FORMAT_R8G8B8A8_UNORM,         VK_FORMAT_R8G8B8A8_SRGB },
+            { VK_FORMAT_B8G8R8A8_UNORM,         VK_FORMAT_B8G8R8A8_SRGB },
+            { VK_FORMAT_BC1_RGBA_UNORM_BLOCK,   VK_FORMAT_BC1_RGBA_SRGB_BLOCK },
+            { VK_FORMAT_BC3_UNORM_BLOCK,        VK_FORMAT_BC3_SRGB_BLOCK },
+            { VK_FORMAT_BC7_UNORM_BLOCK,        VK_FORMAT_BC7_SRGB_BLOCK },
+            { VK_FORMAT_ASTC_4x4_UNORM_BLOCK,   VK_FORMAT_ASTC_4x4_SRGB_BLOCK },
+            { VK_FORMAT_ASTC_5x5_UNORM_BLOCK,   VK_FORMAT_ASTC_5x5_SRGB_BLOCK },
+            { VK_FORMAT_ASTC_6x6_UNORM_BLOCK,   VK_FORMAT_ASTC_6x6_SRGB_BLOCK },
+            { VK_FORMAT_ASTC_8x8_UNORM_BLOCK,   VK_FORMAT_ASTC_8x8_SRGB_BLOCK },
+        };
+
+        for (const auto& [unorm, srgb] : twins)
+        {
+            if (format == unorm || format == srgb)
+            {
+                return isSrgb ? srgb : unorm;
+            }
+        }
+        return format;
     }
+
+    // ktx2 file header and level index (khronos ktx 2.0 specification, section 3)
+    constexpr uint8_t kKTX2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    struct KTX2Header
+    {
+        uint8_t  mIdentifier[12];
+        uint32_t mVkFormat;
+        uint32_t mTypeSize;
+        uint32_t mPixelWidth;
+        uint32_t mPixelHeight;
+        uint32_t mPixelDepth;
+        uint32_t mLayerCount;
+        uint32_t mFaceCount;
+        uint32_t mLevelCount;
+        uint32_t mSupercompressionScheme;
+        uint32_t mDfdByteOffset;
+        uint32_t mDfdByteLength;
+        uint32_t mKvdByteOffset;
+        uint32_t mKvdByteLength;
+        uint64_t mSgdByteOffset;
+        uint64_t mSgdByteLength;
+    };
+
+    struct KTX2LevelIndex
+    {
+        uint64_t mByteOffset;
+        uint64_t mByteLength;
+        uint64_t mUncompressedByteLength;
+    };
+
+    static_assert(sizeof(KTX2Header) == 80, "KTX2Header must match the file layout");
+    static_assert(sizeof(KTX2LevelIndex) == 24, "KTX2LevelIndex must match the file layout");
 }
 
 namespace keplar
@@ -41,13 +375,15 @@ namespace keplar
     Texture::Texture() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
         , m_vkImage(VK_NULL_HANDLE)
-        , m_vkImageMemory(VK_NULL_HANDLE)
         , m_vkImageView(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_allocation{}
         , m_width(0)
         , m_height(0)
         , m_channels(0)
         , m_mipLevels(0)
         , m_format(VK_FORMAT_UNDEFINED)
+        , m_layerCount(1)
     {
     }
 
@@ -59,24 +395,30 @@ namespace keplar
     Texture::Texture(Texture&& other) noexcept
         : m_vkDevice(other.m_vkDevice)
         , m_vkImage(other.m_vkImage)
-        , m_vkImageMemory(other.m_vkImageMemory)
         , m_vkImageView(other.m_vkImageView)
+        , m_memoryAllocator(other.m_memoryAllocator)
+        , m_allocation(other.m_allocation)
         , m_width(other.m_width)
         , m_height(other.m_height)
         , m_channels(other.m_channels)
         , m_mipLevels(other.m_mipLevels)
         , m_format(other.m_format)
+        , m_layerCount(other.m_layerCount)
+        , m_vkLayerViews(std::move(other.m_vkLayerViews))
     {
         // reset the other
         other.m_vkDevice = VK_NULL_HANDLE;
         other.m_vkImage = VK_NULL_HANDLE;
-        other.m_vkImageMemory = VK_NULL_HANDLE;
         other.m_vkImageView = VK_NULL_HANDLE;
+        other.m_memoryAllocator = nullptr;
+        other.m_allocation = VulkanAllocation{};
         other.m_width = 0;
         other.m_height = 0;
         other.m_channels = 0;
         other.m_mipLevels = 0;
         other.m_format = VK_FORMAT_UNDEFINED;
+        other.m_layerCount = 1;
+        other.m_vkLayerViews.clear();
     }
 
     Texture& Texture::operator=(Texture&& other) noexcept
@@ -90,47 +432,65 @@ namespace keplar
             // transfer ownership
             m_vkDevice = other.m_vkDevice;
             m_vkImage = other.m_vkImage;
-            m_vkImageMemory = other.m_vkImageMemory;
             m_vkImageView = other.m_vkImageView;
+            m_memoryAllocator = other.m_memoryAllocator;
+            m_allocation = other.m_allocation;
             m_width = other.m_width;
             m_height = other.m_height;
             m_channels = other.m_channels;
             m_mipLevels = other.m_mipLevels;
             m_format = other.m_format;
+            m_layerCount = other.m_layerCount;
+            m_vkLayerViews = std::move(other.m_vkLayerViews);
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
             other.m_vkImage = VK_NULL_HANDLE;
-            other.m_vkImageMemory = VK_NULL_HANDLE;
             other.m_vkImageView = VK_NULL_HANDLE;
+            other.m_memoryAllocator = nullptr;
+            other.m_allocation = VulkanAllocation{};
             other.m_width = 0;
             other.m_height = 0;
             other.m_channels = 0;
             other.m_mipLevels = 0;
             other.m_format = VK_FORMAT_UNDEFINED;
+            other.m_layerCount = 1;
+            other.m_vkLayerViews.clear();
         }
         
         return *this;
     }
 
-    bool Texture::load(const VulkanDevice& device, const VulkanCommandPool& commandPool, const std::string& filepath, const VkFormat& format, bool flipY, bool genMips) noexcept
+    bool Texture::load(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filepath, const VkFormat& format, bool flipY, bool genMips) noexcept
     {
-        // image info container
+        // image info container (pixels point into the decoder output)
         ImageData imageData{};
+        std::vector<uint8_t> pixels;
         const std::filesystem::path texturePath = keplar::config::kTextureDir / filepath;
 
+        // pre-compressed container: upload its payload and mips as stored
+        if (texturePath.extension() == ".ktx2")
+        {
+            TextureData textureData{};
+            if (!decodeKTX2(texturePath.string(), textureData))
+            {
+                VK_LOG_ERROR("Texture::load :: failed to load ktx2 texture: %s", filepath.c_str());
+                return false;
+            }
+            return upload(device, stagingBelt, textureData, format);
+        }
+
         // load image data from file
-        if (!loadImageData(texturePath.string(), imageData, flipY))
+        if (!loadImageData(texturePath.string(), pixels, imageData, flipY))
         {
             VK_LOG_ERROR("Texture::load :: failed to load image data from file: %s", filepath.c_str());
             return false;
         }
 
         // create vulkan image from loaded image info
-        if (!createImage(device, commandPool, imageData, format, genMips))
+        if (!createImage(device, stagingBelt, imageData, format, genMips))
         {
             VK_LOG_DEBUG("Texture::load :: failed to create vulkan image from loaded image info: %s", filepath.c_str());
-            stbi_image_free(imageData.pixels);
             return false;
         }
 
@@ -138,338 +498,816 @@ namespace keplar
         if (!createImageView())
         {
             VK_LOG_ERROR("Texture::load :: failed to create image view for texture: %s", filepath.c_str());
-            stbi_image_free(imageData.pixels);
             return false;
         }
-
-        // cleanup and return success
-        stbi_image_free(imageData.pixels);
         return true;
     }
 
-    bool Texture::load(const VulkanDevice& device, const VulkanCommandPool& commandPool, const tinygltf::Image& gltfImage, const VkFormat& format, bool genMips) noexcept
+    bool Texture::load(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const tinygltf::Image& gltfImage, const VkFormat& format, bool genMips) noexcept
     {
-        // image info container
+        // decode pixels and build the mip chain on the cpu
+        TextureData textureData{};
+        if (!decode(gltfImage, format, genMips, textureData))
+        {
+            return false;
+        }
+
+        // stage the whole mip chain and create the image view
+        return upload(device, stagingBelt, textureData, format);
+    }
+
+    bool Texture::decode(const tinygltf::Image& gltfImage, const VkFormat& format, bool genMips, TextureData& textureData, VkFormat transcodeFormat,
+                         const uint8_t* encodedData, size_t encodedSize, bool flipY) noexcept
+    {
+        // decoded images land in textureData.mPixels directly; only tinygltf's own pixels are copied
         ImageData imageData{};
-        std::string imageName;
-        bool isEmbedded = false;
+        textureData = TextureData{};
 
-        if (!gltfImage.image.empty())
+        // encoded bytes of an embedded image: the given span, or the copy the loader kept
+        const bool isEncoded = encodedData != nullptr || gltfImage.as_is;
+        const uint8_t* embeddedData = encodedData ? encodedData : gltfImage.image.data();
+        const size_t embeddedSize = encodedData ? encodedSize : gltfImage.image.size();
+
+        // ktx2 payloads are uploaded as stored (or transcoded), never decoded through stb
+        const std::string extension = gltfImage.uri.size() >= 5 ? gltfImage.uri.substr(gltfImage.uri.size() - 5) : std::string();
+        if (gltfImage.mimeType == "image/ktx2" || extension == ".ktx2")
+        {
+            const std::string name = !gltfImage.name.empty() ? gltfImage.name : (!gltfImage.uri.empty() ? gltfImage.uri : "embedded_image");
+            if (embeddedSize > 0)
+            {
+                return decodeKTX2(embeddedData, embeddedSize, name, textureData, transcodeFormat);
+            }
+            return decodeKTX2((keplar::config::kModelDir / gltfImage.uri).string(), textureData, transcodeFormat);
+        }
+
+        if (embeddedSize > 0 && isEncoded)
+        {
+            // embedded image kept encoded by the loader: decode here so it runs off the main thread
+            textureData.mName = !gltfImage.name.empty() ? gltfImage.name : "embedded_image";
+            uint32_t width = 0;
+            uint32_t height = 0;
+            if (!image_decoder::decodeRGBA8(embeddedData, embeddedSize, flipY, textureData.mPixels, width, height))
+            {
+                VK_LOG_ERROR("Texture::decode :: %s failed to decode embedded glTF image: %s", image_decoder::getBackendName(embeddedData, embeddedSize),
+                             textureData.mName.c_str());
+                return false;
+            }
+            imageData.width    = static_cast<int>(width);
+            imageData.height   = static_cast<int>(height);
+            imageData.channels = 4;
+        }
+        else if (!gltfImage.image.empty())
         {
             // embedded image: pixels already loaded in tinygltf::Image
             imageData.pixels   = const_cast<void*>(static_cast<const void*>(gltfImage.image.data()));
             imageData.width    = gltfImage.width;
             imageData.height   = gltfImage.height;
             imageData.channels = gltfImage.component;
-            imageName          = !gltfImage.name.empty() ? gltfImage.name : "embedded_image";
-            isEmbedded         = true;
+            textureData.mName  = !gltfImage.name.empty() ? gltfImage.name : "embedded_image";
 
             if (!imageData.pixels || imageData.width <= 0 || imageData.height <= 0)
             {
-                VK_LOG_ERROR("Texture::load failed :: invalid embedded glTF image: %s (%dx%d)", imageName.c_str(), imageData.width, imageData.height);
+                VK_LOG_ERROR("Texture::decode failed :: invalid embedded glTF image: %s (%dx%d)", textureData.mName.c_str(), imageData.width, imageData.height);
                 return false;
             }
         }
         else if (!gltfImage.uri.empty())
         {
             // non-embedded image: load from external file
-            imageName = gltfImage.uri;
-            const std::filesystem::path texturePath = keplar::config::kModelDir / imageName;
-            if (!loadImageData(texturePath.string(), imageData))
+            textureData.mName = gltfImage.uri;
+            const std::filesystem::path texturePath = keplar::config::kModelDir / textureData.mName;
+            if (!loadImageData(texturePath.string(), textureData.mPixels, imageData))
             {
-                VK_LOG_ERROR("Texture::load :: failed to load image data: %s", imageName.c_str());
+                VK_LOG_ERROR("Texture::decode :: failed to load image data: %s", textureData.mName.c_str());
                 return false;
             }
+            imageData.pixels = nullptr;
         }
         else 
         {
-            VK_LOG_ERROR("Texture::load :: glTF image has no embedded data or URI!");
+            VK_LOG_ERROR("Texture::decode :: glTF image has no embedded data or URI!");
             return false;
         }
 
-        // create vulkan image from loaded image info
-        if (!createImage(device, commandPool, imageData, format, genMips))
+        // level 0; pixels held by tinygltf are copied in
+        const uint32_t width    = static_cast<uint32_t>(imageData.width);
+        const uint32_t height   = static_cast<uint32_t>(imageData.height);
+        const uint32_t channels = static_cast<uint32_t>(imageData.channels);
+        textureData.mChannels = channels;
+        textureData.mMipExtents.push_back({ width, height });
+        textureData.mMipOffsets.push_back(0);
+        if (imageData.pixels)
         {
-            VK_LOG_DEBUG("Texture::load :: failed to create vulkan image for loaded glTF image: %s", imageName.c_str());
-            if (!isEmbedded) { stbi_image_free(imageData.pixels); }
-            return false;
+            textureData.mPixels.resize(static_cast<size_t>(width) * height * channels);
+            std::memcpy(textureData.mPixels.data(), imageData.pixels, textureData.mPixels.size());
         }
 
-        // create vulkan image view for sampling
-        if (!createImageView())
+        // each level is filtered from the previous one
+        const bool isSrgb = (format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_B8G8R8A8_SRGB);
+        return !genMips || generateMips(textureData, isSrgb, false, MipFilter::kBox);
+    }
+
+    bool Texture::generateMips(TextureData& textureData, bool isSrgb, bool isNormalMap, MipFilter filter) noexcept
+    {
+        if (textureData.mFormat != VK_FORMAT_UNDEFINED || textureData.mMipExtents.empty() || textureData.mChannels == 0 || textureData.mChannels > 4)
         {
-            VK_LOG_ERROR("Texture::load :: failed to create image view for glTF image: %s", imageName.c_str());
-            if (!isEmbedded) { stbi_image_free(imageData.pixels); }
+            VK_LOG_ERROR("Texture::generateMips :: only decoded 8-bit images are supported: %s", textureData.mName.c_str());
             return false;
         }
 
-        // cleanup for non-embedded image
-        if (!isEmbedded)
+        // lay out the mip chain: level 0 followed by every downsampled level
+        const uint32_t width     = textureData.mMipExtents[0].width;
+        const uint32_t height    = textureData.mMipExtents[0].height;
+        const uint32_t channels  = textureData.mChannels;
+        const uint32_t mipLevels = getMipLevelCount(width, height);
+
+        VkDeviceSize totalSize = 0;
+        textureData.mMipExtents.resize(1);
+        textureData.mMipOffsets.assign(1, 0);
+        for (uint32_t level = 0; level < mipLevels; ++level)
+        {
+            const VkExtent2D extent = { std::max(1u, width >> level), std::max(1u, height >> level) };
+            if (level > 0)
+            {
+                textureData.mMipExtents.push_back(extent);
+                textureData.mMipOffsets.push_back(totalSize);
+            }
+            totalSize += static_cast<VkDeviceSize>(extent.width) * extent.height * channels;
+        }
+        textureData.mPixels.resize(static_cast<size_t>(totalSize));
+
+        // plain color with the box filter: 8-bit averages, as the chain has always been built
+        if (filter == MipFilter::kBox && !isNormalMap)
+        {
+            for (uint32_t level = 1; level < mipLevels; ++level)
+            {
+                const VkExtent2D& srcExtent = textureData.mMipExtents[level - 1];
+                const VkExtent2D& dstExtent = textureData.mMipExtents[level];
+                downsample(textureData.mPixels.data() + textureData.mMipOffsets[level - 1], srcExtent.width, srcExtent.height, 
+                           textureData.mPixels.data() + textureData.mMipOffsets[level], dstExtent.width, dstExtent.height, 
+                           channels, isSrgb);
+            }
+            return true;
+        }
+
+        // kaiser or normal-aware filtering in float, one level resident at a time
+        std::vector<float> source(static_cast<size_t>(width) * height * channels);
+        std::vector<float> target;
+        std::vector<float> scratch;
+        decodeLevel(textureData.mPixels.data(), static_cast<size_t>(width) * height, channels, isSrgb, isNormalMap, source.data());
+        for (uint32_t level = 1; level < mipLevels; ++level)
         {
-            stbi_image_free(imageData.pixels);
+            const VkExtent2D& srcExtent = textureData.mMipExtents[level - 1];
+            const VkExtent2D& dstExtent = textureData.mMipExtents[level];
+            const size_t texelCount = static_cast<size_t>(dstExtent.width) * dstExtent.height;
+            target.resize(texelCount * channels);
+            downsampleFloat(source.data(), srcExtent.width, srcExtent.height, target.data(), dstExtent.width, dstExtent.height, 
+                            channels, filter, scratch);
+            encodeLevel(target.data(), texelCount, channels, isSrgb, isNormalMap, textureData.mPixels.data() + textureData.mMipOffsets[level]);
+            source.swap(target);
         }
 
         return true;
     }
 
-    bool Texture::loadImageData(const std::string& filepath, ImageData& imageData, bool flipY) noexcept
+    bool Texture::upload(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureData& textureData, const VkFormat& format) noexcept
     {
-        // open file in binary mode
-        FILE* file = fopenSafe(filepath, "rb");
-        if (!file)
+        // validate decoded data
+        if (textureData.mPixels.empty() || textureData.mMipExtents.empty() || textureData.mMipExtents.size() != textureData.mMipOffsets.size())
         {
-            VK_LOG_ERROR("Texture::loadImageData :: failed to open texture file: %s", filepath.c_str());
+            VK_LOG_ERROR("Texture::upload :: texture data is empty or has an invalid mip chain: %s", textureData.mName.c_str());
             return false;
         }
 
-        // set vertical flip
-        stbi_set_flip_vertically_on_load(flipY); 
+        TextureDataView view{};
+        view.mPixels     = textureData.mPixels.data();
+        view.mSize       = textureData.mPixels.size();
+        view.mMipExtents = textureData.mMipExtents.data();
+        view.mMipOffsets = textureData.mMipOffsets.data();
+        view.mMipLevels  = static_cast<uint32_t>(textureData.mMipExtents.size());
+        view.mChannels   = textureData.mChannels;
+        view.mFormat     = textureData.mFormat;
+        view.mName       = textureData.mName.c_str();
+        return upload(device, stagingBelt, view, format);
+    }
 
-        // load image data as unsigned byte 
-        imageData.pixels = stbi_load_from_file(file, &imageData.width, &imageData.height, &imageData.channels, STBI_rgb_alpha);
+    bool Texture::upload(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureDataView& textureData, const VkFormat& format) noexcept
+    {
+        return uploadImage(device, stagingBelt, textureData, format, textureData.mMipLevels);
+    }
 
-        // close file 
-        fclose(file);
+    bool Texture::uploadLevels(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureData& textureData, 
+                               const VkFormat& format, uint32_t firstLevel) noexcept
+    {
+        // validate decoded data and the requested level
+        if (textureData.mPixels.empty() || textureData.mMipExtents.empty() || textureData.mMipExtents.size() != textureData.mMipOffsets.size() ||
+            firstLevel >= textureData.mMipExtents.size())
+        {
+            VK_LOG_ERROR("Texture::uploadLevels :: texture data has no level %u: %s", firstLevel, textureData.mName.c_str());
+            return false;
+        }
 
-        // validate image data
-        if (!imageData.pixels || imageData.width <= 0 || imageData.height <= 0)
+        // levels are packed in order, so the tail of the chain is one contiguous range; rebase its offsets onto it
+        const VkDeviceSize baseOffset = textureData.mMipOffsets[firstLevel];
+        std::vector<VkDeviceSize> mipOffsets(textureData.mMipOffsets.begin() + firstLevel, textureData.mMipOffsets.end());
+        for (VkDeviceSize& mipOffset : mipOffsets)
         {
-            VK_LOG_ERROR("Texture::loadImageData :: stbi failed to load pixel data or invalid dimensions: %s (%dx%d)", filepath.c_str(), imageData.width, imageData.height);
-            if (imageData.pixels) { stbi_image_free(imageData.pixels); }
+            mipOffset -= baseOffset;
+        }
+
+        TextureDataView view{};
+        view.mPixels     = textureData.mPixels.data() + baseOffset;
+        view.mSize       = textureData.mPixels.size() - baseOffset;
+        view.mMipExtents = textureData.mMipExtents.data() + firstLevel;
+        view.mMipOffsets = mipOffsets.data();
+        view.mMipLevels  = static_cast<uint32_t>(mipOffsets.size());
+        view.mChannels   = textureData.mChannels;
+        view.mFormat     = textureData.mFormat;
+        view.mName       = textureData.mName.c_str();
+        return uploadImage(device, stagingBelt, view, format, view.mMipLevels);
+    }
+
+    VkDeviceSize Texture::getLevelsSize(const TextureData& textureData, uint32_t firstLevel) noexcept
+    {
+        if (firstLevel >= textureData.mMipOffsets.size())
+        {
+            return 0;
+        }
+        return textureData.mPixels.size() - textureData.mMipOffsets[firstLevel];
+    }
+
+    bool Texture::uploadForMipGeneration(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureData& textureData, 
+                                         const VkFormat& format, uint32_t mipLevels) noexcept
+    {
+        // the compute downsampler reads and writes rgba8 through unorm storage views
+        if ((format != VK_FORMAT_R8G8B8A8_UNORM && format != VK_FORMAT_R8G8B8A8_SRGB) || textureData.mFormat != VK_FORMAT_UNDEFINED || 
+            textureData.mChannels != 4 || textureData.mPixels.empty() || textureData.mMipExtents.empty() || textureData.mMipOffsets.empty())
+        {
+            VK_LOG_ERROR("Texture::uploadForMipGeneration :: only decoded rgba8 images are supported: %s", textureData.mName.c_str());
             return false;
         }
 
-        return true;
+        // only the base level is staged
+        TextureDataView view{};
+        view.mPixels     = textureData.mPixels.data();
+        view.mSize       = textureData.mMipExtents.size() > 1 ? textureData.mMipOffsets[1] : textureData.mPixels.size();
+        view.mMipExtents = textureData.mMipExtents.data();
+        view.mMipOffsets = textureData.mMipOffsets.data();
+        view.mMipLevels  = 1;
+        view.mChannels   = textureData.mChannels;
+        view.mName       = textureData.mName.c_str();
+        return uploadImage(device, stagingBelt, view, format, std::max(1u, mipLevels));
     }
 
-    void Texture::destroy() noexcept
+    bool Texture::uploadArray(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::vector<const TextureData*>& layers,
+                              const VkFormat& format) noexcept
     {
-        if (m_vkImageView != VK_NULL_HANDLE)
+        // every layer must match the first one's chain exactly: the copies of each level share one extent
+        const TextureData* first = layers.empty() ? nullptr : layers.front();
+        const uint32_t maxLayers = device.getPhysicalDeviceProperties().limits.maxImageArrayLayers;
+        if (first == nullptr || first->mPixels.empty() || first->mMipExtents.empty() || first->mMipExtents.size() != first->mMipOffsets.size() ||
+            layers.size() > maxLayers)
         {
-            vkDestroyImageView(m_vkDevice, m_vkImageView, nullptr);
-            m_vkImageView = VK_NULL_HANDLE;
+            VK_LOG_ERROR("Texture::uploadArray :: %zu layers cannot form an image array (limit: %u)", layers.size(), maxLayers);
+            return false;
         }
 
-        if (m_vkImageMemory != VK_NULL_HANDLE)
+        for (const TextureData* layer : layers)
         {
-            vkFreeMemory(m_vkDevice, m_vkImageMemory, nullptr);
-            m_vkImageMemory = VK_NULL_HANDLE;
+            const bool isMatching = layer != nullptr && layer->mPixels.size() == first->mPixels.size() && layer->mChannels == first->mChannels &&
+                                    layer->mFormat == first->mFormat && layer->mMipOffsets == first->mMipOffsets &&
+                                    std::equal(layer->mMipExtents.begin(), layer->mMipExtents.end(), first->mMipExtents.begin(), first->mMipExtents.end(),
+                                               [](const VkExtent2D& a, const VkExtent2D& b) { return a.width == b.width && a.height == b.height; });
+            if (!isMatching)
+            {
+                VK_LOG_ERROR("Texture::uploadArray :: layer %s does not match the chain of %s", layer ? layer->mName.c_str() : "(null)", first->mName.c_str());
+                return false;
+            }
         }
 
-        if (m_vkImage != VK_NULL_HANDLE)
+        const VkFormat uploadFormat = first->mFormat != VK_FORMAT_UNDEFINED ? matchColorSpace(first->mFormat, isSrgbFormat(format)) : format;
+        if (first->mFormat != VK_FORMAT_UNDEFINED && !isFormatSupported(device, uploadFormat))
         {
-            vkDestroyImage(m_vkDevice, m_vkImage, nullptr);
-            m_vkImage = VK_NULL_HANDLE;
+            VK_LOG_ERROR("Texture::uploadArray :: format %s is not supported by the device: %s", string_VkFormat(uploadFormat), first->mName.c_str());
+            return false;
         }
+
+        // set device and image metadata
+        m_vkDevice   = device.getDevice();
+        m_width      = first->mMipExtents[0].width;
+        m_height     = first->mMipExtents[0].height;
+        m_channels   = first->mChannels;
+        m_format     = uploadFormat;
+        m_mipLevels  = static_cast<uint32_t>(first->mMipExtents.size());
+        m_layerCount = static_cast<uint32_t>(layers.size());
+
+        // layers back to back in one staged region; each layer's size is a whole number of texel blocks, so every
+        // level of every layer starts on a block boundary
+        const VkDeviceSize layerSize = first->mPixels.size();
+        std::vector<uint8_t> pixels;
+        pixels.reserve(layerSize * layers.size());
+        for (const TextureData* layer : layers)
+        {
+            pixels.insert(pixels.end(), layer->mPixels.begin(), layer->mPixels.end());
+        }
+
+        const FormatBlockInfo blockInfo = getFormatBlockInfo(m_format);
+        const VkDeviceSize stagingAlignment = blockInfo.mBytes > 0 ? blockInfo.mBytes : m_channels * sizeof(uint8_t);
+        VkBuffer vkBufferStaging = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        if (!stagingBelt.stage(pixels.data(), pixels.size(), stagingAlignment, vkBufferStaging, stagingOffset))
+        {
+            VK_LOG_ERROR("Texture::uploadArray :: failed to stage %u layers: %s", m_layerCount, first->mName.c_str());
+            return false;
+        }
+
+        if (!createVulkanImage(device))
+        {
+            return false;
+        }
+
+        VkImageSubresourceRange subresourceRange{};
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = 0;
+        subresourceRange.levelCount     = m_mipLevels;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = m_layerCount;
+
+        // one copy region per level and layer
+        std::vector<VkBufferImageCopy> bufferImageCopies;
+        bufferImageCopies.reserve(static_cast<size_t>(m_mipLevels) * m_layerCount);
+        for (uint32_t layer = 0; layer < m_layerCount; ++layer)
+        {
+            for (uint32_t level = 0; level < m_mipLevels; ++level)
+            {
+                VkBufferImageCopy bufferImageCopy{};
+                bufferImageCopy.bufferOffset = stagingOffset + layer * layerSize + first->mMipOffsets[level];
+                bufferImageCopy.bufferRowLength = 0;
+                bufferImageCopy.bufferImageHeight = 0;
+                bufferImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                bufferImageCopy.imageSubresource.mipLevel = level;
+                bufferImageCopy.imageSubresource.baseArrayLayer = layer;
+                bufferImageCopy.imageSubresource.layerCount = 1;
+                bufferImageCopy.imageOffset = { 0, 0, 0 };
+                bufferImageCopy.imageExtent = { first->mMipExtents[level].width, first->mMipExtents[level].height, 1 };
+                bufferImageCopies.push_back(bufferImageCopy);
+            }
+        }
+
+        if (!stagingBelt.copyToImage(vkBufferStaging, m_vkImage, subresourceRange, static_cast<uint32_t>(bufferImageCopies.size()), bufferImageCopies.data()))
+        {
+            return false;
+        }
+
+        stagingBelt.transferImageOwnership(m_vkImage, subresourceRange, 
+                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 
+                                           VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+        if (!createImageView() || !createLayerViews())
+        {
+            VK_LOG_ERROR("Texture::uploadArray :: failed to create image views for texture array: %s", first->mName.c_str());
+            return false;
+        }
+
+        return true;
     }
 
-    bool Texture::createImage(const VulkanDevice& device, const VulkanCommandPool& commandPool, const ImageData& imageData, const VkFormat& format, bool genMips) noexcept
+    uint32_t Texture::getMipLevelCount(uint32_t width, uint32_t height) noexcept
     {
+        return 1 + static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(std::max(1u, std::max(width, height))))));
+    }
+
+    bool Texture::uploadImage(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureDataView& textureData, 
+                              const VkFormat& format, uint32_t mipLevels) noexcept
+    {
+        // validate decoded data
+        if (textureData.mPixels == nullptr || textureData.mSize == 0 || textureData.mMipLevels == 0 || 
+            textureData.mMipExtents == nullptr || textureData.mMipOffsets == nullptr)
+        {
+            VK_LOG_ERROR("Texture::upload :: texture data is empty or has an invalid mip chain: %s", textureData.mName);
+            return false;
+        }
+
+        // pre-compressed payloads keep their block format; the requested format only picks srgb or unorm
+        const VkFormat uploadFormat = textureData.mFormat != VK_FORMAT_UNDEFINED ? matchColorSpace(textureData.mFormat, isSrgbFormat(format)) : format;
+        if (textureData.mFormat != VK_FORMAT_UNDEFINED && !isFormatSupported(device, uploadFormat))
+        {
+            VK_LOG_ERROR("Texture::upload :: format %s is not supported by the device: %s", string_VkFormat(uploadFormat), textureData.mName);
+            return false;
+        }
+
         // set device and image metadata
         m_vkDevice  = device.getDevice();
-        m_width     = imageData.width;
-        m_height    = imageData.height;
-        m_channels  = imageData.channels;
-        m_format    = format;
-        m_mipLevels = 1;
+        m_width     = textureData.mMipExtents[0].width;
+        m_height    = textureData.mMipExtents[0].height;
+        m_channels  = textureData.mChannels;
+        m_format    = uploadFormat;
+        m_mipLevels = std::max(mipLevels, textureData.mMipLevels);
 
-        // compute mip levels
-        if (genMips)
+        // levels past the decoded ones are written by the compute downsampler through unorm storage views
+        const bool isMipTarget = m_mipLevels > textureData.mMipLevels;
+
+        // complete chains are written by the cpu straight into the image where the device allows it
+        if (!isMipTarget && device.isHostImageCopySupported(m_format, kTextureUsage))
         {
-            const auto maxDim = max(imageData.width, imageData.height);
-            m_mipLevels += static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(maxDim))));
+            return uploadImageOnHost(device, textureData);
         }
 
-        // compute image size
-        VkDeviceSize imageSize = m_width * m_height * m_channels * sizeof(uint8_t);
-  
-        // ------------------------------------------
-        // ▶ step 1: create host-visible staging buffer and copy image data
-        // ------------------------------------------
+        // stage every mip level in one contiguous region before recording any command; copies start on texel block boundaries
+        const FormatBlockInfo blockInfo = getFormatBlockInfo(m_format);
+        const VkDeviceSize stagingAlignment = blockInfo.mBytes > 0 ? blockInfo.mBytes : m_channels * sizeof(uint8_t);
+        VkBuffer vkBufferStaging = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        if (!stagingBelt.stage(textureData.mPixels, textureData.mSize, stagingAlignment, vkBufferStaging, stagingOffset))
+        {
+            VK_LOG_ERROR("Texture::upload :: failed to stage image data: %s", textureData.mName);
+            return false;
+        }
 
-        // staging buffer creation info
-        VkBufferCreateInfo bufferCreateInfo{};
-        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferCreateInfo.pNext = nullptr;
-        bufferCreateInfo.flags = 0;
-        bufferCreateInfo.size = imageSize;
-        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        // create device-local vulkan image
+        const VkImageCreateFlags createFlags = isMipTarget && isSrgbFormat(m_format) ? 
+                                               VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT : 0;
+        if (!createVulkanImage(device, createFlags, isMipTarget ? VK_IMAGE_USAGE_STORAGE_BIT : 0))
+        {
+            return false;
+        }
 
-        // staging buffer for host-to-device copy
-        VkBuffer vkBufferStaging = VK_NULL_HANDLE;
-        VkResult vkResult = vkCreateBuffer(m_vkDevice, &bufferCreateInfo, nullptr, &vkBufferStaging);
-        if (vkResult != VK_SUCCESS)
+        // whole chain; a single transfer-dst transition covers the levels the compute downsampler writes too
+        VkImageSubresourceRange subresourceRange{};
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = 0;
+        subresourceRange.levelCount     = m_mipLevels;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = 1;
+
+        // one copy region per pre-generated mip level
+        std::vector<VkBufferImageCopy> bufferImageCopies(textureData.mMipLevels);
+        for (uint32_t level = 0; level < textureData.mMipLevels; ++level)
+        {
+            VkBufferImageCopy& bufferImageCopy = bufferImageCopies[level];
+            bufferImageCopy.bufferOffset = stagingOffset + textureData.mMipOffsets[level];
+            bufferImageCopy.bufferRowLength = 0;
+            bufferImageCopy.bufferImageHeight = 0;
+            bufferImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            bufferImageCopy.imageSubresource.mipLevel = level;
+            bufferImageCopy.imageSubresource.baseArrayLayer = 0;
+            bufferImageCopy.imageSubresource.layerCount = 1;
+            bufferImageCopy.imageOffset = { 0, 0, 0 };
+            bufferImageCopy.imageExtent = { textureData.mMipExtents[level].width, textureData.mMipExtents[level].height, 1 };
+        }
+
+        // the belt batches the transition and the copy with those of every other upload in the batch
+        if (!stagingBelt.copyToImage(vkBufferStaging, m_vkImage, subresourceRange, static_cast<uint32_t>(bufferImageCopies.size()), bufferImageCopies.data()))
         {
-            VK_LOG_ERROR("vkCreateBuffer failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // query memory requirements for the staging buffer
-        VkMemoryRequirements memoryRequirements{};
-        vkGetBufferMemoryRequirements(m_vkDevice, vkBufferStaging, &memoryRequirements);
+        // no blits needed: the whole chain goes straight to shader-read on the graphics queue,
+        // or to general for the compute downsampler, which leaves it in shader-read
+        if (isMipTarget)
+        {
+            stagingBelt.transferImageOwnership(m_vkImage, subresourceRange, 
+                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL, 
+                                               VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+        }
+        else
+        {
+            stagingBelt.transferImageOwnership(m_vkImage, subresourceRange, 
+                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 
+                                               VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+        }
 
-        VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        auto memoryTypeIndex = device.findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags);
-        if (!memoryTypeIndex.has_value())
+        // create vulkan image view for sampling
+        if (!createImageView())
         {
+            VK_LOG_ERROR("Texture::upload :: failed to create image view for texture: %s", textureData.mName);
             return false;
         }
 
-        // allocate device memory for the staging buffer
-        VkMemoryAllocateInfo memoryAllocationInfo{};
-        memoryAllocationInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;                  
-        memoryAllocationInfo.pNext = nullptr;                                                    
-        memoryAllocationInfo.allocationSize = memoryRequirements.size;                      
-        memoryAllocationInfo.memoryTypeIndex = *memoryTypeIndex;
+        return true;
+    }
 
-        VkDeviceMemory deviceMemoryStaging = VK_NULL_HANDLE;
-        vkResult = vkAllocateMemory(m_vkDevice, &memoryAllocationInfo, nullptr, &deviceMemoryStaging);
-        if (vkResult != VK_SUCCESS)
+    bool Texture::uploadImageOnHost(const VulkanDevice& device, const TextureDataView& textureData) noexcept
+    {
+        // no staging memory, command buffer or submission: the image is sampled-ready when this returns, and host writes
+        // made before a queue submission are visible to it
+        if (!createVulkanImage(device, 0, VK_IMAGE_USAGE_HOST_TRANSFER_BIT))
         {
-            VK_LOG_FATAL("vkAllocateMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // bind memory to the staging buffer
-        vkResult = vkBindBufferMemory(m_vkDevice, vkBufferStaging, deviceMemoryStaging, 0);
-        if (vkResult != VK_SUCCESS)
+        VkImageSubresourceRange subresourceRange{};
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = 0;
+        subresourceRange.levelCount     = m_mipLevels;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = 1;
+        if (!device.transitionImageLayoutOnHost(m_vkImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange))
         {
-            VK_LOG_FATAL("vkBindBufferMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_ERROR("Texture::upload :: failed to transition image on the host: %s", textureData.mName);
             return false;
         }
 
-        // map staging buffer memory
-        void* mappedData = nullptr;
-        vkResult = vkMapMemory(m_vkDevice, deviceMemoryStaging, 0, imageSize, 0, &mappedData);
-        if (vkResult != VK_SUCCESS)
+        // one copy region per mip level, read in place from the decoded chain
+        std::vector<VkMemoryToImageCopy> memoryImageCopies(textureData.mMipLevels);
+        for (uint32_t level = 0; level < textureData.mMipLevels; ++level)
+        {
+            VkMemoryToImageCopy& memoryImageCopy = memoryImageCopies[level];
+            memoryImageCopy.sType = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY;
+            memoryImageCopy.pNext = nullptr;
+            memoryImageCopy.pHostPointer = textureData.mPixels + textureData.mMipOffsets[level];
+            memoryImageCopy.memoryRowLength = 0;
+            memoryImageCopy.memoryImageHeight = 0;
+            memoryImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            memoryImageCopy.imageSubresource.mipLevel = level;
+            memoryImageCopy.imageSubresource.baseArrayLayer = 0;
+            memoryImageCopy.imageSubresource.layerCount = 1;
+            memoryImageCopy.imageOffset = { 0, 0, 0 };
+            memoryImageCopy.imageExtent = { textureData.mMipExtents[level].width, textureData.mMipExtents[level].height, 1 };
+        }
+
+        if (!device.copyMemoryToImage(m_vkImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, static_cast<uint32_t>(memoryImageCopies.size()), memoryImageCopies.data()))
         {
-            VK_LOG_FATAL("vkMapMemory failed for staging buffer : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_ERROR("Texture::upload :: failed to copy image data on the host: %s", textureData.mName);
             return false;
         }
 
-        // copy pixel data to staging buffer
-        std::memcpy(mappedData, imageData.pixels, imageSize);
-        vkUnmapMemory(m_vkDevice, deviceMemoryStaging);
+        // create vulkan image view for sampling
+        if (!createImageView())
+        {
+            VK_LOG_ERROR("Texture::upload :: failed to create image view for texture: %s", textureData.mName);
+            return false;
+        }
 
-        // ------------------------------------------
-        // ▶ step 2: create device-local vulkan image
-        // ------------------------------------------
+        return true;
+    }
 
-        // image creation info
-        VkImageCreateInfo imageCreateInfo{};
-        imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        imageCreateInfo.pNext = nullptr;
-        imageCreateInfo.flags = 0;
-        imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-        imageCreateInfo.format = m_format;
-        imageCreateInfo.extent.width = m_width;
-        imageCreateInfo.extent.height = m_height;
-        imageCreateInfo.extent.depth = 1;
-        imageCreateInfo.mipLevels = m_mipLevels;
-        imageCreateInfo.arrayLayers = 1;
-        imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-        imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-        imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    bool Texture::decodeKTX2(const uint8_t* data, size_t size, const std::string& name, TextureData& textureData, VkFormat transcodeFormat) noexcept
+    {
+        // basis universal payloads have no vulkan format and are transcoded to the requested target
+        if (basis_transcoder::isTranscodable(data, size))
+        {
+            const VkFormat targetFormat = transcodeFormat != VK_FORMAT_UNDEFINED ? transcodeFormat : VK_FORMAT_R8G8B8A8_UNORM;
+            return basis_transcoder::transcodeKTX2(data, size, targetFormat, name, textureData);
+        }
 
-        // create image 
-        vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &m_vkImage);
-        if (vkResult != VK_SUCCESS)
+        textureData = TextureData{};
+        textureData.mName = name;
+
+        // validate the container
+        KTX2Header header{};
+        if (data == nullptr || size < sizeof(header))
         {
-            VK_LOG_FATAL("vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_ERROR("Texture::decodeKTX2 :: truncated ktx2 data: %s", name.c_str());
             return false;
         }
 
-        // query memory requirements
-        VkMemoryRequirements vkMemoryRequirements{};
-        vkGetImageMemoryRequirements(m_vkDevice, m_vkImage, &vkMemoryRequirements);
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.mIdentifier, kKTX2Identifier, sizeof(kKTX2Identifier)) != 0)
+        {
+            VK_LOG_ERROR("Texture::decodeKTX2 :: not a ktx2 container: %s", name.c_str());
+            return false;
+        }
 
-        // find suitable memory type
-        memoryTypeIndex = device.findMemoryType(vkMemoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        if (!memoryTypeIndex.has_value())
+        // zstd or zlib over a regular vulkan format is not handled
+        if (header.mSupercompressionScheme != 0 || header.mVkFormat == VK_FORMAT_UNDEFINED)
         {
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_ERROR("Texture::decodeKTX2 :: supercompressed ktx2 is not supported: %s (scheme: %u)", 
+                         name.c_str(), header.mSupercompressionScheme);
             return false;
         }
 
-        // allocate device memory from vulkan heap
-        VkMemoryAllocateInfo vkMemoryAllocateInfo{};
-        vkMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        vkMemoryAllocateInfo.pNext = nullptr;
-        vkMemoryAllocateInfo.allocationSize = vkMemoryRequirements.size;
-        vkMemoryAllocateInfo.memoryTypeIndex = *memoryTypeIndex;
+        const VkFormat format = static_cast<VkFormat>(header.mVkFormat);
+        const FormatBlockInfo blockInfo = getFormatBlockInfo(format);
+        if (blockInfo.mBytes == 0 || header.mPixelWidth == 0 || header.mPixelHeight == 0 || header.mPixelDepth > 1 || 
+            header.mLayerCount > 1 || header.mFaceCount != 1)
+        {
+            VK_LOG_ERROR("Texture::decodeKTX2 :: only single 2d images in known formats are supported: %s (format: %s)", 
+                         name.c_str(), string_VkFormat(format));
+            return false;
+        }
 
-        vkResult = vkAllocateMemory(m_vkDevice, &vkMemoryAllocateInfo, nullptr, &m_vkImageMemory);
-        if (vkResult != VK_SUCCESS)
+        // level 0 is the full-resolution image; a level count of 0 asks for runtime generation, so only the base level is uploaded
+        const uint32_t levelCount = std::max(1u, header.mLevelCount);
+        if (size < sizeof(header) + levelCount * sizeof(KTX2LevelIndex))
         {
-            VK_LOG_FATAL("vkAllocateMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_ERROR("Texture::decodeKTX2 :: truncated level index: %s", name.c_str());
             return false;
         }
 
-        // bind memory to image
-        vkResult = vkBindImageMemory(m_vkDevice, m_vkImage, m_vkImageMemory, 0);
-        if (vkResult != VK_SUCCESS)
+        std::vector<KTX2LevelIndex> levels(levelCount);
+        std::memcpy(levels.data(), data + sizeof(header), levelCount * sizeof(KTX2LevelIndex));
+
+        // repack the levels back to back, largest first
+        VkDeviceSize totalSize = 0;
+        textureData.mMipExtents.reserve(levelCount);
+        textureData.mMipOffsets.reserve(levelCount);
+        for (uint32_t level = 0; level < levelCount; ++level)
         {
-            VK_LOG_FATAL("vkBindImageMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            const VkExtent2D extent = { std::max(1u, header.mPixelWidth >> level), std::max(1u, header.mPixelHeight >> level) };
+            const VkDeviceSize levelSize = getLevelSize(format, extent.width, extent.height, blockInfo.mChannels);
+            if (levels[level].mByteLength < levelSize || levels[level].mByteOffset > size || levelSize > size - levels[level].mByteOffset)
+            {
+                VK_LOG_ERROR("Texture::decodeKTX2 :: level %u is out of bounds: %s", level, name.c_str());
+                return false;
+            }
+
+            textureData.mMipExtents.push_back(extent);
+            textureData.mMipOffsets.push_back(totalSize);
+            totalSize += levelSize;
+        }
+
+        textureData.mPixels.resize(static_cast<size_t>(totalSize));
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            const VkDeviceSize levelSize = (level + 1 < levelCount ? textureData.mMipOffsets[level + 1] : totalSize) - textureData.mMipOffsets[level];
+            std::memcpy(textureData.mPixels.data() + textureData.mMipOffsets[level], data + levels[level].mByteOffset, static_cast<size_t>(levelSize));
+        }
+
+        textureData.mChannels = blockInfo.mChannels;
+        textureData.mFormat   = format;
+        return true;
+    }
+
+    bool Texture::decodeKTX2(const std::string& filepath, TextureData& textureData, VkFormat transcodeFormat) noexcept
+    {
+        // stored packed files are decoded in place, compressed ones from their decompressed copy
+        std::vector<uint8_t> packedStorage;
+        const uint8_t* packedData = nullptr;
+        size_t packedSize = 0;
+        if (AssetPack::getInstance().load(filepath, packedStorage, packedData, packedSize))
+        {
+            return decodeKTX2(packedData, packedSize, filepath, textureData, transcodeFormat);
+        }
+
+        // the levels are copied out of the mapping, which is released on return
+        MappedFile file;
+        if (!file.open(filepath))
+        {
+            VK_LOG_ERROR("Texture::decodeKTX2 :: failed to open file: %s", filepath.c_str());
             return false;
         }
+        return decodeKTX2(file.getData(), file.getSize(), filepath, textureData, transcodeFormat);
+    }
 
-        // ------------------------------------------
-        // ▶ step 3: allocate and begin one time submit command buffer
-        // ------------------------------------------
+    bool Texture::isFormatSupported(const VulkanDevice& device, VkFormat format) noexcept
+    {
+        // compressed formats are only legal with their feature enabled, regardless of the reported format properties
+        const VkPhysicalDeviceFeatures& enabledFeatures = device.getEnabledFeatures();
+        if ((isBCFormat(format) && enabledFeatures.textureCompressionBC != VK_TRUE) || 
+            (isASTCFormat(format) && enabledFeatures.textureCompressionASTC_LDR != VK_TRUE))
+        {
+            return false;
+        }
+        return device.isFormatSupported(format, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+    }
+
+    VkFormat Texture::selectCompressedFormat(const VulkanDevice& device, bool isNormalMap, bool isSrgb) noexcept
+    {
+        // desktop: bc5 keeps two full-precision channels for normals, bc7 covers color and data maps
+        const VkFormat bcFormat = isNormalMap ? VK_FORMAT_BC5_UNORM_BLOCK : (isSrgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK);
+        if (isFormatSupported(device, bcFormat))
+        {
+            return bcFormat;
+        }
 
-        // allocate command buffer from pool 
-        auto commandBuffer = commandPool.allocatePrimary();
-        if (!commandBuffer.isValid())
+        // mobile and tile-based gpus
+        const VkFormat astcFormat = (isSrgb && !isNormalMap) ? VK_FORMAT_ASTC_4x4_SRGB_BLOCK : VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        if (isFormatSupported(device, astcFormat))
         {
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            return astcFormat;
+        }
+        return VK_FORMAT_UNDEFINED;
+    }
+
+    VkDeviceSize Texture::getLevelSize(VkFormat format, uint32_t width, uint32_t height, uint32_t channels) noexcept
+    {
+        // block formats round partial blocks at the edges up to whole blocks
+        const FormatBlockInfo blockInfo = getFormatBlockInfo(format);
+        if (blockInfo.mBytes == 0)
+        {
+            return static_cast<VkDeviceSize>(width) * height * channels;
+        }
+
+        const VkDeviceSize blocksX = (width + blockInfo.mWidth - 1) / blockInfo.mWidth;
+        const VkDeviceSize blocksY = (height + blockInfo.mHeight - 1) / blockInfo.mHeight;
+        return blocksX * blocksY * blockInfo.mBytes;
+    }
+
+    VkFormat Texture::getUploadFormat(const TextureData& textureData, const VkFormat& format) noexcept
+    {
+        return textureData.mFormat != VK_FORMAT_UNDEFINED ? matchColorSpace(textureData.mFormat, isSrgbFormat(format)) : format;
+    }
+
+    VkDeviceSize Texture::getStagingAlignment(VkFormat format, uint32_t channels) noexcept
+    {
+        const FormatBlockInfo blockInfo = getFormatBlockInfo(format);
+        return blockInfo.mBytes > 0 ? blockInfo.mBytes : std::max(1u, channels) * sizeof(uint8_t);
+    }
+
+    bool Texture::loadImageData(const std::string& filepath, std::vector<uint8_t>& pixels, ImageData& imageData, bool flipY) noexcept
+    {
+        // read the whole file through the thread's i/o queue, then decode from memory
+        std::vector<uint8_t> fileData;
+        if (!AsyncFileIO::getThreadInstance().readFile(filepath, fileData) || fileData.empty())
+        {
+            VK_LOG_ERROR("Texture::loadImageData :: failed to open texture file: %s", filepath.c_str());
             return false;
         }
 
-        // begin recording commands 
-        if (!commandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+        // rgba8 rows straight from the decoder
+        uint32_t width = 0;
+        uint32_t height = 0;
+        if (!image_decoder::decodeRGBA8(fileData.data(), fileData.size(), flipY, pixels, width, height))
         {
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_ERROR("Texture::loadImageData :: %s failed to decode pixel data: %s", image_decoder::getBackendName(fileData.data(), fileData.size()),
+                         filepath.c_str());
             return false;
         }
 
+        imageData.pixels   = pixels.data();
+        imageData.width    = static_cast<int>(width);
+        imageData.height   = static_cast<int>(height);
+        imageData.channels = 4;
+        return true;
+    }
+
+    void Texture::destroy() noexcept
+    {
+        for (VkImageView vkLayerView : m_vkLayerViews)
+        {
+            vkDestroyImageView(m_vkDevice, vkLayerView, nullptr);
+        }
+        m_vkLayerViews.clear();
+        m_layerCount = 1;
+
+        if (m_vkImageView != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(m_vkDevice, m_vkImageView, nullptr);
+            m_vkImageView = VK_NULL_HANDLE;
+        }
+
+        if (m_vkImage != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(m_vkDevice, m_vkImage, nullptr);
+            m_vkImage = VK_NULL_HANDLE;
+        }
+
+        if (m_memoryAllocator && m_allocation.isValid())
+        {
+            m_memoryAllocator->free(m_allocation);
+        }
+    }
+
+    bool Texture::createImage(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const ImageData& imageData, const VkFormat& format, bool genMips) noexcept
+    {
+        // set device and image metadata
+        m_vkDevice  = device.getDevice();
+        m_width     = imageData.width;
+        m_height    = imageData.height;
+        m_channels  = imageData.channels;
+        m_format    = format;
+        m_mipLevels = 1;
+
+        // compute mip levels
+        if (genMips)
+        {
+            const auto maxDim = max(imageData.width, imageData.height);
+            m_mipLevels += static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(maxDim))));
+        }
+
+        // compute image size
+        VkDeviceSize imageSize = m_width * m_height * m_channels * sizeof(uint8_t);
+  
         // ------------------------------------------
-        // ▶ step 4: pipeline barrier to transition image layout for transfer 
+        // ▶ step 1: copy image data into the shared staging belt
         // ------------------------------------------
 
-        // transition image from undefined to transfer-dst for staging copy
-        auto srcStage       = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        auto dstStage       = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        auto oldLayout      = VK_IMAGE_LAYOUT_UNDEFINED;
-        auto newLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        auto srcAccessMask  = 0;
-        auto dstAccessMask  = VK_ACCESS_TRANSFER_WRITE_BIT;
-        auto baseMipLevel   = 0;
-        auto levelCount     = m_mipLevels;
+        // staged before any command is recorded, staging may submit the pending batch
+        VkBuffer vkBufferStaging = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        if (!stagingBelt.stage(imageData.pixels, imageSize, m_channels * sizeof(uint8_t), vkBufferStaging, stagingOffset))
+        {
+            VK_LOG_ERROR("Texture::createImage :: failed to stage image data");
+            return false;
+        }
 
-        // execute image layout transition
-        transitionImageLayout(commandBuffer.get(), srcStage, dstStage, oldLayout, newLayout, srcAccessMask, dstAccessMask, baseMipLevel, levelCount);
+        // ------------------------------------------
+        // ▶ step 2: create device-local vulkan image
+        // ------------------------------------------
+
+        if (!createVulkanImage(device))
+        {
+            return false;
+        }
 
         // ------------------------------------------
-        // ▶ step 5: copy data from staging buffer to device-local image 
+        // ▶ step 3: describe the copy from the staging region to the device-local image 
         // ------------------------------------------
 
         // buffer image copy info
         VkBufferImageCopy bufferImageCopy{};
-        bufferImageCopy.bufferOffset = 0;
+        bufferImageCopy.bufferOffset = stagingOffset;
         bufferImageCopy.bufferRowLength = 0;
         bufferImageCopy.bufferImageHeight = 0;
         bufferImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -483,82 +1321,92 @@ namespace keplar
         bufferImageCopy.imageExtent.height = m_height;
         bufferImageCopy.imageExtent.depth = 1;
 
-        // copy buffer to image
-        vkCmdCopyBufferToImage(commandBuffer.get(), vkBufferStaging, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferImageCopy);
-
         // ------------------------------------------
-        // ▶ step 6: pipeline barrier to transition image layout to shader-read (generate mipmaps if enabled)
+        // ▶ step 4: transition to transfer-dst and copy, batched by the staging belt
         // ------------------------------------------
 
-        if (genMips) 
-        { 
-            // generate all mip levels and transition them to shader-read layout
-            generateMipmaps(commandBuffer.get());
-        }
-        else 
-        {
-            // transition image from transfer-dst to shader-read for sampling
-            srcStage      = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage      = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        // whole image; copies may run on the transfer queue, so the image is handed to the graphics queue below
+        VkImageSubresourceRange subresourceRange{};
+        subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        subresourceRange.baseMipLevel   = 0;
+        subresourceRange.levelCount     = m_mipLevels;
+        subresourceRange.baseArrayLayer = 0;
+        subresourceRange.layerCount     = 1;
 
-            // execute image layout transition
-            transitionImageLayout(commandBuffer.get(), srcStage, dstStage, oldLayout, newLayout, srcAccessMask, dstAccessMask, baseMipLevel, levelCount);
+        // every level goes to transfer-dst: level 0 for the copy, the rest for the mip blits
+        if (!stagingBelt.copyToImage(vkBufferStaging, m_vkImage, subresourceRange, 1, &bufferImageCopy))
+        {
+            return false;
         }
 
         // ------------------------------------------
-        // ▶ step 7: submit command buffer and wait for completion
+        // ▶ step 5: transition image layout to shader-read (generate mipmaps if enabled)
         // ------------------------------------------
 
-        // end recording commands
-        if (!commandBuffer.end())
+        if (genMips) 
+        { 
+            // blits need a graphics-capable queue: acquire in transfer-dst layout, then generate all mip levels
+            stagingBelt.transferImageOwnership(m_vkImage, subresourceRange, 
+                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 
+                                               VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+            VkCommandBuffer graphicsCommandBuffer = stagingBelt.getGraphicsCommandBuffer();
+            if (graphicsCommandBuffer == VK_NULL_HANDLE)
+            {
+                VK_LOG_ERROR("Texture::createImage :: failed to get staging belt graphics command buffer");
+                return false;
+            }
+
+            generateMipmaps(graphicsCommandBuffer);
+        }
+        else 
         {
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
-            return false;
+            // transition image from transfer-dst to shader-read for sampling (acquired by the graphics queue)
+            stagingBelt.transferImageOwnership(m_vkImage, subresourceRange, 
+                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 
+                                               VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
         }
 
-        // create a fence 
-        VkFenceCreateInfo fenceCreateInfo{};
-        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceCreateInfo.pNext = nullptr;
-        fenceCreateInfo.flags = 0;  
+        // submitted with the rest of the belt batch on flush
+        return true;
+    }
 
-        VulkanFence copyFence;
-        if (!copyFence.initialize(m_vkDevice, fenceCreateInfo))
+    bool Texture::createVulkanImage(const VulkanDevice& device, VkImageCreateFlags createFlags, VkImageUsageFlags extraUsage) noexcept
+    {
+        // image creation info
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.pNext = nullptr;
+        imageCreateInfo.flags = createFlags;
+        imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format = m_format;
+        imageCreateInfo.extent.width = m_width;
+        imageCreateInfo.extent.height = m_height;
+        imageCreateInfo.extent.depth = 1;
+        imageCreateInfo.mipLevels = m_mipLevels;
+        imageCreateInfo.arrayLayers = m_layerCount;
+        imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage = kTextureUsage | extraUsage;
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        // create image 
+        VkResult vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &m_vkImage);
+        if (vkResult != VK_SUCCESS)
         {
-            VK_LOG_FATAL("failed for create fence");
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_FATAL("vkCreateImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // submit info for executing the command buffer
-        VkCommandBuffer vkCommandBuffer = commandBuffer.get();
-        VkSubmitInfo vkSubmitInfo{};
-        vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        vkSubmitInfo.pNext = nullptr;
-        vkSubmitInfo.commandBufferCount = 1;
-        vkSubmitInfo.pCommandBuffers = &vkCommandBuffer;
-
-        // submit the copy command and signal the fence on completion
-        vkResult = vkQueueSubmit(device.getGraphicsQueue(), 1, &vkSubmitInfo, copyFence.get());
-        if (vkResult != VK_SUCCESS)
+        // sub-allocate and bind device-local memory for the image
+        m_memoryAllocator = &device.getMemoryAllocator();
+        if (!m_memoryAllocator->allocateImageMemory(m_vkImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_allocation))
         {
-            VK_LOG_FATAL("vkQueueSubmit failed for buffer copy from host to device : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_FATAL("Texture::createVulkanImage :: failed to allocate image memory");
             return false;
         }
 
-        // cleanup staging resources 
-        copyFence.wait();
-        commandPool.deallocate(commandBuffer);
-        vkFreeMemory(m_vkDevice, deviceMemoryStaging, nullptr);
-        vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
         return true;
     }
 
@@ -571,7 +1419,7 @@ namespace keplar
         imageViewCreateInfo.flags = 0;
         imageViewCreateInfo.image = m_vkImage;
         imageViewCreateInfo.format = m_format;
-        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewCreateInfo.viewType = m_layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
         imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_R;
         imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_G;
         imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_B;
@@ -580,7 +1428,7 @@ namespace keplar
         imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
         imageViewCreateInfo.subresourceRange.levelCount = m_mipLevels;
         imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
-        imageViewCreateInfo.subresourceRange.layerCount = 1;
+        imageViewCreateInfo.subresourceRange.layerCount = m_layerCount;
 
         // create texture image view
         VkResult vkResult = vkCreateImageView(m_vkDevice, &imageViewCreateInfo, nullptr, &m_vkImageView);
@@ -593,6 +1441,43 @@ namespace keplar
         return true;
     }
 
+    bool Texture::createLayerViews() noexcept
+    {
+        VkImageViewCreateInfo imageViewCreateInfo{};
+        imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        imageViewCreateInfo.pNext = nullptr;
+        imageViewCreateInfo.flags = 0;
+        imageViewCreateInfo.image = m_vkImage;
+        imageViewCreateInfo.format = m_format;
+        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+        imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+        imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+        imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+        imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+        imageViewCreateInfo.subresourceRange.levelCount = m_mipLevels;
+        imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+        // a 2d view per layer, so sampler2D bindings read a layer like an image of its own
+        m_vkLayerViews.reserve(m_layerCount);
+        for (uint32_t layer = 0; layer < m_layerCount; ++layer)
+        {
+            imageViewCreateInfo.subresourceRange.baseArrayLayer = layer;
+
+            VkImageView vkLayerView = VK_NULL_HANDLE;
+            VkResult vkResult = vkCreateImageView(m_vkDevice, &imageViewCreateInfo, nullptr, &vkLayerView);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("vkCreateImageView failed to create view for texture layer %u : %s (code: %d)", layer, string_VkResult(vkResult), vkResult);
+                return false;
+            }
+            m_vkLayerViews.push_back(vkLayerView);
+        }
+
+        return true;
+    }
+
     void Texture::generateMipmaps(VkCommandBuffer commandBuffer) noexcept
     {
         // validate mip levels
@@ -605,37 +1490,18 @@ namespace keplar
         int32_t mipWidth  = m_width;
         int32_t mipHeight = m_height;
 
-        // local variables for pipeline stages and layout transitions during mipmap generation
-        VkPipelineStageFlags  srcStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        VkPipelineStageFlags  dstStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        VkImageLayout         oldLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-        VkImageLayout         newLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-        VkAccessFlags         srcAccess    = 0;
-        VkAccessFlags         dstAccess    = 0;
-        uint32_t              baseMipLevel = 0;
-        uint32_t              levelCount   = 1;
+        // every level arrives in transfer-dst. one barrier ahead of each blit turns the previous level into the blit
+        // source and hands the level before it, which the last blit finished reading, to the fragment shader
+        VulkanBarrierBatch barriers;
+        auto levelRange = [](uint32_t level) { return VkImageSubresourceRange{ VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 }; };
 
         for (uint32_t i = 1; i < m_mipLevels; ++i)
         {
-            // transition previous mip level from transfer-dst -> transfer-src
-            srcStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            oldLayout    = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            newLayout    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            srcAccess    = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dstAccess    = VK_ACCESS_TRANSFER_READ_BIT;
-            baseMipLevel = i - 1;
-
-            transitionImageLayout(commandBuffer, srcStage, dstStage, oldLayout, newLayout, srcAccess, dstAccess, baseMipLevel, levelCount);
-
-            // transition current mip level from undefined -> transfer-dst
-            oldLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-            newLayout    = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            srcAccess    = 0;
-            dstAccess    = VK_ACCESS_TRANSFER_WRITE_BIT;
-            baseMipLevel = i;
-
-            transitionImageLayout(commandBuffer, srcStage, dstStage, oldLayout, newLayout, srcAccess, dstAccess, baseMipLevel, levelCount);
+            // transition previous mip level from transfer-dst -> transfer-src (written by the copy or the previous blit)
+            barriers.imageBarrier(m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, levelRange(i - 1),
+                                  VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                  VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+            barriers.flush(commandBuffer);
 
             // blit previous mip level into current mip level
             VkImageBlit blit{};
@@ -656,16 +1522,10 @@ namespace keplar
 
             vkCmdBlitImage(commandBuffer, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
 
-            // transition previous mip level from transfer-src -> shader-read
-            srcStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dstStage     = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            oldLayout    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            newLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            srcAccess    = VK_ACCESS_TRANSFER_READ_BIT;
-            dstAccess    = VK_ACCESS_SHADER_READ_BIT;
-            baseMipLevel = i - 1;
-
-            transitionImageLayout(commandBuffer, srcStage, dstStage, oldLayout, newLayout, srcAccess, dstAccess, baseMipLevel, levelCount);
+            // transition previous mip level from transfer-src -> shader-read, recorded with the next level's barrier
+            barriers.imageBarrier(m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, levelRange(i - 1),
+                                  VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_NONE,
+                                  VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
 
             // halve the dimensions for the next mip level
             mipWidth  = max(1, mipWidth / 2);
@@ -673,40 +1533,9 @@ namespace keplar
         }
 
         // transition last mip level from transfer-dst -> shader-read
-        srcStage     = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dstStage     = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-        oldLayout    = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        newLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        srcAccess    = VK_ACCESS_TRANSFER_WRITE_BIT;
-        dstAccess    = VK_ACCESS_SHADER_READ_BIT;
-        baseMipLevel = m_mipLevels - 1;
-
-        transitionImageLayout(commandBuffer, srcStage, dstStage, oldLayout, newLayout, srcAccess, dstAccess, baseMipLevel, levelCount);
-    }
-
-    void Texture::transitionImageLayout(VkCommandBuffer commandBuffer, 
-                                        VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, 
-                                        VkImageLayout oldLayout, VkImageLayout newLayout, 
-                                        VkAccessFlags srcAccess, VkAccessFlags dstAccess, 
-                                        uint32_t baseMipLevel, uint32_t levelCount) noexcept
-    {
-        // image memory barrier setup
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout = oldLayout;
-        barrier.newLayout = newLayout;
-        barrier.srcAccessMask = srcAccess;
-        barrier.dstAccessMask = dstAccess;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = m_vkImage;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel = baseMipLevel;
-        barrier.subresourceRange.levelCount = levelCount; 
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = 1;
-
-        // execute pipeline barrier
-        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        barriers.imageBarrier(m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, levelRange(m_mipLevels - 1),
+                              VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                              VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+        barriers.flush(commandBuffer);
     }
 }   // namespace keplar
@@ -5,17 +5,47 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "asset_io.hpp"
 #include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+#include "utils/handle_pool.hpp"
 
 namespace keplar
 {
     // forward declarations
     class VulkanDevice;
-    class VulkanCommandPool;
+    class VulkanStagingBelt;
     struct ImageData;
 
+    // cpu mip filter: 2x2 box, or a separable 8-tap kaiser-windowed sinc that keeps more detail (used for bakes)
+    enum class MipFilter : uint8_t { kBox, kKaiser };
+
+    // cpu-side decoded image with its mip chain packed level after level (level 0 first)
+    struct TextureData
+    {
+        std::vector<uint8_t>        mPixels;
+        std::vector<VkExtent2D>     mMipExtents;
+        std::vector<VkDeviceSize>   mMipOffsets;
+        uint32_t                    mChannels = 0;
+        VkFormat                    mFormat = VK_FORMAT_UNDEFINED;     // payload format of pre-compressed data (ktx2); undefined: upload format
+        std::string                 mName;
+    };
+
+    // non-owning view of a decoded mip chain, e.g. pixels read straight from a mapped baked model
+    struct TextureDataView
+    {
+        const uint8_t*      mPixels     = nullptr;
+        VkDeviceSize        mSize       = 0;
+        const VkExtent2D*   mMipExtents = nullptr;
+        const VkDeviceSize* mMipOffsets = nullptr;
+        uint32_t            mMipLevels  = 0;
+        uint32_t            mChannels   = 0;
+        VkFormat            mFormat     = VK_FORMAT_UNDEFINED;
+        const char*         mName       = "";
+    };
+
     class Texture
     {
         public:
@@ -31,13 +61,62 @@ namespace keplar
             Texture(Texture&&) noexcept;
             Texture& operator=(Texture&&) noexcept;
 
-            // usage
-            bool load(const VulkanDevice& device, const VulkanCommandPool& commandPool, const std::string& filepath, const VkFormat& format, 
+            // usage (upload is recorded into the staging belt; the image is ready once the belt is flushed). with host image
+            // copy (VulkanDevice::isHostImageCopySupported) complete chains skip the belt and are ready on return instead
+            bool load(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::string& filepath, const VkFormat& format, 
                       bool flipY = false, bool genMips = true) noexcept;
-            bool load(const VulkanDevice& device, const VulkanCommandPool& commandPool, const tinygltf::Image& gltfImage, const VkFormat& format, 
+            bool load(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const tinygltf::Image& gltfImage, const VkFormat& format, 
                       bool genMips = true) noexcept;
             void destroy() noexcept;
 
+            // two-phase loading: decode() touches no vulkan state and may run on any thread,
+            // upload() stages the decoded mip chain into the belt from the recording thread
+            // encodedData, when given, is the image's encoded file (e.g. a span of its glb buffer view) for loaders that keep no copy;
+            // flipY applies to it, uri images are always flipped like Texture::load flips files
+            static bool decode(const tinygltf::Image& gltfImage, const VkFormat& format, bool genMips, TextureData& textureData, 
+                               VkFormat transcodeFormat = VK_FORMAT_UNDEFINED, const uint8_t* encodedData = nullptr, size_t encodedSize = 0,
+                               bool flipY = false) noexcept;
+            bool upload(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureData& textureData, const VkFormat& format) noexcept;
+            bool upload(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureDataView& textureData, const VkFormat& format) noexcept;
+
+            // partial residency: uploads levels [firstLevel, end) of a decoded chain as an image of its own, so firstLevel
+            // becomes the image's level 0 (texture streaming swaps in a deeper chain once the larger levels are needed)
+            bool uploadLevels(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureData& textureData, 
+                              const VkFormat& format, uint32_t firstLevel) noexcept;
+            static VkDeviceSize getLevelsSize(const TextureData& textureData, uint32_t firstLevel) noexcept;
+
+            // same-shape decoded chains (extent, mip levels, channels and payload format) as the layers of one image array, so
+            // a group of small images takes one image, allocation and bind. getImageView views every layer, getLayerView one
+            bool uploadArray(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const std::vector<const TextureData*>& layers,
+                             const VkFormat& format) noexcept;
+
+            // stages only the base level of a decoded rgba8 image into an image with mipLevels levels, left in general
+            // layout for MipGenerator to fill the rest (see MipGenerationJob)
+            bool uploadForMipGeneration(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureData& textureData, 
+                                        const VkFormat& format, uint32_t mipLevels) noexcept;
+
+            // ktx2 containers with uncompressed, bcn or astc payloads and all their mips (no supercompression).
+            // the payload keeps its block format; only its srgb/unorm variant follows the upload format.
+            // basis universal payloads are transcoded to transcodeFormat (rgba8 when undefined)
+            static bool decodeKTX2(const uint8_t* data, size_t size, const std::string& name, TextureData& textureData, 
+                                   VkFormat transcodeFormat = VK_FORMAT_UNDEFINED) noexcept;
+            static bool decodeKTX2(const std::string& filepath, TextureData& textureData, VkFormat transcodeFormat = VK_FORMAT_UNDEFINED) noexcept;
+
+            // format support: block-compressed formats also need their device feature enabled
+            static bool isFormatSupported(const VulkanDevice& device, VkFormat format) noexcept;
+            static VkFormat selectCompressedFormat(const VulkanDevice& device, bool isNormalMap, bool isSrgb) noexcept;
+            static VkDeviceSize getLevelSize(VkFormat format, uint32_t width, uint32_t height, uint32_t channels) noexcept;
+
+            // the image format a decoded chain uploads as (pre-compressed payloads keep their block format, format picks srgb
+            // or unorm) and the alignment staged copies of it start on
+            static VkFormat getUploadFormat(const TextureData& textureData, const VkFormat& format) noexcept;
+            static VkDeviceSize getStagingAlignment(VkFormat format, uint32_t channels) noexcept;
+            static uint32_t getMipLevelCount(uint32_t width, uint32_t height) noexcept;
+
+            // rebuilds the full chain of a decoded 8-bit image from its level 0 (thread-safe, no vulkan state).
+            // filtering is linear for srgb color; normal maps are averaged as vectors and renormalized
+            static bool generateMips(TextureData& textureData, bool isSrgb, bool isNormalMap, MipFilter filter) noexcept;
+
             // accessors
             VkImage     getImage() const noexcept       { return m_vkImage; }
             VkImageView getImageView() const noexcept   { return m_vkImageView; }
@@ -45,24 +124,29 @@ namespace keplar
             uint32_t    getWidth() const noexcept       { return m_width; }
             uint32_t    getHeight() const noexcept      { return m_height; }
             uint32_t    getChannels() const noexcept    { return m_channels; }
+            VkFormat    getFormat() const noexcept      { return m_format; }
+            VkDeviceSize getMemorySize() const noexcept { return m_allocation.mSize; }
+            uint32_t    getLayerCount() const noexcept  { return m_layerCount; }
+            VkImageView getLayerView(uint32_t layer) const noexcept { return layer < m_vkLayerViews.size() ? m_vkLayerViews[layer] : VK_NULL_HANDLE; }
 
         private:
-            bool loadImageData(const std::string& filepath, ImageData& imageData, bool flipY = true) noexcept;
-            bool createImage(const VulkanDevice& device, const VulkanCommandPool& commandPool, const ImageData& imageData, const VkFormat& format, bool genMips) noexcept;
+            static bool loadImageData(const std::string& filepath, std::vector<uint8_t>& pixels, ImageData& imageData, bool flipY = true) noexcept;
+            bool uploadImage(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const TextureDataView& textureData, 
+                             const VkFormat& format, uint32_t mipLevels) noexcept;
+            bool uploadImageOnHost(const VulkanDevice& device, const TextureDataView& textureData) noexcept;
+            bool createVulkanImage(const VulkanDevice& device, VkImageCreateFlags createFlags = 0, VkImageUsageFlags extraUsage = 0) noexcept;
+            bool createImage(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const ImageData& imageData, const VkFormat& format, bool genMips) noexcept;
             bool createImageView() noexcept;
+            bool createLayerViews() noexcept;
             void generateMipmaps(VkCommandBuffer commandBuffer) noexcept;
-            void transitionImageLayout(VkCommandBuffer commandBuffer, 
-                                       VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, 
-                                       VkImageLayout oldLayout, VkImageLayout newLayout, 
-                                       VkAccessFlags srcAccess, VkAccessFlags dstAccess, 
-                                       uint32_t baseMipLevel, uint32_t levelCount) noexcept;
 
         private:
             // vulkan handles
-            VkDevice        m_vkDevice;
-            VkImage         m_vkImage;
-            VkDeviceMemory  m_vkImageMemory;
-            VkImageView     m_vkImageView;
+            VkDevice                m_vkDevice;
+            VkImage                 m_vkImage;
+            VkImageView             m_vkImageView;
+            VulkanMemoryAllocator*  m_memoryAllocator;
+            VulkanAllocation        m_allocation;
 
             // image data
             uint32_t m_width;
@@ -70,6 +154,14 @@ namespace keplar
             uint32_t m_channels;
             uint32_t m_mipLevels;
             VkFormat m_format;
+
+            // image arrays (see uploadArray): one 2d view per layer
+            uint32_t                 m_layerCount;
+            std::vector<VkImageView> m_vkLayerViews;
     };  
+
+    // textures owned by a pool and referenced by 32-bit generational handles
+    using TextureHandle = Handle<Texture>;
+    using TexturePool   = HandlePool<Texture>;
 }   // namespace keplar
 
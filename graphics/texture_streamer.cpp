@@ -0,0 +1,419 @@
+// ────────────────────────────────────────────
+//  File: texture_streamer.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "texture_streamer.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    TextureStreamer::TextureStreamer() noexcept
+        : m_frame(0)
+        , m_streamedCount(0)
+        , m_pendingCount(0)
+        , m_sparseCount(0)
+        , m_residentBytes(0)
+        , m_isPageCacheFull(false)
+    {
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        destroy();
+    }
+
+    void TextureStreamer::initialize(const TextureStreamerConfig& config) noexcept
+    {
+        destroy();
+        m_config = config;
+        m_config.mTailSize = std::max(1u, m_config.mTailSize);
+        m_config.mRetireFrames = std::max(1u, m_config.mRetireFrames);
+    }
+
+    void TextureStreamer::destroy() noexcept
+    {
+        // pending images may still be written by an upload batch; the caller idles the device before this
+        retireViews(true);
+        m_entries.clear();
+        m_retired.clear();
+        m_pageCache.destroy();
+        m_frame = 0;
+        m_streamedCount = 0;
+        m_pendingCount = 0;
+        m_sparseCount = 0;
+        m_residentBytes = 0;
+        m_isPageCacheFull = false;
+    }
+
+    bool TextureStreamer::add(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, uint32_t textureIndex, TextureData&& textureData,
+                              VkFormat format, Texture& texture) noexcept
+    {
+        if (textureData.mMipExtents.empty())
+        {
+            VK_LOG_ERROR("TextureStreamer::add :: texture data has no levels: %s", textureData.mName.c_str());
+            return false;
+        }
+
+        if (textureIndex >= m_entries.size())
+        {
+            m_entries.resize(textureIndex + 1);
+        }
+
+        // the tail: first level that fits mTailSize (the last level when none does)
+        Entry& entry = m_entries[textureIndex];
+        const uint32_t levelCount = static_cast<uint32_t>(textureData.mMipExtents.size());
+        uint32_t tailLevel = 0;
+        while (tailLevel + 1 < levelCount && std::max(textureData.mMipExtents[tailLevel].width, textureData.mMipExtents[tailLevel].height) > m_config.mTailSize)
+        {
+            ++tailLevel;
+        }
+
+        entry.mFormat    = format;
+        entry.mTailLevel = tailLevel;
+        const bool isSparse = m_config.mUseSparseResidency && tailLevel > 0 && addSparse(device, stagingBelt, entry, textureData, format);
+        if (!isSparse && !texture.uploadLevels(device, stagingBelt, textureData, format, tailLevel))
+        {
+            return false;
+        }
+
+        entry.mResidentLevel   = tailLevel;
+        entry.mRequestedLevel  = tailLevel;
+        entry.mLastNeededFrame = m_frame;
+        entry.mIsStreamed      = tailLevel > 0;
+        m_residentBytes += Texture::getLevelsSize(textureData, tailLevel);
+
+        // a chain that fits the tail is fully resident and needs no cpu copy
+        if (entry.mIsStreamed)
+        {
+            entry.mData = std::move(textureData);
+            ++m_streamedCount;
+        }
+        m_sparseCount += isSparse ? 1 : 0;
+        return true;
+    }
+
+    bool TextureStreamer::addSparse(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, Entry& entry, const TextureData& textureData,
+                                    VkFormat format) noexcept
+    {
+        if (!device.isSparseResidencySupported(Texture::getUploadFormat(textureData, format), SparseTexture::kUsage))
+        {
+            return false;
+        }
+
+        auto sparse = std::make_unique<SparseTexture>();
+        if (!sparse->initialize(device, textureData, format))
+        {
+            return false;
+        }
+
+        // the first sparse chain sizes the pages; without a cache every chain takes the swapping path
+        if (!m_pageCache.isValid() && !m_pageCache.initialize(device, sparse->getMemoryRequirements(), m_config.mSparsePageBudget))
+        {
+            VK_LOG_WARN("TextureStreamer :: no sparse page cache, streaming whole images instead");
+            m_config.mUseSparseResidency = false;
+            return false;
+        }
+
+        // the tail stays bound for the chain's lifetime; a full cache sends the chain down the swapping path
+        VkImageView retiredView = VK_NULL_HANDLE;
+        if (!sparse->commit(m_pageCache, entry.mTailLevel) || !sparse->upload(stagingBelt, textureData, entry.mTailLevel, sparse->getMipLevels()) ||
+            !sparse->setBaseLevel(entry.mTailLevel, retiredView))
+        {
+            return false;
+        }
+
+        entry.mSparse = std::move(sparse);
+        return true;
+    }
+
+    void TextureStreamer::request(uint32_t textureIndex, float footprint) noexcept
+    {
+        if (textureIndex >= m_entries.size() || !m_entries[textureIndex].mIsStreamed)
+        {
+            return;
+        }
+
+        // finest level that still has a texel per covered pixel
+        Entry& entry = m_entries[textureIndex];
+        const VkExtent2D baseExtent = entry.mData.mMipExtents[0];
+        const float baseSize = static_cast<float>(std::max(baseExtent.width, baseExtent.height));
+        const float levelBias = std::floor(std::log2(std::max(1.0f, baseSize / std::max(footprint, 1.0f))));
+        const uint32_t level = std::min(static_cast<uint32_t>(levelBias), entry.mTailLevel);
+        entry.mRequestedLevel = std::min(entry.mRequestedLevel, level);
+    }
+
+    bool TextureStreamer::update(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, TexturePool& textures,
+                                 std::vector<uint32_t>& swappedTextures) noexcept
+    {
+        if (m_streamedCount == 0)
+        {
+            return true;
+        }
+        ++m_frame;
+
+        // images replaced mRetireFrames updates ago are no longer sampled by any frame in flight
+        while (!m_retired.empty() && m_retired.front().mFrame + m_config.mRetireFrames <= m_frame)
+        {
+            m_retired.pop_front();
+        }
+        retireViews(false);
+
+        // swap in the chains whose upload batch fully completed (copies and the graphics-side ownership acquire)
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()) && i < textures.size(); ++i)
+        {
+            Entry& entry = m_entries[i];
+            if (!entry.mIsPending || !stagingBelt.isComplete(entry.mTicket))
+            {
+                continue;
+            }
+
+            // sparse: the new levels were uploaded into the same image, only the view widens
+            if (entry.mSparse)
+            {
+                entry.mIsPending = false;
+                entry.mTicket = VulkanStagingBelt::kInvalidTicket;
+                --m_pendingCount;
+                if (swapSparse(i, entry.mPendingLevel, 0))
+                {
+                    swappedTextures.push_back(i);
+                }
+                continue;
+            }
+
+            m_residentBytes -= Texture::getLevelsSize(entry.mData, entry.mResidentLevel);
+            m_residentBytes += Texture::getLevelsSize(entry.mData, entry.mPendingLevel);
+            m_retired.push_back({ std::move(textures[i]), m_frame });
+            textures[i] = std::move(entry.mPending);
+            entry.mResidentLevel = entry.mPendingLevel;
+            entry.mIsPending = false;
+            entry.mTicket = VulkanStagingBelt::kInvalidTicket;
+            --m_pendingCount;
+            swappedTextures.push_back(i);
+        }
+
+        // candidates: finer levels than resident were asked for, or the resident ones were not
+        std::vector<uint32_t> upgrades;
+        uint32_t evictIndex = UINT32_MAX;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()); ++i)
+        {
+            Entry& entry = m_entries[i];
+            if (!entry.mIsStreamed)
+            {
+                continue;
+            }
+
+            if (entry.mRequestedLevel <= entry.mResidentLevel)
+            {
+                entry.mLastNeededFrame = m_frame;
+            }
+
+            if (!entry.mIsPending && entry.mRequestedLevel < entry.mResidentLevel)
+            {
+                upgrades.push_back(i);
+            }
+            else if (!entry.mIsPending && entry.mRequestedLevel > entry.mResidentLevel &&
+                     (evictIndex == UINT32_MAX || entry.mLastNeededFrame < m_entries[evictIndex].mLastNeededFrame))
+            {
+                evictIndex = i;
+            }
+        }
+
+        // over budget, or out of sparse pages: drop one texture to its requested level per update and hold back every upgrade.
+        // a sparse chain narrows its view at once and unbinds the dropped levels once no frame samples them
+        const MemoryBudget memoryBudget = device.queryMemoryBudget();
+        const VkDeviceSize streamingBudget = static_cast<VkDeviceSize>(static_cast<double>(memoryBudget.mBudget) * m_config.mBudgetUsage);
+        VkDeviceSize projectedUsage = memoryBudget.mUsage;
+        bool isStaged = false;
+        if (projectedUsage > streamingBudget || m_isPageCacheFull)
+        {
+            m_isPageCacheFull = false;
+            if (evictIndex != UINT32_MAX && m_entries[evictIndex].mSparse)
+            {
+                Entry& entry = m_entries[evictIndex];
+                if (swapSparse(evictIndex, entry.mRequestedLevel, entry.mRequestedLevel))
+                {
+                    swappedTextures.push_back(evictIndex);
+                    VK_LOG_DEBUG("TextureStreamer :: over budget, dropping '%s' to level %u", entry.mData.mName.c_str(), entry.mRequestedLevel);
+                }
+            }
+            else if (evictIndex != UINT32_MAX)
+            {
+                Entry& entry = m_entries[evictIndex];
+                if (!stage(device, stagingBelt, entry, entry.mRequestedLevel))
+                {
+                    return false;
+                }
+                isStaged = true;
+                VK_LOG_DEBUG("TextureStreamer :: over budget, dropping '%s' to level %u", entry.mData.mName.c_str(), entry.mRequestedLevel);
+            }
+            upgrades.clear();
+        }
+
+        // largest residency gaps first, within the per-update upload cap and what is left of the budget
+        std::sort(upgrades.begin(), upgrades.end(), [this](uint32_t a, uint32_t b)
+        {
+            return m_entries[a].mResidentLevel - m_entries[a].mRequestedLevel > m_entries[b].mResidentLevel - m_entries[b].mRequestedLevel;
+        });
+
+        VkDeviceSize stagedBytes = 0;
+        for (uint32_t index : upgrades)
+        {
+            Entry& entry = m_entries[index];
+            const VkDeviceSize size = Texture::getLevelsSize(entry.mData, entry.mRequestedLevel);
+            if ((stagedBytes > 0 && stagedBytes + size > m_config.mUploadBytesPerFrame) || projectedUsage + size > streamingBudget)
+            {
+                continue;
+            }
+
+            if (entry.mSparse)
+            {
+                if (!stageSparse(stagingBelt, index, entry.mRequestedLevel, swappedTextures))
+                {
+                    return false;
+                }
+                isStaged |= entry.mIsPending;
+            }
+            else
+            {
+                if (!stage(device, stagingBelt, entry, entry.mRequestedLevel))
+                {
+                    return false;
+                }
+                isStaged = true;
+            }
+            stagedBytes += size;
+            projectedUsage += size;
+        }
+
+        // one batch for everything staged this update; pending entries wait on its ticket
+        if (isStaged)
+        {
+            const VulkanStagingBelt::Ticket ticket = stagingBelt.submit();
+            for (Entry& entry : m_entries)
+            {
+                if (entry.mIsPending && entry.mTicket == VulkanStagingBelt::kInvalidTicket)
+                {
+                    entry.mTicket = ticket;
+                }
+            }
+        }
+
+        // requests are per update
+        for (Entry& entry : m_entries)
+        {
+            entry.mRequestedLevel = entry.mTailLevel;
+        }
+        return true;
+    }
+
+    bool TextureStreamer::isStreamed(uint32_t textureIndex) const noexcept
+    {
+        return textureIndex < m_entries.size() && m_entries[textureIndex].mIsStreamed;
+    }
+
+    uint32_t TextureStreamer::getResidentLevel(uint32_t textureIndex) const noexcept
+    {
+        return isStreamed(textureIndex) ? m_entries[textureIndex].mResidentLevel : 0;
+    }
+
+    VkImageView TextureStreamer::getSparseView(uint32_t textureIndex) const noexcept
+    {
+        return textureIndex < m_entries.size() && m_entries[textureIndex].mSparse ? m_entries[textureIndex].mSparse->getImageView() : VK_NULL_HANDLE;
+    }
+
+    bool TextureStreamer::stage(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, Entry& entry, uint32_t level) noexcept
+    {
+        // the new chain is a separate image: the resident one keeps being sampled until the swap
+        Texture texture;
+        if (!texture.uploadLevels(device, stagingBelt, entry.mData, entry.mFormat, level))
+        {
+            VK_LOG_ERROR("TextureStreamer :: failed to stage level %u of '%s'", level, entry.mData.mName.c_str());
+            return false;
+        }
+
+        entry.mPending = std::move(texture);
+        entry.mPendingLevel = level;
+        entry.mTicket = VulkanStagingBelt::kInvalidTicket;
+        entry.mIsPending = true;
+        ++m_pendingCount;
+        return true;
+    }
+
+    bool TextureStreamer::stageSparse(VulkanStagingBelt& stagingBelt, uint32_t entryIndex, uint32_t level, std::vector<uint32_t>& swappedTextures) noexcept
+    {
+        // no free pages: the next update drops the texture needed least recently instead
+        Entry& entry = m_entries[entryIndex];
+        SparseTexture& sparse = *entry.mSparse;
+        const uint32_t committedLevel = sparse.getCommittedLevel();
+        if (!sparse.commit(m_pageCache, level))
+        {
+            m_isPageCacheFull = true;
+            return true;
+        }
+
+        // levels dropped but not unbound yet still hold their texels
+        if (level >= committedLevel)
+        {
+            if (swapSparse(entryIndex, level, 0))
+            {
+                swappedTextures.push_back(entryIndex);
+            }
+            return true;
+        }
+
+        // only the newly bound levels are uploaded; the view widens once their batch completed
+        if (!sparse.upload(stagingBelt, entry.mData, level, committedLevel))
+        {
+            VK_LOG_ERROR("TextureStreamer :: failed to stage level %u of '%s'", level, entry.mData.mName.c_str());
+            return false;
+        }
+
+        entry.mPendingLevel = level;
+        entry.mTicket = VulkanStagingBelt::kInvalidTicket;
+        entry.mIsPending = true;
+        ++m_pendingCount;
+        return true;
+    }
+
+    bool TextureStreamer::swapSparse(uint32_t entryIndex, uint32_t level, uint32_t releaseLevel) noexcept
+    {
+        Entry& entry = m_entries[entryIndex];
+        VkImageView retiredView = VK_NULL_HANDLE;
+        if (!entry.mSparse->setBaseLevel(level, retiredView))
+        {
+            return false;
+        }
+
+        m_residentBytes -= Texture::getLevelsSize(entry.mData, entry.mResidentLevel);
+        m_residentBytes += Texture::getLevelsSize(entry.mData, level);
+        entry.mResidentLevel = level;
+        m_retiredViews.push_back({ entryIndex, retiredView, releaseLevel, m_frame });
+        return true;
+    }
+
+    void TextureStreamer::retireViews(bool isDestroying) noexcept
+    {
+        while (!m_retiredViews.empty() && (isDestroying || m_retiredViews.front().mFrame + m_config.mRetireFrames <= m_frame))
+        {
+            const RetiredView& retired = m_retiredViews.front();
+            Entry& entry = m_entries[retired.mEntry];
+            if (entry.mSparse)
+            {
+                entry.mSparse->destroyView(retired.mView);
+
+                // levels the chain came back to (or is uploading) since the drop stay bound
+                const uint32_t pendingLevel = entry.mIsPending ? entry.mPendingLevel : UINT32_MAX;
+                if (!isDestroying && retired.mReleaseLevel > 0)
+                {
+                    entry.mSparse->release(std::min({ retired.mReleaseLevel, entry.mResidentLevel, pendingLevel }));
+                }
+            }
+            m_retiredViews.pop_front();
+        }
+    }
+}   // namespace keplar
@@ -0,0 +1,137 @@
+// ────────────────────────────────────────────
+//  File: texture_streamer.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "texture.hpp"
+#include "sparse_texture.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    struct TextureStreamerConfig
+    {
+        uint32_t     mTailSize           = 256;                 // levels up to this size are resident from load on
+        VkDeviceSize mUploadBytesPerFrame = 16ull * 1024 * 1024; // staged per update (one texture always goes through)
+        float        mBudgetUsage        = 0.9f;                // fraction of the device-local budget streaming may grow into
+        uint32_t     mRetireFrames       = 4;                   // updates before a replaced image may be destroyed
+        bool         mUseSparseResidency = false;               // one partially resident image per chain where the device allows
+        VkDeviceSize mSparsePageBudget   = 256ull * 1024 * 1024; // device memory all sparse images share (see SparsePageCache)
+    };
+
+    // mip residency for a set of textures whose decoded chains stay on the cpu. each texture starts with its tail (the
+    // levels no larger than mTailSize); callers request the finest level they need every update, and deeper chains are
+    // uploaded through the staging belt (so on the transfer queue when there is one) and swapped in once their batch
+    // completed, without waiting on it. while device-local usage is over budget, the texture needed least recently at
+    // its resident level is dropped back to what it was last asked for instead.
+    //
+    // a swap replaces the whole image: the caller rewrites the descriptors of the reported textures before recording
+    // with them, and the replaced image is kept alive for mRetireFrames updates for frames still in flight.
+    //
+    // with mUseSparseResidency, chains whose format the device can partially bind become one SparseTexture each instead,
+    // backed by a page cache of mSparsePageBudget: an upgrade binds pages for the new levels only and uploads just those,
+    // a drop narrows the view at once and unbinds the pages mRetireFrames updates later, and levels dropped but not yet
+    // unbound come back without an upload. device memory then follows the levels in use up to the page budget instead of
+    // a second image per swap; a full cache is handled like an exceeded budget. the model's slot of a sparse texture
+    // stays empty and getSparseView resolves it, with swaps reported as before
+    class TextureStreamer final
+    {
+        public:
+            // creation and destruction
+            TextureStreamer() noexcept;
+            ~TextureStreamer();
+
+            // disable copy and move semantics to enforce unique ownership
+            TextureStreamer(const TextureStreamer&) = delete;
+            TextureStreamer& operator=(const TextureStreamer&) = delete;
+            TextureStreamer(TextureStreamer&&) = delete;
+            TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+            void initialize(const TextureStreamerConfig& config = {}) noexcept;
+            void destroy() noexcept;
+
+            // usage: takes over a decoded chain and uploads its tail into texture (an image of its own, see Texture::uploadLevels),
+            // or into a sparse image that leaves texture empty
+            bool add(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, uint32_t textureIndex, TextureData&& textureData,
+                     VkFormat format, Texture& texture) noexcept;
+
+            // usage: per update, how many pixels textureIndex spans on screen; the finest level over all calls is kept
+            void request(uint32_t textureIndex, float footprint) noexcept;
+
+            // usage: once per frame. swaps in completed uploads (their indices are appended to swappedTextures), evicts
+            // under budget pressure, and stages new uploads; returns false only when staging failed
+            bool update(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, TexturePool& textures,
+                        std::vector<uint32_t>& swappedTextures) noexcept;
+
+            // accessors
+            bool isStreamed(uint32_t textureIndex) const noexcept;
+            uint32_t getResidentLevel(uint32_t textureIndex) const noexcept;
+            VkImageView getSparseView(uint32_t textureIndex) const noexcept;
+            uint32_t getSparseTextureCount() const noexcept     { return m_sparseCount; }
+            VkDeviceSize getPageCacheBytes() const noexcept     { return m_pageCache.getAllocatedBytes(); }
+            uint32_t getStreamedTextureCount() const noexcept   { return m_streamedCount; }
+            uint32_t getPendingUploadCount() const noexcept     { return m_pendingCount; }
+            VkDeviceSize getResidentBytes() const noexcept      { return m_residentBytes; }
+
+        private:
+            struct Entry
+            {
+                TextureData                 mData;
+                VkFormat                    mFormat = VK_FORMAT_UNDEFINED;
+                uint32_t                    mTailLevel = 0;
+                uint32_t                    mResidentLevel = 0;
+                uint32_t                    mRequestedLevel = 0;        // reset to the tail after every update
+                uint64_t                    mLastNeededFrame = 0;       // last update that sampled the resident level
+                Texture                     mPending;
+                std::unique_ptr<SparseTexture> mSparse;             // set for sparse chains, with mPending unused
+                uint32_t                    mPendingLevel = 0;
+                VulkanStagingBelt::Ticket   mTicket = VulkanStagingBelt::kInvalidTicket;
+                bool                        mIsPending = false;
+                bool                        mIsStreamed = false;
+            };
+
+            // image replaced by a swap, destroyed once no frame in flight can sample it
+            struct RetiredTexture
+            {
+                Texture     mTexture;
+                uint64_t    mFrame = 0;
+            };
+
+            // view narrowed away from a sparse chain; once no frame samples it, the levels above mReleaseLevel are unbound
+            struct RetiredView
+            {
+                uint32_t    mEntry = 0;
+                VkImageView mView = VK_NULL_HANDLE;
+                uint32_t    mReleaseLevel = 0;
+                uint64_t    mFrame = 0;
+            };
+
+            bool addSparse(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, Entry& entry, const TextureData& textureData,
+                           VkFormat format) noexcept;
+            bool stage(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, Entry& entry, uint32_t level) noexcept;
+            bool stageSparse(VulkanStagingBelt& stagingBelt, uint32_t entryIndex, uint32_t level, std::vector<uint32_t>& swappedTextures) noexcept;
+            bool swapSparse(uint32_t entryIndex, uint32_t level, uint32_t releaseLevel) noexcept;
+            void retireViews(bool isDestroying) noexcept;
+
+        private:
+            TextureStreamerConfig       m_config;
+            SparsePageCache             m_pageCache;        // outlives the sparse chains of m_entries
+            std::vector<Entry>          m_entries;          // indexed like the caller's textures
+            std::deque<RetiredTexture>  m_retired;
+            std::deque<RetiredView>     m_retiredViews;
+            uint64_t                    m_frame;
+            uint32_t                    m_streamedCount;
+            uint32_t                    m_pendingCount;
+            uint32_t                    m_sparseCount;
+            VkDeviceSize                m_residentBytes;
+            bool                        m_isPageCacheFull;  // an upgrade found no free pages last update
+    };
+}   // namespace keplar
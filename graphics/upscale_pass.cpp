@@ -0,0 +1,267 @@
+// ────────────────────────────────────────────
+//  File: upscale_pass.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "upscale_pass.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // descriptor binding of the source (set: 0)
+    constexpr uint32_t kSourceBinding = 0;
+
+    // push constants: source region and sharpening, must match upscale.frag
+    struct UpscalePushConstants
+    {
+        glm::vec4 region;       // xy: rendered extent over the source extent, zw: largest uv inside it
+        glm::vec4 params;       // xy: source texel size in uv, z: sharpness
+    };
+}
+
+namespace keplar
+{
+    UpscalePass::UpscalePass() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkSampler(VK_NULL_HANDLE)
+        , m_vkSetLayout(VK_NULL_HANDLE)
+        , m_vkDescriptorPool(VK_NULL_HANDLE)
+        , m_vkDescriptorSet(VK_NULL_HANDLE)
+        , m_extent{}
+    {
+    }
+
+    UpscalePass::~UpscalePass()
+    {
+        destroy();
+    }
+
+    bool UpscalePass::initialize(const VulkanDevice& device, const UpscalePassShaders& shaders, VkRenderPass renderPass, uint32_t subpass,
+                                 VkExtent2D extent) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_extent = extent;
+        if (renderPass == VK_NULL_HANDLE || extent.width == 0 || extent.height == 0)
+        {
+            VK_LOG_ERROR("UpscalePass::initialize :: invalid render pass or extent");
+            destroy();
+            return false;
+        }
+
+        // bilinear reads clamped to the edge; the shader keeps them inside the rendered region itself
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_LINEAR;
+        samplerInfo.minFilter    = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = 0.0f;
+        samplerInfo.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+        m_vkSampler = device.getSamplerCache().getOrCreate(samplerInfo);
+        if (m_vkSampler == VK_NULL_HANDLE)
+        {
+            destroy();
+            return false;
+        }
+
+        if (!createDescriptorResources(device) || !createPipeline(device, shaders, renderPass, subpass))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("UpscalePass::initialize successful (%ux%u)", extent.width, extent.height);
+        return true;
+    }
+
+    void UpscalePass::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        m_pipeline.destroy();
+
+        // the set is freed with its pool
+        if (m_vkDescriptorPool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, m_vkDescriptorPool, nullptr);
+            m_vkDescriptorPool = VK_NULL_HANDLE;
+            m_vkDescriptorSet = VK_NULL_HANDLE;
+        }
+
+        m_vkSetLayout = VK_NULL_HANDLE;
+        m_vkSampler = VK_NULL_HANDLE;
+        m_extent = {};
+        m_vkDevice = VK_NULL_HANDLE;
+        VK_LOG_DEBUG("upscale pass destroyed successfully");
+    }
+
+    void UpscalePass::bindSource(VkImageView sourceView) noexcept
+    {
+        if (m_vkDescriptorSet == VK_NULL_HANDLE || sourceView == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        const VkDescriptorImageInfo sourceInfo{ m_vkSampler, sourceView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        VkWriteDescriptorSet write{};
+        write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext            = nullptr;
+        write.dstSet           = m_vkDescriptorSet;
+        write.dstBinding       = kSourceBinding;
+        write.dstArrayElement  = 0;
+        write.descriptorCount  = 1;
+        write.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo       = &sourceInfo;
+        write.pBufferInfo      = nullptr;
+        write.pTexelBufferView = nullptr;
+        vkUpdateDescriptorSets(m_vkDevice, 1, &write, 0, nullptr);
+    }
+
+    void UpscalePass::record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float sharpness) const noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        // uv over the output maps onto the rendered region, and bilinear taps stop half a texel inside it
+        const glm::vec2 extent(static_cast<float>(m_extent.width), static_cast<float>(m_extent.height));
+        const glm::vec2 rendered(static_cast<float>(std::clamp(renderExtent.width, 1u, m_extent.width)),
+                                 static_cast<float>(std::clamp(renderExtent.height, 1u, m_extent.height)));
+
+        UpscalePushConstants pushConstants{};
+        pushConstants.region = glm::vec4(rendered / extent, (rendered - 0.5f) / extent);
+        pushConstants.params = glm::vec4(1.0f / extent, glm::clamp(sharpness, 0.0f, 1.0f), 0.0f);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline.getLayout(), 0, 1, &m_vkDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_pipeline.getLayout(), VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    }
+
+    bool UpscalePass::createDescriptorResources(const VulkanDevice& device) noexcept
+    {
+        const std::vector<VkDescriptorSetLayoutBinding> bindings
+        {
+            { kSourceBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr }
+        };
+        m_vkSetLayout = device.getDescriptorSetLayoutCache().getOrCreate(bindings);
+        if (m_vkSetLayout == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        // private pool for the one set; bindSource only rewrites it
+        const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.pNext         = nullptr;
+        poolInfo.flags         = 0;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes    = &poolSize;
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolInfo, nullptr, &m_vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("UpscalePass :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext              = nullptr;
+        allocateInfo.descriptorPool     = m_vkDescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &m_vkSetLayout;
+
+        vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, &m_vkDescriptorSet);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("UpscalePass :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    bool UpscalePass::createPipeline(const VulkanDevice& device, const UpscalePassShaders& shaders, VkRenderPass renderPass, uint32_t subpass) noexcept
+    {
+        // missing spir-v is not fatal; callers render the scene at the output extent instead
+        VulkanShader vertexShader;
+        VulkanShader fragmentShader;
+        if (!vertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, shaders.mVertexFile) ||
+            !fragmentShader.initialize(m_vkDevice, VK_SHADER_STAGE_FRAGMENT_BIT, shaders.mFragmentFile))
+        {
+            VK_LOG_WARN("UpscalePass :: shaders '%s' / '%s' unavailable", shaders.mVertexFile.c_str(), shaders.mFragmentFile.c_str());
+            return false;
+        }
+
+        // the triangle is generated from gl_VertexIndex
+        VkPipelineVertexInputStateCreateInfo vertexInputState{};
+        vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // the output always covers the whole attachment
+        const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(m_extent.width), static_cast<float>(m_extent.height), 0.0f, 1.0f };
+        const VkRect2D scissor{ { 0, 0 }, m_extent };
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.pViewports    = &viewport;
+        viewportState.scissorCount  = 1;
+        viewportState.pScissors     = &scissor;
+
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        rasterizationState.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizationState.cullMode    = VK_CULL_MODE_NONE;
+        rasterizationState.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizationState.lineWidth   = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        multisampleState.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable    = VK_FALSE;
+
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+        colorBlendState.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlendState.attachmentCount = 1;
+        colorBlendState.pAttachments    = &colorBlendAttachment;
+
+        GraphicsPipelineConfig pipelineConfig{};
+        pipelineConfig.mShaderStages         = { vertexShader.getShaderStageInfo(), fragmentShader.getShaderStageInfo() };
+        pipelineConfig.mVertexInputState     = vertexInputState;
+        pipelineConfig.mInputAssemblyState   = inputAssembly;
+        pipelineConfig.mViewportState        = viewportState;
+        pipelineConfig.mRasterizationState   = rasterizationState;
+        pipelineConfig.mMultisampleState     = multisampleState;
+        pipelineConfig.mColorBlendState      = colorBlendState;
+        pipelineConfig.mRenderPass           = renderPass;
+        pipelineConfig.mSubpassIndex         = subpass;
+        pipelineConfig.mDescriptorSetLayouts = { m_vkSetLayout };
+        pipelineConfig.mPushConstantRanges   = { { VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(UpscalePushConstants) } };
+        if (!m_pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
+        {
+            VK_LOG_ERROR("UpscalePass :: failed to create pipeline");
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,69 @@
+// ────────────────────────────────────────────
+//  File: upscale_pass.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <string>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // spir-v of the fullscreen pass
+    struct UpscalePassShaders
+    {
+        std::string mVertexFile;        // fullscreen.vert
+        std::string mFragmentFile;      // upscale.frag
+    };
+
+    // fullscreen pass filling its color attachment from the top-left region of a source image the scene rendered
+    // into at a reduced viewport: bilinear upscale followed by a contrast-adaptive sharpen (see upscale.frag).
+    // the source has the extent of the pass, so only the viewport changes with the render scale and nothing is
+    // reallocated; pass and pipeline are rebuilt with the render graph that owns both images
+    class UpscalePass final
+    {
+        public:
+            // creation and destruction
+            UpscalePass() noexcept;
+            ~UpscalePass();
+
+            // disable copy and move semantics to enforce unique ownership
+            UpscalePass(const UpscalePass&) = delete;
+            UpscalePass& operator=(const UpscalePass&) = delete;
+            UpscalePass(UpscalePass&&) = delete;
+            UpscalePass& operator=(UpscalePass&&) = delete;
+
+            // usage: renderPass and subpass are the graph's upscale pass, a single color attachment of extent
+            bool initialize(const VulkanDevice& device, const UpscalePassShaders& shaders, VkRenderPass renderPass, uint32_t subpass,
+                            VkExtent2D extent) noexcept;
+            void destroy() noexcept;
+
+            // usage: the source image (of the pass extent), sampled in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            void bindSource(VkImageView sourceView) noexcept;
+
+            // usage: inside the pass's subpass; renderExtent is the region of the source the scene rendered into
+            void record(VkCommandBuffer commandBuffer, VkExtent2D renderExtent, float sharpness) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_pipeline.isValid() && m_vkDescriptorSet != VK_NULL_HANDLE; }
+
+        private:
+            bool createDescriptorResources(const VulkanDevice& device) noexcept;
+            bool createPipeline(const VulkanDevice& device, const UpscalePassShaders& shaders, VkRenderPass renderPass, uint32_t subpass) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                    m_vkDevice;
+            VkSampler                   m_vkSampler;            // owned by the device sampler cache
+            VkDescriptorSetLayout       m_vkSetLayout;          // owned by the device layout cache
+            VkDescriptorPool            m_vkDescriptorPool;
+            VkDescriptorSet             m_vkDescriptorSet;
+            VulkanPipeline              m_pipeline;
+            VkExtent2D                  m_extent;
+    };
+}   // namespace keplar
@@ -0,0 +1,139 @@
+// ────────────────────────────────────────────
+//  File: vertex_layout.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "math3d.hpp"
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // bytes of one location of a vertex format, 0 for formats the layout checks do not know
+    constexpr uint32_t getVertexFormatSize(VkFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R32_SFLOAT:          case VK_FORMAT_R32_SINT:            case VK_FORMAT_R32_UINT:
+            case VK_FORMAT_R16G16_SFLOAT:       case VK_FORMAT_R16G16_UNORM:        case VK_FORMAT_R16G16_SNORM:
+            case VK_FORMAT_R16G16_UINT:         case VK_FORMAT_R16G16_SINT:
+            case VK_FORMAT_R8G8B8A8_UNORM:      case VK_FORMAT_R8G8B8A8_SNORM:      case VK_FORMAT_R8G8B8A8_UINT:
+            case VK_FORMAT_R8G8B8A8_SINT:       case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            case VK_FORMAT_A2B10G10R10_SNORM_PACK32:
+                return 4;
+            case VK_FORMAT_R32G32_SFLOAT:       case VK_FORMAT_R32G32_SINT:         case VK_FORMAT_R32G32_UINT:
+            case VK_FORMAT_R16G16B16A16_SFLOAT: case VK_FORMAT_R16G16B16A16_UNORM:  case VK_FORMAT_R16G16B16A16_SNORM:
+            case VK_FORMAT_R16G16B16A16_UINT:   case VK_FORMAT_R16G16B16A16_SINT:
+                return 8;
+            case VK_FORMAT_R32G32B32_SFLOAT:    case VK_FORMAT_R32G32B32_SINT:      case VK_FORMAT_R32G32B32_UINT:
+                return 12;
+            case VK_FORMAT_R32G32B32A32_SFLOAT: case VK_FORMAT_R32G32B32A32_SINT:   case VK_FORMAT_R32G32B32A32_UINT:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    // format a member type is read with unless the attribute names one; matrices take a location per column.
+    // quantized members (e.g. uint16_t[4] read as unorm16) have no default and must name their format
+    template <typename T> struct VertexFormatTraits    { static constexpr VkFormat kFormat = VK_FORMAT_UNDEFINED;           static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<float>        { static constexpr VkFormat kFormat = VK_FORMAT_R32_SFLOAT;          static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<int32_t>      { static constexpr VkFormat kFormat = VK_FORMAT_R32_SINT;            static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<uint32_t>     { static constexpr VkFormat kFormat = VK_FORMAT_R32_UINT;            static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::vec2>    { static constexpr VkFormat kFormat = VK_FORMAT_R32G32_SFLOAT;       static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::vec3>    { static constexpr VkFormat kFormat = VK_FORMAT_R32G32B32_SFLOAT;    static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::vec4>    { static constexpr VkFormat kFormat = VK_FORMAT_R32G32B32A32_SFLOAT; static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::ivec2>   { static constexpr VkFormat kFormat = VK_FORMAT_R32G32_SINT;         static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::ivec4>   { static constexpr VkFormat kFormat = VK_FORMAT_R32G32B32A32_SINT;   static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::uvec2>   { static constexpr VkFormat kFormat = VK_FORMAT_R32G32_UINT;         static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::uvec4>   { static constexpr VkFormat kFormat = VK_FORMAT_R32G32B32A32_UINT;   static constexpr uint32_t kLocationCount = 1; };
+    template <> struct VertexFormatTraits<glm::mat4>    { static constexpr VkFormat kFormat = VK_FORMAT_R32G32B32A32_SFLOAT; static constexpr uint32_t kLocationCount = 4; };
+
+    // one shader input: the first location it occupies, the member it reads and that member's offset in the vertex
+    template <uint32_t Location, typename Member, size_t Offset, VkFormat Format = VertexFormatTraits<Member>::kFormat>
+    struct VertexAttribute
+    {
+        static constexpr uint32_t kLocationCount = VertexFormatTraits<Member>::kLocationCount;
+        static constexpr uint32_t kColumnSize = static_cast<uint32_t>(sizeof(Member) / kLocationCount);
+
+        static_assert(Format != VK_FORMAT_UNDEFINED, "VertexAttribute: the member type has no default format, name one");
+        static_assert(getVertexFormatSize(Format) == 0 || getVertexFormatSize(Format) == kColumnSize,
+                      "VertexAttribute: format size does not match the member");
+
+        template <size_t Count>
+        static constexpr void append(std::array<VkVertexInputAttributeDescription, Count>& attributes, uint32_t& index, uint32_t binding) noexcept
+        {
+            for (uint32_t column = 0; column < kLocationCount; ++column)
+            {
+                attributes[index++] = { Location + column, binding, Format, static_cast<uint32_t>(Offset) + column * kColumnSize };
+            }
+        }
+    };
+
+    // attribute of a vertex struct, its type and offset taken from the member; _AS names the format of quantized members
+    #define KEPLAR_VERTEX_ATTRIBUTE(location, Vertex, member) \
+        ::keplar::VertexAttribute<location, decltype(Vertex::member), offsetof(Vertex, member)>
+    #define KEPLAR_VERTEX_ATTRIBUTE_AS(location, Vertex, member, format) \
+        ::keplar::VertexAttribute<location, decltype(Vertex::member), offsetof(Vertex, member), format>
+
+    // one vertex buffer binding, strided by the vertex type it holds
+    template <uint32_t Binding, typename Vertex, VkVertexInputRate InputRate, typename... Attributes>
+    struct VertexBinding
+    {
+        static constexpr uint32_t          kBinding = Binding;
+        static constexpr uint32_t          kStride = static_cast<uint32_t>(sizeof(Vertex));
+        static constexpr VkVertexInputRate kInputRate = InputRate;
+        static constexpr uint32_t          kAttributeCount = (0 + ... + Attributes::kLocationCount);
+
+        template <size_t Count>
+        static constexpr void append(std::array<VkVertexInputAttributeDescription, Count>& attributes, uint32_t& index) noexcept
+        {
+            (Attributes::append(attributes, index, Binding), ...);
+        }
+    };
+
+    // a tightly packed stream of one type read at one location, e.g. a separate position or color buffer
+    template <uint32_t Binding, uint32_t Location, typename T, VkVertexInputRate InputRate = VK_VERTEX_INPUT_RATE_VERTEX>
+    using VertexStream = VertexBinding<Binding, T, InputRate, VertexAttribute<Location, T, 0>>;
+
+    // attribute descriptions of every binding, in binding order
+    template <typename... Bindings>
+    constexpr std::array<VkVertexInputAttributeDescription, (0 + ... + Bindings::kAttributeCount)> makeVertexAttributes() noexcept
+    {
+        std::array<VkVertexInputAttributeDescription, (0 + ... + Bindings::kAttributeCount)> attributes{};
+        uint32_t index = 0;
+        (Bindings::append(attributes, index), ...);
+        return attributes;
+    }
+
+    // vertex input state derived from the vertex types at compile time: the descriptions live in static constexpr
+    // arrays, so a pipeline takes getInputState() without building (or allocating) anything at runtime
+    template <typename... Bindings>
+    class VertexLayout final
+    {
+        public:
+            static constexpr uint32_t kBindingCount = static_cast<uint32_t>(sizeof...(Bindings));
+            static constexpr uint32_t kAttributeCount = (0 + ... + Bindings::kAttributeCount);
+
+            static constexpr std::array<VkVertexInputBindingDescription, kBindingCount> kBindings{ {
+                { Bindings::kBinding, Bindings::kStride, Bindings::kInputRate }... } };
+            static constexpr std::array<VkVertexInputAttributeDescription, kAttributeCount> kAttributes = makeVertexAttributes<Bindings...>();
+
+            static VkPipelineVertexInputStateCreateInfo getInputState() noexcept
+            {
+                VkPipelineVertexInputStateCreateInfo inputState{};
+                inputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+                inputState.pNext = nullptr;
+                inputState.flags = 0;
+                inputState.vertexBindingDescriptionCount = kBindingCount;
+                inputState.pVertexBindingDescriptions = kBindings.data();
+                inputState.vertexAttributeDescriptionCount = kAttributeCount;
+                inputState.pVertexAttributeDescriptions = kAttributes.data();
+                return inputState;
+            }
+    };
+}   // namespace keplar
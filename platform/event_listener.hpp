@@ -3,8 +3,11 @@
 // ────────────────────────────────────────────
 
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
+#include "input_event.hpp"
+
 namespace keplar
 {
     class EventListener
@@ -26,5 +29,27 @@ namespace keplar
             virtual void onMouseScroll(double) {}
             virtual void onMouseButtonPressed(uint32_t, int, int) {}
             virtual void onMouseButtonReleased(uint32_t, int, int) {}
+            // relative device motion without pointer acceleration, summed over the pump (platforms with raw input only)
+            virtual void onMouseRawMotion(double, double) {}
+
+            // input of one pollEvents in arrival order, consecutive mouse moves and scrolls coalesced.
+            // the default forwards each event to the handlers above
+            virtual void onInputEvents(const InputEvent* events, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const InputEvent& event = events[i];
+                    switch (event.mType)
+                    {
+                        case InputEventType::kKeyPressed:           onKeyPressed(event.mCode); break;
+                        case InputEventType::kKeyReleased:          onKeyReleased(event.mCode); break;
+                        case InputEventType::kMouseMove:            onMouseMove(event.mX, event.mY); break;
+                        case InputEventType::kMouseScroll:          onMouseScroll(event.mX); break;
+                        case InputEventType::kMouseButtonPressed:   onMouseButtonPressed(event.mCode, static_cast<int>(event.mX), static_cast<int>(event.mY)); break;
+                        case InputEventType::kMouseButtonReleased:  onMouseButtonReleased(event.mCode, static_cast<int>(event.mX), static_cast<int>(event.mY)); break;
+                        case InputEventType::kMouseRawMotion:       onMouseRawMotion(event.mX, event.mY); break;
+                    }
+                }
+            }
     };
 }   // namespace keplar
@@ -7,6 +7,17 @@
 
 namespace keplar
 {
+    EventManager::EventManager() noexcept
+        : m_listeners(std::make_shared<const ListenerList>())
+        , m_inputEvents{}
+        , m_inputEventCount(0)
+        , m_isDeferred(false)
+        , m_isReplaying(false)
+    {
+        m_deferredEvents.reserve(kMaxQueuedInputEvents);
+        m_dispatchEvents.reserve(kMaxQueuedInputEvents);
+    }
+
     void EventManager::addListener(const std::shared_ptr<EventListener>& listener) noexcept
     {
         if (!listener)
@@ -16,9 +27,12 @@ namespace keplar
 
         // check if the listener is already registered
         std::lock_guard<std::mutex> lock(m_mutex);
-        if (std::none_of(m_listeners.begin(), m_listeners.end(), [&listener](const auto& weak){ return weak.lock() == listener; }))
+        const auto current = getListenerSnapshot();
+        if (std::none_of(current->begin(), current->end(), [&listener](const auto& weak){ return weak.lock() == listener; }))
         {
-            m_listeners.emplace_back(listener);
+            ListenerList listeners = *current;
+            listeners.emplace_back(listener);
+            publish(std::move(listeners));
         }
     }
 
@@ -30,28 +44,39 @@ namespace keplar
         }
 
         std::lock_guard<std::mutex> lock(m_mutex);
-        auto itr = std::remove_if(m_listeners.begin(), m_listeners.end(), [&listener](const auto& weak)
+        ListenerList listeners = *getListenerSnapshot();
+        auto itr = std::remove_if(listeners.begin(), listeners.end(), [&listener](const auto& weak)
         {
             auto registered = weak.lock();
             return !registered || registered == listener;
         });
 
-        if (itr != m_listeners.end())
+        if (itr != listeners.end())
         {
-            m_listeners.erase(itr, m_listeners.end());
+            listeners.erase(itr, listeners.end());
+            publish(std::move(listeners));
         }
     }
 
     void EventManager::removeAllListeners() noexcept
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_listeners.clear();
+        publish({});
     }
 
-    void EventManager::onWindowResize(uint32_t width, uint32_t height) const noexcept
+    void EventManager::onWindowResize(uint32_t width, uint32_t height) noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        if (m_isDeferred.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            m_windowMailbox.mResized = true;
+            m_windowMailbox.mWidth = width;
+            m_windowMailbox.mHeight = height;
+            return;
+        }
+
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -60,10 +85,17 @@ namespace keplar
         }
     }
 
-    void EventManager::onWindowClose() const noexcept
+    void EventManager::onWindowClose() noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        if (m_isDeferred.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            m_windowMailbox.mClosed = true;
+            return;
+        }
+
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -72,10 +104,18 @@ namespace keplar
         }
     }
 
-    void EventManager::onWindowFocus(bool focused) const noexcept
+    void EventManager::onWindowFocus(bool focused) noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        if (m_isDeferred.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            m_windowMailbox.mFocusChanged = true;
+            m_windowMailbox.mFocused = focused;
+            return;
+        }
+
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -86,8 +126,8 @@ namespace keplar
 
     void EventManager::onKeyPressed(uint32_t key) const noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -98,8 +138,8 @@ namespace keplar
 
     void EventManager::onKeyReleased(uint32_t key) const noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -110,8 +150,8 @@ namespace keplar
 
     void EventManager::onMouseMove(double xpos, double ypos) const noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -122,8 +162,8 @@ namespace keplar
 
     void EventManager::onMouseScroll(double yoffset) const noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -134,8 +174,8 @@ namespace keplar
 
     void EventManager::onMouseButtonPressed(uint32_t button, int xpos, int ypos) const noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -146,8 +186,8 @@ namespace keplar
 
     void EventManager::onMouseButtonReleased(uint32_t button, int xpos, int ypos) const noexcept
     {
-        auto snapshot = getListenerSnapshot();
-        for (auto& weak_ptr : snapshot)
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
         {
             if (auto listener = weak_ptr.lock())
             {
@@ -156,9 +196,175 @@ namespace keplar
         }
     }
 
-    std::vector<std::weak_ptr<EventListener>> EventManager::getListenerSnapshot() const noexcept
+    void EventManager::queueInputEvent(const InputEvent& event) noexcept
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_listeners;
+        if (m_isReplaying.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (m_isDeferred.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            if (m_deferredEvents.empty() || !coalesce(m_deferredEvents.back(), event))
+            {
+                m_deferredEvents.push_back(event);
+            }
+            return;
+        }
+
+        if (m_inputEventCount > 0 && coalesce(m_inputEvents[m_inputEventCount - 1], event))
+        {
+            return;
+        }
+
+        if (m_inputEventCount == m_inputEvents.size())
+        {
+            dispatchInputEvents();
+        }
+
+        m_inputEvents[m_inputEventCount++] = event;
+    }
+
+    void EventManager::dispatchInputEvents() noexcept
+    {
+        if (m_inputEventCount == 0)
+        {
+            return;
+        }
+
+        // one list load and one virtual call per listener for the whole batch
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
+        {
+            if (auto listener = weak_ptr.lock())
+            {
+                listener->onInputEvents(m_inputEvents.data(), m_inputEventCount);
+            }
+        }
+
+        m_inputEventCount = 0;
+    }
+
+    void EventManager::setDeferredDispatch(bool enabled) noexcept
+    {
+        // input still buffered for immediate dispatch goes out before the switch
+        dispatchInputEvents();
+        m_isDeferred.store(enabled, std::memory_order_release);
+        if (!enabled)
+        {
+            dispatchDeferredEvents();
+        }
+    }
+
+    void EventManager::dispatchDeferredEvents() noexcept
+    {
+        // take everything recorded since the last frame; the pumping thread keeps recording into the other list
+        WindowMailbox mailbox;
+        {
+            std::lock_guard<std::mutex> lock(m_deferredMutex);
+            std::swap(mailbox, m_windowMailbox);
+            m_deferredEvents.swap(m_dispatchEvents);
+        }
+
+        dispatchWindowEvents(mailbox);
+        if (!m_dispatchEvents.empty())
+        {
+            const auto snapshot = getListenerSnapshot();
+            for (const auto& weak_ptr : *snapshot)
+            {
+                if (auto listener = weak_ptr.lock())
+                {
+                    listener->onInputEvents(m_dispatchEvents.data(), m_dispatchEvents.size());
+                }
+            }
+            m_dispatchEvents.clear();
+        }
+    }
+
+    void EventManager::setInputReplay(bool enabled) noexcept
+    {
+        m_isReplaying.store(enabled, std::memory_order_relaxed);
+    }
+
+    void EventManager::replayInputEvents(const InputEvent* events, size_t count) const noexcept
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
+        {
+            if (auto listener = weak_ptr.lock())
+            {
+                listener->onInputEvents(events, count);
+            }
+        }
+    }
+
+    void EventManager::replayWindowResize(uint32_t width, uint32_t height) const noexcept
+    {
+        WindowMailbox mailbox;
+        mailbox.mResized = true;
+        mailbox.mWidth = width;
+        mailbox.mHeight = height;
+        dispatchWindowEvents(mailbox);
+    }
+
+    bool EventManager::coalesce(InputEvent& last, const InputEvent& event) noexcept
+    {
+        // only the latest cursor position of a run of moves matters; scroll offsets and raw motion of a run add up
+        if (event.mType == InputEventType::kMouseMove && last.mType == InputEventType::kMouseMove)
+        {
+            last = event;
+            return true;
+        }
+
+        if (event.mType == InputEventType::kMouseScroll && last.mType == InputEventType::kMouseScroll)
+        {
+            last.mX += event.mX;
+            return true;
+        }
+
+        if (event.mType == InputEventType::kMouseRawMotion && last.mType == InputEventType::kMouseRawMotion)
+        {
+            last.mX += event.mX;
+            last.mY += event.mY;
+            return true;
+        }
+
+        return false;
+    }
+
+    void EventManager::dispatchWindowEvents(const WindowMailbox& mailbox) const noexcept
+    {
+        if (!mailbox.mResized && !mailbox.mFocusChanged && !mailbox.mClosed)
+        {
+            return;
+        }
+
+        const auto snapshot = getListenerSnapshot();
+        for (const auto& weak_ptr : *snapshot)
+        {
+            if (auto listener = weak_ptr.lock())
+            {
+                if (mailbox.mResized)       { listener->onWindowResize(mailbox.mWidth, mailbox.mHeight); }
+                if (mailbox.mFocusChanged)  { listener->onWindowFocus(mailbox.mFocused); }
+                if (mailbox.mClosed)        { listener->onWindowClose(); }
+            }
+        }
+    }
+
+    std::shared_ptr<const EventManager::ListenerList> EventManager::getListenerSnapshot() const noexcept
+    {
+        // a list replaced during dispatch stays alive until that dispatch returns
+        return std::atomic_load_explicit(&m_listeners, std::memory_order_acquire);
+    }
+
+    void EventManager::publish(ListenerList listeners) noexcept
+    {
+        std::atomic_store_explicit(&m_listeners, std::shared_ptr<const ListenerList>(std::make_shared<ListenerList>(std::move(listeners))), std::memory_order_release);
     }
 }   // namespace keplar
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <mutex>
 
@@ -15,7 +18,7 @@ namespace keplar
     {
         public:
             // creation and destruction
-            EventManager() noexcept = default;
+            EventManager() noexcept;
             ~EventManager() = default;
 
             // non-copyable
@@ -27,10 +30,10 @@ namespace keplar
             void removeListener(const std::shared_ptr<EventListener>& listener) noexcept;
             void removeAllListeners() noexcept;
 
-            // window events
-            void onWindowResize(uint32_t width, uint32_t height) const noexcept;
-            void onWindowClose() const noexcept;
-            void onWindowFocus(bool focused) const noexcept; 
+            // window events (deferred dispatch: the latest state is kept for the next dispatchDeferredEvents)
+            void onWindowResize(uint32_t width, uint32_t height) noexcept;
+            void onWindowClose() noexcept;
+            void onWindowFocus(bool focused) noexcept; 
 
             // keyboard events
             void onKeyPressed(uint32_t key) const noexcept;
@@ -42,12 +45,66 @@ namespace keplar
             void onMouseButtonPressed(uint32_t button, int xpos, int ypos) const noexcept;
             void onMouseButtonReleased(uint32_t button, int xpos, int ypos) const noexcept;
 
+            // buffered input (platform thread only): queued while the platform pumps its messages and handed to the
+            // listeners as one batch per frame. a full queue is dispatched early instead of dropping input
+            void queueInputEvent(const InputEvent& event) noexcept;
+            void dispatchInputEvents() noexcept;
+
+            // deferred dispatch for a render thread separate from the message pump: events are recorded under a lock
+            // on the pumping thread and delivered on the thread calling dispatchDeferredEvents, once per frame
+            void setDeferredDispatch(bool enabled) noexcept;
+            void dispatchDeferredEvents() noexcept;
+
+            // input replay: while enabled, input the platform queues is dropped; recorded input is handed to the
+            // listeners right away on the calling thread (the frame thread), deferred dispatch or not
+            void setInputReplay(bool enabled) noexcept;
+            void replayInputEvents(const InputEvent* events, size_t count) const noexcept;
+            void replayWindowResize(uint32_t width, uint32_t height) const noexcept;
+
         private:
-            // returns a snapshot of the current listeners for safe, lock-free dispatch
-            std::vector<std::weak_ptr<EventListener>> getListenerSnapshot() const noexcept;
+            static constexpr size_t kMaxQueuedInputEvents = 256;
+
+            // window state handed from the pumping thread to the render thread
+            struct WindowMailbox
+            {
+                bool     mResized      = false;
+                uint32_t mWidth        = 0;
+                uint32_t mHeight       = 0;
+                bool     mFocusChanged = false;
+                bool     mFocused      = false;
+                bool     mClosed       = false;
+            };
+
+            // merges event into the previous one when both belong to a run of moves or scrolls
+            static bool coalesce(InputEvent& last, const InputEvent& event) noexcept;
+            void dispatchWindowEvents(const WindowMailbox& mailbox) const noexcept;
+
+            using ListenerList = std::vector<std::weak_ptr<EventListener>>;
+
+            // returns the current immutable listener list: dispatch never copies the vector or allocates, but the atomic
+            // shared_ptr load is not lock-free (libstdc++ and msvc guard it with an internal lock) and bumps the refcount
+            std::shared_ptr<const ListenerList> getListenerSnapshot() const noexcept;
+
+            // copy-on-write update of the listener list, serialized by m_mutex
+            void publish(ListenerList listeners) noexcept;
 
         private:    
-            mutable std::mutex m_mutex;
-            std::vector<std::weak_ptr<EventListener>> m_listeners;
+            // writers: add and remove are rare, every event dispatch only loads the current list
+            std::mutex m_mutex;
+            std::shared_ptr<const ListenerList> m_listeners;
+
+            // input of the current frame
+            std::array<InputEvent, kMaxQueuedInputEvents> m_inputEvents;
+            size_t m_inputEventCount;
+
+            // deferred dispatch; the two event lists swap so their capacity is reused
+            std::atomic<bool> m_isDeferred;
+            std::mutex m_deferredMutex;
+            WindowMailbox m_windowMailbox;
+            std::vector<InputEvent> m_deferredEvents;
+            std::vector<InputEvent> m_dispatchEvents;
+
+            // input replay
+            std::atomic<bool> m_isReplaying;
     };
 }   // namespace keplar
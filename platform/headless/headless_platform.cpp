@@ -0,0 +1,131 @@
+// ────────────────────────────────────────────
+//  File: headless_platform.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "headless_platform.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    HeadlessPlatform::HeadlessPlatform() noexcept
+        : m_width(0)
+        , m_height(0)
+        , m_shouldClose(false)
+    {
+    }
+
+    HeadlessPlatform::~HeadlessPlatform()
+    {
+        shutdown();
+    }
+
+    bool HeadlessPlatform::initialize(const std::string& title, int width, int height, bool /* maximized */) noexcept
+    {
+        if (width <= 0 || height <= 0)
+        {
+            VK_LOG_ERROR("HeadlessPlatform::initialize failed: invalid extent (%d x %d)", width, height);
+            return false;
+        }
+
+        m_width = static_cast<uint32_t>(width);
+        m_height = static_cast<uint32_t>(height);
+        m_shouldClose = false;
+
+        VK_LOG_INFO("headless platform initialized for '%s' (%u x %u, offscreen)", title.c_str(), m_width, m_height);
+        return true;
+    }
+
+    void HeadlessPlatform::pollEvents() noexcept
+    {
+        // no window system: there are no events to pump
+    }
+
+    bool HeadlessPlatform::shouldClose() noexcept
+    {
+        return m_shouldClose;
+    }
+
+    void HeadlessPlatform::shutdown() noexcept
+    {
+        m_shouldClose = true;
+        m_eventManager.removeAllListeners();
+    }
+
+    void* HeadlessPlatform::getWindowHandle() const noexcept
+    {
+        return nullptr;
+    }
+
+    uint32_t HeadlessPlatform::getWindowWidth() const noexcept
+    {
+        return m_width;
+    }
+
+    uint32_t HeadlessPlatform::getWindowHeight() const noexcept
+    {
+        return m_height;
+    }
+
+    void HeadlessPlatform::addListener(const std::shared_ptr<EventListener>& listener) noexcept
+    {
+        m_eventManager.addListener(listener);
+    }
+
+    void HeadlessPlatform::removeListener(const std::shared_ptr<EventListener>& listener) noexcept
+    {
+        m_eventManager.removeListener(listener);
+    }
+
+    void HeadlessPlatform::enableImGuiEvents(bool /* enabled */) noexcept
+    {
+    }
+
+    void HeadlessPlatform::setDeferredEventDispatch(bool enabled) noexcept
+    {
+        m_eventManager.setDeferredDispatch(enabled);
+    }
+
+    void HeadlessPlatform::dispatchDeferredEvents() noexcept
+    {
+        m_eventManager.dispatchDeferredEvents();
+    }
+
+    void HeadlessPlatform::waitEvents(uint32_t timeoutMs) noexcept
+    {
+        // nothing to wait for but the timeout
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+    }
+
+    void HeadlessPlatform::setInputReplay(bool enabled) noexcept
+    {
+        m_eventManager.setInputReplay(enabled);
+    }
+
+    void HeadlessPlatform::replayInputFrame(const InputFrame& frame) noexcept
+    {
+        // a recorded resize becomes the extent, so the offscreen images follow it like a window's surface would
+        if (frame.mIsResized && frame.mWidth > 0 && frame.mHeight > 0)
+        {
+            m_width = frame.mWidth;
+            m_height = frame.mHeight;
+            m_eventManager.replayWindowResize(m_width, m_height);
+        }
+        m_eventManager.replayInputEvents(frame.mEvents.data(), frame.mEvents.size());
+    }
+
+    VkSurfaceKHR HeadlessPlatform::createSurface(VkInstance /* vkInstance */) const noexcept
+    {
+        // no presentation surface: the swapchain falls back to offscreen images
+        return VK_NULL_HANDLE;
+    }
+
+    std::vector<std::string_view> HeadlessPlatform::getSurfaceExtensions() const noexcept
+    {
+        // VK_KHR_surface stays enabled so surface dependent instance and device extensions remain valid to request
+        return { VK_KHR_SURFACE_EXTENSION_NAME };
+    }
+}   // namespace keplar
@@ -0,0 +1,55 @@
+// ────────────────────────────────────────────
+//  File: headless_platform.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "platform/platform.hpp"
+#include "platform/event_manager.hpp"
+
+namespace keplar
+{
+    // windowless platform for automated runs: no surface is created, so the swapchain renders into offscreen
+    // images and nothing is presented. the extent passed to initialize() stands in for the window size
+    class HeadlessPlatform : public Platform
+    {
+        public:
+            // creation and destruction
+            HeadlessPlatform() noexcept;
+            virtual ~HeadlessPlatform() override;
+
+            // lifecycle
+            virtual bool initialize(const std::string& title, int width, int height, bool maximized) noexcept override;
+            virtual void pollEvents() noexcept override;
+            virtual bool shouldClose() noexcept override;
+            virtual void shutdown() noexcept override;
+            virtual bool isHeadless() const noexcept override { return true; }
+
+            // window queries
+            virtual void* getWindowHandle() const noexcept override;
+            virtual uint32_t getWindowWidth() const noexcept override;
+            virtual uint32_t getWindowHeight() const noexcept override;
+
+            // event listeners
+            virtual void addListener(const std::shared_ptr<EventListener>& listener) noexcept override;
+            virtual void removeListener(const std::shared_ptr<EventListener>& listener) noexcept override;
+            virtual void enableImGuiEvents(bool enabled) noexcept override;
+            virtual void setDeferredEventDispatch(bool enabled) noexcept override;
+            virtual void dispatchDeferredEvents() noexcept override;
+            virtual void waitEvents(uint32_t timeoutMs) noexcept override;
+            virtual void setInputReplay(bool enabled) noexcept override;
+            virtual void replayInputFrame(const InputFrame& frame) noexcept override;
+
+            // vulkan 
+            virtual VkSurfaceKHR createSurface(VkInstance vkInstance) const noexcept override;
+            virtual std::vector<std::string_view> getSurfaceExtensions() const noexcept override;
+
+        private:
+            uint32_t            m_width;
+            uint32_t            m_height;
+            bool                m_shouldClose;
+
+            // listeners are kept for symmetry; the fixed extent never emits events
+            EventManager        m_eventManager;
+    };
+}   // namespace keplar
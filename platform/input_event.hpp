@@ -0,0 +1,29 @@
+// ────────────────────────────────────────────
+//  File: input_event.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+#include <cstdint>
+
+namespace keplar
+{
+    enum class InputEventType : uint8_t
+    {
+        kKeyPressed,
+        kKeyReleased,
+        kMouseMove,
+        kMouseScroll,
+        kMouseButtonPressed,
+        kMouseButtonReleased,
+        kMouseRawMotion
+    };
+
+    // raw input collected by the platform and dispatched once per pollEvents
+    struct InputEvent
+    {
+        InputEventType mType;
+        uint32_t       mCode;       // key or mouse button
+        double         mX;          // cursor position, the scroll offset in mX, or the relative device motion
+        double         mY;
+    };
+}   // namespace keplar
@@ -0,0 +1,225 @@
+// ────────────────────────────────────────────
+//  File: input_recording.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "input_recording.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    template <typename T>
+    void writeValue(std::vector<uint8_t>& buffer, const T& value)
+    {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(const std::vector<uint8_t>& data, size_t& offset, T& value) noexcept
+    {
+        if (data.size() - offset < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    // fields an event type carries: keys only their code, scrolls only mX
+    bool hasCode(keplar::InputEventType type) noexcept
+    {
+        return type != keplar::InputEventType::kMouseScroll && type != keplar::InputEventType::kMouseRawMotion;
+    }
+
+    bool hasPosition(keplar::InputEventType type) noexcept
+    {
+        return type != keplar::InputEventType::kKeyPressed && type != keplar::InputEventType::kKeyReleased;
+    }
+
+    bool hasY(keplar::InputEventType type) noexcept
+    {
+        return hasPosition(type) && type != keplar::InputEventType::kMouseScroll;
+    }
+}
+
+namespace keplar
+{
+    InputRecorder::~InputRecorder()
+    {
+        close();
+    }
+
+    bool InputRecorder::open(const std::filesystem::path& filepath) noexcept
+    {
+        close();
+
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        m_file.open(filepath, std::ios::binary | std::ios::trunc);
+        if (!m_file)
+        {
+            VK_LOG_ERROR("InputRecorder::open : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        InputRecordingHeader header{};
+        std::memcpy(header.mMagic, kInputRecordingMagic, sizeof(header.mMagic));
+        header.mVersion = kInputRecordingVersion;
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        m_filepath = filepath;
+        m_frame = InputFrame{};
+        m_frameCount = 0;
+        VK_LOG_INFO("InputRecorder::open : recording input to %s", filepath.string().c_str());
+        return true;
+    }
+
+    void InputRecorder::endFrame(float deltaTime) noexcept
+    {
+        if (!m_file.is_open())
+        {
+            return;
+        }
+
+        // a frame with more events than a record holds keeps the earliest ones (far beyond what one pump coalesces to)
+        const size_t eventCount = std::min<size_t>(m_frame.mEvents.size(), std::numeric_limits<uint16_t>::max());
+        m_buffer.clear();
+        writeValue(m_buffer, deltaTime);
+        writeValue(m_buffer, static_cast<uint16_t>(eventCount));
+        writeValue(m_buffer, static_cast<uint8_t>(m_frame.mIsResized ? 1 : 0));
+        if (m_frame.mIsResized)
+        {
+            writeValue(m_buffer, m_frame.mWidth);
+            writeValue(m_buffer, m_frame.mHeight);
+        }
+
+        for (size_t i = 0; i < eventCount; ++i)
+        {
+            const InputEvent& event = m_frame.mEvents[i];
+            writeValue(m_buffer, static_cast<uint8_t>(event.mType));
+            if (hasCode(event.mType))       { writeValue(m_buffer, event.mCode); }
+            if (hasPosition(event.mType))   { writeValue(m_buffer, event.mX); }
+            if (hasY(event.mType))          { writeValue(m_buffer, event.mY); }
+        }
+
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        m_frame.mEvents.clear();
+        m_frame.mIsResized = false;
+        ++m_frameCount;
+    }
+
+    void InputRecorder::close() noexcept
+    {
+        if (!m_file.is_open())
+        {
+            return;
+        }
+
+        m_file.close();
+        VK_LOG_INFO("InputRecorder::close : %llu frames recorded to %s", static_cast<unsigned long long>(m_frameCount), m_filepath.string().c_str());
+    }
+
+    void InputRecorder::onWindowResize(uint32_t width, uint32_t height)
+    {
+        m_frame.mIsResized = true;
+        m_frame.mWidth = width;
+        m_frame.mHeight = height;
+    }
+
+    void InputRecorder::onInputEvents(const InputEvent* events, size_t count)
+    {
+        m_frame.mEvents.insert(m_frame.mEvents.end(), events, events + count);
+    }
+
+    bool InputReplay::load(const std::filesystem::path& filepath) noexcept
+    {
+        m_data.clear();
+        m_offset = 0;
+        m_frameIndex = 0;
+
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            VK_LOG_ERROR("InputReplay::load : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        const std::streamsize size = file.tellg();
+        InputRecordingHeader header{};
+        if (size < static_cast<std::streamsize>(sizeof(header)))
+        {
+            VK_LOG_ERROR("InputReplay::load : %s is not an input recording", filepath.string().c_str());
+            return false;
+        }
+
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (std::memcmp(header.mMagic, kInputRecordingMagic, sizeof(header.mMagic)) != 0 || header.mVersion != kInputRecordingVersion)
+        {
+            VK_LOG_ERROR("InputReplay::load : %s is not a version %u input recording", filepath.string().c_str(), kInputRecordingVersion);
+            return false;
+        }
+
+        m_data.resize(static_cast<size_t>(size) - sizeof(header));
+        file.read(reinterpret_cast<char*>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+        if (!file)
+        {
+            VK_LOG_ERROR("InputReplay::load : failed to read %s", filepath.string().c_str());
+            m_data.clear();
+            return false;
+        }
+
+        VK_LOG_INFO("InputReplay::load : replaying input from %s", filepath.string().c_str());
+        return true;
+    }
+
+    bool InputReplay::nextFrame(InputFrame& frame) noexcept
+    {
+        frame.mEvents.clear();
+        frame.mIsResized = false;
+
+        // a truncated record (recording cut short by a crash) ends the replay
+        uint16_t eventCount = 0;
+        uint8_t isResized = 0;
+        if (!readValue(m_data, m_offset, frame.mDeltaTime) || !readValue(m_data, m_offset, eventCount) || !readValue(m_data, m_offset, isResized) ||
+            (isResized && (!readValue(m_data, m_offset, frame.mWidth) || !readValue(m_data, m_offset, frame.mHeight))))
+        {
+            m_offset = m_data.size();
+            return false;
+        }
+        frame.mIsResized = isResized != 0;
+
+        frame.mEvents.resize(eventCount);
+        for (InputEvent& event : frame.mEvents)
+        {
+            uint8_t type = 0;
+            event = InputEvent{};
+            bool isRead = readValue(m_data, m_offset, type) && type <= static_cast<uint8_t>(InputEventType::kMouseRawMotion);
+            event.mType = static_cast<InputEventType>(type);
+            isRead = isRead && (!hasCode(event.mType) || readValue(m_data, m_offset, event.mCode));
+            isRead = isRead && (!hasPosition(event.mType) || readValue(m_data, m_offset, event.mX));
+            isRead = isRead && (!hasY(event.mType) || readValue(m_data, m_offset, event.mY));
+            if (!isRead)
+            {
+                VK_LOG_WARN("InputReplay::nextFrame : recording ends in a damaged frame (%llu)", static_cast<unsigned long long>(m_frameIndex));
+                m_offset = m_data.size();
+                return false;
+            }
+        }
+
+        ++m_frameIndex;
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,91 @@
+// ────────────────────────────────────────────
+//  File: input_recording.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "event_listener.hpp"
+
+namespace keplar
+{
+    // the input one simulated frame saw, and the time step it was simulated with
+    struct InputFrame
+    {
+        float                   mDeltaTime = 0.0f;
+        std::vector<InputEvent> mEvents;
+        bool                    mIsResized = false;     // the window resized to mWidth x mHeight before the events
+        uint32_t                mWidth     = 0;
+        uint32_t                mHeight    = 0;
+    };
+
+    // .kinput layout: a header, then one record per frame (f32 time step, u16 event count, resize flag and extent,
+    // events with only the fields their type uses). native byte order, recordings are not meant to move between machines
+    struct InputRecordingHeader
+    {
+        char        mMagic[4];
+        uint32_t    mVersion;
+    };
+
+    constexpr char      kInputRecordingMagic[4] = { 'K', 'I', 'N', 'P' };
+    constexpr uint32_t  kInputRecordingVersion  = 1;
+
+    // listens like any other listener and writes what it received since the previous endFrame as one frame record.
+    // callbacks and endFrame must come from the same thread (the one listeners are dispatched on)
+    class InputRecorder final : public EventListener
+    {
+        public:
+            // creation and destruction
+            InputRecorder() noexcept = default;
+            ~InputRecorder() override;
+
+            // disable copy and move semantics to enforce unique ownership (of the file)
+            InputRecorder(const InputRecorder&) = delete;
+            InputRecorder& operator=(const InputRecorder&) = delete;
+            InputRecorder(InputRecorder&&) = delete;
+            InputRecorder& operator=(InputRecorder&&) = delete;
+
+            // usage
+            bool open(const std::filesystem::path& filepath) noexcept;
+            void endFrame(float deltaTime) noexcept;
+            void close() noexcept;
+
+            // accessors
+            bool isOpen() const noexcept            { return m_file.is_open(); }
+            uint64_t getFrameCount() const noexcept { return m_frameCount; }
+
+            // event listener interface
+            virtual void onWindowResize(uint32_t width, uint32_t height) override;
+            virtual void onInputEvents(const InputEvent* events, size_t count) override;
+
+        private:
+            std::ofstream           m_file;
+            std::filesystem::path   m_filepath;
+            InputFrame              m_frame;
+            std::vector<uint8_t>    m_buffer;       // the encoded frame, written with one call
+            uint64_t                m_frameCount = 0;
+    };
+
+    // reads a recording made by InputRecorder and hands it back one frame at a time
+    class InputReplay final
+    {
+        public:
+            // usage
+            bool load(const std::filesystem::path& filepath) noexcept;
+            bool nextFrame(InputFrame& frame) noexcept;
+
+            // accessors
+            bool isLoaded() const noexcept          { return !m_data.empty(); }
+            bool isComplete() const noexcept        { return m_offset >= m_data.size(); }
+            uint64_t getFrameIndex() const noexcept { return m_frameIndex; }
+
+        private:
+            std::vector<uint8_t>    m_data;
+            size_t                  m_offset = 0;
+            uint64_t                m_frameIndex = 0;
+    };
+}   // namespace keplar
@@ -10,9 +10,28 @@
 
 #include "vulkan/vulkan_config.hpp"
 #include "event_listener.hpp"
+#include "input_recording.hpp"
 
 namespace keplar
 {
+    // how the window covers its monitor. borderless and exclusive windows both span the monitor without decorations;
+    // exclusive additionally asks the swapchain to take the display over (VK_EXT_full_screen_exclusive), bypassing
+    // the compositor for flips without its extra frame of latency
+    enum class FullscreenMode : uint8_t
+    {
+        kWindowed,
+        kBorderless,
+        kExclusive
+    };
+
+    // refresh of the monitor a window is on. with variable refresh (g-sync, freesync, hdmi vrr) the display scans a
+    // frame out as it arrives, anywhere up to mRefreshRate, instead of holding it for the next fixed refresh
+    struct DisplayRefresh
+    {
+        float mRefreshRate = 0.0f;      // hz of the current display mode, 0 when unknown
+        bool  mIsVariable  = false;
+    };
+
     class Platform
     {
         public:
@@ -23,17 +42,46 @@ namespace keplar
             virtual void pollEvents() noexcept = 0;
             virtual bool shouldClose() noexcept = 0;
             virtual void shutdown() noexcept = 0;
+
+            // windowless platforms render offscreen and present nothing
+            virtual bool isHeadless() const noexcept { return false; }
             
             // window queries
             virtual void* getWindowHandle() const noexcept = 0;
             virtual uint32_t getWindowWidth() const noexcept = 0;
             virtual uint32_t getWindowHeight() const noexcept = 0;
 
+            // window state for the app's power policy, safe to query from any thread; windowless platforms are always
+            // focused and never minimized
+            virtual bool isWindowFocused() const noexcept { return true; }
+            virtual bool isWindowMinimized() const noexcept { return false; }
+
+            // fullscreen state, safe to query from any thread; a change is followed by a window resize event (with the
+            // same extent when only the mode changed), so renderers pick the mode up when they recreate the swapchain.
+            // the monitor handle is the win32 HMONITOR the window is on, nullptr elsewhere
+            virtual FullscreenMode getFullscreenMode() const noexcept { return FullscreenMode::kWindowed; }
+            virtual void* getMonitorHandle() const noexcept { return nullptr; }
+
+            // refresh of the window's monitor, queried from the os on each call: callers query it again when the monitor
+            // or the fullscreen mode changed rather than every frame. unknown (all zero) on windowless platforms
+            virtual DisplayRefresh getDisplayRefresh() const noexcept { return {}; }
+
             // event listeners
             virtual void addListener(const std::shared_ptr<EventListener>& listener) noexcept = 0;
             virtual void removeListener(const std::shared_ptr<EventListener>& listener) noexcept = 0;
             virtual void enableImGuiEvents(bool enabled) noexcept = 0;
 
+            // render thread support: with deferred dispatch, events pumped by pollEvents are held until the render
+            // thread calls dispatchDeferredEvents; waitEvents blocks the pumping thread until a message or the timeout
+            virtual void setDeferredEventDispatch(bool enabled) noexcept = 0;
+            virtual void dispatchDeferredEvents() noexcept = 0;
+            virtual void waitEvents(uint32_t timeoutMs) noexcept = 0;
+
+            // input replay (see KeplarApp): live input is ignored while enabled, replayInputFrame hands a recorded frame
+            // to the listeners on the calling thread
+            virtual void setInputReplay(bool enabled) noexcept = 0;
+            virtual void replayInputFrame(const InputFrame& frame) noexcept = 0;
+
             // vulkan 
             virtual VkSurfaceKHR createSurface(VkInstance vkInstance) const noexcept = 0;
             virtual std::vector<std::string_view> getSurfaceExtensions() const noexcept = 0;
@@ -3,6 +3,7 @@
 // ────────────────────────────────────────────
 
 #include "platform_factory.hpp"
+#include "headless/headless_platform.hpp"
 
 #ifdef _WIN32
 #include "windows/win32_platform.hpp"
@@ -14,9 +15,14 @@
 
 namespace keplar::platform
 {
-    // factory function that returns the platform-specific instance
-    std::shared_ptr<Platform> createPlatform()
+    // factory function that returns the platform-specific instance, or the windowless one for automated runs
+    std::shared_ptr<Platform> createPlatform(bool headless)
     {
+        if (headless)
+        {
+            return std::make_shared<HeadlessPlatform>();
+        }
+
         #ifdef _WIN32
             return std::make_shared<Win32Platform>();
         #elif defined(__linux__)
@@ -9,5 +9,5 @@
 
 namespace keplar::platform
 {
-    std::shared_ptr<Platform> createPlatform();
+    std::shared_ptr<Platform> createPlatform(bool headless = false);
 }   // namespace keplar
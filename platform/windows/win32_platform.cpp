@@ -7,6 +7,8 @@
 #include "utils/logger.hpp"
 #include "vulkan/vulkan_utils.hpp"
 
+#include <dxgi1_5.h>
+
 // forward declaration of ImGui message handler
 extern LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -14,6 +16,38 @@ namespace
 {
     static constexpr int kMinWindowWidth  = 1280;
     static constexpr int kMinWindowHeight = 720;
+
+    // hid generic desktop mouse, and the reports GetRawInputBuffer takes per call
+    static constexpr USHORT kHidUsagePageGeneric = 0x01;
+    static constexpr USHORT kHidUsageMouse       = 0x02;
+    static constexpr UINT   kRawInputBatchSize   = 64;
+
+    // windows reports variable refresh support as dxgi's tearing support: with it, flips of a fullscreen (or windowed
+    // vrr) swapchain reach the display when they are presented. dxgi is loaded for the query only, keplar does not link it
+    bool isTearingSupported() noexcept
+    {
+        HMODULE dxgi = LoadLibraryW(L"dxgi.dll");
+        if (!dxgi)
+        {
+            return false;
+        }
+
+        using CreateFactoryFn = HRESULT (WINAPI*)(REFIID, void**);
+        const auto createFactory = reinterpret_cast<CreateFactoryFn>(GetProcAddress(dxgi, "CreateDXGIFactory1"));
+
+        BOOL allowTearing = FALSE;
+        IDXGIFactory5* factory = nullptr;
+        if (createFactory && SUCCEEDED(createFactory(__uuidof(IDXGIFactory5), reinterpret_cast<void**>(&factory))))
+        {
+            if (FAILED(factory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))))
+            {
+                allowTearing = FALSE;
+            }
+            factory->Release();
+        }
+        FreeLibrary(dxgi);
+        return allowTearing == TRUE;
+    }
 }
 
 namespace keplar
@@ -25,8 +59,15 @@ namespace keplar
         , m_width(0)
         , m_height(0)
         , m_shouldClose(false)
-        , m_isFullscreen(false)
+        , m_fullscreenMode(FullscreenMode::kWindowed)
+        , m_monitor(nullptr)
+        , m_isFocused(true)
+        , m_isMinimized(false)
         , m_imguiEvents(false)
+        , m_isRawInput(false)
+        , m_rawDeltaX(0)
+        , m_rawDeltaY(0)
+        , m_isDeferred(false)
     {
     }
 
@@ -91,12 +132,16 @@ namespace keplar
         ShowWindow(m_hwnd, maximized ? SW_MAXIMIZE : SW_SHOWDEFAULT);
 		SetForegroundWindow(m_hwnd);
 		SetFocus(m_hwnd);
+        registerRawInput();
         VK_LOG_INFO("window is created successfully.");
         return true;
     }
 
     void Win32Platform::pollEvents() noexcept 
     {
+        // high-rate mice queue a WM_INPUT per report: take what is buffered in batches before the other messages
+        readRawInputBuffer();
+
         MSG msg {};
         while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) 
         {
@@ -111,6 +156,16 @@ namespace keplar
             TranslateMessage(&msg);
             DispatchMessage(&msg);
         }
+
+        // raw motion of the whole pump as one relative event, then input queued by wndProc reaches the listeners
+        // as one batch per frame
+        if (m_rawDeltaX != 0 || m_rawDeltaY != 0)
+        {
+            m_eventManager.queueInputEvent({ InputEventType::kMouseRawMotion, 0, static_cast<double>(m_rawDeltaX), static_cast<double>(m_rawDeltaY) });
+            m_rawDeltaX = 0;
+            m_rawDeltaY = 0;
+        }
+        m_eventManager.dispatchInputEvents();
     }
  
     bool Win32Platform::shouldClose() noexcept
@@ -123,6 +178,14 @@ namespace keplar
         // remove all listeners on shutdown
         m_eventManager.removeAllListeners();
 
+        // stop raw input before its target window goes away
+        if (m_isRawInput)
+        {
+            const RAWINPUTDEVICE device{ kHidUsagePageGeneric, kHidUsageMouse, RIDEV_REMOVE, nullptr };
+            RegisterRawInputDevices(&device, 1, sizeof(RAWINPUTDEVICE));
+            m_isRawInput = false;
+        }
+
         // destroy window 
         if (m_hwnd) 
         {
@@ -147,6 +210,48 @@ namespace keplar
         return m_height;
     }
 
+    bool Win32Platform::isWindowFocused() const noexcept
+    {
+        return m_isFocused.load(std::memory_order_acquire);
+    }
+
+    bool Win32Platform::isWindowMinimized() const noexcept
+    {
+        return m_isMinimized.load(std::memory_order_acquire);
+    }
+
+    FullscreenMode Win32Platform::getFullscreenMode() const noexcept
+    {
+        return m_fullscreenMode.load(std::memory_order_acquire);
+    }
+
+    void* Win32Platform::getMonitorHandle() const noexcept
+    {
+        // windowed: the monitor holding most of the window
+        const HMONITOR monitor = m_monitor.load(std::memory_order_acquire);
+        return (monitor != nullptr) ? monitor : MonitorFromWindow(m_hwnd, MONITOR_DEFAULTTOPRIMARY);
+    }
+
+    DisplayRefresh Win32Platform::getDisplayRefresh() const noexcept
+    {
+        DisplayRefresh refresh{};
+
+        // frequencies 0 and 1 stand for the hardware default, which the mode does not tell
+        MONITORINFOEXW monitorInfo{};
+        monitorInfo.cbSize = sizeof(monitorInfo);
+        DEVMODEW displayMode{};
+        displayMode.dmSize = sizeof(displayMode);
+        if (GetMonitorInfoW(static_cast<HMONITOR>(getMonitorHandle()), reinterpret_cast<MONITORINFO*>(&monitorInfo)) &&
+            EnumDisplaySettingsW(monitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &displayMode) && displayMode.dmDisplayFrequency > 1)
+        {
+            refresh.mRefreshRate = static_cast<float>(displayMode.dmDisplayFrequency);
+        }
+
+        // tearing support is system wide; a monitor without a variable range still runs at its fixed refresh then
+        refresh.mIsVariable = refresh.mRefreshRate > 0.0f && isTearingSupported();
+        return refresh;
+    }
+
     void Win32Platform::addListener(const std::shared_ptr<EventListener>& listener) noexcept 
     {
         m_eventManager.addListener(listener);
@@ -162,6 +267,49 @@ namespace keplar
         m_imguiEvents = enabled;
     }
 
+    void Win32Platform::setDeferredEventDispatch(bool enabled) noexcept
+    {
+        m_isDeferred.store(enabled, std::memory_order_release);
+        m_eventManager.setDeferredDispatch(enabled);
+        if (!enabled)
+        {
+            dispatchDeferredEvents();
+        }
+    }
+
+    void Win32Platform::dispatchDeferredEvents() noexcept
+    {
+        // replay imgui messages on this thread, then hand the frame's events to the listeners
+        {
+            std::lock_guard<std::mutex> lock(m_imguiMutex);
+            m_imguiMessages.swap(m_imguiDispatch);
+        }
+
+        for (const ImGuiMessage& message : m_imguiDispatch)
+        {
+            ImGui_ImplWin32_WndProcHandler(message.mHwnd, message.mMsg, message.mWParam, message.mLParam);
+        }
+        m_imguiDispatch.clear();
+
+        m_eventManager.dispatchDeferredEvents();
+    }
+
+    void Win32Platform::waitEvents(uint32_t timeoutMs) noexcept
+    {
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, timeoutMs, QS_ALLINPUT);
+    }
+
+    void Win32Platform::setInputReplay(bool enabled) noexcept
+    {
+        m_eventManager.setInputReplay(enabled);
+    }
+
+    void Win32Platform::replayInputFrame(const InputFrame& frame) noexcept
+    {
+        // recorded resizes are not replayed: the surface keeps the window's real extent, whose resizes still arrive
+        m_eventManager.replayInputEvents(frame.mEvents.data(), frame.mEvents.size());
+    }
+
     VkSurfaceKHR Win32Platform::createSurface(VkInstance vkInstance) const noexcept
     {
         VkSurfaceKHR vkSurfaceKHR = VK_NULL_HANDLE;  
@@ -195,9 +343,18 @@ namespace keplar
             return DefWindowProc(hwnd, iMsg, wParam, lParam);
         }
 
-        if (platform->m_imguiEvents)
+        // imgui reads the cursor from WM_MOUSEMOVE, raw reports would only fill its deferred queue
+        if (platform->m_imguiEvents && iMsg != WM_INPUT)
         {
-            ImGui_ImplWin32_WndProcHandler(hwnd, iMsg, wParam, lParam);
+            if (platform->m_isDeferred.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(platform->m_imguiMutex);
+                platform->m_imguiMessages.push_back({ hwnd, iMsg, wParam, lParam });
+            }
+            else
+            {
+                ImGui_ImplWin32_WndProcHandler(hwnd, iMsg, wParam, lParam);
+            }
         }
 
         switch (iMsg)
@@ -218,15 +375,16 @@ namespace keplar
             case WM_SIZE:
                 platform->m_width = LOWORD(lParam);
                 platform->m_height = HIWORD(lParam);
+                platform->m_isMinimized.store(wParam == SIZE_MINIMIZED, std::memory_order_release);
                 platform->m_eventManager.onWindowResize(platform->m_width, platform->m_height);
                 break;
 
             case WM_KEYDOWN:
-                platform->m_eventManager.onKeyPressed(static_cast<uint32_t>(wParam));
+                platform->m_eventManager.queueInputEvent({ InputEventType::kKeyPressed, static_cast<uint32_t>(wParam), 0.0, 0.0 });
                 switch (wParam)
                 {
                     case VK_F11:
-                        platform->toggleFullscreen();
+                        platform->toggleFullscreen(FullscreenMode::kBorderless);
                         break;
 
                     case VK_ESCAPE:
@@ -238,48 +396,71 @@ namespace keplar
                 }
                 break;
 
+            case WM_SYSKEYDOWN:
+                // alt+enter (bit 29: alt held); handled here so DefWindowProc does not beep
+                if (wParam == VK_RETURN && (lParam & (1 << 29)) != 0)
+                {
+                    platform->toggleFullscreen(FullscreenMode::kExclusive);
+                    return 0;
+                }
+                break;
+
             case WM_KEYUP:
-                platform->m_eventManager.onKeyReleased(static_cast<uint32_t>(wParam));
+                platform->m_eventManager.queueInputEvent({ InputEventType::kKeyReleased, static_cast<uint32_t>(wParam), 0.0, 0.0 });
                 break;
 
             case WM_MOUSEMOVE:
-                platform->m_eventManager.onMouseMove(static_cast<uint32_t>(LOWORD(lParam)), static_cast<uint32_t>(HIWORD(lParam)));
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseMove, 0, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) });
+                break;
+
+            case WM_INPUT:
+                {
+                    // a report that arrived after the pump drained the buffer; DefWindowProc still cleans it up
+                    RAWINPUT input{};
+                    UINT size = sizeof(RAWINPUT);
+                    if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &input, &size, sizeof(RAWINPUTHEADER)) != static_cast<UINT>(-1))
+                    {
+                        platform->accumulateRawInput(input);
+                    }
+                }
                 break;
 
             case WM_MOUSEWHEEL:
-                platform->m_eventManager.onMouseScroll(static_cast<double>(GET_WHEEL_DELTA_WPARAM(wParam)) / WHEEL_DELTA);
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseScroll, 0, static_cast<double>(GET_WHEEL_DELTA_WPARAM(wParam)) / WHEEL_DELTA, 0.0 });
                 break;
 
             case WM_SETFOCUS:    
+                platform->m_isFocused.store(true, std::memory_order_release);
                 platform->m_eventManager.onWindowFocus(true);      
                 break;
 
             case WM_KILLFOCUS:   
+                platform->m_isFocused.store(false, std::memory_order_release);
                 platform->m_eventManager.onWindowFocus(false);     
                 break;
 
             case WM_LBUTTONDOWN: 
-                platform->m_eventManager.onMouseButtonPressed(0, LOWORD(lParam), HIWORD(lParam));  
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseButtonPressed, 0, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) });  
                 break;
 
             case WM_LBUTTONUP:   
-                platform->m_eventManager.onMouseButtonReleased(0, LOWORD(lParam), HIWORD(lParam)); 
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseButtonReleased, 0, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) }); 
                 break;
 
             case WM_RBUTTONDOWN: 
-                platform->m_eventManager.onMouseButtonPressed(1, LOWORD(lParam), HIWORD(lParam));  
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseButtonPressed, 1, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) });  
                 break;
 
             case WM_RBUTTONUP:   
-                platform->m_eventManager.onMouseButtonReleased(1, LOWORD(lParam), HIWORD(lParam)); 
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseButtonReleased, 1, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) }); 
                 break;
 
             case WM_MBUTTONDOWN: 
-                platform->m_eventManager.onMouseButtonPressed(2, LOWORD(lParam), HIWORD(lParam));  
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseButtonPressed, 2, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) });  
                 break;
 
             case WM_MBUTTONUP:   
-                platform->m_eventManager.onMouseButtonReleased(2, LOWORD(lParam), HIWORD(lParam)); 
+                platform->m_eventManager.queueInputEvent({ InputEventType::kMouseButtonReleased, 2, static_cast<double>(LOWORD(lParam)), static_cast<double>(HIWORD(lParam)) }); 
                 break;
 
             default:
@@ -289,18 +470,95 @@ namespace keplar
         return (DefWindowProc(hwnd, iMsg, wParam, lParam));
     }
 
-    void Win32Platform::toggleFullscreen() noexcept
+    void Win32Platform::registerRawInput() noexcept
+    {
+        // not fatal: without raw input the camera follows the cursor messages
+        const RAWINPUTDEVICE device{ kHidUsagePageGeneric, kHidUsageMouse, 0, m_hwnd };
+        m_isRawInput = RegisterRawInputDevices(&device, 1, sizeof(RAWINPUTDEVICE)) == TRUE;
+        if (!m_isRawInput)
+        {
+            VK_LOG_WARN("raw mouse input unavailable (GetLastError: %lu)", GetLastError());
+        }
+    }
+
+    void Win32Platform::readRawInputBuffer() noexcept
+    {
+        if (!m_isRawInput)
+        {
+            return;
+        }
+
+        // the size query returns the largest single report; the buffer holds a batch of them
+        UINT reportSize = 0;
+        if (GetRawInputBuffer(nullptr, &reportSize, sizeof(RAWINPUTHEADER)) != 0 || reportSize == 0)
+        {
+            return;
+        }
+
+        const size_t bufferWords = (static_cast<size_t>(reportSize) * kRawInputBatchSize + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        if (m_rawInputBuffer.size() < bufferWords)
+        {
+            m_rawInputBuffer.resize(bufferWords);
+        }
+
+        // each call removes up to a batch of reports from the queue, until it is empty
+        for (;;)
+        {
+            UINT bufferSize = static_cast<UINT>(m_rawInputBuffer.size() * sizeof(uint64_t));
+            PRAWINPUT input = reinterpret_cast<PRAWINPUT>(m_rawInputBuffer.data());
+            const UINT count = GetRawInputBuffer(input, &bufferSize, sizeof(RAWINPUTHEADER));
+            if (count == 0 || count == static_cast<UINT>(-1))
+            {
+                break;
+            }
+
+            for (UINT i = 0; i < count; ++i)
+            {
+                accumulateRawInput(*input);
+                input = NEXTRAWINPUTBLOCK(input);
+            }
+        }
+    }
+
+    void Win32Platform::accumulateRawInput(const RAWINPUT& input) noexcept
     {
+        // absolute reports (pens, remote sessions) carry positions, which WM_MOUSEMOVE already delivers
+        if (input.header.dwType != RIM_TYPEMOUSE || (input.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) != 0)
+        {
+            return;
+        }
+
+        m_rawDeltaX += input.data.mouse.lLastX;
+        m_rawDeltaY += input.data.mouse.lLastY;
+    }
+
+    void Win32Platform::toggleFullscreen(FullscreenMode mode) noexcept
+    {
+        const FullscreenMode currentMode = m_fullscreenMode.load(std::memory_order_relaxed);
+
+        // borderless and exclusive windows share their geometry: switching between them only changes how the swapchain
+        // presents, announced through a resize event of the unchanged extent
+        if (currentMode != FullscreenMode::kWindowed && currentMode != mode)
+        {
+            m_fullscreenMode.store(mode, std::memory_order_release);
+            m_eventManager.onWindowResize(m_width, m_height);
+            return;
+        }
+
         MONITORINFO monitorInfo {};                                            
         monitorInfo.cbSize = sizeof(MONITORINFO);                    
-        if (!m_isFullscreen)                             
+        if (currentMode == FullscreenMode::kWindowed)                             
         {
+            // published before SetWindowPos sends the resize, which recreates the swapchain for the mode
+            const HMONITOR monitor = MonitorFromWindow(m_hwnd, MONITOR_DEFAULTTOPRIMARY);
+            m_monitor.store(monitor, std::memory_order_release);
+            m_fullscreenMode.store(mode, std::memory_order_release);
+
             // save current window placement and style
             m_windowStyle = GetWindowLong(m_hwnd, GWL_STYLE);       
             if (m_windowStyle & WS_OVERLAPPEDWINDOW)               
             {
-                if (GetWindowPlacement(m_hwnd, &m_windowPlacement) && 
-                    GetMonitorInfo(MonitorFromWindow(m_hwnd, MONITOR_DEFAULTTOPRIMARY), &monitorInfo))
+                if (GetWindowPlacement(m_hwnd, &m_windowPlacement) && GetMonitorInfo(monitor, &monitorInfo))
                 {
                     SetWindowLong(m_hwnd, GWL_STYLE, (m_windowStyle & ~WS_OVERLAPPEDWINDOW));
                     SetWindowPos(m_hwnd, 
@@ -313,16 +571,16 @@ namespace keplar
                 }                                                          
             }
             ShowCursor(FALSE);                                 
-            m_isFullscreen = true;                          
         }
         else                                                   
         { 
             // restore window style and placement
+            m_fullscreenMode.store(FullscreenMode::kWindowed, std::memory_order_release);
+            m_monitor.store(nullptr, std::memory_order_release);
             SetWindowLong(m_hwnd, GWL_STYLE, (m_windowStyle | WS_OVERLAPPEDWINDOW));
             SetWindowPlacement(m_hwnd, &m_windowPlacement);
             SetWindowPos(m_hwnd, HWND_TOP, 0, 0, 0, 0, SWP_NOOWNERZORDER | SWP_NOSIZE | SWP_NOMOVE | SWP_NOZORDER | SWP_FRAMECHANGED);
             ShowCursor(TRUE);            
-            m_isFullscreen = false;
         }
     }
 }   // namespace keplar
@@ -5,6 +5,10 @@
 #pragma once
 
 #include <Windows.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "platform/platform.hpp"
 #include "platform/event_manager.hpp"
 
@@ -27,18 +31,32 @@ namespace keplar
             virtual void* getWindowHandle() const noexcept override;
             virtual uint32_t getWindowWidth() const noexcept override;
             virtual uint32_t getWindowHeight() const noexcept override;
+            virtual bool isWindowFocused() const noexcept override;
+            virtual bool isWindowMinimized() const noexcept override;
+            virtual FullscreenMode getFullscreenMode() const noexcept override;
+            virtual void* getMonitorHandle() const noexcept override;
+            virtual DisplayRefresh getDisplayRefresh() const noexcept override;
 
             // event listeners
             virtual void addListener(const std::shared_ptr<EventListener>& listener) noexcept override;
             virtual void removeListener(const std::shared_ptr<EventListener>& listener) noexcept override;
             virtual void enableImGuiEvents(bool enabled) noexcept override;
+            virtual void setDeferredEventDispatch(bool enabled) noexcept override;
+            virtual void dispatchDeferredEvents() noexcept override;
+            virtual void waitEvents(uint32_t timeoutMs) noexcept override;
+            virtual void setInputReplay(bool enabled) noexcept override;
+            virtual void replayInputFrame(const InputFrame& frame) noexcept override;
 
             // vulkan 
             virtual VkSurfaceKHR createSurface(VkInstance vkInstance) const noexcept override;
             virtual std::vector<std::string_view> getSurfaceExtensions() const noexcept override;
 
         private:
-            void toggleFullscreen() noexcept;
+            // F11 toggles borderless, alt+enter exclusive fullscreen; toggling the active mode returns to windowed
+            void toggleFullscreen(FullscreenMode mode) noexcept;
+            void registerRawInput() noexcept;
+            void readRawInputBuffer() noexcept;
+            void accumulateRawInput(const RAWINPUT& input) noexcept;
             static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
             
         private:
@@ -50,10 +68,34 @@ namespace keplar
             uint32_t            m_width;
             uint32_t            m_height;
             bool                m_shouldClose;
-            bool                m_isFullscreen;
+            std::atomic<FullscreenMode> m_fullscreenMode;
+            std::atomic<HMONITOR>       m_monitor;          // monitor the window covers while fullscreen
+            std::atomic<bool>   m_isFocused;
+            std::atomic<bool>   m_isMinimized;
 
             // input/event handling
             EventManager        m_eventManager;
             bool                m_imguiEvents;
+
+            // raw mouse input: reports drained in batches by pollEvents and summed into one relative motion per pump;
+            // the cursor keeps its legacy WM_MOUSEMOVE messages
+            bool                    m_isRawInput;
+            LONG                    m_rawDeltaX;
+            LONG                    m_rawDeltaY;
+            std::vector<uint64_t>   m_rawInputBuffer;       // 8 byte aligned RAWINPUT blocks
+
+            // deferred dispatch: imgui sees its messages on the render thread that builds the ui
+            struct ImGuiMessage
+            {
+                HWND    mHwnd;
+                UINT    mMsg;
+                WPARAM  mWParam;
+                LPARAM  mLParam;
+            };
+
+            std::atomic<bool>           m_isDeferred;
+            std::mutex                  m_imguiMutex;
+            std::vector<ImGuiMessage>   m_imguiMessages;
+            std::vector<ImGuiMessage>   m_imguiDispatch;
     };
 }   // namespace keplar
@@ -6,14 +6,15 @@
 #include "utils/logger.hpp"
 #include "samples/PBR/pbr.hpp"
 
-int main([[maybe_unused]]int argc, [[maybe_unused]] char* argv[])
+int main(int argc, char* argv[])
 {
     // start the logging thread early
     keplar::Logger::getInstance();
 
     // create and initialize app
     keplar::KeplarApp app;
-    if (!app.initialize(std::make_unique<keplar::PBR>()))
+    // --headless / --benchmark [frames] select an offscreen or scripted benchmark run
+    if (!app.initialize(std::make_unique<keplar::PBR>(), keplar::KeplarAppOptions::fromCommandLine(argc, argv)))
     {
         VK_LOG_FATAL("failed to initialize Keplar application");
         return EXIT_FAILURE;
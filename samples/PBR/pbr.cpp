@@ -3,8 +3,132 @@
 // ────────────────────────────────────────────
 
 #include "pbr.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "utils/allocation_tracker.hpp"
+#include "utils/asset_pack.hpp"
+#include "utils/async_file_io.hpp"
 #include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
 #include "vulkan/vulkan_utils.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "core/keplar_config.hpp"
+#include "graphics/texture_streamer.hpp"
+#include "graphics/model_cache.hpp"
+
+namespace
+{
+    // parallel cpu-path scene recording: worker count cap, and the fewest draw runs worth a worker of their own
+    constexpr uint32_t kMaxRecordWorkers = 4;
+    constexpr uint32_t kMinRunsPerWorker = 128;
+
+    // resize is applied once the window extent has been stable this long (dragging emits a burst of events)
+    constexpr std::chrono::milliseconds kResizeDebounce{ 50 };
+
+    // benchmark runs: warm-up frames before capture, and the fixed simulation step replacing the frame dt
+    constexpr uint32_t kBenchmarkWarmupFrames = 60;
+    constexpr float    kBenchmarkTimeStep     = 1.0f / 60.0f;
+
+    // telemetry runs: frames between two published samples; every sample sorts the metric histories once
+    constexpr uint32_t kTelemetryInterval     = 30;
+
+    // on-demand rendering: frames rendered after the last change, and how long auto exposure keeps them coming
+    constexpr uint32_t kRedrawSettleFrames    = 8;
+    constexpr uint32_t kTemporalSettleFrames  = 32;     // temporal aa history converging on a still frame
+    constexpr std::chrono::milliseconds kExposureSettleTime{ 2000 };
+
+    // depth pre-pass in occluder mode: draws spanning fewer pixels are left to the main pass
+    constexpr float kDefaultOccluderPixels = 64.0f;
+
+    // dynamic resolution: sharpening of the upscale pass, 0 leaves the bilinear result
+    constexpr float kDefaultUpscaleSharpness = 0.3f;
+
+    // variable rate shading: pipeline rate of low-detail materials (the coarsest rate every device supports), and the
+    // relative luminance contrast below which the adaptive rate image halves an axis
+    constexpr VkExtent2D kCoarseFragmentSize = { 2, 2 };
+    constexpr float kDefaultShadingRateThreshold = 0.08f;
+
+    // stereo: both eyes render in one multiview pass into the two layers of the scene targets
+    constexpr uint32_t kStereoViewMask = 0b11;
+    constexpr float    kDefaultInterpupillaryDistance = 0.064f;
+
+    // reverse-z depth with the far plane at infinity: 1 at the near plane, cleared to 0, nearer fragments pass
+    constexpr float       kClearDepth       = 0.0f;
+    constexpr VkCompareOp kDepthCompareOp   = VK_COMPARE_OP_GREATER_OR_EQUAL;
+
+    // a light's range ends where its inverse square falloff drops below this radiance
+    constexpr float kLightCutoff = 0.05f;
+
+    // generated scene lights: scattered in a box around the model, with ranges between the two radii
+    constexpr float kPointLightSpread    = 3.0f;
+    constexpr float kPointLightMinRadius = 0.5f;
+    constexpr float kPointLightMaxRadius = 1.5f;
+    constexpr float kPointLightRadiance  = 4.0f;    // unwindowed radiance at the light's full range
+
+    // scene model, relative to config::kModelDir
+    constexpr const char* kModelFile = "DamagedHelmet.glb";
+
+    // shared geometry of the loaded models, in the packed vertex layout the sample loads with
+    constexpr uint32_t kGeometryArenaVertices = 512u * 1024;
+    constexpr uint32_t kGeometryArenaIndices  = 2u * 1024 * 1024;
+
+    // scene shaders, in the order of PBR::getSceneShaders
+    enum SceneShaderIndex : size_t { kVertexShader, kFragmentShader, kIndirectVertexShader, kObjectVertexShader, kBindlessFragmentShader,
+                                     kMeshletTaskShader, kMeshletMeshShader, kPulledVertexShader, kHalfFragmentShader, kMultiDrawVertexShader,
+                                     kRayQueryFragmentShader, kRayQueryBindlessFragmentShader, kGBufferFragmentShader, kGBufferBindlessFragmentShader };
+
+    struct SceneShaderSource
+    {
+        VkShaderStageFlagBits   mStage;
+        const char*             mFile;
+    };
+
+    constexpr std::array<SceneShaderSource, 14> kSceneShaderSources =
+    {{
+        { VK_SHADER_STAGE_VERTEX_BIT,   "pbr/pbr.vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr.frag.spv" },
+        { VK_SHADER_STAGE_VERTEX_BIT,   "pbr/pbr_indirect.vert.spv" },
+        { VK_SHADER_STAGE_VERTEX_BIT,   "pbr/pbr_object.vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr_bindless.frag.spv" },
+        { VK_SHADER_STAGE_TASK_BIT_EXT, "pbr/pbr_meshlet.task.spv" },
+        { VK_SHADER_STAGE_MESH_BIT_EXT, "pbr/pbr_meshlet.mesh.spv" },
+        { VK_SHADER_STAGE_VERTEX_BIT,   "pbr/pbr_pulled.vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr_half.frag.spv" },
+        { VK_SHADER_STAGE_VERTEX_BIT,   "pbr/pbr_object_multi.vert.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr_rq.frag.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr_bindless_rq.frag.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr_gbuffer.frag.spv" },
+        { VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr_bindless_gbuffer.frag.spv" },
+    }};
+
+    // contents of a light set (set 2) in binding order, written through one update template
+    struct LightSetDescriptors
+    {
+        VkDescriptorBufferInfo  mLight;             // binding 0: light block, placed by the dynamic offset
+        VkDescriptorBufferInfo  mStorage[2];        // binding 1-2: lights and cluster records
+        VkDescriptorImageInfo   mEnvironment[3];    // binding 3-5: irradiance, prefiltered and brdf lut
+        VkDescriptorImageInfo   mShadows[2];        // binding 6-7: cascade and cube shadow maps
+        VkAccelerationStructureKHR mShadowScene;    // binding 8: top level traced by ray query shadows (only in their layout)
+    };
+
+    // pipeline shading rate with per-primitive rates ignored; attachmentOp decides how the rate image combines with it
+    VkPipelineFragmentShadingRateStateCreateInfoKHR makeShadingRateState(VkExtent2D fragmentSize, VkFragmentShadingRateCombinerOpKHR attachmentOp) noexcept
+    {
+        VkPipelineFragmentShadingRateStateCreateInfoKHR shadingRateState{};
+        shadingRateState.sType          = VK_STRUCTURE_TYPE_PIPELINE_FRAGMENT_SHADING_RATE_STATE_CREATE_INFO_KHR;
+        shadingRateState.pNext          = nullptr;
+        shadingRateState.fragmentSize   = fragmentSize;
+        shadingRateState.combinerOps[0] = VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR;
+        shadingRateState.combinerOps[1] = attachmentOp;
+        return shadingRateState;
+    }
+}   // namespace
 
 namespace keplar
 {
@@ -15,12 +139,96 @@ namespace keplar
         , m_vkSwapchainKHR(VK_NULL_HANDLE)
         , m_windowWidth(0)
         , m_windowHeight(0)
+        , m_pendingWidth(0)
+        , m_pendingHeight(0)
+        , m_isResizePending(false)
+        , m_isSwapchainOutOfDate(false)
+        , m_scenePass(kInvalidRenderGraphHandle)
         , m_sampleCount(VK_SAMPLE_COUNT_1_BIT)
+        , m_antiAliasingMode(AntiAliasingMode::kMsaa)
+        , m_requestedAntiAliasingMode(AntiAliasingMode::kMsaa)
+        , m_requestedSampleCount(VK_SAMPLE_COUNT_4_BIT)
         , m_swapchainImageCount(0)
-        , m_maxFramesInFlight(0)
+        , m_maxFramesInFlight(GLTFModel::kMaxFramesInFlight)
+        , m_activeFramesInFlight(glm::clamp(config::kFramesInFlight, 1u, GLTFModel::kMaxFramesInFlight))
+        , m_requestedFramesInFlight(m_activeFramesInFlight)
         , m_currentImageIndex(0)
         , m_currentFrameIndex(0)
         , m_readyToRender(false)
+        , m_partitionRecordCount(0)
+        , m_usePresentPacing(false)
+        , m_latencyFrameId(0)
+        , m_frameLatencyId(0)
+        , m_recordWorkerCount(0)
+        , m_workerCommandCounts{}
+        , m_sceneRecorderStats{}
+        , m_depthRecorderStats{}
+        , m_cameraDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_lightDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_isGpuDriven(false)
+        , m_useDrawIndirectCount(false)
+        , m_isVertexPulling(false)
+        , m_requestedVertexPulling(false)
+        , m_depthPipelineHandles{}
+        , m_depthPrepass(kInvalidRenderGraphHandle)
+        , m_depthPrepassMode(DepthPrepassMode::kOff)
+        , m_requestedDepthPrepassMode(DepthPrepassMode::kOff)
+        , m_occluderPixels(kDefaultOccluderPixels)
+        , m_updateDt(0.0f)
+        , m_frameDt(0.0f)
+        , m_isPostProcessAvailable(true)
+        , m_tileToneMapPass(kInvalidRenderGraphHandle)
+        , m_isTileLocalPost(false)
+        , m_requestedTileLocalPost(false)
+        , m_isOverlayRetargeted(false)
+        , m_isDeferred(false)
+        , m_requestedDeferred(false)
+        , m_isAmbientOcclusion(true)
+        , m_renderExtent{}
+        , m_upscaleSharpness(kDefaultUpscaleSharpness)
+        , m_isDynamicResolution(false)
+        , m_requestedDynamicResolution(false)
+        , m_isStereo(false)
+        , m_requestedStereo(false)
+        , m_stereoMirrorEye(0)
+        , m_interpupillaryDistance(kDefaultInterpupillaryDistance)
+        , m_shadingRateMode(ShadingRateMode::kOff)
+        , m_requestedShadingRateMode(ShadingRateMode::kOff)
+        , m_shadingRateThreshold(kDefaultShadingRateThreshold)
+        , m_isExtendedDynamicState(false)
+        , m_isShaderObject(false)
+        , m_isHalfPrecision(true)
+        , m_requestedHalfPrecision(true)
+        , m_isBindless(false)
+        , m_isMultiDraw(false)
+        , m_isMeshShading(false)
+        , m_pointLightCount(0)
+        , m_environmentIntensity(1.0f)
+        , m_sunDirection(0.4f, 1.0f, 0.3f)
+        , m_sunColor(1.0f, 0.95f, 0.85f)
+        , m_sunIntensity(2.0f)
+        , m_isShadowsEnabled(true)
+        , m_isRayTracedShadows(false)
+        , m_frameProfileScope(UINT32_MAX)
+        , m_frameCommandCounts{}
+        , m_cullingDrawnCount(0)
+        , m_cullingTestedCount(0)
+        , m_updateCpuMs(0.0f)
+        , m_frameUpdateCpuMs(0.0f)
+        , m_isFramePrepared(false)
+        , m_isSceneRecordNeeded(false)
+        , m_preparedRunCount(0)
+        , m_isOverlayDrawn(false)
+        , m_benchmarkFrameCount(0)
+        , m_benchmarkFrame(0)
+        , m_isBenchmarkRunning(false)
+        , m_isBenchmarkComplete(false)
+        , m_telemetryFrameCount(0)
+        , m_redrawFrameCount(kRedrawSettleFrames)
+        , m_redrawDeadline{}
+        , m_interpolationAlpha(1.0f)
+        , m_cameraDescriptorSet(VK_NULL_HANDLE)
+        , m_isCameraPushed(false)
     {
     }
 
@@ -38,11 +246,27 @@ namespace keplar
         // ensure gpu has finished executing all submitted commands
         vkDeviceWaitIdle(m_vkDevice);
 
+        // wait for background pipeline compiles before their configs go away
+        m_pipelineLibrary.destroy();
+
         // destroy vulkan resources 
+        m_deletionQueue.flush();
         GLTFModel::destroySharedResources(m_vkDevice);
         m_swapchain.reset();
-        m_commandPool.deallocate(m_primaryCommandBuffers);
         m_commandPool.deallocate(m_secondaryCommandBuffer);
+        for (auto& partitionCommandBuffers : m_partitionCommandBuffers)
+        {
+            m_commandPool.deallocate(partitionCommandBuffers);
+        }
+        m_frameCommandAllocator.destroy();
+        for (auto& frameDescriptorAllocator : m_frameDescriptorAllocators)
+        {
+            frameDescriptorAllocator.destroy();
+        }
+        m_descriptorAllocator.destroy();
+        m_frameTimeline.destroy();
+        m_lowLatency.destroy();
+        m_statsReadback.destroy();
     }
 
     bool PBR::initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept
@@ -76,108 +300,298 @@ namespace keplar
         m_windowWidth     = platformLocked->getWindowWidth();
         m_windowHeight    = platformLocked->getWindowHeight();
 
-        // initialize vulkan resources
-        if (!createSwapchain())             { return false; }
-        if (!createMsaaTarget(*device))     { return false; }
-        if (!createCommandPool(*device))    { return false; }
-        if (!createCommandBuffers())        { return false; }
-        if (!createTextureSamplers(*device)){ return false; }
-        if (!loadAssets(*device))           { return false; }
-        if (!createUniformBuffers(*device)) { return false; }
-        if (!createShaderModules())         { return false; }
-        if (!createDescriptorSetLayouts())  { return false; }
-        if (!createDescriptorPool())        { return false; }
-        if (!createDescriptorSets())        { return false; }
-        if (!createRenderPasses())          { return false; }
-        if (!createGraphicsPipeline())      { return false; }
-        if (!createFramebuffers())          { return false; }
-        if (!createSyncPrimitives())        { return false; }
-        if (!recordSceneCommandBuffers())   { return false; }
-        if (!prepareScene())                { return false; }
+        // initialize vulkan resources; the model decodes in the background until the first step that depends on it
+        if (!KEPLAR_STARTUP_STEP(loadAssets(*device)))                 { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSwapchain()))                   { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandPool(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createStagingBelt(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandBuffers()))              { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRecordWorkers(*device)))        { return false; }
+        if (!KEPLAR_STARTUP_STEP(createTextureSamplers(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createUniformBuffers(*device)))       { return false; }
+        if (!KEPLAR_STARTUP_STEP(createShaderModules(*device)))        { return false; }
+        if (!KEPLAR_STARTUP_STEP(createLightClusters(*device)))        { return false; }
+        if (!KEPLAR_STARTUP_STEP(createEnvironmentLighting(*device)))  { return false; }
+        if (!KEPLAR_STARTUP_STEP(finishAssets(*device)))               { return false; }
+        if (!KEPLAR_STARTUP_STEP(createShadowMaps(*device)))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRayTracedShadows(*device)))     { return false; }
+        if (!KEPLAR_STARTUP_STEP(createMeshShading(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGpuCulling(*device)))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGpuSkinning(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createBindlessMaterials(*device)))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSetLayouts(*device))) { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorPool()))              { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSets()))              { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGpuProfiler(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRenderGraph(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGraphicsPipeline(*device)))     { return false; }
+        if (!KEPLAR_STARTUP_STEP(createFrameTimeline(*device)))        { return false; }
+        if (!KEPLAR_STARTUP_STEP(createPresentWait(*device)))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createLowLatency(*device)))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSyncPrimitives()))              { return false; }
+        if (!KEPLAR_STARTUP_STEP(recordSceneCommandBuffers()))         { return false; }
+        if (!KEPLAR_STARTUP_STEP(prepareScene()))                      { return false; }
 
         VK_LOG_INFO("PBR::initialize successful");
         return true;
     }
 
+    void PBR::preload() noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+
+        // nothing here needs the device: reading the files initialize opens first (model or its baked cache, environment,
+        // scene shaders) as one overlapped batch leaves them in the os file cache by the time they are mapped or parsed
+        const std::filesystem::path modelPath = config::kModelDir / kModelFile;
+        std::vector<std::filesystem::path> paths = { modelPath, getModelCachePath(modelPath), config::kTextureDir / "environment.hdr" };
+        for (const SceneShaderSource& source : kSceneShaderSources)
+        {
+            paths.emplace_back(config::kShaderDir / source.mFile);
+        }
+
+        std::vector<FileRead> reads;
+        reads.reserve(paths.size());
+        for (const std::filesystem::path& path : paths)
+        {
+            if (AssetPack::exists(path))
+            {
+                reads.emplace_back().mPath = path;
+            }
+        }
+
+        // the contents are dropped again, the loaders read them through their own paths
+        if (!AsyncFileIO::getThreadInstance().readFiles(reads.data(), reads.size()))
+        {
+            VK_LOG_DEBUG("PBR::preload : some files failed to read, they load on demand");
+        }
+        VK_LOG_DEBUG("PBR::preload read %zu files", reads.size());
+    }
+
     void PBR::update(float dt) noexcept
     {
-        // update scene state
+        KEPLAR_PROFILE_FUNCTION();
+        const auto updateStart = std::chrono::steady_clock::now();
+
+        // benchmark frames replay the same poses and animation regardless of how long each frame took
+        if (m_isBenchmarkRunning)
+        {
+            dt = kBenchmarkTimeStep;
+            poseBenchmarkCamera();
+        }
+
+        // update scene state; only the camera and the model are touched, so this may overlap submitFrame()
         m_camera->update(dt);
+        m_gltfModel.update(dt);
+        m_updateDt = dt;
+        m_updateCpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
     }
 
     bool PBR::render() noexcept
     {
+        return prepareFrame() && submitFrame();
+    }
+
+    bool PBR::prepareFrame() noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+        m_isFramePrepared = false;
+        m_frameUpdateCpuMs = m_updateCpuMs;
+        m_frameDt = m_updateDt;
+
+        // benchmark bookkeeping of the frame just simulated (capture window, completion)
+        if (m_isBenchmarkRunning)
+        {
+            advanceBenchmark();
+        }
+
+        // input for this frame was sampled by update(): latency is measured from here to its present. a frame that was
+        // not paced by the latency sleep (benchmarks) still takes the next id, so present ids keep increasing
+        m_presentWait.markFrameStart();
+        m_redrawFrameCount -= (m_redrawFrameCount > 0) ? 1 : 0;
+        if (m_lowLatency.isValid())
+        {
+            m_frameLatencyId = (m_latencyFrameId != 0) ? m_latencyFrameId : m_lowLatency.beginFrame();
+            m_latencyFrameId = 0;
+            m_lowLatency.setMarker(m_frameLatencyId, LatencyMarker::kSimulationEnd);
+        }
+        m_frameMetrics.beginFrame();
+
+        // gpu time of the most recently resolved frame (the outermost profiler scope)
+        const auto& gpuResults = m_gpuProfiler.getResults();
+        if (m_gpuProfiler.isValid() && !gpuResults.empty() && gpuResults.front().mDepth == 0)
+        {
+            m_frameMetrics.record(FrameMetric::kGpuTime, gpuResults.front().mMilliseconds);
+        }
+
+        // swapchain recreation happens here rather than in the resize event, without idling the device
+        if (m_isResizePending)
+        {
+            applyPendingResize();
+        }
+
+        // pipelines of rewritten shaders are compiled in the background and swapped in here once ready
+        if constexpr (config::kShaderHotReload)
+        {
+            updateShaderReload();
+        }
+
+        // fast-linked permutations give way to their optimized links as those finish
+        if (m_pipelineLibrary.isLinkingEnabled())
+        {
+            updateOptimizedPipelines();
+        }
+
         // skip frame if renderer is not ready
         if (!m_readyToRender.load())
         {
-            VK_LOG_DEBUG("PBR::render skipped: renderer not ready");
+            VK_LOG_DEBUG_THROTTLED("PBR::prepareFrame skipped: renderer not ready");
             return true;
         }
 
-        // wait on the fence for this frame to ensure gpu finished work from last time
+        // wait on the timeline (or the fence) for this frame to ensure gpu finished work from last time
         // this prevents cpu from submitting commands for the same frame while gpu is still using it
         auto& frameSync = m_frameSyncPrimitives[m_currentFrameIndex];
-        if (!frameSync.mInFlightFence.wait())
+        const bool useTimeline = m_frameTimeline.isValid();
+        if (useTimeline ? !m_frameTimeline.waitForFrame(m_currentFrameIndex) : !frameSync.mInFlightFence.wait())
+        {
+            return false;
+        }
+
+        // the slot's previous submission is complete: release what was retired before it, take what it read back
+        m_deletionQueue.beginFrame(m_currentFrameIndex);
+        if (m_statsReadback.isValid())
+        {
+            m_statsReadback.beginFrame(m_currentFrameIndex);
+        }
+        if (useTimeline)
+        {
+            m_deletionQueue.collect(m_frameTimeline.getCompletedValue());
+        }
+
+        // cpu time of the frame excludes the waits on the frame slot above and on the swapchain image, which submitFrame
+        // acquires once everything but the passes writing it is recorded and queued
+        m_cpuWorkStart = std::chrono::steady_clock::now();
+
+        // the frame's gpu work is done: recycle its transient command buffers and descriptor sets in one reset per pool
+        if (!m_frameCommandAllocator.beginFrame(m_currentFrameIndex))
+        {
+            return false;
+        }
+        m_primaryCommandBuffers[m_currentFrameIndex] = m_frameCommandAllocator.allocatePrimary();
+        m_presentCommandBuffers[m_currentFrameIndex] = m_frameCommandAllocator.allocatePrimary();
+        m_frameDescriptorAllocators[m_currentFrameIndex].reset();
+
+        // the scene viewport follows the gpu time before anything is sized from it
+        updateRenderExtent();
+
+        // update per-frame resources
+        if (!updatePerFrame(m_currentFrameIndex))
         {
             return false;
         }
 
+        // stream texture mips for the current camera; swapped material sets invalidate the cached recordings binding them
+        if (m_gltfModel.isTextureStreamingEnabled())
+        {
+            updateTextureStreaming(m_currentFrameIndex);
+        }
+
+        // without gpu culling, gather this frame's visible draws against the current camera frustum; cached
+        // gpu-driven partitions are only re-recorded once they target the pipelines and render pass of the last
+        // resize, or once what they bind changed
+        m_preparedRunCount = 0;
+        m_isSceneRecordNeeded = !m_isGpuDriven || m_isSceneRecordStale[m_currentFrameIndex] || hasStaleScenePartitions(m_currentFrameIndex);
+        if (!m_isGpuDriven)
+        {
+            // lods by screen-space error: the camera in model space, and the pixels a unit spans at unit distance
+            const ubo::Camera& camera = m_cameraUniforms[m_currentFrameIndex];
+            const float tanHalfFov = std::tan(glm::radians(m_camera->getFov()) * 0.5f);
+            const glm::vec3 viewPosition = glm::vec3(glm::inverse(camera.view * camera.model)[3]);
+            // (meshlets only cover the full-detail ranges)
+            const float projectionScale = m_isMeshShading ? 0.0f : 0.5f * static_cast<float>(m_renderExtent.height) / tanHalfFov;
+            m_gltfModel.setLodView(viewPosition, projectionScale);
+
+            const Frustum frustum = Frustum::fromMatrix(m_cullingMatrices[m_currentFrameIndex]);
+            m_preparedRunCount = m_gltfModel.prepareDraws(m_currentFrameIndex, &frustum);
+        }
+
+        // the overlay builds its ui against renderer settings, which therefore only change between frames; its draws
+        // are recorded into the upscale pass
+        m_isOverlayDrawn = m_imguiLayer && m_imguiLayer->buildFrame();
+        m_isFramePrepared = true;
+        return true;
+    }
+
+    bool PBR::submitFrame() noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+
+        // prepareFrame skipped this frame (renderer not ready)
+        if (!m_isFramePrepared)
+        {
+            return true;
+        }
+        m_isFramePrepared = false;
+        m_lowLatency.setMarker(m_frameLatencyId, LatencyMarker::kRenderSubmitStart);
+
         // frame-specific semaphores and fence
+        auto& frameSync = m_frameSyncPrimitives[m_currentFrameIndex];
+        const bool useTimeline = m_frameTimeline.isValid();
+        const bool isOffscreen = m_swapchain->isOffscreen();
         const auto imageAcquireSemaphore    = frameSync.mImageAvailableSemaphore.get();
         const auto renderCompleteSemaphore  = frameSync.mRenderCompleteSemaphore.get();
         const auto inFlightFence            = frameSync.mInFlightFence.get();
 
-        // acquire next image from swapchain, signaling the image available semaphore 
-        VkResult vkResult = vkAcquireNextImageKHR(m_vkDevice, m_vkSwapchainKHR, UINT64_MAX, imageAcquireSemaphore, VK_NULL_HANDLE, &m_currentImageIndex);
-        if (vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_SUBOPTIMAL_KHR)
+        // record the scene draws gathered by prepareFrame
+        m_partitionRecordCount = 0;
+        if (m_isSceneRecordNeeded && !recordSceneCommandBuffer(m_currentFrameIndex, m_preparedRunCount))
         {
-            VK_LOG_DEBUG("vkAcquireNextImageKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            onWindowResize(m_windowWidth, m_windowHeight);
-            return true;
+            return false;
         }
-        else if (vkResult != VK_SUCCESS)
-        {
-            VK_LOG_FATAL("vkAcquireNextImageKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+        m_isSceneRecordStale[m_currentFrameIndex] = false;
+
+        // every pass ahead of the swapchain (shadows, culling, scene, post processing) records and starts on the gpu
+        // before an image is acquired; frame resources are reused once the later submission below completes
+        if (!recordFrameCommandBuffer(m_currentFrameIndex))
+        {    
             return false;
         }
 
-        // wait if this swapchain image is still in flight
-        VkFence& imageFence = m_imagesInFlightFences[m_currentImageIndex];
-        if (imageFence != VK_NULL_HANDLE)
+        const VkCommandBuffer frameCommandBuffer = m_primaryCommandBuffers[m_currentFrameIndex].get();
+        VkSubmitInfo frameSubmitInfo{};
+        frameSubmitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        frameSubmitInfo.pNext              = m_lowLatency.chainSubmitFrameId(nullptr, m_frameLatencyId);
+        frameSubmitInfo.commandBufferCount = 1;
+        frameSubmitInfo.pCommandBuffers    = &frameCommandBuffer;
+        if (!VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &frameSubmitInfo, VK_NULL_HANDLE)))
         {
-            vkResult = vkWaitForFences(m_vkDevice, 1, &imageFence, VK_TRUE, UINT64_MAX);
-            if (vkResult != VK_SUCCESS)
-            {
-                VK_LOG_ERROR("vkWaitForFences failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-                return false;
-            }
+            return false;
         }
 
-        // mark this image as now owned by current frame fence
-        imageFence = inFlightFence;
-
-        // reset current frame fence before submitting new gpu work
-        if (!frameSync.mInFlightFence.reset())
+        // acquire as late as possible: only the swapchain passes wait on the image. without one (out of date) the
+        // frame still completes its slot, with nothing to present
+        bool isImageAcquired = false;
+        const auto acquireStart = std::chrono::steady_clock::now();
+        if (!acquireSwapchainImage(isImageAcquired))
         {
             return false;
         }
+        const auto acquireWait = std::chrono::steady_clock::now() - acquireStart;
 
-        // update per-frame resources
-        if (!updatePerFrame(m_currentFrameIndex))
+        // reset the frame fence (no timeline), now that the acquired image no longer waits on it
+        if (!useTimeline && !frameSync.mInFlightFence.reset())
         {
             return false;
         }
 
-        // record primary buffer for this frame targeting the acquired swapchain framebuffer
-        if (!recordFrameCommandBuffer(m_currentFrameIndex, m_currentImageIndex))
-        {    
+        // record the passes writing the swapchain image; they close the frame's profiler scope
+        if (!recordPresentCommandBuffer(m_currentFrameIndex, m_currentImageIndex, isImageAcquired))
+        {
             return false;
         }
 
-        // prepare command buffers to submit
-        VkCommandBuffer commandBuffers[2]{};
-        commandBuffers[0] = m_primaryCommandBuffers[m_currentFrameIndex].get();
-        commandBuffers[1] = m_imguiLayer->recordFrame(m_currentFrameIndex, m_currentImageIndex);
+        // the present buffer carries the upscale pass, overlay included
+        const VkCommandBuffer commandBuffer = m_presentCommandBuffers[m_currentFrameIndex].get();
 
         // pipeline wait stages
         const VkPipelineStageFlags waitDstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
@@ -185,734 +599,3069 @@ namespace keplar
         // setup queue submit info
         VkSubmitInfo submitInfo{};
         submitInfo.sType                 = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.pNext                 = nullptr;
+        submitInfo.pNext                 = m_lowLatency.chainSubmitFrameId(nullptr, m_frameLatencyId);
         submitInfo.pWaitDstStageMask     = &waitDstStageMask;
         submitInfo.waitSemaphoreCount    = 1;
         submitInfo.pWaitSemaphores       = &imageAcquireSemaphore;
-        submitInfo.commandBufferCount    = 2;
-        submitInfo.pCommandBuffers       = commandBuffers;
+        submitInfo.commandBufferCount    = 1;
+        submitInfo.pCommandBuffers       = &commandBuffer;
         submitInfo.signalSemaphoreCount  = 1;
         submitInfo.pSignalSemaphores     = &renderCompleteSemaphore;
 
-        // submit command buffer to graphics queue with fence to track GPU work
-        if (!VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, inFlightFence)))
+        // timeline: also signal the frame's value; binary semaphores ignore their (zero) entries
+        const VkSemaphore signalSemaphores[2] = { renderCompleteSemaphore, m_frameTimeline.get() };
+        const uint64_t signalValues[2] = { 0, m_frameTimeline.getPendingValue() };
+        const uint64_t waitValue = 0;
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        timelineSubmitInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.pNext                     = submitInfo.pNext;
+        timelineSubmitInfo.waitSemaphoreValueCount   = 1;
+        timelineSubmitInfo.pWaitSemaphoreValues      = &waitValue;
+        timelineSubmitInfo.signalSemaphoreValueCount = 2;
+        timelineSubmitInfo.pSignalSemaphoreValues    = signalValues;
+        if (useTimeline)
         {
-            return false;
+            submitInfo.pNext                = &timelineSubmitInfo;
+            submitInfo.signalSemaphoreCount = 2;
+            submitInfo.pSignalSemaphores    = signalSemaphores;
         }
 
-        // prepare present info to present the rendered image
-        VkPresentInfoKHR presentInfo{};
-        presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pNext               = nullptr;
-        presentInfo.waitSemaphoreCount  = 1;
-        presentInfo.pWaitSemaphores     = &renderCompleteSemaphore;
-        presentInfo.swapchainCount      = 1;
-        presentInfo.pSwapchains         = &m_vkSwapchainKHR;
-        presentInfo.pImageIndices       = &m_currentImageIndex;
-
-        // queue the present operation
-        vkResult = vkQueuePresentKHR(m_presentQueue, &presentInfo);
-        if (vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_SUBOPTIMAL_KHR)
+        // offscreen images are neither acquired nor presented, and an image that was not acquired is not presented:
+        // no binary semaphores to wait on or signal
+        const bool isPresented = !isOffscreen && isImageAcquired;
+        if (!isPresented)
         {
-            VK_LOG_DEBUG("vkQueuePresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            onWindowResize(m_windowWidth, m_windowHeight);
-            return true;
+            submitInfo.waitSemaphoreCount             = 0;
+            submitInfo.pWaitSemaphores                = nullptr;
+            submitInfo.pWaitDstStageMask              = nullptr;
+            submitInfo.signalSemaphoreCount           = useTimeline ? 1 : 0;
+            submitInfo.pSignalSemaphores              = useTimeline ? &signalSemaphores[1] : nullptr;
+            timelineSubmitInfo.waitSemaphoreValueCount   = 0;
+            timelineSubmitInfo.pWaitSemaphoreValues      = nullptr;
+            timelineSubmitInfo.signalSemaphoreValueCount = 1;
+            timelineSubmitInfo.pSignalSemaphoreValues    = &signalValues[1];
         }
-        else if (vkResult != VK_SUCCESS)
+
+        // submit command buffer to graphics queue; the fence tracks gpu work only without a timeline
+        if (!VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, useTimeline ? VK_NULL_HANDLE : inFlightFence)))
         {
-            VK_LOG_FATAL("vkQueuePresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // advance to the next frame sync object (cycling through available frames in flight)
-        m_currentFrameIndex = (m_currentFrameIndex + 1) % m_maxFramesInFlight;
-        return true;
-    }
-
-    void PBR::configureVulkan(VulkanContextConfig& config) noexcept
-    {
-        // enable sampler anisotropy for higher quality texture filtering
-        config.mRequestedFeatures.samplerAnisotropy = VK_TRUE;
-    }
-
-    void PBR::onWindowResize(uint32_t width, uint32_t height)
-    {    
-        // window minimized or device not available: stop rendering
-        auto device = m_device.lock();
-        if (width == 0 || height == 0 || !device)
+        if (useTimeline)
         {
-            m_readyToRender.store(false);
-            return;
+            m_frameTimeline.markSubmitted(m_currentFrameIndex);
         }
 
-        // stop rendering and wait for device to finish all operations
-        m_readyToRender.store(false);
-        vkDeviceWaitIdle(m_vkDevice);
+        // resources retired so far are released once this submission completes
+        m_deletionQueue.markSubmitted(m_currentFrameIndex);
+        m_lowLatency.setMarker(m_frameLatencyId, LatencyMarker::kRenderSubmitEnd);
 
-        // recreate swapchain with new dimensions
-        if (!m_swapchain->recreate(width, height))
+        // present the rendered image (offscreen frames and those without an image end with the submission)
+        if (isPresented && !presentFrame(renderCompleteSemaphore))
         {
-            return;
+            return false;
         }
 
-        // store old max frames-in-flight for sync check
-        const uint32_t previousMaxFramesInFlight = m_maxFramesInFlight;
+        // a frames in flight change applies between frames
+        if (m_requestedFramesInFlight != m_activeFramesInFlight)
+        {
+            applyFramesInFlight();
+        }
 
-        // update swapchain handle and image count
-        m_vkSwapchainKHR      = m_swapchain->get();
-        m_swapchainImageCount = m_swapchain->getImageCount();
-        m_maxFramesInFlight   = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight   = glm::max(1u, m_maxFramesInFlight);
+        // commands this frame recorded (secondaries and overlay included), shown by the next frame's ui
+        m_frameCommandCounts = VulkanCommandCounters::take();
 
-        // reset per-image fence ownership for the new swapchain images
-        m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
+        // advance to the next frame sync object (cycling through active frames in flight)
+        m_currentFrameIndex = (m_currentFrameIndex + 1) % m_activeFramesInFlight;
+        m_frameMetrics.record(FrameMetric::kCpuTime, m_frameUpdateCpuMs + 
+                              std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_cpuWorkStart - acquireWait).count());
 
-        // teardown all dependent resources (framebuffers, pipeline, renderpass, command buffers)
-        for (auto& framebuffer : m_framebuffers)
+        if (m_telemetry.isOpen() && ++m_telemetryFrameCount % kTelemetryInterval == 0)
         {
-            framebuffer.destroy();
+            publishTelemetry();
         }
+        return true;
+    }
 
-        m_graphicsPipeline.destroy();
-        m_renderPass.destroy();
-        m_msaaTarget.destroy();
-        m_commandPool.deallocate(m_primaryCommandBuffers);
-
-        // recreate all dependent resources
-        if (!createMsaaTarget(*device))   { return; }
-        if (!createCommandBuffers())      { return; }
-        if (!createRenderPasses())        { return; }
-        if (!createGraphicsPipeline())    { return; }
-        if (!createFramebuffers())        { return; }
-        if (!recordSceneCommandBuffers()) { return; }
+    bool PBR::acquireSwapchainImage(bool& isAcquired) noexcept
+    {
+        isAcquired = false;
+        auto& frameSync = m_frameSyncPrimitives[m_currentFrameIndex];
+        const bool useTimeline = m_frameTimeline.isValid();
 
-        // recreate per-frame sync primitives if max frames-in-flight changed
-        if (m_maxFramesInFlight != previousMaxFramesInFlight)
+        // acquire next image from swapchain, signaling the image available semaphore (offscreen: no semaphore involved)
+        VkResult vkResult = VK_SUCCESS;
+        if (m_swapchain->isOffscreen())
         {
-            for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
-            {
-                auto& frameSync = m_frameSyncPrimitives[i];
-                frameSync.mInFlightFence.destroy();
-                frameSync.mRenderCompleteSemaphore.destroy();
-                frameSync.mImageAvailableSemaphore.destroy();
-            }
-            
-            if (!createSyncPrimitives()) 
-            { 
-                return; 
-            }
+            m_currentImageIndex = m_swapchain->acquireOffscreenImage();
         }
-
-        // recreate imgui resources
-        if (m_imguiLayer)
+        else
         {
-            m_imguiLayer->recreate(m_maxFramesInFlight);
+            vkResult = vkAcquireNextImageKHR(m_vkDevice, m_vkSwapchainKHR, UINT64_MAX, frameSync.mImageAvailableSemaphore.get(), VK_NULL_HANDLE, 
+                                             &m_currentImageIndex);
         }
 
-        // update window dimensions 
-        m_windowWidth  = width;
-        m_windowHeight = height;
-
-        // resume rendering
-        m_currentFrameIndex = 0;
-        m_readyToRender.store(true);
-    }
-
-    bool PBR::createSwapchain() noexcept
-    {
-        // setup swapchain
-        if (!m_swapchain->initialize(m_windowWidth, m_windowHeight))
+        if (vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT)
         {
-            VK_LOG_ERROR("PBR::createSwapchain : failed to create swapchain fpr presentation.");
+            // nothing acquired (the semaphore is unsignaled): recreate on the next frame, which also asks for the
+            // display again after exclusive fullscreen was lost
+            VK_LOG_DEBUG_THROTTLED("vkAcquireNextImageKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_isSwapchainOutOfDate = true;
+            if (!m_isResizePending) { onWindowResize(m_windowWidth, m_windowHeight); }
+            return true;
+        }
+        else if (vkResult == VK_SUBOPTIMAL_KHR)
+        {
+            // the image is acquired and the semaphore signaled: render this frame, recreate after the debounce
+            if (!m_isResizePending) { onWindowResize(m_windowWidth, m_windowHeight); }
+        }
+        else if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkAcquireNextImageKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // retrieve swapchain handle and image count
-        m_vkSwapchainKHR = m_swapchain->get();
-        m_swapchainImageCount = m_swapchain->getImageCount();
-        
-        // vulkan spec suggests max frames in flight should be less than swapchain image count
-        // to prevent CPU stalling while waiting for an image to become available for rendering.
-        // setting an upper limit of 3 balances throughput and avoids stalls.
-        m_maxFramesInFlight = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight = glm::max(1u, m_maxFramesInFlight);
-
-        VK_LOG_INFO("PBR::createSwapchain : swapchain created successfully (max frames in flight: %d)", m_maxFramesInFlight);
-        return true;
-    }
-
-    bool PBR::createMsaaTarget(const VulkanDevice& device) noexcept
-    {
-        // initialize msaa color and depth targets for the current swapchain
-        if (m_msaaTarget.initialize(device, *m_swapchain, VK_SAMPLE_COUNT_4_BIT))
+        // wait if this swapchain image is still in flight
+        if (useTimeline)
         {
-            // success
-            m_sampleCount = m_msaaTarget.getSampleCount();
-            VK_LOG_DEBUG("PBR::createMsaaTarget : msaa targets created successfully.");
+            // the image is owned by the timeline value of the submission that last rendered it
+            if (!m_frameTimeline.wait(m_imagesInFlightValues[m_currentImageIndex]))
+            {
+                return false;
+            }
+            m_imagesInFlightValues[m_currentImageIndex] = m_frameTimeline.getPendingValue();
         }
-        else 
+        else
         {
-            // fall back to no msaa
-            VK_LOG_WARN("PBR::createMsaaTarget : failed to create msaa color and depth targets.");
+            VkFence& imageFence = m_imagesInFlightFences[m_currentImageIndex];
+            if (imageFence != VK_NULL_HANDLE)
+            {
+                vkResult = vkWaitForFences(m_vkDevice, 1, &imageFence, VK_TRUE, UINT64_MAX);
+                if (vkResult != VK_SUCCESS)
+                {
+                    VK_LOG_ERROR("vkWaitForFences failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                    return false;
+                }
+            }
+
+            // mark this image as now owned by current frame fence
+            imageFence = frameSync.mInFlightFence.get();
         }
 
+        isAcquired = true;
         return true;
     }
 
-    bool PBR::createCommandPool(const VulkanDevice& device) noexcept
+    bool PBR::presentFrame(VkSemaphore renderCompleteSemaphore) noexcept
     {
-        // setup command pool for graphics queue
-        const auto graphicsFamilyIndex = device.getQueueFamilyIndices().mGraphicsFamily;
+        // prepare present info to present the rendered image
+        VkPresentInfoKHR presentInfo{};
+        presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.pNext               = m_presentWait.chainPresentId(m_swapchain->chainPresentMode(nullptr), m_frameLatencyId);
+        presentInfo.waitSemaphoreCount  = 1;
+        presentInfo.pWaitSemaphores     = &renderCompleteSemaphore;
+        presentInfo.swapchainCount      = 1;
+        presentInfo.pSwapchains         = &m_vkSwapchainKHR;
+        presentInfo.pImageIndices       = &m_currentImageIndex;
 
-        // command pool creation info
-        VkCommandPoolCreateInfo vkCommandPoolCreateInfo{};
-        vkCommandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        vkCommandPoolCreateInfo.pNext = nullptr;
-        vkCommandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        vkCommandPoolCreateInfo.queueFamilyIndex = graphicsFamilyIndex .value();
+        // queue the present operation
+        m_lowLatency.setMarker(m_frameLatencyId, LatencyMarker::kPresentStart);
+        const VkResult vkResult = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+        m_lowLatency.setMarker(m_frameLatencyId, LatencyMarker::kPresentEnd);
+        if (vkResult == VK_SUCCESS || vkResult == VK_SUBOPTIMAL_KHR)
+        {
+            m_presentWait.markPresented();
+        }
 
-        // setup command pool
-        if (!m_commandPool.initialize(m_vkDevice, vkCommandPoolCreateInfo))
+        if (vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_SUBOPTIMAL_KHR || vkResult == VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT)
         {
-            VK_LOG_ERROR("PBR::createCommandPool : failed to initialize command pool.");
+            // the frame was submitted: keep advancing, recreate from the frame loop
+            VK_LOG_DEBUG_THROTTLED("vkQueuePresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_isSwapchainOutOfDate = m_isSwapchainOutOfDate || (vkResult != VK_SUBOPTIMAL_KHR);
+            if (!m_isResizePending) { onWindowResize(m_windowWidth, m_windowHeight); }
+        }
+        else if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkQueuePresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        VK_LOG_DEBUG("PBR::createCommandPool successful");
         return true;
     }
 
-    bool PBR::createCommandBuffers() noexcept
+    bool PBR::waitForPresent() noexcept
     {
-        // allocate primary command buffers for each frame in flight
-        m_primaryCommandBuffers = m_commandPool.allocatePrimaries(m_maxFramesInFlight);
-        if (m_primaryCommandBuffers.empty())
+        // low latency: the driver holds the next frame until its computed start, which replaces any other pacing.
+        // the frame's simulation starts right after (serial frames; pipelined ones simulated ahead of this point)
+        if (m_lowLatency.isValid() && m_readyToRender.load())
         {
-            VK_LOG_ERROR("PBR::createCommandBuffers failed to allocate primary command buffers.");
-            return false;
+            m_latencyFrameId = m_lowLatency.sleep();
+            m_lowLatency.setMarker(m_latencyFrameId, LatencyMarker::kSimulationStart);
+            if (m_lowLatency.isEnabled())
+            {
+                return true;
+            }
         }
 
-        // allocate secondary command buffers to cache stable draw workloads
-        m_secondaryCommandBuffer = m_commandPool.allocateSecondaries(m_maxFramesInFlight);
-        if (m_secondaryCommandBuffer.empty())
+        if (!m_usePresentPacing || !m_presentWait.isValid() || !m_readyToRender.load())
         {
-            VK_LOG_ERROR("PBR::createCommandBuffers failed to allocate secondary command buffers.");
             return false;
         }
 
-        VK_LOG_DEBUG("PBR::createCommandBuffers successful");
-        return true;
-    }
-
-    bool PBR::createTextureSamplers(const VulkanDevice& device) noexcept
-    {
-        // create predefined samplers
-        if (!m_samplers.initialize(device))
+        // the next frame starts once the display caught up to the configured queue depth
+        if (!m_presentWait.waitForLatency(m_vkSwapchainKHR))
         {
-            VK_LOG_ERROR("PBR::createTextureSamplers failed to create samplers.");
             return false;
         }
 
-        VK_LOG_DEBUG("PBR::createTextureSamplers successful");
+        m_frameMetrics.record(FrameMetric::kPresentLatency, m_presentWait.getLatencyMs());
         return true;
     }
 
-    bool PBR::loadAssets(const VulkanDevice& device) noexcept
+    void PBR::requestRedraw() noexcept
     {
-        // initialize shared resources
-        GLTFModel::initSharedResources(m_vkDevice);
-
-        // load gltf model
-        if (!m_gltfModel.load(device, m_commandPool, "DamagedHelmet.glb"))
+        m_redrawFrameCount = m_temporalAA ? kTemporalSettleFrames : kRedrawSettleFrames;
+        if (m_postProcessSettings.mAutoExposure)
         {
-            VK_LOG_DEBUG("PBR::loadAssets failed to load gltf model");
-            return false;
-        }                                     
-        
-        VK_LOG_DEBUG("PBR::loadAssets successful");
-        return true;
+            m_redrawDeadline = std::chrono::steady_clock::now() + kExposureSettleTime;
+        }
     }
 
-    bool PBR::createUniformBuffers(const VulkanDevice& device) noexcept
+    bool PBR::needsRedraw() const noexcept
+    {
+        // changes since the last frame, or temporal state still converging on them
+        if (m_redrawFrameCount > 0 || m_isResizePending || m_isBenchmarkRunning || m_shaderReload.mIsPending)
+        {
+            return true;
+        }
+
+        // scene motion: the camera moved in the last update, or animations keep playing
+        if (m_camera->hasMoved() || m_gltfModel.hasAnimations())
+        {
+            return true;
+        }
+
+        // streamed textures still in flight are swapped in by later frames
+        const TextureStreamer* textureStreamer = m_gltfModel.getTextureStreamer();
+        if (textureStreamer && textureStreamer->getPendingUploadCount() > 0)
+        {
+            return true;
+        }
+
+        return std::chrono::steady_clock::now() < m_redrawDeadline;
+    }
+
+    bool PBR::isSteadyState() const noexcept
+    {
+        // swapchain and pipeline rebuilds and streaming swaps allocate by design
+        if (!m_readyToRender.load() || m_isResizePending || m_shaderReload.mIsPending)
+        {
+            return false;
+        }
+
+        const TextureStreamer* textureStreamer = m_gltfModel.getTextureStreamer();
+        return !textureStreamer || textureStreamer->getPendingUploadCount() == 0;
+    }
+
+    bool PBR::startBenchmark(uint32_t frameCount, const std::filesystem::path& outputPath) noexcept
+    {
+        if (!m_readyToRender.load() || frameCount == 0)
+        {
+            VK_LOG_ERROR("PBR::startBenchmark failed: renderer not ready or no frames requested");
+            return false;
+        }
+
+        // one orbit over the captured frames at the camera's starting distance from the model
+        const float distance = glm::length(m_camera->getPosition());
+        m_benchmarkPath = CameraPath::createOrbit(static_cast<float>(frameCount) * kBenchmarkTimeStep, (distance > 0.0f) ? distance : 3.0f, glm::radians(25.0f));
+        m_benchmarkOutput = outputPath;
+        m_benchmarkFrameCount = frameCount;
+        m_benchmarkFrame = 0;
+        m_isBenchmarkRunning = true;
+        m_isBenchmarkComplete = false;
+
+        // the run is paced by nothing but the gpu
+        m_usePresentPacing = false;
+        m_frameMetrics.reset();
+
+        VK_LOG_INFO("PBR::startBenchmark : %u frames after %u warm-up frames (%s)", frameCount, kBenchmarkWarmupFrames, 
+                    m_swapchain->isOffscreen() ? "offscreen" : "presented");
+        return true;
+    }
+
+    void PBR::poseBenchmarkCamera() noexcept
+    {
+        // warm-up holds the first pose so pipelines, caches and clocks settle before anything is captured
+        const uint32_t capturedFrames = (m_benchmarkFrame > kBenchmarkWarmupFrames) ? m_benchmarkFrame - kBenchmarkWarmupFrames : 0;
+        const CameraPathKey key = m_benchmarkPath.evaluate(static_cast<float>(capturedFrames) * kBenchmarkTimeStep);
+        m_camera->setOrbit(key.mYaw, key.mPitch, key.mDistance);
+    }
+
+    void PBR::advanceBenchmark() noexcept
+    {
+        // metrics are captured once the warm-up frames have played
+        if (m_benchmarkFrame == kBenchmarkWarmupFrames)
+        {
+            m_frameMetrics.beginCapture(m_benchmarkFrameCount);
+        }
+
+        const uint32_t capturedFrames = (m_benchmarkFrame > kBenchmarkWarmupFrames) ? m_benchmarkFrame - kBenchmarkWarmupFrames : 0;
+        if (capturedFrames >= m_benchmarkFrameCount)
+        {
+            finishBenchmark();
+            return;
+        }
+        ++m_benchmarkFrame;
+    }
+
+    void PBR::finishBenchmark() noexcept
+    {
+        m_frameMetrics.endCapture();
+        m_isBenchmarkRunning = false;
+        m_isBenchmarkComplete = true;
+
+        // run description next to the summaries, so results from different machines can be told apart
+        std::vector<std::pair<std::string, std::string>> properties;
+        properties.emplace_back("sample", "PBR");
+        if (auto device = m_device.lock())
+        {
+            properties.emplace_back("device", device->getPhysicalDeviceProperties().deviceName);
+        }
+        properties.emplace_back("extent", std::to_string(m_swapchain->getExtent().width) + "x" + std::to_string(m_swapchain->getExtent().height));
+        properties.emplace_back("target", m_swapchain->isOffscreen() ? "offscreen" : string_VkPresentModeKHR(m_swapchain->getPresentMode()));
+        properties.emplace_back("frames", std::to_string(m_benchmarkFrameCount));
+        properties.emplace_back("warmup_frames", std::to_string(kBenchmarkWarmupFrames));
+        properties.emplace_back("gpu_driven", m_isGpuDriven ? "true" : "false");
+        properties.emplace_back("occlusion_culling", (m_isGpuDriven && m_occlusionCulling) ? "true" : "false");
+        properties.emplace_back("vertex_pulling", (m_isGpuDriven && m_isVertexPulling) ? "true" : "false");
+        properties.emplace_back("mesh_shading", m_isMeshShading ? "true" : "false");
+        properties.emplace_back("depth_prepass", !isDepthPrepassActive() ? "off" : (m_depthPrepassMode == DepthPrepassMode::kFull ? "full" : "occluders"));
+        properties.emplace_back("dynamic_resolution", isDynamicResolutionActive() ? "true" : "false");
+        properties.emplace_back("stereo", m_isStereo ? "true" : "false");
+        properties.emplace_back("tile_local_post", m_isTileLocalPost ? "true" : "false");
+        properties.emplace_back("deferred", m_isDeferred ? "true" : "false");
+        properties.emplace_back("ambient_occlusion", (m_ambientOcclusion && m_isAmbientOcclusion) ? "true" : "false");
+        properties.emplace_back("half_precision", m_isHalfPrecision ? "true" : "false");
+        properties.emplace_back("anti_aliasing", m_temporalAA ? "temporal" : (m_fxaaPass ? "fxaa" : ("msaa " + std::to_string(static_cast<uint32_t>(m_sampleCount)) + "x")));
+        properties.emplace_back("multi_draw", m_isMultiDraw ? "true" : "false");
+        properties.emplace_back("shading_rate", m_shadingRateMode == ShadingRateMode::kOff ? "off" : (m_shadingRateImage ? "adaptive" : "materials"));
+
+        // counters of the last captured frame; the per-pass timings and pipeline statistics go into a csv next to it
+        properties.emplace_back("recorded_draws", std::to_string(m_frameCommandCounts.mDraws));
+        properties.emplace_back("recorded_binds", std::to_string(m_frameCommandCounts.mBinds));
+        properties.emplace_back("recorded_barriers", std::to_string(m_frameCommandCounts.mBarriers));
+        if (m_isGpuDriven && m_cullingTestedCount > 0)
+        {
+            properties.emplace_back("culling_drawn", std::to_string(m_cullingDrawnCount));
+            properties.emplace_back("culling_culled", std::to_string(m_cullingTestedCount - m_cullingDrawnCount));
+        }
+
+        if (!m_frameMetrics.writeCaptureJson(m_benchmarkOutput, properties))
+        {
+            VK_LOG_ERROR("PBR::finishBenchmark : failed to write %s", m_benchmarkOutput.string().c_str());
+            return;
+        }
+
+        if (m_gpuProfiler.isValid())
+        {
+            std::filesystem::path passesPath = m_benchmarkOutput;
+            passesPath.replace_filename(m_benchmarkOutput.stem().string() + "_passes.csv");
+            m_gpuProfiler.exportCsv(passesPath);
+        }
+
+        const FrameMetricStats cpu = m_frameMetrics.getCaptureStats(FrameMetric::kCpuTime);
+        const FrameMetricStats gpu = m_frameMetrics.getCaptureStats(FrameMetric::kGpuTime);
+        VK_LOG_INFO("PBR::finishBenchmark : cpu p50 %.3f p99 %.3f ms, gpu p50 %.3f p99 %.3f ms", cpu.mP50, cpu.mP99, gpu.mP50, gpu.mP99);
+    }
+
+    bool PBR::startTelemetry(const std::string& channelName) noexcept
+    {
+        m_telemetryFrameCount = 0;
+        return m_telemetry.create(channelName);
+    }
+
+    void PBR::publishTelemetry() noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+
+        // percentiles are only sorted out on demand; the overlay does the same for what it shows
+        m_frameMetrics.update();
+
+        // filled on the stack and copied into the channel's slot at once, nothing here allocates
+        TelemetryFrame frame{};
+        frame.mFrameNumber = m_telemetryFrameCount;
+        frame.mTimestampUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                                   std::chrono::steady_clock::now().time_since_epoch()).count());
+        for (uint32_t metric = 0; metric < static_cast<uint32_t>(FrameMetric::kCount); ++metric)
+        {
+            const FrameMetricStats& stats = m_frameMetrics.getStats(static_cast<FrameMetric>(metric));
+            frame.mMetrics[metric] = { stats.mLatest, stats.mP50, stats.mP95, stats.mP99 };
+        }
+        frame.mHitchCount   = m_frameMetrics.getTotalHitchCount();
+        frame.mDrawCount    = m_frameCommandCounts.mDraws;
+        frame.mBindCount    = m_frameCommandCounts.mBinds;
+        frame.mBarrierCount = m_frameCommandCounts.mBarriers;
+
+        if (const TextureStreamer* textureStreamer = m_gltfModel.getTextureStreamer())
+        {
+            frame.mPendingUploads   = textureStreamer->getPendingUploadCount();
+            frame.mStreamedTextures = textureStreamer->getStreamedTextureCount();
+            frame.mStreamedBytes    = textureStreamer->getResidentBytes();
+        }
+
+        // scopes past the channel's limit are the innermost ones of the last passes, the frame total is always first
+        for (const GpuProfileResult& result : m_gpuProfiler.getResults())
+        {
+            if (frame.mPassCount == kTelemetryMaxPasses)
+            {
+                break;
+            }
+            TelemetryPass& pass = frame.mPasses[frame.mPassCount++];
+            std::strncpy(pass.mName, result.mName.c_str(), kTelemetryNameLength - 1);
+            pass.mDepth        = result.mDepth;
+            pass.mMilliseconds = result.mMilliseconds;
+        }
+
+        if (auto device = m_device.lock())
+        {
+            std::array<MemoryBudget, VK_MAX_MEMORY_HEAPS> heapBudgets{};
+            frame.mHeapCount = std::min(device->queryMemoryHeapBudgets(heapBudgets), kTelemetryMaxHeaps);
+            for (uint32_t heap = 0; heap < frame.mHeapCount; ++heap)
+            {
+                frame.mHeaps[heap] = { heapBudgets[heap].mBudget, heapBudgets[heap].mUsage };
+            }
+        }
+
+        m_telemetry.publish(frame);
+    }
+
+    void PBR::configureVulkan(VulkanContextConfig& config) noexcept
+    {
+        // enable sampler anisotropy for higher quality texture filtering
+        config.mRequestedFeatures.samplerAnisotropy = VK_TRUE;
+
+        // pre-compressed ktx2 textures; unsupported features are dropped and those textures fall back to rgba8
+        config.mRequestedFeatures.textureCompressionBC = VK_TRUE;
+        config.mRequestedFeatures.textureCompressionASTC_LDR = VK_TRUE;
+
+        // compute mip generation indexes an array of storage image views
+        config.mRequestedFeatures.shaderStorageImageArrayDynamicIndexing = VK_TRUE;
+
+        // the tile-local tonemap bins its histogram from the fragment stage
+        config.mRequestedFeatures.fragmentStoresAndAtomics = VK_TRUE;
+
+        // streamed textures become partially resident images where the device binds sparse memory
+        config.mRequestedFeatures.sparseBinding = VK_TRUE;
+        config.mRequestedFeatures.sparseResidencyImage2D = VK_TRUE;
+
+        // stream model uploads on a dedicated transfer queue when the device exposes one
+        config.mPreferDedicatedTransferQueue = true;
+
+        // gpu-driven culling and indirect draws; unsupported features are dropped by the device
+        config.mRequestedFeatures.multiDrawIndirect = VK_TRUE;
+        config.mRequestedFeatures.drawIndirectFirstInstance = VK_TRUE;
+        config.mRequestDrawIndirectCount = true;
+
+        // per-pass pipeline statistics in the profiler, also around the scene secondaries; dropped where unsupported
+        config.mRequestedFeatures.pipelineStatisticsQuery = VK_TRUE;
+        config.mRequestedFeatures.inheritedQueries = VK_TRUE;
+
+        // bindless materials: one texture array and material table per model
+        config.mRequestDescriptorIndexing = true;
+
+        // frame pacing on one timeline semaphore; falls back to per-frame fences
+        config.mRequestTimelineSemaphore = true;
+
+        // vblank aligned frame pacing and latency measurement; falls back to the clock pacer
+        config.mRequestPresentWait = true;
+
+        // present mode switches from the ui without recreating the swapchain; falls back to a recreate
+        config.mRequestSwapchainMaintenance1 = true;
+
+        // a texture batch uploads behind a handful of barriers with per-barrier stages; falls back to legacy barriers
+        config.mRequestSynchronization2 = true;
+
+        // texture streaming evicts against the driver's budget; falls back to the heap size
+        config.mRequestMemoryBudget = true;
+
+        // camera block pushed with each pass, no camera set to allocate or bind; falls back to a dynamic offset set
+        config.mRequestPushDescriptor = true;
+
+        // cull mode set per draw, one pipeline per material across sidedness; falls back to baked cull modes
+        config.mRequestExtendedDynamicState = true;
+
+        // material permutations fast-linked from cached parts, optimized links swapped in later; falls back to
+        // monolithic pipelines
+        config.mRequestGraphicsPipelineLibrary = true;
+
+        // tooling builds bind scene shaders without pipelines, so rewritten shaders apply at once; falls back to pipelines
+        if constexpr (config::kShaderHotReload)
+        {
+            config.mRequestShaderObject = true;
+        }
+
+        // meshlet rendering through task and mesh shaders; falls back to the vertex pipeline
+        config.mRequestMeshShader = true;
+
+        // textures written from the cpu straight into their images; falls back to staging belt uploads
+        config.mRequestHostImageCopy = true;
+
+        // driver paced frame start (reflex or anti-lag); falls back to present wait or clock pacing
+        config.mRequestLowLatency = true;
+
+        // alt+enter takes the display over on win32 (direct flips, no compositor frame); falls back to borderless
+        config.mRequestFullScreenExclusive = true;
+
+        // coarse shading of low-detail materials and flat screen regions; falls back to full rate everywhere
+        config.mRequestFragmentShadingRate = true;
+
+        // vertex pulling of the gpu-driven path; falls back to vertex bindings
+        config.mRequestBufferDeviceAddress = true;
+
+        // fp16 material terms in the fragment shader; falls back to fp32 shading
+        config.mRequestShaderFloat16 = true;
+
+        // stereo rendering of both eyes in one pass; the scene shaders read gl_ViewIndex, which needs the feature even
+        // with one view, and it is mandatory from vulkan 1.1
+        config.mRequestMultiview = true;
+
+        // bindless cpu draws sharing state submitted as one multi-draw; falls back to a draw per run
+        config.mRequestMultiDraw = true;
+
+        // shadow rays traced against the model's acceleration structures; falls back to shadow maps
+        config.mRequestRayQuery = true;
+    }
+
+    void PBR::onWindowResize(uint32_t width, uint32_t height)
+    {    
+        // record the latest extent only; render() applies it once resize events settle
+        m_pendingWidth    = width;
+        m_pendingHeight   = height;
+        m_isResizePending = true;
+        m_lastResizeTime  = std::chrono::steady_clock::now();
+        requestRedraw();
+
+        // window minimized: stop rendering until a non-zero extent arrives
+        if (width == 0 || height == 0)
+        {
+            m_readyToRender.store(false);
+        }
+    }
+
+    void PBR::applyPendingResize() noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+
+        // wait for the extent to settle, unless the swapchain can no longer be presented
+        const bool isSettled = std::chrono::steady_clock::now() - m_lastResizeTime >= kResizeDebounce;
+        if (!isSettled && !m_isSwapchainOutOfDate)
+        {
+            return;
+        }
+
+        // window minimized or device not available: keep the resize pending
+        auto device = m_device.lock();
+        if (m_pendingWidth == 0 || m_pendingHeight == 0 || !device)
+        {
+            return;
+        }
+
+        m_isResizePending = false;
+        m_isSwapchainOutOfDate = false;
+        m_readyToRender.store(false);
+
+        // fullscreen mode changes arrive as resizes: the swapchain takes the display over while the window is exclusive
+        if (auto platform = m_platform.lock())
+        {
+            const bool isExclusive = platform->getFullscreenMode() == FullscreenMode::kExclusive;
+            m_swapchainPolicy.mFullScreenExclusive = isExclusive;
+            m_swapchainPolicy.mMonitor = isExclusive ? platform->getMonitorHandle() : nullptr;
+            m_swapchain->updatePolicy(m_swapchainPolicy);
+        }
+
+        // recreate swapchain with new dimensions; the old one is handed over through oldSwapchain and retired,
+        // so frames still in flight finish presenting without a device wait
+        if (!m_swapchain->recreate(m_pendingWidth, m_pendingHeight, m_deletionQueue))
+        {
+            return;
+        }
+
+        // update swapchain handle and image count. frames in flight stay as created: their semaphores,
+        // timeline values and command buffers may still be in use
+        m_vkSwapchainKHR      = m_swapchain->get();
+        m_swapchainImageCount = m_swapchain->getImageCount();
+        m_presentWait.onSwapchainRecreated();
+        m_lowLatency.setSwapchain(m_swapchain->isLatencyModeEnabled() ? m_vkSwapchainKHR : VK_NULL_HANDLE);
+
+        // reset per-image ownership for the new swapchain images
+        m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
+        m_imagesInFlightValues.assign(m_swapchainImageCount, 0);
+
+        // a shader reload in flight was built for the old extent: take its shaders, the pipelines are rebuilt below
+        if (m_shaderReload.mIsPending)
+        {
+            finishShaderReload();
+        }
+
+        // retire extent dependent resources (pipelines, render graph); in-flight frames keep using them.
+        // on the timeline they go as soon as the last submission completes, otherwise when its frame slot comes around
+        const bool useTimeline = m_frameTimeline.isValid();
+        const uint64_t lastSubmittedValue = m_frameTimeline.getLastSubmittedValue();
+        auto retire = [this, useTimeline, lastSubmittedValue](auto&& resource)
+        {
+            if (useTimeline) { m_deletionQueue.retire(std::move(resource), lastSubmittedValue); }
+            else             { m_deletionQueue.retire(std::move(resource)); }
+        };
+
+        retire(m_graphicsPipeline);
+        retire(m_indirectPipeline);
+        retire(m_instancedPipeline);
+        retire(m_meshletPipeline);
+        retire(m_permutationPipelines);
+        retire(m_depthPipelines);
+        retire(m_renderGraph);
+        m_permutationLinks.clear();
+
+        // library parts name the retired render passes
+        m_pipelineLibrary.clearPartCache();
+        retire(m_occlusionCulling);
+        retire(m_upscalePass);
+        retire(m_postProcess);
+        retire(m_temporalAA);
+        retire(m_fxaaPass);
+        retire(m_deferredLighting);
+        retire(m_ambientOcclusion);
+        retire(m_shadingRateImage);
+
+        // recreate against the new swapchain (with the requested depth pre-pass, dynamic resolution and shading rates)
+        m_depthPrepassMode = m_requestedDepthPrepassMode;
+        m_isDynamicResolution = m_requestedDynamicResolution;
+        m_isStereo = m_requestedStereo;
+        m_isTileLocalPost = m_requestedTileLocalPost;
+        m_isDeferred = m_requestedDeferred;
+        m_shadingRateMode = m_requestedShadingRateMode;
+        m_isVertexPulling = m_requestedVertexPulling;
+        m_isHalfPrecision = m_requestedHalfPrecision;
+        m_antiAliasingMode = m_requestedAntiAliasingMode;
+        if (!createRenderGraph(*device))  { return; }
+        if (!createGraphicsPipeline(*device)) { return; }
+        updateOverlayTarget();
+
+        // secondaries of frames in flight cannot be reset yet: re-record each once its slot comes around
+        m_isSceneRecordStale.assign(m_maxFramesInFlight, true);
+
+        // update window dimensions 
+        m_windowWidth  = m_pendingWidth;
+        m_windowHeight = m_pendingHeight;
+
+        // resume rendering
+        m_readyToRender.store(true);
+    }
+
+    void PBR::applySwapchainPolicy() noexcept
+    {
+        // present mode switches among compatible modes apply on the next present
+        if (m_swapchain->updatePolicy(m_swapchainPolicy))
+        {
+            return;
+        }
+
+        // otherwise recreate through the deferred resize path (a pending resize picks the policy up as well)
+        if (!m_isResizePending)
+        {
+            onWindowResize(m_windowWidth, m_windowHeight);
+        }
+    }
+
+    void PBR::applyFramesInFlight() noexcept
+    {
+        const uint32_t framesInFlight = glm::clamp(m_requestedFramesInFlight, 1u, m_maxFramesInFlight);
+
+        // slots going idle keep their sync objects; release what was retired on them once their last submission
+        // completes (a one-off wait when the setting changes)
+        for (uint32_t frameIndex = framesInFlight; frameIndex < m_activeFramesInFlight; ++frameIndex)
+        {
+            const bool isComplete = m_frameTimeline.isValid() ? m_frameTimeline.waitForFrame(frameIndex) 
+                                                              : m_frameSyncPrimitives[frameIndex].mInFlightFence.wait();
+            if (isComplete)
+            {
+                m_deletionQueue.beginFrame(frameIndex);
+            }
+        }
+
+        // the frame index wraps into the active range on the next advance
+        VK_LOG_INFO("PBR::applyFramesInFlight : %u -> %u frames in flight", m_activeFramesInFlight, framesInFlight);
+        m_activeFramesInFlight = framesInFlight;
+        m_requestedFramesInFlight = framesInFlight;
+    }
+
+    void PBR::updateShaderReload() noexcept
+    {
+        // frames keep drawing with the running pipelines until every rebuilt one is ready
+        if (m_shaderReload.mIsPending)
+        {
+            for (PipelineHandle handle : m_shaderReload.mPipelines)
+            {
+                if (handle.isValid() && !m_pipelineLibrary.isReady(handle))
+                {
+                    return;
+                }
+            }
+
+            for (PipelineHandle handle : m_shaderReload.mPermutations)
+            {
+                if (!m_pipelineLibrary.isReady(handle))
+                {
+                    return;
+                }
+            }
+
+            finishShaderReload();
+            return;
+        }
+
+        auto device = m_device.lock();
+        if (!device)
+        {
+            return;
+        }
+
+        std::vector<std::string> changedFiles = device->getShaderCache().collectChangedFiles();
+        if (!changedFiles.empty())
+        {
+            beginShaderReload(*device, changedFiles);
+        }
+    }
+
+    void PBR::beginShaderReload(const VulkanDevice& device, const std::vector<std::string>& changedFiles) noexcept
+    {
+        // only shaders in use reload; one that was unavailable at startup stays off, its fallback path is already chosen
+        const SceneShaderSet runningShaders = getSceneShaders();
+        bool isAffected = false;
+        for (size_t i = 0; i < kSceneShaderCount; ++i)
+        {
+            isAffected = isAffected || (runningShaders[i]->isValid() && 
+                         std::find(changedFiles.begin(), changedFiles.end(), kSceneShaderSources[i].mFile) != changedFiles.end());
+        }
+        if (!isAffected)
+        {
+            return;
+        }
+
+        // unchanged shaders come straight from the cache, rewritten ones are read again
+        VulkanShaderCache& shaderCache = device.getShaderCache();
+        SceneShaderSet pendingShaders{};
+        for (size_t i = 0; i < kSceneShaderCount; ++i)
+        {
+            VulkanShader& shader = m_shaderReload.mShaders[i];
+            shader = VulkanShader();
+            if (runningShaders[i]->isValid() && !shader.initialize(shaderCache, kSceneShaderSources[i].mStage, kSceneShaderSources[i].mFile))
+            {
+                VK_LOG_WARN("PBR::beginShaderReload : '%s' failed to load, keeping the running shaders", kSceneShaderSources[i].mFile);
+                return;
+            }
+            pendingShaders[i] = &shader;
+        }
+
+        // descriptor sets stay bound across the swap: the new shaders must declare the same camera and light sets
+        VkDescriptorSetLayout cameraLayout = VK_NULL_HANDLE;
+        VkDescriptorSetLayout lightLayout = VK_NULL_HANDLE;
+        if (!resolveSceneLayouts(device, pendingShaders, cameraLayout, lightLayout) || 
+            cameraLayout != m_cameraDescriptorSetLayout || lightLayout != m_lightDescriptorSetLayout)
+        {
+            VK_LOG_WARN("PBR::beginShaderReload : descriptor set layouts changed, restart to apply the new shaders");
+            return;
+        }
+
+        // rebuild the pipelines that exist from their stored configs
+        std::array<GraphicsPipelineConfig, kScenePipelineCount> configs = m_scenePipelineState.mConfigs;
+        setSceneShaderStages(pendingShaders, configs);
+
+        const std::array<const VulkanPipeline*, kScenePipelineCount> runningPipelines = { &m_graphicsPipeline, &m_indirectPipeline, &m_instancedPipeline, 
+                                                                                           &m_meshletPipeline };
+        for (size_t i = 0; i < kScenePipelineCount; ++i)
+        {
+            m_shaderReload.mPipelines[i] = PipelineHandle{};
+            m_shaderReload.mShaderObjects[i].destroy();
+            if (!runningPipelines[i]->isValid())
+            {
+                continue;
+            }
+
+            // shader objects link in place of a compile, there is nothing to wait for
+            if (!m_isShaderObject)
+            {
+                m_shaderReload.mPipelines[i] = m_pipelineLibrary.compile(configs[i]);
+            }
+            else if (!createScenePipeline(device, pendingShaders, configs[i], i, m_shaderReload.mShaderObjects[i]))
+            {
+                VK_LOG_WARN("PBR::beginShaderReload : shader objects failed to link, keeping the running shaders");
+                m_shaderReload.mShaderObjects = {};
+                return;
+            }
+        }
+        m_shaderReload.mPermutations = m_permutationPipelines.empty() ? std::vector<PipelineHandle>{} : 
+                                       m_pipelineLibrary.compile(getPermutationConfigs(configs, m_shaderReload.mPermutationIndices));
+
+        m_shaderReload.mIsPending = true;
+        VK_LOG_INFO("PBR::beginShaderReload : rebuilding scene pipelines in the background");
+    }
+
+    void PBR::finishShaderReload() noexcept
+    {
+        m_shaderReload.mIsPending = false;
+
+        // all or nothing, so every pipeline runs the same shaders
+        std::array<VulkanPipeline, kScenePipelineCount> pipelines;
+        for (size_t i = 0; i < kScenePipelineCount; ++i)
+        {
+            pipelines[i] = std::move(m_shaderReload.mShaderObjects[i]);
+            if (m_shaderReload.mPipelines[i].isValid() && !m_pipelineLibrary.release(m_shaderReload.mPipelines[i], pipelines[i]))
+            {
+                VK_LOG_WARN("PBR::finishShaderReload : pipeline rebuild failed, keeping the running pipelines");
+                return;
+            }
+        }
+
+        std::vector<VulkanPipeline> permutationPipelines(m_shaderReload.mPermutations.size());
+        for (size_t i = 0; i < m_shaderReload.mPermutations.size(); ++i)
+        {
+            if (!m_pipelineLibrary.release(m_shaderReload.mPermutations[i], permutationPipelines[i]))
+            {
+                VK_LOG_WARN("PBR::finishShaderReload : permutation rebuild failed, keeping the running pipelines");
+                return;
+            }
+        }
+
+        // frames in flight still draw with the old pipelines: retire them like on a resize
+        const bool useTimeline = m_frameTimeline.isValid();
+        const uint64_t lastSubmittedValue = m_frameTimeline.getLastSubmittedValue();
+        auto retire = [this, useTimeline, lastSubmittedValue](auto&& resource)
+        {
+            if (useTimeline) { m_deletionQueue.retire(std::move(resource), lastSubmittedValue); }
+            else             { m_deletionQueue.retire(std::move(resource)); }
+        };
+
+        const std::array<VulkanPipeline*, kScenePipelineCount> runningPipelines = { &m_graphicsPipeline, &m_indirectPipeline, &m_instancedPipeline, 
+                                                                                     &m_meshletPipeline };
+        for (size_t i = 0; i < kScenePipelineCount; ++i)
+        {
+            if (pipelines[i].isValid())
+            {
+                retire(*runningPipelines[i]);
+                *runningPipelines[i] = std::move(pipelines[i]);
+            }
+        }
+
+        if (!m_shaderReload.mPermutations.empty())
+        {
+            retire(m_permutationPipelines);
+            setPermutationPipelines(std::move(permutationPipelines), m_shaderReload.mPermutationIndices, m_shaderReload.mPermutations);
+        }
+
+        // the new shaders become the running ones (pipelines no longer need the old modules), and later rebuilds use them
+        m_vertexShader           = std::move(m_shaderReload.mShaders[kVertexShader]);
+        m_fragmentShader         = std::move(m_shaderReload.mShaders[kFragmentShader]);
+        m_indirectVertexShader   = std::move(m_shaderReload.mShaders[kIndirectVertexShader]);
+        m_objectVertexShader     = std::move(m_shaderReload.mShaders[kObjectVertexShader]);
+        m_bindlessFragmentShader = std::move(m_shaderReload.mShaders[kBindlessFragmentShader]);
+        m_meshletTaskShader      = std::move(m_shaderReload.mShaders[kMeshletTaskShader]);
+        m_meshletMeshShader      = std::move(m_shaderReload.mShaders[kMeshletMeshShader]);
+        m_pulledVertexShader     = std::move(m_shaderReload.mShaders[kPulledVertexShader]);
+        m_halfFragmentShader     = std::move(m_shaderReload.mShaders[kHalfFragmentShader]);
+        m_multiDrawVertexShader  = std::move(m_shaderReload.mShaders[kMultiDrawVertexShader]);
+        m_rayQueryFragmentShader = std::move(m_shaderReload.mShaders[kRayQueryFragmentShader]);
+        m_rayQueryBindlessFragmentShader = std::move(m_shaderReload.mShaders[kRayQueryBindlessFragmentShader]);
+        m_gBufferFragmentShader  = std::move(m_shaderReload.mShaders[kGBufferFragmentShader]);
+        m_gBufferBindlessFragmentShader = std::move(m_shaderReload.mShaders[kGBufferBindlessFragmentShader]);
+        setSceneShaderStages(getSceneShaders(), m_scenePipelineState.mConfigs);
+        m_pipelineLibrary.clearPartCache();
+
+        // secondaries of frames in flight bind the old pipelines: re-record each once its slot comes around
+        m_isSceneRecordStale.assign(m_maxFramesInFlight, true);
+        requestRedraw();
+        VK_LOG_INFO("PBR::finishShaderReload : scene pipelines swapped");
+    }
+
+    bool PBR::createSwapchain() noexcept
+    {
+        // setup swapchain; the scene depth it picks the format of holds reverse-z, which wants floating point
+        m_swapchainPolicy.mDepthPrecision = DepthPrecision::kFloat;
+        m_swapchain->updatePolicy(m_swapchainPolicy);
+        if (!m_swapchain->initialize(m_windowWidth, m_windowHeight))
+        {
+            VK_LOG_ERROR("PBR::createSwapchain : failed to create swapchain fpr presentation.");
+            return false;
+        }
+
+        // retrieve swapchain handle and image count
+        m_vkSwapchainKHR = m_swapchain->get();
+        m_swapchainImageCount = m_swapchain->getImageCount();
+
+        // frames in flight are a budget of their own (config::kFramesInFlight), not derived from the image count: a
+        // driver handing out more images must not deepen the cpu-gpu queue. frames beyond the free images just wait
+        // in acquire, the image in flight fences keep an image from being reused before its last frame completes
+        VK_LOG_INFO("PBR::createSwapchain : swapchain created successfully (%u images, %u of %u frame slots in flight)",
+                    m_swapchainImageCount, m_activeFramesInFlight, m_maxFramesInFlight);
+        return true;
+    }
+
+    bool PBR::createCommandPool(const VulkanDevice& device) noexcept
+    {
+        // setup command pool for graphics queue
+        const auto graphicsFamilyIndex = device.getQueueFamilyIndices().mGraphicsFamily;
+
+        // command pool creation info
+        VkCommandPoolCreateInfo vkCommandPoolCreateInfo{};
+        vkCommandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        vkCommandPoolCreateInfo.pNext = nullptr;
+        vkCommandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        vkCommandPoolCreateInfo.queueFamilyIndex = graphicsFamilyIndex .value();
+
+        // setup command pool
+        if (!m_commandPool.initialize(m_vkDevice, vkCommandPoolCreateInfo))
+        {
+            VK_LOG_ERROR("PBR::createCommandPool : failed to initialize command pool.");
+            return false;
+        }
+
+        // transient per-frame pools for command buffers re-recorded every frame
+        if (!m_frameCommandAllocator.initialize(m_vkDevice, graphicsFamilyIndex.value(), GLTFModel::kMaxFramesInFlight))
+        {
+            VK_LOG_ERROR("PBR::createCommandPool : failed to initialize frame command allocator.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PBR::createCommandPool successful");
+        return true;
+    }
+
+    bool PBR::createStagingBelt(const VulkanDevice& device) noexcept
+    {
+        // persistently mapped staging ring shared by all host-to-device uploads
+        if (!m_stagingBelt.initialize(device))
+        {
+            VK_LOG_ERROR("PBR::createStagingBelt : failed to initialize staging belt.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PBR::createStagingBelt successful");
+        return true;
+    }
+
+    bool PBR::createCommandBuffers() noexcept
+    {
+        // primary command buffers are taken from the frame command allocator when each frame begins
+        m_primaryCommandBuffers.assign(m_maxFramesInFlight, VulkanCommandBuffer{});
+        m_presentCommandBuffers.assign(m_maxFramesInFlight, VulkanCommandBuffer{});
+
+        // allocate secondary command buffers to cache stable draw workloads
+        m_secondaryCommandBuffer = m_commandPool.allocateSecondaries(m_maxFramesInFlight);
+        if (m_secondaryCommandBuffer.empty())
+        {
+            VK_LOG_ERROR("PBR::createCommandBuffers failed to allocate secondary command buffers.");
+            return false;
+        }
+
+        // partition secondaries are allocated once the model's partition count is known
+        m_partitionCommandBuffers.assign(m_maxFramesInFlight, {});
+        m_partitionRecordRevisions.assign(m_maxFramesInFlight, {});
+
+        VK_LOG_DEBUG("PBR::createCommandBuffers successful");
+        return true;
+    }
+
+    bool PBR::createRecordWorkers(const VulkanDevice& device) noexcept
+    {
+        // command pools are externally synchronized, so every worker records from its own pool per frame in flight
+        m_recordWorkerCount = 0;
+        const uint32_t workerCount = std::min(kMaxRecordWorkers, std::thread::hardware_concurrency());
+        if (workerCount < 2)
+        {
+            VK_LOG_INFO("PBR::createRecordWorkers single core, scene draws recorded on the render thread");
+            return true;
+        }
+
+        VkCommandPoolCreateInfo vkCommandPoolCreateInfo{};
+        vkCommandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        vkCommandPoolCreateInfo.pNext = nullptr;
+        vkCommandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        vkCommandPoolCreateInfo.queueFamilyIndex = device.getQueueFamilyIndices().mGraphicsFamily.value();
+
+        // pool and secondary of worker w for frame f at [f * workerCount + w]
+        m_workerCommandPools.resize(GLTFModel::kMaxFramesInFlight * workerCount);
+        m_workerCommandBuffers.clear();
+        m_workerCommandBuffers.reserve(m_workerCommandPools.size());
+        for (auto& commandPool : m_workerCommandPools)
+        {
+            if (!commandPool.initialize(m_vkDevice, vkCommandPoolCreateInfo))
+            {
+                VK_LOG_ERROR("PBR::createRecordWorkers failed to initialize worker command pool.");
+                return false;
+            }
+
+            m_workerCommandBuffers.push_back(commandPool.allocateSecondary());
+            if (!m_workerCommandBuffers.back().isValid())
+            {
+                VK_LOG_ERROR("PBR::createRecordWorkers failed to allocate worker secondary command buffer.");
+                return false;
+            }
+        }
+
+        m_recordThreadPool = std::make_unique<ThreadPool>(workerCount, 0, "record");
+        m_recordWorkerCount = workerCount;
+        VK_LOG_DEBUG("PBR::createRecordWorkers successful (%u workers)", workerCount);
+        return true;
+    }
+
+    bool PBR::createTextureSamplers(const VulkanDevice& device) noexcept
+    {
+        // create predefined samplers
+        if (!m_samplers.initialize(device))
+        {
+            VK_LOG_ERROR("PBR::createTextureSamplers failed to create samplers.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PBR::createTextureSamplers successful");
+        return true;
+    }
+
+    bool PBR::loadAssets(const VulkanDevice& device) noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+
+        // initialize shared resources
+        GLTFModel::initSharedResources(m_vkDevice);
+
+        // not fatal: without the downsampler mip chains are built on the cpu while decoding
+        if (!m_mipGenerator.initialize(device, "pbr/mip_downsample.comp.spv"))
+        {
+            VK_LOG_WARN("PBR::loadAssets failed to initialize mip generator, using cpu mipmaps");
+        }
+
+        // not fatal: models own their buffers without it
+        if (!m_geometryArena.initialize(device, GLTFModel::getVertexStride(GLTFVertexFormat::kPacked), kGeometryArenaVertices, kGeometryArenaIndices))
+        {
+            VK_LOG_WARN("PBR::loadAssets failed to initialize geometry arena, models use their own buffers");
+        }
+
+        // start loading the gltf model; parsing and decoding overlap the rest of initialization (see finishAssets)
+        GLTFLoadConfig loadConfig{};
+        loadConfig.mVertexFormat   = GLTFVertexFormat::kPacked;
+        loadConfig.mOptimizeMeshes = true;
+        loadConfig.mUseBakedCache  = true;
+        loadConfig.mMipGenerator   = &m_mipGenerator;
+        loadConfig.mStreamTextures = true;
+        loadConfig.mSparseTextures = true;
+        loadConfig.mGenerateLods   = true;
+        loadConfig.mBuildMeshlets  = true;
+        loadConfig.mGeometryArena  = m_geometryArena.isValid() ? &m_geometryArena : nullptr;
+        m_gltfModel.loadAsync(device, kModelFile, loadConfig);
+        VK_LOG_DEBUG("PBR::loadAssets successful");
+        return true;
+    }
+
+    bool PBR::finishAssets(const VulkanDevice& device) noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+
+        // culling, skinning, descriptor pools and pipelines are sized from the model, so wait for it here
+        if (!m_gltfModel.finishLoad(device, m_stagingBelt))
+        {
+            VK_LOG_DEBUG("PBR::finishAssets failed to load gltf model");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PBR::finishAssets successful");
+        return true;
+    }
+
+    bool PBR::createUniformBuffers(const VulkanDevice& device) noexcept
     {
         // allocate space for vectors per frame
-        m_cameraUniformBuffers.resize(m_maxFramesInFlight);
-        m_lightUniformBuffers.resize(m_maxFramesInFlight);
         m_cameraUniforms.resize(m_maxFramesInFlight);
+        m_cullingMatrices.resize(m_maxFramesInFlight, glm::mat4(1.0f));
         m_lightUniforms.resize(m_maxFramesInFlight);
+        m_uniformOffsets.assign(m_maxFramesInFlight, { 0, 0 });
+
+        // one persistently mapped arena holds the camera and light blocks of every frame
+        if (!m_uniformArena.initialize(device, { sizeof(ubo::Camera), sizeof(ubo::Light) }, m_maxFramesInFlight))
+        {
+            VK_LOG_ERROR("PBR::createUniformBuffers failed to create the per-frame uniform arena");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PBR::createUniformBuffers successful");
+        return true;
+    }
+
+    bool PBR::createShaderModules(const VulkanDevice& device) noexcept
+    {
+        // modules come from the device cache: identical binaries are shared and unchanged files are not read again
+        VulkanShaderCache& shaderCache = device.getShaderCache();
+        auto loadShader = [&shaderCache](VulkanShader& shader, SceneShaderIndex index)
+        {
+            return shader.initialize(shaderCache, kSceneShaderSources[index].mStage, kSceneShaderSources[index].mFile);
+        };
+
+        // create vertex shader module from SPIR-V
+        if (!loadShader(m_vertexShader, kVertexShader))
+        {
+            VK_LOG_ERROR("PBR::createShaderModules failed for vertex shader");
+            return false;
+        }
+
+        // create fragment shader module from SPIR-V
+        if (!loadShader(m_fragmentShader, kFragmentShader))
+        {
+            VK_LOG_ERROR("PBR::createShaderModules failed for fragment shader");
+            return false;
+        }
+
+        // optional vertex shader for indirect draws (model matrix per draw record)
+        if (!loadShader(m_indirectVertexShader, kIndirectVertexShader))
+        {
+            VK_LOG_WARN("PBR::createShaderModules indirect vertex shader unavailable, gpu culling disabled");
+        }
+
+        // optional vertex shader fetching vertices through the pools' device addresses
+        if (device.isBufferDeviceAddressEnabled() && !loadShader(m_pulledVertexShader, kPulledVertexShader))
+        {
+            VK_LOG_WARN("PBR::createShaderModules pulled vertex shader unavailable, vertex pulling disabled");
+        }
+
+        // optional fp16 build of the fragment shader
+        if (device.isShaderFloat16Enabled() && !loadShader(m_halfFragmentShader, kHalfFragmentShader))
+        {
+            VK_LOG_WARN("PBR::createShaderModules half-precision fragment shader unavailable, shading in fp32");
+        }
+
+        // optional shaders reading object records and materials from the bindless set
+        if (!loadShader(m_objectVertexShader, kObjectVertexShader) || !loadShader(m_bindlessFragmentShader, kBindlessFragmentShader))
+        {
+            VK_LOG_WARN("PBR::createShaderModules bindless shaders unavailable, using per-material descriptor sets");
+        }
+
+        // optional gl_DrawID build of the object vertex shader
+        if (device.isMultiDrawEnabled() && !loadShader(m_multiDrawVertexShader, kMultiDrawVertexShader))
+        {
+            VK_LOG_WARN("PBR::createShaderModules multi-draw vertex shader unavailable, drawing one run per call");
+        }
+
+        // optional ray query builds of both fragment shaders, used together or not at all
+        if (device.isRayQueryEnabled() && 
+            (!loadShader(m_rayQueryFragmentShader, kRayQueryFragmentShader) || !loadShader(m_rayQueryBindlessFragmentShader, kRayQueryBindlessFragmentShader)))
+        {
+            VK_LOG_WARN("PBR::createShaderModules ray query fragment shaders unavailable, shadows from shadow maps");
+            m_rayQueryFragmentShader = VulkanShader();
+            m_rayQueryBindlessFragmentShader = VulkanShader();
+        }
+
+        // optional g-buffer builds of both fragment shaders for deferred shading, used together or not at all
+        if (!loadShader(m_gBufferFragmentShader, kGBufferFragmentShader) || !loadShader(m_gBufferBindlessFragmentShader, kGBufferBindlessFragmentShader))
+        {
+            VK_LOG_WARN("PBR::createShaderModules g-buffer fragment shaders unavailable, forward shading only");
+            m_gBufferFragmentShader = VulkanShader();
+            m_gBufferBindlessFragmentShader = VulkanShader();
+        }
+
+        // optional position-only vertex shader of the depth pre-pass
+        if (!m_depthVertexShader.initialize(shaderCache, VK_SHADER_STAGE_VERTEX_BIT, "pbr/pbr_depth.vert.spv"))
+        {
+            VK_LOG_WARN("PBR::createShaderModules depth vertex shader unavailable, depth pre-pass disabled");
+        }
+
+        // optional meshlet stages; their modules are only valid on devices with VK_EXT_mesh_shader
+        if (device.isMeshShaderEnabled() && (!loadShader(m_meshletTaskShader, kMeshletTaskShader) || !loadShader(m_meshletMeshShader, kMeshletMeshShader)))
+        {
+            m_meshletTaskShader = VulkanShader();
+            m_meshletMeshShader = VulkanShader();
+            VK_LOG_WARN("PBR::createShaderModules meshlet shaders unavailable, mesh shading disabled");
+        }
+
+        // material permutations compile in parallel through the library; debug builds also rebuild the scene
+        // pipelines in the background when a .spv is rewritten
+        m_pipelineLibrary.initialize(device);
+        if constexpr (config::kShaderHotReload)
+        {
+            shaderCache.startWatching();
+        }
+
+        VK_LOG_DEBUG("PBR::createShaderModules successful");
+        return true;
+    }
+
+    bool PBR::createGpuSkinning(const VulkanDevice& device) noexcept
+    {
+        // nothing to skin
+        m_gltfModel.setGpuSkinningEnabled(false);
+        if (!m_gltfModel.hasSkins())
+        {
+            return true;
+        }
+
+        // not fatal: skinned meshes keep drawing in bind pose
+        if (!m_gpuSkinning.initialize(device, "pbr/skinning.comp.spv", GLTFModel::kMaxSkinningFrames))
+        {
+            VK_LOG_WARN("PBR::createGpuSkinning failed to initialize skinning pass, skinned meshes stay in bind pose");
+            return true;
+        }
+
+        // sets cover the model's per-frame buffers, so frames-in-flight changes on resize need no rebinding
+        for (uint32_t i = 0; i < GLTFModel::kMaxSkinningFrames; ++i)
+        {
+            m_gpuSkinning.bindBuffers(i, m_gltfModel.getSkinnedRestBuffer(), m_gltfModel.getSkinVertexBuffer(), 
+                                      m_gltfModel.getJointMatrixBuffer(i), m_gltfModel.getSkinnedVertexBuffer(i), m_gltfModel.getMorphRangeBuffer(),
+                                      m_gltfModel.getMorphDeltaBuffer(), m_gltfModel.getMorphWeightBuffer(i));
+        }
+        m_gltfModel.setGpuSkinningEnabled(true);
+
+        VK_LOG_DEBUG("PBR::createGpuSkinning successful (%u skinned vertices, %u morph targets)", m_gltfModel.getSkinnedVertexCount(), 
+                     m_gltfModel.getMorphTargetCount());
+        return true;
+    }
+
+    bool PBR::createMeshShading(const VulkanDevice& device) noexcept
+    {
+        // skinned pools move every frame and have no meshlets, so models with skins keep the vertex pipeline
+        m_isMeshShading = false;
+        if (!m_meshletTaskShader.isValid() || !m_meshletMeshShader.isValid() || !m_gltfModel.hasMeshlets() || m_gltfModel.hasSkins())
+        {
+            VK_LOG_INFO("PBR::createMeshShading mesh shading not available, using the vertex pipeline");
+            return true;
+        }
+
+        // not fatal: keep rendering through the vertex pipeline
+        if (!GLTFModel::initMeshletResources(device))
+        {
+            VK_LOG_WARN("PBR::createMeshShading failed to initialize meshlet resources, using the vertex pipeline");
+            return true;
+        }
+
+        m_isMeshShading = true;
+        VK_LOG_DEBUG("PBR::createMeshShading successful (%u meshlets)", m_gltfModel.getMeshletCount());
+        return true;
+    }
+
+    bool PBR::createGpuCulling(const VulkanDevice& device) noexcept
+    {
+        // draw records are selected through firstInstance
+        m_isGpuDriven = false;
+        if (m_isMeshShading)
+        {
+            VK_LOG_INFO("PBR::createGpuCulling meshlets are culled by the task shader, gpu-driven path not used");
+            return true;
+        }
+
+        // draw records hold load-time transforms, so animated models stay on the cpu path
+        if (!m_indirectVertexShader.isValid() || !device.getEnabledFeatures().drawIndirectFirstInstance || 
+            m_gltfModel.getDrawCount() == 0 || m_gltfModel.hasAnimations())
+        {
+            VK_LOG_INFO("PBR::createGpuCulling gpu-driven path not available, using cpu-recorded draws");
+            return true;
+        }
+
+        // not fatal: keep rendering through the cpu path
+        if (!m_gpuCulling.initialize(device, "pbr/frustum_cull.comp.spv"))
+        {
+            VK_LOG_WARN("PBR::createGpuCulling failed to initialize culling pass, using cpu-recorded draws");
+            return true;
+        }
+
+        m_gpuCulling.bindBuffers(m_gltfModel.getDrawDataBuffer(), m_gltfModel.getIndirectBuffer(), m_gltfModel.getDrawCountBuffer());
+        m_useDrawIndirectCount = device.isDrawIndirectCountEnabled();
+        m_isGpuDriven = true;
+
+        VK_LOG_DEBUG("PBR::createGpuCulling successful (%u draws, draw count: %s)", m_gltfModel.getDrawCount(), m_useDrawIndirectCount ? "gpu" : "fixed");
+        return true;
+    }
+
+    bool PBR::createOcclusionCulling(const VulkanDevice& device, VkFormat depthFormat) noexcept
+    {
+        // the previous instance, if any, was retired with its render graph
+        m_occlusionCulling.reset();
+        if (!m_isGpuDriven)
+        {
+            return false;
+        }
+
+        // the pyramid is of one view: stereo keeps the frustum pass
+        if (m_isStereo)
+        {
+            VK_LOG_INFO("PBR::createOcclusionCulling stereo rendering, using frustum culling only");
+            return false;
+        }
+
+        // the pyramid is built from the scene depth, so it has to be sampleable
+        if (!device.isFormatSupported(depthFormat, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        {
+            VK_LOG_INFO("PBR::createOcclusionCulling depth format %s cannot be sampled, using frustum culling only", string_VkFormat(depthFormat));
+            return false;
+        }
+
+        OcclusionCullingShaders shaders{};
+        shaders.mCullFile              = "pbr/occlusion_cull.comp.spv";
+        shaders.mReduceFile            = "pbr/hiz_reduce.comp.spv";
+        shaders.mReduceMultisampleFile = "pbr/hiz_reduce_ms.comp.spv";
+
+        // not fatal: keep the frustum culling pass
+        auto occlusionCulling = std::make_unique<OcclusionCulling>();
+        if (!occlusionCulling->initialize(device, shaders, m_sampleCount, m_gltfModel.getDrawCount()))
+        {
+            VK_LOG_WARN("PBR::createOcclusionCulling failed to initialize occlusion culling, using frustum culling only");
+            return false;
+        }
+
+        occlusionCulling->setReverseDepth(true);
+        occlusionCulling->bindBuffers(m_gltfModel.getDrawDataBuffer(), m_gltfModel.getIndirectBuffer(), m_gltfModel.getDrawCountBuffer());
+        m_occlusionCulling = std::move(occlusionCulling);
+        VK_LOG_DEBUG("PBR::createOcclusionCulling successful");
+        return true;
+    }
+
+    bool PBR::createBindlessMaterials(const VulkanDevice& device) noexcept
+    {
+        // not fatal: materials keep their own descriptor sets
+        m_isBindless = false;
+        if (m_isMeshShading || !m_objectVertexShader.isValid() || !m_bindlessFragmentShader.isValid() || !device.isDescriptorIndexingEnabled() || !GLTFModel::initBindlessResources(device))
+        {
+            VK_LOG_INFO("PBR::createBindlessMaterials bindless materials not available, using per-material descriptor sets");
+            return true;
+        }
+
+        m_isBindless = true;
+        VK_LOG_DEBUG("PBR::createBindlessMaterials successful");
+        return true;
+    }
+
+    bool PBR::createLightClusters(const VulkanDevice& device) noexcept
+    {
+        // not fatal without the compute pass: fragments shade every light
+        if (!m_lightClusters.initialize(device, m_stagingBelt, "pbr/light_cluster.comp.spv", m_maxFramesInFlight))
+        {
+            if (!m_lightClusters.hasBuffers())
+            {
+                VK_LOG_ERROR("PBR::createLightClusters failed to create light buffers");
+                return false;
+            }
+            VK_LOG_WARN("PBR::createLightClusters failed to initialize cluster pass, shading every light");
+            return true;
+        }
+
+        VK_LOG_DEBUG("PBR::createLightClusters successful");
+        return true;
+    }
+
+    bool PBR::createEnvironmentLighting(const VulkanDevice& device) noexcept
+    {
+        // an equirectangular hdr next to the textures, or the procedural sky; baked once, then loaded from the cache
+        const std::filesystem::path environmentFile = config::kTextureDir / "environment.hdr";
+        const bool hasEnvironmentFile = AssetPack::exists(environmentFile);
+
+        // not fatal without the bake: ambient stays flat
+        if (!m_environmentLighting.initialize(device, m_stagingBelt, m_samplers, hasEnvironmentFile ? environmentFile : std::filesystem::path{}, 
+                                              config::kCacheDir / "environment.kibl"))
+        {
+            if (!m_environmentLighting.hasImages())
+            {
+                VK_LOG_ERROR("PBR::createEnvironmentLighting failed to create environment maps");
+                return false;
+            }
+            VK_LOG_WARN("PBR::createEnvironmentLighting failed to bake environment maps, using flat ambient");
+            return true;
+        }
+
+        VK_LOG_DEBUG("PBR::createEnvironmentLighting successful");
+        return true;
+    }
+
+    bool PBR::createShadowMaps(const VulkanDevice& device) noexcept
+    {
+        // casters are drawn from the model's position stream, so this waits for the loaded vertex format
+        if (!m_shadowMaps.initialize(device, "pbr/pbr_shadow.vert.spv", m_gltfModel.getVertexFormat(), m_maxFramesInFlight))
+        {
+            if (!m_shadowMaps.hasImages())
+            {
+                VK_LOG_ERROR("PBR::createShadowMaps failed to create shadow maps");
+                return false;
+            }
+            VK_LOG_WARN("PBR::createShadowMaps failed to create caster pipelines, lights stay unshadowed");
+            return true;
+        }
+
+        VK_LOG_DEBUG("PBR::createShadowMaps successful");
+        return true;
+    }
+
+    bool PBR::createRayTracedShadows(const VulkanDevice& device) noexcept
+    {
+        // not fatal: without the structures the shaders are dropped, so the light layout keeps the shadow maps only
+        m_isRayTracedShadows = m_rayQueryFragmentShader.isValid() && 
+                               m_rayTracedShadows.initialize(device, m_stagingBelt, m_gltfModel, m_maxFramesInFlight);
+        if (!m_isRayTracedShadows)
+        {
+            m_rayQueryFragmentShader = VulkanShader();
+            m_rayQueryBindlessFragmentShader = VulkanShader();
+            return true;
+        }
+
+        VK_LOG_DEBUG("PBR::createRayTracedShadows successful");
+        return true;
+    }
+
+    bool PBR::createDescriptorSetLayouts(const VulkanDevice& device) noexcept
+    {
+        // camera and light layouts reflected from the shaders, shared through the device layout cache; the single
+        // camera block is pushed with each pass where push descriptors are available
+        m_isCameraPushed = device.isPushDescriptorEnabled();
+        if (!resolveSceneLayouts(device, getSceneShaders(), m_cameraDescriptorSetLayout, m_lightDescriptorSetLayout))
+        {
+            VK_LOG_ERROR("PBR::createDescriptorSetLayouts failed");
+            return false;
+        }
+
+        VK_LOG_DEBUG("PBR::createDescriptorSetLayouts successful");
+        return true;
+    }
+
+    bool PBR::resolveSceneLayouts(const VulkanDevice& device, const SceneShaderSet& shaders, VkDescriptorSetLayout& cameraLayout, 
+                                  VkDescriptorSetLayout& lightLayout) const noexcept
+    {
+        // sets 0 and 2 are shared by every pipeline variant, so merge all of their shaders into one layout.
+        // set 1 differs between the per-material and the bindless path and stays owned by GLTFModel
+        ReflectedPipelineLayout reflectedLayout;
+        for (const VulkanShader* shader : shaders)
+        {
+            if (shader->isValid())
+            {
+                reflectedLayout.add(shader->getReflection());
+            }
+        }
+
+        // set: 0, binding: 0 and set: 2, binding: 0 are sub-allocated from the uniform arena with dynamic offsets;
+        // a pushed camera block carries its offset in the write instead (push layouts take no dynamic types)
+        const VkDescriptorType cameraType = m_isCameraPushed ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        reflectedLayout.setBindingType(0, 0, cameraType);
+        reflectedLayout.setBindingType(2, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+
+        // set: 0, binding: 0, type: dynamic or pushed uniform buffer (camera block of the frame)
+        std::vector<VkDescriptorSetLayoutBinding> cameraBindings;
+        if (!reflectedLayout.getSetBindings(0, cameraBindings) || cameraBindings.size() != 1 || cameraBindings[0].descriptorType != cameraType)
+        {
+            VK_LOG_ERROR("PBR::resolveSceneLayouts failed: shaders do not declare the expected camera set");
+            return false;
+        }
+
+        // set: 2, binding: 0, type: dynamic uniform buffer (light grid), binding: 1-2, type: storage buffer (lights, clusters),
+        // binding: 3-7, type: combined image sampler (irradiance, prefiltered environment, brdf lut, cascade and cube shadow maps),
+        // binding: 8, type: acceleration structure (shadow rays, with the ray query shaders only)
+        std::vector<VkDescriptorSetLayoutBinding> lightBindings;
+        if (!reflectedLayout.getSetBindings(2, lightBindings) || lightBindings.size() < 8 || lightBindings.size() > 9)
+        {
+            VK_LOG_ERROR("PBR::resolveSceneLayouts failed: shaders do not declare the expected light set");
+            return false;
+        }
+        for (uint32_t i = 0; i < static_cast<uint32_t>(lightBindings.size()); ++i)
+        {
+            VkDescriptorType expectedType = (i == 0) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : 
+                                            (i < 3 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : 
+                                            (i < 8 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR));
+            if (lightBindings[i].binding != i || lightBindings[i].descriptorType != expectedType)
+            {
+                VK_LOG_ERROR("PBR::resolveSceneLayouts failed: light set binding %u does not match the shaders", i);
+                return false;
+            }
+        }
+
+        // the blocks must be the ones ubo::Camera and ubo::Light fill: a binary built against an older block would read its
+        // counts out of whatever the current layout put there
+        const uint32_t cameraBlockSize = reflectedLayout.getBlockSize(0, 0);
+        const uint32_t lightBlockSize = reflectedLayout.getBlockSize(2, 0);
+        if (cameraBlockSize != sizeof(ubo::Camera) || lightBlockSize != sizeof(ubo::Light))
+        {
+            VK_LOG_ERROR("PBR::resolveSceneLayouts failed: camera and light blocks of the shaders (%u, %u bytes) do not match ubo::Camera and ubo::Light (%zu, %zu bytes)",
+                         cameraBlockSize, lightBlockSize, sizeof(ubo::Camera), sizeof(ubo::Light));
+            return false;
+        }
+
+        // the deferred lighting pass reads both sets from its compute stage
+        for (VkDescriptorSetLayoutBinding& binding : cameraBindings) { binding.stageFlags |= VK_SHADER_STAGE_COMPUTE_BIT; }
+        for (VkDescriptorSetLayoutBinding& binding : lightBindings)  { binding.stageFlags |= VK_SHADER_STAGE_COMPUTE_BIT; }
+
+        // identical sets resolve to the same layout across pipelines
+        VulkanDescriptorSetLayoutCache& layoutCache = device.getDescriptorSetLayoutCache();
+        cameraLayout = layoutCache.getOrCreate(cameraBindings, m_isCameraPushed ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0);
+        if (cameraLayout == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("PBR::resolveSceneLayouts failed to create descriptor set layout for camera");
+            return false;
+        }
+
+        lightLayout = layoutCache.getOrCreate(lightBindings);
+        if (lightLayout == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("PBR::resolveSceneLayouts failed to create descriptor set layout for light");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool PBR::createDescriptorPool() noexcept
+    {
+        // requirements for camera descriptor sets (none when the camera block is pushed)
+        DescriptorRequirements cameraRequirements{};
+        cameraRequirements.mMaxSets = m_isCameraPushed ? 0 : 1;
+        cameraRequirements.mDynamicUniformCount = m_isCameraPushed ? 0 : 1;
+
+        // requirements for light descriptor sets
+        DescriptorRequirements lightRequirements{};
+        lightRequirements.mMaxSets = m_maxFramesInFlight;
+        lightRequirements.mDynamicUniformCount = m_maxFramesInFlight;
+        lightRequirements.mStorageBufferCount = 2 * m_maxFramesInFlight;
+        lightRequirements.mSamplerCount = 5 * m_maxFramesInFlight;
+        lightRequirements.mAccelerationStructureCount = m_isRayTracedShadows ? m_maxFramesInFlight : 0;
+
+        // add requirements
+        m_descriptorAllocator.addRequirements(cameraRequirements);
+        m_descriptorAllocator.addRequirements(lightRequirements);
+        m_descriptorAllocator.addRequirements(m_isBindless ? m_gltfModel.getBindlessDescriptorRequirements() : m_gltfModel.getDescriptorRequirements());
+        if (m_isMeshShading)
+        {
+            m_descriptorAllocator.addRequirements(m_gltfModel.getMeshletDescriptorRequirements());
+        }
+
+        // create the scene allocator, its first pool sized to the requirements; later sets chain new pools
+        if (!m_descriptorAllocator.initialize(m_vkDevice))
+        {
+            VK_LOG_ERROR("PBR::createDescriptorPool failed");
+            return false;
+        }
+
+        // transient allocators create their pools on first use and keep them across resets
+        for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
+        {
+            if (!m_frameDescriptorAllocators[i].initialize(m_vkDevice))
+            {
+                VK_LOG_ERROR("PBR::createDescriptorPool failed to create frame descriptor allocator %u", i);
+                return false;
+            }
+        }
+
+        VK_LOG_DEBUG("PBR::createDescriptorPool successful");
+        return true;
+    }
+
+    bool PBR::createDescriptorSets() noexcept
+    {
+        // allocate the camera descriptor set, shared by every frame; a pushed camera block needs none
+        if (!m_isCameraPushed)
+        {
+            if (!m_descriptorAllocator.allocate(m_cameraDescriptorSetLayout, m_cameraDescriptorSet))
+            {
+                VK_LOG_ERROR("PBR::createDescriptorSets failed to allocate camera descriptor set");
+                return false;
+            }
+
+            // set: 0, binding: 0 (camera block, placed by the dynamic offset)
+            VkDescriptorBufferInfo cameraBufferInfo{};
+            cameraBufferInfo.buffer   = m_uniformArena.getBuffer();
+            cameraBufferInfo.offset   = 0;
+            cameraBufferInfo.range    = sizeof(ubo::Camera);
+
+            VkWriteDescriptorSet cameraWrite{};
+            cameraWrite.sType                  = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            cameraWrite.pNext                  = nullptr;
+            cameraWrite.dstSet                 = m_cameraDescriptorSet;
+            cameraWrite.dstBinding             = 0;
+            cameraWrite.dstArrayElement        = 0;
+            cameraWrite.descriptorCount        = 1;
+            cameraWrite.descriptorType         = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            cameraWrite.pImageInfo             = nullptr;
+            cameraWrite.pBufferInfo            = &cameraBufferInfo;
+            cameraWrite.pTexelBufferView       = nullptr;
+            vkUpdateDescriptorSets(m_vkDevice, 1, &cameraWrite, 0, nullptr);
+        }
+
+        // create identical light descriptor set layouts for each frame
+        std::vector<VkDescriptorSetLayout> layouts(m_maxFramesInFlight, m_lightDescriptorSetLayout);
+
+        // allocate descriptor sets for light
+        m_lightDescriptorSets.resize(m_maxFramesInFlight);
+        if (!m_descriptorAllocator.allocate(layouts.data(), m_maxFramesInFlight, m_lightDescriptorSets.data()))
+        {
+            VK_LOG_ERROR("PBR::createDescriptorSets failed to allocate light descriptor sets");
+            return false;
+        }
+
+        // one template for every light set: each binding reads its member of LightSetDescriptors
+        std::vector<VkDescriptorUpdateTemplateEntry> lightEntries =
+        {
+            { 0, 0, 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,  offsetof(LightSetDescriptors, mLight),       sizeof(VkDescriptorBufferInfo) },
+            { 1, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,          offsetof(LightSetDescriptors, mStorage),     sizeof(VkDescriptorBufferInfo) },
+            { 2, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,          offsetof(LightSetDescriptors, mStorage) + sizeof(VkDescriptorBufferInfo), 
+                                                                   sizeof(VkDescriptorBufferInfo) },
+            { 3, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,  offsetof(LightSetDescriptors, mEnvironment), sizeof(VkDescriptorImageInfo) },
+            { 4, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,  offsetof(LightSetDescriptors, mEnvironment) + sizeof(VkDescriptorImageInfo), 
+                                                                   sizeof(VkDescriptorImageInfo) },
+            { 5, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,  offsetof(LightSetDescriptors, mEnvironment) + 2 * sizeof(VkDescriptorImageInfo), 
+                                                                   sizeof(VkDescriptorImageInfo) },
+            { 6, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,  offsetof(LightSetDescriptors, mShadows),     sizeof(VkDescriptorImageInfo) },
+            { 7, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,  offsetof(LightSetDescriptors, mShadows) + sizeof(VkDescriptorImageInfo), 
+                                                                   sizeof(VkDescriptorImageInfo) }
+        };
+        if (m_isRayTracedShadows)
+        {
+            lightEntries.push_back({ 8, 0, 1, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, offsetof(LightSetDescriptors, mShadowScene), 
+                                     sizeof(VkAccelerationStructureKHR) });
+        }
+
+        if (!m_lightUpdateTemplate.initialize(m_vkDevice, m_lightDescriptorSetLayout, lightEntries))
+        {
+            VK_LOG_ERROR("PBR::createDescriptorSets failed to create light update template");
+            return false;
+        }
+
+        // for each frame, bind its light and cluster buffers, the environment maps and the shadow maps
+        const VkSampler environmentSampler = m_samplers.get(VulkanSamplers::Type::LinearClamp);
+        for (uint32_t i = 0; i < m_maxFramesInFlight; i++)
+        {
+            LightSetDescriptors descriptors{};
+            descriptors.mLight          = { m_uniformArena.getBuffer(), 0, sizeof(ubo::Light) };
+            descriptors.mStorage[0]     = { m_lightClusters.getLightBuffer(i),   0, VK_WHOLE_SIZE };
+            descriptors.mStorage[1]     = { m_lightClusters.getClusterBuffer(i), 0, VK_WHOLE_SIZE };
+            descriptors.mEnvironment[0] = { environmentSampler, m_environmentLighting.getIrradianceView(),  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+            descriptors.mEnvironment[1] = { environmentSampler, m_environmentLighting.getPrefilteredView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+            descriptors.mEnvironment[2] = { environmentSampler, m_environmentLighting.getBrdfLutView(),     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+            descriptors.mShadows[0]     = { m_shadowMaps.getSampler(), m_shadowMaps.getCascadeView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+            descriptors.mShadows[1]     = { m_shadowMaps.getSampler(), m_shadowMaps.getCubeView(),    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+            descriptors.mShadowScene    = m_isRayTracedShadows ? m_rayTracedShadows.getTopLevel(i) : VK_NULL_HANDLE;
+            m_lightUpdateTemplate.update(m_lightDescriptorSets[i], &descriptors);
+        }
+
+        // allocate and update descriptor sets for model: one bindless set, or one set per material
+        if (m_isBindless)
+        {
+            if (!m_gltfModel.allocateBindlessDescriptorSet(m_descriptorAllocator))
+            {
+                VK_LOG_ERROR("PBR::createDescriptorSets failed to allocate bindless material set");
+                return false;
+            }
+            m_gltfModel.updateBindlessDescriptorSet(m_samplers);
+            m_gltfModel.setBindlessEnabled(true);
+        }
+        else
+        {
+            if (!m_gltfModel.allocateDescriptorSets(m_descriptorAllocator))
+            {
+                VK_LOG_ERROR("PBR::createDescriptorSets failed to allocate material sets");
+                return false;
+            }
+            m_gltfModel.updateDescriptorSets(m_samplers);
+        }
+
+        // meshlets and the vertex pool for the task and mesh stages (set: 3)
+        if (m_isMeshShading && !m_gltfModel.allocateMeshletDescriptorSet(m_descriptorAllocator))
+        {
+            VK_LOG_ERROR("PBR::createDescriptorSets failed to allocate meshlet set");
+            return false;
+        }
+        
+        VK_LOG_DEBUG("PBR::createDescriptorSets successful");
+        return true;
+    }
+
+    bool PBR::createGpuProfiler(const VulkanDevice& device) noexcept
+    {
+        // not fatal: the frame simply records without timestamps
+        if (!m_gpuProfiler.initialize(device, m_maxFramesInFlight))
+        {
+            VK_LOG_INFO("PBR::createGpuProfiler gpu timestamps not available, profiling disabled");
+        }
+
+        // the culling counters read back every batch count of both occlusion phases; not fatal either
+        const VkDeviceSize countBytes = 2 * static_cast<VkDeviceSize>(m_gltfModel.getDrawBatchCount()) * sizeof(uint32_t);
+        if (countBytes > 0 && !m_statsReadback.initialize(device, countBytes, m_maxFramesInFlight))
+        {
+            VK_LOG_INFO("PBR::createGpuProfiler culling readback not available, culling counters disabled");
+        }
+
+        VK_LOG_DEBUG("PBR::createGpuProfiler successful");
+        return true;
+    }
+
+    bool PBR::createRenderGraph(const VulkanDevice& device) noexcept
+    {
+        // the graph is rebuilt, not patched: a resize retires the previous one
+        m_renderGraph = std::make_unique<RenderGraph>();
+        if (m_gpuProfiler.isValid())
+        {
+            m_renderGraph->setProfiler(&m_gpuProfiler);
+        }
+
+        // stereo: the scene passes render both eyes through a view mask; meshlet pipelines draw one view, and only the post
+        // process mirrors an eye. the history of temporal aa and the adaptive rate image are per view, so both fall back
+        // to their single-view neighbours
+        if (!device.isMultiviewEnabled() || m_isMeshShading || !m_isPostProcessAvailable)
+        {
+            m_isStereo = false;
+        }
+        if (m_isStereo && m_antiAliasingMode == AntiAliasingMode::kTemporal)
+        {
+            m_antiAliasingMode = AntiAliasingMode::kMsaa;
+        }
+        const uint32_t sceneLayers = m_isStereo ? ubo::kMaxViews : 1;
+        const uint32_t sceneViewMask = m_isStereo ? kStereoViewMask : 0;
+
+        // deferred shading lights one surface per pixel of one view; forward+ shades whatever it cannot run
+        if (m_isStereo || !m_gBufferFragmentShader.isValid())
+        {
+            m_isDeferred = false;
+        }
+        if (m_isDeferred && !createDeferredLighting(device))
+        {
+            m_isDeferred = false;
+        }
+
+        // not fatal: the lighting pass keeps the material occlusion only
+        if (m_isDeferred)
+        {
+            createAmbientOcclusion(device);
+        }
+
+        // msaa renders into transient hdr targets resolved into the scene color; otherwise straight into the scene color.
+        // temporal aa, fxaa and deferred shading render single-sampled: no multisampled attachments and no resolve. fxaa
+        // filters the tonemapped display color, so it needs the post process
+        if ((m_antiAliasingMode == AntiAliasingMode::kTemporal && !createTemporalAA(device)) ||
+            (m_antiAliasingMode == AntiAliasingMode::kFxaa && (!m_isPostProcessAvailable || !createFxaaPass(device))))
+        {
+            m_antiAliasingMode = AntiAliasingMode::kMsaa;
+        }
+        m_sampleCount = (m_antiAliasingMode != AntiAliasingMode::kMsaa || m_isDeferred) ? VK_SAMPLE_COUNT_1_BIT 
+                        : MsaaTarget::selectSampleCount(device.getPhysicalDeviceProperties(), m_requestedSampleCount);
+        const bool msaaEnabled = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
+
+        // the tile-local tonemap sees one resolved pixel of one view at the native extent, lit in the scene subpass
+        if (m_antiAliasingMode != AntiAliasingMode::kMsaa || m_isDynamicResolution || m_isStereo || m_isDeferred || 
+            !m_isPostProcessAvailable || !device.getEnabledFeatures().fragmentStoresAndAtomics)
+        {
+            m_isTileLocalPost = false;
+        }
+        m_tileToneMapPass = kInvalidRenderGraphHandle;
+
+        // the overlay draws inside the upscale pass (or the tile-local tonemap), so the swapchain leaves the graph ready for presentation
+        RenderGraphImageDesc swapchainDesc{};
+        swapchainDesc.mFormat = m_swapchain->getColorFormat();
+        const RenderGraphHandle swapchainImage = m_renderGraph->importImage("swapchain", swapchainDesc, m_swapchain->getColorImages(), 
+                                                                           m_swapchain->getColorImageViews(), VK_IMAGE_LAYOUT_UNDEFINED, 
+                                                                           m_swapchain->getPresentLayout());
+
+        // transient depth: never stored (so it can stay in tile memory) unless occlusion culling samples it
+        const VkFormat depthFormat = m_swapchain->getDepthFormat();
+        RenderGraphImageDesc depthDesc{};
+        depthDesc.mFormat  = depthFormat;
+        depthDesc.mSamples = m_sampleCount;
+        depthDesc.mAspect  = VK_IMAGE_ASPECT_DEPTH_BIT;
+        depthDesc.mLayers  = sceneLayers;
+        if (depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT || depthFormat == VK_FORMAT_D24_UNORM_S8_UINT || depthFormat == VK_FORMAT_D16_UNORM_S8_UINT)
+        {
+            depthDesc.mAspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+        const RenderGraphHandle depthImage = m_renderGraph->createImage("scene depth", depthDesc);
+
+        // variable rate shading: modes the device cannot run fall back to the next one it can. the rate image is derived
+        // from the display color the post process writes
+        if (!device.isFragmentShadingRateEnabled())
+        {
+            m_shadingRateMode = ShadingRateMode::kOff;
+        }
+        else if (m_shadingRateMode == ShadingRateMode::kAdaptive && (!device.isShadingRateAttachmentEnabled() || m_isStereo || m_isTileLocalPost))
+        {
+            m_shadingRateMode = ShadingRateMode::kMaterials;
+        }
+
+        const bool isShadingRateImage = m_shadingRateMode == ShadingRateMode::kAdaptive && createShadingRateImage(device);
+        RenderGraphHandle shadingRateImage = kInvalidRenderGraphHandle;
+        if (isShadingRateImage)
+        {
+            RenderGraphImageDesc shadingRateDesc{};
+            shadingRateDesc.mFormat = ShadingRateImage::kFormat;
+            shadingRateImage = m_renderGraph->importImage("shading rate", shadingRateDesc, { m_shadingRateImage->getImage() }, 
+                                                          { m_shadingRateImage->getImageView() }, 
+                                                          VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR,
+                                                          VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR);
+        }
+
+        // the scene renders (or resolves) linear radiance into a float target of the swapchain extent, which the post
+        // process turns into the display color the upscale pass fills the swapchain from
+        RenderGraphImageDesc sceneDesc{};
+        sceneDesc.mFormat = PostProcess::kSourceFormat;
+        sceneDesc.mLayers = sceneLayers;
+        const RenderGraphHandle sceneOutput = m_renderGraph->createImage("scene hdr", sceneDesc);
+
+        RenderGraphImageDesc displayDesc{};
+        displayDesc.mFormat = PostProcess::kDestinationFormat;
+        const RenderGraphHandle displayImage = m_isPostProcessAvailable ? m_renderGraph->createImage("scene display", displayDesc) 
+                                                                        : kInvalidRenderGraphHandle;
+
+        // depth pre-pass: clears depth and lays down the opaque draws, merged with the scene pass into one render pass
+        m_depthPrepass = kInvalidRenderGraphHandle;
+        if (isDepthPrepassAvailable())
+        {
+            RenderGraphPassDesc depthPass{};
+            depthPass.mName     = "depth prepass";
+            depthPass.mViewMask = sceneViewMask;
+
+            RenderGraphAttachment depthAttachment{};
+            depthAttachment.mImage                   = depthImage;
+            depthAttachment.mLoadOp                  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            depthAttachment.mClearValue.depthStencil = { kClearDepth, 0 };
+            depthPass.mDepthStencilAttachment = depthAttachment;
+
+            depthPass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+            {
+                if (isDepthPrepassActive())
+                {
+                    recordDepthPrepass(commandBuffer, context.mFrameIndex);
+                }
+            };
+            m_depthPrepass = m_renderGraph->addPass(std::move(depthPass));
+        }
+
+        // scene pass: clear color and depth, execute the frame's scene secondaries
+        RenderGraphPassDesc scenePass{};
+        scenePass.mName     = "scene";
+        scenePass.mContents = VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+        scenePass.mViewMask = sceneViewMask;
+
+        RenderGraphAttachment colorAttachment{};
+        colorAttachment.mImage            = sceneOutput;
+        colorAttachment.mLoadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.mClearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+        if (msaaEnabled)
+        {
+            RenderGraphImageDesc colorDesc = sceneDesc;
+            colorDesc.mSamples = m_sampleCount;
+            colorAttachment.mImage = m_renderGraph->createImage("scene color", colorDesc);
+            scenePass.mResolveAttachments.push_back(sceneOutput);
+        }
+        scenePass.mColorAttachments.push_back(colorAttachment);
+
+        // deferred shading: the scene target takes emissive and occlusion, base color and normal go to the g-buffer targets
+        std::array<RenderGraphAttachment, kMaxSceneColorAttachments - 1> gBufferAttachments{};
+        if (m_isDeferred)
+        {
+            RenderGraphImageDesc albedoDesc{};
+            albedoDesc.mFormat = DeferredLighting::kAlbedoFormat;
+            RenderGraphImageDesc normalDesc{};
+            normalDesc.mFormat = DeferredLighting::kNormalFormat;
+            gBufferAttachments[0].mImage = m_renderGraph->createImage("gbuffer albedo", albedoDesc);
+            gBufferAttachments[1].mImage = m_renderGraph->createImage("gbuffer normal", normalDesc);
+            for (RenderGraphAttachment& attachment : gBufferAttachments)
+            {
+                attachment.mLoadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
+                attachment.mClearValue.color = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+                scenePass.mColorAttachments.push_back(attachment);
+            }
+        }
+
+        RenderGraphAttachment depthAttachment{};
+        depthAttachment.mImage                   = depthImage;
+        depthAttachment.mLoadOp                  = m_depthPrepass != kInvalidRenderGraphHandle ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.mClearValue.depthStencil = { kClearDepth, 0 };
+        scenePass.mDepthStencilAttachment = depthAttachment;
+        if (isShadingRateImage)
+        {
+            scenePass.mShadingRateAttachment = shadingRateImage;
+            scenePass.mShadingRateTexelSize  = m_shadingRateImage->getTexelSize();
+        }
+
+        // the cached secondary, or this frame's worker recordings in draw order
+        scenePass.mRecord = [this](VkCommandBuffer, const RenderGraphPassContext& context)
+        {
+            const uint32_t frameIndex = context.mFrameIndex;
+            auto& commandBuffer = m_primaryCommandBuffers[frameIndex];
+            if (m_isGpuDriven)
+            {
+                const std::vector<VulkanCommandBuffer>& partitionCommandBuffers = m_partitionCommandBuffers[frameIndex];
+                if (!partitionCommandBuffers.empty())
+                {
+                    commandBuffer.executeCommands(partitionCommandBuffers.data(), static_cast<uint32_t>(partitionCommandBuffers.size()));
+                }
+            }
+            else if (m_workerCommandCounts[frameIndex] > 0)
+            {
+                commandBuffer.executeCommands(&m_workerCommandBuffers[frameIndex * m_recordWorkerCount], m_workerCommandCounts[frameIndex]);
+            }
+            else
+            {
+                commandBuffer.executeCommands(m_secondaryCommandBuffer[frameIndex]);
+            }
+        };
+
+        m_scenePass = m_renderGraph->addPass(std::move(scenePass));
+
+        // gpu-driven occlusion culling: the scene pass draws last frame's visible set, its depth is reduced into a
+        // pyramid that culls the remaining draws, and a second pass draws the ones that turned visible
+        if (createOcclusionCulling(device, depthFormat))
+        {
+            RenderGraphPassDesc occlusionPass{};
+            occlusionPass.mName      = "occlusion";
+            occlusionPass.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            occlusionPass.mSampledImages.push_back(depthImage);
+            occlusionPass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+            {
+                if (m_isGpuDriven && m_occlusionCulling)
+                {
+                    const ubo::Camera& camera = m_cameraUniforms[context.mFrameIndex];
+                    m_occlusionCulling->recordLate(commandBuffer, camera.projection * camera.view * camera.model, m_gltfModel.getDrawCount(),
+                                                   m_gltfModel.getDrawBatchCount(), m_useDrawIndirectCount);
+                }
+            };
+            m_renderGraph->addPass(std::move(occlusionPass));
+
+            // late scene pass: keeps the early color and depth, resolves again
+            RenderGraphPassDesc lateScenePass{};
+            lateScenePass.mName = "scene late";
+            colorAttachment.mLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+            depthAttachment.mLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+            lateScenePass.mColorAttachments.push_back(colorAttachment);
+            if (m_isDeferred)
+            {
+                for (RenderGraphAttachment& attachment : gBufferAttachments)
+                {
+                    attachment.mLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+                    lateScenePass.mColorAttachments.push_back(attachment);
+                }
+            }
+            lateScenePass.mDepthStencilAttachment = depthAttachment;
+            if (msaaEnabled)
+            {
+                lateScenePass.mResolveAttachments.push_back(sceneOutput);
+            }
+            if (isShadingRateImage)
+            {
+                lateScenePass.mShadingRateAttachment = shadingRateImage;
+                lateScenePass.mShadingRateTexelSize  = m_shadingRateImage->getTexelSize();
+            }
+
+            lateScenePass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+            {
+                if (m_isGpuDriven && m_occlusionCulling)
+                {
+                    recordLateScenePass(commandBuffer, context.mFrameIndex);
+                }
+            };
+            m_renderGraph->addPass(std::move(lateScenePass));
+        }
+
+        // ambient occlusion: half-resolution visibility from the finished depth, for the lighting pass to upsample
+        if (m_ambientOcclusion)
+        {
+            RenderGraphPassDesc occlusionPass{};
+            occlusionPass.mName      = "ambient occlusion";
+            occlusionPass.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            occlusionPass.mSampledImages.push_back(depthImage);
+            occlusionPass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+            {
+                if (m_ambientOcclusion)
+                {
+                    m_ambientOcclusion->record(commandBuffer, m_renderExtent, m_cameraUniforms[context.mFrameIndex].projection, 
+                                               m_ambientOcclusionSettings, m_isAmbientOcclusion);
+                }
+            };
+            m_renderGraph->addPass(std::move(occlusionPass));
+        }
+
+        // deferred lighting: every pixel the scene passes covered lit once, into the scene target the rest reads
+        if (m_isDeferred)
+        {
+            RenderGraphPassDesc lightingPass{};
+            lightingPass.mName      = "deferred lighting";
+            lightingPass.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            lightingPass.mSampledImages.push_back(gBufferAttachments[0].mImage);
+            lightingPass.mSampledImages.push_back(gBufferAttachments[1].mImage);
+            lightingPass.mSampledImages.push_back(depthImage);
+            lightingPass.mStorageImages.push_back(sceneOutput);
+            lightingPass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+            {
+                if (m_deferredLighting)
+                {
+                    // camera and lights bound as for the scene pipelines, at the compute bind point
+                    const uint32_t frameIndex = context.mFrameIndex;
+                    const VkPipelineLayout pipelineLayout = m_deferredLighting->getPipelineLayout();
+                    bindCameraSet(commandBuffer, pipelineLayout, frameIndex, VK_PIPELINE_BIND_POINT_COMPUTE);
+                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 2, 1, &m_lightDescriptorSets[frameIndex], 
+                                            1, &m_uniformOffsets[frameIndex][1]);
+                    m_deferredLighting->record(commandBuffer, m_renderExtent, glm::inverse(m_cameraUniforms[frameIndex].viewProjections[0]),
+                                               m_ambientOcclusion && m_isAmbientOcclusion);
+                }
+            };
+            m_renderGraph->addPass(std::move(lightingPass));
+        }
+
+        if (m_isTileLocalPost)
+        {
+            return createTileLocalPost(device, swapchainImage, sceneOutput, depthImage);
+        }
+
+        // temporal aa: the jittered scene and its depth resolved against the history into the image the post process reads
+        RenderGraphHandle postSource = sceneOutput;
+        if (m_temporalAA)
+        {
+            postSource = m_renderGraph->createImage("scene antialiased", sceneDesc);
+
+            RenderGraphPassDesc temporalPass{};
+            temporalPass.mName      = "temporal aa";
+            temporalPass.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            temporalPass.mSampledImages.push_back(sceneOutput);
+            temporalPass.mSampledImages.push_back(depthImage);
+            temporalPass.mStorageImages.push_back(postSource);
+            temporalPass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+            {
+                if (m_temporalAA)
+                {
+                    m_temporalAA->record(commandBuffer);
+                }
+            };
+            m_renderGraph->addPass(std::move(temporalPass));
+        }
+
+        // post process: bloom, exposure and tonemap once per rendered pixel of the resolved scene. without it the upscale
+        // pass shows the resolved scene as it is
+        RenderGraphHandle displayColor = postSource;
+        if (m_isPostProcessAvailable)
+        {
+            displayColor = displayImage;
+
+            RenderGraphPassDesc postPass{};
+            postPass.mName      = "post process";
+            postPass.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            postPass.mSampledImages.push_back(postSource);
+            postPass.mStorageImages.push_back(displayImage);
+            postPass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+            {
+                if (m_postProcess)
+                {
+                    m_postProcess->record(commandBuffer, m_renderExtent, m_frameDt, m_postProcessSettings);
+                }
+            };
+            m_renderGraph->addPass(std::move(postPass));
+        }
+
+        // fxaa: the tonemapped display color filtered into the image the upscale pass reads
+        RenderGraphHandle upscaleSource = displayColor;
+        if (m_fxaaPass)
+        {
+            upscaleSource = m_renderGraph->createImage("scene display fxaa", displayDesc);
+
+            RenderGraphPassDesc fxaaDesc{};
+            fxaaDesc.mName      = "fxaa";
+            fxaaDesc.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            fxaaDesc.mSampledImages.push_back(displayColor);
+            fxaaDesc.mStorageImages.push_back(upscaleSource);
+            fxaaDesc.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+            {
+                if (m_fxaaPass)
+                {
+                    m_fxaaPass->record(commandBuffer, m_renderExtent, m_fxaaSettings);
+                }
+            };
+            m_renderGraph->addPass(std::move(fxaaDesc));
+        }
+
+        // shading rates of the next frame from this frame's color; the pass synchronizes the rate image itself
+        if (isShadingRateImage)
+        {
+            RenderGraphPassDesc shadingRatePass{};
+            shadingRatePass.mName      = "shading rate";
+            shadingRatePass.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            shadingRatePass.mSampledImages.push_back(displayColor);
+            shadingRatePass.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+            {
+                if (m_shadingRateImage)
+                {
+                    m_shadingRateImage->record(commandBuffer, m_renderExtent, m_shadingRateThreshold);
+                }
+            };
+            m_renderGraph->addPass(std::move(shadingRatePass));
+        }
+
+        // upscale pass: fills the whole swapchain image from the region of the display color the scene viewport covered
+        // (a plain copy at the native extent). swapchain images are not storage images everywhere, so the post process
+        // cannot write them directly. the overlay blends over it in the same subpass: its single swapchain attachment
+        // keeps the render pass compatible with the one the imgui pipeline is built for, and saves a load and store
+        RenderGraphPassDesc upscaleDesc{};
+        upscaleDesc.mName = "upscale";
+
+        RenderGraphAttachment outputAttachment{};
+        outputAttachment.mImage  = swapchainImage;
+        outputAttachment.mLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        upscaleDesc.mColorAttachments.push_back(outputAttachment);
+        upscaleDesc.mSampledImages.push_back(upscaleSource);
+
+        upscaleDesc.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+        {
+            if (m_upscalePass)
+            {
+                m_upscalePass->record(commandBuffer, m_renderExtent, isDynamicResolutionActive() ? m_upscaleSharpness : 0.0f);
+            }
+            if (m_isOverlayDrawn)
+            {
+                m_imguiLayer->recordDraws(commandBuffer);
+            }
+        };
+        const RenderGraphHandle upscalePass = m_renderGraph->addPass(std::move(upscaleDesc));
+
+        if (m_scenePass == kInvalidRenderGraphHandle || !m_renderGraph->compile(device, m_swapchain->getExtent()))
+        {
+            VK_LOG_ERROR("PBR::createRenderGraph failed to compile render graph");
+            return false;
+        }
+
+        // not fatal: the late pass draws nothing and the early cull falls back to the frustum pass
+        if (m_occlusionCulling && !m_occlusionCulling->bindDepth(m_renderGraph->getImage(depthImage), depthFormat, m_swapchain->getExtent()))
+        {
+            VK_LOG_WARN("PBR::createRenderGraph failed to bind scene depth for occlusion culling, using frustum culling only");
+            m_occlusionCulling.reset();
+        }
+
+        // the scene target is only lit once the lighting pass reads the g-buffer, so a failed bind cannot fall back either
+        if (m_deferredLighting && !m_deferredLighting->bindImages(m_renderGraph->getImageView(gBufferAttachments[0].mImage), 
+                                                                  m_renderGraph->getImageView(gBufferAttachments[1].mImage),
+                                                                  m_renderGraph->getImage(depthImage), depthFormat, m_renderGraph->getImageView(sceneOutput)))
+        {
+            VK_LOG_ERROR("PBR::createRenderGraph failed to bind the deferred lighting images");
+            return false;
+        }
+
+        // not fatal: the graph's occlusion pass records nothing once the pass is gone
+        if (m_ambientOcclusion && (!m_ambientOcclusion->bindDepth(m_renderGraph->getImage(depthImage), depthFormat) ||
+                                   !m_deferredLighting->bindOcclusion(m_ambientOcclusion->getOcclusionView(), m_ambientOcclusion->getDepthView(),
+                                                                      m_ambientOcclusion->getExtent())))
+        {
+            VK_LOG_WARN("PBR::createRenderGraph failed to bind the ambient occlusion images, lighting without it");
+            m_ambientOcclusion.reset();
+        }
+
+        // the post process reads what the temporal pass writes, so a failed bind cannot fall back here
+        if (m_temporalAA && !m_temporalAA->bindImages(m_renderGraph->getImageView(sceneOutput), m_renderGraph->getImage(depthImage), depthFormat,
+                                                      m_renderGraph->getImageView(postSource)))
+        {
+            VK_LOG_ERROR("PBR::createRenderGraph failed to bind the temporal aa images");
+            return false;
+        }
+
+        // not fatal: rebuild the graph with the upscale pass reading the scene target untonemapped
+        if (m_isPostProcessAvailable && !createPostProcess(device, postSource, displayImage))
+        {
+            VK_LOG_WARN("PBR::createRenderGraph failed to create the post process, presenting the scene untonemapped");
+            m_isPostProcessAvailable = false;
+            m_fxaaPass.reset();
+            return createRenderGraph(device);
+        }
+
+        if (m_fxaaPass)
+        {
+            m_fxaaPass->bindImages(m_renderGraph->getImageView(displayColor), m_renderGraph->getImageView(upscaleSource));
+        }
+
+        // not fatal where the tile-local tonemap can write the swapchain instead: rebuild the graph with msaa at the
+        // native extent, forward shaded in one view
+        if (!createUpscalePass(device, upscalePass, upscaleSource))
+        {
+            if (!m_postProcess || !device.getEnabledFeatures().fragmentStoresAndAtomics)
+            {
+                VK_LOG_ERROR("PBR::createRenderGraph failed to create the upscale pass");
+                return false;
+            }
+
+            VK_LOG_WARN("PBR::createRenderGraph failed to create the upscale pass, falling back to the tile-local tonemap");
+            m_isTileLocalPost = true;
+            m_isDynamicResolution = false;
+            m_isStereo = false;
+            m_isDeferred = false;
+            m_antiAliasingMode = AntiAliasingMode::kMsaa;
+            if (m_shadingRateMode == ShadingRateMode::kAdaptive)
+            {
+                m_shadingRateMode = ShadingRateMode::kMaterials;
+            }
+            m_postProcess.reset();
+            m_temporalAA.reset();
+            m_fxaaPass.reset();
+            m_deferredLighting.reset();
+            m_ambientOcclusion.reset();
+            m_shadingRateImage.reset();
+            return createRenderGraph(device);
+        }
+
+        if (m_shadingRateImage)
+        {
+            m_shadingRateImage->bindSource(m_renderGraph->getImageView(displayColor));
+        }
+
+        // the scene starts at the full extent; updateRenderExtent scales it from the next frame on
+        m_renderExtent = m_swapchain->getExtent();
+
+        VK_LOG_DEBUG("PBR::createRenderGraph successful (samples: %d, transient memory: %llu bytes)", m_sampleCount, 
+                     static_cast<unsigned long long>(m_renderGraph->getTransientMemorySize()));
+        return true;
+    }
+
+    bool PBR::createGraphicsPipeline(const VulkanDevice& device) noexcept
+    {
+        // per-draw culling lets material permutations and the depth pipelines share across sidedness
+        m_isExtendedDynamicState = device.isExtendedDynamicStateEnabled();
+        m_gltfModel.setDynamicCullModeEnabled(m_isExtendedDynamicState);
+        m_isShaderObject = device.isShaderObjectEnabled();
+
+        // bindless cpu draws of one pipeline and vertex pool go out as multi-draws, told apart by gl_DrawID
+        m_isMultiDraw = m_isBindless && m_multiDrawVertexShader.isValid();
+        m_gltfModel.setMultiDrawLimit(m_isMultiDraw ? device.getMultiDrawProperties().maxMultiDrawCount : 0);
+
+        // retrieve shared vertex input layout
+        const VkPipelineVertexInputStateCreateInfo vertexInputState = GLTFModel::getVertexInputState(m_gltfModel.getVertexFormat());
+
+        // input assembly state: triangle list
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.pNext = nullptr;
+        inputAssembly.flags = 0;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // viewport and scissor state: the full extent here, overridden per recording (see setSceneViewport)
+        auto swapchainExtent = m_swapchain->getExtent();
+
+        VkViewport& viewport = m_scenePipelineState.mViewport;
+        viewport = {};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = static_cast<float>(swapchainExtent.width);
+        viewport.height = static_cast<float>(swapchainExtent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+
+        VkRect2D& scissor = m_scenePipelineState.mScissor;
+        scissor = {};
+        scissor.offset.x = 0;
+        scissor.offset.y = 0;
+        scissor.extent = swapchainExtent;
+
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.pNext = nullptr;
+        viewportState.flags = 0;
+        viewportState.viewportCount = 1;
+        viewportState.pViewports = &viewport;
+        viewportState.scissorCount = 1;
+        viewportState.pScissors = &scissor;
+
+        // dynamic viewport and scissor: dynamic resolution changes the scene extent without rebuilding pipelines
+        auto& dynamicStates = m_scenePipelineState.mDynamicStates;
+        dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.pNext = nullptr;
+        dynamicState.flags = 0;
+        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+        dynamicState.pDynamicStates = dynamicStates.data();
+
+        // rasterization state
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        rasterizationState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizationState.pNext = nullptr;
+        rasterizationState.flags = 0;
+        rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizationState.cullMode = VK_CULL_MODE_NONE;
+        rasterizationState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizationState.lineWidth = 1.0f;
+
+        // multisample state
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampleState.pNext = nullptr;
+        multisampleState.flags = 0;
+        multisampleState.rasterizationSamples = m_sampleCount;
+
+        // depth stencil state
+        VkPipelineDepthStencilStateCreateInfo depthStencilState{};
+        depthStencilState.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;                       
+        depthStencilState.pNext = NULL;                                                                            
+        depthStencilState.flags = 0;                                                                                
+        depthStencilState.depthTestEnable = VK_TRUE;                                                                
+        depthStencilState.depthWriteEnable = VK_TRUE;                                                               
+        depthStencilState.depthCompareOp = kDepthCompareOp;
+        depthStencilState.depthBoundsTestEnable = VK_FALSE;
+        depthStencilState.back.failOp = VK_STENCIL_OP_KEEP;
+        depthStencilState.back.passOp = VK_STENCIL_OP_KEEP;
+        depthStencilState.back.compareOp = VK_COMPARE_OP_ALWAYS;
+        depthStencilState.stencilTestEnable = VK_FALSE;
+        depthStencilState.front = depthStencilState.back;
+
+        // color blend state: every g-buffer target of deferred shading is written as is
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable = VK_FALSE;
+        m_scenePipelineState.mColorBlendAttachments.fill(colorBlendAttachment);
+
+        // alpha-blended materials: straight alpha over the opaque scene, keeping the target's own alpha
+        VkPipelineColorBlendAttachmentState& blendAttachment = m_scenePipelineState.mBlendAttachment;
+        blendAttachment = colorBlendAttachment;
+        blendAttachment.blendEnable         = VK_TRUE;
+        blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+        blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        blendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+        colorBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlendState.pNext = nullptr;
+        colorBlendState.flags = 0;
+        colorBlendState.attachmentCount = m_isDeferred ? kMaxSceneColorAttachments : 1;
+        colorBlendState.pAttachments = m_scenePipelineState.mColorBlendAttachments.data();
+
+        // configure the graphics pipeline
+        GraphicsPipelineConfig pipelineConfig{};
+        pipelineConfig.mFlags = 0;
+        pipelineConfig.mVertexInputState = vertexInputState;
+        pipelineConfig.mInputAssemblyState = inputAssembly;
+        pipelineConfig.mViewportState = viewportState;
+        pipelineConfig.mRasterizationState = rasterizationState;
+        pipelineConfig.mMultisampleState = multisampleState;
+        pipelineConfig.mDepthStencilState = depthStencilState;
+        pipelineConfig.mColorBlendState = colorBlendState;
+        pipelineConfig.mDynamicState = dynamicState;
+        pipelineConfig.mRenderPass = m_renderGraph->getRenderPass(m_scenePass);
+        pipelineConfig.mSubpassIndex = m_renderGraph->getSubpassIndex(m_scenePass);
+        pipelineConfig.mDescriptorSetLayouts.emplace_back(m_cameraDescriptorSetLayout);
+        pipelineConfig.mDescriptorSetLayouts.emplace_back(m_isBindless ? GLTFModel::getBindlessDescriptorSetLayout() : GLTFModel::getDescriptorSetLayout());
+        pipelineConfig.mDescriptorSetLayouts.emplace_back(m_lightDescriptorSetLayout);
+        pipelineConfig.mPushConstantRanges.emplace_back(m_isBindless ? GLTFModel::getObjectPushConstantRange() : GLTFModel::getPushConstantRange());
+
+        // adaptive shading: the rate image replaces the full pipeline rate (coarse materials, see getPermutationConfigs)
+        if (m_shadingRateImage)
+        {
+            pipelineConfig.mFragmentShadingRateState = makeShadingRateState({ 1, 1 }, VK_FRAGMENT_SHADING_RATE_COMBINER_OP_REPLACE_KHR);
+        }
+
+        // indirect variant: same state, per-draw model matrices as an instance-rate binding
+        GraphicsPipelineConfig indirectConfig = pipelineConfig;
+        indirectConfig.mPushConstantRanges[0] = GLTFModel::getPushConstantRange();
+        indirectConfig.mVertexInputState = GLTFModel::getIndirectVertexInputState(m_gltfModel.getVertexFormat());
+
+        // instanced variant for the cpu path: the indirect attributes over tightly packed instance matrices
+        GraphicsPipelineConfig instancedConfig = indirectConfig;
+        instancedConfig.mVertexInputState = GLTFModel::getInstancedVertexInputState(m_gltfModel.getVertexFormat());
+
+        // pulled indirect variant: only the draw records stay a vertex binding (pbr_pulled.vert fetches the vertices)
+        m_isVertexPulling = m_isVertexPulling && m_isGpuDriven && m_pulledVertexShader.isValid();
+        m_gltfModel.setVertexPullingEnabled(m_isVertexPulling);
+        m_isVertexPulling = m_gltfModel.isVertexPullingEnabled();
+        if (m_isVertexPulling)
+        {
+            indirectConfig.mVertexInputState = GLTFModel::getPulledVertexInputState();
+        }
+
+        // meshlet variant: no vertex input (the mesh stage fetches the pool itself), meshlets at set 3, and the push
+        // constants reach the task and mesh stages
+        GraphicsPipelineConfig meshletConfig = pipelineConfig;
+        meshletConfig.mDescriptorSetLayouts.emplace_back(GLTFModel::getMeshletDescriptorSetLayout());
+        meshletConfig.mPushConstantRanges[0] = GLTFModel::getMeshletPushConstantRange();
+        meshletConfig.addSpecializationConstant(VK_SHADER_STAGE_MESH_BIT_EXT, GLTFModel::kVertexFormatConstantId, 
+                                                m_gltfModel.getVertexFormat() == GLTFVertexFormat::kPacked ? 1u : 0u);
+
+        // the configs stay around (pointing into m_scenePipelineState) so new shaders can rebuild the same pipelines
+        auto& configs = m_scenePipelineState.mConfigs;
+        configs = { std::move(pipelineConfig), std::move(indirectConfig), std::move(instancedConfig), std::move(meshletConfig) };
+        m_isHalfPrecision = m_isHalfPrecision && m_halfFragmentShader.isValid();
+        setSceneShaderStages(getSceneShaders(), configs);
+
+        // create graphics pipeline
+        const SceneShaderSet shaders = getSceneShaders();
+        if (!createScenePipeline(device, shaders, configs[kGraphicsPipeline], kGraphicsPipeline, m_graphicsPipeline))
+        {
+            VK_LOG_ERROR("PBR::createGraphicsPipeline failed");
+            return false;
+        }
+
+        // gpu-driven draws use the indirect variant
+        if (m_isGpuDriven && !createScenePipeline(device, shaders, configs[kIndirectPipeline], kIndirectPipeline, m_indirectPipeline))
+        {
+            VK_LOG_WARN("PBR::createGraphicsPipeline indirect pipeline failed, using cpu-recorded draws");
+            m_isGpuDriven = false;
+        }
 
-        // create a host-visible uniform buffer for each frame
-        for (size_t i = 0; i < m_maxFramesInFlight; i++)
+        // meshlet draws replace the per-node pipeline where they can
+        if (m_isMeshShading && !createScenePipeline(device, shaders, configs[kMeshletPipeline], kMeshletPipeline, m_meshletPipeline))
         {
-            VkBufferCreateInfo bufferCreateInfo{};
-            bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufferCreateInfo.pNext = nullptr;
-            bufferCreateInfo.flags = 0;
-            bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-            bufferCreateInfo.size = sizeof(ubo::Camera);
+            VK_LOG_WARN("PBR::createGraphicsPipeline meshlet pipeline failed, using the vertex pipeline");
+            m_isMeshShading = false;
+        }
 
-            // create host-visible buffer for camera uniform data
-            if (!m_cameraUniformBuffers[i].createHostVisible(device, bufferCreateInfo, nullptr, 0, true))
+        // repeated meshes of the cpu path draw instanced
+        // (bindless draws already merge repeated meshes through the object records, meshlet draws take one transform per run,
+        // and the depth pre-pass draws with per-run transforms)
+        m_gltfModel.setInstancingEnabled(false);
+        if (!m_isGpuDriven && !m_isBindless && !m_isMeshShading && m_depthPrepass == kInvalidRenderGraphHandle && 
+            m_indirectVertexShader.isValid() && m_gltfModel.getRepeatedDrawCount() > 0)
+        {
+            if (createScenePipeline(device, shaders, configs[kInstancedPipeline], kInstancedPipeline, m_instancedPipeline))
             {
-                VK_LOG_ERROR("PBR::createUniformBuffers failed to create host visible buffer for camera uniform data");
-                return false;
+                m_gltfModel.setInstancingEnabled(true);
             }
-
-            // create host-visible buffer for light uniform data
-            bufferCreateInfo.size = sizeof(ubo::Light);
-            if (!m_lightUniformBuffers[i].createHostVisible(device, bufferCreateInfo, nullptr, 0, true))
+            else
             {
-                VK_LOG_ERROR("PBR::createUniformBuffers failed to create host visible buffer for light uniform data");
-                return false;
+                VK_LOG_WARN("PBR::createGraphicsPipeline instanced pipeline failed, drawing repeated meshes one by one");
             }
         }
 
-        VK_LOG_DEBUG("PBR::createUniformBuffers successful");
+        // depth pre-pass pipelines first: permutations test EQUAL against them when they cover every draw
+        createDepthPipelines(device);
+
+        // specialize the cpu path's pipeline per material permutation
+        createPermutationPipelines();
+
+        VK_LOG_DEBUG("PBR::createGraphicsPipeline successful");
         return true;
     }
 
-    bool PBR::createShaderModules() noexcept
+    PBR::SceneShaderSet PBR::getSceneShaders() const noexcept
     {
-        // create vertex shader module from SPIR-V
-        if (!m_vertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, "pbr/pbr.vert.spv"))
+        return { &m_vertexShader, &m_fragmentShader, &m_indirectVertexShader, &m_objectVertexShader, &m_bindlessFragmentShader, 
+                 &m_meshletTaskShader, &m_meshletMeshShader, &m_pulledVertexShader, &m_halfFragmentShader, &m_multiDrawVertexShader,
+                 &m_rayQueryFragmentShader, &m_rayQueryBindlessFragmentShader, &m_gBufferFragmentShader, &m_gBufferBindlessFragmentShader };
+    }
+
+    std::vector<const VulkanShader*> PBR::getSceneStageShaders(const SceneShaderSet& shaders, size_t pipelineIndex) const noexcept
+    {
+        // bindless draws read object records and materials from the bindless set; the others shade with the fp16 build when it is on.
+        // ray query shadows take precedence over both fp16 and the shadow map builds. deferred shading writes the g-buffer
+        // instead, its lighting pass traces or looks up the shadows
+        const VulkanShader* sceneFragmentShader = m_isDeferred ? shaders[kGBufferFragmentShader] : 
+                                                  m_isRayTracedShadows ? shaders[kRayQueryFragmentShader] :
+                                                  m_isHalfPrecision ? shaders[kHalfFragmentShader] : shaders[kFragmentShader];
+        const VulkanShader* bindlessShader = m_isDeferred ? shaders[kGBufferBindlessFragmentShader] : 
+                                             m_isRayTracedShadows ? shaders[kRayQueryBindlessFragmentShader] : shaders[kBindlessFragmentShader];
+        const VulkanShader* objectShader   = m_isMultiDraw ? shaders[kMultiDrawVertexShader] : shaders[kObjectVertexShader];
+        const VulkanShader* vertexShader   = m_isBindless ? objectShader : shaders[kVertexShader];
+        const VulkanShader* fragmentShader = m_isBindless ? bindlessShader : sceneFragmentShader;
+        switch (pipelineIndex)
         {
-            VK_LOG_ERROR("PBR::createShaderModules failed for vertex shader");
+            // indirect and instanced draws take their model matrices from the instance-rate binding
+            // (pulled indirect draws fetch their vertices too)
+            case kIndirectPipeline:
+                return { m_isVertexPulling ? shaders[kPulledVertexShader] : shaders[kIndirectVertexShader], fragmentShader };
+            case kInstancedPipeline:
+                return { shaders[kIndirectVertexShader], fragmentShader };
+
+            // meshlet draws: task and mesh stages ahead of the per-material fragment shader
+            case kMeshletPipeline:
+                return { shaders[kMeshletTaskShader], shaders[kMeshletMeshShader], sceneFragmentShader };
+
+            default:
+                return { vertexShader, fragmentShader };
+        }
+    }
+
+    void PBR::setSceneShaderStages(const SceneShaderSet& shaders, std::array<GraphicsPipelineConfig, kScenePipelineCount>& configs) const noexcept
+    {
+        for (size_t i = 0; i < kScenePipelineCount; ++i)
+        {
+            configs[i].mShaderStages.clear();
+            for (const VulkanShader* shader : getSceneStageShaders(shaders, i))
+            {
+                configs[i].mShaderStages.push_back(shader->getShaderStageInfo());
+            }
+        }
+    }
+
+    bool PBR::createScenePipeline(const VulkanDevice& device, const SceneShaderSet& shaders, const GraphicsPipelineConfig& config, 
+                                  size_t pipelineIndex, VulkanPipeline& pipeline) const noexcept
+    {
+        // shader objects take the config's state at bind time and their code from the stage shaders
+        if (m_isShaderObject)
+        {
+            return pipeline.initializeShaderObjects(m_vkDevice, config, getSceneStageShaders(shaders, pipelineIndex));
+        }
+        return pipeline.initialize(m_vkDevice, config, device.getPipelineCache().get());
+    }
+
+    std::vector<GraphicsPipelineConfig> PBR::getPermutationConfigs(const std::array<GraphicsPipelineConfig, kScenePipelineCount>& configs,
+                                                                   std::vector<uint32_t>& pipelineIndices) const noexcept
+    {
+        pipelineIndices.clear();
+
+        // the uber shader serves gpu-driven draws (batches mix materials), the bindless fragment shader and shader objects
+        if (m_isGpuDriven || m_isBindless || m_isShaderObject)
+        {
+            return {};
+        }
+
+        // the variant the cpu path records with: material features become specialization constants of the fragment stage,
+        // and single-sided materials cull back faces
+        const GraphicsPipelineConfig& baseConfig = configs[m_isMeshShading ? kMeshletPipeline : 
+                                                           (m_gltfModel.isInstancingEnabled() ? kInstancedPipeline : kGraphicsPipeline)];
+        const std::vector<uint32_t>& permutations = m_gltfModel.getMaterialPermutations();
+        std::vector<GraphicsPipelineConfig> permutationConfigs;
+        std::vector<GraphicsPipelineKey> pipelineKeys;
+        for (size_t i = 0; i < permutations.size(); ++i)
+        {
+            // with dynamic culling single-sided materials take the double-sided variant: the back faces its lighting flips
+            // for are culled before they reach it
+            const uint32_t features = m_isExtendedDynamicState ? (permutations[i] | kMaterialDoubleSided) : permutations[i];
+
+            // a full depth pre-pass already resolved visibility: shade only the fragments that won it
+            const bool isDepthResolved = m_depthPrepassMode == DepthPrepassMode::kFull && isDepthPrepassActive() && 
+                                         m_gltfModel.isDepthPrepassComplete(static_cast<uint32_t>(i));
+
+            GraphicsPipelineConfig config = baseConfig;
+            config.addSpecializationConstant(VK_SHADER_STAGE_FRAGMENT_BIT, GLTFModel::kMaterialFeatureConstantId, features);
+            if (m_isExtendedDynamicState)
+            {
+                config.mExtendedDynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE);
+            }
+            else
+            {
+                config.mRasterizationState.cullMode = (features & kMaterialDoubleSided) ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+            }
+
+            // blended materials draw last, back to front (see GLTFModel::prepareDraws): tested against depth, never writing it.
+            // the g-buffer holds one surface per pixel, so deferred shading cuts them out like masked ones instead
+            if ((features & kMaterialAlphaBlend) && !m_isDeferred)
+            {
+                config.mColorBlendState.pAttachments = &m_scenePipelineState.mBlendAttachment;
+                config.mDepthStencilState->depthWriteEnable = VK_FALSE;
+            }
+
+            if (isDepthResolved)
+            {
+                config.mDepthStencilState->depthCompareOp   = VK_COMPARE_OP_EQUAL;
+                config.mDepthStencilState->depthWriteEnable = VK_FALSE;
+            }
+
+            // no base color or normal map leaves little detail within 2x2 pixels; rate image texels are never coarser, so
+            // the pipeline rate is kept over them
+            if (m_shadingRateMode != ShadingRateMode::kOff && (features & (kMaterialBaseColorMap | kMaterialNormalMap)) == 0)
+            {
+                config.mFragmentShadingRateState = makeShadingRateState(kCoarseFragmentSize, VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR);
+            }
+
+            // permutations that end up with the same state share a pipeline (e.g. features the shader or the dynamic cull
+            // mode make no difference for)
+            GraphicsPipelineKey pipelineKey = makeGraphicsPipelineKey(config);
+            const auto sharedKey = std::find(pipelineKeys.begin(), pipelineKeys.end(), pipelineKey);
+            pipelineIndices.push_back(static_cast<uint32_t>(sharedKey - pipelineKeys.begin()));
+            if (sharedKey == pipelineKeys.end())
+            {
+                pipelineKeys.push_back(std::move(pipelineKey));
+                permutationConfigs.push_back(std::move(config));
+            }
+        }
+        return permutationConfigs;
+    }
+
+    void PBR::setPermutationPipelines(std::vector<VulkanPipeline>&& pipelines, const std::vector<uint32_t>& pipelineIndices,
+                                      const std::vector<PipelineHandle>& libraryHandles) noexcept
+    {
+        // handles stay indexed by permutation, shared pipelines appear once per permutation using them
+        m_permutationPipelines = std::move(pipelines);
+        m_permutationPipelineIndices = pipelineIndices;
+        m_permutationHandles.clear();
+        for (uint32_t pipelineIndex : pipelineIndices)
+        {
+            m_permutationHandles.push_back(m_permutationPipelines[pipelineIndex].get());
+        }
+
+        // linked pipelines are fast links until their optimized links replace them
+        m_permutationLinks.clear();
+        if (m_pipelineLibrary.isLinkingEnabled())
+        {
+            m_permutationLinks = libraryHandles;
+        }
+    }
+
+    void PBR::updateOptimizedPipelines() noexcept
+    {
+        const bool useTimeline = m_frameTimeline.isValid();
+        const uint64_t lastSubmittedValue = m_frameTimeline.getLastSubmittedValue();
+        bool isSwapped = false;
+        for (size_t i = 0; i < m_permutationLinks.size(); ++i)
+        {
+            if (!m_permutationLinks[i].isValid() || !m_pipelineLibrary.isOptimizationReady(m_permutationLinks[i]))
+            {
+                continue;
+            }
+
+            // frames in flight still draw with the fast link: retire it like on a resize
+            VulkanPipeline optimizedPipeline;
+            if (m_pipelineLibrary.releaseOptimized(m_permutationLinks[i], optimizedPipeline))
+            {
+                if (useTimeline) { m_deletionQueue.retire(std::move(m_permutationPipelines[i]), lastSubmittedValue); }
+                else             { m_deletionQueue.retire(std::move(m_permutationPipelines[i])); }
+                m_permutationPipelines[i] = std::move(optimizedPipeline);
+                isSwapped = true;
+            }
+            m_permutationLinks[i] = PipelineHandle{};
+        }
+
+        if (!isSwapped)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < m_permutationPipelineIndices.size(); ++i)
+        {
+            m_permutationHandles[i] = m_permutationPipelines[m_permutationPipelineIndices[i]].get();
+        }
+
+        // secondaries of frames in flight bind the fast links: re-record each once its slot comes around
+        m_isSceneRecordStale.assign(m_maxFramesInFlight, true);
+        requestRedraw();
+    }
+
+    bool PBR::createPermutationPipelines() noexcept
+    {
+        m_permutationPipelines.clear();
+        m_permutationHandles.clear();
+        m_permutationLinks.clear();
+
+        // compile every permutation at once; the library spreads them over its workers
+        std::vector<uint32_t> pipelineIndices;
+        const std::vector<PipelineHandle> handles = m_pipelineLibrary.compile(getPermutationConfigs(m_scenePipelineState.mConfigs, pipelineIndices));
+        std::vector<VulkanPipeline> pipelines(handles.size());
+        bool isSuccessful = true;
+        for (size_t i = 0; i < handles.size(); ++i)
+        {
+            isSuccessful = m_pipelineLibrary.release(handles[i], pipelines[i]) && isSuccessful;
+        }
+
+        // all or nothing: without a full set every material draws with the uber pipeline
+        if (!isSuccessful)
+        {
+            VK_LOG_WARN("PBR::createPermutationPipelines failed, materials share the uber shader");
             return false;
         }
 
-        // create fragment shader module from SPIR-V
-        if (!m_fragmentShader.initialize(m_vkDevice, VK_SHADER_STAGE_FRAGMENT_BIT, "pbr/pbr.frag.spv"))
+        setPermutationPipelines(std::move(pipelines), pipelineIndices, handles);
+        VK_LOG_DEBUG("PBR::createPermutationPipelines successful (%zu permutations, %zu pipelines)", m_permutationHandles.size(), 
+                     m_permutationPipelines.size());
+        return true;
+    }
+
+    bool PBR::createDepthPipelines(const VulkanDevice& device) noexcept
+    {
+        m_depthPipelineHandles = {};
+        if (m_depthPrepass == kInvalidRenderGraphHandle)
         {
-            VK_LOG_ERROR("PBR::createShaderModules failed for fragment shader");
             return false;
         }
 
-        VK_LOG_DEBUG("PBR::createShaderModules successful");
+        // the per-node pipeline's state with the position stream, no fragment stage and no color attachments; only the
+        // camera set and the push constants are read
+        GraphicsPipelineConfig depthConfig = m_scenePipelineState.mConfigs[kGraphicsPipeline];
+        depthConfig.mShaderStages = { m_depthVertexShader.getShaderStageInfo() };
+        depthConfig.mVertexInputState = GLTFModel::getDepthVertexInputState(m_gltfModel.getVertexFormat());
+        depthConfig.mColorBlendState.attachmentCount = 0;
+        depthConfig.mColorBlendState.pAttachments    = nullptr;
+        depthConfig.mRenderPass   = m_renderGraph->getRenderPass(m_depthPrepass);
+        depthConfig.mSubpassIndex = m_renderGraph->getSubpassIndex(m_depthPrepass);
+        depthConfig.mDescriptorSetLayouts = { m_cameraDescriptorSetLayout };
+
+        // culling matches the permutations: back faces for single-sided materials, none for double-sided ones. with
+        // dynamic culling one pipeline serves both and the draws set the mode
+        const std::array<VkCullModeFlags, 2> cullModes = { VK_CULL_MODE_BACK_BIT, VK_CULL_MODE_NONE };
+        if (m_isExtendedDynamicState)
+        {
+            depthConfig.mExtendedDynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE);
+        }
+        for (size_t i = 0; i < m_depthPipelines.size(); ++i)
+        {
+            if (m_isExtendedDynamicState && i > 0)
+            {
+                m_depthPipelineHandles[i] = m_depthPipelineHandles[0];
+                continue;
+            }
+
+            depthConfig.mRasterizationState.cullMode = cullModes[i];
+            if (!m_depthPipelines[i].initialize(m_vkDevice, depthConfig, device.getPipelineCache().get()))
+            {
+                // not fatal: the pre-pass records nothing and the scene pass tests against cleared depth
+                VK_LOG_WARN("PBR::createDepthPipelines failed, depth pre-pass disabled");
+                m_depthPipelines = {};
+                m_depthPipelineHandles = {};
+                return false;
+            }
+            m_depthPipelineHandles[i] = m_depthPipelines[i].get();
+        }
+
+        VK_LOG_DEBUG("PBR::createDepthPipelines successful (%s)", m_depthPrepassMode == DepthPrepassMode::kFull ? "full" : "occluders");
         return true;
     }
 
-    bool PBR::createDescriptorSetLayouts() noexcept
+    bool PBR::isDepthPrepassAvailable() const noexcept
+    {
+        // cpu path with per-material sets only: gpu-driven and meshlet draws are culled on the gpu, and bindless runs
+        // carry no per-draw transform
+        return m_depthPrepassMode != DepthPrepassMode::kOff && m_depthVertexShader.isValid() && m_gltfModel.hasDepthPositions() && 
+               !m_isGpuDriven && !m_isMeshShading && !m_isBindless;
+    }
+
+    bool PBR::isDepthPrepassActive() const noexcept
     {
-        // set: 0, binding: 0, type: uniform buffer
-        VkDescriptorSetLayoutBinding uboBinding{};
-        uboBinding.binding                     = 0;
-        uboBinding.descriptorType              = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        uboBinding.descriptorCount             = 1;
-        uboBinding.stageFlags                  = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        uboBinding.pImmutableSamplers          = nullptr;
+        return m_depthPrepass != kInvalidRenderGraphHandle && m_depthPipelineHandles[0] != VK_NULL_HANDLE && m_depthPipelineHandles[1] != VK_NULL_HANDLE;
+    }
 
-        // descriptor set layout creation info
-        VkDescriptorSetLayoutCreateInfo descriptorSetlayoutInfo{};
-        descriptorSetlayoutInfo.sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        descriptorSetlayoutInfo.pNext          = nullptr;
-        descriptorSetlayoutInfo.flags          = 0;
-        descriptorSetlayoutInfo.bindingCount   = 1;
-        descriptorSetlayoutInfo.pBindings      = &uboBinding;
+    bool PBR::createUpscalePass(const VulkanDevice& device, RenderGraphHandle upscalePass, RenderGraphHandle sceneOutput) noexcept
+    {
+        UpscalePassShaders shaders{};
+        shaders.mVertexFile   = "pbr/fullscreen.vert.spv";
+        shaders.mFragmentFile = "pbr/upscale.frag.spv";
 
-        // create descriptor set layout for camera
-        if (!m_cameraDescriptorSetLayout.initialize(m_vkDevice, descriptorSetlayoutInfo))
+        auto pass = std::make_unique<UpscalePass>();
+        if (!pass->initialize(device, shaders, m_renderGraph->getRenderPass(upscalePass), m_renderGraph->getSubpassIndex(upscalePass), 
+                              m_swapchain->getExtent()))
         {
-            VK_LOG_ERROR("PBR::createDescriptorSetLayouts failed to create descriptor set layout for camera");
             return false;
         }
-        
-        // set: 2, binding: 0, type: uniform buffer
-        uboBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pass->bindSource(m_renderGraph->getImageView(sceneOutput));
+        m_upscalePass = std::move(pass);
+
+        // the timings lag by the frames in flight; target and scale range survive the rebuild, the scale restarts at the top
+        DynamicResolutionConfig config = m_dynamicResolution.getConfig();
+        config.mSettleFrames = m_maxFramesInFlight + 1;
+        m_dynamicResolution.initialize(config);
 
-        // create descriptor set layout for light
-        if (!m_lightDescriptorSetLayout.initialize(m_vkDevice, descriptorSetlayoutInfo))
+        VK_LOG_DEBUG("PBR::createUpscalePass successful (target: %.2f ms)", config.mTargetMs);
+        return true;
+    }
+
+    bool PBR::createPostProcess(const VulkanDevice& device, RenderGraphHandle sceneColor, RenderGraphHandle displayColor) noexcept
+    {
+        PostProcessShaders shaders{};
+        shaders.mBloomFile    = "pbr/bloom_downsample.comp.spv";
+        shaders.mToneMapFile  = "pbr/tonemap.comp.spv";
+        shaders.mExposureFile = "pbr/exposure.comp.spv";
+
+        // the exposure restarts from the metered one with each rebuild
+        auto postProcess = std::make_unique<PostProcess>();
+        if (!postProcess->initialize(device, shaders, m_swapchain->getExtent()))
         {
-            VK_LOG_ERROR("PBR::createDescriptorSetLayouts failed to create descriptor set layout for light");
             return false;
         }
+        // stereo: the window mirrors one eye's layer
+        const VkImageView sourceView = m_isStereo ? m_renderGraph->getLayerView(sceneColor, m_stereoMirrorEye) : m_renderGraph->getImageView(sceneColor);
+        postProcess->bindImages(sourceView, m_renderGraph->getImageView(displayColor));
+        m_postProcess = std::move(postProcess);
 
-        VK_LOG_DEBUG("PBR::createDescriptorSetLayouts successful");
+        VK_LOG_DEBUG("PBR::createPostProcess successful");
         return true;
     }
 
-    bool PBR::createDescriptorPool() noexcept
+    bool PBR::createTileLocalPost(const VulkanDevice& device, RenderGraphHandle swapchainImage, RenderGraphHandle sceneOutput,
+                                  RenderGraphHandle depthImage) noexcept
     {
-        // requirements for camera descriptor sets
-        DescriptorRequirements cameraRequirements{};
-        cameraRequirements.mMaxSets = m_maxFramesInFlight;
-        cameraRequirements.mUniformCount = 1;
+        // tonemap subpass: reads the resolved scene in place and writes the swapchain, the overlay blending over it. with
+        // no later reader the hdr target is a transient attachment that is never stored
+        RenderGraphPassDesc toneMapDesc{};
+        toneMapDesc.mName = "tonemap";
+
+        RenderGraphAttachment outputAttachment{};
+        outputAttachment.mImage  = swapchainImage;
+        outputAttachment.mLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        toneMapDesc.mColorAttachments.push_back(outputAttachment);
+        toneMapDesc.mInputAttachments.push_back(sceneOutput);
+
+        toneMapDesc.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+        {
+            if (m_postProcess)
+            {
+                m_postProcess->recordTileToneMap(commandBuffer, m_renderExtent, m_postProcessSettings);
+            }
+            if (m_isOverlayDrawn)
+            {
+                m_imguiLayer->recordDraws(commandBuffer);
+            }
+        };
+        m_tileToneMapPass = m_renderGraph->addPass(std::move(toneMapDesc));
 
-        // requirements for light descriptor sets
-        DescriptorRequirements lightRequirements{};
-        lightRequirements.mMaxSets = m_maxFramesInFlight;
-        lightRequirements.mUniformCount = 1;
+        // exposure: the histogram the fragments binned, reduced once the render pass ended; it synchronizes itself
+        RenderGraphPassDesc exposureDesc{};
+        exposureDesc.mName      = "exposure";
+        exposureDesc.mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+        exposureDesc.mRecord = [this](VkCommandBuffer commandBuffer, const RenderGraphPassContext&)
+        {
+            if (m_postProcess)
+            {
+                m_postProcess->recordExposure(commandBuffer, m_frameDt, m_postProcessSettings);
+            }
+        };
+        m_renderGraph->addPass(std::move(exposureDesc));
 
-        // add requirements
-        m_descriptorPool.addRequirements(cameraRequirements);
-        m_descriptorPool.addRequirements(lightRequirements);
-        m_descriptorPool.addRequirements(m_gltfModel.getDescriptorRequirements());
+        if (m_scenePass == kInvalidRenderGraphHandle || m_tileToneMapPass == kInvalidRenderGraphHandle ||
+            !m_renderGraph->compile(device, m_swapchain->getExtent()))
+        {
+            VK_LOG_ERROR("PBR::createTileLocalPost failed to compile render graph");
+            return false;
+        }
 
-        // create vulkan descriptor pool
-        if (!m_descriptorPool.initialize(m_vkDevice))
+        const VkFormat depthFormat = m_swapchain->getDepthFormat();
+        if (m_occlusionCulling && !m_occlusionCulling->bindDepth(m_renderGraph->getImage(depthImage), depthFormat, m_swapchain->getExtent()))
         {
-            VK_LOG_ERROR("PBR::createDescriptorPool failed");
+            VK_LOG_WARN("PBR::createTileLocalPost failed to bind scene depth for occlusion culling, using frustum culling only");
+            m_occlusionCulling.reset();
+        }
+
+        PostProcessShaders shaders{};
+        shaders.mBloomFile       = "pbr/bloom_downsample.comp.spv";
+        shaders.mToneMapFile     = "pbr/tonemap.comp.spv";
+        shaders.mExposureFile    = "pbr/exposure.comp.spv";
+        shaders.mTileVertexFile  = "pbr/fullscreen.vert.spv";
+        shaders.mTileToneMapFile = "pbr/tonemap_tile.frag.spv";
+
+        // the only pass writing the swapchain: no fallback once the graph is built
+        auto postProcess = std::make_unique<PostProcess>();
+        if (!postProcess->initialize(device, shaders, m_swapchain->getExtent()) ||
+            !postProcess->initializeTileToneMap(device, shaders, m_renderGraph->getRenderPass(m_tileToneMapPass),
+                                                m_renderGraph->getSubpassIndex(m_tileToneMapPass)))
+        {
+            VK_LOG_ERROR("PBR::createTileLocalPost failed to create the tile-local tonemap");
             return false;
         }
+        postProcess->bindTileSource(m_renderGraph->getImageView(sceneOutput));
+        m_postProcess = std::move(postProcess);
+        m_renderExtent = m_swapchain->getExtent();
 
-        VK_LOG_DEBUG("PBR::createDescriptorPool successful");
+        VK_LOG_DEBUG("PBR::createTileLocalPost successful (samples: %d, tonemap subpass: %u, transient memory: %llu bytes)", m_sampleCount,
+                     m_renderGraph->getSubpassIndex(m_tileToneMapPass), static_cast<unsigned long long>(m_renderGraph->getTransientMemorySize()));
         return true;
     }
 
-    bool PBR::createDescriptorSets() noexcept
+    void PBR::updateOverlayTarget() noexcept
     {
-        // create identical descriptor set layouts for each frame
-        std::vector<VkDescriptorSetLayout> layouts(m_maxFramesInFlight, m_cameraDescriptorSetLayout.get());
+        // the imgui pipeline is built for the subpass it draws in: the tonemap's, or one compatible with the upscale pass
+        if (!m_imguiLayer || (!m_isTileLocalPost && !m_isOverlayRetargeted))
+        {
+            return;
+        }
+
+        // blocking: frames in flight may still draw the overlay with the pipeline being replaced
+        vkDeviceWaitIdle(m_vkDevice);
+        if (m_isTileLocalPost)
+        {
+            m_imguiLayer->setTargetPass(m_renderGraph->getRenderPass(m_tileToneMapPass), m_renderGraph->getSubpassIndex(m_tileToneMapPass));
+        }
+        else
+        {
+            m_imguiLayer->setTargetPass(VK_NULL_HANDLE, 0);
+        }
+        m_isOverlayRetargeted = m_isTileLocalPost;
+    }
 
-        // descriptor set allocation info
-        VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
-        descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        descriptorSetAllocateInfo.pNext = nullptr;
-        descriptorSetAllocateInfo.descriptorPool = m_descriptorPool.get();
-        descriptorSetAllocateInfo.descriptorSetCount = m_maxFramesInFlight;
-        descriptorSetAllocateInfo.pSetLayouts = layouts.data();
+    bool PBR::createTemporalAA(const VulkanDevice& device) noexcept
+    {
+        TemporalAAShaders shaders{};
+        shaders.mResolveFile = "pbr/taa_resolve.comp.spv";
 
-        // allocate descriptor sets for camera
-        m_cameraDescriptorSets.resize(m_maxFramesInFlight);
-        VkResult vkResult = vkAllocateDescriptorSets(m_vkDevice, &descriptorSetAllocateInfo, m_cameraDescriptorSets.data());
-        if (vkResult != VK_SUCCESS)
+        // the history restarts with each rebuild; images are bound once the graph is compiled
+        auto temporalAA = std::make_unique<TemporalAA>();
+        if (!temporalAA->initialize(device, shaders, m_swapchain->getExtent()))
         {
-            VK_LOG_FATAL("vkAllocateDescriptorSets failed to allocate camera descriptor set : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_WARN("PBR::createTemporalAA failed to initialize temporal aa, using msaa");
             return false;
         }
+        m_temporalAA = std::move(temporalAA);
 
-        // set light descriptor set layout
-        std::fill(layouts.begin(), layouts.end(), m_lightDescriptorSetLayout.get());
+        VK_LOG_DEBUG("PBR::createTemporalAA successful");
+        return true;
+    }
 
-        // allocate descriptor sets for light
-        m_lightDescriptorSets.resize(m_maxFramesInFlight);
-        vkResult = vkAllocateDescriptorSets(m_vkDevice, &descriptorSetAllocateInfo, m_lightDescriptorSets.data());
-        if (vkResult != VK_SUCCESS)
+    bool PBR::createDeferredLighting(const VulkanDevice& device) noexcept
+    {
+        // the lighting pass traces its shadows when the scene's light set carries the acceleration structure
+        DeferredLightingShaders shaders{};
+        shaders.mLightingFile = m_isRayTracedShadows ? "pbr/deferred_lighting_rq.comp.spv" : "pbr/deferred_lighting.comp.spv";
+
+        // images are bound once the graph is compiled
+        auto deferredLighting = std::make_unique<DeferredLighting>();
+        if (!deferredLighting->initialize(device, shaders, m_swapchain->getExtent(), m_cameraDescriptorSetLayout, m_lightDescriptorSetLayout))
         {
-            VK_LOG_FATAL("vkAllocateDescriptorSets failed to allocate light descriptor set : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_WARN("PBR::createDeferredLighting failed to initialize deferred lighting, shading forward");
             return false;
         }
+        m_deferredLighting = std::move(deferredLighting);
 
-        // for each frame, bind its corresponding uniform buffer to the descriptor set
-        for (uint32_t i = 0; i < m_maxFramesInFlight; i++)
+        VK_LOG_DEBUG("PBR::createDeferredLighting successful");
+        return true;
+    }
+
+    bool PBR::createAmbientOcclusion(const VulkanDevice& device) noexcept
+    {
+        AmbientOcclusionShaders shaders{};
+        shaders.mDepthFile     = "pbr/ao_depth.comp.spv";
+        shaders.mOcclusionFile = "pbr/ao.comp.spv";
+
+        // the depth is bound once the graph is compiled
+        auto ambientOcclusion = std::make_unique<AmbientOcclusion>();
+        if (!ambientOcclusion->initialize(device, shaders, m_swapchain->getExtent()))
         {
-            VkWriteDescriptorSet uboWrite[2]{};
+            VK_LOG_WARN("PBR::createAmbientOcclusion failed to initialize ambient occlusion, lighting without it");
+            return false;
+        }
+        m_ambientOcclusion = std::move(ambientOcclusion);
 
-            // set: 0, binding: 0 (camera uniform)
-            VkDescriptorBufferInfo cameraBufferInfo{};
-            cameraBufferInfo.buffer   = m_cameraUniformBuffers[i].get();
-            cameraBufferInfo.offset   = 0;
-            cameraBufferInfo.range    = sizeof(ubo::Camera);
+        VK_LOG_DEBUG("PBR::createAmbientOcclusion successful");
+        return true;
+    }
 
-            uboWrite[0].sType                  = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            uboWrite[0].pNext                  = nullptr;
-            uboWrite[0].dstSet                 = m_cameraDescriptorSets[i];
-            uboWrite[0].dstBinding             = 0;
-            uboWrite[0].dstArrayElement        = 0;
-            uboWrite[0].descriptorCount        = 1;
-            uboWrite[0].descriptorType         = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            uboWrite[0].pImageInfo             = nullptr;
-            uboWrite[0].pBufferInfo            = &cameraBufferInfo;
-            uboWrite[0].pTexelBufferView       = nullptr;
-
-            // set: 2, binding: 0 (light uniform)
-            VkDescriptorBufferInfo lightBufferInfo{};
-            lightBufferInfo.buffer   = m_lightUniformBuffers[i].get();
-            lightBufferInfo.offset   = 0;
-            lightBufferInfo.range    = sizeof(ubo::Light);
-
-            uboWrite[1].sType                  = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            uboWrite[1].pNext                  = nullptr;
-            uboWrite[1].dstSet                 = m_lightDescriptorSets[i];
-            uboWrite[1].dstBinding             = 0;
-            uboWrite[1].dstArrayElement        = 0;
-            uboWrite[1].descriptorCount        = 1;
-            uboWrite[1].descriptorType         = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            uboWrite[1].pImageInfo             = nullptr;
-            uboWrite[1].pBufferInfo            = &lightBufferInfo;
-            uboWrite[1].pTexelBufferView       = nullptr;
-
-            // commit the binding to the descriptor set
-            vkUpdateDescriptorSets(m_vkDevice, 2, uboWrite, 0, nullptr);
-        }
-
-        // allocate and update descriptor sets for model
-        m_gltfModel.allocateDescriptorSets(m_descriptorPool.get());
-        m_gltfModel.updateDescriptorSets(m_samplers);
-        
-        VK_LOG_DEBUG("PBR::createDescriptorSets successful");
+    bool PBR::createFxaaPass(const VulkanDevice& device) noexcept
+    {
+        FxaaPassShaders shaders{};
+        shaders.mFxaaFile = "pbr/fxaa.comp.spv";
+
+        // images are bound once the graph is compiled
+        auto fxaaPass = std::make_unique<FxaaPass>();
+        if (!fxaaPass->initialize(device, shaders, m_swapchain->getExtent()))
+        {
+            VK_LOG_WARN("PBR::createFxaaPass failed to initialize fxaa, using msaa");
+            return false;
+        }
+        m_fxaaPass = std::move(fxaaPass);
+
+        VK_LOG_DEBUG("PBR::createFxaaPass successful");
         return true;
     }
 
-    bool PBR::createRenderPasses() noexcept
+    bool PBR::isDynamicResolutionActive() const noexcept
+    {
+        // without gpu timestamps there is no frame time to scale by
+        return m_upscalePass && m_isDynamicResolution && m_gpuProfiler.isValid();
+    }
+
+    void PBR::updateRenderExtent() noexcept
+    {
+        // the scale follows the gpu time of the most recently resolved frame; otherwise the scene renders at the swapchain extent
+        const VkExtent2D outputExtent = m_swapchain->getExtent();
+        VkExtent2D renderExtent = outputExtent;
+        if (isDynamicResolutionActive())
+        {
+            const auto& gpuResults = m_gpuProfiler.getResults();
+            if (!gpuResults.empty() && gpuResults.front().mDepth == 0)
+            {
+                m_dynamicResolution.update(gpuResults.front().mMilliseconds);
+            }
+            renderExtent = m_dynamicResolution.getRenderExtent(outputExtent);
+        }
+
+        // cached secondaries set the viewport they were recorded with
+        if (renderExtent.width != m_renderExtent.width || renderExtent.height != m_renderExtent.height)
+        {
+            m_renderExtent = renderExtent;
+            m_isSceneRecordStale.assign(m_maxFramesInFlight, true);
+        }
+
+        // the occlusion test maps clip space onto the region of the depth the viewport covers
+        if (m_occlusionCulling)
+        {
+            m_occlusionCulling->setViewportExtent(m_renderExtent);
+        }
+    }
+
+    void PBR::setSceneViewport(VkCommandBuffer commandBuffer) const noexcept
     {
-        // check if msaa is enabled
-        const bool msaaEnabled = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
+        // the top-left region of the scene targets; the upscale pass samples the same region
+        const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(m_renderExtent.width), static_cast<float>(m_renderExtent.height), 0.0f, 1.0f };
+        const VkRect2D scissor{ { 0, 0 }, m_renderExtent };
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    }
 
-        // color attachment: description, reference, subpass dependency
-        VkAttachmentDescription colorAttachment{};
-        colorAttachment.flags            = 0;
-        colorAttachment.format           = m_swapchain->getColorFormat();
-        colorAttachment.samples          = m_sampleCount;
-        colorAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        colorAttachment.storeOp          = msaaEnabled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
-        colorAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        colorAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        colorAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout      = msaaEnabled ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        VkAttachmentReference colorAttachmentRef{};
-        colorAttachmentRef.attachment    = 0;                                       
-        colorAttachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;   
-
-        // depth attachment: description, reference, subpass dependency
-        VkAttachmentDescription depthAttachment{};
-        depthAttachment.flags            = 0;
-        depthAttachment.format           = m_swapchain->getDepthFormat();
-        depthAttachment.samples          = m_sampleCount;                   
-        depthAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;            
-        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;             
-        depthAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;   
-        depthAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;  
-        depthAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;         
-        depthAttachment.finalLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;  
-
-        VkAttachmentReference depthAttachmentRef{};
-        depthAttachmentRef.attachment    = msaaEnabled ? 2 : 1;
-        depthAttachmentRef.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        // resolve attachment: description, reference (msaa only)
-        VkAttachmentDescription resolveAttachment{};
-        VkAttachmentReference resolveAttachmentRef{};
-        if (msaaEnabled)
-        {
-            resolveAttachment                = colorAttachment;
-            resolveAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
-            resolveAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-            resolveAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-            resolveAttachment.finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-            resolveAttachmentRef.attachment  = 1;                                       
-            resolveAttachmentRef.layout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL; 
-        }    
-
-        // subpass description 
-        VkSubpassDescription subpass{};
-        subpass.flags                    = 0;
-        subpass.pipelineBindPoint        = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.inputAttachmentCount     = 0;
-        subpass.pInputAttachments        = nullptr;
-        subpass.colorAttachmentCount     = 1;                                   
-        subpass.pColorAttachments        = &colorAttachmentRef;      
-        subpass.pResolveAttachments      = msaaEnabled ? &resolveAttachmentRef : nullptr;
-        subpass.pDepthStencilAttachment  = &depthAttachmentRef;
-        subpass.preserveAttachmentCount  = 0;
-        subpass.pPreserveAttachments     = nullptr;
-
-        // setup attachments, subpasses and dependencies
-        std::vector<VkAttachmentDescription> attachments { colorAttachment }; 
-        if (msaaEnabled) { attachments.emplace_back(resolveAttachment); }  
-        attachments.emplace_back(depthAttachment); 
-        
-        std::vector<VkSubpassDescription> subpasses { subpass };
+    bool PBR::createShadingRateImage(const VulkanDevice& device) noexcept
+    {
+        // not fatal: the low-detail materials keep their pipeline rate
+        ShadingRateImageShaders shaders{};
+        shaders.mGenerateFile = "pbr/shading_rate.comp.spv";
 
-        // setup render pass 
-        if (!m_renderPass.initialize(m_vkDevice, attachments, subpasses, {}))
+        auto shadingRateImage = std::make_unique<ShadingRateImage>();
+        if (!shadingRateImage->initialize(device, shaders, m_swapchain->getExtent()))
         {
-            VK_LOG_ERROR("PBR::createRenderPasses failed to initialize render pass");
+            VK_LOG_WARN("PBR::createShadingRateImage failed to create the shading rate image, using pipeline rates only");
+            m_shadingRateImage.reset();
             return false;
         }
+        m_shadingRateImage = std::move(shadingRateImage);
 
-        VK_LOG_DEBUG("PBR::createRenderPasses successful");
+        const VkExtent2D texelSize = m_shadingRateImage->getTexelSize();
+        VK_LOG_DEBUG("PBR::createShadingRateImage successful (texel: %ux%u)", texelSize.width, texelSize.height);
         return true;
     }
 
-    bool PBR::createGraphicsPipeline() noexcept
+    bool PBR::createFrameTimeline(const VulkanDevice& device) noexcept
     {
-        // retrieve shared vertex input layout
-        const auto bindings = GLTFModel::getBindings();
-        const auto attributes = GLTFModel::getAttributes();
-
-        // vertex input state
-        VkPipelineVertexInputStateCreateInfo vertexInputState{};
-        vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputState.pNext = nullptr;
-        vertexInputState.flags = 0;
-        vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(bindings.size());
-        vertexInputState.pVertexBindingDescriptions = bindings.data();
-        vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
-        vertexInputState.pVertexAttributeDescriptions = attributes.data();
-
-        // input assembly state: triangle list
-        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
-        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-        inputAssembly.pNext = nullptr;
-        inputAssembly.flags = 0;
-        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-        // viewport and scissor state
-        auto swapchainExtent = m_swapchain->getExtent();
-
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(swapchainExtent.width);
-        viewport.height = static_cast<float>(swapchainExtent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-
-        VkRect2D scissor{};
-        scissor.offset.x = 0;
-        scissor.offset.y = 0;
-        scissor.extent = swapchainExtent;
-
-        VkPipelineViewportStateCreateInfo viewportState{};
-        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-        viewportState.pNext = nullptr;
-        viewportState.flags = 0;
-        viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
-        viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
-
-        // rasterization state
-        VkPipelineRasterizationStateCreateInfo rasterizationState{};
-        rasterizationState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-        rasterizationState.pNext = nullptr;
-        rasterizationState.flags = 0;
-        rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
-        rasterizationState.cullMode = VK_CULL_MODE_NONE;
-        rasterizationState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-        rasterizationState.lineWidth = 1.0f;
-
-        // multisample state
-        VkPipelineMultisampleStateCreateInfo multisampleState{};
-        multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-        multisampleState.pNext = nullptr;
-        multisampleState.flags = 0;
-        multisampleState.rasterizationSamples = m_sampleCount;
-
-        // depth stencil state
-        VkPipelineDepthStencilStateCreateInfo depthStencilState{};
-        depthStencilState.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;                       
-        depthStencilState.pNext = NULL;                                                                            
-        depthStencilState.flags = 0;                                                                                
-        depthStencilState.depthTestEnable = VK_TRUE;                                                                
-        depthStencilState.depthWriteEnable = VK_TRUE;                                                               
-        depthStencilState.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;                                          
-        depthStencilState.depthBoundsTestEnable = VK_FALSE;
-        depthStencilState.back.failOp = VK_STENCIL_OP_KEEP;
-        depthStencilState.back.passOp = VK_STENCIL_OP_KEEP;
-        depthStencilState.back.compareOp = VK_COMPARE_OP_ALWAYS;
-        depthStencilState.stencilTestEnable = VK_FALSE;
-        depthStencilState.front = depthStencilState.back;
+        // not fatal: frames keep pacing on their in-flight fences
+        if (!device.isTimelineSemaphoreEnabled())
+        {
+            VK_LOG_INFO("PBR::createFrameTimeline timeline semaphores not available, using per-frame fences");
+            return true;
+        }
 
-        // color blend state
-        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_FALSE;
+        if (!m_frameTimeline.initialize(m_vkDevice, GLTFModel::kMaxFramesInFlight))
+        {
+            VK_LOG_WARN("PBR::createFrameTimeline failed, using per-frame fences");
+            return true;
+        }
 
-        VkPipelineColorBlendStateCreateInfo colorBlendState{};
-        colorBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-        colorBlendState.pNext = nullptr;
-        colorBlendState.flags = 0;
-        colorBlendState.attachmentCount = 1;
-        colorBlendState.pAttachments = &colorBlendAttachment;
+        VK_LOG_DEBUG("PBR::createFrameTimeline successful");
+        return true;
+    }
 
-        // configure the graphics pipeline
-        GraphicsPipelineConfig pipelineConfig{};
-        pipelineConfig.mFlags = 0;
-        pipelineConfig.mShaderStages.emplace_back(m_vertexShader.getShaderStageInfo());
-        pipelineConfig.mShaderStages.emplace_back(m_fragmentShader.getShaderStageInfo());
-        pipelineConfig.mVertexInputState = vertexInputState;
-        pipelineConfig.mInputAssemblyState = inputAssembly;
-        pipelineConfig.mViewportState = viewportState;
-        pipelineConfig.mRasterizationState = rasterizationState;
-        pipelineConfig.mMultisampleState = multisampleState;
-        pipelineConfig.mDepthStencilState = depthStencilState;
-        pipelineConfig.mColorBlendState = colorBlendState;
-        pipelineConfig.mRenderPass = m_renderPass.get();
-        pipelineConfig.mSubpassIndex = 0;
-        pipelineConfig.mDescriptorSetLayouts.emplace_back(m_cameraDescriptorSetLayout.get());
-        pipelineConfig.mDescriptorSetLayouts.emplace_back(GLTFModel::getDescriptorSetLayout());
-        pipelineConfig.mDescriptorSetLayouts.emplace_back(m_lightDescriptorSetLayout.get());
-        pipelineConfig.mPushConstantRanges.emplace_back(GLTFModel::getPushConstantRange());
+    bool PBR::createPresentWait(const VulkanDevice& device) noexcept
+    {
+        // offscreen frames are never presented: nothing to wait on
+        if (m_swapchain->isOffscreen())
+        {
+            return true;
+        }
 
-        // create graphics pipeline
-        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig))
+        // not fatal: the app keeps pacing frames on the cpu clock
+        if (!m_presentWait.initialize(device, 1))
         {
-            VK_LOG_ERROR("PBR::createGraphicsPipeline failed");
-            return false;
+            VK_LOG_INFO("PBR::createPresentWait present wait not available, using clock frame pacing");
+            return true;
         }
 
-        VK_LOG_DEBUG("PBR::createGraphicsPipeline successful");
+        m_usePresentPacing = true;
+        VK_LOG_DEBUG("PBR::createPresentWait successful");
         return true;
     }
 
-    bool PBR::createFramebuffers() noexcept
+    bool PBR::createLowLatency(const VulkanDevice& device) noexcept
     {
-        // allocate framebuffer for each swapchain image
-        m_framebuffers.resize(m_swapchainImageCount);
-
-        // get swapchain properties
-        const auto swapchainImageViews = m_swapchain->getColorImageViews();
-        const auto swapchainExtent     = m_swapchain->getExtent();
-        const auto msaaEnabled         = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
-
-        // prefetch attachments
-        VkImageView colorImageView   = VK_NULL_HANDLE;
-        VkImageView depthImageView  = VK_NULL_HANDLE;
-        if (msaaEnabled)
+        // offscreen frames are never presented: no frame start to schedule
+        if (m_swapchain->isOffscreen())
         {
-            colorImageView  = m_msaaTarget.getColorImageView();
-            depthImageView  = m_msaaTarget.getDepthImageView();
+            return true;
         }
-        else 
+
+        // not fatal: frames keep the present wait or clock pacing
+        if (!m_lowLatency.initialize(device))
         {
-            depthImageView  = m_swapchain->getDepthImageView();
+            VK_LOG_INFO("PBR::createLowLatency low latency not available");
+            return true;
         }
 
-        // framebuffer attachments: color, resolve, depth
-        VkImageView attachments[3]{ VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
-        
-        // framebuffer creation info
-        VkFramebufferCreateInfo framebufferCreateInfo{};
-        framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferCreateInfo.pNext = nullptr;
-        framebufferCreateInfo.flags = 0;
-        framebufferCreateInfo.renderPass = m_renderPass.get();
-        framebufferCreateInfo.pAttachments = attachments;
-        framebufferCreateInfo.width = swapchainExtent.width;
-        framebufferCreateInfo.height = swapchainExtent.height;
-        framebufferCreateInfo.layers = 1;
-
-        // create framebuffer per swapchain image view
-        for (uint32_t i = 0; i < m_swapchainImageCount; ++i)
+        if (!m_lowLatency.setSwapchain(m_swapchain->isLatencyModeEnabled() ? m_vkSwapchainKHR : VK_NULL_HANDLE))
         {
-            if (msaaEnabled)
-            {
-                // msaa enabled: [0] multisampled color, [1] swapchain resolve, [2] multisampled depth
-                framebufferCreateInfo.attachmentCount = 3;
-                attachments[0] = colorImageView;
-                attachments[1] = swapchainImageViews[i];
-                attachments[2] = depthImageView;
-            }
-            else 
-            {
-                // msaa disabled: [0] swapchain color, [1] swapchain depth
-                framebufferCreateInfo.attachmentCount = 2;
-                attachments[0] = swapchainImageViews[i];
-                attachments[1] = depthImageView;
-            }
-            
-            // initialize framebuffer 
-            if (!m_framebuffers[i].initialize(m_vkDevice, framebufferCreateInfo))
-            {
-                VK_LOG_ERROR("PBR::createFramebuffers failed at swapchain image index %u", i);
-                return false;
-            }
+            m_lowLatency.destroy();
+            return true;
         }
 
-        VK_LOG_DEBUG("PBR::createFramebuffers successful");
+        VK_LOG_DEBUG("PBR::createLowLatency successful (%s)", m_lowLatency.getModeName());
         return true;
     }
 
@@ -960,24 +3709,49 @@ namespace keplar
             }
         }
 
-        // image in flight fences to track which fence currently owns swapchain image
+        // image in flight fences (or timeline values) to track which submission currently owns swapchain image
         m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
+        m_imagesInFlightValues.assign(m_swapchainImageCount, 0);
+        m_isSceneRecordStale.assign(m_maxFramesInFlight, false);
+
+        // resources retired by resize are released per frame slot
+        if (!m_deletionQueue.initialize(m_maxFramesInFlight))
+        {
+            return false;
+        }
+
         VK_LOG_DEBUG("PBR::createSyncPrimitives successful");
         return true;
     }
 
     bool PBR::recordSceneCommandBuffers() noexcept
+    {
+        // record every frame's secondary up front; the cpu path re-records per frame once culling has a camera
+        for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
+        {
+            const uint32_t runCount = m_isGpuDriven ? 0 : m_gltfModel.prepareDraws(i, nullptr);
+            if (!recordSceneCommandBuffer(i, runCount))
+            {
+                return false;
+            }
+        }
+
+        VK_LOG_DEBUG("PBR::recordSceneCommandBuffers successful");
+        return true;
+    }
+
+    bool PBR::recordSceneCommandBuffer(uint32_t frameIndex, uint32_t runCount) noexcept
     {
         // secondary command buffer inherts render pass state from the primary
         VkCommandBufferInheritanceInfo inheritanceInfo{};
         inheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
         inheritanceInfo.pNext                = nullptr;
-        inheritanceInfo.renderPass           = m_renderPass.get();
-        inheritanceInfo.subpass              = 0;
+        inheritanceInfo.renderPass           = m_renderGraph->getRenderPass(m_scenePass);
+        inheritanceInfo.subpass              = m_renderGraph->getSubpassIndex(m_scenePass);
         inheritanceInfo.framebuffer          = VK_NULL_HANDLE;
         inheritanceInfo.occlusionQueryEnable = VK_FALSE;
         inheritanceInfo.queryFlags           = 0;
-        inheritanceInfo.pipelineStatistics   = 0;
+        inheritanceInfo.pipelineStatistics   = m_gpuProfiler.getInheritedStatistics();
 
         // secondary command buffer begin info
         VkCommandBufferBeginInfo beginInfo{};
@@ -986,84 +3760,339 @@ namespace keplar
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
         beginInfo.pInheritanceInfo = &inheritanceInfo;
 
-        for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
+        // gpu-driven draws are cached per partition of the model's batches
+        m_workerCommandCounts[frameIndex] = 0;
+        if (m_isGpuDriven)
+        {
+            return recordScenePartitions(frameIndex, beginInfo);
+        }
+
+        // cpu path with enough draws: workers record disjoint ranges of the sorted draw runs into their own secondaries
+        const uint32_t workerCount = std::min(m_recordWorkerCount, runCount / kMinRunsPerWorker);
+        if (workerCount > 1)
+        {
+            const uint32_t runsPerWorker = (runCount + workerCount - 1) / workerCount;
+            const VulkanCommandBuffer* workerCommandBuffers = &m_workerCommandBuffers[frameIndex * m_recordWorkerCount];
+            // the recording thread takes ranges no worker has started and returns once the last range is recorded
+            std::atomic<bool> isRecorded{ true };
+            std::array<CommandRecorderStats, kMaxRecordWorkers> workerStats{};
+            TaskGroup recordGroup(*m_recordThreadPool, TaskPriority::kFrameCritical);
+            recordGroup.parallelFor(workerCount, 1, [&](size_t worker)
+            {
+                const uint32_t firstRun = static_cast<uint32_t>(worker) * runsPerWorker;
+                const uint32_t workerRuns = std::min(runsPerWorker, runCount - std::min(runCount, firstRun));
+                if (!recordScenePass(workerCommandBuffers[worker], beginInfo, frameIndex, firstRun, workerRuns, workerStats[worker]))
+                {
+                    isRecorded.store(false, std::memory_order_relaxed);
+                }
+            });
+            recordGroup.wait();
+
+            m_sceneRecorderStats = {};
+            for (uint32_t worker = 0; worker < workerCount; ++worker)
+            {
+                m_sceneRecorderStats.mRecorded += workerStats[worker].mRecorded;
+                m_sceneRecorderStats.mElided   += workerStats[worker].mElided;
+                m_sceneRecorderStats.mBinds    += workerStats[worker].mBinds;
+                m_sceneRecorderStats.mDraws    += workerStats[worker].mDraws;
+            }
+
+            m_workerCommandCounts[frameIndex] = isRecorded.load(std::memory_order_relaxed) ? workerCount : 0;
+            return isRecorded.load(std::memory_order_relaxed);
+        }
+
+        // single secondary for the whole scene
+        return recordScenePass(m_secondaryCommandBuffer[frameIndex], beginInfo, frameIndex, 0, runCount, m_sceneRecorderStats);
+    }
+
+    bool PBR::recordScenePass(const VulkanCommandBuffer& commandBuffer, const VkCommandBufferBeginInfo& beginInfo, 
+                              uint32_t frameIndex, uint32_t firstRun, uint32_t runCount, CommandRecorderStats& recorderStats) noexcept
+    {
+        // reset and begin recording into secondary
+        if (!commandBuffer.reset() || !commandBuffer.begin(beginInfo))
+        {
+            return false;
+        }
+
+        // record graphics pipeline state, resource bindings, and draw commands for this frame
+        const VulkanPipeline& pipeline = m_isMeshShading ? m_meshletPipeline : (m_gltfModel.isInstancingEnabled() ? m_instancedPipeline : m_graphicsPipeline);
+        bindScenePassState(commandBuffer.get(), pipeline, frameIndex);
+
+        // the per-run binds go through a recorder that drops the redundant ones
+        VulkanCommandRecorder recorder(commandBuffer);
+        if (m_isMeshShading)
+        {
+            m_gltfModel.recordMeshletDraws(recorder, pipeline.getLayout(), frameIndex, firstRun, runCount, 
+                                           m_permutationHandles.empty() ? nullptr : m_permutationHandles.data());
+        }
+        else
+        {
+            m_gltfModel.recordDraws(recorder, pipeline.getLayout(), frameIndex, firstRun, runCount, 
+                                    m_permutationHandles.empty() ? nullptr : m_permutationHandles.data());
+        }
+        recorderStats = recorder.getStats();
+
+        // finalize the command buffer
+        return commandBuffer.end();
+    }
+
+    void PBR::recordLateScenePass(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept
+    {
+        // recorded inline: the draws that passed the late occlusion test, with the scene pass bindings
+        const VulkanPipeline& pipeline = m_indirectPipeline;
+        bindScenePassState(commandBuffer, pipeline, frameIndex);
+        m_gltfModel.renderIndirect(commandBuffer, pipeline.getLayout(), frameIndex, m_useDrawIndirectCount, true);
+    }
+
+    bool PBR::recordScenePartitions(uint32_t frameIndex, const VkCommandBufferBeginInfo& beginInfo) noexcept
+    {
+        // a load changes the partition count: the slot's secondaries are replaced, they are not in flight here
+        const uint32_t partitionCount = m_gltfModel.getIndirectPartitionCount();
+        std::vector<VulkanCommandBuffer>& commandBuffers = m_partitionCommandBuffers[frameIndex];
+        std::vector<uint64_t>& recordRevisions = m_partitionRecordRevisions[frameIndex];
+        if (commandBuffers.size() != partitionCount)
+        {
+            m_commandPool.deallocate(commandBuffers);
+            recordRevisions.clear();
+            if (partitionCount > 0)
+            {
+                commandBuffers = m_commandPool.allocateSecondaries(partitionCount);
+                if (commandBuffers.size() != partitionCount)
+                {
+                    VK_LOG_ERROR("PBR::recordScenePartitions failed to allocate %u partition command buffers.", partitionCount);
+                    commandBuffers.clear();
+                    return false;
+                }
+            }
+            recordRevisions.assign(partitionCount, 0);
+        }
+
+        // new pipelines or render pass state invalidate every partition, otherwise only those whose revision moved
+        const bool isStale = m_isSceneRecordStale[frameIndex];
+        for (uint32_t partition = 0; partition < partitionCount; ++partition)
+        {
+            const uint64_t revision = m_gltfModel.getIndirectPartitionRevision(partition);
+            if (!isStale && recordRevisions[partition] == revision)
+            {
+                continue;
+            }
+
+            // secondaries inherit no state, every partition binds the whole scene pass state
+            const VulkanCommandBuffer& commandBuffer = commandBuffers[partition];
+            if (!commandBuffer.reset() || !commandBuffer.begin(beginInfo))
+            {
+                return false;
+            }
+
+            bindScenePassState(commandBuffer.get(), m_indirectPipeline, frameIndex);
+            m_gltfModel.renderIndirectPartition(commandBuffer.get(), m_indirectPipeline.getLayout(), frameIndex, m_useDrawIndirectCount, partition);
+            if (!commandBuffer.end())
+            {
+                return false;
+            }
+
+            recordRevisions[partition] = revision;
+            ++m_partitionRecordCount;
+        }
+        return true;
+    }
+
+    bool PBR::hasStaleScenePartitions(uint32_t frameIndex) const noexcept
+    {
+        const uint32_t partitionCount = m_gltfModel.getIndirectPartitionCount();
+        const std::vector<uint64_t>& recordRevisions = m_partitionRecordRevisions[frameIndex];
+        if (recordRevisions.size() != partitionCount)
+        {
+            return true;
+        }
+
+        for (uint32_t partition = 0; partition < partitionCount; ++partition)
+        {
+            if (recordRevisions[partition] != m_gltfModel.getIndirectPartitionRevision(partition))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PBR::bindScenePassState(VkCommandBuffer commandBuffer, const VulkanPipeline& pipeline, uint32_t frameIndex) const noexcept
+    {
+        // pipeline, viewport, camera (set: 0) and lights (set: 2); materials are bound by the model's draws
+        const std::array<uint32_t, 2>& uniformOffsets = m_uniformOffsets[frameIndex];
+        pipeline.bind(commandBuffer);
+        setSceneViewport(commandBuffer);
+        bindCameraSet(commandBuffer, pipeline.getLayout(), frameIndex);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getLayout(), 2, 1, &m_lightDescriptorSets[frameIndex], 1, &uniformOffsets[1]);
+    }
+
+    void PBR::recordDepthPrepass(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept
+    {
+        // recorded inline: the runs prepareFrame gathered for the scene pass, through the position stream
+        const VkPipelineLayout pipelineLayout = m_depthPipelines[0].getLayout();
+        setSceneViewport(commandBuffer);
+        bindCameraSet(commandBuffer, pipelineLayout, frameIndex);
+
+        const float minPixels = m_depthPrepassMode == DepthPrepassMode::kOccluders ? m_occluderPixels : 0.0f;
+        VulkanCommandRecorder recorder(commandBuffer);
+        m_gltfModel.recordDepthDraws(recorder, pipelineLayout, frameIndex, 0, m_preparedRunCount, minPixels, m_depthPipelineHandles);
+        m_depthRecorderStats = recorder.getStats();
+    }
+
+    void PBR::bindCameraSet(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, VkPipelineBindPoint bindPoint) const noexcept
+    {
+        // set: 0, the frame's camera block in the uniform arena
+        const uint32_t cameraOffset = m_uniformOffsets[frameIndex][0];
+        if (!m_isCameraPushed)
+        {
+            vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, 0, 1, &m_cameraDescriptorSet, 1, &cameraOffset);
+            return;
+        }
+
+        const VkDescriptorBufferInfo cameraBufferInfo = { m_uniformArena.getBuffer(), cameraOffset, sizeof(ubo::Camera) };
+        VkWriteDescriptorSet cameraWrite{};
+        cameraWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        cameraWrite.dstBinding      = 0;
+        cameraWrite.descriptorCount = 1;
+        cameraWrite.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        cameraWrite.pBufferInfo     = &cameraBufferInfo;
+        VulkanCommandBuffer::pushDescriptorSet(commandBuffer, bindPoint, pipelineLayout, 0, 1, &cameraWrite);
+    }
+
+    bool PBR::recordFrameCommandBuffer(uint32_t frameIndex) noexcept
+    {
+        // begin primary recording
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = 0;
+
+        // begin recording; the buffer comes from a freshly reset pool, so no per-buffer reset
+        auto& commandBuffer = m_primaryCommandBuffers[frameIndex];
+        if (!commandBuffer.isValid() || !commandBuffer.begin(beginInfo))
+        {
+            return false;
+        }
+
+        // resolve the slot's previous timestamps and reset its queries before any scope; the frame scope ends in the
+        // present command buffer
+        m_gpuProfiler.beginFrame(commandBuffer.get(), frameIndex);
+        m_frameProfileScope = m_gpuProfiler.beginScope(commandBuffer.get(), "frame");
+        {
+
+            // morph and skin this frame's vertices before any draw reads them
+            if (m_gpuSkinning.isValid())
+            {
+                KEPLAR_GPU_ZONE(m_gpuProfiler, commandBuffer.get(), "skinning");
+                m_gpuSkinning.record(commandBuffer.get(), frameIndex, m_gltfModel.getSkinnedVertexCount(), m_gltfModel.getActiveMorphTargetCount() > 0);
+            }
+
+            // cull draws against this frame's camera before the render pass consumes them
+            if (m_isGpuDriven)
+            {
+                KEPLAR_GPU_ZONE(m_gpuProfiler, commandBuffer.get(), "culling");
+                const glm::mat4& viewProjection = m_cullingMatrices[frameIndex];
+                if (m_occlusionCulling)
+                {
+                    // early phase: last frame's visible set, the rest is tested after the scene pass wrote depth
+                    m_occlusionCulling->recordEarly(commandBuffer.get(), viewProjection, m_gltfModel.getDrawCount(),
+                                                    m_gltfModel.getDrawBatchCount(), m_useDrawIndirectCount);
+                }
+                else
+                {
+                    m_gpuCulling.record(commandBuffer.get(), Frustum::fromMatrix(viewProjection), m_gltfModel.getDrawCount(), m_useDrawIndirectCount);
+                }
+            }
+
+            // bin this frame's lights into clusters before the fragments read them
+            if (m_lightClusters.isValid() && !m_isStereo)
+            {
+                KEPLAR_GPU_ZONE(m_gpuProfiler, commandBuffer.get(), "light clusters");
+                m_lightClusters.record(commandBuffer.get(), frameIndex, m_cameraUniforms[frameIndex].view, m_lightUniforms[frameIndex].frustum);
+            }
+
+            // re-render the shadow views that went stale (or refit the traced top level) before the scene samples them
+            if (m_isShadowsEnabled && m_isRayTracedShadows)
+            {
+                KEPLAR_GPU_ZONE(m_gpuProfiler, commandBuffer.get(), "shadows");
+                m_rayTracedShadows.record(commandBuffer.get(), frameIndex);
+            }
+            else if (m_isShadowsEnabled)
+            {
+                KEPLAR_GPU_ZONE(m_gpuProfiler, commandBuffer.get(), "shadows");
+                m_shadowMaps.record(commandBuffer.get(), frameIndex, m_gltfModel);
+            }
+
+            // the rate image enters the graph in its attachment layout, at full rate until a frame was measured
+            if (m_shadingRateImage)
+            {
+                m_shadingRateImage->recordPrepare(commandBuffer.get());
+            }
+
+            // graph passes ahead of the swapchain, which own their render passes, attachments and barriers (timed per pass)
+            m_renderGraph->execute(commandBuffer.get(), 0, frameIndex, 0, m_renderGraph->getFirstImportPass());
+
+            // the culling passes' visible draw counts, once both phases wrote them
+            if (m_isGpuDriven && m_useDrawIndirectCount && m_statsReadback.isValid())
+            {
+                recordCullingReadback(commandBuffer);
+            }
+        }
+
+        // finalize the command buffer
+        return commandBuffer.end();
+    }
+
+    void PBR::recordCullingReadback(const VulkanCommandBuffer& commandBuffer) noexcept
+    {
+        // per-batch counts, the late phase's after the early phase's; the next frame's clear waits on this copy
+        const uint32_t batchCount = m_gltfModel.getDrawBatchCount();
+        const VkDeviceSize countBytes = (m_occlusionCulling ? 2u : 1u) * static_cast<VkDeviceSize>(batchCount) * sizeof(uint32_t);
+        if (countBytes == 0 || countBytes > m_statsReadback.getFrameCapacity())
         {
-            // reset and begin recording into secondary
-            if (!m_secondaryCommandBuffer[i].reset() || !m_secondaryCommandBuffer[i].begin(beginInfo))
-            {
-                return false;
-            }
+            return;
+        }
 
-            // record graphics pipeline state, resource bindings, and draw commands for this frame
-            m_secondaryCommandBuffer[i].bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.get());
-            m_secondaryCommandBuffer[i].bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.getLayout(), 0, 1, &m_cameraDescriptorSets[i]);
-            m_secondaryCommandBuffer[i].bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.getLayout(), 2, 1, &m_lightDescriptorSets[i]);
-            m_gltfModel.render(m_secondaryCommandBuffer[i].get(), m_graphicsPipeline.getLayout());
+        VulkanBarrierBatch barrierBatch;
+        barrierBatch.memoryBarrier(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+        commandBuffer.pipelineBarrier(barrierBatch);
 
-            // finalize the command buffer
-            if (!m_secondaryCommandBuffer[i].end())
+        const uint32_t drawCount = m_gltfModel.getDrawCount();
+        m_statsReadback.readBuffer(commandBuffer, m_gltfModel.getDrawCountBuffer(), 0, countBytes, [this, drawCount](const void* data, VkDeviceSize size)
+        {
+            uint32_t drawnCount = 0;
+            for (VkDeviceSize offset = 0; offset + sizeof(uint32_t) <= size; offset += sizeof(uint32_t))
             {
-                return false;
+                uint32_t batchDrawn = 0;
+                std::memcpy(&batchDrawn, static_cast<const uint8_t*>(data) + offset, sizeof(uint32_t));
+                drawnCount += batchDrawn;
             }
-        }
-
-        VK_LOG_DEBUG("PBR::recordSceneCommandBuffers successful");
-        return true;
+            m_cullingDrawnCount  = std::min(drawnCount, drawCount);
+            m_cullingTestedCount = drawCount;
+        });
+        m_statsReadback.recordHostBarrier(commandBuffer);
     }
 
-    bool PBR::recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept
+    bool PBR::recordPresentCommandBuffer(uint32_t frameIndex, uint32_t imageIndex, bool isImageAcquired) noexcept
     {
-        // begin primary recording
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         beginInfo.pNext = nullptr;
         beginInfo.flags = 0;
 
-        // reset and then begin recording into the command buffer
-        auto& commandBuffer = m_primaryCommandBuffers[frameIndex];
-        if (!commandBuffer.reset() || !commandBuffer.begin(beginInfo))
+        auto& commandBuffer = m_presentCommandBuffers[frameIndex];
+        if (!commandBuffer.isValid() || !commandBuffer.begin(beginInfo))
         {
             return false;
         }
 
-        // check if msaa is enabled
-        const bool msaaEnabled = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
-
-        // clear values for render pass; color: 0, depth-stencil: 1
-        VkClearValue clearValues[3]{};
-        if (msaaEnabled)
-        {
-            clearValues[0].color        = { 0.0f, 0.0f, 0.0f, 1.0f };
-            clearValues[1].color        = { 0.0f, 0.0f, 0.0f, 1.0f };
-            clearValues[2].depthStencil = { 1.0f, 0 };
-        }
-        else 
+        // the remaining graph passes write the acquired image; without one only the frame scope is closed
+        if (isImageAcquired)
         {
-            clearValues[0].color        = { 0.0f, 0.0f, 0.0f, 1.0f };
-            clearValues[1].depthStencil = { 1.0f, 0 };
+            m_renderGraph->execute(commandBuffer.get(), imageIndex, frameIndex, m_renderGraph->getFirstImportPass(), m_renderGraph->getPhysicalPassCount());
         }
+        m_gpuProfiler.endScope(commandBuffer.get(), m_frameProfileScope);
 
-        // render pass begin info (framebuffer updated per command buffer)
-        VkRenderPassBeginInfo renderPassBeginInfo{};
-        renderPassBeginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassBeginInfo.pNext             = nullptr;
-        renderPassBeginInfo.framebuffer       = m_framebuffers[imageIndex].get();
-        renderPassBeginInfo.renderPass        = m_renderPass.get();
-        renderPassBeginInfo.renderArea.offset = {0, 0};
-        renderPassBeginInfo.renderArea.extent = m_swapchain->getExtent();
-        renderPassBeginInfo.clearValueCount   = msaaEnabled ? 3 : 2;
-        renderPassBeginInfo.pClearValues      = clearValues;
-        
-        // begin render pass for this frame
-        commandBuffer.beginRenderPass(renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
-
-        // execute the cached secondary command buffer
-        commandBuffer.executeCommands(m_secondaryCommandBuffer[frameIndex]);
-
-        // end current render pass
-        commandBuffer.endRenderPass();
-
-        // finalize the command buffer
         return commandBuffer.end();
     }
 
@@ -1072,20 +4101,25 @@ namespace keplar
         auto platform = m_platform.lock();
         auto context = m_context.lock();
 
-        // setup imgui layer
-        m_imguiLayer = std::make_unique<ImGuiLayer>(*m_swapchain);
-        m_imguiLayer->initialize(*platform, *context, m_maxFramesInFlight);
-        platform->enableImGuiEvents(true);
-
-        // register imgui widget
-        m_imguiLayer->registerWidget([this]()
+        // setup imgui layer; offscreen rendering has no window to draw the overlay into or take input from
+        if (!m_swapchain->isOffscreen())
         {
-            updateUserInterface();
-        });
+            m_imguiLayer = std::make_unique<ImGuiLayer>(*m_swapchain);
+            m_imguiLayer->initialize(*platform, *context, m_maxFramesInFlight);
+            platform->enableImGuiEvents(true);
+            updateOverlayTarget();
+
+            // register imgui widget
+            m_imguiLayer->registerWidget([this](FrameArena& frameArena)
+            {
+                updateUserInterface(frameArena);
+            });
+        }
 
         // calculate aspect ratio of window and initialize camera
         const float aspectRatio = float(m_windowWidth) / float(m_windowHeight);
         m_camera = std::make_shared<Camera>(Camera::Mode::Turntable, 45.0f, aspectRatio, 0.1f, 100.0f);
+        m_camera->setReverseDepth(true);
 
         // register listeners with the platform
         platform->addListener(m_camera);
@@ -1105,34 +4139,163 @@ namespace keplar
         // setup camera uniform data
         ubo::Camera& camera = m_cameraUniforms[frameIndex];
         camera.model      = glm::mat4(1.0f);
-        camera.view       = m_camera->getViewMatrix();
+        camera.view       = m_camera->getInterpolatedViewMatrix(m_interpolationAlpha);
         camera.projection = m_camera->getProjectionMatrix();
-        camera.position   = glm::vec4(m_camera->getPosition(), 1.0f);
+        camera.position   = glm::vec4(m_camera->getInterpolatedPosition(m_interpolationAlpha), 1.0f);
+
+        // temporal aa: the scene renders through this frame's sub-pixel jitter, the history reprojects without it
+        if (m_temporalAA)
+        {
+            const glm::mat4 viewProjection = camera.projection * camera.view;
+            m_camera->setJitter(m_temporalAA->getJitter(m_renderExtent));
+            camera.projection = m_camera->getJitteredProjectionMatrix();
+            m_temporalAA->prepare(viewProjection, camera.projection * camera.view, m_renderExtent);
+        }
+
+        // per-view matrices of the scene passes: the eyes sit half the interpupillary distance either side of the center.
+        // culling runs once for both, against a frustum pulled back until it encloses the two eye frustums
+        const uint32_t viewCount = m_isStereo ? ubo::kMaxViews : 1;
+        for (uint32_t view = 0; view < viewCount; ++view)
+        {
+            const float eyeOffset = m_isStereo ? (view == 0 ? -0.5f : 0.5f) * m_interpupillaryDistance : 0.0f;
+            const glm::mat4 eyeView = Camera::getEyeViewMatrix(camera.view, eyeOffset);
+            camera.viewProjections[view] = camera.projection * eyeView;
+            camera.viewPositions[view]   = glm::vec4(glm::vec3(glm::inverse(eyeView)[3]), 1.0f);
+        }
+        m_cullingMatrices[frameIndex] = (m_isStereo ? m_camera->getStereoCullingMatrix(camera.view, m_interpupillaryDistance) 
+                                                    : camera.projection * camera.view) * camera.model;
+
+        // the frame's previous blocks are no longer read: rewind its arena region and write the camera block
+        if (!m_uniformArena.beginFrame(frameIndex) || !m_uniformArena.push(camera, m_uniformOffsets[frameIndex][0]))
+        {
+            VK_LOG_ERROR_THROTTLED("PBR::updatePerFrame : uniform arena push failed for camera: %d", frameIndex);
+            return false;
+        }
+
+        // joint matrices and morph weights consumed by this frame's skinning pass
+        if (!m_gltfModel.uploadJointMatrices(frameIndex))
+        {
+            VK_LOG_ERROR_THROTTLED("PBR::updatePerFrame : uploadJointMatrices() failed: %d", frameIndex);
+            return false;
+        }
 
-        // upload to camera uniform buffer
-        if (!m_cameraUniformBuffers[frameIndex].uploadHostVisible(&camera, sizeof(camera)))
+        if (!m_gltfModel.uploadMorphWeights(frameIndex))
         {
-            VK_LOG_ERROR("PBR::updatePerFrame : uploadHostVisible() failed for camera: %d", frameIndex);
+            VK_LOG_ERROR_THROTTLED("PBR::updatePerFrame : uploadMorphWeights() failed: %d", frameIndex);
             return false;
         }
 
-        // setup light uniform data
+        // main light first, its range ending at the cutoff radiance, followed by the generated scene lights
+        FrameArena::Scope arenaScope(FrameArena::getThreadArena());
+        ArenaVector<LightClusters::PointLight> lights;
+        lights.reserve(1 + m_pointLights.size());
+        lights.push_back({ glm::vec4(glm::vec3(m_lightPosition), std::sqrt(m_lightIntensity / kLightCutoff)), glm::vec4(m_lightColor, m_lightIntensity) });
+        lights.insert(lights.end(), m_pointLights.begin(), m_pointLights.end());
+        const uint32_t lightCount = m_lightClusters.uploadLights(frameIndex, lights.data(), static_cast<uint32_t>(lights.size()));
+
+        // setup light uniform data: cluster grid and the camera it is binned against (tiles span the scene viewport)
+        const float tanHalfFov = std::tan(glm::radians(m_camera->getFov()) * 0.5f);
+        const bool isClustered = m_lightClusters.isValid() && !m_isStereo;    // the clusters are binned in one view's tiles
         ubo::Light& light = m_lightUniforms[frameIndex];
-        light.position[0] = m_lightPosition;
-        light.color[0]    = glm::vec4(m_lightColor, m_lightIntensity);
-        light.count       = glm::ivec4(1, 0, 0, 0);
+        light.grid    = glm::uvec4(isClustered ? LightClusters::kGridX : 0, LightClusters::kGridY, LightClusters::kGridZ, lightCount);
+        light.slices  = glm::vec4(LightClusters::getSliceParams(m_camera->getNearClip(), m_camera->getFarClip()),
+                                  float(m_renderExtent.width) / float(LightClusters::kGridX), float(m_renderExtent.height) / float(LightClusters::kGridY));
+        light.frustum = glm::vec4(tanHalfFov * m_camera->getAspectRatio(), tanHalfFov, m_camera->getNearClip(), m_camera->getFarClip());
+        light.environment = glm::vec4(float(EnvironmentLighting::kPrefilteredMipLevels - 1), 
+                                      m_environmentLighting.isValid() ? m_environmentIntensity : 0.0f, 0.0f, 0.0f);
+
+        // sun and main light shadows: only the views gone stale since the last frame gather their casters
+        const glm::vec3 sunDirection = glm::length(m_sunDirection) > 0.0f ? glm::normalize(m_sunDirection) : glm::vec3(0.0f, 1.0f, 0.0f);
+        light.sunDirection = glm::vec4(sunDirection, 0.0f);
+        light.sunColor     = glm::vec4(m_sunColor, m_sunIntensity);
+
+        ShadowMaps::ShadingParams shadowParams{};
+        if (m_isShadowsEnabled && m_isRayTracedShadows)
+        {
+            // rays replace every map: the shaders only read whether shadows are on
+            m_rayTracedShadows.prepare(frameIndex, m_gltfModel, camera.model);
+            shadowParams.mParams = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+        }
+        else if (m_isShadowsEnabled)
+        {
+            ShadowFrameDesc shadowDesc{};
+            shadowDesc.mView           = camera.view;
+            shadowDesc.mProjection     = m_camera->getProjectionMatrix();
+            shadowDesc.mNear           = m_camera->getNearClip();
+            shadowDesc.mFar            = m_camera->getFarClip();
+            shadowDesc.mLightDirection = m_sunIntensity > 0.0f ? -sunDirection : glm::vec3(0.0f);
+            shadowDesc.mPointLight     = m_lightIntensity > 0.0f ? lights.front().mPositionRadius : glm::vec4(0.0f);
+            shadowDesc.mCasterBounds   = m_gltfModel.getBounds().transformed(camera.model);
+            shadowDesc.mCastersMoved   = m_gltfModel.hasAnimations();
+
+            const uint32_t gatherMask = m_shadowMaps.prepare(frameIndex, shadowDesc);
+            for (uint32_t view = 0; view < ShadowMaps::kViewCount; ++view)
+            {
+                if (gatherMask & (1u << view))
+                {
+                    m_gltfModel.gatherShadowCasters(m_shadowMaps.getViewFrustum(view), camera.model, m_shadowMaps.getCasters(frameIndex, view));
+                }
+            }
+            shadowParams = m_shadowMaps.getShadingParams(frameIndex);
+        }
+
+        // the main light is the first one uploaded, so its shadow index is 1 whenever the cube is in use
+        std::copy(shadowParams.mCascadeMatrices.begin(), shadowParams.mCascadeMatrices.end(), light.cascades);
+        light.cascadeSplits = shadowParams.mCascadeSplits;
+        light.cascadeTexels = shadowParams.mCascadeTexels;
+        light.pointShadow   = shadowParams.mPointLight;
+        light.shadowParams  = shadowParams.mParams;
 
-        // upload to light uniform buffer
-        if (!m_lightUniformBuffers[frameIndex].uploadHostVisible(&light, sizeof(light)))
+        // write the light block after the camera block
+        if (!m_uniformArena.push(light, m_uniformOffsets[frameIndex][1]))
         {
-            VK_LOG_ERROR("PBR::updatePerFrame : uploadHostVisible() failed for light: %d", frameIndex);
+            VK_LOG_ERROR_THROTTLED("PBR::updatePerFrame : uniform arena push failed for light: %d", frameIndex);
             return false;
         }
 
         return true;
     }
 
-    void PBR::updateUserInterface() noexcept
+    void PBR::updateTextureStreaming(uint32_t frameIndex) noexcept
+    {
+        KEPLAR_PROFILE_FUNCTION();
+        auto device = m_device.lock();
+        if (!device)
+        {
+            return;
+        }
+
+        // the camera in model space, and the pixels a unit spans at unit distance
+        const ubo::Camera& camera = m_cameraUniforms[frameIndex];
+        const glm::vec3 viewPosition = glm::vec3(glm::inverse(camera.view * camera.model)[3]);
+        const float projectionScale = 0.5f * static_cast<float>(m_swapchain->getExtent().height) * glm::abs(camera.projection[1][1]);
+        // swapped sets move the revisions of the partitions binding them (the cpu path re-records every frame)
+        if (m_gltfModel.updateTextureStreaming(*device, m_stagingBelt, viewPosition, projectionScale))
+        {
+            requestRedraw();
+        }
+    }
+
+    void PBR::generatePointLights() noexcept
+    {
+        // fixed seed: the same count always yields the same scene
+        std::mt19937 generator(1234u);
+        std::uniform_real_distribution<float> position(-kPointLightSpread, kPointLightSpread);
+        std::uniform_real_distribution<float> radius(kPointLightMinRadius, kPointLightMaxRadius);
+        std::uniform_real_distribution<float> hue(0.0f, 1.0f);
+
+        m_pointLights.resize(static_cast<size_t>(m_pointLightCount));
+        for (auto& pointLight : m_pointLights)
+        {
+            // intensity follows the range, so every light is as bright at the same fraction of its range
+            const float range = radius(generator);
+            const glm::vec3 color = glm::clamp(glm::abs(glm::fract(hue(generator) + glm::vec3(1.0f, 2.0f / 3.0f, 1.0f / 3.0f)) * 6.0f - 3.0f) - 1.0f, 0.0f, 1.0f);
+            pointLight.mPositionRadius = glm::vec4(position(generator), position(generator) * 0.5f, position(generator), range);
+            pointLight.mColorIntensity = glm::vec4(color, kPointLightRadiance * range * range);
+        }
+    }
+
+    void PBR::updateUserInterface(FrameArena& frameArena) noexcept
     {
         constexpr float kLabelColWidth = 160.0f;
 
@@ -1180,6 +4343,798 @@ namespace keplar
             return ImGui::ColorEdit3(id, rgb, ImGuiColorEditFlags_Float);
         };
 
+        // ───────────────────────── Frame Pacing ─────────────────────
+        if (ImGui::TreeNodeEx("Frame Pacing", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##FramePacingTable", kLabelColWidth))
+            {
+                static constexpr const char* kPresentPolicyNames[] = 
+                { 
+                    "Balanced (mailbox)", "Low Latency (mailbox/immediate)", "V-Sync (fifo)", "Power Saving (fifo relaxed)" 
+                };
+
+                int presentPolicy = static_cast<int>(m_swapchainPolicy.mPresentPolicy);
+                RowLabel("Present Policy");
+                if (ImGui::Combo("##PresentPolicy", &presentPolicy, kPresentPolicyNames, IM_ARRAYSIZE(kPresentPolicyNames)))
+                {
+                    m_swapchainPolicy.mPresentPolicy = static_cast<PresentPolicy>(presentPolicy);
+                    applySwapchainPolicy();
+                }
+
+                RowLabel("Present Mode");
+                ImGui::Text("%s%s", string_VkPresentModeKHR(m_swapchain->getPresentMode()), m_swapchain->canSwitchPresentMode() ? " (in place switch)" : "");
+
+                // F11 borderless, alt+enter exclusive (win32)
+                RowLabel("Fullscreen");
+                ImGui::TextUnformatted(m_swapchain->isFullScreenExclusive() ? "exclusive" :
+                                       (m_swapchainPolicy.mFullScreenExclusive ? "exclusive requested (composited)" : "off / borderless"));
+
+                int imageCount = static_cast<int>(m_swapchainPolicy.mImageCount);
+                RowLabel("Image Count (0: auto)");
+                if (ImGui::SliderInt("##ImageCount", &imageCount, 0, 8))
+                {
+                    m_swapchainPolicy.mImageCount = static_cast<uint32_t>(imageCount);
+                    applySwapchainPolicy();
+                }
+
+                int framesInFlight = static_cast<int>(m_requestedFramesInFlight);
+                RowLabel("Frames in Flight");
+                if (ImGui::SliderInt("##FramesInFlight", &framesInFlight, 1, static_cast<int>(m_maxFramesInFlight)))
+                    m_requestedFramesInFlight = static_cast<uint32_t>(framesInFlight);
+
+                if (m_presentWait.isValid())
+                {
+                    RowLabel("Present Synced");
+                    ImGui::Checkbox("##PresentSynced", &m_usePresentPacing);
+
+                    int maxQueuedFrames = static_cast<int>(m_presentWait.getMaxQueuedFrames());
+                    RowLabel("Max Queued Frames");
+                    if (ImGui::SliderInt("##MaxQueuedFrames", &maxQueuedFrames, 1, static_cast<int>(m_maxFramesInFlight)))
+                        m_presentWait.setMaxQueuedFrames(static_cast<uint32_t>(maxQueuedFrames));
+
+                    RowLabel("Input to Present");
+                    ImGui::Text("%.2f ms (avg %.2f ms)", m_presentWait.getLatencyMs(), m_presentWait.getAverageLatencyMs());
+                }
+                else
+                {
+                    RowLabel("Present Synced");
+                    ImGui::TextUnformatted("unsupported (clock pacing)");
+                }
+
+                RowLabel("Low Latency");
+                if (m_lowLatency.isValid())
+                {
+                    bool isLowLatency = m_lowLatency.isEnabled();
+                    if (ImGui::Checkbox("##LowLatency", &isLowLatency))
+                        m_lowLatency.setEnabled(isLowLatency);
+                    ImGui::SameLine();
+                    ImGui::TextUnformatted(m_lowLatency.getModeName());
+
+                    if (m_lowLatency.isLatencySleep())
+                    {
+                        bool isBoost = m_lowLatency.isBoost();
+                        RowLabel("Low Latency Boost");
+                        if (ImGui::Checkbox("##LowLatencyBoost", &isBoost))
+                            m_lowLatency.setBoost(isBoost);
+                    }
+                }
+                else
+                {
+                    ImGui::TextUnformatted("unsupported");
+                }
+
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Frame Metrics ────────────────────
+        if (ImGui::TreeNodeEx("Frame Metrics", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            // percentiles are only sorted out while the panel is open
+            m_frameMetrics.update();
+
+            if (BeginTwoColTable("##FrameMetricsTable", kLabelColWidth))
+            {
+                RowLabel("Hitches (total)");
+                ImGui::Text("%llu (> %.0fx rolling avg)", static_cast<unsigned long long>(m_frameMetrics.getTotalHitchCount()), FrameMetrics::kHitchFactor);
+                ImGui::EndTable();
+            }
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(FrameMetric::kCount); ++i)
+            {
+                const auto metric = static_cast<FrameMetric>(i);
+                const FrameMetricStats& stats = m_frameMetrics.getStats(metric);
+                if (stats.mSampleCount == 0)
+                {
+                    continue;
+                }
+
+                SectionHeader(FrameMetrics::getName(metric));
+                ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", stats.mP50, stats.mP95, stats.mP99, stats.mMax);
+                ImGui::Text("avg %.2f ms  hitches %u / %u frames", stats.mAverage, stats.mHitchCount, stats.mSampleCount);
+
+                // rolling history scaled to the p99 so single spikes stay visible without flattening the rest
+                const char* overlay = frameArena.format("%.2f ms", stats.mLatest);
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::PlotHistogram("##History", m_frameMetrics.getHistory(metric), static_cast<int>(m_frameMetrics.getHistoryCount(metric)),
+                                     static_cast<int>(m_frameMetrics.getHistoryOffset(metric)), overlay, 0.0f, stats.mP99 * 1.5f, ImVec2(-1.0f, 60.0f));
+                ImGui::PopID();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── GPU Timings ──────────────────────
+        if (ImGui::TreeNodeEx("GPU Timings", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (!m_gpuProfiler.isValid())
+            {
+                ImGui::TextUnformatted("timestamps not supported");
+            }
+            else if (BeginTwoColTable("##GpuTimingsTable", kLabelColWidth))
+            {
+                for (const auto& result : m_gpuProfiler.getResults())
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::Text("%*s%s", static_cast<int>(result.mDepth * 2), "", result.mName.c_str());
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::Text("%.3f ms (avg %.3f ms)", result.mMilliseconds, result.mAverageMilliseconds);
+                }
+
+                ImGui::EndTable();
+            }
+
+            if (m_gpuProfiler.isValid() && ImGui::Button("Export CSV"))
+            {
+                m_gpuProfiler.exportCsv(keplar::config::kCacheDir / "gpu_profile.csv");
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Frame Statistics ─────────────────
+        if (ImGui::TreeNodeEx("Frame Statistics", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##FrameCountersTable", kLabelColWidth))
+            {
+                // cpu side: what the last frame recorded, cached secondaries count only when re-recorded
+                RowLabel("Recorded");
+                ImGui::Text("%u draws, %u binds, %u barriers", m_frameCommandCounts.mDraws, m_frameCommandCounts.mBinds, m_frameCommandCounts.mBarriers);
+                if (m_isGpuDriven)
+                {
+                    RowLabel("GPU Culling");
+                    if (!m_useDrawIndirectCount || !m_statsReadback.isValid())
+                    {
+                        ImGui::TextUnformatted("needs compacted draws");
+                    }
+                    else
+                    {
+                        ImGui::Text("%u drawn, %u culled", m_cullingDrawnCount, m_cullingTestedCount - m_cullingDrawnCount);
+                    }
+                }
+                ImGui::EndTable();
+            }
+
+            // gpu side: per render graph pass, in millions
+            constexpr double kMillions = 1e-6;
+            if (!m_gpuProfiler.isStatisticsEnabled())
+            {
+                ImGui::TextUnformatted("pipeline statistics not supported");
+            }
+            else if (BeginTwoColTable("##PipelineStatisticsTable", kLabelColWidth))
+            {
+                for (const auto& result : m_gpuProfiler.getResults())
+                {
+                    if (!result.mHasStatistics)
+                    {
+                        continue;
+                    }
+
+                    const GpuPipelineStatistics& statistics = result.mStatistics;
+                    RowLabel(result.mName.c_str());
+                    if (statistics.mComputeInvocations != 0 && statistics.mVertexInvocations == 0)
+                    {
+                        ImGui::Text("%.2fM cs", static_cast<double>(statistics.mComputeInvocations) * kMillions);
+                    }
+                    else
+                    {
+                        ImGui::Text("%.2fM vs, %.2fM/%.2fM prims clipped, %.2fM fs", static_cast<double>(statistics.mVertexInvocations) * kMillions,
+                                    static_cast<double>(statistics.mClippingPrimitives) * kMillions, static_cast<double>(statistics.mClippingInvocations) * kMillions,
+                                    static_cast<double>(statistics.mFragmentInvocations) * kMillions);
+                    }
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Memory ───────────────────────────
+        if (ImGui::TreeNodeEx("Memory", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            constexpr double kMiB = 1024.0 * 1024.0;
+            auto device = m_device.lock();
+            if (!device)
+            {
+                ImGui::TextUnformatted("device unavailable");
+            }
+            else
+            {
+                // free lists are only walked while the panel is open
+                const VulkanMemoryAllocator& memoryAllocator = device->getMemoryAllocator();
+                const VulkanMemoryStats memoryStats = memoryAllocator.getStats();
+                std::array<MemoryBudget, VK_MAX_MEMORY_HEAPS> heapBudgets{};
+                const uint32_t heapCount = device->queryMemoryHeapBudgets(heapBudgets);
+
+                if (BeginTwoColTable("##MemoryTable", kLabelColWidth))
+                {
+                    RowLabel("Blocks");
+                    ImGui::Text("%u (%.1f MiB)", memoryStats.mBlockCount, memoryStats.mBlockBytes / kMiB);
+                    RowLabel("Allocations");
+                    ImGui::Text("%u (%.1f MiB)", memoryStats.mAllocationCount, memoryStats.mAllocatedBytes / kMiB);
+                    RowLabel("Free");
+                    ImGui::Text("%.1f MiB in %u regions", memoryStats.mFreeBytes / kMiB, memoryStats.mFreeRegionCount);
+                    RowLabel("Fragmentation");
+                    ImGui::Text("%.1f%% (largest %.1f MiB)", memoryStats.getFragmentation() * 100.0f, memoryStats.mLargestFreeRegion / kMiB);
+
+                    if (const TextureStreamer* textureStreamer = m_gltfModel.getTextureStreamer())
+                    {
+                        RowLabel("Streamed Textures");
+                        ImGui::Text("%u (%.1f MiB, %u pending)", textureStreamer->getStreamedTextureCount(),
+                                    textureStreamer->getResidentBytes() / kMiB, textureStreamer->getPendingUploadCount());
+                        if (textureStreamer->getSparseTextureCount() > 0)
+                        {
+                            RowLabel("Sparse Pages");
+                            ImGui::Text("%u textures, %.1f MiB", textureStreamer->getSparseTextureCount(), textureStreamer->getPageCacheBytes() / kMiB);
+                        }
+                    }
+
+                    if (m_geometryArena.isValid())
+                    {
+                        RowLabel("Geometry Arena");
+                        ImGui::Text("%u / %u vertices, %u / %u indices", m_geometryArena.getUsedVertexCount(), m_geometryArena.getVertexCapacity(),
+                                    m_geometryArena.getUsedIndexCount(), m_geometryArena.getIndexCapacity());
+                    }
+
+                    // peak over every frame so far: this frame's labels are still being formatted
+                    RowLabel("UI Scratch");
+                    ImGui::Text("%.1f / %.0f KiB%s", frameArena.getPeakUsage() / 1024.0, frameArena.getCapacity() / 1024.0,
+                                frameArena.getFailedCount() > 0 ? " (overflowed)" : "");
+
+                    // KEPLAR_TRACK_ALLOCATIONS builds: the last sampled frame
+                    if constexpr (AllocationTracker::isEnabled())
+                    {
+                        const AllocationSample allocations = AllocationTracker::getLastSample();
+                        RowLabel("Heap / Frame");
+                        ImGui::Text("%llu allocs, %.1f KiB (frame threads %llu)", static_cast<unsigned long long>(allocations.mAllocations),
+                                    allocations.mBytes / 1024.0, static_cast<unsigned long long>(allocations.mFrameThreadAllocations));
+                        RowLabel("Vulkan Host / Frame");
+                        ImGui::Text("%llu allocs", static_cast<unsigned long long>(allocations.mVulkanAllocations));
+                    }
+                    ImGui::EndTable();
+                }
+
+                SectionHeader("Categories");
+                if (BeginTwoColTable("##MemoryCategoryTable", kLabelColWidth))
+                {
+                    for (size_t category = 0; category < memoryStats.mCategories.size(); ++category)
+                    {
+                        const VulkanMemoryCategoryStats& categoryStats = memoryStats.mCategories[category];
+                        RowLabel(getMemoryCategoryName(static_cast<VulkanMemoryCategory>(category)));
+                        ImGui::Text("%.1f MiB (peak %.1f, %u allocs)", categoryStats.mAllocatedBytes / kMiB, categoryStats.mPeakBytes / kMiB,
+                                    categoryStats.mAllocationCount);
+                    }
+                    ImGui::EndTable();
+                }
+
+                SectionHeader(device->isMemoryBudgetEnabled() ? "Heaps (VK_EXT_memory_budget)" : "Heaps (allocator estimate)");
+                const VkPhysicalDeviceMemoryProperties& memoryProperties = device->getPhysicalDeviceMemoryProperties();
+                for (uint32_t heap = 0; heap < heapCount; ++heap)
+                {
+                    const MemoryBudget& heapBudget = heapBudgets[heap];
+                    const bool isDeviceLocal = (memoryProperties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+                    const float usage = heapBudget.mBudget > 0 ? static_cast<float>(static_cast<double>(heapBudget.mUsage) / heapBudget.mBudget) : 0.0f;
+
+                    const char* overlay = frameArena.format("%.0f / %.0f MiB", heapBudget.mUsage / kMiB, heapBudget.mBudget / kMiB);
+                    ImGui::Text("heap %u%s", heap, isDeviceLocal ? " (device local)" : "");
+                    ImGui::ProgressBar(std::min(usage, 1.0f), ImVec2(-1.0f, 0.0f), overlay);
+                }
+            }
+
+            if (device && ImGui::Button("Dump JSON"))
+            {
+                device->getMemoryAllocator().writeStatsJson(keplar::config::kCacheDir / "memory_stats.json", device->queryMemoryHeapBudgets());
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Level of Detail ──────────────────
+        if (ImGui::TreeNodeEx("Level of Detail", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (!m_gltfModel.hasLods())
+            {
+                ImGui::TextUnformatted("model has no simplified levels");
+            }
+            else if (BeginTwoColTable("##LodTable", kLabelColWidth))
+            {
+                float pixelError = m_gltfModel.getLodPixelError();
+                if (RowSlider("Pixel Error", "##LodPixelError", &pixelError, 0.0f, 8.0f))
+                {
+                    m_gltfModel.setLodPixelError(pixelError);
+                }
+
+                RowLabel("Triangles");
+                if (m_isGpuDriven)
+                {
+                    ImGui::TextUnformatted("full detail (gpu-driven draws)");
+                }
+                else if (m_isMeshShading)
+                {
+                    ImGui::Text("full detail (%u meshlets)", m_gltfModel.getMeshletCount());
+                }
+                else
+                {
+                    ImGui::Text("%llu / %llu", static_cast<unsigned long long>(m_gltfModel.getDrawnTriangleCount()),
+                                static_cast<unsigned long long>(m_gltfModel.getFullDetailTriangleCount()));
+                }
+
+                RowLabel("LOD Indices");
+                ImGui::Text("%u", m_gltfModel.getLodIndexCount());
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Vertex Pulling ───────────────────
+        if (ImGui::TreeNodeEx("Vertex Pulling", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (!m_isGpuDriven || !m_pulledVertexShader.isValid())
+            {
+                ImGui::TextUnformatted(m_isGpuDriven ? "needs buffer device address" : "gpu-driven path only");
+            }
+            else if (BeginTwoColTable("##VertexPullingTable", kLabelColWidth))
+            {
+                // the indirect pipeline is rebuilt without vertex bindings, through the deferred resize path
+                RowLabel("Enabled");
+                if (ImGui::Checkbox("##VertexPulling", &m_requestedVertexPulling) && !m_isResizePending)
+                {
+                    onWindowResize(m_windowWidth, m_windowHeight);
+                }
+
+                RowLabel("Status");
+                ImGui::TextUnformatted(m_isVertexPulling ? "vertices fetched by address" : "vertex bindings");
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Command Recording ────────────────
+        if (ImGui::TreeNodeEx("Command Recording", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (m_isGpuDriven && BeginTwoColTable("##CommandRecordingTable", kLabelColWidth))
+            {
+                // cached partition secondaries, recorded again only when their contents changed
+                RowLabel("Scene Partitions");
+                ImGui::Text("%u (%u recorded last frame)", m_gltfModel.getIndirectPartitionCount(), m_partitionRecordCount);
+                ImGui::EndTable();
+            }
+            else if (!m_isGpuDriven && BeginTwoColTable("##CommandRecordingTable", kLabelColWidth))
+            {
+                // state commands the pass recorders passed on and dropped as rebinding what was bound
+                RowLabel("Scene Pass");
+                ImGui::Text("%u recorded, %u elided", m_sceneRecorderStats.mRecorded, m_sceneRecorderStats.mElided);
+                if (isDepthPrepassActive())
+                {
+                    RowLabel("Depth Pre-pass");
+                    ImGui::Text("%u recorded, %u elided", m_depthRecorderStats.mRecorded, m_depthRecorderStats.mElided);
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Depth Pre-pass ───────────────────
+        if (ImGui::TreeNodeEx("Depth Pre-pass", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##DepthPrepassTable", kLabelColWidth))
+            {
+                static constexpr const char* kDepthPrepassModeNames[] = { "Off", "Large Occluders", "Full (main pass EQUAL)" };
+
+                // the pass and its pipelines are rebuilt with the render graph, through the deferred resize path
+                int depthPrepassMode = static_cast<int>(m_requestedDepthPrepassMode);
+                RowLabel("Mode");
+                if (ImGui::Combo("##DepthPrepassMode", &depthPrepassMode, kDepthPrepassModeNames, IM_ARRAYSIZE(kDepthPrepassModeNames)))
+                {
+                    m_requestedDepthPrepassMode = static_cast<DepthPrepassMode>(depthPrepassMode);
+                    if (!m_isResizePending)
+                    {
+                        onWindowResize(m_windowWidth, m_windowHeight);
+                    }
+                }
+
+                if (m_requestedDepthPrepassMode == DepthPrepassMode::kOccluders)
+                {
+                    RowSlider("Occluder Size (px)", "##OccluderPixels", &m_occluderPixels, 0.0f, 512.0f);
+                }
+
+                RowLabel("Status");
+                if (isDepthPrepassActive())
+                {
+                    ImGui::TextUnformatted("active");
+                }
+                else if (m_depthPrepassMode == DepthPrepassMode::kOff)
+                {
+                    ImGui::TextUnformatted("off");
+                }
+                else
+                {
+                    ImGui::TextUnformatted(m_isGpuDriven || m_isMeshShading || m_isBindless ? "cpu path only" : "unavailable");
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Dynamic Resolution ───────────────
+        if (ImGui::TreeNodeEx("Dynamic Resolution", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (!m_gpuProfiler.isValid())
+            {
+                ImGui::TextUnformatted("needs gpu timestamps");
+            }
+            else if (BeginTwoColTable("##DynamicResolutionTable", kLabelColWidth))
+            {
+                // the offscreen target and the upscale pass are rebuilt with the render graph, through the deferred resize path
+                RowLabel("Enabled");
+                if (ImGui::Checkbox("##DynamicResolution", &m_requestedDynamicResolution) && !m_isResizePending)
+                {
+                    onWindowResize(m_windowWidth, m_windowHeight);
+                }
+
+                const DynamicResolutionConfig& config = m_dynamicResolution.getConfig();
+                float targetMs = config.mTargetMs;
+                if (RowSlider("GPU Target (ms)", "##DynamicResolutionTarget", &targetMs, 4.0f, 50.0f))
+                {
+                    m_dynamicResolution.setTargetMs(targetMs);
+                }
+
+                float minScale = config.mMinScale;
+                float maxScale = config.mMaxScale;
+                const bool isMinChanged = RowSlider("Min Scale", "##DynamicResolutionMin", &minScale, 0.25f, 1.0f);
+                const bool isMaxChanged = RowSlider("Max Scale", "##DynamicResolutionMax", &maxScale, 0.25f, 1.0f);
+                if (isMinChanged || isMaxChanged)
+                {
+                    m_dynamicResolution.setScaleRange(minScale, std::max(minScale, maxScale));
+                }
+
+                RowSlider("Sharpness", "##UpscaleSharpness", &m_upscaleSharpness, 0.0f, 1.0f);
+
+                RowLabel("Render Extent");
+                if (isDynamicResolutionActive())
+                {
+                    ImGui::Text("%ux%u (%.0f%%)", m_renderExtent.width, m_renderExtent.height, 100.0f * m_dynamicResolution.getScale());
+                }
+                else
+                {
+                    ImGui::TextUnformatted(m_isDynamicResolution ? "unavailable" : "native");
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Stereo ───────────────────────────
+        if (ImGui::TreeNodeEx("Stereo", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##StereoTable", kLabelColWidth))
+            {
+                static constexpr const char* kEyeNames[] = { "Left", "Right" };
+
+                // the layered targets and the multiview render pass are rebuilt with the render graph, through the
+                // deferred resize path, and so is the post process reading the mirrored eye
+                RowLabel("Enabled");
+                if (ImGui::Checkbox("##Stereo", &m_requestedStereo) && !m_isResizePending)
+                {
+                    onWindowResize(m_windowWidth, m_windowHeight);
+                }
+
+                int mirrorEye = static_cast<int>(m_stereoMirrorEye);
+                RowLabel("Mirror Eye");
+                if (ImGui::Combo("##StereoMirrorEye", &mirrorEye, kEyeNames, IM_ARRAYSIZE(kEyeNames)))
+                {
+                    m_stereoMirrorEye = static_cast<uint32_t>(mirrorEye);
+                    if (m_isStereo && !m_isResizePending)
+                    {
+                        onWindowResize(m_windowWidth, m_windowHeight);
+                    }
+                }
+
+                float ipdMillimeters = m_interpupillaryDistance * 1000.0f;
+                if (RowSlider("IPD (mm)", "##StereoIpd", &ipdMillimeters, 0.0f, 80.0f))
+                {
+                    m_interpupillaryDistance = ipdMillimeters * 0.001f;
+                }
+
+                RowLabel("Status");
+                if (m_isStereo)
+                {
+                    ImGui::TextUnformatted("active (multiview)");
+                }
+                else
+                {
+                    ImGui::TextUnformatted(!m_requestedStereo ? "off" : (m_isMeshShading ? "not with mesh shading" : "unavailable"));
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Tile-Local Post ───────────────────────────
+        if (ImGui::TreeNodeEx("Tile-Local Post", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##TileLocalPostTable", kLabelColWidth))
+            {
+                // the tonemap subpass and the overlay pipeline built for it are rebuilt with the render graph, through the
+                // deferred resize path
+                RowLabel("Enabled");
+                if (ImGui::Checkbox("##TileLocalPost", &m_requestedTileLocalPost) && !m_isResizePending)
+                {
+                    onWindowResize(m_windowWidth, m_windowHeight);
+                }
+
+                RowLabel("Status");
+                if (m_isTileLocalPost)
+                {
+                    ImGui::Text("active (subpass %u, no bloom)", m_renderGraph->getSubpassIndex(m_tileToneMapPass));
+                }
+                else if (!m_requestedTileLocalPost)
+                {
+                    ImGui::TextUnformatted("off");
+                }
+                else
+                {
+                    ImGui::TextUnformatted(m_antiAliasingMode != AntiAliasingMode::kMsaa ? "needs msaa"
+                                         : (m_isDynamicResolution || m_isStereo) ? "needs one view at native resolution"
+                                         : m_isDeferred ? "needs forward shading" : "unavailable");
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Shading Path ──────────────────────
+        if (ImGui::TreeNodeEx("Shading Path", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##ShadingPathTable", kLabelColWidth))
+            {
+                // the g-buffer targets, the lighting pass and the scene pipelines writing them are rebuilt with the render
+                // graph, through the deferred resize path
+                RowLabel("Deferred");
+                if (ImGui::Checkbox("##Deferred", &m_requestedDeferred) && !m_isResizePending)
+                {
+                    onWindowResize(m_windowWidth, m_windowHeight);
+                }
+
+                RowLabel("Status");
+                if (m_isDeferred)
+                {
+                    ImGui::TextUnformatted("deferred (g-buffer +8 B/px, blending cut out, no msaa)");
+                }
+                else if (!m_requestedDeferred)
+                {
+                    ImGui::TextUnformatted("forward+");
+                }
+                else
+                {
+                    ImGui::TextUnformatted(m_isStereo ? "forward+, deferred needs one view" : "forward+, deferred unavailable");
+                }
+
+                // screen-space occlusion of the deferred path, applied from the next frame
+                if (m_isDeferred)
+                {
+                    RowLabel("Ambient Occlusion");
+                    ImGui::Checkbox("##AmbientOcclusion", &m_isAmbientOcclusion);
+                    RowSlider("AO Radius", "##AORadius", &m_ambientOcclusionSettings.mRadius, 0.05f, 4.0f);
+                    RowSlider("AO Intensity", "##AOIntensity", &m_ambientOcclusionSettings.mIntensity, 0.25f, 4.0f);
+
+                    RowLabel("AO Status");
+                    if (m_ambientOcclusion)
+                    {
+                        const VkExtent2D extent = m_ambientOcclusion->getExtent();
+                        ImGui::Text("%s, traced at %ux%u", m_isAmbientOcclusion ? "on" : "off", extent.width, extent.height);
+                    }
+                    else
+                    {
+                        ImGui::TextUnformatted("unavailable");
+                    }
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Variable Rate Shading ────────────
+        if (ImGui::TreeNodeEx("Variable Rate Shading", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            auto device = m_device.lock();
+            if (!device || !device->isFragmentShadingRateEnabled())
+            {
+                ImGui::TextUnformatted("unsupported");
+            }
+            else if (BeginTwoColTable("##ShadingRateTable", kLabelColWidth))
+            {
+                static constexpr const char* kShadingRateModeNames[] = { "Off", "Low-Detail Materials", "Adaptive (luminance)" };
+
+                // pipelines and the rate image are rebuilt with the render graph, through the deferred resize path
+                int shadingRateMode = static_cast<int>(m_requestedShadingRateMode);
+                RowLabel("Mode");
+                if (ImGui::Combo("##ShadingRateMode", &shadingRateMode, kShadingRateModeNames, IM_ARRAYSIZE(kShadingRateModeNames)))
+                {
+                    m_requestedShadingRateMode = static_cast<ShadingRateMode>(shadingRateMode);
+                    if (!m_isResizePending)
+                    {
+                        onWindowResize(m_windowWidth, m_windowHeight);
+                    }
+                }
+
+                if (m_requestedShadingRateMode == ShadingRateMode::kAdaptive)
+                {
+                    RowSlider("Threshold", "##ShadingRateThreshold", &m_shadingRateThreshold, 0.0f, 0.5f);
+                }
+
+                RowLabel("Rate Image");
+                if (m_shadingRateImage)
+                {
+                    const VkExtent2D extent = m_shadingRateImage->getExtent();
+                    const VkExtent2D texelSize = m_shadingRateImage->getTexelSize();
+                    ImGui::Text("%ux%u (%ux%u px texels)", extent.width, extent.height, texelSize.width, texelSize.height);
+                }
+                else
+                {
+                    ImGui::TextUnformatted(device->isShadingRateAttachmentEnabled() ? "off" : "unsupported");
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Anti-Aliasing ────────────────────
+        if (ImGui::TreeNodeEx("Anti-Aliasing", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##AntiAliasingTable", kLabelColWidth))
+            {
+                static constexpr const char* kAntiAliasingModeNames[] = { "MSAA", "Temporal", "FXAA" };
+
+                // the render graph is rebuilt with or without multisampled targets, through the deferred resize path
+                int antiAliasingMode = static_cast<int>(m_requestedAntiAliasingMode);
+                RowLabel("Mode");
+                if (ImGui::Combo("##AntiAliasingMode", &antiAliasingMode, kAntiAliasingModeNames, IM_ARRAYSIZE(kAntiAliasingModeNames)))
+                {
+                    m_requestedAntiAliasingMode = static_cast<AntiAliasingMode>(antiAliasingMode);
+                    if (!m_isResizePending)
+                    {
+                        onWindowResize(m_windowWidth, m_windowHeight);
+                    }
+                }
+
+                // msaa levels the device supports for both color and depth; the targets, render passes and scene
+                // pipelines are rebuilt against the new count while frames in flight finish on the retired ones
+                auto device = m_device.lock();
+                if (device && m_requestedAntiAliasingMode == AntiAliasingMode::kMsaa)
+                {
+                    static constexpr VkSampleCountFlagBits kSampleCounts[] = { VK_SAMPLE_COUNT_1_BIT, VK_SAMPLE_COUNT_2_BIT, VK_SAMPLE_COUNT_4_BIT, VK_SAMPLE_COUNT_8_BIT };
+                    static constexpr const char* kSampleCountNames[] = { "Off", "2x", "4x", "8x" };
+
+                    // the label shows the count the graph runs with; the request may exceed what the device supports
+                    const VkSampleCountFlags supportedCounts = MsaaTarget::getSupportedSampleCounts(device->getPhysicalDeviceProperties());
+                    const char* activeName = kSampleCountNames[0];
+                    for (uint32_t i = 0; i < IM_ARRAYSIZE(kSampleCounts); ++i)
+                    {
+                        activeName = (m_antiAliasingMode == AntiAliasingMode::kMsaa && m_sampleCount == kSampleCounts[i]) ? kSampleCountNames[i] : activeName;
+                    }
+
+                    RowLabel("Samples");
+                    if (ImGui::BeginCombo("##MsaaSamples", activeName))
+                    {
+                        for (uint32_t i = 0; i < IM_ARRAYSIZE(kSampleCounts); ++i)
+                        {
+                            if ((supportedCounts & kSampleCounts[i]) == 0)
+                            {
+                                continue;
+                            }
+
+                            const bool isSelected = activeName == kSampleCountNames[i];
+                            if (ImGui::Selectable(kSampleCountNames[i], isSelected) && !isSelected)
+                            {
+                                m_requestedSampleCount = kSampleCounts[i];
+                                if (!m_isResizePending)
+                                {
+                                    onWindowResize(m_windowWidth, m_windowHeight);
+                                }
+                            }
+                        }
+                        ImGui::EndCombo();
+                    }
+                }
+
+                RowLabel("Status");
+                if (m_temporalAA)
+                {
+                    ImGui::Text("temporal, jitter phase %u / %u", m_temporalAA->getJitterPhase() + 1, TemporalAA::kJitterPhaseCount);
+                }
+                else if (m_fxaaPass)
+                {
+                    ImGui::TextUnformatted("fxaa (single sample)");
+                }
+                else
+                {
+                    ImGui::Text("%ux msaa", static_cast<uint32_t>(m_sampleCount));
+                }
+
+                if (m_fxaaPass)
+                {
+                    RowSlider("Subpixel", "##FxaaSubpixel", &m_fxaaSettings.mSubpixelQuality, 0.0f, 1.0f);
+                    RowSlider("Edge Threshold", "##FxaaEdgeThreshold", &m_fxaaSettings.mEdgeThreshold, 0.063f, 0.333f);
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Half Precision ───────────────────
+        if (ImGui::TreeNodeEx("Half Precision", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (!m_halfFragmentShader.isValid())
+            {
+                ImGui::TextUnformatted("needs shaderFloat16");
+            }
+            else if (BeginTwoColTable("##HalfPrecisionTable", kLabelColWidth))
+            {
+                // the scene pipelines are rebuilt with the other fragment shader, through the deferred resize path
+                RowLabel("Enabled");
+                if (ImGui::Checkbox("##HalfPrecision", &m_requestedHalfPrecision) && !m_isResizePending)
+                {
+                    onWindowResize(m_windowWidth, m_windowHeight);
+                }
+
+                RowLabel("Status");
+                ImGui::TextUnformatted(m_isBindless ? "bindless shading (fp32)" : (m_isHalfPrecision ? "fp16 material terms" : "fp32"));
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
         // ───────────────────────── Lighting ─────────────────────────
         if (ImGui::TreeNodeEx("Lighting", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
         {
@@ -1188,6 +5143,69 @@ namespace keplar
                 RowDragFloat3("Position", "##LightPos", &m_lightPosition.x, 0.1f);
                 RowColor3("Color", "##LightColor", &m_lightColor.r);
                 RowSlider("Intensity", "##LightIntensity", &m_lightIntensity, 0.0f, 1000.0f);
+
+                RowLabel("Point Lights");
+                if (ImGui::SliderInt("##PointLights", &m_pointLightCount, 0, static_cast<int>(LightClusters::kMaxLights - 1)))
+                {
+                    generatePointLights();
+                }
+
+                if (m_environmentLighting.isValid())
+                {
+                    RowSlider("Environment", "##EnvironmentIntensity", &m_environmentIntensity, 0.0f, 4.0f);
+                }
+
+                RowDragFloat3("Sun Direction", "##SunDirection", &m_sunDirection.x, 0.01f);
+                RowColor3("Sun Color", "##SunColor", &m_sunColor.r);
+                RowSlider("Sun Intensity", "##SunIntensity", &m_sunIntensity, 0.0f, 10.0f);
+
+                RowLabel("Shadows");
+                if (ImGui::Checkbox("##Shadows", &m_isShadowsEnabled) && m_isShadowsEnabled)
+                {
+                    m_shadowMaps.invalidate();
+                }
+
+                if (m_isShadowsEnabled && m_isRayTracedShadows)
+                {
+                    RowLabel("Shadow Rays");
+                    ImGui::Text("%u instances, %u blas (%.1f MiB)", m_rayTracedShadows.getInstanceCount(m_currentFrameIndex),
+                                m_rayTracedShadows.getBottomLevelCount(), m_rayTracedShadows.getCompactedBytes() / (1024.0 * 1024.0));
+                }
+                else if (m_isShadowsEnabled)
+                {
+                    RowLabel("Shadow Views");
+                    ImGui::Text("%u of %u re-rendered", m_shadowMaps.getRenderedViewCount(m_currentFrameIndex), ShadowMaps::kViewCount);
+                }
+                ImGui::EndTable();
+            }
+
+            ImGui::Spacing();
+            ImGui::TreePop();
+        }
+
+        // ───────────────────────── Post Process ─────────────────────
+        if (ImGui::TreeNodeEx("Post Process", ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth))
+        {
+            if (BeginTwoColTable("##PostProcessTable", kLabelColWidth))
+            {
+                RowLabel("Auto Exposure");
+                ImGui::Checkbox("##AutoExposure", &m_postProcessSettings.mAutoExposure);
+                RowSlider("Exposure (EV)", "##ExposureCompensation", &m_postProcessSettings.mExposureCompensation, -4.0f, 4.0f);
+                if (m_postProcessSettings.mAutoExposure)
+                {
+                    RowSlider("Adaptation", "##AdaptationSpeed", &m_postProcessSettings.mAdaptationSpeed, 0.1f, 10.0f);
+                }
+
+                if (m_postProcess && m_postProcess->hasBloom() && !m_isTileLocalPost)
+                {
+                    RowLabel("Bloom");
+                    ImGui::Checkbox("##Bloom", &m_postProcessSettings.mBloom);
+                    if (m_postProcessSettings.mBloom)
+                    {
+                        RowSlider("Bloom Strength", "##BloomStrength", &m_postProcessSettings.mBloomStrength, 0.0f, 0.5f);
+                        RowSlider("Bloom Threshold", "##BloomThreshold", &m_postProcessSettings.mBloomThreshold, 0.0f, 8.0f);
+                    }
+                }
                 ImGui::EndTable();
             }
 
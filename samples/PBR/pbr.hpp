@@ -4,29 +4,67 @@
 
 #pragma once 
 
+#include <array>
 #include <vector>
 #include <atomic>
+#include <memory>
+#include <chrono>
 
 #include "graphics/renderer.hpp"
 #include "platform/platform.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/frame_metrics.hpp"
+#include "utils/frame_arena.hpp"
+#include "utils/telemetry_channel.hpp"
 #include "vulkan/vulkan_device.hpp"
 #include "vulkan/vulkan_swapchain.hpp"
 #include "vulkan/vulkan_command_pool.hpp"
 #include "vulkan/vulkan_command_buffer.hpp"
+#include "vulkan/vulkan_command_recorder.hpp"
+#include "vulkan/vulkan_command_counters.hpp"
+#include "vulkan/vulkan_frame_command_allocator.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
 #include "vulkan/vulkan_render_pass.hpp"
 #include "vulkan/vulkan_framebuffer.hpp"
 #include "vulkan/vulkan_fence.hpp"
 #include "vulkan/vulkan_semaphore.hpp"
+#include "vulkan/vulkan_frame_timeline.hpp"
+#include "vulkan/vulkan_deletion_queue.hpp"
+#include "vulkan/vulkan_readback_ring.hpp"
+#include "vulkan/vulkan_present_wait.hpp"
+#include "vulkan/vulkan_low_latency.hpp"
 #include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_uniform_arena.hpp"
 #include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_descriptor_allocator.hpp"
 #include "vulkan/vulkan_descriptor_set_layout.hpp"
-#include "vulkan/vulkan_descriptor_pool.hpp"
 #include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_pipeline_library.hpp"
 #include "vulkan/vulkan_samplers.hpp"
 
 #include "graphics/msaa_target.hpp"
+#include "graphics/render_graph.hpp"
 #include "graphics/camera.hpp"
+#include "graphics/camera_path.hpp"
+#include "graphics/geometry_arena.hpp"
 #include "graphics/gltf_model.hpp"
+#include "graphics/gpu_culling.hpp"
+#include "graphics/occlusion_culling.hpp"
+#include "graphics/dynamic_resolution.hpp"
+#include "graphics/upscale_pass.hpp"
+#include "graphics/post_process.hpp"
+#include "graphics/temporal_aa.hpp"
+#include "graphics/fxaa_pass.hpp"
+#include "graphics/deferred_lighting.hpp"
+#include "graphics/ambient_occlusion.hpp"
+#include "graphics/shading_rate_image.hpp"
+#include "graphics/gpu_skinning.hpp"
+#include "graphics/light_clusters.hpp"
+#include "graphics/environment_lighting.hpp"
+#include "graphics/shadow_maps.hpp"
+#include "graphics/ray_traced_shadows.hpp"
+#include "graphics/mip_generator.hpp"
+#include "graphics/gpu_profiler.hpp"
 #include "graphics/imgui_layer.hpp"
 #include "shader_structs.hpp"
 
@@ -41,34 +79,139 @@ namespace keplar
 
             // core renderer interface: initialize, update, render, configure
             virtual bool initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept override;
+            virtual void preload() noexcept override;
             virtual void update(float dt) noexcept override;
+            virtual void setInterpolation(float alpha) noexcept override { m_interpolationAlpha = alpha; }
             virtual bool render() noexcept override;
+            virtual bool supportsPipelinedFrames() const noexcept override { return true; }
+            virtual bool prepareFrame() noexcept override;
+            virtual bool submitFrame() noexcept override;
             virtual void configureVulkan(VulkanContextConfig& config) noexcept override;
+            virtual bool waitForPresent() noexcept override;
+            virtual bool needsRedraw() const noexcept override;
+            virtual bool isSteadyState() const noexcept override;
+            virtual bool startBenchmark(uint32_t frameCount, const std::filesystem::path& outputPath) noexcept override;
+            virtual bool isBenchmarkComplete() const noexcept override { return m_isBenchmarkComplete; }
+            virtual bool startTelemetry(const std::string& channelName) noexcept override;
 
             // handle window and user input events
             virtual void onWindowResize(uint32_t, uint32_t) override;
+            virtual void onWindowFocus(bool) override                                   { requestRedraw(); }
+            virtual void onInputEvents(const InputEvent*, size_t) override              { requestRedraw(); }
 
         private:
+            // scene shaders in this order: vertex, fragment, indirect vertex, object vertex, bindless fragment, meshlet task, meshlet mesh,
+            // pulled vertex, half-precision fragment, multi-draw object vertex, ray query fragment, ray query bindless fragment,
+            // g-buffer fragment, g-buffer bindless fragment
+            static constexpr size_t kSceneShaderCount = 14;
+
+            // color attachments of the scene passes: the hdr target, plus albedo and normal of the deferred g-buffer
+            static constexpr uint32_t kMaxSceneColorAttachments = 3;
+            using SceneShaderSet = std::array<const VulkanShader*, kSceneShaderCount>;
+
+            // scene pipeline variants: per-node draws, gpu-driven indirect draws, cpu instanced draws, mesh-shaded meshlets
+            enum ScenePipeline : size_t { kGraphicsPipeline, kIndirectPipeline, kInstancedPipeline, kMeshletPipeline, kScenePipelineCount };
+
+            // depth pre-pass coverage: none, large occluders only, or every opaque draw with the main pass testing EQUAL
+            enum class DepthPrepassMode : uint8_t { kOff, kOccluders, kFull };
+
+            // variable rate shading: none, coarse pipeline rates for low-detail materials, or those plus a luminance rate image
+            enum class ShadingRateMode : uint8_t { kOff, kMaterials, kAdaptive };
+
+            // anti-aliasing: multisampled scene passes, single-sample jittered frames resolved against their history, or
+            // single-sample frames filtered after the tonemap
+            enum class AntiAliasingMode : uint8_t { kMsaa, kTemporal, kFxaa };
+
             bool createSwapchain() noexcept;
-            bool createMsaaTarget(const VulkanDevice& device) noexcept;
             bool createCommandPool(const VulkanDevice& device) noexcept;
+            bool createStagingBelt(const VulkanDevice& device) noexcept;
             bool createCommandBuffers() noexcept;
+            bool createRecordWorkers(const VulkanDevice& device) noexcept;
             bool createTextureSamplers(const VulkanDevice& device) noexcept;
             bool loadAssets(const VulkanDevice& device) noexcept;
+            bool finishAssets(const VulkanDevice& device) noexcept;
             bool createUniformBuffers(const VulkanDevice& device) noexcept;
-            bool createShaderModules() noexcept;
-            bool createDescriptorSetLayouts() noexcept;
+            bool createShaderModules(const VulkanDevice& device) noexcept;
+            bool createMeshShading(const VulkanDevice& device) noexcept;
+            bool createGpuCulling(const VulkanDevice& device) noexcept;
+            bool createOcclusionCulling(const VulkanDevice& device, VkFormat depthFormat) noexcept;
+            bool createGpuSkinning(const VulkanDevice& device) noexcept;
+            bool createBindlessMaterials(const VulkanDevice& device) noexcept;
+            bool createLightClusters(const VulkanDevice& device) noexcept;
+            bool createEnvironmentLighting(const VulkanDevice& device) noexcept;
+            bool createShadowMaps(const VulkanDevice& device) noexcept;
+            bool createRayTracedShadows(const VulkanDevice& device) noexcept;
+            bool createDescriptorSetLayouts(const VulkanDevice& device) noexcept;
+            bool resolveSceneLayouts(const VulkanDevice& device, const SceneShaderSet& shaders, VkDescriptorSetLayout& cameraLayout, 
+                                     VkDescriptorSetLayout& lightLayout) const noexcept;
             bool createDescriptorPool() noexcept;
             bool createDescriptorSets() noexcept;
-            bool createRenderPasses() noexcept; 
-            bool createGraphicsPipeline() noexcept;
-            bool createFramebuffers() noexcept;
+            bool createGpuProfiler(const VulkanDevice& device) noexcept;
+            bool createRenderGraph(const VulkanDevice& device) noexcept;
+            bool createGraphicsPipeline(const VulkanDevice& device) noexcept;
+            SceneShaderSet getSceneShaders() const noexcept;
+            std::vector<const VulkanShader*> getSceneStageShaders(const SceneShaderSet& shaders, size_t pipelineIndex) const noexcept;
+            void setSceneShaderStages(const SceneShaderSet& shaders, std::array<GraphicsPipelineConfig, kScenePipelineCount>& configs) const noexcept;
+            bool createScenePipeline(const VulkanDevice& device, const SceneShaderSet& shaders, const GraphicsPipelineConfig& config, 
+                                     size_t pipelineIndex, VulkanPipeline& pipeline) const noexcept;
+            std::vector<GraphicsPipelineConfig> getPermutationConfigs(const std::array<GraphicsPipelineConfig, kScenePipelineCount>& configs,
+                                                                      std::vector<uint32_t>& pipelineIndices) const noexcept;
+            void setPermutationPipelines(std::vector<VulkanPipeline>&& pipelines, const std::vector<uint32_t>& pipelineIndices,
+                                         const std::vector<PipelineHandle>& libraryHandles) noexcept;
+            void updateOptimizedPipelines() noexcept;
+            bool createPermutationPipelines() noexcept;
+            bool createDepthPipelines(const VulkanDevice& device) noexcept;
+            bool isDepthPrepassAvailable() const noexcept;
+            bool isDepthPrepassActive() const noexcept;
+            bool createUpscalePass(const VulkanDevice& device, RenderGraphHandle upscalePass, RenderGraphHandle sceneOutput) noexcept;
+            bool createPostProcess(const VulkanDevice& device, RenderGraphHandle sceneColor, RenderGraphHandle displayColor) noexcept;
+            bool createTileLocalPost(const VulkanDevice& device, RenderGraphHandle swapchainImage, RenderGraphHandle sceneOutput,
+                                     RenderGraphHandle depthImage) noexcept;
+            void updateOverlayTarget() noexcept;
+            bool createTemporalAA(const VulkanDevice& device) noexcept;
+            bool createFxaaPass(const VulkanDevice& device) noexcept;
+            bool createDeferredLighting(const VulkanDevice& device) noexcept;
+            bool createAmbientOcclusion(const VulkanDevice& device) noexcept;
+            bool isDynamicResolutionActive() const noexcept;
+            void updateRenderExtent() noexcept;
+            void setSceneViewport(VkCommandBuffer commandBuffer) const noexcept;
+            bool createShadingRateImage(const VulkanDevice& device) noexcept;
+            bool createFrameTimeline(const VulkanDevice& device) noexcept;
+            bool createPresentWait(const VulkanDevice& device) noexcept;
+            bool createLowLatency(const VulkanDevice& device) noexcept;
             bool createSyncPrimitives() noexcept;
             bool recordSceneCommandBuffers() noexcept;
-            bool recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept;
+            bool recordSceneCommandBuffer(uint32_t frameIndex, uint32_t runCount) noexcept;
+            bool recordScenePass(const VulkanCommandBuffer& commandBuffer, const VkCommandBufferBeginInfo& beginInfo, 
+                                 uint32_t frameIndex, uint32_t firstRun, uint32_t runCount, CommandRecorderStats& recorderStats) noexcept;
+            bool recordScenePartitions(uint32_t frameIndex, const VkCommandBufferBeginInfo& beginInfo) noexcept;
+            bool hasStaleScenePartitions(uint32_t frameIndex) const noexcept;
+            void bindScenePassState(VkCommandBuffer commandBuffer, const VulkanPipeline& pipeline, uint32_t frameIndex) const noexcept;
+            void recordLateScenePass(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept;
+            void recordDepthPrepass(VkCommandBuffer commandBuffer, uint32_t frameIndex) noexcept;
+            void bindCameraSet(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, 
+                               VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS) const noexcept;
+            bool recordFrameCommandBuffer(uint32_t frameIndex) noexcept;
+            void recordCullingReadback(const VulkanCommandBuffer& commandBuffer) noexcept;
+            bool recordPresentCommandBuffer(uint32_t frameIndex, uint32_t imageIndex, bool isImageAcquired) noexcept;
             bool prepareScene() noexcept;
+            bool acquireSwapchainImage(bool& isAcquired) noexcept;
+            bool presentFrame(VkSemaphore renderCompleteSemaphore) noexcept;
             bool updatePerFrame(uint32_t frameIndex) noexcept;
-            void updateUserInterface() noexcept;
+            void updateTextureStreaming(uint32_t frameIndex) noexcept;
+            void generatePointLights() noexcept;
+            void applyPendingResize() noexcept;
+            void applySwapchainPolicy() noexcept;
+            void applyFramesInFlight() noexcept;
+            void requestRedraw() noexcept;
+            void updateShaderReload() noexcept;
+            void beginShaderReload(const VulkanDevice& device, const std::vector<std::string>& changedFiles) noexcept;
+            void finishShaderReload() noexcept;
+            void updateUserInterface(FrameArena& frameArena) noexcept;
+            void poseBenchmarkCamera() noexcept;
+            void advanceBenchmark() noexcept;
+            void finishBenchmark() noexcept;
+            void publishTelemetry() noexcept;
 
         private:
             // per frame sync primitives
@@ -79,6 +222,28 @@ namespace keplar
                 VulkanFence      mInFlightFence;
             };
 
+            // fixed-function state of the scene pipelines, kept so their configs can rebuild them with new shaders
+            struct ScenePipelineState
+            {
+                VkViewport                                                  mViewport{};
+                VkRect2D                                                    mScissor{};
+                std::array<VkPipelineColorBlendAttachmentState, kMaxSceneColorAttachments> mColorBlendAttachments{};
+                VkPipelineColorBlendAttachmentState                         mBlendAttachment{};     // blended material permutations (forward only)
+                std::array<VkDynamicState, 2>                               mDynamicStates{};   // viewport and scissor
+                std::array<GraphicsPipelineConfig, kScenePipelineCount>     mConfigs;
+            };
+
+            // shaders rewritten on disk and the scene pipelines being compiled from them (debug hot reload)
+            struct ShaderReload
+            {
+                std::array<VulkanShader, kSceneShaderCount>                 mShaders;
+                std::array<PipelineHandle, kScenePipelineCount>             mPipelines;     // invalid for variants not in use
+                std::vector<PipelineHandle>                                 mPermutations;  // material permutations of the cpu path
+                std::vector<uint32_t>                                       mPermutationIndices;
+                std::array<VulkanPipeline, kScenePipelineCount>             mShaderObjects; // built in place of mPipelines
+                bool                                                        mIsPending = false;
+            };
+
             // core dependencies
             std::weak_ptr<Platform>             m_platform;
             std::weak_ptr<VulkanContext>        m_context;
@@ -97,47 +262,309 @@ namespace keplar
             uint32_t                            m_windowWidth;
             uint32_t                            m_windowHeight;
 
-            // multisampling target 
-            MsaaTarget                          m_msaaTarget;      
+            // resize events are debounced and applied from the frame loop
+            uint32_t                            m_pendingWidth;
+            uint32_t                            m_pendingHeight;
+            bool                                m_isResizePending;
+            bool                                m_isSwapchainOutOfDate;     // cannot present: apply without debounce
+            std::chrono::steady_clock::time_point m_lastResizeTime;
+
+            // runtime present mode and image count policy (edited through the ui)
+            VulkanSwapchainPolicy               m_swapchainPolicy;
+
+            // frame graph: scene pass into transient msaa color/depth, resolved into the swapchain (or the upscale pass source)
+            std::unique_ptr<RenderGraph>        m_renderGraph;
+            RenderGraphHandle                   m_scenePass;
             VkSampleCountFlagBits               m_sampleCount; 
 
+            // temporal anti-aliasing replaces msaa when selected (the scene then renders one sample per pixel); falls
+            // back to msaa when its pass cannot be created
+            AntiAliasingMode                    m_antiAliasingMode;         // the render graph's
+            AntiAliasingMode                    m_requestedAntiAliasingMode;    // applied with the next rebuild
+            VkSampleCountFlagBits               m_requestedSampleCount;     // kMsaa: highest supported count up to it, applied with the next rebuild
+            std::unique_ptr<TemporalAA>         m_temporalAA;               // rebuilt with the render graph
+            std::unique_ptr<FxaaPass>           m_fxaaPass;                 // rebuilt with the render graph
+            FxaaSettings                        m_fxaaSettings;
+
             // rendering state
             uint32_t                            m_swapchainImageCount;
-            uint32_t                            m_maxFramesInFlight;
+            uint32_t                            m_maxFramesInFlight;        // frame slots created, GLTFModel::kMaxFramesInFlight
+            uint32_t                            m_activeFramesInFlight;     // frame slots cycled through, at most m_maxFramesInFlight
+            uint32_t                            m_requestedFramesInFlight;  // applied between frames
             uint32_t                            m_currentImageIndex;
             uint32_t                            m_currentFrameIndex;
             std::atomic<bool>                   m_readyToRender;
 
             // command buffers and synchronization
             VulkanCommandPool                   m_commandPool;
-            std::vector<VulkanCommandBuffer>    m_primaryCommandBuffers;
+            VulkanFrameCommandAllocator         m_frameCommandAllocator;
+            VulkanStagingBelt                   m_stagingBelt;
+            std::vector<VulkanCommandBuffer>    m_primaryCommandBuffers;    // every pass ahead of the swapchain, submitted before the acquire
+            std::vector<VulkanCommandBuffer>    m_presentCommandBuffers;    // the passes writing the acquired image
             std::vector<VulkanCommandBuffer>    m_secondaryCommandBuffer;
-            VulkanRenderPass                    m_renderPass;
-            std::vector<VulkanFramebuffer>      m_framebuffers;
             std::vector<FrameSyncPrimitives>    m_frameSyncPrimitives;
             std::vector<VkFence>                m_imagesInFlightFences;
+            std::vector<bool>                   m_isSceneRecordStale;       // secondaries to re-record once their frame slot is free
+            VulkanDeletionQueue                 m_deletionQueue;            // resources retired by resize, released per frame slot
+
+            // gpu-driven scene: per frame slot one secondary per model partition (GLTFModel::kBatchesPerPartition), each
+            // re-recorded only once the partition's revision moves past the one it was recorded at
+            std::vector<std::vector<VulkanCommandBuffer>>   m_partitionCommandBuffers;
+            std::vector<std::vector<uint64_t>>              m_partitionRecordRevisions;
+            uint32_t                                        m_partitionRecordCount;     // partitions recorded by the last frame
+
+            // timeline frame pacing (falls back to the in-flight fences above)
+            VulkanFrameTimeline                 m_frameTimeline;
+            std::vector<uint64_t>               m_imagesInFlightValues;
+
+            // present-synced pacing and input-to-present latency (falls back to the app's clock pacer)
+            VulkanPresentWait                   m_presentWait;
+            bool                                m_usePresentPacing;
+
+            // vendor low latency: driver paced frame start and latency markers keyed by frame id, which is also the present id
+            VulkanLowLatency                    m_lowLatency;
+            uint64_t                            m_latencyFrameId;       // claimed by the latest sleep, 0 once a frame took it
+            uint64_t                            m_frameLatencyId;       // the prepared frame's id, 0 without low latency
+
+            // parallel cpu-path scene recording: per worker and frame command pools and secondaries
+            std::unique_ptr<ThreadPool>         m_recordThreadPool;
+            std::vector<VulkanCommandPool>      m_workerCommandPools;
+            std::vector<VulkanCommandBuffer>    m_workerCommandBuffers;
+            uint32_t                            m_recordWorkerCount;
+            std::array<uint32_t, GLTFModel::kMaxFramesInFlight> m_workerCommandCounts;    // secondaries recorded per frame, 0: the single one
+            CommandRecorderStats                m_sceneRecorderStats;       // state commands of the last scene recording, summed over workers
+            CommandRecorderStats                m_depthRecorderStats;       // and of the last depth pre-pass
             
             // shaders and pipeline
             VulkanShader                        m_vertexShader;
             VulkanShader                        m_fragmentShader;
             VulkanSamplers                      m_samplers;     
-            VulkanDescriptorSetLayout           m_cameraDescriptorSetLayout;
-            VulkanDescriptorSetLayout           m_lightDescriptorSetLayout;
-            VulkanDescriptorPool                m_descriptorPool;
+            VkDescriptorSetLayout               m_cameraDescriptorSetLayout;    // reflected from the shaders, owned by the device layout cache
+            VkDescriptorSetLayout               m_lightDescriptorSetLayout;
+            VulkanDescriptorAllocator           m_descriptorAllocator;      // sets that live as long as the scene
+            std::array<VulkanDescriptorAllocator, GLTFModel::kMaxFramesInFlight> m_frameDescriptorAllocators;   // transient sets, reset when their frame begins
             VulkanPipeline                      m_graphicsPipeline;
 
-            // main camera and uniform buffer
+            // scene pipeline configs, and their background rebuild when shaders change
+            ScenePipelineState                  m_scenePipelineState;
+            VulkanPipelineLibrary               m_pipelineLibrary;
+            ShaderReload                        m_shaderReload;
+
+            // gpu-driven path: compute culling feeding indirect draws (falls back to cpu-recorded draws)
+            VulkanShader                        m_indirectVertexShader;
+            VulkanPipeline                      m_indirectPipeline;
+            GpuCulling                          m_gpuCulling;
+            bool                                m_isGpuDriven;
+            bool                                m_useDrawIndirectCount;
+
+            // vertex pulling of the gpu-driven path (buffer device address): the indirect pipeline reads the vertex pools
+            // through their addresses instead of vertex bindings; a toggle rebuilds it through the deferred resize path
+            VulkanShader                        m_pulledVertexShader;
+            bool                                m_isVertexPulling;          // the indirect pipeline's
+            bool                                m_requestedVertexPulling;   // applied with the next rebuild
+
+            // two-phase occlusion culling of the gpu-driven path, rebuilt with the render graph it samples depth from
+            std::unique_ptr<OcclusionCulling>   m_occlusionCulling;
+
+            // depth pre-pass of the cpu path: position-only draws ahead of the scene pass, so pbr.frag shades visible fragments
+            // only. declared with the render graph; a mode change rebuilds both through the deferred resize path
+            VulkanShader                        m_depthVertexShader;
+            std::array<VulkanPipeline, 2>       m_depthPipelines;           // single-sided (back faces culled), double-sided
+            std::array<VkPipeline, 2>           m_depthPipelineHandles;
+            RenderGraphHandle                   m_depthPrepass;
+            DepthPrepassMode                    m_depthPrepassMode;         // the render graph's
+            DepthPrepassMode                    m_requestedDepthPrepassMode;    // applied with the next rebuild
+            float                               m_occluderPixels;           // kOccluders: smallest screen span drawn by the pre-pass
+
+            // hdr post process: the scene renders linear radiance into a float target, resolved once, which one compute pass
+            // blooms, exposes (metered from its own histogram) and tonemaps into the display target the upscale pass reads
+            std::unique_ptr<PostProcess>        m_postProcess;              // rebuilt with the render graph
+            PostProcessSettings                 m_postProcessSettings;
+            float                               m_updateDt;                 // simulated time of the latest update()
+            float                               m_frameDt;                  // simulated time of the prepared frame, for exposure adaptation
+            bool                                m_isPostProcessAvailable;   // cleared when it fails to build; the upscale pass then shows the scene untonemapped
+
+            // tile-local post process: on tiled gpus the tonemap and the overlay run as a subpass of the scene's render pass,
+            // reading the resolved scene as an input attachment, so the hdr target is never stored and the display target
+            // and upscale pass go away. the exposure is reduced by a compute pass after it. needs msaa at the native extent,
+            // one view and fragmentStoresAndAtomics; bloom and the adaptive rate image need neighbours and are skipped
+            RenderGraphHandle                   m_tileToneMapPass;
+            bool                                m_isTileLocalPost;          // the render graph's
+            bool                                m_requestedTileLocalPost;   // applied with the next rebuild
+            bool                                m_isOverlayRetargeted;      // the imgui pipeline is built for the tonemap subpass
+
+            // deferred shading: the scene passes run pbr.frag built with -DGBUFFER into a compact g-buffer (the hdr target,
+            // albedo and octahedral normal), and one compute pass lights every pixel once against the same clusters, shadows
+            // and environment the forward path reads. single-sampled, one view; blended materials are cut out at half
+            // coverage. a toggle rebuilds the render graph and pipelines through the deferred resize path
+            VulkanShader                        m_gBufferFragmentShader;
+            VulkanShader                        m_gBufferBindlessFragmentShader;
+            std::unique_ptr<DeferredLighting>   m_deferredLighting;         // rebuilt with the render graph
+            bool                                m_isDeferred;               // the render graph's
+            bool                                m_requestedDeferred;        // applied with the next rebuild
+
+            // screen-space ambient occlusion of the deferred path: traced at half resolution once the scene passes wrote
+            // the depth, upsampled by the lighting pass. forward+ has no complete depth before it shades (short of a full
+            // pre-pass) and no light set binding for it, so it keeps the material occlusion. the toggle and tunables
+            // apply from the next frame, no rebuild
+            std::unique_ptr<AmbientOcclusion>   m_ambientOcclusion;         // rebuilt with the render graph
+            AmbientOcclusionSettings            m_ambientOcclusionSettings;
+            bool                                m_isAmbientOcclusion;
+
+            // dynamic resolution: the scene renders into a target of the swapchain extent through a viewport scaled by the
+            // gpu frame time, and the fullscreen pass copying the display target into the swapchain upscales and sharpens
+            // that region (needs gpu timestamps). toggling it rebuilds the render graph through the deferred resize path
+            DynamicResolution                   m_dynamicResolution;
+            std::unique_ptr<UpscalePass>        m_upscalePass;              // rebuilt with the render graph
+            VkExtent2D                          m_renderExtent;             // scene viewport of the prepared frame
+            float                               m_upscaleSharpness;
+            bool                                m_isDynamicResolution;      // the render graph's
+            bool                                m_requestedDynamicResolution;   // applied with the next rebuild
+
+            // stereo: the depth pre-pass and scene passes render both eyes in one multiview render pass (view mask 0b11)
+            // into two-layer depth and hdr targets, the vertex stage picking its eye's matrix by gl_ViewIndex. the window
+            // mirrors one eye's layer. draws are culled once against a frustum enclosing both eyes, occlusion culling,
+            // temporal aa, the adaptive rate image and clustered light binning stay single-view and fall back
+            bool                                m_isStereo;                 // the render graph's
+            bool                                m_requestedStereo;          // applied with the next rebuild
+            uint32_t                            m_stereoMirrorEye;          // layer the post process reads, 0: left
+            float                               m_interpupillaryDistance;   // world units (meters)
+            std::vector<glm::mat4>              m_cullingMatrices;          // per frame: clip from model space of this frame's culling
+
+            // variable rate shading (VK_KHR_fragment_shading_rate): low-detail material permutations shade 2x2 through their
+            // pipeline rate, and the adaptive mode adds a rate image derived from the scene color, read by the scene passes of
+            // the next frame as an attachment. it samples the tonemapped display target; a mode change rebuilds both through
+            // the deferred resize path
+            std::unique_ptr<ShadingRateImage>   m_shadingRateImage;         // rebuilt with the render graph, null unless adaptive
+            ShadingRateMode                     m_shadingRateMode;          // the render graph's
+            ShadingRateMode                     m_requestedShadingRateMode;     // applied with the next rebuild
+            float                               m_shadingRateThreshold;     // kAdaptive: relative contrast below which an axis halves
+
+            // cpu path instancing of repeated mesh nodes, using the indirect vertex shader
+            VulkanPipeline                      m_instancedPipeline;
+
+            // material permutations of the cpu path: the per-node or instanced pipeline specialized for each material
+            // feature set (gpu-driven and bindless draws keep the uber shader)
+            // with extended dynamic state culling is set per draw, so permutations that differ only in sidedness share a
+            // pipeline (m_permutationHandles stays indexed by permutation)
+            std::vector<VulkanPipeline>         m_permutationPipelines;
+            std::vector<VkPipeline>             m_permutationHandles;
+            std::vector<uint32_t>               m_permutationPipelineIndices;   // permutation -> m_permutationPipelines
+            std::vector<PipelineHandle>         m_permutationLinks;             // optimized links still to swap in
+            bool                                m_isExtendedDynamicState;
+
+            // shader objects (tooling builds): the scene variants bind linked shaders with all state set at record time, so
+            // a hot reload never waits on pipeline compiles; materials keep the uber shader (no permutations)
+            bool                                m_isShaderObject;
+
+            // half-precision shading (shaderFloat16): pbr.frag built with fp16 material terms replaces the fp32 build in the
+            // per-node, instanced, meshlet and permutation pipelines; a toggle rebuilds them through the deferred resize path
+            VulkanShader                        m_halfFragmentShader;
+            bool                                m_isHalfPrecision;          // the scene pipelines'
+            bool                                m_requestedHalfPrecision;   // applied with the next rebuild
+
+            // bindless material set bound once per model, with per-frame object records (falls back to per-material descriptor sets)
+            VulkanShader                        m_objectVertexShader;
+            VulkanShader                        m_bindlessFragmentShader;
+            bool                                m_isBindless;
+
+            // multi-draw (VK_EXT_multi_draw): pbr_object.vert built with gl_DrawID replaces the object vertex shader, and the
+            // model submits bindless runs sharing pipeline and vertex pool as one vkCmdDrawMultiIndexedEXT
+            VulkanShader                        m_multiDrawVertexShader;
+            bool                                m_isMultiDraw;
+
+            // task/mesh shader path: meshlets culled per cluster on the gpu, with the cpu path's draw runs (falls back to vertex draws)
+            VulkanShader                        m_meshletTaskShader;
+            VulkanShader                        m_meshletMeshShader;
+            VulkanPipeline                      m_meshletPipeline;
+            bool                                m_isMeshShading;
+
+            // compute skinning of the model's skinned vertex pool (falls back to bind pose)
+            GpuSkinning                         m_gpuSkinning;
+
+            // clustered forward lighting: per-frame light lists binned by a compute pass (falls back to shading every light)
+            LightClusters                       m_lightClusters;
+            std::vector<LightClusters::PointLight> m_pointLights;       // scene lights after the main one
+            int                                 m_pointLightCount;          // requested in the ui
+
+            // baked image-based lighting (falls back to a flat ambient term)
+            EnvironmentLighting                 m_environmentLighting;
+            float                               m_environmentIntensity;
+
+            // cached cascades for the sun and a cube for the main point light (falls back to unshadowed lights)
+            ShadowMaps                          m_shadowMaps;
+            glm::vec3                           m_sunDirection;             // towards the sun
+            glm::vec3                           m_sunColor;
+            float                               m_sunIntensity;
+            bool                                m_isShadowsEnabled;
+
+            // ray query shadows (VK_KHR_ray_query): pbr.frag and pbr_bindless.frag built to trace the sun and every point light
+            // against the model's acceleration structures replace both shadow maps' lookups (falls back to the shadow maps)
+            RayTracedShadows                    m_rayTracedShadows;
+            VulkanShader                        m_rayQueryFragmentShader;
+            VulkanShader                        m_rayQueryBindlessFragmentShader;
+            bool                                m_isRayTracedShadows;
+
+            // batched compute mipmaps for model textures (falls back to cpu mip chains)
+            MipGenerator                        m_mipGenerator;
+
+            // per-pass gpu timestamps and pipeline statistics shown in the ui (disabled without timestamp support)
+            GpuProfiler                         m_gpuProfiler;
+            uint32_t                            m_frameProfileScope;        // opened in the frame command buffer, closed in the present one
+
+            // frame statistics next to the timings: the commands the last frame recorded, and the draws gpu culling kept,
+            // read back frames in flight later (compacted draws only)
+            CommandCounts                       m_frameCommandCounts;
+            VulkanReadbackRing                  m_statsReadback;
+            uint32_t                            m_cullingDrawnCount;        // both phases with occlusion culling
+            uint32_t                            m_cullingTestedCount;       // 0 until a readback was delivered
+
+            // frame, cpu, gpu and present latency histories with percentiles for the ui
+            FrameMetrics                        m_frameMetrics;
+            float                               m_updateCpuMs;              // cpu time of the latest update()
+            float                               m_frameUpdateCpuMs;         // update() time of the prepared frame
+            std::chrono::steady_clock::time_point m_cpuWorkStart;           // prepared frame's cpu work, after its waits
+
+            // frame packet captured by prepareFrame and consumed by submitFrame (possibly on another thread)
+            bool                                m_isFramePrepared;
+            bool                                m_isSceneRecordNeeded;
+            uint32_t                            m_preparedRunCount;         // cpu path draw runs gathered for the frame
+            bool                                m_isOverlayDrawn;           // the upscale pass records the overlay's draws
+
+            // scripted benchmark: fixed step camera path, metrics captured after a warm-up
+            CameraPath                          m_benchmarkPath;
+            std::filesystem::path               m_benchmarkOutput;
+            uint32_t                            m_benchmarkFrameCount;
+            uint32_t                            m_benchmarkFrame;           // frames played, warm-up included
+            bool                                m_isBenchmarkRunning;
+            bool                                m_isBenchmarkComplete;
+
+            // live telemetry (--telemetry): a sample of the metrics above every few frames, for readers outside the process
+            TelemetryChannel                    m_telemetry;
+            uint64_t                            m_telemetryFrameCount;      // frames submitted since the channel was created
+
+            // on-demand rendering: frames left to settle temporal state (frames in flight, occlusion history, staggered
+            // shadow updates) after the last change, and the time auto exposure gets to adapt to it
+            uint32_t                            m_redrawFrameCount;
+            std::chrono::steady_clock::time_point m_redrawDeadline;
+
+            // main camera and the per-frame uniform blocks, sub-allocated from one arena
             std::shared_ptr<Camera>             m_camera;
-            std::vector<VulkanBuffer>           m_cameraUniformBuffers;
-            std::vector<VulkanBuffer>           m_lightUniformBuffers;
+            float                               m_interpolationAlpha;       // camera pose blend between the last two updates
+            VulkanUniformArena                  m_uniformArena;
 
-            // descriptor sets and UBOs
-            std::vector<VkDescriptorSet>        m_cameraDescriptorSets;
+            // descriptor sets and UBOs; the camera set is shared by every frame through its dynamic offset, light
+            // sets stay per frame for the frame's light and cluster buffers
+            VkDescriptorSet                     m_cameraDescriptorSet;
+            bool                                m_isCameraPushed;           // camera block pushed per pass instead of a bound set
             std::vector<VkDescriptorSet>        m_lightDescriptorSets;
+            VulkanDescriptorUpdateTemplate      m_lightUpdateTemplate;      // writes a whole light set from LightSetDescriptors
             std::vector<ubo::Camera>            m_cameraUniforms;
             std::vector<ubo::Light>             m_lightUniforms;
+            std::vector<std::array<uint32_t, 2>> m_uniformOffsets;          // per frame: camera and light dynamic offsets
             
-            // scene resources
+            // scene resources; the arena holds the models' static geometry, so it is declared (and outlives) them
+            GeometryArena                       m_geometryArena;
             GLTFModel                           m_gltfModel;
             std::unique_ptr<ImGuiLayer>         m_imguiLayer;
             
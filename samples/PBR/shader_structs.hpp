@@ -5,22 +5,37 @@
 #pragma once
 
 #include "graphics/math3d.hpp"
+#include "graphics/shadow_maps.hpp"
 
 namespace keplar::ubo
 {
+    // views of a multiview scene pass (stereo: left and right eye)
+    inline constexpr uint32_t kMaxViews = 2;
+
+    // the first members are the center view, which everything but the scene passes' vertex and fragment stages reads
     struct alignas(16) Camera
     {
         glm::mat4 projection;
         glm::mat4 view;
         glm::mat4 model;
         glm::vec4 position;
+        glm::mat4 viewProjections[kMaxViews];   // per gl_ViewIndex; the center one in view 0 when not stereo
+        glm::vec4 viewPositions[kMaxViews];
     };
 
-    constexpr int MAX_LIGHTS = 1;
+    // lights themselves live in LightClusters' storage buffers
     struct alignas(16) Light
     {
-        glm::vec4 position[MAX_LIGHTS];
-        glm::vec4 color[MAX_LIGHTS];
-        glm::ivec4 count;
+        glm::uvec4 grid;        // xyz: cluster grid (x 0: shade every light), w: light count
+        glm::vec4 slices;       // x: depth slice scale, y: depth slice bias, zw: tile size in pixels
+        glm::vec4 frustum;      // xy: tangent of the horizontal and vertical half fov, z: near, w: far
+        glm::vec4 environment;  // x: prefiltered map's last mip, y: image-based lighting intensity (0: flat ambient)
+        glm::vec4 sunDirection; // xyz: direction towards the directional light
+        glm::vec4 sunColor;     // rgb: color, w: intensity (0: no directional light)
+        glm::mat4 cascades[keplar::ShadowMaps::kCascadeCount];     // world to cascade clip space
+        glm::vec4 cascadeSplits;    // view depth each cascade ends at
+        glm::vec4 cascadeTexels;    // world size of one texel of each cascade
+        glm::vec4 pointShadow;  // xyz: position the shadow cube was rendered from, w: index + 1 of the light casting it (0: none)
+        glm::vec4 shadowParams; // x: cascades in use, y: cube depth scale, z: cube near, w: cube texel size at unit distance
     };
 }   // namespace keplar
@@ -3,7 +3,9 @@
 // ────────────────────────────────────────────
 
 #include "gltfloader.hpp"
+#include "core/keplar_config.hpp"
 #include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
 #include "vulkan/vulkan_utils.hpp"
 
 namespace keplar
@@ -41,8 +43,8 @@ namespace keplar
         // destroy vulkan resources 
         GLTFModel::destroySharedResources(m_vkDevice);
         m_swapchain.reset();
-        m_commandPool.deallocate(m_primaryCommandBuffers);
         m_commandPool.deallocate(m_secondaryCommandBuffer);
+        m_frameCommandAllocator.destroy();
     }
 
     bool GLTFLoader::initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept
@@ -77,23 +79,24 @@ namespace keplar
         m_windowHeight    = platformLocked->getWindowHeight();
 
         // initialize vulkan resources
-        if (!createSwapchain())             { return false; }
-        if (!createMsaaTarget(*device))     { return false; }
-        if (!createCommandPool(*device))    { return false; }
-        if (!createCommandBuffers())        { return false; }
-        if (!createTextureSamplers(*device)){ return false; }
-        if (!loadAssets(*device))           { return false; }
-        if (!createUniformBuffers(*device)) { return false; }
-        if (!createShaderModules())         { return false; }
-        if (!createDescriptorSetLayouts())  { return false; }
-        if (!createDescriptorPool())        { return false; }
-        if (!createDescriptorSets())        { return false; }
-        if (!createRenderPasses())          { return false; }
-        if (!createGraphicsPipeline())      { return false; }
-        if (!createFramebuffers())          { return false; }
-        if (!createSyncPrimitives())        { return false; }
-        if (!recordSceneCommandBuffers())   { return false; }
-        if (!prepareScene())                { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSwapchain()))               { return false; }
+        if (!KEPLAR_STARTUP_STEP(createMsaaTarget(*device)))       { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandPool(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createStagingBelt(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandBuffers()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createTextureSamplers(*device)))  { return false; }
+        if (!KEPLAR_STARTUP_STEP(loadAssets(*device)))             { return false; }
+        if (!KEPLAR_STARTUP_STEP(createUniformBuffers(*device)))   { return false; }
+        if (!KEPLAR_STARTUP_STEP(createShaderModules()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSetLayouts()))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorPool()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSets()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRenderPasses()))            { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGraphicsPipeline(*device))) { return false; }
+        if (!KEPLAR_STARTUP_STEP(createFramebuffers()))            { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSyncPrimitives()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(recordSceneCommandBuffers()))     { return false; }
+        if (!KEPLAR_STARTUP_STEP(prepareScene()))                  { return false; }
 
         VK_LOG_INFO("GLTFLoader::initialize successful");
         return true;
@@ -103,6 +106,7 @@ namespace keplar
     {
         // update scene state
         m_camera->update(dt);
+        m_gltfModel.update(dt);
     }
 
     bool GLTFLoader::render() noexcept
@@ -162,12 +166,25 @@ namespace keplar
             return false;
         }
 
+        // the frame's gpu work is done: recycle its transient command buffers in one pool reset
+        if (!m_frameCommandAllocator.beginFrame(m_currentFrameIndex))
+        {
+            return false;
+        }
+        m_primaryCommandBuffers[m_currentFrameIndex] = m_frameCommandAllocator.allocatePrimary();
+
         // update per-frame resources
         if (!updatePerFrame(m_currentFrameIndex))
         {
             return false;
         }
 
+        // node transforms change every frame while animating; push constants are baked into the secondary
+        if (m_gltfModel.hasAnimations() && !recordSceneCommandBuffer(m_currentFrameIndex))
+        {
+            return false;
+        }
+
         // record primary buffer for this frame targeting the acquired swapchain framebuffer
         if (!recordFrameCommandBuffer(m_currentFrameIndex, m_currentImageIndex))
         {    
@@ -229,6 +246,13 @@ namespace keplar
     {
         // enable sampler anisotropy for higher quality texture filtering
         config.mRequestedFeatures.samplerAnisotropy = VK_TRUE;
+
+        // pre-compressed ktx2 textures; unsupported features are dropped and those textures fall back to rgba8
+        config.mRequestedFeatures.textureCompressionBC = VK_TRUE;
+        config.mRequestedFeatures.textureCompressionASTC_LDR = VK_TRUE;
+
+        // stream model uploads on a dedicated transfer queue when the device exposes one
+        config.mPreferDedicatedTransferQueue = true;
     }
 
     void GLTFLoader::onWindowResize(uint32_t width, uint32_t height)
@@ -245,20 +269,20 @@ namespace keplar
         m_readyToRender.store(false);
         vkDeviceWaitIdle(m_vkDevice);
 
-        // recreate swapchain with new dimensions
+        // recreate swapchain with new dimensions; a display rotation changes the pre-rotation with it
         if (!m_swapchain->recreate(width, height))
         {
             return;
         }
 
-        // store old max frames-in-flight for sync check
-        const uint32_t previousMaxFramesInFlight = m_maxFramesInFlight;
+        if (m_camera)
+        {
+            m_camera->setPreRotation(m_swapchain->getPreRotation());
+        }
 
         // update swapchain handle and image count
         m_vkSwapchainKHR      = m_swapchain->get();
         m_swapchainImageCount = m_swapchain->getImageCount();
-        m_maxFramesInFlight   = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight   = glm::max(1u, m_maxFramesInFlight);
 
         // reset per-image fence ownership for the new swapchain images
         m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
@@ -272,33 +296,15 @@ namespace keplar
         m_graphicsPipeline.destroy();
         m_renderPass.destroy();
         m_msaaTarget.destroy();
-        m_commandPool.deallocate(m_primaryCommandBuffers);
 
         // recreate all dependent resources
         if (!createMsaaTarget(*device))   { return; }
         if (!createCommandBuffers())      { return; }
         if (!createRenderPasses())        { return; }
-        if (!createGraphicsPipeline())    { return; }
+        if (!createGraphicsPipeline(*device)) { return; }
         if (!createFramebuffers())        { return; }
         if (!recordSceneCommandBuffers()) { return; }
 
-        // recreate per-frame sync primitives if max frames-in-flight changed
-        if (m_maxFramesInFlight != previousMaxFramesInFlight)
-        {
-            for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
-            {
-                auto& frameSync = m_frameSyncPrimitives[i];
-                frameSync.mInFlightFence.destroy();
-                frameSync.mRenderCompleteSemaphore.destroy();
-                frameSync.mImageAvailableSemaphore.destroy();
-            }
-            
-            if (!createSyncPrimitives()) 
-            { 
-                return; 
-            }
-        }
-
         // update window dimensions 
         m_windowWidth  = width;
         m_windowHeight = height;
@@ -309,7 +315,10 @@ namespace keplar
 
     bool GLTFLoader::createSwapchain() noexcept
     {
-        // setup swapchain
+        // setup swapchain: rendering straight into its images, the projection takes over the display rotation
+        VulkanSwapchainPolicy policy = m_swapchain->getPolicy();
+        policy.mPreRotation = true;
+        m_swapchain->updatePolicy(policy);
         if (!m_swapchain->initialize(m_windowWidth, m_windowHeight))
         {
             VK_LOG_ERROR("GLTFLoader::createSwapchain : failed to create swapchain fpr presentation.");
@@ -320,11 +329,8 @@ namespace keplar
         m_vkSwapchainKHR = m_swapchain->get();
         m_swapchainImageCount = m_swapchain->getImageCount();
         
-        // vulkan spec suggests max frames in flight should be less than swapchain image count
-        // to prevent CPU stalling while waiting for an image to become available for rendering.
-        // setting an upper limit of 3 balances throughput and avoids stalls.
-        m_maxFramesInFlight = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight = glm::max(1u, m_maxFramesInFlight);
+        // frames in flight are a budget of their own, not derived from the image count (see config::kFramesInFlight)
+        m_maxFramesInFlight = config::kFramesInFlight;
 
         VK_LOG_INFO("GLTFLoader::createSwapchain : swapchain created successfully (max frames in flight: %d)", m_maxFramesInFlight);
         return true;
@@ -335,14 +341,20 @@ namespace keplar
         // initialize msaa color and depth targets for the current swapchain
         if (m_msaaTarget.initialize(device, *m_swapchain, VK_SAMPLE_COUNT_8_BIT))
         {
-            // success
+            // success: the msaa depth target replaces the swapchain one
             m_sampleCount = m_msaaTarget.getSampleCount();
+            m_swapchain->setDepthAttachment(false);
             VK_LOG_DEBUG("GLTFLoader::createMsaaTarget : msaa targets created successfully.");
         }
         else 
         {
-            // fall back to no msaa
+            // fall back to no msaa, rendering depth into the swapchain's own target
             VK_LOG_WARN("GLTFLoader::createMsaaTarget : failed to create msaa color and depth targets.");
+            if (!m_swapchain->setDepthAttachment(true))
+            {
+                VK_LOG_ERROR("GLTFLoader::createMsaaTarget : failed to create swapchain depth target.");
+                return false;
+            }
         }
 
         return true;
@@ -367,20 +379,35 @@ namespace keplar
             return false;
         }
 
+        // transient per-frame pools for command buffers re-recorded every frame
+        if (!m_frameCommandAllocator.initialize(m_vkDevice, graphicsFamilyIndex.value(), GLTFModel::kMaxFramesInFlight))
+        {
+            VK_LOG_ERROR("GLTFLoader::createCommandPool : failed to initialize frame command allocator.");
+            return false;
+        }
+
         VK_LOG_DEBUG("GLTFLoader::createCommandPool successful");
         return true;
     }
 
-    bool GLTFLoader::createCommandBuffers() noexcept
+    bool GLTFLoader::createStagingBelt(const VulkanDevice& device) noexcept
     {
-        // allocate primary command buffers for each frame in flight
-        m_primaryCommandBuffers = m_commandPool.allocatePrimaries(m_maxFramesInFlight);
-        if (m_primaryCommandBuffers.empty())
+        // persistently mapped staging ring shared by all host-to-device uploads
+        if (!m_stagingBelt.initialize(device))
         {
-            VK_LOG_ERROR("GLTFLoader::createCommandBuffers failed to allocate primary command buffers.");
+            VK_LOG_ERROR("GLTFLoader::createStagingBelt : failed to initialize staging belt.");
             return false;
         }
 
+        VK_LOG_DEBUG("GLTFLoader::createStagingBelt successful");
+        return true;
+    }
+
+    bool GLTFLoader::createCommandBuffers() noexcept
+    {
+        // primary command buffers are taken from the frame command allocator when each frame begins
+        m_primaryCommandBuffers.assign(m_maxFramesInFlight, VulkanCommandBuffer{});
+
         // allocate secondary command buffers to cache stable draw workloads
         m_secondaryCommandBuffer = m_commandPool.allocateSecondaries(m_maxFramesInFlight);
         if (m_secondaryCommandBuffer.empty())
@@ -412,7 +439,11 @@ namespace keplar
         GLTFModel::initSharedResources(m_vkDevice);
 
         // load gltf model
-        if (!m_gltfModel.load(device, m_commandPool, "DamagedHelmet.glb"))
+        GLTFLoadConfig loadConfig{};
+        loadConfig.mVertexFormat   = GLTFVertexFormat::kPacked;
+        loadConfig.mOptimizeMeshes = true;
+        loadConfig.mUseBakedCache  = true;
+        if (!m_gltfModel.load(device, m_stagingBelt, "DamagedHelmet.glb", loadConfig))
         {
             VK_LOG_DEBUG("GLTFLoader::loadAssets failed to load gltf model");
             return false;
@@ -507,14 +538,14 @@ namespace keplar
         // descriptor set requirements
         DescriptorRequirements requirements{};
         requirements.mMaxSets = m_maxFramesInFlight;
-        requirements.mUniformCount = 1;
+        requirements.mUniformCount = m_maxFramesInFlight;
 
         // add requirements
-        m_descriptorPool.addRequirements(requirements);
-        m_descriptorPool.addRequirements(m_gltfModel.getDescriptorRequirements());
+        m_descriptorAllocator.addRequirements(requirements);
+        m_descriptorAllocator.addRequirements(m_gltfModel.getDescriptorRequirements());
 
-        // create vulkan descriptor pool
-        if (!m_descriptorPool.initialize(m_vkDevice))
+        // create the descriptor allocator, its first pool sized to the requirements
+        if (!m_descriptorAllocator.initialize(m_vkDevice))
         {
             VK_LOG_ERROR("GLTFLoader::createDescriptorPool failed");
             return false;
@@ -529,20 +560,11 @@ namespace keplar
         // create identical descriptor set layouts for each frame
         std::vector<VkDescriptorSetLayout> layouts(m_maxFramesInFlight, m_descriptorSetLayout.get());
 
-        // descriptor set allocation info
-        VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
-        descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        descriptorSetAllocateInfo.pNext = nullptr;
-        descriptorSetAllocateInfo.descriptorPool = m_descriptorPool.get();
-        descriptorSetAllocateInfo.descriptorSetCount = m_maxFramesInFlight;
-        descriptorSetAllocateInfo.pSetLayouts = layouts.data();
-
         // allocate descriptor sets
         m_descriptorSets.resize(m_maxFramesInFlight);
-        VkResult vkResult = vkAllocateDescriptorSets(m_vkDevice, &descriptorSetAllocateInfo, m_descriptorSets.data());
-        if (vkResult != VK_SUCCESS)
+        if (!m_descriptorAllocator.allocate(layouts.data(), m_maxFramesInFlight, m_descriptorSets.data()))
         {
-            VK_LOG_FATAL("vkAllocateDescriptorSets failed to allocate descriptor set : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_ERROR("GLTFLoader::createDescriptorSets failed to allocate descriptor sets");
             return false;
         }
 
@@ -572,7 +594,11 @@ namespace keplar
         }
 
         // allocate and update descriptor sets for model
-        m_gltfModel.allocateDescriptorSets(m_descriptorPool.get());
+        if (!m_gltfModel.allocateDescriptorSets(m_descriptorAllocator))
+        {
+            VK_LOG_ERROR("GLTFLoader::createDescriptorSets failed to allocate material descriptor sets");
+            return false;
+        }
         m_gltfModel.updateDescriptorSets(m_samplers);
         
         VK_LOG_DEBUG("GLTFLoader::createDescriptorSets successful");
@@ -606,7 +632,7 @@ namespace keplar
         depthAttachment.format           = m_swapchain->getDepthFormat();
         depthAttachment.samples          = m_sampleCount;                   
         depthAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;            
-        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;             
+        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;         // depth is not read after the pass
         depthAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;   
         depthAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;  
         depthAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;         
@@ -661,21 +687,10 @@ namespace keplar
         return true;
     }
 
-    bool GLTFLoader::createGraphicsPipeline() noexcept
+    bool GLTFLoader::createGraphicsPipeline(const VulkanDevice& device) noexcept
     {
         // retrieve shared vertex input layout
-        const auto bindings = GLTFModel::getBindings();
-        const auto attributes = GLTFModel::getAttributes();
-
-        // vertex input state
-        VkPipelineVertexInputStateCreateInfo vertexInputState{};
-        vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputState.pNext = nullptr;
-        vertexInputState.flags = 0;
-        vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(bindings.size());
-        vertexInputState.pVertexBindingDescriptions = bindings.data();
-        vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
-        vertexInputState.pVertexAttributeDescriptions = attributes.data();
+        const VkPipelineVertexInputStateCreateInfo vertexInputState = GLTFModel::getVertexInputState(m_gltfModel.getVertexFormat());
 
         // input assembly state: triangle list
         VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
@@ -772,7 +787,7 @@ namespace keplar
         pipelineConfig.mPushConstantRanges.emplace_back(GLTFModel::getPushConstantRange());
 
         // create graphics pipeline
-        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig))
+        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
         {
             VK_LOG_ERROR("GLTFLoader::createGraphicsPipeline failed");
             return false;
@@ -901,6 +916,21 @@ namespace keplar
     }
 
     bool GLTFLoader::recordSceneCommandBuffers() noexcept
+    {
+        // record every frame's secondary up front; animated models re-record per frame
+        for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
+        {
+            if (!recordSceneCommandBuffer(i))
+            {
+                return false;
+            }
+        }
+
+        VK_LOG_DEBUG("GLTFLoader::recordSceneCommandBuffers successful");
+        return true;
+    }
+
+    bool GLTFLoader::recordSceneCommandBuffer(uint32_t frameIndex) noexcept
     {
         // secondary command buffer inherts render pass state from the primary
         VkCommandBufferInheritanceInfo inheritanceInfo{};
@@ -920,28 +950,20 @@ namespace keplar
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
         beginInfo.pInheritanceInfo = &inheritanceInfo;
 
-        for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
+        // reset and begin recording into secondary
+        auto& commandBuffer = m_secondaryCommandBuffer[frameIndex];
+        if (!commandBuffer.reset() || !commandBuffer.begin(beginInfo))
         {
-            // reset and begin recording into secondary
-            if (!m_secondaryCommandBuffer[i].reset() || !m_secondaryCommandBuffer[i].begin(beginInfo))
-            {
-                return false;
-            }
-
-            // record graphics pipeline state, resource bindings, and draw commands for this frame
-            m_secondaryCommandBuffer[i].bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.get());
-            m_secondaryCommandBuffer[i].bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.getLayout(), 0, 1, &m_descriptorSets[i]);
-            m_gltfModel.render(m_secondaryCommandBuffer[i].get(), m_graphicsPipeline.getLayout());
-
-            // finalize the command buffer
-            if (!m_secondaryCommandBuffer[i].end())
-            {
-                return false;
-            }
+            return false;
         }
 
-        VK_LOG_DEBUG("GLTFLoader::recordSceneCommandBuffers successful");
-        return true;
+        // record graphics pipeline state, resource bindings, and draw commands for this frame
+        commandBuffer.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.get());
+        commandBuffer.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.getLayout(), 0, 1, &m_descriptorSets[frameIndex]);
+        m_gltfModel.render(commandBuffer.get(), m_graphicsPipeline.getLayout(), frameIndex);
+
+        // finalize the command buffer
+        return commandBuffer.end();
     }
 
     bool GLTFLoader::recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept
@@ -952,9 +974,9 @@ namespace keplar
         beginInfo.pNext = nullptr;
         beginInfo.flags = 0;
 
-        // reset and then begin recording into the command buffer
+        // begin recording; the buffer comes from a freshly reset pool, so no per-buffer reset
         auto& commandBuffer = m_primaryCommandBuffers[frameIndex];
-        if (!commandBuffer.reset() || !commandBuffer.begin(beginInfo))
+        if (!commandBuffer.isValid() || !commandBuffer.begin(beginInfo))
         {
             return false;
         }
@@ -1005,6 +1027,7 @@ namespace keplar
         // calculate aspect ratio of window and initialize camera
         const float aspectRatio = static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight);
         m_camera = std::make_shared<Camera>(Camera::Mode::Cinematic, 45.0f, aspectRatio, 0.1f, 100.0f);
+        m_camera->setPreRotation(m_swapchain->getPreRotation());
 
         // register listeners with the platform
         if (auto platform = m_platform.lock())
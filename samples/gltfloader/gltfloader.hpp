@@ -13,6 +13,8 @@
 #include "vulkan/vulkan_swapchain.hpp"
 #include "vulkan/vulkan_command_pool.hpp"
 #include "vulkan/vulkan_command_buffer.hpp"
+#include "vulkan/vulkan_frame_command_allocator.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
 #include "vulkan/vulkan_render_pass.hpp"
 #include "vulkan/vulkan_framebuffer.hpp"
 #include "vulkan/vulkan_fence.hpp"
@@ -20,7 +22,7 @@
 #include "vulkan/vulkan_buffer.hpp"
 #include "vulkan/vulkan_shader.hpp"
 #include "vulkan/vulkan_descriptor_set_layout.hpp"
-#include "vulkan/vulkan_descriptor_pool.hpp"
+#include "vulkan/vulkan_descriptor_allocator.hpp"
 #include "vulkan/vulkan_pipeline.hpp"
 #include "vulkan/vulkan_samplers.hpp"
 
@@ -51,6 +53,7 @@ namespace keplar
             bool createSwapchain() noexcept;
             bool createMsaaTarget(const VulkanDevice& device) noexcept;
             bool createCommandPool(const VulkanDevice& device) noexcept;
+            bool createStagingBelt(const VulkanDevice& device) noexcept;
             bool createCommandBuffers() noexcept;
             bool createTextureSamplers(const VulkanDevice& device) noexcept;
             bool loadAssets(const VulkanDevice& device) noexcept;
@@ -60,10 +63,11 @@ namespace keplar
             bool createDescriptorPool() noexcept;
             bool createDescriptorSets() noexcept;
             bool createRenderPasses() noexcept; 
-            bool createGraphicsPipeline() noexcept;
+            bool createGraphicsPipeline(const VulkanDevice& device) noexcept;
             bool createFramebuffers() noexcept;
             bool createSyncPrimitives() noexcept;
             bool recordSceneCommandBuffers() noexcept;
+            bool recordSceneCommandBuffer(uint32_t frameIndex) noexcept;
             bool recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept;
             bool prepareScene() noexcept;
             bool updatePerFrame(uint32_t frameIndex) noexcept;
@@ -108,6 +112,8 @@ namespace keplar
 
             // command buffers and synchronization
             VulkanCommandPool                   m_commandPool;
+            VulkanFrameCommandAllocator         m_frameCommandAllocator;
+            VulkanStagingBelt                   m_stagingBelt;
             std::vector<VulkanCommandBuffer>    m_primaryCommandBuffers;
             std::vector<VulkanCommandBuffer>    m_secondaryCommandBuffer;
             VulkanRenderPass                    m_renderPass;
@@ -120,7 +126,7 @@ namespace keplar
             VulkanShader                        m_fragmentShader;
             VulkanSamplers                      m_samplers;     
             VulkanDescriptorSetLayout           m_descriptorSetLayout;
-            VulkanDescriptorPool                m_descriptorPool;
+            VulkanDescriptorAllocator           m_descriptorAllocator;
             VulkanPipeline                      m_graphicsPipeline;
 
             // main camera and uniform buffer
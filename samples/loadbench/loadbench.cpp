@@ -0,0 +1,499 @@
+// ────────────────────────────────────────────
+//  File: loadbench.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "loadbench.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+#ifdef PLATFORM_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+#include "core/keplar_config.hpp"
+#include "graphics/model_cache.hpp"
+#include "utils/logger.hpp"
+#include "vulkan/vulkan_context.hpp"
+
+namespace
+{
+    double getMillisecondsSince(std::chrono::steady_clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::string escapeJson(const std::string& value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char c : value)
+        {
+            if (c == '"' || c == '\\') { escaped.push_back('\\'); }
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
+
+    // cold is the first iteration, warm the mean of the rest (the cold one when it is all there is)
+    template <typename Sample, typename Getter>
+    void getColdWarm(const std::vector<Sample>& samples, Getter getter, double& cold, double& warm) noexcept
+    {
+        cold = samples.empty() ? 0.0 : getter(samples.front());
+        warm = cold;
+        if (samples.size() > 1)
+        {
+            double sum = 0.0;
+            for (size_t i = 1; i < samples.size(); ++i)
+            {
+                sum += getter(samples[i]);
+            }
+            warm = sum / static_cast<double>(samples.size() - 1);
+        }
+    }
+
+    // megabytes of source (or baked file) read per second of the whole load
+    double getThroughputMbps(const keplar::GLTFLoadTimings& timings) noexcept
+    {
+        return timings.mTotal > 0.0 ? (static_cast<double>(timings.mSourceBytes) / (1024.0 * 1024.0)) / (timings.mTotal / 1000.0) : 0.0;
+    }
+
+    // stages reported per case, in load order
+    struct StageField
+    {
+        const char*                             mName;
+        double keplar::GLTFLoadTimings::*       mField;
+    };
+
+    constexpr StageField kStageFields[] =
+    {
+        { "parse_ms",           &keplar::GLTFLoadTimings::mParse },
+        { "meshes_ms",          &keplar::GLTFLoadTimings::mMeshes },
+        { "tangents_ms",        &keplar::GLTFLoadTimings::mTangents },
+        { "scene_graph_ms",     &keplar::GLTFLoadTimings::mSceneGraph },
+        { "textures_ms",        &keplar::GLTFLoadTimings::mTextures },
+        { "image_decode_ms",    &keplar::GLTFLoadTimings::mImageDecode },
+        { "mip_generation_ms",  &keplar::GLTFLoadTimings::mMipGeneration },
+        { "materials_ms",       &keplar::GLTFLoadTimings::mMaterials },
+        { "upload_ms",          &keplar::GLTFLoadTimings::mUpload },
+        { "bake_ms",            &keplar::GLTFLoadTimings::mBake },
+        { "total_ms",           &keplar::GLTFLoadTimings::mTotal },
+    };
+}
+
+namespace keplar
+{
+    LoadBench::LoadBench(std::vector<std::string> modelFiles) noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_readyToRender(false)
+        , m_modelFiles(std::move(modelFiles))
+        , m_iterationCount(0)
+        , m_iteration(0)
+        , m_case(LoadCase::kSource)
+        , m_isBenchmarkRunning(false)
+        , m_isBenchmarkComplete(false)
+    {
+    }
+
+    LoadBench::~LoadBench()
+    {
+        // stop any new iterations from running
+        m_readyToRender.store(false);
+
+        // uploads of the last iteration may still be in flight
+        if (m_vkDevice != VK_NULL_HANDLE)
+        {
+            vkDeviceWaitIdle(m_vkDevice);
+        }
+
+        // destroy vulkan resources
+        releaseModels();
+        GLTFModel::destroySharedResources(m_vkDevice);
+    }
+
+    bool LoadBench::initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept
+    {
+        // store non-owning references
+        m_platform = platform;
+        m_context = context;
+
+        // acquire shared access to the context
+        auto contextLocked = m_context.lock();
+        if (!contextLocked)
+        {
+            return false;
+        }
+
+        // store non-owning device reference and acquire shared access
+        m_device = contextLocked->getDevice();
+        auto device = m_device.lock();
+        if (!device)
+        {
+            return false;
+        }
+        m_vkDevice = device->getDevice();
+
+        // nothing is drawn, so no swapchain: only what loading a model needs
+        if (!m_stagingBelt.initialize(*device))
+        {
+            VK_LOG_ERROR("LoadBench::initialize : failed to initialize staging belt.");
+            return false;
+        }
+
+        if (!m_samplers.initialize(*device))
+        {
+            VK_LOG_ERROR("LoadBench::initialize : failed to create samplers.");
+            return false;
+        }
+
+        if (m_modelFiles.empty())
+        {
+            VK_LOG_ERROR("LoadBench::initialize : no models to load.");
+            return false;
+        }
+
+        GLTFModel::initSharedResources(m_vkDevice);
+        for (auto& results : m_results)
+        {
+            results.mSamples.assign(m_modelFiles.size(), {});
+        }
+
+        m_readyToRender.store(true);
+        VK_LOG_INFO("LoadBench::initialize successful");
+        return true;
+    }
+
+    bool LoadBench::startBenchmark(uint32_t frameCount, const std::filesystem::path& outputPath) noexcept
+    {
+        if (!m_readyToRender.load() || frameCount == 0)
+        {
+            VK_LOG_ERROR("LoadBench::startBenchmark failed: renderer not ready or no iterations requested");
+            return false;
+        }
+
+        m_benchmarkOutput = outputPath;
+        m_iterationCount = frameCount;
+        m_iteration = 0;
+        m_case = LoadCase::kSource;
+        m_isBenchmarkRunning = true;
+        m_isBenchmarkComplete = false;
+
+        VK_LOG_INFO("LoadBench::startBenchmark : %zu models, %u iterations per case", m_modelFiles.size(), frameCount);
+        return true;
+    }
+
+    bool LoadBench::render() noexcept
+    {
+        if (!m_readyToRender.load() || !m_isBenchmarkRunning)
+        {
+            return true;
+        }
+
+        if (!runIteration())
+        {
+            VK_LOG_ERROR("LoadBench::render : %s iteration %u failed", getCaseName(m_case), m_iteration);
+            return false;
+        }
+
+        // next iteration, then next case
+        if (++m_iteration < m_iterationCount)
+        {
+            return true;
+        }
+
+        m_results[static_cast<size_t>(m_case)].mPeakRssMb = getPeakRssMb();
+        m_iteration = 0;
+        m_case = static_cast<LoadCase>(static_cast<uint8_t>(m_case) + 1);
+        if (m_case == LoadCase::kCount)
+        {
+            finishBenchmark();
+        }
+        return true;
+    }
+
+    bool LoadBench::runIteration() noexcept
+    {
+        // the previous iteration's models go first, outside of any measurement
+        vkDeviceWaitIdle(m_vkDevice);
+        releaseModels();
+
+        GLTFLoadConfig config{};
+        config.mOptimizeMeshes = true;
+        switch (m_case)
+        {
+            case LoadCase::kSource:
+                return runSequential(config);
+
+            case LoadCase::kBaked:
+            {
+                // a cold first iteration: no cache to read, so it parses, decodes and bakes
+                if (m_iteration == 0)
+                {
+                    for (const auto& modelFile : m_modelFiles)
+                    {
+                        std::error_code errorCode;
+                        std::filesystem::remove(getModelCachePath(config::kModelDir / modelFile), errorCode);
+                    }
+                }
+                config.mUseBakedCache = true;
+                return runSequential(config);
+            }
+
+            case LoadCase::kConcurrent:
+                return runConcurrent(config);
+
+            default:
+                return false;
+        }
+    }
+
+    bool LoadBench::runSequential(const GLTFLoadConfig& config) noexcept
+    {
+        auto device = m_device.lock();
+        if (!device)
+        {
+            return false;
+        }
+
+        CaseResults& results = m_results[static_cast<size_t>(m_case)];
+        m_loadedModels.resize(m_modelFiles.size());
+        for (size_t i = 0; i < m_modelFiles.size(); ++i)
+        {
+            LoadedModel& loaded = m_loadedModels[i];
+            loaded.mModel = std::make_unique<GLTFModel>();
+            if (!loaded.mModel->load(*device, m_stagingBelt, m_modelFiles[i], config))
+            {
+                VK_LOG_ERROR("LoadBench::runSequential : failed to load %s", m_modelFiles[i].c_str());
+                return false;
+            }
+
+            LoadSample sample{};
+            sample.mTimings = loaded.mModel->getLoadTimings();
+            if (!setupDescriptors(loaded, sample))
+            {
+                return false;
+            }
+            results.mSamples[i].push_back(sample);
+        }
+        return true;
+    }
+
+    bool LoadBench::runConcurrent(const GLTFLoadConfig& config) noexcept
+    {
+        auto device = m_device.lock();
+        if (!device)
+        {
+            return false;
+        }
+
+        // every decode is started before the first upload, the batch is done once the last model is resident
+        CaseResults& results = m_results[static_cast<size_t>(m_case)];
+        m_loadedModels.resize(m_modelFiles.size());
+        const auto batchStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < m_modelFiles.size(); ++i)
+        {
+            m_loadedModels[i].mModel = std::make_unique<GLTFModel>();
+            m_loadedModels[i].mModel->loadAsync(*device, m_modelFiles[i], config);
+        }
+
+        for (size_t i = 0; i < m_modelFiles.size(); ++i)
+        {
+            if (!m_loadedModels[i].mModel->finishLoad(*device, m_stagingBelt))
+            {
+                VK_LOG_ERROR("LoadBench::runConcurrent : failed to load %s", m_modelFiles[i].c_str());
+                return false;
+            }
+        }
+        results.mBatchMs.push_back(getMillisecondsSince(batchStart));
+
+        // per model timings cover the decode only, the upload is part of the batch
+        for (size_t i = 0; i < m_modelFiles.size(); ++i)
+        {
+            LoadSample sample{};
+            sample.mTimings = m_loadedModels[i].mModel->getLoadTimings();
+            if (!setupDescriptors(m_loadedModels[i], sample))
+            {
+                return false;
+            }
+            results.mSamples[i].push_back(sample);
+        }
+        return true;
+    }
+
+    bool LoadBench::setupDescriptors(LoadedModel& loaded, LoadSample& sample) noexcept
+    {
+        // a pool sized for the model alone, as a renderer creating it on load would
+        const auto start = std::chrono::steady_clock::now();
+        loaded.mDescriptorAllocator = std::make_unique<VulkanDescriptorAllocator>();
+        loaded.mDescriptorAllocator->addRequirements(loaded.mModel->getDescriptorRequirements());
+        if (!loaded.mDescriptorAllocator->initialize(m_vkDevice) || !loaded.mModel->allocateDescriptorSets(*loaded.mDescriptorAllocator))
+        {
+            VK_LOG_ERROR("LoadBench::setupDescriptors : failed to allocate descriptor sets");
+            return false;
+        }
+        loaded.mModel->updateDescriptorSets(m_samplers);
+        sample.mDescriptorMs = getMillisecondsSince(start);
+        return true;
+    }
+
+    void LoadBench::releaseModels() noexcept
+    {
+        // models before the pools their sets came from
+        for (auto& loaded : m_loadedModels)
+        {
+            loaded.mModel.reset();
+            loaded.mDescriptorAllocator.reset();
+        }
+        m_loadedModels.clear();
+    }
+
+    void LoadBench::finishBenchmark() noexcept
+    {
+        m_isBenchmarkRunning = false;
+        m_isBenchmarkComplete = true;
+
+        logSummary();
+        writeSummaryJson(m_benchmarkOutput);
+    }
+
+    void LoadBench::logSummary() const noexcept
+    {
+        for (uint8_t caseIdx = 0; caseIdx < static_cast<uint8_t>(LoadCase::kCount); ++caseIdx)
+        {
+            const CaseResults& results = m_results[caseIdx];
+            const char* caseName = getCaseName(static_cast<LoadCase>(caseIdx));
+            for (size_t i = 0; i < m_modelFiles.size(); ++i)
+            {
+                const auto& samples = results.mSamples[i];
+                if (samples.empty())
+                {
+                    continue;
+                }
+
+                double coldTotal = 0.0, warmTotal = 0.0, coldParse = 0.0, warmParse = 0.0, coldTextures = 0.0, warmTextures = 0.0;
+                double coldUpload = 0.0, warmUpload = 0.0, coldDescriptors = 0.0, warmDescriptors = 0.0, coldRate = 0.0, warmRate = 0.0;
+                getColdWarm(samples, [](const LoadSample& s) { return s.mTimings.mTotal; }, coldTotal, warmTotal);
+                getColdWarm(samples, [](const LoadSample& s) { return s.mTimings.mParse; }, coldParse, warmParse);
+                getColdWarm(samples, [](const LoadSample& s) { return s.mTimings.mTextures; }, coldTextures, warmTextures);
+                getColdWarm(samples, [](const LoadSample& s) { return s.mTimings.mUpload; }, coldUpload, warmUpload);
+                getColdWarm(samples, [](const LoadSample& s) { return s.mDescriptorMs; }, coldDescriptors, warmDescriptors);
+                getColdWarm(samples, [](const LoadSample& s) { return getThroughputMbps(s.mTimings); }, coldRate, warmRate);
+
+                VK_LOG_INFO("LoadBench : %-10s %-24s cold %8.2f ms warm %8.2f ms | parse %.2f/%.2f textures %.2f/%.2f upload %.2f/%.2f "
+                            "descriptors %.3f/%.3f ms | %.1f/%.1f MB/s", caseName, m_modelFiles[i].c_str(), coldTotal, warmTotal,
+                            coldParse, warmParse, coldTextures, warmTextures, coldUpload, warmUpload, coldDescriptors, warmDescriptors,
+                            coldRate, warmRate);
+            }
+
+            if (!results.mBatchMs.empty())
+            {
+                const double batchSum = std::accumulate(results.mBatchMs.begin(), results.mBatchMs.end(), 0.0);
+                VK_LOG_INFO("LoadBench : %-10s batch of %zu models: cold %.2f ms, mean %.2f ms", caseName, m_modelFiles.size(),
+                            results.mBatchMs.front(), batchSum / static_cast<double>(results.mBatchMs.size()));
+            }
+            VK_LOG_INFO("LoadBench : %-10s peak resident memory %.1f MB", caseName, results.mPeakRssMb);
+        }
+    }
+
+    bool LoadBench::writeSummaryJson(const std::filesystem::path& filepath) const noexcept
+    {
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            VK_LOG_ERROR("LoadBench::writeSummaryJson : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        // one object per case, one entry per model with the cold and warm value of every stage (milliseconds)
+        file << std::fixed << std::setprecision(4);
+        file << "{\n";
+        file << "  \"iterations\": " << m_iterationCount << ",\n";
+        file << "  \"cases\": {";
+        for (uint8_t caseIdx = 0; caseIdx < static_cast<uint8_t>(LoadCase::kCount); ++caseIdx)
+        {
+            const CaseResults& results = m_results[caseIdx];
+            file << (caseIdx == 0 ? "\n" : ",\n");
+            file << "    \"" << getCaseName(static_cast<LoadCase>(caseIdx)) << "\": {\n";
+            file << "      \"peak_rss_mb\": " << results.mPeakRssMb << ",\n";
+            if (!results.mBatchMs.empty())
+            {
+                const double batchSum = std::accumulate(results.mBatchMs.begin(), results.mBatchMs.end(), 0.0);
+                file << "      \"batch_ms\": { \"cold\": " << results.mBatchMs.front()
+                     << ", \"mean\": " << batchSum / static_cast<double>(results.mBatchMs.size()) << " },\n";
+            }
+
+            file << "      \"models\": [";
+            for (size_t i = 0; i < m_modelFiles.size(); ++i)
+            {
+                const auto& samples = results.mSamples[i];
+                file << (i == 0 ? "\n" : ",\n");
+                file << "        { \"file\": \"" << escapeJson(m_modelFiles[i]) << "\", "
+                     << "\"samples\": " << samples.size() << ", "
+                     << "\"bytes\": " << (samples.empty() ? 0 : samples.front().mTimings.mSourceBytes) << ", "
+                     << "\"from_cache\": " << ((!samples.empty() && samples.back().mTimings.mIsFromCache) ? "true" : "false");
+
+                double cold = 0.0, warm = 0.0;
+                for (const StageField& stage : kStageFields)
+                {
+                    getColdWarm(samples, [&stage](const LoadSample& s) { return s.mTimings.*stage.mField; }, cold, warm);
+                    file << ", \"" << stage.mName << "\": [" << cold << ", " << warm << "]";
+                }
+                getColdWarm(samples, [](const LoadSample& s) { return s.mDescriptorMs; }, cold, warm);
+                file << ", \"descriptors_ms\": [" << cold << ", " << warm << "]";
+                getColdWarm(samples, [](const LoadSample& s) { return getThroughputMbps(s.mTimings); }, cold, warm);
+                file << ", \"throughput_mbps\": [" << cold << ", " << warm << "] }";
+            }
+            file << "\n      ]\n    }";
+        }
+        file << "\n  }\n}\n";
+
+        VK_LOG_INFO("LoadBench::writeSummaryJson : results written to %s", filepath.string().c_str());
+        return static_cast<bool>(file);
+    }
+
+    const char* LoadBench::getCaseName(LoadCase loadCase) noexcept
+    {
+        switch (loadCase)
+        {
+            case LoadCase::kSource:     return "source";
+            case LoadCase::kBaked:      return "baked";
+            case LoadCase::kConcurrent: return "concurrent";
+            default:                    return "unknown";
+        }
+    }
+
+    double LoadBench::getPeakRssMb() noexcept
+    {
+        // high water mark of the whole process so far, not of a single case
+#ifdef PLATFORM_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return 0.0;
+        }
+        return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+        struct rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;     // kilobytes
+#endif
+    }
+}   // namespace keplar
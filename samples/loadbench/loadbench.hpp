@@ -0,0 +1,116 @@
+// ────────────────────────────────────────────
+//  File: loadbench.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <filesystem>
+
+#include "graphics/renderer.hpp"
+#include "platform/platform.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_descriptor_allocator.hpp"
+#include "vulkan/vulkan_samplers.hpp"
+
+#include "graphics/gltf_model.hpp"
+
+namespace keplar
+{
+    // the ways a model reaches resident, measured one after another
+    enum class LoadCase : uint8_t
+    {
+        kSource,            // tinygltf parse and full decode, no baked cache
+        kBaked,             // baked cache: the first iteration bakes it (cold), the rest read the mapped .kmodel (warm)
+        kConcurrent,        // every model decoded at once through loadAsync, then finished one by one
+        kCount
+    };
+
+    // asset loading benchmark: loads each model under every LoadCase for a number of iterations and reports the stage
+    // timings of GLTFLoadTimings, descriptor setup, throughput and peak resident memory. iteration 0 of a case is reported
+    // as cold and the mean of the others as warm; the summary is logged and written as json to the benchmark output.
+    // one iteration runs per frame so the app loop keeps pumping, nothing is presented
+    class LoadBench : public Renderer
+    {
+        public:
+            static constexpr uint32_t kDefaultIterations = 5;
+
+            // creation and destruction
+            explicit LoadBench(std::vector<std::string> modelFiles) noexcept;
+            ~LoadBench();
+
+            // core renderer interface: initialize, update, render
+            virtual bool initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept override;
+            virtual void update(float) noexcept override {}
+            virtual bool render() noexcept override;
+
+            // benchmark runs: frameCount is the iteration count of every case
+            virtual bool startBenchmark(uint32_t frameCount, const std::filesystem::path& outputPath) noexcept override;
+            virtual bool isBenchmarkComplete() const noexcept override { return m_isBenchmarkComplete; }
+
+        private:
+            // a loaded model and the pool its descriptor sets came from (freed after the model)
+            struct LoadedModel
+            {
+                std::unique_ptr<VulkanDescriptorAllocator>  mDescriptorAllocator;
+                std::unique_ptr<GLTFModel>                  mModel;
+            };
+
+            // one load of one model
+            struct LoadSample
+            {
+                GLTFLoadTimings mTimings;
+                double          mDescriptorMs = 0.0;    // pool creation, set allocation and writes
+            };
+
+            // every iteration of one case, per model; concurrent batches also keep their wall time
+            struct CaseResults
+            {
+                std::vector<std::vector<LoadSample>>    mSamples;
+                std::vector<double>                     mBatchMs;
+                double                                  mPeakRssMb = 0.0;   // process peak once the case finished
+            };
+
+            bool runIteration() noexcept;
+            bool runSequential(const GLTFLoadConfig& config) noexcept;
+            bool runConcurrent(const GLTFLoadConfig& config) noexcept;
+            bool setupDescriptors(LoadedModel& loaded, LoadSample& sample) noexcept;
+            void releaseModels() noexcept;
+            void finishBenchmark() noexcept;
+            void logSummary() const noexcept;
+            bool writeSummaryJson(const std::filesystem::path& filepath) const noexcept;
+
+            static const char* getCaseName(LoadCase loadCase) noexcept;
+            static double getPeakRssMb() noexcept;
+
+        private:
+            // core dependencies
+            std::weak_ptr<Platform>             m_platform;
+            std::weak_ptr<VulkanContext>        m_context;
+            std::weak_ptr<VulkanDevice>         m_device;
+            VkDevice                            m_vkDevice;
+
+            // upload path and samplers every model's descriptor sets are written with
+            VulkanStagingBelt                   m_stagingBelt;
+            VulkanSamplers                      m_samplers;
+            std::atomic<bool>                   m_readyToRender;
+
+            // models under test and the loads of the current iteration
+            std::vector<std::string>            m_modelFiles;
+            std::vector<LoadedModel>            m_loadedModels;
+
+            // benchmark progress and results
+            std::filesystem::path               m_benchmarkOutput;
+            uint32_t                            m_iterationCount;
+            uint32_t                            m_iteration;
+            LoadCase                            m_case;
+            bool                                m_isBenchmarkRunning;
+            bool                                m_isBenchmarkComplete;
+            std::array<CaseResults, static_cast<size_t>(LoadCase::kCount)> m_results;
+    };
+}   // namespace keplar
@@ -0,0 +1,54 @@
+// ────────────────────────────────────────────
+//  File: main.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/keplar_app.hpp"
+#include "utils/logger.hpp"
+#include "samples/loadbench/loadbench.hpp"
+
+int main(int argc, char* argv[])
+{
+    // start the logging thread early
+    keplar::Logger::getInstance();
+
+    // --model <file> (repeatable, relative to the model directory) picks the models, the rest goes to the app
+    std::vector<std::string> modelFiles;
+    std::vector<char*> appArgs = { argv[0] };
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--model" && i + 1 < argc)
+        {
+            modelFiles.emplace_back(argv[++i]);
+            continue;
+        }
+        appArgs.push_back(argv[i]);
+    }
+
+    if (modelFiles.empty())
+    {
+        modelFiles = { "DamagedHelmet.glb", "flighthelmet.glb" };
+    }
+
+    // always a benchmark run: --benchmark [iterations] sets the iterations per case, headless unless --windowed
+    keplar::KeplarAppOptions options = keplar::KeplarAppOptions::fromCommandLine(static_cast<int>(appArgs.size()), appArgs.data());
+    if (options.mBenchmarkFrames == 0)
+    {
+        options.mBenchmarkFrames = keplar::LoadBench::kDefaultIterations;
+        options.mHeadless = true;
+    }
+
+    // create and initialize app
+    keplar::KeplarApp app;
+    if (!app.initialize(std::make_unique<keplar::LoadBench>(std::move(modelFiles)), options))
+    {
+        VK_LOG_FATAL("failed to initialize Keplar application");
+        return EXIT_FAILURE;
+    }
+
+    // run the main loop until every case finished
+    return app.run();
+}
@@ -0,0 +1,24 @@
+// ────────────────────────────────────────────
+//  File: main.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "core/keplar_app.hpp"
+#include "utils/logger.hpp"
+#include "samples/stress/stress.hpp"
+
+int main([[maybe_unused]]int argc, [[maybe_unused]] char* argv[])
+{
+    // start the logging thread early
+    keplar::Logger::getInstance();
+
+    // create and initialize app
+    keplar::KeplarApp app;
+    if (!app.initialize(std::make_unique<keplar::Stress>()))
+    {
+        VK_LOG_FATAL("failed to initialize Keplar application");
+        return EXIT_FAILURE;
+    }
+
+    // run the main loop until app exit
+    return app.run();
+}
@@ -0,0 +1,17 @@
+// ────────────────────────────────────────────
+//  File: shader_structs.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "graphics/math3d.hpp"
+
+namespace keplar::ubo
+{
+    // placements carry their own transforms, so only the camera is per frame
+    struct alignas(16) FrameData
+    {
+        glm::mat4 projection;
+        glm::mat4 view;
+    };
+}   // namespace keplar
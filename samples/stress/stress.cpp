@@ -0,0 +1,1479 @@
+// ────────────────────────────────────────────
+//  File: stress.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "stress.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include "core/keplar_config.hpp"
+#include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
+#include "vulkan/vulkan_utils.hpp"
+#include "vulkan/vulkan_command_recorder.hpp"
+
+namespace
+{
+    // placements are scattered through a cube whose side grows with their cube root, at about this many units apart
+    constexpr float kPlacementSpacing   = 3.0f;
+    constexpr float kFlightHelmetScale  = 3.0f;     // the flight helmet is modeled about a third of the damaged helmet's size
+    constexpr uint32_t kPlacementSeed   = 0x5eed;   // the same count always lays out the same field
+    constexpr double kLogInterval       = 2.0;      // seconds between running reports
+
+    // the placements are split into full meshes and impostors again once the camera moved this far
+    constexpr float kImpostorResplitDistance = 0.25f * kPlacementSpacing;
+
+    const char* getStrategyName(keplar::SubmissionStrategy strategy) noexcept
+    {
+        switch (strategy)
+        {
+            case keplar::SubmissionStrategy::kCpuPerDraw:       return "cpu per draw";
+            case keplar::SubmissionStrategy::kMultiThreaded:    return "multi-threaded";
+            case keplar::SubmissionStrategy::kInstanced:        return "instanced";
+            case keplar::SubmissionStrategy::kIndirect:         return "indirect";
+            default:                                            return "unknown";
+        }
+    }
+
+    double toMilliseconds(std::chrono::steady_clock::duration duration) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+namespace keplar
+{
+    Stress::Stress() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_presentQueue(VK_NULL_HANDLE)
+        , m_graphicsQueue(VK_NULL_HANDLE)
+        , m_vkSwapchainKHR(VK_NULL_HANDLE)
+        , m_windowWidth(0)
+        , m_windowHeight(0)
+        , m_swapchainImageCount(0)
+        , m_maxFramesInFlight(0)
+        , m_currentImageIndex(0)
+        , m_currentFrameIndex(0)
+        , m_readyToRender(false)
+        , m_recordWorkerCount(0)
+        , m_placementCount(kDefaultPlacements)
+        , m_fieldExtent(0.0f)
+        , m_splitPosition(0.0f)
+        , m_isImpostorEnabled(true)
+        , m_isSplitDirty(true)
+        , m_strategy(SubmissionStrategy::kCpuPerDraw)
+        , m_settleFrames(0)
+        , m_totalStats{}
+        , m_windowStats{}
+        , m_windowStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    Stress::~Stress()
+    {
+        // stop any new rendering tasks from being submitted
+        m_readyToRender.store(false);
+
+        // unregister listeners from the platform
+        if (auto platform = m_platform.lock())
+        {
+            platform->removeListener(m_camera);
+        }
+
+        // ensure gpu has finished executing all submitted commands
+        vkDeviceWaitIdle(m_vkDevice);
+
+        // the measurements of every strategy that ran
+        logSummary();
+
+        // destroy vulkan resources; workers are joined before their allocators go
+        m_gpuProfiler.destroy();
+        GLTFModel::destroySharedResources(m_vkDevice);
+        m_swapchain.reset();
+        m_recordThreadPool.reset();
+        for (auto& workerAllocator : m_workerAllocators)
+        {
+            workerAllocator->destroy();
+        }
+        m_frameCommandAllocator.destroy();
+    }
+
+    bool Stress::initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept
+    {
+        // store non-owning references
+        m_platform = platform;
+        m_context = context;
+
+        // acquire shared access to context and platform
+        auto contextLocked = m_context.lock();
+        auto platformLocked = m_platform.lock();
+        if (!contextLocked || !platformLocked)
+        {
+            return false;
+        }
+
+        // store non-owning device reference and acquire shared access
+        m_device = contextLocked->getDevice();
+        auto device = m_device.lock();
+        if (!device)
+        {
+            return false;
+        }
+
+        // setup resources and cache vulkan handles
+        m_swapchain       = std::make_unique<VulkanSwapchain>(contextLocked->getSurface(), m_device);
+        m_vkDevice        = device->getDevice();
+        m_presentQueue    = device->getPresentQueue();
+        m_graphicsQueue   = device->getGraphicsQueue();
+        m_vkSwapchainKHR  = m_swapchain->get();
+        m_windowWidth     = platformLocked->getWindowWidth();
+        m_windowHeight    = platformLocked->getWindowHeight();
+
+        // initialize vulkan resources
+        if (!KEPLAR_STARTUP_STEP(createSwapchain()))                { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDepthTarget()))              { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandAllocator(*device)))  { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRecordWorkers(*device)))     { return false; }
+        if (!KEPLAR_STARTUP_STEP(createStagingBelt(*device)))       { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandBuffers()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createTextureSamplers(*device)))   { return false; }
+        if (!KEPLAR_STARTUP_STEP(loadAssets(*device)))              { return false; }
+        if (!KEPLAR_STARTUP_STEP(createUniformBuffers(*device)))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createShaderModules()))            { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSetLayouts()))     { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorPool()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSets()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRenderPasses()))             { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGraphicsPipelines(*device))) { return false; }
+        if (!KEPLAR_STARTUP_STEP(createFramebuffers()))             { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSyncPrimitives()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGpuProfiler(*device)))       { return false; }
+        if (!KEPLAR_STARTUP_STEP(createImpostors(*device)))         { return false; }
+        if (!KEPLAR_STARTUP_STEP(prepareScene()))                   { return false; }
+
+        VK_LOG_INFO("Stress::initialize successful (keys 1-4: strategy, Z/X: halve/double placements, I: impostors)");
+        return true;
+    }
+
+    void Stress::update(float dt) noexcept
+    {
+        // placements are static, only the camera moves
+        m_camera->update(dt);
+    }
+
+    bool Stress::render() noexcept
+    {
+        // skip frame if renderer is not ready
+        if (!m_readyToRender.load())
+        {
+            VK_LOG_DEBUG("Stress::beginFrame skipped: renderer not ready");
+            return true;
+        }
+
+        // wait on the fence for this frame to ensure gpu finished work from last time
+        auto& frameSync = m_frameSyncPrimitives[m_currentFrameIndex];
+        if (!frameSync.mInFlightFence.wait())
+        {
+            return false;
+        }
+
+        // frame-specific semaphores and fence
+        const auto imageAcquireSemaphore    = frameSync.mImageAvailableSemaphore.get();
+        const auto renderCompleteSemaphore  = frameSync.mRenderCompleteSemaphore.get();
+        const auto inFlightFence            = frameSync.mInFlightFence.get();
+
+        // acquire next image from swapchain, signaling the image available semaphore
+        VkResult vkResult = vkAcquireNextImageKHR(m_vkDevice, m_vkSwapchainKHR, UINT64_MAX, imageAcquireSemaphore, VK_NULL_HANDLE, &m_currentImageIndex);
+        if (vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_SUBOPTIMAL_KHR)
+        {
+            VK_LOG_DEBUG("vkAcquireNextImageKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            onWindowResize(m_windowWidth, m_windowHeight);
+            return true;
+        }
+        else if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkAcquireNextImageKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // wait if this swapchain image is still in flight
+        VkFence& imageFence = m_imagesInFlightFences[m_currentImageIndex];
+        if (imageFence != VK_NULL_HANDLE)
+        {
+            vkResult = vkWaitForFences(m_vkDevice, 1, &imageFence, VK_TRUE, UINT64_MAX);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_ERROR("vkWaitForFences failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                return false;
+            }
+        }
+
+        // mark this image as now owned by current frame fence
+        imageFence = inFlightFence;
+
+        // reset current frame fence before submitting new gpu work
+        if (!frameSync.mInFlightFence.reset())
+        {
+            return false;
+        }
+
+        // the frame's gpu work is done: recycle its transient command buffers, the workers' included
+        if (!m_frameCommandAllocator.beginFrame(m_currentFrameIndex))
+        {
+            return false;
+        }
+        for (auto& workerAllocator : m_workerAllocators)
+        {
+            if (!workerAllocator->beginFrame(m_currentFrameIndex))
+            {
+                return false;
+            }
+        }
+        m_primaryCommandBuffers[m_currentFrameIndex] = m_frameCommandAllocator.allocatePrimary();
+
+        // update per-frame resources
+        if (!updatePerFrame(m_currentFrameIndex))
+        {
+            return false;
+        }
+
+        // cull and record the scene with the current strategy (timed), then the primary that executes it
+        if (!recordSceneCommandBuffers(m_currentFrameIndex))
+        {
+            return false;
+        }
+
+        if (!recordFrameCommandBuffer(m_currentFrameIndex, m_currentImageIndex))
+        {
+            return false;
+        }
+
+        // prepare command buffers to submit
+        VkCommandBuffer commandBuffer = m_primaryCommandBuffers[m_currentFrameIndex].get();
+        const VkPipelineStageFlags waitDstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+        // setup queue submit info
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType                 = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                 = nullptr;
+        submitInfo.pWaitDstStageMask     = &waitDstStageMask;
+        submitInfo.waitSemaphoreCount    = 1;
+        submitInfo.pWaitSemaphores       = &imageAcquireSemaphore;
+        submitInfo.commandBufferCount    = 1;
+        submitInfo.pCommandBuffers       = &commandBuffer;
+        submitInfo.signalSemaphoreCount  = 1;
+        submitInfo.pSignalSemaphores     = &renderCompleteSemaphore;
+
+        // submit command buffer to graphics queue with fence to track GPU work
+        if (!VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, inFlightFence)))
+        {
+            return false;
+        }
+
+        // prepare present info to present the rendered image
+        VkPresentInfoKHR presentInfo{};
+        presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.pNext               = nullptr;
+        presentInfo.waitSemaphoreCount  = 1;
+        presentInfo.pWaitSemaphores     = &renderCompleteSemaphore;
+        presentInfo.swapchainCount      = 1;
+        presentInfo.pSwapchains         = &m_vkSwapchainKHR;
+        presentInfo.pImageIndices       = &m_currentImageIndex;
+
+        // queue the present operation
+        vkResult = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+        if (vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_SUBOPTIMAL_KHR)
+        {
+            VK_LOG_DEBUG("vkQueuePresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            onWindowResize(m_windowWidth, m_windowHeight);
+            return true;
+        }
+        else if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkQueuePresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // advance to the next frame sync object (cycling through available frames in flight)
+        m_currentFrameIndex = (m_currentFrameIndex + 1) % m_maxFramesInFlight;
+        return true;
+    }
+
+    void Stress::configureVulkan(VulkanContextConfig& config) noexcept
+    {
+        // enable sampler anisotropy for higher quality texture filtering
+        config.mRequestedFeatures.samplerAnisotropy = VK_TRUE;
+
+        // one indirect call per material in the indirect strategy; without it every run is its own call
+        config.mRequestedFeatures.multiDrawIndirect = VK_TRUE;
+    }
+
+    void Stress::onWindowResize(uint32_t width, uint32_t height)
+    {
+        // window minimized or device not available: stop rendering
+        auto device = m_device.lock();
+        if (width == 0 || height == 0 || !device)
+        {
+            m_readyToRender.store(false);
+            return;
+        }
+
+        // stop rendering and wait for device to finish all operations
+        m_readyToRender.store(false);
+        vkDeviceWaitIdle(m_vkDevice);
+
+        // recreate swapchain with new dimensions; a display rotation changes the pre-rotation with it
+        if (!m_swapchain->recreate(width, height))
+        {
+            return;
+        }
+
+        if (m_camera)
+        {
+            m_camera->setPreRotation(m_swapchain->getPreRotation());
+        }
+
+        // update swapchain handle and image count
+        m_vkSwapchainKHR      = m_swapchain->get();
+        m_swapchainImageCount = m_swapchain->getImageCount();
+
+        // reset per-image fence ownership for the new swapchain images
+        m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
+
+        // teardown all dependent resources (framebuffers, pipelines, renderpass)
+        for (auto& framebuffer : m_framebuffers)
+        {
+            framebuffer.destroy();
+        }
+
+        m_drawPipeline.destroy();
+        m_instancedPipeline.destroy();
+        m_impostorPipeline.destroy();
+        m_renderPass.destroy();
+
+        // recreate all dependent resources
+        if (!createDepthTarget())               { return; }
+        if (!createCommandBuffers())            { return; }
+        if (!createRenderPasses())              { return; }
+        if (!createGraphicsPipelines(*device))  { return; }
+        if (!createFramebuffers())              { return; }
+
+        // update window dimensions
+        m_windowWidth  = width;
+        m_windowHeight = height;
+
+        // the first frames after a resize are not representative; the switch distance follows the window height
+        m_currentFrameIndex = 0;
+        m_isSplitDirty = true;
+        m_settleFrames = GLTFModel::kMaxFramesInFlight + 1;
+
+        // resume rendering
+        m_readyToRender.store(true);
+    }
+
+    void Stress::onKeyPressed(uint32_t key)
+    {
+        // 1-4 select the submission strategy
+        if (key >= '1' && key < '1' + static_cast<uint32_t>(SubmissionStrategy::kCount))
+        {
+            setStrategy(static_cast<SubmissionStrategy>(key - '1'));
+            return;
+        }
+
+        // Z and X halve and double the placements within what the models' buffers hold
+        if (key == 'Z' || key == 'X')
+        {
+            const uint32_t count = key == 'Z' ? m_placementCount / 2 : m_placementCount * 2;
+            generatePlacements(std::clamp(count, kMinPlacements, kMaxHelmetPlacements));
+            return;
+        }
+
+        // I switches distant placements between impostors and their full meshes
+        if (key == 'I')
+        {
+            setImpostorsEnabled(!m_isImpostorEnabled);
+        }
+    }
+
+    bool Stress::createSwapchain() noexcept
+    {
+        // setup swapchain: rendering straight into its images, the projection takes over the display rotation
+        VulkanSwapchainPolicy policy = m_swapchain->getPolicy();
+        policy.mPreRotation = true;
+        m_swapchain->updatePolicy(policy);
+        if (!m_swapchain->initialize(m_windowWidth, m_windowHeight))
+        {
+            VK_LOG_ERROR("Stress::createSwapchain : failed to create swapchain for presentation.");
+            return false;
+        }
+
+        // retrieve swapchain handle and image count
+        m_vkSwapchainKHR = m_swapchain->get();
+        m_swapchainImageCount = m_swapchain->getImageCount();
+
+        // frames in flight are a budget of their own, not derived from the image count (see config::kFramesInFlight)
+        m_maxFramesInFlight = config::kFramesInFlight;
+
+        VK_LOG_INFO("Stress::createSwapchain : swapchain created successfully (max frames in flight: %d)", m_maxFramesInFlight);
+        return true;
+    }
+
+    bool Stress::createDepthTarget() noexcept
+    {
+        // no msaa: the test is about submission, depth goes into the swapchain's own target
+        if (!m_swapchain->setDepthAttachment(true))
+        {
+            VK_LOG_ERROR("Stress::createDepthTarget : failed to create swapchain depth target.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Stress::createCommandAllocator(const VulkanDevice& device) noexcept
+    {
+        // transient per-frame pools for the render thread's primaries and secondaries, re-recorded every frame
+        const auto graphicsFamilyIndex = device.getQueueFamilyIndices().mGraphicsFamily;
+        if (!m_frameCommandAllocator.initialize(m_vkDevice, graphicsFamilyIndex.value(), GLTFModel::kMaxFramesInFlight))
+        {
+            VK_LOG_ERROR("Stress::createCommandAllocator : failed to initialize frame command allocator.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createCommandAllocator successful");
+        return true;
+    }
+
+    bool Stress::createRecordWorkers(const VulkanDevice& device) noexcept
+    {
+        // one worker per core up to the limit; one core leaves the multi-threaded strategy on the render thread
+        const uint32_t workerCount = std::min(kMaxRecordWorkers, std::thread::hardware_concurrency());
+        if (workerCount < 2)
+        {
+            VK_LOG_INFO("Stress::createRecordWorkers single core, the multi-threaded strategy records on the render thread");
+            return true;
+        }
+
+        // command pools are externally synchronized: every worker records from its own transient allocator
+        const uint32_t graphicsFamilyIndex = device.getQueueFamilyIndices().mGraphicsFamily.value();
+        m_workerAllocators.clear();
+        for (uint32_t worker = 0; worker < workerCount; ++worker)
+        {
+            auto workerAllocator = std::make_unique<VulkanFrameCommandAllocator>();
+            if (!workerAllocator->initialize(m_vkDevice, graphicsFamilyIndex, GLTFModel::kMaxFramesInFlight))
+            {
+                VK_LOG_ERROR("Stress::createRecordWorkers failed to initialize worker command allocator.");
+                return false;
+            }
+            m_workerAllocators.push_back(std::move(workerAllocator));
+        }
+
+        m_recordThreadPool = std::make_unique<ThreadPool>(workerCount, 0, "record");
+        m_recordWorkerCount = workerCount;
+        VK_LOG_DEBUG("Stress::createRecordWorkers successful (%u workers)", workerCount);
+        return true;
+    }
+
+    bool Stress::createStagingBelt(const VulkanDevice& device) noexcept
+    {
+        // persistently mapped staging ring shared by all host-to-device uploads
+        if (!m_stagingBelt.initialize(device))
+        {
+            VK_LOG_ERROR("Stress::createStagingBelt : failed to initialize staging belt.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createStagingBelt successful");
+        return true;
+    }
+
+    bool Stress::createCommandBuffers() noexcept
+    {
+        // primaries and scene secondaries are taken from the frame command allocators when each frame begins
+        m_primaryCommandBuffers.assign(m_maxFramesInFlight, VulkanCommandBuffer{});
+        m_sceneCommandBuffers.reserve(kMaxRecordWorkers);
+        return true;
+    }
+
+    bool Stress::createTextureSamplers(const VulkanDevice& device) noexcept
+    {
+        // create predefined samplers
+        if (!m_samplers.initialize(device))
+        {
+            VK_LOG_ERROR("Stress::createTextureSamplers failed to create samplers.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createTextureSamplers successful");
+        return true;
+    }
+
+    bool Stress::loadAssets(const VulkanDevice& device) noexcept
+    {
+        // initialize shared resources
+        GLTFModel::initSharedResources(m_vkDevice);
+
+        // two models so placements mix materials; buffers sized for every placement either may take
+        GLTFLoadConfig loadConfig{};
+        loadConfig.mVertexFormat   = GLTFVertexFormat::kPacked;
+        loadConfig.mOptimizeMeshes = true;
+        loadConfig.mUseBakedCache  = true;
+
+        loadConfig.mMaxPlacements = kMaxHelmetPlacements;
+        if (!m_models[0].load(device, m_stagingBelt, "DamagedHelmet.glb", loadConfig))
+        {
+            VK_LOG_ERROR("Stress::loadAssets failed to load DamagedHelmet.glb");
+            return false;
+        }
+
+        loadConfig.mMaxPlacements = kMaxFlightHelmetPlacements;
+        if (!m_models[1].load(device, m_stagingBelt, "flighthelmet.glb", loadConfig))
+        {
+            VK_LOG_ERROR("Stress::loadAssets failed to load flighthelmet.glb");
+            return false;
+        }
+
+        // one pipeline per strategy draws both models
+        if (m_models[0].getVertexFormat() != m_models[1].getVertexFormat())
+        {
+            VK_LOG_ERROR("Stress::loadAssets models loaded with different vertex formats");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::loadAssets successful");
+        return true;
+    }
+
+    bool Stress::createUniformBuffers(const VulkanDevice& device) noexcept
+    {
+        // one host-visible camera buffer per frame that can be in flight
+        m_uniformBuffers.resize(GLTFModel::kMaxFramesInFlight);
+
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        bufferCreateInfo.size  = sizeof(ubo::FrameData);
+
+        for (auto& uniformBuffer : m_uniformBuffers)
+        {
+            if (!uniformBuffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true))
+            {
+                VK_LOG_ERROR("Stress::createUniformBuffers failed to create host visible buffer for uniform data");
+                return false;
+            }
+        }
+
+        VK_LOG_DEBUG("Stress::createUniformBuffers successful");
+        return true;
+    }
+
+    bool Stress::createShaderModules() noexcept
+    {
+        // per-draw transforms come from push constants, instanced ones from the instance binding
+        if (!m_vertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, "stress/stress.vert.spv"))
+        {
+            VK_LOG_ERROR("Stress::createShaderModules failed for vertex shader");
+            return false;
+        }
+
+        if (!m_instancedVertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, "stress/stress_instanced.vert.spv"))
+        {
+            VK_LOG_ERROR("Stress::createShaderModules failed for instanced vertex shader");
+            return false;
+        }
+
+        if (!m_fragmentShader.initialize(m_vkDevice, VK_SHADER_STAGE_FRAGMENT_BIT, "stress/stress.frag.spv"))
+        {
+            VK_LOG_ERROR("Stress::createShaderModules failed for fragment shader");
+            return false;
+        }
+
+        // impostor quads: built from the instance transform alone, shaded from the atlases
+        if (!m_impostorVertexShader.initialize(m_vkDevice, VK_SHADER_STAGE_VERTEX_BIT, "stress/impostor.vert.spv") ||
+            !m_impostorFragmentShader.initialize(m_vkDevice, VK_SHADER_STAGE_FRAGMENT_BIT, "stress/impostor.frag.spv"))
+        {
+            VK_LOG_ERROR("Stress::createShaderModules failed for impostor shaders");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createShaderModules successful");
+        return true;
+    }
+
+    bool Stress::createDescriptorSetLayouts() noexcept
+    {
+        // binding: 0, type: uniform buffer
+        VkDescriptorSetLayoutBinding uboBinding{};
+        uboBinding.binding                  = 0;
+        uboBinding.descriptorType           = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        uboBinding.descriptorCount          = 1;
+        uboBinding.stageFlags               = VK_SHADER_STAGE_VERTEX_BIT;
+        uboBinding.pImmutableSamplers       = nullptr;
+
+        // descriptor set layout creation info
+        VkDescriptorSetLayoutCreateInfo descriptorSetlayoutInfo{};
+        descriptorSetlayoutInfo.sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        descriptorSetlayoutInfo.pNext          = nullptr;
+        descriptorSetlayoutInfo.flags          = 0;
+        descriptorSetlayoutInfo.bindingCount   = 1;
+        descriptorSetlayoutInfo.pBindings      = &uboBinding;
+
+        // create descriptor set layout
+        if (!m_descriptorSetLayout.initialize(m_vkDevice, descriptorSetlayoutInfo))
+        {
+            VK_LOG_ERROR("Stress::createDescriptorSetLayouts failed to create descriptor set layout");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createDescriptorSetLayouts successful");
+        return true;
+    }
+
+    bool Stress::createDescriptorPool() noexcept
+    {
+        // descriptor set requirements
+        DescriptorRequirements requirements{};
+        requirements.mMaxSets = GLTFModel::kMaxFramesInFlight;
+        requirements.mUniformCount = GLTFModel::kMaxFramesInFlight;
+
+        // add requirements
+        m_descriptorAllocator.addRequirements(requirements);
+        for (const auto& model : m_models)
+        {
+            m_descriptorAllocator.addRequirements(model.getDescriptorRequirements());
+        }
+
+        // create the descriptor allocator, its first pool sized to the requirements
+        if (!m_descriptorAllocator.initialize(m_vkDevice))
+        {
+            VK_LOG_ERROR("Stress::createDescriptorPool failed");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createDescriptorPool successful");
+        return true;
+    }
+
+    bool Stress::createDescriptorSets() noexcept
+    {
+        // one camera set per uniform buffer
+        const uint32_t setCount = static_cast<uint32_t>(m_uniformBuffers.size());
+        std::vector<VkDescriptorSetLayout> layouts(setCount, m_descriptorSetLayout.get());
+        m_descriptorSets.resize(setCount);
+        if (!m_descriptorAllocator.allocate(layouts.data(), setCount, m_descriptorSets.data()))
+        {
+            VK_LOG_ERROR("Stress::createDescriptorSets failed to allocate descriptor sets");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < setCount; i++)
+        {
+            // info for uniform buffer binding
+            VkDescriptorBufferInfo bufferInfo{};
+            bufferInfo.buffer   = m_uniformBuffers[i].get();
+            bufferInfo.offset   = 0;
+            bufferInfo.range    = sizeof(ubo::FrameData);
+
+            VkWriteDescriptorSet uboWrite{};
+            uboWrite.sType                  = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            uboWrite.pNext                  = nullptr;
+            uboWrite.dstSet                 = m_descriptorSets[i];
+            uboWrite.dstBinding             = 0;
+            uboWrite.dstArrayElement        = 0;
+            uboWrite.descriptorCount        = 1;
+            uboWrite.descriptorType         = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            uboWrite.pImageInfo             = nullptr;
+            uboWrite.pBufferInfo            = &bufferInfo;
+            uboWrite.pTexelBufferView       = nullptr;
+
+            // commit the binding to the descriptor set
+            vkUpdateDescriptorSets(m_vkDevice, 1, &uboWrite, 0, nullptr);
+        }
+
+        // allocate and update the material sets of both models
+        for (auto& model : m_models)
+        {
+            if (!model.allocateDescriptorSets(m_descriptorAllocator))
+            {
+                VK_LOG_ERROR("Stress::createDescriptorSets failed to allocate material descriptor sets");
+                return false;
+            }
+            model.updateDescriptorSets(m_samplers);
+        }
+
+        VK_LOG_DEBUG("Stress::createDescriptorSets successful");
+        return true;
+    }
+
+    bool Stress::createRenderPasses() noexcept
+    {
+        // color attachment: the swapchain image, presented after the pass
+        VkAttachmentDescription colorAttachment{};
+        colorAttachment.flags            = 0;
+        colorAttachment.format           = m_swapchain->getColorFormat();
+        colorAttachment.samples          = VK_SAMPLE_COUNT_1_BIT;
+        colorAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        colorAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
+        colorAttachment.finalLayout      = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        VkAttachmentReference colorAttachmentRef{};
+        colorAttachmentRef.attachment    = 0;
+        colorAttachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        // depth attachment: the swapchain's depth target
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.flags            = 0;
+        depthAttachment.format           = m_swapchain->getDepthFormat();
+        depthAttachment.samples          = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;         // depth is not read after the pass
+        depthAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment    = 1;
+        depthAttachmentRef.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        // subpass description
+        VkSubpassDescription subpass{};
+        subpass.flags                    = 0;
+        subpass.pipelineBindPoint        = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.inputAttachmentCount     = 0;
+        subpass.pInputAttachments        = nullptr;
+        subpass.colorAttachmentCount     = 1;
+        subpass.pColorAttachments        = &colorAttachmentRef;
+        subpass.pResolveAttachments      = nullptr;
+        subpass.pDepthStencilAttachment  = &depthAttachmentRef;
+        subpass.preserveAttachmentCount  = 0;
+        subpass.pPreserveAttachments     = nullptr;
+
+        // setup render pass
+        std::vector<VkAttachmentDescription> attachments { colorAttachment, depthAttachment };
+        std::vector<VkSubpassDescription> subpasses { subpass };
+        if (!m_renderPass.initialize(m_vkDevice, attachments, subpasses, {}))
+        {
+            VK_LOG_ERROR("Stress::createRenderPasses failed to initialize render pass");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createRenderPasses successful");
+        return true;
+    }
+
+    bool Stress::createGraphicsPipelines(const VulkanDevice& device) noexcept
+    {
+        // per-draw and instanced pipelines share everything but the vertex stage and its inputs
+        if (!createGraphicsPipeline(device, ScenePipeline::kDraw, m_drawPipeline))
+        {
+            VK_LOG_ERROR("Stress::createGraphicsPipelines failed for the per-draw pipeline");
+            return false;
+        }
+
+        if (!createGraphicsPipeline(device, ScenePipeline::kInstanced, m_instancedPipeline))
+        {
+            VK_LOG_ERROR("Stress::createGraphicsPipelines failed for the instanced pipeline");
+            return false;
+        }
+
+        if (!createGraphicsPipeline(device, ScenePipeline::kImpostor, m_impostorPipeline))
+        {
+            VK_LOG_ERROR("Stress::createGraphicsPipelines failed for the impostor pipeline");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Stress::createGraphicsPipelines successful");
+        return true;
+    }
+
+    bool Stress::createGraphicsPipeline(const VulkanDevice& device, ScenePipeline kind, VulkanPipeline& pipeline) noexcept
+    {
+        // retrieve shared vertex input layout; instanced draws add the per-instance model matrix binding, impostors read
+        // nothing but that binding
+        const bool isImpostor = kind == ScenePipeline::kImpostor;
+        const auto vertexFormat = m_models[0].getVertexFormat();
+        VkPipelineVertexInputStateCreateInfo vertexInputState = GLTFModel::getVertexInputState(vertexFormat);
+        if (kind == ScenePipeline::kInstanced)
+        {
+            vertexInputState = GLTFModel::getInstancedVertexInputState(vertexFormat);
+        }
+        else if (isImpostor)
+        {
+            vertexInputState = ImpostorAtlas::getVertexInputState();
+        }
+
+        // input assembly state: triangle list, or a strip of one quad per impostor
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.pNext = nullptr;
+        inputAssembly.flags = 0;
+        inputAssembly.topology = isImpostor ? VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // viewport and scissor state
+        auto swapchainExtent = m_swapchain->getExtent();
+
+        VkViewport viewport{};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = static_cast<float>(swapchainExtent.width);
+        viewport.height = static_cast<float>(swapchainExtent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+
+        VkRect2D scissor{};
+        scissor.offset.x = 0;
+        scissor.offset.y = 0;
+        scissor.extent = swapchainExtent;
+
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.pNext = nullptr;
+        viewportState.flags = 0;
+        viewportState.viewportCount = 1;
+        viewportState.pViewports = &viewport;
+        viewportState.scissorCount = 1;
+        viewportState.pScissors = &scissor;
+
+        // rasterization state: the helmets have open and double-sided surfaces
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        rasterizationState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizationState.pNext = nullptr;
+        rasterizationState.flags = 0;
+        rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizationState.cullMode = VK_CULL_MODE_NONE;
+        rasterizationState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizationState.lineWidth = 1.0f;
+
+        // multisample state
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampleState.pNext = nullptr;
+        multisampleState.flags = 0;
+        multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        // depth stencil state
+        VkPipelineDepthStencilStateCreateInfo depthStencilState{};
+        depthStencilState.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencilState.pNext = nullptr;
+        depthStencilState.flags = 0;
+        depthStencilState.depthTestEnable = VK_TRUE;
+        depthStencilState.depthWriteEnable = VK_TRUE;
+        depthStencilState.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+        depthStencilState.depthBoundsTestEnable = VK_FALSE;
+        depthStencilState.back.failOp = VK_STENCIL_OP_KEEP;
+        depthStencilState.back.passOp = VK_STENCIL_OP_KEEP;
+        depthStencilState.back.compareOp = VK_COMPARE_OP_ALWAYS;
+        depthStencilState.stencilTestEnable = VK_FALSE;
+        depthStencilState.front = depthStencilState.back;
+
+        // color blend state
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable = VK_FALSE;
+
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+        colorBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlendState.pNext = nullptr;
+        colorBlendState.flags = 0;
+        colorBlendState.attachmentCount = 1;
+        colorBlendState.pAttachments = &colorBlendAttachment;
+
+        // shader stages by pipeline
+        const VulkanShader& vertexShader = isImpostor ? m_impostorVertexShader :
+                                           kind == ScenePipeline::kInstanced ? m_instancedVertexShader : m_vertexShader;
+        const VulkanShader& fragmentShader = isImpostor ? m_impostorFragmentShader : m_fragmentShader;
+
+        // configure the graphics pipeline
+        GraphicsPipelineConfig pipelineConfig{};
+        pipelineConfig.mFlags = 0;
+        pipelineConfig.mShaderStages.emplace_back(vertexShader.getShaderStageInfo());
+        pipelineConfig.mShaderStages.emplace_back(fragmentShader.getShaderStageInfo());
+        pipelineConfig.mVertexInputState = vertexInputState;
+        pipelineConfig.mInputAssemblyState = inputAssembly;
+        pipelineConfig.mViewportState = viewportState;
+        pipelineConfig.mRasterizationState = rasterizationState;
+        pipelineConfig.mMultisampleState = multisampleState;
+        pipelineConfig.mDepthStencilState = depthStencilState;
+        pipelineConfig.mColorBlendState = colorBlendState;
+        pipelineConfig.mRenderPass = m_renderPass.get();
+        pipelineConfig.mSubpassIndex = 0;
+        pipelineConfig.mDescriptorSetLayouts.emplace_back(m_descriptorSetLayout.get());
+        pipelineConfig.mDescriptorSetLayouts.emplace_back(isImpostor ? ImpostorAtlas::getDescriptorSetLayout(device) : GLTFModel::getDescriptorSetLayout());
+        pipelineConfig.mPushConstantRanges.emplace_back(isImpostor ? ImpostorAtlas::getPushConstantRange() : GLTFModel::getPushConstantRange());
+
+        // create graphics pipeline
+        return pipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get());
+    }
+
+    bool Stress::createFramebuffers() noexcept
+    {
+        // allocate framebuffer for each swapchain image
+        m_framebuffers.resize(m_swapchainImageCount);
+
+        // get swapchain properties
+        const auto swapchainImageViews = m_swapchain->getColorImageViews();
+        const auto swapchainExtent     = m_swapchain->getExtent();
+
+        // framebuffer attachments: [0] swapchain color, [1] swapchain depth
+        VkImageView attachments[2]{ VK_NULL_HANDLE, m_swapchain->getDepthImageView() };
+
+        // framebuffer creation info
+        VkFramebufferCreateInfo framebufferCreateInfo{};
+        framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferCreateInfo.pNext = nullptr;
+        framebufferCreateInfo.flags = 0;
+        framebufferCreateInfo.renderPass = m_renderPass.get();
+        framebufferCreateInfo.attachmentCount = 2;
+        framebufferCreateInfo.pAttachments = attachments;
+        framebufferCreateInfo.width = swapchainExtent.width;
+        framebufferCreateInfo.height = swapchainExtent.height;
+        framebufferCreateInfo.layers = 1;
+
+        // create framebuffer per swapchain image view
+        for (uint32_t i = 0; i < m_swapchainImageCount; ++i)
+        {
+            attachments[0] = swapchainImageViews[i];
+            if (!m_framebuffers[i].initialize(m_vkDevice, framebufferCreateInfo))
+            {
+                VK_LOG_ERROR("Stress::createFramebuffers failed at swapchain image index %u", i);
+                return false;
+            }
+        }
+
+        VK_LOG_DEBUG("Stress::createFramebuffers successful");
+        return true;
+    }
+
+    bool Stress::createSyncPrimitives() noexcept
+    {
+        // allocate sync primitives for each frame in flight
+        m_frameSyncPrimitives.resize(m_maxFramesInFlight);
+
+        // semaphore creation info (binary semaphore)
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = nullptr;
+        semaphoreCreateInfo.flags = 0;
+
+        // fence creation info (signaled state)
+        VkFenceCreateInfo fenceCreateInfo{};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCreateInfo.pNext = nullptr;
+        fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        // create sync primitives per frame
+        for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
+        {
+            auto& frameSync = m_frameSyncPrimitives[i];
+            if (!frameSync.mImageAvailableSemaphore.initialize(m_vkDevice, semaphoreCreateInfo))
+            {
+                VK_LOG_ERROR("Stress::createSyncPrimitives failed to initialize image available semaphore : %u", i);
+                return false;
+            }
+
+            if (!frameSync.mRenderCompleteSemaphore.initialize(m_vkDevice, semaphoreCreateInfo))
+            {
+                VK_LOG_ERROR("Stress::createSyncPrimitives failed to initialize render complete semaphore : %u", i);
+                return false;
+            }
+
+            if (!frameSync.mInFlightFence.initialize(m_vkDevice, fenceCreateInfo))
+            {
+                VK_LOG_ERROR("Stress::createSyncPrimitives failed to initialize fence : %u", i);
+                return false;
+            }
+        }
+
+        // image in flight fences to track which fence currently owns swapchain image
+        m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
+        VK_LOG_DEBUG("Stress::createSyncPrimitives successful");
+        return true;
+    }
+
+    bool Stress::createGpuProfiler(const VulkanDevice& device) noexcept
+    {
+        // not fatal: the strategies are then compared on cpu time alone
+        if (!m_gpuProfiler.initialize(device, GLTFModel::kMaxFramesInFlight))
+        {
+            VK_LOG_INFO("Stress::createGpuProfiler gpu timestamps not available, gpu time not reported");
+            return true;
+        }
+
+        VK_LOG_DEBUG("Stress::createGpuProfiler successful");
+        return true;
+    }
+
+    bool Stress::createImpostors(const VulkanDevice& device) noexcept
+    {
+        // baked from the models as loaded, before generatePlacements gives them placements; sized for every placement
+        // either model may take. not fatal: a model without an atlas keeps drawing every placement in full
+        const ImpostorShaders shaders{ "stress/impostor_bake.vert.spv", "stress/impostor_bake.frag.spv" };
+        for (size_t i = 0; i < m_models.size(); ++i)
+        {
+            if (!m_impostors[i].initialize(device, m_stagingBelt, m_models[i], shaders, m_models[i].getMaxPlacements()))
+            {
+                VK_LOG_WARN("Stress::createImpostors no impostor for model %zu, its placements stay full meshes", i);
+            }
+        }
+
+        VK_LOG_DEBUG("Stress::createImpostors successful");
+        return true;
+    }
+
+    bool Stress::prepareScene() noexcept
+    {
+        // orbit camera around the field, fitted to it by generatePlacements
+        const float aspectRatio = static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight);
+        m_camera = std::make_shared<Camera>(Camera::Mode::Turntable, 45.0f, aspectRatio, 0.5f, 1000.0f);
+        m_camera->setPreRotation(m_swapchain->getPreRotation());
+        m_camera->setOrbitTarget(glm::vec3(0.0f));
+
+        // register listeners with the platform
+        if (auto platform = m_platform.lock())
+        {
+            platform->addListener(m_camera);
+        }
+
+        generatePlacements(m_placementCount);
+        setStrategy(SubmissionStrategy::kCpuPerDraw);
+
+        // mark ready for render
+        m_readyToRender.store(true);
+        return true;
+    }
+
+    bool Stress::updatePerFrame(uint32_t frameIndex) noexcept
+    {
+        // setup uniform data
+        ubo::FrameData frameData{};
+        frameData.view       = m_camera->getViewMatrix();
+        frameData.projection = m_camera->getProjectionMatrix();
+
+        // upload to uniform buffer
+        if (!m_uniformBuffers[frameIndex].uploadHostVisible(&frameData, sizeof(frameData)))
+        {
+            VK_LOG_ERROR("Stress::updatePerFrame failed for frame: %d", frameIndex);
+            return false;
+        }
+
+        return true;
+    }
+
+    void Stress::generatePlacements(uint32_t count) noexcept
+    {
+        // reseeded per call: a given count lays out the same field every time
+        std::mt19937 rng(kPlacementSeed);
+        std::uniform_real_distribution<float> unit(-0.5f, 0.5f);
+        std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+        std::uniform_real_distribution<float> scale(0.6f, 1.4f);
+
+        m_fieldExtent = std::cbrt(static_cast<float>(count)) * kPlacementSpacing;
+        for (auto& placements : m_placements)
+        {
+            placements.clear();
+            placements.reserve(count);
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            // about one in kFlightHelmetShare takes the flight helmet, until its buffers are full
+            const bool isFlightHelmet = rng() % kFlightHelmetShare == 0 && m_placements[1].size() < kMaxFlightHelmetPlacements;
+            const glm::vec3 position = glm::vec3(unit(rng), unit(rng), unit(rng)) * m_fieldExtent;
+            const glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 1e-3f, 0.0f));
+            const float placementScale = scale(rng) * (isFlightHelmet ? kFlightHelmetScale : 1.0f);
+
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+            transform = glm::rotate(transform, angle(rng), axis);
+            transform = glm::scale(transform, glm::vec3(placementScale));
+            m_placements[isFlightHelmet ? 1 : 0].push_back(transform);
+        }
+
+        for (size_t i = 0; i < m_models.size(); ++i)
+        {
+            m_models[i].setPlacements(m_placements[i].data(), static_cast<uint32_t>(m_placements[i].size()));
+        }
+
+        // a new field starts a new measurement window, and a new split into meshes and impostors
+        m_isSplitDirty = true;
+        m_placementCount = count;
+        m_settleFrames = GLTFModel::kMaxFramesInFlight + 1;
+        m_windowStats = {};
+        m_windowStart = std::chrono::steady_clock::now();
+        fitCamera();
+        VK_LOG_INFO("Stress::generatePlacements %u placements (%zu damaged helmets, %zu flight helmets)",
+                    count, m_placements[0].size(), m_placements[1].size());
+    }
+
+    void Stress::fitCamera() noexcept
+    {
+        // the whole field in view from a three-quarter angle, far plane past its back corner
+        if (!m_camera)
+        {
+            return;
+        }
+
+        const float distance = m_fieldExtent * 1.6f + 4.0f;
+        m_camera->setOrbit(0.6f, 0.35f, distance);
+        m_camera->setClipPlanes(0.5f, distance + m_fieldExtent * 1.5f);
+    }
+
+    void Stress::setStrategy(SubmissionStrategy strategy) noexcept
+    {
+        // instancing is a prepare-time choice, the indirect commands are written along with the instance data
+        m_strategy = strategy;
+        const bool isInstanced = strategy == SubmissionStrategy::kInstanced || strategy == SubmissionStrategy::kIndirect;
+        for (auto& model : m_models)
+        {
+            model.setInstancingEnabled(isInstanced);
+        }
+
+        // gpu times of frames still in flight belong to the previous strategy
+        m_settleFrames = GLTFModel::kMaxFramesInFlight + 1;
+        m_windowStats = {};
+        m_windowStart = std::chrono::steady_clock::now();
+        VK_LOG_INFO("Stress::setStrategy %s", getStrategyName(strategy));
+    }
+
+    void Stress::setImpostorsEnabled(bool isEnabled) noexcept
+    {
+        // off gives the models every placement back, on splits them again with the next frame
+        m_isImpostorEnabled = isEnabled;
+        m_isSplitDirty = true;
+        if (!isEnabled)
+        {
+            for (size_t i = 0; i < m_models.size(); ++i)
+            {
+                m_models[i].setPlacements(m_placements[i].data(), static_cast<uint32_t>(m_placements[i].size()));
+                m_nearPlacements[i].clear();
+                m_farPlacements[i].clear();
+            }
+        }
+
+        m_settleFrames = GLTFModel::kMaxFramesInFlight + 1;
+        m_windowStats = {};
+        m_windowStart = std::chrono::steady_clock::now();
+        VK_LOG_INFO("Stress::setImpostorsEnabled %s", isEnabled ? "on" : "off");
+    }
+
+    uint32_t Stress::prepareImpostors(uint32_t frameIndex, const Frustum& frustum) noexcept
+    {
+        // off: the models draw every placement
+        if (!m_isImpostorEnabled)
+        {
+            return 0;
+        }
+
+        // split again once the camera moved (or the field or window changed). a placement switches once its bounding
+        // sphere spans fewer pixels than a frame: 2 * radius * scale * pixels per unit / distance < kFrameSize
+        const glm::vec3 cameraPosition = m_camera->getPosition();
+        if (m_isSplitDirty || glm::distance(cameraPosition, m_splitPosition) > kImpostorResplitDistance)
+        {
+            const glm::mat4& projection = m_camera->getProjectionMatrix();
+            const float pixelsPerUnit = 0.5f * static_cast<float>(m_windowHeight) * glm::length(glm::vec2(projection[1][0], projection[1][1]));
+            for (size_t i = 0; i < m_models.size(); ++i)
+            {
+                const ImpostorAtlas& impostor = m_impostors[i];
+                const float switchFactor = 2.0f * impostor.getRadius() * pixelsPerUnit / static_cast<float>(ImpostorAtlas::kFrameSize);
+                m_nearPlacements[i].clear();
+                m_farPlacements[i].clear();
+                for (const glm::mat4& placement : m_placements[i])
+                {
+                    const glm::vec3 offset = glm::vec3(placement * glm::vec4(impostor.getCenter(), 1.0f)) - cameraPosition;
+                    const float switchDistance = switchFactor * glm::length(glm::vec3(placement[0]));
+                    const bool isFar = impostor.isValid() && glm::dot(offset, offset) > switchDistance * switchDistance;
+                    (isFar ? m_farPlacements[i] : m_nearPlacements[i]).push_back(placement);
+                }
+                m_models[i].setPlacements(m_nearPlacements[i].data(), static_cast<uint32_t>(m_nearPlacements[i].size()));
+            }
+            m_splitPosition = cameraPosition;
+            m_isSplitDirty = false;
+        }
+
+        // the far placements inside the frustum, every frame
+        uint32_t impostorCount = 0;
+        for (size_t i = 0; i < m_impostors.size(); ++i)
+        {
+            ImpostorAtlas& impostor = m_impostors[i];
+            m_visibleImpostors.clear();
+            for (const glm::mat4& placement : m_farPlacements[i])
+            {
+                const glm::vec3 center = glm::vec3(placement * glm::vec4(impostor.getCenter(), 1.0f));
+                if (frustum.intersectsSphere(center, impostor.getRadius() * glm::length(glm::vec3(placement[0]))))
+                {
+                    m_visibleImpostors.push_back(placement);
+                }
+            }
+            impostorCount += impostor.setInstances(frameIndex, m_visibleImpostors.data(), static_cast<uint32_t>(m_visibleImpostors.size()));
+        }
+        return impostorCount;
+    }
+
+    bool Stress::recordSceneCommandBuffers(uint32_t frameIndex) noexcept
+    {
+        // prepare: split off and cull the impostors, cull every other placement against the world frustum, sort and
+        // group into runs. a model whose placements all became impostors has nothing left (none would draw it once)
+        const auto prepareStart = std::chrono::steady_clock::now();
+        const Frustum frustum = m_camera->getFrustum();
+        const uint32_t impostorCount = prepareImpostors(frameIndex, frustum);
+        std::array<uint32_t, 2> runCounts{};
+        for (size_t i = 0; i < m_models.size(); ++i)
+        {
+            if (!m_isImpostorEnabled || !m_nearPlacements[i].empty())
+            {
+                runCounts[i] = m_models[i].prepareDraws(frameIndex, &frustum);
+            }
+        }
+        const auto recordStart = std::chrono::steady_clock::now();
+
+        // record: this frame's secondaries, executed in order by the primary
+        m_sceneCommandBuffers.clear();
+        const uint32_t runCount = runCounts[0] + runCounts[1];
+        const uint32_t workerCount = m_strategy == SubmissionStrategy::kMultiThreaded ?
+            std::min(m_recordWorkerCount, runCount / kMinRunsPerWorker) : 0;
+        bool isRecorded = true;
+        if (workerCount > 1)
+        {
+            // workers record disjoint ranges of the runs of both models, concatenated, into secondaries of their own allocators
+            const uint32_t runsPerWorker = (runCount + workerCount - 1) / workerCount;
+            for (uint32_t worker = 0; worker < workerCount; ++worker)
+            {
+                m_sceneCommandBuffers.push_back(m_workerAllocators[worker]->allocateSecondary());
+            }
+
+            std::atomic<bool> isWorkerRecorded{ true };
+            TaskGroup recordGroup(*m_recordThreadPool, TaskPriority::kFrameCritical);
+            recordGroup.parallelFor(workerCount, 1, [&](size_t worker)
+            {
+                const uint32_t begin = std::min(runCount, static_cast<uint32_t>(worker) * runsPerWorker);
+                const uint32_t end = std::min(runCount, begin + runsPerWorker);
+                const std::array<uint32_t, 2> firstRuns{ std::min(begin, runCounts[0]), std::max(begin, runCounts[0]) - runCounts[0] };
+                const std::array<uint32_t, 2> workerRuns{ std::min(end, runCounts[0]) - firstRuns[0], std::max(end, runCounts[0]) - runCounts[0] - firstRuns[1] };
+                if (!recordScenePass(m_sceneCommandBuffers[worker], frameIndex, firstRuns, workerRuns))
+                {
+                    isWorkerRecorded.store(false, std::memory_order_relaxed);
+                }
+            });
+            recordGroup.wait();
+            isRecorded = isWorkerRecorded.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            // every other strategy (and the multi-threaded one with too few runs) records on the render thread
+            m_sceneCommandBuffers.push_back(m_frameCommandAllocator.allocateSecondary());
+            isRecorded = recordScenePass(m_sceneCommandBuffers.back(), frameIndex, { 0, 0 }, runCounts);
+        }
+
+        // the impostors of both models follow in one more secondary
+        if (isRecorded && impostorCount > 0)
+        {
+            m_sceneCommandBuffers.push_back(m_frameCommandAllocator.allocateSecondary());
+            isRecorded = recordImpostorPass(m_sceneCommandBuffers.back(), frameIndex);
+        }
+        const auto recordEnd = std::chrono::steady_clock::now();
+
+        if (!isRecorded)
+        {
+            VK_LOG_ERROR("Stress::recordSceneCommandBuffers failed for frame: %d", frameIndex);
+            return false;
+        }
+
+        accumulateStats(toMilliseconds(recordStart - prepareStart), toMilliseconds(recordEnd - recordStart), runCount, impostorCount);
+        return true;
+    }
+
+    bool Stress::beginSceneSecondary(const VulkanCommandBuffer& commandBuffer) const noexcept
+    {
+        // secondary command buffer inherits render pass state from the primary
+        VkCommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext                = nullptr;
+        inheritanceInfo.renderPass           = m_renderPass.get();
+        inheritanceInfo.subpass              = 0;
+        inheritanceInfo.framebuffer          = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags           = 0;
+        inheritanceInfo.pipelineStatistics   = 0;
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        // the buffer comes from a freshly reset pool, so no per-buffer reset
+        return commandBuffer.isValid() && commandBuffer.begin(beginInfo);
+    }
+
+    bool Stress::recordImpostorPass(const VulkanCommandBuffer& commandBuffer, uint32_t frameIndex) noexcept
+    {
+        if (!beginSceneSecondary(commandBuffer))
+        {
+            return false;
+        }
+
+        // one instanced draw per model, both through the impostor pipeline and the camera set
+        const VkPipelineLayout pipelineLayout = m_impostorPipeline.getLayout();
+        vkCmdBindPipeline(commandBuffer.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, m_impostorPipeline.get());
+        vkCmdBindDescriptorSets(commandBuffer.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &m_descriptorSets[frameIndex], 0, nullptr);
+        for (const ImpostorAtlas& impostor : m_impostors)
+        {
+            impostor.record(commandBuffer.get(), pipelineLayout, frameIndex);
+        }
+
+        // finalize the command buffer
+        return commandBuffer.end();
+    }
+
+    bool Stress::recordScenePass(const VulkanCommandBuffer& commandBuffer, uint32_t frameIndex, const std::array<uint32_t, 2>& firstRuns,
+                                 const std::array<uint32_t, 2>& runCounts) noexcept
+    {
+        if (!beginSceneSecondary(commandBuffer))
+        {
+            return false;
+        }
+
+        // the binds of both models go through one recorder, which drops the ones repeated between runs
+        const bool isInstanced = m_strategy == SubmissionStrategy::kInstanced || m_strategy == SubmissionStrategy::kIndirect;
+        const VulkanPipeline& pipeline = isInstanced ? m_instancedPipeline : m_drawPipeline;
+        VulkanCommandRecorder recorder(commandBuffer);
+        recorder.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.get());
+        recorder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getLayout(), 0, 1, &m_descriptorSets[frameIndex]);
+        for (size_t i = 0; i < m_models.size(); ++i)
+        {
+            if (runCounts[i] == 0)
+            {
+                continue;
+            }
+
+            if (m_strategy == SubmissionStrategy::kIndirect)
+            {
+                m_models[i].recordIndirectDraws(recorder, pipeline.getLayout(), frameIndex, firstRuns[i], runCounts[i]);
+            }
+            else
+            {
+                m_models[i].recordDraws(recorder, pipeline.getLayout(), frameIndex, firstRuns[i], runCounts[i]);
+            }
+        }
+
+        // finalize the command buffer
+        return commandBuffer.end();
+    }
+
+    bool Stress::recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept
+    {
+        // begin primary recording
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        // begin recording; the buffer comes from a freshly reset pool, so no per-buffer reset
+        auto& commandBuffer = m_primaryCommandBuffers[frameIndex];
+        if (!commandBuffer.isValid() || !commandBuffer.begin(beginInfo))
+        {
+            return false;
+        }
+
+        // clear values for render pass; color: 0, depth-stencil: 1
+        VkClearValue clearValues[2]{};
+        clearValues[0].color        = { 0.02f, 0.02f, 0.025f, 1.0f };
+        clearValues[1].depthStencil = { 1.0f, 0 };
+
+        // render pass begin info (framebuffer updated per command buffer)
+        VkRenderPassBeginInfo renderPassBeginInfo{};
+        renderPassBeginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassBeginInfo.pNext             = nullptr;
+        renderPassBeginInfo.framebuffer       = m_framebuffers[imageIndex].get();
+        renderPassBeginInfo.renderPass        = m_renderPass.get();
+        renderPassBeginInfo.renderArea.offset = {0, 0};
+        renderPassBeginInfo.renderArea.extent = m_swapchain->getExtent();
+        renderPassBeginInfo.clearValueCount   = 2;
+        renderPassBeginInfo.pClearValues      = clearValues;
+
+        // the scene pass is the one timed scope: it resolves this slot's previous frame first
+        m_gpuProfiler.beginFrame(commandBuffer.get(), frameIndex);
+        const uint32_t sceneScope = m_gpuProfiler.beginScope(commandBuffer.get(), "scene");
+        commandBuffer.beginRenderPass(renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        commandBuffer.executeCommands(m_sceneCommandBuffers.data(), static_cast<uint32_t>(m_sceneCommandBuffers.size()));
+        commandBuffer.endRenderPass();
+        m_gpuProfiler.endScope(commandBuffer.get(), sceneScope);
+
+        // finalize the command buffer
+        return commandBuffer.end();
+    }
+
+    void Stress::accumulateStats(double prepareMs, double recordMs, uint32_t drawCount, uint32_t impostorCount) noexcept
+    {
+        // frames right after a change still report the previous configuration
+        if (m_settleFrames > 0)
+        {
+            --m_settleFrames;
+            return;
+        }
+
+        // gpu time of the most recently resolved frame (the scene scope)
+        const auto& gpuResults = m_gpuProfiler.getResults();
+        const double gpuMs = (m_gpuProfiler.isValid() && !gpuResults.empty()) ? gpuResults.front().mMilliseconds : 0.0;
+
+        StrategyStats& totalStats = m_totalStats[static_cast<size_t>(m_strategy)];
+        for (StrategyStats* stats : { &totalStats, &m_windowStats })
+        {
+            ++stats->mFrames;
+            stats->mPrepareMs += prepareMs;
+            stats->mRecordMs  += recordMs;
+            stats->mGpuMs     += gpuMs;
+            stats->mDraws     += drawCount;
+            stats->mImpostors += impostorCount;
+        }
+
+        // running report over the last window
+        const auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - m_windowStart).count() < kLogInterval)
+        {
+            return;
+        }
+
+        const double frames = static_cast<double>(m_windowStats.mFrames);
+        unsigned long long triangles = 0;
+        for (size_t i = 0; i < m_models.size(); ++i)
+        {
+            // a model left without placements skipped its prepare, its count is stale
+            if (!m_isImpostorEnabled || !m_nearPlacements[i].empty())
+            {
+                triangles += m_models[i].getDrawnTriangleCount();
+            }
+        }
+        VK_LOG_INFO("Stress : %s, %u placements, %.0f draws, %llu triangles, %.0f impostors, prepare %.3f ms, record %.3f ms, gpu %.3f ms",
+                    getStrategyName(m_strategy), m_placementCount, m_windowStats.mDraws / frames, triangles, m_windowStats.mImpostors / frames,
+                    m_windowStats.mPrepareMs / frames, m_windowStats.mRecordMs / frames, m_windowStats.mGpuMs / frames);
+        m_windowStats = {};
+        m_windowStart = now;
+    }
+
+    void Stress::logSummary() const noexcept
+    {
+        // averages per strategy over every measured frame of the run, whatever the placement count was
+        for (size_t i = 0; i < m_totalStats.size(); ++i)
+        {
+            const StrategyStats& stats = m_totalStats[i];
+            if (stats.mFrames == 0)
+            {
+                continue;
+            }
+
+            const double frames = static_cast<double>(stats.mFrames);
+            VK_LOG_INFO("Stress summary : %s over %llu frames, %.0f draws, %.0f impostors, prepare %.3f ms, record %.3f ms, gpu %.3f ms",
+                        getStrategyName(static_cast<SubmissionStrategy>(i)), static_cast<unsigned long long>(stats.mFrames),
+                        stats.mDraws / frames, stats.mImpostors / frames, stats.mPrepareMs / frames, stats.mRecordMs / frames, stats.mGpuMs / frames);
+        }
+    }
+}   // namespace keplar
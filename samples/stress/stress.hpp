@@ -0,0 +1,230 @@
+// ────────────────────────────────────────────
+//  File: stress.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <chrono>
+
+#include "graphics/renderer.hpp"
+#include "platform/platform.hpp"
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_swapchain.hpp"
+#include "vulkan/vulkan_command_buffer.hpp"
+#include "vulkan/vulkan_frame_command_allocator.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
+#include "vulkan/vulkan_render_pass.hpp"
+#include "vulkan/vulkan_framebuffer.hpp"
+#include "vulkan/vulkan_fence.hpp"
+#include "vulkan/vulkan_semaphore.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_shader.hpp"
+#include "vulkan/vulkan_descriptor_set_layout.hpp"
+#include "vulkan/vulkan_descriptor_allocator.hpp"
+#include "vulkan/vulkan_pipeline.hpp"
+#include "vulkan/vulkan_samplers.hpp"
+
+#include "graphics/camera.hpp"
+#include "graphics/gltf_model.hpp"
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/impostor_atlas.hpp"
+#include "utils/thread_pool.hpp"
+#include "shader_structs.hpp"
+
+namespace keplar
+{
+    // ways the scene's draws reach the gpu, switched at runtime with keys 1-4
+    enum class SubmissionStrategy : uint8_t
+    {
+        kCpuPerDraw,        // one vkCmdDrawIndexed per visible placement and primitive, recorded on the render thread
+        kMultiThreaded,     // the same draws split across record workers, one secondary each
+        kInstanced,         // one instanced draw per primitive and material
+        kIndirect,          // the instanced draws as indirect commands, one multi-draw per material
+        kCount
+    };
+
+    // draw-call throughput stress test: thousands to hundreds of thousands of glTF placements with randomized transforms,
+    // each drawing one of two models (and so one of their materials). every strategy culls and sorts on the cpu through
+    // GLTFModel::prepareDraws and differs only in how it records; cpu prepare and record time and the gpu time of the scene
+    // pass are averaged per strategy, logged while running and summarized on exit. Z and X halve and double the placements.
+    // I toggles impostors: placements whose bounds span fewer pixels than an impostor frame (ImpostorAtlas::kFrameSize) leave
+    // the models' draws and are drawn as one instanced quad each, from octahedral atlases baked per model at startup
+    class Stress : public Renderer
+    {
+        public:
+            // placements the models' per-frame buffers are sized for; the flight helmet takes about one in kFlightHelmetShare
+            static constexpr uint32_t kMaxHelmetPlacements       = 131072;
+            static constexpr uint32_t kMaxFlightHelmetPlacements = 16384;
+            static constexpr uint32_t kFlightHelmetShare         = 8;
+            static constexpr uint32_t kMinPlacements             = 1024;
+            static constexpr uint32_t kDefaultPlacements         = 16384;
+            static constexpr uint32_t kMaxRecordWorkers          = 8;
+            static constexpr uint32_t kMinRunsPerWorker          = 64;
+
+            // creation and destruction
+            Stress() noexcept;
+            ~Stress();
+
+            // core renderer interface: initialize, update, render, configure
+            virtual bool initialize(std::weak_ptr<Platform> platform, std::weak_ptr<VulkanContext> context) noexcept override;
+            virtual void update(float dt) noexcept override;
+            virtual bool render() noexcept override;
+            virtual void configureVulkan(VulkanContextConfig& config) noexcept override;
+
+            // handle window and user input events
+            virtual void onWindowResize(uint32_t, uint32_t) override;
+            virtual void onKeyPressed(uint32_t key) override;
+
+        private:
+            // pipelines of the scene pass: the models' per-draw and instanced draws, and the impostor quads
+            enum class ScenePipeline : uint8_t
+            {
+                kDraw,
+                kInstanced,
+                kImpostor
+            };
+
+            bool createSwapchain() noexcept;
+            bool createDepthTarget() noexcept;
+            bool createCommandAllocator(const VulkanDevice& device) noexcept;
+            bool createRecordWorkers(const VulkanDevice& device) noexcept;
+            bool createStagingBelt(const VulkanDevice& device) noexcept;
+            bool createCommandBuffers() noexcept;
+            bool createTextureSamplers(const VulkanDevice& device) noexcept;
+            bool loadAssets(const VulkanDevice& device) noexcept;
+            bool createUniformBuffers(const VulkanDevice& device) noexcept;
+            bool createShaderModules() noexcept;
+            bool createDescriptorSetLayouts() noexcept;
+            bool createDescriptorPool() noexcept;
+            bool createDescriptorSets() noexcept;
+            bool createRenderPasses() noexcept;
+            bool createGraphicsPipelines(const VulkanDevice& device) noexcept;
+            bool createGraphicsPipeline(const VulkanDevice& device, ScenePipeline kind, VulkanPipeline& pipeline) noexcept;
+            bool createFramebuffers() noexcept;
+            bool createSyncPrimitives() noexcept;
+            bool createGpuProfiler(const VulkanDevice& device) noexcept;
+            bool createImpostors(const VulkanDevice& device) noexcept;
+            bool prepareScene() noexcept;
+            bool updatePerFrame(uint32_t frameIndex) noexcept;
+
+            // placements and per-frame recording
+            void generatePlacements(uint32_t count) noexcept;
+            void fitCamera() noexcept;
+            void setStrategy(SubmissionStrategy strategy) noexcept;
+            void setImpostorsEnabled(bool isEnabled) noexcept;
+            uint32_t prepareImpostors(uint32_t frameIndex, const Frustum& frustum) noexcept;
+            bool recordSceneCommandBuffers(uint32_t frameIndex) noexcept;
+            bool beginSceneSecondary(const VulkanCommandBuffer& commandBuffer) const noexcept;
+            bool recordImpostorPass(const VulkanCommandBuffer& commandBuffer, uint32_t frameIndex) noexcept;
+            bool recordScenePass(const VulkanCommandBuffer& commandBuffer, uint32_t frameIndex, const std::array<uint32_t, 2>& firstRuns,
+                                 const std::array<uint32_t, 2>& runCounts) noexcept;
+            bool recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept;
+            void accumulateStats(double prepareMs, double recordMs, uint32_t drawCount, uint32_t impostorCount) noexcept;
+            void logSummary() const noexcept;
+
+        private:
+            // per frame sync primitives
+            struct FrameSyncPrimitives
+            {
+                VulkanSemaphore  mImageAvailableSemaphore;
+                VulkanSemaphore  mRenderCompleteSemaphore;
+                VulkanFence      mInFlightFence;
+            };
+
+            // running sums of one strategy, over the whole run and the current log window
+            struct StrategyStats
+            {
+                uint64_t    mFrames      = 0;
+                double      mPrepareMs   = 0.0;     // culling, sorting and instance data (GLTFModel::prepareDraws)
+                double      mRecordMs    = 0.0;     // secondary recording, workers included
+                double      mGpuMs       = 0.0;     // scene pass timestamps
+                uint64_t    mDraws       = 0;       // draw runs recorded
+                uint64_t    mImpostors   = 0;       // placements drawn as impostors
+            };
+
+            // core dependencies
+            std::weak_ptr<Platform>             m_platform;
+            std::weak_ptr<VulkanContext>        m_context;
+            std::weak_ptr<VulkanDevice>         m_device;
+
+            // swapchain for presentation
+            std::unique_ptr<VulkanSwapchain>    m_swapchain;
+
+            // vulkan handles
+            VkDevice                            m_vkDevice;
+            VkQueue                             m_presentQueue;
+            VkQueue                             m_graphicsQueue;
+            VkSwapchainKHR                      m_vkSwapchainKHR;
+
+            // window dimensions
+            uint32_t                            m_windowWidth;
+            uint32_t                            m_windowHeight;
+
+            // rendering state
+            uint32_t                            m_swapchainImageCount;
+            uint32_t                            m_maxFramesInFlight;
+            uint32_t                            m_currentImageIndex;
+            uint32_t                            m_currentFrameIndex;
+            std::atomic<bool>                   m_readyToRender;
+
+            // command buffers and synchronization
+            VulkanFrameCommandAllocator         m_frameCommandAllocator;
+            VulkanStagingBelt                   m_stagingBelt;
+            std::vector<VulkanCommandBuffer>    m_primaryCommandBuffers;
+            std::vector<VulkanCommandBuffer>    m_sceneCommandBuffers;      // this frame's secondaries, executed in order
+            VulkanRenderPass                    m_renderPass;
+            std::vector<VulkanFramebuffer>      m_framebuffers;
+            std::vector<FrameSyncPrimitives>    m_frameSyncPrimitives;
+            std::vector<VkFence>                m_imagesInFlightFences;
+
+            // record workers: one transient allocator each, not shared between threads
+            std::unique_ptr<ThreadPool>         m_recordThreadPool;
+            std::vector<std::unique_ptr<VulkanFrameCommandAllocator>> m_workerAllocators;
+            uint32_t                            m_recordWorkerCount;
+
+            // shaders and pipelines: per-draw matrices in push constants, or per-instance ones on the instance binding
+            VulkanShader                        m_vertexShader;
+            VulkanShader                        m_instancedVertexShader;
+            VulkanShader                        m_fragmentShader;
+            VulkanSamplers                      m_samplers;
+            VulkanDescriptorSetLayout           m_descriptorSetLayout;
+            VulkanDescriptorAllocator           m_descriptorAllocator;
+            VulkanPipeline                      m_drawPipeline;
+            VulkanPipeline                      m_instancedPipeline;
+            VulkanShader                        m_impostorVertexShader;
+            VulkanShader                        m_impostorFragmentShader;
+            VulkanPipeline                      m_impostorPipeline;
+
+            // main camera and uniform buffer
+            std::shared_ptr<Camera>             m_camera;
+            std::vector<VulkanBuffer>           m_uniformBuffers;
+            std::vector<VkDescriptorSet>        m_descriptorSets;
+
+            // models and their placements
+            std::array<GLTFModel, 2>            m_models;
+            std::array<std::vector<glm::mat4>, 2> m_placements;
+            uint32_t                            m_placementCount;
+            float                               m_fieldExtent;
+
+            // impostors: the placements are split into the models' (near) and the atlases' (far) once the camera moved
+            std::array<ImpostorAtlas, 2>        m_impostors;
+            std::array<std::vector<glm::mat4>, 2> m_nearPlacements;
+            std::array<std::vector<glm::mat4>, 2> m_farPlacements;
+            std::vector<glm::mat4>              m_visibleImpostors;    // this frame's far placements inside the frustum
+            glm::vec3                           m_splitPosition;       // camera position of the last split
+            bool                                m_isImpostorEnabled;
+            bool                                m_isSplitDirty;
+
+            // strategy and measurements
+            SubmissionStrategy                  m_strategy;
+            uint32_t                            m_settleFrames;     // frames after a switch whose gpu times are still the previous strategy's
+            GpuProfiler                         m_gpuProfiler;
+            std::array<StrategyStats, static_cast<size_t>(SubmissionStrategy::kCount)> m_totalStats;
+            StrategyStats                       m_windowStats;
+            std::chrono::steady_clock::time_point m_windowStart;
+    };
+}   // namespace keplar
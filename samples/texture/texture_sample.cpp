@@ -3,7 +3,9 @@
 // ────────────────────────────────────────────
 
 #include "texture_sample.hpp"
+#include "core/keplar_config.hpp"
 #include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
 #include "vulkan/vulkan_utils.hpp"
 
 namespace keplar
@@ -76,24 +78,25 @@ namespace keplar
         m_windowHeight    = platformLocked->getWindowHeight();
 
         // initialize vulkan resources
-        if (!createSwapchain())             { return false; }
-        if (!createMsaaTarget(*device))     { return false; }
-        if (!createCommandPool(*device))    { return false; }
-        if (!createCommandBuffers())        { return false; }
-        if (!createTextureSamplers(*device)){ return false; }
-        if (!createVertexBuffers(*device))  { return false; }
-        if (!createTextures(*device))       { return false; }
-        if (!createUniformBuffers(*device)) { return false; }
-        if (!createShaderModules())         { return false; }
-        if (!createDescriptorSetLayouts())  { return false; }
-        if (!createDescriptorPool())        { return false; }
-        if (!createDescriptorSets())        { return false; }
-        if (!createRenderPasses())          { return false; }
-        if (!createGraphicsPipeline())      { return false; }
-        if (!createFramebuffers())          { return false; }
-        if (!createSyncPrimitives())        { return false; }
-        if (!recordSceneCommandBuffers())   { return false; }
-        if (!prepareScene())                { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSwapchain()))               { return false; }
+        if (!KEPLAR_STARTUP_STEP(createMsaaTarget(*device)))       { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandPool(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createStagingBelt(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandBuffers()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createTextureSamplers(*device)))  { return false; }
+        if (!KEPLAR_STARTUP_STEP(createVertexBuffers(*device)))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createTextures(*device)))         { return false; }
+        if (!KEPLAR_STARTUP_STEP(createUniformBuffers(*device)))   { return false; }
+        if (!KEPLAR_STARTUP_STEP(createShaderModules()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSetLayouts()))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorPool()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSets()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createRenderPasses()))            { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGraphicsPipeline(*device))) { return false; }
+        if (!KEPLAR_STARTUP_STEP(createFramebuffers()))            { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSyncPrimitives()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(recordSceneCommandBuffers()))     { return false; }
+        if (!KEPLAR_STARTUP_STEP(prepareScene()))                  { return false; }
 
         VK_LOG_INFO("TextureSample::initialize successful");
         return true;
@@ -243,20 +246,20 @@ namespace keplar
         m_readyToRender.store(false);
         vkDeviceWaitIdle(m_vkDevice);
 
-        // recreate swapchain with new dimensions
+        // recreate swapchain with new dimensions; a display rotation changes the pre-rotation with it
         if (!m_swapchain->recreate(width, height))
         {
             return;
         }
 
-        // store old max frames-in-flight for sync check
-        const uint32_t previousMaxFramesInFlight = m_maxFramesInFlight;
+        if (m_camera)
+        {
+            m_camera->setPreRotation(m_swapchain->getPreRotation());
+        }
 
         // update swapchain handle and image count
         m_vkSwapchainKHR      = m_swapchain->get();
         m_swapchainImageCount = m_swapchain->getImageCount();
-        m_maxFramesInFlight   = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight   = glm::max(1u, m_maxFramesInFlight);
 
         // reset per-image fence ownership for the new swapchain images
         m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
@@ -276,27 +279,10 @@ namespace keplar
         if (!createMsaaTarget(*device))   { return; }
         if (!createCommandBuffers())      { return; }
         if (!createRenderPasses())        { return; }
-        if (!createGraphicsPipeline())    { return; }
+        if (!createGraphicsPipeline(*device)) { return; }
         if (!createFramebuffers())        { return; }
         if (!recordSceneCommandBuffers()) { return; }
 
-        // recreate per-frame sync primitives if max frames-in-flight changed
-        if (m_maxFramesInFlight != previousMaxFramesInFlight)
-        {
-            for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
-            {
-                auto& frameSync = m_frameSyncPrimitives[i];
-                frameSync.mInFlightFence.destroy();
-                frameSync.mRenderCompleteSemaphore.destroy();
-                frameSync.mImageAvailableSemaphore.destroy();
-            }
-            
-            if (!createSyncPrimitives()) 
-            { 
-                return; 
-            }
-        }
-
         // update window dimensions 
         m_windowWidth  = width;
         m_windowHeight = height;
@@ -307,7 +293,10 @@ namespace keplar
 
     bool TextureSample::createSwapchain() noexcept
     {
-        // setup swapchain
+        // setup swapchain: rendering straight into its images, the projection takes over the display rotation
+        VulkanSwapchainPolicy policy = m_swapchain->getPolicy();
+        policy.mPreRotation = true;
+        m_swapchain->updatePolicy(policy);
         if (!m_swapchain->initialize(m_windowWidth, m_windowHeight))
         {
             VK_LOG_ERROR("TextureSample::createSwapchain : failed to create swapchain fpr presentation.");
@@ -318,11 +307,8 @@ namespace keplar
         m_vkSwapchainKHR = m_swapchain->get();
         m_swapchainImageCount = m_swapchain->getImageCount();
         
-        // vulkan spec suggests max frames in flight should be less than swapchain image count
-        // to prevent CPU stalling while waiting for an image to become available for rendering.
-        // setting an upper limit of 3 balances throughput and avoids stalls.
-        m_maxFramesInFlight = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight = glm::max(1u, m_maxFramesInFlight);
+        // frames in flight are a budget of their own, not derived from the image count (see config::kFramesInFlight)
+        m_maxFramesInFlight = config::kFramesInFlight;
 
         VK_LOG_INFO("TextureSample::createSwapchain : swapchain created successfully (max frames in flight: %d)", m_maxFramesInFlight);
         return true;
@@ -333,14 +319,20 @@ namespace keplar
         // initialize msaa color and depth targets for the current swapchain
         if (m_msaaTarget.initialize(device, *m_swapchain, VK_SAMPLE_COUNT_8_BIT))
         {
-            // success
+            // success: the msaa depth target replaces the swapchain one
             m_sampleCount = m_msaaTarget.getSampleCount();
+            m_swapchain->setDepthAttachment(false);
             VK_LOG_DEBUG("TextureSample::createMsaaTarget : msaa targets created successfully.");
         }
         else 
         {
-            // fall back to no msaa
+            // fall back to no msaa, rendering depth into the swapchain's own target
             VK_LOG_WARN("TextureSample::createMsaaTarget : failed to create msaa color and depth targets.");
+            if (!m_swapchain->setDepthAttachment(true))
+            {
+                VK_LOG_ERROR("TextureSample::createMsaaTarget : failed to create swapchain depth target.");
+                return false;
+            }
         }
 
         return true;
@@ -369,6 +361,19 @@ namespace keplar
         return true;
     }
 
+    bool TextureSample::createStagingBelt(const VulkanDevice& device) noexcept
+    {
+        // persistently mapped staging ring shared by all host-to-device uploads
+        if (!m_stagingBelt.initialize(device))
+        {
+            VK_LOG_ERROR("TextureSample::createStagingBelt : failed to initialize staging belt.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("TextureSample::createStagingBelt successful");
+        return true;
+    }
+
     bool TextureSample::createCommandBuffers() noexcept
     {
         // allocate primary command buffers for each frame in flight
@@ -434,7 +439,7 @@ namespace keplar
             1.0f, 1.0f
         };
 
-        // create device local buffer via staging buffer for upload
+        // create device local buffer via staging belt for upload
         // vulkan buffer creation info
         VkBufferCreateInfo bufferCreateInfo{};
         bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;                                    
@@ -445,7 +450,7 @@ namespace keplar
 
         // create rectangle position buffer
         bufferCreateInfo.size = sizeof(rectangle_position); 
-        if (!m_positionBuffer.createDeviceLocal(device, m_commandPool, bufferCreateInfo, rectangle_position, sizeof(rectangle_position)))
+        if (!m_positionBuffer.createDeviceLocal(device, m_stagingBelt, bufferCreateInfo, rectangle_position, sizeof(rectangle_position)))
         {
             VK_LOG_ERROR("TextureSample::createVertexBuffers failed to create device-local buffer for vertex positions");
             return false;
@@ -453,7 +458,7 @@ namespace keplar
 
         // create rectangle texcoords
         bufferCreateInfo.size = sizeof(rectangle_texcoord); 
-        if (!m_texcoordBuffer.createDeviceLocal(device, m_commandPool, bufferCreateInfo, rectangle_texcoord, sizeof(rectangle_texcoord)))
+        if (!m_texcoordBuffer.createDeviceLocal(device, m_stagingBelt, bufferCreateInfo, rectangle_texcoord, sizeof(rectangle_texcoord)))
         {
             VK_LOG_ERROR("TextureSample::createVertexBuffers failed to create device-local buffer for vertex colors");
             return false;
@@ -466,12 +471,19 @@ namespace keplar
     bool TextureSample::createTextures(const VulkanDevice& device) noexcept
     {
         // load texture from file
-        if (!m_texture.load(device, m_commandPool, "cloth.png", VK_FORMAT_R8G8B8A8_UNORM, true))
+        if (!m_texture.load(device, m_stagingBelt, "cloth.png", VK_FORMAT_R8G8B8A8_UNORM, true))
         {
             VK_LOG_ERROR("TextureSample::createTextures failed to load texture");
             return false;
         }
 
+        // submit vertex and texture uploads in one batch
+        if (!m_stagingBelt.flush())
+        {
+            VK_LOG_ERROR("TextureSample::createTextures failed to flush staged uploads");
+            return false;
+        }
+
         VK_LOG_DEBUG("TextureSample::createTextures successful");
         return true;
     }
@@ -685,7 +697,7 @@ namespace keplar
         depthAttachment.format           = m_swapchain->getDepthFormat();
         depthAttachment.samples          = m_sampleCount;                   
         depthAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;            
-        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;             
+        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;         // depth is not read after the pass
         depthAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;   
         depthAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;  
         depthAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;         
@@ -740,7 +752,7 @@ namespace keplar
         return true;
     }
 
-    bool TextureSample::createGraphicsPipeline() noexcept
+    bool TextureSample::createGraphicsPipeline(const VulkanDevice& device) noexcept
     {
         // vertex input bindings
         VkVertexInputBindingDescription vertexBindings[2]{};
@@ -873,7 +885,7 @@ namespace keplar
         pipelineConfig.mDescriptorSetLayouts.emplace_back(m_descriptorSetLayout.get());
 
         // create graphics pipeline
-        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig))
+        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
         {
             VK_LOG_ERROR("TextureSample::createGraphicsPipeline failed");
             return false;
@@ -1111,6 +1123,7 @@ namespace keplar
         // calculate aspect ratio of window and initialize camera
         const float aspectRatio = static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight);
         m_camera = std::make_shared<Camera>(Camera::Mode::Cinematic, 45.0f, aspectRatio, 0.1f, 100.0f);
+        m_camera->setPreRotation(m_swapchain->getPreRotation());
 
         // register listeners with the platform
         if (auto platform = m_platform.lock())
@@ -13,6 +13,7 @@
 #include "vulkan/vulkan_swapchain.hpp"
 #include "vulkan/vulkan_command_pool.hpp"
 #include "vulkan/vulkan_command_buffer.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
 #include "vulkan/vulkan_render_pass.hpp"
 #include "vulkan/vulkan_framebuffer.hpp"
 #include "vulkan/vulkan_fence.hpp"
@@ -51,6 +52,7 @@ namespace keplar
             bool createSwapchain() noexcept;
             bool createMsaaTarget(const VulkanDevice& device) noexcept;
             bool createCommandPool(const VulkanDevice& device) noexcept;
+            bool createStagingBelt(const VulkanDevice& device) noexcept;
             bool createCommandBuffers() noexcept;
             bool createTextureSamplers(const VulkanDevice& device) noexcept;
             bool createVertexBuffers(const VulkanDevice& device) noexcept;
@@ -61,7 +63,7 @@ namespace keplar
             bool createDescriptorPool() noexcept;
             bool createDescriptorSets() noexcept;
             bool createRenderPasses() noexcept; 
-            bool createGraphicsPipeline() noexcept;
+            bool createGraphicsPipeline(const VulkanDevice& device) noexcept;
             bool createFramebuffers() noexcept;
             bool createSyncPrimitives() noexcept;
             bool recordSceneCommandBuffers() noexcept;
@@ -109,6 +111,7 @@ namespace keplar
 
             // command buffers and synchronization
             VulkanCommandPool                   m_commandPool;
+            VulkanStagingBelt                   m_stagingBelt;
             std::vector<VulkanCommandBuffer>    m_primaryCommandBuffers;
             std::vector<VulkanCommandBuffer>    m_secondaryCommandBuffer;
             VulkanRenderPass                    m_renderPass;
@@ -3,7 +3,9 @@
 // ────────────────────────────────────────────
 
 #include "triangle.hpp"
+#include "core/keplar_config.hpp"
 #include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
 #include "vulkan/vulkan_utils.hpp"
 
 namespace keplar
@@ -59,6 +61,13 @@ namespace keplar
             return false;
         }
 
+        // scene is drawn with dynamic rendering; core in vulkan 1.3 and requested in configureVulkan
+        if (!device->isDynamicRenderingEnabled())
+        {
+            VK_LOG_ERROR("Triangle::initialize failed: dynamic rendering is not supported by the device");
+            return false;
+        }
+
         // setup resources and cache vulkan handles
         m_swapchain       = std::make_unique<VulkanSwapchain>(contextLocked->getSurface(), m_device);
         m_vkDevice        = device->getDevice();
@@ -69,21 +78,20 @@ namespace keplar
         m_windowHeight    = platformLocked->getWindowHeight();
 
         // initialize vulkan resources
-        if (!createSwapchain())             { return false; }
-        if (!createMsaaTarget(*device))     { return false; }
-        if (!createCommandPool(*device))    { return false; }
-        if (!createCommandBuffers())        { return false; }
-        if (!createVertexBuffers(*device))  { return false; }
-        if (!createUniformBuffers(*device)) { return false; }
-        if (!createShaderModules())         { return false; }
-        if (!createDescriptorSetLayouts())  { return false; }
-        if (!createDescriptorPool())        { return false; }
-        if (!createDescriptorSets())        { return false; }
-        if (!createRenderPasses())          { return false; }
-        if (!createGraphicsPipeline())      { return false; }
-        if (!createFramebuffers())          { return false; }
-        if (!createSyncPrimitives())        { return false; }
-        if (!recordSceneCommandBuffers())   { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSwapchain()))               { return false; }
+        if (!KEPLAR_STARTUP_STEP(createMsaaTarget(*device)))       { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandPool(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createStagingBelt(*device)))      { return false; }
+        if (!KEPLAR_STARTUP_STEP(createCommandBuffers()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createVertexBuffers(*device)))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createUniformBuffers(*device)))   { return false; }
+        if (!KEPLAR_STARTUP_STEP(createShaderModules()))           { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSetLayouts()))    { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorPool()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createDescriptorSets()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(createGraphicsPipeline(*device))) { return false; }
+        if (!KEPLAR_STARTUP_STEP(createSyncPrimitives()))          { return false; }
+        if (!KEPLAR_STARTUP_STEP(recordSceneCommandBuffers()))     { return false; }
 
         // initialization complete
         m_readyToRender.store(true);
@@ -217,8 +225,13 @@ namespace keplar
         return true;
     }
 
-    void Triangle::configureVulkan(VulkanContextConfig& /* config */) noexcept
+    void Triangle::configureVulkan(VulkanContextConfig& config) noexcept
     {
+        // begin rendering directly on the swapchain and msaa views (no render pass or framebuffers to rebuild on resize)
+        config.mRequestDynamicRendering = true;
+
+        // the frame's attachment transitions go out as one barrier with per-image stages; falls back to legacy barriers
+        config.mRequestSynchronization2 = true;
     }
 
     void Triangle::onWindowResize(uint32_t width, uint32_t height)
@@ -241,54 +254,31 @@ namespace keplar
             return;
         }
 
-        // store old max frames-in-flight for sync check
-        const uint32_t previousMaxFramesInFlight = m_maxFramesInFlight;
-
         // update swapchain handle and image count
         m_vkSwapchainKHR      = m_swapchain->get();
         m_swapchainImageCount = m_swapchain->getImageCount();
-        m_maxFramesInFlight   = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight   = glm::max(1u, m_maxFramesInFlight);
 
         // reset per-image fence ownership for the new swapchain images
         m_imagesInFlightFences.assign(m_swapchainImageCount, VK_NULL_HANDLE);
 
-        // teardown all dependent resources (framebuffers, pipeline, renderpass, command buffers)
-        for (auto& framebuffer : m_framebuffers)
-        {
-            framebuffer.destroy();
-        }
-
-        m_graphicsPipeline.destroy();
-        m_renderPass.destroy();
+        // teardown size dependent resources; with dynamic rendering and dynamic viewport/scissor
+        // the pipeline only depends on attachment formats and sample count
+        const VkSampleCountFlagBits previousSampleCount = m_sampleCount;
         m_msaaTarget.destroy();
         m_commandPool.deallocate(m_primaryCommandBuffers);
 
         // recreate all dependent resources
         if (!createMsaaTarget(*device))   { return; }
         if (!createCommandBuffers())      { return; }
-        if (!createRenderPasses())        { return; }
-        if (!createGraphicsPipeline())    { return; }
-        if (!createFramebuffers())        { return; }
-        if (!recordSceneCommandBuffers()) { return; }
 
-        // recreate per-frame sync primitives if max frames-in-flight changed
-        if (m_maxFramesInFlight != previousMaxFramesInFlight)
+        if (m_sampleCount != previousSampleCount)
         {
-            for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
-            {
-                auto& frameSync = m_frameSyncPrimitives[i];
-                frameSync.mInFlightFence.destroy();
-                frameSync.mRenderCompleteSemaphore.destroy();
-                frameSync.mImageAvailableSemaphore.destroy();
-            }
-
-            if (!createSyncPrimitives()) 
-            { 
-                return; 
-            }
+            m_graphicsPipeline.destroy();
+            if (!createGraphicsPipeline(*device)) { return; }
         }
 
+        if (!recordSceneCommandBuffers()) { return; }
+
         // update window dimensions 
         m_windowWidth  = width;
         m_windowHeight = height;
@@ -310,11 +300,8 @@ namespace keplar
         m_vkSwapchainKHR = m_swapchain->get();
         m_swapchainImageCount = m_swapchain->getImageCount();
         
-        // vulkan spec suggests max frames in flight should be less than swapchain image count
-        // to prevent CPU stalling while waiting for an image to become available for rendering.
-        // setting an upper limit of 3 balances throughput and avoids stalls.
-        m_maxFramesInFlight = glm::min(3u, m_swapchainImageCount-1);
-        m_maxFramesInFlight = glm::max(1u, m_maxFramesInFlight);
+        // frames in flight are a budget of their own, not derived from the image count (see config::kFramesInFlight)
+        m_maxFramesInFlight = config::kFramesInFlight;
 
         VK_LOG_INFO("Triangle::createSwapchain : swapchain created successfully (max frames in flight: %d)", m_maxFramesInFlight);
         return true;
@@ -325,14 +312,20 @@ namespace keplar
         // initialize msaa color and depth targets for the current swapchain
         if (m_msaaTarget.initialize(device, *m_swapchain, VK_SAMPLE_COUNT_8_BIT))
         {
-            // success
+            // success: the msaa depth target replaces the swapchain one
             m_sampleCount = m_msaaTarget.getSampleCount();
+            m_swapchain->setDepthAttachment(false);
             VK_LOG_DEBUG("Triangle::createMsaaTarget : msaa targets created successfully.");
         }
         else 
         {
-            // fall back to no msaa
+            // fall back to no msaa, rendering depth into the swapchain's own target
             VK_LOG_WARN("Triangle::createMsaaTarget : failed to create msaa color and depth targets.");
+            if (!m_swapchain->setDepthAttachment(true))
+            {
+                VK_LOG_ERROR("Triangle::createMsaaTarget : failed to create swapchain depth target.");
+                return false;
+            }
         }
 
         return true;
@@ -361,6 +354,19 @@ namespace keplar
         return true;
     }
 
+    bool Triangle::createStagingBelt(const VulkanDevice& device) noexcept
+    {
+        // persistently mapped staging ring shared by all host-to-device uploads
+        if (!m_stagingBelt.initialize(device))
+        {
+            VK_LOG_ERROR("Triangle::createStagingBelt : failed to initialize staging belt.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("Triangle::createStagingBelt successful");
+        return true;
+    }
+
     bool Triangle::createCommandBuffers() noexcept
     {
         // allocate primary command buffers for each frame in flight
@@ -403,7 +409,7 @@ namespace keplar
             0.0f, 0.0f, 1.0f   
         };
 
-        // create device local buffer via staging buffer for upload
+        // create device local buffer via staging belt for upload
         // vulkan buffer creation info
         VkBufferCreateInfo bufferCreateInfo{};
         bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;                                    
@@ -414,7 +420,7 @@ namespace keplar
 
         // create triangle position buffer
         bufferCreateInfo.size = sizeof(triangle_position); 
-        if (!m_positionBuffer.createDeviceLocal(device, m_commandPool, bufferCreateInfo, triangle_position, sizeof(triangle_position)))
+        if (!m_positionBuffer.createDeviceLocal(device, m_stagingBelt, bufferCreateInfo, triangle_position, sizeof(triangle_position)))
         {
             VK_LOG_ERROR("Triangle::createVertexBuffers failed to create device-local buffer for vertex positions");
             return false;
@@ -422,11 +428,18 @@ namespace keplar
 
         // create triangle color buffer
         bufferCreateInfo.size = sizeof(triangle_colors); 
-        if (!m_colorBuffer.createDeviceLocal(device, m_commandPool, bufferCreateInfo, triangle_colors, sizeof(triangle_colors)))
+        if (!m_colorBuffer.createDeviceLocal(device, m_stagingBelt, bufferCreateInfo, triangle_colors, sizeof(triangle_colors)))
         {
             VK_LOG_ERROR("Triangle::createVertexBuffers failed to create device-local buffer for vertex colors");
             return false;
         }
+
+        // submit both vertex uploads in one batch
+        if (!m_stagingBelt.flush())
+        {
+            VK_LOG_ERROR("Triangle::createVertexBuffers failed to flush staged uploads");
+            return false;
+        }
         
         VK_LOG_DEBUG("Triangle::createVertexBuffers successful");
         return true;
@@ -586,89 +599,7 @@ namespace keplar
         return true;
     }
 
-    bool Triangle::createRenderPasses() noexcept
-    {
-        // check if msaa is enabled
-        const bool msaaEnabled = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
-
-        // color attachment: description, reference, subpass dependency
-        VkAttachmentDescription colorAttachment{};
-        colorAttachment.flags            = 0;
-        colorAttachment.format           = m_swapchain->getColorFormat();
-        colorAttachment.samples          = m_sampleCount;
-        colorAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        colorAttachment.storeOp          = msaaEnabled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
-        colorAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        colorAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        colorAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout      = msaaEnabled ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        VkAttachmentReference colorAttachmentRef{};
-        colorAttachmentRef.attachment    = 0;                                       
-        colorAttachmentRef.layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;   
-
-        // depth attachment: description, reference, subpass dependency
-        VkAttachmentDescription depthAttachment{};
-        depthAttachment.flags            = 0;
-        depthAttachment.format           = m_swapchain->getDepthFormat();
-        depthAttachment.samples          = m_sampleCount;                   
-        depthAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;            
-        depthAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;             
-        depthAttachment.stencilLoadOp    = VK_ATTACHMENT_LOAD_OP_DONT_CARE;   
-        depthAttachment.stencilStoreOp   = VK_ATTACHMENT_STORE_OP_DONT_CARE;  
-        depthAttachment.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;         
-        depthAttachment.finalLayout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;  
-
-        VkAttachmentReference depthAttachmentRef{};
-        depthAttachmentRef.attachment    = msaaEnabled ? 2 : 1;
-        depthAttachmentRef.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        // resolve attachment: description, reference (msaa only)
-        VkAttachmentDescription resolveAttachment{};
-        VkAttachmentReference resolveAttachmentRef{};
-        if (msaaEnabled)
-        {
-            resolveAttachment                = colorAttachment;
-            resolveAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
-            resolveAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-            resolveAttachment.finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-            resolveAttachmentRef.attachment  = 1;                                       
-            resolveAttachmentRef.layout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL; 
-        }    
-
-        // subpass description 
-        VkSubpassDescription subpass{};
-        subpass.flags                    = 0;
-        subpass.pipelineBindPoint        = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.inputAttachmentCount     = 0;
-        subpass.pInputAttachments        = nullptr;
-        subpass.colorAttachmentCount     = 1;                                   
-        subpass.pColorAttachments        = &colorAttachmentRef;      
-        subpass.pResolveAttachments      = msaaEnabled ? &resolveAttachmentRef : nullptr;
-        subpass.pDepthStencilAttachment  = &depthAttachmentRef;
-        subpass.preserveAttachmentCount  = 0;
-        subpass.pPreserveAttachments     = nullptr;
-
-        // setup attachments, subpasses and dependencies
-        std::vector<VkAttachmentDescription> attachments { colorAttachment }; 
-        if (msaaEnabled) { attachments.emplace_back(resolveAttachment); }  
-        attachments.emplace_back(depthAttachment); 
-
-        std::vector<VkSubpassDescription> subpasses { subpass };
-
-        // setup render pass 
-        if (!m_renderPass.initialize(m_vkDevice, attachments, subpasses, {}))
-        {
-            VK_LOG_ERROR("Triangle::createRenderPasses failed to initialize render pass");
-            return false;
-        }
-
-        VK_LOG_DEBUG("Triangle::createRenderPasses successful");
-        return true;
-    }
-
-    bool Triangle::createGraphicsPipeline() noexcept
+    bool Triangle::createGraphicsPipeline(const VulkanDevice& device) noexcept
     {
         // vertex input bindings
         VkVertexInputBindingDescription vertexBindings[2]{};
@@ -715,30 +646,24 @@ namespace keplar
         inputAssembly.flags = 0;
         inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 
-        // viewport and scissor state
-        auto swapchainExtent = m_swapchain->getExtent();
-
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(swapchainExtent.width);
-        viewport.height = static_cast<float>(swapchainExtent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-
-        VkRect2D scissor{};
-        scissor.offset.x = 0;
-        scissor.offset.y = 0;
-        scissor.extent = swapchainExtent;
-
+        // viewport and scissor state (set dynamically so the pipeline survives resize)
         VkPipelineViewportStateCreateInfo viewportState{};
         viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportState.pNext = nullptr;
         viewportState.flags = 0;
         viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
+        viewportState.pViewports = nullptr;
         viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
+        viewportState.pScissors = nullptr;
+
+        const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.pNext = nullptr;
+        dynamicState.flags = 0;
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
 
         // rasterization state
         VkPipelineRasterizationStateCreateInfo rasterizationState{};
@@ -796,12 +721,14 @@ namespace keplar
         pipelineConfig.mMultisampleState = multisampleState;
         pipelineConfig.mDepthStencilState = depthStencilState;
         pipelineConfig.mColorBlendState = colorBlendState;
-        pipelineConfig.mRenderPass = m_renderPass.get();
-        pipelineConfig.mSubpassIndex = 0;
+        pipelineConfig.mDynamicState = dynamicState;
+        pipelineConfig.mRenderPass = VK_NULL_HANDLE;
+        pipelineConfig.mColorAttachmentFormats.emplace_back(m_swapchain->getColorFormat());
+        pipelineConfig.mDepthAttachmentFormat = m_swapchain->getDepthFormat();
         pipelineConfig.mDescriptorSetLayouts.emplace_back(m_descriptorSetLayout.get());
 
         // create graphics pipeline
-        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig))
+        if (!m_graphicsPipeline.initialize(m_vkDevice, pipelineConfig, device.getPipelineCache().get()))
         {
             VK_LOG_ERROR("Triangle::createGraphicsPipeline failed");
             return false;
@@ -811,74 +738,6 @@ namespace keplar
         return true;
     }
 
-    bool Triangle::createFramebuffers() noexcept
-    {
-        // allocate framebuffer for each swapchain image
-        m_framebuffers.resize(m_swapchainImageCount);
-
-        // get swapchain properties
-        const auto swapchainImageViews = m_swapchain->getColorImageViews();
-        const auto swapchainExtent     = m_swapchain->getExtent();
-        const auto msaaEnabled         = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
-
-        // prefetch attachments
-        VkImageView colorImageView   = VK_NULL_HANDLE;
-        VkImageView depthImageView  = VK_NULL_HANDLE;
-        if (msaaEnabled)
-        {
-            colorImageView  = m_msaaTarget.getColorImageView();
-            depthImageView  = m_msaaTarget.getDepthImageView();
-        }
-        else 
-        {
-            depthImageView  = m_swapchain->getDepthImageView();
-        }
-
-        // framebuffer attachments: color, resolve, depth
-        VkImageView attachments[3]{ VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
-        
-        // framebuffer creation info
-        VkFramebufferCreateInfo framebufferCreateInfo{};
-        framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferCreateInfo.pNext = nullptr;
-        framebufferCreateInfo.flags = 0;
-        framebufferCreateInfo.renderPass = m_renderPass.get();
-        framebufferCreateInfo.pAttachments = attachments;
-        framebufferCreateInfo.width = swapchainExtent.width;
-        framebufferCreateInfo.height = swapchainExtent.height;
-        framebufferCreateInfo.layers = 1;
-
-        // create framebuffer per swapchain image view
-        for (uint32_t i = 0; i < m_swapchainImageCount; ++i)
-        {
-            if (msaaEnabled)
-            {
-                // msaa enabled: [0] multisampled color, [1] swapchain resolve, [2] multisampled depth
-                framebufferCreateInfo.attachmentCount = 3;
-                attachments[0] = colorImageView;
-                attachments[1] = swapchainImageViews[i];
-                attachments[2] = depthImageView;
-            }
-            else 
-            {
-                // msaa disabled: [0] swapchain color, [1] swapchain depth
-                framebufferCreateInfo.attachmentCount = 2;
-                attachments[0] = swapchainImageViews[i];
-                attachments[1] = depthImageView;
-            }
-            
-            // initialize framebuffer 
-            if (!m_framebuffers[i].initialize(m_vkDevice, framebufferCreateInfo))
-            {
-                VK_LOG_ERROR("Triangle::createFramebuffers failed at swapchain image index %u", i);
-                return false;
-            }
-        }
-
-        VK_LOG_DEBUG("Triangle::createFramebuffers successful");
-        return true;
-    }
-
     bool Triangle::createSyncPrimitives() noexcept
     {
         // allocate sync primitives for each frame in flight
@@ -931,11 +790,24 @@ namespace keplar
 
     bool Triangle::recordSceneCommandBuffers() noexcept
     {
-        // secondary command buffer inherts render pass state from the primary
+        // secondary command buffer inherits the dynamic rendering attachment formats from the primary
+        const VkFormat colorFormat = m_swapchain->getColorFormat();
+
+        VkCommandBufferInheritanceRenderingInfo renderingInheritanceInfo{};
+        renderingInheritanceInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+        renderingInheritanceInfo.pNext                   = nullptr;
+        renderingInheritanceInfo.flags                   = 0;
+        renderingInheritanceInfo.viewMask                = 0;
+        renderingInheritanceInfo.colorAttachmentCount    = 1;
+        renderingInheritanceInfo.pColorAttachmentFormats = &colorFormat;
+        renderingInheritanceInfo.depthAttachmentFormat   = m_swapchain->getDepthFormat();
+        renderingInheritanceInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+        renderingInheritanceInfo.rasterizationSamples    = m_sampleCount;
+
         VkCommandBufferInheritanceInfo inheritanceInfo{};
         inheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
-        inheritanceInfo.pNext                = nullptr;
-        inheritanceInfo.renderPass           = m_renderPass.get();
+        inheritanceInfo.pNext                = &renderingInheritanceInfo;
+        inheritanceInfo.renderPass           = VK_NULL_HANDLE;
         inheritanceInfo.subpass              = 0;
         inheritanceInfo.framebuffer          = VK_NULL_HANDLE;
         inheritanceInfo.occlusionQueryEnable = VK_FALSE;
@@ -949,6 +821,11 @@ namespace keplar
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
         beginInfo.pInheritanceInfo = &inheritanceInfo;
 
+        // viewport and scissor cover the current swapchain extent
+        const VkExtent2D swapchainExtent = m_swapchain->getExtent();
+        const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(swapchainExtent.width), static_cast<float>(swapchainExtent.height), 0.0f, 1.0f };
+        const VkRect2D scissor{ { 0, 0 }, swapchainExtent };
+
         for (uint32_t i = 0; i < m_maxFramesInFlight; ++i)
         {
             // reset and begin recording into secondary
@@ -963,6 +840,8 @@ namespace keplar
 
             // record graphics pipeline state, resource bindings, and draw commands for this frame
             m_secondaryCommandBuffer[i].bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.get());
+            m_secondaryCommandBuffer[i].setViewport(viewport);
+            m_secondaryCommandBuffer[i].setScissor(scissor);
             m_secondaryCommandBuffer[i].bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.getLayout(), 0, 1, &m_descriptorSets[i]);
             m_secondaryCommandBuffer[i].bindVertexBuffers(0, 2, vertexBuffers, offset);
             m_secondaryCommandBuffer[i].draw(3, 1, 0, 0); 
@@ -996,39 +875,83 @@ namespace keplar
         // check if msaa is enabled
         const bool msaaEnabled = m_sampleCount > VK_SAMPLE_COUNT_1_BIT;
 
-        // clear values for render pass; color: 0, depth-stencil: 1
-        VkClearValue clearValues[3]{};
+        // attachment images: msaa renders into the multisampled targets and resolves into the swapchain image
+        const VkImage swapchainImage     = m_swapchain->getColorImages()[imageIndex];
+        const VkImageView swapchainView  = m_swapchain->getColorImageViews()[imageIndex];
+        const VkImage depthImage         = msaaEnabled ? m_msaaTarget.getDepthImage() : m_swapchain->getDepthImage();
+        const VkImageView depthView      = msaaEnabled ? m_msaaTarget.getDepthImageView() : m_swapchain->getDepthImageView();
+
+        // depth-stencil formats transition both aspects together
+        const VkFormat depthFormat = m_swapchain->getDepthFormat();
+        const bool hasStencil = depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT || depthFormat == VK_FORMAT_D24_UNORM_S8_UINT || depthFormat == VK_FORMAT_D16_UNORM_S8_UINT;
+        const VkImageSubresourceRange depthRange{ VK_IMAGE_ASPECT_DEPTH_BIT | (hasStencil ? VK_IMAGE_ASPECT_STENCIL_BIT : 0u), 0, 1, 0, 1 };
+
+        // contents are cleared every frame, so transitions start from undefined. color barriers chain onto the
+        // image acquire wait at color output; attachments shared by all frames also order after the previous frame's writes.
+        // all of them go out as one barrier, each with its own stages
+        m_frameBarriers.imageBarrier(swapchainImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+
         if (msaaEnabled)
         {
-            clearValues[0].color        = { 0.0f, 0.0f, 0.0f, 1.0f };
-            clearValues[1].color        = { 0.0f, 0.0f, 0.0f, 1.0f };
-            clearValues[2].depthStencil = { 1.0f, 0 };
-        }
-        else 
-        {
-            clearValues[0].color        = { 0.0f, 0.0f, 0.0f, 1.0f };
-            clearValues[1].depthStencil = { 1.0f, 0 };
-        }
-
-        // render pass begin info (framebuffer updated per command buffer)
-        VkRenderPassBeginInfo renderPassBeginInfo{};
-        renderPassBeginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassBeginInfo.pNext             = nullptr;
-        renderPassBeginInfo.framebuffer       = m_framebuffers[imageIndex].get();
-        renderPassBeginInfo.renderPass        = m_renderPass.get();
-        renderPassBeginInfo.renderArea.offset = {0, 0};
-        renderPassBeginInfo.renderArea.extent = m_swapchain->getExtent();
-        renderPassBeginInfo.clearValueCount   = msaaEnabled ? 3 : 2;
-        renderPassBeginInfo.pClearValues      = clearValues;
-        
-        // begin render pass for this frame
-        commandBuffer.beginRenderPass(renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            m_frameBarriers.imageBarrier(m_msaaTarget.getColorImage(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, 
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+        }
+
+        m_frameBarriers.imageBarrier(depthImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, depthRange,
+            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, 
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        commandBuffer.pipelineBarrier(m_frameBarriers);
+
+        // color attachment: cleared, resolved into the swapchain image when multisampled
+        VkRenderingAttachmentInfo colorAttachment{};
+        colorAttachment.sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        colorAttachment.pNext              = nullptr;
+        colorAttachment.imageView          = msaaEnabled ? m_msaaTarget.getColorImageView() : swapchainView;
+        colorAttachment.imageLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.resolveMode        = msaaEnabled ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE;
+        colorAttachment.resolveImageView   = msaaEnabled ? swapchainView : VK_NULL_HANDLE;
+        colorAttachment.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp             = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp            = msaaEnabled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue.color   = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+        // depth attachment: cleared and discarded, nothing reads it after the pass
+        VkRenderingAttachmentInfo depthAttachment{};
+        depthAttachment.sType                   = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depthAttachment.pNext                   = nullptr;
+        depthAttachment.imageView               = depthView;
+        depthAttachment.imageLayout             = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.resolveMode             = VK_RESOLVE_MODE_NONE;
+        depthAttachment.loadOp                  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp                 = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.clearValue.depthStencil = { 1.0f, 0 };
+
+        // rendering info for this frame's swapchain image
+        VkRenderingInfo renderingInfo{};
+        renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.pNext                = nullptr;
+        renderingInfo.flags                = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+        renderingInfo.renderArea.offset    = { 0, 0 };
+        renderingInfo.renderArea.extent    = m_swapchain->getExtent();
+        renderingInfo.layerCount           = 1;
+        renderingInfo.viewMask             = 0;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments    = &colorAttachment;
+        renderingInfo.pDepthAttachment     = &depthAttachment;
+        renderingInfo.pStencilAttachment   = nullptr;
+
+        // begin rendering for this frame
+        commandBuffer.beginRendering(renderingInfo);
 
         // execute the cached secondary command buffer
         commandBuffer.executeCommands(m_secondaryCommandBuffer[frameIndex]);
 
-        // end current render pass
-        commandBuffer.endRenderPass();
+        // end rendering and hand the swapchain image to presentation
+        commandBuffer.endRendering();
+        commandBuffer.transitionImageLayout(swapchainImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 
         // finalize the command buffer
         return commandBuffer.end();
@@ -13,8 +13,8 @@
 #include "vulkan/vulkan_swapchain.hpp"
 #include "vulkan/vulkan_command_pool.hpp"
 #include "vulkan/vulkan_command_buffer.hpp"
-#include "vulkan/vulkan_render_pass.hpp"
-#include "vulkan/vulkan_framebuffer.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
 #include "vulkan/vulkan_fence.hpp"
 #include "vulkan/vulkan_semaphore.hpp"
 #include "vulkan/vulkan_buffer.hpp"
@@ -48,6 +48,7 @@ namespace keplar
             bool createSwapchain() noexcept;
             bool createMsaaTarget(const VulkanDevice& device) noexcept;
             bool createCommandPool(const VulkanDevice& device) noexcept;
+            bool createStagingBelt(const VulkanDevice& device) noexcept;
             bool createCommandBuffers() noexcept;
             bool createVertexBuffers(const VulkanDevice& device) noexcept;
             bool createUniformBuffers(const VulkanDevice& device) noexcept;
@@ -55,9 +56,7 @@ namespace keplar
             bool createDescriptorSetLayouts() noexcept;
             bool createDescriptorPool() noexcept;
             bool createDescriptorSets() noexcept;
-            bool createRenderPasses() noexcept; 
-            bool createGraphicsPipeline() noexcept;
-            bool createFramebuffers() noexcept;
+            bool createGraphicsPipeline(const VulkanDevice& device) noexcept;
             bool createSyncPrimitives() noexcept;
             bool recordSceneCommandBuffers() noexcept;
             bool recordFrameCommandBuffer(uint32_t frameIndex, uint32_t imageIndex) noexcept;
@@ -101,12 +100,14 @@ namespace keplar
             uint32_t                            m_currentFrameIndex;
             std::atomic<bool>                   m_readyToRender;
 
+            // attachment transitions at frame start, storage kept across frames
+            VulkanBarrierBatch                  m_frameBarriers;
+
             // command buffers and synchronization
             VulkanCommandPool                   m_commandPool;
+            VulkanStagingBelt                   m_stagingBelt;
             std::vector<VulkanCommandBuffer>    m_primaryCommandBuffers;
             std::vector<VulkanCommandBuffer>    m_secondaryCommandBuffer;
-            VulkanRenderPass                    m_renderPass;
-            std::vector<VulkanFramebuffer>      m_framebuffers;
             std::vector<FrameSyncPrimitives>    m_frameSyncPrimitives;
             std::vector<VkFence>                m_imagesInFlightFences;
             
@@ -35,7 +35,7 @@ layout(push_constant) uniform PushConstants
     mat4 model;          // 64 bytes: model matrix
     vec4 baseColor;      // 16 bytes: r,g,b,a
     vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
-    vec4 emissiveColor;  // 16 bytes: r,g,b + padding
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
 } pc;
 
 // -------------------------------------
@@ -0,0 +1,18 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+
+// -------------------------------------
+// outputs: uv over the target, (0, 0) at its top-left
+// -------------------------------------
+
+layout(location = 0) out vec2 outUV;
+
+// -------------------------------------
+// main: one triangle covering the viewport, no vertex input
+// -------------------------------------
+
+void main()
+{
+    outUV = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(outUV * 2.0 - 1.0, 0.0, 1.0);
+}
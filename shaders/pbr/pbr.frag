@@ -1,5 +1,30 @@
 #version 450 core
 #extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
+
+// compiled a second time with -DHALF_PRECISION into pbr_half.frag.spv (needs shaderFloat16): the material terms of the
+// brdf (fresnel, geometry, diffuse, reflectance) run in fp16, while positions, directions, the ggx distribution (whose
+// a^2 underflows and peak overflows fp16 on smooth surfaces), specular, radiance and every sum of lights stay fp32
+#ifdef HALF_PRECISION
+#extension GL_EXT_shader_explicit_arithmetic_types_float16 : require
+#define mfloat float16_t
+#define mvec2  f16vec2
+#define mvec3  f16vec3
+#else
+#define mfloat float
+#define mvec2  vec2
+#define mvec3  vec3
+#endif
+
+// compiled a third time with -DRAY_QUERY_SHADOWS into pbr_rq.frag.spv (needs rayQuery): shadow rays traced with ray queries against
+// RayTracedShadows' top-level structure replace the cascade and cube map lookups
+#ifdef RAY_QUERY_SHADOWS
+#extension GL_EXT_ray_query : require
+#endif
+
+// compiled with -DGBUFFER into pbr_gbuffer.frag.spv (deferred shading): the material terms are written to the compact
+// g-buffer DeferredLighting reads back instead of being lit here; lighting, shadows and the environment run per pixel in
+// deferred_lighting.comp. blended materials are cut out at half coverage, the g-buffer holds one surface per pixel
 
 // -------------------------------------
 // inputs from vertex shader
@@ -17,6 +42,29 @@ layout(location = 4) in vec3 vBitangent;
 
 layout(location = 0) out vec4 fragColor;
 
+#ifdef GBUFFER
+// g-buffer targets, formats of DeferredLighting: fragColor carries emissive rgb and ambient occlusion
+layout(location = 1) out vec4 gAlbedo;     // rgb: base color (srgb target), a: metallic
+layout(location = 2) out vec4 gNormal;     // rg: octahedral world normal, b: roughness
+#endif
+
+// -------------------------------------
+// material permutation (GLTFMaterialFeature bits), specialized per pipeline.
+// the default samples every map, opaque and single-sided
+// -------------------------------------
+
+layout(constant_id = 0) const uint MATERIAL_FEATURES = 0x1Fu;
+
+const bool HAS_BASE_COLOR_MAP         = (MATERIAL_FEATURES & 0x01u) != 0u;
+const bool HAS_METALLIC_ROUGHNESS_MAP = (MATERIAL_FEATURES & 0x02u) != 0u;
+const bool HAS_NORMAL_MAP             = (MATERIAL_FEATURES & 0x04u) != 0u;
+const bool HAS_OCCLUSION_MAP          = (MATERIAL_FEATURES & 0x08u) != 0u;
+const bool HAS_EMISSIVE_MAP           = (MATERIAL_FEATURES & 0x10u) != 0u;
+const bool IS_ALPHA_MASK              = (MATERIAL_FEATURES & 0x20u) != 0u;
+const bool IS_DOUBLE_SIDED            = (MATERIAL_FEATURES & 0x40u) != 0u;
+const bool HAS_PACKED_OCCLUSION       = (MATERIAL_FEATURES & 0x80u) != 0u;  // occlusion in the red channel of the metallic roughness map
+const bool IS_ALPHA_BLEND             = (MATERIAL_FEATURES & 0x100u) != 0u; // blended by the pipeline with the output alpha
+
 // -------------------------------------
 // descriptor set 0: camera / per-frame data
 // -------------------------------------
@@ -27,6 +75,8 @@ layout(set = 0, binding = 0) uniform CameraUBO
     mat4 view;
     mat4 model;
     vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
 } camera;
 
 // -------------------------------------
@@ -43,13 +93,62 @@ layout(set = 1, binding = 5) uniform sampler2D uEmissiveMap;
 // descriptor set 2: lighting data
 // -------------------------------------
 
-layout(constant_id = 0) const int MAX_LIGHTS = 1;
+// clustered lighting: lights are binned per froxel by light_cluster.comp (grid.x == 0: no clusters, shade every light)
+const uint MAX_LIGHTS_PER_CLUSTER = 63;
+const uint CLUSTER_STRIDE = MAX_LIGHTS_PER_CLUSTER + 1;
+
 layout(set = 2, binding = 0) uniform LightUBO
 {
-    vec4 position[MAX_LIGHTS];
-    vec4 color[MAX_LIGHTS];
-    ivec4 count;
-} lights;
+    uvec4 grid;         // xyz: cluster grid dimensions, w: light count
+    vec4  slices;       // x: depth slice scale, y: depth slice bias, zw: cluster tile size in pixels
+    vec4  frustum;      // xy: tangent of the horizontal and vertical half fov, z: near, w: far
+    vec4  environment;  // x: prefiltered map's last mip, y: image-based lighting intensity (0: flat ambient)
+    vec4  sunDirection; // xyz: direction towards the directional light
+    vec4  sunColor;     // rgb: color, w: intensity (0: no directional light)
+    mat4  cascades[4];  // world to cascade clip space (ShadowMaps::kCascadeCount)
+    vec4  cascadeSplits;    // view depth each cascade ends at
+    vec4  cascadeTexels;    // world size of one texel of each cascade
+    vec4  pointShadow;  // xyz: position the shadow cube was rendered from, w: index + 1 of the light casting it (0: none)
+    vec4  shadowParams; // x: cascades in use, y: cube depth scale far / (far - near), z: cube near, w: cube texel size at unit distance
+} lightGrid;
+
+// matches LightClusters::PointLight
+struct PointLight
+{
+    vec4 positionRadius;    // xyz: world-space position, w: range
+    vec4 colorIntensity;    // rgb: color, w: intensity
+};
+
+layout(std430, set = 2, binding = 1) readonly buffer LightBuffer
+{
+    PointLight lights[];
+};
+
+layout(std430, set = 2, binding = 2) readonly buffer ClusterBuffer
+{
+    uint clusters[];
+};
+
+// image-based lighting baked by EnvironmentLighting: diffuse irradiance, ggx-prefiltered specular (roughness per mip), split-sum brdf lut
+layout(set = 2, binding = 3) uniform samplerCube uIrradianceMap;
+layout(set = 2, binding = 4) uniform samplerCube uPrefilteredMap;
+layout(set = 2, binding = 5) uniform sampler2D uBrdfLut;
+
+// depth comparison maps rendered by ShadowMaps: directional cascades and the point light cube (outside reads as lit)
+layout(set = 2, binding = 6) uniform sampler2DArrayShadow uCascadeShadowMap;
+layout(set = 2, binding = 7) uniform samplerCubeShadow uPointShadowMap;
+
+#ifdef RAY_QUERY_SHADOWS
+// the model's placed static opaque geometry built by RayTracedShadows, traced in place of both maps
+layout(set = 2, binding = 8) uniform accelerationStructureEXT uShadowScene;
+
+// ray origin offset per unit of the fragment's largest world coordinate, and the sun ray's length
+const float RAY_ORIGIN_OFFSET = 0.001f;
+const float RAY_SUN_DISTANCE = 10000.0f;
+#endif
+
+// normal offset in texels, on top of the rasterizer's slope bias
+const float SHADOW_NORMAL_OFFSET = 1.5f;
 
 // -------------------------------------
 // push constants: shared vertex + fragment stage
@@ -59,8 +158,8 @@ layout(push_constant) uniform PushConstants
 {
     mat4 model;          // 64 bytes: model matrix
     vec4 baseColor;      // 16 bytes: r,g,b,a
-    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
-    vec4 emissiveColor;  // 16 bytes: r,g,b + padding
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:alpha cutoff
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
 } pc;
 
 // -------------------------------------
@@ -69,9 +168,15 @@ layout(push_constant) uniform PushConstants
 
 #define PI 3.14159265359
 
-vec3 freshnelSchlick(float cosTheta, vec3 F0)
+mvec3 freshnelSchlick(mfloat cosTheta, mvec3 F0)
+{
+    return F0 + (mvec3(1.0f) - F0) * pow(mfloat(1.0f) - cosTheta, mfloat(5.0f));
+}
+
+// rough surfaces reflect less of the environment at grazing angles
+mvec3 freshnelSchlickRoughness(mfloat cosTheta, mvec3 F0, mfloat roughness)
 {
-    return F0 + (1.0f - F0) * pow(1.0f - cosTheta, 5.0f);
+    return F0 + (max(mvec3(mfloat(1.0f) - roughness), F0) - F0) * pow(mfloat(1.0f) - cosTheta, mfloat(5.0f));
 }
 
 float distributionGGX(vec3 N, vec3 H, float roughness)
@@ -83,86 +188,274 @@ float distributionGGX(vec3 N, vec3 H, float roughness)
     return a2 / (PI * denom * denom + 0.0001f);
 }
 
-float geometrySchlickGGX(float NdotV, float roughness)
+mfloat geometrySchlickGGX(mfloat NdotV, mfloat roughness)
 {
-    float r = roughness + 1.0f;
-    float k = (r * r) / 8.0f;
-    return NdotV / (NdotV * (1.0f - k) + k);
+    mfloat r = roughness + mfloat(1.0f);
+    mfloat k = (r * r) / mfloat(8.0f);
+    return NdotV / (NdotV * (mfloat(1.0f) - k) + k);
 }
 
-float geometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+mfloat geometrySmith(vec3 N, vec3 V, vec3 L, mfloat roughness)
 {
-    float NdotV = max(dot(N, V), 0.0f);
-    float NdotL = max(dot(N, L), 0.0f);
+    mfloat NdotV = mfloat(max(dot(N, V), 0.0f));
+    mfloat NdotL = mfloat(max(dot(N, L), 0.0f));
     return geometrySchlickGGX(NdotV, roughness) * geometrySchlickGGX(NdotL, roughness);
 }
 
+// inverse square falloff windowed to zero at the light's range, so culling by range is exact
+float lightAttenuation(float dist, float range)
+{
+    float ratio = dist / range;
+    float window = clamp(1.0f - ratio * ratio * ratio * ratio, 0.0f, 1.0f);
+    return (window * window) / (dist * dist + 0.0001f);
+}
+
+#ifdef RAY_QUERY_SHADOWS
+// 1 when no opaque instance lies along the ray before tMax; the first hit ends the query. the origin is offset along
+// the geometry normal, further on fragments far from the origin where positions lose precision
+float traceShadow(vec3 geometryNormal, vec3 direction, float tMax)
+{
+    vec3 magnitude = abs(vWorldPos);
+    vec3 origin = vWorldPos + geometryNormal * RAY_ORIGIN_OFFSET * (1.0f + max(magnitude.x, max(magnitude.y, magnitude.z)));
+
+    rayQueryEXT query;
+    rayQueryInitializeEXT(query, uShadowScene, gl_RayFlagsTerminateOnFirstHitEXT | gl_RayFlagsOpaqueEXT, 0xFF, origin, 0.0f, direction, tMax);
+    while (rayQueryProceedEXT(query))
+    {
+    }
+    return rayQueryGetIntersectionTypeEXT(query, true) == gl_RayQueryCommittedIntersectionNoneEXT ? 1.0f : 0.0f;
+}
+
+// the sun's ray in place of its cascades (shadowParams.x > 0: shadows enabled)
+float cascadeShadow(vec3 geometryNormal)
+{
+    return lightGrid.shadowParams.x > 0.0f ? traceShadow(geometryNormal, lightGrid.sunDirection.xyz, RAY_SUN_DISTANCE) : 1.0f;
+}
+
+// a ray to every light in range, not just the one a shadow cube was rendered for
+float pointShadow(uint lightIndex, vec3 geometryNormal)
+{
+    if (lightGrid.shadowParams.x <= 0.0f)
+    {
+        return 1.0f;
+    }
+
+    vec3 toLight = lights[lightIndex].positionRadius.xyz - vWorldPos;
+    float dist = length(toLight);
+    return traceShadow(geometryNormal, toLight / max(dist, 0.0001f), dist);
+}
+#else
+// 3x3 bilinear comparisons in the first cascade reaching this fragment's view depth
+float cascadeShadow(vec3 geometryNormal)
+{
+    float viewDepth = -(camera.view * vec4(vWorldPos, 1.0f)).z;
+    uint count = uint(lightGrid.shadowParams.x);
+    uint cascade = 0u;
+    while (cascade < count && viewDepth > lightGrid.cascadeSplits[cascade])
+    {
+        cascade++;
+    }
+    if (cascade >= count)
+    {
+        return 1.0f;
+    }
+
+    vec3 position = vWorldPos + geometryNormal * lightGrid.cascadeTexels[cascade] * SHADOW_NORMAL_OFFSET;
+    vec4 shadowPosition = lightGrid.cascades[cascade] * vec4(position, 1.0f);
+    vec2 uv = shadowPosition.xy * 0.5f + 0.5f;
+    vec2 texel = 1.0f / vec2(textureSize(uCascadeShadowMap, 0).xy);
+
+    float lit = 0.0f;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            lit += texture(uCascadeShadowMap, vec4(uv + vec2(x, y) * texel, float(cascade), shadowPosition.z));
+        }
+    }
+    return lit / 9.0f;
+}
+
+// one bilinear comparison against the face depth of the light-to-fragment vector's major axis
+float pointShadow(uint lightIndex, vec3 geometryNormal)
+{
+    if (uint(lightGrid.pointShadow.w) != lightIndex + 1u)
+    {
+        return 1.0f;
+    }
+
+    vec3 toFragment = vWorldPos - lightGrid.pointShadow.xyz;
+    float major = max(abs(toFragment.x), max(abs(toFragment.y), abs(toFragment.z)));
+    toFragment += geometryNormal * major * lightGrid.shadowParams.w * SHADOW_NORMAL_OFFSET;
+    major = max(abs(toFragment.x), max(abs(toFragment.y), abs(toFragment.z)));
+    float depth = lightGrid.shadowParams.y * (1.0f - lightGrid.shadowParams.z / max(major, lightGrid.shadowParams.z));
+    return texture(uPointShadowMap, vec4(toFragment, depth));
+}
+#endif
+
+vec3 shadeRadiance(vec3 L, vec3 radiance, vec3 N, vec3 V, mvec3 F0, mvec3 albedo, mfloat metallic, mfloat roughness)
+{
+    vec3 H = normalize(V + L);
+    float NDF = distributionGGX(N, H, float(roughness));
+    mfloat G = geometrySmith(N, V, L, roughness);
+    mvec3 F = freshnelSchlick(mfloat(max(dot(H, V), 0.0f)), F0);
+
+    vec3 specular = (NDF * float(G) * vec3(F)) / (4.0f * max(dot(N, V), 0.0f) * max(dot(N, L), 0.0f) + 0.0001f);
+    mvec3 kS = F;
+    mvec3 kD = (mvec3(1.0f) - kS) * (mfloat(1.0f) - metallic);
+
+    float NdotL = max(dot(N, L), 0.0f);
+    return (vec3(kD * albedo * mfloat(1.0f / PI)) + specular) * radiance * NdotL;
+}
+
+vec3 shadeLight(uint index, vec3 N, vec3 geometryNormal, vec3 V, mvec3 F0, mvec3 albedo, mfloat metallic, mfloat roughness)
+{
+    PointLight light = lights[index];
+    vec3 toLight = light.positionRadius.xyz - vWorldPos;
+    float dist = length(toLight);
+    if (dist >= light.positionRadius.w)
+    {
+        return vec3(0.0f);
+    }
+
+    vec3 L = toLight / max(dist, 0.0001f);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.w * lightAttenuation(dist, light.positionRadius.w);
+    return shadeRadiance(L, radiance * pointShadow(index, geometryNormal), N, V, F0, albedo, metallic, roughness);
+}
+
+// record of the froxel containing this fragment
+uint clusterRecord()
+{
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / lightGrid.slices.zw), lightGrid.grid.xy - 1u);
+    float viewDepth = max(-(camera.view * vec4(vWorldPos, 1.0f)).z, lightGrid.frustum.z);
+    uint slice = min(uint(max(log(viewDepth) * lightGrid.slices.x + lightGrid.slices.y, 0.0f)), lightGrid.grid.z - 1u);
+    return (tile.x + tile.y * lightGrid.grid.x + slice * lightGrid.grid.x * lightGrid.grid.y) * CLUSTER_STRIDE;
+}
+
 vec3 calculateNormal()
 {
+    // double-sided back faces shade with the flipped normal
+    vec3 N = normalize(vNormal);
+    if (IS_DOUBLE_SIDED && !gl_FrontFacing)
+    {
+        N = -N;
+    }
+
+    if (!HAS_NORMAL_MAP)
+    {
+        return N;
+    }
+
     vec3 tangentNormal = texture(uNormalMap, vUV).xyz * 2.0f - 1.0f;
     vec3 T = normalize(vTangent);
     vec3 B = normalize(vBitangent);
-    vec3 N = normalize(vNormal);
     return normalize(mat3(T, B, N) * tangentNormal);
 }
 
+#ifdef GBUFFER
+// unit vector to [0, 1]^2 on the octahedron folded onto its upper half; 10 bits per axis hold it to about a tenth of a degree
+vec2 encodeOctahedral(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    vec2 folded = n.z >= 0.0f ? n.xy : (1.0f - abs(n.yx)) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+    return folded * 0.5f + 0.5f;
+}
+#endif
+
 // -------------------------------------
 // fragment stage entry point
 // -------------------------------------
 
 void main(void)
 {   
-    // base color (sRGB -> linear)
-    vec3 albedo = pow(texture(uBaseColorMap, vUV).rgb, vec3(2.2f)) * pc.baseColor.rgb;
+    // base color (sRGB -> linear); maps the material lacks fall back to their factors
+    vec4 baseColor = HAS_BASE_COLOR_MAP ? texture(uBaseColorMap, vUV) : vec4(1.0f);
+
+    // alpha mask: cut out before any other fetch
+    if (IS_ALPHA_MASK && baseColor.a * pc.baseColor.a < pc.pbrFactors.w)
+    {
+        discard;
+    }
+#ifdef GBUFFER
+    if (IS_ALPHA_BLEND && baseColor.a * pc.baseColor.a < 0.5f)
+    {
+        discard;
+    }
+#endif
+    mvec3 albedo = mvec3(pow(baseColor.rgb, vec3(2.2f)) * pc.baseColor.rgb);
     
     // metallic roughness (gltf standard)
-    vec4 mr = texture(uMetallicRoughnessMap, vUV);
-    float metallic = mr.b * pc.pbrFactors.x;
-    float roughness = mr.g * pc.pbrFactors.y;
+    vec4 mr = HAS_METALLIC_ROUGHNESS_MAP ? texture(uMetallicRoughnessMap, vUV) : vec4(1.0f);
+    mfloat metallic = mfloat(mr.b * pc.pbrFactors.x);
+    mfloat roughness = mfloat(mr.g * pc.pbrFactors.y);
     
     // sample ambient occlusion and emissive color
-    float ao = texture(uOcclusionMap, vUV).r;
-    vec3 emissive = texture(uEmissiveMap, vUV).rgb * pc.emissiveColor.rgb;
+    float ao = (HAS_PACKED_OCCLUSION ? mr.r : HAS_OCCLUSION_MAP ? texture(uOcclusionMap, vUV).r : 1.0f) * pc.emissiveColor.w;
+    vec3 emissive = (HAS_EMISSIVE_MAP ? texture(uEmissiveMap, vUV).rgb : vec3(1.0f)) * pc.emissiveColor.rgb;
 
     // compute normal and view direction
     vec3 N = calculateNormal();
-    vec3 V = normalize(camera.position.xyz - vWorldPos);
+    vec3 V = normalize(camera.viewPositions[gl_ViewIndex].xyz - vWorldPos);
+
+#ifdef GBUFFER
+    // linear base color, encoded by the srgb target so its 8 bits go where the eye needs them
+    fragColor = vec4(emissive, ao);
+    gAlbedo = vec4(vec3(albedo), metallic);
+    gNormal = vec4(encodeOctahedral(N), roughness, 0.0f);
+    return;
+#endif
 
     // base reflectance
-    vec3 F0 = mix(vec3(0.04f), albedo, metallic);
+    mvec3 F0 = mix(mvec3(0.04f), albedo, metallic);
     vec3 Lo = vec3(0.0f);
 
-    // accumulate lighting from all direct light sources
-    for (int i = 0; i < lights.count.x; i++)
+    // the interpolated normal offsets shadow lookups, facing the view on back faces
+    vec3 geometryNormal = normalize(vNormal);
+    geometryNormal = dot(geometryNormal, V) < 0.0f ? -geometryNormal : geometryNormal;
+
+    // directional light through its cascades
+    if (lightGrid.sunColor.w > 0.0f)
     {
-        vec3 L = normalize(lights.position[i].xyz - vWorldPos);
-        vec3 H = normalize(V + L);
-
-        float dist = length(lights.position[i].xyz - vWorldPos);
-        vec3 radiance = (lights.color[i].rgb * lights.color[i].w) / (dist * dist);
-
-        float NDF = distributionGGX(N, H, roughness);
-        float G = geometrySmith(N, V, L, roughness);
-        vec3 F = freshnelSchlick(max(dot(H, V), 0.0f), F0);
-
-        vec3 specular = (NDF * G * F) / (4.0f * max(dot(N, V), 0.0f) * max(dot(N, L), 0.0f) + 0.0001f);
-        vec3 kS = F;
-        vec3 kD = (1.0f - kS) * (1.0f - metallic);
-        
-        float NdotL = max(dot(N, L), 0.0f);
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
+        vec3 radiance = lightGrid.sunColor.rgb * lightGrid.sunColor.w * cascadeShadow(geometryNormal);
+        Lo += shadeRadiance(lightGrid.sunDirection.xyz, radiance, N, V, F0, albedo, metallic, roughness);
     }
 
-    // combine ambient, direct lighting, and emissive contributions
-    vec3 ambient = vec3(0.05f) * albedo * ao;
-    vec3 color = ambient + Lo + emissive;
+    // accumulate direct lighting from the lights binned into this fragment's cluster
+    if (lightGrid.grid.x > 0)
+    {
+        uint record = clusterRecord();
+        uint count = clusters[record];
+        for (uint i = 0; i < count; i++)
+        {
+            Lo += shadeLight(clusters[record + 1u + i], N, geometryNormal, V, F0, albedo, metallic, roughness);
+        }
+    }
+    else
+    {
+        for (uint i = 0; i < lightGrid.grid.w; i++)
+        {
+            Lo += shadeLight(i, N, geometryNormal, V, F0, albedo, metallic, roughness);
+        }
+    }
+
+    // ambient from the baked environment: three fetches for the split-sum approximation
+    vec3 ambient = vec3(0.05f) * vec3(albedo) * ao;
+    if (lightGrid.environment.y > 0.0f)
+    {
+        float NdotV = max(dot(N, V), 0.0f);
+        mvec3 F = freshnelSchlickRoughness(mfloat(NdotV), F0, roughness);
+        mvec3 kD = (mvec3(1.0f) - F) * (mfloat(1.0f) - metallic);
 
-    // apply tonemap
-    color = color / (color + vec3(1.0f));
+        // the hdr environment samples stay fp32, only the products of unit range material terms are fp16
+        vec3 irradiance = texture(uIrradianceMap, N).rgb;
+        vec3 prefiltered = textureLod(uPrefilteredMap, reflect(-V, N), float(roughness) * lightGrid.environment.x).rgb;
+        mvec2 brdf = mvec2(texture(uBrdfLut, vec2(NdotV, float(roughness))).rg);
+        ambient = (vec3(kD * albedo) * irradiance + prefiltered * vec3(F * brdf.x + brdf.y)) * ao * lightGrid.environment.y;
+    }
 
-    // apply gamma 
-    color = pow(color, vec3(1.0f / 2.2f));
+    // combine ambient, direct lighting, and emissive contributions
+    vec3 color = ambient + Lo + emissive;
 
-    // final color
-    fragColor = vec4(color, 1.0f);
+    // linear hdr radiance; exposure, tonemap and gamma run once per pixel after the resolve (tonemap.comp)
+    fragColor = vec4(color, IS_ALPHA_BLEND ? baseColor.a * pc.baseColor.a : 1.0f);
 }
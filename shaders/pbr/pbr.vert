@@ -1,5 +1,6 @@
 #version 450 core
 #extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
 
 // -------------------------------------
 // vertex inputs
@@ -20,6 +21,9 @@ layout(location = 2) out vec3 vNormal;
 layout(location = 3) out vec3 vTangent;
 layout(location = 4) out vec3 vBitangent;
 
+// the depth pre-pass (pbr_depth.vert) computes the same position: the main pass tests EQUAL against it
+invariant gl_Position;
+
 // -------------------------------------
 // descriptor set 0: camera / per-frame data
 // -------------------------------------
@@ -30,6 +34,8 @@ layout(set = 0, binding = 0) uniform CameraUBO
     mat4 view;
     mat4 model;
     vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
 } camera;
 
 // -------------------------------------
@@ -41,7 +47,7 @@ layout(push_constant) uniform PushConstants
     mat4 model;          // 64 bytes: model matrix
     vec4 baseColor;      // 16 bytes: r,g,b,a
     vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
-    vec4 emissiveColor;  // 16 bytes: r,g,b + padding
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
 } pc;
 
 // -------------------------------------
@@ -65,6 +71,6 @@ void main(void)
     vBitangent = normalize(cross(vNormal, vTangent) * inTangent.w);
 
     // apply view and projection transform
-    gl_Position = camera.projection * camera.view * worldPos;
+    gl_Position = camera.viewProjections[gl_ViewIndex] * worldPos;
 }
 
@@ -0,0 +1,420 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
+#extension GL_EXT_nonuniform_qualifier : require
+
+// compiled a second time with -DRAY_QUERY_SHADOWS into pbr_bindless_rq.frag.spv (needs rayQuery): shadow rays traced with ray queries against
+// RayTracedShadows' top-level structure replace the cascade and cube map lookups
+#ifdef RAY_QUERY_SHADOWS
+#extension GL_EXT_ray_query : require
+#endif
+
+// compiled with -DGBUFFER into pbr_bindless_gbuffer.frag.spv (deferred shading): the material terms are written to the compact
+// g-buffer DeferredLighting reads back instead of being lit here; lighting, shadows and the environment run per pixel in
+// deferred_lighting.comp. blended materials are cut out at half coverage, the g-buffer holds one surface per pixel
+
+// -------------------------------------
+// inputs from vertex shader
+// -------------------------------------
+
+layout(location = 0) in vec3 vWorldPos;
+layout(location = 1) in vec2 vUV;
+layout(location = 2) in vec3 vNormal;
+layout(location = 3) in vec3 vTangent;
+layout(location = 4) in vec3 vBitangent;
+layout(location = 5) flat in uint vMaterialIndex;
+
+// -------------------------------------
+// fragment output
+// -------------------------------------
+
+layout(location = 0) out vec4 fragColor;
+
+#ifdef GBUFFER
+// g-buffer targets, formats of DeferredLighting: fragColor carries emissive rgb and ambient occlusion
+layout(location = 1) out vec4 gAlbedo;     // rgb: base color (srgb target), a: metallic
+layout(location = 2) out vec4 gNormal;     // rg: octahedral world normal, b: roughness
+#endif
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+    mat4 model;
+    vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
+} camera;
+
+// -------------------------------------
+// descriptor set 1: bindless material table and model textures (binding 1 holds the vertex stage object records)
+// -------------------------------------
+
+// GLTFModel BindlessMaterial; texture slots index uTextures, -1 when unused
+struct Material
+{
+    vec4  baseColor;
+    vec4  pbrFactors;       // x:metallic, y:roughness, z:specular, w:unused
+    vec4  emissiveColor;    // w:occlusion factor
+    ivec4 textures;         // x:base color, y:metallic roughness, z:normal, w:occlusion
+    ivec4 extraTextures;    // x:emissive, y:1 if occlusion is the red channel of the metallic roughness map
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer MaterialBuffer
+{
+    Material materials[];
+};
+
+layout(set = 1, binding = 2) uniform sampler2D uTextures[];
+
+// -------------------------------------
+// descriptor set 2: lighting data
+// -------------------------------------
+
+// clustered lighting: lights are binned per froxel by light_cluster.comp (grid.x == 0: no clusters, shade every light)
+const uint MAX_LIGHTS_PER_CLUSTER = 63;
+const uint CLUSTER_STRIDE = MAX_LIGHTS_PER_CLUSTER + 1;
+
+layout(set = 2, binding = 0) uniform LightUBO
+{
+    uvec4 grid;         // xyz: cluster grid dimensions, w: light count
+    vec4  slices;       // x: depth slice scale, y: depth slice bias, zw: cluster tile size in pixels
+    vec4  frustum;      // xy: tangent of the horizontal and vertical half fov, z: near, w: far
+    vec4  environment;  // x: prefiltered map's last mip, y: image-based lighting intensity (0: flat ambient)
+    vec4  sunDirection; // xyz: direction towards the directional light
+    vec4  sunColor;     // rgb: color, w: intensity (0: no directional light)
+    mat4  cascades[4];  // world to cascade clip space (ShadowMaps::kCascadeCount)
+    vec4  cascadeSplits;    // view depth each cascade ends at
+    vec4  cascadeTexels;    // world size of one texel of each cascade
+    vec4  pointShadow;  // xyz: position the shadow cube was rendered from, w: index + 1 of the light casting it (0: none)
+    vec4  shadowParams; // x: cascades in use, y: cube depth scale far / (far - near), z: cube near, w: cube texel size at unit distance
+} lightGrid;
+
+// matches LightClusters::PointLight
+struct PointLight
+{
+    vec4 positionRadius;    // xyz: world-space position, w: range
+    vec4 colorIntensity;    // rgb: color, w: intensity
+};
+
+layout(std430, set = 2, binding = 1) readonly buffer LightBuffer
+{
+    PointLight lights[];
+};
+
+layout(std430, set = 2, binding = 2) readonly buffer ClusterBuffer
+{
+    uint clusters[];
+};
+
+// image-based lighting baked by EnvironmentLighting: diffuse irradiance, ggx-prefiltered specular (roughness per mip), split-sum brdf lut
+layout(set = 2, binding = 3) uniform samplerCube uIrradianceMap;
+layout(set = 2, binding = 4) uniform samplerCube uPrefilteredMap;
+layout(set = 2, binding = 5) uniform sampler2D uBrdfLut;
+
+// depth comparison maps rendered by ShadowMaps: directional cascades and the point light cube (outside reads as lit)
+layout(set = 2, binding = 6) uniform sampler2DArrayShadow uCascadeShadowMap;
+layout(set = 2, binding = 7) uniform samplerCubeShadow uPointShadowMap;
+
+#ifdef RAY_QUERY_SHADOWS
+// the model's placed static opaque geometry built by RayTracedShadows, traced in place of both maps
+layout(set = 2, binding = 8) uniform accelerationStructureEXT uShadowScene;
+
+// ray origin offset per unit of the fragment's largest world coordinate, and the sun ray's length
+const float RAY_ORIGIN_OFFSET = 0.001f;
+const float RAY_SUN_DISTANCE = 10000.0f;
+#endif
+
+// normal offset in texels, on top of the rasterizer's slope bias
+const float SHADOW_NORMAL_OFFSET = 1.5f;
+
+// -------------------------------------
+// PBR Microfacet Model Functions
+// -------------------------------------
+
+#define PI 3.14159265359
+
+vec3 freshnelSchlick(float cosTheta, vec3 F0)
+{
+    return F0 + (1.0f - F0) * pow(1.0f - cosTheta, 5.0f);
+}
+
+// rough surfaces reflect less of the environment at grazing angles
+vec3 freshnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
+{
+    return F0 + (max(vec3(1.0f - roughness), F0) - F0) * pow(1.0f - cosTheta, 5.0f);
+}
+
+float distributionGGX(vec3 N, vec3 H, float roughness)
+{
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0f);
+    float denom = (NdotH * NdotH) * (a2 - 1.0f) + 1.0f;
+    return a2 / (PI * denom * denom + 0.0001f);
+}
+
+float geometrySchlickGGX(float NdotV, float roughness)
+{
+    float r = roughness + 1.0f;
+    float k = (r * r) / 8.0f;
+    return NdotV / (NdotV * (1.0f - k) + k);
+}
+
+float geometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+{
+    float NdotV = max(dot(N, V), 0.0f);
+    float NdotL = max(dot(N, L), 0.0f);
+    return geometrySchlickGGX(NdotV, roughness) * geometrySchlickGGX(NdotL, roughness);
+}
+
+// unused slots return the fallback, so materials without a map keep their factors
+vec4 sampleMaterialTexture(int slot, vec4 fallback)
+{
+    return slot >= 0 ? texture(uTextures[nonuniformEXT(slot)], vUV) : fallback;
+}
+
+// inverse square falloff windowed to zero at the light's range, so culling by range is exact
+float lightAttenuation(float dist, float range)
+{
+    float ratio = dist / range;
+    float window = clamp(1.0f - ratio * ratio * ratio * ratio, 0.0f, 1.0f);
+    return (window * window) / (dist * dist + 0.0001f);
+}
+
+#ifdef RAY_QUERY_SHADOWS
+// 1 when no opaque instance lies along the ray before tMax; the first hit ends the query. the origin is offset along
+// the geometry normal, further on fragments far from the origin where positions lose precision
+float traceShadow(vec3 geometryNormal, vec3 direction, float tMax)
+{
+    vec3 magnitude = abs(vWorldPos);
+    vec3 origin = vWorldPos + geometryNormal * RAY_ORIGIN_OFFSET * (1.0f + max(magnitude.x, max(magnitude.y, magnitude.z)));
+
+    rayQueryEXT query;
+    rayQueryInitializeEXT(query, uShadowScene, gl_RayFlagsTerminateOnFirstHitEXT | gl_RayFlagsOpaqueEXT, 0xFF, origin, 0.0f, direction, tMax);
+    while (rayQueryProceedEXT(query))
+    {
+    }
+    return rayQueryGetIntersectionTypeEXT(query, true) == gl_RayQueryCommittedIntersectionNoneEXT ? 1.0f : 0.0f;
+}
+
+// the sun's ray in place of its cascades (shadowParams.x > 0: shadows enabled)
+float cascadeShadow(vec3 geometryNormal)
+{
+    return lightGrid.shadowParams.x > 0.0f ? traceShadow(geometryNormal, lightGrid.sunDirection.xyz, RAY_SUN_DISTANCE) : 1.0f;
+}
+
+// a ray to every light in range, not just the one a shadow cube was rendered for
+float pointShadow(uint lightIndex, vec3 geometryNormal)
+{
+    if (lightGrid.shadowParams.x <= 0.0f)
+    {
+        return 1.0f;
+    }
+
+    vec3 toLight = lights[lightIndex].positionRadius.xyz - vWorldPos;
+    float dist = length(toLight);
+    return traceShadow(geometryNormal, toLight / max(dist, 0.0001f), dist);
+}
+#else
+// 3x3 bilinear comparisons in the first cascade reaching this fragment's view depth
+float cascadeShadow(vec3 geometryNormal)
+{
+    float viewDepth = -(camera.view * vec4(vWorldPos, 1.0f)).z;
+    uint count = uint(lightGrid.shadowParams.x);
+    uint cascade = 0u;
+    while (cascade < count && viewDepth > lightGrid.cascadeSplits[cascade])
+    {
+        cascade++;
+    }
+    if (cascade >= count)
+    {
+        return 1.0f;
+    }
+
+    vec3 position = vWorldPos + geometryNormal * lightGrid.cascadeTexels[cascade] * SHADOW_NORMAL_OFFSET;
+    vec4 shadowPosition = lightGrid.cascades[cascade] * vec4(position, 1.0f);
+    vec2 uv = shadowPosition.xy * 0.5f + 0.5f;
+    vec2 texel = 1.0f / vec2(textureSize(uCascadeShadowMap, 0).xy);
+
+    float lit = 0.0f;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            lit += texture(uCascadeShadowMap, vec4(uv + vec2(x, y) * texel, float(cascade), shadowPosition.z));
+        }
+    }
+    return lit / 9.0f;
+}
+
+// one bilinear comparison against the face depth of the light-to-fragment vector's major axis
+float pointShadow(uint lightIndex, vec3 geometryNormal)
+{
+    if (uint(lightGrid.pointShadow.w) != lightIndex + 1u)
+    {
+        return 1.0f;
+    }
+
+    vec3 toFragment = vWorldPos - lightGrid.pointShadow.xyz;
+    float major = max(abs(toFragment.x), max(abs(toFragment.y), abs(toFragment.z)));
+    toFragment += geometryNormal * major * lightGrid.shadowParams.w * SHADOW_NORMAL_OFFSET;
+    major = max(abs(toFragment.x), max(abs(toFragment.y), abs(toFragment.z)));
+    float depth = lightGrid.shadowParams.y * (1.0f - lightGrid.shadowParams.z / max(major, lightGrid.shadowParams.z));
+    return texture(uPointShadowMap, vec4(toFragment, depth));
+}
+#endif
+
+vec3 shadeRadiance(vec3 L, vec3 radiance, vec3 N, vec3 V, vec3 F0, vec3 albedo, float metallic, float roughness)
+{
+    vec3 H = normalize(V + L);
+    float NDF = distributionGGX(N, H, roughness);
+    float G = geometrySmith(N, V, L, roughness);
+    vec3 F = freshnelSchlick(max(dot(H, V), 0.0f), F0);
+
+    vec3 specular = (NDF * G * F) / (4.0f * max(dot(N, V), 0.0f) * max(dot(N, L), 0.0f) + 0.0001f);
+    vec3 kS = F;
+    vec3 kD = (1.0f - kS) * (1.0f - metallic);
+
+    float NdotL = max(dot(N, L), 0.0f);
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
+vec3 shadeLight(uint index, vec3 N, vec3 geometryNormal, vec3 V, vec3 F0, vec3 albedo, float metallic, float roughness)
+{
+    PointLight light = lights[index];
+    vec3 toLight = light.positionRadius.xyz - vWorldPos;
+    float dist = length(toLight);
+    if (dist >= light.positionRadius.w)
+    {
+        return vec3(0.0f);
+    }
+
+    vec3 L = toLight / max(dist, 0.0001f);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.w * lightAttenuation(dist, light.positionRadius.w);
+    return shadeRadiance(L, radiance * pointShadow(index, geometryNormal), N, V, F0, albedo, metallic, roughness);
+}
+
+// record of the froxel containing this fragment
+uint clusterRecord()
+{
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / lightGrid.slices.zw), lightGrid.grid.xy - 1u);
+    float viewDepth = max(-(camera.view * vec4(vWorldPos, 1.0f)).z, lightGrid.frustum.z);
+    uint slice = min(uint(max(log(viewDepth) * lightGrid.slices.x + lightGrid.slices.y, 0.0f)), lightGrid.grid.z - 1u);
+    return (tile.x + tile.y * lightGrid.grid.x + slice * lightGrid.grid.x * lightGrid.grid.y) * CLUSTER_STRIDE;
+}
+
+vec3 calculateNormal(int slot)
+{
+    if (slot < 0)
+    {
+        return normalize(vNormal);
+    }
+
+    vec3 tangentNormal = sampleMaterialTexture(slot, vec4(0.5f, 0.5f, 1.0f, 1.0f)).xyz * 2.0f - 1.0f;
+    vec3 T = normalize(vTangent);
+    vec3 B = normalize(vBitangent);
+    vec3 N = normalize(vNormal);
+    return normalize(mat3(T, B, N) * tangentNormal);
+}
+
+#ifdef GBUFFER
+// unit vector to [0, 1]^2 on the octahedron folded onto its upper half; 10 bits per axis hold it to about a tenth of a degree
+vec2 encodeOctahedral(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    vec2 folded = n.z >= 0.0f ? n.xy : (1.0f - abs(n.yx)) * vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+    return folded * 0.5f + 0.5f;
+}
+#endif
+
+// -------------------------------------
+// fragment stage entry point
+// -------------------------------------
+
+void main(void)
+{   
+    // material of this draw
+    Material material = materials[vMaterialIndex];
+
+    // base color (sRGB -> linear)
+    vec3 albedo = pow(sampleMaterialTexture(material.textures.x, vec4(1.0f)).rgb, vec3(2.2f)) * material.baseColor.rgb;
+    
+    // metallic roughness (gltf standard)
+    vec4 mr = sampleMaterialTexture(material.textures.y, vec4(1.0f));
+    float metallic = mr.b * material.pbrFactors.x;
+    float roughness = mr.g * material.pbrFactors.y;
+    
+    // sample ambient occlusion and emissive color
+    float ao = (material.extraTextures.y != 0 ? mr.r : sampleMaterialTexture(material.textures.w, vec4(1.0f)).r) * material.emissiveColor.w;
+    vec3 emissive = sampleMaterialTexture(material.extraTextures.x, vec4(1.0f)).rgb * material.emissiveColor.rgb;
+
+    // compute normal and view direction
+    vec3 N = calculateNormal(material.textures.z);
+    vec3 V = normalize(camera.viewPositions[gl_ViewIndex].xyz - vWorldPos);
+
+#ifdef GBUFFER
+    // linear base color, encoded by the srgb target so its 8 bits go where the eye needs them
+    fragColor = vec4(emissive, ao);
+    gAlbedo = vec4(albedo, metallic);
+    gNormal = vec4(encodeOctahedral(N), roughness, 0.0f);
+    return;
+#endif
+
+    // base reflectance
+    vec3 F0 = mix(vec3(0.04f), albedo, metallic);
+    vec3 Lo = vec3(0.0f);
+
+    // the interpolated normal offsets shadow lookups, facing the view on back faces
+    vec3 geometryNormal = normalize(vNormal);
+    geometryNormal = dot(geometryNormal, V) < 0.0f ? -geometryNormal : geometryNormal;
+
+    // directional light through its cascades
+    if (lightGrid.sunColor.w > 0.0f)
+    {
+        vec3 radiance = lightGrid.sunColor.rgb * lightGrid.sunColor.w * cascadeShadow(geometryNormal);
+        Lo += shadeRadiance(lightGrid.sunDirection.xyz, radiance, N, V, F0, albedo, metallic, roughness);
+    }
+
+    // accumulate direct lighting from the lights binned into this fragment's cluster
+    if (lightGrid.grid.x > 0)
+    {
+        uint record = clusterRecord();
+        uint count = clusters[record];
+        for (uint i = 0; i < count; i++)
+        {
+            Lo += shadeLight(clusters[record + 1u + i], N, geometryNormal, V, F0, albedo, metallic, roughness);
+        }
+    }
+    else
+    {
+        for (uint i = 0; i < lightGrid.grid.w; i++)
+        {
+            Lo += shadeLight(i, N, geometryNormal, V, F0, albedo, metallic, roughness);
+        }
+    }
+
+    // ambient from the baked environment: three fetches for the split-sum approximation
+    vec3 ambient = vec3(0.05f) * albedo * ao;
+    if (lightGrid.environment.y > 0.0f)
+    {
+        float NdotV = max(dot(N, V), 0.0f);
+        vec3 F = freshnelSchlickRoughness(NdotV, F0, roughness);
+        vec3 kD = (1.0f - F) * (1.0f - metallic);
+
+        vec3 irradiance = texture(uIrradianceMap, N).rgb;
+        vec3 prefiltered = textureLod(uPrefilteredMap, reflect(-V, N), roughness * lightGrid.environment.x).rgb;
+        vec2 brdf = texture(uBrdfLut, vec2(NdotV, roughness)).rg;
+        ambient = (kD * irradiance * albedo + prefiltered * (F * brdf.x + brdf.y)) * ao * lightGrid.environment.y;
+    }
+
+    // combine ambient, direct lighting, and emissive contributions
+    vec3 color = ambient + Lo + emissive;
+
+    // linear hdr radiance; exposure, tonemap and gamma run once per pixel after the resolve (tonemap.comp)
+    fragColor = vec4(color, 1.0f);
+}
@@ -0,0 +1,47 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
+
+// -------------------------------------
+// vertex inputs: the position-only stream
+// -------------------------------------
+
+layout(location = 0) in vec4 inPosition;
+
+// must match pbr.vert bit for bit: the main pass tests EQUAL against this depth
+invariant gl_Position;
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+    mat4 model;
+    vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
+} camera;
+
+// -------------------------------------
+// push constants: the scene layout, only the model matrix is read
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: model matrix
+} pc;
+
+// -------------------------------------
+// vertex stage entry point 
+// -------------------------------------
+
+void main(void) 
+{ 
+    // same operations in the same order as pbr.vert
+    mat4 localToWorld = camera.model * pc.model;
+    vec4 worldPos = localToWorld * inPosition;
+    gl_Position = camera.viewProjections[gl_ViewIndex] * worldPos;
+}
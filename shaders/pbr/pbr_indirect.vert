@@ -0,0 +1,79 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
+
+// -------------------------------------
+// vertex inputs
+// -------------------------------------
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+layout(location = 3) in vec4 inTangent;
+
+// per-draw model matrix (instance rate, indexed through firstInstance)
+layout(location = 4) in mat4 inModel;
+
+// ----------------------------
+// output to fragment shader (varyings)
+// ----------------------------
+
+layout(location = 0) out vec3 vWorldPos;
+layout(location = 1) out vec2 vUV;
+layout(location = 2) out vec3 vNormal;
+layout(location = 3) out vec3 vTangent;
+layout(location = 4) out vec3 vBitangent;
+layout(location = 5) flat out uint vMaterialIndex;
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+    mat4 model;
+    vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
+} camera;
+
+// -------------------------------------
+// push constants: shared vertex + fragment stage (model unused, supplied per draw)
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: model matrix
+    vec4 baseColor;      // 16 bytes: r,g,b,a
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
+    uvec4 materialInfo;  // 16 bytes: x:material index (bindless material table)
+} pc;
+
+// -------------------------------------
+// vertex stage entry point 
+// -------------------------------------
+
+void main(void) 
+{ 
+    // compute model to world transform matrix
+    mat4 localToWorld = camera.model * inModel;
+    vMaterialIndex = pc.materialInfo.x;
+
+    // transform position from model to world space 
+    vec4 worldPos = localToWorld * inPosition;
+    vWorldPos = worldPos.xyz;
+    vUV = inUV;
+
+    // compute normal matrix and transform normal, tangent vectors to world space
+    mat3 normalMatrix = transpose(inverse(mat3(localToWorld)));
+    vNormal = normalize(normalMatrix * inNormal);
+    vTangent = normalize(normalMatrix * inTangent.xyz);
+    vBitangent = normalize(cross(vNormal, vTangent) * inTangent.w);
+
+    // apply view and projection transform
+    gl_Position = camera.viewProjections[gl_ViewIndex] * worldPos;
+}
+
@@ -0,0 +1,99 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
+
+// compiled a second time with -DMULTI_DRAW into pbr_object_multi.vert.spv (needs shaderDrawParameters): the draws of one
+// vkCmdDrawMultiIndexedEXT share the pushed constants and step through their records by gl_DrawID
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters : require
+#define DRAW_INDEX gl_DrawIDARB
+#else
+#define DRAW_INDEX 0
+#endif
+
+// -------------------------------------
+// vertex inputs
+// -------------------------------------
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+layout(location = 3) in vec4 inTangent;
+
+// ----------------------------
+// output to fragment shader (varyings)
+// ----------------------------
+
+layout(location = 0) out vec3 vWorldPos;
+layout(location = 1) out vec2 vUV;
+layout(location = 2) out vec3 vNormal;
+layout(location = 3) out vec3 vTangent;
+layout(location = 4) out vec3 vBitangent;
+layout(location = 5) flat out uint vMaterialIndex;
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+    mat4 model;
+    vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
+} camera;
+
+// -------------------------------------
+// descriptor set 1: per-frame object records (GLTFModel ObjectData, std430)
+// -------------------------------------
+
+struct Object
+{
+    mat4  model;
+    uvec4 info;         // x:material index
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer ObjectBuffer
+{
+    Object objects[];
+};
+
+// -------------------------------------
+// push constants: first object record of the draw, and records per draw of a multi-draw
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    uint objectIndex;
+    uint drawStride;
+} pc;
+
+// -------------------------------------
+// vertex stage entry point 
+// -------------------------------------
+
+void main(void) 
+{ 
+    // instances of one draw read consecutive records, following draws of a multi-draw the next ones
+    Object object = objects[pc.objectIndex + uint(DRAW_INDEX) * pc.drawStride + gl_InstanceIndex];
+    vMaterialIndex = object.info.x;
+
+    // compute model to world transform matrix
+    mat4 localToWorld = camera.model * object.model;
+
+    // transform position from model to world space 
+    vec4 worldPos = localToWorld * inPosition;
+    vWorldPos = worldPos.xyz;
+    vUV = inUV;
+
+    // compute normal matrix and transform normal, tangent vectors to world space
+    mat3 normalMatrix = transpose(inverse(mat3(localToWorld)));
+    vNormal = normalize(normalMatrix * inNormal);
+    vTangent = normalize(normalMatrix * inTangent.xyz);
+    vBitangent = normalize(cross(vNormal, vTangent) * inTangent.w);
+
+    // apply view and projection transform
+    gl_Position = camera.viewProjections[gl_ViewIndex] * worldPos;
+}
@@ -0,0 +1,120 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+#extension GL_EXT_multiview : require
+#extension GL_EXT_buffer_reference2 : require
+#extension GL_EXT_buffer_reference_uvec2 : require
+
+// -------------------------------------
+// vertex inputs: per-draw model matrix only (instance rate, indexed through firstInstance);
+// vertices are pulled from the pool whose address the draw pushes
+// -------------------------------------
+
+layout(location = 4) in mat4 inModel;
+
+// ----------------------------
+// output to fragment shader (varyings)
+// ----------------------------
+
+layout(location = 0) out vec3 vWorldPos;
+layout(location = 1) out vec2 vUV;
+layout(location = 2) out vec3 vNormal;
+layout(location = 3) out vec3 vTangent;
+layout(location = 4) out vec3 vBitangent;
+layout(location = 5) flat out uint vMaterialIndex;
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+    mat4 model;
+    vec4 position;
+    mat4 viewProjections[2];    // per view of multiview passes (gl_ViewIndex); the members above are the center view
+    vec4 viewPositions[2];
+} camera;
+
+// -------------------------------------
+// vertex pool: raw words, in either vertex layout
+// -------------------------------------
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer VertexWords
+{
+    uint words[];
+};
+
+// -------------------------------------
+// push constants: shared vertex + fragment stage (model unused, supplied per draw)
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: model matrix
+    vec4 baseColor;      // 16 bytes: r,g,b,a
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
+    uvec4 materialInfo;  // 16 bytes: x:material index, y:1 if packed vertices, zw:vertex pool address
+} pc;
+
+// -------------------------------------
+// vertex fetch: the same decode the vertex input formats apply
+// -------------------------------------
+
+void loadVertex(uint index, out vec4 position, out vec3 normal, out vec2 uv, out vec4 tangent)
+{
+    VertexWords pool = VertexWords(pc.materialInfo.zw);
+    if (pc.materialInfo.y != 0u)
+    {
+        // unorm16 position, snorm16 normal, half2 uv, snorm8 tangent (6 words)
+        uint base = index * 6u;
+        position = vec4(unpackUnorm2x16(pool.words[base + 0u]), unpackUnorm2x16(pool.words[base + 1u]));
+        normal   = vec3(unpackSnorm2x16(pool.words[base + 2u]), unpackSnorm2x16(pool.words[base + 3u]).x);
+        uv       = unpackHalf2x16(pool.words[base + 4u]);
+        tangent  = unpackSnorm4x8(pool.words[base + 5u]);
+    }
+    else
+    {
+        // vec4 position, vec3 normal, vec2 uv, vec4 tangent (13 words)
+        uint base = index * 13u;
+        position = vec4(uintBitsToFloat(pool.words[base + 0u]), uintBitsToFloat(pool.words[base + 1u]), 
+                        uintBitsToFloat(pool.words[base + 2u]), uintBitsToFloat(pool.words[base + 3u]));
+        normal   = vec3(uintBitsToFloat(pool.words[base + 4u]), uintBitsToFloat(pool.words[base + 5u]), uintBitsToFloat(pool.words[base + 6u]));
+        uv       = vec2(uintBitsToFloat(pool.words[base + 7u]), uintBitsToFloat(pool.words[base + 8u]));
+        tangent  = vec4(uintBitsToFloat(pool.words[base + 9u]), uintBitsToFloat(pool.words[base + 10u]), 
+                        uintBitsToFloat(pool.words[base + 11u]), uintBitsToFloat(pool.words[base + 12u]));
+    }
+}
+
+// -------------------------------------
+// vertex stage entry point 
+// -------------------------------------
+
+void main(void) 
+{ 
+    // indices still come from the bound index buffer: gl_VertexIndex already includes the command's vertexOffset
+    vec4 position;
+    vec3 normal;
+    vec2 uv;
+    vec4 tangent;
+    loadVertex(uint(gl_VertexIndex), position, normal, uv, tangent);
+
+    // compute model to world transform matrix
+    mat4 localToWorld = camera.model * inModel;
+    vMaterialIndex = pc.materialInfo.x;
+
+    // transform position from model to world space 
+    vec4 worldPos = localToWorld * position;
+    vWorldPos = worldPos.xyz;
+    vUV = uv;
+
+    // compute normal matrix and transform normal, tangent vectors to world space
+    mat3 normalMatrix = transpose(inverse(mat3(localToWorld)));
+    vNormal = normalize(normalMatrix * normal);
+    vTangent = normalize(normalMatrix * tangent.xyz);
+    vBitangent = normalize(cross(vNormal, vTangent) * tangent.w);
+
+    // apply view and projection transform
+    gl_Position = camera.viewProjections[gl_ViewIndex] * worldPos;
+}
@@ -0,0 +1,27 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+
+// -------------------------------------
+// vertex inputs: the position-only stream
+// -------------------------------------
+
+layout(location = 0) in vec4 inPosition;
+
+// -------------------------------------
+// push constants: ShadowMaps' layout, the caster's model to world and the view's world to clip
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;             // 64 bytes: caster model matrix
+    mat4 viewProjection;    // 64 bytes: cascade or cube face view projection
+} pc;
+
+// -------------------------------------
+// vertex stage entry point 
+// -------------------------------------
+
+void main(void) 
+{ 
+    gl_Position = pc.viewProjection * (pc.model * inPosition);
+}
@@ -0,0 +1,84 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+
+// -------------------------------------
+// one fragment per displayed pixel, in the subpass after the scene: exposure and tonemap of the hdr color read in
+// place from tile memory, plus a sparse grid of pixels binned into the histogram exposure.comp reduces. a subpass
+// input only sees its own pixel, so there is no bloom
+// -------------------------------------
+
+const uint HISTOGRAM_BINS = 256;
+
+// -------------------------------------
+// source: resolved hdr scene color of this pixel
+// -------------------------------------
+
+layout(input_attachment_index = 0, set = 0, binding = 0) uniform subpassInput sceneColor;
+
+// histogram of this frame, exposure adapted by the previous one (0 until the first reduction)
+layout(std430, set = 0, binding = 1) buffer ExposureBuffer
+{
+    uint  histogram[HISTOGRAM_BINS];
+    float exposure;
+    float averageLuminance;
+} exposureState;
+
+// -------------------------------------
+// push constants: shared with tonemap.comp and exposure.comp
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    uvec4 extents;          // xy: rendered region, z: 1 when metering, w: metering stride in pixels
+    vec4  exposure;         // x: fixed exposure, y: 1 when metered
+    vec4  histogram;        // x: min log2 luminance, y: log2 luminance range, w: compensation scale
+} pc;
+
+layout(location = 0) out vec4 outColor;
+
+// -------------------------------------
+// helpers
+// -------------------------------------
+
+float luminance(vec3 color)
+{
+    return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+// bin 0 holds pixels too dark to meter, the rest split the log2 range evenly
+uint luminanceBin(float lum)
+{
+    if (lum < exp2(pc.histogram.x))
+    {
+        return 0u;
+    }
+
+    float t = clamp((log2(lum) - pc.histogram.x) / pc.histogram.y, 0.0, 1.0);
+    return uint(t * float(HISTOGRAM_BINS - 2u)) + 1u;
+}
+
+// narkowicz's fit of the aces filmic curve
+vec3 tonemapAces(vec3 color)
+{
+    return clamp((color * (2.51 * color + 0.03)) / (color * (2.43 * color + 0.59) + 0.14), 0.0, 1.0);
+}
+
+// -------------------------------------
+// fragment stage entry point
+// -------------------------------------
+
+void main()
+{
+    vec3 color = subpassLoad(sceneColor).rgb;
+
+    // the exposure is an average, so one pixel per stride square meters as well as all of them
+    uvec2 pixel = uvec2(gl_FragCoord.xy);
+    if (pc.extents.z != 0u && all(equal(pixel % max(pc.extents.w, 1u), uvec2(0u))))
+    {
+        atomicAdd(exposureState.histogram[luminanceBin(luminance(color))], 1u);
+    }
+
+    float exposure = (pc.exposure.y > 0.0 && exposureState.exposure > 0.0) ? exposureState.exposure : pc.exposure.x;
+    vec3 mapped = tonemapAces(color * exposure);
+    outColor = vec4(pow(mapped, vec3(1.0 / 2.2)), 1.0);
+}
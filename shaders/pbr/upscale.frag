@@ -0,0 +1,74 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+
+// -------------------------------------
+// inputs: uv over the output (fullscreen.vert)
+// -------------------------------------
+
+layout(location = 0) in vec2 inUV;
+
+// -------------------------------------
+// descriptor set 0: the scene color, rendered into the top-left region of a target the size of the output
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform sampler2D sceneColor;
+
+// -------------------------------------
+// push constants: source region and sharpening
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    vec4 region;    // xy: rendered extent over the source extent, zw: largest uv inside it (half a texel in)
+    vec4 params;    // xy: source texel size in uv, z: sharpness [0, 1]
+} pc;
+
+// -------------------------------------
+// outputs
+// -------------------------------------
+
+layout(location = 0) out vec4 outColor;
+
+// -------------------------------------
+// helpers
+// -------------------------------------
+
+// bilinear read of the rendered region; the clamp keeps the filter off texels the scene did not render
+vec3 fetchScene(vec2 uv)
+{
+    return texture(sceneColor, clamp(uv, 0.5 * pc.params.xy, pc.region.zw)).rgb;
+}
+
+// -------------------------------------
+// main: bilinear upscale, then a contrast-adaptive sharpen over the source texel cross.
+// the sharpening weight shrinks where the neighborhood already spans a wide range, so edges do not ring
+// -------------------------------------
+
+void main()
+{
+    const vec2 uv = inUV * pc.region.xy;
+    const vec2 texel = pc.params.xy;
+
+    const vec3 center = fetchScene(uv);
+    const vec3 north  = fetchScene(uv - vec2(0.0, texel.y));
+    const vec3 south  = fetchScene(uv + vec2(0.0, texel.y));
+    const vec3 west   = fetchScene(uv - vec2(texel.x, 0.0));
+    const vec3 east   = fetchScene(uv + vec2(texel.x, 0.0));
+
+    const float sharpness = pc.params.z;
+    if (sharpness <= 0.0)
+    {
+        outColor = vec4(center, 1.0);
+        return;
+    }
+
+    // headroom of the neighborhood towards black and white, relative to its range
+    const vec3 minColor = min(center, min(min(north, south), min(west, east)));
+    const vec3 maxColor = max(center, max(max(north, south), max(west, east)));
+    const vec3 amplitude = sqrt(clamp(min(minColor, 1.0 - maxColor) / max(maxColor, vec3(1e-4)), 0.0, 1.0));
+
+    // negative lobe between -1/8 (soft) and -1/5 (sharp)
+    const vec3 weight = -amplitude * mix(0.125, 0.2, sharpness);
+    const vec3 color = (center + (north + south + west + east) * weight) / (1.0 + 4.0 * weight);
+    outColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
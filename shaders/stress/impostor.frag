@@ -0,0 +1,53 @@
+#version 450 core
+#extension GL_ARB_separate_shader_objects : enable
+
+// -------------------------------------
+// inputs from vertex shader
+// -------------------------------------
+
+layout(location = 0) in vec2 vUV;
+layout(location = 1) in vec4 vClipPosition;
+layout(location = 2) flat in vec4 vClipDepthAxis;
+layout(location = 3) flat in vec3 vNormalAxisX;
+layout(location = 4) flat in vec3 vNormalAxisY;
+layout(location = 5) flat in vec3 vNormalAxisZ;
+
+// -------------------------------------
+// fragment outputs: the baked surface lies behind the quad, so early depth tests stay valid
+// -------------------------------------
+
+layout(location = 0) out vec4 fragColor;
+layout(depth_greater) out float gl_FragDepth;
+
+// -------------------------------------
+// descriptor set 1: the impostor atlases
+// -------------------------------------
+
+layout(set = 1, binding = 0) uniform sampler2D uAlbedoAtlas;         // rgb: base color, a: coverage
+layout(set = 1, binding = 1) uniform sampler2D uNormalDepthAtlas;    // rgb: model-space normal, a: depth below the front plane
+
+// -------------------------------------
+// fragment stage entry point
+// -------------------------------------
+
+// the same key light as stress.frag, so the switch from the full mesh does not show in the shading
+const vec3 kLightDirection = vec3(0.4, 0.8, 0.45);
+
+void main(void)
+{
+    vec4 albedo = texture(uAlbedoAtlas, vUV);
+    if (albedo.a < 0.5)
+    {
+        discard;
+    }
+
+    // filtering blends covered texels with the uncovered (black) ones around them: undo it on the color
+    vec4 normalDepth = texture(uNormalDepthAtlas, vUV);
+    vec3 normal = normalize(mat3(vNormalAxisX, vNormalAxisY, vNormalAxisZ) * (normalDepth.xyz * 2.0 - 1.0));
+    float diffuse = max(dot(normal, normalize(kLightDirection)), 0.0);
+    fragColor = vec4(albedo.rgb / albedo.a * (0.15 + 0.85 * diffuse), 1.0);
+
+    // the quad spans the frame's front plane: its depth range reaches back along the frame direction
+    vec4 clipPosition = vClipPosition - vClipDepthAxis * normalDepth.a;
+    gl_FragDepth = clipPosition.z / clipPosition.w;
+}
@@ -0,0 +1,110 @@
+#version 450 core
+#extension GL_ARB_separate_shader_objects : enable
+
+// -------------------------------------
+// one strip of four corners per impostor instance (ImpostorAtlas::record): the quad faces the frame of the octahedral
+// grid nearest to the instance's view direction and lies on that frame's front plane, fitted to the model's bounding
+// sphere, so the baked depth pushes fragments backwards only
+// -------------------------------------
+
+// -------------------------------------
+// vertex inputs: the instance's model-to-world transform (uniformly scaled)
+// -------------------------------------
+
+layout(location = 0) in mat4 inModel;
+
+// ----------------------------
+// output to fragment shader (varyings)
+// ----------------------------
+
+layout(location = 0) out vec2 vUV;
+layout(location = 1) out vec4 vClipPosition;
+layout(location = 2) flat out vec4 vClipDepthAxis;     // clip space of the frame's depth range, front to back
+layout(location = 3) flat out vec3 vNormalAxisX;       // model-space normal to world space
+layout(location = 4) flat out vec3 vNormalAxisY;
+layout(location = 5) flat out vec3 vNormalAxisZ;
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+} camera;
+
+// -------------------------------------
+// push constants: must match impostor_atlas.cpp
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    vec4  bounds;       // xyz: bounding sphere center (model space), w: radius
+    uvec4 atlas;        // x: frames per side
+} pc;
+
+// -------------------------------------
+// helpers: must match impostor_atlas.cpp
+// -------------------------------------
+
+vec2 octahedralEncode(vec3 direction)
+{
+    direction /= abs(direction.x) + abs(direction.y) + abs(direction.z);
+    vec2 folded = direction.xy;
+    if (direction.z < 0.0)
+    {
+        folded = (1.0 - abs(direction.yx)) * vec2(direction.x >= 0.0 ? 1.0 : -1.0, direction.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return folded * 0.5 + 0.5;
+}
+
+vec3 octahedralDecode(vec2 uv)
+{
+    vec2 f = uv * 2.0 - 1.0;
+    vec3 direction = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+    float fold = max(-direction.z, 0.0);
+    direction.x += direction.x >= 0.0 ? -fold : fold;
+    direction.y += direction.y >= 0.0 ? -fold : fold;
+    return normalize(direction);
+}
+
+void frameBasis(vec3 direction, out vec3 right, out vec3 up)
+{
+    vec3 reference = abs(direction.y) > 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    right = normalize(cross(reference, direction));
+    up = cross(direction, right);
+}
+
+// -------------------------------------
+// vertex stage entry point
+// -------------------------------------
+
+void main(void)
+{
+    // the view direction in model space picks the frame; the transpose undoes the rotation of a uniform scale
+    vec3 cameraPosition = -transpose(mat3(camera.view)) * camera.view[3].xyz;
+    vec3 center = vec3(inModel * vec4(pc.bounds.xyz, 1.0));
+    vec3 viewDirection = normalize(transpose(mat3(inModel)) * (cameraPosition - center));
+
+    float framesPerSide = float(pc.atlas.x);
+    vec2 cell = min(floor(octahedralEncode(viewDirection) * framesPerSide), vec2(framesPerSide - 1.0));
+    vec3 direction = octahedralDecode((cell + 0.5) / framesPerSide);
+    vec3 right;
+    vec3 up;
+    frameBasis(direction, right, up);
+
+    // corners of the strip: (-1, -1), (1, -1), (-1, 1), (1, 1); up is the top of the frame
+    vec2 corner = vec2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1)) * 2.0 - 1.0;
+    float radius = pc.bounds.w;
+    vec3 modelPosition = pc.bounds.xyz + (direction + right * corner.x + up * corner.y) * radius;
+
+    mat4 viewProjection = camera.projection * camera.view;
+    gl_Position = viewProjection * (inModel * vec4(modelPosition, 1.0));
+    vClipPosition = gl_Position;
+    vClipDepthAxis = viewProjection * vec4(mat3(inModel) * (direction * 2.0 * radius), 0.0);
+    vUV = (cell + vec2(corner.x, -corner.y) * 0.5 + 0.5) / framesPerSide;
+    vNormalAxisX = inModel[0].xyz;
+    vNormalAxisY = inModel[1].xyz;
+    vNormalAxisZ = inModel[2].xyz;
+}
@@ -0,0 +1,66 @@
+#version 450 core
+#extension GL_ARB_separate_shader_objects : enable
+
+// -------------------------------------
+// inputs from vertex shader
+// -------------------------------------
+
+layout(location = 0) in vec2 vUV;
+layout(location = 1) in vec3 vNormal;
+
+// -------------------------------------
+// fragment outputs: the two atlases (ImpostorAtlas::kAlbedoFormat, kNormalDepthFormat)
+// -------------------------------------
+
+layout(location = 0) out vec4 outAlbedo;         // rgb: base color, a: coverage
+layout(location = 1) out vec4 outNormalDepth;    // rgb: model-space normal * 0.5 + 0.5, a: depth below the front plane
+
+// -------------------------------------
+// descriptor set 0: the frame's orthographic view (dynamic offset per frame)
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform BakeViewUBO
+{
+    mat4 viewProjection;
+    vec4 direction;
+} bakeView;
+
+// -------------------------------------
+// descriptor set 1: material textures (only the base color is sampled)
+// -------------------------------------
+
+layout(set = 1, binding = 1) uniform sampler2D uBaseColorMap;
+
+// -------------------------------------
+// push constants: shared vertex + fragment stage
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: node matrix, within the model
+    vec4 baseColor;      // 16 bytes: r,g,b,a
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
+    uvec4 materialInfo;  // 16 bytes: x:material index
+} pc;
+
+// -------------------------------------
+// fragment stage entry point
+// -------------------------------------
+
+void main(void)
+{
+    // cut-out texels stay uncovered, so the impostor's alpha test reproduces them
+    vec4 baseColor = texture(uBaseColorMap, vUV) * pc.baseColor;
+    if (baseColor.a < 0.5)
+    {
+        discard;
+    }
+
+    // double-sided surfaces: the side facing the frame's camera is the one seen
+    vec3 normal = normalize(vNormal);
+    normal = dot(normal, bakeView.direction.xyz) < 0.0 ? -normal : normal;
+
+    outAlbedo = vec4(baseColor.rgb, 1.0);
+    outNormalDepth = vec4(normal * 0.5 + 0.5, gl_FragCoord.z);
+}
@@ -0,0 +1,53 @@
+#version 450 core
+#extension GL_ARB_separate_shader_objects : enable
+
+// -------------------------------------
+// vertex inputs
+// -------------------------------------
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+layout(location = 3) in vec4 inTangent;
+
+// ----------------------------
+// output to fragment shader (varyings)
+// ----------------------------
+
+layout(location = 0) out vec2 vUV;
+layout(location = 1) out vec3 vNormal;
+
+// -------------------------------------
+// descriptor set 0: the frame's orthographic view (dynamic offset per frame)
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform BakeViewUBO
+{
+    mat4 viewProjection;    // model space to the frame's clip space, depth 0 at its front plane
+    vec4 direction;         // xyz: from the center towards the frame's camera
+} bakeView;
+
+// -------------------------------------
+// push constants: shared vertex + fragment stage
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: node matrix, within the model
+    vec4 baseColor;      // 16 bytes: r,g,b,a
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
+    uvec4 materialInfo;  // 16 bytes: x:material index
+} pc;
+
+// -------------------------------------
+// vertex stage entry point
+// -------------------------------------
+
+void main(void)
+{
+    // the bake has no placement: node matrices take vertices straight into model space
+    vUV = inUV;
+    vNormal = mat3(pc.model) * inNormal;
+    gl_Position = bakeView.viewProjection * (pc.model * inPosition);
+}
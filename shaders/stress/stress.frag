@@ -0,0 +1,48 @@
+#version 450 core
+#extension GL_ARB_separate_shader_object : enable
+
+// -------------------------------------
+// inputs from vertex shader
+// -------------------------------------
+
+layout(location = 0) in vec2 vUV;
+layout(location = 1) in vec3 vNormal;
+
+// -------------------------------------
+// fragment output
+// -------------------------------------
+
+layout(location = 0) out vec4 fragColor;
+
+// -------------------------------------
+// descriptor set 1: material textures (only the base color is sampled)
+// -------------------------------------
+
+layout(set = 1, binding = 1) uniform sampler2D uBaseColorMap;
+
+// -------------------------------------
+// push constants: shared vertex + fragment stage
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: model matrix
+    vec4 baseColor;      // 16 bytes: r,g,b,a
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
+    uvec4 materialInfo;  // 16 bytes: x:material index
+} pc;
+
+// -------------------------------------
+// fragment stage entry point
+// -------------------------------------
+
+// fixed key light: shading stays cheap so the test measures submission, not lighting
+const vec3 kLightDirection = vec3(0.4, 0.8, 0.45);
+
+void main(void)
+{
+    vec4 baseColor = texture(uBaseColorMap, vUV) * pc.baseColor;
+    float diffuse = max(dot(normalize(vNormal), normalize(kLightDirection)), 0.0);
+    fragColor = vec4(baseColor.rgb * (0.15 + 0.85 * diffuse) + pc.emissiveColor.rgb, baseColor.a);
+}
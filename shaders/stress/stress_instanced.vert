@@ -0,0 +1,57 @@
+#version 450 core
+#extension GL_ARB_seperate_shader_objects : enable
+
+// -------------------------------------
+// vertex inputs
+// -------------------------------------
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+layout(location = 3) in vec4 inTangent;
+
+// per-instance model matrix (instance rate, indexed through firstInstance)
+layout(location = 4) in mat4 inModel;
+
+// ----------------------------
+// output to fragment shader (varyings)
+// ----------------------------
+
+layout(location = 0) out vec2 vUV;
+layout(location = 1) out vec3 vNormal;
+
+// -------------------------------------
+// descriptor set 0: camera / per-frame data
+// -------------------------------------
+
+layout(set = 0, binding = 0) uniform CameraUBO
+{
+    mat4 projection;
+    mat4 view;
+} camera;
+
+// -------------------------------------
+// push constants: shared vertex + fragment stage (model unused, supplied per instance)
+// -------------------------------------
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 model;          // 64 bytes: model matrix
+    vec4 baseColor;      // 16 bytes: r,g,b,a
+    vec4 pbrFactors;     // 16 bytes: x:metallic, y:roughness, z:specular, w:unused
+    vec4 emissiveColor;  // 16 bytes: r,g,b + occlusion factor
+    uvec4 materialInfo;  // 16 bytes: x:material index
+} pc;
+
+// -------------------------------------
+// vertex stage entry point 
+// -------------------------------------
+
+void main(void)
+{
+    // placements are uniformly scaled, so the model matrix turns normals as well
+    vec4 worldPos = inModel * inPosition;
+    vUV = inUV;
+    vNormal = mat3(inModel) * inNormal;
+    gl_Position = camera.projection * camera.view * worldPos;
+}
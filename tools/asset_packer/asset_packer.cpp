@@ -0,0 +1,265 @@
+// ────────────────────────────────────────────
+//  File: asset_packer.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+// builds a .kpak resource pack (see utils/asset_pack.hpp):
+//   keplar_packer [--compress] <output.kpak> <root> <file or directory>...
+// every file is stored under its path relative to root, which is the directory the runtime resolves assets from.
+// with --compress files are deflated in independent chunks and kept compressed when that saves enough
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "utils/asset_pack.hpp"
+
+// only the zlib compressor of stb_image_write is used
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_STATIC
+#define STBI_WRITE_NO_STDIO
+#include <stb_image_write.h>
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+    // stb deflate effort, and the share a compressed file has to save to be kept compressed
+    constexpr int      kCompressionQuality  = 8;
+    constexpr uint64_t kMinSavingsDivisor   = 8;
+
+    struct PackFile
+    {
+        std::filesystem::path   mPath;
+        std::string             mKey;
+    };
+
+    uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool writePadding(std::ofstream& output, uint64_t& offset, uint64_t alignment)
+    {
+        static const std::vector<char> kZeros(keplar::kAssetPackAlignment, 0);
+        const uint64_t padding = alignUp(offset, alignment) - offset;
+        output.write(kZeros.data(), static_cast<std::streamsize>(padding));
+        offset += padding;
+        return static_cast<bool>(output);
+    }
+
+    bool gatherFiles(const std::filesystem::path& input, const std::filesystem::path& root, const std::filesystem::path& output,
+                     std::vector<PackFile>& files)
+    {
+        std::error_code errorCode;
+        auto addFile = [&](const std::filesystem::path& path)
+        {
+            const std::filesystem::path absolutePath = std::filesystem::absolute(path, errorCode).lexically_normal();
+            if (absolutePath != output)
+            {
+                files.push_back({ absolutePath, absolutePath.lexically_relative(root).lexically_normal().generic_string() });
+            }
+        };
+
+        if (std::filesystem::is_regular_file(input, errorCode))
+        {
+            addFile(input);
+            return true;
+        }
+
+        if (!std::filesystem::is_directory(input, errorCode))
+        {
+            std::fprintf(stderr, "keplar_packer: %s is neither a file nor a directory\n", input.string().c_str());
+            return false;
+        }
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, errorCode))
+        {
+            if (entry.is_regular_file(errorCode))
+            {
+                addFile(entry.path());
+            }
+        }
+        return !errorCode;
+    }
+
+    // chunk table and streams of a compressed entry; false when compression does not pay off
+    bool compressFile(const std::vector<char>& contents, std::vector<char>& compressed)
+    {
+        if (contents.empty())
+        {
+            return false;
+        }
+
+        const size_t chunkCount = (contents.size() + keplar::kAssetPackChunkSize - 1) / keplar::kAssetPackChunkSize;
+        std::vector<uint32_t> chunkEnds(chunkCount);
+        std::string streams;
+        for (size_t i = 0; i < chunkCount; ++i)
+        {
+            const size_t offset = i * keplar::kAssetPackChunkSize;
+            const int chunkSize = static_cast<int>(std::min<size_t>(keplar::kAssetPackChunkSize, contents.size() - offset));
+            int streamSize = 0;
+            unsigned char* stream = stbi_zlib_compress(reinterpret_cast<unsigned char*>(const_cast<char*>(contents.data() + offset)),
+                                                       chunkSize, &streamSize, kCompressionQuality);
+            if (!stream)
+            {
+                return false;
+            }
+
+            streams.append(reinterpret_cast<const char*>(stream), static_cast<size_t>(streamSize));
+            std::free(stream);
+            if (streams.size() > UINT32_MAX)
+            {
+                return false;
+            }
+            chunkEnds[i] = static_cast<uint32_t>(streams.size());
+        }
+
+        const size_t storedSize = chunkEnds.size() * sizeof(uint32_t) + streams.size();
+        if (storedSize > contents.size() - contents.size() / kMinSavingsDivisor)
+        {
+            return false;
+        }
+
+        compressed.resize(storedSize);
+        std::memcpy(compressed.data(), chunkEnds.data(), chunkEnds.size() * sizeof(uint32_t));
+        std::memcpy(compressed.data() + chunkEnds.size() * sizeof(uint32_t), streams.data(), streams.size());
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int argument = 1;
+    const bool isCompressed = argc > 1 && std::strcmp(argv[1], "--compress") == 0;
+    argument += isCompressed ? 1 : 0;
+    if (argc - argument < 3)
+    {
+        std::fprintf(stderr, "usage: keplar_packer [--compress] <output.kpak> <root> <file or directory>...\n");
+        return 1;
+    }
+
+    std::error_code errorCode;
+    const std::filesystem::path outputPath = std::filesystem::absolute(argv[argument], errorCode).lexically_normal();
+    const std::filesystem::path root = std::filesystem::absolute(argv[argument + 1], errorCode).lexically_normal();
+
+    // sorted by path so the pack is reproducible; a file named twice is stored once
+    std::vector<PackFile> files;
+    for (int i = argument + 2; i < argc; ++i)
+    {
+        if (!gatherFiles(argv[i], root, outputPath, files))
+        {
+            return 1;
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const PackFile& a, const PackFile& b) { return a.mKey < b.mKey; });
+    files.erase(std::unique(files.begin(), files.end(), [](const PackFile& a, const PackFile& b) { return a.mKey == b.mKey; }), files.end());
+
+    const std::filesystem::path tempPath = outputPath.string() + ".tmp";
+    std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        std::fprintf(stderr, "keplar_packer: failed to open %s for writing\n", tempPath.string().c_str());
+        return 1;
+    }
+
+    // header first as a placeholder, rewritten once the index offsets are known
+    keplar::AssetPackHeader header{};
+    std::memcpy(header.mMagic, keplar::kAssetPackMagic, sizeof(header.mMagic));
+    header.mVersion    = keplar::kAssetPackVersion;
+    header.mEntryCount = static_cast<uint32_t>(files.size());
+    header.mAlignment  = keplar::kAssetPackAlignment;
+    header.mChunkSize  = keplar::kAssetPackChunkSize;
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t offset = sizeof(header);
+
+    // contents, each on its own aligned block
+    std::vector<keplar::AssetPackEntry> entries;
+    std::string names;
+    entries.reserve(files.size());
+    std::vector<char> buffer;
+    std::vector<char> compressed;
+    uint64_t storedBytes = 0;
+    uint64_t fileBytes = 0;
+    for (const PackFile& file : files)
+    {
+        std::ifstream input(file.mPath, std::ios::binary | std::ios::ate);
+        if (!input)
+        {
+            std::fprintf(stderr, "keplar_packer: failed to read %s\n", file.mPath.string().c_str());
+            return 1;
+        }
+        buffer.resize(static_cast<size_t>(input.tellg()));
+        input.seekg(0);
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!input || !writePadding(output, offset, keplar::kAssetPackAlignment))
+        {
+            std::fprintf(stderr, "keplar_packer: failed to pack %s\n", file.mPath.string().c_str());
+            return 1;
+        }
+
+        // already compressed formats (png, jpeg, supercompressed ktx2) stay stored
+        const bool isEntryCompressed = isCompressed && compressFile(buffer, compressed);
+        const std::vector<char>& stored = isEntryCompressed ? compressed : buffer;
+
+        keplar::AssetPackEntry entry{};
+        entry.mPathHash    = keplar::hashAssetPath(file.mKey);
+        entry.mOffset      = offset;
+        entry.mSize        = buffer.size();
+        entry.mStoredSize  = stored.size();
+        entry.mNameOffset  = static_cast<uint32_t>(names.size());
+        entry.mNameLength  = static_cast<uint32_t>(file.mKey.size());
+        entry.mCompression = static_cast<uint32_t>(isEntryCompressed ? keplar::AssetPackCompression::kDeflate : keplar::AssetPackCompression::kNone);
+        entries.push_back(entry);
+        names += file.mKey;
+
+        output.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+        offset += stored.size();
+        storedBytes += stored.size();
+        fileBytes += buffer.size();
+    }
+
+    // index sorted by hash for the runtime's binary search, then the path strings
+    std::sort(entries.begin(), entries.end(), [](const keplar::AssetPackEntry& a, const keplar::AssetPackEntry& b) { return a.mPathHash < b.mPathHash; });
+    writePadding(output, offset, alignof(keplar::AssetPackEntry));
+    header.mIndexOffset = offset;
+    output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(keplar::AssetPackEntry)));
+    offset += entries.size() * sizeof(keplar::AssetPackEntry);
+    header.mNamesOffset = offset;
+    header.mNamesSize   = names.size();
+    output.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.close();
+    if (!output)
+    {
+        std::fprintf(stderr, "keplar_packer: failed to write %s\n", tempPath.string().c_str());
+        return 1;
+    }
+
+    std::filesystem::rename(tempPath, outputPath, errorCode);
+    if (errorCode)
+    {
+        std::fprintf(stderr, "keplar_packer: failed to replace %s: %s\n", outputPath.string().c_str(), errorCode.message().c_str());
+        return 1;
+    }
+
+    std::printf("keplar_packer: packed %zu files (%llu of %llu bytes) into %s\n", entries.size(), static_cast<unsigned long long>(storedBytes),
+                static_cast<unsigned long long>(fileBytes), outputPath.string().c_str());
+    return 0;
+}
@@ -0,0 +1,584 @@
+// ────────────────────────────────────────────
+//  File: microbench.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+// microbenchmarks of the core utilities on the frame's hot paths:
+//   keplar_microbench [--output <results.json>] [--baseline <results.json>] [--threshold <percent>] [--filter <text>]
+// every benchmark reports per operation times in nanoseconds (mean, p50, p99 over its samples). with --baseline the
+// p50 of each benchmark is compared against the one of the same name in a previous results file, and the run fails
+// when any is slower by more than the threshold (default 10%). --filter runs only the groups whose name starts with the
+// text (task_wrapper, thread_pool, logger, event_manager, frame_pacer, frustum_culling)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/thread_pool.hpp"
+#include "utils/logger.hpp"
+#include "utils/frame_pacer.hpp"
+#include "platform/event_manager.hpp"
+#include "graphics/frustum_culling.hpp"
+
+// the logger compresses rotated files with the zlib compressor of stb_image_write
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STBI_WRITE_NO_STDIO
+#include <stb_image_write.h>
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    // repetitions of the batched benchmarks, and the default slowdown a baseline comparison tolerates
+    constexpr uint32_t kRepetitions       = 9;
+    constexpr double   kDefaultThreshold  = 10.0;
+
+    struct BenchResult
+    {
+        std::string mName;
+        size_t      mSamples = 0;
+        double      mMeanNs  = 0.0;
+        double      mP50Ns   = 0.0;
+        double      mP99Ns   = 0.0;
+    };
+
+    struct BenchOptions
+    {
+        std::string mOutput = "microbench.json";
+        std::string mBaseline;
+        std::string mFilter;
+        double      mThreshold = kDefaultThreshold;
+    };
+
+    double getNanosecondsSince(clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    }
+
+    // summary of per operation samples (nanoseconds)
+    BenchResult summarize(const std::string& name, std::vector<double> samples)
+    {
+        BenchResult result{};
+        result.mName = name;
+        result.mSamples = samples.size();
+        if (samples.empty())
+        {
+            return result;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (const double sample : samples)
+        {
+            sum += sample;
+        }
+        result.mMeanNs = sum / static_cast<double>(samples.size());
+        result.mP50Ns = samples[samples.size() / 2];
+        result.mP99Ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        return result;
+    }
+
+    // runs f(operations) kRepetitions times, one sample per repetition: its time divided by the operations
+    BenchResult runBatched(const std::string& name, size_t operations, const std::function<void(size_t)>& f)
+    {
+        f(operations);  // warm-up: first touches, thread creation, lazy registration
+
+        std::vector<double> samples;
+        samples.reserve(kRepetitions);
+        for (uint32_t repetition = 0; repetition < kRepetitions; ++repetition)
+        {
+            const auto start = clock::now();
+            f(operations);
+            samples.push_back(getNanosecondsSince(start) / static_cast<double>(operations));
+        }
+        return summarize(name, std::move(samples));
+    }
+
+    // thread counts worth measuring on this machine: 1, 2, 4... up to the hardware threads
+    std::vector<uint32_t> getThreadCounts()
+    {
+        const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<uint32_t> counts;
+        for (uint32_t count = 1; count <= std::min(hardwareThreads, 16u); count *= 2)
+        {
+            counts.push_back(count);
+        }
+        return counts;
+    }
+
+    // ─────────────────────────────────────────
+    // TaskWrapper: type erasure, inline and heap fallback
+    // ─────────────────────────────────────────
+    void benchTaskWrapper(std::vector<BenchResult>& results)
+    {
+        static std::atomic<uint64_t> sink{0};
+
+        results.push_back(runBatched("task_wrapper/inline", 1 << 20, [](size_t operations)
+        {
+            for (size_t i = 0; i < operations; ++i)
+            {
+                keplar::TaskWrapper task([i]() { sink.fetch_add(i, std::memory_order_relaxed); });
+                keplar::TaskWrapper moved(std::move(task));
+                moved();
+            }
+        }));
+
+        results.push_back(runBatched("task_wrapper/heap", 1 << 18, [](size_t operations)
+        {
+            std::array<uint64_t, keplar::TaskWrapper::kInlineSize / sizeof(uint64_t) + 1> payload{};
+            for (size_t i = 0; i < operations; ++i)
+            {
+                payload[0] = i;
+                keplar::TaskWrapper task([payload]() { sink.fetch_add(payload[0], std::memory_order_relaxed); });
+                keplar::TaskWrapper moved(std::move(task));
+                moved();
+            }
+        }));
+    }
+
+    // ─────────────────────────────────────────
+    // ThreadPool: round trip latency, throughput under producer contention, parallelFor overhead
+    // ─────────────────────────────────────────
+    void benchThreadPool(std::vector<BenchResult>& results)
+    {
+        keplar::ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()), 0, "bench");
+
+        // dispatch to completion of one empty task as seen by the dispatching thread, one sample per task
+        {
+            constexpr size_t kRoundTrips = 20000;
+            std::vector<double> samples;
+            samples.reserve(kRoundTrips);
+            for (size_t i = 0; i < kRoundTrips; ++i)
+            {
+                const auto start = clock::now();
+                pool.dispatch([]() {}).wait();
+                samples.push_back(getNanosecondsSince(start));
+            }
+            results.push_back(summarize("thread_pool/dispatch_latency", std::move(samples)));
+        }
+
+        // producers dispatching into the pool at once; per task time of the whole batch
+        for (const uint32_t producerCount : getThreadCounts())
+        {
+            constexpr size_t kTasksPerProducer = 4096;
+            std::atomic<uint64_t> executed{0};
+            results.push_back(runBatched("thread_pool/throughput/producers:" + std::to_string(producerCount), kTasksPerProducer * producerCount,
+                [&](size_t)
+                {
+                    std::vector<std::thread> producers;
+                    producers.reserve(producerCount);
+                    for (uint32_t producer = 0; producer < producerCount; ++producer)
+                    {
+                        producers.emplace_back([&]()
+                        {
+                            std::vector<keplar::TaskHandle> handles;
+                            handles.reserve(kTasksPerProducer);
+                            for (size_t i = 0; i < kTasksPerProducer; ++i)
+                            {
+                                handles.push_back(pool.dispatch([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }));
+                            }
+                            for (const auto& handle : handles)
+                            {
+                                handle.wait();
+                            }
+                        });
+                    }
+                    for (auto& producer : producers)
+                    {
+                        producer.join();
+                    }
+                }));
+        }
+
+        // a frame-sized parallelFor of trivial work: the split, dispatch and join cost per call
+        {
+            constexpr size_t kItems = 4096;
+            std::vector<uint32_t> values(kItems, 1);
+            results.push_back(runBatched("thread_pool/parallel_for:4096", 256, [&](size_t calls)
+            {
+                for (size_t call = 0; call < calls; ++call)
+                {
+                    pool.parallelFor(keplar::TaskPriority::kFrameCritical, kItems, 64, [&values](size_t i) { values[i] += 1; }).wait();
+                }
+            }));
+        }
+    }
+
+    // ─────────────────────────────────────────
+    // Logger::enqueueLog: cost on the calling thread, per concurrent logging thread count
+    // ─────────────────────────────────────────
+    void benchLogger(std::vector<BenchResult>& results)
+    {
+        keplar::Logger& logger = keplar::Logger::getInstance();
+        logger.enableLevel(keplar::Logger::Level::Info);
+
+        // well below a ring's capacity so the worker never has to catch up inside a repetition
+        constexpr size_t kLogsPerThread = 256;
+        for (const uint32_t threadCount : getThreadCounts())
+        {
+            std::vector<double> samples;
+            for (uint32_t repetition = 0; repetition <= kRepetitions; ++repetition)
+            {
+                // every thread registers its ring before the start flag, so only enqueueing is timed
+                std::atomic<uint32_t> readyCount{0};
+                std::atomic<bool> isStarted{false};
+                std::vector<double> threadNs(threadCount, 0.0);
+                std::vector<std::thread> threads;
+                for (uint32_t t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&, t]()
+                    {
+                        logger.enqueueLog(keplar::Logger::Level::Info, __FILE__, __LINE__, "microbench thread %u ready", t);
+                        readyCount.fetch_add(1);
+                        while (!isStarted.load(std::memory_order_acquire))
+                        {
+                            std::this_thread::yield();
+                        }
+
+                        const auto start = clock::now();
+                        for (size_t i = 0; i < kLogsPerThread; ++i)
+                        {
+                            logger.enqueueLog(keplar::Logger::Level::Info, __FILE__, __LINE__, "microbench %u %zu %f %s", t, i, 0.5 * static_cast<double>(i), "payload");
+                        }
+                        threadNs[t] = getNanosecondsSince(start) / static_cast<double>(kLogsPerThread);
+                    });
+                }
+
+                while (readyCount.load() < threadCount)
+                {
+                    std::this_thread::yield();
+                }
+                isStarted.store(true, std::memory_order_release);
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+                logger.flush();
+
+                // the first repetition is a warm-up
+                if (repetition > 0)
+                {
+                    samples.insert(samples.end(), threadNs.begin(), threadNs.end());
+                }
+            }
+            results.push_back(summarize("logger/enqueue/threads:" + std::to_string(threadCount), std::move(samples)));
+        }
+
+        if (logger.getDroppedLogCount() > 0)
+        {
+            std::fprintf(stderr, "keplar_microbench: logger dropped %llu records, enqueue times include full rings\n",
+                         static_cast<unsigned long long>(logger.getDroppedLogCount()));
+        }
+    }
+
+    // ─────────────────────────────────────────
+    // EventManager: immediate dispatch and the per frame input batch, per listener count
+    // ─────────────────────────────────────────
+    class CountingListener final : public keplar::EventListener
+    {
+        public:
+            virtual void onKeyPressed(uint32_t key) override                    { m_sum += key; }
+            virtual void onInputEvents(const keplar::InputEvent*, size_t count) override { m_sum += count; }
+
+        private:
+            uint64_t m_sum = 0;
+    };
+
+    void benchEventManager(std::vector<BenchResult>& results)
+    {
+        for (const size_t listenerCount : { 1u, 8u, 64u, 256u })
+        {
+            keplar::EventManager eventManager;
+            std::vector<std::shared_ptr<keplar::EventListener>> listeners;
+            for (size_t i = 0; i < listenerCount; ++i)
+            {
+                listeners.push_back(std::make_shared<CountingListener>());
+                eventManager.addListener(listeners.back());
+            }
+
+            const std::string suffix = "/listeners:" + std::to_string(listenerCount);
+            results.push_back(runBatched("event_manager/dispatch" + suffix, 1 << 14, [&](size_t events)
+            {
+                for (size_t i = 0; i < events; ++i)
+                {
+                    eventManager.onKeyPressed(static_cast<uint32_t>(i));
+                }
+            }));
+
+            // a frame's worth of input, queued and handed over as one batch; per frame
+            results.push_back(runBatched("event_manager/input_batch:64" + suffix, 1 << 12, [&](size_t frames)
+            {
+                for (size_t frame = 0; frame < frames; ++frame)
+                {
+                    for (uint32_t i = 0; i < 64; ++i)
+                    {
+                        const keplar::InputEventType type = (i & 1) ? keplar::InputEventType::kKeyReleased : keplar::InputEventType::kKeyPressed;
+                        eventManager.queueInputEvent({ type, i, 0.0, 0.0 });
+                    }
+                    eventManager.dispatchInputEvents();
+                }
+            }));
+        }
+    }
+
+    // ─────────────────────────────────────────
+    // FramePacer::wait: distance of each frame interval from the target step
+    // ─────────────────────────────────────────
+    void benchFramePacer(std::vector<BenchResult>& results)
+    {
+        for (const float fps : { 60.0f, 240.0f })
+        {
+            keplar::FramePacer pacer;
+            pacer.setTargetFps(fps);
+            const double stepNs = 1.0e9 / static_cast<double>(fps);
+            const size_t frameCount = static_cast<size_t>(fps) * 2;
+
+            // the first wait starts the schedule
+            pacer.wait();
+            auto last = clock::now();
+            std::vector<double> samples;
+            samples.reserve(frameCount);
+            for (size_t frame = 0; frame < frameCount; ++frame)
+            {
+                pacer.wait();
+                const auto now = clock::now();
+                const double intervalNs = std::chrono::duration<double, std::nano>(now - last).count();
+                samples.push_back(std::abs(intervalNs - stepNs));
+                last = now;
+            }
+            results.push_back(summarize("frame_pacer/jitter/fps:" + std::to_string(static_cast<int>(fps)), std::move(samples)));
+        }
+    }
+
+    // ─────────────────────────────────────────
+    // cullBounds: 100k boxes scattered around a camera, per box; the kernel alone and split across the pool
+    // ─────────────────────────────────────────
+    void benchFrustumCulling(std::vector<BenchResult>& results)
+    {
+        constexpr uint32_t kBoxCount = 100000;
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(30.0f, 0.0f, 40.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const keplar::CullingFrustum frustum = keplar::CullingFrustum::fromFrustum(keplar::Frustum::fromMatrix(projection * view));
+
+        // fixed seed, so every run culls the same boxes
+        uint32_t seed = 0x9e3779b9u;
+        const auto random = [&seed](float low, float high)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return low + (high - low) * static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+        };
+        keplar::CullingBounds bounds;
+        bounds.reserve(kBoxCount);
+        for (uint32_t i = 0; i < kBoxCount; ++i)
+        {
+            const glm::vec3 center(random(-200.0f, 200.0f), random(-20.0f, 20.0f), random(-200.0f, 200.0f));
+            const glm::vec3 extent(random(0.1f, 5.0f), random(0.1f, 5.0f), random(0.1f, 5.0f));
+            bounds.push({ center - extent, center + extent });
+        }
+
+        std::vector<uint32_t> visible;
+        visible.reserve(kBoxCount);
+        results.push_back(runBatched("frustum_culling/cull_bounds:100k", kBoxCount, [&](size_t)
+        {
+            keplar::cullBounds(frustum, bounds, visible);
+        }));
+
+        keplar::ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()), 0, "bench");
+        results.push_back(runBatched("frustum_culling/cull_bounds_pooled:100k", kBoxCount, [&](size_t)
+        {
+            keplar::cullBounds(frustum, bounds, visible, &pool);
+        }));
+    }
+
+    // ─────────────────────────────────────────
+    // results and baseline
+    // ─────────────────────────────────────────
+    bool writeResults(const std::string& filepath, const std::vector<BenchResult>& results)
+    {
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            std::fprintf(stderr, "keplar_microbench: failed to open %s for writing\n", filepath.c_str());
+            return false;
+        }
+
+        // one benchmark per line, which is what readBaseline expects
+        file << std::fixed << std::setprecision(2);
+        file << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchResult& result = results[i];
+            file << "    { \"name\": \"" << result.mName << "\", \"samples\": " << result.mSamples
+                 << ", \"mean_ns\": " << result.mMeanNs << ", \"p50_ns\": " << result.mP50Ns << ", \"p99_ns\": " << result.mP99Ns << " }"
+                 << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+
+    // p50 by name from a file written by writeResults
+    bool readBaseline(const std::string& filepath, std::map<std::string, double>& baseline)
+    {
+        std::ifstream file(filepath);
+        if (!file)
+        {
+            std::fprintf(stderr, "keplar_microbench: failed to open baseline %s\n", filepath.c_str());
+            return false;
+        }
+
+        static constexpr const char kNameKey[] = "\"name\": \"";
+        static constexpr const char kP50Key[]  = "\"p50_ns\": ";
+        std::string line;
+        while (std::getline(file, line))
+        {
+            const size_t nameStart = line.find(kNameKey);
+            const size_t p50Start = line.find(kP50Key);
+            if (nameStart == std::string::npos || p50Start == std::string::npos)
+            {
+                continue;
+            }
+
+            const size_t nameBegin = nameStart + sizeof(kNameKey) - 1;
+            const size_t nameEnd = line.find('"', nameBegin);
+            if (nameEnd != std::string::npos)
+            {
+                baseline[line.substr(nameBegin, nameEnd - nameBegin)] = std::strtod(line.c_str() + p50Start + sizeof(kP50Key) - 1, nullptr);
+            }
+        }
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, BenchOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+            {
+                options.mOutput = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+            {
+                options.mBaseline = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue)
+            {
+                options.mThreshold = std::strtod(argv[++i], nullptr);
+            }
+            else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            {
+                options.mFilter = argv[++i];
+            }
+            else
+            {
+                std::fprintf(stderr, "usage: keplar_microbench [--output <results.json>] [--baseline <results.json>] [--threshold <percent>] [--filter <text>]\n");
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options{};
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    struct BenchGroup
+    {
+        const char* mPrefix;
+        void        (*mRun)(std::vector<BenchResult>&);
+    };
+    const BenchGroup groups[] =
+    {
+        { "task_wrapper",   benchTaskWrapper },
+        { "thread_pool",    benchThreadPool },
+        { "logger",         benchLogger },
+        { "event_manager",  benchEventManager },
+        { "frame_pacer",    benchFramePacer },
+        { "frustum_culling", benchFrustumCulling },
+    };
+
+    std::vector<BenchResult> results;
+    for (const BenchGroup& group : groups)
+    {
+        if (std::strncmp(group.mPrefix, options.mFilter.c_str(), options.mFilter.size()) != 0)
+        {
+            continue;
+        }
+
+        const size_t firstResult = results.size();
+        group.mRun(results);
+        for (size_t i = firstResult; i < results.size(); ++i)
+        {
+            const BenchResult& result = results[i];
+            std::printf("%-48s %10.1f ns  p50 %10.1f ns  p99 %10.1f ns  (%zu samples)\n", result.mName.c_str(), result.mMeanNs,
+                        result.mP50Ns, result.mP99Ns, result.mSamples);
+        }
+    }
+
+    if (!writeResults(options.mOutput, results))
+    {
+        return 1;
+    }
+    std::printf("keplar_microbench: %zu results written to %s\n", results.size(), options.mOutput.c_str());
+
+    // regressions: a p50 above the baseline's by more than the threshold
+    if (options.mBaseline.empty())
+    {
+        return 0;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!readBaseline(options.mBaseline, baseline))
+    {
+        return 1;
+    }
+
+    uint32_t regressionCount = 0;
+    for (const BenchResult& result : results)
+    {
+        const auto it = baseline.find(result.mName);
+        if (it == baseline.end() || it->second <= 0.0)
+        {
+            continue;
+        }
+
+        const double change = (result.mP50Ns / it->second - 1.0) * 100.0;
+        if (change > options.mThreshold)
+        {
+            std::printf("REGRESSION %-48s p50 %10.1f ns  baseline %10.1f ns  (%+.1f%%)\n", result.mName.c_str(), result.mP50Ns, it->second, change);
+            ++regressionCount;
+        }
+    }
+
+    std::printf("keplar_microbench: %u regressions against %s (threshold %.1f%%)\n", regressionCount, options.mBaseline.c_str(), options.mThreshold);
+    return regressionCount > 0 ? 1 : 0;
+}
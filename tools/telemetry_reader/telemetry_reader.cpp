@@ -0,0 +1,260 @@
+// ────────────────────────────────────────────
+//  File: telemetry_reader.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+// prints or records the live telemetry of a running instance (see utils/telemetry_channel.hpp):
+//   keplar_telemetry [--interval <ms>] [--csv <path>] [--passes] [--timeout <seconds>] <channel>
+// the channel is the name the instance was started with (--telemetry <channel>). every interval the latest sample is
+// printed as one line (with --passes followed by its gpu pass timings); with --csv every sample published is appended
+// as a row instead, so a collector can poll the file. exits once no sample arrived for the timeout (default 5 s)
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "utils/telemetry_channel.hpp"
+
+// the logger compresses rotated files with the zlib compressor of stb_image_write
+#if defined(_MSC_VER)
+#pragma warning(push, 0)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STBI_WRITE_NO_STDIO
+#include <stb_image_write.h>
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+    constexpr uint32_t kDefaultIntervalMs      = 1000;
+    constexpr uint32_t kDefaultTimeoutSeconds  = 5;
+    constexpr uint32_t kPollMs                 = 50;
+    constexpr double   kMiB                    = 1024.0 * 1024.0;
+    constexpr uint32_t kMetricCount            = static_cast<uint32_t>(keplar::FrameMetric::kCount);
+
+    struct ReaderOptions
+    {
+        std::string mChannel;
+        std::string mCsv;
+        uint32_t    mIntervalMs     = kDefaultIntervalMs;
+        uint32_t    mTimeoutSeconds = kDefaultTimeoutSeconds;
+        bool        mShowPasses     = false;
+    };
+
+    bool parseOptions(int argc, char** argv, ReaderOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--interval") == 0 && hasValue)
+            {
+                options.mIntervalMs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+            {
+                options.mCsv = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "--timeout") == 0 && hasValue)
+            {
+                options.mTimeoutSeconds = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(argv[i], "--passes") == 0)
+            {
+                options.mShowPasses = true;
+            }
+            else if (argv[i][0] != '-' && options.mChannel.empty())
+            {
+                options.mChannel = argv[i];
+            }
+            else
+            {
+                options.mChannel.clear();
+                break;
+            }
+        }
+
+        if (options.mChannel.empty())
+        {
+            std::fprintf(stderr, "usage: keplar_telemetry [--interval <ms>] [--csv <path>] [--passes] [--timeout <seconds>] <channel>\n");
+            return false;
+        }
+        return true;
+    }
+
+    void printFrame(const keplar::TelemetryFrame& frame, bool showPasses)
+    {
+        std::printf("frame %8llu", static_cast<unsigned long long>(frame.mFrameNumber));
+        for (uint32_t metric = 0; metric < kMetricCount; ++metric)
+        {
+            const keplar::TelemetryPercentiles& percentiles = frame.mMetrics[metric];
+            std::printf("  %s %.2f/%.2f/%.2f", keplar::FrameMetrics::getName(static_cast<keplar::FrameMetric>(metric)),
+                        percentiles.mP50, percentiles.mP95, percentiles.mP99);
+        }
+        std::printf("  hitches %llu  draws %u  uploads %u (%.1f MiB streamed)", static_cast<unsigned long long>(frame.mHitchCount),
+                    frame.mDrawCount, frame.mPendingUploads, frame.mStreamedBytes / kMiB);
+        for (uint32_t heap = 0; heap < frame.mHeapCount && heap < keplar::kTelemetryMaxHeaps; ++heap)
+        {
+            std::printf("  heap%u %.0f/%.0f MiB", heap, frame.mHeaps[heap].mUsage / kMiB, frame.mHeaps[heap].mBudget / kMiB);
+        }
+        std::printf("\n");
+
+        if (showPasses)
+        {
+            for (uint32_t pass = 0; pass < frame.mPassCount && pass < keplar::kTelemetryMaxPasses; ++pass)
+            {
+                const keplar::TelemetryPass& telemetryPass = frame.mPasses[pass];
+                std::printf("    %*s%-*s %7.3f ms\n", static_cast<int>(telemetryPass.mDepth * 2), "",
+                            40 - static_cast<int>(telemetryPass.mDepth * 2), telemetryPass.mName, telemetryPass.mMilliseconds);
+            }
+        }
+        std::fflush(stdout);
+    }
+
+    void writeCsvHeader(std::FILE* file)
+    {
+        std::fprintf(file, "frame,timestamp_us");
+        for (uint32_t metric = 0; metric < kMetricCount; ++metric)
+        {
+            // column names in snake case ("Present Latency" becomes present_latency)
+            std::string name = keplar::FrameMetrics::getName(static_cast<keplar::FrameMetric>(metric));
+            for (char& c : name)
+            {
+                c = (c == ' ') ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            std::fprintf(file, ",%s_p50_ms,%s_p95_ms,%s_p99_ms", name.c_str(), name.c_str(), name.c_str());
+        }
+        std::fprintf(file, ",hitches,draws,binds,barriers,pending_uploads,streamed_textures,streamed_bytes,heap_usage_bytes,heap_budget_bytes\n");
+    }
+
+    void writeCsvRow(std::FILE* file, const keplar::TelemetryFrame& frame)
+    {
+        std::fprintf(file, "%llu,%llu", static_cast<unsigned long long>(frame.mFrameNumber), static_cast<unsigned long long>(frame.mTimestampUs));
+        for (uint32_t metric = 0; metric < kMetricCount; ++metric)
+        {
+            const keplar::TelemetryPercentiles& percentiles = frame.mMetrics[metric];
+            std::fprintf(file, ",%.3f,%.3f,%.3f", percentiles.mP50, percentiles.mP95, percentiles.mP99);
+        }
+
+        // heaps summed: the dashboard tracks the device's total against its total budget
+        unsigned long long usage = 0;
+        unsigned long long budget = 0;
+        for (uint32_t heap = 0; heap < frame.mHeapCount && heap < keplar::kTelemetryMaxHeaps; ++heap)
+        {
+            usage += frame.mHeaps[heap].mUsage;
+            budget += frame.mHeaps[heap].mBudget;
+        }
+        std::fprintf(file, ",%llu,%u,%u,%u,%u,%u,%llu,%llu,%llu\n", static_cast<unsigned long long>(frame.mHitchCount), frame.mDrawCount,
+                     frame.mBindCount, frame.mBarrierCount, frame.mPendingUploads, frame.mStreamedTextures,
+                     static_cast<unsigned long long>(frame.mStreamedBytes), usage, budget);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ReaderOptions options{};
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    keplar::TelemetryChannel channel;
+    if (!channel.attach(options.mChannel))
+    {
+        std::fprintf(stderr, "keplar_telemetry: no telemetry channel '%s'\n", options.mChannel.c_str());
+        return 1;
+    }
+    std::printf("keplar_telemetry: attached to '%s' (process %llu, %u slots)\n", options.mChannel.c_str(),
+                static_cast<unsigned long long>(channel.getProcessId()), channel.getSlotCount());
+
+    std::FILE* csv = nullptr;
+    if (!options.mCsv.empty())
+    {
+        csv = std::fopen(options.mCsv.c_str(), "w");
+        if (csv == nullptr)
+        {
+            std::fprintf(stderr, "keplar_telemetry: cannot open %s\n", options.mCsv.c_str());
+            return 1;
+        }
+        writeCsvHeader(csv);
+    }
+
+    // start at the newest sample; earlier ones describe the run before the reader was there
+    using clock = std::chrono::steady_clock;
+    uint64_t nextIndex = channel.getWriteCount();
+    uint64_t lostCount = 0;
+    bool hasLatest = false;
+    keplar::TelemetryFrame frame{};
+    keplar::TelemetryFrame latest{};
+    clock::time_point lastSample = clock::now();
+    clock::time_point lastPrint = lastSample;
+
+    while (true)
+    {
+        const uint64_t writeCount = channel.getWriteCount();
+        const clock::time_point now = clock::now();
+        if (writeCount != nextIndex)
+        {
+            lastSample = now;
+        }
+        if (writeCount > nextIndex + channel.getSlotCount())
+        {
+            lostCount += writeCount - channel.getSlotCount() - nextIndex;
+            nextIndex = writeCount - channel.getSlotCount();
+        }
+
+        // a slot overwritten while it was copied is lost as well; the ones after it are still intact
+        for (; nextIndex < writeCount; ++nextIndex)
+        {
+            if (!channel.read(nextIndex, frame))
+            {
+                ++lostCount;
+                continue;
+            }
+            latest = frame;
+            hasLatest = true;
+            if (csv != nullptr)
+            {
+                writeCsvRow(csv, frame);
+            }
+        }
+
+        if (now - lastPrint >= std::chrono::milliseconds(options.mIntervalMs) && hasLatest)
+        {
+            if (csv != nullptr)
+            {
+                std::fflush(csv);
+            }
+            else
+            {
+                printFrame(latest, options.mShowPasses);
+            }
+            hasLatest = false;
+            lastPrint = now;
+        }
+
+        if (now - lastSample >= std::chrono::seconds(options.mTimeoutSeconds))
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollMs));
+    }
+
+    if (csv != nullptr)
+    {
+        std::fclose(csv);
+    }
+    std::printf("keplar_telemetry: no samples for %u s, detaching (%llu samples lost)\n", options.mTimeoutSeconds,
+                static_cast<unsigned long long>(lostCount));
+    return 0;
+}
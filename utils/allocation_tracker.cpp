@@ -0,0 +1,201 @@
+// ────────────────────────────────────────────
+//  File: allocation_tracker.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "allocation_tracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef KEPLAR_TRACK_ALLOCATIONS
+    #include <cstdlib>
+    #include <new>
+    #ifdef _WIN32
+        #include <malloc.h>
+    #endif
+#endif
+
+namespace 
+{
+    // threads past the table share its last slot; counters stay valid (atomic), only their attribution blurs
+    constexpr uint32_t kMaxThreads = 64;
+
+    // written by the owning thread, read by the sampling one; everything here is constant initialized, so it is
+    // usable from operator new before any static constructor runs
+    struct alignas(64) ThreadCounters
+    {
+        std::atomic<uint64_t>   mAllocations{ 0 };
+        std::atomic<uint64_t>   mFrees{ 0 };
+        std::atomic<uint64_t>   mBytes{ 0 };
+        std::atomic<uint64_t>   mVulkanAllocations{ 0 };
+        std::atomic<bool>       mIsFrameThread{ false };
+    };
+
+    ThreadCounters          s_threadCounters[kMaxThreads];
+    std::atomic<uint32_t>   s_threadCount{ 0 };
+    thread_local ThreadCounters* tl_counters = nullptr;
+
+    // running totals of the previous sample (sampling thread only) and the last sample (any thread)
+    keplar::AllocationSample s_previousTotals;
+    std::atomic<uint64_t>   s_lastAllocations{ 0 };
+    std::atomic<uint64_t>   s_lastFrees{ 0 };
+    std::atomic<uint64_t>   s_lastBytes{ 0 };
+    std::atomic<uint64_t>   s_lastVulkanAllocations{ 0 };
+    std::atomic<uint64_t>   s_lastFrameThreadAllocations{ 0 };
+
+    [[maybe_unused]] ThreadCounters& getThreadCounters() noexcept
+    {
+        if (!tl_counters)
+        {
+            const uint32_t slot = s_threadCount.fetch_add(1, std::memory_order_relaxed);
+            tl_counters = &s_threadCounters[std::min(slot, kMaxThreads - 1)];
+        }
+        return *tl_counters;
+    }
+}
+
+#ifdef KEPLAR_TRACK_ALLOCATIONS
+namespace 
+{
+    // aligned requests (operator new with std::align_val_t) come back from the matching aligned delete
+    void* trackedAllocate(size_t size, size_t alignment, bool isAligned) noexcept
+    {
+        ThreadCounters& counters = getThreadCounters();
+        counters.mAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.mBytes.fetch_add(size, std::memory_order_relaxed);
+
+        size = std::max<size_t>(size, 1);
+        if (!isAligned)
+        {
+            return std::malloc(size);
+        }
+
+        alignment = std::max(alignment, sizeof(void*));
+    #ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+    #else
+        void* memory = nullptr;
+        return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+    #endif
+    }
+
+    void trackedFree(void* memory, bool isAligned) noexcept
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        getThreadCounters().mFrees.fetch_add(1, std::memory_order_relaxed);
+    #ifdef _WIN32
+        if (isAligned)
+        {
+            _aligned_free(memory);
+            return;
+        }
+    #else
+        (void)isAligned;
+    #endif
+        std::free(memory);
+    }
+
+    void* throwingAllocate(size_t size, size_t alignment, bool isAligned)
+    {
+        void* memory = trackedAllocate(size, alignment, isAligned);
+        if (!memory)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+}
+
+// replaceable global allocation functions
+void* operator new(size_t size)                                                     { return throwingAllocate(size, alignof(std::max_align_t), false); }
+void* operator new[](size_t size)                                                   { return throwingAllocate(size, alignof(std::max_align_t), false); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept                     { return trackedAllocate(size, alignof(std::max_align_t), false); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept                   { return trackedAllocate(size, alignof(std::max_align_t), false); }
+void* operator new(size_t size, std::align_val_t alignment)                         { return throwingAllocate(size, static_cast<size_t>(alignment), true); }
+void* operator new[](size_t size, std::align_val_t alignment)                       { return throwingAllocate(size, static_cast<size_t>(alignment), true); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept   { return trackedAllocate(size, static_cast<size_t>(alignment), true); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAllocate(size, static_cast<size_t>(alignment), true); }
+
+void operator delete(void* memory) noexcept                                         { trackedFree(memory, false); }
+void operator delete[](void* memory) noexcept                                       { trackedFree(memory, false); }
+void operator delete(void* memory, size_t) noexcept                                 { trackedFree(memory, false); }
+void operator delete[](void* memory, size_t) noexcept                               { trackedFree(memory, false); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept                  { trackedFree(memory, false); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept                { trackedFree(memory, false); }
+void operator delete(void* memory, std::align_val_t) noexcept                       { trackedFree(memory, true); }
+void operator delete[](void* memory, std::align_val_t) noexcept                     { trackedFree(memory, true); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept               { trackedFree(memory, true); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept             { trackedFree(memory, true); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept   { trackedFree(memory, true); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(memory, true); }
+#endif
+
+namespace keplar
+{
+    void AllocationTracker::markFrameThread() noexcept
+    {
+    #ifdef KEPLAR_TRACK_ALLOCATIONS
+        getThreadCounters().mIsFrameThread.store(true, std::memory_order_relaxed);
+    #endif
+    }
+
+    AllocationSample AllocationTracker::sampleFrame() noexcept
+    {
+        AllocationSample totals{};
+        const uint32_t threadCount = std::min(s_threadCount.load(std::memory_order_relaxed), kMaxThreads);
+        for (uint32_t thread = 0; thread < threadCount; ++thread)
+        {
+            const ThreadCounters& counters = s_threadCounters[thread];
+            const uint64_t allocations = counters.mAllocations.load(std::memory_order_relaxed);
+            const uint64_t vulkanAllocations = counters.mVulkanAllocations.load(std::memory_order_relaxed);
+            totals.mAllocations += allocations;
+            totals.mFrees += counters.mFrees.load(std::memory_order_relaxed);
+            totals.mBytes += counters.mBytes.load(std::memory_order_relaxed);
+            totals.mVulkanAllocations += vulkanAllocations;
+            if (counters.mIsFrameThread.load(std::memory_order_relaxed))
+            {
+                totals.mFrameThreadAllocations += allocations + vulkanAllocations;
+            }
+        }
+
+        // a thread marked since the previous sample brings its whole history into the frame totals once
+        AllocationSample sample{};
+        sample.mAllocations = totals.mAllocations - s_previousTotals.mAllocations;
+        sample.mFrees = totals.mFrees - s_previousTotals.mFrees;
+        sample.mBytes = totals.mBytes - s_previousTotals.mBytes;
+        sample.mVulkanAllocations = totals.mVulkanAllocations - s_previousTotals.mVulkanAllocations;
+        sample.mFrameThreadAllocations = totals.mFrameThreadAllocations - std::min(totals.mFrameThreadAllocations, s_previousTotals.mFrameThreadAllocations);
+        s_previousTotals = totals;
+
+        s_lastAllocations.store(sample.mAllocations, std::memory_order_relaxed);
+        s_lastFrees.store(sample.mFrees, std::memory_order_relaxed);
+        s_lastBytes.store(sample.mBytes, std::memory_order_relaxed);
+        s_lastVulkanAllocations.store(sample.mVulkanAllocations, std::memory_order_relaxed);
+        s_lastFrameThreadAllocations.store(sample.mFrameThreadAllocations, std::memory_order_relaxed);
+        return sample;
+    }
+
+    AllocationSample AllocationTracker::getLastSample() noexcept
+    {
+        AllocationSample sample{};
+        sample.mAllocations = s_lastAllocations.load(std::memory_order_relaxed);
+        sample.mFrees = s_lastFrees.load(std::memory_order_relaxed);
+        sample.mBytes = s_lastBytes.load(std::memory_order_relaxed);
+        sample.mVulkanAllocations = s_lastVulkanAllocations.load(std::memory_order_relaxed);
+        sample.mFrameThreadAllocations = s_lastFrameThreadAllocations.load(std::memory_order_relaxed);
+        return sample;
+    }
+
+    void AllocationTracker::recordVulkanAllocation([[maybe_unused]] size_t size) noexcept
+    {
+    #ifdef KEPLAR_TRACK_ALLOCATIONS
+        ThreadCounters& counters = getThreadCounters();
+        counters.mVulkanAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.mBytes.fetch_add(size, std::memory_order_relaxed);
+    #endif
+    }
+}   // namespace keplar
@@ -0,0 +1,50 @@
+// ────────────────────────────────────────────
+//  File: allocation_tracker.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace keplar
+{
+    // heap activity between two samples. frame threads are the ones running the frame loop; background threads
+    // (logger, profiler writer, asset streaming) allocate freely and only show in the totals
+    struct AllocationSample
+    {
+        uint64_t mAllocations               = 0;    // operator new, every thread
+        uint64_t mFrees                     = 0;
+        uint64_t mBytes                     = 0;
+        uint64_t mVulkanAllocations         = 0;    // driver host allocations through the tracked callbacks
+        uint64_t mFrameThreadAllocations    = 0;    // heap and driver allocations of frame threads
+    };
+
+    // heap instrumentation of KEPLAR_TRACK_ALLOCATIONS builds: global operator new/delete are replaced and counted per
+    // thread (lock-free, one cache line per thread), and the vulkan host allocation callbacks report here. without the
+    // define every call is a no-op and operator new is the standard library's
+    class AllocationTracker
+    {
+        public:
+            static constexpr bool isEnabled() noexcept
+            {
+            #ifdef KEPLAR_TRACK_ALLOCATIONS
+                return true;
+            #else
+                return false;
+            #endif
+            }
+
+            // usage: once on each thread that runs frames
+            static void markFrameThread() noexcept;
+
+            // usage: once per frame from the frame loop; the activity of every thread since the previous sample
+            static AllocationSample sampleFrame() noexcept;
+
+            // the last sampled frame, from any thread (overlays)
+            static AllocationSample getLastSample() noexcept;
+
+            // usage: from the vulkan host allocation callbacks
+            static void recordVulkanAllocation(size_t size) noexcept;
+    };
+}   // namespace keplar
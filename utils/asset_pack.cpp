@@ -0,0 +1,339 @@
+// ────────────────────────────────────────────
+//  File: asset_pack.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "asset_pack.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stb_image.h>
+
+#include "utils/logger.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace
+{
+    // entries of at least this many chunks are decoded across the pack's workers, smaller ones on the caller
+    constexpr size_t kParallelDecodeChunks = 8;
+}
+
+namespace keplar
+{
+    AssetPack::AssetPack() noexcept
+        : m_entries(nullptr)
+        , m_entryCount(0)
+        , m_names(nullptr)
+        , m_namesSize(0)
+        , m_chunkSize(0)
+        , m_writeTime(0)
+    {
+    }
+
+    AssetPack::~AssetPack()
+    {
+        close();
+    }
+
+    bool AssetPack::open(const std::filesystem::path& filepath) noexcept
+    {
+        close();
+        if (!m_file.open(filepath))
+        {
+            return false;
+        }
+
+        // validate the header and that index and names lie inside the file before handing out pointers into it
+        const uint8_t* data = m_file.getData();
+        const size_t size = m_file.getSize();
+        AssetPackHeader header{};
+        if (size < sizeof(header))
+        {
+            VK_LOG_WARN("AssetPack::open :: %s is too small to be a pack", filepath.string().c_str());
+            close();
+            return false;
+        }
+
+        std::memcpy(&header, data, sizeof(header));
+        const uint64_t indexSize = static_cast<uint64_t>(header.mEntryCount) * sizeof(AssetPackEntry);
+        if (std::memcmp(header.mMagic, kAssetPackMagic, sizeof(kAssetPackMagic)) != 0 || header.mVersion != kAssetPackVersion ||
+            header.mIndexOffset > size || indexSize > size - header.mIndexOffset || (header.mIndexOffset % alignof(AssetPackEntry)) != 0 ||
+            header.mNamesOffset > size || header.mNamesSize > size - header.mNamesOffset || header.mChunkSize == 0 ||
+            header.mChunkSize > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+        {
+            VK_LOG_WARN("AssetPack::open :: %s has an unsupported or malformed header", filepath.string().c_str());
+            close();
+            return false;
+        }
+
+        m_entries    = reinterpret_cast<const AssetPackEntry*>(data + header.mIndexOffset);
+        m_entryCount = header.mEntryCount;
+        m_names      = reinterpret_cast<const char*>(data + header.mNamesOffset);
+        m_namesSize  = static_cast<size_t>(header.mNamesSize);
+        m_chunkSize  = header.mChunkSize;
+        bool hasCompressedEntries = false;
+        for (size_t i = 0; i < m_entryCount; ++i)
+        {
+            const AssetPackEntry& entry = m_entries[i];
+            if (entry.mOffset > size || entry.mStoredSize > size - entry.mOffset ||
+                static_cast<uint64_t>(entry.mNameOffset) + entry.mNameLength > m_namesSize)
+            {
+                VK_LOG_WARN("AssetPack::open :: %s has an entry outside the file", filepath.string().c_str());
+                close();
+                return false;
+            }
+            hasCompressedEntries = hasCompressedEntries || entry.mCompression != static_cast<uint32_t>(AssetPackCompression::kNone);
+        }
+
+        if (hasCompressedEntries)
+        {
+            m_decodePool = std::make_unique<ThreadPool>(std::max(1u, std::thread::hardware_concurrency()), 0, "unpack");
+        }
+
+        std::error_code errorCode;
+        m_root = std::filesystem::current_path(errorCode);
+        m_writeTime = static_cast<int64_t>(std::filesystem::last_write_time(filepath, errorCode).time_since_epoch().count());
+        m_path = filepath;
+        VK_LOG_INFO("AssetPack::open successful: %s (%zu files)", filepath.string().c_str(), m_entryCount);
+        return true;
+    }
+
+    void AssetPack::close() noexcept
+    {
+        m_decodePool.reset();
+        m_file.close();
+        m_path.clear();
+        m_root.clear();
+        m_entries = nullptr;
+        m_entryCount = 0;
+        m_names = nullptr;
+        m_namesSize = 0;
+        m_chunkSize = 0;
+        m_writeTime = 0;
+    }
+
+    bool AssetPack::find(const std::filesystem::path& filepath, const uint8_t*& data, size_t& size) const noexcept
+    {
+        const AssetPackEntry* entry = findEntry(filepath);
+        if (!entry)
+        {
+            return false;
+        }
+
+        // compressed entries have no in-place contents; load() and read() decode them
+        if (entry->mCompression != static_cast<uint32_t>(AssetPackCompression::kNone))
+        {
+            return false;
+        }
+
+        data = m_file.getData() + entry->mOffset;
+        size = static_cast<size_t>(entry->mSize);
+        return true;
+    }
+
+    bool AssetPack::load(const std::filesystem::path& filepath, std::vector<uint8_t>& storage, const uint8_t*& data, size_t& size) const noexcept
+    {
+        const AssetPackEntry* entry = findEntry(filepath);
+        if (!entry)
+        {
+            return false;
+        }
+
+        if (entry->mCompression == static_cast<uint32_t>(AssetPackCompression::kNone))
+        {
+            data = m_file.getData() + entry->mOffset;
+            size = static_cast<size_t>(entry->mSize);
+            return true;
+        }
+
+        storage.resize(static_cast<size_t>(entry->mSize));
+        if (!decompress(*entry, storage.data()))
+        {
+            VK_LOG_WARN("AssetPack::load :: failed to decompress %s", filepath.string().c_str());
+            return false;
+        }
+
+        data = storage.data();
+        size = storage.size();
+        return true;
+    }
+
+    bool AssetPack::read(const std::filesystem::path& filepath, void* destination, size_t capacity, size_t& size) const noexcept
+    {
+        const AssetPackEntry* entry = findEntry(filepath);
+        if (!entry)
+        {
+            return false;
+        }
+
+        if (entry->mSize > capacity)
+        {
+            VK_LOG_WARN("AssetPack::read :: %s (%llu bytes) does not fit its destination (%zu bytes)", filepath.string().c_str(),
+                        static_cast<unsigned long long>(entry->mSize), capacity);
+            return false;
+        }
+
+        size = static_cast<size_t>(entry->mSize);
+        if (entry->mCompression == static_cast<uint32_t>(AssetPackCompression::kNone))
+        {
+            if (size > 0)
+            {
+                std::memcpy(destination, m_file.getData() + entry->mOffset, size);
+            }
+            return true;
+        }
+
+        if (!decompress(*entry, static_cast<uint8_t*>(destination)))
+        {
+            VK_LOG_WARN("AssetPack::read :: failed to decompress %s", filepath.string().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetPack::getSize(const std::filesystem::path& filepath, size_t& size) const noexcept
+    {
+        const AssetPackEntry* entry = findEntry(filepath);
+        if (!entry)
+        {
+            return false;
+        }
+
+        size = static_cast<size_t>(entry->mSize);
+        return true;
+    }
+
+    bool AssetPack::contains(const std::filesystem::path& filepath) const noexcept
+    {
+        return findEntry(filepath) != nullptr;
+    }
+
+    AssetPack& AssetPack::getInstance() noexcept
+    {
+        static AssetPack instance;
+        return instance;
+    }
+
+    bool AssetPack::exists(const std::filesystem::path& filepath) noexcept
+    {
+        std::error_code errorCode;
+        return getInstance().contains(filepath) || std::filesystem::exists(filepath, errorCode);
+    }
+
+    bool AssetPack::getFileSize(const std::filesystem::path& filepath, size_t& size) noexcept
+    {
+        if (getInstance().getSize(filepath, size))
+        {
+            return true;
+        }
+
+        std::error_code errorCode;
+        const uintmax_t fileSize = std::filesystem::file_size(filepath, errorCode);
+        size = static_cast<size_t>(fileSize);
+        return !errorCode;
+    }
+
+    std::string AssetPack::makeKey(const std::filesystem::path& filepath, const std::filesystem::path& root) noexcept
+    {
+        std::filesystem::path path = filepath;
+        if (path.is_absolute() && !root.empty())
+        {
+            path = path.lexically_relative(root);
+        }
+        return path.lexically_normal().generic_string();
+    }
+
+    const AssetPackEntry* AssetPack::findEntry(const std::filesystem::path& filepath) const noexcept
+    {
+        if (m_entryCount == 0)
+        {
+            return nullptr;
+        }
+
+        // entries are sorted by hash; equal hashes are told apart by their stored path
+        const std::string key = makeKey(filepath, m_root);
+        const uint64_t hash = hashAssetPath(key);
+        const AssetPackEntry* end = m_entries + m_entryCount;
+        const AssetPackEntry* entry = std::lower_bound(m_entries, end, hash, [](const AssetPackEntry& candidate, uint64_t value)
+        {
+            return candidate.mPathHash < value;
+        });
+
+        for (; entry != end && entry->mPathHash == hash; ++entry)
+        {
+            if (std::string_view(m_names + entry->mNameOffset, entry->mNameLength) == key)
+            {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    bool AssetPack::decompress(const AssetPackEntry& entry, uint8_t* destination) const noexcept
+    {
+        if (entry.mCompression != static_cast<uint32_t>(AssetPackCompression::kDeflate))
+        {
+            VK_LOG_WARN_THROTTLED("AssetPack::decompress :: unsupported compression %u", entry.mCompression);
+            return false;
+        }
+
+        // chunk table, then the streams; offsets were not validated at open, so each chunk is checked before decoding
+        const size_t chunkCount = static_cast<size_t>((entry.mSize + m_chunkSize - 1) / m_chunkSize);
+        const size_t tableSize = chunkCount * sizeof(uint32_t);
+        if (tableSize > entry.mStoredSize)
+        {
+            return false;
+        }
+
+        const uint8_t* payload = m_file.getData() + entry.mOffset;
+        const uint8_t* streams = payload + tableSize;
+        const size_t streamsSize = static_cast<size_t>(entry.mStoredSize) - tableSize;
+        auto decodeChunk = [&](size_t index) noexcept
+        {
+            uint32_t begin = 0;
+            uint32_t end = 0;
+            if (index > 0)
+            {
+                std::memcpy(&begin, payload + (index - 1) * sizeof(uint32_t), sizeof(uint32_t));
+            }
+            std::memcpy(&end, payload + index * sizeof(uint32_t), sizeof(uint32_t));
+
+            const size_t offset = index * m_chunkSize;
+            const size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(m_chunkSize, entry.mSize - offset));
+            if (begin > end || end > streamsSize || end - begin > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+            {
+                return false;
+            }
+
+            const int decoded = stbi_zlib_decode_buffer(reinterpret_cast<char*>(destination + offset), static_cast<int>(chunkSize),
+                                                        reinterpret_cast<const char*>(streams + begin), static_cast<int>(end - begin));
+            return decoded == static_cast<int>(chunkSize);
+        };
+
+        if (chunkCount < kParallelDecodeChunks || !m_decodePool)
+        {
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                if (!decodeChunk(i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // the caller joins in, so a load running on another pool's worker still makes progress
+        std::atomic<bool> isDecoded{ true };
+        TaskGroup group(*m_decodePool);
+        group.parallelFor(chunkCount, 0, [&](size_t index)
+        {
+            if (isDecoded.load(std::memory_order_relaxed) && !decodeChunk(index))
+            {
+                isDecoded.store(false, std::memory_order_relaxed);
+            }
+        });
+        group.wait();
+        return isDecoded.load(std::memory_order_relaxed);
+    }
+}   // namespace keplar
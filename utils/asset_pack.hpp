@@ -0,0 +1,138 @@
+// ────────────────────────────────────────────
+//  File: asset_pack.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <memory>
+
+#include "mapped_file.hpp"
+
+namespace keplar
+{
+    class ThreadPool;
+
+    // .kpak layout: header, then the file contents each starting on kAssetPackAlignment (ready for mmap and direct
+    // reads), then the index sorted by path hash and the path strings it points into. paths are stored relative to
+    // the directory the runtime resolves them from (the working directory), with forward slashes
+    inline constexpr char     kAssetPackMagic[4]    = { 'K', 'P', 'A', 'K' };
+    inline constexpr uint32_t kAssetPackVersion     = 2;
+    inline constexpr uint32_t kAssetPackAlignment   = 4096;
+    inline constexpr uint32_t kAssetPackChunkSize   = 64u << 10;
+
+    // a compressed entry is split into chunks of the header's chunk size that decode independently (the tiling
+    // gpu codecs such as gdeflate use): uint32_t end offsets of every chunk, relative to the end of that table,
+    // followed by the chunk streams
+    enum class AssetPackCompression : uint32_t
+    {
+        kNone = 0,
+        kDeflate = 1        // zlib stream per chunk
+    };
+
+    struct AssetPackHeader
+    {
+        char     mMagic[4];
+        uint32_t mVersion;
+        uint32_t mEntryCount;
+        uint32_t mAlignment;
+        uint32_t mChunkSize;        // bytes of file per compressed chunk
+        uint32_t mReserved;
+        uint64_t mIndexOffset;      // AssetPackEntry[mEntryCount]
+        uint64_t mNamesOffset;      // path strings, not null-terminated
+        uint64_t mNamesSize;
+    };
+
+    struct AssetPackEntry
+    {
+        uint64_t mPathHash;
+        uint64_t mOffset;
+        uint64_t mSize;             // bytes of the file
+        uint64_t mStoredSize;       // bytes in the pack; equal to mSize while uncompressed
+        uint32_t mNameOffset;
+        uint32_t mNameLength;
+        uint32_t mCompression;      // AssetPackCompression
+        uint32_t mReserved;
+    };
+
+    // 64-bit fnv-1a over the normalized path, shared by the packer and the runtime
+    inline uint64_t hashAssetPath(std::string_view path) noexcept
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (const char c : path)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    // read-only view of a mapped .kpak. lookups take the path a loose file would be opened with; open the pack before
+    // any loads start, lookups are then safe from every thread. large compressed entries decode their chunks in
+    // parallel on the pack's own workers
+    class AssetPack final
+    {
+        public:
+            // creation and destruction
+            AssetPack() noexcept;
+            ~AssetPack();
+
+            // disable copy and move semantics to enforce unique ownership
+            AssetPack(const AssetPack&) = delete;
+            AssetPack& operator=(const AssetPack&) = delete;
+            AssetPack(AssetPack&&) = delete;
+            AssetPack& operator=(AssetPack&&) = delete;
+
+            // usage
+            bool open(const std::filesystem::path& filepath) noexcept;
+            void close() noexcept;
+
+            // contents of a stored file, pointing into the mapping; false when the file is not in the pack or compressed
+            bool find(const std::filesystem::path& filepath, const uint8_t*& data, size_t& size) const noexcept;
+
+            // contents of a packed file: in the mapping when stored, otherwise decompressed into storage
+            bool load(const std::filesystem::path& filepath, std::vector<uint8_t>& storage, const uint8_t*& data, size_t& size) const noexcept;
+
+            // copy or decompress a packed file into caller memory of capacity bytes (staging memory, a read buffer)
+            bool read(const std::filesystem::path& filepath, void* destination, size_t capacity, size_t& size) const noexcept;
+
+            // size of a packed file once decompressed
+            bool getSize(const std::filesystem::path& filepath, size_t& size) const noexcept;
+            bool contains(const std::filesystem::path& filepath) const noexcept;
+
+            // pack of the process; assets resolve through it first and fall back to loose files when it has no entry
+            static AssetPack& getInstance() noexcept;
+            static bool exists(const std::filesystem::path& filepath) noexcept;
+            static bool getFileSize(const std::filesystem::path& filepath, size_t& size) noexcept;
+
+            // key a path is stored under: relative to the working directory, normalized, forward slashes
+            static std::string makeKey(const std::filesystem::path& filepath, const std::filesystem::path& root) noexcept;
+
+            // accessors
+            bool isOpen() const noexcept                                    { return m_file.isOpen(); }
+            size_t getEntryCount() const noexcept                           { return m_entryCount; }
+            const std::filesystem::path& getPath() const noexcept           { return m_path; }
+            int64_t getWriteTime() const noexcept                           { return m_writeTime; }
+
+        private:
+            const AssetPackEntry* findEntry(const std::filesystem::path& filepath) const noexcept;
+            bool decompress(const AssetPackEntry& entry, uint8_t* destination) const noexcept;
+
+        private:
+            MappedFile                  m_file;
+            std::filesystem::path       m_path;
+            std::filesystem::path       m_root;         // working directory at open, absolute paths are made relative to it
+            const AssetPackEntry*       m_entries;
+            size_t                      m_entryCount;
+            const char*                 m_names;
+            size_t                      m_namesSize;
+            uint32_t                    m_chunkSize;
+            int64_t                     m_writeTime;    // of the pack file, in filesystem clock ticks
+            std::unique_ptr<ThreadPool> m_decodePool;   // only for packs with compressed entries
+    };
+}   // namespace keplar
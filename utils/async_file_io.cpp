@@ -0,0 +1,631 @@
+// ────────────────────────────────────────────
+//  File: async_file_io.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "async_file_io.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/uio.h>
+    #if defined(__linux__) && __has_include(<linux/io_uring.h>)
+        #define KEPLAR_HAS_IO_URING
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+#include "utils/asset_pack.hpp"
+#include "utils/logger.hpp"
+#include "utils/profiler.hpp"
+
+namespace
+{
+    // one completion wait reaps at most this many reads
+    constexpr uint32_t kMaxCompletionBatch = 64;
+
+    // progress of one file through its reads
+    enum class ReadStatus : uint8_t { kInFlight, kPartial, kDone, kFailed };
+
+    size_t alignUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+namespace keplar
+{
+    struct AsyncFileIO::Operation
+    {
+    #ifdef _WIN32
+        OVERLAPPED  mOverlapped{};          // completions find their operation through it
+        HANDLE      mFile = INVALID_HANDLE_VALUE;
+    #else
+        int         mFile = -1;
+        iovec       mIov{};
+    #endif
+        FileRead*   mRead = nullptr;
+        uint8_t*    mBuffer = nullptr;
+        size_t      mSize = 0;
+        size_t      mCompleted = 0;
+        ReadStatus  mStatus = ReadStatus::kDone;
+        bool        mIsDirect = false;
+    };
+
+#ifdef KEPLAR_HAS_IO_URING
+    // submission and completion rings shared with the kernel
+    struct AsyncFileIO::Ring
+    {
+        int             mFd = -1;
+        void*           mSqRing = MAP_FAILED;
+        void*           mCqRing = MAP_FAILED;
+        io_uring_sqe*   mSqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t          mSqRingSize = 0;
+        size_t          mCqRingSize = 0;
+        size_t          mSqesSize = 0;
+        unsigned*       mSqTail = nullptr;
+        unsigned*       mSqMask = nullptr;
+        unsigned*       mSqArray = nullptr;
+        unsigned*       mCqHead = nullptr;
+        unsigned*       mCqTail = nullptr;
+        unsigned*       mCqMask = nullptr;
+        io_uring_cqe*   mCqes = nullptr;
+        unsigned        mToSubmit = 0;      // queued entries the next io_uring_enter hands to the kernel
+
+        bool initialize(uint32_t depth) noexcept
+        {
+            io_uring_params params{};
+            mFd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+            if (mFd < 0)
+            {
+                return false;
+            }
+
+            mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (isSingleMap)
+            {
+                mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+            }
+
+            mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, IORING_OFF_SQ_RING);
+            mCqRing = isSingleMap ? mSqRing : mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, IORING_OFF_CQ_RING);
+            mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            mSqes = static_cast<io_uring_sqe*>(mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, IORING_OFF_SQES));
+            if (mSqRing == MAP_FAILED || mCqRing == MAP_FAILED || mSqes == MAP_FAILED)
+            {
+                destroy();
+                return false;
+            }
+
+            uint8_t* sq = static_cast<uint8_t*>(mSqRing);
+            uint8_t* cq = static_cast<uint8_t*>(mCqRing);
+            mSqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            mSqMask  = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            mSqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            mCqHead  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            mCqTail  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            mCqMask  = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            mCqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        void destroy() noexcept
+        {
+            if (mSqes != MAP_FAILED)
+            {
+                munmap(mSqes, mSqesSize);
+            }
+            if (mCqRing != MAP_FAILED && mCqRing != mSqRing)
+            {
+                munmap(mCqRing, mCqRingSize);
+            }
+            if (mSqRing != MAP_FAILED)
+            {
+                munmap(mSqRing, mSqRingSize);
+            }
+            if (mFd >= 0)
+            {
+                close(mFd);
+            }
+            *this = Ring{};
+        }
+
+        // the kernel only reads entries past the tail once it is published; we are the single producer
+        void pushRead(int fd, const iovec* iov, uint64_t offset, uint64_t userData) noexcept
+        {
+            const unsigned tail = *mSqTail;
+            const unsigned index = tail & *mSqMask;
+            io_uring_sqe& sqe = mSqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = IORING_OP_READV;
+            sqe.fd        = fd;
+            sqe.addr      = reinterpret_cast<uint64_t>(iov);
+            sqe.len       = 1;
+            sqe.off       = offset;
+            sqe.user_data = userData;
+            mSqArray[index] = index;
+            __atomic_store_n(mSqTail, tail + 1, __ATOMIC_RELEASE);
+            ++mToSubmit;
+        }
+
+        // submits the queued entries and blocks for at least one completion
+        bool enter() noexcept
+        {
+            for (;;)
+            {
+                const long result = syscall(__NR_io_uring_enter, mFd, mToSubmit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (result >= 0)
+                {
+                    mToSubmit -= std::min(mToSubmit, static_cast<unsigned>(result));
+                    return true;
+                }
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                {
+                    return false;
+                }
+            }
+        }
+    };
+#else
+    struct AsyncFileIO::Ring {};
+#endif
+
+    AsyncFileIO::AsyncFileIO() noexcept
+        : m_ring(nullptr)
+        , m_completionPort(nullptr)
+        , m_queueDepth(kDefaultQueueDepth)
+        , m_isOverlapped(false)
+        , m_isInitialized(false)
+    {
+    }
+
+    AsyncFileIO::~AsyncFileIO()
+    {
+        destroy();
+    }
+
+    bool AsyncFileIO::initialize(uint32_t queueDepth) noexcept
+    {
+        destroy();
+        m_queueDepth = std::max(1u, queueDepth);
+
+    #ifdef _WIN32
+        m_completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        m_isOverlapped = m_completionPort != nullptr;
+    #elif defined(KEPLAR_HAS_IO_URING)
+        // seccomp profiles of containers commonly refuse io_uring; plain reads then do the work
+        m_ring = new Ring();
+        if (!m_ring->initialize(m_queueDepth))
+        {
+            delete m_ring;
+            m_ring = nullptr;
+        }
+        m_isOverlapped = m_ring != nullptr;
+    #endif
+
+        m_isInitialized = true;
+        VK_LOG_DEBUG("AsyncFileIO::initialize successful (%s, queue depth %u)", getBackendName(), m_queueDepth);
+        return true;
+    }
+
+    void AsyncFileIO::destroy() noexcept
+    {
+    #ifdef _WIN32
+        if (m_completionPort)
+        {
+            CloseHandle(m_completionPort);
+            m_completionPort = nullptr;
+        }
+    #elif defined(KEPLAR_HAS_IO_URING)
+        if (m_ring)
+        {
+            m_ring->destroy();
+            delete m_ring;
+            m_ring = nullptr;
+        }
+    #endif
+        m_isOverlapped = false;
+        m_isInitialized = false;
+    }
+
+    AsyncFileIO& AsyncFileIO::getThreadInstance() noexcept
+    {
+        thread_local AsyncFileIO fileIO;
+        thread_local const bool isInitialized = fileIO.initialize(kDefaultQueueDepth);
+        (void)isInitialized;
+        return fileIO;
+    }
+
+    const char* AsyncFileIO::getBackendName() const noexcept
+    {
+    #ifdef _WIN32
+        return m_isOverlapped ? "iocp" : "blocking";
+    #else
+        return m_isOverlapped ? "io_uring" : "blocking";
+    #endif
+    }
+
+    bool AsyncFileIO::readFile(const std::filesystem::path& filepath, std::vector<uint8_t>& data) noexcept
+    {
+        FileRead read{};
+        read.mPath = filepath;
+        const bool isRead = readFiles(&read, 1);
+        data = std::move(read.mData);
+        return isRead;
+    }
+
+    bool AsyncFileIO::readFiles(FileRead* reads, size_t count) noexcept
+    {
+        KEPLAR_PROFILE_ZONE("AsyncFileIO::readFiles");
+        if (!m_isInitialized && !initialize(m_queueDepth))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            reads[i].mIsRead = false;
+        }
+
+        // one slot per read in flight; files are opened only once a slot frees so descriptors stay bounded
+        std::vector<Operation> operations(std::min<size_t>(m_queueDepth, count));
+        size_t nextRead = 0;
+        size_t inFlight = 0;
+        bool isSuccess = true;
+        auto startNext = [&](size_t slot) noexcept
+        {
+            Operation& operation = operations[slot];
+            while (nextRead < count)
+            {
+                FileRead& read = reads[nextRead++];
+                if (readPacked(read))
+                {
+                    continue;
+                }
+
+                if (!openOperation(operation, read))
+                {
+                    isSuccess = false;
+                    continue;
+                }
+
+                // empty files and the fallback path complete right here
+                if (operation.mSize == 0 || !m_isOverlapped)
+                {
+                    read.mIsRead = operation.mSize == 0 || readBlocking(operation);
+                    read.mSize = read.mIsRead ? operation.mSize : 0;
+                    isSuccess = isSuccess && read.mIsRead;
+                    closeOperation(operation);
+                    continue;
+                }
+
+                if (!submitOperation(operation, slot))
+                {
+                    isSuccess = false;
+                    closeOperation(operation);
+                    continue;
+                }
+                ++inFlight;
+                return;
+            }
+        };
+
+        for (size_t slot = 0; slot < operations.size(); ++slot)
+        {
+            startNext(slot);
+        }
+
+        while (inFlight > 0)
+        {
+            if (waitCompletions(operations) == 0)
+            {
+                // the backend failed as a whole: what is still in flight cannot be trusted, read it again plainly
+                VK_LOG_WARN("AsyncFileIO::readFiles :: %s completion wait failed, falling back to blocking reads", getBackendName());
+                destroy();
+                m_isInitialized = true;
+                for (Operation& operation : operations)
+                {
+                    if (operation.mRead && operation.mStatus != ReadStatus::kDone && operation.mStatus != ReadStatus::kFailed)
+                    {
+                        operation.mCompleted = 0;
+                        operation.mStatus = readBlocking(operation) ? ReadStatus::kDone : ReadStatus::kFailed;
+                    }
+                }
+            }
+
+            // finished files hand their slot to the next request, short reads continue where they stopped
+            for (size_t slot = 0; slot < operations.size(); ++slot)
+            {
+                Operation& operation = operations[slot];
+                if (!operation.mRead || operation.mStatus == ReadStatus::kInFlight)
+                {
+                    continue;
+                }
+
+                if (operation.mStatus == ReadStatus::kPartial && submitOperation(operation, slot))
+                {
+                    continue;
+                }
+
+                FileRead& read = *operation.mRead;
+                read.mIsRead = operation.mStatus == ReadStatus::kDone;
+                read.mSize = read.mIsRead ? operation.mSize : 0;
+                isSuccess = isSuccess && read.mIsRead;
+                closeOperation(operation);
+                --inFlight;
+                startNext(slot);
+            }
+        }
+        return isSuccess;
+    }
+
+    bool AsyncFileIO::readPacked(FileRead& read) noexcept
+    {
+        // packed files are copied or decompressed out of the pack's mapping straight into the destination; no file is opened
+        const AssetPack& assetPack = AssetPack::getInstance();
+        size_t size = 0;
+        if (!assetPack.getSize(read.mPath, size))
+        {
+            return false;
+        }
+
+        void* destination = read.mDestination;
+        size_t capacity = read.mCapacity;
+        if (!destination)
+        {
+            read.mData.resize(size);
+            destination = read.mData.data();
+            capacity = size;
+        }
+
+        if (!assetPack.read(read.mPath, destination, capacity, size))
+        {
+            return false;
+        }
+        read.mSize = size;
+        read.mIsRead = true;
+        return true;
+    }
+
+    bool AsyncFileIO::openOperation(Operation& operation, FileRead& read) noexcept
+    {
+        operation = Operation{};
+        std::error_code errorCode;
+        const uintmax_t fileSize = std::filesystem::file_size(read.mPath, errorCode);
+        if (errorCode || fileSize > SIZE_MAX)
+        {
+            return false;
+        }
+
+        // caller memory must hold the whole file; direct reads also transfer whole aligned blocks
+        const size_t size = static_cast<size_t>(fileSize);
+        if (read.mDestination)
+        {
+            if (read.mCapacity < size)
+            {
+                VK_LOG_WARN("AsyncFileIO :: %s (%zu bytes) does not fit its destination (%zu bytes)", read.mPath.string().c_str(), size, read.mCapacity);
+                return false;
+            }
+            operation.mBuffer = static_cast<uint8_t*>(read.mDestination);
+            operation.mIsDirect = m_isOverlapped && size > 0 && (reinterpret_cast<uintptr_t>(read.mDestination) % kDirectAlignment) == 0 &&
+                                  read.mCapacity >= alignUp(size, kDirectAlignment);
+        }
+        else
+        {
+            read.mData.resize(size);
+            operation.mBuffer = read.mData.data();
+        }
+
+    #ifdef _WIN32
+        const DWORD flags = FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN | (operation.mIsDirect ? FILE_FLAG_NO_BUFFERING : 0);
+        operation.mFile = CreateFileW(read.mPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (operation.mFile == INVALID_HANDLE_VALUE && operation.mIsDirect)
+        {
+            operation.mIsDirect = false;
+            operation.mFile = CreateFileW(read.mPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        }
+        if (operation.mFile == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        if (m_completionPort && CreateIoCompletionPort(operation.mFile, m_completionPort, 0, 0) == nullptr)
+        {
+            CloseHandle(operation.mFile);
+            operation.mFile = INVALID_HANDLE_VALUE;
+            return false;
+        }
+    #else
+        int flags = O_RDONLY | O_CLOEXEC;
+        #ifdef O_DIRECT
+        flags |= operation.mIsDirect ? O_DIRECT : 0;
+        #endif
+        operation.mFile = open(read.mPath.c_str(), flags);
+        if (operation.mFile < 0 && operation.mIsDirect)
+        {
+            // file systems without direct i/o (tmpfs, some network mounts) refuse the flag
+            operation.mIsDirect = false;
+            operation.mFile = open(read.mPath.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        if (operation.mFile < 0)
+        {
+            return false;
+        }
+    #endif
+
+        operation.mRead = &read;
+        operation.mSize = size;
+        return true;
+    }
+
+    void AsyncFileIO::closeOperation(Operation& operation) noexcept
+    {
+    #ifdef _WIN32
+        if (operation.mFile != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(operation.mFile);
+        }
+    #else
+        if (operation.mFile >= 0)
+        {
+            close(operation.mFile);
+        }
+    #endif
+        operation = Operation{};
+    }
+
+    bool AsyncFileIO::readBlocking(Operation& operation) noexcept
+    {
+        while (operation.mCompleted < operation.mSize)
+        {
+            const size_t remaining = operation.mSize - operation.mCompleted;
+            const size_t length = std::min(kMaxReadSize, operation.mIsDirect ? alignUp(remaining, kDirectAlignment) : remaining);
+
+        #ifdef _WIN32
+            // overlapped handles need an offset even for a synchronous read; the wait is on the handle itself
+            OVERLAPPED overlapped{};
+            overlapped.Offset     = static_cast<DWORD>(operation.mCompleted & 0xFFFFFFFFull);
+            overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(operation.mCompleted) >> 32);
+            DWORD bytesRead = 0;
+            if (!ReadFile(operation.mFile, operation.mBuffer + operation.mCompleted, static_cast<DWORD>(length), nullptr, &overlapped) &&
+                GetLastError() != ERROR_IO_PENDING)
+            {
+                return false;
+            }
+            if (!GetOverlappedResult(operation.mFile, &overlapped, &bytesRead, TRUE) || bytesRead == 0)
+            {
+                return false;
+            }
+            operation.mCompleted += bytesRead;
+        #else
+            const ssize_t bytesRead = pread(operation.mFile, operation.mBuffer + operation.mCompleted, length, static_cast<off_t>(operation.mCompleted));
+            if (bytesRead < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytesRead <= 0)
+            {
+                return false;
+            }
+            operation.mCompleted += static_cast<size_t>(bytesRead);
+        #endif
+        }
+        return true;
+    }
+
+    bool AsyncFileIO::submitOperation(Operation& operation, size_t slot) noexcept
+    {
+        // a short direct read leaves an unaligned offset, which only buffered reads accept
+        if (operation.mIsDirect && (operation.mCompleted % kDirectAlignment) != 0)
+        {
+        #if defined(_WIN32) || !defined(O_DIRECT)
+            (void)slot;
+            return false;
+        #else
+            fcntl(operation.mFile, F_SETFL, fcntl(operation.mFile, F_GETFL) & ~O_DIRECT);
+            operation.mIsDirect = false;
+        #endif
+        }
+
+        const size_t remaining = operation.mSize - operation.mCompleted;
+        const size_t length = std::min(kMaxReadSize, operation.mIsDirect ? alignUp(remaining, kDirectAlignment) : remaining);
+        operation.mStatus = ReadStatus::kInFlight;
+
+    #ifdef _WIN32
+        (void)slot;
+        operation.mOverlapped = OVERLAPPED{};
+        operation.mOverlapped.Offset     = static_cast<DWORD>(operation.mCompleted & 0xFFFFFFFFull);
+        operation.mOverlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(operation.mCompleted) >> 32);
+
+        // a read that completes at once still posts its completion to the port
+        if (!ReadFile(operation.mFile, operation.mBuffer + operation.mCompleted, static_cast<DWORD>(length), nullptr, &operation.mOverlapped) &&
+            GetLastError() != ERROR_IO_PENDING)
+        {
+            operation.mStatus = ReadStatus::kFailed;
+            return false;
+        }
+        return true;
+    #elif defined(KEPLAR_HAS_IO_URING)
+        operation.mIov.iov_base = operation.mBuffer + operation.mCompleted;
+        operation.mIov.iov_len  = length;
+        m_ring->pushRead(operation.mFile, &operation.mIov, operation.mCompleted, slot);
+        return true;
+    #else
+        (void)slot;
+        (void)length;
+        operation.mStatus = ReadStatus::kFailed;
+        return false;
+    #endif
+    }
+
+    size_t AsyncFileIO::waitCompletions(std::vector<Operation>& operations) noexcept
+    {
+        // applies one completed read of bytesRead bytes (negative: failed) to its operation
+        auto complete = [](Operation& operation, int64_t bytesRead) noexcept
+        {
+            if (bytesRead <= 0)
+            {
+                operation.mStatus = ReadStatus::kFailed;
+                return;
+            }
+            operation.mCompleted = std::min(operation.mSize, operation.mCompleted + static_cast<size_t>(bytesRead));
+            operation.mStatus = (operation.mCompleted == operation.mSize) ? ReadStatus::kDone : ReadStatus::kPartial;
+        };
+
+    #ifdef _WIN32
+        OVERLAPPED_ENTRY entries[kMaxCompletionBatch];
+        ULONG removed = 0;
+        const ULONG capacity = static_cast<ULONG>(std::min<size_t>(kMaxCompletionBatch, operations.size()));
+        if (!GetQueuedCompletionStatusEx(static_cast<HANDLE>(m_completionPort), entries, capacity, &removed, INFINITE, FALSE))
+        {
+            return 0;
+        }
+
+        for (ULONG i = 0; i < removed; ++i)
+        {
+            Operation& operation = *CONTAINING_RECORD(entries[i].lpOverlapped, Operation, mOverlapped);
+            const bool isFailed = entries[i].lpOverlapped->Internal != 0;
+            complete(operation, isFailed ? -1 : static_cast<int64_t>(entries[i].dwNumberOfBytesTransferred));
+        }
+        return removed;
+    #elif defined(KEPLAR_HAS_IO_URING)
+        if (!m_ring->enter())
+        {
+            return 0;
+        }
+
+        size_t completed = 0;
+        unsigned head = *m_ring->mCqHead;
+        const unsigned tail = __atomic_load_n(m_ring->mCqTail, __ATOMIC_ACQUIRE);
+        while (head != tail && completed < kMaxCompletionBatch)
+        {
+            const io_uring_cqe& cqe = m_ring->mCqes[head & *m_ring->mCqMask];
+            if (cqe.user_data < operations.size())
+            {
+                complete(operations[cqe.user_data], cqe.res);
+            }
+            ++head;
+            ++completed;
+        }
+        __atomic_store_n(m_ring->mCqHead, head, __ATOMIC_RELEASE);
+        return completed;
+    #else
+        (void)operations;
+        (void)complete;
+        return 0;
+    #endif
+    }
+}   // namespace keplar
@@ -0,0 +1,81 @@
+// ────────────────────────────────────────────
+//  File: async_file_io.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace keplar
+{
+    // one whole-file read. with a destination the file lands there and must fit its capacity, otherwise in mData.
+    // a destination aligned to kDirectAlignment whose capacity holds the file rounded up to it is read past the os
+    // file cache (staging memory the data goes to the gpu from)
+    struct FileRead
+    {
+        std::filesystem::path   mPath;
+        void*                   mDestination = nullptr;
+        size_t                  mCapacity = 0;
+        std::vector<uint8_t>    mData;
+        size_t                  mSize = 0;          // bytes of the file, valid once read
+        bool                    mIsRead = false;
+    };
+
+    // overlapped file reads: a batch is kept in flight together up to the queue depth (io_uring on linux, an i/o
+    // completion port on windows), so many small assets load at the device's queue depth instead of one syscall at
+    // a time. kernels or sandboxes without io_uring fall back to plain reads. files in the AssetPack are copied out of
+    // it instead of read. an instance serves one thread at a time
+    class AsyncFileIO final
+    {
+        public:
+            static constexpr uint32_t kDefaultQueueDepth    = 32;
+            static constexpr size_t   kDirectAlignment      = 4096;
+            static constexpr size_t   kMaxReadSize          = 64u << 20;    // larger files complete in several reads
+
+            // creation and destruction
+            AsyncFileIO() noexcept;
+            ~AsyncFileIO();
+
+            // disable copy and move semantics to enforce unique ownership
+            AsyncFileIO(const AsyncFileIO&) = delete;
+            AsyncFileIO& operator=(const AsyncFileIO&) = delete;
+            AsyncFileIO(AsyncFileIO&&) = delete;
+            AsyncFileIO& operator=(AsyncFileIO&&) = delete;
+
+            // false only when no backend, not even the plain reads, could be set up
+            bool initialize(uint32_t queueDepth = kDefaultQueueDepth) noexcept;
+            void destroy() noexcept;
+
+            // usage: reads every request and returns once all completed; false when any of them failed (see mIsRead)
+            bool readFiles(FileRead* reads, size_t count) noexcept;
+            bool readFile(const std::filesystem::path& filepath, std::vector<uint8_t>& data) noexcept;
+
+            // instance of the calling thread, set up on first use
+            static AsyncFileIO& getThreadInstance() noexcept;
+
+            // accessors
+            bool isOverlapped() const noexcept  { return m_isOverlapped; }
+            const char* getBackendName() const noexcept;
+
+        private:
+            struct Ring;
+            struct Operation;
+
+            bool readPacked(FileRead& read) noexcept;
+            bool openOperation(Operation& operation, FileRead& read) noexcept;
+            void closeOperation(Operation& operation) noexcept;
+            bool readBlocking(Operation& operation) noexcept;
+            bool submitOperation(Operation& operation, size_t slot) noexcept;
+            size_t waitCompletions(std::vector<Operation>& operations) noexcept;
+
+        private:
+            Ring*       m_ring;             // io_uring rings on linux
+            void*       m_completionPort;   // win32 i/o completion port
+            uint32_t    m_queueDepth;
+            bool        m_isOverlapped;
+            bool        m_isInitialized;
+    };
+}   // namespace keplar
@@ -0,0 +1,323 @@
+// ────────────────────────────────────────────
+//  File: async_task.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+// coroutine tasks are only built with KEPLAR_COROUTINES (c++20); the c++17 build keeps the plain task api
+#ifdef KEPLAR_COROUTINES
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "KEPLAR_COROUTINES needs a c++20 compiler with coroutine support"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+#include "inplace_function.hpp"
+
+namespace keplar
+{
+    template<typename T = void>
+    class AsyncTask;
+
+    namespace detail
+    {
+        // shared by every task promise: lazy start, and on completion the awaiting coroutine resumes in its place
+        struct AsyncPromiseBase
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+                void await_resume() const noexcept {}
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+                {
+                    // the owner may destroy the frame as soon as the task reads done, so nothing is touched after
+                    AsyncPromiseBase& promise = handle.promise();
+                    const std::coroutine_handle<> continuation = promise.mContinuation;
+                    promise.mIsDone.store(true, std::memory_order_release);
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() const noexcept { std::terminate(); }
+
+            std::coroutine_handle<>     mContinuation;
+            std::atomic<bool>           mIsDone{ false };
+        };
+
+        template<typename T>
+        struct AsyncPromise : AsyncPromiseBase
+        {
+            AsyncTask<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& value) { mValue.emplace(std::forward<U>(value)); }
+
+            std::optional<T> mValue;
+        };
+
+        template<>
+        struct AsyncPromise<void> : AsyncPromiseBase
+        {
+            AsyncTask<void> get_return_object() noexcept;
+            void return_void() const noexcept {}
+        };
+    }   // namespace detail
+
+    // lazily started coroutine producing a T. co_await it from another task, which resumes where it left off once
+    // this one returns, or start() it from plain code and poll isDone(). the task owns its frame: destroy it only
+    // once it is done or suspended on a point that will not resume it anymore (see AsyncQueue::clear)
+    template<typename T>
+    class AsyncTask
+    {
+        public:
+            using promise_type = detail::AsyncPromise<T>;
+            using Handle = std::coroutine_handle<promise_type>;
+
+            // creation and destruction
+            AsyncTask() noexcept = default;
+            explicit AsyncTask(Handle handle) noexcept : m_handle(handle) {}
+            ~AsyncTask() { reset(); }
+
+            // disable copy semantics to enforce unique ownership
+            AsyncTask(const AsyncTask&) = delete;
+            AsyncTask& operator=(const AsyncTask&) = delete;
+
+            // move semantics
+            AsyncTask(AsyncTask&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+            AsyncTask& operator=(AsyncTask&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    m_handle = std::exchange(other.m_handle, {});
+                }
+                return *this;
+            }
+
+            // usage: runs the task on the calling thread until its first suspension
+            void start() { m_handle.resume(); }
+            void reset() noexcept
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                    m_handle = {};
+                }
+            }
+
+            // accessors
+            bool isValid() const noexcept   { return static_cast<bool>(m_handle); }
+            bool isDone() const noexcept    { return !m_handle || m_handle.promise().mIsDone.load(std::memory_order_acquire); }
+
+            template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+            U& getResult() noexcept         { return *m_handle.promise().mValue; }
+
+            // awaiting: the awaiting coroutine hands its thread to the task (symmetric transfer) and resumes when it returns
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                m_handle.promise().mContinuation = awaiting;
+                return m_handle;
+            }
+
+            T await_resume()
+            {
+                if constexpr (!std::is_void_v<T>)
+                {
+                    return std::move(*m_handle.promise().mValue);
+                }
+            }
+
+        private:
+            Handle m_handle;
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        AsyncTask<T> AsyncPromise<T>::get_return_object() noexcept
+        {
+            return AsyncTask<T>(AsyncTask<T>::Handle::from_promise(*this));
+        }
+
+        inline AsyncTask<void> AsyncPromise<void>::get_return_object() noexcept
+        {
+            return AsyncTask<void>(AsyncTask<void>::Handle::from_promise(*this));
+        }
+    }   // namespace detail
+
+    // co_await resumeOn(pool): the coroutine continues as a task of the pool. that task's handle is stored into
+    // taskHandle when given; it completes once the coroutine suspends again or returns
+    class ThreadPoolAwaiter
+    {
+        public:
+            ThreadPoolAwaiter(ThreadPool& pool, TaskPriority priority, TaskHandle* taskHandle) noexcept
+                : m_pool(pool), m_priority(priority), m_taskHandle(taskHandle) {}
+
+            bool await_ready() const noexcept { return false; }
+            void await_resume() const noexcept {}
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                // the awaiter lives in the frame, which may already run elsewhere once dispatched
+                TaskHandle* taskHandle = m_taskHandle;
+                TaskHandle task = m_pool.dispatch(m_priority, [handle]() { handle.resume(); });
+                if (taskHandle)
+                {
+                    *taskHandle = std::move(task);
+                }
+            }
+
+        private:
+            ThreadPool&     m_pool;
+            TaskPriority    m_priority;
+            TaskHandle*     m_taskHandle;
+    };
+
+    inline ThreadPoolAwaiter resumeOn(ThreadPool& pool, TaskPriority priority = TaskPriority::kNormal, TaskHandle* taskHandle = nullptr) noexcept
+    {
+        return ThreadPoolAwaiter(pool, priority, taskHandle);
+    }
+
+    // coroutines parked for one thread, typically the one recording uploads: co_await schedule() continues on that
+    // thread at its next poll(), co_await until(condition) once condition holds there (a staging belt ticket or another
+    // gpu timeline point). conditions are evaluated on the polling thread only and must not block
+    class AsyncQueue final
+    {
+        public:
+            using Condition = InplaceFunction<bool(), 32>;
+
+            class Awaiter
+            {
+                public:
+                    Awaiter(AsyncQueue& queue, Condition&& condition) noexcept
+                        : m_queue(queue), m_condition(std::move(condition)) {}
+
+                    bool await_ready() const noexcept { return false; }
+                    void await_resume() const noexcept {}
+                    void await_suspend(std::coroutine_handle<> handle) { m_queue.push(handle, std::move(m_condition)); }
+
+                private:
+                    AsyncQueue&     m_queue;
+                    Condition       m_condition;
+            };
+
+            // creation and destruction
+            AsyncQueue() = default;
+            ~AsyncQueue() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            AsyncQueue(const AsyncQueue&) = delete;
+            AsyncQueue& operator=(const AsyncQueue&) = delete;
+            AsyncQueue(AsyncQueue&&) = delete;
+            AsyncQueue& operator=(AsyncQueue&&) = delete;
+
+            // awaiting, from any thread
+            Awaiter schedule() noexcept                     { return Awaiter(*this, Condition{}); }
+            Awaiter until(Condition&& condition) noexcept   { return Awaiter(*this, std::move(condition)); }
+
+            // usage: from the owning thread, resumes every parked coroutine that may continue and returns how many did.
+            // coroutines parking again while resumed wait for the next poll
+            size_t poll()
+            {
+                std::vector<Entry> entries;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    entries.swap(m_entries);
+                }
+
+                size_t resumed = 0;
+                std::vector<Entry> waiting;
+                for (Entry& entry : entries)
+                {
+                    if (entry.mCondition && !entry.mCondition())
+                    {
+                        waiting.emplace_back(std::move(entry));
+                        continue;
+                    }
+
+                    entry.mHandle.resume();
+                    ++resumed;
+                }
+
+                // still waiting: back in front of anything parked meanwhile, in their original order
+                if (!waiting.empty())
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (Entry& entry : m_entries)
+                    {
+                        waiting.emplace_back(std::move(entry));
+                    }
+                    m_entries.swap(waiting);
+                }
+                return resumed;
+            }
+
+            // drops every parked coroutine without resuming it; their owners then destroy them
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.clear();
+            }
+
+            bool isEmpty() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_entries.empty();
+            }
+
+        private:
+            struct Entry
+            {
+                std::coroutine_handle<>     mHandle;
+                Condition                   mCondition;     // empty: resume at the next poll
+            };
+
+            void push(std::coroutine_handle<> handle, Condition&& condition)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.push_back(Entry{ handle, std::move(condition) });
+            }
+
+        private:
+            mutable std::mutex      m_mutex;
+            std::vector<Entry>      m_entries;
+    };
+
+    // reads a whole file as a background task of pool and returns there; empty when the file cannot be read
+    inline AsyncTask<std::vector<uint8_t>> readFileAsync(ThreadPool& pool, std::filesystem::path filepath)
+    {
+        co_await resumeOn(pool, TaskPriority::kBackground);
+
+        std::vector<uint8_t> data;
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (file.is_open())
+        {
+            const std::streamsize size = file.tellg();
+            data.resize(static_cast<size_t>(std::max<std::streamsize>(0, size)));
+            file.seekg(0, std::ios::beg);
+            if (!file.read(reinterpret_cast<char*>(data.data()), size))
+            {
+                data.clear();
+            }
+        }
+        co_return data;
+    }
+}   // namespace keplar
+
+#endif  // KEPLAR_COROUTINES
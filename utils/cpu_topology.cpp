@@ -0,0 +1,332 @@
+// ────────────────────────────────────────────
+//  File: cpu_topology.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "cpu_topology.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <thread>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fstream>
+    #include <map>
+    #include <string>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "logger.hpp"
+#include "profiler.hpp"
+
+namespace 
+{
+#ifndef _WIN32
+    // linux nice values of the thread priorities
+    constexpr int kLowNice  = 5;
+    constexpr int kHighNice = -5;
+
+    bool readLine(const std::string& path, std::string& line) noexcept
+    {
+        std::ifstream file(path);
+        return file && std::getline(file, line) && !line.empty();
+    }
+
+    bool readUint(const std::string& path, uint32_t& value) noexcept
+    {
+        std::string line;
+        if (!readLine(path, line))
+        {
+            return false;
+        }
+        value = static_cast<uint32_t>(std::strtoul(line.c_str(), nullptr, 10));
+        return true;
+    }
+
+    // sysfs cpu lists: "0-3,8,10-11"
+    std::vector<uint32_t> parseCpuList(const std::string& list) noexcept
+    {
+        std::vector<uint32_t> cpus;
+        const char* p = list.c_str();
+        while (*p)
+        {
+            char* end = nullptr;
+            const unsigned long first = std::strtoul(p, &end, 10);
+            if (end == p)
+            {
+                break;
+            }
+
+            unsigned long last = first;
+            p = end;
+            if (*p == '-')
+            {
+                last = std::strtoul(p + 1, &end, 10);
+                p = end;
+            }
+            for (unsigned long cpu = first; cpu <= last && cpu < keplar::kMaxLogicalProcessors; ++cpu)
+            {
+                cpus.push_back(static_cast<uint32_t>(cpu));
+            }
+            if (*p == ',')
+            {
+                ++p;
+            }
+        }
+        return cpus;
+    }
+#endif
+}
+
+namespace keplar
+{
+    const CpuTopology& CpuTopology::getInstance() noexcept
+    {
+        static CpuTopology topology;
+        return topology;
+    }
+
+    CpuTopology::CpuTopology() noexcept
+        : m_coreCount(0)
+    {
+        if (!detect() || m_processors.empty())
+        {
+            // one performance core per logical processor
+            m_processors.clear();
+            const uint32_t count = std::clamp(std::thread::hardware_concurrency(), 1u, kMaxLogicalProcessors);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                m_processors.push_back({ i, i, CoreType::kPerformance, true });
+            }
+            m_coreCount = count;
+            VK_LOG_WARN("CpuTopology : topology unavailable, assuming %u performance cores", count);
+            return;
+        }
+
+        VK_LOG_INFO("CpuTopology : %u logical processors, %u cores (%u performance, %u efficiency)", getLogicalCount(), m_coreCount,
+                    getCoreCount(CoreType::kPerformance), getCoreCount(CoreType::kEfficiency));
+    }
+
+    bool CpuTopology::detect() noexcept
+    {
+    #ifdef _WIN32
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || length == 0)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> buffer(length);
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+        if (!GetLogicalProcessorInformationEx(RelationProcessorCore, info, &length))
+        {
+            return false;
+        }
+
+        // efficiency classes rank cores by performance (higher is faster); one class on non-hybrid parts
+        BYTE maxEfficiencyClass = 0;
+        for (DWORD offset = 0; offset < length; offset += info->Size)
+        {
+            info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+            maxEfficiencyClass = std::max(maxEfficiencyClass, info->Processor.EfficiencyClass);
+        }
+
+        for (DWORD offset = 0; offset < length; offset += info->Size)
+        {
+            info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+            const PROCESSOR_RELATIONSHIP& core = info->Processor;
+            const CoreType type = core.EfficiencyClass < maxEfficiencyClass ? CoreType::kEfficiency : CoreType::kPerformance;
+
+            bool isPrimaryThread = true;
+            for (WORD group = 0; group < core.GroupCount; ++group)
+            {
+                const GROUP_AFFINITY& affinity = core.GroupMask[group];
+                for (uint32_t bit = 0; bit < 64; ++bit)
+                {
+                    const uint32_t index = affinity.Group * 64 + bit;
+                    if ((affinity.Mask & (KAFFINITY(1) << bit)) == 0 || index >= kMaxLogicalProcessors)
+                    {
+                        continue;
+                    }
+                    m_processors.push_back({ index, m_coreCount, type, isPrimaryThread });
+                    isPrimaryThread = false;
+                }
+            }
+            ++m_coreCount;
+        }
+    #else
+        std::string onlineCpus;
+        if (!readLine("/sys/devices/system/cpu/online", onlineCpus))
+        {
+            return false;
+        }
+
+        // intel hybrid parts list their e-cores under the cpu_atom pmu; big.LITTLE ranks cores by cpu_capacity
+        std::string line;
+        std::vector<uint32_t> atomCpus;
+        if (readLine("/sys/devices/cpu_atom/cpus", line))
+        {
+            atomCpus = parseCpuList(line);
+        }
+
+        std::map<uint64_t, uint32_t> cores;
+        std::vector<uint32_t> capacities;
+        uint32_t maxCapacity = 0;
+        for (const uint32_t cpu : parseCpuList(onlineCpus))
+        {
+            const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/";
+            uint32_t coreId = cpu;
+            uint32_t packageId = 0;
+            readUint(path + "topology/core_id", coreId);
+            readUint(path + "topology/physical_package_id", packageId);
+
+            // smt siblings share the (package, core) pair; the lowest numbered one is the primary thread
+            const uint64_t coreKey = (static_cast<uint64_t>(packageId) << 32) | coreId;
+            const auto [itr, isNewCore] = cores.emplace(coreKey, static_cast<uint32_t>(cores.size()));
+            std::string siblings;
+            const std::vector<uint32_t> siblingCpus = readLine(path + "topology/thread_siblings_list", siblings) ? parseCpuList(siblings) : std::vector<uint32_t>{};
+            const bool isPrimaryThread = siblingCpus.empty() ? isNewCore : siblingCpus.front() == cpu;
+
+            uint32_t capacity = 0;
+            readUint(path + "cpu_capacity", capacity);
+            maxCapacity = std::max(maxCapacity, capacity);
+            capacities.push_back(capacity);
+
+            const bool isAtom = std::find(atomCpus.begin(), atomCpus.end(), cpu) != atomCpus.end();
+            m_processors.push_back({ cpu, itr->second, isAtom ? CoreType::kEfficiency : CoreType::kPerformance, isPrimaryThread });
+        }
+
+        if (atomCpus.empty() && maxCapacity > 0)
+        {
+            for (size_t i = 0; i < m_processors.size(); ++i)
+            {
+                m_processors[i].mType = capacities[i] < maxCapacity ? CoreType::kEfficiency : CoreType::kPerformance;
+            }
+        }
+        m_coreCount = static_cast<uint32_t>(cores.size());
+    #endif
+        return true;
+    }
+
+    CpuSet CpuTopology::getProcessors(CoreType type, bool primaryThreadsOnly) const noexcept
+    {
+        CpuSet processors;
+        for (const LogicalProcessor& processor : m_processors)
+        {
+            if (processor.mType == type && (!primaryThreadsOnly || processor.mIsPrimaryThread))
+            {
+                processors.set(processor.mIndex);
+            }
+        }
+        return processors;
+    }
+
+    CpuSet CpuTopology::getAllProcessors() const noexcept
+    {
+        CpuSet processors;
+        for (const LogicalProcessor& processor : m_processors)
+        {
+            processors.set(processor.mIndex);
+        }
+        return processors;
+    }
+
+    uint32_t CpuTopology::getCoreCount(CoreType type) const noexcept
+    {
+        // primary threads stand for their core
+        uint32_t count = 0;
+        for (const LogicalProcessor& processor : m_processors)
+        {
+            count += (processor.mType == type && processor.mIsPrimaryThread) ? 1 : 0;
+        }
+        return count;
+    }
+
+    bool setCurrentThreadAffinity(const CpuSet& processors) noexcept
+    {
+        const CpuSet allowed = processors.any() ? processors : CpuTopology::getInstance().getAllProcessors();
+    #ifdef _WIN32
+        // a thread runs in one processor group: the group of the first allowed processor
+        uint32_t first = 0;
+        while (first < kMaxLogicalProcessors && !allowed.test(first))
+        {
+            ++first;
+        }
+        if (first == kMaxLogicalProcessors)
+        {
+            return false;
+        }
+
+        GROUP_AFFINITY affinity{};
+        affinity.Group = static_cast<WORD>(first / 64);
+        for (uint32_t bit = 0; bit < 64 && affinity.Group * 64 + bit < kMaxLogicalProcessors; ++bit)
+        {
+            if (allowed.test(affinity.Group * 64 + bit))
+            {
+                affinity.Mask |= KAFFINITY(1) << bit;
+            }
+        }
+        return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+    #else
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (uint32_t cpu = 0; cpu < kMaxLogicalProcessors; ++cpu)
+        {
+            if (allowed.test(cpu))
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    #endif
+    }
+
+    bool setCurrentThreadPriority(ThreadPriority priority) noexcept
+    {
+    #ifdef _WIN32
+        int value = THREAD_PRIORITY_NORMAL;
+        if (priority == ThreadPriority::kLow)  value = THREAD_PRIORITY_BELOW_NORMAL;
+        if (priority == ThreadPriority::kHigh) value = THREAD_PRIORITY_ABOVE_NORMAL;
+        return SetThreadPriority(GetCurrentThread(), value) != 0;
+    #else
+        // nice values are per thread on linux
+        int nice = 0;
+        if (priority == ThreadPriority::kLow)  nice = kLowNice;
+        if (priority == ThreadPriority::kHigh) nice = kHighNice;
+        const id_t threadId = static_cast<id_t>(syscall(SYS_gettid));
+        return setpriority(PRIO_PROCESS, threadId, nice) == 0;
+    #endif
+    }
+
+    void setCurrentThreadName(const char* name) noexcept
+    {
+    #ifdef _WIN32
+        wchar_t wideName[64] = {};
+        for (size_t i = 0; i + 1 < std::size(wideName) && name[i]; ++i)
+        {
+            wideName[i] = static_cast<wchar_t>(static_cast<unsigned char>(name[i]));
+        }
+        SetThreadDescription(GetCurrentThread(), wideName);
+    #else
+        char shortName[16] = {};
+        std::snprintf(shortName, sizeof(shortName), "%s", name);
+        pthread_setname_np(pthread_self(), shortName);
+    #endif
+
+        // profiler rings only exist where zones are recorded
+    #ifndef NDEBUG
+        Profiler::getInstance().setThreadName(name);
+    #endif
+    }
+}   // namespace keplar
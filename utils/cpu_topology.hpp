@@ -0,0 +1,79 @@
+// ────────────────────────────────────────────
+//  File: cpu_topology.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace keplar
+{
+    // logical processor indices (linux cpu numbers, win32 group * 64 + processor)
+    constexpr uint32_t kMaxLogicalProcessors = 256;
+    using CpuSet = std::bitset<kMaxLogicalProcessors>;
+
+    enum class CoreType : uint8_t
+    {
+        kPerformance,
+        kEfficiency         // hybrid parts only: intel e-cores, the little cluster of big.LITTLE
+    };
+
+    struct LogicalProcessor
+    {
+        uint32_t    mIndex = 0;
+        uint32_t    mCore = 0;                  // physical core, dense over every package
+        CoreType    mType = CoreType::kPerformance;
+        bool        mIsPrimaryThread = true;    // first smt sibling of its core
+    };
+
+    // processor layout detected once at first use: physical cores, smt siblings and the performance class of each
+    // core (win32 efficiency classes, linux cpu_atom / cpu_capacity). without topology information every logical
+    // processor counts as its own performance core
+    class CpuTopology final
+    {
+        public:
+            static const CpuTopology& getInstance() noexcept;
+
+            // disable copy and move semantics
+            CpuTopology(const CpuTopology&) = delete;
+            CpuTopology& operator=(const CpuTopology&) = delete;
+            CpuTopology(CpuTopology&&) = delete;
+            CpuTopology& operator=(CpuTopology&&) = delete;
+
+            // processors of one core type (empty on non-hybrid parts for kEfficiency), optionally one per core
+            CpuSet getProcessors(CoreType type, bool primaryThreadsOnly = false) const noexcept;
+            CpuSet getAllProcessors() const noexcept;
+
+            // accessors
+            const std::vector<LogicalProcessor>& getLogicalProcessors() const noexcept { return m_processors; }
+            uint32_t getLogicalCount() const noexcept   { return static_cast<uint32_t>(m_processors.size()); }
+            uint32_t getCoreCount() const noexcept      { return m_coreCount; }
+            uint32_t getCoreCount(CoreType type) const noexcept;
+            bool isHybrid() const noexcept              { return getCoreCount(CoreType::kEfficiency) > 0; }
+
+        private:
+            CpuTopology() noexcept;
+            bool detect() noexcept;
+
+        private:
+            std::vector<LogicalProcessor>   m_processors;
+            uint32_t                        m_coreCount;
+    };
+
+    // os scheduling priority of a thread, relative to the process
+    enum class ThreadPriority : uint8_t
+    {
+        kLow,
+        kNormal,
+        kHigh               // linux: needs CAP_SYS_NICE (or a raised RLIMIT_NICE), fails quietly otherwise
+    };
+
+    // usage: from the thread being configured. false when the os refuses; an empty set allows every processor
+    bool setCurrentThreadAffinity(const CpuSet& processors) noexcept;
+    bool setCurrentThreadPriority(ThreadPriority priority) noexcept;
+
+    // os thread name (debuggers, perf, the windows thread list) and the cpu profiler's trace; linux keeps 15 characters
+    void setCurrentThreadName(const char* name) noexcept;
+}   // namespace keplar
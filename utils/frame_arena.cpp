@@ -0,0 +1,107 @@
+// ────────────────────────────────────────────
+//  File: frame_arena.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "frame_arena.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <algorithm>
+#include <new>
+
+namespace keplar
+{
+    FrameArena::FrameArena() noexcept
+        : m_capacity(0)
+        , m_offset(0)
+        , m_peakUsage(0)
+        , m_failedCount(0)
+    {
+    }
+
+    bool FrameArena::initialize(size_t capacity) noexcept
+    {
+        m_memory.reset(new (std::nothrow) uint8_t[capacity]);
+        m_capacity = m_memory ? capacity : 0;
+        m_offset = 0;
+        m_peakUsage = 0;
+        m_failedCount = 0;
+        return m_memory != nullptr;
+    }
+
+    void FrameArena::reset() noexcept
+    {
+        m_offset = 0;
+    }
+
+    void* FrameArena::allocate(size_t size, size_t alignment) noexcept
+    {
+        // alignment is a power of two; offsets are aligned relative to the block, which new[] aligns to max_align_t
+        const size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+        if (!m_memory || offset + size > m_capacity)
+        {
+            ++m_failedCount;
+            return nullptr;
+        }
+
+        m_offset = offset + size;
+        m_peakUsage = std::max(m_peakUsage, m_offset);
+        return m_memory.get() + offset;
+    }
+
+    void FrameArena::deallocate(void* memory, size_t size) noexcept
+    {
+        // only the top of the arena can be handed back
+        uint8_t* bytes = static_cast<uint8_t*>(memory);
+        if (owns(memory) && bytes + size == m_memory.get() + m_offset)
+        {
+            m_offset = static_cast<size_t>(bytes - m_memory.get());
+        }
+    }
+
+    bool FrameArena::owns(const void* memory) const noexcept
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(memory);
+        return m_memory && bytes >= m_memory.get() && bytes < m_memory.get() + m_capacity;
+    }
+
+    FrameArena& FrameArena::getThreadArena() noexcept
+    {
+        // a failed allocation leaves an empty arena, whose allocations then fall back to the heap
+        thread_local FrameArena arena;
+        thread_local const bool isInitialized = arena.initialize(kThreadArenaSize);
+        (void)isInitialized;
+        return arena;
+    }
+
+    const char* FrameArena::format(const char* fmt, ...) noexcept
+    {
+        // format straight into the free tail, then keep only what was written
+        const size_t available = m_capacity - m_offset;
+        if (!m_memory || available == 0)
+        {
+            ++m_failedCount;
+            return "";
+        }
+
+        char* text = reinterpret_cast<char*>(m_memory.get() + m_offset);
+        va_list args;
+        va_start(args, fmt);
+        const int length = std::vsnprintf(text, available, fmt, args);
+        va_end(args);
+        if (length < 0)
+        {
+            return "";
+        }
+
+        const size_t written = std::min(static_cast<size_t>(length) + 1, available);
+        if (written < static_cast<size_t>(length) + 1)
+        {
+            ++m_failedCount;
+        }
+
+        m_offset += written;
+        m_peakUsage = std::max(m_peakUsage, m_offset);
+        return text;
+    }
+}   // namespace keplar
@@ -0,0 +1,128 @@
+// ────────────────────────────────────────────
+//  File: frame_arena.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace keplar
+{
+    // linear scratch memory for data that lives one frame (ui labels and values): one allocation up front, bump
+    // allocations after it and a reset per frame. running out fails the allocation rather than growing, so a frame
+    // never touches the heap; the peak usage tells how much capacity the frames actually need
+    class FrameArena
+    {
+        public:
+            static constexpr size_t kThreadArenaSize = 256 * 1024;
+
+            // rewinds the arena to where it stood at construction: scratch of a scope on any thread, without waiting
+            // for the frame boundary
+            class Scope
+            {
+                public:
+                    explicit Scope(FrameArena& arena) noexcept : m_arena(arena), m_offset(arena.m_offset) {}
+                    ~Scope()                                    { m_arena.m_offset = m_offset; }
+
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+
+                private:
+                    FrameArena& m_arena;
+                    size_t      m_offset;
+            };
+
+            // creation and destruction
+            FrameArena() noexcept;
+            ~FrameArena() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            FrameArena(const FrameArena&) = delete;
+            FrameArena& operator=(const FrameArena&) = delete;
+            FrameArena(FrameArena&&) = delete;
+            FrameArena& operator=(FrameArena&&) = delete;
+
+            // usage
+            bool initialize(size_t capacity) noexcept;
+            void reset() noexcept;
+
+            // nullptr once the frame's capacity is used up. deallocate only gives back the latest allocation, so a
+            // growing container reuses its own space; anything else is reclaimed by the reset
+            void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+            void deallocate(void* memory, size_t size) noexcept;
+            bool owns(const void* memory) const noexcept;
+
+            // printf into the arena; out of space yields the truncated text, or "" when nothing fits
+            const char* format(const char* fmt, ...) noexcept;
+
+            // accessors
+            size_t getCapacity() const noexcept     { return m_capacity; }
+            size_t getUsage() const noexcept        { return m_offset; }
+            size_t getPeakUsage() const noexcept    { return m_peakUsage; }
+            uint32_t getFailedCount() const noexcept { return m_failedCount; }
+
+            // the calling thread's arena of kThreadArenaSize, allocated on first use. the thread that runs a frame
+            // resets it at the frame boundary; other threads keep their use inside a Scope
+            static FrameArena& getThreadArena() noexcept;
+
+        private:
+            std::unique_ptr<uint8_t[]>  m_memory;
+            size_t                      m_capacity;
+            size_t                      m_offset;
+            size_t                      m_peakUsage;
+            uint32_t                    m_failedCount;      // allocations that did not fit, over every frame
+    };
+
+    // std allocator over a frame arena for transient containers; requests the arena cannot hold fall back to the
+    // heap (counted as failed by the arena), so a container never fails where a std::vector would not. memory must
+    // not outlive the arena's next reset or the enclosing Scope
+    template <typename T>
+    class ArenaAllocator
+    {
+        public:
+            using value_type = T;
+
+            ArenaAllocator() noexcept : m_arena(&FrameArena::getThreadArena()) {}
+            explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+            template <typename U>
+            ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.getArena()) {}
+
+            T* allocate(size_t count)
+            {
+                static_assert(alignof(T) <= alignof(std::max_align_t), "ArenaAllocator: type is over-aligned");
+                if (void* memory = m_arena->allocate(count * sizeof(T), alignof(T)))
+                {
+                    return static_cast<T*>(memory);
+                }
+                return static_cast<T*>(::operator new(count * sizeof(T)));
+            }
+
+            void deallocate(T* memory, size_t count) noexcept
+            {
+                if (m_arena->owns(memory))
+                {
+                    m_arena->deallocate(memory, count * sizeof(T));
+                    return;
+                }
+                ::operator delete(memory);
+            }
+
+            FrameArena* getArena() const noexcept   { return m_arena; }
+
+            template <typename U>
+            bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.getArena(); }
+            template <typename U>
+            bool operator!=(const ArenaAllocator<U>& other) const noexcept { return m_arena != other.getArena(); }
+
+        private:
+            FrameArena* m_arena;
+    };
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}   // namespace keplar
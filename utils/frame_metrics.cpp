@@ -0,0 +1,263 @@
+// ────────────────────────────────────────────
+//  File: frame_metrics.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "frame_metrics.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+
+#include "utils/logger.hpp"
+
+namespace 
+{
+    // hitches are not judged before the window holds a meaningful average
+    constexpr uint32_t kMinHitchSamples = 30;
+
+    // nearest-rank percentile of sorted samples
+    float percentile(const float* sorted, uint32_t count, float fraction) noexcept
+    {
+        const auto rank = static_cast<uint32_t>(std::ceil(fraction * static_cast<float>(count)));
+        return sorted[std::clamp(rank, 1u, count) - 1];
+    }
+
+    // summary of sorted samples; hitches are counted against their own average
+    keplar::FrameMetricStats summarize(const float* sorted, uint32_t count, double sum, float hitchFactor) noexcept
+    {
+        keplar::FrameMetricStats stats{};
+        stats.mSampleCount = count;
+        if (count == 0)
+        {
+            return stats;
+        }
+
+        const float average = static_cast<float>(sum / count);
+        stats.mAverage = average;
+        stats.mMax     = sorted[count - 1];
+        stats.mP50     = percentile(sorted, count, 0.50f);
+        stats.mP95     = percentile(sorted, count, 0.95f);
+        stats.mP99     = percentile(sorted, count, 0.99f);
+
+        // samples above the hitch threshold (sorted: count from the top)
+        const float* end = sorted + count;
+        stats.mHitchCount = (count < kMinHitchSamples) ? 0 : 
+                            static_cast<uint32_t>(end - std::upper_bound(sorted, end, hitchFactor * average));
+        return stats;
+    }
+
+    // json string with quotes and backslashes escaped (device names, paths)
+    std::string escapeJson(const std::string& value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char c : value)
+        {
+            if (c == '"' || c == '\\') { escaped.push_back('\\'); }
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
+}
+
+namespace keplar
+{
+    FrameMetrics::FrameMetrics() noexcept
+        : m_histories{}
+        , m_stats{}
+        , m_scratch{}
+        , m_totalHitchCount(0)
+        , m_lastFrameStart{}
+        , m_hasFrameStart(false)
+        , m_captures{}
+        , m_isCapturing(false)
+    {
+    }
+
+    void FrameMetrics::beginFrame() noexcept
+    {
+        // frame time is measured here rather than taken from the clamped simulation dt
+        const auto now = clock::now();
+        if (m_hasFrameStart)
+        {
+            record(FrameMetric::kFrameTime, std::chrono::duration<float, std::milli>(now - m_lastFrameStart).count());
+        }
+
+        m_lastFrameStart = now;
+        m_hasFrameStart = true;
+    }
+
+    void FrameMetrics::record(FrameMetric metric, float milliseconds) noexcept
+    {
+        if (metric >= FrameMetric::kCount)
+        {
+            return;
+        }
+
+        History& history = m_histories[index(metric)];
+
+        // count frame time hitches against the window before this sample
+        if (metric == FrameMetric::kFrameTime && history.mCount >= kMinHitchSamples)
+        {
+            const double average = history.mSum / history.mCount;
+            if (milliseconds > kHitchFactor * average)
+            {
+                ++m_totalHitchCount;
+            }
+        }
+
+        // overwrite the oldest sample once the window is full
+        if (history.mCount == kHistorySize)
+        {
+            history.mSum -= history.mSamples[history.mHead];
+        }
+        else
+        {
+            ++history.mCount;
+        }
+
+        // capture storage never grows past the reserved run length
+        std::vector<float>& capture = m_captures[index(metric)];
+        if (m_isCapturing && capture.size() < capture.capacity())
+        {
+            capture.push_back(milliseconds);
+        }
+
+        history.mSamples[history.mHead] = milliseconds;
+        history.mSum += milliseconds;
+        history.mHead = (history.mHead + 1) % kHistorySize;
+        m_stats[index(metric)].mLatest = milliseconds;
+    }
+
+    void FrameMetrics::reset() noexcept
+    {
+        m_histories = {};
+        m_stats = {};
+        m_totalHitchCount = 0;
+        m_hasFrameStart = false;
+    }
+
+    void FrameMetrics::update() noexcept
+    {
+        for (uint32_t metric = 0; metric < kMetricCount; ++metric)
+        {
+            const History& history = m_histories[metric];
+
+            // the ring is unordered: percentiles come from a sorted copy of the window
+            std::copy_n(history.mSamples.begin(), history.mCount, m_scratch.begin());
+            std::sort(m_scratch.begin(), m_scratch.begin() + history.mCount);
+
+            const float latest = m_stats[metric].mLatest;
+            m_stats[metric] = summarize(m_scratch.data(), history.mCount, history.mSum, kHitchFactor);
+            m_stats[metric].mLatest = latest;
+        }
+    }
+
+    void FrameMetrics::beginCapture(uint32_t frameCount) noexcept
+    {
+        // the only allocation of a capture happens here
+        for (auto& capture : m_captures)
+        {
+            capture.clear();
+            capture.reserve(frameCount);
+        }
+
+        m_isCapturing = true;
+    }
+
+    FrameMetricStats FrameMetrics::getCaptureStats(FrameMetric metric) const noexcept
+    {
+        if (metric >= FrameMetric::kCount)
+        {
+            return FrameMetricStats{};
+        }
+
+        std::vector<float> sorted = m_captures[index(metric)];
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (const float sample : sorted)
+        {
+            sum += sample;
+        }
+
+        FrameMetricStats stats = summarize(sorted.data(), static_cast<uint32_t>(sorted.size()), sum, kHitchFactor);
+        stats.mLatest = sorted.empty() ? 0.0f : m_captures[index(metric)].back();
+        return stats;
+    }
+
+    bool FrameMetrics::writeCaptureJson(const std::filesystem::path& filepath, 
+                                        const std::vector<std::pair<std::string, std::string>>& properties) const noexcept
+    {
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            VK_LOG_ERROR("FrameMetrics::writeCaptureJson : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        // run description first, then one summary object per metric that received samples (milliseconds)
+        file << "{\n";
+        for (const auto& [key, value] : properties)
+        {
+            file << "  \"" << escapeJson(key) << "\": \"" << escapeJson(value) << "\",\n";
+        }
+
+        file << std::fixed << std::setprecision(4);
+        file << "  \"hitch_factor\": " << kHitchFactor << ",\n";
+        file << "  \"metrics\": {";
+
+        bool isFirst = true;
+        for (uint32_t metric = 0; metric < kMetricCount; ++metric)
+        {
+            const FrameMetricStats stats = getCaptureStats(static_cast<FrameMetric>(metric));
+            if (stats.mSampleCount == 0)
+            {
+                continue;
+            }
+
+            file << (isFirst ? "\n" : ",\n");
+            file << "    \"" << getName(static_cast<FrameMetric>(metric)) << "\": { "
+                 << "\"samples\": " << stats.mSampleCount << ", "
+                 << "\"avg_ms\": " << stats.mAverage << ", "
+                 << "\"p50_ms\": " << stats.mP50 << ", "
+                 << "\"p95_ms\": " << stats.mP95 << ", "
+                 << "\"p99_ms\": " << stats.mP99 << ", "
+                 << "\"max_ms\": " << stats.mMax << ", "
+                 << "\"hitches\": " << stats.mHitchCount << " }";
+            isFirst = false;
+        }
+
+        file << "\n  }\n}\n";
+
+        VK_LOG_INFO("FrameMetrics::writeCaptureJson : %zu frames written to %s", m_captures[index(FrameMetric::kFrameTime)].size(), filepath.string().c_str());
+        return static_cast<bool>(file);
+    }
+
+    const char* FrameMetrics::getName(FrameMetric metric) noexcept
+    {
+        switch (metric)
+        {
+            case FrameMetric::kFrameTime:       return "Frame";
+            case FrameMetric::kCpuTime:         return "CPU";
+            case FrameMetric::kGpuTime:         return "GPU";
+            case FrameMetric::kPresentLatency:  return "Present Latency";
+            default:                            return "Unknown";
+        }
+    }
+
+    uint32_t FrameMetrics::getHistoryOffset(FrameMetric metric) const noexcept
+    {
+        // until the ring wraps, samples are stored oldest first from slot 0
+        const History& history = m_histories[index(metric)];
+        return (history.mCount == kHistorySize) ? history.mHead : 0;
+    }
+}   // namespace keplar
@@ -0,0 +1,103 @@
+// ────────────────────────────────────────────
+//  File: frame_metrics.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <filesystem>
+
+namespace keplar
+{
+    // tracked per-frame timings, in milliseconds
+    enum class FrameMetric : uint8_t
+    {
+        kFrameTime,         // frame start to frame start (unclamped, unlike Time::tick)
+        kCpuTime,           // cpu work of the frame, excluding waits on the gpu and the display
+        kGpuTime,           // gpu time of the frame's command buffers
+        kPresentLatency,    // input sampling to present completion
+        kCount
+    };
+
+    // percentiles and hitches over the samples currently in the history window
+    struct FrameMetricStats
+    {
+        float       mLatest      = 0.0f;
+        float       mAverage     = 0.0f;
+        float       mMax         = 0.0f;
+        float       mP50         = 0.0f;
+        float       mP95         = 0.0f;
+        float       mP99         = 0.0f;
+        uint32_t    mHitchCount  = 0;
+        uint32_t    mSampleCount = 0;
+    };
+
+    // fixed-size ring buffer history per metric. record() is O(1) and allocation free; percentiles are
+    // only sorted out in update(), which callers run when the stats are displayed or exported.
+    // a hitch is a sample above kHitchFactor times the rolling average of its window.
+    // a capture additionally keeps every sample of a fixed length run (benchmarks) in preallocated storage
+    class FrameMetrics
+    {
+        public:
+            static constexpr uint32_t kHistorySize = 512;
+            static constexpr float    kHitchFactor = 2.0f;
+
+            // creation and destruction
+            FrameMetrics() noexcept;
+
+            // usage: recording
+            void beginFrame() noexcept;
+            void record(FrameMetric metric, float milliseconds) noexcept;
+            void reset() noexcept;
+
+            // usage: full run capture, summarized over all of its samples rather than the history window
+            void beginCapture(uint32_t frameCount) noexcept;
+            void endCapture() noexcept                                            { m_isCapturing = false; }
+            bool isCapturing() const noexcept                                     { return m_isCapturing; }
+            FrameMetricStats getCaptureStats(FrameMetric metric) const noexcept;
+            bool writeCaptureJson(const std::filesystem::path& filepath, 
+                                  const std::vector<std::pair<std::string, std::string>>& properties) const noexcept;
+
+            // usage: statistics
+            void update() noexcept;
+            const FrameMetricStats& getStats(FrameMetric metric) const noexcept  { return m_stats[index(metric)]; }
+            uint64_t getTotalHitchCount() const noexcept                          { return m_totalHitchCount; }
+            static const char* getName(FrameMetric metric) noexcept;
+
+            // accessors: ring buffer layout for plotting (oldest sample at getHistoryOffset)
+            const float* getHistory(FrameMetric metric) const noexcept            { return m_histories[index(metric)].mSamples.data(); }
+            uint32_t getHistoryCount(FrameMetric metric) const noexcept           { return m_histories[index(metric)].mCount; }
+            uint32_t getHistoryOffset(FrameMetric metric) const noexcept;
+
+        private:
+            using clock      = std::chrono::steady_clock;
+            using time_point = clock::time_point;
+
+            static constexpr uint32_t kMetricCount = static_cast<uint32_t>(FrameMetric::kCount);
+            static constexpr uint32_t index(FrameMetric metric) noexcept { return static_cast<uint32_t>(metric); }
+
+            struct History
+            {
+                std::array<float, kHistorySize> mSamples{};
+                uint32_t                        mHead  = 0;     // next slot to write
+                uint32_t                        mCount = 0;
+                double                          mSum   = 0.0;   // running sum of the window
+            };
+
+            std::array<History, kMetricCount>           m_histories;
+            std::array<FrameMetricStats, kMetricCount>  m_stats;
+            std::array<float, kHistorySize>             m_scratch;          // sorted copy for percentiles
+            uint64_t                                    m_totalHitchCount;  // frame time hitches since reset
+            time_point                                  m_lastFrameStart;
+            bool                                        m_hasFrameStart;
+
+            // capture storage, reserved up front so recording never allocates
+            std::array<std::vector<float>, kMetricCount> m_captures;
+            bool                                         m_isCapturing;
+    };
+}   // namespace keplar
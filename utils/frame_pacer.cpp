@@ -3,15 +3,34 @@
 // ────────────────────────────────────────────
 
 #include "frame_pacer.hpp"
+#include <algorithm>
 #include <thread>
 
+#ifdef _WIN32
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+    #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+    #endif
+#else
+    #include <cerrno>
+    #include <time.h>
+#endif
+
 namespace 
 {
     constexpr float kMinFPS         = 1.0f;
     constexpr float kMaxFPS         = 1000.0f;
 
-    constexpr auto kSpinThreshold   = std::chrono::microseconds(1000);
-    constexpr auto kSleepPad        = std::chrono::microseconds(500);
+    // timer wakes land this late on average; the estimate starts conservative and adapts from measured overshoot,
+    // rising quickly on a late wake and decaying slowly so a single early wake does not cost the next frame its deadline
+    constexpr auto  kInitialOvershoot   = std::chrono::microseconds(500);
+    constexpr auto  kMaxOvershoot       = std::chrono::microseconds(2000);
+    constexpr auto  kOvershootMargin    = std::chrono::microseconds(50);
+    constexpr float kOvershootRise      = 0.5f;
+    constexpr float kOvershootDecay     = 0.05f;
 }
 
 namespace keplar
@@ -21,9 +40,32 @@ namespace keplar
         , m_frameCount(0)
         , m_enabled(false)
         , m_hasSchedule(false)
+        , m_isVariableRefresh(false)
         , m_frameStep{}
         , m_nextTick{}
+        , m_sleepOvershoot(std::chrono::duration_cast<duration>(kInitialOvershoot))
+        , m_timerHandle(nullptr)
+    {
+    #ifdef _WIN32
+        // high resolution timers need windows 10 1803; older systems fall back to a regular waitable timer
+        HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (!timer)
+        {
+            timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+        m_timerHandle = timer;
+    #endif
+    }
+
+    FramePacer::~FramePacer()
     {
+        if (m_timerHandle)
+        {
+        #ifdef _WIN32
+            CloseHandle(static_cast<HANDLE>(m_timerHandle));
+        #endif
+            m_timerHandle = nullptr;
+        }
     }
 
     void FramePacer::setTargetFps(float fps) noexcept
@@ -64,6 +106,13 @@ namespace keplar
             return;
         }
 
+        // variable refresh: a late frame is presented right away and the next one is timed from it
+        if (now >= m_nextTick && m_isVariableRefresh)
+        {
+            m_nextTick = now + m_frameStep;
+            return;
+        }
+
         // catch up if we are behind schedule
         if (now >= m_nextTick)
         {
@@ -72,19 +121,20 @@ namespace keplar
             m_nextTick += missed * m_frameStep;
         }
 
-        auto remaining = m_nextTick - clock::now();
-
-        // coarse sleep first
-        if (remaining > kSpinThreshold)
+        // timer sleep up to the expected overshoot before the tick
+        const auto wakeTime = m_nextTick - m_sleepOvershoot - kOvershootMargin;
+        if (wakeTime > clock::now())
         {
-            const auto coarse = remaining - kSpinThreshold;
-            if (coarse > kSleepPad)
-            {
-                std::this_thread::sleep_for(coarse - kSleepPad);
-            }
+            sleepUntil(wakeTime);
+
+            // adapt the estimate to how late the timer actually woke
+            const auto overshoot = std::max(clock::now() - wakeTime, duration::zero());
+            const float weight = overshoot > m_sleepOvershoot ? kOvershootRise : kOvershootDecay;
+            const auto delta = std::chrono::duration_cast<duration>((overshoot - m_sleepOvershoot) * weight);
+            m_sleepOvershoot = std::clamp(m_sleepOvershoot + delta, duration::zero(), std::chrono::duration_cast<duration>(kMaxOvershoot));
         }
 
-        // fine wait (spin with yield)
+        // fine wait (spin with yield), bounded by the overshoot estimate
         while (clock::now() < m_nextTick)
         {
             std::this_thread::yield();
@@ -93,4 +143,42 @@ namespace keplar
         // advance schedule for next frame
         m_nextTick += m_frameStep;
     }
+
+    float FramePacer::getVariableRefreshCap(float refreshRate) noexcept
+    {
+        // r - r^2 / 3600: the margin grows with the refresh, as the frame time shrinks towards the timer's jitter
+        return std::max(refreshRate - refreshRate * refreshRate / 3600.0f, kMinFPS);
+    }
+
+    void FramePacer::sleepUntil(time_point wakeTime) noexcept
+    {
+    #ifdef _WIN32
+        // waitable timers take a relative due time in negative 100 ns units
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeTime - clock::now());
+        if (remaining.count() <= 0)
+        {
+            return;
+        }
+
+        LARGE_INTEGER dueTime{};
+        dueTime.QuadPart = -static_cast<LONGLONG>(remaining.count() / 100);
+        if (m_timerHandle && SetWaitableTimer(static_cast<HANDLE>(m_timerHandle), &dueTime, 0, nullptr, nullptr, FALSE))
+        {
+            WaitForSingleObject(static_cast<HANDLE>(m_timerHandle), INFINITE);
+            return;
+        }
+        std::this_thread::sleep_for(remaining);
+    #elif defined(__linux__)
+        // steady_clock is CLOCK_MONOTONIC on linux, so its time points convert directly into an absolute deadline
+        const auto deadline = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeTime.time_since_epoch()).count();
+        timespec ts{};
+        ts.tv_sec  = static_cast<time_t>(deadline / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(deadline % 1'000'000'000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {
+        }
+    #else
+        std::this_thread::sleep_until(wakeTime);
+    #endif
+    }
 }   // namespace keplar
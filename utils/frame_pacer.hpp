@@ -8,30 +8,55 @@
 
 namespace keplar
 {
+    // cpu clock frame pacing. each wait sleeps on a platform timer (a high resolution waitable timer on win32, an
+    // absolute clock_nanosleep elsewhere) until shortly before the tick and spins only the rest; how early it wakes
+    // adapts to the overshoot the timer showed on previous waits, so pacing stays sub-millisecond at little cpu cost.
+    // on a fixed refresh display ticks stay on one grid and a late frame waits for the next one, keeping the cadence
+    // even; with variable refresh the display follows the frames instead, so a late frame goes out at once and the
+    // schedule restarts from it (the target rate is then a cap, see getVariableRefreshCap)
     class FramePacer
     {
         public: 
             // creation and destruction
             FramePacer() noexcept;
+            ~FramePacer();
+
+            // disable copy and move semantics to enforce unique ownership (of the platform timer)
+            FramePacer(const FramePacer&) = delete;
+            FramePacer& operator=(const FramePacer&) = delete;
+            FramePacer(FramePacer&&) = delete;
+            FramePacer& operator=(FramePacer&&) = delete;
 
             // usage 
             void wait() noexcept;
             void setTargetFps(float fps) noexcept;
+            void setVariableRefresh(bool enabled) noexcept  { m_isVariableRefresh = enabled; }
+            void resetSchedule() noexcept                   { m_hasSchedule = false; }
+
+            // a cap a few percent below the maximum refresh (138 of 144 hz, 224 of 240), so frames stay inside the
+            // variable range instead of queueing behind the fastest refresh the display has
+            static float getVariableRefreshCap(float refreshRate) noexcept;
 
             // accessors
-            float    getFrameRate() const noexcept  { return m_targetFps; }
-            uint64_t getFrameCount() const noexcept { return m_frameCount; }
+            float    getFrameRate() const noexcept          { return m_targetFps; }
+            uint64_t getFrameCount() const noexcept         { return m_frameCount; }
+            bool     isVariableRefresh() const noexcept     { return m_isVariableRefresh; }
 
         private:
             using clock      = std::chrono::steady_clock;
             using time_point = clock::time_point;
             using duration   = clock::duration;
 
+            void sleepUntil(time_point wakeTime) noexcept;
+
             float       m_targetFps;
             uint64_t    m_frameCount;
             bool        m_enabled;
             bool        m_hasSchedule;
+            bool        m_isVariableRefresh;
             duration    m_frameStep;
             time_point  m_nextTick;
+            duration    m_sleepOvershoot;      // expected lateness of a timer wake, woken this much early
+            void*       m_timerHandle;         // win32 waitable timer; unused elsewhere
     };
 }   // namespace keplar
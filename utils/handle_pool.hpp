@@ -0,0 +1,194 @@
+// ────────────────────────────────────────────
+//  File: handle_pool.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace keplar
+{
+    // 32-bit reference into a HandlePool: a slot index and the generation the slot had when the handle was made. a slot
+    // bumps its generation whenever it is freed, so a handle to a removed object fails the pool's check instead of
+    // reaching whatever took the slot over. Tag makes handles of different pools distinct types
+    template <typename Tag>
+    class Handle
+    {
+        public:
+            static constexpr uint32_t kIndexBits      = 20;
+            static constexpr uint32_t kGenerationBits = 32 - kIndexBits;
+            static constexpr uint32_t kMaxIndex       = (1u << kIndexBits) - 1;
+            static constexpr uint32_t kGenerationMask = (1u << kGenerationBits) - 1;
+
+            // the null handle: generation 0 is never handed out
+            constexpr Handle() noexcept : m_value(0) {}
+            constexpr Handle(uint32_t index, uint32_t generation) noexcept
+                : m_value((generation << kIndexBits) | (index & kMaxIndex))
+            {
+            }
+
+            constexpr uint32_t getIndex() const noexcept        { return m_value & kMaxIndex; }
+            constexpr uint32_t getGeneration() const noexcept   { return m_value >> kIndexBits; }
+            constexpr uint32_t getValue() const noexcept        { return m_value; }
+            constexpr bool isNull() const noexcept              { return m_value == 0; }
+            constexpr explicit operator bool() const noexcept   { return m_value != 0; }
+
+            constexpr bool operator==(Handle other) const noexcept { return m_value == other.m_value; }
+            constexpr bool operator!=(Handle other) const noexcept { return m_value != other.m_value; }
+
+        private:
+            uint32_t m_value;
+    };
+
+    // objects addressed by generational handles. the objects themselves are packed densely in insertion order, so
+    // iterating touches contiguous memory; remove() moves the last object into the hole (one move, no shifting) and
+    // repoints its slot. freed slots are reused from a free list. while nothing was removed, the dense index of an
+    // object equals its handle's index, so code indexing the pool by position (descriptor arrays) keeps working.
+    // not thread-safe
+    template <typename T, typename Tag = T>
+    class HandlePool final
+    {
+        public:
+            using HandleType = Handle<Tag>;
+
+            // creation and destruction
+            HandlePool() noexcept : m_freeHead(kNoSlot) {}
+            ~HandlePool() = default;
+
+            // disable copy semantics, pools of move-only resources are the point
+            HandlePool(const HandlePool&) = delete;
+            HandlePool& operator=(const HandlePool&) = delete;
+
+            // move semantics
+            HandlePool(HandlePool&&) noexcept = default;
+            HandlePool& operator=(HandlePool&&) noexcept = default;
+
+            // usage: null handle once kMaxIndex slots are live
+            template <typename... Args>
+            HandleType emplace(Args&&... args)
+            {
+                uint32_t slotIndex = m_freeHead;
+                if (slotIndex != kNoSlot)
+                {
+                    m_freeHead = m_slots[slotIndex].mDenseIndex;
+                }
+                else
+                {
+                    if (m_slots.size() > HandleType::kMaxIndex)
+                    {
+                        return HandleType{};
+                    }
+                    slotIndex = static_cast<uint32_t>(m_slots.size());
+                    m_slots.push_back({ kNoSlot, 1 });
+                }
+
+                m_slots[slotIndex].mDenseIndex = static_cast<uint32_t>(m_objects.size());
+                m_objects.emplace_back(std::forward<Args>(args)...);
+                m_denseSlots.push_back(slotIndex);
+                return HandleType(slotIndex, m_slots[slotIndex].mGeneration);
+            }
+
+            bool remove(HandleType handle)
+            {
+                if (!isValid(handle))
+                {
+                    return false;
+                }
+
+                // the last object fills the hole
+                Slot& slot = m_slots[handle.getIndex()];
+                const uint32_t denseIndex = slot.mDenseIndex;
+                const uint32_t lastIndex = static_cast<uint32_t>(m_objects.size() - 1);
+                if (denseIndex != lastIndex)
+                {
+                    m_objects[denseIndex] = std::move(m_objects[lastIndex]);
+                    m_denseSlots[denseIndex] = m_denseSlots[lastIndex];
+                    m_slots[m_denseSlots[denseIndex]].mDenseIndex = denseIndex;
+                }
+                m_objects.pop_back();
+                m_denseSlots.pop_back();
+
+                // generation 0 stays reserved for the null handle
+                slot.mGeneration = (slot.mGeneration + 1) & HandleType::kGenerationMask;
+                slot.mGeneration += (slot.mGeneration == 0) ? 1 : 0;
+                slot.mDenseIndex = m_freeHead;
+                m_freeHead = handle.getIndex();
+                return true;
+            }
+
+            void clear() noexcept
+            {
+                // bump every live slot so handles of the cleared objects go stale
+                for (uint32_t slotIndex : m_denseSlots)
+                {
+                    Slot& slot = m_slots[slotIndex];
+                    slot.mGeneration = (slot.mGeneration + 1) & HandleType::kGenerationMask;
+                    slot.mGeneration += (slot.mGeneration == 0) ? 1 : 0;
+                }
+
+                // refill in ascending order, so objects emplaced next again sit at their handle's index
+                m_freeHead = kNoSlot;
+                for (uint32_t slotIndex = static_cast<uint32_t>(m_slots.size()); slotIndex-- > 0;)
+                {
+                    m_slots[slotIndex].mDenseIndex = m_freeHead;
+                    m_freeHead = slotIndex;
+                }
+                m_objects.clear();
+                m_denseSlots.clear();
+            }
+
+            void reserve(size_t capacity)
+            {
+                m_objects.reserve(capacity);
+                m_denseSlots.reserve(capacity);
+                m_slots.reserve(capacity);
+            }
+
+            // usage: lookup, nullptr for null or stale handles
+            bool isValid(HandleType handle) const noexcept
+            {
+                return handle.getIndex() < m_slots.size() && handle.getGeneration() != 0 &&
+                       m_slots[handle.getIndex()].mGeneration == handle.getGeneration();
+            }
+
+            T* get(HandleType handle) noexcept              { return isValid(handle) ? &m_objects[m_slots[handle.getIndex()].mDenseIndex] : nullptr; }
+            const T* get(HandleType handle) const noexcept  { return isValid(handle) ? &m_objects[m_slots[handle.getIndex()].mDenseIndex] : nullptr; }
+
+            // usage: dense access in storage order
+            T& operator[](size_t denseIndex) noexcept               { return m_objects[denseIndex]; }
+            const T& operator[](size_t denseIndex) const noexcept   { return m_objects[denseIndex]; }
+            HandleType getHandle(size_t denseIndex) const noexcept
+            {
+                const uint32_t slotIndex = m_denseSlots[denseIndex];
+                return HandleType(slotIndex, m_slots[slotIndex].mGeneration);
+            }
+
+            auto begin() noexcept           { return m_objects.begin(); }
+            auto end() noexcept             { return m_objects.end(); }
+            auto begin() const noexcept     { return m_objects.begin(); }
+            auto end() const noexcept       { return m_objects.end(); }
+
+            // accessors
+            size_t size() const noexcept    { return m_objects.size(); }
+            bool empty() const noexcept     { return m_objects.empty(); }
+
+        private:
+            static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+            // a live slot points at its object, a free one at the next free slot
+            struct Slot
+            {
+                uint32_t mDenseIndex;
+                uint32_t mGeneration;
+            };
+
+        private:
+            std::vector<T>          m_objects;      // packed live objects
+            std::vector<uint32_t>   m_denseSlots;   // per object: the slot its handle names
+            std::vector<Slot>       m_slots;
+            uint32_t                m_freeHead;
+    };
+}   // namespace keplar
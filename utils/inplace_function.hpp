@@ -0,0 +1,123 @@
+// ────────────────────────────────────────────
+//  File: inplace_function.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace keplar
+{
+    template <typename Signature, size_t Capacity = 32>
+    class InplaceFunction;
+
+    // move-only callable stored inside the object itself: a std::function that never allocates. callables larger than
+    // Capacity (or over-aligned) fail to compile instead of spilling to the heap
+    template <typename Result, typename... Args, size_t Capacity>
+    class InplaceFunction<Result(Args...), Capacity>
+    {
+        public:
+            // creation and destruction
+            InplaceFunction() noexcept : m_ops(nullptr) {}
+
+            template <typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, InplaceFunction>>>
+            InplaceFunction(Callable&& callable) noexcept : m_ops(&kOps<std::decay_t<Callable>>)
+            {
+                using Stored = std::decay_t<Callable>;
+                static_assert(sizeof(Stored) <= Capacity, "InplaceFunction: callable exceeds the inline capacity");
+                static_assert(alignof(Stored) <= alignof(std::max_align_t), "InplaceFunction: callable is over-aligned");
+                static_assert(std::is_nothrow_move_constructible_v<Stored>, "InplaceFunction: callable must be nothrow movable");
+                ::new (static_cast<void*>(&m_storage)) Stored(std::forward<Callable>(callable));
+            }
+
+            InplaceFunction(InplaceFunction&& other) noexcept : m_ops(other.m_ops)
+            {
+                if (m_ops)
+                {
+                    m_ops->mMove(&m_storage, &other.m_storage);
+                    other.reset();
+                }
+            }
+
+            InplaceFunction& operator=(InplaceFunction&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    m_ops = other.m_ops;
+                    if (m_ops)
+                    {
+                        m_ops->mMove(&m_storage, &other.m_storage);
+                        other.reset();
+                    }
+                }
+                return *this;
+            }
+
+            ~InplaceFunction()
+            {
+                reset();
+            }
+
+            // copies would duplicate captured state silently
+            InplaceFunction(const InplaceFunction&) = delete;
+            InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+            // usage
+            Result operator()(Args... args) const
+            {
+                return m_ops->mInvoke(&m_storage, std::forward<Args>(args)...);
+            }
+
+            void reset() noexcept
+            {
+                if (m_ops)
+                {
+                    m_ops->mDestroy(&m_storage);
+                    m_ops = nullptr;
+                }
+            }
+
+            explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+        private:
+            using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+            // type-erased operations of the stored callable, one static table per callable type
+            struct Ops
+            {
+                Result (*mInvoke)(const void*, Args&&...);
+                void   (*mMove)(void*, void*) noexcept;
+                void   (*mDestroy)(void*) noexcept;
+            };
+
+            template <typename Stored>
+            static Result invoke(const void* storage, Args&&... args)
+            {
+                // callables such as mutable lambdas are invoked through a non-const reference, as std::function does
+                return (*const_cast<Stored*>(static_cast<const Stored*>(storage)))(std::forward<Args>(args)...);
+            }
+
+            template <typename Stored>
+            static void move(void* destination, void* source) noexcept
+            {
+                ::new (destination) Stored(std::move(*static_cast<Stored*>(source)));
+            }
+
+            template <typename Stored>
+            static void destroy(void* storage) noexcept
+            {
+                static_cast<Stored*>(storage)->~Stored();
+            }
+
+            template <typename Stored>
+            static constexpr Ops kOps = { &invoke<Stored>, &move<Stored>, &destroy<Stored> };
+
+        private:
+            const Ops*  m_ops;
+            Storage     m_storage;
+    };
+}   // namespace keplar
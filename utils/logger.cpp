@@ -4,11 +4,141 @@
 
 #include "logger.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <sstream>
-#include <vector>
-#include <chrono>
-#include <iomanip>
+#include <string_view>
+
+// zlib compressor of stb_image_write (implemented in graphics/external_libs.cpp)
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+namespace
+{
+    // worker wake-up interval; errors and nearly full rings wake it early
+    constexpr auto kWorkerInterval = std::chrono::milliseconds(10);
+
+    // batched lines reach the file at least this often
+    constexpr auto kFlushInterval = std::chrono::milliseconds(250);
+
+    // stb deflate effort for rotated files
+    constexpr int kCompressionQuality = 8;
+
+    // gives a thread's ring back when the thread exits, after its last published record
+    struct RingLease
+    {
+        std::atomic<bool>* mIsOwned = nullptr;
+
+        ~RingLease()
+        {
+            if (mIsOwned)
+            {
+                mIsOwned->store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    uint32_t crc32(const unsigned char* data, size_t size) noexcept
+    {
+        static const auto kTable = []()
+        {
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+                }
+                table[i] = c;
+            }
+            return table;
+        }();
+
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc = kTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    // writes source as a gzip member: the zlib stream without its header and adler32 wrapped in gzip framing
+    bool compressFile(const std::filesystem::path& source, const std::filesystem::path& target) noexcept
+    {
+        std::ifstream input(source, std::ios::binary);
+        std::vector<unsigned char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        if (!input.good() && !input.eof())
+        {
+            return false;
+        }
+
+        if (data.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+        {
+            return false;
+        }
+
+        int zlibSize = 0;
+        unsigned char* zlib = stbi_zlib_compress(data.data(), static_cast<int>(data.size()), &zlibSize, kCompressionQuality);
+        if (!zlib || zlibSize < 6)
+        {
+            std::free(zlib);
+            return false;
+        }
+
+        const uint32_t crc = crc32(data.data(), data.size());
+        const uint32_t size = static_cast<uint32_t>(data.size());
+        const unsigned char header[10] = { 0x1F, 0x8B, 0x08, 0, 0, 0, 0, 0, 0, 0xFF };
+        const unsigned char trailer[8] = 
+        {
+            static_cast<unsigned char>(crc),  static_cast<unsigned char>(crc >> 8),  static_cast<unsigned char>(crc >> 16),  static_cast<unsigned char>(crc >> 24),
+            static_cast<unsigned char>(size), static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size >> 16), static_cast<unsigned char>(size >> 24)
+        };
+
+        std::ofstream output(target, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(zlib + 2), zlibSize - 6);
+        output.write(reinterpret_cast<const char*>(trailer), sizeof(trailer));
+        std::free(zlib);
+        return output.good();
+    }
+
+    // rounds record sizes up to the ring alignment
+    constexpr uint32_t alignRecord(size_t size) noexcept
+    {
+        return static_cast<uint32_t>((size + 7) & ~size_t{ 7 });
+    }
+
+    // printf spec scratch size: flags, width, precision, length and conversion
+    constexpr size_t kMaxSpecLength = 32;
+
+    // appends snprintf(spec, value) to out
+    template <typename T>
+    void appendFormatted(std::string& out, const char* spec, T value) noexcept
+    {
+        constexpr size_t kGuess = 64;
+        const size_t offset = out.size();
+        out.resize(offset + kGuess);
+
+        int len = std::snprintf(&out[offset], kGuess + 1, spec, value);
+        if (len < 0)
+        {
+            out.resize(offset);
+            return;
+        }
+
+        if (static_cast<size_t>(len) > kGuess)
+        {
+            out.resize(offset + static_cast<size_t>(len));
+            std::snprintf(&out[offset], static_cast<size_t>(len) + 1, spec, value);
+        }
+
+        out.resize(offset + static_cast<size_t>(len));
+    }
+}
 
 namespace keplar
 {
@@ -22,22 +152,28 @@ namespace keplar
 
     Logger::Logger(const std::string& filename) noexcept
         : m_filename(filename)
-        , m_logStream(m_filename, std::ios::out | std::ios::trunc)
-        , m_enabledLevels{ Level::Trace, Level::Debug, Level::Info, Level::Warn, Level::Error, Level::Fatal }
+        , m_levelMask(0)
+        , m_droppedLogs(0)
+        , m_steadyEpoch(clock::now())
+        , m_wallEpoch(std::chrono::system_clock::now())
+        , m_lastSecond(0)
+        , m_fileBytes(0)
+        , m_lastWrite(clock::now())
+        , m_hasCriticalPending(false)
         , m_shutdown(false)
-        , m_worker(std::thread(&Logger::processQueue, this))
     {
-        if (!m_logStream.is_open()) 
-        {
-            std::cerr << "Logger: failed to open log file: " << m_filename << std::endl;
-        }
+        openLogFile(std::ios::out | std::ios::trunc);
 
         // disable Debug/Trace in release builds
         #ifndef NDEBUG
-            m_enabledLevels = { Level::Trace, Level::Debug, Level::Info, Level::Warn, Level::Error, Level::Fatal };
+            setMinLevel(Level::Trace);
         #else
-            m_enabledLevels = { Level::Info, Level::Warn, Level::Error, Level::Fatal };
+            setMinLevel(Level::Info);
         #endif
+
+        m_messageBuffer.reserve(1024);
+        m_writeBuffer.reserve(kWriteBufferBytes + 4096);
+        m_worker = std::thread(&Logger::processQueue, this);
     }
 
     Logger::~Logger()
@@ -45,69 +181,131 @@ namespace keplar
         terminate();
     }
 
-    void Logger::enqueueLog(Level level, const char* file, int line, const char* fmt, ...) noexcept
+    std::byte* Logger::beginRecord(Level level, const char* file, int line, const char* fmt, size_t argBytes) noexcept
     {
-        if (!isEnabled(level)) 
+        const size_t recordBytes = sizeof(RecordHeader) + argBytes;
+        if (recordBytes > kMaxRecordBytes)
         {
-            return;
+            m_droppedLogs.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
         }
 
-        constexpr size_t stackSize = 1024;
-        char stackBuffer[stackSize];
+        ThreadRing* ring = getThreadRing();
+        if (!ring)
+        {
+            m_droppedLogs.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
 
-        va_list args;
-        va_start(args, fmt);
-        int len = std::vsnprintf(stackBuffer, stackSize, fmt, args);
-        va_end(args);
+        // records never wrap: the unused end of the ring is skipped with a padding record
+        const uint32_t size = alignRecord(recordBytes);
+        uint32_t head = ring->mHead.load(std::memory_order_relaxed);
+        const uint32_t contiguous = kRingBytes - (head & (kRingBytes - 1));
+        const uint32_t needed = (size > contiguous) ? size + contiguous : size;
 
-        if (len < 0) 
+        // single producer: only this thread advances the head. a full ring waits on the worker, never on a lock
+        while (kRingBytes - (head - ring->mTail.load(std::memory_order_acquire)) < needed)
         {
-            return;
+            if (m_shutdown.load(std::memory_order_relaxed))
+            {
+                m_droppedLogs.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            m_cv.notify_one();
+            std::this_thread::yield();
         }
 
-        std::string timestamp = getCurrentTimestamp();
-        std::string fileLine = getFileLine(file, line);
+        if (size > contiguous)
+        {
+            const uint32_t padding[2] = { contiguous, kPaddingRecord };
+            std::memcpy(&ring->mBytes[head & (kRingBytes - 1)], padding, sizeof(padding));
+            head += contiguous;
+        }
 
-        std::string formatted;
-        if (static_cast<size_t>(len) < stackSize)
+        RecordHeader header{};
+        header.mSize = size;
+        header.mLevel = static_cast<uint32_t>(level);
+        header.mTimestamp = static_cast<uint64_t>((clock::now() - m_steadyEpoch).count());
+        header.mFile = file;
+        header.mFormat = fmt;
+        header.mLine = line;
+        header.mArgBytes = static_cast<uint32_t>(argBytes);
+
+        std::byte* record = &ring->mBytes[head & (kRingBytes - 1)];
+        std::memcpy(record, &header, sizeof(header));
+        ring->mPendingHead = head + size;
+        return record + sizeof(header);
+    }
+
+    void Logger::endRecord(Level level) noexcept
+    {
+        ThreadRing* ring = getThreadRing();
+        const uint32_t head = ring->mPendingHead;
+        ring->mHead.store(head, std::memory_order_release);
+
+        // critical logs and rings past half capacity are written out without waiting for the next interval
+        if (level >= Level::Error || head - ring->mTail.load(std::memory_order_relaxed) > kRingBytes / 2)
         {
-            formatLogMessage(formatted, level, timestamp.c_str(), fileLine.c_str(), stackBuffer);
+            m_cv.notify_one();
         }
-        else
+    }
+
+    Logger::ThreadRing* Logger::getThreadRing() noexcept
+    {
+        // one registration per thread, cached thread-locally; the lease releases the ring at thread exit
+        thread_local ThreadRing* threadRing = nullptr;
+        thread_local RingLease lease;
+        if (threadRing)
         {
-            // fall back to heap buffer for large messages
-            std::vector<char> heapBuffer(len + 1);
-            va_list args2;
-            va_start(args2, fmt);
-            std::vsnprintf(heapBuffer.data(), heapBuffer.size(), fmt, args2);
-            va_end(args2);
-            formatLogMessage(formatted, level, timestamp.c_str(), fileLine.c_str(), heapBuffer.data());
+            return threadRing;
         }
 
-        // equeue the formatted log message for async processing
+        // thread id string formatted once per thread
+        std::stringstream tidStream;
+        tidStream << std::this_thread::get_id();
+
+        // take over the ring of an exited thread once the worker drained it (the tails only move under m_ringMutex),
+        // so short-lived pool threads do not grow the ring list
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        for (const auto& ring : m_rings)
         {
-            std::lock_guard lock(m_queueMutex);
-            m_messageQueue.push({ level, std::move(formatted) });
+            if (!ring->mIsOwned.load(std::memory_order_acquire) &&
+                ring->mTail.load(std::memory_order_relaxed) == ring->mHead.load(std::memory_order_acquire))
+            {
+                ring->mIsOwned.store(true, std::memory_order_relaxed);
+                ring->mThreadId = tidStream.str();
+                threadRing = ring.get();
+                lease.mIsOwned = &ring->mIsOwned;
+                return threadRing;
+            }
         }
 
-        // notify the worker thread 
-        m_cv.notify_one();
+        auto ring = std::make_unique<ThreadRing>();
+        ring->mThreadId = tidStream.str();
+        threadRing = ring.get();
+        lease.mIsOwned = &ring->mIsOwned;
+        m_rings.push_back(std::move(ring));
+        return threadRing;
     }
 
-    void Logger::flush() noexcept
+    size_t Logger::getStringLength(const char* str) noexcept
     {
-        std::scoped_lock lock(m_stateMutex, m_queueMutex);
-    
-        // now it's safe: no one can enqueue while we drain the queue
-        while (!m_messageQueue.empty())
+        size_t length = 0;
+        while (length < kMaxStringLength && str[length] != '\0')
         {
-            auto logEntry = std::move(m_messageQueue.front());
-            m_messageQueue.pop();
-            if (m_logStream.is_open())
-            {
-                m_logStream << logEntry.mMessage << "\n";
-            }
+            ++length;
         }
+        return length;
+    }
+
+    void Logger::flush() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+    
+        // write everything published so far; producers keep logging into their rings meanwhile
+        drainRings();
+        commitWrites(true);
 
         // force flush stream
         if (m_logStream.is_open())
@@ -118,9 +316,9 @@ namespace keplar
 
     void Logger::terminate() noexcept
     {
-        // acquire both state and queue mutexes to safely update shutdown state
+        // acquire the state mutex to safely update shutdown state
         {
-            std::scoped_lock lock(m_stateMutex, m_queueMutex);
+            std::lock_guard<std::mutex> lock(m_stateMutex);
             if (m_shutdown.load()) return;
             m_shutdown.store(true);
         }
@@ -136,6 +334,17 @@ namespace keplar
         flush();
 
         std::lock_guard<std::mutex> lock(m_stateMutex);
+        if (m_compressor.joinable())
+        {
+            m_compressor.join();
+        }
+
+        const uint64_t droppedLogs = m_droppedLogs.exchange(0, std::memory_order_relaxed);
+        if (droppedLogs > 0 && m_logStream.is_open())
+        {
+            m_logStream << "Logger: " << droppedLogs << " messages dropped\n";
+        }
+
         if (m_logStream.is_open())
         {
             m_logStream.close();
@@ -146,7 +355,7 @@ namespace keplar
     {
         terminate();
         
-        std::scoped_lock lock(m_stateMutex, m_queueMutex);
+        std::lock_guard<std::mutex> lock(m_stateMutex);
         std::ios_base::openmode mode = std::ios::out;
         if (!filename.empty())
         {
@@ -158,10 +367,8 @@ namespace keplar
             mode |= std::ios::app;
         }
 
-        m_logStream.open(m_filename, mode);
-        if (!m_logStream.is_open()) 
+        if (!openLogFile(mode))
         {
-            std::cerr << "Logger: failed to open log file: " << m_filename << std::endl;
             return;
         }
 
@@ -176,18 +383,20 @@ namespace keplar
             return;
         }
 
-        std::scoped_lock lock(m_stateMutex, m_queueMutex);
+        std::lock_guard<std::mutex> lock(m_stateMutex);
         if (m_logStream.is_open())
         {
             m_logStream.close();
         }
 
         m_filename = filename;
-        m_logStream.open(filename, std::ios::out | std::ios::trunc);
-        if (!m_logStream.is_open()) 
-        {
-            std::cerr << "Logger: failed to open log file: " << m_filename << std::endl;
-        }
+        openLogFile(std::ios::out | std::ios::trunc);
+    }
+
+    void Logger::setRotationPolicy(const LogRotationPolicy& policy) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_rotationPolicy = policy;
     }
 
     bool Logger::isActive() const noexcept
@@ -198,97 +407,448 @@ namespace keplar
 
     void Logger::setMinLevel(Level level) noexcept
     {
-        std::lock_guard<std::mutex> lock(m_stateMutex);
-        m_enabledLevels.clear();
+        uint32_t mask = 0;
         for (int lvl = static_cast<int>(level); lvl <= static_cast<int>(Level::Fatal); ++lvl)
         {
-            m_enabledLevels.insert(static_cast<Level>(lvl));
+            mask |= levelBit(static_cast<Level>(lvl));
         }
+        m_levelMask.store(mask, std::memory_order_relaxed);
     }
 
     void Logger::enableLevel(Level level) noexcept
     {
-        std::lock_guard<std::mutex> lock(m_stateMutex);
-        m_enabledLevels.insert(level);
+        m_levelMask.fetch_or(levelBit(level), std::memory_order_relaxed);
     }
 
     void Logger::disableLevel(Level level) noexcept
     {
-        std::lock_guard<std::mutex> lock(m_stateMutex);
-        m_enabledLevels.erase(level);
+        m_levelMask.fetch_and(~levelBit(level), std::memory_order_relaxed);
     }
 
-    bool Logger::isEnabled(Level level) const noexcept
+    void Logger::processQueue() noexcept
     {
-        std::lock_guard<std::mutex> lock(m_stateMutex);
-        return (m_enabledLevels.find(level) != m_enabledLevels.end());
+        std::unique_lock<std::mutex> workerLock(m_workerMutex);
+        while (true)
+        {
+            // wake up periodically, early for critical logs, full rings or a shutdown request
+            m_cv.wait_for(workerLock, kWorkerInterval, [this] { return m_shutdown.load(); });
+            {
+                std::lock_guard<std::mutex> stateLock(m_stateMutex);
+                drainRings();
+                commitWrites(false);
+            }
+
+            // exit the loop if shutdown has been requested
+            if (m_shutdown.load())
+            {
+                break;
+            }
+        }
     }
 
-    void Logger::processQueue() noexcept
+    void Logger::drainRings() noexcept
     {
-        std::unique_lock<std::mutex> queueLock(m_queueMutex);
+        // caller holds m_stateMutex: single consumer, only the drain advances the tails
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+
+        // records published before this pass, merged across threads in timestamp order
+        std::vector<uint32_t> heads(m_rings.size());
+        for (size_t i = 0; i < m_rings.size(); ++i)
+        {
+            heads[i] = m_rings[i]->mHead.load(std::memory_order_acquire);
+        }
+
         while (true)
         {
-            // wait until there is a message to process or a shutdown is requested
-            m_cv.wait(queueLock, [this] { return !m_messageQueue.empty() || m_shutdown.load(); });
-            while (!m_messageQueue.empty())
+            ThreadRing* nextRing = nullptr;
+            RecordHeader nextHeader{};
+            for (size_t i = 0; i < m_rings.size(); ++i)
             {
-                // retrieve the next log entry from the queue
-                auto logEntry = std::move(m_messageQueue.front());
-                m_messageQueue.pop();
+                ThreadRing& ring = *m_rings[i];
+                uint32_t tail = ring.mTail.load(std::memory_order_relaxed);
+                if (tail == heads[i])
+                {
+                    continue;
+                }
 
-                // temporarily release the queue lock during I/O to allow other threads to enqueue
-                queueLock.unlock();
+                // skip the padding at the end of the ring
+                uint32_t prefix[2];
+                std::memcpy(prefix, &ring.mBytes[tail & (kRingBytes - 1)], sizeof(prefix));
+                if (prefix[1] == kPaddingRecord)
                 {
-                    std::lock_guard<std::mutex> stateLock(m_stateMutex);
-                    if (m_logStream.is_open())
+                    tail += prefix[0];
+                    ring.mTail.store(tail, std::memory_order_release);
+                    if (tail == heads[i])
                     {
-                        m_logStream << logEntry.mMessage << "\n";
-                        
-                        // flush critical logs 
-                        if (logEntry.mLevel == Level::Error || logEntry.mLevel == Level::Fatal)
-                        {
-                            m_logStream.flush();
-                        }
+                        continue;
                     }
                 }
-                // re-acquire the queue lock before checking the queue again
-                queueLock.lock();
+
+                RecordHeader header;
+                std::memcpy(&header, &ring.mBytes[tail & (kRingBytes - 1)], sizeof(header));
+                if (!nextRing || header.mTimestamp < nextHeader.mTimestamp)
+                {
+                    nextRing = &ring;
+                    nextHeader = header;
+                }
             }
 
-            // exit the loop if shutdown has been requested
-            if (m_shutdown.load())
+            if (!nextRing)
             {
                 break;
             }
+
+            const uint32_t tail = nextRing->mTail.load(std::memory_order_relaxed);
+            const std::byte* args = &nextRing->mBytes[tail & (kRingBytes - 1)] + sizeof(RecordHeader);
+            writeRecord(nextHeader, args, nextRing->mThreadId);
+            nextRing->mTail.store(tail + nextHeader.mSize, std::memory_order_release);
+        }
+    }
+
+    void Logger::writeRecord(const RecordHeader& header, const std::byte* args, const std::string& threadId) noexcept
+    {
+        if (!m_logStream.is_open())
+        {
+            return;
+        }
+
+        char timestamp[32];
+        char fileLine[128];
+        formatTimestamp(timestamp, sizeof(timestamp), header.mTimestamp);
+        getFileLine(fileLine, sizeof(fileLine), header.mFile, header.mLine);
+        formatMessage(m_messageBuffer, header.mFormat, args, args + header.mArgBytes);
+
+        const Level level = static_cast<Level>(header.mLevel);
+        formatLogMessage(m_writeBuffer, level, timestamp, threadId.c_str(), fileLine, m_messageBuffer);
+        m_writeBuffer += '\n';
+
+        // critical logs are written at the end of this batch
+        if (level == Level::Error || level == Level::Fatal)
+        {
+            m_hasCriticalPending = true;
+        }
+
+        // large batches are written as they fill up
+        if (m_writeBuffer.size() >= kWriteBufferBytes)
+        {
+            commitWrites(true);
+        }
+    }
+
+    void Logger::commitWrites(bool force) noexcept
+    {
+        // caller holds m_stateMutex
+        if (m_writeBuffer.empty())
+        {
+            return;
+        }
+
+        const auto now = clock::now();
+        if (!force && !m_hasCriticalPending && now - m_lastWrite < kFlushInterval)
+        {
+            return;
+        }
+
+        // the stream is unbuffered: one write per batch
+        if (m_logStream.is_open())
+        {
+            m_logStream.write(m_writeBuffer.data(), static_cast<std::streamsize>(m_writeBuffer.size()));
+            m_fileBytes += m_writeBuffer.size();
+        }
+
+        m_writeBuffer.clear();
+        m_hasCriticalPending = false;
+        m_lastWrite = now;
+
+        if (m_rotationPolicy.mMaxFileBytes > 0 && m_fileBytes >= m_rotationPolicy.mMaxFileBytes)
+        {
+            rotateLogFile();
+        }
+    }
+
+    bool Logger::openLogFile(std::ios_base::openmode mode) noexcept
+    {
+        // caller holds m_stateMutex (or is the constructor); batching replaces the stream buffer
+        m_logStream.rdbuf()->pubsetbuf(nullptr, 0);
+        m_logStream.open(m_filename, mode);
+        if (!m_logStream.is_open()) 
+        {
+            std::cerr << "Logger: failed to open log file: " << m_filename << std::endl;
+            return false;
+        }
+
+        std::error_code errorCode;
+        const auto fileSize = std::filesystem::file_size(m_filename, errorCode);
+        m_fileBytes = ((mode & std::ios::app) && !errorCode) ? static_cast<uint64_t>(fileSize) : 0;
+        return true;
+    }
+
+    void Logger::rotateLogFile() noexcept
+    {
+        namespace fs = std::filesystem;
+
+        // the previous rotated file must be complete before it is shifted
+        if (m_compressor.joinable())
+        {
+            m_compressor.join();
+        }
+
+        m_logStream.close();
+
+        const uint32_t maxFiles = m_rotationPolicy.mMaxFiles;
+        std::error_code errorCode;
+        if (maxFiles > 0)
+        {
+            // drop the oldest file and shift the rest up by one
+            fs::remove(getRotatedPath(maxFiles, false), errorCode);
+            fs::remove(getRotatedPath(maxFiles, true), errorCode);
+            for (uint32_t index = maxFiles - 1; index >= 1; --index)
+            {
+                for (const bool compressed : { false, true })
+                {
+                    const fs::path path = getRotatedPath(index, compressed);
+                    if (fs::exists(path, errorCode))
+                    {
+                        fs::rename(path, getRotatedPath(index + 1, compressed), errorCode);
+                    }
+                }
+            }
+
+            const fs::path rotated = getRotatedPath(1, false);
+            fs::rename(m_filename, rotated, errorCode);
+            if (!errorCode && m_rotationPolicy.mCompress)
+            {
+                // compression stays off the worker: it keeps draining the rings meanwhile
+                const fs::path compressed = getRotatedPath(1, true);
+                m_compressor = std::thread([rotated, compressed]()
+                {
+                    std::error_code removeError;
+                    if (compressFile(rotated, compressed))
+                    {
+                        fs::remove(rotated, removeError);
+                    }
+                    else
+                    {
+                        fs::remove(compressed, removeError);
+                    }
+                });
+            }
+        }
+
+        openLogFile(std::ios::out | std::ios::trunc);
+    }
+
+    std::filesystem::path Logger::getRotatedPath(uint32_t index, bool compressed) const noexcept
+    {
+        // vklog.txt -> vklog.<index>.txt[.gz]
+        const std::filesystem::path path(m_filename);
+        std::string name = path.stem().string() + "." + std::to_string(index) + path.extension().string();
+        if (compressed)
+        {
+            name += ".gz";
         }
+        return path.parent_path() / name;
     }
 
-    void Logger::formatLogMessage(std::string& out, Level level, const char* timestamp, const char* fileLine, const char* message) noexcept
+    void Logger::formatMessage(std::string& out, const char* fmt, const std::byte* args, const std::byte* argsEnd) const noexcept
     {
-        // reserve approximate size upfront to reduce reallocations
         out.clear();
-        out.reserve(128 + std::strlen(message) + std::strlen(fileLine) + std::strlen(timestamp));
 
-        // convert thread id to string without ostringstream
-        std::stringstream tidStream;
-        tidStream << std::this_thread::get_id();
-        std::string tidStr = tidStream.str();
+        // decodes the next argument; false once the arguments run out
+        struct Arg
+        {
+            ArgType     mType;
+            uint64_t    mBits;
+            const char* mString;
+        };
 
-        if (tidStr.length() < 6)
-            tidStr.append(6 - tidStr.length(), ' ');
+        auto nextArg = [&args, argsEnd](Arg& arg) -> bool
+        {
+            if (args >= argsEnd)
+            {
+                return false;
+            }
 
-        // get level string
-        std::string levelStr(levelToString(level));
-        if (levelStr.length() < 5)
-            levelStr.append(5 - levelStr.length(), ' ');
+            arg.mType = static_cast<ArgType>(*args++);
+            arg.mBits = 0;
+            arg.mString = nullptr;
+            if (arg.mType == ArgType::kString)
+            {
+                uint32_t length = 0;
+                std::memcpy(&length, args, sizeof(length));
+                arg.mString = reinterpret_cast<const char*>(args + sizeof(length));
+                args += sizeof(length) + length + 1;
+            }
+            else
+            {
+                std::memcpy(&arg.mBits, args, sizeof(arg.mBits));
+                args += sizeof(arg.mBits);
+            }
+            return true;
+        };
+
+        // '*' width or precision
+        auto nextInt = [&nextArg]() -> int
+        {
+            Arg arg;
+            return (nextArg(arg) && (arg.mType == ArgType::kInt || arg.mType == ArgType::kUInt)) ? static_cast<int>(static_cast<int64_t>(arg.mBits)) : 0;
+        };
+
+        // walk the format string and print one conversion at a time with its argument cast to the spec's type
+        const char* p = fmt;
+        while (*p != '\0')
+        {
+            if (*p != '%')
+            {
+                const char* next = std::strchr(p, '%');
+                const size_t length = next ? static_cast<size_t>(next - p) : std::strlen(p);
+                out.append(p, length);
+                p += length;
+                continue;
+            }
+
+            if (p[1] == '%')
+            {
+                out += '%';
+                p += 2;
+                continue;
+            }
+
+            char spec[kMaxSpecLength];
+            size_t specLength = 0;
+            auto put = [&spec, &specLength](char c) { if (specLength + 1 < kMaxSpecLength) spec[specLength++] = c; };
+            auto putInt = [&put](int value) { char digits[16]; std::snprintf(digits, sizeof(digits), "%d", value); for (const char* d = digits; *d; ++d) put(*d); };
+            put(*p++);
+
+            // flags and width
+            while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') { put(*p++); }
+            if (*p == '*')      { putInt(nextInt()); ++p; }
+            else                { while (*p >= '0' && *p <= '9') { put(*p++); } }
+
+            // precision (a negative '*' precision is ignored, as in printf)
+            if (*p == '.')
+            {
+                ++p;
+                if (*p == '*')  { const int precision = nextInt(); if (precision >= 0) { put('.'); putInt(precision); } ++p; }
+                else            { put('.'); while (*p >= '0' && *p <= '9') { put(*p++); } }
+            }
+
+            // length modifier
+            const char* lengthBegin = p;
+            while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'j' || *p == 'z' || *p == 't') { put(*p++); }
+            const std::string_view modifier(lengthBegin, static_cast<size_t>(p - lengthBegin));
+
+            const char conversion = *p;
+            if (conversion == '\0')
+            {
+                break;
+            }
+            put(*p++);
+            spec[specLength] = '\0';
+
+            Arg arg;
+            if (!nextArg(arg))
+            {
+                out += "<missing>";
+                continue;
+            }
+
+            switch (conversion)
+            {
+                case 'd':
+                case 'i':
+                {
+                    const int64_t value = static_cast<int64_t>(arg.mBits);
+                    if (arg.mType != ArgType::kInt && arg.mType != ArgType::kUInt)    { out += "<?>"; }
+                    else if (modifier == "hh")  { appendFormatted(out, spec, static_cast<int>(static_cast<signed char>(value))); }
+                    else if (modifier == "h")   { appendFormatted(out, spec, static_cast<int>(static_cast<short>(value))); }
+                    else if (modifier == "l")   { appendFormatted(out, spec, static_cast<long>(value)); }
+                    else if (modifier == "ll")  { appendFormatted(out, spec, static_cast<long long>(value)); }
+                    else if (modifier == "j")   { appendFormatted(out, spec, static_cast<intmax_t>(value)); }
+                    else if (modifier == "z" || modifier == "t") { appendFormatted(out, spec, static_cast<ptrdiff_t>(value)); }
+                    else                        { appendFormatted(out, spec, static_cast<int>(value)); }
+                    break;
+                }
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X':
+                {
+                    const uint64_t value = arg.mBits;
+                    if (arg.mType != ArgType::kInt && arg.mType != ArgType::kUInt)    { out += "<?>"; }
+                    else if (modifier == "hh")  { appendFormatted(out, spec, static_cast<unsigned int>(static_cast<unsigned char>(value))); }
+                    else if (modifier == "h")   { appendFormatted(out, spec, static_cast<unsigned int>(static_cast<unsigned short>(value))); }
+                    else if (modifier == "l")   { appendFormatted(out, spec, static_cast<unsigned long>(value)); }
+                    else if (modifier == "ll")  { appendFormatted(out, spec, static_cast<unsigned long long>(value)); }
+                    else if (modifier == "j")   { appendFormatted(out, spec, static_cast<uintmax_t>(value)); }
+                    else if (modifier == "z" || modifier == "t") { appendFormatted(out, spec, static_cast<size_t>(value)); }
+                    else                        { appendFormatted(out, spec, static_cast<unsigned int>(value)); }
+                    break;
+                }
+                case 'c':
+                {
+                    if (arg.mType != ArgType::kInt && arg.mType != ArgType::kUInt)    { out += "<?>"; }
+                    else                        { appendFormatted(out, spec, static_cast<int>(arg.mBits)); }
+                    break;
+                }
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                {
+                    double value = 0.0;
+                    std::memcpy(&value, &arg.mBits, sizeof(value));
+                    if (arg.mType != ArgType::kDouble)  { out += "<?>"; }
+                    else if (modifier == "L")           { appendFormatted(out, spec, static_cast<long double>(value)); }
+                    else                                { appendFormatted(out, spec, value); }
+                    break;
+                }
+                case 's':
+                {
+                    if (arg.mType != ArgType::kString)  { out += "<?>"; }
+                    else                                { appendFormatted(out, spec, arg.mString); }
+                    break;
+                }
+                case 'p':
+                {
+                    if (arg.mType != ArgType::kPointer) { out += "<?>"; }
+                    else                                { appendFormatted(out, spec, reinterpret_cast<const void*>(static_cast<uintptr_t>(arg.mBits))); }
+                    break;
+                }
+                default:
+                {
+                    // unsupported conversion: print it verbatim
+                    out.append(spec, specLength);
+                    break;
+                }
+            }
+        }
+    }
+
+    void Logger::formatLogMessage(std::string& out, Level level, const char* timestamp, const char* threadId, const char* fileLine, const std::string& message) const noexcept
+    {
+        // appends to the batch; reserve approximate size upfront to reduce reallocations
+        out.reserve(out.size() + 128 + message.size());
 
         // build the final string 
         out += timestamp;
         out += " | TID ";
-        out += tidStr;
+        out += threadId;
+        size_t tidLen = std::strlen(threadId);
+        if (tidLen < 6)
+            out.append(6 - tidLen, ' ');
         out += " | ";
+
+        // get level string
+        const char* levelStr = levelToString(level);
+        size_t levelLen = std::strlen(levelStr);
         out += levelStr;
+        if (levelLen < 5)
+            out.append(5 - levelLen, ' ');
         out += " | ";
 
         // file and line information
@@ -322,18 +882,16 @@ namespace keplar
         }
     }
 
-    std::string Logger::getCurrentTimestamp() const noexcept
+    void Logger::formatTimestamp(char* out, size_t size, uint64_t timestamp) noexcept
     {
+        // record timestamps are steady clock ticks since construction, converted to wall time here on the worker
         using namespace std::chrono;
-        static std::string lastTimestamp;
-        static time_t lastSecond = 0;
-
-        auto now = system_clock::now();
-        auto in_time_t = system_clock::to_time_t(now);
-        auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
+        const auto now = m_wallEpoch + duration_cast<system_clock::duration>(clock::duration(static_cast<clock::rep>(timestamp)));
+        const time_t in_time_t = system_clock::to_time_t(now);
+        const auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
 
         // cheaper on repeated calls within same second
-        if (in_time_t != lastSecond)
+        if (in_time_t != m_lastSecond)
         {
             std::tm timeInfo;
             #ifdef _WIN32
@@ -341,22 +899,20 @@ namespace keplar
             #else
                 localtime_r(&in_time_t, &timeInfo);
             #endif
-            std::ostringstream oss;
-            oss << std::put_time(&timeInfo, "%Y-%m-%d %H:%M:%S");
-            lastTimestamp = oss.str();
-            lastSecond = in_time_t;
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &timeInfo);
+            m_lastTimestamp = buffer;
+            m_lastSecond = in_time_t;
         }
 
-        std::ostringstream finalStream;
-        finalStream << lastTimestamp << '.' << std::setfill('0') << std::setw(3) << ms.count();
-        return finalStream.str();
+        std::snprintf(out, size, "%s.%03d", m_lastTimestamp.c_str(), static_cast<int>(ms.count()));
     }
 
-    std::string Logger::getFileLine(const char* fullPath, int line) const noexcept
+    void Logger::getFileLine(char* out, size_t size, const char* fullPath, int line) const noexcept
     {
         std::string_view path(fullPath);
         size_t lastSlash = path.find_last_of("/\\");
         std::string_view filename = (lastSlash != std::string_view::npos) ? path.substr(lastSlash + 1) : path;
-        return std::string(filename) + ":" + std::to_string(line);
+        std::snprintf(out, size, "%.*s:%d", static_cast<int>(filename.size()), filename.data(), line);
     }
 }   // namespace keplar
@@ -4,40 +4,191 @@
 
 #pragma once
 
-#include <cstdarg>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string>
-#include <unordered_set>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <type_traits>
+#include <vector>
 #include <condition_variable>
 
+// printf conversion checking of the log calls and a branch hint for the runtime level check (gcc and clang)
+#if defined(__GNUC__) || defined(__clang__)
+    #define KEPLAR_PRINTF_FORMAT(formatIndex, firstArgIndex) __attribute__((format(printf, formatIndex, firstArgIndex)))
+    #define KEPLAR_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+    #define KEPLAR_PRINTF_FORMAT(formatIndex, firstArgIndex)
+    #define KEPLAR_UNLIKELY(condition) (condition)
+#endif
+
+// lowest level compiled in (0 trace, 1 debug, 2 info, 3 warn, 4 error, 5 fatal, 6 none), set by the build through
+// -DKEPLAR_LOG_MIN_LEVEL. calls below it expand to a dead branch: nothing is evaluated or emitted, but the format is
+// still checked against the arguments. debug builds default to everything, release builds to info and up
+#ifndef KEPLAR_LOG_MIN_LEVEL
+    #ifndef NDEBUG
+        #define KEPLAR_LOG_MIN_LEVEL 0
+    #else
+        #define KEPLAR_LOG_MIN_LEVEL 2
+    #endif
+#endif
+
+// never taken: lets the compiler check the call's printf conversions without evaluating its arguments
+#define VK_LOG_CHECK_FORMAT(fmt, ...) \
+    do { \
+        if (false) \
+        { \
+            keplar::checkLogFormat(fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+// levels enabled at runtime are expected to log rarely from the paths that call them, so the record stays off the
+// fall-through path
 #define VK_LOG(level, fmt, ...) \
     do { \
-        if (keplar::Logger::getInstance().isEnabled(keplar::Logger::Level::level)) \
+        VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__); \
+        if (KEPLAR_UNLIKELY(keplar::Logger::getInstance().isEnabled(keplar::Logger::Level::level))) \
         { \
             keplar::Logger::getInstance().enqueueLog( \
                 keplar::Logger::Level::level, __FILE__, __LINE__, fmt, ##__VA_ARGS__); \
         } \
     } while (0)
 
-// zero runtime overhead for debug and trace logs in release builds
-#ifndef NDEBUG
+// per call site rate limit for hot loops: at most one message per interval, repeats in between are counted and
+// reported with the next message that gets through
+#define VK_LOG_THROTTLED(level, intervalMs, fmt, ...) \
+    do { \
+        VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__); \
+        static keplar::LogRateLimiter _vkLogSite(intervalMs); \
+        uint32_t _vkSuppressed = 0; \
+        if (KEPLAR_UNLIKELY(keplar::Logger::getInstance().isEnabled(keplar::Logger::Level::level)) && _vkLogSite.tryAcquire(_vkSuppressed)) \
+        { \
+            if (_vkSuppressed > 0) \
+            { \
+                keplar::Logger::getInstance().enqueueLog( \
+                    keplar::Logger::Level::level, __FILE__, __LINE__, "(%u similar messages suppressed)", _vkSuppressed); \
+            } \
+            keplar::Logger::getInstance().enqueueLog( \
+                keplar::Logger::Level::level, __FILE__, __LINE__, fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+// zero runtime overhead for the levels below KEPLAR_LOG_MIN_LEVEL
+#if KEPLAR_LOG_MIN_LEVEL <= 0
     #define VK_LOG_TRACE(fmt, ...) VK_LOG(Trace, fmt, ##__VA_ARGS__)
+    #define VK_LOG_TRACE_THROTTLED(fmt, ...) VK_LOG_THROTTLED(Trace, keplar::kLogThrottleIntervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define VK_LOG_TRACE(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+    #define VK_LOG_TRACE_THROTTLED(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+#endif
+
+#if KEPLAR_LOG_MIN_LEVEL <= 1
     #define VK_LOG_DEBUG(fmt, ...) VK_LOG(Debug, fmt, ##__VA_ARGS__)
+    #define VK_LOG_DEBUG_THROTTLED(fmt, ...) VK_LOG_THROTTLED(Debug, keplar::kLogThrottleIntervalMs, fmt, ##__VA_ARGS__)
 #else
-    #define VK_LOG_TRACE(fmt, ...) ((void)0)
-    #define VK_LOG_DEBUG(fmt, ...) ((void)0)
+    #define VK_LOG_DEBUG(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+    #define VK_LOG_DEBUG_THROTTLED(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
 #endif
 
-#define VK_LOG_INFO(fmt, ...)  VK_LOG(Info,  fmt, ##__VA_ARGS__)
-#define VK_LOG_WARN(fmt, ...)  VK_LOG(Warn,  fmt, ##__VA_ARGS__)
-#define VK_LOG_ERROR(fmt, ...) VK_LOG(Error, fmt, ##__VA_ARGS__)
-#define VK_LOG_FATAL(fmt, ...) VK_LOG(Fatal, fmt, ##__VA_ARGS__)
+#if KEPLAR_LOG_MIN_LEVEL <= 2
+    #define VK_LOG_INFO(fmt, ...) VK_LOG(Info, fmt, ##__VA_ARGS__)
+    #define VK_LOG_INFO_THROTTLED(fmt, ...) VK_LOG_THROTTLED(Info, keplar::kLogThrottleIntervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define VK_LOG_INFO(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+    #define VK_LOG_INFO_THROTTLED(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+#endif
+
+#if KEPLAR_LOG_MIN_LEVEL <= 3
+    #define VK_LOG_WARN(fmt, ...) VK_LOG(Warn, fmt, ##__VA_ARGS__)
+    #define VK_LOG_WARN_THROTTLED(fmt, ...) VK_LOG_THROTTLED(Warn, keplar::kLogThrottleIntervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define VK_LOG_WARN(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+    #define VK_LOG_WARN_THROTTLED(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+#endif
+
+#if KEPLAR_LOG_MIN_LEVEL <= 4
+    #define VK_LOG_ERROR(fmt, ...) VK_LOG(Error, fmt, ##__VA_ARGS__)
+    #define VK_LOG_ERROR_THROTTLED(fmt, ...) VK_LOG_THROTTLED(Error, keplar::kLogThrottleIntervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define VK_LOG_ERROR(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+    #define VK_LOG_ERROR_THROTTLED(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+#endif
+
+#if KEPLAR_LOG_MIN_LEVEL <= 5
+    #define VK_LOG_FATAL(fmt, ...) VK_LOG(Fatal, fmt, ##__VA_ARGS__)
+#else
+    #define VK_LOG_FATAL(fmt, ...) VK_LOG_CHECK_FORMAT(fmt, ##__VA_ARGS__)
+#endif
 
 namespace keplar
 {
+    // default interval of the VK_LOG_*_THROTTLED macros
+    constexpr uint32_t kLogThrottleIntervalMs = 1000;
+
+    // target of VK_LOG_CHECK_FORMAT, never called
+    KEPLAR_PRINTF_FORMAT(1, 2) inline void checkLogFormat(const char* /*fmt*/, ...) noexcept {}
+
+    // rate limiter state of one throttled log site; constant initialized, so the function local static has no guard
+    class LogRateLimiter final
+    {
+        public:
+            explicit constexpr LogRateLimiter(uint32_t intervalMs) noexcept
+                : m_intervalNs(static_cast<int64_t>(intervalMs) * 1000000)
+                , m_nextNs(0)
+                , m_suppressed(0)
+            {
+            }
+
+            // disable copy and move semantics to enforce unique ownership
+            LogRateLimiter(const LogRateLimiter&) = delete;
+            LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+            LogRateLimiter(LogRateLimiter&&) = delete;
+            LogRateLimiter& operator=(LogRateLimiter&&) = delete;
+
+            // true when the site may log now, with the number of messages suppressed since the last one
+            bool tryAcquire(uint32_t& suppressed) noexcept
+            {
+                using namespace std::chrono;
+                const int64_t now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+
+                // one thread wins the interval, the others count as repeats
+                int64_t next = m_nextNs.load(std::memory_order_relaxed);
+                if (now < next || !m_nextNs.compare_exchange_strong(next, now + m_intervalNs, std::memory_order_relaxed))
+                {
+                    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+
+        private:
+            const int64_t           m_intervalNs;
+            std::atomic<int64_t>    m_nextNs;
+            std::atomic<uint32_t>   m_suppressed;
+    };
+
+    // size based rotation of the log file: vklog.txt -> vklog.1.txt[.gz] -> ... -> vklog.<mMaxFiles>.txt[.gz]
+    struct LogRotationPolicy
+    {
+        uint64_t mMaxFileBytes = 16ull * 1024 * 1024;   // 0: never rotate
+        uint32_t mMaxFiles     = 4;                     // rotated files kept next to the active one
+        bool     mCompress     = true;                  // gzip rotated files on a background thread
+    };
+
+    // binary deferred logger: the calling thread only checks an atomic level mask and copies the format pointer,
+    // call site, a steady clock timestamp and the raw arguments into its own single producer ring (no locks, no
+    // allocations). formatting, timestamps and file i/o happen on the worker thread. format strings and __FILE__
+    // must outlive the logger (string literals); string arguments are copied. the worker batches formatted lines
+    // into one buffer written with a single call per batch, on an interval or right away for errors
     class Logger
     {
         public:
@@ -61,48 +212,240 @@ namespace keplar
             Logger& operator=(const Logger&) = delete;
             Logger& operator=(const Logger&&) = delete;
 
-            // logging operations
-            void enqueueLog(Level level, const char* file, int line, const char* fmt, ...) noexcept;
+            // logging operations (printf conversions; arguments must be arithmetic, enums, c strings or pointers)
+            template <typename... Args>
+            void enqueueLog(Level level, const char* file, int line, const char* fmt, Args... args) noexcept;
             void flush() noexcept;
             void terminate() noexcept;
             void restart(const std::string& filename = {}) noexcept;
             
             // log level control
             void resetLogFile(const std::string& filename) noexcept;
+            void setRotationPolicy(const LogRotationPolicy& policy) noexcept;
             bool isActive() const noexcept;
             void setMinLevel(Level level) noexcept;
             void enableLevel(Level level) noexcept;
             void disableLevel(Level level) noexcept;
-            bool isEnabled(Level level) const noexcept;
+            bool isEnabled(Level level) const noexcept { return (m_levelMask.load(std::memory_order_relaxed) & levelBit(level)) != 0; }
+
+            // accessors
+            uint64_t getDroppedLogCount() const noexcept { return m_droppedLogs.load(std::memory_order_relaxed); }
             
         private:
             Logger(const std::string& filename) noexcept;
             ~Logger();
 
-            // internal helpers
+            static constexpr uint32_t kRingBytes        = 64 * 1024;    // per thread, power of two
+            static constexpr uint32_t kMaxRecordBytes   = kRingBytes / 4;
+            static constexpr uint32_t kMaxStringLength  = 2048;         // longer string arguments are truncated
+            static constexpr uint32_t kPaddingRecord    = 0xFFFFFFFFu;  // record level marking the unused end of the ring
+            static constexpr size_t   kWriteBufferBytes = 256 * 1024;   // batch size written without waiting for the interval
+
+            // encoded argument types
+            enum class ArgType : uint8_t
+            {
+                kInt,
+                kUInt,
+                kDouble,
+                kString,
+                kPointer
+            };
+
+            // record layout: header followed by the encoded arguments, 8 byte aligned
+            struct RecordHeader
+            {
+                uint32_t    mSize;          // first two fields always fit before the end of the ring
+                uint32_t    mLevel;
+                uint64_t    mTimestamp;
+                const char* mFile;
+                const char* mFormat;
+                int32_t     mLine;
+                uint32_t    mArgBytes;
+            };
+
+            // written by its thread (head), read by the worker (tail); reused by a later thread once
+            // its thread exited and the worker drained it
+            struct ThreadRing
+            {
+                alignas(8) std::array<std::byte, kRingBytes> mBytes;
+                std::atomic<uint32_t>   mHead{ 0 };
+                std::atomic<uint32_t>   mTail{ 0 };
+                std::atomic<bool>       mIsOwned{ true };
+                uint32_t                mPendingHead = 0;
+                std::string             mThreadId;
+            };
+
+            static constexpr uint32_t levelBit(Level level) noexcept { return 1u << static_cast<uint32_t>(level); }
+
+            // argument encoding on the calling thread
+            template <typename T>
+            static constexpr ArgType getArgType() noexcept;
+            template <typename T>
+            static size_t getEncodedSize(T value) noexcept;
+            template <typename T>
+            static void encodeArg(std::byte*& cursor, T value) noexcept;
+            static size_t getStringLength(const char* str) noexcept;
+
+            // ring operations on the calling thread
+            ThreadRing* getThreadRing() noexcept;
+            std::byte* beginRecord(Level level, const char* file, int line, const char* fmt, size_t argBytes) noexcept;
+            void endRecord(Level level) noexcept;
+
+            // internal helpers (worker)
             void processQueue() noexcept;
-            void formatLogMessage(std::string& out, Level level, const char* timestamp, const char* fileLine, const char* message) noexcept;
+            void drainRings() noexcept;
+            void writeRecord(const RecordHeader& header, const std::byte* args, const std::string& threadId) noexcept;
+            void commitWrites(bool force) noexcept;
+            bool openLogFile(std::ios_base::openmode mode) noexcept;
+            void rotateLogFile() noexcept;
+            std::filesystem::path getRotatedPath(uint32_t index, bool compressed) const noexcept;
+            void formatMessage(std::string& out, const char* fmt, const std::byte* args, const std::byte* argsEnd) const noexcept;
+            void formatLogMessage(std::string& out, Level level, const char* timestamp, const char* threadId, const char* fileLine, const std::string& message) const noexcept;
             
             const char* levelToString(Level level) const noexcept;
-            std::string getCurrentTimestamp() const noexcept;
-            std::string getFileLine(const char* fullPath, int line) const noexcept;
+            void formatTimestamp(char* out, size_t size, uint64_t timestamp) noexcept;
+            void getFileLine(char* out, size_t size, const char* fullPath, int line) const noexcept;
             
         private:
-            struct LogEntry
-            {
-                Level mLevel;
-                std::string mMessage;
-            };
+            using clock = std::chrono::steady_clock;
 
+            // guards the stream and the consumer side of the rings (worker and flush)
             mutable std::mutex m_stateMutex;
-            mutable std::mutex m_queueMutex;
 
             std::string m_filename;
             std::ofstream m_logStream;
-            std::unordered_set<Level> m_enabledLevels;
-            std::queue<LogEntry> m_messageQueue;
+            std::atomic<uint32_t> m_levelMask;
+            std::atomic<uint64_t> m_droppedLogs;
+
+            // steady clock to wall clock conversion for record timestamps
+            clock::time_point m_steadyEpoch;
+            std::chrono::system_clock::time_point m_wallEpoch;
+            std::string m_lastTimestamp;
+            time_t m_lastSecond;
+
+            // worker scratch buffers, reused across records
+            std::string m_messageBuffer;
+
+            // batched writes and rotation (guarded by m_stateMutex)
+            std::string m_writeBuffer;
+            uint64_t m_fileBytes;
+            clock::time_point m_lastWrite;
+            bool m_hasCriticalPending;
+            LogRotationPolicy m_rotationPolicy;
+            std::thread m_compressor;
+
+            // rings are owned here and outlive their threads, at most one per thread logging at a time; registration is
+            // the only locked path
+            std::mutex m_ringMutex;
+            std::vector<std::unique_ptr<ThreadRing>> m_rings;
+
+            std::mutex m_workerMutex;
             std::condition_variable m_cv;
             std::atomic<bool> m_shutdown;
             std::thread m_worker;
     };
+
+    template <typename T>
+    constexpr Logger::ArgType Logger::getArgType() noexcept
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return std::is_signed_v<std::underlying_type_t<T>> ? ArgType::kInt : ArgType::kUInt;
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            return ArgType::kUInt;
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            return std::is_signed_v<T> ? ArgType::kInt : ArgType::kUInt;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return ArgType::kDouble;
+        }
+        else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+        {
+            return ArgType::kString;
+        }
+        else
+        {
+            static_assert(std::is_pointer_v<T> || std::is_null_pointer_v<T>, "log arguments must be arithmetic, enums, c strings or pointers");
+            return ArgType::kPointer;
+        }
+    }
+
+    template <typename T>
+    size_t Logger::getEncodedSize(T value) noexcept
+    {
+        // type tag, then a 64-bit value or a length prefixed, null terminated copy of the string
+        if constexpr (getArgType<T>() == ArgType::kString)
+        {
+            return 1 + sizeof(uint32_t) + getStringLength(value ? value : "(null)") + 1;
+        }
+        else
+        {
+            return 1 + sizeof(uint64_t);
+        }
+    }
+
+    template <typename T>
+    void Logger::encodeArg(std::byte*& cursor, T value) noexcept
+    {
+        constexpr ArgType type = getArgType<T>();
+        *cursor++ = static_cast<std::byte>(type);
+
+        uint64_t bits = 0;
+        if constexpr (type == ArgType::kString)
+        {
+            const char* str = value ? value : "(null)";
+            const uint32_t length = static_cast<uint32_t>(getStringLength(str));
+            std::memcpy(cursor, &length, sizeof(length));
+            cursor += sizeof(length);
+            std::memcpy(cursor, str, length);
+            cursor[length] = std::byte{ 0 };
+            cursor += length + 1;
+            return;
+        }
+        else if constexpr (type == ArgType::kDouble)
+        {
+            const double converted = static_cast<double>(value);
+            std::memcpy(&bits, &converted, sizeof(bits));
+        }
+        else if constexpr (type == ArgType::kPointer)
+        {
+            bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const void*>(value)));
+        }
+        else if constexpr (type == ArgType::kInt)
+        {
+            bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+        }
+        else
+        {
+            bits = static_cast<uint64_t>(value);
+        }
+
+        std::memcpy(cursor, &bits, sizeof(bits));
+        cursor += sizeof(bits);
+    }
+
+    template <typename... Args>
+    void Logger::enqueueLog(Level level, const char* file, int line, const char* fmt, Args... args) noexcept
+    {
+        if (!isEnabled(level)) 
+        {
+            return;
+        }
+
+        // size the record, then encode the arguments in place
+        const size_t argBytes = (size_t{ 0 } + ... + getEncodedSize(args));
+        std::byte* cursor = beginRecord(level, file, line, fmt, argBytes);
+        if (!cursor)
+        {
+            return;
+        }
+
+        (encodeArg(cursor, args), ...);
+        endRecord(level);
+    }
 }   // namespace keplar
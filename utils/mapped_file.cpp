@@ -0,0 +1,152 @@
+// ────────────────────────────────────────────
+//  File: mapped_file.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "mapped_file.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    MappedFile::MappedFile() noexcept
+        : m_data(nullptr)
+        , m_size(0)
+        , m_fileHandle(nullptr)
+        , m_mappingHandle(nullptr)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_fileHandle(std::exchange(other.m_fileHandle, nullptr))
+        , m_mappingHandle(std::exchange(other.m_mappingHandle, nullptr))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            m_data          = std::exchange(other.m_data, nullptr);
+            m_size          = std::exchange(other.m_size, 0);
+            m_fileHandle    = std::exchange(other.m_fileHandle, nullptr);
+            m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::filesystem::path& filepath) noexcept
+    {
+        close();
+
+    #ifdef _WIN32
+        HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            VK_LOG_WARN("MappedFile::open :: CreateFileMapping failed for %s (error: %lu)", filepath.string().c_str(), GetLastError());
+            CloseHandle(file);
+            return false;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            VK_LOG_WARN("MappedFile::open :: MapViewOfFile failed for %s (error: %lu)", filepath.string().c_str(), GetLastError());
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_fileHandle    = file;
+        m_mappingHandle = mapping;
+        m_data          = static_cast<const uint8_t*>(view);
+        m_size          = static_cast<size_t>(fileSize.QuadPart);
+    #else
+        const int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        // the mapping keeps its own reference to the file, so the descriptor can go right away
+        void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            VK_LOG_WARN("MappedFile::open :: mmap failed for %s", filepath.string().c_str());
+            return false;
+        }
+
+        // the whole file is read front to back; start readahead now
+        madvise(view, static_cast<size_t>(fileStat.st_size), MADV_WILLNEED);
+
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(fileStat.st_size);
+    #endif
+
+        return true;
+    }
+
+    void MappedFile::close() noexcept
+    {
+        if (m_data == nullptr)
+        {
+            return;
+        }
+
+    #ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    #else
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    #endif
+
+        m_data          = nullptr;
+        m_size          = 0;
+        m_fileHandle    = nullptr;
+        m_mappingHandle = nullptr;
+    }
+}   // namespace keplar
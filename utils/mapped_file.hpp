@@ -0,0 +1,44 @@
+// ────────────────────────────────────────────
+//  File: mapped_file.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace keplar
+{
+    // read-only memory mapping of a whole file; pages are faulted in from the os file cache on first touch
+    class MappedFile
+    {
+        public:
+            // creation and destruction
+            MappedFile() noexcept;
+            ~MappedFile();
+
+            // disable copy semantics to enforce unique ownership
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            // move semantics
+            MappedFile(MappedFile&&) noexcept;
+            MappedFile& operator=(MappedFile&&) noexcept;
+
+            // usage
+            bool open(const std::filesystem::path& filepath) noexcept;
+            void close() noexcept;
+
+            // accessors
+            const uint8_t* getData() const noexcept { return m_data; }
+            size_t         getSize() const noexcept { return m_size; }
+            bool           isOpen() const noexcept  { return m_data != nullptr; }
+
+        private:
+            const uint8_t*  m_data;
+            size_t          m_size;
+            void*           m_fileHandle;       // win32 file and mapping handles; unused elsewhere
+            void*           m_mappingHandle;
+    };
+}   // namespace keplar
@@ -0,0 +1,209 @@
+// ────────────────────────────────────────────
+//  File: profiler.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "profiler.hpp"
+
+#include <cstdio>
+#include <iomanip>
+#include "logger.hpp"
+
+namespace
+{
+    // writer wake-up interval; rings must not fill up in between
+    constexpr auto kWriterInterval = std::chrono::milliseconds(10);
+}
+
+namespace keplar
+{
+    Profiler& Profiler::getInstance() noexcept
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    Profiler::Profiler() noexcept
+        : m_epoch(clock::now())
+        , m_isActive(false)
+        , m_droppedZones(0)
+        , m_isFirstEvent(true)
+        , m_stopWriter(false)
+    {
+    }
+
+    Profiler::~Profiler()
+    {
+        endSession();
+    }
+
+    bool Profiler::beginSession(const std::filesystem::path& filepath) noexcept
+    {
+        endSession();
+
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        m_traceStream.open(filepath, std::ios::trunc);
+        if (!m_traceStream)
+        {
+            VK_LOG_ERROR("Profiler::beginSession : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        // discard zones recorded before the session
+        {
+            std::lock_guard<std::mutex> lock(m_ringMutex);
+            for (auto& ring : m_rings)
+            {
+                ring->mTail.store(ring->mHead.load(std::memory_order_acquire), std::memory_order_release);
+                ring->mIsNameWritten = false;
+            }
+        }
+
+        // chrome trace timestamps are microseconds; keep sub-microsecond precision over long sessions
+        m_traceStream << std::fixed << std::setprecision(3);
+        m_traceStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        m_isFirstEvent = true;
+        m_stopWriter = false;
+        m_droppedZones.store(0, std::memory_order_relaxed);
+        m_writer = std::thread(&Profiler::writerLoop, this);
+        m_isActive.store(true, std::memory_order_release);
+
+        VK_LOG_INFO("Profiler::beginSession : writing trace to %s", filepath.string().c_str());
+        return true;
+    }
+
+    void Profiler::endSession() noexcept
+    {
+        if (!m_writer.joinable())
+        {
+            return;
+        }
+
+        // stop recording, then let the writer drain what is left
+        m_isActive.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_stopWriter = true;
+        }
+
+        m_writerCv.notify_one();
+        m_writer.join();
+
+        m_traceStream << "]}\n";
+        m_traceStream.close();
+
+        const uint64_t droppedZones = m_droppedZones.load(std::memory_order_relaxed);
+        if (droppedZones > 0)
+        {
+            VK_LOG_WARN("Profiler::endSession : %llu zones dropped (ring full)", static_cast<unsigned long long>(droppedZones));
+        }
+    }
+
+    uint64_t Profiler::now() const noexcept
+    {
+        // offset by one so a valid timestamp is never zero
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_epoch).count()) + 1;
+    }
+
+    void Profiler::recordZone(const char* name, uint64_t beginNs, uint64_t endNs) noexcept
+    {
+        if (!isActive())
+        {
+            return;
+        }
+
+        ThreadRing* ring = getThreadRing();
+        if (!ring)
+        {
+            return;
+        }
+
+        // single producer: only this thread advances the head
+        const uint32_t head = ring->mHead.load(std::memory_order_relaxed);
+        if (head - ring->mTail.load(std::memory_order_acquire) >= kRingSize)
+        {
+            m_droppedZones.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ring->mZones[head % kRingSize] = Zone{ name, beginNs, endNs };
+        ring->mHead.store(head + 1, std::memory_order_release);
+    }
+
+    void Profiler::setThreadName(const char* name) noexcept
+    {
+        ThreadRing* ring = getThreadRing();
+        if (!ring || ring->mHasName.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        std::snprintf(ring->mThreadName, sizeof(ring->mThreadName), "%s", name);
+        ring->mHasName.store(true, std::memory_order_release);
+    }
+
+    Profiler::ThreadRing* Profiler::getThreadRing() noexcept
+    {
+        // one registration per thread, cached thread-locally
+        thread_local ThreadRing* threadRing = nullptr;
+        if (threadRing)
+        {
+            return threadRing;
+        }
+
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        auto ring = std::make_unique<ThreadRing>();
+        ring->mThreadId = static_cast<uint32_t>(m_rings.size() + 1);
+        threadRing = ring.get();
+        m_rings.push_back(std::move(ring));
+        return threadRing;
+    }
+
+    void Profiler::writerLoop() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        while (!m_stopWriter)
+        {
+            m_writerCv.wait_for(lock, kWriterInterval, [this]() { return m_stopWriter; });
+            drainRings();
+        }
+    }
+
+    void Profiler::drainRings() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        for (auto& ring : m_rings)
+        {
+            // metadata event naming the thread's track, once per session
+            if (!ring->mIsNameWritten && ring->mHasName.load(std::memory_order_acquire))
+            {
+                m_traceStream << (m_isFirstEvent ? "\n" : ",\n")
+                              << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->mThreadId
+                              << ",\"args\":{\"name\":\"" << ring->mThreadName << "\"}}";
+                m_isFirstEvent = false;
+                ring->mIsNameWritten = true;
+            }
+
+            // single consumer: only the writer advances the tail
+            const uint32_t tail = ring->mTail.load(std::memory_order_relaxed);
+            const uint32_t head = ring->mHead.load(std::memory_order_acquire);
+            for (uint32_t i = tail; i != head; ++i)
+            {
+                // complete events in microseconds
+                const Zone& zone = ring->mZones[i % kRingSize];
+                m_traceStream << (m_isFirstEvent ? "\n" : ",\n")
+                              << "{\"name\":\"" << zone.mName << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->mThreadId
+                              << ",\"ts\":" << static_cast<double>(zone.mBeginNs) * 1e-3
+                              << ",\"dur\":" << static_cast<double>(zone.mEndNs - zone.mBeginNs) * 1e-3 << "}";
+                m_isFirstEvent = false;
+            }
+
+            ring->mTail.store(head, std::memory_order_release);
+        }
+    }
+}   // namespace keplar
@@ -0,0 +1,145 @@
+// ────────────────────────────────────────────
+//  File: profiler.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <condition_variable>
+
+#define KEPLAR_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KEPLAR_PROFILE_CONCAT(a, b) KEPLAR_PROFILE_CONCAT_IMPL(a, b)
+
+// zero runtime overhead for cpu zones in release builds, like VK_LOG_TRACE. zone names must be string literals
+#ifndef NDEBUG
+    #define KEPLAR_PROFILE_ZONE(name) keplar::ProfileZone KEPLAR_PROFILE_CONCAT(_profileZone, __LINE__)(name)
+    #define KEPLAR_PROFILE_FUNCTION() KEPLAR_PROFILE_ZONE(__func__)
+    #define KEPLAR_PROFILE_BEGIN_SESSION(filepath) keplar::Profiler::getInstance().beginSession(filepath)
+    #define KEPLAR_PROFILE_END_SESSION() keplar::Profiler::getInstance().endSession()
+#else
+    #define KEPLAR_PROFILE_ZONE(name) ((void)0)
+    #define KEPLAR_PROFILE_FUNCTION() ((void)0)
+    #define KEPLAR_PROFILE_BEGIN_SESSION(filepath) ((void)0)
+    #define KEPLAR_PROFILE_END_SESSION() ((void)0)
+#endif
+
+namespace keplar
+{
+    // cpu zone profiler writing chrome trace (perfetto compatible) json. every thread records completed zones into
+    // its own single producer ring (no locks on the hot path, zones are dropped when a ring is full); a background
+    // writer drains the rings into the trace file while the session is open
+    class Profiler
+    {
+        public:
+            // singleton creation
+            static Profiler& getInstance() noexcept;
+
+            // disable copy and move semantics
+            Profiler(const Profiler&) = delete;
+            Profiler(Profiler&&) = delete;
+            Profiler& operator=(const Profiler&) = delete;
+            Profiler& operator=(Profiler&&) = delete;
+
+            // session control
+            bool beginSession(const std::filesystem::path& filepath) noexcept;
+            void endSession() noexcept;
+            bool isActive() const noexcept { return m_isActive.load(std::memory_order_relaxed); }
+
+            // usage: record a completed zone on the calling thread
+            void recordZone(const char* name, uint64_t beginNs, uint64_t endNs) noexcept;
+
+            // usage: once per thread; the trace labels the thread's track with it
+            void setThreadName(const char* name) noexcept;
+            uint64_t now() const noexcept;
+
+            // accessors
+            uint64_t getDroppedZoneCount() const noexcept { return m_droppedZones.load(std::memory_order_relaxed); }
+
+        private:
+            Profiler() noexcept;
+            ~Profiler();
+
+            static constexpr uint32_t kRingSize = 4096;     // zones per thread between two writer passes
+
+            struct Zone
+            {
+                const char* mName;
+                uint64_t    mBeginNs;
+                uint64_t    mEndNs;
+            };
+
+            // written by its thread (head), read by the writer (tail)
+            struct ThreadRing
+            {
+                std::array<Zone, kRingSize> mZones;
+                std::atomic<uint32_t>       mHead{ 0 };
+                std::atomic<uint32_t>       mTail{ 0 };
+                uint32_t                    mThreadId = 0;
+                char                        mThreadName[32] = {};
+                std::atomic<bool>           mHasName{ false };      // published by its thread after the name is written
+                bool                        mIsNameWritten = false; // writer: name emitted in the current session
+            };
+
+            ThreadRing* getThreadRing() noexcept;
+            void writerLoop() noexcept;
+            void drainRings() noexcept;
+
+        private:
+            using clock = std::chrono::steady_clock;
+
+            clock::time_point                           m_epoch;
+            std::atomic<bool>                           m_isActive;
+            std::atomic<uint64_t>                       m_droppedZones;
+
+            // rings are owned here and outlive their threads; registration is the only locked path
+            std::mutex                                  m_ringMutex;
+            std::vector<std::unique_ptr<ThreadRing>>    m_rings;
+
+            // background writer
+            std::mutex                                  m_writerMutex;
+            std::condition_variable                     m_writerCv;
+            std::thread                                 m_writer;
+            std::ofstream                               m_traceStream;
+            bool                                        m_isFirstEvent;
+            bool                                        m_stopWriter;
+    };
+
+    // raii cpu zone: records [construction, destruction) on the calling thread
+    class ProfileZone final
+    {
+        public:
+            explicit ProfileZone(const char* name) noexcept
+                : m_name(name)
+                , m_beginNs(Profiler::getInstance().isActive() ? Profiler::getInstance().now() : 0)
+            {
+            }
+
+            ~ProfileZone()
+            {
+                if (m_beginNs != 0)
+                {
+                    Profiler& profiler = Profiler::getInstance();
+                    profiler.recordZone(m_name, m_beginNs, profiler.now());
+                }
+            }
+
+            // disable copy and move semantics to enforce unique ownership
+            ProfileZone(const ProfileZone&) = delete;
+            ProfileZone& operator=(const ProfileZone&) = delete;
+            ProfileZone(ProfileZone&&) = delete;
+            ProfileZone& operator=(ProfileZone&&) = delete;
+
+        private:
+            const char* m_name;
+            uint64_t    m_beginNs;
+    };
+}   // namespace keplar
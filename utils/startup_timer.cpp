@@ -0,0 +1,199 @@
+// ────────────────────────────────────────────
+//  File: startup_timer.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "startup_timer.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <string_view>
+
+#include "logger.hpp"
+
+namespace
+{
+    // nesting of the open phases on this thread
+    thread_local uint32_t t_phaseDepth = 0;
+
+    double getMilliseconds(std::chrono::steady_clock::duration duration) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+namespace keplar
+{
+    StartupTimer& StartupTimer::getInstance() noexcept
+    {
+        static StartupTimer instance;
+        return instance;
+    }
+
+    StartupTimer::StartupTimer() noexcept
+        : m_start(clock::now())
+        , m_initialized(m_start)
+        , m_isRecording(false)
+    {
+    }
+
+    void StartupTimer::begin() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_start = clock::now();
+        m_initialized = m_start;
+        m_phases.clear();
+        m_threads.assign(1, std::this_thread::get_id());
+        m_isRecording.store(true, std::memory_order_relaxed);
+    }
+
+    void StartupTimer::markInitialized() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_initialized = clock::now();
+    }
+
+    void StartupTimer::finish(const std::filesystem::path& outputPath) noexcept
+    {
+        // only the first present reports
+        if (!m_isRecording.exchange(false, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        const clock::time_point end = clock::now();
+        double totalMs = 0.0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            StartupPhaseTiming& firstFrame = m_phases.emplace_back();
+            firstFrame.mName       = "first frame";
+            firstFrame.mStartMs    = getMilliseconds(m_initialized - m_start);
+            firstFrame.mDurationMs = getMilliseconds(end - m_initialized);
+            totalMs = getMilliseconds(end - m_start);
+
+            // json keeps the start order
+            std::stable_sort(m_phases.begin(), m_phases.end(), [](const StartupPhaseTiming& a, const StartupPhaseTiming& b)
+            {
+                return a.mStartMs < b.mStartMs;
+            });
+        }
+
+        logReport(totalMs);
+        writeJson(outputPath, totalMs);
+    }
+
+    void StartupTimer::recordPhase(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, uint32_t depth) noexcept
+    {
+        if (!isRecording())
+        {
+            return;
+        }
+
+        // steps are named after their call; the arguments are dropped
+        const std::string_view fullName(name);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        StartupPhaseTiming& phase = m_phases.emplace_back();
+        phase.mName       = std::string(fullName.substr(0, fullName.find('(')));
+        phase.mStartMs    = getMilliseconds(start - m_start);
+        phase.mDurationMs = getMilliseconds(end - start);
+        phase.mDepth      = depth;
+        phase.mThreadId   = getThreadId();
+    }
+
+    void StartupTimer::logReport(double totalMs) const noexcept
+    {
+        // longest first, so whatever dominates time to first frame leads; nested phases are part of their parent's time
+        std::vector<const StartupPhaseTiming*> sorted;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            sorted.reserve(m_phases.size());
+            for (const StartupPhaseTiming& phase : m_phases)
+            {
+                sorted.push_back(&phase);
+            }
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [](const StartupPhaseTiming* a, const StartupPhaseTiming* b)
+        {
+            return a->mDurationMs > b->mDurationMs;
+        });
+
+        VK_LOG_INFO("StartupTimer : %.2f ms to the first present, %zu phases", totalMs, sorted.size());
+        for (const StartupPhaseTiming* phase : sorted)
+        {
+            const double share = totalMs > 0.0 ? 100.0 * phase->mDurationMs / totalMs : 0.0;
+            VK_LOG_INFO("StartupTimer : %9.2f ms %5.1f%%  %*s%s%s", phase->mDurationMs, share, static_cast<int>(2 * phase->mDepth), "",
+                        phase->mName.c_str(), phase->mThreadId != 0 ? " (worker)" : "");
+        }
+    }
+
+    bool StartupTimer::writeJson(const std::filesystem::path& filepath, double totalMs) const noexcept
+    {
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            VK_LOG_ERROR("StartupTimer::writeJson : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        // phase names are literals from the code, nothing to escape
+        std::lock_guard<std::mutex> lock(m_mutex);
+        file << std::fixed << std::setprecision(4);
+        file << "{\n";
+        file << "  \"first_present_ms\": " << totalMs << ",\n";
+        file << "  \"phases\": [";
+        for (size_t i = 0; i < m_phases.size(); ++i)
+        {
+            const StartupPhaseTiming& phase = m_phases[i];
+            file << (i == 0 ? "\n" : ",\n");
+            file << "    { \"name\": \"" << phase.mName << "\", "
+                 << "\"start_ms\": " << phase.mStartMs << ", "
+                 << "\"duration_ms\": " << phase.mDurationMs << ", "
+                 << "\"depth\": " << phase.mDepth << ", "
+                 << "\"thread\": " << phase.mThreadId << " }";
+        }
+        file << "\n  ]\n}\n";
+
+        VK_LOG_INFO("StartupTimer::writeJson : %zu phases written to %s", m_phases.size(), filepath.string().c_str());
+        return static_cast<bool>(file);
+    }
+
+    uint32_t StartupTimer::getThreadId() noexcept
+    {
+        // called with m_mutex held
+        const std::thread::id id = std::this_thread::get_id();
+        const auto found = std::find(m_threads.begin(), m_threads.end(), id);
+        if (found != m_threads.end())
+        {
+            return static_cast<uint32_t>(found - m_threads.begin());
+        }
+        m_threads.push_back(id);
+        return static_cast<uint32_t>(m_threads.size() - 1);
+    }
+
+    // ─────────────── StartupPhase ───────────────
+
+    StartupPhase::StartupPhase(const char* name) noexcept
+        : m_name(name)
+        , m_start(std::chrono::steady_clock::now())
+        , m_depth(t_phaseDepth)
+        , m_isRecording(StartupTimer::getInstance().isRecording())
+    {
+        ++t_phaseDepth;
+    }
+
+    StartupPhase::~StartupPhase()
+    {
+        --t_phaseDepth;
+        if (m_isRecording)
+        {
+            StartupTimer::getInstance().recordPhase(m_name, m_start, std::chrono::steady_clock::now(), m_depth);
+        }
+    }
+}   // namespace keplar
@@ -0,0 +1,109 @@
+// ────────────────────────────────────────────
+//  File: startup_timer.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+
+#define KEPLAR_STARTUP_CONCAT_IMPL(a, b) a##b
+#define KEPLAR_STARTUP_CONCAT(a, b) KEPLAR_STARTUP_CONCAT_IMPL(a, b)
+
+// startup phases are timed in every build (a handful per run, recording stops at the first present). names must be
+// string literals; a step is named after its call, up to the argument list: KEPLAR_STARTUP_STEP(createSwapchain())
+#define KEPLAR_STARTUP_PHASE(name) keplar::StartupPhase KEPLAR_STARTUP_CONCAT(_startupPhase, __LINE__)(name)
+#define KEPLAR_STARTUP_STEP(call) keplar::StartupTimer::timeStep(#call, [&]() { return call; })
+
+namespace keplar
+{
+    // one timed phase, in milliseconds since StartupTimer::begin
+    struct StartupPhaseTiming
+    {
+        std::string mName;
+        double      mStartMs    = 0.0;
+        double      mDurationMs = 0.0;
+        uint32_t    mDepth      = 0;        // phases open around it on the same thread
+        uint32_t    mThreadId   = 0;        // 0: the thread that called begin
+    };
+
+    // time-to-first-frame breakdown: phases from begin (application start) to the first presented frame are
+    // collected from any thread; finish logs them longest first and writes them as json in start order
+    class StartupTimer
+    {
+        public:
+            // singleton creation
+            static StartupTimer& getInstance() noexcept;
+
+            // disable copy and move semantics
+            StartupTimer(const StartupTimer&) = delete;
+            StartupTimer(StartupTimer&&) = delete;
+            StartupTimer& operator=(const StartupTimer&) = delete;
+            StartupTimer& operator=(StartupTimer&&) = delete;
+
+            // usage: begin starts the clock, markInitialized ends initialization (the rest until finish is the first
+            // frame), finish records the first present and reports once; later calls and phases are ignored
+            void begin() noexcept;
+            void markInitialized() noexcept;
+            void finish(const std::filesystem::path& outputPath) noexcept;
+            void recordPhase(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, uint32_t depth) noexcept;
+
+            // accessors
+            bool isRecording() const noexcept { return m_isRecording.load(std::memory_order_relaxed); }
+
+            // times one initialization step and returns its result
+            template <typename Step>
+            static auto timeStep(const char* name, Step&& step);
+
+        private:
+            StartupTimer() noexcept;
+
+            void logReport(double totalMs) const noexcept;
+            bool writeJson(const std::filesystem::path& filepath, double totalMs) const noexcept;
+            uint32_t getThreadId() noexcept;
+
+        private:
+            using clock = std::chrono::steady_clock;
+
+            clock::time_point                   m_start;
+            clock::time_point                   m_initialized;
+            std::atomic<bool>                   m_isRecording;
+
+            mutable std::mutex                  m_mutex;
+            std::vector<StartupPhaseTiming>     m_phases;
+            std::vector<std::thread::id>        m_threads;      // index is the reported thread id
+    };
+
+    // raii phase: records [construction, destruction) while the startup timer is recording
+    class StartupPhase final
+    {
+        public:
+            explicit StartupPhase(const char* name) noexcept;
+            ~StartupPhase();
+
+            // disable copy and move semantics to enforce unique ownership
+            StartupPhase(const StartupPhase&) = delete;
+            StartupPhase& operator=(const StartupPhase&) = delete;
+            StartupPhase(StartupPhase&&) = delete;
+            StartupPhase& operator=(StartupPhase&&) = delete;
+
+        private:
+            const char*                             m_name;
+            std::chrono::steady_clock::time_point   m_start;
+            uint32_t                                m_depth;
+            bool                                    m_isRecording;
+    };
+
+    template <typename Step>
+    auto StartupTimer::timeStep(const char* name, Step&& step)
+    {
+        StartupPhase phase(name);
+        return step();
+    }
+}   // namespace keplar
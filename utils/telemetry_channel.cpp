@@ -0,0 +1,278 @@
+// ────────────────────────────────────────────
+//  File: telemetry_channel.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "telemetry_channel.hpp"
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    TelemetryChannel::TelemetryChannel() noexcept
+        : m_header(nullptr)
+        , m_size(0)
+        , m_slotCount(0)
+        , m_isPublisher(false)
+        , m_mappingHandle(nullptr)
+    {
+    }
+
+    TelemetryChannel::~TelemetryChannel()
+    {
+        close();
+    }
+
+    bool TelemetryChannel::create(const std::string& name, uint32_t slotCount) noexcept
+    {
+        close();
+        if (name.empty() || slotCount == 0)
+        {
+            VK_LOG_ERROR("TelemetryChannel::create failed: empty name or no slots");
+            return false;
+        }
+
+        if (!map(name, sizeof(TelemetryHeader) + static_cast<size_t>(slotCount) * sizeof(TelemetrySlot), true))
+        {
+            return false;
+        }
+
+        // fresh mappings are zero-filled: every slot starts at sequence 0, never the one of a complete sample
+        TelemetryHeader* header = new (m_header) TelemetryHeader{};
+        TelemetrySlot* slots = reinterpret_cast<TelemetrySlot*>(header + 1);
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            new (&slots[i]) TelemetrySlot{};
+        }
+        header->mVersion   = kTelemetryVersion;
+        header->mSlotCount = slotCount;
+        header->mSlotSize  = static_cast<uint32_t>(sizeof(TelemetrySlot));
+    #ifdef _WIN32
+        header->mProcessId = GetCurrentProcessId();
+    #else
+        header->mProcessId = static_cast<uint64_t>(getpid());
+    #endif
+
+        // readers check the magic last, so they never see a half initialized header
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header->mMagic, kTelemetryMagic, sizeof(kTelemetryMagic));
+
+        m_slotCount = slotCount;
+        VK_LOG_INFO("TelemetryChannel::create : publishing '%s' (%u slots, %zu bytes)", name.c_str(), slotCount, m_size);
+        return true;
+    }
+
+    bool TelemetryChannel::attach(const std::string& name) noexcept
+    {
+        close();
+        if (name.empty() || !map(name, 0, false))
+        {
+            return false;
+        }
+
+        const TelemetryHeader& header = *m_header;
+        if (m_size < sizeof(TelemetryHeader) || std::memcmp(header.mMagic, kTelemetryMagic, sizeof(kTelemetryMagic)) != 0)
+        {
+            VK_LOG_ERROR("TelemetryChannel::attach failed: '%s' is not a telemetry channel", name.c_str());
+            close();
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header.mVersion != kTelemetryVersion || header.mSlotSize != sizeof(TelemetrySlot) ||
+            m_size < sizeof(TelemetryHeader) + static_cast<size_t>(header.mSlotCount) * sizeof(TelemetrySlot))
+        {
+            VK_LOG_ERROR("TelemetryChannel::attach failed: '%s' has version %u and %u byte slots, expected version %u and %zu",
+                         name.c_str(), header.mVersion, header.mSlotSize, kTelemetryVersion, sizeof(TelemetrySlot));
+            close();
+            return false;
+        }
+
+        m_slotCount = header.mSlotCount;
+        return true;
+    }
+
+    void TelemetryChannel::close() noexcept
+    {
+        if (m_header == nullptr)
+        {
+            return;
+        }
+
+    #ifdef _WIN32
+        // the mapping goes away with its last handle, the publisher's included
+        UnmapViewOfFile(m_header);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    #else
+        munmap(m_header, m_size);
+        if (m_isPublisher)
+        {
+            shm_unlink(m_objectName.c_str());
+        }
+    #endif
+
+        m_header        = nullptr;
+        m_size          = 0;
+        m_slotCount     = 0;
+        m_isPublisher   = false;
+        m_mappingHandle = nullptr;
+        m_objectName.clear();
+    }
+
+    void TelemetryChannel::publish(const TelemetryFrame& frame) noexcept
+    {
+        if (!m_isPublisher)
+        {
+            return;
+        }
+
+        // sequence lock: odd while the frame is copied in, so a reader that copied across the write sees it changed
+        const uint64_t index = m_header->mWriteCount.load(std::memory_order_relaxed);
+        TelemetrySlot& slot = getSlot(index);
+        slot.mSequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.mFrame, &frame, sizeof(TelemetryFrame));
+        slot.mSequence.store(2 * (index + 1), std::memory_order_release);
+        m_header->mWriteCount.store(index + 1, std::memory_order_release);
+    }
+
+    bool TelemetryChannel::read(uint64_t index, TelemetryFrame& frame) const noexcept
+    {
+        if (m_header == nullptr)
+        {
+            return false;
+        }
+
+        const TelemetrySlot& slot = getSlot(index);
+        const uint64_t sequence = 2 * (index + 1);
+        if (slot.mSequence.load(std::memory_order_acquire) != sequence)
+        {
+            return false;
+        }
+        std::memcpy(&frame, &slot.mFrame, sizeof(TelemetryFrame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.mSequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    uint64_t TelemetryChannel::getWriteCount() const noexcept
+    {
+        return (m_header != nullptr) ? m_header->mWriteCount.load(std::memory_order_acquire) : 0;
+    }
+
+    uint64_t TelemetryChannel::getProcessId() const noexcept
+    {
+        return (m_header != nullptr) ? m_header->mProcessId : 0;
+    }
+
+    bool TelemetryChannel::map(const std::string& name, size_t size, bool isPublisher) noexcept
+    {
+    #ifdef _WIN32
+        const std::string objectName = "Local\\keplar_" + name;
+        const std::wstring wideName(objectName.begin(), objectName.end());
+
+        HANDLE mapping = nullptr;
+        if (isPublisher)
+        {
+            const uint64_t mappingSize = size;
+            mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(mappingSize >> 32),
+                                         static_cast<DWORD>(mappingSize & 0xFFFFFFFFu), wideName.c_str());
+        }
+        else
+        {
+            mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, wideName.c_str());
+        }
+        if (mapping == nullptr)
+        {
+            VK_LOG_ERROR("TelemetryChannel::map failed: %s of %s (error: %lu)", isPublisher ? "CreateFileMapping" : "OpenFileMapping",
+                         objectName.c_str(), GetLastError());
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, isPublisher ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+        if (view == nullptr)
+        {
+            VK_LOG_ERROR("TelemetryChannel::map failed: MapViewOfFile of %s (error: %lu)", objectName.c_str(), GetLastError());
+            CloseHandle(mapping);
+            return false;
+        }
+
+        // readers take the size of the whole section
+        if (!isPublisher)
+        {
+            MEMORY_BASIC_INFORMATION info{};
+            size = (VirtualQuery(view, &info, sizeof(info)) != 0) ? info.RegionSize : 0;
+        }
+        m_mappingHandle = mapping;
+    #else
+        const std::string objectName = "/keplar_" + name;
+
+        // a publisher that crashed leaves its object behind; a new one starts from a clean object rather than its ring
+        int fd = -1;
+        if (isPublisher)
+        {
+            shm_unlink(objectName.c_str());
+            fd = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                ::close(fd);
+                shm_unlink(objectName.c_str());
+                fd = -1;
+            }
+        }
+        else
+        {
+            fd = shm_open(objectName.c_str(), O_RDONLY, 0);
+            struct stat objectStat{};
+            if (fd >= 0 && (fstat(fd, &objectStat) != 0 || objectStat.st_size <= 0))
+            {
+                ::close(fd);
+                fd = -1;
+            }
+            size = (fd >= 0) ? static_cast<size_t>(objectStat.st_size) : 0;
+        }
+        if (fd < 0)
+        {
+            VK_LOG_ERROR("TelemetryChannel::map failed: shm_open of %s", objectName.c_str());
+            return false;
+        }
+
+        // the mapping keeps its own reference to the object, so the descriptor can go right away
+        void* view = mmap(nullptr, size, isPublisher ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            VK_LOG_ERROR("TelemetryChannel::map failed: mmap of %s", objectName.c_str());
+            if (isPublisher)
+            {
+                shm_unlink(objectName.c_str());
+            }
+            return false;
+        }
+    #endif
+
+        m_header      = static_cast<TelemetryHeader*>(view);
+        m_size        = size;
+        m_isPublisher = isPublisher;
+        m_objectName  = objectName;
+        return true;
+    }
+
+    TelemetrySlot& TelemetryChannel::getSlot(uint64_t index) const noexcept
+    {
+        TelemetrySlot* slots = reinterpret_cast<TelemetrySlot*>(m_header + 1);
+        return slots[index % m_slotCount];
+    }
+}   // namespace keplar
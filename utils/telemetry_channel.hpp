@@ -0,0 +1,137 @@
+// ────────────────────────────────────────────
+//  File: telemetry_channel.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "frame_metrics.hpp"
+
+namespace keplar
+{
+    // shared memory layout: a TelemetryHeader followed by mSlotCount TelemetrySlots, a ring the publisher overwrites
+    // oldest first. the layout is plain data of fixed size, so a reader built from a different revision checks the
+    // version and slot size instead of trusting the name
+    inline constexpr char     kTelemetryMagic[4]    = { 'K', 'T', 'E', 'L' };
+    inline constexpr uint32_t kTelemetryVersion     = 1;
+    inline constexpr uint32_t kTelemetryMaxPasses   = 32;
+    inline constexpr uint32_t kTelemetryMaxHeaps    = 16;      // VK_MAX_MEMORY_HEAPS
+    inline constexpr uint32_t kTelemetryNameLength  = 32;
+
+    struct TelemetryPercentiles
+    {
+        float mLatest = 0.0f;
+        float mP50    = 0.0f;
+        float mP95    = 0.0f;
+        float mP99    = 0.0f;
+    };
+
+    struct TelemetryPass
+    {
+        char     mName[kTelemetryNameLength];   // gpu profiler scope, truncated and null-terminated
+        uint32_t mDepth;
+        float    mMilliseconds;
+    };
+
+    struct TelemetryHeap
+    {
+        uint64_t mBudget;
+        uint64_t mUsage;
+    };
+
+    // one published sample, filled by the renderer every few frames
+    struct TelemetryFrame
+    {
+        uint64_t                mFrameNumber;
+        uint64_t                mTimestampUs;                                   // steady clock of the publisher
+        TelemetryPercentiles    mMetrics[static_cast<uint32_t>(FrameMetric::kCount)];   // over the FrameMetrics history window
+        uint64_t                mHitchCount;
+        uint32_t                mDrawCount;                                     // commands recorded by the latest frame
+        uint32_t                mBindCount;
+        uint32_t                mBarrierCount;
+        uint32_t                mPendingUploads;                                // texture streamer queue
+        uint32_t                mStreamedTextures;
+        uint32_t                mPassCount;
+        uint32_t                mHeapCount;
+        uint32_t                mReserved;
+        uint64_t                mStreamedBytes;
+        TelemetryPass           mPasses[kTelemetryMaxPasses];
+        TelemetryHeap           mHeaps[kTelemetryMaxHeaps];
+    };
+
+    struct TelemetryHeader
+    {
+        char                    mMagic[4];
+        uint32_t                mVersion;
+        uint32_t                mSlotCount;
+        uint32_t                mSlotSize;                                      // sizeof(TelemetrySlot)
+        uint64_t                mProcessId;
+        std::atomic<uint64_t>   mWriteCount;                                    // samples published so far
+    };
+
+    // the sequence is odd while the slot's frame is being written and 2 * (index + 1) once sample index is complete
+    struct TelemetrySlot
+    {
+        std::atomic<uint64_t>   mSequence;
+        TelemetryFrame          mFrame;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "telemetry channel atomics are shared between processes");
+
+    // live telemetry over a named shared memory ring, for monitoring a running instance without the overlay. a single
+    // publisher creates the channel and writes samples without locks or system calls; any number of readers, in this
+    // or other processes, attach to it by name and copy samples out under a per-slot sequence lock, retrying (or
+    // skipping) a slot the publisher overwrote meanwhile. readers never block the publisher, a reader that falls more
+    // than a ring behind only loses the samples in between. the posix object is /keplar_<name>, on windows the
+    // mapping Local\keplar_<name>
+    class TelemetryChannel
+    {
+        public:
+            static constexpr uint32_t kDefaultSlotCount = 256;
+
+            // creation and destruction
+            TelemetryChannel() noexcept;
+            ~TelemetryChannel();
+
+            // disable copy and move semantics to enforce unique ownership
+            TelemetryChannel(const TelemetryChannel&) = delete;
+            TelemetryChannel& operator=(const TelemetryChannel&) = delete;
+            TelemetryChannel(TelemetryChannel&&) = delete;
+            TelemetryChannel& operator=(TelemetryChannel&&) = delete;
+
+            // usage: the publisher creates the channel (replacing a stale one of the same name), readers attach to it
+            bool create(const std::string& name, uint32_t slotCount = kDefaultSlotCount) noexcept;
+            bool attach(const std::string& name) noexcept;
+            void close() noexcept;
+
+            // usage: publisher only, from one thread at a time
+            void publish(const TelemetryFrame& frame) noexcept;
+
+            // usage: readers. sample index (0 for the first one published) is copied into frame; false once it was
+            // overwritten, or while it is being written or not published yet
+            bool read(uint64_t index, TelemetryFrame& frame) const noexcept;
+            uint64_t getWriteCount() const noexcept;
+
+            // accessors
+            bool isOpen() const noexcept                { return m_header != nullptr; }
+            bool isPublisher() const noexcept           { return m_isPublisher; }
+            uint32_t getSlotCount() const noexcept      { return m_slotCount; }
+            uint64_t getProcessId() const noexcept;
+
+        private:
+            bool map(const std::string& name, size_t size, bool isPublisher) noexcept;
+            TelemetrySlot& getSlot(uint64_t index) const noexcept;
+
+        private:
+            TelemetryHeader*    m_header;
+            size_t              m_size;
+            uint32_t            m_slotCount;
+            bool                m_isPublisher;
+            std::string         m_objectName;
+            void*               m_mappingHandle;    // win32 mapping handle; unused elsewhere
+    };
+}   // namespace keplar
@@ -4,60 +4,87 @@
 
 #include "thread_pool.hpp"
 
+#include <chrono>
+
+namespace
+{
+    // marks threads that are not workers of the pool being queried
+    constexpr size_t kNoWorker = static_cast<size_t>(-1);
+
+    // identity of the pool worker running on the current thread
+    thread_local const keplar::ThreadPool*  tl_pool        = nullptr;
+    thread_local size_t                     tl_workerIndex = kNoWorker;
+    thread_local size_t                     tl_workerLane  = keplar::kTaskPriorityCount;    // lane the os settings match
+
+    size_t toLane(keplar::TaskPriority priority) noexcept
+    {
+        return static_cast<size_t>(priority);
+    }
+}
+
 namespace keplar
 {
-    ThreadPool::ThreadPool(size_t maxThreads) 
-        : m_stop(false)
+    std::array<ThreadPoolLane, kTaskPriorityCount> ThreadPoolConfig::getDefaultLanes() noexcept
+    {
+        const CpuTopology& topology = CpuTopology::getInstance();
+        std::array<ThreadPoolLane, kTaskPriorityCount> lanes{};
+        lanes[toLane(TaskPriority::kFrameCritical)].mPriority = ThreadPriority::kHigh;
+        lanes[toLane(TaskPriority::kBackground)].mPriority = ThreadPriority::kLow;
+        if (topology.isHybrid())
+        {
+            lanes[toLane(TaskPriority::kFrameCritical)].mAffinity = topology.getProcessors(CoreType::kPerformance);
+            lanes[toLane(TaskPriority::kBackground)].mAffinity = topology.getProcessors(CoreType::kEfficiency);
+        }
+        return lanes;
+    }
+
+    ThreadPool::ThreadPool(size_t maxThreads, size_t reservedFrameWorkers, const char* name)
+        : ThreadPool([&]()
+        {
+            ThreadPoolConfig config{};
+            config.mThreadCount = maxThreads;
+            config.mReservedFrameWorkers = reservedFrameWorkers;
+            config.mName = name;
+            return config;
+        }())
+    {
+    }
+
+    ThreadPool::ThreadPool(const ThreadPoolConfig& config)
+        : m_config(config)
+        , m_reservedWorkers(0)
+        , m_nextQueue(0)
+        , m_unfinishedTasks(0)
+        , m_stop(false)
     {
-        // fallback to at least one thread
-        maxThreads = std::max<size_t>(1, maxThreads);
+        // fallback to at least one thread, of which one is always free for non-frame work
+        const size_t maxThreads = std::max<size_t>(1, config.mThreadCount);
+        m_reservedWorkers = std::min(config.mReservedFrameWorkers, maxThreads - 1);
+        for (auto& queuedTasks : m_queuedTasks)
+        {
+            queuedTasks.store(0, std::memory_order_relaxed);
+        }
+
+        // one deque per worker, created before any worker can steal from it
+        m_queues.reserve(maxThreads);
+        for (size_t i = 0; i < maxThreads; ++i)
+        {
+            m_queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
 
         // spawn worker threads
         m_workers.reserve(maxThreads);
         for (size_t i = 0; i < maxThreads; ++i)
         {
-            m_workers.emplace_back([this]()
-            {
-                for (;;)
-                {
-                    {
-                        // wait until there's task or pool is stopping
-                        std::unique_lock<std::mutex> lock(m_mutex);
-                        m_taskAvailable.wait(lock, [this]()
-                        {
-                            return (m_stop || !m_tasks.empty());
-                        });
-
-                        // exit if stopped and no task is queued
-                        if (m_stop && m_tasks.empty())
-                        {
-                            return;
-                        }
-
-                        // fetch the next task
-                        TaskWrapper task = std::move(m_tasks.front());
-                        m_tasks.pop();
-
-                        // release mutex and execute the task
-                        lock.unlock();
-                        task();
-                    }
-
-                    // signal waitIdle() that all queued tasks have completed
-                    {
-                        std::unique_lock<std::mutex> lock(m_mutex);
-                        if (m_tasks.empty()) 
-                        {
-                            m_waitIdle.notify_all();
-                        }
-                    }
-                }
-            });
+            m_workers.emplace_back([this, i]() { workerLoop(i); });
         }
     }
 
     ThreadPool::~ThreadPool()
     {
+        // finish dispatched work, including tasks still waiting on dependencies
+        waitIdle();
+
         {
             std::unique_lock<std::mutex> lock(m_mutex);
             m_stop = true;
@@ -65,6 +92,7 @@ namespace keplar
 
         // wake up all workers so they can exit
         m_taskAvailable.notify_all();
+        m_frameTaskAvailable.notify_all();
 
         // join all worker threads
         for (auto& worker : m_workers)
@@ -76,13 +104,360 @@ namespace keplar
         }
     }
 
+    void ThreadPool::wait(const TaskHandle& handle)
+    {
+        if (!handle.m_state)
+        {
+            return;
+        }
+
+        // help with queued work at least as urgent as the task while it is pending; our own deque first when on a worker
+        TaskState& state = *handle.m_state;
+        const size_t queueIndex = (tl_pool == this) ? tl_workerIndex : kNoWorker;
+        const TaskPriority lowestPriority = std::min(state.mPriority, getLowestPriority(queueIndex));
+        while (!state.mIsDone.load(std::memory_order_acquire))
+        {
+            if (runPendingTask(queueIndex, lowestPriority))
+            {
+                continue;
+            }
+
+            // nothing to steal: the task runs elsewhere, recheck periodically for new work
+            std::unique_lock<std::mutex> lock(state.mMutex);
+            state.mCompleted.wait_for(lock, std::chrono::milliseconds(1), [&state]()
+            {
+                return state.mIsDone.load(std::memory_order_acquire);
+            });
+        }
+    }
+
     void ThreadPool::waitIdle()
     {
-        // wait until the queue is empty and all workers are idle
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_waitIdle.wait(lock, [this]()
+        // run queued work on the calling thread until every dispatched task has completed
+        while (m_unfinishedTasks.load(std::memory_order_acquire) != 0)
+        {
+            if (runPendingTask(kNoWorker, TaskPriority::kBackground))
+            {
+                continue;
+            }
+
+            // the remaining tasks run on workers or wait on dependencies, recheck periodically for new work
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_waitIdle.wait_for(lock, std::chrono::milliseconds(1), [this]()
+            {
+                return m_unfinishedTasks.load(std::memory_order_acquire) == 0;
+            });
+        }
+    }
+
+    void ThreadPool::waitGroup(TaskGroupState& group, TaskPriority priority)
+    {
+        const size_t queueIndex = (tl_pool == this) ? tl_workerIndex : kNoWorker;
+        const TaskPriority lowestPriority = std::min(priority, getLowestPriority(queueIndex));
+        while (group.mPendingTasks.load(std::memory_order_acquire) != 0)
+        {
+            // newest scheduled task of the group first; workers steal from the other end of their deques
+            std::shared_ptr<TaskState> state;
+            {
+                std::lock_guard<std::mutex> lock(group.mMutex);
+                if (!group.mReadyTasks.empty())
+                {
+                    state = std::move(group.mReadyTasks.back());
+                    group.mReadyTasks.pop_back();
+                }
+            }
+
+            if (state)
+            {
+                // the entry stays in its worker deque and is skipped there once claimed
+                if (!state->mIsClaimed.exchange(true, std::memory_order_acq_rel))
+                {
+                    execute(state);
+                }
+                continue;
+            }
+
+            // every group task is running or waits on a dependency; a worker keeps the pool moving meanwhile
+            if (queueIndex != kNoWorker && runPendingTask(queueIndex, lowestPriority))
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(group.mMutex);
+            group.mCompleted.wait_for(lock, std::chrono::milliseconds(1), [&group]()
+            {
+                return group.mPendingTasks.load(std::memory_order_acquire) == 0 || !group.mReadyTasks.empty();
+            });
+        }
+
+        // drop entries of tasks the workers ran
+        std::lock_guard<std::mutex> lock(group.mMutex);
+        group.mReadyTasks.clear();
+    }
+
+    TaskHandle ThreadPool::submit(TaskWrapper&& task, TaskPriority priority, const TaskHandle* dependencies, size_t dependencyCount,
+                                  const std::shared_ptr<TaskGroupState>& group)
+    {
+        // don’t accept new tasks on stop
+        if (m_stop.load(std::memory_order_acquire))
+        {
+            return TaskHandle{};
+        }
+
+        auto state = std::make_shared<TaskState>();
+        state->mTask.emplace(std::move(task));
+        state->mPriority = priority;
+        state->mGroup = group;
+        if (group)
+        {
+            group->mPendingTasks.fetch_add(1, std::memory_order_acq_rel);
+        }
+        state->mPendingDependencies.store(static_cast<uint32_t>(dependencyCount) + 1, std::memory_order_relaxed);
+        m_unfinishedTasks.fetch_add(1, std::memory_order_acq_rel);
+
+        // register with every unfinished dependency; finished ones are counted off immediately
+        for (size_t i = 0; i < dependencyCount; ++i)
+        {
+            const auto& dependency = dependencies[i].m_state;
+            bool isPending = false;
+            if (dependency)
+            {
+                std::lock_guard<std::mutex> lock(dependency->mMutex);
+                if (!dependency->mIsDone.load(std::memory_order_acquire))
+                {
+                    dependency->mSuccessors.push_back(state);
+                    isPending = true;
+                }
+            }
+
+            if (!isPending)
+            {
+                state->mPendingDependencies.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        // drop the registration guard; schedule now if nothing is outstanding
+        if (state->mPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            schedule(state);
+        }
+
+        return TaskHandle(std::move(state), this);
+    }
+
+    void ThreadPool::schedule(std::shared_ptr<TaskState> state)
+    {
+        // workers keep spawned tasks local; external threads spread work round-robin, other work past the reserved workers
+        const TaskPriority priority = state->mPriority;
+        const size_t lane = toLane(priority);
+        size_t queueIndex = tl_workerIndex;
+        if (tl_pool != this)
         {
-            return m_tasks.empty();
-        });
+            const size_t firstQueue = (priority == TaskPriority::kFrameCritical) ? 0 : m_reservedWorkers;
+            queueIndex = firstQueue + m_nextQueue.fetch_add(1, std::memory_order_relaxed) % (m_queues.size() - firstQueue);
+        }
+
+        // a group's joining thread may take the task before any worker does
+        if (state->mGroup)
+        {
+            TaskGroupState& group = *state->mGroup;
+            {
+                std::lock_guard<std::mutex> lock(group.mMutex);
+                group.mReadyTasks.push_back(state);
+            }
+            group.mCompleted.notify_all();
+        }
+
+        {
+            WorkerQueue& queue = *m_queues[queueIndex];
+            std::lock_guard<std::mutex> lock(queue.mMutex);
+            queue.mTasks[lane].emplace_back(std::move(state));
+        }
+
+        // publish under the sleep mutex so a worker about to sleep cannot miss it
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queuedTasks[lane].fetch_add(1, std::memory_order_release);
+        }
+
+        // notify a worker that a new task is available; frame work also wakes a reserved one
+        m_taskAvailable.notify_one();
+        if (priority == TaskPriority::kFrameCritical && m_reservedWorkers > 0)
+        {
+            m_frameTaskAvailable.notify_one();
+        }
+    }
+
+    bool ThreadPool::runPendingTask(size_t queueIndex, TaskPriority lowestPriority)
+    {
+        // lanes in order of urgency: a task is only taken once no more urgent one is queued anywhere
+        const size_t queueCount = m_queues.size();
+        for (size_t lane = 0; lane <= toLane(lowestPriority); ++lane)
+        {
+            if (m_queuedTasks[lane].load(std::memory_order_acquire) == 0)
+            {
+                continue;
+            }
+
+            std::shared_ptr<TaskState> state;
+
+            // own deque: newest task first (its data is most likely still in cache)
+            if (queueIndex != kNoWorker)
+            {
+                WorkerQueue& queue = *m_queues[queueIndex];
+                std::lock_guard<std::mutex> lock(queue.mMutex);
+                if (!queue.mTasks[lane].empty())
+                {
+                    state = std::move(queue.mTasks[lane].back());
+                    queue.mTasks[lane].pop_back();
+                }
+            }
+
+            // steal the oldest task from the other deques
+            const size_t start = (queueIndex != kNoWorker) ? queueIndex + 1 : 0;
+            for (size_t i = 0; !state && i < queueCount; ++i)
+            {
+                const size_t victim = (start + i) % queueCount;
+                if (victim == queueIndex)
+                {
+                    continue;
+                }
+
+                WorkerQueue& queue = *m_queues[victim];
+                std::lock_guard<std::mutex> lock(queue.mMutex);
+                if (!queue.mTasks[lane].empty())
+                {
+                    state = std::move(queue.mTasks[lane].front());
+                    queue.mTasks[lane].pop_front();
+                }
+            }
+
+            if (state)
+            {
+                // claimed by a joining group already: the entry is only dropped, the caller looks again
+                m_queuedTasks[lane].fetch_sub(1, std::memory_order_acq_rel);
+                if (state->mIsClaimed.exchange(true, std::memory_order_acq_rel))
+                {
+                    return true;
+                }
+
+                if (queueIndex != kNoWorker)
+                {
+                    applyLane(lane);
+                }
+                execute(state);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TaskPriority ThreadPool::getLowestPriority(size_t queueIndex) const noexcept
+    {
+        // reserved workers, and tasks helping while running on one, stay on frame work
+        return (queueIndex != kNoWorker && queueIndex < m_reservedWorkers) ? TaskPriority::kFrameCritical : TaskPriority::kBackground;
+    }
+
+    bool ThreadPool::hasQueuedTask(TaskPriority lowestPriority) const noexcept
+    {
+        for (size_t lane = 0; lane <= toLane(lowestPriority); ++lane)
+        {
+            if (m_queuedTasks[lane].load(std::memory_order_acquire) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::execute(const std::shared_ptr<TaskState>& state)
+    {
+        // run the task and release its captures
+        (*state->mTask)();
+        state->mTask.reset();
+
+        // mark it done and take over the tasks that waited on it
+        std::vector<std::shared_ptr<TaskState>> successors;
+        {
+            std::lock_guard<std::mutex> lock(state->mMutex);
+            state->mIsDone.store(true, std::memory_order_release);
+            successors.swap(state->mSuccessors);
+        }
+        state->mCompleted.notify_all();
+
+        // schedule successors whose last dependency this was
+        for (auto& successor : successors)
+        {
+            if (successor->mPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                schedule(std::move(successor));
+            }
+        }
+
+        // release the group (its ready list may still reference this task) and wake its join on the last task
+        if (std::shared_ptr<TaskGroupState> group = std::move(state->mGroup))
+        {
+            if (group->mPendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(group->mMutex);
+                group->mCompleted.notify_all();
+            }
+        }
+
+        // signal waitIdle() that all dispatched tasks have completed
+        if (m_unfinishedTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_waitIdle.notify_all();
+        }
+    }
+
+    void ThreadPool::applyLane(size_t lane) noexcept
+    {
+        if (tl_workerLane == lane)
+        {
+            return;
+        }
+
+        // refused settings (raised priority without privileges) leave the thread as it was
+        tl_workerLane = lane;
+        const ThreadPoolLane& config = m_config.mLanes[lane];
+        setCurrentThreadAffinity(config.mAffinity);
+        setCurrentThreadPriority(config.mPriority);
+    }
+
+    void ThreadPool::workerLoop(size_t index)
+    {
+        tl_pool        = this;
+        tl_workerIndex = index;
+
+        const std::string name = m_config.mName + " " + std::to_string(index);
+        setCurrentThreadName(name.c_str());
+
+        // reserved workers stay on the frame lane's cores; the others follow the lane of each task
+        const TaskPriority lowestPriority = getLowestPriority(index);
+        applyLane(toLane(lowestPriority == TaskPriority::kFrameCritical ? TaskPriority::kFrameCritical : TaskPriority::kNormal));
+        std::condition_variable& taskAvailable = (lowestPriority == TaskPriority::kFrameCritical) ? m_frameTaskAvailable : m_taskAvailable;
+        for (;;)
+        {
+            // keep running while there is local or stealable work
+            if (runPendingTask(index, lowestPriority))
+            {
+                continue;
+            }
+
+            // wait until there's task or pool is stopping
+            std::unique_lock<std::mutex> lock(m_mutex);
+            taskAvailable.wait(lock, [this, lowestPriority]()
+            {
+                return (m_stop || hasQueuedTask(lowestPriority));
+            });
+
+            // exit if stopped and no task is queued
+            if (m_stop && !hasQueuedTask(lowestPriority))
+            {
+                return;
+            }
+        }
     }
 }
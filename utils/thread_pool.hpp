@@ -4,90 +4,482 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <optional>
+#include <algorithm>
 #include <functional>
+#include <type_traits>
+#include <string>
+#include <initializer_list>
 #include <condition_variable>
 
+#include "cpu_topology.hpp"
+
 namespace keplar
 {
-    class TaskWrapper 
+    // move-only type-erased callable. closures up to kInlineSize bytes are stored in place,
+    // larger ones fall back to a single heap allocation.
+    class TaskWrapper
     {
-        public:            
+        public:
+            static constexpr size_t kInlineSize = 64;
+
             // construct from any callable (lambda, functor...) and type-erase it
-            template<typename F>
-            TaskWrapper(F&& f) : m_callable(std::make_unique<CallableImpl<std::decay_t<F>>>(std::forward<F>(f))) {}
+            template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TaskWrapper>>>
+            TaskWrapper(F&& f)
+            {
+                using Callable = std::decay_t<F>;
+                if constexpr (kIsInline<Callable>)
+                {
+                    ::new (static_cast<void*>(m_storage)) Callable(std::forward<F>(f));
+                    m_operations = &InlineCallable<Callable>::kOperations;
+                }
+                else
+                {
+                    ::new (static_cast<void*>(m_storage)) Callable*(new Callable(std::forward<F>(f)));
+                    m_operations = &HeapCallable<Callable>::kOperations;
+                }
+            }
+
+            ~TaskWrapper() { reset(); }
 
             // move-only semantics
-            TaskWrapper(TaskWrapper&&) = default;
-            TaskWrapper& operator=(TaskWrapper&&) = default;
+            TaskWrapper(TaskWrapper&& other) noexcept
+                : m_operations(other.m_operations)
+            {
+                if (m_operations)
+                {
+                    m_operations->mMove(other.m_storage, m_storage);
+                    other.m_operations = nullptr;
+                }
+            }
+
+            TaskWrapper& operator=(TaskWrapper&& other) noexcept
+            {
+                // avoid self-move
+                if (this != &other)
+                {
+                    reset();
+                    m_operations = other.m_operations;
+                    if (m_operations)
+                    {
+                        m_operations->mMove(other.m_storage, m_storage);
+                        other.m_operations = nullptr;
+                    }
+                }
+                return *this;
+            }
+
             TaskWrapper(const TaskWrapper&) = delete;
             TaskWrapper& operator=(const TaskWrapper&) = delete;
 
              // invoke the wrapped callable
-            void operator()() { (*m_callable)(); }
+            void operator()() { m_operations->mInvoke(m_storage); }
 
         private:
-             // abstract interface used for type-erasure
-            struct CallableBase
+            // per-type function table used for type-erasure
+            struct Operations
+            {
+                void (*mInvoke)(void* storage);
+                void (*mMove)(void* src, void* dst) noexcept;
+                void (*mDestroy)(void* storage) noexcept;
+            };
+
+            // callables stored in place must fit, be suitably aligned and move without throwing
+            template<typename F>
+            static constexpr bool kIsInline = sizeof(F) <= kInlineSize && 
+                                              alignof(F) <= alignof(std::max_align_t) && 
+                                              std::is_nothrow_move_constructible_v<F>;
+
+            // callable constructed inside m_storage
+            template<typename F>
+            struct InlineCallable
             {
-                virtual ~CallableBase() = default;
-                virtual void operator()() = 0; 
+                static F* get(void* storage) noexcept { return std::launder(static_cast<F*>(storage)); }
+                static void invoke(void* storage) { (*get(storage))(); }
+                static void move(void* src, void* dst) noexcept
+                {
+                    ::new (dst) F(std::move(*get(src)));
+                    get(src)->~F();
+                }
+                static void destroy(void* storage) noexcept { get(storage)->~F(); }
+                static constexpr Operations kOperations = { &invoke, &move, &destroy };
             };
 
-            // concrete implementation storing the actual callable
+            // callable on the heap, m_storage holds the pointer
             template<typename F>
-            struct CallableImpl : CallableBase
+            struct HeapCallable
             {
-                CallableImpl(F&& f) : mFunc(std::move(f)) {}
-                void operator()() override { mFunc(); }
-                F mFunc;
+                static F*& get(void* storage) noexcept { return *std::launder(static_cast<F**>(storage)); }
+                static void invoke(void* storage) { (*get(storage))(); }
+                static void move(void* src, void* dst) noexcept { ::new (dst) F*(get(src)); }
+                static void destroy(void* storage) noexcept { delete get(storage); }
+                static constexpr Operations kOperations = { &invoke, &move, &destroy };
             };
 
-            std::unique_ptr<CallableBase> m_callable;
+            void reset() noexcept
+            {
+                if (m_operations)
+                {
+                    m_operations->mDestroy(m_storage);
+                    m_operations = nullptr;
+                }
+            }
+
+            alignas(std::max_align_t) unsigned char m_storage[kInlineSize];
+            const Operations* m_operations = nullptr;
+    };
+
+    // forward declarations
+    class ThreadPool;
+    struct TaskGroupState;
+
+    // scheduling lanes, most urgent first. a free worker always takes the most urgent queued task, so a task only
+    // waits behind work that is already running (tasks are never interrupted)
+    enum class TaskPriority : uint8_t
+    {
+        kFrameCritical,     // work the current frame waits on: command recording, culling
+        kNormal,
+        kBackground         // streaming, decoding, file i/o
+    };
+
+    constexpr size_t kTaskPriorityCount = 3;
+
+    // where and how urgently a worker runs while it executes tasks of one lane (empty affinity: any processor)
+    struct ThreadPoolLane
+    {
+        CpuSet          mAffinity;
+        ThreadPriority  mPriority = ThreadPriority::kNormal;
+    };
+
+    // the default lanes follow the cpu topology: frame work on performance cores at high priority, background work
+    // on efficiency cores (any core on non-hybrid parts) at low priority, normal work anywhere
+    struct ThreadPoolConfig
+    {
+        size_t                                          mThreadCount = std::thread::hardware_concurrency();
+        size_t                                          mReservedFrameWorkers = 0;
+        std::string                                     mName = "worker";       // workers are named "<name> <index>"
+        std::array<ThreadPoolLane, kTaskPriorityCount>  mLanes = getDefaultLanes();
+
+        static std::array<ThreadPoolLane, kTaskPriorityCount> getDefaultLanes() noexcept;
+    };
+
+    // shared state of a dispatched task: the callable, its completion flag and the tasks waiting on it
+    struct TaskState
+    {
+        std::optional<TaskWrapper>                  mTask;
+        TaskPriority                                mPriority = TaskPriority::kNormal;
+        std::atomic<bool>                           mIsClaimed{ false };    // taken by a worker or a joining group
+        std::shared_ptr<TaskGroupState>             mGroup;                 // released once the task has run
+        std::atomic<uint32_t>                       mPendingDependencies{ 1 };
+        std::atomic<bool>                           mIsDone{ false };
+        std::mutex                                  mMutex;
+        std::condition_variable                     mCompleted;
+        std::vector<std::shared_ptr<TaskState>>     mSuccessors;
+    };
+
+    // handle to a dispatched task; usable as a dependency and to wait for completion.
+    // a default-constructed handle is treated as already complete.
+    class TaskHandle
+    {
+        public:
+            TaskHandle() noexcept = default;
+
+            // usage (wait helps the pool execute queued tasks instead of blocking idle)
+            void wait() const;
+
+            // accessors
+            bool isValid() const noexcept   { return m_state != nullptr; }
+            bool isDone() const noexcept    { return !m_state || m_state->mIsDone.load(std::memory_order_acquire); }
+
+        private:
+            friend class ThreadPool;
+            TaskHandle(std::shared_ptr<TaskState> state, ThreadPool* pool) noexcept
+                : m_state(std::move(state)), m_pool(pool) {}
+
+            std::shared_ptr<TaskState>  m_state;
+            ThreadPool*                 m_pool = nullptr;
     };
 
+    // tasks of one TaskGroup: the ones not finished yet, and the scheduled ones a joining thread may take
+    struct TaskGroupState
+    {
+        std::atomic<size_t>                         mPendingTasks{ 0 };
+        std::mutex                                  mMutex;
+        std::condition_variable                     mCompleted;
+        std::vector<std::shared_ptr<TaskState>>     mReadyTasks;
+    };
+
+    // handle to a dispatched task that produces a value
+    template<typename R>
+    class TaskFuture : public TaskHandle
+    {
+        public:
+            TaskFuture() noexcept = default;
+
+            // wait for the task and access its result
+            R& get() { wait(); return **m_result; }
+
+        private:
+            friend class ThreadPool;
+            TaskFuture(TaskHandle handle, std::shared_ptr<std::optional<R>> result) noexcept
+                : TaskHandle(std::move(handle)), m_result(std::move(result)) {}
+
+            std::shared_ptr<std::optional<R>> m_result;
+    };
+
+    // work-stealing pool: every worker owns a deque per priority lane, pops its own work lifo for locality
+    // and steals fifo from the others when it runs dry, one lane at a time from the most urgent. the first
+    // reservedFrameWorkers workers only ever run kFrameCritical tasks, so frame work finds a free worker
+    // however much background work is queued. a worker takes the affinity and priority of the lane it runs,
+    // switching (two system calls) only when consecutive tasks come from different lanes
     class ThreadPool final
     {
         public:
-            // creation and destruction
-            explicit ThreadPool(size_t maxThreads = std::thread::hardware_concurrency());
+            // creation and destruction (at least one worker stays unreserved)
+            explicit ThreadPool(size_t maxThreads = std::thread::hardware_concurrency(), size_t reservedFrameWorkers = 0,
+                                const char* name = "worker");
+            explicit ThreadPool(const ThreadPoolConfig& config);
             ~ThreadPool();
 
             // disable copy and move semantics to enforce unique ownership
             ThreadPool(const ThreadPool&) = delete;
             ThreadPool& operator=(const ThreadPool&) = delete;
             ThreadPool(ThreadPool&&) = delete;
-            ThreadPool& operator=(ThreadPool&&) = delete; 
+            ThreadPool& operator=(ThreadPool&&) = delete;
+
+            // dispatch the task to a worker thread for async execution (kNormal unless a priority is given)
+            template<typename F>
+            auto dispatch(F&& f)
+            {
+                return dispatchWith(TaskPriority::kNormal, nullptr, 0, std::forward<F>(f));
+            }
+
+            template<typename F>
+            auto dispatch(TaskPriority priority, F&& f)
+            {
+                return dispatchWith(priority, nullptr, 0, std::forward<F>(f));
+            }
+
+            // dispatch the task once every dependency has completed
+            template<typename F>
+            auto dispatchAfter(std::initializer_list<TaskHandle> dependencies, F&& f)
+            {
+                return dispatchWith(TaskPriority::kNormal, dependencies.begin(), dependencies.size(), std::forward<F>(f));
+            }
+
+            template<typename F>
+            auto dispatchAfter(const std::vector<TaskHandle>& dependencies, F&& f)
+            {
+                return dispatchWith(TaskPriority::kNormal, dependencies.data(), dependencies.size(), std::forward<F>(f));
+            }
+
+            template<typename F>
+            auto dispatchAfter(TaskPriority priority, std::initializer_list<TaskHandle> dependencies, F&& f)
+            {
+                return dispatchWith(priority, dependencies.begin(), dependencies.size(), std::forward<F>(f));
+            }
+
+            template<typename F>
+            auto dispatchAfter(TaskPriority priority, const std::vector<TaskHandle>& dependencies, F&& f)
+            {
+                return dispatchWith(priority, dependencies.data(), dependencies.size(), std::forward<F>(f));
+            }
+
+            // invoke f(index) for every index in [0, count), split into chunks of chunkSize (0 picks one)
+            template<typename F>
+            TaskHandle parallelFor(size_t count, size_t chunkSize, F&& f)
+            {
+                return parallelFor(TaskPriority::kNormal, count, chunkSize, std::forward<F>(f));
+            }
 
-            // dispatch the task to a worker thread for async execution
             template<typename F>
-            void dispatch(F&& f) 
+            TaskHandle parallelFor(TaskPriority priority, size_t count, size_t chunkSize, F&& f)
             {
+                if (count == 0)
+                {
+                    return TaskHandle{};
+                }
+
+                // aim for a few chunks per worker so stealing can balance uneven work
+                if (chunkSize == 0)
                 {
-                    // don’t accept new tasks on stop
-                    std::unique_lock<std::mutex> lock(m_mutex);
-                    if (m_stop) return;
+                    chunkSize = std::max<size_t>(1, count / (getThreadCount() * 4));
+                }
 
-                    // wrap lambda internally in UniqueTask
-                    m_tasks.emplace(TaskWrapper(std::forward<F>(f)));
+                // all chunks share a single copy of the callable
+                auto func = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
+                std::vector<TaskHandle> chunks;
+                chunks.reserve((count + chunkSize - 1) / chunkSize);
+                for (size_t begin = 0; begin < count; begin += chunkSize)
+                {
+                    const size_t end = std::min(count, begin + chunkSize);
+                    chunks.emplace_back(dispatch(priority, [func, begin, end]()
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            (*func)(i);
+                        }
+                    }));
                 }
 
-                // notify a worker that a new task is available
-                m_taskAvailable.notify_one();
+                // join task completes once every chunk has run
+                return dispatchAfter(priority, chunks, []() {});
             }
 
-            // wait until all queued tasks are finished
+            // wait for one task, executing queued tasks meanwhile (safe to call from a worker). only tasks at least as
+            // urgent as the awaited one are helped with, so waiting on frame work never picks up a long background job
+            void wait(const TaskHandle& handle);
+
+            // wait until all dispatched tasks are finished, executing queued tasks meanwhile (must not be called from a task)
             void waitIdle();
 
-        private:       
-            std::vector<std::thread>            m_workers;
-            std::queue<TaskWrapper>             m_tasks;
-            std::mutex                          m_mutex;
-            std::condition_variable             m_taskAvailable;
-            std::condition_variable             m_waitIdle;
-            bool                                m_stop;
+            // accessors
+            size_t getThreadCount() const noexcept { return m_workers.size(); }
+            size_t getReservedWorkerCount() const noexcept { return m_reservedWorkers; }
+
+        private:
+            friend class TaskGroup;
+
+            // per-worker task deques, one per priority lane
+            struct WorkerQueue
+            {
+                std::mutex                                                          mMutex;
+                std::array<std::deque<std::shared_ptr<TaskState>>, kTaskPriorityCount> mTasks;
+            };
+
+            template<typename F>
+            auto dispatchWith(TaskPriority priority, const TaskHandle* dependencies, size_t dependencyCount, F&& f,
+                              const std::shared_ptr<TaskGroupState>& group = nullptr)
+            {
+                using R = std::invoke_result_t<std::decay_t<F>&>;
+                if constexpr (std::is_void_v<R>)
+                {
+                    return submit(TaskWrapper(std::forward<F>(f)), priority, dependencies, dependencyCount, group);
+                }
+                else
+                {
+                    // result slot shared between the task and its future
+                    auto result = std::make_shared<std::optional<R>>();
+                    TaskHandle handle = submit(TaskWrapper([result, func = std::forward<F>(f)]() mutable { result->emplace(func()); }),
+                                               priority, dependencies, dependencyCount, group);
+                    return TaskFuture<R>(std::move(handle), std::move(result));
+                }
+            }
+
+            TaskHandle submit(TaskWrapper&& task, TaskPriority priority, const TaskHandle* dependencies, size_t dependencyCount,
+                              const std::shared_ptr<TaskGroupState>& group);
+            void waitGroup(TaskGroupState& group, TaskPriority priority);
+            void schedule(std::shared_ptr<TaskState> state);
+            bool runPendingTask(size_t queueIndex, TaskPriority lowestPriority);
+            TaskPriority getLowestPriority(size_t queueIndex) const noexcept;
+            bool hasQueuedTask(TaskPriority lowestPriority) const noexcept;
+            void execute(const std::shared_ptr<TaskState>& state);
+            void workerLoop(size_t index);
+            void applyLane(size_t lane) noexcept;
+
+        private:
+            ThreadPoolConfig                            m_config;
+            std::vector<std::thread>                    m_workers;
+            std::vector<std::unique_ptr<WorkerQueue>>   m_queues;
+            size_t                                      m_reservedWorkers;      // workers [0, m_reservedWorkers) run frame work only
+            std::atomic<size_t>                         m_nextQueue;
+            std::array<std::atomic<size_t>, kTaskPriorityCount> m_queuedTasks;  // per lane
+            std::atomic<size_t>                         m_unfinishedTasks;
+            std::atomic<bool>                           m_stop;
+
+            // sleeping workers and waitIdle() block here; reserved workers only wake for frame work
+            std::mutex                                  m_mutex;
+            std::condition_variable                     m_taskAvailable;
+            std::condition_variable                     m_frameTaskAvailable;
+            std::condition_variable                     m_waitIdle;
+    };
+
+    // fork/join scope over a pool: wait() runs the group's own tasks that no worker has started yet on the calling
+    // thread and returns as soon as every task of the group is done, whatever else the pool is busy with. a worker
+    // joining a group also helps with other tasks as urgent as the group's while its last tasks finish elsewhere,
+    // so nested joins cannot starve the pool
+    class TaskGroup final
+    {
+        public:
+            // creation and destruction (waits for the group)
+            explicit TaskGroup(ThreadPool& pool, TaskPriority priority = TaskPriority::kNormal)
+                : m_pool(pool), m_priority(priority), m_state(std::make_shared<TaskGroupState>()) {}
+            ~TaskGroup() { wait(); }
+
+            // disable copy and move semantics to enforce unique ownership
+            TaskGroup(const TaskGroup&) = delete;
+            TaskGroup& operator=(const TaskGroup&) = delete;
+            TaskGroup(TaskGroup&&) = delete;
+            TaskGroup& operator=(TaskGroup&&) = delete;
+
+            // dispatch a task into the group, optionally after dependencies (in or outside the group)
+            template<typename F>
+            auto dispatch(F&& f)
+            {
+                return m_pool.dispatchWith(m_priority, nullptr, 0, std::forward<F>(f), m_state);
+            }
+
+            template<typename F>
+            auto dispatchAfter(std::initializer_list<TaskHandle> dependencies, F&& f)
+            {
+                return m_pool.dispatchWith(m_priority, dependencies.begin(), dependencies.size(), std::forward<F>(f), m_state);
+            }
+
+            // invoke f(index) for every index in [0, count) as chunks of the group (0 picks the chunk size)
+            template<typename F>
+            void parallelFor(size_t count, size_t chunkSize, F&& f)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+
+                if (chunkSize == 0)
+                {
+                    chunkSize = std::max<size_t>(1, count / (m_pool.getThreadCount() * 4));
+                }
+
+                // all chunks share a single copy of the callable
+                auto func = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
+                for (size_t begin = 0; begin < count; begin += chunkSize)
+                {
+                    const size_t end = std::min(count, begin + chunkSize);
+                    dispatch([func, begin, end]()
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            (*func)(i);
+                        }
+                    });
+                }
+            }
+
+            // usage: join; the group can take new tasks afterwards
+            void wait() { m_pool.waitGroup(*m_state, m_priority); }
+
+            // accessors
+            bool isDone() const noexcept { return m_state->mPendingTasks.load(std::memory_order_acquire) == 0; }
+
+        private:
+            ThreadPool&                         m_pool;
+            TaskPriority                        m_priority;
+            std::shared_ptr<TaskGroupState>     m_state;
     };
+
+    inline void TaskHandle::wait() const
+    {
+        if (m_state && m_pool)
+        {
+            m_pool->wait(*this);
+        }
+    }
 }
@@ -16,6 +16,7 @@ namespace keplar
 
             // usage
             float tick() noexcept;
+            void reset() noexcept { m_initialized = false; }     // the next tick reports a nominal step instead of the gap
 
         private:
             using clock = std::chrono::steady_clock;
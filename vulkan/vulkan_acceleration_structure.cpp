@@ -0,0 +1,197 @@
+// ────────────────────────────────────────────
+//  File: vulkan_acceleration_structure.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_acceleration_structure.hpp"
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanAccelerationStructure::VulkanAccelerationStructure() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkAccelerationStructure(VK_NULL_HANDLE)
+        , m_deviceAddress(0)
+        , m_size(0)
+    {
+    }
+
+    VulkanAccelerationStructure::VulkanAccelerationStructure(VulkanAccelerationStructure&& other) noexcept
+        : m_vkDevice(other.m_vkDevice)
+        , m_vkAccelerationStructure(other.m_vkAccelerationStructure)
+        , m_deviceAddress(other.m_deviceAddress)
+        , m_buffer(std::move(other.m_buffer))
+        , m_size(other.m_size)
+    {
+        other.m_vkDevice = VK_NULL_HANDLE;
+        other.m_vkAccelerationStructure = VK_NULL_HANDLE;
+        other.m_deviceAddress = 0;
+        other.m_size = 0;
+    }
+
+    VulkanAccelerationStructure& VulkanAccelerationStructure::operator=(VulkanAccelerationStructure&& other) noexcept
+    {
+        // avoid self-move
+        if (this != &other)
+        {
+            destroy();
+
+            // transfer ownership
+            m_vkDevice = other.m_vkDevice;
+            m_vkAccelerationStructure = other.m_vkAccelerationStructure;
+            m_deviceAddress = other.m_deviceAddress;
+            m_buffer = std::move(other.m_buffer);
+            m_size = other.m_size;
+
+            // reset the other
+            other.m_vkDevice = VK_NULL_HANDLE;
+            other.m_vkAccelerationStructure = VK_NULL_HANDLE;
+            other.m_deviceAddress = 0;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    bool VulkanAccelerationStructure::initialize(const VulkanDevice& device, VkAccelerationStructureTypeKHR type, VkDeviceSize size) noexcept
+    {
+        if (!device.isRayQueryEnabled() || !isAccelerationStructureLoaded())
+        {
+            VK_LOG_ERROR("VulkanAccelerationStructure::initialize failed: ray query is not enabled on the device");
+            return false;
+        }
+
+        if (size == 0)
+        {
+            VK_LOG_ERROR("VulkanAccelerationStructure::initialize failed: empty structure");
+            return false;
+        }
+
+        destroy();
+
+        // storage the driver lays the structure out in
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferCreateInfo.size = size;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_buffer.createDeviceLocal(device, bufferCreateInfo))
+        {
+            VK_LOG_ERROR("VulkanAccelerationStructure::initialize failed to create a %llu byte buffer", static_cast<unsigned long long>(size));
+            return false;
+        }
+
+        m_vkDevice = device.getDevice();
+        m_size = size;
+
+        VkAccelerationStructureCreateInfoKHR createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+        createInfo.pNext = nullptr;
+        createInfo.createFlags = 0;
+        createInfo.buffer = m_buffer.get();
+        createInfo.offset = 0;
+        createInfo.size = size;
+        createInfo.type = type;
+        createInfo.deviceAddress = 0;
+
+        VkResult result = s_vkCreateAccelerationStructureKHR(m_vkDevice, &createInfo, nullptr, &m_vkAccelerationStructure);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkCreateAccelerationStructureKHR failed with error code %d", result);
+            destroy();
+            return false;
+        }
+
+        VkAccelerationStructureDeviceAddressInfoKHR addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.pNext = nullptr;
+        addressInfo.accelerationStructure = m_vkAccelerationStructure;
+        m_deviceAddress = s_vkGetAccelerationStructureDeviceAddressKHR(m_vkDevice, &addressInfo);
+        return true;
+    }
+
+    void VulkanAccelerationStructure::destroy() noexcept
+    {
+        if (m_vkAccelerationStructure != VK_NULL_HANDLE)
+        {
+            s_vkDestroyAccelerationStructureKHR(m_vkDevice, m_vkAccelerationStructure, nullptr);
+            m_vkAccelerationStructure = VK_NULL_HANDLE;
+        }
+
+        m_buffer = VulkanBuffer();
+        m_deviceAddress = 0;
+        m_size = 0;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    VkAccelerationStructureBuildSizesInfoKHR VulkanAccelerationStructure::getBuildSizes(VkDevice vkDevice, const VkAccelerationStructureBuildGeometryInfoKHR& buildInfo,
+                                                                                        const uint32_t* maxPrimitiveCounts) noexcept
+    {
+        VkAccelerationStructureBuildSizesInfoKHR sizesInfo{};
+        sizesInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+        sizesInfo.pNext = nullptr;
+        if (isAccelerationStructureLoaded())
+        {
+            s_vkGetAccelerationStructureBuildSizesKHR(vkDevice, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, maxPrimitiveCounts, &sizesInfo);
+        }
+        return sizesInfo;
+    }
+
+    void VulkanAccelerationStructure::cmdBuild(VkCommandBuffer vkCommandBuffer, uint32_t infoCount, const VkAccelerationStructureBuildGeometryInfoKHR* buildInfos,
+                                               const VkAccelerationStructureBuildRangeInfoKHR* const* rangeInfos) noexcept
+    {
+        if (infoCount > 0 && isAccelerationStructureLoaded())
+        {
+            s_vkCmdBuildAccelerationStructuresKHR(vkCommandBuffer, infoCount, buildInfos, rangeInfos);
+        }
+    }
+
+    void VulkanAccelerationStructure::cmdWriteCompactedSizes(VkCommandBuffer vkCommandBuffer, uint32_t count, const VkAccelerationStructureKHR* structures,
+                                                             VkQueryPool queryPool, uint32_t firstQuery) noexcept
+    {
+        if (count > 0 && isAccelerationStructureLoaded())
+        {
+            s_vkCmdWriteAccelerationStructuresPropertiesKHR(vkCommandBuffer, count, structures, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+                                                            queryPool, firstQuery);
+        }
+    }
+
+    void VulkanAccelerationStructure::cmdCompact(VkCommandBuffer vkCommandBuffer, VkAccelerationStructureKHR source, VkAccelerationStructureKHR destination) noexcept
+    {
+        if (!isAccelerationStructureLoaded())
+        {
+            return;
+        }
+
+        VkCopyAccelerationStructureInfoKHR copyInfo{};
+        copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+        copyInfo.pNext = nullptr;
+        copyInfo.src = source;
+        copyInfo.dst = destination;
+        copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+        s_vkCmdCopyAccelerationStructureKHR(vkCommandBuffer, &copyInfo);
+    }
+
+    bool VulkanAccelerationStructure::loadAccelerationStructure(VkDevice vkDevice) noexcept
+    {
+        s_vkCreateAccelerationStructureKHR = (PFN_vkCreateAccelerationStructureKHR)vkGetDeviceProcAddr(vkDevice, "vkCreateAccelerationStructureKHR");
+        s_vkDestroyAccelerationStructureKHR = (PFN_vkDestroyAccelerationStructureKHR)vkGetDeviceProcAddr(vkDevice, "vkDestroyAccelerationStructureKHR");
+        s_vkGetAccelerationStructureBuildSizesKHR = (PFN_vkGetAccelerationStructureBuildSizesKHR)vkGetDeviceProcAddr(vkDevice, "vkGetAccelerationStructureBuildSizesKHR");
+        s_vkGetAccelerationStructureDeviceAddressKHR = (PFN_vkGetAccelerationStructureDeviceAddressKHR)vkGetDeviceProcAddr(vkDevice, "vkGetAccelerationStructureDeviceAddressKHR");
+        s_vkCmdBuildAccelerationStructuresKHR = (PFN_vkCmdBuildAccelerationStructuresKHR)vkGetDeviceProcAddr(vkDevice, "vkCmdBuildAccelerationStructuresKHR");
+        s_vkCmdWriteAccelerationStructuresPropertiesKHR = (PFN_vkCmdWriteAccelerationStructuresPropertiesKHR)vkGetDeviceProcAddr(vkDevice, "vkCmdWriteAccelerationStructuresPropertiesKHR");
+        s_vkCmdCopyAccelerationStructureKHR = (PFN_vkCmdCopyAccelerationStructureKHR)vkGetDeviceProcAddr(vkDevice, "vkCmdCopyAccelerationStructureKHR");
+        if (s_vkCreateAccelerationStructureKHR == nullptr || s_vkDestroyAccelerationStructureKHR == nullptr ||
+            s_vkGetAccelerationStructureBuildSizesKHR == nullptr || s_vkGetAccelerationStructureDeviceAddressKHR == nullptr ||
+            s_vkCmdBuildAccelerationStructuresKHR == nullptr || s_vkCmdWriteAccelerationStructuresPropertiesKHR == nullptr ||
+            s_vkCmdCopyAccelerationStructureKHR == nullptr)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get acceleration structure function pointers");
+            s_vkCmdBuildAccelerationStructuresKHR = nullptr;
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
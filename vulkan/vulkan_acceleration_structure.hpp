@@ -0,0 +1,83 @@
+// ────────────────────────────────────────────
+//  File: vulkan_acceleration_structure.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // VK_KHR_acceleration_structure (VulkanDevice::isRayQueryEnabled): one bottom-level (triangles) or top-level
+    // (instances) structure in a device-local buffer of its own, created at the size a build or a compacting copy
+    // asks for. contents are undefined until a build or copy recorded with the static commands below completes.
+    // builds read their geometry and scratch through device addresses, so inputs are created with
+    // VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR and scratch with storage usage, both
+    // with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    class VulkanAccelerationStructure final
+    {
+        public:
+            // creation and destruction
+            VulkanAccelerationStructure() noexcept;
+            ~VulkanAccelerationStructure() { destroy(); }
+
+            // disable copy semantics to enforce unique ownership
+            VulkanAccelerationStructure(const VulkanAccelerationStructure&) = delete;
+            VulkanAccelerationStructure& operator=(const VulkanAccelerationStructure&) = delete;
+
+            // move semantics, so structures live in vectors and retire through the deletion queue
+            VulkanAccelerationStructure(VulkanAccelerationStructure&& other) noexcept;
+            VulkanAccelerationStructure& operator=(VulkanAccelerationStructure&& other) noexcept;
+
+            bool initialize(const VulkanDevice& device, VkAccelerationStructureTypeKHR type, VkDeviceSize size) noexcept;
+            void destroy() noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_vkAccelerationStructure != VK_NULL_HANDLE; }
+            VkAccelerationStructureKHR get() const noexcept { return m_vkAccelerationStructure; }
+            VkDeviceAddress getDeviceAddress() const noexcept { return m_deviceAddress; }      // what instances reference
+            VkDeviceSize getSize() const noexcept { return m_size; }
+
+            // usage: memory a build of the geometries needs, for at most maxPrimitiveCounts primitives per geometry
+            static VkAccelerationStructureBuildSizesInfoKHR getBuildSizes(VkDevice vkDevice, const VkAccelerationStructureBuildGeometryInfoKHR& buildInfo,
+                                                                          const uint32_t* maxPrimitiveCounts) noexcept;
+
+            // usage: recording. builds of one call run concurrently, so their destinations and scratch ranges must not
+            // overlap; a barrier on VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR orders dependent builds
+            static void cmdBuild(VkCommandBuffer vkCommandBuffer, uint32_t infoCount, const VkAccelerationStructureBuildGeometryInfoKHR* buildInfos,
+                                 const VkAccelerationStructureBuildRangeInfoKHR* const* rangeInfos) noexcept;
+            // writes the compacted size of each structure (built with ALLOW_COMPACTION) into consecutive queries of a
+            // VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR pool, reset beforehand
+            static void cmdWriteCompactedSizes(VkCommandBuffer vkCommandBuffer, uint32_t count, const VkAccelerationStructureKHR* structures,
+                                               VkQueryPool queryPool, uint32_t firstQuery) noexcept;
+            // copies source into a destination created at its compacted size
+            static void cmdCompact(VkCommandBuffer vkCommandBuffer, VkAccelerationStructureKHR source, VkAccelerationStructureKHR destination) noexcept;
+
+            // loaded by the device that enables the extension
+            static bool loadAccelerationStructure(VkDevice vkDevice) noexcept;
+            static bool isAccelerationStructureLoaded() noexcept { return s_vkCmdBuildAccelerationStructuresKHR != nullptr; }
+
+        private:
+            // vulkan handles
+            VkDevice                            m_vkDevice;
+            VkAccelerationStructureKHR          m_vkAccelerationStructure;
+            VkDeviceAddress                     m_deviceAddress;
+
+            // storage the structure is placed in
+            VulkanBuffer                        m_buffer;
+            VkDeviceSize                        m_size;
+
+            // extension commands, shared by every instance
+            inline static PFN_vkCreateAccelerationStructureKHR                  s_vkCreateAccelerationStructureKHR = nullptr;
+            inline static PFN_vkDestroyAccelerationStructureKHR                 s_vkDestroyAccelerationStructureKHR = nullptr;
+            inline static PFN_vkGetAccelerationStructureBuildSizesKHR           s_vkGetAccelerationStructureBuildSizesKHR = nullptr;
+            inline static PFN_vkGetAccelerationStructureDeviceAddressKHR        s_vkGetAccelerationStructureDeviceAddressKHR = nullptr;
+            inline static PFN_vkCmdBuildAccelerationStructuresKHR               s_vkCmdBuildAccelerationStructuresKHR = nullptr;
+            inline static PFN_vkCmdWriteAccelerationStructuresPropertiesKHR     s_vkCmdWriteAccelerationStructuresPropertiesKHR = nullptr;
+            inline static PFN_vkCmdCopyAccelerationStructureKHR                 s_vkCmdCopyAccelerationStructureKHR = nullptr;
+    };
+}   // namespace keplar
@@ -0,0 +1,110 @@
+// ────────────────────────────────────────────
+//  File: vulkan_allocation_callbacks.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_allocation_callbacks.hpp"
+
+#ifdef KEPLAR_TRACK_ALLOCATIONS
+    #include <algorithm>
+    #include <cstdlib>
+    #include <cstring>
+    #ifdef _WIN32
+        #include <malloc.h>
+    #endif
+
+    #include "utils/allocation_tracker.hpp"
+#endif
+
+#ifdef KEPLAR_TRACK_ALLOCATIONS
+namespace 
+{
+    // reallocation needs the old size, which the driver does not pass: every block is prefixed with its size and the
+    // distance back to the start of the underlying allocation
+    struct BlockHeader
+    {
+        size_t mSize;
+        size_t mOffset;
+    };
+
+    constexpr size_t kMinAlignment = 16;
+    static_assert(sizeof(BlockHeader) <= kMinAlignment, "BlockHeader must fit the minimum alignment");
+
+    BlockHeader* getHeader(void* memory) noexcept
+    {
+        return reinterpret_cast<BlockHeader*>(static_cast<char*>(memory) - sizeof(BlockHeader));
+    }
+
+    void* VKAPI_PTR allocate(void* /* pUserData */, size_t size, size_t alignment, VkSystemAllocationScope /* scope */)
+    {
+        // the header sits in the aligned padding in front of the block
+        alignment = std::max(alignment, kMinAlignment);
+        const size_t offset = alignment;
+    #ifdef _WIN32
+        char* base = static_cast<char*>(_aligned_malloc(size + offset, alignment));
+    #else
+        void* allocation = nullptr;
+        char* base = posix_memalign(&allocation, alignment, size + offset) == 0 ? static_cast<char*>(allocation) : nullptr;
+    #endif
+        if (!base)
+        {
+            return nullptr;
+        }
+
+        keplar::AllocationTracker::recordVulkanAllocation(size);
+        void* memory = base + offset;
+        *getHeader(memory) = { size, offset };
+        return memory;
+    }
+
+    void VKAPI_PTR free(void* /* pUserData */, void* memory)
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        char* base = static_cast<char*>(memory) - getHeader(memory)->mOffset;
+    #ifdef _WIN32
+        _aligned_free(base);
+    #else
+        std::free(base);
+    #endif
+    }
+
+    void* VKAPI_PTR reallocate(void* pUserData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (!original)
+        {
+            return allocate(pUserData, size, alignment, scope);
+        }
+        if (size == 0)
+        {
+            free(pUserData, original);
+            return nullptr;
+        }
+
+        // on failure the original block stays valid, as the spec requires
+        void* memory = allocate(pUserData, size, alignment, scope);
+        if (memory)
+        {
+            std::memcpy(memory, original, std::min(size, getHeader(original)->mSize));
+            free(pUserData, original);
+        }
+        return memory;
+    }
+
+    const VkAllocationCallbacks kAllocationCallbacks = { nullptr, allocate, reallocate, free, nullptr, nullptr };
+}
+#endif
+
+namespace keplar
+{
+    const VkAllocationCallbacks* getVulkanAllocationCallbacks() noexcept
+    {
+    #ifdef KEPLAR_TRACK_ALLOCATIONS
+        return &kAllocationCallbacks;
+    #else
+        return nullptr;
+    #endif
+    }
+}   // namespace keplar
@@ -0,0 +1,14 @@
+// ────────────────────────────────────────────
+//  File: vulkan_allocation_callbacks.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // host allocation callbacks of the instance and device: counted by the AllocationTracker in KEPLAR_TRACK_ALLOCATIONS
+    // builds, nullptr (the driver's own allocator) otherwise. create and destroy of an object must pass the same value
+    const VkAllocationCallbacks* getVulkanAllocationCallbacks() noexcept;
+}   // namespace keplar
@@ -0,0 +1,299 @@
+// ────────────────────────────────────────────
+//  File: vulkan_barrier_batch.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_barrier_batch.hpp"
+
+#include <algorithm>
+
+#include "vulkan_command_counters.hpp"
+
+namespace
+{
+    // synchronization2 stages without a legacy bit of their own
+    constexpr VkPipelineStageFlags2 kTransferStages2    = VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_RESOLVE_BIT |
+                                                          VK_PIPELINE_STAGE_2_BLIT_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT;
+    constexpr VkPipelineStageFlags2 kVertexInputStages2 = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+
+    // every legacy stage and access bit keeps its value in the 64-bit masks
+    constexpr uint64_t kLegacyBits = 0xFFFFFFFFull;
+
+    VkPipelineStageFlags toLegacyStages(VkPipelineStageFlags2 stages, VkPipelineStageFlags emptyStage) noexcept
+    {
+        VkPipelineStageFlags legacy = static_cast<VkPipelineStageFlags>(stages & kLegacyBits);
+        if (stages & kTransferStages2)                                  { legacy |= VK_PIPELINE_STAGE_TRANSFER_BIT; }
+        if (stages & kVertexInputStages2)                               { legacy |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT; }
+        if (stages & VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT) { legacy |= VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT; }
+
+        // legacy barriers need a stage on both sides; none maps to the end of the pipe it waits on
+        return legacy != 0 ? legacy : emptyStage;
+    }
+
+    VkAccessFlags toLegacyAccess(VkAccessFlags2 access) noexcept
+    {
+        VkAccessFlags legacy = static_cast<VkAccessFlags>(access & kLegacyBits);
+        if (access & (VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT)) { legacy |= VK_ACCESS_SHADER_READ_BIT; }
+        if (access & VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT)                                        { legacy |= VK_ACCESS_SHADER_WRITE_BIT; }
+        return legacy;
+    }
+
+    // one vkCmdPipelineBarrier for the whole set: legacy barriers share a single pair of stage masks
+    void recordLegacy(VkCommandBuffer vkCommandBuffer,
+                      uint32_t memoryBarrierCount, const VkMemoryBarrier2* pMemoryBarriers,
+                      uint32_t bufferBarrierCount, const VkBufferMemoryBarrier2* pBufferBarriers,
+                      uint32_t imageBarrierCount, const VkImageMemoryBarrier2* pImageBarriers) noexcept
+    {
+        // reused per thread, so batches recorded every frame do not allocate
+        thread_local std::vector<VkMemoryBarrier>       tl_memoryBarriers;
+        thread_local std::vector<VkBufferMemoryBarrier> tl_bufferBarriers;
+        thread_local std::vector<VkImageMemoryBarrier>  tl_imageBarriers;
+        tl_memoryBarriers.resize(memoryBarrierCount);
+        tl_bufferBarriers.resize(bufferBarrierCount);
+        tl_imageBarriers.resize(imageBarrierCount);
+
+        VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+        VkPipelineStageFlags2 dstStages = VK_PIPELINE_STAGE_2_NONE;
+        for (uint32_t i = 0; i < memoryBarrierCount; ++i)
+        {
+            const VkMemoryBarrier2& barrier2 = pMemoryBarriers[i];
+            VkMemoryBarrier& barrier = tl_memoryBarriers[i];
+            barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.pNext         = nullptr;
+            barrier.srcAccessMask = toLegacyAccess(barrier2.srcAccessMask);
+            barrier.dstAccessMask = toLegacyAccess(barrier2.dstAccessMask);
+            srcStages |= barrier2.srcStageMask;
+            dstStages |= barrier2.dstStageMask;
+        }
+
+        for (uint32_t i = 0; i < bufferBarrierCount; ++i)
+        {
+            const VkBufferMemoryBarrier2& barrier2 = pBufferBarriers[i];
+            VkBufferMemoryBarrier& barrier = tl_bufferBarriers[i];
+            barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.pNext               = nullptr;
+            barrier.srcAccessMask       = toLegacyAccess(barrier2.srcAccessMask);
+            barrier.dstAccessMask       = toLegacyAccess(barrier2.dstAccessMask);
+            barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+            barrier.buffer              = barrier2.buffer;
+            barrier.offset              = barrier2.offset;
+            barrier.size                = barrier2.size;
+            srcStages |= barrier2.srcStageMask;
+            dstStages |= barrier2.dstStageMask;
+        }
+
+        for (uint32_t i = 0; i < imageBarrierCount; ++i)
+        {
+            const VkImageMemoryBarrier2& barrier2 = pImageBarriers[i];
+            VkImageMemoryBarrier& barrier = tl_imageBarriers[i];
+            barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.pNext               = nullptr;
+            barrier.srcAccessMask       = toLegacyAccess(barrier2.srcAccessMask);
+            barrier.dstAccessMask       = toLegacyAccess(barrier2.dstAccessMask);
+            barrier.oldLayout           = barrier2.oldLayout;
+            barrier.newLayout           = barrier2.newLayout;
+            barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+            barrier.image               = barrier2.image;
+            barrier.subresourceRange    = barrier2.subresourceRange;
+            srcStages |= barrier2.srcStageMask;
+            dstStages |= barrier2.dstStageMask;
+        }
+
+        vkCmdPipelineBarrier(vkCommandBuffer,
+                             toLegacyStages(srcStages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+                             toLegacyStages(dstStages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT), 0,
+                             memoryBarrierCount, tl_memoryBarriers.data(),
+                             bufferBarrierCount, tl_bufferBarriers.data(),
+                             imageBarrierCount, tl_imageBarriers.data());
+    }
+}
+
+namespace keplar
+{
+    void VulkanBarrierBatch::memoryBarrier(VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                                           VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess) noexcept
+    {
+        VkMemoryBarrier2 barrier{};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        barrier.pNext         = nullptr;
+        barrier.srcStageMask  = srcStages;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstStageMask  = dstStages;
+        barrier.dstAccessMask = dstAccess;
+        m_memoryBarriers.push_back(barrier);
+    }
+
+    void VulkanBarrierBatch::bufferBarrier(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                                           VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                                           VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess,
+                                           uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex) noexcept
+    {
+        VkBufferMemoryBarrier2 barrier{};
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.pNext               = nullptr;
+        barrier.srcStageMask        = srcStages;
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstStageMask        = dstStages;
+        barrier.dstAccessMask       = dstAccess;
+        barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+        barrier.buffer              = buffer;
+        barrier.offset              = offset;
+        barrier.size                = size;
+        m_bufferBarriers.push_back(barrier);
+    }
+
+    void VulkanBarrierBatch::imageBarrier(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, const VkImageSubresourceRange& subresourceRange,
+                                          VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                                          VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess,
+                                          uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex) noexcept
+    {
+        VkImageMemoryBarrier2 barrier{};
+        barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.pNext               = nullptr;
+        barrier.srcStageMask        = srcStages;
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstStageMask        = dstStages;
+        barrier.dstAccessMask       = dstAccess;
+        barrier.oldLayout           = oldLayout;
+        barrier.newLayout           = newLayout;
+        barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+        barrier.image               = image;
+        barrier.subresourceRange    = subresourceRange;
+        m_imageBarriers.push_back(barrier);
+    }
+
+    void VulkanBarrierBatch::imageTransition(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                             const VkImageSubresourceRange& subresourceRange) noexcept
+    {
+        const ImageLayoutScope srcScope = getSrcScope(oldLayout);
+        const ImageLayoutScope dstScope = getDstScope(newLayout);
+        imageBarrier(image, oldLayout, newLayout, subresourceRange, srcScope.mStages, srcScope.mAccess, dstScope.mStages, dstScope.mAccess);
+    }
+
+    void VulkanBarrierBatch::flush(VkCommandBuffer vkCommandBuffer) noexcept
+    {
+        if (isEmpty())
+        {
+            return;
+        }
+
+        record(vkCommandBuffer,
+               static_cast<uint32_t>(m_memoryBarriers.size()), m_memoryBarriers.data(),
+               static_cast<uint32_t>(m_bufferBarriers.size()), m_bufferBarriers.data(),
+               static_cast<uint32_t>(m_imageBarriers.size()), m_imageBarriers.data());
+        clear();
+    }
+
+    void VulkanBarrierBatch::clear() noexcept
+    {
+        // keeps the capacity for the next batch
+        m_memoryBarriers.clear();
+        m_bufferBarriers.clear();
+        m_imageBarriers.clear();
+    }
+
+    uint32_t VulkanBarrierBatch::getBarrierCount() const noexcept
+    {
+        return static_cast<uint32_t>(m_memoryBarriers.size() + m_bufferBarriers.size() + m_imageBarriers.size());
+    }
+
+    bool VulkanBarrierBatch::hasImage(VkImage image) const noexcept
+    {
+        return std::any_of(m_imageBarriers.begin(), m_imageBarriers.end(), [image](const VkImageMemoryBarrier2& barrier) { return barrier.image == image; });
+    }
+
+    void VulkanBarrierBatch::record(VkCommandBuffer vkCommandBuffer,
+                                    uint32_t memoryBarrierCount, const VkMemoryBarrier2* pMemoryBarriers,
+                                    uint32_t bufferBarrierCount, const VkBufferMemoryBarrier2* pBufferBarriers,
+                                    uint32_t imageBarrierCount, const VkImageMemoryBarrier2* pImageBarriers) noexcept
+    {
+        if (memoryBarrierCount + bufferBarrierCount + imageBarrierCount == 0)
+        {
+            return;
+        }
+
+        VulkanCommandCounters::addBarrier();
+        if (!s_isSynchronization2Enabled)
+        {
+            recordLegacy(vkCommandBuffer, memoryBarrierCount, pMemoryBarriers, bufferBarrierCount, pBufferBarriers, imageBarrierCount, pImageBarriers);
+            return;
+        }
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.pNext                    = nullptr;
+        dependencyInfo.dependencyFlags          = 0;
+        dependencyInfo.memoryBarrierCount       = memoryBarrierCount;
+        dependencyInfo.pMemoryBarriers          = pMemoryBarriers;
+        dependencyInfo.bufferMemoryBarrierCount = bufferBarrierCount;
+        dependencyInfo.pBufferMemoryBarriers    = pBufferBarriers;
+        dependencyInfo.imageMemoryBarrierCount  = imageBarrierCount;
+        dependencyInfo.pImageMemoryBarriers     = pImageBarriers;
+        vkCmdPipelineBarrier2(vkCommandBuffer, &dependencyInfo);
+    }
+
+    ImageLayoutScope VulkanBarrierBatch::getSrcScope(VkImageLayout layout) noexcept
+    {
+        switch (layout)
+        {
+            // nothing to wait on: contents are discarded, or the acquire semaphore already ordered presentation
+            case VK_IMAGE_LAYOUT_UNDEFINED:
+            case VK_IMAGE_LAYOUT_PREINITIALIZED:
+            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+                return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE };
+
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT };
+
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+
+            // reads only need the execution dependency
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_NONE };
+
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT };
+
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_NONE };
+
+            // general and anything else may have been written anywhere
+            default:
+                return { VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT };
+        }
+    }
+
+    ImageLayoutScope VulkanBarrierBatch::getDstScope(VkImageLayout layout) noexcept
+    {
+        switch (layout)
+        {
+            // presentation is ordered by the semaphore the present waits on
+            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+                return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE };
+
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT };
+
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT };
+
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT };
+
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT };
+
+            default:
+                return { VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT };
+        }
+    }
+}   // namespace keplar
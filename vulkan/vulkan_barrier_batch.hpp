@@ -0,0 +1,81 @@
+// ────────────────────────────────────────────
+//  File: vulkan_barrier_batch.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // stages and access an image layout is used with, as the source or the destination of a transition
+    struct ImageLayoutScope
+    {
+        VkPipelineStageFlags2   mStages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2          mAccess = VK_ACCESS_2_NONE;
+    };
+
+    // collects memory, buffer and image barriers and records all of them with one vkCmdPipelineBarrier2 on flush().
+    // every barrier keeps its own stage masks, so unrelated transitions recorded together do not widen each other's
+    // dependency. without synchronization2 the batch falls back to one vkCmdPipelineBarrier over the union of the masks
+    class VulkanBarrierBatch final
+    {
+        public:
+            // creation and destruction
+            VulkanBarrierBatch() = default;
+            ~VulkanBarrierBatch() = default;
+
+            // copy and move semantics (plain barrier storage)
+            VulkanBarrierBatch(const VulkanBarrierBatch&) = default;
+            VulkanBarrierBatch& operator=(const VulkanBarrierBatch&) = default;
+            VulkanBarrierBatch(VulkanBarrierBatch&&) noexcept = default;
+            VulkanBarrierBatch& operator=(VulkanBarrierBatch&&) noexcept = default;
+
+            // usage: collection
+            void memoryBarrier(VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                               VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess) noexcept;
+            void bufferBarrier(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                               VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                               VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess,
+                               uint32_t srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, uint32_t dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED) noexcept;
+            void imageBarrier(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, const VkImageSubresourceRange& subresourceRange,
+                              VkPipelineStageFlags2 srcStages, VkAccessFlags2 srcAccess,
+                              VkPipelineStageFlags2 dstStages, VkAccessFlags2 dstAccess,
+                              uint32_t srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, uint32_t dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED) noexcept;
+
+            // stages and access inferred from the two layouts (see getSrcScope / getDstScope)
+            void imageTransition(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                 const VkImageSubresourceRange& subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }) noexcept;
+
+            // usage: recording (flush leaves the batch empty, an empty batch records nothing)
+            void flush(VkCommandBuffer vkCommandBuffer) noexcept;
+            void clear() noexcept;
+
+            // accessors
+            bool isEmpty() const noexcept               { return getBarrierCount() == 0; }
+            uint32_t getBarrierCount() const noexcept;
+            bool hasImage(VkImage image) const noexcept;
+
+            // records the given barriers at once, for callers that do not keep a batch
+            static void record(VkCommandBuffer vkCommandBuffer,
+                               uint32_t memoryBarrierCount, const VkMemoryBarrier2* pMemoryBarriers,
+                               uint32_t bufferBarrierCount, const VkBufferMemoryBarrier2* pBufferBarriers,
+                               uint32_t imageBarrierCount, const VkImageMemoryBarrier2* pImageBarriers) noexcept;
+
+            // narrowest scope of the work that wrote (src) or will use (dst) an image in this layout
+            static ImageLayoutScope getSrcScope(VkImageLayout layout) noexcept;
+            static ImageLayoutScope getDstScope(VkImageLayout layout) noexcept;
+
+            // set by the primary device from its enabled features (vkCmdPipelineBarrier2 is core in vulkan 1.3)
+            static void setSynchronization2Enabled(bool enabled) noexcept   { s_isSynchronization2Enabled = enabled; }
+            static bool isSynchronization2Enabled() noexcept                { return s_isSynchronization2Enabled; }
+
+        private:
+            std::vector<VkMemoryBarrier2>           m_memoryBarriers;
+            std::vector<VkBufferMemoryBarrier2>     m_bufferBarriers;
+            std::vector<VkImageMemoryBarrier2>      m_imageBarriers;
+
+            inline static bool s_isSynchronization2Enabled = false;
+    };
+}   // namespace keplar
@@ -5,60 +5,108 @@
 #include "vulkan_buffer.hpp"
 
 #include "vulkan/vulkan_device.hpp"
-#include "vulkan/vulkan_command_pool.hpp"
-#include "vulkan/vulkan_command_buffer.hpp"
-#include "vulkan/vulkan_fence.hpp"
+#include "vulkan/vulkan_staging_belt.hpp"
 #include "utils/logger.hpp"
 
+namespace
+{
+    // transfer-only buffer over an existing range, so moves copy buffers whose usage has no transfer bits
+    VkBuffer createAliasBuffer(VkDevice vkDevice, const keplar::VulkanAllocation& allocation, VkDeviceSize size, VkBufferUsageFlags usage) noexcept
+    {
+        VkBufferCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.size = size;
+        createInfo.usage = usage;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkBuffer vkBuffer = VK_NULL_HANDLE;
+        if (vkCreateBuffer(vkDevice, &createInfo, nullptr, &vkBuffer) != VK_SUCCESS)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // the range was placed for the real buffer; give up when the alias needs more
+        VkMemoryRequirements requirements{};
+        vkGetBufferMemoryRequirements(vkDevice, vkBuffer, &requirements);
+        const bool isCompatible = (requirements.memoryTypeBits & (1u << allocation.mMemoryTypeIndex)) != 0 &&
+                                  allocation.mOffset % requirements.alignment == 0 && requirements.size <= allocation.mSize;
+        if (!isCompatible || vkBindBufferMemory(vkDevice, vkBuffer, allocation.mMemory, allocation.mOffset) != VK_SUCCESS)
+        {
+            vkDestroyBuffer(vkDevice, vkBuffer, nullptr);
+            return VK_NULL_HANDLE;
+        }
+
+        return vkBuffer;
+    }
+}
+
 namespace keplar
 {
     VulkanBuffer::VulkanBuffer() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
         , m_vkBuffer(VK_NULL_HANDLE)
-        , m_vkDeviceMemory(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_allocation{}
         , m_allocationSize(0)
         , m_mappedData(nullptr)
+        , m_usageFlags(0)
+        , m_bufferSize(0)
+        , m_isRelocatable(false)
+        , m_isMovable(false)
     {
     }
 
     VulkanBuffer::~VulkanBuffer()
     {
-        if (m_mappedData)
+        if (m_vkBuffer != VK_NULL_HANDLE)
         {
-            vkUnmapMemory(m_vkDevice, m_vkDeviceMemory);
-            VK_LOG_DEBUG("vulkan memory unmapped successfully");
-            m_mappedData = nullptr;
+            vkDestroyBuffer(m_vkDevice, m_vkBuffer, nullptr);
+            m_vkBuffer = VK_NULL_HANDLE;
+            VK_LOG_DEBUG("vulkan buffer destroyed successfully");
         }
 
-        if (m_vkDeviceMemory != VK_NULL_HANDLE)
+        // return sub-allocation to the device allocator (block stays mapped)
+        if (m_memoryAllocator && m_allocation.isValid())
         {
-            vkFreeMemory(m_vkDevice, m_vkDeviceMemory, nullptr);
-            m_vkDeviceMemory = VK_NULL_HANDLE;
+            m_memoryAllocator->free(m_allocation);
             VK_LOG_DEBUG("vulkan buffer memory freed successfully");
         }
 
-        if (m_vkBuffer != VK_NULL_HANDLE)
-        {
-            vkDestroyBuffer(m_vkDevice, m_vkBuffer, nullptr);
-            m_vkBuffer = VK_NULL_HANDLE;
-            m_vkDevice = VK_NULL_HANDLE;
-            VK_LOG_DEBUG("vulkan buffer destroyed successfully");
-        }
+        m_vkDevice = VK_NULL_HANDLE;
+        m_memoryAllocator = nullptr;
+        m_mappedData = nullptr;
     }
 
     VulkanBuffer::VulkanBuffer(VulkanBuffer&& other) noexcept
         : m_vkDevice(other.m_vkDevice)
         , m_vkBuffer(other.m_vkBuffer)
-        , m_vkDeviceMemory(other.m_vkDeviceMemory)
+        , m_memoryAllocator(other.m_memoryAllocator)
+        , m_allocation(other.m_allocation)
         , m_allocationSize(other.m_allocationSize)
         , m_mappedData(other.m_mappedData)
+        , m_usageFlags(other.m_usageFlags)
+        , m_bufferSize(other.m_bufferSize)
+        , m_isRelocatable(other.m_isRelocatable)
+        , m_isMovable(other.m_isMovable)
     {
+        // the allocator reports moves to the new owner
+        if (m_isMovable)
+        {
+            m_memoryAllocator->setMovable(m_allocation, this);
+        }
+
         // reset the other
-        other.m_vkDevice       = VK_NULL_HANDLE;
-        other.m_vkBuffer       = VK_NULL_HANDLE;
-        other.m_vkDeviceMemory = VK_NULL_HANDLE;
-        other.m_allocationSize = 0;
-        other.m_mappedData     = nullptr;
+        other.m_vkDevice        = VK_NULL_HANDLE;
+        other.m_vkBuffer        = VK_NULL_HANDLE;
+        other.m_memoryAllocator = nullptr;
+        other.m_allocation      = VulkanAllocation{};
+        other.m_allocationSize  = 0;
+        other.m_mappedData      = nullptr;
+        other.m_usageFlags      = 0;
+        other.m_bufferSize      = 0;
+        other.m_isRelocatable   = false;
+        other.m_isMovable       = false;
     }
 
     VulkanBuffer& VulkanBuffer::operator=(VulkanBuffer&& other) noexcept
@@ -67,34 +115,45 @@ namespace keplar
         if (this != &other)
         {
             // release existing vulkan resources
-            if (m_mappedData)
+            if (m_vkBuffer != VK_NULL_HANDLE)
             {
-                vkUnmapMemory(m_vkDevice, m_vkDeviceMemory);
+                vkDestroyBuffer(m_vkDevice, m_vkBuffer, nullptr);
             }
 
-            if (m_vkDeviceMemory != VK_NULL_HANDLE)
+            if (m_memoryAllocator && m_allocation.isValid())
             {
-                vkFreeMemory(m_vkDevice, m_vkDeviceMemory, nullptr);
+                m_memoryAllocator->free(m_allocation);
             }
 
-            if (m_vkBuffer != VK_NULL_HANDLE)
+            // transfer ownership
+            m_vkDevice        = other.m_vkDevice;
+            m_vkBuffer        = other.m_vkBuffer;
+            m_memoryAllocator = other.m_memoryAllocator;
+            m_allocation      = other.m_allocation;
+            m_allocationSize  = other.m_allocationSize;
+            m_mappedData      = other.m_mappedData;  
+            m_usageFlags      = other.m_usageFlags;
+            m_bufferSize      = other.m_bufferSize;
+            m_isRelocatable   = other.m_isRelocatable;
+            m_isMovable       = other.m_isMovable;
+
+            // the allocator reports moves to the new owner
+            if (m_isMovable)
             {
-                vkDestroyBuffer(m_vkDevice, m_vkBuffer, nullptr);
+                m_memoryAllocator->setMovable(m_allocation, this);
             }
-
-            // transfer ownership
-            m_vkDevice       = other.m_vkDevice;
-            m_vkBuffer       = other.m_vkBuffer;
-            m_vkDeviceMemory = other.m_vkDeviceMemory;
-            m_allocationSize = other.m_allocationSize;
-            m_mappedData     = other.m_mappedData;  
             
             // reset the other
-            other.m_vkDevice       = VK_NULL_HANDLE;
-            other.m_vkBuffer       = VK_NULL_HANDLE;
-            other.m_vkDeviceMemory = VK_NULL_HANDLE;
-            other.m_allocationSize = 0;
-            other.m_mappedData     = nullptr;
+            other.m_vkDevice        = VK_NULL_HANDLE;
+            other.m_vkBuffer        = VK_NULL_HANDLE;
+            other.m_memoryAllocator = nullptr;
+            other.m_allocation      = VulkanAllocation{};
+            other.m_allocationSize  = 0;
+            other.m_mappedData      = nullptr;
+            other.m_usageFlags      = 0;
+            other.m_bufferSize      = 0;
+            other.m_isRelocatable   = false;
+            other.m_isMovable       = false;
         }
 
         return *this;
@@ -104,49 +163,79 @@ namespace keplar
                                          const VkBufferCreateInfo& createInfo, 
                                          const void* data,
                                          size_t size, 
-                                         bool persistMapped) noexcept
+                                         bool persistMapped,
+                                         bool preferDeviceLocal,
+                                         VulkanMemoryCategory category) noexcept
     {
-        // get raw vulkan device handle
+        // get raw vulkan device handle and memory allocator
         m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
 
-        // create vertex buffer and allocate memory
-        VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        if (!createBuffer(device, createInfo, propertyFlags, m_vkBuffer, m_vkDeviceMemory))
+        // any host-visible type works, coherent ones (and device-local ones when asked) rank first
+        VkMemoryPropertyFlags preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        if (preferDeviceLocal)
+        {
+            preferredFlags |= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        }
+        if (!createBuffer(device, createInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, m_vkBuffer, m_allocation, preferredFlags, category))
         {
             return false;
         }
-        
-        // map memory 
-        void* mappedData = nullptr;
-        VkResult vkResult = vkMapMemory(m_vkDevice, m_vkDeviceMemory, 0, m_allocationSize, 0, &mappedData);
-        if (vkResult != VK_SUCCESS)
+
+        // host-visible blocks are persistently mapped by the allocator
+        if (m_allocation.mMappedData == nullptr)
         {
-            VK_LOG_FATAL("vkMapMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("VulkanBuffer::createHostVisible :: allocation is not host mapped");
             return false;
         }
 
         // copy initial data if provided
         if (data != nullptr && size != 0)
         {
-            std::memcpy(mappedData, data, size);
+            std::memcpy(m_allocation.mMappedData, data, size);
+            if (!flush(0, size))
+            {
+                return false;
+            }
         }
 
-        // optionally keep memory mapped for frequent updates
+        // optionally expose the mapped pointer for frequent updates
         if (persistMapped)
         {
-            m_mappedData = mappedData;
+            m_mappedData = m_allocation.mMappedData;
+        }
+
+        VK_LOG_DEBUG("VulkanBuffer::createHostVisible successful");
+        return true;
+    }
+
+    bool VulkanBuffer::createHostReadback(const VulkanDevice& device, const VkBufferCreateInfo& createInfo) noexcept
+    {
+        // get raw vulkan device handle and memory allocator
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+
+        // cached types rank first, coherent ones next; device-local (resizable bar) memory is not asked for, it reads slowly
+        const VkMemoryPropertyFlags preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        if (!createBuffer(device, createInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, m_vkBuffer, m_allocation, preferredFlags, VulkanMemoryCategory::kStaging))
+        {
+            return false;
         }
-        else 
+
+        // host-visible blocks are persistently mapped by the allocator
+        if (m_allocation.mMappedData == nullptr)
         {
-            vkUnmapMemory(m_vkDevice, m_vkDeviceMemory);
+            VK_LOG_FATAL("VulkanBuffer::createHostReadback :: allocation is not host mapped");
+            return false;
         }
 
-        VK_LOG_DEBUG("VulkanBuffer::createHostVisible successful");
+        m_mappedData = m_allocation.mMappedData;
+        VK_LOG_DEBUG("VulkanBuffer::createHostReadback successful");
         return true;
     }
 
     bool VulkanBuffer::createDeviceLocal(const VulkanDevice& device,
-                                         const VulkanCommandPool& commandPool, 
+                                         VulkanStagingBelt& stagingBelt, 
                                          const VkBufferCreateInfo& createInfo, 
                                          const void* data, 
                                          size_t size) noexcept
@@ -158,164 +247,160 @@ namespace keplar
             return false;
         }
 
-        // get raw vulkan device handle
+        // get raw vulkan device handle and memory allocator
         m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
 
-        // staging buffer creation info
-        VkBufferCreateInfo createInfoStaging{};
-        createInfoStaging.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        createInfoStaging.pNext = nullptr;
-        createInfoStaging.flags = 0;
-        createInfoStaging.size = size;
-        createInfoStaging.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        createInfoStaging.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    
-        // staging buffer resources used for temporary host-to-device copy
-        VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        VkBuffer vkBufferStaging = VK_NULL_HANDLE;
-        VkDeviceMemory vkDeviceMemoryStaging = VK_NULL_HANDLE;
-
-        // create staging vertex buffer and allocate memory 
-        if (!createBuffer(device, createInfoStaging, propertyFlags, vkBufferStaging, vkDeviceMemoryStaging))
+        // create device local buffer and allocate memory 
+        if (!createBuffer(device, createInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_vkBuffer, m_allocation))
         {
             return false;
         }
 
-        // map memory 
-        void* mappedData = nullptr;
-        VkResult vkResult = vkMapMemory(m_vkDevice, vkDeviceMemoryStaging, 0, m_allocationSize, 0, &mappedData);
-        if (vkResult != VK_SUCCESS)
+        // stage data and record the copy into the belt's batch (contents are valid once the belt is flushed)
+        if (!stagingBelt.uploadBuffer(m_vkBuffer, data, size))
         {
-            VK_LOG_FATAL("vkMapMemory failed for staging buffer : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_ERROR("VulkanBuffer::createDeviceLocal :: failed to stage buffer upload");
             return false;
         }
 
-        // copy data to mapped memory
-        std::memcpy(mappedData, data, size);
+        VK_LOG_DEBUG("VulkanBuffer::createDeviceLocal successful");
+        return true;
+    }
 
-        // unmap memory
-        vkUnmapMemory(m_vkDevice, vkDeviceMemoryStaging);
+    bool VulkanBuffer::createDeviceLocal(const VulkanDevice& device, const VkBufferCreateInfo& createInfo) noexcept
+    {
+        // get raw vulkan device handle and memory allocator
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
 
-        // create device local buffer and allocate memory 
-        if (!createBuffer(device, createInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_vkBuffer, m_vkDeviceMemory))
+        // create device local buffer and allocate memory, nothing staged
+        if (!createBuffer(device, createInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_vkBuffer, m_allocation))
         {
-            vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
             return false;
         }
 
-        // allocate one-time submit command buffer from pool for host to device copy
-        auto commandBuffer = commandPool.allocatePrimary();
-        if (!commandBuffer.isValid())
+        VK_LOG_DEBUG("VulkanBuffer::createDeviceLocal successful (uninitialized, %llu bytes)", static_cast<unsigned long long>(createInfo.size));
+        return true;
+    }
+
+    bool VulkanBuffer::uploadHostVisible(const void* data, size_t size, VkDeviceSize offset, bool /* mapFullAllocation */) noexcept
+    {
+        // validate input data
+        if (data == nullptr || size == 0)
         {
-            vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_WARN("VulkanBuffer::uploadHostVisible invalid input data or size");
             return false;
         }
 
-        // begin recording commands
-        if (!commandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+        // validate write range
+        if (m_allocation.mMappedData == nullptr || offset + size > m_allocationSize)
         {
-            vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
+            VK_LOG_WARN("VulkanBuffer::uploadHostVisible buffer is not host mapped or range exceeds allocation");
             return false;
         }
 
-        // copy from staging host buffer to device-local buffer
-        VkBufferCopy vkBufferCopy{};
-        vkBufferCopy.srcOffset = 0;
-        vkBufferCopy.dstOffset = 0;
-        vkBufferCopy.size = size;
-        commandBuffer.copyBuffer(vkBufferStaging, m_vkBuffer, 1, &vkBufferCopy);
+        // memory stays mapped for the lifetime of the allocation; write directly
+        std::memcpy(static_cast<uint8_t*>(m_allocation.mMappedData) + offset, data, size);
+        return flush(offset, size);
+    }
+
+    bool VulkanBuffer::flush(VkDeviceSize offset, VkDeviceSize size) const noexcept
+    {
+        return m_memoryAllocator == nullptr || m_memoryAllocator->flush(m_allocation, offset, size);
+    }
 
-        // end recording commands
-        if (!commandBuffer.end())
-        {
-            vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
-            return false;
-        }
+    bool VulkanBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size) const noexcept
+    {
+        return m_memoryAllocator == nullptr || m_memoryAllocator->invalidate(m_allocation, offset, size);
+    }
 
-        // create a fence to track copy completion
-        VkFenceCreateInfo fenceCreateInfo{};
-        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceCreateInfo.pNext = nullptr;
-        fenceCreateInfo.flags = 0;  
-
-        VulkanFence copyFence;
-        copyFence.initialize(m_vkDevice, fenceCreateInfo);
- 
-        // submit info for executing the command buffer
-        VkCommandBuffer vkCommandBuffer = commandBuffer.get();
-        VkSubmitInfo vkSubmitInfo{};
-        vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        vkSubmitInfo.pNext = nullptr;
-        vkSubmitInfo.commandBufferCount = 1;
-        vkSubmitInfo.pCommandBuffers = &vkCommandBuffer;
-
-        // submit the copy command and signal the fence on completion
-        vkResult = vkQueueSubmit(device.getGraphicsQueue(), 1, &vkSubmitInfo, copyFence.get());
-        if (vkResult != VK_SUCCESS)
+    VkDeviceAddress VulkanBuffer::getDeviceAddress() const noexcept
+    {
+        if (m_vkBuffer == VK_NULL_HANDLE)
         {
-            VK_LOG_FATAL("vkQueueSubmit failed for buffer copy from host to device : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-            vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
-            return false;
+            return 0;
         }
 
-        // cleanup staging resources 
-        copyFence.wait();
-        commandPool.deallocate(commandBuffer);
-        vkFreeMemory(m_vkDevice, vkDeviceMemoryStaging, nullptr);
-        vkDestroyBuffer(m_vkDevice, vkBufferStaging, nullptr);
-
-        VK_LOG_DEBUG("VulkanBuffer::createDeviceLocal successful");
-        return true;
+        VkBufferDeviceAddressInfo addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        addressInfo.pNext = nullptr;
+        addressInfo.buffer = m_vkBuffer;
+        return vkGetBufferDeviceAddress(m_vkDevice, &addressInfo);
     }
 
-    bool VulkanBuffer::uploadHostVisible(const void* data, size_t size, VkDeviceSize offset, bool mapFullAllocation) noexcept
+    bool VulkanBuffer::setMovable(bool isMovable) noexcept
     {
-        // validate input data
-        if (data == nullptr || size == 0)
+        if (isMovable && (!m_isRelocatable || !m_allocation.isValid() || m_allocation.mMappedData != nullptr))
         {
-            VK_LOG_WARN("VulkanBuffer::uploadHostVisible invalid input data or size");
+            VK_LOG_WARN("VulkanBuffer::setMovable :: buffer cannot be relocated, it stays pinned");
             return false;
         }
 
-        // use persisted mapped pointer if available
-        if (m_mappedData)
+        if (m_memoryAllocator != nullptr)
         {
-            std::memcpy(m_mappedData, data, size);
-            return true;
+            m_memoryAllocator->setMovable(m_allocation, isMovable ? this : nullptr);
         }
+        m_isMovable = isMovable;
+        return true;
+    }
 
-        // choose mapping size: either full allocation or just the provided size
-        VkDeviceSize mapSize = mapFullAllocation ? m_allocationSize : size;
-
-        // map buffer memory for host access
-        void* mappedData = nullptr;
-        VkResult vkResult = vkMapMemory(m_vkDevice, m_vkDeviceMemory, offset, mapSize, 0, &mappedData);
-        if (vkResult != VK_SUCCESS)
+    bool VulkanBuffer::relocate(VkCommandBuffer vkCommandBuffer, const VulkanAllocation& destination, std::vector<VkBuffer>& retiredBuffers) noexcept
+    {
+        if (!m_isMovable || !destination.isValid())
         {
-            VK_LOG_FATAL("vkMapMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        // copy data to mapped memory
-        std::memcpy(mappedData, data, size);
+        // transfer views of both ranges and the buffer that replaces this one
+        const VkBuffer sourceAlias = createAliasBuffer(m_vkDevice, m_allocation, m_bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        const VkBuffer destinationAlias = createAliasBuffer(m_vkDevice, destination, m_bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+        VkBufferCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.size = m_bufferSize;
+        createInfo.usage = m_usageFlags;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkBuffer vkBuffer = VK_NULL_HANDLE;
+        bool isBound = vkCreateBuffer(m_vkDevice, &createInfo, nullptr, &vkBuffer) == VK_SUCCESS;
+        isBound = isBound && vkBindBufferMemory(m_vkDevice, vkBuffer, destination.mMemory, destination.mOffset) == VK_SUCCESS;
+        if (!isBound || sourceAlias == VK_NULL_HANDLE || destinationAlias == VK_NULL_HANDLE)
+        {
+            VK_LOG_WARN("VulkanBuffer::relocate :: buffer cannot be bound at the destination, move canceled");
+            for (VkBuffer handle : { vkBuffer, sourceAlias, destinationAlias })
+            {
+                if (handle != VK_NULL_HANDLE)
+                {
+                    vkDestroyBuffer(m_vkDevice, handle, nullptr);
+                }
+            }
+            return false;
+        }
 
-        // unmap buffer memory after copy
-        vkUnmapMemory(m_vkDevice, m_vkDeviceMemory);
+        VkBufferCopy region{};
+        region.srcOffset = 0;
+        region.dstOffset = 0;
+        region.size = m_bufferSize;
+        vkCmdCopyBuffer(vkCommandBuffer, sourceAlias, destinationAlias, 1, &region);
+
+        // the previous handle may still be read by frames in flight
+        retiredBuffers.push_back(m_vkBuffer);
+        retiredBuffers.push_back(sourceAlias);
+        retiredBuffers.push_back(destinationAlias);
+        m_vkBuffer = vkBuffer;
+        m_allocation = destination;
         return true;
     }
 
-    bool VulkanBuffer::createBuffer(const VulkanDevice& device,
+    bool VulkanBuffer::createBuffer(const VulkanDevice& /* device */,
                                     const VkBufferCreateInfo& createInfo, 
                                     VkMemoryPropertyFlags propertyFlags, 
                                     VkBuffer& vkBuffer, 
-                                    VkDeviceMemory& vkDeviceMemory) noexcept
+                                    VulkanAllocation& allocation,
+                                    VkMemoryPropertyFlags preferredFlags,
+                                    VulkanMemoryCategory category) noexcept
     {
         // create vulkan buffer
         VkResult vkResult = vkCreateBuffer(m_vkDevice, &createInfo, nullptr, &vkBuffer);
@@ -325,41 +410,19 @@ namespace keplar
             return false;
         }
 
-        // query memory requirements
-        VkMemoryRequirements vkMemoryRequirements{};
-        vkGetBufferMemoryRequirements(m_vkDevice, vkBuffer, &vkMemoryRequirements);
-
-        // find suitable memory type
-        auto memoryTypeIndex = device.findMemoryType(vkMemoryRequirements.memoryTypeBits, propertyFlags);
-        if (!memoryTypeIndex.has_value())
-        {
-            return false;
-        }
-
-        // allocate device memory from vulkan heap
-        VkMemoryAllocateInfo vkMemoryAllocateInfo{};
-        vkMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        vkMemoryAllocateInfo.pNext = nullptr;
-        vkMemoryAllocateInfo.allocationSize = vkMemoryRequirements.size;
-        vkMemoryAllocateInfo.memoryTypeIndex = *memoryTypeIndex;
-
-        vkResult = vkAllocateMemory(m_vkDevice, &vkMemoryAllocateInfo, nullptr, &vkDeviceMemory);
-        if (vkResult != VK_SUCCESS)
-        {
-            VK_LOG_FATAL("vkAllocateMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            return false;
-        }
-
-        // bind memory to buffer
-        vkResult = vkBindBufferMemory(m_vkDevice, vkBuffer, vkDeviceMemory, 0);
-        if (vkResult != VK_SUCCESS)
+        // sub-allocate and bind memory from the device allocator
+        if (!m_memoryAllocator->allocateBufferMemory(vkBuffer, propertyFlags, allocation, preferredFlags, category))
         {
-            VK_LOG_FATAL("vkBindBufferMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("VulkanBuffer::createBuffer :: failed to allocate buffer memory");
             return false;
         }
 
-        // store allocation size for mapping 
-        m_allocationSize = vkMemoryAllocateInfo.allocationSize;
+        // store allocation size for host writes, and what a relocation re-creates
+        m_allocationSize = allocation.mSize;
+        m_usageFlags = createInfo.usage;
+        m_bufferSize = createInfo.size;
+        m_isRelocatable = createInfo.pNext == nullptr && createInfo.flags == 0 && createInfo.sharingMode == VK_SHARING_MODE_EXCLUSIVE &&
+                          (createInfo.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) == 0;
         VK_LOG_DEBUG("VulkanBuffer::createBuffer successful");
         return true;
     }
@@ -5,12 +5,14 @@
 #pragma once
 
 #include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+#include "utils/handle_pool.hpp"
 
 namespace keplar
 {
     // forward declarations
     class VulkanDevice;
-    class VulkanCommandPool;
+    class VulkanStagingBelt;
 
     class VulkanBuffer final
     {
@@ -27,28 +29,75 @@ namespace keplar
             VulkanBuffer(VulkanBuffer&&) noexcept;
             VulkanBuffer& operator=(VulkanBuffer&&) noexcept;
  
-            // usage
-            bool createHostVisible(const VulkanDevice& device, const VkBufferCreateInfo& createInfo, const void* data, size_t size, bool persistMapped = false) noexcept;
-            bool createDeviceLocal(const VulkanDevice& device, const VulkanCommandPool& commandPool, const VkBufferCreateInfo& createInfo, const void* data, size_t size) noexcept;
+            // usage: host-visible memory stays mapped for the buffer's lifetime, coherent where the device offers it.
+            // preferDeviceLocal places small per-frame data the cpu rewrites in device-local host-visible memory
+            // (resizable bar) when available, so writes reach vram without a staging copy. category only selects the
+            // allocator statistics the memory is counted in
+            bool createHostVisible(const VulkanDevice& device, const VkBufferCreateInfo& createInfo, const void* data, size_t size, 
+                                   bool persistMapped = false, bool preferDeviceLocal = false,
+                                   VulkanMemoryCategory category = VulkanMemoryCategory::kBuffer) noexcept;
+            bool createDeviceLocal(const VulkanDevice& device, VulkanStagingBelt& stagingBelt, const VkBufferCreateInfo& createInfo, const void* data, size_t size) noexcept;
+            // usage: contents are undefined until written, e.g. by staging belt uploads into sub-ranges or by the gpu
+            bool createDeviceLocal(const VulkanDevice& device, const VkBufferCreateInfo& createInfo) noexcept;
             bool uploadHostVisible(const void* data, size_t size, VkDeviceSize offset = 0, bool mapFullAllocation = false) noexcept;
 
+            // usage: persistently mapped memory the device writes and the cpu reads back, host-cached where the device
+            // offers it so reads do not go through uncached write-combined memory (invalidate before reading)
+            bool createHostReadback(const VulkanDevice& device, const VkBufferCreateInfo& createInfo) noexcept;
+
+            // usage: after writing through getMappedData(), before the device reads; before reading device writes back.
+            // no-ops on host-coherent memory
+            bool flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const noexcept;
+            bool invalidate(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const noexcept;
+
+            // usage: buffers created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT on a device with buffer device
+            // address enabled; 0 when the buffer was never created
+            VkDeviceAddress getDeviceAddress() const noexcept;
+
+            // usage: opts a device-local buffer into allocator defragmentation (VulkanDefragmenter), which may move its
+            // memory to another block and replace get() with a new handle bound there. only for buffers whose users fetch
+            // get() again every frame instead of keeping it in descriptor sets; buffers with a device address or host
+            // mapping, create flags, chained create info or concurrent sharing stay pinned
+            bool setMovable(bool isMovable) noexcept;
+
+            // usage: applies a defragmentation move: records the copy of the contents into destination and switches get()
+            // to a new buffer bound there. the handles appended to retiredBuffers are destroyed by the caller once the copy
+            // completed; the source allocation is released by VulkanMemoryAllocator::endDefragmentationPass
+            bool relocate(VkCommandBuffer vkCommandBuffer, const VulkanAllocation& destination, std::vector<VkBuffer>& retiredBuffers) noexcept;
+
             // accessors
             VkBuffer get() const noexcept { return m_vkBuffer; }  
+            void* getMappedData() const noexcept { return m_mappedData; }
+            VkDeviceSize getSize() const noexcept { return m_allocationSize; }     // of the memory bound, 0 when never created
+            bool isMovable() const noexcept { return m_isMovable; }
 
         private:
             bool createBuffer(const VulkanDevice& device,
                               const VkBufferCreateInfo& createInfo, 
                               VkMemoryPropertyFlags propertyFlags, 
                               VkBuffer& vkBuffer, 
-                              VkDeviceMemory& vkDeviceMemory) noexcept;
+                              VulkanAllocation& allocation,
+                              VkMemoryPropertyFlags preferredFlags = 0,
+                              VulkanMemoryCategory category = VulkanMemoryCategory::kBuffer) noexcept;
 
         private:  
             // vulkan handles
-            VkDevice         m_vkDevice;
-            VkBuffer         m_vkBuffer;
-            VkDeviceMemory   m_vkDeviceMemory;
-            VkDeviceSize     m_allocationSize;
-            void*            m_mappedData;
+            VkDevice                m_vkDevice;
+            VkBuffer                m_vkBuffer;
+            VulkanMemoryAllocator*  m_memoryAllocator;
+            VulkanAllocation        m_allocation;
+            VkDeviceSize            m_allocationSize;
+            void*                   m_mappedData;
+
+            // what relocate() re-creates the buffer with
+            VkBufferUsageFlags      m_usageFlags;
+            VkDeviceSize            m_bufferSize;
+            bool                    m_isRelocatable;
+            bool                    m_isMovable;
     }; 
+
+    // buffers owned by a pool and referenced by 32-bit generational handles
+    using BufferHandle = Handle<VulkanBuffer>;
+    using BufferPool   = HandlePool<VulkanBuffer>;
 }   // namespace keplar
 
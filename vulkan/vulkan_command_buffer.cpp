@@ -4,6 +4,8 @@
 
 #include "vulkan_command_buffer.hpp"
 #include "vulkan_utils.hpp"
+#include "vulkan_barrier_batch.hpp"
+#include "vulkan_dispatch.hpp"
 #include "utils/logger.hpp"
 
 namespace keplar
@@ -51,7 +53,7 @@ namespace keplar
 
     bool VulkanCommandBuffer::begin(const VkCommandBufferBeginInfo& beginInfo) const noexcept
     {
-        return VK_CHECK(vkBeginCommandBuffer(m_vkCommandBuffer, &beginInfo));
+        return VK_CHECK(VulkanDispatch::device().mBeginCommandBuffer(m_vkCommandBuffer, &beginInfo));
     }
 
     bool VulkanCommandBuffer::begin(VkCommandBufferUsageFlags flags) const noexcept
@@ -61,44 +63,75 @@ namespace keplar
         vkCommandBufferBeginInfo.pNext = nullptr;
         vkCommandBufferBeginInfo.flags = flags;
 
-        return VK_CHECK(vkBeginCommandBuffer(m_vkCommandBuffer, &vkCommandBufferBeginInfo));
+        return VK_CHECK(VulkanDispatch::device().mBeginCommandBuffer(m_vkCommandBuffer, &vkCommandBufferBeginInfo));
     }
 
     bool VulkanCommandBuffer::end() const noexcept
     {
-        return VK_CHECK(vkEndCommandBuffer(m_vkCommandBuffer));
+        return VK_CHECK(VulkanDispatch::device().mEndCommandBuffer(m_vkCommandBuffer));
     }
 
     bool VulkanCommandBuffer::reset(VkCommandBufferResetFlags flags) const noexcept
     {
-        return VK_CHECK(vkResetCommandBuffer(m_vkCommandBuffer, flags));
+        return VK_CHECK(VulkanDispatch::device().mResetCommandBuffer(m_vkCommandBuffer, flags));
     }
 
     void VulkanCommandBuffer::executeCommands(const VulkanCommandBuffer& commandBuffers) noexcept
     {
         // execute command buffers
         VkCommandBuffer vkCommandBuffer = commandBuffers.get();
-        vkCmdExecuteCommands(m_vkCommandBuffer, 1, &vkCommandBuffer);
+        VulkanDispatch::device().mCmdExecuteCommands(m_vkCommandBuffer, 1, &vkCommandBuffer);
+    }
+
+    void VulkanCommandBuffer::executeCommands(const VulkanCommandBuffer* commandBuffers, uint32_t count) noexcept
+    {
+        // execute command buffers in order, in a single call
+        std::vector<VkCommandBuffer> vkCommandBuffers;
+        vkCommandBuffers.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            vkCommandBuffers.push_back(commandBuffers[i].get());
+        }
+
+        if (!vkCommandBuffers.empty())
+        {
+            VulkanDispatch::device().mCmdExecuteCommands(m_vkCommandBuffer, count, vkCommandBuffers.data());
+        }
     }
 
     void VulkanCommandBuffer::beginRenderPass(const VkRenderPassBeginInfo& beginInfo, VkSubpassContents contents) const noexcept
     {
-        vkCmdBeginRenderPass(m_vkCommandBuffer, &beginInfo, contents);
+        VulkanDispatch::device().mCmdBeginRenderPass(m_vkCommandBuffer, &beginInfo, contents);
     }
 
     void VulkanCommandBuffer::endRenderPass() const noexcept
     {
-        vkCmdEndRenderPass(m_vkCommandBuffer);
+        VulkanDispatch::device().mCmdEndRenderPass(m_vkCommandBuffer);
+    }
+
+    void VulkanCommandBuffer::beginRendering(const VkRenderingInfo& renderingInfo) const noexcept
+    {
+        VulkanDispatch::device().mCmdBeginRendering(m_vkCommandBuffer, &renderingInfo);
+    }
+
+    void VulkanCommandBuffer::endRendering() const noexcept
+    {
+        VulkanDispatch::device().mCmdEndRendering(m_vkCommandBuffer);
     }
 
     void VulkanCommandBuffer::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy* copyRegions) const noexcept
     {
-        vkCmdCopyBuffer(m_vkCommandBuffer, srcBuffer, dstBuffer, regionCount, copyRegions);
+        VulkanDispatch::device().mCmdCopyBuffer(m_vkCommandBuffer, srcBuffer, dstBuffer, regionCount, copyRegions);
+    }
+
+    void VulkanCommandBuffer::copyImageToBuffer(VkImage srcImage, VkImageLayout srcLayout, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferImageCopy* copyRegions) const noexcept
+    {
+        VulkanDispatch::device().mCmdCopyImageToBuffer(m_vkCommandBuffer, srcImage, srcLayout, dstBuffer, regionCount, copyRegions);
     }
 
     void VulkanCommandBuffer::bindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline) const noexcept
     {
-        vkCmdBindPipeline(m_vkCommandBuffer, bindPoint, pipeline);
+        VulkanDispatch::device().mCmdBindPipeline(m_vkCommandBuffer, bindPoint, pipeline);
     }
     
     void VulkanCommandBuffer::bindDescriptorSets(VkPipelineBindPoint bindPoint, 
@@ -109,17 +142,88 @@ namespace keplar
                                                  uint32_t dynamicOffsetCount, 
                                                  const uint32_t* pDynamicOffsets) const noexcept
     {
-        vkCmdBindDescriptorSets(m_vkCommandBuffer, bindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+        VulkanDispatch::device().mCmdBindDescriptorSets(m_vkCommandBuffer, bindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+    }
+
+    void VulkanCommandBuffer::setCullMode(VkCullModeFlags cullMode) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetCullMode(m_vkCommandBuffer, cullMode);
+    }
+
+    void VulkanCommandBuffer::setFrontFace(VkFrontFace frontFace) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetFrontFace(m_vkCommandBuffer, frontFace);
+    }
+
+    void VulkanCommandBuffer::setPrimitiveTopology(VkPrimitiveTopology topology) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetPrimitiveTopology(m_vkCommandBuffer, topology);
+    }
+
+    void VulkanCommandBuffer::setDepthTestEnable(bool enable) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetDepthTestEnable(m_vkCommandBuffer, enable ? VK_TRUE : VK_FALSE);
+    }
+
+    void VulkanCommandBuffer::setDepthWriteEnable(bool enable) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetDepthWriteEnable(m_vkCommandBuffer, enable ? VK_TRUE : VK_FALSE);
+    }
+
+    void VulkanCommandBuffer::setDepthCompareOp(VkCompareOp compareOp) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetDepthCompareOp(m_vkCommandBuffer, compareOp);
+    }
+
+    void VulkanCommandBuffer::setDepthBiasEnable(bool enable) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetDepthBiasEnable(m_vkCommandBuffer, enable ? VK_TRUE : VK_FALSE);
+    }
+
+    void VulkanCommandBuffer::pushDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, uint32_t writeCount, 
+                                                const VkWriteDescriptorSet* pWrites) const noexcept
+    {
+        pushDescriptorSet(m_vkCommandBuffer, bindPoint, layout, set, writeCount, pWrites);
+    }
+
+    void VulkanCommandBuffer::pushDescriptorSet(VkCommandBuffer vkCommandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, 
+                                                uint32_t writeCount, const VkWriteDescriptorSet* pWrites) noexcept
+    {
+        if (s_vkCmdPushDescriptorSetKHR != nullptr)
+        {
+            s_vkCmdPushDescriptorSetKHR(vkCommandBuffer, bindPoint, layout, set, writeCount, pWrites);
+        }
+    }
+
+    bool VulkanCommandBuffer::loadPushDescriptor(VkDevice vkDevice) noexcept
+    {
+        s_vkCmdPushDescriptorSetKHR = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(vkDevice, "vkCmdPushDescriptorSetKHR");
+        if (s_vkCmdPushDescriptorSetKHR == nullptr)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get vkCmdPushDescriptorSetKHR function pointer");
+            return false;
+        }
+        return true;
     }
 
     void VulkanCommandBuffer::bindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets) const noexcept
     {
-        vkCmdBindVertexBuffers(m_vkCommandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+        VulkanDispatch::device().mCmdBindVertexBuffers(m_vkCommandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+    }
+
+    void VulkanCommandBuffer::setViewport(const VkViewport& viewport) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetViewport(m_vkCommandBuffer, 0, 1, &viewport);
+    }
+
+    void VulkanCommandBuffer::setScissor(const VkRect2D& scissor) const noexcept
+    {
+        VulkanDispatch::device().mCmdSetScissor(m_vkCommandBuffer, 0, 1, &scissor);
     }
 
     void VulkanCommandBuffer::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) const noexcept
     {
-        vkCmdDraw(m_vkCommandBuffer, vertexCount, instanceCount, firstVertex, firstInstance); 
+        VulkanDispatch::device().mCmdDraw(m_vkCommandBuffer, vertexCount, instanceCount, firstVertex, firstInstance); 
     }
 
     void VulkanCommandBuffer::transitionImageLayout(VkImage image, 
@@ -127,10 +231,18 @@ namespace keplar
                                                     VkImageLayout newLayout, 
                                                     const VkImageSubresourceRange& subresourceRange) const noexcept
     {
+        // stages and access follow from the layouts: what last wrote the old one and what will use the new one
+        const ImageLayoutScope srcScope = VulkanBarrierBatch::getSrcScope(oldLayout);
+        const ImageLayoutScope dstScope = VulkanBarrierBatch::getDstScope(newLayout);
+
         // image memory barrier info
-        VkImageMemoryBarrier imageMemoryBarrier{};
-        imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        VkImageMemoryBarrier2 imageMemoryBarrier{};
+        imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
         imageMemoryBarrier.pNext                = nullptr;
+        imageMemoryBarrier.srcStageMask         = srcScope.mStages;
+        imageMemoryBarrier.srcAccessMask        = srcScope.mAccess;
+        imageMemoryBarrier.dstStageMask         = dstScope.mStages;
+        imageMemoryBarrier.dstAccessMask        = dstScope.mAccess;
         imageMemoryBarrier.oldLayout            = oldLayout;
         imageMemoryBarrier.newLayout            = newLayout;
         imageMemoryBarrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
@@ -138,93 +250,40 @@ namespace keplar
         imageMemoryBarrier.image                = image;
         imageMemoryBarrier.subresourceRange     = subresourceRange;
 
-        // source and destination pipeline stages
-        VkPipelineStageFlags srcStageMask{};
-        VkPipelineStageFlags dstStageMask{};
+        // issue an image memory barrier to synchronize access and transition the image layout between 
+        // pipeline stages, ensuring proper ordering of read/write operations
+        VulkanBarrierBatch::record(m_vkCommandBuffer, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+    }
 
-        switch (oldLayout)
-        {
-            case VK_IMAGE_LAYOUT_UNDEFINED:
-                imageMemoryBarrier.srcAccessMask = 0; 
-                srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-                break;
-            
-            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-                imageMemoryBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-                srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-                imageMemoryBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-                srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
-                imageMemoryBarrier.srcAccessMask = 0;
-                srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
-                imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-                srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-                imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-                srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-                break;
-
-            default:
-                imageMemoryBarrier.srcAccessMask = 0;
-                srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-                break;
-        }
+    void VulkanCommandBuffer::transitionImageLayout(VkImage image, 
+                                                    VkImageLayout oldLayout, 
+                                                    VkImageLayout newLayout, 
+                                                    VkPipelineStageFlags srcStageMask, 
+                                                    VkAccessFlags srcAccessMask, 
+                                                    VkPipelineStageFlags dstStageMask, 
+                                                    VkAccessFlags dstAccessMask,
+                                                    const VkImageSubresourceRange& subresourceRange) const noexcept
+    {
+        // legacy stage and access bits keep their values in the synchronization2 masks
+        VkImageMemoryBarrier2 imageMemoryBarrier{};
+        imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        imageMemoryBarrier.pNext                = nullptr;
+        imageMemoryBarrier.srcStageMask         = srcStageMask;
+        imageMemoryBarrier.srcAccessMask        = srcAccessMask;
+        imageMemoryBarrier.dstStageMask         = dstStageMask;
+        imageMemoryBarrier.dstAccessMask        = dstAccessMask;
+        imageMemoryBarrier.oldLayout            = oldLayout;
+        imageMemoryBarrier.newLayout            = newLayout;
+        imageMemoryBarrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        imageMemoryBarrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        imageMemoryBarrier.image                = image;
+        imageMemoryBarrier.subresourceRange     = subresourceRange;
 
-        switch (newLayout)
-        {
-            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-                imageMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-                dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-                imageMemoryBarrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-                dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
-                imageMemoryBarrier.dstAccessMask = 0;
-                dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
-                imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-                dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-                imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-                dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-                break;
-
-            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-                imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-                dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-                break;
-
-            default:
-                imageMemoryBarrier.dstAccessMask = 0;
-                dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-                break;
-        }
+        VulkanBarrierBatch::record(m_vkCommandBuffer, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+    }
 
-        // issue an image memory barrier to synchronize access and transition the image layout between 
-        // pipeline stages, ensuring proper ordering of read/write operations
-        vkCmdPipelineBarrier(m_vkCommandBuffer,                         // command buffer
-                             srcStageMask, dstStageMask,                // pipeline stages
-                             0,                                         // dependency flag
-                             0, nullptr,                                // global memory barriers
-                             0, nullptr,                                // buffer memory barriers
-                             1, &imageMemoryBarrier);                   // image memory barriers
+    void VulkanCommandBuffer::pipelineBarrier(VulkanBarrierBatch& barrierBatch) const noexcept
+    {
+        barrierBatch.flush(m_vkCommandBuffer);
     }
 }   // namespace keplar
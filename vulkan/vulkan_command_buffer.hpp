@@ -11,6 +11,7 @@ namespace keplar
 {
     // forward declarations
     class VulkanCommandPool;
+    class VulkanBarrierBatch;
 
     class VulkanCommandBuffer final
     {
@@ -33,29 +34,65 @@ namespace keplar
             bool end() const noexcept;
             bool reset(VkCommandBufferResetFlags flags = 0) const noexcept;
             void executeCommands(const VulkanCommandBuffer& commandBuffers) noexcept;
+            void executeCommands(const VulkanCommandBuffer* commandBuffers, uint32_t count) noexcept;
 
             // render pass helpers
             void beginRenderPass(const VkRenderPassBeginInfo& beginInfo, VkSubpassContents contents) const noexcept;
             void endRenderPass() const noexcept;
+
+            // dynamic rendering helpers (vulkan 1.3, no render pass or framebuffer objects)
+            void beginRendering(const VkRenderingInfo& renderingInfo) const noexcept;
+            void endRendering() const noexcept;
   
             // copy helpers
             void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy* copyRegions) const noexcept;
+            void copyImageToBuffer(VkImage srcImage, VkImageLayout srcLayout, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferImageCopy* copyRegions) const noexcept;
 
             // draw helpers
             void bindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline) const noexcept;
             void bindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount, 
                 const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount = 0, const uint32_t* pDynamicOffsets = nullptr) const noexcept;
+            // push descriptors (VK_KHR_push_descriptor): writes go straight into the command buffer for a set whose layout
+            // was created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR; dstSet of the writes is ignored
+            void pushDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, uint32_t writeCount, 
+                const VkWriteDescriptorSet* pWrites) const noexcept;
+            static void pushDescriptorSet(VkCommandBuffer vkCommandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, 
+                uint32_t writeCount, const VkWriteDescriptorSet* pWrites) noexcept;
             void bindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets) const noexcept;
+            void setViewport(const VkViewport& viewport) const noexcept;
+            void setScissor(const VkRect2D& scissor) const noexcept;
             void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) const noexcept;
 
-            // pipeline barrier
+            // extended dynamic state (vulkan 1.3), for pipelines that list the state in GraphicsPipelineConfig::mExtendedDynamicStates
+            void setCullMode(VkCullModeFlags cullMode) const noexcept;
+            void setFrontFace(VkFrontFace frontFace) const noexcept;
+            void setPrimitiveTopology(VkPrimitiveTopology topology) const noexcept;
+            void setDepthTestEnable(bool enable) const noexcept;
+            void setDepthWriteEnable(bool enable) const noexcept;
+            void setDepthCompareOp(VkCompareOp compareOp) const noexcept;
+            void setDepthBiasEnable(bool enable) const noexcept;
+
+            // pipeline barrier (recorded through vkCmdPipelineBarrier2 when the device enabled synchronization2)
             void transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
                 const VkImageSubresourceRange& subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }) const noexcept;
 
+            // explicit stages and access, for transitions the layout table above cannot infer 
+            // (e.g. chaining onto a semaphore wait or a write-after-write on an attachment reused every frame)
+            void transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, 
+                VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask,
+                const VkImageSubresourceRange& subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }) const noexcept;
+
+            // records every barrier collected in the batch as one dependency and empties it
+            void pipelineBarrier(VulkanBarrierBatch& barrierBatch) const noexcept;
+
             // accessor
             VkCommandBuffer get() const noexcept { return m_vkCommandBuffer; }
             bool isValid() const noexcept { return m_vkCommandBuffer != VK_NULL_HANDLE; }
 
+            // loaded by the device that enables the extension
+            static bool loadPushDescriptor(VkDevice vkDevice) noexcept;
+            static bool isPushDescriptorLoaded() noexcept { return s_vkCmdPushDescriptorSetKHR != nullptr; }
+
         private:
             // only command pool can construct
             friend class VulkanCommandPool;
@@ -63,6 +100,7 @@ namespace keplar
 
         private:
             VkCommandBuffer m_vkCommandBuffer;
+            inline static PFN_vkCmdPushDescriptorSetKHR s_vkCmdPushDescriptorSetKHR = nullptr;
     };
 }   // namespace keplar
 
@@ -0,0 +1,47 @@
+// ────────────────────────────────────────────
+//  File: vulkan_command_counters.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace keplar
+{
+    // commands recorded between two takes
+    struct CommandCounts
+    {
+        uint32_t mDraws    = 0;         // draw calls, an indirect call counts once whatever its draw count
+        uint32_t mBinds    = 0;         // pipeline, descriptor set, vertex and index buffer binds
+        uint32_t mBarriers = 0;         // pipeline barrier commands, however many barriers each carries
+    };
+
+    // cpu-side counts of the commands the engine's recording paths issue, added from any thread and taken once per frame
+    // by the main loop. recorders add their counts in one go per pass rather than per command, barriers are few enough
+    // to add one by one. work recorded once and replayed (cached secondaries) counts in the frame that recorded it, so
+    // the counts measure recording, not what the gpu executes
+    class VulkanCommandCounters final
+    {
+        public:
+            // usage: from any thread
+            static void addDraws(uint32_t count) noexcept       { s_draws.fetch_add(count, std::memory_order_relaxed); }
+            static void addBinds(uint32_t count) noexcept       { s_binds.fetch_add(count, std::memory_order_relaxed); }
+            static void addBarrier() noexcept                   { s_barriers.fetch_add(1, std::memory_order_relaxed); }
+
+            // usage: once per frame, returns the counts since the last take and restarts them
+            static CommandCounts take() noexcept
+            {
+                CommandCounts counts{};
+                counts.mDraws    = s_draws.exchange(0, std::memory_order_relaxed);
+                counts.mBinds    = s_binds.exchange(0, std::memory_order_relaxed);
+                counts.mBarriers = s_barriers.exchange(0, std::memory_order_relaxed);
+                return counts;
+            }
+
+        private:
+            inline static std::atomic<uint32_t> s_draws{ 0 };
+            inline static std::atomic<uint32_t> s_binds{ 0 };
+            inline static std::atomic<uint32_t> s_barriers{ 0 };
+    };
+}   // namespace keplar
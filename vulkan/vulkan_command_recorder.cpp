@@ -0,0 +1,298 @@
+// ────────────────────────────────────────────
+//  File: vulkan_command_recorder.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_command_recorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include "vulkan_command_buffer.hpp"
+#include "vulkan_dispatch.hpp"
+#include "vulkan_command_counters.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanCommandRecorder::VulkanCommandRecorder(VkCommandBuffer vkCommandBuffer) noexcept
+        : m_vkCommandBuffer(vkCommandBuffer)
+    {
+        beginPass();
+    }
+
+    VulkanCommandRecorder::VulkanCommandRecorder(const VulkanCommandBuffer& commandBuffer) noexcept
+        : VulkanCommandRecorder(commandBuffer.get())
+    {
+    }
+
+    VulkanCommandRecorder::~VulkanCommandRecorder()
+    {
+        publish();
+    }
+
+    void VulkanCommandRecorder::beginPass() noexcept
+    {
+        publish();
+        m_stats = {};
+        invalidate();
+    }
+
+    void VulkanCommandRecorder::invalidate() noexcept
+    {
+        m_bindPoints.fill({});
+        m_vertexBuffers.fill(VK_NULL_HANDLE);
+        m_vertexOffsets.fill(0);
+        m_indexBuffer = VK_NULL_HANDLE;
+        m_indexOffset = 0;
+        m_indexType = VK_INDEX_TYPE_UINT32;
+        m_viewport = {};
+        m_scissor = {};
+        m_isViewportKnown = false;
+        m_isScissorKnown = false;
+        m_cullMode = VK_CULL_MODE_NONE;
+        m_isCullModeKnown = false;
+        m_pushConstantLayout = VK_NULL_HANDLE;
+        m_pushConstantStages.fill(0);
+    }
+
+    void VulkanCommandRecorder::bindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline) noexcept
+    {
+        BindPointState* state = getBindPointState(bindPoint);
+        if (state && pipeline != VK_NULL_HANDLE && state->mPipeline == pipeline)
+        {
+            elide();
+            return;
+        }
+
+        // binding a pipeline leaves the bound sets and push constants alone, compatibility is checked at the draw
+        VulkanDispatch::device().mCmdBindPipeline(m_vkCommandBuffer, bindPoint, pipeline);
+        bind();
+        if (state)
+        {
+            state->mPipeline = pipeline;
+        }
+    }
+
+    void VulkanCommandRecorder::bindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount,
+                                                   const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets) noexcept
+    {
+        BindPointState* state = getBindPointState(bindPoint);
+        const bool isShadowed = state && firstSet + descriptorSetCount <= kMaxDescriptorSets;
+        if (isShadowed && dynamicOffsetCount == 0 && state->mLayout == layout &&
+            std::equal(pDescriptorSets, pDescriptorSets + descriptorSetCount, state->mSets.begin() + firstSet))
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdBindDescriptorSets(m_vkCommandBuffer, bindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+        bind();
+        if (!state)
+        {
+            return;
+        }
+
+        // another layout may disturb sets outside the range, so only what this call bound stays known
+        if (state->mLayout != layout)
+        {
+            state->mSets.fill(VK_NULL_HANDLE);
+            state->mLayout = layout;
+        }
+
+        const uint32_t endSet = std::min(firstSet + descriptorSetCount, kMaxDescriptorSets);
+        for (uint32_t set = firstSet; set < endSet; ++set)
+        {
+            state->mSets[set] = dynamicOffsetCount == 0 ? pDescriptorSets[set - firstSet] : VK_NULL_HANDLE;
+        }
+    }
+
+    void VulkanCommandRecorder::pushDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, uint32_t writeCount,
+                                                  const VkWriteDescriptorSet* pWrites) noexcept
+    {
+        // the pushed contents are not compared, the set is unknown afterwards
+        VulkanCommandBuffer::pushDescriptorSet(m_vkCommandBuffer, bindPoint, layout, set, writeCount, pWrites);
+        bind();
+        if (BindPointState* state = getBindPointState(bindPoint))
+        {
+            if (state->mLayout != layout)
+            {
+                state->mSets.fill(VK_NULL_HANDLE);
+                state->mLayout = layout;
+            }
+            if (set < kMaxDescriptorSets)
+            {
+                state->mSets[set] = VK_NULL_HANDLE;
+            }
+        }
+    }
+
+    void VulkanCommandRecorder::bindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets) noexcept
+    {
+        const bool isShadowed = firstBinding + bindingCount <= kMaxVertexBindings;
+        if (isShadowed &&
+            std::equal(pBuffers, pBuffers + bindingCount, m_vertexBuffers.begin() + firstBinding) &&
+            std::equal(pOffsets, pOffsets + bindingCount, m_vertexOffsets.begin() + firstBinding) &&
+            std::none_of(pBuffers, pBuffers + bindingCount, [](VkBuffer buffer) { return buffer == VK_NULL_HANDLE; }))
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdBindVertexBuffers(m_vkCommandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+        bind();
+        const uint32_t endBinding = std::min(firstBinding + bindingCount, kMaxVertexBindings);
+        for (uint32_t binding = firstBinding; binding < endBinding; ++binding)
+        {
+            m_vertexBuffers[binding] = pBuffers[binding - firstBinding];
+            m_vertexOffsets[binding] = pOffsets[binding - firstBinding];
+        }
+    }
+
+    void VulkanCommandRecorder::bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType) noexcept
+    {
+        if (buffer != VK_NULL_HANDLE && m_indexBuffer == buffer && m_indexOffset == offset && m_indexType == indexType)
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdBindIndexBuffer(m_vkCommandBuffer, buffer, offset, indexType);
+        bind();
+        m_indexBuffer = buffer;
+        m_indexOffset = offset;
+        m_indexType = indexType;
+    }
+
+    void VulkanCommandRecorder::setViewport(const VkViewport& viewport) noexcept
+    {
+        if (m_isViewportKnown && std::memcmp(&m_viewport, &viewport, sizeof(VkViewport)) == 0)
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdSetViewport(m_vkCommandBuffer, 0, 1, &viewport);
+        record();
+        m_viewport = viewport;
+        m_isViewportKnown = true;
+    }
+
+    void VulkanCommandRecorder::setScissor(const VkRect2D& scissor) noexcept
+    {
+        if (m_isScissorKnown && std::memcmp(&m_scissor, &scissor, sizeof(VkRect2D)) == 0)
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdSetScissor(m_vkCommandBuffer, 0, 1, &scissor);
+        record();
+        m_scissor = scissor;
+        m_isScissorKnown = true;
+    }
+
+    void VulkanCommandRecorder::setCullMode(VkCullModeFlags cullMode) noexcept
+    {
+        if (m_isCullModeKnown && m_cullMode == cullMode)
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdSetCullMode(m_vkCommandBuffer, cullMode);
+        record();
+        m_cullMode = cullMode;
+        m_isCullModeKnown = true;
+    }
+
+    void VulkanCommandRecorder::pushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues) noexcept
+    {
+        // known bytes: pushed through the same layout to the same stages, with the same contents
+        const bool isShadowed = offset + size <= kMaxPushConstantBytes;
+        const uint8_t* bytes = static_cast<const uint8_t*>(pValues);
+        if (isShadowed && stageFlags != 0 && m_pushConstantLayout == layout &&
+            std::all_of(m_pushConstantStages.begin() + offset, m_pushConstantStages.begin() + offset + size,
+                        [stageFlags](VkShaderStageFlags stages) { return stages == stageFlags; }) &&
+            std::memcmp(m_pushConstantBytes.data() + offset, bytes, size) == 0)
+        {
+            elide();
+            return;
+        }
+
+        VulkanDispatch::device().mCmdPushConstants(m_vkCommandBuffer, layout, stageFlags, offset, size, pValues);
+        record();
+        if (m_pushConstantLayout != layout)
+        {
+            m_pushConstantStages.fill(0);
+            m_pushConstantLayout = layout;
+        }
+        if (isShadowed)
+        {
+            std::memcpy(m_pushConstantBytes.data() + offset, bytes, size);
+            std::fill_n(m_pushConstantStages.begin() + offset, size, stageFlags);
+        }
+    }
+
+    void VulkanCommandRecorder::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) noexcept
+    {
+        ++m_stats.mDraws;
+        VulkanDispatch::device().mCmdDraw(m_vkCommandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    void VulkanCommandRecorder::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) noexcept
+    {
+        ++m_stats.mDraws;
+        VulkanDispatch::device().mCmdDrawIndexed(m_vkCommandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+
+    void VulkanCommandRecorder::drawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride) noexcept
+    {
+        ++m_stats.mDraws;
+        VulkanDispatch::device().mCmdDrawIndexedIndirect(m_vkCommandBuffer, buffer, offset, drawCount, stride);
+    }
+
+    void VulkanCommandRecorder::drawMultiIndexed(uint32_t drawCount, const VkMultiDrawIndexedInfoEXT* pIndexInfo, uint32_t instanceCount, 
+                                                 uint32_t firstInstance) noexcept
+    {
+        // vertex offsets come from each draw's info
+        if (s_vkCmdDrawMultiIndexedEXT != nullptr)
+        {
+            ++m_stats.mDraws;
+            s_vkCmdDrawMultiIndexedEXT(m_vkCommandBuffer, drawCount, pIndexInfo, instanceCount, firstInstance, sizeof(VkMultiDrawIndexedInfoEXT), nullptr);
+        }
+    }
+
+    bool VulkanCommandRecorder::loadMultiDraw(VkDevice vkDevice) noexcept
+    {
+        s_vkCmdDrawMultiIndexedEXT = (PFN_vkCmdDrawMultiIndexedEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdDrawMultiIndexedEXT");
+        if (s_vkCmdDrawMultiIndexedEXT == nullptr)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get vkCmdDrawMultiIndexedEXT function pointer");
+            return false;
+        }
+        return true;
+    }
+
+    void VulkanCommandRecorder::publish() const noexcept
+    {
+        // one add per pass, the counters are shared by every recording thread
+        if (m_stats.mDraws != 0)
+        {
+            VulkanCommandCounters::addDraws(m_stats.mDraws);
+        }
+        if (m_stats.mBinds != 0)
+        {
+            VulkanCommandCounters::addBinds(m_stats.mBinds);
+        }
+    }
+
+    VulkanCommandRecorder::BindPointState* VulkanCommandRecorder::getBindPointState(VkPipelineBindPoint bindPoint) noexcept
+    {
+        // other bind points (ray tracing) are passed through unshadowed
+        switch (bindPoint)
+        {
+            case VK_PIPELINE_BIND_POINT_GRAPHICS:   return &m_bindPoints[0];
+            case VK_PIPELINE_BIND_POINT_COMPUTE:    return &m_bindPoints[1];
+            default:                                return nullptr;
+        }
+    }
+}   // namespace keplar
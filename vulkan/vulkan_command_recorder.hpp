@@ -0,0 +1,125 @@
+// ────────────────────────────────────────────
+//  File: vulkan_command_recorder.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanCommandBuffer;
+
+    // commands a recorder passed on and dropped since its pass began (mRecorded and mElided are state commands, of
+    // which mBinds were binds; draws are counted apart)
+    struct CommandRecorderStats
+    {
+        uint32_t mRecorded = 0;
+        uint32_t mElided   = 0;
+        uint32_t mBinds    = 0;
+        uint32_t mDraws    = 0;
+    };
+
+    // shadows the state bound through it (pipelines and descriptor sets per bind point, vertex and index buffers,
+    // viewport, scissor, cull mode and push constant bytes) and drops calls that would rebind what is already bound.
+    // state it has not seen counts as unknown, so the first bind of a pass always records; commands recorded around
+    // the recorder that change any of this state must be followed by invalidate(). one recorder per command buffer
+    // and thread, for the duration of a pass; its draws and binds are added to VulkanCommandCounters when the next
+    // pass begins and on destruction
+    class VulkanCommandRecorder final
+    {
+        public:
+            // creation and destruction (non owning, the command buffer must be recording)
+            explicit VulkanCommandRecorder(VkCommandBuffer vkCommandBuffer) noexcept;
+            explicit VulkanCommandRecorder(const VulkanCommandBuffer& commandBuffer) noexcept;
+            ~VulkanCommandRecorder();
+
+            // disable copy and move semantics to prevent two shadows of one command buffer
+            VulkanCommandRecorder(const VulkanCommandRecorder&) = delete;
+            VulkanCommandRecorder& operator=(const VulkanCommandRecorder&) = delete;
+            VulkanCommandRecorder(VulkanCommandRecorder&&) = delete;
+            VulkanCommandRecorder& operator=(VulkanCommandRecorder&&) = delete;
+
+            // usage: pass scope (beginPass forgets the state and restarts the counts)
+            void beginPass() noexcept;
+            void invalidate() noexcept;
+
+            // usage: state commands, recorded only when they change what is bound
+            void bindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline) noexcept;
+            // sets with dynamic offsets always record and are forgotten, the offsets usually change per call
+            void bindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount,
+                const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount = 0, const uint32_t* pDynamicOffsets = nullptr) noexcept;
+            void pushDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, uint32_t writeCount,
+                const VkWriteDescriptorSet* pWrites) noexcept;
+            void bindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets) noexcept;
+            void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType) noexcept;
+            void setViewport(const VkViewport& viewport) noexcept;
+            void setScissor(const VkRect2D& scissor) noexcept;
+            void setCullMode(VkCullModeFlags cullMode) noexcept;
+            void pushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues) noexcept;
+
+            // usage: draws, recorded as given
+            void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) noexcept;
+            void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) noexcept;
+            void drawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride) noexcept;
+            // VK_EXT_multi_draw (VulkanDevice::isMultiDrawEnabled): drawCount indexed draws sharing the instance range, told
+            // apart by gl_DrawID; at most VkPhysicalDeviceMultiDrawPropertiesEXT::maxMultiDrawCount per call
+            void drawMultiIndexed(uint32_t drawCount, const VkMultiDrawIndexedInfoEXT* pIndexInfo, uint32_t instanceCount, uint32_t firstInstance) noexcept;
+
+            // accessors
+            VkCommandBuffer get() const noexcept                    { return m_vkCommandBuffer; }
+            const CommandRecorderStats& getStats() const noexcept   { return m_stats; }
+            uint32_t getElidedCount() const noexcept                { return m_stats.mElided; }
+
+            // loaded by the device that enables the extension
+            static bool loadMultiDraw(VkDevice vkDevice) noexcept;
+            static bool isMultiDrawLoaded() noexcept                { return s_vkCmdDrawMultiIndexedEXT != nullptr; }
+
+        public:
+            // shadowed slots; binds past them always record
+            static constexpr uint32_t kMaxDescriptorSets    = 8;
+            static constexpr uint32_t kMaxVertexBindings    = 16;
+            static constexpr uint32_t kMaxPushConstantBytes = 256;
+
+        private:
+            // pipeline and sets of one bind point (graphics or compute)
+            struct BindPointState
+            {
+                VkPipeline                                          mPipeline = VK_NULL_HANDLE;
+                VkPipelineLayout                                    mLayout   = VK_NULL_HANDLE;
+                std::array<VkDescriptorSet, kMaxDescriptorSets>     mSets{};
+            };
+
+            BindPointState* getBindPointState(VkPipelineBindPoint bindPoint) noexcept;
+            void record() noexcept                                  { ++m_stats.mRecorded; }
+            void bind() noexcept                                    { ++m_stats.mRecorded; ++m_stats.mBinds; }
+            void publish() const noexcept;
+            void elide() noexcept                                   { ++m_stats.mElided; }
+
+        private:
+            VkCommandBuffer                                         m_vkCommandBuffer;
+            CommandRecorderStats                                    m_stats;
+
+            // shadowed state, null handles (and a zero stage mask for push constant bytes) are unknown
+            std::array<BindPointState, 2>                           m_bindPoints;
+            std::array<VkBuffer, kMaxVertexBindings>                m_vertexBuffers;
+            std::array<VkDeviceSize, kMaxVertexBindings>            m_vertexOffsets;
+            VkBuffer                                                m_indexBuffer;
+            VkDeviceSize                                            m_indexOffset;
+            VkIndexType                                             m_indexType;
+            VkViewport                                              m_viewport;
+            VkRect2D                                                m_scissor;
+            bool                                                    m_isViewportKnown;
+            bool                                                    m_isScissorKnown;
+            VkCullModeFlags                                         m_cullMode;
+            bool                                                    m_isCullModeKnown;
+            VkPipelineLayout                                        m_pushConstantLayout;
+            std::array<uint8_t, kMaxPushConstantBytes>              m_pushConstantBytes;
+            std::array<VkShaderStageFlags, kMaxPushConstantBytes>   m_pushConstantStages;
+
+            // extension command, shared by every recorder
+            inline static PFN_vkCmdDrawMultiIndexedEXT              s_vkCmdDrawMultiIndexedEXT = nullptr;
+    };
+}   // namespace keplar
@@ -0,0 +1,188 @@
+// ────────────────────────────────────────────
+//  File: vulkan_compute_queue.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_compute_queue.hpp"
+#include "vulkan_device.hpp"
+#include "vulkan_utils.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanComputeQueue::VulkanComputeQueue() noexcept
+        : m_vkQueue(VK_NULL_HANDLE)
+        , m_queueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        , m_isAsync(false)
+        , m_currentFrame(0)
+        , m_isRecording(false)
+    {
+    }
+
+    bool VulkanComputeQueue::initialize(const VulkanDevice& device, uint32_t frameCount) noexcept
+    {
+        // cross-queue sync runs on timeline values
+        const auto& queueFamilies = device.getQueueFamilyIndices();
+        if (!device.isTimelineSemaphoreEnabled() || !queueFamilies.mComputeFamily || device.getComputeQueue() == VK_NULL_HANDLE)
+        {
+            VK_LOG_INFO("VulkanComputeQueue::initialize :: compute queue or timeline semaphores not available");
+            return false;
+        }
+
+        destroy();
+        const VkDevice vkDevice = device.getDevice();
+        if (!m_commandAllocator.initialize(vkDevice, *queueFamilies.mComputeFamily, frameCount) || !m_timeline.initialize(vkDevice, frameCount))
+        {
+            VK_LOG_ERROR("VulkanComputeQueue::initialize :: failed to create command allocator or timeline");
+            destroy();
+            return false;
+        }
+
+        // async only when compute runs on its own family; otherwise submissions simply serialize with graphics
+        m_vkQueue = device.getComputeQueue();
+        m_queueFamilyIndex = *queueFamilies.mComputeFamily;
+        m_isAsync = queueFamilies.mGraphicsFamily != queueFamilies.mComputeFamily;
+        VK_LOG_DEBUG("VulkanComputeQueue::initialize successful (family: %u, async: %s)", m_queueFamilyIndex, m_isAsync ? "yes" : "no");
+        return true;
+    }
+
+    void VulkanComputeQueue::destroy() noexcept
+    {
+        // callers wait for the device (or the timeline) to be idle first
+        m_commandBuffer = VulkanCommandBuffer{};
+        m_commandAllocator.destroy();
+        m_timeline.destroy();
+        m_vkQueue = VK_NULL_HANDLE;
+        m_queueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        m_isAsync = false;
+        m_isRecording = false;
+    }
+
+    bool VulkanComputeQueue::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // drop an unsubmitted recording; its buffer is recycled with the pool
+        m_commandBuffer = VulkanCommandBuffer{};
+        m_isRecording = false;
+
+        // the slot's command buffers are free once its last submission completed
+        if (!m_timeline.waitForFrame(frameIndex) || !m_commandAllocator.beginFrame(frameIndex))
+        {
+            return false;
+        }
+
+        m_currentFrame = frameIndex;
+        return true;
+    }
+
+    VkCommandBuffer VulkanComputeQueue::getCommandBuffer() noexcept
+    {
+        // begin the frame's recording on first use
+        if (!m_isRecording)
+        {
+            m_commandBuffer = m_commandAllocator.allocatePrimary();
+            if (!m_commandBuffer.isValid() || !m_commandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+            {
+                VK_LOG_ERROR("VulkanComputeQueue::getCommandBuffer :: failed to begin compute command buffer");
+                m_commandBuffer = VulkanCommandBuffer{};
+                return VK_NULL_HANDLE;
+            }
+            m_isRecording = true;
+        }
+
+        return m_commandBuffer.get();
+    }
+
+    uint64_t VulkanComputeQueue::submit(VkSemaphore waitSemaphore, uint64_t waitValue, VkPipelineStageFlags waitStage) noexcept
+    {
+        // nothing recorded this frame
+        if (!m_isRecording)
+        {
+            return 0;
+        }
+
+        m_isRecording = false;
+        if (!m_commandBuffer.end())
+        {
+            return 0;
+        }
+
+        // signal the next timeline value, optionally after another queue's timeline reached waitValue
+        const uint64_t signalValue = m_timeline.getPendingValue();
+        const VkSemaphore signalSemaphore = m_timeline.get();
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        timelineSubmitInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.pNext                     = nullptr;
+        timelineSubmitInfo.waitSemaphoreValueCount   = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+        timelineSubmitInfo.pWaitSemaphoreValues      = &waitValue;
+        timelineSubmitInfo.signalSemaphoreValueCount = 1;
+        timelineSubmitInfo.pSignalSemaphoreValues    = &signalValue;
+
+        const VkCommandBuffer vkCommandBuffer = m_commandBuffer.get();
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = &timelineSubmitInfo;
+        submitInfo.waitSemaphoreCount   = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+        submitInfo.pWaitSemaphores      = &waitSemaphore;
+        submitInfo.pWaitDstStageMask    = &waitStage;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &vkCommandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &signalSemaphore;
+
+        if (!VK_CHECK(vkQueueSubmit(m_vkQueue, 1, &submitInfo, VK_NULL_HANDLE)))
+        {
+            return 0;
+        }
+
+        m_timeline.markSubmitted(m_currentFrame);
+        return signalValue;
+    }
+
+    void VulkanComputeQueue::releaseBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkAccessFlags srcAccess, uint32_t dstQueueFamilyIndex) const noexcept
+    {
+        // same family: the consumer's regular barrier covers visibility
+        if (!m_isAsync || dstQueueFamilyIndex == m_queueFamilyIndex)
+        {
+            return;
+        }
+
+        // release half; the destination access is ignored and provided by the matching acquire
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstAccessMask       = 0;
+        barrier.srcQueueFamilyIndex = m_queueFamilyIndex;
+        barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+        barrier.buffer              = buffer;
+        barrier.offset              = 0;
+        barrier.size                = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 
+                             0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
+
+    void VulkanComputeQueue::acquireBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess, 
+                                           uint32_t dstQueueFamilyIndex) const noexcept
+    {
+        // same family: the consumer's regular barrier covers visibility
+        if (!m_isAsync || dstQueueFamilyIndex == m_queueFamilyIndex)
+        {
+            return;
+        }
+
+        // acquire half, recorded on the destination queue after waiting on the compute timeline
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = 0;
+        barrier.dstAccessMask       = dstAccess;
+        barrier.srcQueueFamilyIndex = m_queueFamilyIndex;
+        barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+        barrier.buffer              = buffer;
+        barrier.offset              = 0;
+        barrier.size                = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
+}   // namespace keplar
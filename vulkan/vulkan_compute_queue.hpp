@@ -0,0 +1,76 @@
+// ────────────────────────────────────────────
+//  File: vulkan_compute_queue.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_command_buffer.hpp"
+#include "vulkan/vulkan_frame_command_allocator.hpp"
+#include "vulkan/vulkan_frame_timeline.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // compute submission path on the device's compute queue (a dedicated family with mPreferDedicatedComputeQueue).
+    // per frame: beginFrame() waits until the slot's previous dispatches finished and recycles its command buffers,
+    // passes record into getCommandBuffer(), and submit() signals the returned value on the compute timeline.
+    // the graphics submission consumes the results by waiting on getTimelineSemaphore() at that value; compute can
+    // in turn wait on a graphics timeline value (e.g. the frame that last read its output) through submit().
+    //
+    // when the queue is async (isAsync), exclusive resources crossing queues need an ownership transfer:
+    // releaseBuffer() in the compute recording, acquireBuffer() in the consuming queue's recording.
+    // requires the timelineSemaphore feature
+    class VulkanComputeQueue final
+    {
+        public:
+            // creation and destruction
+            VulkanComputeQueue() noexcept;
+            ~VulkanComputeQueue() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanComputeQueue(const VulkanComputeQueue&) = delete;
+            VulkanComputeQueue& operator=(const VulkanComputeQueue&) = delete;
+            VulkanComputeQueue(VulkanComputeQueue&&) = delete;
+            VulkanComputeQueue& operator=(VulkanComputeQueue&&) = delete;
+
+            bool initialize(const VulkanDevice& device, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame recording and submission (submit returns 0 when nothing was submitted)
+            bool beginFrame(uint32_t frameIndex) noexcept;
+            VkCommandBuffer getCommandBuffer() noexcept;
+            uint64_t submit(VkSemaphore waitSemaphore = VK_NULL_HANDLE, uint64_t waitValue = 0, 
+                            VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) noexcept;
+            bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const noexcept { return m_timeline.wait(value, timeout); }
+
+            // usage: queue family ownership transfer of a buffer written by compute (no-op unless async)
+            void releaseBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkAccessFlags srcAccess, uint32_t dstQueueFamilyIndex) const noexcept;
+            void acquireBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess, 
+                               uint32_t dstQueueFamilyIndex) const noexcept;
+
+            // accessors
+            VkSemaphore getTimelineSemaphore() const noexcept { return m_timeline.get(); }
+            uint32_t getQueueFamilyIndex() const noexcept { return m_queueFamilyIndex; }
+            bool isAsync() const noexcept { return m_isAsync; }
+            bool isValid() const noexcept { return m_vkQueue != VK_NULL_HANDLE; }
+            bool isRecording() const noexcept { return m_isRecording; }
+
+        private:
+            // vulkan handles
+            VkQueue                         m_vkQueue;
+            uint32_t                        m_queueFamilyIndex;
+            bool                            m_isAsync;
+
+            // per-frame command buffers and the timeline their submissions signal
+            VulkanFrameCommandAllocator     m_commandAllocator;
+            VulkanFrameTimeline             m_timeline;
+
+            // current frame's recording
+            VulkanCommandBuffer             m_commandBuffer;
+            uint32_t                        m_currentFrame;
+            bool                            m_isRecording;
+    };
+}   // namespace keplar
@@ -5,7 +5,9 @@
 #pragma once
 
 // std headers
+#include <memory>
 #include <vector>
+#include <optional>
 #include <string_view>
 
 // define platform-specific Vulkan surface extension
@@ -23,6 +25,9 @@
 
 namespace keplar 
 {
+    // forward declarations
+    class VulkanFeatureChain;
+
     // default configuration constants
     inline constexpr std::string_view kDefaultApplicationName    = "keplar_vk";
     inline constexpr uint32_t         kDefaultApplicationVersion = VK_MAKE_VERSION(1, 0, 0);
@@ -55,8 +60,110 @@ namespace keplar
         // requested physical device features
         VkPhysicalDeviceFeatures mRequestedFeatures;
 
+        // VkPhysicalDeviceFeatures2 pNext structs (vulkan 1.1-1.4 core and extension features) requested on top; features
+        // the device lacks are dropped with a warning, and the enabled chain is queryable from the device
+        std::shared_ptr<const VulkanFeatureChain> mRequestedFeatureChain;
+
+        // explicit gpu choice by enumeration index or by case-insensitive name substring, instead of the best scored
+        // device; the KEPLAR_DEVICE environment variable (index or name) takes precedence over both
+        std::optional<uint32_t> mPhysicalDeviceIndex;
+        std::string_view mPhysicalDeviceName;
+
+        // headless second logical device on another gpu for offloaded work (baking, ibl precompute); chosen like the
+        // primary among the remaining devices (KEPLAR_SECONDARY_DEVICE), and absent on single gpu systems
+        bool mRequestSecondaryDevice = false;
+
         // hint to prefer dedicated queue families 
         bool mPreferDedicatedComputeQueue = false;
         bool mPreferDedicatedTransferQueue = false;
+
+        // vulkan 1.2 drawIndirectCount (gpu-driven rendering); dropped when unsupported
+        bool mRequestDrawIndirectCount = false;
+
+        // vulkan 1.2 descriptor indexing (bindless texture arrays); dropped when unsupported
+        bool mRequestDescriptorIndexing = false;
+
+        // vulkan 1.2 timeline semaphores (monotonic gpu/cpu sync counters); dropped when unsupported
+        bool mRequestTimelineSemaphore = false;
+
+        // vulkan 1.2 buffer device address (vertex pulling through buffer references); dropped when unsupported
+        bool mRequestBufferDeviceAddress = false;
+
+        // vulkan 1.2 shaderFloat16 (half-precision arithmetic in shaders, e.g. a cheaper shading variant); dropped when unsupported
+        bool mRequestShaderFloat16 = false;
+
+        // vulkan 1.1 multiview (one render pass draws every view of its view mask, shaders select theirs by gl_ViewIndex);
+        // dropped when unsupported
+        bool mRequestMultiview = false;
+
+        // vulkan 1.3 dynamic rendering (vkCmdBeginRendering without render pass/framebuffer objects); dropped when unsupported
+        bool mRequestDynamicRendering = false;
+
+        // vulkan 1.3 synchronization2 (vkCmdPipelineBarrier2 with per-barrier 64-bit stage and access masks, used by
+        // VulkanBarrierBatch); dropped when unsupported, barriers then fall back to vkCmdPipelineBarrier
+        bool mRequestSynchronization2 = false;
+
+        // vulkan 1.3 extended dynamic state (cull mode, front face, topology, depth test/write/compare, depth bias enable)
+        // set at record time instead of baked into pipelines; dropped on older devices
+        bool mRequestExtendedDynamicState = false;
+
+        // VK_KHR_present_id + VK_KHR_present_wait (vblank aligned frame pacing); extensions appended only when supported
+        bool mRequestPresentWait = false;
+
+        // VK_EXT_swapchain_maintenance1 (present mode switches without swapchain recreation); needs the
+        // surface_maintenance1 instance extensions, which are appended when available
+        bool mRequestSwapchainMaintenance1 = false;
+
+        // VK_EXT_memory_budget (per-heap budget and usage, e.g. for texture streaming); appended only when supported
+        bool mRequestMemoryBudget = false;
+
+        // VK_KHR_push_descriptor (small sets written straight into the command buffer, no pool allocation);
+        // appended only when supported
+        bool mRequestPushDescriptor = false;
+
+        // VK_EXT_mesh_shader task and mesh stages (meshlet rendering); needs a vulkan 1.2 device for spir-v 1.4,
+        // appended only when supported
+        bool mRequestMeshShader = false;
+
+        // VK_KHR_fragment_shading_rate per-pipeline rates, plus shading rate attachments where supported; needs render
+        // pass 2 (core in vulkan 1.2), appended only when supported
+        bool mRequestFragmentShadingRate = false;
+
+        // VK_KHR_pipeline_library + VK_EXT_graphics_pipeline_library (pipelines linked from separately compiled parts);
+        // kept only where fast linking is reported, appended only when supported
+        bool mRequestGraphicsPipelineLibrary = false;
+
+        // VK_EXT_shader_object (linked shaders bound without pipelines, every state set at record time); needs a
+        // vulkan 1.3 device, appended only when supported
+        bool mRequestShaderObject = false;
+
+        // vulkan 1.4 host image copy (texture uploads written from the cpu straight into optimal-tiled images, no staging
+        // or submission); kept only where shader-read-only is a host copy destination layout, dropped on older devices
+        bool mRequestHostImageCopy = false;
+
+        // VK_EXT_descriptor_buffer (descriptors written into mapped memory and bound by offset, see VulkanDescriptorBuffer);
+        // needs buffer device address, appended only when supported
+        bool mRequestDescriptorBuffer = false;
+
+        // VK_EXT_device_generated_commands (gpu-written sequences of pipeline switches, push constants and draws, see
+        // VulkanIndirectCommands); needs buffer device address and maintenance5, appended only when supported
+        bool mRequestDeviceGeneratedCommands = false;
+
+        // VK_EXT_multi_draw with shaderDrawParameters (one vkCmdDrawMultiIndexedEXT for consecutive draws sharing state, the
+        // shader telling them apart by gl_DrawID); appended only when supported
+        bool mRequestMultiDraw = false;
+
+        // VK_KHR_acceleration_structure with VK_KHR_ray_query (shaders tracing rays against VulkanAccelerationStructure
+        // from any stage, e.g. for shadows); needs buffer device address, appended only when supported
+        bool mRequestRayQuery = false;
+
+        // VK_NV_low_latency2 (driver paced frame start and latency markers), on top of present wait and timeline semaphores,
+        // else VK_AMD_anti_lag; appended only when supported
+        bool mRequestLowLatency = false;
+
+        // VK_EXT_full_screen_exclusive (win32: swapchains of exclusive fullscreen windows take the display over, see
+        // VulkanSwapchainPolicy::mFullScreenExclusive); needs the get_surface_capabilities2 instance extension, which is
+        // appended when available, and is appended only when supported
+        bool mRequestFullScreenExclusive = false;
     };
 }  // namespace keplar
@@ -8,8 +8,10 @@
 #include "vulkan_instance.hpp"
 #include "vulkan_surface.hpp"
 #include "vulkan_device.hpp"
+#include "vulkan_debug_label.hpp"
 #include "vulkan_utils.hpp"
 #include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
 
 namespace keplar
 {
@@ -20,34 +22,49 @@ namespace keplar
     VulkanContext::~VulkanContext()
     {
         // destroy resources in a reverse order
+        m_vulkanSecondaryDevice.reset();
         m_vulkanDevice.reset();
         m_vulkanSurface.reset();
+        VulkanDebugLabel::reset();
         m_vulkanInstance.reset();
     }
 
     bool VulkanContext::initialize(const Platform& platform, const VulkanContextConfig& config) noexcept
     {
         // create vulkan instance 
-        m_vulkanInstance = VulkanInstance::create(config);
+        m_vulkanInstance = KEPLAR_STARTUP_STEP(VulkanInstance::create(config));
         if (!m_vulkanInstance)
         {
             return false;
         }
 
+        // command buffer labels for gpu captures (when debug utils is enabled)
+        VulkanDebugLabel::initialize(*m_vulkanInstance);
+
         // create presentation surface 
-        m_vulkanSurface = VulkanSurface::create(*m_vulkanInstance, platform);
+        m_vulkanSurface = KEPLAR_STARTUP_STEP(VulkanSurface::create(*m_vulkanInstance, platform));
         if (!m_vulkanSurface)
         {
             return false;
         }
 
         // choose appropriate physical device and create logical device 
-        m_vulkanDevice = VulkanDevice::create(*m_vulkanInstance, *m_vulkanSurface, config);
+        m_vulkanDevice = KEPLAR_STARTUP_STEP(VulkanDevice::create(*m_vulkanInstance, *m_vulkanSurface, config));
         if (!m_vulkanDevice)
         {
             return false;
         }
 
+        // not fatal: offloaded work runs on the primary device instead
+        if (config.mRequestSecondaryDevice)
+        {
+            m_vulkanSecondaryDevice = KEPLAR_STARTUP_STEP(VulkanDevice::createSecondary(*m_vulkanInstance, config, *m_vulkanDevice));
+            if (!m_vulkanSecondaryDevice)
+            {
+                VK_LOG_INFO("VulkanContext::initialize no secondary device, offloaded work stays on the primary device");
+            }
+        }
+
         return true;
     }
 
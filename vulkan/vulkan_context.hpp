@@ -35,6 +35,9 @@ namespace keplar
             std::weak_ptr<VulkanSurface> getSurface() const noexcept { return m_vulkanSurface; }
             std::weak_ptr<VulkanDevice> getDevice() const noexcept { return m_vulkanDevice; }
 
+            // headless device on another gpu for offloaded work; empty unless requested and available
+            std::weak_ptr<VulkanDevice> getSecondaryDevice() const noexcept { return m_vulkanSecondaryDevice; }
+
         private:
             // only accessible by builder for controlled construction and initialization
             VulkanContext() noexcept;
@@ -44,6 +47,7 @@ namespace keplar
             std::shared_ptr<VulkanInstance> m_vulkanInstance;
             std::shared_ptr<VulkanSurface>  m_vulkanSurface;
             std::shared_ptr<VulkanDevice>   m_vulkanDevice;
+            std::shared_ptr<VulkanDevice>   m_vulkanSecondaryDevice;
     };
 
     class VulkanContext::Builder
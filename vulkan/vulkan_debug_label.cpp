@@ -0,0 +1,70 @@
+// ────────────────────────────────────────────
+//  File: vulkan_debug_label.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_debug_label.hpp"
+
+#include "vulkan_instance.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    constexpr const char* kCmdBeginDebugUtilsLabel = "vkCmdBeginDebugUtilsLabelEXT";
+    constexpr const char* kCmdEndDebugUtilsLabel   = "vkCmdEndDebugUtilsLabelEXT";
+
+    PFN_vkCmdBeginDebugUtilsLabelEXT sCmdBeginDebugUtilsLabel = nullptr;
+    PFN_vkCmdEndDebugUtilsLabelEXT   sCmdEndDebugUtilsLabel   = nullptr;
+}
+
+namespace keplar
+{
+    void VulkanDebugLabel::initialize(const VulkanInstance& instance) noexcept
+    {
+        reset();
+        if (!instance.isExtensionEnabled(VK_EXT_DEBUG_UTILS_EXTENSION_NAME))
+        {
+            return;
+        }
+
+        sCmdBeginDebugUtilsLabel = (PFN_vkCmdBeginDebugUtilsLabelEXT)vkGetInstanceProcAddr(instance.get(), kCmdBeginDebugUtilsLabel);
+        sCmdEndDebugUtilsLabel   = (PFN_vkCmdEndDebugUtilsLabelEXT)vkGetInstanceProcAddr(instance.get(), kCmdEndDebugUtilsLabel);
+        if (!sCmdBeginDebugUtilsLabel || !sCmdEndDebugUtilsLabel)
+        {
+            VK_LOG_WARN("vkGetInstanceProcAddr failed to get debug utils label function pointers");
+            reset();
+        }
+    }
+
+    void VulkanDebugLabel::reset() noexcept
+    {
+        sCmdBeginDebugUtilsLabel = nullptr;
+        sCmdEndDebugUtilsLabel = nullptr;
+    }
+
+    void VulkanDebugLabel::begin(VkCommandBuffer commandBuffer, const char* name) noexcept
+    {
+        if (!sCmdBeginDebugUtilsLabel)
+        {
+            return;
+        }
+
+        VkDebugUtilsLabelEXT label{};
+        label.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+        label.pNext = nullptr;
+        label.pLabelName = name;
+        sCmdBeginDebugUtilsLabel(commandBuffer, &label);
+    }
+
+    void VulkanDebugLabel::end(VkCommandBuffer commandBuffer) noexcept
+    {
+        if (sCmdEndDebugUtilsLabel)
+        {
+            sCmdEndDebugUtilsLabel(commandBuffer);
+        }
+    }
+
+    bool VulkanDebugLabel::isEnabled() noexcept
+    {
+        return sCmdBeginDebugUtilsLabel != nullptr;
+    }
+}   // namespace keplar
@@ -0,0 +1,47 @@
+// ────────────────────────────────────────────
+//  File: vulkan_debug_label.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanInstance;
+
+    // VK_EXT_debug_utils command buffer labels, so profiler zones show up by name in gpu captures.
+    // every call is a no-op unless the instance enabled the extension
+    class VulkanDebugLabel final
+    {
+        public:
+            // load the label entry points from an instance (reset when it is destroyed)
+            static void initialize(const VulkanInstance& instance) noexcept;
+            static void reset() noexcept;
+
+            // usage
+            static void begin(VkCommandBuffer commandBuffer, const char* name) noexcept;
+            static void end(VkCommandBuffer commandBuffer) noexcept;
+            static bool isEnabled() noexcept;
+
+            // raii label over a command buffer range
+            class Scope final
+            {
+                public:
+                    Scope(VkCommandBuffer commandBuffer, const char* name) noexcept : m_vkCommandBuffer(commandBuffer) { begin(commandBuffer, name); }
+                    ~Scope() { end(m_vkCommandBuffer); }
+
+                    // disable copy and move semantics to enforce unique ownership
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+                    Scope(Scope&&) = delete;
+                    Scope& operator=(Scope&&) = delete;
+
+                private:
+                    VkCommandBuffer m_vkCommandBuffer;
+            };
+
+            VulkanDebugLabel() = delete;
+    };
+}   // namespace keplar
@@ -0,0 +1,133 @@
+// ────────────────────────────────────────────
+//  File: vulkan_defragmenter.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_defragmenter.hpp"
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanDefragmenter::VulkanDefragmenter() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_frameCount(0)
+        , m_frameIndex(0)
+        , m_pendingFrame(kNoPendingFrame)
+        , m_maxBytes(kDefaultMaxBytes)
+        , m_maxMoves(kDefaultMaxMoves)
+        , m_movedBytes(0)
+        , m_moveCount(0)
+    {
+    }
+
+    bool VulkanDefragmenter::initialize(const VulkanDevice& device, uint32_t frameCount) noexcept
+    {
+        if (frameCount == 0)
+        {
+            VK_LOG_ERROR("VulkanDefragmenter::initialize failed: invalid frame count %u", frameCount);
+            return false;
+        }
+
+        m_vkDevice = device.getDevice();
+        m_memoryAllocator = &device.getMemoryAllocator();
+        m_frameCount = frameCount;
+        m_frameIndex = 0;
+        m_pendingFrame = kNoPendingFrame;
+        m_movedBytes = 0;
+        m_moveCount = 0;
+        VK_LOG_DEBUG("VulkanDefragmenter::initialize successful (%llu bytes, %u moves per pass)",
+                     static_cast<unsigned long long>(m_maxBytes), m_maxMoves);
+        return true;
+    }
+
+    void VulkanDefragmenter::destroy() noexcept
+    {
+        flush();
+        m_memoryAllocator = nullptr;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    bool VulkanDefragmenter::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frameCount)
+        {
+            VK_LOG_ERROR("VulkanDefragmenter::beginFrame failed: frame index %u out of range (%u frames)", frameIndex, m_frameCount);
+            return false;
+        }
+
+        // the caller waited for the slot's last submission, so the copies it recorded have landed
+        m_frameIndex = frameIndex;
+        if (m_pendingFrame == frameIndex)
+        {
+            complete();
+        }
+        return true;
+    }
+
+    uint32_t VulkanDefragmenter::record(const VulkanCommandBuffer& commandBuffer) noexcept
+    {
+        if (!isValid() || isPassPending() || !m_memoryAllocator->beginDefragmentationPass(m_maxBytes, m_maxMoves, m_moves))
+        {
+            return 0;
+        }
+
+        // earlier work on the queue may still write the sources, and later work reads the destinations
+        const VkCommandBuffer vkCommandBuffer = commandBuffer.get();
+        VulkanBarrierBatch barriers;
+        barriers.memoryBarrier(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT,
+                               VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        barriers.flush(vkCommandBuffer);
+
+        uint32_t movedCount = 0;
+        for (VulkanDefragmentationMove& move : m_moves)
+        {
+            auto* buffer = static_cast<VulkanBuffer*>(move.mUserData);
+            move.mIsCanceled = !buffer->relocate(vkCommandBuffer, move.mDestination, m_retiredBuffers);
+            if (!move.mIsCanceled)
+            {
+                m_movedBytes += move.mSource.mSize;
+                movedCount++;
+            }
+        }
+
+        barriers.memoryBarrier(VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT);
+        barriers.flush(vkCommandBuffer);
+
+        m_moveCount += movedCount;
+        m_pendingFrame = m_frameIndex;
+        return movedCount;
+    }
+
+    void VulkanDefragmenter::setBudget(VkDeviceSize maxBytes, uint32_t maxMoves) noexcept
+    {
+        m_maxBytes = maxBytes;
+        m_maxMoves = maxMoves;
+    }
+
+    void VulkanDefragmenter::flush() noexcept
+    {
+        if (isPassPending())
+        {
+            complete();
+        }
+    }
+
+    void VulkanDefragmenter::complete() noexcept
+    {
+        for (VkBuffer vkBuffer : m_retiredBuffers)
+        {
+            vkDestroyBuffer(m_vkDevice, vkBuffer, nullptr);
+        }
+        m_retiredBuffers.clear();
+
+        // frees the sources of applied moves and the destinations of canceled ones
+        m_memoryAllocator->endDefragmentationPass(m_moves);
+        m_pendingFrame = kNoPendingFrame;
+    }
+}   // namespace keplar
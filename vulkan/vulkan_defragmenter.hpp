@@ -0,0 +1,85 @@
+// ────────────────────────────────────────────
+//  File: vulkan_defragmenter.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_memory_allocator.hpp"
+#include "vulkan/vulkan_command_buffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // incremental defragmentation of the device allocator for long sessions, where streaming leaves shared blocks
+    // scattered with holes until allocations fail although enough memory is free in total. every frameCount frames,
+    // record() runs one allocator pass within the byte and move budget: the buffers opted in with
+    // VulkanBuffer::setMovable that live in the emptiest block of a pool are copied on the gpu into fuller blocks and
+    // switched to new handles, so drained blocks are released block by block over many frames.
+    // - fence paced like VulkanReadbackRing: beginFrame(frameIndex), called after the slot's fence wait, completes the
+    //   pass that slot recorded, destroying the previous handles and freeing their memory
+    // - record() goes first into the frame's command buffer, before anything reading movable buffers; their users fetch
+    //   VulkanBuffer::get() again afterwards. images, and buffers kept in descriptor sets, are not moved
+    class VulkanDefragmenter final
+    {
+        public:
+            static constexpr VkDeviceSize kDefaultMaxBytes = 32ull * 1024 * 1024;
+            static constexpr uint32_t     kDefaultMaxMoves = 64;
+
+            // creation and destruction
+            VulkanDefragmenter() noexcept;
+            ~VulkanDefragmenter() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanDefragmenter(const VulkanDefragmenter&) = delete;
+            VulkanDefragmenter& operator=(const VulkanDefragmenter&) = delete;
+            VulkanDefragmenter(VulkanDefragmenter&&) = delete;
+            VulkanDefragmenter& operator=(VulkanDefragmenter&&) = delete;
+
+            bool initialize(const VulkanDevice& device, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame
+            bool beginFrame(uint32_t frameIndex) noexcept;
+            uint32_t record(const VulkanCommandBuffer& commandBuffer) noexcept;
+
+            // usage: bytes and moves one pass may copy, which bounds the gpu time it adds to its frame
+            void setBudget(VkDeviceSize maxBytes, uint32_t maxMoves) noexcept;
+
+            // completes the pending pass; only valid once the device is idle
+            void flush() noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_memoryAllocator != nullptr; }
+            bool isPassPending() const noexcept { return m_pendingFrame != kNoPendingFrame; }
+            uint64_t getMovedBytes() const noexcept { return m_movedBytes; }       // since initialize
+            uint64_t getMoveCount() const noexcept { return m_moveCount; }
+
+        private:
+            void complete() noexcept;
+
+        private:
+            static constexpr uint32_t kNoPendingFrame = UINT32_MAX;
+
+            // vulkan handles
+            VkDevice                                m_vkDevice;
+            VulkanMemoryAllocator*                  m_memoryAllocator;
+
+            // the pass in flight and the handles it replaced
+            std::vector<VulkanDefragmentationMove>  m_moves;
+            std::vector<VkBuffer>                   m_retiredBuffers;
+            uint32_t                                m_frameCount;
+            uint32_t                                m_frameIndex;
+            uint32_t                                m_pendingFrame;
+
+            // budget and totals
+            VkDeviceSize                            m_maxBytes;
+            uint32_t                                m_maxMoves;
+            uint64_t                                m_movedBytes;
+            uint64_t                                m_moveCount;
+    };
+}   // namespace keplar
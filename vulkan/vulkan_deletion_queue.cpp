@@ -0,0 +1,142 @@
+// ────────────────────────────────────────────
+//  File: vulkan_deletion_queue.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_deletion_queue.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanDeletionQueue::~VulkanDeletionQueue()
+    {
+        destroy();
+    }
+
+    bool VulkanDeletionQueue::initialize(uint32_t frameCount) noexcept
+    {
+        // validate input
+        if (frameCount == 0)
+        {
+            VK_LOG_ERROR("VulkanDeletionQueue::initialize failed: frame count is zero");
+            return false;
+        }
+
+        // release anything retired under the previous frame count
+        flush();
+        m_frameDeleters.resize(frameCount);
+        VK_LOG_DEBUG("VulkanDeletionQueue::initialize successful (%u frames)", frameCount);
+        return true;
+    }
+
+    void VulkanDeletionQueue::destroy() noexcept
+    {
+        flush();
+        m_frameDeleters.clear();
+    }
+
+    void VulkanDeletionQueue::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frameDeleters.size())
+        {
+            VK_LOG_ERROR("VulkanDeletionQueue::beginFrame failed: frame index %u out of range (%zu frames)", frameIndex, m_frameDeleters.size());
+            return;
+        }
+
+        // the slot's last submission has completed: nothing retired before it can still be in use.
+        // run in reverse so dependents (views) are released before what they reference (images)
+        auto& deleters = m_frameDeleters[frameIndex];
+        for (auto it = deleters.rbegin(); it != deleters.rend(); ++it)
+        {
+            (*it)();
+        }
+        deleters.clear();
+    }
+
+    void VulkanDeletionQueue::markSubmitted(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frameDeleters.size())
+        {
+            VK_LOG_ERROR("VulkanDeletionQueue::markSubmitted failed: frame index %u out of range (%zu frames)", frameIndex, m_frameDeleters.size());
+            return;
+        }
+
+        // everything retired so far is released once this submission completes
+        auto& deleters = m_frameDeleters[frameIndex];
+        for (auto& deleter : m_pendingDeleters)
+        {
+            deleters.emplace_back(std::move(deleter));
+        }
+        m_pendingDeleters.clear();
+    }
+
+    void VulkanDeletionQueue::collect(uint64_t completedValue) noexcept
+    {
+        // run completed deleters in retirement order, keep the rest
+        size_t keptCount = 0;
+        for (auto& entry : m_timelineDeleters)
+        {
+            if (entry.mValue <= completedValue)
+            {
+                entry.mDeleter();
+            }
+            else
+            {
+                m_timelineDeleters[keptCount++] = std::move(entry);
+            }
+        }
+        m_timelineDeleters.resize(keptCount);
+    }
+
+    void VulkanDeletionQueue::push(std::function<void()> deleter)
+    {
+        if (deleter)
+        {
+            m_pendingDeleters.emplace_back(std::move(deleter));
+        }
+    }
+
+    void VulkanDeletionQueue::push(std::function<void()> deleter, uint64_t timelineValue)
+    {
+        if (deleter)
+        {
+            m_timelineDeleters.push_back({ timelineValue, std::move(deleter) });
+        }
+    }
+
+    void VulkanDeletionQueue::flush() noexcept
+    {
+        // frame slots first, then timeline entries and the deleters not yet attached to a submission
+        for (auto& deleters : m_frameDeleters)
+        {
+            for (auto it = deleters.rbegin(); it != deleters.rend(); ++it)
+            {
+                (*it)();
+            }
+            deleters.clear();
+        }
+
+        for (auto& entry : m_timelineDeleters)
+        {
+            entry.mDeleter();
+        }
+        m_timelineDeleters.clear();
+
+        for (auto it = m_pendingDeleters.rbegin(); it != m_pendingDeleters.rend(); ++it)
+        {
+            (*it)();
+        }
+        m_pendingDeleters.clear();
+    }
+
+    size_t VulkanDeletionQueue::getPendingCount() const noexcept
+    {
+        size_t count = m_pendingDeleters.size() + m_timelineDeleters.size();
+        for (const auto& deleters : m_frameDeleters)
+        {
+            count += deleters.size();
+        }
+        return count;
+    }
+}   // namespace keplar
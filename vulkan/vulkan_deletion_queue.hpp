@@ -0,0 +1,88 @@
+// ────────────────────────────────────────────
+//  File: vulkan_deletion_queue.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <functional>
+#include <type_traits>
+
+namespace keplar
+{
+    // defers destruction of resources that frames still in flight may reference, instead of waiting for device idle.
+    // - keyed by frame slot: deleters pushed while recording are attached to the slot at markSubmitted(), and run when
+    //   that slot begins again, i.e. after the caller waited for its submission, which is ordered after every earlier
+    //   submission on the queue. a frame abandoned before submitting keeps its deleters pending for the next submission
+    // - keyed by timeline value: deleters run from collect() once the timeline (one counter, e.g. the frame timeline)
+    //   reaches the value of the last submission that used the resource
+    class VulkanDeletionQueue final
+    {
+        public:
+            // creation and destruction
+            VulkanDeletionQueue() noexcept = default;
+            ~VulkanDeletionQueue();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanDeletionQueue(const VulkanDeletionQueue&) = delete;
+            VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+            VulkanDeletionQueue(VulkanDeletionQueue&&) = delete;
+            VulkanDeletionQueue& operator=(VulkanDeletionQueue&&) = delete;
+
+            bool initialize(uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: frame slots (call beginFrame after the slot's wait, markSubmitted after its submission)
+            void beginFrame(uint32_t frameIndex) noexcept;
+            void markSubmitted(uint32_t frameIndex) noexcept;
+
+            // usage: timeline values (call collect with the completed counter, e.g. once per frame)
+            void collect(uint64_t completedValue) noexcept;
+
+            // usage: retire resources
+            void push(std::function<void()> deleter);
+            void push(std::function<void()> deleter, uint64_t timelineValue);
+
+            // takes ownership of a movable raii object (buffer, texture, pipeline, framebuffer, unique_ptr, ...) and destroys it later
+            template <typename T>
+            void retire(T&& resource)
+            {
+                push(makeDeleter(std::forward<T>(resource)));
+            }
+
+            template <typename T>
+            void retire(T&& resource, uint64_t timelineValue)
+            {
+                push(makeDeleter(std::forward<T>(resource)), timelineValue);
+            }
+
+            // runs every deleter; only valid once the device is idle
+            void flush() noexcept;
+
+            // accessors
+            size_t getPendingCount() const noexcept;
+
+        private:
+            // std::function needs a copyable callable, so the moved-in object is shared by the deleter's copies
+            template <typename T>
+            static std::function<void()> makeDeleter(T&& resource)
+            {
+                static_assert(!std::is_lvalue_reference_v<T>, "retire takes ownership: pass the resource with std::move");
+                auto holder = std::make_shared<std::decay_t<T>>(std::forward<T>(resource));
+                return [holder]() mutable { holder.reset(); };
+            }
+
+            struct TimelineDeleter
+            {
+                uint64_t                mValue;
+                std::function<void()>   mDeleter;
+            };
+
+        private:
+            std::vector<std::vector<std::function<void()>>> m_frameDeleters;    // attached to a submitted frame slot
+            std::vector<std::function<void()>>              m_pendingDeleters;  // retired since the last submission
+            std::vector<TimelineDeleter>                    m_timelineDeleters; // released once the value completes
+    };
+}   // namespace keplar
@@ -0,0 +1,241 @@
+// ────────────────────────────────────────────
+//  File: vulkan_descriptor_allocator.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_descriptor_allocator.hpp"
+
+#include <algorithm>
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    // per-set descriptor floor of growth pools, so types the requirements never named still find room
+    constexpr keplar::DescriptorRequirements kGrowthRatios =
+    {
+        1,      // sets
+        2,      // uniform buffers
+        4,      // combined image samplers
+        2,      // storage buffers
+        1,      // dynamic uniform buffers
+        1,      // dynamic storage buffers
+        1,      // storage images
+        0,      // acceleration structures (only pools of requirements naming them)
+    };
+
+    // descriptors of one type for setCount sets: the larger of the floor and the requirements' own per-set mix
+    uint32_t scaledCount(uint32_t floorPerSet, uint32_t requiredCount, uint32_t requiredSets, uint32_t setCount) noexcept
+    {
+        uint64_t required = requiredSets ? (static_cast<uint64_t>(requiredCount) * setCount + requiredSets - 1) / requiredSets : 0;
+        return static_cast<uint32_t>(std::max<uint64_t>(static_cast<uint64_t>(floorPerSet) * setCount, required));
+    }
+}   // namespace
+
+namespace keplar
+{
+    VulkanDescriptorAllocator::VulkanDescriptorAllocator() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_flags(0)
+        , m_currentPool(VK_NULL_HANDLE)
+        , m_requirements{}
+        , m_nextSetCount(kDefaultSetsPerPool)
+    {
+    }
+
+    VulkanDescriptorAllocator::~VulkanDescriptorAllocator()
+    {
+        destroy();
+    }
+
+    void VulkanDescriptorAllocator::addRequirements(const DescriptorRequirements& requirements) noexcept
+    {
+        // add requirements to aggregate totals
+        m_requirements.mMaxSets                     += requirements.mMaxSets;
+        m_requirements.mUniformCount                += requirements.mUniformCount;
+        m_requirements.mSamplerCount                += requirements.mSamplerCount;
+        m_requirements.mStorageBufferCount          += requirements.mStorageBufferCount;
+        m_requirements.mDynamicUniformCount         += requirements.mDynamicUniformCount;
+        m_requirements.mDynamicStorageBufferCount   += requirements.mDynamicStorageBufferCount;
+        m_requirements.mStorageImageCount           += requirements.mStorageImageCount;
+        m_requirements.mAccelerationStructureCount  += requirements.mAccelerationStructureCount;
+    }
+
+    bool VulkanDescriptorAllocator::initialize(VkDevice vkDevice, VkDescriptorPoolCreateFlags flags) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanDescriptorAllocator::initialize failed: VkDevice is VK_NULL_HANDLE");
+            return false;
+        }
+
+        destroy();
+        m_vkDevice = vkDevice;
+        m_flags = flags;
+
+        // the first pool holds exactly what was asked for; without requirements it is created on first use
+        if (m_requirements.mMaxSets > 0)
+        {
+            std::vector<VkDescriptorPoolSize> poolSizes = getDescriptorPoolSizes(m_requirements);
+
+            VkDescriptorPoolCreateInfo poolCreateInfo{};
+            poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolCreateInfo.flags = m_flags;
+            poolCreateInfo.maxSets = m_requirements.mMaxSets;
+            poolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+            poolCreateInfo.pPoolSizes = poolSizes.data();
+
+            VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolCreateInfo, nullptr, &m_currentPool);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("VulkanDescriptorAllocator :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                m_vkDevice = VK_NULL_HANDLE;
+                return false;
+            }
+            m_usedPools.push_back(m_currentPool);
+        }
+
+        m_nextSetCount = std::clamp(m_requirements.mMaxSets * 2, kDefaultSetsPerPool, kMaxSetsPerPool);
+        VK_LOG_DEBUG("VulkanDescriptorAllocator::initialize successful (%u initial sets)", m_requirements.mMaxSets);
+        return true;
+    }
+
+    void VulkanDescriptorAllocator::destroy() noexcept
+    {
+        // destroying a pool frees every set allocated from it
+        for (VkDescriptorPool vkDescriptorPool : m_usedPools)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, vkDescriptorPool, nullptr);
+        }
+        for (VkDescriptorPool vkDescriptorPool : m_freePools)
+        {
+            vkDestroyDescriptorPool(m_vkDevice, vkDescriptorPool, nullptr);
+        }
+
+        m_usedPools.clear();
+        m_freePools.clear();
+        m_currentPool = VK_NULL_HANDLE;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    bool VulkanDescriptorAllocator::allocate(VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet, const void* pNext) noexcept
+    {
+        return allocate(&layout, 1, &descriptorSet, pNext);
+    }
+
+    bool VulkanDescriptorAllocator::allocate(const VkDescriptorSetLayout* layouts, uint32_t count, VkDescriptorSet* descriptorSets, const void* pNext) noexcept
+    {
+        // validate state and input
+        if (m_vkDevice == VK_NULL_HANDLE || layouts == nullptr || descriptorSets == nullptr)
+        {
+            VK_LOG_ERROR("VulkanDescriptorAllocator::allocate failed: allocator not initialized or invalid input");
+            return false;
+        }
+        if (count == 0)
+        {
+            return true;
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext = pNext;
+        allocateInfo.descriptorSetCount = count;
+        allocateInfo.pSetLayouts = layouts;
+
+        // the current pool first, then once more from a fresh pool when it is exhausted
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            if (m_currentPool == VK_NULL_HANDLE && !acquireNextPool(count))
+            {
+                return false;
+            }
+
+            allocateInfo.descriptorPool = m_currentPool;
+            VkResult vkResult = vkAllocateDescriptorSets(m_vkDevice, &allocateInfo, descriptorSets);
+            if (vkResult == VK_SUCCESS)
+            {
+                return true;
+            }
+
+            // any other error is not about capacity and a new pool would not help
+            if (vkResult != VK_ERROR_OUT_OF_POOL_MEMORY && vkResult != VK_ERROR_FRAGMENTED_POOL)
+            {
+                VK_LOG_FATAL("VulkanDescriptorAllocator :: vkAllocateDescriptorSets failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                return false;
+            }
+            m_currentPool = VK_NULL_HANDLE;
+        }
+
+        VK_LOG_ERROR("VulkanDescriptorAllocator::allocate failed: %u sets do not fit a fresh pool", count);
+        return false;
+    }
+
+    void VulkanDescriptorAllocator::reset() noexcept
+    {
+        // pools keep their size, so the next frame runs without creating any once the chain has grown enough
+        for (VkDescriptorPool vkDescriptorPool : m_usedPools)
+        {
+            vkResetDescriptorPool(m_vkDevice, vkDescriptorPool, 0);
+            m_freePools.push_back(vkDescriptorPool);
+        }
+
+        m_usedPools.clear();
+        m_currentPool = VK_NULL_HANDLE;
+    }
+
+    bool VulkanDescriptorAllocator::createPool(uint32_t setCount, VkDescriptorPool& vkDescriptorPool) const noexcept
+    {
+        // every descriptor type, in at least the mix of the requirements
+        DescriptorRequirements sizes{};
+        sizes.mMaxSets                      = setCount;
+        sizes.mUniformCount                 = scaledCount(kGrowthRatios.mUniformCount, m_requirements.mUniformCount, m_requirements.mMaxSets, setCount);
+        sizes.mSamplerCount                 = scaledCount(kGrowthRatios.mSamplerCount, m_requirements.mSamplerCount, m_requirements.mMaxSets, setCount);
+        sizes.mStorageBufferCount           = scaledCount(kGrowthRatios.mStorageBufferCount, m_requirements.mStorageBufferCount, m_requirements.mMaxSets, setCount);
+        sizes.mDynamicUniformCount          = scaledCount(kGrowthRatios.mDynamicUniformCount, m_requirements.mDynamicUniformCount, m_requirements.mMaxSets, setCount);
+        sizes.mDynamicStorageBufferCount    = scaledCount(kGrowthRatios.mDynamicStorageBufferCount, m_requirements.mDynamicStorageBufferCount, m_requirements.mMaxSets, setCount);
+        sizes.mStorageImageCount            = scaledCount(kGrowthRatios.mStorageImageCount, m_requirements.mStorageImageCount, m_requirements.mMaxSets, setCount);
+        sizes.mAccelerationStructureCount   = scaledCount(kGrowthRatios.mAccelerationStructureCount, m_requirements.mAccelerationStructureCount, m_requirements.mMaxSets, setCount);
+        std::vector<VkDescriptorPoolSize> poolSizes = getDescriptorPoolSizes(sizes);
+
+        VkDescriptorPoolCreateInfo poolCreateInfo{};
+        poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.flags = m_flags;
+        poolCreateInfo.maxSets = setCount;
+        poolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolCreateInfo.pPoolSizes = poolSizes.data();
+
+        VkResult vkResult = vkCreateDescriptorPool(m_vkDevice, &poolCreateInfo, nullptr, &vkDescriptorPool);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("VulkanDescriptorAllocator :: vkCreateDescriptorPool failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanDescriptorAllocator::acquireNextPool(uint32_t minSetCount) noexcept
+    {
+        // pools emptied by reset() come first
+        if (!m_freePools.empty())
+        {
+            m_currentPool = m_freePools.back();
+            m_freePools.pop_back();
+            m_usedPools.push_back(m_currentPool);
+            return true;
+        }
+
+        // chain a new pool, doubling the size of the next one
+        uint32_t setCount = std::max(m_nextSetCount, minSetCount);
+        VkDescriptorPool vkDescriptorPool = VK_NULL_HANDLE;
+        if (!createPool(setCount, vkDescriptorPool))
+        {
+            return false;
+        }
+
+        m_currentPool = vkDescriptorPool;
+        m_usedPools.push_back(m_currentPool);
+        m_nextSetCount = std::min(m_nextSetCount * 2, kMaxSetsPerPool);
+        VK_LOG_DEBUG("VulkanDescriptorAllocator :: chained descriptor pool %zu (%u sets)", m_usedPools.size() + m_freePools.size(), setCount);
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,68 @@
+// ────────────────────────────────────────────
+//  File: vulkan_descriptor_allocator.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan_config.hpp"
+#include "vulkan_descriptor_pool.hpp"
+
+namespace keplar
+{
+    // growable descriptor allocator: a chain of pools that never runs out. the first pool is sized exactly from the
+    // requirements added before initialize(); when a pool is exhausted (out of pool memory or fragmented) a new one is
+    // chained, twice the size of the last one, holding every descriptor type in the mix the requirements asked for.
+    // reset() recycles every set of every pool in one call per pool, so an allocator per frame in flight serves
+    // transient sets that live until the same frame index begins again. not thread-safe
+    class VulkanDescriptorAllocator final
+    {
+        public:
+            // sets per chained pool: the first growth pool, doubled per chained pool up to the cap
+            static constexpr uint32_t kDefaultSetsPerPool   = 64;
+            static constexpr uint32_t kMaxSetsPerPool       = 4096;
+
+            // creation and destruction
+            VulkanDescriptorAllocator() noexcept;
+            ~VulkanDescriptorAllocator();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanDescriptorAllocator(const VulkanDescriptorAllocator&) = delete;
+            VulkanDescriptorAllocator& operator=(const VulkanDescriptorAllocator&) = delete;
+            VulkanDescriptorAllocator(VulkanDescriptorAllocator&&) = delete;
+            VulkanDescriptorAllocator& operator=(VulkanDescriptorAllocator&&) = delete;
+
+            // setup: requirements are optional, without them pools are sized from kDefaultSetsPerPool alone
+            void addRequirements(const DescriptorRequirements& requirements) noexcept;
+            bool initialize(VkDevice vkDevice, VkDescriptorPoolCreateFlags flags = 0) noexcept;
+            void destroy() noexcept;
+
+            // usage: pNext chains into VkDescriptorSetAllocateInfo (e.g. variable descriptor counts)
+            bool allocate(VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet, const void* pNext = nullptr) noexcept;
+            bool allocate(const VkDescriptorSetLayout* layouts, uint32_t count, VkDescriptorSet* descriptorSets, const void* pNext = nullptr) noexcept;
+
+            // usage: frees every set allocated so far, only once the gpu no longer reads any of them
+            void reset() noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_vkDevice != VK_NULL_HANDLE; }
+            uint32_t getPoolCount() const noexcept { return static_cast<uint32_t>(m_usedPools.size() + m_freePools.size()); }
+
+        private:
+            bool createPool(uint32_t setCount, VkDescriptorPool& vkDescriptorPool) const noexcept;
+            bool acquireNextPool(uint32_t minSetCount) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkDescriptorPoolCreateFlags     m_flags;
+            VkDescriptorPool                m_currentPool;
+            std::vector<VkDescriptorPool>   m_usedPools;        // exhausted pools, current one included
+            std::vector<VkDescriptorPool>   m_freePools;        // pools emptied by reset(), reused before creating new ones
+
+            // sizing: the first pool holds the requirements, growth pools their per-set mix
+            DescriptorRequirements          m_requirements;
+            uint32_t                        m_nextSetCount;
+    };
+}   // namespace keplar
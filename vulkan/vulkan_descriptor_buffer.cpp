@@ -0,0 +1,290 @@
+// ────────────────────────────────────────────
+//  File: vulkan_descriptor_buffer.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_descriptor_buffer.hpp"
+
+#include <array>
+#include <cstring>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // sets one setOffsets() call binds (above the guaranteed maxBoundDescriptorSets of 4)
+    constexpr uint32_t kMaxBoundSets = 8;
+
+    inline VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+namespace keplar
+{
+    VulkanDescriptorBuffer::VulkanDescriptorBuffer() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_mappedData(nullptr)
+        , m_address(0)
+        , m_properties{}
+        , m_uniformAlignment(1)
+        , m_frameSize(0)
+        , m_frameCount(0)
+        , m_frameBase(0)
+        , m_cursor(0)
+    {
+    }
+
+    bool VulkanDescriptorBuffer::initialize(const VulkanDevice& device, VkDeviceSize descriptorBytes, VkDeviceSize uniformBytes, uint32_t frameCount) noexcept
+    {
+        if (!device.isDescriptorBufferEnabled() || !isDescriptorBufferLoaded())
+        {
+            VK_LOG_ERROR("VulkanDescriptorBuffer::initialize failed: descriptor buffers are not enabled on the device");
+            return false;
+        }
+
+        // both alignments are powers of two, so a frame size aligned to the larger keeps every frame region aligned too
+        m_vkDevice = device.getDevice();
+        m_properties = device.getDescriptorBufferProperties();
+        m_uniformAlignment = std::max<VkDeviceSize>(1, device.getPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment);
+        const VkDeviceSize setAlignment = std::max<VkDeviceSize>(1, m_properties.descriptorBufferOffsetAlignment);
+        const VkDeviceSize frameAlignment = std::max(setAlignment, m_uniformAlignment);
+        m_frameSize = alignUp(alignUp(descriptorBytes, setAlignment) + alignUp(uniformBytes, m_uniformAlignment), frameAlignment);
+        m_frameCount = frameCount;
+
+        // resource and sampler descriptors share the buffer, within the address space the device gives each kind
+        const VkDeviceSize totalSize = m_frameSize * frameCount;
+        if (m_frameSize == 0 || frameCount == 0 || totalSize > m_properties.maxResourceDescriptorBufferRange ||
+            totalSize > m_properties.maxSamplerDescriptorBufferRange)
+        {
+            VK_LOG_ERROR("VulkanDescriptorBuffer::initialize failed: invalid frame size %llu or frame count %u",
+                         static_cast<unsigned long long>(m_frameSize), frameCount);
+            return false;
+        }
+
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferCreateInfo.size = totalSize;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_buffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true, true))
+        {
+            VK_LOG_ERROR("VulkanDescriptorBuffer::initialize failed to create the descriptor buffer");
+            return false;
+        }
+
+        m_mappedData = static_cast<uint8_t*>(m_buffer.getMappedData());
+        m_address = m_buffer.getDeviceAddress();
+        m_frameBase = 0;
+        m_cursor = 0;
+        VK_LOG_DEBUG("VulkanDescriptorBuffer::initialize successful (%u frames of %llu bytes)", frameCount, static_cast<unsigned long long>(m_frameSize));
+        return true;
+    }
+
+    void VulkanDescriptorBuffer::destroy() noexcept
+    {
+        m_buffer = VulkanBuffer();
+        m_mappedData = nullptr;
+        m_address = 0;
+        m_frameSize = 0;
+        m_frameCount = 0;
+        m_frameBase = 0;
+        m_cursor = 0;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    bool VulkanDescriptorBuffer::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frameCount)
+        {
+            VK_LOG_ERROR("VulkanDescriptorBuffer::beginFrame failed: frame index %u out of range (%u frames)", frameIndex, m_frameCount);
+            return false;
+        }
+
+        m_frameBase = m_frameSize * frameIndex;
+        m_cursor = 0;
+        return true;
+    }
+
+    bool VulkanDescriptorBuffer::allocate(VkDescriptorSetLayout layout, DescriptorBufferSet& set) noexcept
+    {
+        VkDeviceSize layoutSize = 0;
+        s_vkGetDescriptorSetLayoutSizeEXT(m_vkDevice, layout, &layoutSize);
+
+        VkDeviceSize offset = 0;
+        if (!reserve(layoutSize, m_properties.descriptorBufferOffsetAlignment, offset))
+        {
+            return false;
+        }
+
+        set.mLayout = layout;
+        set.mOffset = offset;
+        set.mData   = m_mappedData + offset;
+        return true;
+    }
+
+    bool VulkanDescriptorBuffer::pushUniform(const void* data, VkDeviceSize size, VkDeviceAddress& address) noexcept
+    {
+        VkDeviceSize offset = 0;
+        if (data == nullptr || !reserve(size, m_uniformAlignment, offset))
+        {
+            return false;
+        }
+
+        std::memcpy(m_mappedData + offset, data, static_cast<size_t>(size));
+        address = m_address + offset;
+        return m_buffer.flush(offset, size);
+    }
+
+    void VulkanDescriptorBuffer::writeBuffer(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type, VkDeviceAddress address,
+                                             VkDeviceSize range, uint32_t arrayElement) const noexcept
+    {
+        VkDescriptorAddressInfoEXT addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+        addressInfo.pNext = nullptr;
+        addressInfo.address = address;
+        addressInfo.range = range;
+        addressInfo.format = VK_FORMAT_UNDEFINED;
+
+        VkDescriptorGetInfoEXT getInfo{};
+        getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+        getInfo.pNext = nullptr;
+        getInfo.type = type;
+        if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+        {
+            getInfo.data.pUniformBuffer = &addressInfo;
+        }
+        else if (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+        {
+            getInfo.data.pStorageBuffer = &addressInfo;
+        }
+        else
+        {
+            VK_LOG_ERROR("VulkanDescriptorBuffer::writeBuffer : descriptor type %d is not a buffer descriptor", static_cast<int>(type));
+            return;
+        }
+
+        writeDescriptor(set, binding, arrayElement, getInfo);
+    }
+
+    void VulkanDescriptorBuffer::writeImage(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type, VkSampler sampler,
+                                            VkImageView imageView, VkImageLayout imageLayout, uint32_t arrayElement) const noexcept
+    {
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = sampler;
+        imageInfo.imageView = imageView;
+        imageInfo.imageLayout = imageLayout;
+
+        VkDescriptorGetInfoEXT getInfo{};
+        getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+        getInfo.pNext = nullptr;
+        getInfo.type = type;
+        switch (type)
+        {
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:     getInfo.data.pCombinedImageSampler = &imageInfo; break;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:              getInfo.data.pSampledImage = &imageInfo; break;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:              getInfo.data.pStorageImage = &imageInfo; break;
+            case VK_DESCRIPTOR_TYPE_SAMPLER:                    getInfo.data.pSampler = &imageInfo.sampler; break;
+            default:
+                VK_LOG_ERROR("VulkanDescriptorBuffer::writeImage : descriptor type %d is not an image descriptor", static_cast<int>(type));
+                return;
+        }
+
+        writeDescriptor(set, binding, arrayElement, getInfo);
+    }
+
+    void VulkanDescriptorBuffer::bind(VkCommandBuffer vkCommandBuffer) const noexcept
+    {
+        // one binding serves resources and samplers (the buffer was created with both usages)
+        VkDescriptorBufferBindingInfoEXT bindingInfo{};
+        bindingInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+        bindingInfo.pNext = nullptr;
+        bindingInfo.address = m_address;
+        bindingInfo.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+        s_vkCmdBindDescriptorBuffersEXT(vkCommandBuffer, 1, &bindingInfo);
+    }
+
+    void VulkanDescriptorBuffer::setOffsets(VkCommandBuffer vkCommandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet,
+                                            uint32_t setCount, const DescriptorBufferSet* sets) const noexcept
+    {
+        if (setCount == 0 || setCount > kMaxBoundSets)
+        {
+            VK_LOG_ERROR("VulkanDescriptorBuffer::setOffsets : %u sets, up to %u are bound at once", setCount, kMaxBoundSets);
+            return;
+        }
+
+        // every set lives in buffer binding 0
+        std::array<uint32_t, kMaxBoundSets> bufferIndices{};
+        std::array<VkDeviceSize, kMaxBoundSets> offsets{};
+        for (uint32_t i = 0; i < setCount; ++i)
+        {
+            offsets[i] = sets[i].mOffset;
+        }
+        s_vkCmdSetDescriptorBufferOffsetsEXT(vkCommandBuffer, bindPoint, layout, firstSet, setCount, bufferIndices.data(), offsets.data());
+    }
+
+    bool VulkanDescriptorBuffer::loadDescriptorBuffer(VkDevice vkDevice) noexcept
+    {
+        s_vkGetDescriptorSetLayoutSizeEXT = (PFN_vkGetDescriptorSetLayoutSizeEXT)vkGetDeviceProcAddr(vkDevice, "vkGetDescriptorSetLayoutSizeEXT");
+        s_vkGetDescriptorSetLayoutBindingOffsetEXT = (PFN_vkGetDescriptorSetLayoutBindingOffsetEXT)vkGetDeviceProcAddr(vkDevice, "vkGetDescriptorSetLayoutBindingOffsetEXT");
+        s_vkCmdBindDescriptorBuffersEXT = (PFN_vkCmdBindDescriptorBuffersEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdBindDescriptorBuffersEXT");
+        s_vkCmdSetDescriptorBufferOffsetsEXT = (PFN_vkCmdSetDescriptorBufferOffsetsEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetDescriptorBufferOffsetsEXT");
+        s_vkGetDescriptorEXT = (PFN_vkGetDescriptorEXT)vkGetDeviceProcAddr(vkDevice, "vkGetDescriptorEXT");
+        if (s_vkGetDescriptorSetLayoutSizeEXT == nullptr || s_vkGetDescriptorSetLayoutBindingOffsetEXT == nullptr ||
+            s_vkCmdBindDescriptorBuffersEXT == nullptr || s_vkCmdSetDescriptorBufferOffsetsEXT == nullptr || s_vkGetDescriptorEXT == nullptr)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get descriptor buffer function pointers");
+            s_vkGetDescriptorEXT = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanDescriptorBuffer::reserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) noexcept
+    {
+        // the frame region is sized up front, running past it would overwrite the next frame
+        const VkDeviceSize candidate = alignUp(m_cursor, std::max<VkDeviceSize>(1, alignment));
+        if (!isValid() || size == 0 || candidate + size > m_frameSize)
+        {
+            VK_LOG_ERROR_THROTTLED("VulkanDescriptorBuffer::reserve failed: %llu bytes do not fit the frame region", static_cast<unsigned long long>(size));
+            return false;
+        }
+
+        offset = m_frameBase + candidate;
+        m_cursor = candidate + size;
+        return true;
+    }
+
+    size_t VulkanDescriptorBuffer::getDescriptorSize(VkDescriptorType type) const noexcept
+    {
+        switch (type)
+        {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:             return m_properties.uniformBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:             return m_properties.storageBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:     return m_properties.combinedImageSamplerDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:              return m_properties.sampledImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:              return m_properties.storageImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLER:                    return m_properties.samplerDescriptorSize;
+            default:                                            return 0;
+        }
+    }
+
+    void VulkanDescriptorBuffer::writeDescriptor(const DescriptorBufferSet& set, uint32_t binding, uint32_t arrayElement,
+                                                 const VkDescriptorGetInfoEXT& getInfo) const noexcept
+    {
+        // array elements of a binding are packed at the descriptor size
+        const size_t descriptorSize = getDescriptorSize(getInfo.type);
+        VkDeviceSize bindingOffset = 0;
+        s_vkGetDescriptorSetLayoutBindingOffsetEXT(m_vkDevice, set.mLayout, binding, &bindingOffset);
+
+        const VkDeviceSize offset = bindingOffset + static_cast<VkDeviceSize>(arrayElement) * descriptorSize;
+        s_vkGetDescriptorEXT(m_vkDevice, &getInfo, descriptorSize, set.mData + offset);
+        m_buffer.flush(set.mOffset + offset, descriptorSize);
+    }
+}   // namespace keplar
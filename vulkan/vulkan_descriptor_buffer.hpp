@@ -0,0 +1,108 @@
+// ────────────────────────────────────────────
+//  File: vulkan_descriptor_buffer.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // a set written into a descriptor buffer: the layout its bytes follow and where they start
+    struct DescriptorBufferSet
+    {
+        VkDescriptorSetLayout   mLayout = VK_NULL_HANDLE;
+        VkDeviceSize            mOffset = 0;            // from the start of the buffer, as bound by setOffsets()
+        uint8_t*                mData   = nullptr;      // mapped bytes of the set
+    };
+
+    // VK_EXT_descriptor_buffer backend (VulkanDevice::isDescriptorBufferEnabled): one persistently mapped buffer, in
+    // resizable bar memory when the device exposes it, split into a region per frame in flight like VulkanUniformArena.
+    // a frame's sets are sub-allocated at the layout's size and written with vkGetDescriptorEXT straight into the mapping,
+    // and the uniform blocks they point at are pushed into the same region, so per-frame descriptors need no pool, set
+    // allocation or update call. beginFrame() rewinds the frame's cursor, only once that frame's fence signaled.
+    //
+    // layouts must be created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT and pipelines with
+    // VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT; a command buffer binds the buffer once with bind(), then selects
+    // sets by offset with setOffsets(). not thread-safe
+    class VulkanDescriptorBuffer final
+    {
+        public:
+            // creation and destruction
+            VulkanDescriptorBuffer() noexcept;
+            ~VulkanDescriptorBuffer() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanDescriptorBuffer(const VulkanDescriptorBuffer&) = delete;
+            VulkanDescriptorBuffer& operator=(const VulkanDescriptorBuffer&) = delete;
+            VulkanDescriptorBuffer(VulkanDescriptorBuffer&&) = delete;
+            VulkanDescriptorBuffer& operator=(VulkanDescriptorBuffer&&) = delete;
+
+            // a frame region holds descriptorBytes of sets and uniformBytes of blocks, each plus its alignment padding
+            bool initialize(const VulkanDevice& device, VkDeviceSize descriptorBytes, VkDeviceSize uniformBytes, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame
+            bool beginFrame(uint32_t frameIndex) noexcept;
+            bool allocate(VkDescriptorSetLayout layout, DescriptorBufferSet& set) noexcept;
+            bool pushUniform(const void* data, VkDeviceSize size, VkDeviceAddress& address) noexcept;
+
+            template <typename T>
+            bool pushUniform(const T& block, VkDeviceAddress& address) noexcept { return pushUniform(&block, sizeof(T), address); }
+
+            // usage: descriptor writes into an allocated set (uniform, storage buffers; sampled, storage images and samplers)
+            void writeBuffer(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type, VkDeviceAddress address,
+                             VkDeviceSize range, uint32_t arrayElement = 0) const noexcept;
+            void writeImage(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type, VkSampler sampler,
+                            VkImageView imageView, VkImageLayout imageLayout, uint32_t arrayElement = 0) const noexcept;
+
+            // usage: recording
+            void bind(VkCommandBuffer vkCommandBuffer) const noexcept;
+            void setOffsets(VkCommandBuffer vkCommandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet,
+                            uint32_t setCount, const DescriptorBufferSet* sets) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_mappedData != nullptr; }
+            VkBuffer getBuffer() const noexcept { return m_buffer.get(); }
+
+            // loaded by the device that enables the extension
+            static bool loadDescriptorBuffer(VkDevice vkDevice) noexcept;
+            static bool isDescriptorBufferLoaded() noexcept { return s_vkGetDescriptorEXT != nullptr; }
+
+        private:
+            bool reserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) noexcept;
+            size_t getDescriptorSize(VkDescriptorType type) const noexcept;
+            void writeDescriptor(const DescriptorBufferSet& set, uint32_t binding, uint32_t arrayElement,
+                                 const VkDescriptorGetInfoEXT& getInfo) const noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                    m_vkDevice;
+
+            // persistently mapped storage of every frame region
+            VulkanBuffer                m_buffer;
+            uint8_t*                    m_mappedData;
+            VkDeviceAddress             m_address;
+
+            // descriptor sizes and the alignments sets and uniform blocks start at
+            VkPhysicalDeviceDescriptorBufferPropertiesEXT m_properties;
+            VkDeviceSize                m_uniformAlignment;
+
+            // linear cursor into the current frame region
+            VkDeviceSize                m_frameSize;
+            uint32_t                    m_frameCount;
+            VkDeviceSize                m_frameBase;
+            VkDeviceSize                m_cursor;
+
+            // extension commands, shared by every instance
+            inline static PFN_vkGetDescriptorSetLayoutSizeEXT           s_vkGetDescriptorSetLayoutSizeEXT = nullptr;
+            inline static PFN_vkGetDescriptorSetLayoutBindingOffsetEXT  s_vkGetDescriptorSetLayoutBindingOffsetEXT = nullptr;
+            inline static PFN_vkGetDescriptorEXT                        s_vkGetDescriptorEXT = nullptr;
+            inline static PFN_vkCmdBindDescriptorBuffersEXT             s_vkCmdBindDescriptorBuffersEXT = nullptr;
+            inline static PFN_vkCmdSetDescriptorBufferOffsetsEXT        s_vkCmdSetDescriptorBufferOffsetsEXT = nullptr;
+    };
+}   // namespace keplar
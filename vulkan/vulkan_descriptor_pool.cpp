@@ -3,10 +3,40 @@
 // ────────────────────────────────────────────
 
 #include "vulkan/vulkan_descriptor_pool.hpp"
+
+#include <iterator>
+#include <utility>
+
 #include "utils/logger.hpp"
 
 namespace keplar
 {
+    std::vector<VkDescriptorPoolSize> getDescriptorPoolSizes(const DescriptorRequirements& requirements) noexcept
+    {
+        const std::pair<VkDescriptorType, uint32_t> counts[] =
+        {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,            requirements.mUniformCount },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,    requirements.mSamplerCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,            requirements.mStorageBufferCount },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,    requirements.mDynamicUniformCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,    requirements.mDynamicStorageBufferCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,             requirements.mStorageImageCount },
+            { VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, requirements.mAccelerationStructureCount },
+        };
+
+        // zero-sized pool sizes are invalid, unused types are left out
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        poolSizes.reserve(std::size(counts));
+        for (const auto& [type, count] : counts)
+        {
+            if (count)
+            {
+                poolSizes.push_back({ type, count });
+            }
+        }
+        return poolSizes;
+    }
+
     VulkanDescriptorPool::VulkanDescriptorPool() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
         , m_vkDescriptorPool(VK_NULL_HANDLE)
@@ -63,6 +93,11 @@ namespace keplar
         m_requirements.mMaxSets         += requirement.mMaxSets;
         m_requirements.mUniformCount    += requirement.mUniformCount;
         m_requirements.mSamplerCount    += requirement.mSamplerCount;
+        m_requirements.mStorageBufferCount += requirement.mStorageBufferCount;
+        m_requirements.mDynamicUniformCount += requirement.mDynamicUniformCount;
+        m_requirements.mDynamicStorageBufferCount += requirement.mDynamicStorageBufferCount;
+        m_requirements.mStorageImageCount += requirement.mStorageImageCount;
+        m_requirements.mAccelerationStructureCount += requirement.mAccelerationStructureCount;
     }
 
     bool VulkanDescriptorPool::initialize(VkDevice vkDevice) noexcept
@@ -75,22 +110,7 @@ namespace keplar
         }
 
         // prepare vulkan descriptor pool sizes based on aggregated requirements
-        std::vector<VkDescriptorPoolSize> poolSizes;
-        poolSizes.reserve(2);
-        if (m_requirements.mUniformCount)
-        {
-            VkDescriptorPoolSize uniformPoolSize{};
-            uniformPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            uniformPoolSize.descriptorCount = m_requirements.mUniformCount;
-            poolSizes.emplace_back(std::move(uniformPoolSize));
-        }
-        if (m_requirements.mSamplerCount)
-        {
-            VkDescriptorPoolSize samplerPoolSize{};
-            samplerPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            samplerPoolSize.descriptorCount = m_requirements.mSamplerCount;
-            poolSizes.emplace_back(std::move(samplerPoolSize));
-        }
+        std::vector<VkDescriptorPoolSize> poolSizes = getDescriptorPoolSizes(m_requirements);
 
         // descriptor pool creation info structure
         VkDescriptorPoolCreateInfo poolCreateInfo{};
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "vulkan_config.hpp"
 
 namespace keplar
@@ -13,8 +15,16 @@ namespace keplar
         uint32_t mMaxSets;
         uint32_t mUniformCount;
         uint32_t mSamplerCount;
+        uint32_t mStorageBufferCount;
+        uint32_t mDynamicUniformCount;
+        uint32_t mDynamicStorageBufferCount;
+        uint32_t mStorageImageCount;
+        uint32_t mAccelerationStructureCount;
     };
 
+    // one pool size per descriptor type the requirements use
+    std::vector<VkDescriptorPoolSize> getDescriptorPoolSizes(const DescriptorRequirements& requirements) noexcept;
+
     class VulkanDescriptorPool
     {
         public:   
@@ -10,6 +10,7 @@ namespace keplar
     VulkanDescriptorSetLayout::VulkanDescriptorSetLayout() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
         , m_vkDescriptorSetLayout(VK_NULL_HANDLE)
+        , m_isPushDescriptor(false)
     {
     }
 
@@ -28,10 +29,12 @@ namespace keplar
     VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(VulkanDescriptorSetLayout&& other) noexcept
         : m_vkDevice(other.m_vkDevice)
         , m_vkDescriptorSetLayout(other.m_vkDescriptorSetLayout)
+        , m_isPushDescriptor(other.m_isPushDescriptor)
     {
         // reset the other
         other.m_vkDevice = VK_NULL_HANDLE;
         other.m_vkDescriptorSetLayout = VK_NULL_HANDLE;
+        other.m_isPushDescriptor = false;
     }
     
     VulkanDescriptorSetLayout& VulkanDescriptorSetLayout::operator=(VulkanDescriptorSetLayout&& other) noexcept
@@ -47,10 +50,12 @@ namespace keplar
             // transfer ownership
             m_vkDevice = other.m_vkDevice;
             m_vkDescriptorSetLayout = other.m_vkDescriptorSetLayout;
+            m_isPushDescriptor = other.m_isPushDescriptor;
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
             other.m_vkDescriptorSetLayout = VK_NULL_HANDLE;    
+            other.m_isPushDescriptor = false;
         }
 
         return *this;
@@ -75,7 +80,119 @@ namespace keplar
 
         // store device handle for destruction
         m_vkDevice = vkDevice;
+        m_isPushDescriptor = (createInfo.flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) != 0;
         VK_LOG_DEBUG("descriptor set layout created successfully");
         return true;
     }
+
+    bool VulkanDescriptorSetLayout::initialize(VkDevice vkDevice, const std::vector<VkDescriptorSetLayoutBinding>& bindings, 
+                                               VkDescriptorSetLayoutCreateFlags flags) noexcept
+    {
+        VkDescriptorSetLayoutCreateInfo createInfo{};
+        createInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        createInfo.pNext        = nullptr;
+        createInfo.flags        = flags;
+        createInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        createInfo.pBindings    = bindings.data();
+        return initialize(vkDevice, createInfo);
+    }
+
+    bool VulkanDescriptorSetLayout::createUpdateTemplate(const std::vector<VkDescriptorUpdateTemplateEntry>& entries, 
+                                                         VulkanDescriptorUpdateTemplate& updateTemplate) const noexcept
+    {
+        return updateTemplate.initialize(m_vkDevice, m_vkDescriptorSetLayout, entries);
+    }
+
+    VulkanDescriptorUpdateTemplate::VulkanDescriptorUpdateTemplate() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkDescriptorUpdateTemplate(VK_NULL_HANDLE)
+    {
+    }
+
+    VulkanDescriptorUpdateTemplate::~VulkanDescriptorUpdateTemplate()
+    {
+        release();
+    }
+
+    VulkanDescriptorUpdateTemplate::VulkanDescriptorUpdateTemplate(VulkanDescriptorUpdateTemplate&& other) noexcept
+        : m_vkDevice(other.m_vkDevice)
+        , m_vkDescriptorUpdateTemplate(other.m_vkDescriptorUpdateTemplate)
+    {
+        // reset the other
+        other.m_vkDevice = VK_NULL_HANDLE;
+        other.m_vkDescriptorUpdateTemplate = VK_NULL_HANDLE;
+    }
+
+    VulkanDescriptorUpdateTemplate& VulkanDescriptorUpdateTemplate::operator=(VulkanDescriptorUpdateTemplate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            // release current resources
+            release();
+
+            // transfer ownership
+            m_vkDevice = other.m_vkDevice;
+            m_vkDescriptorUpdateTemplate = other.m_vkDescriptorUpdateTemplate;
+
+            // reset the other
+            other.m_vkDevice = VK_NULL_HANDLE;
+            other.m_vkDescriptorUpdateTemplate = VK_NULL_HANDLE;
+        }
+
+        return *this;
+    }
+
+    bool VulkanDescriptorUpdateTemplate::initialize(VkDevice vkDevice, VkDescriptorSetLayout vkDescriptorSetLayout, 
+                                                    const std::vector<VkDescriptorUpdateTemplateEntry>& entries) noexcept
+    {
+        // validate handles
+        if (vkDevice == VK_NULL_HANDLE || vkDescriptorSetLayout == VK_NULL_HANDLE || entries.empty())
+        {
+            VK_LOG_ERROR("VulkanDescriptorUpdateTemplate::initialize failed: invalid device, layout or empty entries");
+            return false;
+        }
+
+        // a template may be rebuilt for a new layout
+        release();
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo{};
+        createInfo.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.pNext                      = nullptr;
+        createInfo.flags                      = 0;
+        createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+        createInfo.pDescriptorUpdateEntries   = entries.data();
+        createInfo.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout        = vkDescriptorSetLayout;
+
+        VkResult vkResult = vkCreateDescriptorUpdateTemplate(vkDevice, &createInfo, nullptr, &m_vkDescriptorUpdateTemplate);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkCreateDescriptorUpdateTemplate failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_vkDescriptorUpdateTemplate = VK_NULL_HANDLE;
+            return false;
+        }
+
+        // store device handle for destruction
+        m_vkDevice = vkDevice;
+        VK_LOG_DEBUG("descriptor update template created successfully");
+        return true;
+    }
+
+    void VulkanDescriptorUpdateTemplate::update(VkDescriptorSet vkDescriptorSet, const void* data) const noexcept
+    {
+        if (m_vkDescriptorUpdateTemplate != VK_NULL_HANDLE && vkDescriptorSet != VK_NULL_HANDLE)
+        {
+            vkUpdateDescriptorSetWithTemplate(m_vkDevice, vkDescriptorSet, m_vkDescriptorUpdateTemplate, data);
+        }
+    }
+
+    void VulkanDescriptorUpdateTemplate::release() noexcept
+    {
+        if (m_vkDescriptorUpdateTemplate != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorUpdateTemplate(m_vkDevice, m_vkDescriptorUpdateTemplate, nullptr);
+            m_vkDescriptorUpdateTemplate = VK_NULL_HANDLE;
+            m_vkDevice = VK_NULL_HANDLE;
+        }
+    }
 }   // namespace keplar
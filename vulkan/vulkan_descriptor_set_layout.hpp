@@ -4,10 +4,49 @@
 
 #pragma once
 
+#include <vector>
+
 #include "vulkan_config.hpp"
 
 namespace keplar
 {
+    // update template for sets of one layout: the whole set is written from a packed struct in a single call,
+    // without a VkWriteDescriptorSet per binding. works with layouts owned elsewhere (e.g. the layout cache)
+    class VulkanDescriptorUpdateTemplate
+    {
+        public:
+            // creation and destruction
+            VulkanDescriptorUpdateTemplate() noexcept;
+            ~VulkanDescriptorUpdateTemplate();
+
+            // disable copy semantics to enforce unique ownership
+            VulkanDescriptorUpdateTemplate(const VulkanDescriptorUpdateTemplate&) = delete;
+            VulkanDescriptorUpdateTemplate& operator=(const VulkanDescriptorUpdateTemplate&) = delete;
+
+            // move semantics
+            VulkanDescriptorUpdateTemplate(VulkanDescriptorUpdateTemplate&&) noexcept;
+            VulkanDescriptorUpdateTemplate& operator=(VulkanDescriptorUpdateTemplate&&) noexcept;
+
+            // entries give binding, type and the offset/stride of their descriptor infos inside the packed struct
+            bool initialize(VkDevice vkDevice, VkDescriptorSetLayout vkDescriptorSetLayout, 
+                            const std::vector<VkDescriptorUpdateTemplateEntry>& entries) noexcept;
+
+            // writes every entry of vkDescriptorSet from data laid out as the entries describe
+            void update(VkDescriptorSet vkDescriptorSet, const void* data) const noexcept;
+
+            // accessors
+            VkDescriptorUpdateTemplate get() const noexcept { return m_vkDescriptorUpdateTemplate; }
+            bool isValid() const noexcept { return m_vkDescriptorUpdateTemplate != VK_NULL_HANDLE; }
+
+        private:
+            void release() noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice m_vkDevice;
+            VkDescriptorUpdateTemplate m_vkDescriptorUpdateTemplate;
+    };
+
     class VulkanDescriptorSetLayout
     {
         public:   
@@ -24,13 +63,23 @@ namespace keplar
             VulkanDescriptorSetLayout& operator=(VulkanDescriptorSetLayout&&) noexcept;
 
             bool initialize(VkDevice vkDevice, const VkDescriptorSetLayoutCreateInfo& createInfo) noexcept;
+
+            // push descriptor layouts (VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) hold no sets: their writes are
+            // recorded through VulkanCommandBuffer::pushDescriptorSet and may not use dynamic buffer types
+            bool initialize(VkDevice vkDevice, const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0) noexcept;
+
+            // update template for sets of this layout
+            bool createUpdateTemplate(const std::vector<VkDescriptorUpdateTemplateEntry>& entries, 
+                                      VulkanDescriptorUpdateTemplate& updateTemplate) const noexcept;
             
             // accessor
             VkDescriptorSetLayout get() const noexcept { return m_vkDescriptorSetLayout; }
+            bool isPushDescriptor() const noexcept { return m_isPushDescriptor; }
 
         private:
             // vulkan handles
             VkDevice m_vkDevice;
             VkDescriptorSetLayout m_vkDescriptorSetLayout;
+            bool m_isPushDescriptor;
     };  
 }   // namespace keplar
@@ -0,0 +1,183 @@
+// ────────────────────────────────────────────
+//  File: vulkan_descriptor_set_layout_cache.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_descriptor_set_layout_cache.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    // 64-bit fnv-1a step over one value
+    inline void hashCombine(size_t& hash, uint64_t value) noexcept
+    {
+        hash ^= static_cast<size_t>(value);
+        hash *= static_cast<size_t>(1099511628211ull);
+    }
+}   // namespace
+
+namespace keplar
+{
+    bool VulkanDescriptorSetLayoutCache::LayoutKey::operator==(const LayoutKey& other) const noexcept
+    {
+        if (mFlags != other.mFlags || mBindings.size() != other.mBindings.size() || mBindingFlags != other.mBindingFlags)
+        {
+            return false;
+        }
+
+        return std::equal(mBindings.begin(), mBindings.end(), other.mBindings.begin(), [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b)
+        {
+            return a.binding == b.binding && a.descriptorType == b.descriptorType && a.descriptorCount == b.descriptorCount && a.stageFlags == b.stageFlags;
+        });
+    }
+
+    size_t VulkanDescriptorSetLayoutCache::LayoutKeyHash::operator()(const LayoutKey& key) const noexcept
+    {
+        size_t hash = static_cast<size_t>(14695981039346656037ull);
+        hashCombine(hash, key.mFlags);
+        for (size_t i = 0; i < key.mBindings.size(); ++i)
+        {
+            const VkDescriptorSetLayoutBinding& binding = key.mBindings[i];
+            hashCombine(hash, (static_cast<uint64_t>(binding.binding) << 32) | static_cast<uint64_t>(binding.descriptorType));
+            hashCombine(hash, (static_cast<uint64_t>(binding.descriptorCount) << 32) | static_cast<uint64_t>(binding.stageFlags));
+            hashCombine(hash, key.mBindingFlags[i]);
+        }
+        return hash;
+    }
+
+    VulkanDescriptorSetLayoutCache::VulkanDescriptorSetLayoutCache() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+    {
+    }
+
+    VulkanDescriptorSetLayoutCache::~VulkanDescriptorSetLayoutCache()
+    {
+        destroy();
+    }
+
+    bool VulkanDescriptorSetLayoutCache::initialize(VkDevice vkDevice) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanDescriptorSetLayoutCache::initialize failed: VkDevice is VK_NULL_HANDLE");
+            return false;
+        }
+
+        destroy();
+        m_vkDevice = vkDevice;
+        VK_LOG_DEBUG("VulkanDescriptorSetLayoutCache::initialize successful");
+        return true;
+    }
+
+    void VulkanDescriptorSetLayoutCache::destroy() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [key, vkDescriptorSetLayout] : m_layouts)
+        {
+            vkDestroyDescriptorSetLayout(m_vkDevice, vkDescriptorSetLayout, nullptr);
+        }
+
+        if (!m_layouts.empty())
+        {
+            VK_LOG_DEBUG("VulkanDescriptorSetLayoutCache :: destroyed %zu descriptor set layouts", m_layouts.size());
+        }
+        m_layouts.clear();
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    VkDescriptorSetLayout VulkanDescriptorSetLayoutCache::getOrCreate(const VkDescriptorSetLayoutCreateInfo& createInfo) noexcept
+    {
+        // binding flags are the only extension the key understands
+        const auto* bindingFlagsInfo = static_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo*>(createInfo.pNext);
+        if (bindingFlagsInfo != nullptr && (bindingFlagsInfo->sType != VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO || bindingFlagsInfo->pNext != nullptr))
+        {
+            VK_LOG_ERROR("VulkanDescriptorSetLayoutCache::getOrCreate failed: unsupported pNext chain");
+            return VK_NULL_HANDLE;
+        }
+        if (bindingFlagsInfo != nullptr && bindingFlagsInfo->bindingCount != 0 && bindingFlagsInfo->bindingCount != createInfo.bindingCount)
+        {
+            VK_LOG_ERROR("VulkanDescriptorSetLayoutCache::getOrCreate failed: binding flag count does not match the binding count");
+            return VK_NULL_HANDLE;
+        }
+
+        // key: bindings in binding order, so the same set declared in another order maps to the same layout
+        std::vector<uint32_t> order(createInfo.bindingCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return createInfo.pBindings[a].binding < createInfo.pBindings[b].binding; });
+
+        LayoutKey key;
+        key.mFlags = createInfo.flags;
+        key.mBindings.reserve(createInfo.bindingCount);
+        key.mBindingFlags.reserve(createInfo.bindingCount);
+        for (uint32_t index : order)
+        {
+            const VkDescriptorSetLayoutBinding& binding = createInfo.pBindings[index];
+            if (binding.pImmutableSamplers != nullptr)
+            {
+                VK_LOG_ERROR("VulkanDescriptorSetLayoutCache::getOrCreate failed: immutable samplers are not supported");
+                return VK_NULL_HANDLE;
+            }
+            key.mBindings.push_back(binding);
+            key.mBindingFlags.push_back((bindingFlagsInfo && bindingFlagsInfo->bindingCount) ? bindingFlagsInfo->pBindingFlags[index] : 0);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanDescriptorSetLayoutCache::getOrCreate failed: cache not initialized");
+            return VK_NULL_HANDLE;
+        }
+
+        auto it = m_layouts.find(key);
+        if (it != m_layouts.end())
+        {
+            return it->second;
+        }
+
+        // create from the normalized key, so the layout's binding flags stay paired with their bindings
+        VkDescriptorSetLayoutBindingFlagsCreateInfo sortedFlagsInfo{};
+        sortedFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        sortedFlagsInfo.pNext = nullptr;
+        sortedFlagsInfo.bindingCount = static_cast<uint32_t>(key.mBindingFlags.size());
+        sortedFlagsInfo.pBindingFlags = key.mBindingFlags.data();
+
+        VkDescriptorSetLayoutCreateInfo sortedCreateInfo{};
+        sortedCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        sortedCreateInfo.pNext = bindingFlagsInfo ? &sortedFlagsInfo : nullptr;
+        sortedCreateInfo.flags = key.mFlags;
+        sortedCreateInfo.bindingCount = static_cast<uint32_t>(key.mBindings.size());
+        sortedCreateInfo.pBindings = key.mBindings.data();
+
+        VkDescriptorSetLayout vkDescriptorSetLayout = VK_NULL_HANDLE;
+        VkResult vkResult = vkCreateDescriptorSetLayout(m_vkDevice, &sortedCreateInfo, nullptr, &vkDescriptorSetLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("VulkanDescriptorSetLayoutCache :: vkCreateDescriptorSetLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return VK_NULL_HANDLE;
+        }
+
+        m_layouts.emplace(std::move(key), vkDescriptorSetLayout);
+        return vkDescriptorSetLayout;
+    }
+
+    VkDescriptorSetLayout VulkanDescriptorSetLayoutCache::getOrCreate(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags) noexcept
+    {
+        VkDescriptorSetLayoutCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = flags;
+        createInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        createInfo.pBindings = bindings.data();
+        return getOrCreate(createInfo);
+    }
+
+    size_t VulkanDescriptorSetLayoutCache::getLayoutCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_layouts.size();
+    }
+}   // namespace keplar
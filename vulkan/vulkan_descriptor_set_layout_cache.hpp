@@ -0,0 +1,65 @@
+// ────────────────────────────────────────────
+//  File: vulkan_descriptor_set_layout_cache.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // device-wide cache of descriptor set layouts keyed by their bindings. identical create infos return the same
+    // handle, so pipelines built from the same (reflected) sets share their layouts and stay compatible for a set
+    // bound once across pipeline changes. layouts live until the cache is destroyed with the device; callers never
+    // destroy them. internally synchronized
+    class VulkanDescriptorSetLayoutCache final
+    {
+        public:
+            // creation and destruction
+            VulkanDescriptorSetLayoutCache() noexcept;
+            ~VulkanDescriptorSetLayoutCache();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanDescriptorSetLayoutCache(const VulkanDescriptorSetLayoutCache&) = delete;
+            VulkanDescriptorSetLayoutCache& operator=(const VulkanDescriptorSetLayoutCache&) = delete;
+            VulkanDescriptorSetLayoutCache(VulkanDescriptorSetLayoutCache&&) = delete;
+            VulkanDescriptorSetLayoutCache& operator=(VulkanDescriptorSetLayoutCache&&) = delete;
+
+            bool initialize(VkDevice vkDevice) noexcept;
+            void destroy() noexcept;
+
+            // usage: pNext may only chain VkDescriptorSetLayoutBindingFlagsCreateInfo, which is part of the key.
+            // immutable samplers are not supported. returns VK_NULL_HANDLE on failure
+            VkDescriptorSetLayout getOrCreate(const VkDescriptorSetLayoutCreateInfo& createInfo) noexcept;
+            VkDescriptorSetLayout getOrCreate(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0) noexcept;
+
+            // accessors
+            size_t getLayoutCount() const noexcept;
+
+        private:
+            // bindings sorted by binding number, with their binding flags (0 without the flags struct)
+            struct LayoutKey
+            {
+                VkDescriptorSetLayoutCreateFlags                mFlags = 0;
+                std::vector<VkDescriptorSetLayoutBinding>       mBindings;
+                std::vector<VkDescriptorBindingFlags>           mBindingFlags;
+
+                bool operator==(const LayoutKey& other) const noexcept;
+            };
+
+            struct LayoutKeyHash
+            {
+                size_t operator()(const LayoutKey& key) const noexcept;
+            };
+
+        private:
+            // vulkan handles
+            VkDevice                                                                m_vkDevice;
+            std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash>     m_layouts;
+            mutable std::mutex                                                      m_mutex;
+    };
+}   // namespace keplar
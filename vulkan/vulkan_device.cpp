@@ -4,9 +4,76 @@
 
 #include "vulkan_device.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <unordered_set>
 #include "vulkan_utils.hpp"
+#include "vulkan_allocation_callbacks.hpp"
+#include "vulkan_command_buffer.hpp"
+#include "vulkan_barrier_batch.hpp"
+#include "vulkan_dispatch.hpp"
+#include "vulkan_pipeline.hpp"
+#include "vulkan_descriptor_buffer.hpp"
+#include "vulkan_indirect_commands.hpp"
+#include "vulkan_command_recorder.hpp"
+#include "vulkan_acceleration_structure.hpp"
+#include "core/keplar_config.hpp"
 #include "utils/logger.hpp"
+#include "utils/startup_timer.hpp"
+
+namespace
+{
+    // explicit device choice: an enumeration index, or else a name substring
+    struct DeviceOverride
+    {
+        std::optional<uint32_t> mIndex;
+        std::string mName;
+    };
+
+    std::string readEnvironment(const char* name) noexcept
+    {
+    #if defined(_WIN32)
+        char* value = nullptr;
+        size_t length = 0;
+        if (_dupenv_s(&value, &length, name) != 0 || value == nullptr)
+        {
+            return {};
+        }
+        std::string result(value);
+        std::free(value);
+        return result;
+    #else
+        const char* value = std::getenv(name);
+        return value ? std::string(value) : std::string();
+    #endif
+    }
+
+    // the environment variable (all digits: an index) takes precedence over the config
+    DeviceOverride resolveDeviceOverride(const char* environmentName, std::optional<uint32_t> configIndex, std::string_view configName) noexcept
+    {
+        DeviceOverride deviceOverride{ configIndex, std::string(configName) };
+        const std::string value = readEnvironment(environmentName);
+        if (value.empty())
+        {
+            return deviceOverride;
+        }
+
+        const bool isIndex = value.size() < 10 && std::all_of(value.begin(), value.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+        deviceOverride.mIndex = isIndex ? std::optional<uint32_t>(static_cast<uint32_t>(std::stoul(value))) : std::nullopt;
+        deviceOverride.mName  = isIndex ? std::string() : value;
+        return deviceOverride;
+    }
+
+    bool containsIgnoreCase(std::string_view text, std::string_view pattern) noexcept
+    {
+        return std::search(text.begin(), text.end(), pattern.begin(), pattern.end(), [](char a, char b)
+        {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        }) != text.end();
+    }
+}   // namespace
 
 namespace keplar
 {
@@ -14,10 +81,13 @@ namespace keplar
     struct VulkanDevice::PhysicalDeviceInfo
     {
         VkPhysicalDevice mVkPhysicalDevice;
+        uint32_t mIndex;
         QueueFamilyIndices mQueueFamilyIndices;
         VkPhysicalDeviceProperties mVkPhysicalDeviceProperties;
         VkPhysicalDeviceMemoryProperties mVkPhysicalDeviceMemoryProperties;
         VkPhysicalDeviceFeatures mVkPhysicalDeviceFeatures;
+        uint64_t mPerformanceScore;
+        uint64_t mCapabilityScore;
         uint64_t mScore;
     };
 
@@ -26,7 +96,19 @@ namespace keplar
                                                        const VulkanContextConfig& config) noexcept
     {
         std::shared_ptr<VulkanDevice> device(new VulkanDevice);
-        if (!device->initialize(instance, surface, config))
+        if (!device->initialize(instance, &surface, config, nullptr))
+        {
+            return nullptr;
+        }
+        return device;
+    }
+
+    std::shared_ptr<VulkanDevice> VulkanDevice::createSecondary(const VulkanInstance& instance, 
+                                                                const VulkanContextConfig& config, 
+                                                                const VulkanDevice& primary) noexcept
+    {
+        std::shared_ptr<VulkanDevice> device(new VulkanDevice);
+        if (!device->initialize(instance, nullptr, config, &primary))
         {
             return nullptr;
         }
@@ -40,18 +122,63 @@ namespace keplar
         , m_graphicsQueue(VK_NULL_HANDLE)
         , m_computeQueue(VK_NULL_HANDLE)
         , m_transferQueue(VK_NULL_HANDLE)
+        , m_physicalDeviceIndex(0)
         , m_vkPhysicalDeviceProperties{}
         , m_vkPhysicalDeviceFeatures{}
         , m_vkPhysicalDeviceMemoryProperties{}
+        , m_fragmentShadingRateProperties{}
+        , m_descriptorBufferProperties{}
+        , m_deviceGeneratedCommandsProperties{}
+        , m_multiDrawProperties{}
+        , m_accelerationStructureProperties{}
+        , m_isShadingRateAttachmentEnabled(false)
+        , m_isLatencySleepEnabled(false)
+        , m_vkTransitionImageLayout(nullptr)
+        , m_vkCopyMemoryToImage(nullptr)
     {
     }
 
     VulkanDevice::~VulkanDevice()
     {
+        // stop the shader watcher; modules go with the last shader holding them
+        if (m_shaderCache)
+        {
+            m_shaderCache->destroy();
+            m_shaderCache.reset();
+        }
+
+        // shared descriptor set layouts outlive every pipeline layout built from them
+        if (m_descriptorSetLayoutCache)
+        {
+            m_descriptorSetLayoutCache->destroy();
+            m_descriptorSetLayoutCache.reset();
+        }
+
+        // shared samplers outlive every descriptor referencing them
+        if (m_samplerCache)
+        {
+            m_samplerCache->destroy();
+            m_samplerCache.reset();
+        }
+
+        // persist compiled pipelines before the logical device goes away
+        if (m_pipelineCache)
+        {
+            m_pipelineCache->destroy();
+            m_pipelineCache.reset();
+        }
+
+        // release device memory blocks before the logical device
+        if (m_memoryAllocator)
+        {
+            m_memoryAllocator->destroy();
+            m_memoryAllocator.reset();
+        }
+
         if (m_vkDevice != VK_NULL_HANDLE)
         {
             // queues are destroyed when logical device is destroyed
-            vkDestroyDevice(m_vkDevice, nullptr);
+            vkDestroyDevice(m_vkDevice, getVulkanAllocationCallbacks());
             m_vkDevice = VK_NULL_HANDLE;
             m_graphicsQueue = VK_NULL_HANDLE;
             m_computeQueue = VK_NULL_HANDLE;
@@ -61,7 +188,8 @@ namespace keplar
         }
     }
 
-    bool VulkanDevice::initialize(const VulkanInstance& instance, const VulkanSurface& surface, const VulkanContextConfig& config) noexcept
+    bool VulkanDevice::initialize(const VulkanInstance& instance, const VulkanSurface* surface, const VulkanContextConfig& config, 
+                                  const VulkanDevice* primary) noexcept
     {
         // store the VkInstance for resource creation and destruction
         m_vkInstance = instance.get();
@@ -69,18 +197,78 @@ namespace keplar
         // copy device config params from builder config        
         m_deviceConfig.setDeviceExtensions(config.mDeviceExtensions);
         m_deviceConfig.mRequestedFeatures = config.mRequestedFeatures;
+        if (config.mRequestedFeatureChain)
+        {
+            m_deviceConfig.mRequestedFeatureChain = *config.mRequestedFeatureChain;
+        }
         m_deviceConfig.mPreferDedicatedComputeQueue = config.mPreferDedicatedComputeQueue;
         m_deviceConfig.mPreferDedicatedTransferQueue = config.mPreferDedicatedTransferQueue;
+        m_deviceConfig.mRequestDrawIndirectCount = config.mRequestDrawIndirectCount;
+        m_deviceConfig.mRequestDescriptorIndexing = config.mRequestDescriptorIndexing;
+        m_deviceConfig.mRequestTimelineSemaphore = config.mRequestTimelineSemaphore;
+        m_deviceConfig.mRequestBufferDeviceAddress = config.mRequestBufferDeviceAddress;
+        m_deviceConfig.mRequestShaderFloat16 = config.mRequestShaderFloat16;
+        m_deviceConfig.mRequestMultiview = config.mRequestMultiview;
+        m_deviceConfig.mRequestDynamicRendering = config.mRequestDynamicRendering;
+        m_deviceConfig.mRequestSynchronization2 = config.mRequestSynchronization2;
+        m_deviceConfig.mRequestExtendedDynamicState = config.mRequestExtendedDynamicState;
+        m_deviceConfig.mRequestPresentWait = config.mRequestPresentWait;
+        m_deviceConfig.mRequestMemoryBudget = config.mRequestMemoryBudget;
+        m_deviceConfig.mRequestPushDescriptor = config.mRequestPushDescriptor;
+        m_deviceConfig.mRequestMeshShader = config.mRequestMeshShader;
+        m_deviceConfig.mRequestFragmentShadingRate = config.mRequestFragmentShadingRate;
+        m_deviceConfig.mRequestGraphicsPipelineLibrary = config.mRequestGraphicsPipelineLibrary;
+        m_deviceConfig.mRequestShaderObject = config.mRequestShaderObject;
+        m_deviceConfig.mRequestHostImageCopy = config.mRequestHostImageCopy;
+        m_deviceConfig.mRequestDescriptorBuffer = config.mRequestDescriptorBuffer;
+        m_deviceConfig.mRequestDeviceGeneratedCommands = config.mRequestDeviceGeneratedCommands;
+        m_deviceConfig.mRequestMultiDraw = config.mRequestMultiDraw;
+        m_deviceConfig.mRequestRayQuery = config.mRequestRayQuery;
+        m_deviceConfig.mRequestLowLatency = config.mRequestLowLatency;
+
+        // exclusive fullscreen is a win32 extension, its support queries go through surface capabilities2
+    #if defined(VK_USE_PLATFORM_WIN32_KHR)
+        m_deviceConfig.mRequestFullScreenExclusive = config.mRequestFullScreenExclusive &&
+                                                     instance.isExtensionEnabled(VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME);
+    #else
+        m_deviceConfig.mRequestFullScreenExclusive = false;
+    #endif
+
+        // compatible present modes can only be queried through the surface_maintenance1 instance extension
+        m_deviceConfig.mRequestSwapchainMaintenance1 = config.mRequestSwapchainMaintenance1 && 
+                                                       instance.isExtensionEnabled(VK_EXT_SURFACE_MAINTENANCE_1_EXTENSION_NAME);
+
+        // a secondary device never presents: drop the swapchain extension and everything built on it
+        if (primary)
+        {
+            auto& extensions = m_deviceConfig.mDeviceExtensions;
+            extensions.erase(std::remove_if(extensions.begin(), extensions.end(), [](const char* extension)
+            {
+                return std::strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0;
+            }), extensions.end());
+            m_deviceConfig.mRequestPresentWait = false;
+            m_deviceConfig.mRequestSwapchainMaintenance1 = false;
+            m_deviceConfig.mRequestLowLatency = false;
+            m_deviceConfig.mRequestFullScreenExclusive = false;
+
+            // barriers on both devices go through the command the primary enabled
+            m_deviceConfig.mRequestSynchronization2 = primary->isSynchronization2Enabled();
+        }
 
-        // select appropriate physical device
-        if (!selectPhysicalDevice(surface))
+        // select appropriate physical device, honoring an explicit choice (the secondary's only through its environment variable)
+        const DeviceOverride deviceOverride = primary ? resolveDeviceOverride("KEPLAR_SECONDARY_DEVICE", std::nullopt, {}) : 
+                                                        resolveDeviceOverride("KEPLAR_DEVICE", config.mPhysicalDeviceIndex, config.mPhysicalDeviceName);
+        if (!KEPLAR_STARTUP_STEP(selectPhysicalDevice(surface, primary ? primary->getPhysicalDevice() : VK_NULL_HANDLE, deviceOverride.mIndex, deviceOverride.mName)))
         {
-            VK_LOG_FATAL("failed to select a suitable vulkan physical device");
+            if (!primary)
+            {
+                VK_LOG_FATAL("failed to select a suitable vulkan physical device");
+            }
             return false;
         }
 
         // create logical device 
-        if (!createLogicalDevice())
+        if (!KEPLAR_STARTUP_STEP(createLogicalDevice()))
         {
             VK_LOG_FATAL("failed to create logical device from selected vulkan physical device");
             return false;
@@ -93,6 +281,135 @@ namespace keplar
             return false;
         }
 
+        // every batch and transition helper records barriers the same way: the primary device picks it, a secondary follows
+        if (!primary)
+        {
+            VulkanBarrierBatch::setSynchronization2Enabled(m_deviceConfig.mRequestSynchronization2);
+        }
+        else if (primary->isSynchronization2Enabled() && !m_deviceConfig.mRequestSynchronization2)
+        {
+            VK_LOG_ERROR("secondary device does not support synchronization2, which the primary device records barriers with");
+            return false;
+        }
+
+        // recording calls skip the loader trampoline through the primary device's commands; a secondary device records
+        // through the same table, so it goes back to the loader exports that dispatch per device
+        if (!primary)
+        {
+            VulkanDispatch::load(m_vkDevice);
+        }
+        else
+        {
+            VulkanDispatch::reset();
+        }
+
+        // the push command is shared by every command buffer, so only the primary device loads it
+        if (m_deviceConfig.mRequestPushDescriptor && (primary || !VulkanCommandBuffer::loadPushDescriptor(m_vkDevice)))
+        {
+            m_deviceConfig.mRequestPushDescriptor = false;
+        }
+
+        // descriptor buffer commands are shared the same way
+        if (m_deviceConfig.mRequestDescriptorBuffer && (primary || !VulkanDescriptorBuffer::loadDescriptorBuffer(m_vkDevice)))
+        {
+            m_deviceConfig.mRequestDescriptorBuffer = false;
+        }
+
+        // and so are the generated commands ones
+        if (m_deviceConfig.mRequestDeviceGeneratedCommands && (primary || !VulkanIndirectCommands::loadDeviceGeneratedCommands(m_vkDevice)))
+        {
+            m_deviceConfig.mRequestDeviceGeneratedCommands = false;
+        }
+
+        // as is the multi-draw command recorders issue
+        if (m_deviceConfig.mRequestMultiDraw && (primary || !VulkanCommandRecorder::loadMultiDraw(m_vkDevice)))
+        {
+            m_deviceConfig.mRequestMultiDraw = false;
+        }
+
+        // and the acceleration structure commands
+        if (m_deviceConfig.mRequestRayQuery && (primary || !VulkanAccelerationStructure::loadAccelerationStructure(m_vkDevice)))
+        {
+            m_deviceConfig.mRequestRayQuery = false;
+        }
+
+        // shader objects share their commands the same way, and bind every stage and state the device enabled
+        if (m_deviceConfig.mRequestShaderObject)
+        {
+            ShaderObjectFeatures shaderObjectFeatures{};
+            shaderObjectFeatures.mStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+            shaderObjectFeatures.mStages |= m_deviceConfig.mRequestedFeatures.tessellationShader ? 
+                                            (VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) : 0;
+            shaderObjectFeatures.mStages |= m_deviceConfig.mRequestedFeatures.geometryShader ? VK_SHADER_STAGE_GEOMETRY_BIT : 0;
+            shaderObjectFeatures.mStages |= m_deviceConfig.mRequestMeshShader ? (VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT) : 0;
+            shaderObjectFeatures.mDepthClamp = m_deviceConfig.mRequestedFeatures.depthClamp == VK_TRUE;
+            shaderObjectFeatures.mAlphaToOne = m_deviceConfig.mRequestedFeatures.alphaToOne == VK_TRUE;
+            shaderObjectFeatures.mLogicOp = m_deviceConfig.mRequestedFeatures.logicOp == VK_TRUE;
+            shaderObjectFeatures.mFragmentShadingRate = m_deviceConfig.mRequestFragmentShadingRate;
+            shaderObjectFeatures.mShadingRateAttachment = isShadingRateAttachmentEnabled();
+            if (primary || !VulkanPipeline::loadShaderObject(m_vkDevice, shaderObjectFeatures))
+            {
+                m_deviceConfig.mRequestShaderObject = false;
+            }
+        }
+
+        // host image copies are device commands without a command buffer, loaded per device
+        if (m_deviceConfig.mRequestHostImageCopy)
+        {
+            m_vkTransitionImageLayout = (PFN_vkTransitionImageLayout)vkGetDeviceProcAddr(m_vkDevice, "vkTransitionImageLayout");
+            m_vkCopyMemoryToImage = (PFN_vkCopyMemoryToImage)vkGetDeviceProcAddr(m_vkDevice, "vkCopyMemoryToImage");
+            if (m_vkTransitionImageLayout == nullptr || m_vkCopyMemoryToImage == nullptr)
+            {
+                VK_LOG_ERROR("vkGetDeviceProcAddr failed to get host image copy function pointers");
+                m_deviceConfig.mRequestHostImageCopy = false;
+            }
+        }
+
+        // create device memory allocator
+        m_memoryAllocator = std::make_unique<VulkanMemoryAllocator>();
+        if (!m_memoryAllocator->initialize(m_vkDevice, m_vkPhysicalDeviceMemoryProperties, m_vkPhysicalDeviceProperties.limits.nonCoherentAtomSize, 
+                                          m_deviceConfig.mRequestBufferDeviceAddress))
+        {
+            VK_LOG_FATAL("failed to initialize device memory allocator");
+            return false;
+        }
+
+        // create device pipeline cache, seeded from the previous run when compatible
+        m_pipelineCache = std::make_unique<VulkanPipelineCache>();
+        // (a secondary device keeps its own file: both are written back on destruction)
+        const char* pipelineCacheFile = primary ? "pipeline_cache_secondary.bin" : "pipeline_cache.bin";
+        if (!m_pipelineCache->initialize(m_vkDevice, m_vkPhysicalDevice, keplar::config::kCacheDir / pipelineCacheFile))
+        {
+            VK_LOG_FATAL("failed to initialize device pipeline cache");
+            return false;
+        }
+
+        // create device descriptor set layout cache
+        m_descriptorSetLayoutCache = std::make_unique<VulkanDescriptorSetLayoutCache>();
+        if (!m_descriptorSetLayoutCache->initialize(m_vkDevice))
+        {
+            VK_LOG_FATAL("failed to initialize device descriptor set layout cache");
+            return false;
+        }
+
+        // create device sampler cache; anisotropy is capped by the enabled feature and the device limit
+        const float maxAnisotropy = m_deviceConfig.mRequestedFeatures.samplerAnisotropy ? m_vkPhysicalDeviceProperties.limits.maxSamplerAnisotropy : 0.0f;
+        m_samplerCache = std::make_unique<VulkanSamplerCache>();
+        if (!m_samplerCache->initialize(m_vkDevice, maxAnisotropy))
+        {
+            VK_LOG_FATAL("failed to initialize device sampler cache");
+            return false;
+        }
+
+        // create device shader module cache
+        m_shaderCache = std::make_unique<VulkanShaderCache>();
+        if (!m_shaderCache->initialize(m_vkDevice, keplar::config::kShaderDir))
+        {
+            VK_LOG_FATAL("failed to initialize device shader cache");
+            return false;
+        }
+        m_shaderCache->setCodeRetained(m_deviceConfig.mRequestShaderObject);
+
         return true;
     }
 
@@ -131,6 +448,21 @@ namespace keplar
         return m_transferQueue;
     }
 
+    bool VulkanDevice::isHeadless() const noexcept
+    {
+        return !m_queueFamilyIndices.mPresentFamily.has_value();
+    }
+
+    const std::vector<PhysicalDeviceCandidate>& VulkanDevice::getPhysicalDeviceCandidates() const noexcept
+    {
+        return m_physicalDeviceCandidates;
+    }
+
+    uint32_t VulkanDevice::getPhysicalDeviceIndex() const noexcept
+    {
+        return m_physicalDeviceIndex;
+    }
+
     const VkPhysicalDeviceProperties& VulkanDevice::getPhysicalDeviceProperties() const noexcept
     {
         return m_vkPhysicalDeviceProperties;
@@ -146,6 +478,11 @@ namespace keplar
         return m_deviceConfig.mRequestedFeatures;
     }
 
+    const VulkanFeatureChain& VulkanDevice::getEnabledFeatureChain() const noexcept
+    {
+        return m_deviceConfig.mRequestedFeatureChain;
+    }
+
     const VkPhysicalDeviceMemoryProperties& VulkanDevice::getPhysicalDeviceMemoryProperties() const noexcept
     {
         return m_vkPhysicalDeviceMemoryProperties;
@@ -156,498 +493,1820 @@ namespace keplar
         return std::find(m_deviceConfig.mDeviceExtensions.begin(), m_deviceConfig.mDeviceExtensions.end(), extensionName) != m_deviceConfig.mDeviceExtensions.end();
     }
 
-    std::optional<uint32_t> VulkanDevice::findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags propertyFlags) const noexcept
+    bool VulkanDevice::isDrawIndirectCountEnabled() const noexcept
     {
-        for (uint32_t i = 0; i < m_vkPhysicalDeviceMemoryProperties.memoryTypeCount; i++)
-        {
-            bool isCompatibleType = (memoryTypeBits & (1 << i)) != 0;
-            bool hasRequiredProperties = (m_vkPhysicalDeviceMemoryProperties.memoryTypes[i].propertyFlags & propertyFlags) == propertyFlags;
-            if (isCompatibleType && hasRequiredProperties)
-            {   
-                return i;
-            }
-        }
+        return m_deviceConfig.mRequestDrawIndirectCount;
+    }
 
-        VK_LOG_DEBUG("No suitable memory type found for properties: %s", string_VkMemoryPropertyFlags(propertyFlags).c_str());
-        return std::nullopt;
+    bool VulkanDevice::isDescriptorIndexingEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestDescriptorIndexing;
     }
 
-    bool VulkanDevice::selectPhysicalDevice(const VulkanSurface& surface) noexcept
+    bool VulkanDevice::isTimelineSemaphoreEnabled() const noexcept
     {
-        // query the number of vulkan compatible physical devices.
-        uint32_t deviceCount = 0;
-        VkResult vkResult = vkEnumeratePhysicalDevices(m_vkInstance, &deviceCount, nullptr);
-        if (vkResult != VK_SUCCESS)
+        return m_deviceConfig.mRequestTimelineSemaphore;
+    }
+
+    bool VulkanDevice::isBufferDeviceAddressEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestBufferDeviceAddress;
+    }
+
+    bool VulkanDevice::isShaderFloat16Enabled() const noexcept
+    {
+        return m_deviceConfig.mRequestShaderFloat16;
+    }
+
+    bool VulkanDevice::isMultiviewEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestMultiview;
+    }
+
+    bool VulkanDevice::isDynamicRenderingEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestDynamicRendering;
+    }
+
+    bool VulkanDevice::isSynchronization2Enabled() const noexcept
+    {
+        return m_deviceConfig.mRequestSynchronization2;
+    }
+
+    bool VulkanDevice::isExtendedDynamicStateEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestExtendedDynamicState;
+    }
+
+    bool VulkanDevice::isPresentWaitEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestPresentWait;
+    }
+
+    bool VulkanDevice::isSwapchainMaintenance1Enabled() const noexcept
+    {
+        return m_deviceConfig.mRequestSwapchainMaintenance1;
+    }
+
+    bool VulkanDevice::isMemoryBudgetEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestMemoryBudget;
+    }
+
+    bool VulkanDevice::isPushDescriptorEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestPushDescriptor;
+    }
+
+    bool VulkanDevice::isMeshShaderEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestMeshShader;
+    }
+
+    bool VulkanDevice::isFragmentShadingRateEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestFragmentShadingRate;
+    }
+
+    bool VulkanDevice::isShadingRateAttachmentEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestFragmentShadingRate && m_isShadingRateAttachmentEnabled;
+    }
+
+    bool VulkanDevice::isGraphicsPipelineLibraryEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestGraphicsPipelineLibrary;
+    }
+
+    bool VulkanDevice::isShaderObjectEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestShaderObject;
+    }
+
+    bool VulkanDevice::isHostImageCopyEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestHostImageCopy;
+    }
+
+    bool VulkanDevice::isDescriptorBufferEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestDescriptorBuffer;
+    }
+
+    bool VulkanDevice::isDeviceGeneratedCommandsEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestDeviceGeneratedCommands;
+    }
+
+    bool VulkanDevice::isMultiDrawEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestMultiDraw;
+    }
+
+    bool VulkanDevice::isRayQueryEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestRayQuery;
+    }
+
+    bool VulkanDevice::isHostImageCopySupported(VkFormat format, VkImageUsageFlags usage) const noexcept
+    {
+        if (!m_deviceConfig.mRequestHostImageCopy)
         {
-            VK_LOG_FATAL("failed to query physical device count : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
-        
-        // abort if no vulkan compatible physical devices were found.
-        if (deviceCount == 0)
+
+        // optimal tiling: the format must take host transfers at all
+        VkFormatProperties3 formatProperties3{};
+        formatProperties3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3;
+        formatProperties3.pNext = nullptr;
+
+        VkFormatProperties2 formatProperties2{};
+        formatProperties2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+        formatProperties2.pNext = &formatProperties3;
+        vkGetPhysicalDeviceFormatProperties2(m_vkPhysicalDevice, format, &formatProperties2);
+        if ((formatProperties3.optimalTilingFeatures & VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT) == 0)
         {
-            VK_LOG_FATAL("no vulkan-compatible physical devices found.");
             return false;
         }
 
-        // retrieve the supported vulkan compatible physical devices.
-        std::vector<VkPhysicalDevice> physicalDevices(deviceCount);
-        vkResult = vkEnumeratePhysicalDevices(m_vkInstance, &deviceCount, physicalDevices.data());
-        if (vkResult != VK_SUCCESS)
+        // host transfer usage may cost the image its device-side layout (e.g. compression); staging is faster overall then
+        VkHostImageCopyDevicePerformanceQuery performanceQuery{};
+        performanceQuery.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY;
+        performanceQuery.pNext = nullptr;
+
+        VkImageFormatProperties2 imageFormatProperties{};
+        imageFormatProperties.sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2;
+        imageFormatProperties.pNext = &performanceQuery;
+
+        VkPhysicalDeviceImageFormatInfo2 imageFormatInfo{};
+        imageFormatInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2;
+        imageFormatInfo.pNext = nullptr;
+        imageFormatInfo.format = format;
+        imageFormatInfo.type = VK_IMAGE_TYPE_2D;
+        imageFormatInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageFormatInfo.usage = usage | VK_IMAGE_USAGE_HOST_TRANSFER_BIT;
+        imageFormatInfo.flags = 0;
+        if (vkGetPhysicalDeviceImageFormatProperties2(m_vkPhysicalDevice, &imageFormatInfo, &imageFormatProperties) != VK_SUCCESS)
         {
-            VK_LOG_FATAL("failed to query physical devices : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
+        return performanceQuery.optimalDeviceAccess == VK_TRUE;
+    }
 
-        // select best vulkan physical device from available devices
-        std::optional<PhysicalDeviceInfo> selectedDeviceInfo;
-        for (const auto& device : physicalDevices)
+    bool VulkanDevice::isSparseResidencySupported(VkFormat format, VkImageUsageFlags usage) const noexcept
+    {
+        const VkPhysicalDeviceFeatures& enabledFeatures = getEnabledFeatures();
+        if (!enabledFeatures.sparseBinding || !enabledFeatures.sparseResidencyImage2D || !m_queueFamilyIndices.mGraphicsFamily)
         {
-            // get device properties early to log device name if skipped.
-            PhysicalDeviceInfo physicalDeviceInfo{};
-            vkGetPhysicalDeviceProperties(device, &physicalDeviceInfo.mVkPhysicalDeviceProperties);
-
-            // skip devices that don't support required extensions
-            if (!checkDeviceExtensionSupport(device))
-            {
-                VK_LOG_WARN("skipping device %s due to missing required extension support", physicalDeviceInfo.mVkPhysicalDeviceProperties.deviceName);
-                continue;
-            }
-
-            // device must support a graphics and present queue for rendering
-            QueueFamilyIndices indices = findRequiredQueueFamilies(device, surface);
-            if (!indices.isComplete())
-            {
-                VK_LOG_WARN("skipping device %s due to missing graphics or present queue support", physicalDeviceInfo.mVkPhysicalDeviceProperties.deviceName);
-                continue;
-            }
-
-            // retrieve additional physical device info for scoring.
-            physicalDeviceInfo.mVkPhysicalDevice = device;
-            physicalDeviceInfo.mQueueFamilyIndices = std::move(indices);
-            vkGetPhysicalDeviceMemoryProperties(device, &physicalDeviceInfo.mVkPhysicalDeviceMemoryProperties);
-            vkGetPhysicalDeviceFeatures(device, &physicalDeviceInfo.mVkPhysicalDeviceFeatures);
-            physicalDeviceInfo.mScore = scoreDevice(physicalDeviceInfo);
-
-            // select the best physical device based on score
-            if (!selectedDeviceInfo || physicalDeviceInfo.mScore > selectedDeviceInfo->mScore)
-            {
-                selectedDeviceInfo = physicalDeviceInfo;
-            }
+            return false;
         }
 
-        // abort if no suitable physical device was found.
-        if (!selectedDeviceInfo)
+        // binds are queued on the graphics queue, in order with the frames sampling the images
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_vkPhysicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_vkPhysicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+        const uint32_t graphicsFamily = m_queueFamilyIndices.mGraphicsFamily.value();
+        if (graphicsFamily >= queueFamilyCount || (queueFamilyProperties[graphicsFamily].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) == 0)
         {
-            VK_LOG_FATAL("no suitable vulkan physical device found.");
             return false;
         }
 
-        // set selected physical device and its properties
-        m_vkPhysicalDevice = selectedDeviceInfo->mVkPhysicalDevice;
-        m_queueFamilyIndices = selectedDeviceInfo->mQueueFamilyIndices;
-        m_vkPhysicalDeviceProperties = selectedDeviceInfo->mVkPhysicalDeviceProperties;
-        m_vkPhysicalDeviceMemoryProperties = selectedDeviceInfo->mVkPhysicalDeviceMemoryProperties;
-        m_vkPhysicalDeviceFeatures = selectedDeviceInfo->mVkPhysicalDeviceFeatures;
-
-        // log device info and sanitize requested features
-        logPhysicalDeviceInfo(*selectedDeviceInfo);
-        validateRequestedFeatures();
+        // no sparse format properties: the format cannot be partially resident
+        uint32_t propertyCount = 0;
+        vkGetPhysicalDeviceSparseImageFormatProperties(m_vkPhysicalDevice, format, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT, usage, 
+                                                       VK_IMAGE_TILING_OPTIMAL, &propertyCount, nullptr);
+        return propertyCount > 0;
+    }
 
+    bool VulkanDevice::transitionImageLayoutOnHost(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, 
+                                                   const VkImageSubresourceRange& subresourceRange) const noexcept
+    {
+        VkHostImageLayoutTransitionInfo transitionInfo{};
+        transitionInfo.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO;
+        transitionInfo.pNext = nullptr;
+        transitionInfo.image = image;
+        transitionInfo.oldLayout = oldLayout;
+        transitionInfo.newLayout = newLayout;
+        transitionInfo.subresourceRange = subresourceRange;
+
+        VkResult vkResult = m_vkTransitionImageLayout ? m_vkTransitionImageLayout(m_vkDevice, 1, &transitionInfo) : VK_ERROR_FEATURE_NOT_PRESENT;
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkTransitionImageLayout failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
         return true;
     }
 
-    bool VulkanDevice::createLogicalDevice() noexcept
+    bool VulkanDevice::copyMemoryToImage(VkImage image, VkImageLayout layout, uint32_t regionCount, const VkMemoryToImageCopy* regions) const noexcept
     {
-        // collect unique queue family indices
-        std::unordered_set<uint32_t> uniqueQueueFamilies;
-        uniqueQueueFamilies.insert(*m_queueFamilyIndices.mGraphicsFamily);
-        uniqueQueueFamilies.insert(*m_queueFamilyIndices.mPresentFamily);
-        if (m_queueFamilyIndices.mComputeFamily) uniqueQueueFamilies.insert(*m_queueFamilyIndices.mComputeFamily);
-        if (m_queueFamilyIndices.mTransferFamily) uniqueQueueFamilies.insert(*m_queueFamilyIndices.mTransferFamily);
-
-        // create VkDeviceQueueCreateInfo for each unique queue family
-        std::vector<VkDeviceQueueCreateInfo> vkQueueCreateInfos;
-        vkQueueCreateInfos.reserve(uniqueQueueFamilies.size());
-
-        const float queuePriorities[] = { 1.0f };
-        for (const auto& queueFamilyIndex : uniqueQueueFamilies)
-        {
-            VkDeviceQueueCreateInfo queueCreateInfo{};
-            queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            queueCreateInfo.pNext = nullptr;
-            queueCreateInfo.flags = 0;
-            queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
-            queueCreateInfo.queueCount = 1;
-            queueCreateInfo.pQueuePriorities = queuePriorities;
-            vkQueueCreateInfos.emplace_back(std::move(queueCreateInfo));
-        }
-
-        // setup logical device creation info struct
-        VkDeviceCreateInfo vkDeviceCreateInfo{};
-        vkDeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        vkDeviceCreateInfo.pNext = nullptr;
-        vkDeviceCreateInfo.flags = 0;
-        vkDeviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(vkQueueCreateInfos.size());
-        vkDeviceCreateInfo.pQueueCreateInfos = vkQueueCreateInfos.data();
-        vkDeviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(m_deviceConfig.mDeviceExtensions.size());
-        vkDeviceCreateInfo.ppEnabledExtensionNames = m_deviceConfig.mDeviceExtensions.data();
-        vkDeviceCreateInfo.enabledLayerCount = 0;
-        vkDeviceCreateInfo.ppEnabledLayerNames = nullptr;
-        vkDeviceCreateInfo.pEnabledFeatures = &m_deviceConfig.mRequestedFeatures;              
-
-        // create the Vulkan logical device
-        VkResult vkResult = vkCreateDevice(m_vkPhysicalDevice, &vkDeviceCreateInfo, nullptr, &m_vkDevice);
+        VkCopyMemoryToImageInfo copyInfo{};
+        copyInfo.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO;
+        copyInfo.pNext = nullptr;
+        copyInfo.flags = 0;
+        copyInfo.dstImage = image;
+        copyInfo.dstImageLayout = layout;
+        copyInfo.regionCount = regionCount;
+        copyInfo.pRegions = regions;
+
+        VkResult vkResult = m_vkCopyMemoryToImage ? m_vkCopyMemoryToImage(m_vkDevice, &copyInfo) : VK_ERROR_FEATURE_NOT_PRESENT;
         if (vkResult != VK_SUCCESS)
         {
-            VK_LOG_FATAL("vkCreateDevice failed to create logical device : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_ERROR("vkCopyMemoryToImage failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
-
-        VK_LOG_INFO("logical device created successfully.");
         return true;
     }
 
-    bool VulkanDevice::getDeviceQueues() noexcept
+    bool VulkanDevice::isLowLatencyEnabled() const noexcept
     {
-        // graphics queue (required)
-        vkGetDeviceQueue(m_vkDevice, *m_queueFamilyIndices.mGraphicsFamily, 0, &m_graphicsQueue);
-        if (m_graphicsQueue == VK_NULL_HANDLE)
-        {
-            VK_LOG_FATAL("vkGetDeviceQueue failed to retrieve graphics queue.");
-            return false;
-        }
+        return m_deviceConfig.mRequestLowLatency;
+    }
 
-        // helper lamda to get the queue or alias to graphics if it shares the same family
-        auto getQueue = [&](const std::optional<uint32_t>& familyIndex, const char* name) -> VkQueue 
-        {
-            VkQueue vkQueue = VK_NULL_HANDLE;
-            if (!familyIndex.has_value())
-            {
-                VK_LOG_WARN("no %s queue family found.", name);
-                return vkQueue;
-            }
+    bool VulkanDevice::isLatencySleepEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestLowLatency && m_isLatencySleepEnabled;
+    }
 
-            if (*familyIndex == *m_queueFamilyIndices.mGraphicsFamily)
-            {
-                VK_LOG_INFO("%s queue shares family with graphics queue", name);
-                return m_graphicsQueue;
-            }
+    bool VulkanDevice::isFullScreenExclusiveEnabled() const noexcept
+    {
+        return m_deviceConfig.mRequestFullScreenExclusive;
+    }
 
-            vkGetDeviceQueue(m_vkDevice, *familyIndex, 0, &vkQueue);
-            if (vkQueue == VK_NULL_HANDLE)
-            {
-                VK_LOG_WARN("failed to retrieve %s queue.", name);
-            }
+    const VkPhysicalDeviceFragmentShadingRatePropertiesKHR& VulkanDevice::getFragmentShadingRateProperties() const noexcept
+    {
+        return m_fragmentShadingRateProperties;
+    }
 
-            return vkQueue;
-        };
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT& VulkanDevice::getDescriptorBufferProperties() const noexcept
+    {
+        return m_descriptorBufferProperties;
+    }
 
-        // present queue (required)
-        m_presentQueue = getQueue(m_queueFamilyIndices.mPresentFamily, "present");
-        if (m_presentQueue == VK_NULL_HANDLE)
-        {
-            return false;
-        }
- 
-        // compute and transfer queue (optional)
-        m_computeQueue = getQueue(m_queueFamilyIndices.mComputeFamily, "compute");
-        m_transferQueue = getQueue(m_queueFamilyIndices.mTransferFamily, "transfer");
-        return true;
+    const VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT& VulkanDevice::getDeviceGeneratedCommandsProperties() const noexcept
+    {
+        return m_deviceGeneratedCommandsProperties;
     }
 
-    QueueFamilyIndices VulkanDevice::findRequiredQueueFamilies(VkPhysicalDevice device, const VulkanSurface& surface) const noexcept
+    const VkPhysicalDeviceMultiDrawPropertiesEXT& VulkanDevice::getMultiDrawProperties() const noexcept
     {
-        // query queue family count
-        uint32_t queueFamilyCount = 0;
-        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+        return m_multiDrawProperties;
+    }
 
-        // retrieve queue family properties
-        std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
-        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilyProperties.data());
+    const VkPhysicalDeviceAccelerationStructurePropertiesKHR& VulkanDevice::getAccelerationStructureProperties() const noexcept
+    {
+        return m_accelerationStructureProperties;
+    }
 
-        QueueFamilyIndices indices; 
+    MemoryBudget VulkanDevice::queryMemoryBudget() const noexcept
+    {
+        std::array<MemoryBudget, VK_MAX_MEMORY_HEAPS> heapBudgets{};
+        const uint32_t heapCount = queryMemoryHeapBudgets(heapBudgets);
 
-        // find optimal queue families
-        for (uint32_t index = 0; index < queueFamilyCount; index++)
+        MemoryBudget memoryBudget{};
+        memoryBudget.mIsReported = m_deviceConfig.mRequestMemoryBudget;
+        for (uint32_t i = 0; i < heapCount; ++i)
         {
-            const bool supportsGraphics = queueFamilyProperties[index].queueFlags & VK_QUEUE_GRAPHICS_BIT;
-            const bool supportsCompute  = queueFamilyProperties[index].queueFlags & VK_QUEUE_COMPUTE_BIT;
-            const bool supportsTransfer = queueFamilyProperties[index].queueFlags & VK_QUEUE_TRANSFER_BIT;
-
-            // graphics with present queue family 
-            if (!indices.mGraphicsFamily && supportsGraphics && surface.canQueueFamilyPresent(device, index))
+            if ((m_vkPhysicalDeviceMemoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0)
             {
-                indices.mGraphicsFamily = index;
-                indices.mPresentFamily = index;
+                continue;
+            }
 
-                // share graphics queue for compute operations if dedicated is not requested
-                if (!m_deviceConfig.mPreferDedicatedComputeQueue && supportsCompute)
-                {
-                    indices.mComputeFamily = index;
-                }
+            memoryBudget.mHeapSize += heapBudgets[i].mHeapSize;
+            memoryBudget.mBudget += heapBudgets[i].mBudget;
+            memoryBudget.mUsage += heapBudgets[i].mUsage;
+        }
+        return memoryBudget;
+    }
 
-                // share graphics queue for transfer operations if dedicated is not requested
-                if (!m_deviceConfig.mPreferDedicatedTransferQueue && supportsTransfer)
-                {
-                    indices.mTransferFamily = index;
-                }
-            }
+    std::vector<MemoryBudget> VulkanDevice::queryMemoryHeapBudgets() const noexcept
+    {
+        std::array<MemoryBudget, VK_MAX_MEMORY_HEAPS> heapBudgets{};
+        const uint32_t heapCount = queryMemoryHeapBudgets(heapBudgets);
+        return std::vector<MemoryBudget>(heapBudgets.begin(), heapBudgets.begin() + heapCount);
+    }
 
-            // dedicated compute queue family
-            if (!indices.mComputeFamily && m_deviceConfig.mPreferDedicatedComputeQueue 
-                && supportsCompute && !supportsGraphics)
-            {
-                indices.mComputeFamily = index;
-            }
+    uint32_t VulkanDevice::queryMemoryHeapBudgets(std::array<MemoryBudget, VK_MAX_MEMORY_HEAPS>& heapBudgets) const noexcept
+    {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+        budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        budgetProperties.pNext = nullptr;
 
-            // dedicated transfer queue family
-            if (!indices.mTransferFamily && m_deviceConfig.mPreferDedicatedTransferQueue &&
-                supportsTransfer && !supportsGraphics && !supportsCompute)
-            {
-                indices.mTransferFamily = index;
-            }
+        VkPhysicalDeviceMemoryProperties2 memoryProperties2{};
+        memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryProperties2.pNext = &budgetProperties;
 
-            // early return if all queues are found
-            if (indices.mGraphicsFamily && indices.mPresentFamily && 
-                indices.mComputeFamily && indices.mTransferFamily)
-            {
-                return indices;
-            }
+        const bool isReported = m_deviceConfig.mRequestMemoryBudget;
+        if (isReported)
+        {
+            vkGetPhysicalDeviceMemoryProperties2(m_vkPhysicalDevice, &memoryProperties2);
         }
 
-        // fallback: find any available queue families regardless of preferences
-        if (!indices.isComplete())
+        // without the extension only this device's own blocks are known
+        VulkanMemoryStats memoryStats{};
+        if (!isReported && m_memoryAllocator)
         {
-            for (uint32_t index = 0; index < queueFamilyCount; index++)
-            {
-                const bool supportsGraphics = queueFamilyProperties[index].queueFlags & VK_QUEUE_GRAPHICS_BIT;
-                const bool supportsCompute  = queueFamilyProperties[index].queueFlags & VK_QUEUE_COMPUTE_BIT;
-                const bool supportsTransfer = queueFamilyProperties[index].queueFlags & VK_QUEUE_TRANSFER_BIT;
+            memoryStats = m_memoryAllocator->getStats();
+        }
 
-                // graphics queue family 
-                if (!indices.mGraphicsFamily && supportsGraphics)
-                {
-                    indices.mGraphicsFamily = index;
-                }
+        for (uint32_t i = 0; i < m_vkPhysicalDeviceMemoryProperties.memoryHeapCount; ++i)
+        {
+            const VkMemoryHeap& memoryHeap = m_vkPhysicalDeviceMemoryProperties.memoryHeaps[i];
+            heapBudgets[i].mHeapSize = memoryHeap.size;
+            heapBudgets[i].mBudget = isReported ? budgetProperties.heapBudget[i] : memoryHeap.size;
+            heapBudgets[i].mUsage = isReported ? budgetProperties.heapUsage[i] : memoryStats.mHeapBlockBytes[i];
+            heapBudgets[i].mIsReported = isReported;
+        }
+        return m_vkPhysicalDeviceMemoryProperties.memoryHeapCount;
+    }
 
-                // present queue family 
-                if (!indices.mPresentFamily && surface.canQueueFamilyPresent(device, index))
-                {
-                    indices.mPresentFamily = index;
-                }
+    VulkanMemoryAllocator& VulkanDevice::getMemoryAllocator() const noexcept
+    {
+        return *m_memoryAllocator;
+    }
 
-                // compute queue family 
-                if (!indices.mComputeFamily && supportsCompute)
-                {
-                    indices.mComputeFamily = index;
-                }
+    VulkanPipelineCache& VulkanDevice::getPipelineCache() const noexcept
+    {
+        return *m_pipelineCache;
+    }
 
-                // transfer queue family 
-                if (!indices.mTransferFamily && supportsTransfer)
-                {
-                    indices.mTransferFamily = index;
-                }
-            }
-        }
+    VulkanDescriptorSetLayoutCache& VulkanDevice::getDescriptorSetLayoutCache() const noexcept
+    {
+        return *m_descriptorSetLayoutCache;
+    }
 
-        return indices;
+    VulkanSamplerCache& VulkanDevice::getSamplerCache() const noexcept
+    {
+        return *m_samplerCache;
     }
 
-    bool VulkanDevice::checkDeviceExtensionSupport(VkPhysicalDevice device) const noexcept
+    VulkanShaderCache& VulkanDevice::getShaderCache() const noexcept
     {
-        // vulkan spec permits logical device creation without any extensions
-        if (m_deviceConfig.mDeviceExtensions.empty())
+        return *m_shaderCache;
+    }
+
+    std::optional<uint32_t> VulkanDevice::findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags propertyFlags) const noexcept
+    {
+        for (uint32_t i = 0; i < m_vkPhysicalDeviceMemoryProperties.memoryTypeCount; i++)
         {
-            VK_LOG_WARN("no device extensions requested");
-            return true;
+            bool isCompatibleType = (memoryTypeBits & (1 << i)) != 0;
+            bool hasRequiredProperties = (m_vkPhysicalDeviceMemoryProperties.memoryTypes[i].propertyFlags & propertyFlags) == propertyFlags;
+            if (isCompatibleType && hasRequiredProperties)
+            {   
+                return i;
+            }
         }
 
-        // query the number of supported device extensions
-        uint32_t extensionCount = 0;
-        VkResult vkResult = vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+        VK_LOG_DEBUG("No suitable memory type found for properties: %s", string_VkMemoryPropertyFlags(propertyFlags).c_str());
+        return std::nullopt;
+    }
+
+    bool VulkanDevice::isFormatSupported(VkFormat format, VkFormatFeatureFlags featureFlags) const noexcept
+    {
+        // optimal tiling: every image created by the engine uses it
+        VkFormatProperties formatProperties{};
+        vkGetPhysicalDeviceFormatProperties(m_vkPhysicalDevice, format, &formatProperties);
+        return (formatProperties.optimalTilingFeatures & featureFlags) == featureFlags;
+    }
+
+    bool VulkanDevice::selectPhysicalDevice(const VulkanSurface* surface, VkPhysicalDevice excludedDevice, 
+                                            std::optional<uint32_t> overrideIndex, std::string_view overrideName) noexcept
+    {
+        // query the number of vulkan compatible physical devices.
+        uint32_t deviceCount = 0;
+        VkResult vkResult = vkEnumeratePhysicalDevices(m_vkInstance, &deviceCount, nullptr);
         if (vkResult != VK_SUCCESS)
         {
-            VK_LOG_FATAL("failed to query device extension count : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("failed to query physical device count : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
-
-        // retrieve supported device extensions.
-        std::vector<VkExtensionProperties> extensionProperties(extensionCount);
-        vkResult = vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensionProperties.data());
-        if (vkResult != VK_SUCCESS)
+        
+        // abort if no vulkan compatible physical devices were found.
+        if (deviceCount == 0)
         {
-            VK_LOG_FATAL("failed to query device extension properties : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("no vulkan-compatible physical devices found.");
             return false;
         }
 
-        // check if all the requested extensions are present in supported extensions
-        std::unordered_set<std::string_view> required(m_deviceConfig.mDeviceExtensions.begin(), m_deviceConfig.mDeviceExtensions.end());
-        for (const auto& extension  : extensionProperties)
+        // retrieve the supported vulkan compatible physical devices.
+        std::vector<VkPhysicalDevice> physicalDevices(deviceCount);
+        vkResult = vkEnumeratePhysicalDevices(m_vkInstance, &deviceCount, physicalDevices.data());
+        if (vkResult != VK_SUCCESS)
         {
-            required.erase(extension.extensionName);
+            VK_LOG_FATAL("failed to query physical devices : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
         }
 
-        // log the requested extensions not supported by device
-        for (const auto& ext : required) 
+        // score every suitable device; all of them are listed as candidates
+        std::vector<PhysicalDeviceInfo> suitableDevices;
+        m_physicalDeviceCandidates.clear();
+        m_physicalDeviceCandidates.reserve(deviceCount);
+        for (uint32_t index = 0; index < deviceCount; index++)
         {
-            VK_LOG_WARN("unsupported device extension: %s", ext.data());
-        }
+            const VkPhysicalDevice device = physicalDevices[index];
 
-        return required.empty();
-    }
+            // get device properties early to log device name if skipped.
+            PhysicalDeviceInfo physicalDeviceInfo{};
+            physicalDeviceInfo.mVkPhysicalDevice = device;
+            physicalDeviceInfo.mIndex = index;
+            vkGetPhysicalDeviceProperties(device, &physicalDeviceInfo.mVkPhysicalDeviceProperties);
+            vkGetPhysicalDeviceMemoryProperties(device, &physicalDeviceInfo.mVkPhysicalDeviceMemoryProperties);
 
-    uint64_t VulkanDevice::scoreDevice(const PhysicalDeviceInfo& physicalDeviceInfo) const noexcept
-    {
-        uint64_t score = 0;
-        const auto& properties = physicalDeviceInfo.mVkPhysicalDeviceProperties;
-        const auto& memoryProperties = physicalDeviceInfo.mVkPhysicalDeviceMemoryProperties;
+            const auto& properties = physicalDeviceInfo.mVkPhysicalDeviceProperties;
+            const auto& memoryProperties = physicalDeviceInfo.mVkPhysicalDeviceMemoryProperties;
+            PhysicalDeviceCandidate& candidate = m_physicalDeviceCandidates.emplace_back();
+            candidate.mName = properties.deviceName;
+            candidate.mIndex = index;
+            candidate.mType = properties.deviceType;
+            candidate.mApiVersion = properties.apiVersion;
+            for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+            {
+                if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+                {
+                    candidate.mDeviceLocalBytes += memoryProperties.memoryHeaps[i].size;
+                }
+            }
 
-        // device type preference
-        switch (properties.deviceType)
-        {
-            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
-                score += 1000;
-                break;
+            // the primary device's gpu is listed, but never chosen again
+            if (device == excludedDevice)
+            {
+                continue;
+            }
 
-            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
-                score += 200;
-                break;
+            // skip devices that don't support required extensions
+            if (!checkDeviceExtensionSupport(device))
+            {
+                VK_LOG_WARN("skipping device %s due to missing required extension support", properties.deviceName);
+                continue;
+            }
 
-            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
-                score += 100;
-                break;
+            // device must support a graphics queue, and a present queue for rendering to the surface
+            QueueFamilyIndices indices = findRequiredQueueFamilies(device, surface);
+            if (!indices.mGraphicsFamily || (surface && !indices.mPresentFamily))
+            {
+                VK_LOG_WARN("skipping device %s due to missing graphics or present queue support", properties.deviceName);
+                continue;
+            }
+
+            // retrieve additional physical device info for scoring.
+            physicalDeviceInfo.mQueueFamilyIndices = std::move(indices);
+            vkGetPhysicalDeviceFeatures(device, &physicalDeviceInfo.mVkPhysicalDeviceFeatures);
+            scoreDevice(physicalDeviceInfo);
+
+            candidate.mPerformanceScore = physicalDeviceInfo.mPerformanceScore;
+            candidate.mCapabilityScore = physicalDeviceInfo.mCapabilityScore;
+            candidate.mIsSuitable = true;
+            suitableDevices.emplace_back(std::move(physicalDeviceInfo));
         }
 
-        // device local memory (1 point per 1GB)
-        uint64_t bytesPerPoint = 1024 * 1024 * 1024;
-        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        // abort if no suitable physical device was found (expected for a secondary device on single gpu systems)
+        if (suitableDevices.empty())
         {
-            if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            if (excludedDevice != VK_NULL_HANDLE)
             {
-                score += static_cast<uint64_t>(memoryProperties.memoryHeaps[i].size / bytesPerPoint);
+                VK_LOG_INFO("no secondary vulkan physical device available.");
             }
+            else
+            {
+                VK_LOG_FATAL("no suitable vulkan physical device found.");
+            }
+            return false;
         }
 
-        // rendering quality and capacity
-        const auto& limits = properties.limits;
-        score += static_cast<uint64_t>(limits.maxImageDimension2D / 1024);
-        score += static_cast<uint64_t>(limits.framebufferColorSampleCounts & VK_SAMPLE_COUNT_8_BIT ? 20 : 0);
+        // an explicit choice wins over the scores; one matching no suitable device is reported and ignored
+        const PhysicalDeviceInfo* selectedDeviceInfo = nullptr;
+        if (overrideIndex || !overrideName.empty())
+        {
+            const auto overridden = std::find_if(suitableDevices.begin(), suitableDevices.end(), [&](const PhysicalDeviceInfo& info)
+            {
+                return overrideIndex ? info.mIndex == *overrideIndex : containsIgnoreCase(info.mVkPhysicalDeviceProperties.deviceName, overrideName);
+            });
 
-        // shading and pipeline resources
-        score += std::min<uint64_t>(limits.maxPerStageDescriptorSampledImages / 8, 32u);
-        score += std::min<uint64_t>(limits.maxPerStageDescriptorUniformBuffers / 4, 32u);
-        score += std::min<uint64_t>(limits.maxFragmentCombinedOutputResources / 4, 32u);
-        score += std::min<uint64_t>(limits.maxPushConstantsSize / 32, 16u);
-        score += std::min<uint64_t>(limits.maxBoundDescriptorSets * 2, 16u);
+            if (overridden != suitableDevices.end())
+            {
+                selectedDeviceInfo = &*overridden;
+            }
+            else if (overrideIndex)
+            {
+                VK_LOG_WARN("device override %u matches no suitable device, using the best scored one", *overrideIndex);
+            }
+            else
+            {
+                VK_LOG_WARN("device override \"%.*s\" matches no suitable device, using the best scored one", 
+                            static_cast<int>(overrideName.size()), overrideName.data());
+            }
+        }
+
+        // otherwise the best scored device (the first enumerated one on ties)
+        if (!selectedDeviceInfo)
+        {
+            selectedDeviceInfo = &*std::max_element(suitableDevices.begin(), suitableDevices.end(), [](const PhysicalDeviceInfo& a, const PhysicalDeviceInfo& b)
+            {
+                return a.mScore < b.mScore;
+            });
+        }
+
+        // set selected physical device and its properties
+        m_vkPhysicalDevice = selectedDeviceInfo->mVkPhysicalDevice;
+        m_physicalDeviceIndex = selectedDeviceInfo->mIndex;
+        m_queueFamilyIndices = selectedDeviceInfo->mQueueFamilyIndices;
+        m_vkPhysicalDeviceProperties = selectedDeviceInfo->mVkPhysicalDeviceProperties;
+        m_vkPhysicalDeviceMemoryProperties = selectedDeviceInfo->mVkPhysicalDeviceMemoryProperties;
+        m_vkPhysicalDeviceFeatures = selectedDeviceInfo->mVkPhysicalDeviceFeatures;
+
+        // log device info and sanitize requested features
+        logPhysicalDeviceInfo(*selectedDeviceInfo);
+        validateRequestedFeatures();
 
-        return score;
+        return true;
     }
 
-    void VulkanDevice::logPhysicalDeviceInfo(const PhysicalDeviceInfo& physicalDeviceInfo) const noexcept
+    bool VulkanDevice::createLogicalDevice() noexcept
     {
-        const auto& properties = physicalDeviceInfo.mVkPhysicalDeviceProperties;
-        const auto& indices = physicalDeviceInfo.mQueueFamilyIndices;
+        // collect unique queue family indices
+        std::unordered_set<uint32_t> uniqueQueueFamilies;
+        uniqueQueueFamilies.insert(*m_queueFamilyIndices.mGraphicsFamily);
+        if (m_queueFamilyIndices.mPresentFamily) uniqueQueueFamilies.insert(*m_queueFamilyIndices.mPresentFamily);
+        if (m_queueFamilyIndices.mComputeFamily) uniqueQueueFamilies.insert(*m_queueFamilyIndices.mComputeFamily);
+        if (m_queueFamilyIndices.mTransferFamily) uniqueQueueFamilies.insert(*m_queueFamilyIndices.mTransferFamily);
 
-        // log details of the selected physical device.
-        VK_LOG_INFO("─────────────── Selected Vulkan Physical Device ───────────────");
-        VK_LOG_INFO("Device Name           : %s", properties.deviceName);
-        VK_LOG_INFO("Device Type           : %s", string_VkPhysicalDeviceType(properties.deviceType));
-        VK_LOG_INFO("API Version           : %u.%u.%u",
-                    VK_VERSION_MAJOR(properties.apiVersion),
-                    VK_VERSION_MINOR(properties.apiVersion),
-                    VK_VERSION_PATCH(properties.apiVersion));
-        VK_LOG_INFO("Driver Version        : %u", properties.driverVersion);
-        VK_LOG_INFO("Vendor ID             : 0x%X", properties.vendorID);
-        VK_LOG_INFO("Device ID             : 0x%X", properties.deviceID);
-        VK_LOG_INFO("Score                 : %d", physicalDeviceInfo.mScore);
-        VK_LOG_INFO("Graphics Queue Index  : %d", indices.mGraphicsFamily.value_or(-1));
-        VK_LOG_INFO("Present Queue Index   : %d", indices.mPresentFamily.value_or(-1));
-        VK_LOG_INFO("Compute Queue Index   : %d", indices.mComputeFamily.value_or(-1));
-        VK_LOG_INFO("Transfer Queue Index  : %d", indices.mTransferFamily.value_or(-1));
-        VK_LOG_INFO("───────────────────────────────────────────────────────────────");
+        // create VkDeviceQueueCreateInfo for each unique queue family
+        std::vector<VkDeviceQueueCreateInfo> vkQueueCreateInfos;
+        vkQueueCreateInfos.reserve(uniqueQueueFamilies.size());
 
-        // log enabled validation layers
-        for (const auto& extension : m_deviceConfig.mDeviceExtensions)
+        const float queuePriorities[] = { 1.0f };
+        for (const auto& queueFamilyIndex : uniqueQueueFamilies)
         {
-            VK_LOG_INFO("enabled device extension: %s", extension);
+            VkDeviceQueueCreateInfo queueCreateInfo{};
+            queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueCreateInfo.pNext = nullptr;
+            queueCreateInfo.flags = 0;
+            queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+            queueCreateInfo.queueCount = 1;
+            queueCreateInfo.pQueuePriorities = queuePriorities;
+            vkQueueCreateInfos.emplace_back(std::move(queueCreateInfo));
         }
-    }
 
-    void VulkanDevice::validateRequestedFeatures() noexcept
-    {
-        // array of pairs: pointer-to-member + feature name
-        constexpr std::pair<VkBool32 VkPhysicalDeviceFeatures::*, const char*> featureMap[] = 
+        // the validated config chain, with the features behind the (also validated) request flags merged into it
+        VulkanFeatureChain& featureChain = m_deviceConfig.mRequestedFeatureChain;
+        const bool hasVulkan12Features = m_deviceConfig.mRequestDrawIndirectCount || m_deviceConfig.mRequestDescriptorIndexing || 
+                                         m_deviceConfig.mRequestTimelineSemaphore || m_deviceConfig.mRequestBufferDeviceAddress || 
+                                         m_deviceConfig.mRequestShaderFloat16;
+        if (hasVulkan12Features)
         {
-            { &VkPhysicalDeviceFeatures::robustBufferAccess, "robustBufferAccess" },
-            { &VkPhysicalDeviceFeatures::fullDrawIndexUint32, "fullDrawIndexUint32" },
-            { &VkPhysicalDeviceFeatures::imageCubeArray, "imageCubeArray" },
-            { &VkPhysicalDeviceFeatures::independentBlend, "independentBlend" },
-            { &VkPhysicalDeviceFeatures::geometryShader, "geometryShader" },
-            { &VkPhysicalDeviceFeatures::tessellationShader, "tessellationShader" },
-            { &VkPhysicalDeviceFeatures::sampleRateShading, "sampleRateShading" },
-            { &VkPhysicalDeviceFeatures::dualSrcBlend, "dualSrcBlend" },
-            { &VkPhysicalDeviceFeatures::logicOp, "logicOp" },
-            { &VkPhysicalDeviceFeatures::multiDrawIndirect, "multiDrawIndirect" },
-            { &VkPhysicalDeviceFeatures::drawIndirectFirstInstance, "drawIndirectFirstInstance" },
-            { &VkPhysicalDeviceFeatures::depthClamp, "depthClamp" },
-            { &VkPhysicalDeviceFeatures::depthBiasClamp, "depthBiasClamp" },
-            { &VkPhysicalDeviceFeatures::fillModeNonSolid, "fillModeNonSolid" },
-            { &VkPhysicalDeviceFeatures::depthBounds, "depthBounds" },
-            { &VkPhysicalDeviceFeatures::wideLines, "wideLines" },
-            { &VkPhysicalDeviceFeatures::largePoints, "largePoints" },
-            { &VkPhysicalDeviceFeatures::alphaToOne, "alphaToOne" },
-            { &VkPhysicalDeviceFeatures::multiViewport, "multiViewport" },
-            { &VkPhysicalDeviceFeatures::samplerAnisotropy, "samplerAnisotropy" },
-            { &VkPhysicalDeviceFeatures::textureCompressionETC2, "textureCompressionETC2" },
-            { &VkPhysicalDeviceFeatures::textureCompressionASTC_LDR, "textureCompressionASTC_LDR" },
-            { &VkPhysicalDeviceFeatures::textureCompressionBC, "textureCompressionBC" },
-            { &VkPhysicalDeviceFeatures::occlusionQueryPrecise, "occlusionQueryPrecise" },
-            { &VkPhysicalDeviceFeatures::pipelineStatisticsQuery, "pipelineStatisticsQuery" },
-            { &VkPhysicalDeviceFeatures::vertexPipelineStoresAndAtomics, "vertexPipelineStoresAndAtomics" },
-            { &VkPhysicalDeviceFeatures::fragmentStoresAndAtomics, "fragmentStoresAndAtomics" },
-            { &VkPhysicalDeviceFeatures::shaderTessellationAndGeometryPointSize, "shaderTessellationAndGeometryPointSize" },
-            { &VkPhysicalDeviceFeatures::shaderImageGatherExtended, "shaderImageGatherExtended" },
-            { &VkPhysicalDeviceFeatures::shaderStorageImageExtendedFormats, "shaderStorageImageExtendedFormats" },
-            { &VkPhysicalDeviceFeatures::shaderStorageImageMultisample, "shaderStorageImageMultisample" },
-            { &VkPhysicalDeviceFeatures::shaderStorageImageReadWithoutFormat, "shaderStorageImageReadWithoutFormat" },
-            { &VkPhysicalDeviceFeatures::shaderStorageImageWriteWithoutFormat, "shaderStorageImageWriteWithoutFormat" },
-            { &VkPhysicalDeviceFeatures::shaderUniformBufferArrayDynamicIndexing, "shaderUniformBufferArrayDynamicIndexing" },
-            { &VkPhysicalDeviceFeatures::shaderSampledImageArrayDynamicIndexing, "shaderSampledImageArrayDynamicIndexing" },
-            { &VkPhysicalDeviceFeatures::shaderStorageBufferArrayDynamicIndexing, "shaderStorageBufferArrayDynamicIndexing" },
-            { &VkPhysicalDeviceFeatures::shaderStorageImageArrayDynamicIndexing, "shaderStorageImageArrayDynamicIndexing" },
-            { &VkPhysicalDeviceFeatures::shaderClipDistance, "shaderClipDistance" },
-            { &VkPhysicalDeviceFeatures::shaderCullDistance, "shaderCullDistance" },
-            { &VkPhysicalDeviceFeatures::shaderFloat64, "shaderFloat64" },
-            { &VkPhysicalDeviceFeatures::shaderInt64, "shaderInt64" },
-            { &VkPhysicalDeviceFeatures::shaderInt16, "shaderInt16" },
-            { &VkPhysicalDeviceFeatures::shaderResourceResidency, "shaderResourceResidency" },
-            { &VkPhysicalDeviceFeatures::shaderResourceMinLod, "shaderResourceMinLod" },
-            { &VkPhysicalDeviceFeatures::sparseBinding, "sparseBinding" },
-            { &VkPhysicalDeviceFeatures::sparseResidencyBuffer, "sparseResidencyBuffer" },
-            { &VkPhysicalDeviceFeatures::sparseResidencyImage2D, "sparseResidencyImage2D" },
-            { &VkPhysicalDeviceFeatures::sparseResidencyImage3D, "sparseResidencyImage3D" },
-            { &VkPhysicalDeviceFeatures::sparseResidency2Samples, "sparseResidency2Samples" },
-            { &VkPhysicalDeviceFeatures::sparseResidency4Samples, "sparseResidency4Samples" },
-            { &VkPhysicalDeviceFeatures::sparseResidency8Samples, "sparseResidency8Samples" },
-            { &VkPhysicalDeviceFeatures::sparseResidency16Samples, "sparseResidency16Samples" },
-            { &VkPhysicalDeviceFeatures::sparseResidencyAliased, "sparseResidencyAliased" },
-            { &VkPhysicalDeviceFeatures::variableMultisampleRate, "variableMultisampleRate" },
-            { &VkPhysicalDeviceFeatures::inheritedQueries, "inheritedQueries" }
-        };
+            auto& vulkan12Features = featureChain.add<VkPhysicalDeviceVulkan12Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES);
+            if (m_deviceConfig.mRequestDrawIndirectCount)
+            {
+                vulkan12Features.drawIndirectCount = VK_TRUE;
+            }
 
-        // sanitize the requested features
-        const auto& supportedFeatures = m_vkPhysicalDeviceFeatures;
-        auto& requestedFeatures = m_deviceConfig.mRequestedFeatures;
+            // bindless: runtime-sized, partially bound sampler arrays indexed with non-uniform indices
+            if (m_deviceConfig.mRequestDescriptorIndexing)
+            {
+                vulkan12Features.descriptorIndexing = VK_TRUE;
+                vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+                vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+                vulkan12Features.descriptorBindingVariableDescriptorCount = VK_TRUE;
+                vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+            }
 
-        for (const auto& [memberPtr, name] : featureMap)
+            // monotonic semaphore counters for frame pacing and cross-queue sync
+            if (m_deviceConfig.mRequestTimelineSemaphore)
+            {
+                vulkan12Features.timelineSemaphore = VK_TRUE;
+            }
+
+            // buffer references: vertex pools read through their device address
+            if (m_deviceConfig.mRequestBufferDeviceAddress)
+            {
+                vulkan12Features.bufferDeviceAddress = VK_TRUE;
+            }
+
+            // fp16 arithmetic; inputs, outputs and buffers stay 32-bit, so no 16-bit storage is needed
+            if (m_deviceConfig.mRequestShaderFloat16)
+            {
+                vulkan12Features.shaderFloat16 = VK_TRUE;
+            }
+        }
+
+        // optional vulkan 1.1 features: every view of a view mask drawn by one render pass
+        if (m_deviceConfig.mRequestMultiview)
         {
-            VkBool32& requested = requestedFeatures.*memberPtr;
-            VkBool32 supported = supportedFeatures.*memberPtr;
-            if (requested && !supported)
+            featureChain.add<VkPhysicalDeviceVulkan11Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES).multiview = VK_TRUE;
+        }
+
+        // optional vulkan 1.3 features: render pass-less rendering
+        if (m_deviceConfig.mRequestDynamicRendering)
+        {
+            featureChain.add<VkPhysicalDeviceVulkan13Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES).dynamicRendering = VK_TRUE;
+        }
+
+        // optional vulkan 1.3 features: 64-bit barriers (shares the 1.3 feature struct with dynamic rendering)
+        if (m_deviceConfig.mRequestSynchronization2)
+        {
+            featureChain.add<VkPhysicalDeviceVulkan13Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES).synchronization2 = VK_TRUE;
+        }
+
+        // optional present id/wait extension features: vkWaitForPresentKHR on ids attached to vkQueuePresentKHR
+        if (m_deviceConfig.mRequestPresentWait)
+        {
+            featureChain.add<VkPhysicalDevicePresentIdFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR).presentId = VK_TRUE;
+            featureChain.add<VkPhysicalDevicePresentWaitFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR).presentWait = VK_TRUE;
+        }
+
+        // optional swapchain maintenance features: per-present mode switches among compatible modes
+        if (m_deviceConfig.mRequestSwapchainMaintenance1)
+        {
+            featureChain.add<VkPhysicalDeviceSwapchainMaintenance1FeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SWAPCHAIN_MAINTENANCE_1_FEATURES_EXT)
+                        .swapchainMaintenance1 = VK_TRUE;
+        }
+
+        // optional mesh shader features: task and mesh stages only (no multiview or shading rate variants)
+        if (m_deviceConfig.mRequestMeshShader)
+        {
+            auto& meshShaderFeatures = featureChain.add<VkPhysicalDeviceMeshShaderFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT);
+            meshShaderFeatures.taskShader = VK_TRUE;
+            meshShaderFeatures.meshShader = VK_TRUE;
+        }
+
+        // optional fragment shading rate features: pipeline rates always, attachment rates where the device has them
+        if (m_deviceConfig.mRequestFragmentShadingRate)
+        {
+            auto& fragmentShadingRateFeatures = featureChain.add<VkPhysicalDeviceFragmentShadingRateFeaturesKHR>(
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR);
+            fragmentShadingRateFeatures.pipelineFragmentShadingRate = VK_TRUE;
+            if (m_isShadingRateAttachmentEnabled)
             {
-                VK_LOG_WARN("requested feature '%s' is not supported", name);
-                requested = VK_FALSE;
+                fragmentShadingRateFeatures.attachmentFragmentShadingRate = VK_TRUE;
+            }
+        }
+
+        // optional graphics pipeline library feature: library parts and linking (VK_KHR_pipeline_library has no feature bit)
+        if (m_deviceConfig.mRequestGraphicsPipelineLibrary)
+        {
+            featureChain.add<VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT)
+                        .graphicsPipelineLibrary = VK_TRUE;
+        }
+
+        // optional shader object feature: pipeline-less shaders (the dynamic state commands they need come with the extension)
+        if (m_deviceConfig.mRequestShaderObject)
+        {
+            featureChain.add<VkPhysicalDeviceShaderObjectFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT).shaderObject = VK_TRUE;
+        }
+
+        // optional descriptor buffer feature: descriptors in mapped memory instead of pool-allocated sets
+        if (m_deviceConfig.mRequestDescriptorBuffer)
+        {
+            featureChain.add<VkPhysicalDeviceDescriptorBufferFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT).descriptorBuffer = VK_TRUE;
+        }
+
+        // optional generated commands feature, with the maintenance5 pipeline flags its execution sets need (core in vulkan 1.4)
+        if (m_deviceConfig.mRequestDeviceGeneratedCommands)
+        {
+            featureChain.add<VkPhysicalDeviceDeviceGeneratedCommandsFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEVICE_GENERATED_COMMANDS_FEATURES_EXT)
+                        .deviceGeneratedCommands = VK_TRUE;
+            if (m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_4)
+            {
+                featureChain.add<VkPhysicalDeviceVulkan14Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_4_FEATURES).maintenance5 = VK_TRUE;
+            }
+            else
+            {
+                featureChain.add<VkPhysicalDeviceMaintenance5FeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_5_FEATURES_KHR).maintenance5 = VK_TRUE;
+            }
+        }
+
+        // optional multi-draw feature, with the draw parameters its shaders read gl_DrawID through
+        if (m_deviceConfig.mRequestMultiDraw)
+        {
+            featureChain.add<VkPhysicalDeviceMultiDrawFeaturesEXT>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT).multiDraw = VK_TRUE;
+            featureChain.add<VkPhysicalDeviceShaderDrawParametersFeatures>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES)
+                        .shaderDrawParameters = VK_TRUE;
+        }
+
+        // optional ray query features: acceleration structures, and tracing them from any shader stage
+        if (m_deviceConfig.mRequestRayQuery)
+        {
+            featureChain.add<VkPhysicalDeviceAccelerationStructureFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR)
+                        .accelerationStructure = VK_TRUE;
+            featureChain.add<VkPhysicalDeviceRayQueryFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR).rayQuery = VK_TRUE;
+        }
+
+        // optional vulkan 1.4 feature: cpu writes into optimal-tiled images
+        if (m_deviceConfig.mRequestHostImageCopy)
+        {
+            featureChain.add<VkPhysicalDeviceVulkan14Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_4_FEATURES).hostImageCopy = VK_TRUE;
+        }
+
+        // optional anti-lag feature: only when low latency falls back from latency sleep (which has no feature bit)
+        if (m_deviceConfig.mRequestLowLatency && !m_isLatencySleepEnabled)
+        {
+            featureChain.add<VkPhysicalDeviceAntiLagFeaturesAMD>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ANTI_LAG_FEATURES_AMD).antiLag = VK_TRUE;
+        }
+
+        // setup logical device creation info struct
+        VkDeviceCreateInfo vkDeviceCreateInfo{};
+        vkDeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        vkDeviceCreateInfo.pNext = featureChain.link();
+        vkDeviceCreateInfo.flags = 0;
+        vkDeviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(vkQueueCreateInfos.size());
+        vkDeviceCreateInfo.pQueueCreateInfos = vkQueueCreateInfos.data();
+        vkDeviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(m_deviceConfig.mDeviceExtensions.size());
+        vkDeviceCreateInfo.ppEnabledExtensionNames = m_deviceConfig.mDeviceExtensions.data();
+        vkDeviceCreateInfo.enabledLayerCount = 0;
+        vkDeviceCreateInfo.ppEnabledLayerNames = nullptr;
+        vkDeviceCreateInfo.pEnabledFeatures = &m_deviceConfig.mRequestedFeatures;              
+
+        // create the Vulkan logical device
+        VkResult vkResult = vkCreateDevice(m_vkPhysicalDevice, &vkDeviceCreateInfo, getVulkanAllocationCallbacks(), &m_vkDevice);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkCreateDevice failed to create logical device : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VK_LOG_INFO("logical device created successfully.");
+        return true;
+    }
+
+    bool VulkanDevice::getDeviceQueues() noexcept
+    {
+        // graphics queue (required)
+        vkGetDeviceQueue(m_vkDevice, *m_queueFamilyIndices.mGraphicsFamily, 0, &m_graphicsQueue);
+        if (m_graphicsQueue == VK_NULL_HANDLE)
+        {
+            VK_LOG_FATAL("vkGetDeviceQueue failed to retrieve graphics queue.");
+            return false;
+        }
+
+        // helper lamda to get the queue or alias to graphics if it shares the same family
+        auto getQueue = [&](const std::optional<uint32_t>& familyIndex, const char* name) -> VkQueue 
+        {
+            VkQueue vkQueue = VK_NULL_HANDLE;
+            if (!familyIndex.has_value())
+            {
+                VK_LOG_WARN("no %s queue family found.", name);
+                return vkQueue;
+            }
+
+            if (*familyIndex == *m_queueFamilyIndices.mGraphicsFamily)
+            {
+                VK_LOG_INFO("%s queue shares family with graphics queue", name);
+                return m_graphicsQueue;
+            }
+
+            vkGetDeviceQueue(m_vkDevice, *familyIndex, 0, &vkQueue);
+            if (vkQueue == VK_NULL_HANDLE)
+            {
+                VK_LOG_WARN("failed to retrieve %s queue.", name);
+            }
+
+            return vkQueue;
+        };
+
+        // present queue (required, except on headless devices)
+        if (m_queueFamilyIndices.mPresentFamily)
+        {
+            m_presentQueue = getQueue(m_queueFamilyIndices.mPresentFamily, "present");
+            if (m_presentQueue == VK_NULL_HANDLE)
+            {
+                return false;
+            }
+        }
+ 
+        // compute and transfer queue (optional)
+        m_computeQueue = getQueue(m_queueFamilyIndices.mComputeFamily, "compute");
+        m_transferQueue = getQueue(m_queueFamilyIndices.mTransferFamily, "transfer");
+        return true;
+    }
+
+    QueueFamilyIndices VulkanDevice::findRequiredQueueFamilies(VkPhysicalDevice device, const VulkanSurface* surface) const noexcept
+    {
+        // query queue family count
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+
+        // retrieve queue family properties
+        std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilyProperties.data());
+
+        QueueFamilyIndices indices; 
+
+        // without a surface (headless devices) no present family is needed
+        auto isComplete = [&indices, surface]() { return indices.mGraphicsFamily && (!surface || indices.mPresentFamily); };
+
+        // find optimal queue families
+        for (uint32_t index = 0; index < queueFamilyCount; index++)
+        {
+            const bool supportsGraphics = queueFamilyProperties[index].queueFlags & VK_QUEUE_GRAPHICS_BIT;
+            const bool supportsCompute  = queueFamilyProperties[index].queueFlags & VK_QUEUE_COMPUTE_BIT;
+            const bool supportsTransfer = queueFamilyProperties[index].queueFlags & VK_QUEUE_TRANSFER_BIT;
+
+            // graphics with present queue family 
+            if (!indices.mGraphicsFamily && supportsGraphics && (!surface || surface->canQueueFamilyPresent(device, index)))
+            {
+                indices.mGraphicsFamily = index;
+                if (surface) indices.mPresentFamily = index;
+
+                // share graphics queue for compute operations if dedicated is not requested
+                if (!m_deviceConfig.mPreferDedicatedComputeQueue && supportsCompute)
+                {
+                    indices.mComputeFamily = index;
+                }
+
+                // share graphics queue for transfer operations if dedicated is not requested
+                if (!m_deviceConfig.mPreferDedicatedTransferQueue && supportsTransfer)
+                {
+                    indices.mTransferFamily = index;
+                }
+            }
+
+            // dedicated compute queue family
+            if (!indices.mComputeFamily && m_deviceConfig.mPreferDedicatedComputeQueue 
+                && supportsCompute && !supportsGraphics)
+            {
+                indices.mComputeFamily = index;
+            }
+
+            // dedicated transfer queue family
+            if (!indices.mTransferFamily && m_deviceConfig.mPreferDedicatedTransferQueue &&
+                supportsTransfer && !supportsGraphics && !supportsCompute)
+            {
+                indices.mTransferFamily = index;
+            }
+
+            // early return if all queues are found
+            if (isComplete() && indices.mComputeFamily && indices.mTransferFamily)
+            {
+                return indices;
+            }
+        }
+
+        // fallback: find any available queue families regardless of preferences
+        if (!isComplete())
+        {
+            for (uint32_t index = 0; index < queueFamilyCount; index++)
+            {
+                const bool supportsGraphics = queueFamilyProperties[index].queueFlags & VK_QUEUE_GRAPHICS_BIT;
+                const bool supportsCompute  = queueFamilyProperties[index].queueFlags & VK_QUEUE_COMPUTE_BIT;
+                const bool supportsTransfer = queueFamilyProperties[index].queueFlags & VK_QUEUE_TRANSFER_BIT;
+
+                // graphics queue family 
+                if (!indices.mGraphicsFamily && supportsGraphics)
+                {
+                    indices.mGraphicsFamily = index;
+                }
+
+                // present queue family 
+                if (surface && !indices.mPresentFamily && surface->canQueueFamilyPresent(device, index))
+                {
+                    indices.mPresentFamily = index;
+                }
+
+                // compute queue family 
+                if (!indices.mComputeFamily && supportsCompute)
+                {
+                    indices.mComputeFamily = index;
+                }
+
+                // transfer queue family 
+                if (!indices.mTransferFamily && supportsTransfer)
+                {
+                    indices.mTransferFamily = index;
+                }
+            }
+        }
+
+        return indices;
+    }
+
+    bool VulkanDevice::checkDeviceExtensionSupport(VkPhysicalDevice device) const noexcept
+    {
+        // vulkan spec permits logical device creation without any extensions
+        if (m_deviceConfig.mDeviceExtensions.empty())
+        {
+            VK_LOG_WARN("no device extensions requested");
+            return true;
+        }
+
+        // query the number of supported device extensions
+        uint32_t extensionCount = 0;
+        VkResult vkResult = vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("failed to query device extension count : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // retrieve supported device extensions.
+        std::vector<VkExtensionProperties> extensionProperties(extensionCount);
+        vkResult = vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensionProperties.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("failed to query device extension properties : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // check if all the requested extensions are present in supported extensions
+        std::unordered_set<std::string_view> required(m_deviceConfig.mDeviceExtensions.begin(), m_deviceConfig.mDeviceExtensions.end());
+        for (const auto& extension  : extensionProperties)
+        {
+            required.erase(extension.extensionName);
+        }
+
+        // log the requested extensions not supported by device
+        for (const auto& ext : required) 
+        {
+            VK_LOG_WARN("unsupported device extension: %s", ext.data());
+        }
+
+        return required.empty();
+    }
+
+    void VulkanDevice::scoreDevice(PhysicalDeviceInfo& physicalDeviceInfo) const noexcept
+    {
+        // performance: what the device is and how much memory it has
+        uint64_t score = 0;
+        const auto& properties = physicalDeviceInfo.mVkPhysicalDeviceProperties;
+        const auto& memoryProperties = physicalDeviceInfo.mVkPhysicalDeviceMemoryProperties;
+
+        // device type preference
+        switch (properties.deviceType)
+        {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+                score += 1000;
+                break;
+
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+                score += 200;
+                break;
+
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+                score += 100;
+                break;
+        }
+
+        // device local memory (1 point per 1GB)
+        uint64_t bytesPerPoint = 1024 * 1024 * 1024;
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        {
+            if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            {
+                score += static_cast<uint64_t>(memoryProperties.memoryHeaps[i].size / bytesPerPoint);
+            }
+        }
+        physicalDeviceInfo.mPerformanceScore = score;
+
+        // capability: api version (10 points per minor version), rendering quality and capacity
+        score = static_cast<uint64_t>(VK_API_VERSION_MINOR(properties.apiVersion) * 10);
+        const auto& limits = properties.limits;
+        score += static_cast<uint64_t>(limits.maxImageDimension2D / 1024);
+        score += static_cast<uint64_t>(limits.framebufferColorSampleCounts & VK_SAMPLE_COUNT_8_BIT ? 20 : 0);
+
+        // shading and pipeline resources
+        score += std::min<uint64_t>(limits.maxPerStageDescriptorSampledImages / 8, 32u);
+        score += std::min<uint64_t>(limits.maxPerStageDescriptorUniformBuffers / 4, 32u);
+        score += std::min<uint64_t>(limits.maxFragmentCombinedOutputResources / 4, 32u);
+        score += std::min<uint64_t>(limits.maxPushConstantsSize / 32, 16u);
+        score += std::min<uint64_t>(limits.maxBoundDescriptorSets * 2, 16u);
+        physicalDeviceInfo.mCapabilityScore = score;
+
+        physicalDeviceInfo.mScore = physicalDeviceInfo.mPerformanceScore + physicalDeviceInfo.mCapabilityScore;
+    }
+
+    bool VulkanDevice::isDeviceExtensionAvailable(const char* extensionName) const noexcept
+    {
+        // query the extensions of the selected physical device
+        uint32_t extensionCount = 0;
+        if (vkEnumerateDeviceExtensionProperties(m_vkPhysicalDevice, nullptr, &extensionCount, nullptr) != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        std::vector<VkExtensionProperties> extensionProperties(extensionCount);
+        if (vkEnumerateDeviceExtensionProperties(m_vkPhysicalDevice, nullptr, &extensionCount, extensionProperties.data()) != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        return std::any_of(extensionProperties.begin(), extensionProperties.end(), [extensionName](const VkExtensionProperties& extension)
+        {
+            return std::strcmp(extension.extensionName, extensionName) == 0;
+        });
+    }
+
+    void VulkanDevice::logPhysicalDeviceInfo(const PhysicalDeviceInfo& physicalDeviceInfo) const noexcept
+    {
+        const auto& properties = physicalDeviceInfo.mVkPhysicalDeviceProperties;
+        const auto& indices = physicalDeviceInfo.mQueueFamilyIndices;
+
+        // log every enumerated device, for choosing one through KEPLAR_DEVICE
+        constexpr double kMiB = 1024.0 * 1024.0;
+        VK_LOG_INFO("─────────────── Vulkan Physical Devices ───────────────────────");
+        for (const auto& candidate : m_physicalDeviceCandidates)
+        {
+            if (candidate.mIsSuitable)
+            {
+                VK_LOG_INFO("[%u] %s (%s, %.0f MiB) : performance %llu, capability %llu", candidate.mIndex, candidate.mName.c_str(), 
+                            string_VkPhysicalDeviceType(candidate.mType), candidate.mDeviceLocalBytes / kMiB, 
+                            static_cast<unsigned long long>(candidate.mPerformanceScore), static_cast<unsigned long long>(candidate.mCapabilityScore));
+            }
+            else
+            {
+                VK_LOG_INFO("[%u] %s (%s, %.0f MiB) : unavailable", candidate.mIndex, candidate.mName.c_str(), 
+                            string_VkPhysicalDeviceType(candidate.mType), candidate.mDeviceLocalBytes / kMiB);
+            }
+        }
+
+        // log details of the selected physical device.
+        VK_LOG_INFO("─────────────── Selected Vulkan Physical Device ───────────────");
+        VK_LOG_INFO("Device Name           : %s", properties.deviceName);
+        VK_LOG_INFO("Device Type           : %s", string_VkPhysicalDeviceType(properties.deviceType));
+        VK_LOG_INFO("API Version           : %u.%u.%u",
+                    VK_VERSION_MAJOR(properties.apiVersion),
+                    VK_VERSION_MINOR(properties.apiVersion),
+                    VK_VERSION_PATCH(properties.apiVersion));
+        VK_LOG_INFO("Driver Version        : %u", properties.driverVersion);
+        VK_LOG_INFO("Vendor ID             : 0x%X", properties.vendorID);
+        VK_LOG_INFO("Device ID             : 0x%X", properties.deviceID);
+        VK_LOG_INFO("Score                 : %llu", static_cast<unsigned long long>(physicalDeviceInfo.mScore));
+        VK_LOG_INFO("Headless              : %s", indices.mPresentFamily ? "no" : "yes");
+        VK_LOG_INFO("Graphics Queue Index  : %d", indices.mGraphicsFamily.value_or(-1));
+        VK_LOG_INFO("Present Queue Index   : %d", indices.mPresentFamily.value_or(-1));
+        VK_LOG_INFO("Compute Queue Index   : %d", indices.mComputeFamily.value_or(-1));
+        VK_LOG_INFO("Transfer Queue Index  : %d", indices.mTransferFamily.value_or(-1));
+        VK_LOG_INFO("───────────────────────────────────────────────────────────────");
+
+        // log enabled validation layers
+        for (const auto& extension : m_deviceConfig.mDeviceExtensions)
+        {
+            VK_LOG_INFO("enabled device extension: %s", extension);
+        }
+    }
+
+    void VulkanDevice::validateRequestedFeatures() noexcept
+    {
+        // array of pairs: pointer-to-member + feature name
+        constexpr std::pair<VkBool32 VkPhysicalDeviceFeatures::*, const char*> featureMap[] = 
+        {
+            { &VkPhysicalDeviceFeatures::robustBufferAccess, "robustBufferAccess" },
+            { &VkPhysicalDeviceFeatures::fullDrawIndexUint32, "fullDrawIndexUint32" },
+            { &VkPhysicalDeviceFeatures::imageCubeArray, "imageCubeArray" },
+            { &VkPhysicalDeviceFeatures::independentBlend, "independentBlend" },
+            { &VkPhysicalDeviceFeatures::geometryShader, "geometryShader" },
+            { &VkPhysicalDeviceFeatures::tessellationShader, "tessellationShader" },
+            { &VkPhysicalDeviceFeatures::sampleRateShading, "sampleRateShading" },
+            { &VkPhysicalDeviceFeatures::dualSrcBlend, "dualSrcBlend" },
+            { &VkPhysicalDeviceFeatures::logicOp, "logicOp" },
+            { &VkPhysicalDeviceFeatures::multiDrawIndirect, "multiDrawIndirect" },
+            { &VkPhysicalDeviceFeatures::drawIndirectFirstInstance, "drawIndirectFirstInstance" },
+            { &VkPhysicalDeviceFeatures::depthClamp, "depthClamp" },
+            { &VkPhysicalDeviceFeatures::depthBiasClamp, "depthBiasClamp" },
+            { &VkPhysicalDeviceFeatures::fillModeNonSolid, "fillModeNonSolid" },
+            { &VkPhysicalDeviceFeatures::depthBounds, "depthBounds" },
+            { &VkPhysicalDeviceFeatures::wideLines, "wideLines" },
+            { &VkPhysicalDeviceFeatures::largePoints, "largePoints" },
+            { &VkPhysicalDeviceFeatures::alphaToOne, "alphaToOne" },
+            { &VkPhysicalDeviceFeatures::multiViewport, "multiViewport" },
+            { &VkPhysicalDeviceFeatures::samplerAnisotropy, "samplerAnisotropy" },
+            { &VkPhysicalDeviceFeatures::textureCompressionETC2, "textureCompressionETC2" },
+            { &VkPhysicalDeviceFeatures::textureCompressionASTC_LDR, "textureCompressionASTC_LDR" },
+            { &VkPhysicalDeviceFeatures::textureCompressionBC, "textureCompressionBC" },
+            { &VkPhysicalDeviceFeatures::occlusionQueryPrecise, "occlusionQueryPrecise" },
+            { &VkPhysicalDeviceFeatures::pipelineStatisticsQuery, "pipelineStatisticsQuery" },
+            { &VkPhysicalDeviceFeatures::vertexPipelineStoresAndAtomics, "vertexPipelineStoresAndAtomics" },
+            { &VkPhysicalDeviceFeatures::fragmentStoresAndAtomics, "fragmentStoresAndAtomics" },
+            { &VkPhysicalDeviceFeatures::shaderTessellationAndGeometryPointSize, "shaderTessellationAndGeometryPointSize" },
+            { &VkPhysicalDeviceFeatures::shaderImageGatherExtended, "shaderImageGatherExtended" },
+            { &VkPhysicalDeviceFeatures::shaderStorageImageExtendedFormats, "shaderStorageImageExtendedFormats" },
+            { &VkPhysicalDeviceFeatures::shaderStorageImageMultisample, "shaderStorageImageMultisample" },
+            { &VkPhysicalDeviceFeatures::shaderStorageImageReadWithoutFormat, "shaderStorageImageReadWithoutFormat" },
+            { &VkPhysicalDeviceFeatures::shaderStorageImageWriteWithoutFormat, "shaderStorageImageWriteWithoutFormat" },
+            { &VkPhysicalDeviceFeatures::shaderUniformBufferArrayDynamicIndexing, "shaderUniformBufferArrayDynamicIndexing" },
+            { &VkPhysicalDeviceFeatures::shaderSampledImageArrayDynamicIndexing, "shaderSampledImageArrayDynamicIndexing" },
+            { &VkPhysicalDeviceFeatures::shaderStorageBufferArrayDynamicIndexing, "shaderStorageBufferArrayDynamicIndexing" },
+            { &VkPhysicalDeviceFeatures::shaderStorageImageArrayDynamicIndexing, "shaderStorageImageArrayDynamicIndexing" },
+            { &VkPhysicalDeviceFeatures::shaderClipDistance, "shaderClipDistance" },
+            { &VkPhysicalDeviceFeatures::shaderCullDistance, "shaderCullDistance" },
+            { &VkPhysicalDeviceFeatures::shaderFloat64, "shaderFloat64" },
+            { &VkPhysicalDeviceFeatures::shaderInt64, "shaderInt64" },
+            { &VkPhysicalDeviceFeatures::shaderInt16, "shaderInt16" },
+            { &VkPhysicalDeviceFeatures::shaderResourceResidency, "shaderResourceResidency" },
+            { &VkPhysicalDeviceFeatures::shaderResourceMinLod, "shaderResourceMinLod" },
+            { &VkPhysicalDeviceFeatures::sparseBinding, "sparseBinding" },
+            { &VkPhysicalDeviceFeatures::sparseResidencyBuffer, "sparseResidencyBuffer" },
+            { &VkPhysicalDeviceFeatures::sparseResidencyImage2D, "sparseResidencyImage2D" },
+            { &VkPhysicalDeviceFeatures::sparseResidencyImage3D, "sparseResidencyImage3D" },
+            { &VkPhysicalDeviceFeatures::sparseResidency2Samples, "sparseResidency2Samples" },
+            { &VkPhysicalDeviceFeatures::sparseResidency4Samples, "sparseResidency4Samples" },
+            { &VkPhysicalDeviceFeatures::sparseResidency8Samples, "sparseResidency8Samples" },
+            { &VkPhysicalDeviceFeatures::sparseResidency16Samples, "sparseResidency16Samples" },
+            { &VkPhysicalDeviceFeatures::sparseResidencyAliased, "sparseResidencyAliased" },
+            { &VkPhysicalDeviceFeatures::variableMultisampleRate, "variableMultisampleRate" },
+            { &VkPhysicalDeviceFeatures::inheritedQueries, "inheritedQueries" }
+        };
+
+        // sanitize the requested features
+        const auto& supportedFeatures = m_vkPhysicalDeviceFeatures;
+        auto& requestedFeatures = m_deviceConfig.mRequestedFeatures;
+
+        for (const auto& [memberPtr, name] : featureMap)
+        {
+            VkBool32& requested = requestedFeatures.*memberPtr;
+            VkBool32 supported = supportedFeatures.*memberPtr;
+            if (requested && !supported)
+            {
+                VK_LOG_WARN("requested feature '%s' is not supported", name);
+                requested = VK_FALSE;
+            }
+        }
+
+        // requested feature chain: query the same structs from the device and keep what it reports (vulkan 1.1 query)
+        if (!m_deviceConfig.mRequestedFeatureChain.isEmpty())
+        {
+            if (m_vkPhysicalDeviceProperties.apiVersion < VK_API_VERSION_1_1)
+            {
+                VK_LOG_WARN("requested feature chain needs a vulkan 1.1 device, ignored");
+                m_deviceConfig.mRequestedFeatureChain.clear();
+            }
+            else
+            {
+                VulkanFeatureChain supportedChain = m_deviceConfig.mRequestedFeatureChain.cloneCleared();
+
+                VkPhysicalDeviceFeatures2 features2{};
+                features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                features2.pNext = supportedChain.link();
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+                m_deviceConfig.mRequestedFeatureChain.intersect(supportedChain);
+            }
+        }
+
+        // multiview is core in vulkan 1.1; its struct is only chainable from vulkan 1.2 on
+        if (m_deviceConfig.mRequestMultiview)
+        {
+            VkPhysicalDeviceVulkan11Features vulkan11Features{};
+            vulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+            vulkan11Features.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &vulkan11Features;
+
+            const bool isVulkan12 = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2;
+            if (isVulkan12)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!isVulkan12 || !vulkan11Features.multiview)
+            {
+                VK_LOG_WARN("requested feature 'multiview' is not supported");
+                m_deviceConfig.mRequestMultiview = false;
+            }
+        }
+
+        // vulkan 1.2 features need a 1.2 device and are queried through the features2 chain
+        if (m_deviceConfig.mRequestDrawIndirectCount || m_deviceConfig.mRequestDescriptorIndexing || m_deviceConfig.mRequestTimelineSemaphore || 
+            m_deviceConfig.mRequestBufferDeviceAddress || m_deviceConfig.mRequestShaderFloat16)
+        {
+            VkPhysicalDeviceVulkan12Features vulkan12Features{};
+            vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            vulkan12Features.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &vulkan12Features;
+
+            const bool isVulkan12 = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2;
+            if (isVulkan12)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (m_deviceConfig.mRequestDrawIndirectCount && (!isVulkan12 || !vulkan12Features.drawIndirectCount))
+            {
+                VK_LOG_WARN("requested feature 'drawIndirectCount' is not supported");
+                m_deviceConfig.mRequestDrawIndirectCount = false;
+            }
+
+            // all or nothing: the bindless material path needs every one of these
+            const bool hasDescriptorIndexing = isVulkan12 && vulkan12Features.descriptorIndexing && vulkan12Features.runtimeDescriptorArray && 
+                                               vulkan12Features.descriptorBindingPartiallyBound && vulkan12Features.descriptorBindingVariableDescriptorCount &&
+                                               vulkan12Features.shaderSampledImageArrayNonUniformIndexing;
+            if (m_deviceConfig.mRequestDescriptorIndexing && !hasDescriptorIndexing)
+            {
+                VK_LOG_WARN("requested feature 'descriptorIndexing' is not supported");
+                m_deviceConfig.mRequestDescriptorIndexing = false;
+            }
+
+            if (m_deviceConfig.mRequestTimelineSemaphore && (!isVulkan12 || !vulkan12Features.timelineSemaphore))
+            {
+                VK_LOG_WARN("requested feature 'timelineSemaphore' is not supported");
+                m_deviceConfig.mRequestTimelineSemaphore = false;
+            }
+
+            if (m_deviceConfig.mRequestBufferDeviceAddress && (!isVulkan12 || !vulkan12Features.bufferDeviceAddress))
+            {
+                VK_LOG_WARN("requested feature 'bufferDeviceAddress' is not supported");
+                m_deviceConfig.mRequestBufferDeviceAddress = false;
+            }
+
+            if (m_deviceConfig.mRequestShaderFloat16 && (!isVulkan12 || !vulkan12Features.shaderFloat16))
+            {
+                VK_LOG_WARN("requested feature 'shaderFloat16' is not supported");
+                m_deviceConfig.mRequestShaderFloat16 = false;
+            }
+        }
+
+        // vulkan 1.3 features need a 1.3 device
+        if (m_deviceConfig.mRequestDynamicRendering || m_deviceConfig.mRequestSynchronization2)
+        {
+            VkPhysicalDeviceVulkan13Features vulkan13Features{};
+            vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+            vulkan13Features.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &vulkan13Features;
+
+            const bool isVulkan13 = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_3;
+            if (isVulkan13)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (m_deviceConfig.mRequestDynamicRendering && (!isVulkan13 || !vulkan13Features.dynamicRendering))
+            {
+                VK_LOG_WARN("requested feature 'dynamicRendering' is not supported");
+                m_deviceConfig.mRequestDynamicRendering = false;
+            }
+
+            if (m_deviceConfig.mRequestSynchronization2 && (!isVulkan13 || !vulkan13Features.synchronization2))
+            {
+                VK_LOG_WARN("requested feature 'synchronization2' is not supported");
+                m_deviceConfig.mRequestSynchronization2 = false;
+            }
+        }
+
+        // the extended dynamic state (1 and 2) commands are core in vulkan 1.3 and need no feature bit there
+        if (m_deviceConfig.mRequestExtendedDynamicState && m_vkPhysicalDeviceProperties.apiVersion < VK_API_VERSION_1_3)
+        {
+            VK_LOG_WARN("requested feature 'extendedDynamicState' is not supported");
+            m_deviceConfig.mRequestExtendedDynamicState = false;
+        }
+
+        // present wait is an extension pair: both must be exposed and report their feature before being enabled
+        if (m_deviceConfig.mRequestPresentWait)
+        {
+            const bool hasExtensions = isDeviceExtensionAvailable(VK_KHR_PRESENT_ID_EXTENSION_NAME) && 
+                                       isDeviceExtensionAvailable(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+            VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+            presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+            presentWaitFeatures.pNext = nullptr;
+
+            VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+            presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+            presentIdFeatures.pNext = &presentWaitFeatures;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &presentIdFeatures;
+
+            if (hasExtensions)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!hasExtensions || !presentIdFeatures.presentId || !presentWaitFeatures.presentWait)
+            {
+                VK_LOG_WARN("requested feature 'presentWait' is not supported");
+                m_deviceConfig.mRequestPresentWait = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_KHR_PRESENT_ID_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+            }
+        }
+
+        // swapchain maintenance is a device extension with a feature bit
+        if (m_deviceConfig.mRequestSwapchainMaintenance1)
+        {
+            const bool hasExtension = isDeviceExtensionAvailable(VK_EXT_SWAPCHAIN_MAINTENANCE_1_EXTENSION_NAME);
+
+            VkPhysicalDeviceSwapchainMaintenance1FeaturesEXT swapchainMaintenance1Features{};
+            swapchainMaintenance1Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SWAPCHAIN_MAINTENANCE_1_FEATURES_EXT;
+            swapchainMaintenance1Features.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &swapchainMaintenance1Features;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!hasExtension || !swapchainMaintenance1Features.swapchainMaintenance1)
+            {
+                VK_LOG_WARN("requested feature 'swapchainMaintenance1' is not supported");
+                m_deviceConfig.mRequestSwapchainMaintenance1 = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_SWAPCHAIN_MAINTENANCE_1_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_SWAPCHAIN_MAINTENANCE_1_EXTENSION_NAME);
+            }
+        }
+
+        // exclusive fullscreen has no feature bit; whether a monitor supports it is asked per swapchain creation
+    #if defined(VK_USE_PLATFORM_WIN32_KHR)
+        if (m_deviceConfig.mRequestFullScreenExclusive)
+        {
+            if (isDeviceExtensionAvailable(VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME))
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME);
+            }
+            else
+            {
+                VK_LOG_WARN("requested feature 'fullScreenExclusive' is not supported");
+                m_deviceConfig.mRequestFullScreenExclusive = false;
+            }
+        }
+    #endif
+
+        // memory budget has no feature bit; the query goes through vkGetPhysicalDeviceMemoryProperties2 (vulkan 1.1)
+        if (m_deviceConfig.mRequestMemoryBudget)
+        {
+            if (m_vkPhysicalDeviceProperties.apiVersion < VK_API_VERSION_1_1 || !isDeviceExtensionAvailable(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+            {
+                VK_LOG_WARN("requested extension '%s' is not supported", VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+                m_deviceConfig.mRequestMemoryBudget = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+        }
+
+        // push descriptors have no feature bit (core in vulkan 1.4, the extension is used on every version)
+        if (m_deviceConfig.mRequestPushDescriptor)
+        {
+            if (!isDeviceExtensionAvailable(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+            {
+                VK_LOG_WARN("requested extension '%s' is not supported", VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+                m_deviceConfig.mRequestPushDescriptor = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+            }
+        }
+
+        // mesh shaders: the extension needs spir-v 1.4 (core in vulkan 1.2), and both stages are required
+        if (m_deviceConfig.mRequestMeshShader)
+        {
+            const bool hasExtension = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2 && 
+                                      isDeviceExtensionAvailable(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+
+            VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures{};
+            meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+            meshShaderFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &meshShaderFeatures;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!hasExtension || !meshShaderFeatures.taskShader || !meshShaderFeatures.meshShader)
+            {
+                VK_LOG_WARN("requested feature 'meshShader' is not supported");
+                m_deviceConfig.mRequestMeshShader = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_MESH_SHADER_EXTENSION_NAME);
+            }
+        }
+
+        // fragment shading rate: attachments go through vkCreateRenderPass2 (core in vulkan 1.2); pipeline rates are the
+        // minimum, attachment rates are enabled on top when supported
+        if (m_deviceConfig.mRequestFragmentShadingRate)
+        {
+            const bool hasExtension = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2 && 
+                                      isDeviceExtensionAvailable(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME);
+
+            VkPhysicalDeviceFragmentShadingRateFeaturesKHR fragmentShadingRateFeatures{};
+            fragmentShadingRateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR;
+            fragmentShadingRateFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &fragmentShadingRateFeatures;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!hasExtension || !fragmentShadingRateFeatures.pipelineFragmentShadingRate)
+            {
+                VK_LOG_WARN("requested feature 'pipelineFragmentShadingRate' is not supported");
+                m_deviceConfig.mRequestFragmentShadingRate = false;
+            }
+            else
+            {
+                m_fragmentShadingRateProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_PROPERTIES_KHR;
+                m_fragmentShadingRateProperties.pNext = nullptr;
+
+                VkPhysicalDeviceProperties2 properties2{};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &m_fragmentShadingRateProperties;
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+                m_fragmentShadingRateProperties.pNext = nullptr;
+
+                m_isShadingRateAttachmentEnabled = fragmentShadingRateFeatures.attachmentFragmentShadingRate == VK_TRUE;
+                if (!m_isShadingRateAttachmentEnabled)
+                {
+                    VK_LOG_WARN("requested feature 'attachmentFragmentShadingRate' is not supported, pipeline rates only");
+                }
+
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME);
+            }
+        }
+
+        // graphics pipeline libraries: both extensions and the feature are required, and linking without link time
+        // optimization must be fast, otherwise linked parts gain nothing over monolithic pipelines
+        if (m_deviceConfig.mRequestGraphicsPipelineLibrary)
+        {
+            const bool hasExtension = isDeviceExtensionAvailable(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) && 
+                                      isDeviceExtensionAvailable(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+            VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibraryFeatures{};
+            pipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+            pipelineLibraryFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT pipelineLibraryProperties{};
+            pipelineLibraryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+            pipelineLibraryProperties.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &pipelineLibraryFeatures;
+
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &pipelineLibraryProperties;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+            }
+
+            if (!hasExtension || !pipelineLibraryFeatures.graphicsPipelineLibrary)
+            {
+                VK_LOG_WARN("requested feature 'graphicsPipelineLibrary' is not supported");
+                m_deviceConfig.mRequestGraphicsPipelineLibrary = false;
+            }
+            else if (!pipelineLibraryProperties.graphicsPipelineLibraryFastLinking)
+            {
+                VK_LOG_WARN("requested feature 'graphicsPipelineLibrary' has no fast linking, pipelines stay monolithic");
+                m_deviceConfig.mRequestGraphicsPipelineLibrary = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+            }
+        }
+
+        // shader objects: the extension and its feature on a vulkan 1.3 device, whose extended dynamic state commands
+        // set the state the shaders leave open
+        if (m_deviceConfig.mRequestShaderObject)
+        {
+            const bool hasExtension = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_3 && 
+                                      isDeviceExtensionAvailable(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+
+            VkPhysicalDeviceShaderObjectFeaturesEXT shaderObjectFeatures{};
+            shaderObjectFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT;
+            shaderObjectFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &shaderObjectFeatures;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!hasExtension || !shaderObjectFeatures.shaderObject)
+            {
+                VK_LOG_WARN("requested feature 'shaderObject' is not supported");
+                m_deviceConfig.mRequestShaderObject = false;
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+            }
+        }
+
+        // descriptor buffers: the extension and its feature, on top of buffer device address (set and uniform addresses)
+        if (m_deviceConfig.mRequestDescriptorBuffer)
+        {
+            const bool hasExtension = m_deviceConfig.mRequestBufferDeviceAddress && isDeviceExtensionAvailable(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+
+            VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{};
+            descriptorBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+            descriptorBufferFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &descriptorBufferFeatures;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (!hasExtension || !descriptorBufferFeatures.descriptorBuffer)
+            {
+                VK_LOG_WARN("requested feature 'descriptorBuffer' is not supported");
+                m_deviceConfig.mRequestDescriptorBuffer = false;
+            }
+            else
+            {
+                m_descriptorBufferProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+                m_descriptorBufferProperties.pNext = nullptr;
+
+                VkPhysicalDeviceProperties2 properties2{};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &m_descriptorBufferProperties;
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+                m_descriptorBufferProperties.pNext = nullptr;
+
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+            }
+        }
+
+        // generated commands: the extension and its feature on top of buffer device address, maintenance5 (an extension
+        // before vulkan 1.4, where its feature is required) for indirect-bindable pipelines, and pipeline switches in the
+        // vertex and fragment stages
+        if (m_deviceConfig.mRequestDeviceGeneratedCommands)
+        {
+            const bool isVulkan14 = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_4;
+            const bool hasMaintenance5 = isVulkan14 || isDeviceExtensionAvailable(VK_KHR_MAINTENANCE_5_EXTENSION_NAME);
+            const bool hasExtension = m_deviceConfig.mRequestBufferDeviceAddress && hasMaintenance5 &&
+                                      isDeviceExtensionAvailable(VK_EXT_DEVICE_GENERATED_COMMANDS_EXTENSION_NAME);
+
+            VkPhysicalDeviceDeviceGeneratedCommandsFeaturesEXT generatedCommandsFeatures{};
+            generatedCommandsFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEVICE_GENERATED_COMMANDS_FEATURES_EXT;
+            generatedCommandsFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &generatedCommandsFeatures;
+
+            m_deviceGeneratedCommandsProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEVICE_GENERATED_COMMANDS_PROPERTIES_EXT;
+            m_deviceGeneratedCommandsProperties.pNext = nullptr;
+
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &m_deviceGeneratedCommandsProperties;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+                m_deviceGeneratedCommandsProperties.pNext = nullptr;
+            }
+
+            constexpr VkShaderStageFlags kGraphicsStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+            if (!hasExtension || !generatedCommandsFeatures.deviceGeneratedCommands)
+            {
+                VK_LOG_WARN("requested feature 'deviceGeneratedCommands' is not supported");
+                m_deviceConfig.mRequestDeviceGeneratedCommands = false;
+            }
+            else if (m_deviceGeneratedCommandsProperties.maxIndirectPipelineCount == 0 ||
+                     (m_deviceGeneratedCommandsProperties.supportedIndirectCommandsShaderStagesPipelineBinding & kGraphicsStages) != kGraphicsStages)
+            {
+                VK_LOG_WARN("requested feature 'deviceGeneratedCommands' cannot switch graphics pipelines, batches stay cpu split");
+                m_deviceConfig.mRequestDeviceGeneratedCommands = false;
+            }
+            else
+            {
+                if (!isVulkan14)
+                {
+                    m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_MAINTENANCE_5_EXTENSION_NAME);
+                    VK_LOG_INFO("enabled device extension: %s", VK_KHR_MAINTENANCE_5_EXTENSION_NAME);
+                }
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_DEVICE_GENERATED_COMMANDS_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_DEVICE_GENERATED_COMMANDS_EXTENSION_NAME);
+            }
+
+            if (!m_deviceConfig.mRequestDeviceGeneratedCommands)
+            {
+                m_deviceGeneratedCommandsProperties = VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT{};
+            }
+        }
+
+        // multi-draw: the extension and its feature, draw parameters (core in vulkan 1.1) and room for more than one draw
+        if (m_deviceConfig.mRequestMultiDraw)
+        {
+            const bool hasExtension = isDeviceExtensionAvailable(VK_EXT_MULTI_DRAW_EXTENSION_NAME);
+
+            VkPhysicalDeviceShaderDrawParametersFeatures drawParametersFeatures{};
+            drawParametersFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES;
+            drawParametersFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceMultiDrawFeaturesEXT multiDrawFeatures{};
+            multiDrawFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
+            multiDrawFeatures.pNext = &drawParametersFeatures;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &multiDrawFeatures;
+
+            m_multiDrawProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_PROPERTIES_EXT;
+            m_multiDrawProperties.pNext = nullptr;
+
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &m_multiDrawProperties;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+                m_multiDrawProperties.pNext = nullptr;
+            }
+
+            if (!hasExtension || !multiDrawFeatures.multiDraw || !drawParametersFeatures.shaderDrawParameters ||
+                m_multiDrawProperties.maxMultiDrawCount < 2)
+            {
+                VK_LOG_WARN("requested feature 'multiDraw' is not supported");
+                m_deviceConfig.mRequestMultiDraw = false;
+                m_multiDrawProperties = VkPhysicalDeviceMultiDrawPropertiesEXT{};
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_EXT_MULTI_DRAW_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_EXT_MULTI_DRAW_EXTENSION_NAME);
+            }
+        }
+
+        // ray query: acceleration structures (with the deferred host operations extension they depend on) on top of
+        // buffer device address, and the ray query extension and feature
+        if (m_deviceConfig.mRequestRayQuery)
+        {
+            const bool hasExtension = m_deviceConfig.mRequestBufferDeviceAddress &&
+                                      isDeviceExtensionAvailable(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME) &&
+                                      isDeviceExtensionAvailable(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) &&
+                                      isDeviceExtensionAvailable(VK_KHR_RAY_QUERY_EXTENSION_NAME);
+
+            VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures{};
+            rayQueryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR;
+            rayQueryFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures{};
+            accelerationStructureFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+            accelerationStructureFeatures.pNext = &rayQueryFeatures;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &accelerationStructureFeatures;
+
+            m_accelerationStructureProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+            m_accelerationStructureProperties.pNext = nullptr;
+
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &m_accelerationStructureProperties;
+
+            if (hasExtension)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+                m_accelerationStructureProperties.pNext = nullptr;
+            }
+
+            if (!hasExtension || !accelerationStructureFeatures.accelerationStructure || !rayQueryFeatures.rayQuery)
+            {
+                VK_LOG_WARN("requested feature 'rayQuery' is not supported");
+                m_deviceConfig.mRequestRayQuery = false;
+                m_accelerationStructureProperties = VkPhysicalDeviceAccelerationStructurePropertiesKHR{};
+            }
+            else
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_KHR_RAY_QUERY_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extensions: %s, %s, %s", VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
+                            VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME, VK_KHR_RAY_QUERY_EXTENSION_NAME);
+            }
+        }
+
+        // host image copy: the vulkan 1.4 feature, and shader-read-only among the layouts host copies may write, so
+        // textures go from undefined to sampled with one host transition
+        if (m_deviceConfig.mRequestHostImageCopy)
+        {
+            const bool isVulkan14 = m_vkPhysicalDeviceProperties.apiVersion >= VK_API_VERSION_1_4;
+
+            VkPhysicalDeviceVulkan14Features vulkan14Features{};
+            vulkan14Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_4_FEATURES;
+            vulkan14Features.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &vulkan14Features;
+
+            // the layout list is queried once for its length and once for its contents
+            std::vector<VkImageLayout> copyDstLayouts;
+            VkPhysicalDeviceHostImageCopyProperties hostImageCopyProperties{};
+            hostImageCopyProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES;
+            hostImageCopyProperties.pNext = nullptr;
+
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &hostImageCopyProperties;
+
+            if (isVulkan14)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+                copyDstLayouts.resize(hostImageCopyProperties.copyDstLayoutCount);
+                hostImageCopyProperties.pCopySrcLayouts = nullptr;
+                hostImageCopyProperties.copySrcLayoutCount = 0;
+                hostImageCopyProperties.pCopyDstLayouts = copyDstLayouts.data();
+                vkGetPhysicalDeviceProperties2(m_vkPhysicalDevice, &properties2);
+            }
+
+            const bool hasShaderReadLayout = std::find(copyDstLayouts.begin(), copyDstLayouts.end(), 
+                                                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) != copyDstLayouts.end();
+            if (!isVulkan14 || !vulkan14Features.hostImageCopy)
+            {
+                VK_LOG_WARN("requested feature 'hostImageCopy' is not supported");
+                m_deviceConfig.mRequestHostImageCopy = false;
+            }
+            else if (!hasShaderReadLayout)
+            {
+                VK_LOG_WARN("requested feature 'hostImageCopy' cannot write shader-read-only images, textures keep staging");
+                m_deviceConfig.mRequestHostImageCopy = false;
+            }
+        }
+
+        // low latency: latency sleep keys its markers by present id and signals a timeline semaphore, so it needs both
+        // enabled above; anti-lag has a feature bit and no dependencies
+        if (m_deviceConfig.mRequestLowLatency)
+        {
+            m_isLatencySleepEnabled = m_deviceConfig.mRequestPresentWait && m_deviceConfig.mRequestTimelineSemaphore &&
+                                      isDeviceExtensionAvailable(VK_NV_LOW_LATENCY_2_EXTENSION_NAME);
+
+            VkPhysicalDeviceAntiLagFeaturesAMD antiLagFeatures{};
+            antiLagFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ANTI_LAG_FEATURES_AMD;
+            antiLagFeatures.pNext = nullptr;
+
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &antiLagFeatures;
+
+            const bool hasAntiLag = !m_isLatencySleepEnabled && isDeviceExtensionAvailable(VK_AMD_ANTI_LAG_EXTENSION_NAME);
+            if (hasAntiLag)
+            {
+                vkGetPhysicalDeviceFeatures2(m_vkPhysicalDevice, &features2);
+            }
+
+            if (m_isLatencySleepEnabled)
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_NV_LOW_LATENCY_2_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_NV_LOW_LATENCY_2_EXTENSION_NAME);
+            }
+            else if (hasAntiLag && antiLagFeatures.antiLag)
+            {
+                m_deviceConfig.mDeviceExtensions.emplace_back(VK_AMD_ANTI_LAG_EXTENSION_NAME);
+                VK_LOG_INFO("enabled device extension: %s", VK_AMD_ANTI_LAG_EXTENSION_NAME);
+            }
+            else
+            {
+                VK_LOG_WARN("requested feature 'lowLatency' is not supported");
+                m_deviceConfig.mRequestLowLatency = false;
             }
         }
     }
@@ -4,12 +4,20 @@
 
 #pragma once 
 
+#include <array>
 #include <memory>
+#include <string>
 #include <vector>
 #include <optional>
 
 #include "vulkan_config.hpp"
+#include "vulkan_feature_chain.hpp"
 #include "vulkan_surface.hpp"
+#include "vulkan_memory_allocator.hpp"
+#include "vulkan_pipeline_cache.hpp"
+#include "vulkan_descriptor_set_layout_cache.hpp"
+#include "vulkan_sampler_cache.hpp"
+#include "vulkan_shader_cache.hpp"
 
 namespace keplar
 {
@@ -18,8 +26,33 @@ namespace keplar
     {
         std::vector<const char*> mDeviceExtensions;
         VkPhysicalDeviceFeatures mRequestedFeatures;
+        VulkanFeatureChain mRequestedFeatureChain;
         bool mPreferDedicatedComputeQueue = false;
         bool mPreferDedicatedTransferQueue = false;
+        bool mRequestDrawIndirectCount = false;
+        bool mRequestDescriptorIndexing = false;
+        bool mRequestTimelineSemaphore = false;
+        bool mRequestBufferDeviceAddress = false;
+        bool mRequestShaderFloat16 = false;
+        bool mRequestMultiview = false;
+        bool mRequestDynamicRendering = false;
+        bool mRequestSynchronization2 = false;
+        bool mRequestExtendedDynamicState = false;
+        bool mRequestPresentWait = false;
+        bool mRequestSwapchainMaintenance1 = false;
+        bool mRequestMemoryBudget = false;
+        bool mRequestPushDescriptor = false;
+        bool mRequestMeshShader = false;
+        bool mRequestFragmentShadingRate = false;
+        bool mRequestGraphicsPipelineLibrary = false;
+        bool mRequestShaderObject = false;
+        bool mRequestHostImageCopy = false;
+        bool mRequestDescriptorBuffer = false;
+        bool mRequestDeviceGeneratedCommands = false;
+        bool mRequestMultiDraw = false;
+        bool mRequestRayQuery = false;
+        bool mRequestLowLatency = false;
+        bool mRequestFullScreenExclusive = false;
 
         inline void setDeviceExtensions(const std::vector<std::string_view>& extensions)
         {
@@ -42,6 +75,19 @@ namespace keplar
         inline bool isComplete() const { return (mGraphicsFamily && mPresentFamily); }
     };
 
+    // enumerated gpu as seen by device selection; scores only rank suitable devices against each other
+    struct PhysicalDeviceCandidate
+    {
+        std::string mName;
+        uint32_t mIndex = 0;                    // vkEnumeratePhysicalDevices order, as KEPLAR_DEVICE takes it
+        VkPhysicalDeviceType mType = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+        uint32_t mApiVersion = 0;
+        uint64_t mDeviceLocalBytes = 0;
+        uint64_t mPerformanceScore = 0;         // device type and device local memory
+        uint64_t mCapabilityScore = 0;          // api version, limits and sample counts
+        bool mIsSuitable = false;               // required extensions and queue families present
+    };
+
     class VulkanDevice final
     {
         public:
@@ -49,6 +95,11 @@ namespace keplar
             static std::shared_ptr<VulkanDevice> create(const VulkanInstance& instance, 
                                                         const VulkanSurface& surface, 
                                                         const VulkanContextConfig& config) noexcept;
+
+            // headless device on a gpu other than primary's (no present queue or swapchain extension); null when there is none
+            static std::shared_ptr<VulkanDevice> createSecondary(const VulkanInstance& instance, 
+                                                                 const VulkanContextConfig& config, 
+                                                                 const VulkanDevice& primary) noexcept;
             ~VulkanDevice();
 
             // disable copy and move semantics to enforce unique ownership
@@ -65,31 +116,138 @@ namespace keplar
             VkQueue getPresentQueue() const noexcept;
             VkQueue getComputeQueue() const noexcept;
             VkQueue getTransferQueue() const noexcept;
+            bool isHeadless() const noexcept;
+
+            // every enumerated gpu with its scores, and the index of the selected one among them
+            const std::vector<PhysicalDeviceCandidate>& getPhysicalDeviceCandidates() const noexcept;
+            uint32_t getPhysicalDeviceIndex() const noexcept;
 
             // physical device information
             const VkPhysicalDeviceProperties& getPhysicalDeviceProperties() const noexcept;
             const VkPhysicalDeviceFeatures& getPhysicalDeviceFeatures() const noexcept;
             const VkPhysicalDeviceFeatures& getEnabledFeatures() const noexcept;
+
+            // every pNext feature struct the device was created with: the validated config chain plus the features behind
+            // the mRequest* flags, e.g. getEnabledFeatureChain().find<VkPhysicalDeviceVulkan12Features>(sType)
+            const VulkanFeatureChain& getEnabledFeatureChain() const noexcept;
             const VkPhysicalDeviceMemoryProperties& getPhysicalDeviceMemoryProperties() const noexcept;
             bool isExtensionEnabled(const char* extensionName) const noexcept;
+            bool isDrawIndirectCountEnabled() const noexcept;
+            bool isDescriptorIndexingEnabled() const noexcept;
+            bool isTimelineSemaphoreEnabled() const noexcept;
+            // memory blocks are then allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT, so any buffer created with
+            // VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT has a valid VulkanBuffer::getDeviceAddress
+            bool isBufferDeviceAddressEnabled() const noexcept;
+            bool isShaderFloat16Enabled() const noexcept;
+            // VulkanRenderPass view masks, GraphicsPipelineConfig::mViewMask and shaders reading gl_ViewIndex may then be used
+            bool isMultiviewEnabled() const noexcept;
+            bool isDynamicRenderingEnabled() const noexcept;
+            // VulkanBarrierBatch (and every transition helper built on it) then records through vkCmdPipelineBarrier2
+            bool isSynchronization2Enabled() const noexcept;
+            // GraphicsPipelineConfig::mExtendedDynamicStates and the VulkanCommandBuffer state setters may then be used
+            bool isExtendedDynamicStateEnabled() const noexcept;
+            bool isPresentWaitEnabled() const noexcept;
+            bool isSwapchainMaintenance1Enabled() const noexcept;
+            bool isMemoryBudgetEnabled() const noexcept;
+            // VulkanCommandBuffer::pushDescriptorSet is then loaded, for layouts created with
+            // VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR
+            bool isPushDescriptorEnabled() const noexcept;
+            bool isMeshShaderEnabled() const noexcept;
+            bool isFragmentShadingRateEnabled() const noexcept;
+            bool isShadingRateAttachmentEnabled() const noexcept;
+            // VulkanPipeline::initializeLibrary/initializeLinked may then be used (VulkanPipelineLibrary does so itself)
+            bool isGraphicsPipelineLibraryEnabled() const noexcept;
+            // VulkanPipeline::initializeShaderObjects may then be used; the shader cache retains the spir-v it needs
+            bool isShaderObjectEnabled() const noexcept;
+
+            // host image copy: isHostImageCopySupported tells whether images of the format and usage (plus
+            // VK_IMAGE_USAGE_HOST_TRANSFER_BIT) take host copies without losing optimal device access; the image is
+            // then transitioned and written from the cpu, on any thread (each image externally synchronized)
+            bool isHostImageCopyEnabled() const noexcept;
+            bool isHostImageCopySupported(VkFormat format, VkImageUsageFlags usage) const noexcept;
+            bool transitionImageLayoutOnHost(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, 
+                                             const VkImageSubresourceRange& subresourceRange) const noexcept;
+            bool copyMemoryToImage(VkImage image, VkImageLayout layout, uint32_t regionCount, const VkMemoryToImageCopy* regions) const noexcept;
+
+            // sparse residency: sparseBinding and sparseResidencyImage2D are enabled, the graphics queue takes
+            // vkQueueBindSparse, and single-sampled 2d images of the format and usage may be partially resident
+            bool isSparseResidencySupported(VkFormat format, VkImageUsageFlags usage) const noexcept;
+
+            // VulkanDescriptorBuffer may then be used, for layouts and pipelines created with the descriptor buffer flags
+            bool isDescriptorBufferEnabled() const noexcept;
+            // VulkanIndirectCommands may then be used, with pipelines created with GraphicsPipelineConfig::mIndirectBindable
+            bool isDeviceGeneratedCommandsEnabled() const noexcept;
+            // VulkanCommandRecorder::drawMultiIndexed may then be used, by shaders built with gl_DrawID
+            bool isMultiDrawEnabled() const noexcept;
+            // VulkanAccelerationStructure may then be built, and traced by shaders built with GL_EXT_ray_query
+            bool isRayQueryEnabled() const noexcept;
+
+            // low latency through VK_NV_low_latency2 (latency sleep and markers) or, without it, VK_AMD_anti_lag
+            bool isLowLatencyEnabled() const noexcept;
+            bool isLatencySleepEnabled() const noexcept;
+
+            // VulkanSwapchainPolicy::mFullScreenExclusive may then take effect (win32 only)
+            bool isFullScreenExclusiveEnabled() const noexcept;
+
+            // attachment texel sizes and combiner support; zeroed unless fragment shading rate is enabled
+            const VkPhysicalDeviceFragmentShadingRatePropertiesKHR& getFragmentShadingRateProperties() const noexcept;
+
+            // descriptor sizes and buffer alignments; zeroed unless descriptor buffers are enabled
+            const VkPhysicalDeviceDescriptorBufferPropertiesEXT& getDescriptorBufferProperties() const noexcept;
+
+            // pipeline and sequence limits and the stages generated commands bind; zeroed unless they are enabled
+            const VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT& getDeviceGeneratedCommandsProperties() const noexcept;
+
+            // draws one multi-draw call may carry; zeroed unless multi-draw is enabled
+            const VkPhysicalDeviceMultiDrawPropertiesEXT& getMultiDrawProperties() const noexcept;
+
+            // scratch alignment and geometry, instance and primitive limits; zeroed unless ray query is enabled
+            const VkPhysicalDeviceAccelerationStructurePropertiesKHR& getAccelerationStructureProperties() const noexcept;
+
+            // current device-local budget; cheap enough to poll once per frame
+            MemoryBudget queryMemoryBudget() const noexcept;
+
+            // the same per memory heap, indexed like VkPhysicalDeviceMemoryProperties::memoryHeaps; the array overload
+            // fills caller storage without allocating and returns the heap count
+            std::vector<MemoryBudget> queryMemoryHeapBudgets() const noexcept;
+            uint32_t queryMemoryHeapBudgets(std::array<MemoryBudget, VK_MAX_MEMORY_HEAPS>& heapBudgets) const noexcept;
+
+            // device memory sub-allocator shared by all resources of this device
+            VulkanMemoryAllocator& getMemoryAllocator() const noexcept;
+
+            // persistent pipeline cache shared by all pipelines of this device
+            VulkanPipelineCache& getPipelineCache() const noexcept;
+
+            // descriptor set layouts deduplicated across all pipelines of this device
+            VulkanDescriptorSetLayoutCache& getDescriptorSetLayoutCache() const noexcept;
+
+            // immutable samplers deduplicated by create info across all resources of this device
+            VulkanSamplerCache& getSamplerCache() const noexcept;
+
+            // shader modules deduplicated by spir-v contents, with the hot reload watcher
+            VulkanShaderCache& getShaderCache() const noexcept;
 
             // query properties
             std::optional<uint32_t> findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags propertyFlags) const noexcept;
+            bool isFormatSupported(VkFormat format, VkFormatFeatureFlags featureFlags) const noexcept;
 
         private:
             struct PhysicalDeviceInfo;
 
             // construction helpers
             VulkanDevice() noexcept;
-            bool initialize(const VulkanInstance& instance, const VulkanSurface& surface, const VulkanContextConfig& config) noexcept;
-            bool selectPhysicalDevice(const VulkanSurface& surface) noexcept;
+            bool initialize(const VulkanInstance& instance, const VulkanSurface* surface, const VulkanContextConfig& config, 
+                            const VulkanDevice* primary) noexcept;
+            bool selectPhysicalDevice(const VulkanSurface* surface, VkPhysicalDevice excludedDevice, 
+                                      std::optional<uint32_t> overrideIndex, std::string_view overrideName) noexcept;
             bool createLogicalDevice() noexcept;
             bool getDeviceQueues() noexcept;
             void validateRequestedFeatures() noexcept;
          
             bool checkDeviceExtensionSupport(VkPhysicalDevice device) const noexcept;
-            QueueFamilyIndices findRequiredQueueFamilies(VkPhysicalDevice device, const VulkanSurface& surface) const noexcept;
-            uint64_t scoreDevice(const PhysicalDeviceInfo& physicalDeviceInfo) const noexcept;
+            bool isDeviceExtensionAvailable(const char* extensionName) const noexcept;
+            QueueFamilyIndices findRequiredQueueFamilies(VkPhysicalDevice device, const VulkanSurface* surface) const noexcept;
+            void scoreDevice(PhysicalDeviceInfo& physicalDeviceInfo) const noexcept;
             void logPhysicalDeviceInfo(const PhysicalDeviceInfo& physicalDeviceInfo) const noexcept;
 
         private:
@@ -105,10 +263,41 @@ namespace keplar
             VkQueue m_transferQueue;
             QueueFamilyIndices m_queueFamilyIndices;
 
+            // device selection
+            std::vector<PhysicalDeviceCandidate> m_physicalDeviceCandidates;
+            uint32_t m_physicalDeviceIndex;
+
             // device properties and features
             VkPhysicalDeviceProperties m_vkPhysicalDeviceProperties;
             VkPhysicalDeviceFeatures m_vkPhysicalDeviceFeatures;
             VkPhysicalDeviceMemoryProperties m_vkPhysicalDeviceMemoryProperties;
+            VkPhysicalDeviceFragmentShadingRatePropertiesKHR m_fragmentShadingRateProperties;
+            VkPhysicalDeviceDescriptorBufferPropertiesEXT m_descriptorBufferProperties;
+            VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT m_deviceGeneratedCommandsProperties;
+            VkPhysicalDeviceMultiDrawPropertiesEXT m_multiDrawProperties;
+            VkPhysicalDeviceAccelerationStructurePropertiesKHR m_accelerationStructureProperties;
+            bool m_isShadingRateAttachmentEnabled;
+            bool m_isLatencySleepEnabled;
+
+            // host image copy commands (core in vulkan 1.4), loaded when the feature is enabled
+            PFN_vkTransitionImageLayout m_vkTransitionImageLayout;
+            PFN_vkCopyMemoryToImage m_vkCopyMemoryToImage;
+
             VulkanDeviceConfig m_deviceConfig;
+
+            // device memory allocator
+            std::unique_ptr<VulkanMemoryAllocator> m_memoryAllocator;
+
+            // device pipeline cache (written back to disk on destruction)
+            std::unique_ptr<VulkanPipelineCache> m_pipelineCache;
+
+            // shared descriptor set layouts (owned here, destroyed with the device)
+            std::unique_ptr<VulkanDescriptorSetLayoutCache> m_descriptorSetLayoutCache;
+
+            // shared samplers (owned here, destroyed with the device)
+            std::unique_ptr<VulkanSamplerCache> m_samplerCache;
+
+            // shared shader modules
+            std::unique_ptr<VulkanShaderCache> m_shaderCache;
     };
 }   // namespace keplar
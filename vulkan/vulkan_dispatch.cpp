@@ -0,0 +1,78 @@
+// ────────────────────────────────────────────
+//  File: vulkan_dispatch.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_dispatch.hpp"
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    // replaces the loader export with the driver's entry point when the device returns one
+    template <typename PFN>
+    uint32_t loadCommand(VkDevice vkDevice, const char* name, PFN& command) noexcept
+    {
+        const PFN deviceCommand = reinterpret_cast<PFN>(vkGetDeviceProcAddr(vkDevice, name));
+        if (deviceCommand == nullptr)
+        {
+            return 0;
+        }
+
+        command = deviceCommand;
+        return 1;
+    }
+}
+
+namespace keplar
+{
+    void VulkanDispatch::load(VkDevice vkDevice) noexcept
+    {
+        VulkanDeviceDispatch& table = s_device;
+        table = VulkanDeviceDispatch{};
+
+        uint32_t loadedCount = 0;
+        loadedCount += loadCommand(vkDevice, "vkBeginCommandBuffer", table.mBeginCommandBuffer);
+        loadedCount += loadCommand(vkDevice, "vkEndCommandBuffer", table.mEndCommandBuffer);
+        loadedCount += loadCommand(vkDevice, "vkResetCommandBuffer", table.mResetCommandBuffer);
+        loadedCount += loadCommand(vkDevice, "vkCmdExecuteCommands", table.mCmdExecuteCommands);
+
+        loadedCount += loadCommand(vkDevice, "vkCmdBeginRenderPass", table.mCmdBeginRenderPass);
+        loadedCount += loadCommand(vkDevice, "vkCmdEndRenderPass", table.mCmdEndRenderPass);
+        loadedCount += loadCommand(vkDevice, "vkCmdBeginRendering", table.mCmdBeginRendering);
+        loadedCount += loadCommand(vkDevice, "vkCmdEndRendering", table.mCmdEndRendering);
+
+        loadedCount += loadCommand(vkDevice, "vkCmdBindPipeline", table.mCmdBindPipeline);
+        loadedCount += loadCommand(vkDevice, "vkCmdBindDescriptorSets", table.mCmdBindDescriptorSets);
+        loadedCount += loadCommand(vkDevice, "vkCmdBindVertexBuffers", table.mCmdBindVertexBuffers);
+        loadedCount += loadCommand(vkDevice, "vkCmdBindIndexBuffer", table.mCmdBindIndexBuffer);
+        loadedCount += loadCommand(vkDevice, "vkCmdPushConstants", table.mCmdPushConstants);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetViewport", table.mCmdSetViewport);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetScissor", table.mCmdSetScissor);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetCullMode", table.mCmdSetCullMode);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetFrontFace", table.mCmdSetFrontFace);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetPrimitiveTopology", table.mCmdSetPrimitiveTopology);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetDepthTestEnable", table.mCmdSetDepthTestEnable);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetDepthWriteEnable", table.mCmdSetDepthWriteEnable);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetDepthCompareOp", table.mCmdSetDepthCompareOp);
+        loadedCount += loadCommand(vkDevice, "vkCmdSetDepthBiasEnable", table.mCmdSetDepthBiasEnable);
+
+        loadedCount += loadCommand(vkDevice, "vkCmdDraw", table.mCmdDraw);
+        loadedCount += loadCommand(vkDevice, "vkCmdDrawIndexed", table.mCmdDrawIndexed);
+        loadedCount += loadCommand(vkDevice, "vkCmdDrawIndexedIndirect", table.mCmdDrawIndexedIndirect);
+        loadedCount += loadCommand(vkDevice, "vkCmdDrawIndexedIndirectCount", table.mCmdDrawIndexedIndirectCount);
+        loadedCount += loadCommand(vkDevice, "vkCmdDispatch", table.mCmdDispatch);
+
+        loadedCount += loadCommand(vkDevice, "vkCmdCopyBuffer", table.mCmdCopyBuffer);
+        loadedCount += loadCommand(vkDevice, "vkCmdCopyBufferToImage", table.mCmdCopyBufferToImage);
+        loadedCount += loadCommand(vkDevice, "vkCmdCopyImageToBuffer", table.mCmdCopyImageToBuffer);
+
+        s_isLoaded = true;
+        VK_LOG_DEBUG("VulkanDispatch::load : %u device commands bypass the loader", loadedCount);
+    }
+
+    void VulkanDispatch::reset() noexcept
+    {
+        s_device = VulkanDeviceDispatch{};
+        s_isLoaded = false;
+    }
+}   // namespace keplar
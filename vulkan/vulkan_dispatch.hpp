@@ -0,0 +1,75 @@
+// ────────────────────────────────────────────
+//  File: vulkan_dispatch.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // device-level commands of the recording hot paths, fetched through vkGetDeviceProcAddr so a call jumps straight into
+    // the driver instead of through the loader's trampoline. every entry starts out as the loader export, so the table
+    // works before load() and keeps the export for any command the driver does not return
+    struct VulkanDeviceDispatch
+    {
+        // command buffer lifetime
+        PFN_vkBeginCommandBuffer            mBeginCommandBuffer         = vkBeginCommandBuffer;
+        PFN_vkEndCommandBuffer              mEndCommandBuffer           = vkEndCommandBuffer;
+        PFN_vkResetCommandBuffer            mResetCommandBuffer         = vkResetCommandBuffer;
+        PFN_vkCmdExecuteCommands            mCmdExecuteCommands         = vkCmdExecuteCommands;
+
+        // passes
+        PFN_vkCmdBeginRenderPass            mCmdBeginRenderPass         = vkCmdBeginRenderPass;
+        PFN_vkCmdEndRenderPass              mCmdEndRenderPass           = vkCmdEndRenderPass;
+        PFN_vkCmdBeginRendering             mCmdBeginRendering          = vkCmdBeginRendering;
+        PFN_vkCmdEndRendering               mCmdEndRendering            = vkCmdEndRendering;
+
+        // bindings and state
+        PFN_vkCmdBindPipeline               mCmdBindPipeline            = vkCmdBindPipeline;
+        PFN_vkCmdBindDescriptorSets         mCmdBindDescriptorSets      = vkCmdBindDescriptorSets;
+        PFN_vkCmdBindVertexBuffers          mCmdBindVertexBuffers       = vkCmdBindVertexBuffers;
+        PFN_vkCmdBindIndexBuffer            mCmdBindIndexBuffer         = vkCmdBindIndexBuffer;
+        PFN_vkCmdPushConstants              mCmdPushConstants           = vkCmdPushConstants;
+        PFN_vkCmdSetViewport                mCmdSetViewport             = vkCmdSetViewport;
+        PFN_vkCmdSetScissor                 mCmdSetScissor              = vkCmdSetScissor;
+        PFN_vkCmdSetCullMode                mCmdSetCullMode             = vkCmdSetCullMode;
+        PFN_vkCmdSetFrontFace               mCmdSetFrontFace            = vkCmdSetFrontFace;
+        PFN_vkCmdSetPrimitiveTopology       mCmdSetPrimitiveTopology    = vkCmdSetPrimitiveTopology;
+        PFN_vkCmdSetDepthTestEnable         mCmdSetDepthTestEnable      = vkCmdSetDepthTestEnable;
+        PFN_vkCmdSetDepthWriteEnable        mCmdSetDepthWriteEnable     = vkCmdSetDepthWriteEnable;
+        PFN_vkCmdSetDepthCompareOp          mCmdSetDepthCompareOp       = vkCmdSetDepthCompareOp;
+        PFN_vkCmdSetDepthBiasEnable         mCmdSetDepthBiasEnable      = vkCmdSetDepthBiasEnable;
+
+        // draws and dispatches
+        PFN_vkCmdDraw                       mCmdDraw                    = vkCmdDraw;
+        PFN_vkCmdDrawIndexed                mCmdDrawIndexed             = vkCmdDrawIndexed;
+        PFN_vkCmdDrawIndexedIndirect        mCmdDrawIndexedIndirect     = vkCmdDrawIndexedIndirect;
+        PFN_vkCmdDrawIndexedIndirectCount   mCmdDrawIndexedIndirectCount = vkCmdDrawIndexedIndirectCount;
+        PFN_vkCmdDispatch                   mCmdDispatch                = vkCmdDispatch;
+
+        // transfers
+        PFN_vkCmdCopyBuffer                 mCmdCopyBuffer              = vkCmdCopyBuffer;
+        PFN_vkCmdCopyBufferToImage          mCmdCopyBufferToImage       = vkCmdCopyBufferToImage;
+        PFN_vkCmdCopyImageToBuffer          mCmdCopyImageToBuffer       = vkCmdCopyImageToBuffer;
+    };
+
+    // the table every command buffer records through. the primary device loads it from itself; a secondary device sets it
+    // back to the loader exports, which dispatch on the command buffer's own device (device-level pointers are only valid
+    // for the device they were fetched from)
+    class VulkanDispatch final
+    {
+        public:
+            // usage
+            static void load(VkDevice vkDevice) noexcept;
+            static void reset() noexcept;
+
+            // accessors
+            static const VulkanDeviceDispatch& device() noexcept    { return s_device; }
+            static bool isLoaded() noexcept                         { return s_isLoaded; }
+
+        private:
+            inline static VulkanDeviceDispatch  s_device{};
+            inline static bool                  s_isLoaded = false;
+    };
+}   // namespace keplar
@@ -0,0 +1,76 @@
+// ────────────────────────────────────────────
+//  File: vulkan_feature_chain.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_feature_chain.hpp"
+
+#include <algorithm>
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    void* VulkanFeatureChain::link() noexcept
+    {
+        void* next = nullptr;
+        for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it)
+        {
+            auto* header = reinterpret_cast<VkBaseOutStructure*>(it->mStorage.data());
+            header->pNext = static_cast<VkBaseOutStructure*>(next);
+            next = header;
+        }
+        return next;
+    }
+
+    VulkanFeatureChain VulkanFeatureChain::cloneCleared() const noexcept
+    {
+        VulkanFeatureChain cleared;
+        cleared.m_entries.reserve(m_entries.size());
+        for (const auto& entry : m_entries)
+        {
+            Entry& clearedEntry = cleared.m_entries.emplace_back();
+            clearedEntry.mType = entry.mType;
+            clearedEntry.mSize = entry.mSize;
+            clearedEntry.mStorage.assign(entry.mStorage.size(), 0);
+            reinterpret_cast<VkBaseOutStructure*>(clearedEntry.mStorage.data())->sType = entry.mType;
+        }
+        return cleared;
+    }
+
+    uint32_t VulkanFeatureChain::intersect(const VulkanFeatureChain& supported) noexcept
+    {
+        uint32_t clearedCount = 0;
+        for (auto& entry : m_entries)
+        {
+            // a struct the device did not report leaves nothing supported
+            const void* supportedStorage = supported.findStorage(entry.mType);
+            const uint32_t featureCount = static_cast<uint32_t>((entry.mSize - sizeof(VkBaseOutStructure)) / sizeof(VkBool32));
+
+            auto* requested = reinterpret_cast<VkBool32*>(reinterpret_cast<uint8_t*>(entry.mStorage.data()) + sizeof(VkBaseOutStructure));
+            const VkBool32* available = supportedStorage ? 
+                reinterpret_cast<const VkBool32*>(static_cast<const uint8_t*>(supportedStorage) + sizeof(VkBaseOutStructure)) : nullptr;
+
+            for (uint32_t i = 0; i < featureCount; ++i)
+            {
+                if (requested[i] && (!available || !available[i]))
+                {
+                    VK_LOG_WARN("requested feature %u of %s is not supported", i, string_VkStructureType(entry.mType));
+                    requested[i] = VK_FALSE;
+                    ++clearedCount;
+                }
+            }
+        }
+        return clearedCount;
+    }
+
+    void* VulkanFeatureChain::findStorage(VkStructureType structureType) noexcept
+    {
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [structureType](const Entry& entry) { return entry.mType == structureType; });
+        return it != m_entries.end() ? it->mStorage.data() : nullptr;
+    }
+
+    const void* VulkanFeatureChain::findStorage(VkStructureType structureType) const noexcept
+    {
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [structureType](const Entry& entry) { return entry.mType == structureType; });
+        return it != m_entries.end() ? it->mStorage.data() : nullptr;
+    }
+}   // namespace keplar
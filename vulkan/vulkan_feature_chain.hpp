@@ -0,0 +1,80 @@
+// ────────────────────────────────────────────
+//  File: vulkan_feature_chain.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // owned pNext chain of feature structs for VkPhysicalDeviceFeatures2 / VkDeviceCreateInfo: core version structs
+    // (VkPhysicalDeviceVulkan11Features .. 14) and extension structs, at most one per structure type. every member
+    // after sType and pNext is treated as a VkBool32 feature, which holds for all feature structs. copyable (unlike
+    // the handle wrappers): the pNext links are rebuilt by link(), so call it again after a copy. a core struct and
+    // the extension structs it promoted must not be chained together
+    class VulkanFeatureChain final
+    {
+        public:
+            // returns the struct of the given type, zero-initialized with its sType on first use
+            template<typename T>
+            T& add(VkStructureType structureType) noexcept;
+
+            // null when the chain holds no struct of the given type
+            template<typename T>
+            const T* find(VkStructureType structureType) const noexcept;
+
+            // usage: points each struct at the next in insertion order; null when empty
+            void* link() noexcept;
+
+            // the same structs with every feature cleared, for vkGetPhysicalDeviceFeatures2 to fill in
+            VulkanFeatureChain cloneCleared() const noexcept;
+
+            // clears every feature the supported chain (a filled cloneCleared copy) lacks; returns how many were cleared
+            uint32_t intersect(const VulkanFeatureChain& supported) noexcept;
+
+            void clear() noexcept { m_entries.clear(); }
+            bool isEmpty() const noexcept { return m_entries.empty(); }
+
+        private:
+            struct Entry
+            {
+                VkStructureType         mType;
+                size_t                  mSize;
+                std::vector<uint64_t>   mStorage;       // 8-byte aligned for the pNext pointer
+            };
+
+            void* findStorage(VkStructureType structureType) noexcept;
+            const void* findStorage(VkStructureType structureType) const noexcept;
+
+        private:
+            std::vector<Entry> m_entries;
+    };
+
+    template<typename T>
+    T& VulkanFeatureChain::add(VkStructureType structureType) noexcept
+    {
+        if (void* storage = findStorage(structureType))
+        {
+            return *static_cast<T*>(storage);
+        }
+
+        Entry& entry = m_entries.emplace_back();
+        entry.mType = structureType;
+        entry.mSize = sizeof(T);
+        entry.mStorage.assign((sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+
+        T* features = reinterpret_cast<T*>(entry.mStorage.data());
+        features->sType = structureType;
+        features->pNext = nullptr;
+        return *features;
+    }
+
+    template<typename T>
+    const T* VulkanFeatureChain::find(VkStructureType structureType) const noexcept
+    {
+        return static_cast<const T*>(findStorage(structureType));
+    }
+}   // namespace keplar
@@ -0,0 +1,117 @@
+// ────────────────────────────────────────────
+//  File: vulkan_frame_command_allocator.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_frame_command_allocator.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanFrameCommandAllocator::VulkanFrameCommandAllocator() noexcept
+        : m_currentFrame(0)
+    {
+    }
+
+    bool VulkanFrameCommandAllocator::initialize(VkDevice vkDevice, uint32_t queueFamilyIndex, uint32_t frameCount) noexcept
+    {
+        // validate input
+        if (vkDevice == VK_NULL_HANDLE || frameCount == 0)
+        {
+            VK_LOG_ERROR("VulkanFrameCommandAllocator::initialize failed: invalid device or frame count");
+            return false;
+        }
+
+        // transient pools without per-buffer reset; everything is recycled by resetting the whole pool
+        VkCommandPoolCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        createInfo.queueFamilyIndex = queueFamilyIndex;
+
+        destroy();
+        m_frames.resize(frameCount);
+        for (auto& frame : m_frames)
+        {
+            if (!frame.mCommandPool.initialize(vkDevice, createInfo))
+            {
+                VK_LOG_ERROR("VulkanFrameCommandAllocator::initialize failed to create frame command pool");
+                destroy();
+                return false;
+            }
+        }
+
+        m_currentFrame = 0;
+        VK_LOG_DEBUG("VulkanFrameCommandAllocator::initialize successful (%u frames)", frameCount);
+        return true;
+    }
+
+    void VulkanFrameCommandAllocator::destroy() noexcept
+    {
+        // destroying a pool frees every buffer allocated from it
+        m_frames.clear();
+        m_currentFrame = 0;
+    }
+
+    bool VulkanFrameCommandAllocator::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frames.size())
+        {
+            VK_LOG_ERROR("VulkanFrameCommandAllocator::beginFrame failed: frame index %u out of range (%zu frames)", frameIndex, m_frames.size());
+            return false;
+        }
+
+        // one reset returns every buffer of the frame to the initial state
+        Frame& frame = m_frames[frameIndex];
+        if (!frame.mCommandPool.reset())
+        {
+            VK_LOG_ERROR("VulkanFrameCommandAllocator::beginFrame failed to reset frame command pool");
+            return false;
+        }
+
+        frame.mPrimaryCursor = 0;
+        frame.mSecondaryCursor = 0;
+        m_currentFrame = frameIndex;
+        return true;
+    }
+
+    VulkanCommandBuffer VulkanFrameCommandAllocator::allocatePrimary() noexcept
+    {
+        if (m_frames.empty())
+        {
+            return {};
+        }
+
+        Frame& frame = m_frames[m_currentFrame];
+        return next(frame.mPrimaries, frame.mPrimaryCursor, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    }
+
+    VulkanCommandBuffer VulkanFrameCommandAllocator::allocateSecondary() noexcept
+    {
+        if (m_frames.empty())
+        {
+            return {};
+        }
+
+        Frame& frame = m_frames[m_currentFrame];
+        return next(frame.mSecondaries, frame.mSecondaryCursor, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    }
+
+    VulkanCommandBuffer VulkanFrameCommandAllocator::next(std::vector<VulkanCommandBuffer>& commandBuffers, size_t& cursor, VkCommandBufferLevel level) noexcept
+    {
+        // grow only when this frame needs more buffers than any earlier one
+        if (cursor == commandBuffers.size())
+        {
+            const VulkanCommandPool& commandPool = m_frames[m_currentFrame].mCommandPool;
+            VulkanCommandBuffer commandBuffer = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? commandPool.allocatePrimary() : commandPool.allocateSecondary();
+            if (!commandBuffer.isValid())
+            {
+                VK_LOG_ERROR("VulkanFrameCommandAllocator::next failed to allocate command buffer");
+                return {};
+            }
+            commandBuffers.push_back(commandBuffer);
+        }
+
+        return commandBuffers[cursor++];
+    }
+}   // namespace keplar
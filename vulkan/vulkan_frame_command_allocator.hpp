@@ -0,0 +1,62 @@
+// ────────────────────────────────────────────
+//  File: vulkan_frame_command_allocator.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_command_pool.hpp"
+#include "vulkan/vulkan_command_buffer.hpp"
+
+namespace keplar
+{
+    // ring of transient command pools, one per frame in flight. beginFrame() resets the frame's pool in bulk
+    // (call it only after that frame's fence signaled) and rewinds its cursors; command buffers are then handed
+    // out linearly, reusing the ones allocated in earlier frames and growing the pool only when a frame needs more.
+    // buffers come back in the initial state, so they are begun without a per-buffer reset and are valid until
+    // the same frame index begins again. not thread-safe: give each recording thread its own allocator
+    class VulkanFrameCommandAllocator final
+    {
+        public:
+            // creation and destruction
+            VulkanFrameCommandAllocator() noexcept;
+            ~VulkanFrameCommandAllocator() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanFrameCommandAllocator(const VulkanFrameCommandAllocator&) = delete;
+            VulkanFrameCommandAllocator& operator=(const VulkanFrameCommandAllocator&) = delete;
+            VulkanFrameCommandAllocator(VulkanFrameCommandAllocator&&) = delete;
+            VulkanFrameCommandAllocator& operator=(VulkanFrameCommandAllocator&&) = delete;
+
+            bool initialize(VkDevice vkDevice, uint32_t queueFamilyIndex, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame
+            bool beginFrame(uint32_t frameIndex) noexcept;
+            VulkanCommandBuffer allocatePrimary() noexcept;
+            VulkanCommandBuffer allocateSecondary() noexcept;
+
+            // accessors
+            uint32_t getFrameCount() const noexcept { return static_cast<uint32_t>(m_frames.size()); }
+            bool isValid() const noexcept { return !m_frames.empty(); }
+
+        private:
+            // one frame's pool and the buffers allocated from it so far
+            struct Frame
+            {
+                VulkanCommandPool                   mCommandPool;
+                std::vector<VulkanCommandBuffer>    mPrimaries;
+                std::vector<VulkanCommandBuffer>    mSecondaries;
+                size_t                              mPrimaryCursor = 0;
+                size_t                              mSecondaryCursor = 0;
+            };
+
+            VulkanCommandBuffer next(std::vector<VulkanCommandBuffer>& commandBuffers, size_t& cursor, VkCommandBufferLevel level) noexcept;
+
+        private:
+            std::vector<Frame>  m_frames;
+            uint32_t            m_currentFrame;
+    };
+}   // namespace keplar
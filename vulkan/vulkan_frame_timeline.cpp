@@ -0,0 +1,90 @@
+// ────────────────────────────────────────────
+//  File: vulkan_frame_timeline.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_frame_timeline.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanFrameTimeline::VulkanFrameTimeline() noexcept
+        : m_lastSubmittedValue(0)
+    {
+    }
+
+    bool VulkanFrameTimeline::initialize(VkDevice vkDevice, uint32_t frameCount) noexcept
+    {
+        // validate input
+        if (frameCount == 0)
+        {
+            VK_LOG_ERROR("VulkanFrameTimeline::initialize failed: frame count is zero");
+            return false;
+        }
+
+        // the counter starts at zero, so every frame slot begins complete
+        destroy();
+        if (!m_semaphore.initializeTimeline(vkDevice, 0))
+        {
+            VK_LOG_ERROR("VulkanFrameTimeline::initialize failed to create timeline semaphore");
+            return false;
+        }
+
+        m_frameValues.assign(frameCount, 0);
+        m_lastSubmittedValue = 0;
+        VK_LOG_DEBUG("VulkanFrameTimeline::initialize successful (%u frames)", frameCount);
+        return true;
+    }
+
+    void VulkanFrameTimeline::destroy() noexcept
+    {
+        m_semaphore.destroy();
+        m_frameValues.clear();
+        m_lastSubmittedValue = 0;
+    }
+
+    bool VulkanFrameTimeline::waitForFrame(uint32_t frameIndex, uint64_t timeout) const noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frameValues.size())
+        {
+            VK_LOG_ERROR("VulkanFrameTimeline::waitForFrame failed: frame index %u out of range (%zu frames)", frameIndex, m_frameValues.size());
+            return false;
+        }
+
+        return wait(m_frameValues[frameIndex], timeout);
+    }
+
+    void VulkanFrameTimeline::markSubmitted(uint32_t frameIndex) noexcept
+    {
+        // the pending value is now owned by this frame slot
+        ++m_lastSubmittedValue;
+        if (frameIndex < m_frameValues.size())
+        {
+            m_frameValues[frameIndex] = m_lastSubmittedValue;
+        }
+    }
+
+    bool VulkanFrameTimeline::wait(uint64_t value, uint64_t timeout) const noexcept
+    {
+        // values at or below the initial counter are complete by definition
+        if (value == 0)
+        {
+            return true;
+        }
+
+        return m_semaphore.wait(value, timeout);
+    }
+
+    bool VulkanFrameTimeline::isComplete(uint64_t value) const noexcept
+    {
+        uint64_t counterValue = 0;
+        return m_semaphore.getCounterValue(counterValue) && counterValue >= value;
+    }
+
+    uint64_t VulkanFrameTimeline::getCompletedValue() const noexcept
+    {
+        // a failed query reports nothing completed, which only delays whoever polls it
+        uint64_t counterValue = 0;
+        return m_semaphore.getCounterValue(counterValue) ? counterValue : 0;
+    }
+}   // namespace keplar
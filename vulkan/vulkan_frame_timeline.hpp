@@ -0,0 +1,54 @@
+// ────────────────────────────────────────────
+//  File: vulkan_frame_timeline.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_semaphore.hpp"
+
+namespace keplar
+{
+    // frame pacing on one timeline semaphore instead of a fence per frame in flight. every submission that
+    // completes a frame signals getPendingValue() and then calls markSubmitted(); waitForFrame() blocks until
+    // the previous submission of that frame slot finished, with no fence reset. any work (uploads, compute,
+    // another queue) can wait on or signal the same counter through VkTimelineSemaphoreSubmitInfo
+    class VulkanFrameTimeline final
+    {
+        public:
+            // creation and destruction
+            VulkanFrameTimeline() noexcept;
+            ~VulkanFrameTimeline() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanFrameTimeline(const VulkanFrameTimeline&) = delete;
+            VulkanFrameTimeline& operator=(const VulkanFrameTimeline&) = delete;
+            VulkanFrameTimeline(VulkanFrameTimeline&&) = delete;
+            VulkanFrameTimeline& operator=(VulkanFrameTimeline&&) = delete;
+
+            bool initialize(VkDevice vkDevice, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: frame pacing
+            bool waitForFrame(uint32_t frameIndex, uint64_t timeout = UINT64_MAX) const noexcept;
+            uint64_t getPendingValue() const noexcept { return m_lastSubmittedValue + 1; }
+            void markSubmitted(uint32_t frameIndex) noexcept;
+
+            // usage: arbitrary points on the timeline
+            bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const noexcept;
+            bool isComplete(uint64_t value) const noexcept;
+            uint64_t getCompletedValue() const noexcept;
+
+            // accessors
+            VkSemaphore get() const noexcept { return m_semaphore.get(); }
+            bool isValid() const noexcept { return m_semaphore.isValid(); }
+            uint64_t getLastSubmittedValue() const noexcept { return m_lastSubmittedValue; }
+
+        private:
+            VulkanSemaphore         m_semaphore;
+            std::vector<uint64_t>   m_frameValues;          // value signaled by each frame slot's last submission
+            uint64_t                m_lastSubmittedValue;
+    };
+}   // namespace keplar
@@ -0,0 +1,280 @@
+// ────────────────────────────────────────────
+//  File: vulkan_indirect_commands.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_indirect_commands.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // tokens a sequence carries: execution set first, the draw last
+    constexpr uint32_t kMaxTokenCount = 3;
+
+    inline uint32_t alignUp(uint32_t value, uint32_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+namespace keplar
+{
+    VulkanIndirectCommands::VulkanIndirectCommands() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_executionSet(VK_NULL_HANDLE)
+        , m_commandsLayout(VK_NULL_HANDLE)
+        , m_preprocessSize(0)
+        , m_config{}
+        , m_stride(0)
+        , m_pushConstantOffset(0)
+        , m_drawOffset(0)
+    {
+    }
+
+    bool VulkanIndirectCommands::initialize(const VulkanDevice& device, const IndirectCommandsConfig& config) noexcept
+    {
+        if (!device.isDeviceGeneratedCommandsEnabled() || !isDeviceGeneratedCommandsLoaded())
+        {
+            VK_LOG_ERROR("VulkanIndirectCommands::initialize failed: device generated commands are not enabled on the device");
+            return false;
+        }
+
+        destroy();
+
+        // the sequence: pipeline index, push constants (4-byte granular like every range), then the draw
+        m_pushConstantOffset = static_cast<uint32_t>(sizeof(uint32_t));
+        m_drawOffset = m_pushConstantOffset + alignUp(config.mPushConstantRange.size, 4);
+        m_stride = m_drawOffset + static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+
+        const VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT& properties = device.getDeviceGeneratedCommandsProperties();
+        if (config.mInitialPipeline == VK_NULL_HANDLE || config.mPipelineLayout == VK_NULL_HANDLE || config.mMaxSequenceCount == 0 ||
+            config.mMaxPipelineCount == 0 || config.mMaxPipelineCount > properties.maxIndirectPipelineCount ||
+            config.mMaxSequenceCount > properties.maxIndirectSequenceCount || m_stride > properties.maxIndirectCommandsIndirectStride ||
+            (config.mShaderStages & ~properties.supportedIndirectCommandsShaderStagesPipelineBinding) != 0)
+        {
+            VK_LOG_ERROR("VulkanIndirectCommands::initialize failed: invalid config (%u pipelines, %u sequences of %u bytes)",
+                         config.mMaxPipelineCount, config.mMaxSequenceCount, m_stride);
+            return false;
+        }
+
+        m_vkDevice = device.getDevice();
+        m_config = config;
+
+        // execution set of the pipelines sequences switch between
+        VkIndirectExecutionSetPipelineInfoEXT pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_INDIRECT_EXECUTION_SET_PIPELINE_INFO_EXT;
+        pipelineInfo.pNext = nullptr;
+        pipelineInfo.initialPipeline = config.mInitialPipeline;
+        pipelineInfo.maxPipelineCount = config.mMaxPipelineCount;
+
+        VkIndirectExecutionSetCreateInfoEXT executionSetCreateInfo{};
+        executionSetCreateInfo.sType = VK_STRUCTURE_TYPE_INDIRECT_EXECUTION_SET_CREATE_INFO_EXT;
+        executionSetCreateInfo.pNext = nullptr;
+        executionSetCreateInfo.type = VK_INDIRECT_EXECUTION_SET_INFO_TYPE_PIPELINES_EXT;
+        executionSetCreateInfo.info.pPipelineInfo = &pipelineInfo;
+
+        VkResult result = s_vkCreateIndirectExecutionSetEXT(m_vkDevice, &executionSetCreateInfo, nullptr, &m_executionSet);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkCreateIndirectExecutionSetEXT failed with error code %d", result);
+            destroy();
+            return false;
+        }
+
+        // tokens of a sequence
+        VkIndirectCommandsExecutionSetTokenEXT executionSetToken{};
+        executionSetToken.type = VK_INDIRECT_EXECUTION_SET_INFO_TYPE_PIPELINES_EXT;
+        executionSetToken.shaderStages = config.mShaderStages;
+
+        VkIndirectCommandsPushConstantTokenEXT pushConstantToken{};
+        pushConstantToken.updateRange = config.mPushConstantRange;
+
+        std::array<VkIndirectCommandsLayoutTokenEXT, kMaxTokenCount> tokens{};
+        uint32_t tokenCount = 0;
+        tokens[tokenCount].sType = VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_TOKEN_EXT;
+        tokens[tokenCount].type = VK_INDIRECT_COMMANDS_TOKEN_TYPE_EXECUTION_SET_EXT;
+        tokens[tokenCount].data.pExecutionSet = &executionSetToken;
+        tokens[tokenCount].offset = getExecutionSetOffset();
+        ++tokenCount;
+
+        if (config.mPushConstantRange.size > 0)
+        {
+            tokens[tokenCount].sType = VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_TOKEN_EXT;
+            tokens[tokenCount].type = VK_INDIRECT_COMMANDS_TOKEN_TYPE_PUSH_CONSTANT_EXT;
+            tokens[tokenCount].data.pPushConstant = &pushConstantToken;
+            tokens[tokenCount].offset = m_pushConstantOffset;
+            ++tokenCount;
+        }
+
+        tokens[tokenCount].sType = VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_TOKEN_EXT;
+        tokens[tokenCount].type = VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_INDEXED_EXT;
+        tokens[tokenCount].offset = m_drawOffset;
+        ++tokenCount;
+
+        // sequences are independent draws, so the driver may run them in any order
+        VkIndirectCommandsLayoutCreateInfoEXT layoutCreateInfo{};
+        layoutCreateInfo.sType = VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_CREATE_INFO_EXT;
+        layoutCreateInfo.pNext = nullptr;
+        layoutCreateInfo.flags = VK_INDIRECT_COMMANDS_LAYOUT_USAGE_UNORDERED_SEQUENCES_BIT_EXT;
+        layoutCreateInfo.shaderStages = config.mShaderStages;
+        layoutCreateInfo.indirectStride = m_stride;
+        layoutCreateInfo.pipelineLayout = config.mPipelineLayout;
+        layoutCreateInfo.tokenCount = tokenCount;
+        layoutCreateInfo.pTokens = tokens.data();
+
+        result = s_vkCreateIndirectCommandsLayoutEXT(m_vkDevice, &layoutCreateInfo, nullptr, &m_commandsLayout);
+        if (result != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkCreateIndirectCommandsLayoutEXT failed with error code %d", result);
+            destroy();
+            return false;
+        }
+
+        if (!createPreprocessBuffer(device))
+        {
+            destroy();
+            return false;
+        }
+
+        VK_LOG_DEBUG("VulkanIndirectCommands::initialize successful (%u sequences of %u bytes, %llu preprocess bytes)",
+                     m_config.mMaxSequenceCount, m_stride, static_cast<unsigned long long>(m_preprocessSize));
+        return true;
+    }
+
+    void VulkanIndirectCommands::destroy() noexcept
+    {
+        if (m_commandsLayout != VK_NULL_HANDLE)
+        {
+            s_vkDestroyIndirectCommandsLayoutEXT(m_vkDevice, m_commandsLayout, nullptr);
+            m_commandsLayout = VK_NULL_HANDLE;
+        }
+
+        if (m_executionSet != VK_NULL_HANDLE)
+        {
+            s_vkDestroyIndirectExecutionSetEXT(m_vkDevice, m_executionSet, nullptr);
+            m_executionSet = VK_NULL_HANDLE;
+        }
+
+        m_preprocessBuffer = VulkanBuffer();
+        m_preprocessSize = 0;
+        m_config = IndirectCommandsConfig{};
+        m_stride = 0;
+        m_pushConstantOffset = 0;
+        m_drawOffset = 0;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    bool VulkanIndirectCommands::setPipeline(uint32_t index, VkPipeline pipeline) const noexcept
+    {
+        if (!isValid() || index >= m_config.mMaxPipelineCount || pipeline == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanIndirectCommands::setPipeline failed: index %u out of range (%u pipelines)", index, m_config.mMaxPipelineCount);
+            return false;
+        }
+
+        VkWriteIndirectExecutionSetPipelineEXT write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_INDIRECT_EXECUTION_SET_PIPELINE_EXT;
+        write.pNext = nullptr;
+        write.index = index;
+        write.pipeline = pipeline;
+        s_vkUpdateIndirectExecutionSetPipelineEXT(m_vkDevice, m_executionSet, 1, &write);
+        return true;
+    }
+
+    void VulkanIndirectCommands::execute(VkCommandBuffer vkCommandBuffer, VkDeviceAddress sequenceAddress, VkDeviceAddress sequenceCountAddress,
+                                         uint32_t maxSequenceCount) const noexcept
+    {
+        if (!isValid() || sequenceAddress == 0 || maxSequenceCount == 0)
+        {
+            return;
+        }
+
+        // the preprocess buffer was sized for the configured maximum
+        const uint32_t sequenceCount = std::min(maxSequenceCount, m_config.mMaxSequenceCount);
+
+        VkGeneratedCommandsInfoEXT generatedCommandsInfo{};
+        generatedCommandsInfo.sType = VK_STRUCTURE_TYPE_GENERATED_COMMANDS_INFO_EXT;
+        generatedCommandsInfo.pNext = nullptr;
+        generatedCommandsInfo.shaderStages = m_config.mShaderStages;
+        generatedCommandsInfo.indirectExecutionSet = m_executionSet;
+        generatedCommandsInfo.indirectCommandsLayout = m_commandsLayout;
+        generatedCommandsInfo.indirectAddress = sequenceAddress;
+        generatedCommandsInfo.indirectAddressSize = static_cast<VkDeviceSize>(sequenceCount) * m_stride;
+        generatedCommandsInfo.preprocessAddress = m_preprocessSize > 0 ? m_preprocessBuffer.getDeviceAddress() : 0;
+        generatedCommandsInfo.preprocessSize = m_preprocessSize;
+        generatedCommandsInfo.maxSequenceCount = sequenceCount;
+        generatedCommandsInfo.sequenceCountAddress = sequenceCountAddress;
+        generatedCommandsInfo.maxDrawCount = 0;
+        s_vkCmdExecuteGeneratedCommandsEXT(vkCommandBuffer, VK_FALSE, &generatedCommandsInfo);
+    }
+
+    bool VulkanIndirectCommands::loadDeviceGeneratedCommands(VkDevice vkDevice) noexcept
+    {
+        s_vkCreateIndirectExecutionSetEXT = (PFN_vkCreateIndirectExecutionSetEXT)vkGetDeviceProcAddr(vkDevice, "vkCreateIndirectExecutionSetEXT");
+        s_vkDestroyIndirectExecutionSetEXT = (PFN_vkDestroyIndirectExecutionSetEXT)vkGetDeviceProcAddr(vkDevice, "vkDestroyIndirectExecutionSetEXT");
+        s_vkUpdateIndirectExecutionSetPipelineEXT = (PFN_vkUpdateIndirectExecutionSetPipelineEXT)vkGetDeviceProcAddr(vkDevice, "vkUpdateIndirectExecutionSetPipelineEXT");
+        s_vkCreateIndirectCommandsLayoutEXT = (PFN_vkCreateIndirectCommandsLayoutEXT)vkGetDeviceProcAddr(vkDevice, "vkCreateIndirectCommandsLayoutEXT");
+        s_vkDestroyIndirectCommandsLayoutEXT = (PFN_vkDestroyIndirectCommandsLayoutEXT)vkGetDeviceProcAddr(vkDevice, "vkDestroyIndirectCommandsLayoutEXT");
+        s_vkGetGeneratedCommandsMemoryRequirementsEXT = (PFN_vkGetGeneratedCommandsMemoryRequirementsEXT)vkGetDeviceProcAddr(vkDevice, "vkGetGeneratedCommandsMemoryRequirementsEXT");
+        s_vkCmdExecuteGeneratedCommandsEXT = (PFN_vkCmdExecuteGeneratedCommandsEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdExecuteGeneratedCommandsEXT");
+        if (s_vkCreateIndirectExecutionSetEXT == nullptr || s_vkDestroyIndirectExecutionSetEXT == nullptr ||
+            s_vkUpdateIndirectExecutionSetPipelineEXT == nullptr || s_vkCreateIndirectCommandsLayoutEXT == nullptr ||
+            s_vkDestroyIndirectCommandsLayoutEXT == nullptr || s_vkGetGeneratedCommandsMemoryRequirementsEXT == nullptr ||
+            s_vkCmdExecuteGeneratedCommandsEXT == nullptr)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get device generated commands function pointers");
+            s_vkCmdExecuteGeneratedCommandsEXT = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanIndirectCommands::createPreprocessBuffer(const VulkanDevice& device) noexcept
+    {
+        // sized for the largest batch, so every execute() fits
+        VkGeneratedCommandsMemoryRequirementsInfoEXT requirementsInfo{};
+        requirementsInfo.sType = VK_STRUCTURE_TYPE_GENERATED_COMMANDS_MEMORY_REQUIREMENTS_INFO_EXT;
+        requirementsInfo.pNext = nullptr;
+        requirementsInfo.indirectExecutionSet = m_executionSet;
+        requirementsInfo.indirectCommandsLayout = m_commandsLayout;
+        requirementsInfo.maxSequenceCount = m_config.mMaxSequenceCount;
+        requirementsInfo.maxDrawCount = 0;
+
+        VkMemoryRequirements2 requirements{};
+        requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        requirements.pNext = nullptr;
+        s_vkGetGeneratedCommandsMemoryRequirementsEXT(m_vkDevice, &requirementsInfo, &requirements);
+
+        // some drivers expand sequences in place and need no scratch at all
+        m_preprocessSize = requirements.memoryRequirements.size;
+        if (m_preprocessSize == 0)
+        {
+            return true;
+        }
+
+        // the preprocess usage only exists as a 64-bit usage flag, which then replaces the 32-bit usage
+        VkBufferUsageFlags2CreateInfoKHR usageFlags2{};
+        usageFlags2.sType = VK_STRUCTURE_TYPE_BUFFER_USAGE_FLAGS_2_CREATE_INFO_KHR;
+        usageFlags2.pNext = nullptr;
+        usageFlags2.usage = VK_BUFFER_USAGE_2_PREPROCESS_BUFFER_BIT_EXT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT_KHR;
+
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = &usageFlags2;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferCreateInfo.size = m_preprocessSize;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_preprocessBuffer.createDeviceLocal(device, bufferCreateInfo))
+        {
+            VK_LOG_ERROR("VulkanIndirectCommands::createPreprocessBuffer failed to create a %llu byte buffer",
+                         static_cast<unsigned long long>(m_preprocessSize));
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
@@ -0,0 +1,102 @@
+// ────────────────────────────────────────────
+//  File: vulkan_indirect_commands.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // what the generated sequences switch between and how large a batch may grow
+    struct IndirectCommandsConfig
+    {
+        VkPipeline          mInitialPipeline = VK_NULL_HANDLE;      // execution set slot 0, created with mIndirectBindable
+        VkPipelineLayout    mPipelineLayout = VK_NULL_HANDLE;       // shared by every pipeline of the set
+        VkShaderStageFlags  mShaderStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        uint32_t            mMaxPipelineCount = 1;
+        VkPushConstantRange mPushConstantRange{};                    // size 0: sequences write no push constants
+        uint32_t            mMaxSequenceCount = 0;
+    };
+
+    // VK_EXT_device_generated_commands (VulkanDevice::isDeviceGeneratedCommandsEnabled): a compute pass writes one
+    // sequence per draw into a buffer, and execute() turns the batch into pipeline switches, push constant updates and
+    // indexed draws on the gpu, so batches no longer split on the cpu wherever the pipeline or per-draw data changes.
+    // a sequence is laid out at getStride() as
+    //   uint32 pipeline index into the execution set  @ getExecutionSetOffset()
+    //   push constant bytes of the configured range   @ getPushConstantOffset()
+    //   VkDrawIndexedIndirectCommand                  @ getDrawOffset()
+    //
+    // vertex and index buffers and descriptor sets stay bound by the cpu. before execute(), a pipeline of the set must be
+    // bound, and the writes of the sequence and count buffers must be made visible to
+    // VK_PIPELINE_STAGE_2_COMMAND_PREPROCESS_BIT_EXT / VK_ACCESS_2_COMMAND_PREPROCESS_READ_BIT_EXT. the preprocess
+    // buffer is reused by every execute(), so batches of a command buffer run one after another. not thread-safe
+    class VulkanIndirectCommands final
+    {
+        public:
+            // creation and destruction
+            VulkanIndirectCommands() noexcept;
+            ~VulkanIndirectCommands() { destroy(); }
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanIndirectCommands(const VulkanIndirectCommands&) = delete;
+            VulkanIndirectCommands& operator=(const VulkanIndirectCommands&) = delete;
+            VulkanIndirectCommands(VulkanIndirectCommands&&) = delete;
+            VulkanIndirectCommands& operator=(VulkanIndirectCommands&&) = delete;
+
+            bool initialize(const VulkanDevice& device, const IndirectCommandsConfig& config) noexcept;
+            void destroy() noexcept;
+
+            // usage: fills a slot of the execution set; the pipeline may not be bound by a pending execute()
+            bool setPipeline(uint32_t index, VkPipeline pipeline) const noexcept;
+
+            // usage: recording. sequenceCountAddress 0 executes maxSequenceCount sequences, else the uint32 it points at
+            // (clamped to maxSequenceCount)
+            void execute(VkCommandBuffer vkCommandBuffer, VkDeviceAddress sequenceAddress, VkDeviceAddress sequenceCountAddress,
+                         uint32_t maxSequenceCount) const noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_commandsLayout != VK_NULL_HANDLE; }
+            uint32_t getStride() const noexcept { return m_stride; }
+            uint32_t getExecutionSetOffset() const noexcept { return 0; }
+            uint32_t getPushConstantOffset() const noexcept { return m_pushConstantOffset; }
+            uint32_t getDrawOffset() const noexcept { return m_drawOffset; }
+            uint32_t getMaxSequenceCount() const noexcept { return m_config.mMaxSequenceCount; }
+
+            // loaded by the device that enables the extension
+            static bool loadDeviceGeneratedCommands(VkDevice vkDevice) noexcept;
+            static bool isDeviceGeneratedCommandsLoaded() noexcept { return s_vkCmdExecuteGeneratedCommandsEXT != nullptr; }
+
+        private:
+            bool createPreprocessBuffer(const VulkanDevice& device) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                        m_vkDevice;
+            VkIndirectExecutionSetEXT       m_executionSet;
+            VkIndirectCommandsLayoutEXT     m_commandsLayout;
+
+            // scratch the driver expands sequences into
+            VulkanBuffer                    m_preprocessBuffer;
+            VkDeviceSize                    m_preprocessSize;
+
+            // layout of a sequence
+            IndirectCommandsConfig          m_config;
+            uint32_t                        m_stride;
+            uint32_t                        m_pushConstantOffset;
+            uint32_t                        m_drawOffset;
+
+            // extension commands, shared by every instance
+            inline static PFN_vkCreateIndirectExecutionSetEXT              s_vkCreateIndirectExecutionSetEXT = nullptr;
+            inline static PFN_vkDestroyIndirectExecutionSetEXT             s_vkDestroyIndirectExecutionSetEXT = nullptr;
+            inline static PFN_vkUpdateIndirectExecutionSetPipelineEXT      s_vkUpdateIndirectExecutionSetPipelineEXT = nullptr;
+            inline static PFN_vkCreateIndirectCommandsLayoutEXT            s_vkCreateIndirectCommandsLayoutEXT = nullptr;
+            inline static PFN_vkDestroyIndirectCommandsLayoutEXT           s_vkDestroyIndirectCommandsLayoutEXT = nullptr;
+            inline static PFN_vkGetGeneratedCommandsMemoryRequirementsEXT  s_vkGetGeneratedCommandsMemoryRequirementsEXT = nullptr;
+            inline static PFN_vkCmdExecuteGeneratedCommandsEXT             s_vkCmdExecuteGeneratedCommandsEXT = nullptr;
+    };
+}   // namespace keplar
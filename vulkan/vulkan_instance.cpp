@@ -6,8 +6,10 @@
 
 #include <sstream>
 #include <algorithm> 
+#include <unordered_set>
 
 #include "vulkan_utils.hpp"
+#include "vulkan_allocation_callbacks.hpp"
 #include "utils/logger.hpp"
 
 namespace 
@@ -57,7 +59,7 @@ namespace keplar
         // destroy vulkan instance after all vulkan resources have been released
         if (m_vkInstance != VK_NULL_HANDLE)
         {
-            vkDestroyInstance(m_vkInstance, nullptr);
+            vkDestroyInstance(m_vkInstance, getVulkanAllocationCallbacks());
             m_vkInstance = VK_NULL_HANDLE;
             VK_LOG_INFO("vulkan instance destroyed successfully");
         }
@@ -94,6 +96,18 @@ namespace keplar
             return false;
         }
 
+        // present mode compatibility queries for swapchain_maintenance1; skipped when the driver lacks them
+        if (config.mRequestSwapchainMaintenance1)
+        {
+            appendOptionalExtensions({ VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME, VK_EXT_SURFACE_MAINTENANCE_1_EXTENSION_NAME });
+        }
+
+        // exclusive fullscreen support is queried per monitor through the surface capabilities2 chain
+        if (config.mRequestFullScreenExclusive)
+        {
+            appendOptionalExtensions({ VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME });
+        }
+
         // set validation layers to be enabled
         if (config.mEnableValidation && !validateAndSetValidationLayers(config.mValidationLayers))
         {
@@ -140,7 +154,7 @@ namespace keplar
         }
 
         // create the vulkan instance
-        VkResult vkResult = vkCreateInstance(&vkInstanceCreateInfo, nullptr, &m_vkInstance);
+        VkResult vkResult = vkCreateInstance(&vkInstanceCreateInfo, getVulkanAllocationCallbacks(), &m_vkInstance);
         if (vkResult != VK_SUCCESS)
         {
             VK_LOG_FATAL("vkCreateInstance failed to create vulkan instance : %s (code: %d)", string_VkResult(vkResult), vkResult);
@@ -246,6 +260,47 @@ namespace keplar
         return true;
     }
 
+    void VulkanInstance::appendOptionalExtensions(std::initializer_list<const char*> extensions) noexcept
+    {
+        // query the supported instance extensions
+        uint32_t extensionCount = 0;
+        if (vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr) != VK_SUCCESS)
+        {
+            return;
+        }
+
+        std::vector<VkExtensionProperties> extensionProperties(extensionCount);
+        if (vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensionProperties.data()) != VK_SUCCESS)
+        {
+            return;
+        }
+
+        std::unordered_set<std::string_view> supportedExtensions;
+        for (const auto& elm : extensionProperties)
+        {
+            supportedExtensions.insert(elm.extensionName);
+        }
+
+        // all or nothing: the extensions of one request depend on each other
+        for (const char* extension : extensions)
+        {
+            if (supportedExtensions.find(extension) == supportedExtensions.end())
+            {
+                VK_LOG_WARN("optional instance extension %s is not supported by vulkan driver", extension);
+                return;
+            }
+        }
+
+        for (const char* extension : extensions)
+        {
+            if (!isExtensionEnabled(extension))
+            {
+                VK_LOG_INFO("enabled instance extension: %s", extension);
+                m_enabledExtensions.emplace_back(extension);
+            }
+        }
+    }
+
     bool VulkanInstance::validateAndSetValidationLayers(const std::vector<std::string_view>& requestedLayers) noexcept
     {
         // validation layers are enabled but no layers are requested 
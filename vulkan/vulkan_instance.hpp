@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <vector>
+#include <initializer_list>
 
 #include "vulkan/vulkan_config.hpp"
 
@@ -37,6 +38,7 @@ namespace keplar
             bool setupDebugMessenger() noexcept;
             bool validateAndSetExtensions(const std::vector<std::string_view>& requestedExtensions) noexcept;
             bool validateAndSetValidationLayers(const std::vector<std::string_view>& requestedLayers) noexcept;
+            void appendOptionalExtensions(std::initializer_list<const char*> extensions) noexcept;
 
             // vulkan debug callback invoked for validation and performance messages
             static VKAPI_ATTR VkBool32 VKAPI_CALL debugUtilsMessageCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, 
@@ -0,0 +1,259 @@
+// ────────────────────────────────────────────
+//  File: vulkan_low_latency.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_low_latency.hpp"
+
+#include "vulkan_device.hpp"
+#include "vulkan_utils.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // bound the sleep so a driver that never signals (minimized window, retired swapchain) cannot stall the frame loop
+    constexpr uint64_t kSleepTimeout = 100'000'000;     // 100 ms in ns
+
+    VkLatencyMarkerNV toLatencyMarkerNV(keplar::LatencyMarker marker) noexcept
+    {
+        switch (marker)
+        {
+            case keplar::LatencyMarker::kSimulationStart:   return VK_LATENCY_MARKER_SIMULATION_START_NV;
+            case keplar::LatencyMarker::kSimulationEnd:     return VK_LATENCY_MARKER_SIMULATION_END_NV;
+            case keplar::LatencyMarker::kRenderSubmitStart: return VK_LATENCY_MARKER_RENDERSUBMIT_START_NV;
+            case keplar::LatencyMarker::kRenderSubmitEnd:   return VK_LATENCY_MARKER_RENDERSUBMIT_END_NV;
+            case keplar::LatencyMarker::kPresentStart:      return VK_LATENCY_MARKER_PRESENT_START_NV;
+            case keplar::LatencyMarker::kPresentEnd:        return VK_LATENCY_MARKER_PRESENT_END_NV;
+        }
+        return VK_LATENCY_MARKER_SIMULATION_START_NV;
+    }
+}
+
+namespace keplar
+{
+    VulkanLowLatency::VulkanLowLatency() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkSwapchainKHR(VK_NULL_HANDLE)
+        , m_vkSetLatencySleepModeNV(nullptr)
+        , m_vkLatencySleepNV(nullptr)
+        , m_vkSetLatencyMarkerNV(nullptr)
+        , m_sleepValue(0)
+        , m_submissionInfo{}
+        , m_vkAntiLagUpdateAMD(nullptr)
+        , m_frameId(0)
+        , m_isEnabled(true)
+        , m_isBoost(false)
+    {
+    }
+
+    bool VulkanLowLatency::initialize(const VulkanDevice& device) noexcept
+    {
+        destroy();
+
+        if (!device.isLowLatencyEnabled())
+        {
+            VK_LOG_DEBUG("VulkanLowLatency::initialize skipped: low latency is not enabled on the device");
+            return false;
+        }
+
+        const VkDevice vkDevice = device.getDevice();
+        if (device.isLatencySleepEnabled())
+        {
+            m_vkSetLatencySleepModeNV = (PFN_vkSetLatencySleepModeNV)vkGetDeviceProcAddr(vkDevice, "vkSetLatencySleepModeNV");
+            m_vkLatencySleepNV        = (PFN_vkLatencySleepNV)vkGetDeviceProcAddr(vkDevice, "vkLatencySleepNV");
+            m_vkSetLatencyMarkerNV    = (PFN_vkSetLatencyMarkerNV)vkGetDeviceProcAddr(vkDevice, "vkSetLatencyMarkerNV");
+            if (!m_vkSetLatencySleepModeNV || !m_vkLatencySleepNV || !m_vkSetLatencyMarkerNV)
+            {
+                VK_LOG_ERROR("vkGetDeviceProcAddr failed to get VK_NV_low_latency2 function pointers");
+                destroy();
+                return false;
+            }
+
+            if (!m_sleepSemaphore.initializeTimeline(vkDevice))
+            {
+                VK_LOG_ERROR("VulkanLowLatency::initialize failed to create the sleep semaphore");
+                destroy();
+                return false;
+            }
+
+            m_submissionInfo.sType = VK_STRUCTURE_TYPE_LATENCY_SUBMISSION_PRESENT_ID_NV;
+            m_submissionInfo.pNext = nullptr;
+        }
+        else
+        {
+            m_vkAntiLagUpdateAMD = (PFN_vkAntiLagUpdateAMD)vkGetDeviceProcAddr(vkDevice, "vkAntiLagUpdateAMD");
+            if (!m_vkAntiLagUpdateAMD)
+            {
+                VK_LOG_ERROR("vkGetDeviceProcAddr failed to get vkAntiLagUpdateAMD function pointer");
+                return false;
+            }
+        }
+
+        m_vkDevice = vkDevice;
+        VK_LOG_DEBUG("VulkanLowLatency::initialize successful (%s)", getModeName());
+        return true;
+    }
+
+    void VulkanLowLatency::destroy() noexcept
+    {
+        m_sleepSemaphore.destroy();
+        m_vkDevice = VK_NULL_HANDLE;
+        m_vkSwapchainKHR = VK_NULL_HANDLE;
+        m_vkSetLatencySleepModeNV = nullptr;
+        m_vkLatencySleepNV = nullptr;
+        m_vkSetLatencyMarkerNV = nullptr;
+        m_vkAntiLagUpdateAMD = nullptr;
+        m_sleepValue = 0;
+    }
+
+    bool VulkanLowLatency::setSwapchain(VkSwapchainKHR vkSwapchainKHR) noexcept
+    {
+        m_vkSwapchainKHR = vkSwapchainKHR;
+        return applySleepMode();
+    }
+
+    uint64_t VulkanLowLatency::sleep() noexcept
+    {
+        // frame ids advance on every path, so they stay usable as present ids when the mode is off or unsupported
+        const uint64_t frameId = beginFrame();
+        if (!isValid())
+        {
+            return frameId;
+        }
+
+        // anti-lag: the driver delays this call itself; an off mode is reported the same way
+        if (m_vkAntiLagUpdateAMD)
+        {
+            VkAntiLagPresentationInfoAMD presentationInfo{};
+            presentationInfo.sType      = VK_STRUCTURE_TYPE_ANTI_LAG_PRESENTATION_INFO_AMD;
+            presentationInfo.pNext      = nullptr;
+            presentationInfo.stage      = VK_ANTI_LAG_STAGE_INPUT_AMD;
+            presentationInfo.frameIndex = frameId;
+
+            VkAntiLagDataAMD antiLagData{};
+            antiLagData.sType             = VK_STRUCTURE_TYPE_ANTI_LAG_DATA_AMD;
+            antiLagData.pNext             = nullptr;
+            antiLagData.mode              = m_isEnabled ? VK_ANTI_LAG_MODE_ON_AMD : VK_ANTI_LAG_MODE_OFF_AMD;
+            antiLagData.maxFPS            = 0;
+            antiLagData.pPresentationInfo = m_isEnabled ? &presentationInfo : nullptr;
+            m_vkAntiLagUpdateAMD(m_vkDevice, &antiLagData);
+            return frameId;
+        }
+
+        if (!m_isEnabled || m_vkSwapchainKHR == VK_NULL_HANDLE)
+        {
+            return frameId;
+        }
+
+        // low_latency2: the driver signals the next value once this frame should start
+        VkLatencySleepInfoNV sleepInfo{};
+        sleepInfo.sType           = VK_STRUCTURE_TYPE_LATENCY_SLEEP_INFO_NV;
+        sleepInfo.pNext           = nullptr;
+        sleepInfo.signalSemaphore = m_sleepSemaphore.get();
+        sleepInfo.value           = m_sleepValue + 1;
+
+        const VkResult vkResult = m_vkLatencySleepNV(m_vkDevice, m_vkSwapchainKHR, &sleepInfo);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_WARN_THROTTLED("vkLatencySleepNV failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return frameId;
+        }
+
+        // the value is consumed even when the wait times out: the late signal then satisfies the next, higher wait
+        m_sleepValue = sleepInfo.value;
+        m_sleepSemaphore.wait(m_sleepValue, kSleepTimeout);
+        return frameId;
+    }
+
+    void VulkanLowLatency::setMarker(uint64_t frameId, LatencyMarker marker) noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        // anti-lag only needs to know when the frame is about to be presented
+        if (m_vkAntiLagUpdateAMD)
+        {
+            if (marker != LatencyMarker::kPresentStart || !m_isEnabled)
+            {
+                return;
+            }
+
+            VkAntiLagPresentationInfoAMD presentationInfo{};
+            presentationInfo.sType      = VK_STRUCTURE_TYPE_ANTI_LAG_PRESENTATION_INFO_AMD;
+            presentationInfo.pNext      = nullptr;
+            presentationInfo.stage      = VK_ANTI_LAG_STAGE_PRESENT_AMD;
+            presentationInfo.frameIndex = frameId;
+
+            VkAntiLagDataAMD antiLagData{};
+            antiLagData.sType             = VK_STRUCTURE_TYPE_ANTI_LAG_DATA_AMD;
+            antiLagData.pNext             = nullptr;
+            antiLagData.mode              = VK_ANTI_LAG_MODE_ON_AMD;
+            antiLagData.maxFPS            = 0;
+            antiLagData.pPresentationInfo = &presentationInfo;
+            m_vkAntiLagUpdateAMD(m_vkDevice, &antiLagData);
+            return;
+        }
+
+        if (m_vkSwapchainKHR == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        VkSetLatencyMarkerInfoNV markerInfo{};
+        markerInfo.sType     = VK_STRUCTURE_TYPE_SET_LATENCY_MARKER_INFO_NV;
+        markerInfo.pNext     = nullptr;
+        markerInfo.presentID = frameId;
+        markerInfo.marker    = toLatencyMarkerNV(marker);
+        m_vkSetLatencyMarkerNV(m_vkDevice, m_vkSwapchainKHR, &markerInfo);
+    }
+
+    const void* VulkanLowLatency::chainSubmitFrameId(const void* pNext, uint64_t frameId) noexcept
+    {
+        if (!isLatencySleep())
+        {
+            return pNext;
+        }
+
+        // ties the submission's gpu work to the frame's markers
+        m_submissionInfo.pNext = pNext;
+        m_submissionInfo.presentID = frameId;
+        return &m_submissionInfo;
+    }
+
+    bool VulkanLowLatency::setEnabled(bool isEnabled) noexcept
+    {
+        m_isEnabled = isEnabled;
+        return applySleepMode();
+    }
+
+    bool VulkanLowLatency::setBoost(bool isBoost) noexcept
+    {
+        m_isBoost = isBoost;
+        return applySleepMode();
+    }
+
+    bool VulkanLowLatency::applySleepMode() noexcept
+    {
+        // anti-lag takes its mode with every update instead
+        if (!isLatencySleep() || m_vkSwapchainKHR == VK_NULL_HANDLE)
+        {
+            return true;
+        }
+
+        VkLatencySleepModeInfoNV sleepModeInfo{};
+        sleepModeInfo.sType             = VK_STRUCTURE_TYPE_LATENCY_SLEEP_MODE_INFO_NV;
+        sleepModeInfo.pNext             = nullptr;
+        sleepModeInfo.lowLatencyMode    = m_isEnabled ? VK_TRUE : VK_FALSE;
+        sleepModeInfo.lowLatencyBoost   = (m_isEnabled && m_isBoost) ? VK_TRUE : VK_FALSE;
+        sleepModeInfo.minimumIntervalUs = 0;
+
+        const VkResult vkResult = m_vkSetLatencySleepModeNV(m_vkDevice, m_vkSwapchainKHR, &sleepModeInfo);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkSetLatencySleepModeNV failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+}   // namespace keplar
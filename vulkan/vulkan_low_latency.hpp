@@ -0,0 +1,94 @@
+// ────────────────────────────────────────────
+//  File: vulkan_low_latency.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include "vulkan_config.hpp"
+#include "vulkan_semaphore.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // points of a frame reported to the driver, in the order a frame passes them
+    enum class LatencyMarker : uint8_t
+    {
+        kSimulationStart,
+        kSimulationEnd,
+        kRenderSubmitStart,
+        kRenderSubmitEnd,
+        kPresentStart,
+        kPresentEnd
+    };
+
+    // vendor low latency modes. with VK_NV_low_latency2 the driver measures each frame through its markers and
+    // sleep() holds the cpu until the frame start it computed, so input is sampled just in time for the gpu instead
+    // of a queue of frames ahead of it; markers and submissions are keyed by the frame id sleep() returned, which must
+    // also be the frame's present id. with VK_AMD_anti_lag only sleep() and kPresentStart reach the driver, which
+    // delays the frame itself. frames are identified the same way on both, so callers mark every point regardless
+    class VulkanLowLatency final
+    {
+        public:
+            // creation and destruction
+            VulkanLowLatency() noexcept;
+            ~VulkanLowLatency() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanLowLatency(const VulkanLowLatency&) = delete;
+            VulkanLowLatency& operator=(const VulkanLowLatency&) = delete;
+            VulkanLowLatency(VulkanLowLatency&&) = delete;
+            VulkanLowLatency& operator=(VulkanLowLatency&&) = delete;
+
+            // fails when the device was created without low latency
+            bool initialize(const VulkanDevice& device) noexcept;
+            void destroy() noexcept;
+
+            // usage: after every swapchain (re)creation; the latency mode is a property of the swapchain
+            bool setSwapchain(VkSwapchainKHR vkSwapchainKHR) noexcept;
+
+            // usage: per frame, before input is sampled. blocks until the driver's frame start and returns the frame id;
+            // beginFrame() only takes the next id, for frames that are not paced
+            uint64_t sleep() noexcept;
+            uint64_t beginFrame() noexcept                  { return ++m_frameId; }
+
+            // usage: from the thread that reaches the point; a frame's markers in order
+            void setMarker(uint64_t frameId, LatencyMarker marker) noexcept;
+            const void* chainSubmitFrameId(const void* pNext, uint64_t frameId) noexcept;
+
+            // configuration: disabled keeps the markers (the driver still reports latency) but no longer delays frames
+            bool setEnabled(bool isEnabled) noexcept;
+            bool setBoost(bool isBoost) noexcept;
+            bool isEnabled() const noexcept                 { return m_isEnabled; }
+            bool isBoost() const noexcept                   { return m_isBoost; }
+
+            // accessors
+            bool isValid() const noexcept                   { return m_vkDevice != VK_NULL_HANDLE; }
+            bool isLatencySleep() const noexcept            { return m_vkLatencySleepNV != nullptr; }
+            const char* getModeName() const noexcept        { return isLatencySleep() ? "VK_NV_low_latency2" : "VK_AMD_anti_lag"; }
+
+        private:
+            bool applySleepMode() noexcept;
+
+        private:
+            VkDevice                        m_vkDevice;
+            VkSwapchainKHR                  m_vkSwapchainKHR;
+
+            // low_latency2 entry points; null on the anti-lag path
+            PFN_vkSetLatencySleepModeNV     m_vkSetLatencySleepModeNV;
+            PFN_vkLatencySleepNV            m_vkLatencySleepNV;
+            PFN_vkSetLatencyMarkerNV        m_vkSetLatencyMarkerNV;
+            VulkanSemaphore                 m_sleepSemaphore;       // timeline the driver signals at the frame start
+            uint64_t                        m_sleepValue;
+            VkLatencySubmissionPresentIdNV  m_submissionInfo;
+
+            // anti-lag entry point; null on the low_latency2 path
+            PFN_vkAntiLagUpdateAMD          m_vkAntiLagUpdateAMD;
+
+            // frame state
+            uint64_t                        m_frameId;
+            bool                            m_isEnabled;
+            bool                            m_isBoost;
+    };
+}   // namespace keplar
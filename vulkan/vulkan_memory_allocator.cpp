@@ -0,0 +1,1128 @@
+// ────────────────────────────────────────────
+//  File: vulkan_memory_allocator.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_memory_allocator.hpp"
+
+#include <array>
+#include <bitset>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include "utils/logger.hpp"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace
+{
+    // tlsf layout: first level splits by power of two, second level splits each range linearly
+    static constexpr uint32_t      kSecondLevelLog2   = 5;
+    static constexpr uint32_t      kSecondLevelCount  = 1u << kSecondLevelLog2;
+    static constexpr uint32_t      kFirstLevelCount   = 64;
+    static constexpr VkDeviceSize  kSmallRegionSize   = 1ull << kSecondLevelLog2;
+    static constexpr VkDeviceSize  kMinRegionSize     = 256;
+    static constexpr uint32_t      kInvalidIndex      = UINT32_MAX;
+
+    // block sizing
+    static constexpr VkDeviceSize  kLargeHeapBlockSize = 256ull * 1024 * 1024;
+    static constexpr VkDeviceSize  kSmallHeapThreshold = 1024ull * 1024 * 1024;
+
+    // index of the most significant set bit (value must be non-zero)
+    inline uint32_t findMSB(uint64_t value) noexcept
+    {
+    #if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return static_cast<uint32_t>(index);
+    #else
+        return 63u - static_cast<uint32_t>(__builtin_clzll(value));
+    #endif
+    }
+
+    // index of the least significant set bit (value must be non-zero)
+    inline uint32_t findLSB(uint64_t value) noexcept
+    {
+    #if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return static_cast<uint32_t>(index);
+    #else
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+    #endif
+    }
+
+    inline VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+    {
+        return (alignment > 1) ? (value + alignment - 1) & ~(alignment - 1) : value;
+    }
+}
+
+namespace keplar
+{
+    // ─────────────────────────────────────────────
+    // device memory block with a two-level segregated fit (tlsf) free-list
+    // ─────────────────────────────────────────────
+    struct VulkanMemoryBlock
+    {
+        // contiguous range inside the block, linked physically and (when free) by size class
+        struct Region
+        {
+            VkDeviceSize mOffset;
+            VkDeviceSize mSize;
+            uint32_t     mPrevPhysical;
+            uint32_t     mNextPhysical;
+            uint32_t     mPrevFree;
+            uint32_t     mNextFree;
+            bool         mIsFree;
+            uint32_t     mGeneration;   // bumped whenever the slot is allocated or released
+
+            // what the live allocation asked for, so a defragmentation pass can place it again
+            VkDeviceSize         mRequestedSize;
+            VkDeviceSize         mAlignment;
+            VulkanMemoryCategory mCategory;
+            void*                mUserData;     // movable owner, nullptr while pinned
+        };
+
+        VkDeviceMemory  mMemory          = VK_NULL_HANDLE;
+        VkDeviceSize    mSize            = 0;
+        VkDeviceSize    mAllocatedBytes  = 0;
+        void*           mMappedData      = nullptr;
+        uint32_t        mMemoryTypeIndex = 0;
+        uint32_t        mPoolIndex       = 0;
+        uint64_t        mId              = 0;
+        uint32_t        mAllocationCount = 0;
+        bool            mIsDedicated     = false;
+        bool            mIsDraining      = false;   // source of the running defragmentation pass
+
+        // region storage and recycled slots
+        std::vector<Region>   mRegions;
+        std::vector<uint32_t> mUnusedRegions;
+
+        // tlsf bitmaps and free-list heads
+        uint64_t mFirstLevelBitmap = 0;
+        std::array<uint32_t, kFirstLevelCount> mSecondLevelBitmaps{};
+        std::array<std::array<uint32_t, kSecondLevelCount>, kFirstLevelCount> mFreeHeads{};
+
+        void reset(VkDeviceSize size) noexcept
+        {
+            mSize = size;
+            mAllocatedBytes = 0;
+            mAllocationCount = 0;
+            mRegions.clear();
+            mUnusedRegions.clear();
+            mFirstLevelBitmap = 0;
+            mSecondLevelBitmaps.fill(0);
+            for (auto& heads : mFreeHeads)
+            {
+                heads.fill(kInvalidIndex);
+            }
+
+            // whole block starts as one free region
+            const uint32_t index = createRegion(0, size);
+            insertFree(index);
+        }
+
+        bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset, uint32_t& regionIndex) noexcept
+        {
+            // reserve worst-case padding so any region found is guaranteed to fit after alignment
+            size = alignUp(std::max(size, kMinRegionSize), kMinRegionSize);
+            const VkDeviceSize searchSize = size + ((alignment > 1) ? alignment - 1 : 0);
+            if (searchSize > mSize - mAllocatedBytes)
+            {
+                return false;
+            }
+
+            const uint32_t index = findFree(searchSize);
+            if (index == kInvalidIndex)
+            {
+                return false;
+            }
+            removeFree(index);
+
+            // split off leading padding as its own free region
+            const VkDeviceSize alignedOffset = alignUp(mRegions[index].mOffset, alignment);
+            const VkDeviceSize padding = alignedOffset - mRegions[index].mOffset;
+            if (padding > 0)
+            {
+                const uint32_t front = createRegion(mRegions[index].mOffset, padding);
+                linkBefore(front, index);
+                mRegions[index].mOffset = alignedOffset;
+                mRegions[index].mSize  -= padding;
+                insertFree(front);
+            }
+
+            // split off the tail when it is large enough to be reused
+            const VkDeviceSize remaining = mRegions[index].mSize - size;
+            if (remaining >= kMinRegionSize)
+            {
+                const uint32_t back = createRegion(mRegions[index].mOffset + size, remaining);
+                linkAfter(back, index);
+                mRegions[index].mSize = size;
+                insertFree(back);
+            }
+
+            // mark region as used
+            mRegions[index].mIsFree = false;
+            mRegions[index].mGeneration++;
+            mAllocatedBytes += mRegions[index].mSize;
+            mAllocationCount++;
+
+            mRegions[index].mAlignment = std::max<VkDeviceSize>(1, alignment);
+            mRegions[index].mUserData = nullptr;
+
+            offset = mRegions[index].mOffset;
+            regionIndex = index;
+            return true;
+        }
+
+        uint32_t allocateWhole() noexcept
+        {
+            // dedicated blocks hold exactly one resource: the initial region at offset zero
+            const uint32_t index = 0;
+            removeFree(index);
+            mRegions[index].mIsFree = false;
+            mRegions[index].mGeneration++;
+            mAllocatedBytes = mSize;
+            mAllocationCount = 1;
+            return index;
+        }
+
+        // false for a handle whose region was freed since, whether it is still free, merged into a neighbour or taken
+        // over by a later allocation
+        bool isLive(uint32_t index, uint32_t generation) const noexcept
+        {
+            return index < mRegions.size() && !mRegions[index].mIsFree && mRegions[index].mGeneration == generation;
+        }
+
+        void free(uint32_t index) noexcept
+        {
+            mAllocatedBytes -= mRegions[index].mSize;
+            mAllocationCount--;
+            mRegions[index].mIsFree = true;
+            mRegions[index].mUserData = nullptr;
+
+            // coalesce with the previous physical neighbour
+            const uint32_t prev = mRegions[index].mPrevPhysical;
+            if (prev != kInvalidIndex && mRegions[prev].mIsFree)
+            {
+                removeFree(prev);
+                mRegions[prev].mSize += mRegions[index].mSize;
+                unlink(index);
+                releaseRegion(index);
+                index = prev;
+            }
+
+            // coalesce with the next physical neighbour
+            const uint32_t next = mRegions[index].mNextPhysical;
+            if (next != kInvalidIndex && mRegions[next].mIsFree)
+            {
+                removeFree(next);
+                mRegions[index].mSize += mRegions[next].mSize;
+                unlink(next);
+                releaseRegion(next);
+            }
+
+            insertFree(index);
+        }
+
+        bool isEmpty() const noexcept { return mAllocationCount == 0; }
+
+        // region 0 starts at offset zero and is never released, so the physical chain always begins there
+        uint32_t getFirstRegion() const noexcept { return 0; }
+
+        void fillAllocation(uint32_t index, VulkanAllocation& allocation) const noexcept
+        {
+            const Region& region = mRegions[index];
+            allocation.mMemory          = mMemory;
+            allocation.mOffset          = region.mOffset;
+            allocation.mSize            = region.mRequestedSize;
+            allocation.mMappedData      = mMappedData ? static_cast<uint8_t*>(mMappedData) + region.mOffset : nullptr;
+            allocation.mMemoryTypeIndex = mMemoryTypeIndex;
+            allocation.mCategory        = region.mCategory;
+            allocation.mBlock           = const_cast<VulkanMemoryBlock*>(this);
+            allocation.mBlockId         = mId;
+            allocation.mRegionIndex     = index;
+            allocation.mRegionGeneration = region.mGeneration;
+        }
+
+        // walks the non-empty size classes only
+        void collectFreeStats(uint32_t& freeRegionCount, VkDeviceSize& freeBytes, VkDeviceSize& largestFreeRegion) const noexcept
+        {
+            uint64_t firstLevelMap = mFirstLevelBitmap;
+            while (firstLevelMap != 0)
+            {
+                const uint32_t firstLevel = findLSB(firstLevelMap);
+                firstLevelMap &= firstLevelMap - 1;
+
+                uint32_t secondLevelMap = mSecondLevelBitmaps[firstLevel];
+                while (secondLevelMap != 0)
+                {
+                    const uint32_t secondLevel = findLSB(secondLevelMap);
+                    secondLevelMap &= secondLevelMap - 1;
+                    for (uint32_t index = mFreeHeads[firstLevel][secondLevel]; index != kInvalidIndex; index = mRegions[index].mNextFree)
+                    {
+                        freeRegionCount++;
+                        freeBytes += mRegions[index].mSize;
+                        largestFreeRegion = std::max(largestFreeRegion, mRegions[index].mSize);
+                    }
+                }
+            }
+        }
+
+    private:
+        // size class used when inserting a free region
+        static void mappingInsert(VkDeviceSize size, uint32_t& firstLevel, uint32_t& secondLevel) noexcept
+        {
+            if (size < kSmallRegionSize)
+            {
+                firstLevel  = 0;
+                secondLevel = static_cast<uint32_t>(size);
+                return;
+            }
+
+            const uint32_t msb = findMSB(size);
+            firstLevel  = msb - kSecondLevelLog2 + 1;
+            secondLevel = static_cast<uint32_t>(size >> (msb - kSecondLevelLog2)) ^ kSecondLevelCount;
+        }
+
+        // size class used when searching: rounds up so every region in the class fits
+        static void mappingSearch(VkDeviceSize size, uint32_t& firstLevel, uint32_t& secondLevel) noexcept
+        {
+            if (size >= kSmallRegionSize)
+            {
+                size += (1ull << (findMSB(size) - kSecondLevelLog2)) - 1;
+            }
+            mappingInsert(size, firstLevel, secondLevel);
+        }
+
+        uint32_t findFree(VkDeviceSize size) const noexcept
+        {
+            uint32_t firstLevel = 0;
+            uint32_t secondLevel = 0;
+            mappingSearch(size, firstLevel, secondLevel);
+            if (firstLevel >= kFirstLevelCount)
+            {
+                return kInvalidIndex;
+            }
+
+            // look for a non-empty list in the same first level, then in larger ones
+            uint32_t secondLevelMap = mSecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+            if (secondLevelMap == 0)
+            {
+                const uint64_t firstLevelMap = (firstLevel + 1 < kFirstLevelCount) ? mFirstLevelBitmap & (~0ull << (firstLevel + 1)) : 0;
+                if (firstLevelMap == 0)
+                {
+                    return kInvalidIndex;
+                }
+
+                firstLevel = findLSB(firstLevelMap);
+                secondLevelMap = mSecondLevelBitmaps[firstLevel];
+            }
+
+            secondLevel = findLSB(secondLevelMap);
+            return mFreeHeads[firstLevel][secondLevel];
+        }
+
+        void insertFree(uint32_t index) noexcept
+        {
+            uint32_t firstLevel = 0;
+            uint32_t secondLevel = 0;
+            mappingInsert(mRegions[index].mSize, firstLevel, secondLevel);
+
+            // push to the front of the size class list
+            const uint32_t head = mFreeHeads[firstLevel][secondLevel];
+            mRegions[index].mIsFree   = true;
+            mRegions[index].mPrevFree = kInvalidIndex;
+            mRegions[index].mNextFree = head;
+            if (head != kInvalidIndex)
+            {
+                mRegions[head].mPrevFree = index;
+            }
+
+            mFreeHeads[firstLevel][secondLevel] = index;
+            mFirstLevelBitmap |= (1ull << firstLevel);
+            mSecondLevelBitmaps[firstLevel] |= (1u << secondLevel);
+        }
+
+        void removeFree(uint32_t index) noexcept
+        {
+            uint32_t firstLevel = 0;
+            uint32_t secondLevel = 0;
+            mappingInsert(mRegions[index].mSize, firstLevel, secondLevel);
+
+            const uint32_t prev = mRegions[index].mPrevFree;
+            const uint32_t next = mRegions[index].mNextFree;
+            if (prev != kInvalidIndex) { mRegions[prev].mNextFree = next; }
+            if (next != kInvalidIndex) { mRegions[next].mPrevFree = prev; }
+
+            // update head and clear bitmaps when the list becomes empty
+            if (mFreeHeads[firstLevel][secondLevel] == index)
+            {
+                mFreeHeads[firstLevel][secondLevel] = next;
+                if (next == kInvalidIndex)
+                {
+                    mSecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+                    if (mSecondLevelBitmaps[firstLevel] == 0)
+                    {
+                        mFirstLevelBitmap &= ~(1ull << firstLevel);
+                    }
+                }
+            }
+
+            mRegions[index].mPrevFree = kInvalidIndex;
+            mRegions[index].mNextFree = kInvalidIndex;
+        }
+
+        uint32_t createRegion(VkDeviceSize offset, VkDeviceSize size) noexcept
+        {
+            Region region{ offset, size, kInvalidIndex, kInvalidIndex, kInvalidIndex, kInvalidIndex, true, 0,
+                           0, 1, VulkanMemoryCategory::kBuffer, nullptr };
+            if (!mUnusedRegions.empty())
+            {
+                // a recycled slot keeps counting, so handles from its previous use stay stale
+                const uint32_t index = mUnusedRegions.back();
+                mUnusedRegions.pop_back();
+                region.mGeneration = mRegions[index].mGeneration;
+                mRegions[index] = region;
+                return index;
+            }
+
+            mRegions.emplace_back(region);
+            return static_cast<uint32_t>(mRegions.size() - 1);
+        }
+
+        void releaseRegion(uint32_t index) noexcept
+        {
+            mRegions[index].mIsFree = false;
+            mRegions[index].mGeneration++;
+            mUnusedRegions.emplace_back(index);
+        }
+
+        void linkBefore(uint32_t index, uint32_t anchor) noexcept
+        {
+            const uint32_t prev = mRegions[anchor].mPrevPhysical;
+            mRegions[index].mPrevPhysical = prev;
+            mRegions[index].mNextPhysical = anchor;
+            mRegions[anchor].mPrevPhysical = index;
+            if (prev != kInvalidIndex) { mRegions[prev].mNextPhysical = index; }
+        }
+
+        void linkAfter(uint32_t index, uint32_t anchor) noexcept
+        {
+            const uint32_t next = mRegions[anchor].mNextPhysical;
+            mRegions[index].mPrevPhysical = anchor;
+            mRegions[index].mNextPhysical = next;
+            mRegions[anchor].mNextPhysical = index;
+            if (next != kInvalidIndex) { mRegions[next].mPrevPhysical = index; }
+        }
+
+        void unlink(uint32_t index) noexcept
+        {
+            const uint32_t prev = mRegions[index].mPrevPhysical;
+            const uint32_t next = mRegions[index].mNextPhysical;
+            if (prev != kInvalidIndex) { mRegions[prev].mNextPhysical = next; }
+            if (next != kInvalidIndex) { mRegions[next].mPrevPhysical = prev; }
+        }
+    };
+
+    // ─────────────────────────────────────────────
+    // VulkanMemoryAllocator implementation
+    // ─────────────────────────────────────────────
+    VulkanMemoryAllocator::VulkanMemoryAllocator() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_memoryProperties{}
+        , m_nonCoherentAtomSize(1)
+        , m_isDeviceAddressEnabled(false)
+        , m_isDefragmenting(false)
+        , m_nextBlockId(1)
+        , m_categoryStats{}
+    {
+    }
+
+    VulkanMemoryAllocator::~VulkanMemoryAllocator()
+    {
+        destroy();
+    }
+
+    bool VulkanMemoryAllocator::initialize(VkDevice vkDevice, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize nonCoherentAtomSize,
+                                           bool isDeviceAddressEnabled) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanMemoryAllocator::initialize :: invalid device handle");
+            return false;
+        }
+
+        // one linear and one optimal pool per memory type
+        m_vkDevice = vkDevice;
+        m_memoryProperties = memoryProperties;
+        m_nonCoherentAtomSize = std::max<VkDeviceSize>(1, nonCoherentAtomSize);
+        m_isDeviceAddressEnabled = isDeviceAddressEnabled;
+        m_pools.resize(static_cast<size_t>(m_memoryProperties.memoryTypeCount) * 2);
+
+        VK_LOG_DEBUG("VulkanMemoryAllocator::initialize successful (memory types: %u)", m_memoryProperties.memoryTypeCount);
+        return true;
+    }
+
+    void VulkanMemoryAllocator::destroy() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // release every block; resources still alive at this point are leaks
+        for (auto& pool : m_pools)
+        {
+            for (auto& block : pool.mBlocks)
+            {
+                if (!block->isEmpty())
+                {
+                    VK_LOG_WARN("VulkanMemoryAllocator::destroy :: block released with %u live allocations (%llu bytes)",
+                                block->mAllocationCount, static_cast<unsigned long long>(block->mAllocatedBytes));
+                }
+                destroyBlock(*block);
+            }
+            pool.mBlocks.clear();
+        }
+        m_categoryStats = {};
+        m_isDefragmenting = false;
+
+        if (m_vkDevice != VK_NULL_HANDLE)
+        {
+            m_pools.clear();
+            m_vkDevice = VK_NULL_HANDLE;
+            VK_LOG_DEBUG("vulkan memory allocator destroyed successfully");
+        }
+    }
+
+    bool VulkanMemoryAllocator::allocateBufferMemory(VkBuffer vkBuffer, VkMemoryPropertyFlags propertyFlags, VulkanAllocation& allocation,
+                                                     VkMemoryPropertyFlags preferredFlags, VulkanMemoryCategory category) noexcept
+    {
+        // query memory requirements
+        VkMemoryRequirements memoryRequirements{};
+        vkGetBufferMemoryRequirements(m_vkDevice, vkBuffer, &memoryRequirements);
+
+        // sub-allocate from a linear pool
+        if (!allocate(memoryRequirements, propertyFlags, preferredFlags, true, category, allocation))
+        {
+            return false;
+        }
+
+        // bind memory to buffer
+        VkResult vkResult = vkBindBufferMemory(m_vkDevice, vkBuffer, allocation.mMemory, allocation.mOffset);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkBindBufferMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            free(allocation);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool VulkanMemoryAllocator::allocateImageMemory(VkImage vkImage, VkMemoryPropertyFlags propertyFlags, VulkanAllocation& allocation,
+                                                    VulkanMemoryCategory category) noexcept
+    {
+        // query memory requirements
+        VkMemoryRequirements memoryRequirements{};
+        vkGetImageMemoryRequirements(m_vkDevice, vkImage, &memoryRequirements);
+
+        // sub-allocate from an optimal-tiling pool
+        if (!allocate(memoryRequirements, propertyFlags, 0, false, category, allocation))
+        {
+            return false;
+        }
+
+        // bind memory to image
+        VkResult vkResult = vkBindImageMemory(m_vkDevice, vkImage, allocation.mMemory, allocation.mOffset);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkBindImageMemory failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            free(allocation);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool VulkanMemoryAllocator::allocateImageMemory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags propertyFlags, VulkanAllocation& allocation,
+                                                    VulkanMemoryCategory category) noexcept
+    {
+        // unbound optimal-tiling range; callers bind one or more (aliased) images into it
+        return allocate(requirements, propertyFlags, 0, false, category, allocation);
+    }
+
+    void VulkanMemoryAllocator::free(VulkanAllocation& allocation) noexcept
+    {
+        // nothing to release
+        if (allocation.mBlock == nullptr)
+        {
+            allocation = VulkanAllocation{};
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        release(allocation);
+    }
+
+    void VulkanMemoryAllocator::setMovable(const VulkanAllocation& allocation, void* userData) noexcept
+    {
+        if (allocation.mBlock == nullptr)
+        {
+            return;
+        }
+
+        // dedicated blocks are never drained, their allocations stay pinned
+        std::lock_guard<std::mutex> lock(m_mutex);
+        VulkanMemoryBlock* block = findBlock(allocation);
+        if (block != nullptr && !block->mIsDedicated && block->isLive(allocation.mRegionIndex, allocation.mRegionGeneration))
+        {
+            block->mRegions[allocation.mRegionIndex].mUserData = userData;
+        }
+    }
+
+    bool VulkanMemoryAllocator::beginDefragmentationPass(VkDeviceSize maxBytes, uint32_t maxMoves, std::vector<VulkanDefragmentationMove>& moves) noexcept
+    {
+        moves.clear();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isDefragmenting)
+        {
+            VK_LOG_WARN("VulkanMemoryAllocator::beginDefragmentationPass :: the previous pass has not ended");
+            return false;
+        }
+
+        VkDeviceSize movedBytes = 0;
+        std::vector<VulkanMemoryBlock*> blocks;
+        for (auto& pool : m_pools)
+        {
+            if (moves.size() >= maxMoves || movedBytes >= maxBytes)
+            {
+                break;
+            }
+
+            // non-empty shared blocks, emptiest first
+            blocks.clear();
+            for (auto& block : pool.mBlocks)
+            {
+                if (!block->mIsDedicated && !block->isEmpty())
+                {
+                    blocks.push_back(block.get());
+                }
+            }
+            if (blocks.size() < 2)
+            {
+                continue;
+            }
+            std::sort(blocks.begin(), blocks.end(), [](const VulkanMemoryBlock* a, const VulkanMemoryBlock* b) { return a->mAllocatedBytes < b->mAllocatedBytes; });
+
+            // drain the emptiest block whose contents the others can hold; moving out of a block that cannot empty
+            // only shuffles the fragmentation around
+            VulkanMemoryBlock* source = nullptr;
+            for (size_t candidate = 0; candidate < blocks.size() && source == nullptr; ++candidate)
+            {
+                VkDeviceSize freeElsewhere = 0;
+                for (size_t other = 0; other < blocks.size(); ++other)
+                {
+                    freeElsewhere += (other != candidate) ? blocks[other]->mSize - blocks[other]->mAllocatedBytes : 0;
+                }
+
+                bool hasMovable = false;
+                for (uint32_t index = blocks[candidate]->getFirstRegion(); index != kInvalidIndex && !hasMovable; index = blocks[candidate]->mRegions[index].mNextPhysical)
+                {
+                    hasMovable = !blocks[candidate]->mRegions[index].mIsFree && blocks[candidate]->mRegions[index].mUserData != nullptr;
+                }
+
+                if (hasMovable && blocks[candidate]->mAllocatedBytes <= freeElsewhere)
+                {
+                    source = blocks[candidate];
+                }
+            }
+            if (source == nullptr)
+            {
+                continue;
+            }
+
+            // reserve destinations in the fullest blocks first, so free space gathers in the emptiest ones
+            source->mIsDraining = true;
+            for (uint32_t index = source->getFirstRegion(); index != kInvalidIndex; index = source->mRegions[index].mNextPhysical)
+            {
+                const auto& region = source->mRegions[index];
+                if (region.mIsFree || region.mUserData == nullptr)
+                {
+                    continue;
+                }
+                if (moves.size() >= maxMoves || movedBytes + region.mRequestedSize > maxBytes)
+                {
+                    break;
+                }
+
+                for (auto it = blocks.rbegin(); it != blocks.rend(); ++it)
+                {
+                    VulkanMemoryBlock* destination = *it;
+                    VkDeviceSize offset = 0;
+                    uint32_t regionIndex = 0;
+                    if (destination == source || destination->mIsDraining ||
+                        !destination->allocate(region.mRequestedSize, region.mAlignment, offset, regionIndex))
+                    {
+                        continue;
+                    }
+
+                    destination->mRegions[regionIndex].mRequestedSize = region.mRequestedSize;
+                    destination->mRegions[regionIndex].mCategory = region.mCategory;
+                    destination->mRegions[regionIndex].mUserData = region.mUserData;
+
+                    VulkanDefragmentationMove& move = moves.emplace_back();
+                    source->fillAllocation(index, move.mSource);
+                    destination->fillAllocation(regionIndex, move.mDestination);
+                    move.mUserData = region.mUserData;
+
+                    // both ranges are live until the pass ends
+                    VulkanMemoryCategoryStats& categoryStats = m_categoryStats[static_cast<size_t>(region.mCategory)];
+                    categoryStats.mAllocationCount++;
+                    categoryStats.mAllocatedBytes += region.mRequestedSize;
+                    categoryStats.mPeakBytes = std::max(categoryStats.mPeakBytes, categoryStats.mAllocatedBytes);
+                    movedBytes += region.mRequestedSize;
+                    break;
+                }
+            }
+        }
+
+        // nothing fit the budget: the pass never started
+        if (moves.empty())
+        {
+            clearDraining();
+            return false;
+        }
+
+        m_isDefragmenting = true;
+        VK_LOG_DEBUG("VulkanMemoryAllocator::beginDefragmentationPass :: %zu moves (%llu bytes)", moves.size(),
+                     static_cast<unsigned long long>(movedBytes));
+        return true;
+    }
+
+    void VulkanMemoryAllocator::endDefragmentationPass(std::vector<VulkanDefragmentationMove>& moves) noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isDefragmenting)
+        {
+            return;
+        }
+
+        // drained blocks that end up empty are released like any other by release()
+        clearDraining();
+        for (VulkanDefragmentationMove& move : moves)
+        {
+            release(move.mIsCanceled ? move.mDestination : move.mSource);
+        }
+
+        moves.clear();
+        m_isDefragmenting = false;
+    }
+
+    void VulkanMemoryAllocator::clearDraining() noexcept
+    {
+        for (auto& pool : m_pools)
+        {
+            for (auto& block : pool.mBlocks)
+            {
+                block->mIsDraining = false;
+            }
+        }
+    }
+
+    void VulkanMemoryAllocator::release(VulkanAllocation& allocation) noexcept
+    {
+        // a double free, or the free of a copy of a handle already freed: the region may belong to another allocation by
+        // now, which must stay untouched (as must the stats), or its block may have been destroyed
+        VulkanMemoryBlock* block = findBlock(allocation);
+        if (block == nullptr || !block->isLive(allocation.mRegionIndex, allocation.mRegionGeneration))
+        {
+            VK_LOG_ERROR("VulkanMemoryAllocator::release :: stale allocation (block %llu, region %u, generation %u), ignored",
+                         static_cast<unsigned long long>(allocation.mBlockId), allocation.mRegionIndex, allocation.mRegionGeneration);
+            allocation = VulkanAllocation{};
+            return;
+        }
+
+        VulkanMemoryCategoryStats& categoryStats = m_categoryStats[static_cast<size_t>(allocation.mCategory)];
+        categoryStats.mAllocationCount--;
+        categoryStats.mAllocatedBytes -= allocation.mSize;
+        block->free(allocation.mRegionIndex);
+
+        // release dedicated blocks immediately, keep one empty block per pool to avoid thrashing
+        if (block->isEmpty())
+        {
+            auto& blocks = m_pools[block->mPoolIndex].mBlocks;
+            const auto emptyBlocks = std::count_if(blocks.begin(), blocks.end(), [](const auto& b) { return b->isEmpty() && !b->mIsDedicated; });
+            if (block->mIsDedicated || emptyBlocks > 1)
+            {
+                destroyBlock(*block);
+                blocks.erase(std::find_if(blocks.begin(), blocks.end(), [block](const auto& b) { return b.get() == block; }));
+            }
+        }
+
+        allocation = VulkanAllocation{};
+    }
+
+    bool VulkanMemoryAllocator::flush(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const noexcept
+    {
+        if (!allocation.isValid() || isHostCoherent(allocation))
+        {
+            return true;
+        }
+
+        const VkMappedMemoryRange range = getMappedRange(allocation, offset, size);
+        VkResult vkResult = vkFlushMappedMemoryRanges(m_vkDevice, 1, &range);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkFlushMappedMemoryRanges failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanMemoryAllocator::invalidate(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const noexcept
+    {
+        if (!allocation.isValid() || isHostCoherent(allocation))
+        {
+            return true;
+        }
+
+        const VkMappedMemoryRange range = getMappedRange(allocation, offset, size);
+        VkResult vkResult = vkInvalidateMappedMemoryRanges(m_vkDevice, 1, &range);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkInvalidateMappedMemoryRanges failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    VkMemoryPropertyFlags VulkanMemoryAllocator::getPropertyFlags(const VulkanAllocation& allocation) const noexcept
+    {
+        return allocation.isValid() ? m_memoryProperties.memoryTypes[allocation.mMemoryTypeIndex].propertyFlags : 0;
+    }
+
+    bool VulkanMemoryAllocator::isHostCoherent(const VulkanAllocation& allocation) const noexcept
+    {
+        return (getPropertyFlags(allocation) & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    }
+
+    VulkanMemoryStats VulkanMemoryAllocator::getStats() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        VulkanMemoryStats stats{};
+        for (const auto& pool : m_pools)
+        {
+            for (const auto& block : pool.mBlocks)
+            {
+                stats.mBlockCount++;
+                stats.mAllocationCount += block->mAllocationCount;
+                stats.mBlockBytes      += block->mSize;
+                stats.mAllocatedBytes  += block->mAllocatedBytes;
+                stats.mHeapBlockBytes[m_memoryProperties.memoryTypes[block->mMemoryTypeIndex].heapIndex] += block->mSize;
+
+                // dedicated blocks are never partially free
+                if (!block->mIsDedicated)
+                {
+                    block->collectFreeStats(stats.mFreeRegionCount, stats.mFreeBytes, stats.mLargestFreeRegion);
+                }
+            }
+        }
+
+        stats.mCategories = m_categoryStats;
+        return stats;
+    }
+
+    bool VulkanMemoryAllocator::writeStatsJson(const std::filesystem::path& filepath, const std::vector<MemoryBudget>& heapBudgets) const noexcept
+    {
+        // ensure the output directory exists
+        std::error_code errorCode;
+        if (filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(filepath.parent_path(), errorCode);
+        }
+
+        std::ofstream file(filepath, std::ios::trunc);
+        if (!file)
+        {
+            VK_LOG_ERROR("VulkanMemoryAllocator::writeStatsJson : failed to open %s", filepath.string().c_str());
+            return false;
+        }
+
+        // totals, then free space, then one object per category and per heap (bytes)
+        const VulkanMemoryStats stats = getStats();
+        file << std::fixed << std::setprecision(4);
+        file << "{\n";
+        file << "  \"block_count\": " << stats.mBlockCount << ",\n";
+        file << "  \"allocation_count\": " << stats.mAllocationCount << ",\n";
+        file << "  \"block_bytes\": " << stats.mBlockBytes << ",\n";
+        file << "  \"allocated_bytes\": " << stats.mAllocatedBytes << ",\n";
+        file << "  \"free_regions\": " << stats.mFreeRegionCount << ",\n";
+        file << "  \"free_bytes\": " << stats.mFreeBytes << ",\n";
+        file << "  \"largest_free_region\": " << stats.mLargestFreeRegion << ",\n";
+        file << "  \"fragmentation\": " << stats.getFragmentation() << ",\n";
+
+        file << "  \"categories\": {";
+        for (size_t category = 0; category < stats.mCategories.size(); ++category)
+        {
+            const VulkanMemoryCategoryStats& categoryStats = stats.mCategories[category];
+            file << (category == 0 ? "\n" : ",\n");
+            file << "    \"" << getMemoryCategoryName(static_cast<VulkanMemoryCategory>(category)) << "\": { "
+                 << "\"allocations\": " << categoryStats.mAllocationCount << ", "
+                 << "\"bytes\": " << categoryStats.mAllocatedBytes << ", "
+                 << "\"peak_bytes\": " << categoryStats.mPeakBytes << " }";
+        }
+        file << "\n  },\n";
+
+        file << "  \"heaps\": [";
+        for (uint32_t heap = 0; heap < static_cast<uint32_t>(heapBudgets.size()) && heap < m_memoryProperties.memoryHeapCount; ++heap)
+        {
+            const MemoryBudget& heapBudget = heapBudgets[heap];
+            const bool isDeviceLocal = (m_memoryProperties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+            file << (heap == 0 ? "\n" : ",\n");
+            file << "    { \"index\": " << heap << ", "
+                 << "\"device_local\": " << (isDeviceLocal ? "true" : "false") << ", "
+                 << "\"size\": " << heapBudget.mHeapSize << ", "
+                 << "\"budget\": " << heapBudget.mBudget << ", "
+                 << "\"usage\": " << heapBudget.mUsage << ", "
+                 << "\"allocator_block_bytes\": " << stats.mHeapBlockBytes[heap] << ", "
+                 << "\"reported\": " << (heapBudget.mIsReported ? "true" : "false") << " }";
+        }
+        file << "\n  ]\n}\n";
+
+        VK_LOG_INFO("VulkanMemoryAllocator::writeStatsJson : %u allocations written to %s", stats.mAllocationCount, filepath.string().c_str());
+        return static_cast<bool>(file);
+    }
+
+    bool VulkanMemoryAllocator::allocate(const VkMemoryRequirements& memoryRequirements, VkMemoryPropertyFlags propertyFlags, VkMemoryPropertyFlags preferredFlags,
+                                         bool isLinear, VulkanMemoryCategory category, VulkanAllocation& allocation) noexcept
+    {
+        // find suitable memory type
+        auto memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags, preferredFlags);
+        if (!memoryTypeIndex.has_value())
+        {
+            VK_LOG_ERROR("VulkanMemoryAllocator::allocate :: no suitable memory type for properties: %s", string_VkMemoryPropertyFlags(propertyFlags).c_str());
+            return false;
+        }
+
+        // non-coherent ranges are flushed in whole atoms, so no two allocations may share one:
+        // an invalidate would otherwise discard a neighbour's unflushed writes
+        VkMemoryRequirements requirements = memoryRequirements;
+        const VkMemoryPropertyFlags typeFlags = m_memoryProperties.memoryTypes[*memoryTypeIndex].propertyFlags;
+        if ((typeFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(typeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+        {
+            requirements.alignment = std::max(requirements.alignment, m_nonCoherentAtomSize);
+            requirements.size = alignUp(requirements.size, m_nonCoherentAtomSize);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint32_t poolIndex = *memoryTypeIndex * 2 + (isLinear ? 1 : 0);
+        auto& pool = m_pools[poolIndex];
+
+        // lazily allocated memory and requests larger than half a block get their own allocation
+        const VkDeviceSize blockSize = getPreferredBlockSize(*memoryTypeIndex);
+        const bool isLazy = (m_memoryProperties.memoryTypes[*memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+        const bool isDedicated = isLazy || requirements.size > blockSize / 2;
+
+        VulkanMemoryBlock* block = nullptr;
+        VkDeviceSize offset = 0;
+        uint32_t regionIndex = 0;
+
+        // try existing blocks first, except those a defragmentation pass is emptying
+        if (!isDedicated)
+        {
+            for (auto& candidate : pool.mBlocks)
+            {
+                if (!candidate->mIsDedicated && !candidate->mIsDraining && candidate->allocate(requirements.size, requirements.alignment, offset, regionIndex))
+                {
+                    block = candidate.get();
+                    break;
+                }
+            }
+        }
+
+        // grow the pool with a new block
+        if (block == nullptr)
+        {
+            block = createBlock(*memoryTypeIndex, isDedicated ? requirements.size : blockSize, isDedicated);
+            if (block == nullptr)
+            {
+                return false;
+            }
+
+            block->mPoolIndex = poolIndex;
+            pool.mBlocks.emplace_back(block);
+
+            if (isDedicated)
+            {
+                regionIndex = block->allocateWhole();
+            }
+            else if (!block->allocate(requirements.size, requirements.alignment, offset, regionIndex))
+            {
+                VK_LOG_ERROR("VulkanMemoryAllocator::allocate :: new block cannot hold %llu bytes", static_cast<unsigned long long>(requirements.size));
+                return false;
+            }
+        }
+
+        // fill allocation
+        allocation.mMemory          = block->mMemory;
+        allocation.mOffset          = offset;
+        allocation.mSize            = requirements.size;
+        allocation.mMappedData      = block->mMappedData ? static_cast<uint8_t*>(block->mMappedData) + offset : nullptr;
+        allocation.mMemoryTypeIndex = *memoryTypeIndex;
+        allocation.mCategory        = category;
+        allocation.mBlock           = block;
+        allocation.mBlockId         = block->mId;
+        allocation.mRegionIndex     = regionIndex;
+        allocation.mRegionGeneration = block->mRegions[regionIndex].mGeneration;
+        block->mRegions[regionIndex].mRequestedSize = requirements.size;
+        block->mRegions[regionIndex].mCategory = category;
+
+        // account the requested size; free() subtracts the same
+        VulkanMemoryCategoryStats& categoryStats = m_categoryStats[static_cast<size_t>(category)];
+        categoryStats.mAllocationCount++;
+        categoryStats.mAllocatedBytes += requirements.size;
+        categoryStats.mPeakBytes = std::max(categoryStats.mPeakBytes, categoryStats.mAllocatedBytes);
+        return true;
+    }
+
+    VulkanMemoryBlock* VulkanMemoryAllocator::createBlock(uint32_t memoryTypeIndex, VkDeviceSize size, bool isDedicated) noexcept
+    {
+        // memory allocation info
+        VkMemoryAllocateInfo allocateInfo{};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.allocationSize = size;
+        allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+        // buffers sub-allocated from the block may be created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+        VkMemoryAllocateFlagsInfo allocateFlagsInfo{};
+        allocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        allocateFlagsInfo.pNext = nullptr;
+        allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        if (m_isDeviceAddressEnabled)
+        {
+            allocateInfo.pNext = &allocateFlagsInfo;
+        }
+
+        // allocate device memory from vulkan heap
+        VkDeviceMemory vkDeviceMemory = VK_NULL_HANDLE;
+        VkResult vkResult = vkAllocateMemory(m_vkDevice, &allocateInfo, nullptr, &vkDeviceMemory);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkAllocateMemory failed for memory block (%llu bytes) : %s (code: %d)", static_cast<unsigned long long>(size), string_VkResult(vkResult), vkResult);
+            return nullptr;
+        }
+
+        // host-visible blocks stay mapped for their whole lifetime
+        void* mappedData = nullptr;
+        if (m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            vkResult = vkMapMemory(m_vkDevice, vkDeviceMemory, 0, VK_WHOLE_SIZE, 0, &mappedData);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("vkMapMemory failed for memory block : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                vkFreeMemory(m_vkDevice, vkDeviceMemory, nullptr);
+                return nullptr;
+            }
+        }
+
+        auto* block = new VulkanMemoryBlock();
+        block->mMemory = vkDeviceMemory;
+        block->mMappedData = mappedData;
+        block->mMemoryTypeIndex = memoryTypeIndex;
+        block->mIsDedicated = isDedicated;
+        block->mId = m_nextBlockId++;
+        block->reset(size);
+
+        VK_LOG_DEBUG("VulkanMemoryAllocator :: allocated %s block (type: %u, size: %llu)",
+                     isDedicated ? "dedicated" : "shared", memoryTypeIndex, static_cast<unsigned long long>(size));
+        return block;
+    }
+
+    void VulkanMemoryAllocator::destroyBlock(VulkanMemoryBlock& block) noexcept
+    {
+        if (block.mMappedData)
+        {
+            vkUnmapMemory(m_vkDevice, block.mMemory);
+            block.mMappedData = nullptr;
+        }
+
+        if (block.mMemory != VK_NULL_HANDLE)
+        {
+            vkFreeMemory(m_vkDevice, block.mMemory, nullptr);
+            block.mMemory = VK_NULL_HANDLE;
+        }
+    }
+
+    VulkanMemoryBlock* VulkanMemoryAllocator::findBlock(const VulkanAllocation& allocation) const noexcept
+    {
+        // caller holds m_mutex. only blocks the pools still own are dereferenced: the handle's pointer may be dangling,
+        // or name a newer block at the address of a destroyed one, which the id tells apart
+        const size_t poolIndex = static_cast<size_t>(allocation.mMemoryTypeIndex) * 2;
+        for (size_t i = poolIndex; i < poolIndex + 2 && i < m_pools.size(); ++i)
+        {
+            for (const auto& block : m_pools[i].mBlocks)
+            {
+                if (block.get() == allocation.mBlock && block->mId == allocation.mBlockId)
+                {
+                    return block.get();
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    std::optional<uint32_t> VulkanMemoryAllocator::findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags propertyFlags, VkMemoryPropertyFlags preferredFlags) const noexcept
+    {
+        // the first compatible type with the most preferred properties
+        std::optional<uint32_t> bestType;
+        uint32_t bestScore = 0;
+        for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++)
+        {
+            bool isCompatibleType = (memoryTypeBits & (1 << i)) != 0;
+            bool hasRequiredProperties = (m_memoryProperties.memoryTypes[i].propertyFlags & propertyFlags) == propertyFlags;
+            if (!isCompatibleType || !hasRequiredProperties)
+            {
+                continue;
+            }
+
+            const uint32_t score = static_cast<uint32_t>(std::bitset<32>(m_memoryProperties.memoryTypes[i].propertyFlags & preferredFlags).count());
+            if (!bestType.has_value() || score > bestScore)
+            {
+                bestType = i;
+                bestScore = score;
+            }
+        }
+
+        return bestType;
+    }
+
+    VkMappedMemoryRange VulkanMemoryAllocator::getMappedRange(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const noexcept
+    {
+        // whole atoms around the range; allocations own every atom they touch, a range reaching the block end uses VK_WHOLE_SIZE
+        const VkDeviceSize begin = allocation.mOffset + offset;
+        const VkDeviceSize end = (size == VK_WHOLE_SIZE) ? allocation.mOffset + allocation.mSize : begin + size;
+        const VkDeviceSize alignedBegin = begin - (begin % m_nonCoherentAtomSize);
+        const VkDeviceSize alignedEnd = alignUp(end, m_nonCoherentAtomSize);
+
+        VkMappedMemoryRange range{};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.pNext = nullptr;
+        range.memory = allocation.mMemory;
+        range.offset = alignedBegin;
+        range.size = (allocation.mBlock == nullptr || alignedEnd >= allocation.mBlock->mSize) ? VK_WHOLE_SIZE : alignedEnd - alignedBegin;
+        return range;
+    }
+
+    VkDeviceSize VulkanMemoryAllocator::getPreferredBlockSize(uint32_t memoryTypeIndex) const noexcept
+    {
+        // small heaps (e.g. host-visible bar memory) use an eighth of the heap per block
+        const uint32_t heapIndex = m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+        const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[heapIndex].size;
+        return (heapSize <= kSmallHeapThreshold) ? alignUp(heapSize / 8, 32) : kLargeHeapBlockSize;
+    }
+}   // namespace keplar
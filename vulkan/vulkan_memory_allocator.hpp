@@ -0,0 +1,207 @@
+// ────────────────────────────────────────────
+//  File: vulkan_memory_allocator.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <filesystem>
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    struct VulkanMemoryBlock;
+
+    // subsystem an allocation is accounted to
+    enum class VulkanMemoryCategory : uint8_t
+    {
+        kBuffer,
+        kTexture,
+        kAttachment,
+        kStaging,
+        kCount
+    };
+
+    inline const char* getMemoryCategoryName(VulkanMemoryCategory category) noexcept
+    {
+        switch (category)
+        {
+            case VulkanMemoryCategory::kBuffer:     return "buffers";
+            case VulkanMemoryCategory::kTexture:    return "textures";
+            case VulkanMemoryCategory::kAttachment: return "attachments";
+            case VulkanMemoryCategory::kStaging:    return "staging";
+            default:                                return "unknown";
+        }
+    }
+
+    // budget and usage of a memory heap (or, from VulkanDevice::queryMemoryBudget, summed over the device-local heaps);
+    // from VK_EXT_memory_budget when enabled, otherwise budget is the heap size and usage what this device's allocator holds
+    struct MemoryBudget
+    {
+        VkDeviceSize mHeapSize = 0;
+        VkDeviceSize mBudget = 0;
+        VkDeviceSize mUsage = 0;
+        bool mIsReported = false;       // budget and usage from the driver (all processes)
+    };
+
+    // sub-allocated range of a device memory block
+    struct VulkanAllocation
+    {
+        VkDeviceMemory      mMemory          = VK_NULL_HANDLE;
+        VkDeviceSize        mOffset          = 0;
+        VkDeviceSize        mSize            = 0;
+        void*               mMappedData      = nullptr;
+        uint32_t            mMemoryTypeIndex = 0;
+        VulkanMemoryCategory mCategory       = VulkanMemoryCategory::kBuffer;
+
+        // owning block and region inside it; the block id tells a destroyed block from one allocated at the same
+        // address, region slots are recycled and the generation tells a stale handle from the allocation that took its
+        // slot over. mBlock is only dereferenced once the allocator found it among its live blocks
+        VulkanMemoryBlock*  mBlock           = nullptr;
+        uint64_t            mBlockId         = 0;
+        uint32_t            mRegionIndex     = 0;
+        uint32_t            mRegionGeneration = 0;
+
+        inline bool isValid() const noexcept { return mMemory != VK_NULL_HANDLE; }
+    };
+
+    // one relocation of a defragmentation pass: the owner copies mSource into mDestination on the gpu, rebinds its
+    // resource there and takes mDestination as its allocation, or sets mIsCanceled to stay where it is
+    struct VulkanDefragmentationMove
+    {
+        VulkanAllocation    mSource;
+        VulkanAllocation    mDestination;
+        void*               mUserData   = nullptr;      // owner registered with setMovable
+        bool                mIsCanceled = false;
+    };
+
+    // requested bytes of the live allocations of one category, and the most it ever held
+    struct VulkanMemoryCategoryStats
+    {
+        uint32_t     mAllocationCount = 0;
+        VkDeviceSize mAllocatedBytes  = 0;
+        VkDeviceSize mPeakBytes       = 0;
+    };
+
+    // allocator usage statistics
+    struct VulkanMemoryStats
+    {
+        uint32_t     mBlockCount      = 0;
+        uint32_t     mAllocationCount = 0;
+        VkDeviceSize mBlockBytes      = 0;
+        VkDeviceSize mAllocatedBytes  = 0;
+
+        // free space inside shared blocks
+        uint32_t     mFreeRegionCount   = 0;
+        VkDeviceSize mFreeBytes         = 0;
+        VkDeviceSize mLargestFreeRegion = 0;
+
+        std::array<VulkanMemoryCategoryStats, static_cast<size_t>(VulkanMemoryCategory::kCount)> mCategories{};
+        std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> mHeapBlockBytes{};
+
+        // 0 when all free space is one region, towards 1 the more it is scattered
+        inline float getFragmentation() const noexcept
+        {
+            return mFreeBytes > 0 ? 1.0f - static_cast<float>(mLargestFreeRegion) / static_cast<float>(mFreeBytes) : 0.0f;
+        }
+
+        inline const VulkanMemoryCategoryStats& getCategory(VulkanMemoryCategory category) const noexcept
+        {
+            return mCategories[static_cast<size_t>(category)];
+        }
+    };
+
+    class VulkanMemoryAllocator final
+    {
+        public:
+            // creation and destruction
+            VulkanMemoryAllocator() noexcept;
+            ~VulkanMemoryAllocator();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+            VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+            VulkanMemoryAllocator(VulkanMemoryAllocator&&) = delete;
+            VulkanMemoryAllocator& operator=(VulkanMemoryAllocator&&) = delete;
+
+            // usage: isDeviceAddressEnabled allocates every block with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT (needs the
+            // bufferDeviceAddress feature), so buffers bound anywhere in them may be read through their address
+            bool initialize(VkDevice vkDevice, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize nonCoherentAtomSize = 1,
+                            bool isDeviceAddressEnabled = false) noexcept;
+            void destroy() noexcept;
+
+            // usage: allocate and bind memory for a resource. preferredFlags rank the types that have propertyFlags,
+            // e.g. device-local host-visible memory (resizable bar) for per-frame data the cpu writes in place
+            // category only selects the statistics the allocation is counted in
+            bool allocateBufferMemory(VkBuffer vkBuffer, VkMemoryPropertyFlags propertyFlags, VulkanAllocation& allocation,
+                                      VkMemoryPropertyFlags preferredFlags = 0, VulkanMemoryCategory category = VulkanMemoryCategory::kBuffer) noexcept;
+            bool allocateImageMemory(VkImage vkImage, VkMemoryPropertyFlags propertyFlags, VulkanAllocation& allocation,
+                                     VulkanMemoryCategory category = VulkanMemoryCategory::kTexture) noexcept;
+            bool allocateImageMemory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags propertyFlags, VulkanAllocation& allocation,
+                                     VulkanMemoryCategory category = VulkanMemoryCategory::kTexture) noexcept;
+            void free(VulkanAllocation& allocation) noexcept;
+
+            // usage: incremental defragmentation. setMovable registers the owner of an allocation that can follow a move
+            // (nullptr pins it again). a pass picks the emptiest shared block of each pool whose movable allocations fit in
+            // the other blocks, and reserves destinations for them in the fullest blocks first, within the byte and move
+            // budget; the drained blocks take no new allocations until endDefragmentationPass. that runs once the gpu
+            // finished the copies and frees the sources, or the destinations of canceled moves. one pass at a time
+            void setMovable(const VulkanAllocation& allocation, void* userData) noexcept;
+            bool beginDefragmentationPass(VkDeviceSize maxBytes, uint32_t maxMoves, std::vector<VulkanDefragmentationMove>& moves) noexcept;
+            void endDefragmentationPass(std::vector<VulkanDefragmentationMove>& moves) noexcept;
+
+            // usage: make host writes visible to the device, or device writes visible to the host, for a range of a
+            // mapped allocation (size VK_WHOLE_SIZE: to its end). no-ops on host-coherent memory
+            bool flush(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const noexcept;
+            bool invalidate(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const noexcept;
+
+            // usage: statistics and the per-heap budgets (VulkanDevice::queryMemoryHeapBudgets) as json, for offline comparison
+            bool writeStatsJson(const std::filesystem::path& filepath, const std::vector<MemoryBudget>& heapBudgets) const noexcept;
+
+            // accessors: getStats walks every free list, so it is meant for tools rather than per-frame decisions
+            VulkanMemoryStats getStats() const noexcept;
+            VkMemoryPropertyFlags getPropertyFlags(const VulkanAllocation& allocation) const noexcept;
+            bool isHostCoherent(const VulkanAllocation& allocation) const noexcept;
+
+        private:
+            // allocations are binned by memory type and resource kind (linear / optimal)
+            // so bufferImageGranularity never has to be honored between neighbours
+            struct MemoryPool
+            {
+                std::vector<std::unique_ptr<VulkanMemoryBlock>> mBlocks;
+            };
+
+            bool allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags propertyFlags, VkMemoryPropertyFlags preferredFlags,
+                          bool isLinear, VulkanMemoryCategory category, VulkanAllocation& allocation) noexcept;
+            void release(VulkanAllocation& allocation) noexcept;
+            void clearDraining() noexcept;
+            VulkanMemoryBlock* createBlock(uint32_t memoryTypeIndex, VkDeviceSize size, bool isDedicated) noexcept;
+            void destroyBlock(VulkanMemoryBlock& block) noexcept;
+            VulkanMemoryBlock* findBlock(const VulkanAllocation& allocation) const noexcept;
+            std::optional<uint32_t> findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags propertyFlags, VkMemoryPropertyFlags preferredFlags = 0) const noexcept;
+            VkMappedMemoryRange getMappedRange(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) const noexcept;
+            VkDeviceSize getPreferredBlockSize(uint32_t memoryTypeIndex) const noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                          m_vkDevice;
+            VkPhysicalDeviceMemoryProperties  m_memoryProperties;
+            VkDeviceSize                      m_nonCoherentAtomSize;    // flush granularity of non-coherent memory
+            bool                              m_isDeviceAddressEnabled;
+
+            // memory pools indexed by [memoryTypeIndex * 2 + isLinear]
+            std::vector<MemoryPool>           m_pools;
+            mutable std::mutex                m_mutex;
+            bool                              m_isDefragmenting;        // a pass holds reserved destinations
+            uint64_t                          m_nextBlockId;            // ids are never reused, 0 marks no block
+
+            // per-category accounting, updated under m_mutex
+            std::array<VulkanMemoryCategoryStats, static_cast<size_t>(VulkanMemoryCategory::kCount)> m_categoryStats;
+    };
+}   // namespace keplar
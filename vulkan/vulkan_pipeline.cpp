@@ -3,15 +3,166 @@
 // ────────────────────────────────────────────
 
 #include "vulkan_pipeline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include "vulkan_shader.hpp"
 #include "utils/logger.hpp"
 
+namespace
+{
+    // graphics stages in pipeline order, which is also the order shader objects are linked and bound in
+    constexpr std::array<VkShaderStageFlagBits, 7> kGraphicsStages = 
+    {
+        VK_SHADER_STAGE_TASK_BIT_EXT, VK_SHADER_STAGE_MESH_BIT_EXT, VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+        VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT, VK_SHADER_STAGE_GEOMETRY_BIT, VK_SHADER_STAGE_FRAGMENT_BIT
+    };
+
+    uint32_t getStageOrder(VkShaderStageFlagBits stage) noexcept
+    {
+        return static_cast<uint32_t>(std::find(kGraphicsStages.begin(), kGraphicsStages.end(), stage) - kGraphicsStages.begin());
+    }
+
+    // pipeline keys are the raw bytes of the state; only padding-free values are appended
+    template<typename T>
+    void appendKey(std::string& key, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void appendKey(std::string& key, const T* values, uint32_t count)
+    {
+        appendKey(key, count);
+        if (values != nullptr && count > 0)
+        {
+            key.append(reinterpret_cast<const char*>(values), sizeof(T) * count);
+        }
+    }
+
+    void appendSpecializationKey(std::string& key, const VkSpecializationInfo* specializationInfo)
+    {
+        appendKey(key, specializationInfo != nullptr);
+        if (specializationInfo != nullptr)
+        {
+            appendKey(key, specializationInfo->pMapEntries, specializationInfo->mapEntryCount);
+            appendKey(key, static_cast<const uint8_t*>(specializationInfo->pData), static_cast<uint32_t>(specializationInfo->dataSize));
+        }
+    }
+
+    // shader stages of the pre-rasterization or fragment subset in pipeline order, with the constants they receive
+    void appendStageKey(std::string& key, const keplar::GraphicsPipelineConfig& config, bool isFragment)
+    {
+        std::vector<const VkPipelineShaderStageCreateInfo*> shaderStages;
+        for (const auto& shaderStage : config.mShaderStages)
+        {
+            if ((shaderStage.stage == VK_SHADER_STAGE_FRAGMENT_BIT) == isFragment)
+            {
+                shaderStages.push_back(&shaderStage);
+            }
+        }
+        std::sort(shaderStages.begin(), shaderStages.end(), [](const VkPipelineShaderStageCreateInfo* a, const VkPipelineShaderStageCreateInfo* b)
+        {
+            return getStageOrder(a->stage) < getStageOrder(b->stage);
+        });
+
+        for (const VkPipelineShaderStageCreateInfo* shaderStage : shaderStages)
+        {
+            appendKey(key, shaderStage->stage);
+            appendKey(key, shaderStage->module);
+            key.append(shaderStage->pName != nullptr ? shaderStage->pName : "");
+            key.push_back('\0');
+
+            // the config's constants replace the stage's own
+            const bool isSpecialized = !config.mSpecializationEntries.empty() && (shaderStage->stage & config.mSpecializationStages) != 0;
+            appendKey(key, isSpecialized);
+            if (isSpecialized)
+            {
+                appendKey(key, config.mSpecializationEntries.data(), static_cast<uint32_t>(config.mSpecializationEntries.size()));
+                appendKey(key, config.mSpecializationData.data(), static_cast<uint32_t>(config.mSpecializationData.size()));
+            }
+            else
+            {
+                appendSpecializationKey(key, shaderStage->pSpecializationInfo);
+            }
+        }
+    }
+
+    void appendLayoutKey(std::string& key, const keplar::GraphicsPipelineConfig& config)
+    {
+        appendKey(key, config.mDescriptorSetLayouts.data(), static_cast<uint32_t>(config.mDescriptorSetLayouts.size()));
+        appendKey(key, config.mPushConstantRanges.data(), static_cast<uint32_t>(config.mPushConstantRanges.size()));
+    }
+
+    void appendShadingRateKey(std::string& key, const keplar::GraphicsPipelineConfig& config)
+    {
+        appendKey(key, config.mFragmentShadingRateState.has_value());
+        if (config.mFragmentShadingRateState)
+        {
+            appendKey(key, config.mFragmentShadingRateState->fragmentSize);
+            appendKey(key, config.mFragmentShadingRateState->combinerOps);
+        }
+    }
+
+    // the config's dynamic states and its extended ones, in one sorted set
+    std::vector<VkDynamicState> getDynamicStates(const keplar::GraphicsPipelineConfig& config)
+    {
+        std::vector<VkDynamicState> dynamicStates(config.mExtendedDynamicStates);
+        if (config.mDynamicState && config.mDynamicState->pDynamicStates != nullptr)
+        {
+            dynamicStates.insert(dynamicStates.end(), config.mDynamicState->pDynamicStates, 
+                                 config.mDynamicState->pDynamicStates + config.mDynamicState->dynamicStateCount);
+        }
+        std::sort(dynamicStates.begin(), dynamicStates.end());
+        dynamicStates.erase(std::unique(dynamicStates.begin(), dynamicStates.end()), dynamicStates.end());
+        return dynamicStates;
+    }
+}
+
 namespace keplar
 {
+    // the config's state, copied out of the create info structs whose arrays the caller owns
+    struct VulkanPipeline::ShaderObjectState
+    {
+        std::vector<VkShaderStageFlagBits>                  mStages;            // every stage the device has
+        std::vector<VkShaderEXT>                            mShaders;           // parallel to mStages, VK_NULL_HANDLE when unused
+        std::vector<VkDynamicState>                         mDynamicStates;     // left to the caller
+
+        std::vector<VkVertexInputBindingDescription2EXT>    mVertexBindings;
+        std::vector<VkVertexInputAttributeDescription2EXT>  mVertexAttributes;
+        VkPipelineInputAssemblyStateCreateInfo              mInputAssemblyState{};
+        uint32_t                                            mPatchControlPoints = 0;
+        std::vector<VkViewport>                             mViewports;
+        std::vector<VkRect2D>                               mScissors;
+        VkPipelineRasterizationStateCreateInfo              mRasterizationState{};
+        VkSampleCountFlagBits                               mSamples = VK_SAMPLE_COUNT_1_BIT;
+        std::array<VkSampleMask, 2>                         mSampleMask{ ~0u, ~0u };
+        VkBool32                                            mAlphaToCoverage = VK_FALSE;
+        VkBool32                                            mAlphaToOne = VK_FALSE;
+        VkPipelineDepthStencilStateCreateInfo               mDepthStencilState{};
+        VkBool32                                            mLogicOpEnable = VK_FALSE;
+        VkLogicOp                                           mLogicOp = VK_LOGIC_OP_COPY;
+        std::vector<VkBool32>                               mBlendEnables;
+        std::vector<VkColorBlendEquationEXT>                mBlendEquations;
+        std::vector<VkColorComponentFlags>                  mWriteMasks;
+        std::array<float, 4>                                mBlendConstants{};
+        VkExtent2D                                          mFragmentSize{ 1, 1 };
+        std::array<VkFragmentShadingRateCombinerOpKHR, 2>   mCombinerOps{ VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR, 
+                                                                          VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR };
+
+        bool isStatic(VkDynamicState state) const noexcept
+        {
+            return std::find(mDynamicStates.begin(), mDynamicStates.end(), state) == mDynamicStates.end();
+        }
+    };
+
     VulkanPipeline::VulkanPipeline() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
         , m_vkPipeline(VK_NULL_HANDLE)
         , m_vkPipelineLayout(VK_NULL_HANDLE)
-        , m_vkPipelineCache(VK_NULL_HANDLE)
     {
     }
 
@@ -24,13 +175,12 @@ namespace keplar
         : m_vkDevice(other.m_vkDevice)
         , m_vkPipeline(other.m_vkPipeline)
         , m_vkPipelineLayout(other.m_vkPipelineLayout)
-        , m_vkPipelineCache(other.m_vkPipelineCache)
+        , m_shaderObjects(std::move(other.m_shaderObjects))
     {
         // reset the other
         other.m_vkDevice = VK_NULL_HANDLE;
         other.m_vkPipeline = VK_NULL_HANDLE;
         other.m_vkPipelineLayout = VK_NULL_HANDLE;
-        other.m_vkPipelineCache = VK_NULL_HANDLE;
     }
 
     VulkanPipeline& VulkanPipeline::operator=(VulkanPipeline&& other) noexcept
@@ -44,67 +194,160 @@ namespace keplar
             m_vkDevice = other.m_vkDevice;
             m_vkPipeline = other.m_vkPipeline;
             m_vkPipelineLayout = other.m_vkPipelineLayout;
-            m_vkPipelineCache = other.m_vkPipelineCache;
+            m_shaderObjects = std::move(other.m_shaderObjects);
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
             other.m_vkPipeline = VK_NULL_HANDLE;
             other.m_vkPipelineLayout = VK_NULL_HANDLE;
-            other.m_vkPipelineCache = VK_NULL_HANDLE;
-        }
+            }
         
         return *this;
     }
 
 
-    bool VulkanPipeline::initialize(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig) noexcept
+    bool VulkanPipeline::initialize(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, VkPipelineCache vkPipelineCache) noexcept
+    {
+        return createGraphicsPipeline(vkDevice, pipelineConfig, 0, vkPipelineCache);
+    }
+
+    bool VulkanPipeline::initializeLibrary(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryParts,
+                                           VkPipelineCache vkPipelineCache) noexcept
+    {
+        if (libraryParts == 0)
+        {
+            VK_LOG_ERROR("VulkanPipeline::initializeLibrary failed: no library parts given");
+            return false;
+        }
+        return createGraphicsPipeline(vkDevice, pipelineConfig, libraryParts, vkPipelineCache);
+    }
+
+    bool VulkanPipeline::initializeLinked(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, const std::vector<VkPipeline>& libraries,
+                                          bool isOptimized, VkPipelineCache vkPipelineCache) noexcept
     {
         // validate device handle
         if (vkDevice == VK_NULL_HANDLE)
         {
-            VK_LOG_ERROR("VulkanPipeline::initialize failed: VkDevice is VK_NULL_HANDLE");
+            VK_LOG_ERROR("VulkanPipeline::initializeLinked failed: VkDevice is VK_NULL_HANDLE");
             return false;
         }
 
-        // pipeline layout creation info
-        VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
-        pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutCreateInfo.pNext = nullptr;
-        pipelineLayoutCreateInfo.flags = 0;
-        pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(pipelineConfig.mDescriptorSetLayouts.size());
-        pipelineLayoutCreateInfo.pSetLayouts = pipelineConfig.mDescriptorSetLayouts.data();
-        pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pipelineConfig.mPushConstantRanges.size());
-        pipelineLayoutCreateInfo.pPushConstantRanges = pipelineConfig.mPushConstantRanges.data();
+        // the parts were built against an identical layout, which is compatible with this one
+        if (!createPipelineLayout(vkDevice, pipelineConfig.mDescriptorSetLayouts, pipelineConfig.mPushConstantRanges))
+        {
+            return false;
+        }
 
-        // create pipeline layout
-        VkResult vkResult = vkCreatePipelineLayout(vkDevice, &pipelineLayoutCreateInfo, nullptr, &m_vkPipelineLayout);
+        VkPipelineLibraryCreateInfoKHR libraryCreateInfo{};
+        libraryCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        libraryCreateInfo.pNext = nullptr;
+        libraryCreateInfo.libraryCount = static_cast<uint32_t>(libraries.size());
+        libraryCreateInfo.pLibraries = libraries.data();
+
+        // every state comes from the parts
+        VkGraphicsPipelineCreateInfo pipelineCreateInfo{};
+        pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineCreateInfo.pNext = &libraryCreateInfo;
+        pipelineCreateInfo.flags = isOptimized ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0;
+        pipelineCreateInfo.layout = m_vkPipelineLayout;
+        pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+        pipelineCreateInfo.basePipelineIndex = -1;
+
+        VkResult vkResult = vkCreateGraphicsPipelines(vkDevice, vkPipelineCache, 1, &pipelineCreateInfo, nullptr, &m_vkPipeline);
         if (vkResult != VK_SUCCESS)
         {
-            VK_LOG_FATAL("vkCreatePipelineLayout failed to create pipeline layout : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_FATAL("vkCreateGraphicsPipelines failed to link pipeline : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            vkDestroyPipelineLayout(vkDevice, m_vkPipelineLayout, nullptr);
+            m_vkPipelineLayout = VK_NULL_HANDLE;
             return false;
         }
 
-        // pipeline cache creation info (currently empty cache)
-        VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
-        pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-        pipelineCacheCreateInfo.pNext = nullptr;
-        pipelineCacheCreateInfo.flags = 0;
+        VK_LOG_DEBUG("graphics pipeline linked successfully (%s)", isOptimized ? "optimized" : "fast");
+        m_vkDevice = vkDevice;
+        return true;
+    }
 
-        // create pipeline cache
-        vkResult = vkCreatePipelineCache(vkDevice, &pipelineCacheCreateInfo, nullptr, &m_vkPipelineCache);
-        if (vkResult != VK_SUCCESS)
+    bool VulkanPipeline::createGraphicsPipeline(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryParts,
+                                                VkPipelineCache vkPipelineCache) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
         {
-            VK_LOG_FATAL("vkCreatePipelineCache failed to create pipeline cache : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            VK_LOG_ERROR("VulkanPipeline::initialize failed: VkDevice is VK_NULL_HANDLE");
             return false;
         }
- 
+
+        // pipeline layout
+        if (!createPipelineLayout(vkDevice, pipelineConfig.mDescriptorSetLayouts, pipelineConfig.mPushConstantRanges))
+        {
+            return false;
+        }
+
+        // attachment formats for dynamic rendering pipelines (no render pass to describe them)
+        VkPipelineRenderingCreateInfo renderingCreateInfo{};
+        renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        renderingCreateInfo.pNext = nullptr;
+        renderingCreateInfo.viewMask = pipelineConfig.mViewMask;
+        renderingCreateInfo.colorAttachmentCount = static_cast<uint32_t>(pipelineConfig.mColorAttachmentFormats.size());
+        renderingCreateInfo.pColorAttachmentFormats = pipelineConfig.mColorAttachmentFormats.data();
+        renderingCreateInfo.depthAttachmentFormat = pipelineConfig.mDepthAttachmentFormat;
+        renderingCreateInfo.stencilAttachmentFormat = pipelineConfig.mStencilAttachmentFormat;
+
+        // shading rate state chains after the rendering info when both are present
+        VkPipelineFragmentShadingRateStateCreateInfoKHR fragmentShadingRateState{};
+        const void* pipelineChain = (pipelineConfig.mRenderPass == VK_NULL_HANDLE) ? &renderingCreateInfo : nullptr;
+        if (pipelineConfig.mFragmentShadingRateState)
+        {
+            fragmentShadingRateState = *pipelineConfig.mFragmentShadingRateState;
+            fragmentShadingRateState.sType = VK_STRUCTURE_TYPE_PIPELINE_FRAGMENT_SHADING_RATE_STATE_CREATE_INFO_KHR;
+            fragmentShadingRateState.pNext = pipelineChain;
+            pipelineChain = &fragmentShadingRateState;
+        }
+
+        // specialization constants: stages inherit the shader's stage info, with the config's constants attached
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = static_cast<uint32_t>(pipelineConfig.mSpecializationEntries.size());
+        specializationInfo.pMapEntries   = pipelineConfig.mSpecializationEntries.data();
+        specializationInfo.dataSize      = pipelineConfig.mSpecializationData.size() * sizeof(uint32_t);
+        specializationInfo.pData         = pipelineConfig.mSpecializationData.data();
+
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages = pipelineConfig.mShaderStages;
+
+        // a library part takes only the stages of its subsets (the vertex input and output interfaces have none)
+        VkGraphicsPipelineLibraryCreateInfoEXT libraryCreateInfo{};
+        if (libraryParts != 0)
+        {
+            const bool hasPreRasterization = (libraryParts & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT) != 0;
+            const bool hasFragmentShader   = (libraryParts & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT) != 0;
+            shaderStages.erase(std::remove_if(shaderStages.begin(), shaderStages.end(), [=](const VkPipelineShaderStageCreateInfo& shaderStage)
+            {
+                return shaderStage.stage == VK_SHADER_STAGE_FRAGMENT_BIT ? !hasFragmentShader : !hasPreRasterization;
+            }), shaderStages.end());
+
+            libraryCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+            libraryCreateInfo.pNext = pipelineChain;
+            libraryCreateInfo.flags = libraryParts;
+            pipelineChain = &libraryCreateInfo;
+        }
+
+        if (!pipelineConfig.mSpecializationEntries.empty())
+        {
+            for (auto& shaderStage : shaderStages)
+            {
+                if ((shaderStage.stage & pipelineConfig.mSpecializationStages) != 0)
+                {
+                    shaderStage.pSpecializationInfo = &specializationInfo;
+                }
+            }
+        }
+
         // graphics pipeline creation info
         VkGraphicsPipelineCreateInfo pipelineCreateInfo{};
         pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineCreateInfo.pNext = nullptr;
-        pipelineCreateInfo.flags = 0;
-        pipelineCreateInfo.stageCount = static_cast<uint32_t>(pipelineConfig.mShaderStages.size());
-        pipelineCreateInfo.pStages = pipelineConfig.mShaderStages.data();
+        pipelineCreateInfo.pNext = pipelineChain;
+        pipelineCreateInfo.flags = libraryParts != 0 ? (VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT) : 0;
+        pipelineCreateInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
+        pipelineCreateInfo.pStages = shaderStages.data();
         pipelineCreateInfo.pVertexInputState = &pipelineConfig.mVertexInputState; 
         pipelineCreateInfo.pInputAssemblyState = &pipelineConfig.mInputAssemblyState;
         pipelineCreateInfo.pViewportState = &pipelineConfig.mViewportState;
@@ -121,34 +364,557 @@ namespace keplar
         pipelineCreateInfo.pTessellationState = pipelineConfig.mTessellationState ? &(*pipelineConfig.mTessellationState) : nullptr;
         pipelineCreateInfo.pDepthStencilState = pipelineConfig.mDepthStencilState ? &(*pipelineConfig.mDepthStencilState) : nullptr;
         pipelineCreateInfo.pDynamicState      = pipelineConfig.mDynamicState      ? &(*pipelineConfig.mDynamicState)      : nullptr;
+
+        // extended dynamic states join the config's own; the state they replace is ignored and must be set at record time
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        std::vector<VkDynamicState> dynamicStates;
+        if (!pipelineConfig.mExtendedDynamicStates.empty())
+        {
+            if (pipelineConfig.mDynamicState && pipelineConfig.mDynamicState->pDynamicStates != nullptr)
+            {
+                dynamicState = *pipelineConfig.mDynamicState;
+                dynamicStates.assign(dynamicState.pDynamicStates, dynamicState.pDynamicStates + dynamicState.dynamicStateCount);
+            }
+            dynamicStates.insert(dynamicStates.end(), pipelineConfig.mExtendedDynamicStates.begin(), pipelineConfig.mExtendedDynamicStates.end());
+
+            dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+            dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+            dynamicState.pDynamicStates    = dynamicStates.data();
+            pipelineCreateInfo.pDynamicState = &dynamicState;
+        }
+
+        // pipelines generated commands switch between; the flags2 struct takes the place of the 32-bit flags
+        VkPipelineCreateFlags2CreateInfoKHR createFlags2{};
+        if (pipelineConfig.mIndirectBindable && libraryParts == 0)
+        {
+            createFlags2.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATE_FLAGS_2_CREATE_INFO_KHR;
+            createFlags2.pNext = pipelineCreateInfo.pNext;
+            createFlags2.flags = static_cast<VkPipelineCreateFlags2KHR>(pipelineCreateInfo.flags) | VK_PIPELINE_CREATE_2_INDIRECT_BINDABLE_BIT_EXT;
+            pipelineCreateInfo.pNext = &createFlags2;
+        }
   
-        // create graphics pipeline
-        vkResult = vkCreateGraphicsPipelines(vkDevice, m_vkPipelineCache, 1, &pipelineCreateInfo, nullptr, &m_vkPipeline);
+        // create graphics pipeline (cache is owned by the device and shared across pipelines)
+        VkResult vkResult = vkCreateGraphicsPipelines(vkDevice, vkPipelineCache, 1, &pipelineCreateInfo, nullptr, &m_vkPipeline);
         if (vkResult != VK_SUCCESS)
         {
             VK_LOG_FATAL("vkCreateGraphicsPipelines failed to create pipeline : %s (code: %d)", string_VkResult(vkResult), vkResult);
             return false;
         }
 
-        VK_LOG_DEBUG("graphics pipeline created successfully");
+        VK_LOG_DEBUG("graphics pipeline %s successfully", libraryParts != 0 ? "library created" : "created");
+        m_vkDevice = vkDevice;
+        return true;
+    }
+
+    bool VulkanPipeline::initializeShaderObjects(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, 
+                                                 const std::vector<const VulkanShader*>& shaders) noexcept
+    {
+        // validate device handle, loaded commands and shaders
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanPipeline::initializeShaderObjects failed: VkDevice is VK_NULL_HANDLE");
+            return false;
+        }
+
+        if (!isShaderObjectLoaded() || shaders.size() != pipelineConfig.mShaderStages.size())
+        {
+            VK_LOG_ERROR("VulkanPipeline::initializeShaderObjects failed: shader objects are not enabled or the shaders do not match the stages");
+            return false;
+        }
+
+        // the same layout the pipeline would have, for descriptor binds and push constants
+        if (!createPipelineLayout(vkDevice, pipelineConfig.mDescriptorSetLayouts, pipelineConfig.mPushConstantRanges))
+        {
+            return false;
+        }
+
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = static_cast<uint32_t>(pipelineConfig.mSpecializationEntries.size());
+        specializationInfo.pMapEntries   = pipelineConfig.mSpecializationEntries.data();
+        specializationInfo.dataSize      = pipelineConfig.mSpecializationData.size() * sizeof(uint32_t);
+        specializationInfo.pData         = pipelineConfig.mSpecializationData.data();
+
+        // linked in pipeline order, each stage naming the one that follows it
+        std::vector<size_t> order(shaders.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            return getStageOrder(pipelineConfig.mShaderStages[a].stage) < getStageOrder(pipelineConfig.mShaderStages[b].stage);
+        });
+
+        const bool hasTaskStage = std::any_of(pipelineConfig.mShaderStages.begin(), pipelineConfig.mShaderStages.end(), 
+                                              [](const VkPipelineShaderStageCreateInfo& stage) { return stage.stage == VK_SHADER_STAGE_TASK_BIT_EXT; });
+        std::vector<VkShaderCreateInfoEXT> createInfos(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            const VkPipelineShaderStageCreateInfo& stageInfo = pipelineConfig.mShaderStages[order[i]];
+            const std::vector<uint32_t>& code = shaders[order[i]]->getCode();
+            if (code.empty())
+            {
+                VK_LOG_ERROR("VulkanPipeline::initializeShaderObjects failed: no spir-v retained for the shader of stage %s", 
+                             string_VkShaderStageFlagBits(stageInfo.stage));
+                vkDestroyPipelineLayout(vkDevice, m_vkPipelineLayout, nullptr);
+                m_vkPipelineLayout = VK_NULL_HANDLE;
+                return false;
+            }
+
+            VkShaderCreateFlagsEXT flags = order.size() > 1 ? VK_SHADER_CREATE_LINK_STAGE_BIT_EXT : 0;
+            if (stageInfo.stage == VK_SHADER_STAGE_MESH_BIT_EXT && !hasTaskStage)
+            {
+                flags |= VK_SHADER_CREATE_NO_TASK_SHADER_BIT_EXT;
+            }
+            if (stageInfo.stage == VK_SHADER_STAGE_FRAGMENT_BIT && s_shaderObjectFeatures.mShadingRateAttachment)
+            {
+                flags |= VK_SHADER_CREATE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_EXT;
+            }
+
+            VkShaderCreateInfoEXT& createInfo = createInfos[i];
+            createInfo.sType                  = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT;
+            createInfo.pNext                  = nullptr;
+            createInfo.flags                  = flags;
+            createInfo.stage                  = stageInfo.stage;
+            createInfo.nextStage              = i + 1 < order.size() ? pipelineConfig.mShaderStages[order[i + 1]].stage : 0;
+            createInfo.codeType               = VK_SHADER_CODE_TYPE_SPIRV_EXT;
+            createInfo.codeSize               = code.size() * sizeof(uint32_t);
+            createInfo.pCode                  = code.data();
+            createInfo.pName                  = stageInfo.pName;
+            createInfo.setLayoutCount         = static_cast<uint32_t>(pipelineConfig.mDescriptorSetLayouts.size());
+            createInfo.pSetLayouts            = pipelineConfig.mDescriptorSetLayouts.data();
+            createInfo.pushConstantRangeCount = static_cast<uint32_t>(pipelineConfig.mPushConstantRanges.size());
+            createInfo.pPushConstantRanges    = pipelineConfig.mPushConstantRanges.data();
+            createInfo.pSpecializationInfo    = stageInfo.pSpecializationInfo;
+            if (!pipelineConfig.mSpecializationEntries.empty() && (stageInfo.stage & pipelineConfig.mSpecializationStages) != 0)
+            {
+                createInfo.pSpecializationInfo = &specializationInfo;
+            }
+        }
+
+        std::vector<VkShaderEXT> createdShaders(createInfos.size(), VK_NULL_HANDLE);
+        VkResult vkResult = s_shaderObject.mCreateShaders(vkDevice, static_cast<uint32_t>(createInfos.size()), createInfos.data(), nullptr, 
+                                                          createdShaders.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkCreateShadersEXT failed to create shader objects : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            for (VkShaderEXT shader : createdShaders)
+            {
+                if (shader != VK_NULL_HANDLE)
+                {
+                    s_shaderObject.mDestroyShader(vkDevice, shader, nullptr);
+                }
+            }
+            vkDestroyPipelineLayout(vkDevice, m_vkPipelineLayout, nullptr);
+            m_vkPipelineLayout = VK_NULL_HANDLE;
+            return false;
+        }
+
+        // every stage the device has is bound on each bind, the unused ones to VK_NULL_HANDLE
+        auto state = std::make_unique<ShaderObjectState>();
+        for (VkShaderStageFlagBits stage : kGraphicsStages)
+        {
+            if ((s_shaderObjectFeatures.mStages & stage) != 0)
+            {
+                const auto created = std::find_if(createInfos.begin(), createInfos.end(), [=](const VkShaderCreateInfoEXT& info) { return info.stage == stage; });
+                state->mStages.push_back(stage);
+                state->mShaders.push_back(created != createInfos.end() ? createdShaders[created - createInfos.begin()] : VK_NULL_HANDLE);
+            }
+        }
+
+        // static state of the config, in the form the dynamic state commands take it
+        if (pipelineConfig.mDynamicState && pipelineConfig.mDynamicState->pDynamicStates != nullptr)
+        {
+            state->mDynamicStates.assign(pipelineConfig.mDynamicState->pDynamicStates, 
+                                         pipelineConfig.mDynamicState->pDynamicStates + pipelineConfig.mDynamicState->dynamicStateCount);
+        }
+        state->mDynamicStates.insert(state->mDynamicStates.end(), pipelineConfig.mExtendedDynamicStates.begin(), pipelineConfig.mExtendedDynamicStates.end());
+
+        const VkPipelineVertexInputStateCreateInfo& vertexInput = pipelineConfig.mVertexInputState;
+        for (uint32_t i = 0; i < vertexInput.vertexBindingDescriptionCount; ++i)
+        {
+            const VkVertexInputBindingDescription& binding = vertexInput.pVertexBindingDescriptions[i];
+            state->mVertexBindings.push_back({ VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT, nullptr, binding.binding, binding.stride, 
+                                               binding.inputRate, 1 });
+        }
+        for (uint32_t i = 0; i < vertexInput.vertexAttributeDescriptionCount; ++i)
+        {
+            const VkVertexInputAttributeDescription& attribute = vertexInput.pVertexAttributeDescriptions[i];
+            state->mVertexAttributes.push_back({ VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT, nullptr, attribute.location, 
+                                                 attribute.binding, attribute.format, attribute.offset });
+        }
+
+        state->mInputAssemblyState = pipelineConfig.mInputAssemblyState;
+        state->mPatchControlPoints = pipelineConfig.mTessellationState ? pipelineConfig.mTessellationState->patchControlPoints : 0;
+
+        const VkPipelineViewportStateCreateInfo& viewportState = pipelineConfig.mViewportState;
+        if (viewportState.pViewports != nullptr)
+        {
+            state->mViewports.assign(viewportState.pViewports, viewportState.pViewports + viewportState.viewportCount);
+        }
+        if (viewportState.pScissors != nullptr)
+        {
+            state->mScissors.assign(viewportState.pScissors, viewportState.pScissors + viewportState.scissorCount);
+        }
+
+        state->mRasterizationState = pipelineConfig.mRasterizationState;
+        state->mRasterizationState.pNext = nullptr;
+
+        const VkPipelineMultisampleStateCreateInfo& multisampleState = pipelineConfig.mMultisampleState;
+        state->mSamples = multisampleState.rasterizationSamples != 0 ? multisampleState.rasterizationSamples : VK_SAMPLE_COUNT_1_BIT;
+        if (multisampleState.pSampleMask != nullptr)
+        {
+            std::copy_n(multisampleState.pSampleMask, (static_cast<uint32_t>(state->mSamples) + 31) / 32, state->mSampleMask.begin());
+        }
+        state->mAlphaToCoverage = multisampleState.alphaToCoverageEnable;
+        state->mAlphaToOne = multisampleState.alphaToOneEnable;
+
+        // no depth stencil state tests nothing, as in a pipeline
+        if (pipelineConfig.mDepthStencilState)
+        {
+            state->mDepthStencilState = *pipelineConfig.mDepthStencilState;
+            state->mDepthStencilState.pNext = nullptr;
+        }
+
+        const VkPipelineColorBlendStateCreateInfo& colorBlendState = pipelineConfig.mColorBlendState;
+        state->mLogicOpEnable = colorBlendState.logicOpEnable;
+        state->mLogicOp = colorBlendState.logicOp;
+        std::copy_n(colorBlendState.blendConstants, 4, state->mBlendConstants.begin());
+        for (uint32_t i = 0; i < colorBlendState.attachmentCount; ++i)
+        {
+            const VkPipelineColorBlendAttachmentState& attachment = colorBlendState.pAttachments[i];
+            state->mBlendEnables.push_back(attachment.blendEnable);
+            state->mBlendEquations.push_back({ attachment.srcColorBlendFactor, attachment.dstColorBlendFactor, attachment.colorBlendOp, 
+                                               attachment.srcAlphaBlendFactor, attachment.dstAlphaBlendFactor, attachment.alphaBlendOp });
+            state->mWriteMasks.push_back(attachment.colorWriteMask);
+        }
+
+        if (pipelineConfig.mFragmentShadingRateState)
+        {
+            state->mFragmentSize = pipelineConfig.mFragmentShadingRateState->fragmentSize;
+            std::copy_n(pipelineConfig.mFragmentShadingRateState->combinerOps, 2, state->mCombinerOps.begin());
+        }
+
+        m_shaderObjects = std::move(state);
+        m_vkDevice = vkDevice;
+        VK_LOG_DEBUG("graphics shader objects created successfully (%zu stages)", createInfos.size());
+        return true;
+    }
+
+    void VulkanPipeline::bind(VkCommandBuffer vkCommandBuffer) const noexcept
+    {
+        if (!m_shaderObjects)
+        {
+            vkCmdBindPipeline(vkCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_vkPipeline);
+            return;
+        }
+
+        // shader objects carry no state: everything a draw depends on is set here, unless the caller owns it
+        const ShaderObjectState& state = *m_shaderObjects;
+        s_shaderObject.mBindShaders(vkCommandBuffer, static_cast<uint32_t>(state.mStages.size()), state.mStages.data(), state.mShaders.data());
+
+        // vertex input and assembly
+        if (state.isStatic(VK_DYNAMIC_STATE_VERTEX_INPUT_EXT))
+        {
+            s_shaderObject.mSetVertexInput(vkCommandBuffer, static_cast<uint32_t>(state.mVertexBindings.size()), state.mVertexBindings.data(), 
+                                           static_cast<uint32_t>(state.mVertexAttributes.size()), state.mVertexAttributes.data());
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY))
+        {
+            vkCmdSetPrimitiveTopology(vkCommandBuffer, state.mInputAssemblyState.topology);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE))
+        {
+            vkCmdSetPrimitiveRestartEnable(vkCommandBuffer, state.mInputAssemblyState.primitiveRestartEnable);
+        }
+        if (state.mPatchControlPoints > 0 && state.isStatic(VK_DYNAMIC_STATE_PATCH_CONTROL_POINTS_EXT))
+        {
+            s_shaderObject.mSetPatchControlPoints(vkCommandBuffer, state.mPatchControlPoints);
+        }
+
+        // viewports: the counts always come from here, the values only when static
+        if (!state.mViewports.empty() && state.isStatic(VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT))
+        {
+            vkCmdSetViewportWithCount(vkCommandBuffer, static_cast<uint32_t>(state.mViewports.size()), state.mViewports.data());
+        }
+        if (!state.mScissors.empty() && state.isStatic(VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT))
+        {
+            vkCmdSetScissorWithCount(vkCommandBuffer, static_cast<uint32_t>(state.mScissors.size()), state.mScissors.data());
+        }
+
+        // rasterization
+        const VkPipelineRasterizationStateCreateInfo& rasterization = state.mRasterizationState;
+        if (state.isStatic(VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE))
+        {
+            vkCmdSetRasterizerDiscardEnable(vkCommandBuffer, rasterization.rasterizerDiscardEnable);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_POLYGON_MODE_EXT))
+        {
+            s_shaderObject.mSetPolygonMode(vkCommandBuffer, rasterization.polygonMode);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_CULL_MODE))
+        {
+            vkCmdSetCullMode(vkCommandBuffer, rasterization.cullMode);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_FRONT_FACE))
+        {
+            vkCmdSetFrontFace(vkCommandBuffer, rasterization.frontFace);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_LINE_WIDTH))
+        {
+            vkCmdSetLineWidth(vkCommandBuffer, rasterization.lineWidth);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE))
+        {
+            vkCmdSetDepthBiasEnable(vkCommandBuffer, rasterization.depthBiasEnable);
+        }
+        if (rasterization.depthBiasEnable && state.isStatic(VK_DYNAMIC_STATE_DEPTH_BIAS))
+        {
+            vkCmdSetDepthBias(vkCommandBuffer, rasterization.depthBiasConstantFactor, rasterization.depthBiasClamp, rasterization.depthBiasSlopeFactor);
+        }
+        if (s_shaderObjectFeatures.mDepthClamp && state.isStatic(VK_DYNAMIC_STATE_DEPTH_CLAMP_ENABLE_EXT))
+        {
+            s_shaderObject.mSetDepthClampEnable(vkCommandBuffer, rasterization.depthClampEnable);
+        }
+
+        // multisampling
+        if (state.isStatic(VK_DYNAMIC_STATE_RASTERIZATION_SAMPLES_EXT))
+        {
+            s_shaderObject.mSetRasterizationSamples(vkCommandBuffer, state.mSamples);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_SAMPLE_MASK_EXT))
+        {
+            s_shaderObject.mSetSampleMask(vkCommandBuffer, state.mSamples, state.mSampleMask.data());
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_ALPHA_TO_COVERAGE_ENABLE_EXT))
+        {
+            s_shaderObject.mSetAlphaToCoverageEnable(vkCommandBuffer, state.mAlphaToCoverage);
+        }
+        if (s_shaderObjectFeatures.mAlphaToOne && state.isStatic(VK_DYNAMIC_STATE_ALPHA_TO_ONE_ENABLE_EXT))
+        {
+            s_shaderObject.mSetAlphaToOneEnable(vkCommandBuffer, state.mAlphaToOne);
+        }
+
+        // depth and stencil
+        const VkPipelineDepthStencilStateCreateInfo& depthStencil = state.mDepthStencilState;
+        if (state.isStatic(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE))
+        {
+            vkCmdSetDepthTestEnable(vkCommandBuffer, depthStencil.depthTestEnable);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE))
+        {
+            vkCmdSetDepthWriteEnable(vkCommandBuffer, depthStencil.depthWriteEnable);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP))
+        {
+            vkCmdSetDepthCompareOp(vkCommandBuffer, depthStencil.depthCompareOp);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE))
+        {
+            vkCmdSetDepthBoundsTestEnable(vkCommandBuffer, depthStencil.depthBoundsTestEnable);
+        }
+        if (depthStencil.depthBoundsTestEnable && state.isStatic(VK_DYNAMIC_STATE_DEPTH_BOUNDS))
+        {
+            vkCmdSetDepthBounds(vkCommandBuffer, depthStencil.minDepthBounds, depthStencil.maxDepthBounds);
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE))
+        {
+            vkCmdSetStencilTestEnable(vkCommandBuffer, depthStencil.stencilTestEnable);
+        }
+        if (depthStencil.stencilTestEnable)
+        {
+            for (const auto& [faceMask, face] : { std::pair{ VK_STENCIL_FACE_FRONT_BIT, depthStencil.front }, std::pair{ VK_STENCIL_FACE_BACK_BIT, depthStencil.back } })
+            {
+                if (state.isStatic(VK_DYNAMIC_STATE_STENCIL_OP))
+                {
+                    vkCmdSetStencilOp(vkCommandBuffer, faceMask, face.failOp, face.passOp, face.depthFailOp, face.compareOp);
+                }
+                if (state.isStatic(VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK))
+                {
+                    vkCmdSetStencilCompareMask(vkCommandBuffer, faceMask, face.compareMask);
+                }
+                if (state.isStatic(VK_DYNAMIC_STATE_STENCIL_WRITE_MASK))
+                {
+                    vkCmdSetStencilWriteMask(vkCommandBuffer, faceMask, face.writeMask);
+                }
+                if (state.isStatic(VK_DYNAMIC_STATE_STENCIL_REFERENCE))
+                {
+                    vkCmdSetStencilReference(vkCommandBuffer, faceMask, face.reference);
+                }
+            }
+        }
+
+        // color blending, per attachment
+        if (s_shaderObjectFeatures.mLogicOp && state.isStatic(VK_DYNAMIC_STATE_LOGIC_OP_ENABLE_EXT))
+        {
+            s_shaderObject.mSetLogicOpEnable(vkCommandBuffer, state.mLogicOpEnable);
+        }
+        if (state.mLogicOpEnable && state.isStatic(VK_DYNAMIC_STATE_LOGIC_OP_EXT))
+        {
+            s_shaderObject.mSetLogicOp(vkCommandBuffer, state.mLogicOp);
+        }
+        if (!state.mBlendEnables.empty())
+        {
+            const uint32_t attachmentCount = static_cast<uint32_t>(state.mBlendEnables.size());
+            if (state.isStatic(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT))
+            {
+                s_shaderObject.mSetColorBlendEnable(vkCommandBuffer, 0, attachmentCount, state.mBlendEnables.data());
+            }
+            if (state.isStatic(VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT))
+            {
+                s_shaderObject.mSetColorBlendEquation(vkCommandBuffer, 0, attachmentCount, state.mBlendEquations.data());
+            }
+            if (state.isStatic(VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT))
+            {
+                s_shaderObject.mSetColorWriteMask(vkCommandBuffer, 0, attachmentCount, state.mWriteMasks.data());
+            }
+        }
+        if (state.isStatic(VK_DYNAMIC_STATE_BLEND_CONSTANTS))
+        {
+            vkCmdSetBlendConstants(vkCommandBuffer, state.mBlendConstants.data());
+        }
+
+        // the shading rate is always dynamic with shader objects once the feature is on
+        if (s_shaderObjectFeatures.mFragmentShadingRate && state.isStatic(VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR))
+        {
+            s_shaderObject.mSetFragmentShadingRate(vkCommandBuffer, &state.mFragmentSize, state.mCombinerOps.data());
+        }
+    }
+
+    bool VulkanPipeline::loadShaderObject(VkDevice vkDevice, const ShaderObjectFeatures& features) noexcept
+    {
+        ShaderObjectFunctions functions{};
+        functions.mCreateShaders            = (PFN_vkCreateShadersEXT)vkGetDeviceProcAddr(vkDevice, "vkCreateShadersEXT");
+        functions.mDestroyShader            = (PFN_vkDestroyShaderEXT)vkGetDeviceProcAddr(vkDevice, "vkDestroyShaderEXT");
+        functions.mBindShaders              = (PFN_vkCmdBindShadersEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdBindShadersEXT");
+        functions.mSetVertexInput           = (PFN_vkCmdSetVertexInputEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetVertexInputEXT");
+        functions.mSetPatchControlPoints    = (PFN_vkCmdSetPatchControlPointsEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetPatchControlPointsEXT");
+        functions.mSetPolygonMode           = (PFN_vkCmdSetPolygonModeEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetPolygonModeEXT");
+        functions.mSetRasterizationSamples  = (PFN_vkCmdSetRasterizationSamplesEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetRasterizationSamplesEXT");
+        functions.mSetSampleMask            = (PFN_vkCmdSetSampleMaskEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetSampleMaskEXT");
+        functions.mSetAlphaToCoverageEnable = (PFN_vkCmdSetAlphaToCoverageEnableEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetAlphaToCoverageEnableEXT");
+        functions.mSetAlphaToOneEnable      = (PFN_vkCmdSetAlphaToOneEnableEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetAlphaToOneEnableEXT");
+        functions.mSetDepthClampEnable      = (PFN_vkCmdSetDepthClampEnableEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetDepthClampEnableEXT");
+        functions.mSetLogicOpEnable         = (PFN_vkCmdSetLogicOpEnableEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetLogicOpEnableEXT");
+        functions.mSetLogicOp               = (PFN_vkCmdSetLogicOpEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetLogicOpEXT");
+        functions.mSetColorBlendEnable      = (PFN_vkCmdSetColorBlendEnableEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetColorBlendEnableEXT");
+        functions.mSetColorBlendEquation    = (PFN_vkCmdSetColorBlendEquationEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetColorBlendEquationEXT");
+        functions.mSetColorWriteMask        = (PFN_vkCmdSetColorWriteMaskEXT)vkGetDeviceProcAddr(vkDevice, "vkCmdSetColorWriteMaskEXT");
+        functions.mSetFragmentShadingRate   = features.mFragmentShadingRate ? 
+                                              (PFN_vkCmdSetFragmentShadingRateKHR)vkGetDeviceProcAddr(vkDevice, "vkCmdSetFragmentShadingRateKHR") : nullptr;
+
+        // the extension exposes every command above, the shading rate one comes from its own extension
+        if (!functions.mCreateShaders || !functions.mDestroyShader || !functions.mBindShaders || !functions.mSetVertexInput || 
+            !functions.mSetPatchControlPoints || !functions.mSetPolygonMode || !functions.mSetRasterizationSamples || !functions.mSetSampleMask || 
+            !functions.mSetAlphaToCoverageEnable || !functions.mSetAlphaToOneEnable || !functions.mSetDepthClampEnable || !functions.mSetLogicOpEnable || 
+            !functions.mSetLogicOp || !functions.mSetColorBlendEnable || !functions.mSetColorBlendEquation || !functions.mSetColorWriteMask || 
+            (features.mFragmentShadingRate && !functions.mSetFragmentShadingRate))
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get VK_EXT_shader_object function pointers");
+            return false;
+        }
+
+        s_shaderObject = functions;
+        s_shaderObjectFeatures = features;
+        return true;
+    }
+
+    bool VulkanPipeline::initialize(VkDevice vkDevice, const ComputePipelineConfig& pipelineConfig, VkPipelineCache vkPipelineCache) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanPipeline::initialize failed: VkDevice is VK_NULL_HANDLE");
+            return false;
+        }
+
+        // pipeline layout
+        if (!createPipelineLayout(vkDevice, pipelineConfig.mDescriptorSetLayouts, pipelineConfig.mPushConstantRanges))
+        {
+            return false;
+        }
+
+        // specialization constants
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = static_cast<uint32_t>(pipelineConfig.mSpecializationEntries.size());
+        specializationInfo.pMapEntries   = pipelineConfig.mSpecializationEntries.data();
+        specializationInfo.dataSize      = pipelineConfig.mSpecializationData.size() * sizeof(uint32_t);
+        specializationInfo.pData         = pipelineConfig.mSpecializationData.data();
+
+        // compute pipeline creation info
+        VkComputePipelineCreateInfo pipelineCreateInfo{};
+        pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineCreateInfo.pNext = nullptr;
+        pipelineCreateInfo.flags = pipelineConfig.mFlags;
+        pipelineCreateInfo.stage = pipelineConfig.mShaderStage;
+        pipelineCreateInfo.layout = m_vkPipelineLayout;
+        pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+        pipelineCreateInfo.basePipelineIndex = -1;
+
+        if (!pipelineConfig.mSpecializationEntries.empty())
+        {
+            pipelineCreateInfo.stage.pSpecializationInfo = &specializationInfo;
+        }
+
+        // create compute pipeline (cache is owned by the device and shared across pipelines)
+        VkResult vkResult = vkCreateComputePipelines(vkDevice, vkPipelineCache, 1, &pipelineCreateInfo, nullptr, &m_vkPipeline);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkCreateComputePipelines failed to create pipeline : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            vkDestroyPipelineLayout(vkDevice, m_vkPipelineLayout, nullptr);
+            m_vkPipelineLayout = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VK_LOG_DEBUG("compute pipeline created successfully");
         m_vkDevice = vkDevice;
         return true;
     }
 
+    bool VulkanPipeline::createPipelineLayout(VkDevice vkDevice, const std::vector<VkDescriptorSetLayout>& setLayouts, 
+                                              const std::vector<VkPushConstantRange>& pushConstantRanges) noexcept
+    {
+        // pipeline layout creation info
+        VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+        pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutCreateInfo.pNext = nullptr;
+        pipelineLayoutCreateInfo.flags = 0;
+        pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        pipelineLayoutCreateInfo.pSetLayouts = setLayouts.data();
+        pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+        pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
+
+        // create pipeline layout
+        VkResult vkResult = vkCreatePipelineLayout(vkDevice, &pipelineLayoutCreateInfo, nullptr, &m_vkPipelineLayout);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkCreatePipelineLayout failed to create pipeline layout : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        return true;
+    }
+
     void VulkanPipeline::destroy() noexcept
     {
         if (m_vkPipeline != VK_NULL_HANDLE)
         {
             vkDestroyPipeline(m_vkDevice, m_vkPipeline, nullptr);
             m_vkPipeline = VK_NULL_HANDLE;
-            VK_LOG_DEBUG("graphics pipeline destroyed successfully");
+            VK_LOG_DEBUG("pipeline destroyed successfully");
         }
 
-        if (m_vkPipelineCache != VK_NULL_HANDLE)
+        if (m_shaderObjects)
         {
-            vkDestroyPipelineCache(m_vkDevice, m_vkPipelineCache, nullptr);
-            m_vkPipelineCache = VK_NULL_HANDLE;
-            VK_LOG_DEBUG("pipeline cache destroyed successfully");
+            for (VkShaderEXT shader : m_shaderObjects->mShaders)
+            {
+                if (shader != VK_NULL_HANDLE)
+                {
+                    s_shaderObject.mDestroyShader(m_vkDevice, shader, nullptr);
+                }
+            }
+            m_shaderObjects.reset();
+            VK_LOG_DEBUG("shader objects destroyed successfully");
         }
 
         if (m_vkPipelineLayout != VK_NULL_HANDLE)
@@ -158,4 +924,119 @@ namespace keplar
             VK_LOG_DEBUG("pipeline layout destroyed successfully");
         }
     }
+
+    GraphicsPipelineKey makeGraphicsPipelineKey(const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryParts)
+    {
+        const bool isComplete = libraryParts == 0;
+        auto hasPart = [=](VkGraphicsPipelineLibraryFlagsEXT libraryPart) { return isComplete || (libraryParts & libraryPart) != 0; };
+
+        const std::vector<VkDynamicState> dynamicStates = getDynamicStates(pipelineConfig);
+        auto isDynamic = [&](VkDynamicState state) { return std::binary_search(dynamicStates.begin(), dynamicStates.end(), state); };
+
+        GraphicsPipelineKey pipelineKey;
+        std::string& key = pipelineKey.mState;
+        appendKey(key, libraryParts);
+        appendKey(key, dynamicStates.data(), static_cast<uint32_t>(dynamicStates.size()));
+        if (isComplete)
+        {
+            appendKey(key, pipelineConfig.mFlags);
+            appendKey(key, pipelineConfig.mIndirectBindable);
+        }
+
+        // the vertex input interface alone does not depend on the render pass
+        if (libraryParts != VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT)
+        {
+            appendKey(key, pipelineConfig.mRenderPass);
+            appendKey(key, pipelineConfig.mSubpassIndex);
+            appendKey(key, pipelineConfig.mRenderPass == VK_NULL_HANDLE ? pipelineConfig.mViewMask : 0u);
+        }
+
+        // mesh pipelines read no vertex input
+        const bool hasVertexInput = std::none_of(pipelineConfig.mShaderStages.begin(), pipelineConfig.mShaderStages.end(), 
+                                                 [](const VkPipelineShaderStageCreateInfo& shaderStage) { return shaderStage.stage == VK_SHADER_STAGE_MESH_BIT_EXT; });
+        if (hasPart(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT) && hasVertexInput)
+        {
+            const auto& vertexInput = pipelineConfig.mVertexInputState;
+            appendKey(key, vertexInput.pVertexBindingDescriptions, vertexInput.vertexBindingDescriptionCount);
+            appendKey(key, vertexInput.pVertexAttributeDescriptions, vertexInput.vertexAttributeDescriptionCount);
+            appendKey(key, pipelineConfig.mInputAssemblyState.topology);
+            appendKey(key, pipelineConfig.mInputAssemblyState.primitiveRestartEnable);
+        }
+
+        if (hasPart(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT))
+        {
+            appendStageKey(key, pipelineConfig, false);
+            appendLayoutKey(key, pipelineConfig);
+            appendShadingRateKey(key, pipelineConfig);
+
+            const auto& viewportState = pipelineConfig.mViewportState;
+            appendKey(key, isDynamic(VK_DYNAMIC_STATE_VIEWPORT) ? nullptr : viewportState.pViewports, viewportState.viewportCount);
+            appendKey(key, isDynamic(VK_DYNAMIC_STATE_SCISSOR) ? nullptr : viewportState.pScissors, viewportState.scissorCount);
+            appendKey(key, pipelineConfig.mTessellationState ? pipelineConfig.mTessellationState->patchControlPoints : 0u);
+
+            const auto& rasterization = pipelineConfig.mRasterizationState;
+            appendKey(key, rasterization.depthClampEnable);
+            appendKey(key, rasterization.rasterizerDiscardEnable);
+            appendKey(key, rasterization.polygonMode);
+            appendKey(key, isDynamic(VK_DYNAMIC_STATE_CULL_MODE) ? 0u : rasterization.cullMode);
+            appendKey(key, rasterization.frontFace);
+            appendKey(key, rasterization.depthBiasEnable);
+            appendKey(key, rasterization.depthBiasConstantFactor);
+            appendKey(key, rasterization.depthBiasClamp);
+            appendKey(key, rasterization.depthBiasSlopeFactor);
+            appendKey(key, rasterization.lineWidth);
+        }
+
+        if (hasPart(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT))
+        {
+            appendStageKey(key, pipelineConfig, true);
+            if (!isComplete)
+            {
+                appendLayoutKey(key, pipelineConfig);
+                appendShadingRateKey(key, pipelineConfig);
+            }
+            appendKey(key, pipelineConfig.mMultisampleState.rasterizationSamples);
+            appendKey(key, pipelineConfig.mMultisampleState.sampleShadingEnable);
+            appendKey(key, pipelineConfig.mMultisampleState.minSampleShading);
+
+            appendKey(key, pipelineConfig.mDepthStencilState.has_value());
+            if (pipelineConfig.mDepthStencilState)
+            {
+                const auto& depthStencil = *pipelineConfig.mDepthStencilState;
+                appendKey(key, depthStencil.depthTestEnable);
+                appendKey(key, depthStencil.depthWriteEnable);
+                appendKey(key, depthStencil.depthCompareOp);
+                appendKey(key, depthStencil.depthBoundsTestEnable);
+                appendKey(key, depthStencil.stencilTestEnable);
+                appendKey(key, depthStencil.front);
+                appendKey(key, depthStencil.back);
+                appendKey(key, depthStencil.minDepthBounds);
+                appendKey(key, depthStencil.maxDepthBounds);
+            }
+        }
+
+        if (hasPart(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT))
+        {
+            const auto& colorBlend = pipelineConfig.mColorBlendState;
+            appendKey(key, colorBlend.logicOpEnable);
+            appendKey(key, colorBlend.logicOp);
+            appendKey(key, colorBlend.pAttachments, colorBlend.attachmentCount);
+            appendKey(key, colorBlend.blendConstants);
+            appendKey(key, pipelineConfig.mMultisampleState.rasterizationSamples);
+            appendKey(key, pipelineConfig.mMultisampleState.alphaToCoverageEnable);
+            appendKey(key, pipelineConfig.mMultisampleState.alphaToOneEnable);
+            appendKey(key, pipelineConfig.mMultisampleState.pSampleMask != nullptr ? *pipelineConfig.mMultisampleState.pSampleMask : ~0u);
+
+            // attachment formats only describe dynamic rendering targets
+            if (pipelineConfig.mRenderPass == VK_NULL_HANDLE)
+            {
+                appendKey(key, pipelineConfig.mColorAttachmentFormats.data(), static_cast<uint32_t>(pipelineConfig.mColorAttachmentFormats.size()));
+                appendKey(key, pipelineConfig.mDepthAttachmentFormat);
+                appendKey(key, pipelineConfig.mStencilAttachmentFormat);
+            }
+        }
+
+        pipelineKey.mHash = std::hash<std::string>{}(key);
+        return pipelineKey;
+    }
 }   // namespace keplar
\ No newline at end of file
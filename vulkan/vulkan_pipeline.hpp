@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
+#include <string>
 #include "vulkan_config.hpp"
 
 namespace keplar
@@ -25,16 +27,122 @@ namespace keplar
         std::optional<VkPipelineDepthStencilStateCreateInfo>    mDepthStencilState{};           // depth & stencil test
         VkPipelineColorBlendStateCreateInfo                     mColorBlendState{};             // color blending
         std::optional<VkPipelineDynamicStateCreateInfo>         mDynamicState{};                // dynamic states (viewport, scissor, etc.)
+        std::vector<VkDynamicState>                             mExtendedDynamicStates;         // appended to mDynamicState, e.g. VK_DYNAMIC_STATE_CULL_MODE
+                                                                                                // (VulkanDevice::isExtendedDynamicStateEnabled)
+        std::optional<VkPipelineFragmentShadingRateStateCreateInfoKHR> mFragmentShadingRateState{}; // pipeline rate and combiners (VK_KHR_fragment_shading_rate)
+        bool                                                    mIndirectBindable{false};       // may join an indirect execution set (VulkanIndirectCommands,
+                                                                                                // VulkanDevice::isDeviceGeneratedCommandsEnabled); not for library parts
         
         // subpass binding
         VkRenderPass                                            mRenderPass{VK_NULL_HANDLE};    // render pass handle
         uint32_t                                                mSubpassIndex{0};               // subpass index
+
+        // dynamic rendering attachment formats (used when mRenderPass is VK_NULL_HANDLE)
+        std::vector<VkFormat>                                   mColorAttachmentFormats;        // one per color attachment
+        VkFormat                                                mDepthAttachmentFormat{VK_FORMAT_UNDEFINED};
+        VkFormat                                                mStencilAttachmentFormat{VK_FORMAT_UNDEFINED};
+        uint32_t                                                mViewMask{0};                   // views drawn per draw (VulkanDevice::isMultiviewEnabled); render
+                                                                                                // pass pipelines take it from their subpass
         
         // pipeline layout 
         std::vector<VkDescriptorSetLayout>                      mDescriptorSetLayouts;          // descriptor sets for pipeline layout
         std::vector<VkPushConstantRange>                        mPushConstantRanges;            // push constants for pipeline layout
+
+        // specialization constants (e.g. shader permutations), shared by every stage in mSpecializationStages
+        VkShaderStageFlags                                      mSpecializationStages{};        // stages the constants apply to
+        std::vector<VkSpecializationMapEntry>                   mSpecializationEntries;         // constant id -> offset into data
+        std::vector<uint32_t>                                   mSpecializationData;            // 32-bit constant values
+
+        // appends a 32-bit specialization constant for the given stages
+        void addSpecializationConstant(VkShaderStageFlags stages, uint32_t constantId, uint32_t value)
+        {
+            mSpecializationStages |= stages;
+            mSpecializationEntries.push_back({ constantId, static_cast<uint32_t>(mSpecializationData.size() * sizeof(uint32_t)), sizeof(uint32_t) });
+            mSpecializationData.push_back(value);
+        }
+    };
+
+    // canonical state of a graphics config: shader stages (in pipeline order) with their specialization, fixed-function
+    // state, render targets and layout, as padding-free bytes. values a dynamic state overrides are left out and dynamic
+    // states are sorted, so configs that compile to the same pipeline produce equal keys. handles (shader modules, render
+    // passes, set layouts) are keyed by value, which makes set layouts from VulkanDescriptorSetLayoutCache canonical too;
+    // a key outliving the objects it names may match a new object reusing the handle
+    struct GraphicsPipelineKey
+    {
+        std::string mState;
+        size_t      mHash = 0;
+
+        bool operator==(const GraphicsPipelineKey& other) const noexcept { return mHash == other.mHash && mState == other.mState; }
+        bool operator!=(const GraphicsPipelineKey& other) const noexcept { return !(*this == other); }
+    };
+
+    struct GraphicsPipelineKeyHash
+    {
+        size_t operator()(const GraphicsPipelineKey& key) const noexcept { return key.mHash; }
+    };
+
+    // libraryParts limits the key to the state of those VK_GRAPHICS_PIPELINE_LIBRARY_*_BIT_EXT subsets (the parts of
+    // VulkanPipelineLibrary), 0 keys the complete pipeline including its creation flags
+    GraphicsPipelineKey makeGraphicsPipelineKey(const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryParts = 0);
+
+    struct ComputePipelineConfig
+    {
+        // core
+        VkPipelineCreateFlags                                   mFlags{};                       // pipeline creation flags
+        VkPipelineShaderStageCreateInfo                         mShaderStage{};                 // compute shader stage
+
+        // specialization constants (e.g. local_size_x_id for per-device workgroup sizes)
+        std::vector<VkSpecializationMapEntry>                   mSpecializationEntries;         // constant id -> offset into data
+        std::vector<uint32_t>                                   mSpecializationData;            // 32-bit constant values
+
+        // pipeline layout 
+        std::vector<VkDescriptorSetLayout>                      mDescriptorSetLayouts;          // descriptor sets for pipeline layout
+        std::vector<VkPushConstantRange>                        mPushConstantRanges;            // push constants for pipeline layout
+
+        // appends a 32-bit specialization constant
+        void addSpecializationConstant(uint32_t constantId, uint32_t value)
+        {
+            mSpecializationEntries.push_back({ constantId, static_cast<uint32_t>(mSpecializationData.size() * sizeof(uint32_t)), sizeof(uint32_t) });
+            mSpecializationData.push_back(value);
+        }
     };
  
+    class VulkanShader;
+
+    // what the device enabled for shader objects (VulkanDevice::isShaderObjectEnabled): the graphics stages every bind
+    // covers, and the optional features whose state must then be set before a draw
+    struct ShaderObjectFeatures
+    {
+        VkShaderStageFlags  mStages                 = 0;
+        bool                mDepthClamp             = false;
+        bool                mAlphaToOne             = false;
+        bool                mLogicOp                = false;
+        bool                mFragmentShadingRate    = false;
+        bool                mShadingRateAttachment  = false;
+    };
+
+    // VK_EXT_shader_object commands, loaded by the device that enables the extension
+    struct ShaderObjectFunctions
+    {
+        PFN_vkCreateShadersEXT                  mCreateShaders;
+        PFN_vkDestroyShaderEXT                  mDestroyShader;
+        PFN_vkCmdBindShadersEXT                 mBindShaders;
+        PFN_vkCmdSetVertexInputEXT              mSetVertexInput;
+        PFN_vkCmdSetPatchControlPointsEXT       mSetPatchControlPoints;
+        PFN_vkCmdSetPolygonModeEXT              mSetPolygonMode;
+        PFN_vkCmdSetRasterizationSamplesEXT     mSetRasterizationSamples;
+        PFN_vkCmdSetSampleMaskEXT               mSetSampleMask;
+        PFN_vkCmdSetAlphaToCoverageEnableEXT    mSetAlphaToCoverageEnable;
+        PFN_vkCmdSetAlphaToOneEnableEXT         mSetAlphaToOneEnable;
+        PFN_vkCmdSetDepthClampEnableEXT         mSetDepthClampEnable;
+        PFN_vkCmdSetLogicOpEnableEXT            mSetLogicOpEnable;
+        PFN_vkCmdSetLogicOpEXT                  mSetLogicOp;
+        PFN_vkCmdSetColorBlendEnableEXT         mSetColorBlendEnable;
+        PFN_vkCmdSetColorBlendEquationEXT       mSetColorBlendEquation;
+        PFN_vkCmdSetColorWriteMaskEXT           mSetColorWriteMask;
+        PFN_vkCmdSetFragmentShadingRateKHR      mSetFragmentShadingRate;
+    };
+
     class VulkanPipeline
     {
         public:   
@@ -50,19 +158,58 @@ namespace keplar
             VulkanPipeline(VulkanPipeline&&) noexcept;
             VulkanPipeline& operator=(VulkanPipeline&&) noexcept;
 
-            bool initialize(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig) noexcept;
+            // pipelines compiled through the shared device cache (VulkanDevice::getPipelineCache) are reused across runs
+            bool initialize(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, VkPipelineCache vkPipelineCache = VK_NULL_HANDLE) noexcept;
+            bool initialize(VkDevice vkDevice, const ComputePipelineConfig& pipelineConfig, VkPipelineCache vkPipelineCache = VK_NULL_HANDLE) noexcept;
+
+            // graphics pipeline libraries (VulkanDevice::isGraphicsPipelineLibraryEnabled): a part holds the config's state
+            // for the given VK_GRAPHICS_PIPELINE_LIBRARY_*_BIT_EXT subsets only (fragment stages go to the fragment shader
+            // part, all others to pre-rasterization), and a linked pipeline joins parts covering every subset the config
+            // needs. fast links skip link time optimization; optimized links need parts that retained its information
+            bool initializeLibrary(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryParts,
+                                   VkPipelineCache vkPipelineCache = VK_NULL_HANDLE) noexcept;
+            bool initializeLinked(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, const std::vector<VkPipeline>& libraries,
+                                  bool isOptimized, VkPipelineCache vkPipelineCache = VK_NULL_HANDLE) noexcept;
+
+            // shader objects (VulkanDevice::isShaderObjectEnabled): one linked shader per config stage, built from the
+            // spir-v of the parallel shaders, and no pipeline at all. the config's state is applied by bind, except the
+            // states it lists as dynamic, which stay the caller's to set (a dynamic viewport or scissor without static
+            // values through the *WithCount commands). render pass, subpass and attachment formats are not needed
+            bool initializeShaderObjects(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, 
+                                         const std::vector<const VulkanShader*>& shaders) noexcept;
             void destroy() noexcept;
 
+            // usage: binds a graphics pipeline, or the shader objects with every state they depend on
+            void bind(VkCommandBuffer vkCommandBuffer) const noexcept;
+
             // accessor
             VkPipeline get() const noexcept { return m_vkPipeline; }
             VkPipelineLayout getLayout() const noexcept { return m_vkPipelineLayout; }
-            bool isValid() const noexcept { return m_vkPipeline != VK_NULL_HANDLE; }
+            bool isValid() const noexcept { return m_vkPipeline != VK_NULL_HANDLE || m_shaderObjects != nullptr; }
+            bool isShaderObject() const noexcept { return m_shaderObjects != nullptr; }
+
+            // loaded by the device that enables the extension
+            static bool loadShaderObject(VkDevice vkDevice, const ShaderObjectFeatures& features) noexcept;
+            static bool isShaderObjectLoaded() noexcept { return s_shaderObject.mCreateShaders != nullptr; }
+
+        private:
+            struct ShaderObjectState;
+
+            bool createGraphicsPipeline(VkDevice vkDevice, const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryParts,
+                                        VkPipelineCache vkPipelineCache) noexcept;
+            bool createPipelineLayout(VkDevice vkDevice, const std::vector<VkDescriptorSetLayout>& setLayouts, 
+                                      const std::vector<VkPushConstantRange>& pushConstantRanges) noexcept;
 
         private:
             // vulkan handles
             VkDevice m_vkDevice;
             VkPipeline m_vkPipeline;
             VkPipelineLayout m_vkPipelineLayout;
-            VkPipelineCache m_vkPipelineCache;
+
+            // shaders and the copied state bind applies (shader object pipelines only)
+            std::unique_ptr<ShaderObjectState> m_shaderObjects;
+
+            inline static ShaderObjectFunctions s_shaderObject{};
+            inline static ShaderObjectFeatures  s_shaderObjectFeatures{};
     };
 }   // namespace keplar
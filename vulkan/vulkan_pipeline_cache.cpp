@@ -0,0 +1,273 @@
+// ────────────────────────────────────────────
+//  File: vulkan_pipeline_cache.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_pipeline_cache.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <system_error>
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    // file layout: header, then the raw vkGetPipelineCacheData blob
+    constexpr uint32_t kCacheFileMagic   = 0x43504b4b;   // "KKPC"
+    constexpr uint32_t kCacheFileVersion = 1;
+
+    struct PipelineCacheFileHeader
+    {
+        uint32_t mMagic;
+        uint32_t mVersion;
+        uint32_t mVendorID;
+        uint32_t mDeviceID;
+        uint32_t mDriverVersion;
+        uint8_t  mPipelineCacheUUID[VK_UUID_SIZE];
+        uint8_t  mDriverUUID[VK_UUID_SIZE];
+        uint64_t mDataSize;
+        uint64_t mDataHash;
+    };
+
+    // fnv-1a, detects truncated or corrupted blobs before they reach the driver
+    uint64_t hashData(const uint8_t* data, size_t size) noexcept
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+}
+
+namespace keplar
+{
+    VulkanPipelineCache::VulkanPipelineCache() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkPipelineCache(VK_NULL_HANDLE)
+        , m_driverIdentity{}
+        , m_isWarm(false)
+    {
+    }
+
+    VulkanPipelineCache::~VulkanPipelineCache()
+    {
+        destroy();
+    }
+
+    bool VulkanPipelineCache::initialize(VkDevice vkDevice, VkPhysicalDevice vkPhysicalDevice, const std::filesystem::path& filepath) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE || vkPhysicalDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanPipelineCache::initialize failed: invalid device handle");
+            return false;
+        }
+
+        m_vkDevice = vkDevice;
+        m_filepath = filepath;
+
+        // query the identity the stored data must match
+        VkPhysicalDeviceIDProperties idProperties{};
+        idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        idProperties.pNext = nullptr;
+
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &idProperties;
+        vkGetPhysicalDeviceProperties2(vkPhysicalDevice, &properties2);
+
+        m_driverIdentity.mVendorID      = properties2.properties.vendorID;
+        m_driverIdentity.mDeviceID      = properties2.properties.deviceID;
+        m_driverIdentity.mDriverVersion = properties2.properties.driverVersion;
+        std::memcpy(m_driverIdentity.mPipelineCacheUUID, properties2.properties.pipelineCacheUUID, VK_UUID_SIZE);
+        std::memcpy(m_driverIdentity.mDriverUUID, idProperties.driverUUID, VK_UUID_SIZE);
+
+        // seed the cache with data from a previous run when it is compatible
+        const std::vector<uint8_t> initialData = loadCacheData();
+        m_isWarm = !initialData.empty();
+
+        // pipeline cache creation info
+        VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+        pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        pipelineCacheCreateInfo.pNext = nullptr;
+        pipelineCacheCreateInfo.flags = 0;
+        pipelineCacheCreateInfo.initialDataSize = initialData.size();
+        pipelineCacheCreateInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        // create pipeline cache
+        VkResult vkResult = vkCreatePipelineCache(m_vkDevice, &pipelineCacheCreateInfo, nullptr, &m_vkPipelineCache);
+        if (vkResult != VK_SUCCESS && m_isWarm)
+        {
+            // driver rejected the blob: start cold instead of failing
+            VK_LOG_WARN("vkCreatePipelineCache rejected stored data, starting with an empty cache : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            pipelineCacheCreateInfo.initialDataSize = 0;
+            pipelineCacheCreateInfo.pInitialData = nullptr;
+            m_isWarm = false;
+            vkResult = vkCreatePipelineCache(m_vkDevice, &pipelineCacheCreateInfo, nullptr, &m_vkPipelineCache);
+        }
+
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkCreatePipelineCache failed to create pipeline cache : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        VK_LOG_DEBUG("VulkanPipelineCache::initialize successful (%s start, %zu bytes loaded)", m_isWarm ? "warm" : "cold", initialData.size());
+        return true;
+    }
+
+    void VulkanPipelineCache::destroy() noexcept
+    {
+        if (m_vkPipelineCache != VK_NULL_HANDLE)
+        {
+            // persist everything compiled during this run
+            save();
+
+            vkDestroyPipelineCache(m_vkDevice, m_vkPipelineCache, nullptr);
+            m_vkPipelineCache = VK_NULL_HANDLE;
+            VK_LOG_DEBUG("pipeline cache destroyed successfully");
+        }
+
+        m_vkDevice = VK_NULL_HANDLE;
+        m_isWarm = false;
+    }
+
+    bool VulkanPipelineCache::save() const noexcept
+    {
+        if (m_vkPipelineCache == VK_NULL_HANDLE || m_filepath.empty())
+        {
+            return false;
+        }
+
+        // query size then fetch the cache blob
+        size_t dataSize = 0;
+        VkResult vkResult = vkGetPipelineCacheData(m_vkDevice, m_vkPipelineCache, &dataSize, nullptr);
+        if (vkResult != VK_SUCCESS || dataSize == 0)
+        {
+            VK_LOG_WARN("vkGetPipelineCacheData failed to query cache size : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        std::vector<uint8_t> data(dataSize);
+        vkResult = vkGetPipelineCacheData(m_vkDevice, m_vkPipelineCache, &dataSize, data.data());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_WARN("vkGetPipelineCacheData failed to read cache data : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        // file header binding the blob to this driver
+        PipelineCacheFileHeader header{};
+        header.mMagic         = kCacheFileMagic;
+        header.mVersion       = kCacheFileVersion;
+        header.mVendorID      = m_driverIdentity.mVendorID;
+        header.mDeviceID      = m_driverIdentity.mDeviceID;
+        header.mDriverVersion = m_driverIdentity.mDriverVersion;
+        std::memcpy(header.mPipelineCacheUUID, m_driverIdentity.mPipelineCacheUUID, VK_UUID_SIZE);
+        std::memcpy(header.mDriverUUID, m_driverIdentity.mDriverUUID, VK_UUID_SIZE);
+        header.mDataSize      = dataSize;
+        header.mDataHash      = hashData(data.data(), dataSize);
+
+        // write to a temporary file and swap it in, so a crash never leaves a torn cache
+        std::error_code errorCode;
+        if (m_filepath.has_parent_path())
+        {
+            std::filesystem::create_directories(m_filepath.parent_path(), errorCode);
+        }
+
+        const std::filesystem::path tempPath = m_filepath.string() + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                VK_LOG_WARN("VulkanPipelineCache::save :: failed to open %s for writing", tempPath.string().c_str());
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(dataSize));
+            if (!file.good())
+            {
+                VK_LOG_WARN("VulkanPipelineCache::save :: failed to write %s", tempPath.string().c_str());
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, m_filepath, errorCode);
+        if (errorCode)
+        {
+            VK_LOG_WARN("VulkanPipelineCache::save :: failed to replace %s : %s", m_filepath.string().c_str(), errorCode.message().c_str());
+            std::filesystem::remove(tempPath, errorCode);
+            return false;
+        }
+
+        VK_LOG_DEBUG("VulkanPipelineCache::save :: wrote %zu bytes to %s", dataSize, m_filepath.string().c_str());
+        return true;
+    }
+
+    std::vector<uint8_t> VulkanPipelineCache::loadCacheData() const noexcept
+    {
+        // open file and seek to end to determine file size quickly
+        std::ifstream file(m_filepath, std::ios::ate | std::ios::binary);
+        if (!file.is_open())
+        {
+            return {};
+        }
+
+        const size_t fileSize = static_cast<size_t>(file.tellg());
+        if (fileSize < sizeof(PipelineCacheFileHeader))
+        {
+            VK_LOG_WARN("VulkanPipelineCache :: ignoring truncated cache file %s", m_filepath.string().c_str());
+            return {};
+        }
+
+        // read and validate the file header against the current driver
+        PipelineCacheFileHeader header{};
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        const bool isCompatible = header.mMagic == kCacheFileMagic &&
+                                  header.mVersion == kCacheFileVersion &&
+                                  header.mVendorID == m_driverIdentity.mVendorID &&
+                                  header.mDeviceID == m_driverIdentity.mDeviceID &&
+                                  header.mDriverVersion == m_driverIdentity.mDriverVersion &&
+                                  std::memcmp(header.mPipelineCacheUUID, m_driverIdentity.mPipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+                                  std::memcmp(header.mDriverUUID, m_driverIdentity.mDriverUUID, VK_UUID_SIZE) == 0 &&
+                                  header.mDataSize == fileSize - sizeof(header);
+        if (!isCompatible)
+        {
+            VK_LOG_INFO("VulkanPipelineCache :: cache file %s is stale or from another device, ignoring", m_filepath.string().c_str());
+            return {};
+        }
+
+        std::vector<uint8_t> data(static_cast<size_t>(header.mDataSize));
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file.good() || hashData(data.data(), data.size()) != header.mDataHash)
+        {
+            VK_LOG_WARN("VulkanPipelineCache :: cache file %s is corrupt, ignoring", m_filepath.string().c_str());
+            return {};
+        }
+
+        // the driver's own header must agree as well
+        VkPipelineCacheHeaderVersionOne vkHeader{};
+        if (data.size() < sizeof(vkHeader))
+        {
+            return {};
+        }
+
+        std::memcpy(&vkHeader, data.data(), sizeof(vkHeader));
+        if (vkHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+            vkHeader.vendorID != m_driverIdentity.mVendorID ||
+            vkHeader.deviceID != m_driverIdentity.mDeviceID ||
+            std::memcmp(vkHeader.pipelineCacheUUID, m_driverIdentity.mPipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            VK_LOG_INFO("VulkanPipelineCache :: cache data header mismatch in %s, ignoring", m_filepath.string().c_str());
+            return {};
+        }
+
+        return data;
+    }
+}   // namespace keplar
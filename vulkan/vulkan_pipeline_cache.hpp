@@ -0,0 +1,65 @@
+// ────────────────────────────────────────────
+//  File: vulkan_pipeline_cache.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+#include <filesystem>
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // device-wide VkPipelineCache persisted to disk between runs.
+    // stored data is only reused when it was written by the same vendor, device and driver;
+    // anything else (or a corrupt file) silently falls back to an empty cache.
+    // the cache is internally synchronized, pipelines may be compiled against it from any thread.
+    class VulkanPipelineCache final
+    {
+        public:
+            // creation and destruction
+            VulkanPipelineCache() noexcept;
+            ~VulkanPipelineCache();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+            VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+            VulkanPipelineCache(VulkanPipelineCache&&) = delete;
+            VulkanPipelineCache& operator=(VulkanPipelineCache&&) = delete;
+
+            bool initialize(VkDevice vkDevice, VkPhysicalDevice vkPhysicalDevice, const std::filesystem::path& filepath) noexcept;
+            void destroy() noexcept;
+
+            // usage: write current cache contents back to disk
+            bool save() const noexcept;
+
+            // accessors
+            VkPipelineCache get() const noexcept            { return m_vkPipelineCache; }
+            bool isValid() const noexcept                   { return m_vkPipelineCache != VK_NULL_HANDLE; }
+            bool isWarm() const noexcept                    { return m_isWarm; }
+
+        private:
+            // identity of the driver that produced the cache data
+            struct DriverIdentity
+            {
+                uint32_t mVendorID = 0;
+                uint32_t mDeviceID = 0;
+                uint32_t mDriverVersion = 0;
+                uint8_t  mPipelineCacheUUID[VK_UUID_SIZE] = {};
+                uint8_t  mDriverUUID[VK_UUID_SIZE] = {};
+            };
+
+            std::vector<uint8_t> loadCacheData() const noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                m_vkDevice;
+            VkPipelineCache         m_vkPipelineCache;
+
+            // persistence
+            std::filesystem::path   m_filepath;
+            DriverIdentity          m_driverIdentity;
+            bool                    m_isWarm;
+    };
+}   // namespace keplar
@@ -0,0 +1,301 @@
+// ────────────────────────────────────────────
+//  File: vulkan_pipeline_library.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_pipeline_library.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // the library parts, in link order
+    constexpr std::array<VkGraphicsPipelineLibraryFlagsEXT, 4> kLibraryParts = 
+    {
+        VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT
+    };
+
+    // mesh pipelines have no vertex input to link
+    bool hasVertexInput(const keplar::GraphicsPipelineConfig& config) noexcept
+    {
+        return std::none_of(config.mShaderStages.begin(), config.mShaderStages.end(), [](const VkPipelineShaderStageCreateInfo& shaderStage)
+        {
+            return shaderStage.stage == VK_SHADER_STAGE_MESH_BIT_EXT;
+        });
+    }
+}
+
+namespace keplar
+{
+    VulkanPipelineLibrary::VulkanPipelineLibrary() noexcept
+        : m_threadPool(nullptr)
+        , m_vkDevice(VK_NULL_HANDLE)
+        , m_vkPipelineCache(VK_NULL_HANDLE)
+        , m_isLinkingEnabled(false)
+    {
+    }
+
+    VulkanPipelineLibrary::~VulkanPipelineLibrary()
+    {
+        destroy();
+    }
+
+    bool VulkanPipelineLibrary::initialize(const VulkanDevice& device, ThreadPool* threadPool) noexcept
+    {
+        m_vkDevice = device.getDevice();
+        m_vkPipelineCache = device.getPipelineCache().get();
+        m_isLinkingEnabled = device.isGraphicsPipelineLibraryEnabled();
+
+        // fall back to a private pool when the caller does not share one
+        if (threadPool == nullptr)
+        {
+            m_ownedThreadPool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency(), 0, "pipelines");
+            threadPool = m_ownedThreadPool.get();
+        }
+
+        m_threadPool = threadPool;
+        VK_LOG_DEBUG("VulkanPipelineLibrary::initialize successful (%zu compile threads, %s)", m_threadPool->getThreadCount(), 
+                     m_isLinkingEnabled ? "linked parts" : "monolithic");
+        return true;
+    }
+
+    void VulkanPipelineLibrary::destroy() noexcept
+    {
+        // workers may still be writing entries
+        waitAll();
+        m_pipelines.clear();
+        m_entries.clear();
+        m_parts.clear();
+        m_isLinkingEnabled = false;
+
+        m_ownedThreadPool.reset();
+        m_threadPool = nullptr;
+        m_vkPipelineCache = VK_NULL_HANDLE;
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    PipelineHandle VulkanPipelineLibrary::compile(const GraphicsPipelineConfig& pipelineConfig) noexcept
+    {
+        if (m_threadPool == nullptr)
+        {
+            VK_LOG_ERROR("VulkanPipelineLibrary::compile called before initialize");
+            return PipelineHandle{};
+        }
+
+        // identical state compiles once: the earlier request's pipeline is handed out until it is released
+        GraphicsPipelineKey pipelineKey = makeGraphicsPipelineKey(pipelineConfig);
+        auto it = m_pipelines.find(pipelineKey);
+        if (it != m_pipelines.end())
+        {
+            return PipelineHandle{ it->second };
+        }
+
+        // the entry owns a copy of the config so the caller's struct may go away
+        Entry& entry = m_entries.emplace_back();
+        entry.mConfig = pipelineConfig;
+
+        PipelineHandle handle{};
+        handle.mIndex = static_cast<uint32_t>(m_entries.size() - 1);
+        entry.mKey = pipelineKey;
+        m_pipelines.emplace(std::move(pipelineKey), handle.mIndex);
+        if (m_isLinkingEnabled)
+        {
+            queueLink(entry, handle.mIndex);
+            return handle;
+        }
+
+        // driver compilation runs on a worker; the cache is internally synchronized
+        Entry* target = &entry;
+        VkDevice vkDevice = m_vkDevice;
+        VkPipelineCache vkPipelineCache = m_vkPipelineCache;
+        entry.mTask = m_threadPool->dispatch([target, vkDevice, vkPipelineCache, index = handle.mIndex]()
+        {
+            target->mIsCompiled = target->mPipeline.initialize(vkDevice, target->mConfig, vkPipelineCache);
+            if (!target->mIsCompiled)
+            {
+                VK_LOG_ERROR("VulkanPipelineLibrary :: failed to compile pipeline %u", index);
+            }
+        });
+
+        return handle;
+    }
+
+    void VulkanPipelineLibrary::queueLink(Entry& entry, uint32_t index) noexcept
+    {
+        // parts are shared with earlier requests when their state matches
+        std::vector<TaskHandle> partTasks;
+        for (VkGraphicsPipelineLibraryFlagsEXT libraryPart : kLibraryParts)
+        {
+            if (libraryPart == VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT && !hasVertexInput(entry.mConfig))
+            {
+                continue;
+            }
+            entry.mParts.push_back(getPart(entry.mConfig, libraryPart));
+            partTasks.push_back(entry.mParts.back()->mTask);
+        }
+
+        // the fast link is what acquire and release hand out, the optimized one is only wanted once it is free
+        Entry* target = &entry;
+        VkDevice vkDevice = m_vkDevice;
+        VkPipelineCache vkPipelineCache = m_vkPipelineCache;
+        auto link = [target, vkDevice, vkPipelineCache, index](bool isOptimized)
+        {
+            std::vector<VkPipeline> libraries;
+            for (const auto& part : target->mParts)
+            {
+                if (!part->mIsCompiled)
+                {
+                    return false;
+                }
+                libraries.push_back(part->mPipeline.get());
+            }
+
+            VulkanPipeline& pipeline = isOptimized ? target->mOptimizedPipeline : target->mPipeline;
+            if (!pipeline.initializeLinked(vkDevice, target->mConfig, libraries, isOptimized, vkPipelineCache))
+            {
+                VK_LOG_ERROR("VulkanPipelineLibrary :: failed to link pipeline %u (%s)", index, isOptimized ? "optimized" : "fast");
+                return false;
+            }
+            return true;
+        };
+
+        entry.mTask = m_threadPool->dispatchAfter(partTasks, [target, link]() { target->mIsCompiled = link(false); });
+        entry.mOptimizedTask = m_threadPool->dispatchAfter(TaskPriority::kBackground, partTasks, [target, link]() 
+        { 
+            target->mIsOptimized = link(true); 
+        });
+    }
+
+    std::shared_ptr<VulkanPipelineLibrary::Part> VulkanPipelineLibrary::getPart(const GraphicsPipelineConfig& pipelineConfig, 
+                                                                                VkGraphicsPipelineLibraryFlagsEXT libraryPart) noexcept
+    {
+        std::shared_ptr<Part>& part = m_parts[makeGraphicsPipelineKey(pipelineConfig, libraryPart)];
+        if (part)
+        {
+            return part;
+        }
+
+        // the part owns a config copy like an entry does
+        part = std::make_shared<Part>();
+        part->mConfig = pipelineConfig;
+
+        Part* target = part.get();
+        VkDevice vkDevice = m_vkDevice;
+        VkPipelineCache vkPipelineCache = m_vkPipelineCache;
+        part->mTask = m_threadPool->dispatch([target, vkDevice, vkPipelineCache, libraryPart]()
+        {
+            target->mIsCompiled = target->mPipeline.initializeLibrary(vkDevice, target->mConfig, libraryPart, vkPipelineCache);
+            if (!target->mIsCompiled)
+            {
+                VK_LOG_ERROR("VulkanPipelineLibrary :: failed to compile pipeline library part 0x%x", libraryPart);
+            }
+        });
+        return part;
+    }
+
+    std::vector<PipelineHandle> VulkanPipelineLibrary::compile(const std::vector<GraphicsPipelineConfig>& pipelineConfigs) noexcept
+    {
+        std::vector<PipelineHandle> handles;
+        handles.reserve(pipelineConfigs.size());
+        for (const auto& pipelineConfig : pipelineConfigs)
+        {
+            handles.emplace_back(compile(pipelineConfig));
+        }
+        return handles;
+    }
+
+    const VulkanPipeline* VulkanPipelineLibrary::acquire(PipelineHandle handle) noexcept
+    {
+        if (!handle.isValid() || handle.mIndex >= m_entries.size())
+        {
+            VK_LOG_WARN("VulkanPipelineLibrary::acquire invalid pipeline handle");
+            return nullptr;
+        }
+
+        // block only on this pipeline (the waiting thread helps with queued compiles)
+        Entry& entry = m_entries[handle.mIndex];
+        entry.mTask.wait();
+        return entry.mIsCompiled ? &entry.mPipeline : nullptr;
+    }
+
+    bool VulkanPipelineLibrary::release(PipelineHandle handle, VulkanPipeline& pipeline) noexcept
+    {
+        if (!handle.isValid() || handle.mIndex >= m_entries.size())
+        {
+            VK_LOG_WARN("VulkanPipelineLibrary::release invalid pipeline handle");
+            return false;
+        }
+
+        Entry& entry = m_entries[handle.mIndex];
+        entry.mTask.wait();
+        if (!entry.mIsCompiled)
+        {
+            return false;
+        }
+
+        // the entry keeps its config; acquire() of a released handle returns nullptr, and identical configs compile anew
+        pipeline = std::move(entry.mPipeline);
+        entry.mIsCompiled = false;
+        entry.mIsReleased = true;
+        auto it = m_pipelines.find(entry.mKey);
+        if (it != m_pipelines.end() && it->second == handle.mIndex)
+        {
+            m_pipelines.erase(it);
+        }
+        return true;
+    }
+
+    bool VulkanPipelineLibrary::isOptimizationReady(PipelineHandle handle) const noexcept
+    {
+        if (!handle.isValid() || handle.mIndex >= m_entries.size())
+        {
+            return true;
+        }
+
+        return m_entries[handle.mIndex].mOptimizedTask.isDone();
+    }
+
+    bool VulkanPipelineLibrary::releaseOptimized(PipelineHandle handle, VulkanPipeline& pipeline) noexcept
+    {
+        if (!isOptimizationReady(handle) || handle.mIndex >= m_entries.size() || !m_entries[handle.mIndex].mIsOptimized)
+        {
+            return false;
+        }
+
+        // the parts are no longer needed once both links exist
+        Entry& entry = m_entries[handle.mIndex];
+        entry.mTask.wait();
+        pipeline = std::move(entry.mOptimizedPipeline);
+        entry.mIsOptimized = false;
+        entry.mParts.clear();
+        return true;
+    }
+
+    bool VulkanPipelineLibrary::isReady(PipelineHandle handle) const noexcept
+    {
+        if (!handle.isValid() || handle.mIndex >= m_entries.size())
+        {
+            return false;
+        }
+
+        return m_entries[handle.mIndex].mTask.isDone();
+    }
+
+    bool VulkanPipelineLibrary::waitAll() noexcept
+    {
+        bool isSuccessful = true;
+        for (auto& entry : m_entries)
+        {
+            entry.mTask.wait();
+            entry.mOptimizedTask.wait();
+            isSuccessful = isSuccessful && (entry.mIsCompiled || entry.mIsReleased);
+        }
+        return isSuccessful;
+    }
+}   // namespace keplar
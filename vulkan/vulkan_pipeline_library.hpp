@@ -0,0 +1,133 @@
+// ────────────────────────────────────────────
+//  File: vulkan_pipeline_library.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "vulkan_config.hpp"
+#include "vulkan_pipeline.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // index of a pipeline requested from a VulkanPipelineLibrary
+    struct PipelineHandle
+    {
+        static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+        uint32_t mIndex = kInvalidIndex;
+
+        bool isValid() const noexcept { return mIndex != kInvalidIndex; }
+    };
+
+    // compiles graphics pipelines in parallel on a thread pool against the device pipeline cache.
+    // compile() returns immediately; acquire() only blocks on the pipeline it is asked for,
+    // so startup waits for what the first frame draws and the rest finishes in the background.
+    //
+    // everything a config points to (shader stages, vertex input arrays, blend attachments,
+    // render pass...) must stay alive until that pipeline is ready.
+    //
+    // requests are deduplicated by GraphicsPipelineKey: a config with the state of an earlier one gets that request's
+    // handle back, so identical permutations compile once and share one pipeline and layout through acquire. release
+    // hands the pipeline to a single owner (a second release of a shared handle fails), after which the same state
+    // compiles anew; callers that release dedupe their configs by key first.
+    //
+    // with graphics pipeline libraries (VulkanDevice::isGraphicsPipelineLibraryEnabled) a config is split into its
+    // vertex input, pre-rasterization, fragment shader and output interface parts. each part is compiled once and
+    // cached by its state, so permutations differing only in the fragment stage compile just that stage, and the
+    // pipeline is a fast link of the parts. an optimized link of the same parts follows in the background, to be
+    // swapped in through releaseOptimized. parts are keyed by handle values (shader modules, render passes, set
+    // layouts): call clearPartCache after destroying any of those so a reused handle never matches a stale part
+    class VulkanPipelineLibrary final
+    {
+        public:
+            // creation and destruction
+            VulkanPipelineLibrary() noexcept;
+            ~VulkanPipelineLibrary();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanPipelineLibrary(const VulkanPipelineLibrary&) = delete;
+            VulkanPipelineLibrary& operator=(const VulkanPipelineLibrary&) = delete;
+            VulkanPipelineLibrary(VulkanPipelineLibrary&&) = delete;
+            VulkanPipelineLibrary& operator=(VulkanPipelineLibrary&&) = delete;
+
+            // uses the given pool or creates one sized to the hardware when none is passed
+            bool initialize(const VulkanDevice& device, ThreadPool* threadPool = nullptr) noexcept;
+            void destroy() noexcept;
+
+            // usage: queue compilation (call from a single thread); identical state returns the pending or compiled handle
+            PipelineHandle compile(const GraphicsPipelineConfig& pipelineConfig) noexcept;
+            std::vector<PipelineHandle> compile(const std::vector<GraphicsPipelineConfig>& pipelineConfigs) noexcept;
+
+            // usage: wait for a pipeline; nullptr when compilation failed or the handle is invalid
+            const VulkanPipeline* acquire(PipelineHandle handle) noexcept;
+            bool isReady(PipelineHandle handle) const noexcept;
+            bool waitAll() noexcept;
+
+            // usage: move a compiled pipeline out, e.g. to swap it for a live one. waits like acquire; false when
+            // compilation failed or the pipeline was already released
+            bool release(PipelineHandle handle, VulkanPipeline& pipeline) noexcept;
+
+            // usage: linked pipelines only. never blocks: true once the background optimized link is done (or none was
+            // queued), and releaseOptimized then moves it out to replace the released fast link (false when it failed,
+            // was already released or there is none)
+            bool isOptimizationReady(PipelineHandle handle) const noexcept;
+            bool releaseOptimized(PipelineHandle handle, VulkanPipeline& pipeline) noexcept;
+
+            // usage: later compiles build fresh parts and pipelines; queued links keep the parts they use
+            void clearPartCache() noexcept { m_parts.clear(); m_pipelines.clear(); }
+
+            // accessors
+            size_t getPipelineCount() const noexcept { return m_entries.size(); }
+            size_t getSharedPipelineCount() const noexcept { return m_pipelines.size(); }
+            size_t getPartCount() const noexcept { return m_parts.size(); }
+            bool isLinkingEnabled() const noexcept { return m_isLinkingEnabled; }
+
+        private:
+            // one pipeline library part, shared by every pipeline with the same state for its subset
+            struct Part
+            {
+                GraphicsPipelineConfig  mConfig;
+                VulkanPipeline          mPipeline;
+                TaskHandle              mTask;
+                bool                    mIsCompiled = false;
+            };
+
+            // one requested pipeline; deque keeps entries stable while workers write them
+            struct Entry
+            {
+                GraphicsPipelineConfig              mConfig;
+                GraphicsPipelineKey                 mKey;
+                VulkanPipeline                      mPipeline;
+                TaskHandle                          mTask;
+                bool                                mIsCompiled = false;
+                bool                                mIsReleased = false;
+
+                // linked pipelines: the parts and the background optimized link
+                std::vector<std::shared_ptr<Part>>  mParts;
+                VulkanPipeline                      mOptimizedPipeline;
+                TaskHandle                          mOptimizedTask;
+                bool                                mIsOptimized = false;
+            };
+
+            void queueLink(Entry& entry, uint32_t index) noexcept;
+            std::shared_ptr<Part> getPart(const GraphicsPipelineConfig& pipelineConfig, VkGraphicsPipelineLibraryFlagsEXT libraryPart) noexcept;
+
+            std::unique_ptr<ThreadPool>                             m_ownedThreadPool;
+            ThreadPool*                                             m_threadPool;
+            VkDevice                                                m_vkDevice;
+            VkPipelineCache                                         m_vkPipelineCache;
+            bool                                                    m_isLinkingEnabled;
+            std::deque<Entry>                                       m_entries;
+            std::unordered_map<GraphicsPipelineKey, std::shared_ptr<Part>, GraphicsPipelineKeyHash> m_parts;       // by part state
+            std::unordered_map<GraphicsPipelineKey, uint32_t, GraphicsPipelineKeyHash>              m_pipelines;   // unreleased entries by state
+    };
+}   // namespace keplar
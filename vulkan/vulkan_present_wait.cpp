@@ -0,0 +1,167 @@
+// ────────────────────────────────────────────
+//  File: vulkan_present_wait.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_present_wait.hpp"
+
+#include <algorithm>
+#include "vulkan_device.hpp"
+#include "vulkan_utils.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // bound the wait so a minimized or occluded window never stalls the frame loop
+    constexpr uint64_t kPresentWaitTimeout  = 100'000'000;     // 100 ms in ns
+
+    // exponential moving average weight of the latest latency sample
+    constexpr float kLatencySmoothing       = 0.1f;
+}
+
+namespace keplar
+{
+    VulkanPresentWait::VulkanPresentWait() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_vkWaitForPresentKHR(nullptr)
+        , m_maxQueuedFrames(1)
+        , m_presentIdInfo{}
+        , m_pendingPresentId(0)
+        , m_lastPresentedId(0)
+        , m_lastWaitedId(0)
+        , m_firstSwapchainId(1)
+        , m_frameStartTime{}
+        , m_presentFrameStarts{}
+        , m_latencyMs(0.0f)
+        , m_averageLatencyMs(0.0f)
+    {
+    }
+
+    bool VulkanPresentWait::initialize(const VulkanDevice& device, uint32_t maxQueuedFrames) noexcept
+    {
+        destroy();
+
+        // present ids are only accepted when both extensions were enabled at device creation
+        if (!device.isPresentWaitEnabled())
+        {
+            VK_LOG_DEBUG("VulkanPresentWait::initialize skipped: present wait is not enabled on the device");
+            return false;
+        }
+
+        auto vkWaitForPresentKHR = (PFN_vkWaitForPresentKHR)vkGetDeviceProcAddr(device.getDevice(), "vkWaitForPresentKHR");
+        if (!vkWaitForPresentKHR)
+        {
+            VK_LOG_ERROR("vkGetDeviceProcAddr failed to get vkWaitForPresentKHR function pointer");
+            return false;
+        }
+
+        m_vkDevice = device.getDevice();
+        m_vkWaitForPresentKHR = vkWaitForPresentKHR;
+        setMaxQueuedFrames(maxQueuedFrames);
+
+        m_presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        m_presentIdInfo.pNext = nullptr;
+        m_presentIdInfo.swapchainCount = 1;
+        m_presentIdInfo.pPresentIds = &m_pendingPresentId;
+
+        VK_LOG_DEBUG("VulkanPresentWait::initialize successful (%u queued frames)", m_maxQueuedFrames);
+        return true;
+    }
+
+    void VulkanPresentWait::destroy() noexcept
+    {
+        m_vkDevice = VK_NULL_HANDLE;
+        m_vkWaitForPresentKHR = nullptr;
+        m_pendingPresentId = 0;
+        m_lastPresentedId = 0;
+        m_lastWaitedId = 0;
+        m_firstSwapchainId = 1;
+        m_latencyMs = 0.0f;
+        m_averageLatencyMs = 0.0f;
+    }
+
+    void VulkanPresentWait::markFrameStart() noexcept
+    {
+        m_frameStartTime = clock::now();
+    }
+
+    const void* VulkanPresentWait::chainPresentId(const void* pNext, uint64_t presentId) noexcept
+    {
+        if (!isValid())
+        {
+            return pNext;
+        }
+
+        // the id stays pending until markPresented(), so a failed present reuses it. caller ids may skip values (frames
+        // that were never presented) but must keep increasing: waits on a skipped id complete with the next present
+        m_pendingPresentId = std::max(presentId, m_lastPresentedId + 1);
+        m_presentIdInfo.pNext = pNext;
+        return &m_presentIdInfo;
+    }
+
+    void VulkanPresentWait::markPresented() noexcept
+    {
+        if (!isValid())
+        {
+            return;
+        }
+
+        m_lastPresentedId = m_pendingPresentId;
+        m_presentFrameStarts[m_lastPresentedId % kTrackedPresents] = m_frameStartTime;
+    }
+
+    bool VulkanPresentWait::waitForLatency(VkSwapchainKHR vkSwapchainKHR) noexcept
+    {
+        if (!isValid() || vkSwapchainKHR == VK_NULL_HANDLE)
+        {
+            return true;
+        }
+
+        // keep at most maxQueuedFrames presents ahead of the display
+        if (m_lastPresentedId < m_maxQueuedFrames)
+        {
+            return true;
+        }
+
+        const uint64_t targetId = m_lastPresentedId - (m_maxQueuedFrames - 1);
+        if (targetId < m_firstSwapchainId || targetId <= m_lastWaitedId)
+        {
+            return true;
+        }
+
+        VkResult vkResult = m_vkWaitForPresentKHR(m_vkDevice, vkSwapchainKHR, targetId, kPresentWaitTimeout);
+        if (vkResult == VK_TIMEOUT || vkResult == VK_ERROR_OUT_OF_DATE_KHR || vkResult == VK_ERROR_SURFACE_LOST_KHR)
+        {
+            // nothing reached the display in time (minimized, occluded, or being recreated): pace on the next frame
+            return true;
+        }
+
+        if (vkResult != VK_SUCCESS && vkResult != VK_SUBOPTIMAL_KHR)
+        {
+            VK_LOG_FATAL("vkWaitForPresentKHR failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+
+        m_lastWaitedId = targetId;
+
+        // input-to-present latency of the frame that just reached the display
+        if (m_lastPresentedId - targetId < kTrackedPresents)
+        {
+            const auto latency = clock::now() - m_presentFrameStarts[targetId % kTrackedPresents];
+            m_latencyMs = std::chrono::duration<float, std::milli>(latency).count();
+            m_averageLatencyMs = (m_averageLatencyMs == 0.0f) ? m_latencyMs : m_averageLatencyMs + (m_latencyMs - m_averageLatencyMs) * kLatencySmoothing;
+        }
+
+        return true;
+    }
+
+    void VulkanPresentWait::onSwapchainRecreated() noexcept
+    {
+        // ids keep increasing across swapchains; only the ones presented from here on can be waited on
+        m_firstSwapchainId = m_lastPresentedId + 1;
+    }
+
+    void VulkanPresentWait::setMaxQueuedFrames(uint32_t maxQueuedFrames) noexcept
+    {
+        m_maxQueuedFrames = std::max(maxQueuedFrames, 1u);
+    }
+}   // namespace keplar
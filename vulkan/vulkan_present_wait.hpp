@@ -0,0 +1,81 @@
+// ────────────────────────────────────────────
+//  File: vulkan_present_wait.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "vulkan/vulkan_config.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // present-synced frame pacing on VK_KHR_present_id/VK_KHR_present_wait. every present carries an increasing id
+    // (chainPresentId: its own sequence or the caller's ids, e.g. those of the latency markers), and waitForLatency()
+    // blocks until the present maxQueuedFrames behind the latest one reached the display, so the next frame starts
+    // right after a vblank instead of on a free running cpu clock. the time between markFrameStart() (input sampled)
+    // and that present is reported as the input-to-present latency
+    class VulkanPresentWait final
+    {
+        public:
+            // creation and destruction
+            VulkanPresentWait() noexcept;
+            ~VulkanPresentWait() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanPresentWait(const VulkanPresentWait&) = delete;
+            VulkanPresentWait& operator=(const VulkanPresentWait&) = delete;
+            VulkanPresentWait(VulkanPresentWait&&) = delete;
+            VulkanPresentWait& operator=(VulkanPresentWait&&) = delete;
+
+            // fails when the device was created without present wait
+            bool initialize(const VulkanDevice& device, uint32_t maxQueuedFrames = 1) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame
+            void markFrameStart() noexcept;
+            const void* chainPresentId(const void* pNext, uint64_t presentId = 0) noexcept;     // 0: the next id in sequence
+            void markPresented() noexcept;
+            bool waitForLatency(VkSwapchainKHR vkSwapchainKHR) noexcept;
+
+            // ids presented to a retired swapchain can no longer be waited on
+            void onSwapchainRecreated() noexcept;
+
+            // configuration
+            void setMaxQueuedFrames(uint32_t maxQueuedFrames) noexcept;
+            uint32_t getMaxQueuedFrames() const noexcept    { return m_maxQueuedFrames; }
+
+            // accessors
+            bool  isValid() const noexcept                  { return m_vkWaitForPresentKHR != nullptr; }
+            float getLatencyMs() const noexcept             { return m_latencyMs; }
+            float getAverageLatencyMs() const noexcept      { return m_averageLatencyMs; }
+
+        private:
+            using clock      = std::chrono::steady_clock;
+            using time_point = clock::time_point;
+
+            // frame start times of the most recent presents, indexed by present id
+            static constexpr uint32_t kTrackedPresents = 16;
+
+            VkDevice                                    m_vkDevice;
+            PFN_vkWaitForPresentKHR                     m_vkWaitForPresentKHR;
+            uint32_t                                    m_maxQueuedFrames;
+
+            // present id state
+            VkPresentIdKHR                              m_presentIdInfo;
+            uint64_t                                    m_pendingPresentId;
+            uint64_t                                    m_lastPresentedId;
+            uint64_t                                    m_lastWaitedId;
+            uint64_t                                    m_firstSwapchainId;     // first id presented to the current swapchain
+
+            // latency tracking
+            time_point                                  m_frameStartTime;
+            std::array<time_point, kTrackedPresents>    m_presentFrameStarts;
+            float                                       m_latencyMs;
+            float                                       m_averageLatencyMs;
+    };
+}   // namespace keplar
@@ -0,0 +1,203 @@
+// ────────────────────────────────────────────
+//  File: vulkan_readback_ring.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_readback_ring.hpp"
+
+#include <utility>
+
+#include "vulkan/vulkan_device.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanReadbackRing::VulkanReadbackRing() noexcept
+        : m_frameSize(0)
+        , m_frameIndex(0)
+    {
+    }
+
+    bool VulkanReadbackRing::initialize(const VulkanDevice& device, VkDeviceSize frameCapacity, uint32_t frameCount) noexcept
+    {
+        m_frameSize = (frameCapacity + kCopyAlignment - 1) & ~(kCopyAlignment - 1);
+        if (m_frameSize == 0 || frameCount == 0)
+        {
+            VK_LOG_ERROR("VulkanReadbackRing::initialize failed: invalid frame capacity %llu or frame count %u",
+                         static_cast<unsigned long long>(frameCapacity), frameCount);
+            return false;
+        }
+
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferCreateInfo.size = m_frameSize * frameCount;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_buffer.createHostReadback(device, bufferCreateInfo))
+        {
+            VK_LOG_ERROR("VulkanReadbackRing::initialize failed to create the readback buffer");
+            return false;
+        }
+
+        m_slots.clear();
+        m_slots.resize(frameCount);
+        m_frameIndex = 0;
+        VK_LOG_DEBUG("VulkanReadbackRing::initialize successful (%u frames of %llu bytes)", frameCount, static_cast<unsigned long long>(m_frameSize));
+        return true;
+    }
+
+    void VulkanReadbackRing::destroy() noexcept
+    {
+        // callbacks of undelivered readbacks are dropped with the data they were waiting for
+        m_slots.clear();
+        m_buffer = VulkanBuffer();
+        m_frameSize = 0;
+        m_frameIndex = 0;
+    }
+
+    bool VulkanReadbackRing::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_slots.size())
+        {
+            VK_LOG_ERROR("VulkanReadbackRing::beginFrame failed: frame index %u out of range (%zu frames)", frameIndex, m_slots.size());
+            return false;
+        }
+
+        // the caller waited for the slot's last submission, so whatever it copied has landed
+        m_frameIndex = frameIndex;
+        deliver(m_slots[frameIndex]);
+        return true;
+    }
+
+    bool VulkanReadbackRing::readBuffer(const VulkanCommandBuffer& commandBuffer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkDeviceSize size,
+                                        Callback callback) noexcept
+    {
+        VkDeviceSize offset = 0;
+        if (!reserve(size, offset))
+        {
+            return false;
+        }
+
+        VkBufferCopy copyRegion{};
+        copyRegion.srcOffset = srcOffset;
+        copyRegion.dstOffset = offset;
+        copyRegion.size = size;
+        commandBuffer.copyBuffer(srcBuffer, m_buffer.get(), 1, &copyRegion);
+
+        FrameSlot& slot = m_slots[m_frameIndex];
+        slot.mRequests.push_back({ offset, size, std::move(callback) });
+        slot.mHasUnsyncedCopies = true;
+        return true;
+    }
+
+    bool VulkanReadbackRing::readImage(const VulkanCommandBuffer& commandBuffer, VkImage srcImage, VkImageLayout srcLayout, const VkBufferImageCopy& region,
+                                       VkDeviceSize size, Callback callback) noexcept
+    {
+        VkDeviceSize offset = 0;
+        if (!reserve(size, offset))
+        {
+            return false;
+        }
+
+        // texels land tightly packed at the reserved offset
+        VkBufferImageCopy copyRegion = region;
+        copyRegion.bufferOffset = offset;
+        copyRegion.bufferRowLength = 0;
+        copyRegion.bufferImageHeight = 0;
+        commandBuffer.copyImageToBuffer(srcImage, srcLayout, m_buffer.get(), 1, &copyRegion);
+
+        FrameSlot& slot = m_slots[m_frameIndex];
+        slot.mRequests.push_back({ offset, size, std::move(callback) });
+        slot.mHasUnsyncedCopies = true;
+        return true;
+    }
+
+    void VulkanReadbackRing::recordHostBarrier(const VulkanCommandBuffer& commandBuffer) noexcept
+    {
+        // the fence or timeline signal alone does not make transfer writes visible to host reads
+        if (m_slots.empty() || !m_slots[m_frameIndex].mHasUnsyncedCopies)
+        {
+            return;
+        }
+
+        VulkanBarrierBatch barrierBatch;
+        barrierBatch.memoryBarrier(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+        commandBuffer.pipelineBarrier(barrierBatch);
+        m_slots[m_frameIndex].mHasUnsyncedCopies = false;
+    }
+
+    void VulkanReadbackRing::markSubmitted(uint64_t timelineValue) noexcept
+    {
+        if (!m_slots.empty())
+        {
+            m_slots[m_frameIndex].mTimelineValue = timelineValue;
+        }
+    }
+
+    void VulkanReadbackRing::collect(uint64_t completedValue) noexcept
+    {
+        for (FrameSlot& slot : m_slots)
+        {
+            if (slot.mTimelineValue != 0 && slot.mTimelineValue <= completedValue)
+            {
+                deliver(slot);
+            }
+        }
+    }
+
+    void VulkanReadbackRing::flush() noexcept
+    {
+        for (FrameSlot& slot : m_slots)
+        {
+            deliver(slot);
+        }
+    }
+
+    bool VulkanReadbackRing::reserve(VkDeviceSize size, VkDeviceSize& offset) noexcept
+    {
+        // the frame region is sized up front, running past it would overwrite the next frame
+        if (!isValid() || size == 0)
+        {
+            VK_LOG_ERROR_THROTTLED("VulkanReadbackRing::reserve failed: ring is not initialized or the readback is empty");
+            return false;
+        }
+
+        FrameSlot& slot = m_slots[m_frameIndex];
+        const VkDeviceSize alignedSize = (size + kCopyAlignment - 1) & ~(kCopyAlignment - 1);
+        if (slot.mUsed + alignedSize > m_frameSize)
+        {
+            VK_LOG_ERROR_THROTTLED("VulkanReadbackRing::reserve failed: %llu bytes do not fit the frame region", static_cast<unsigned long long>(size));
+            return false;
+        }
+
+        offset = m_frameSize * m_frameIndex + slot.mUsed;
+        slot.mUsed += alignedSize;
+        return true;
+    }
+
+    void VulkanReadbackRing::deliver(FrameSlot& slot) noexcept
+    {
+        // request storage keeps its capacity, so steady state frames do not allocate
+        if (!slot.mRequests.empty())
+        {
+            const VkDeviceSize base = slot.mRequests.front().mOffset;
+            m_buffer.invalidate(base, slot.mUsed);
+            const uint8_t* mappedData = static_cast<const uint8_t*>(m_buffer.getMappedData());
+            for (Request& request : slot.mRequests)
+            {
+                if (request.mCallback)
+                {
+                    request.mCallback(mappedData + request.mOffset, request.mSize);
+                }
+            }
+            slot.mRequests.clear();
+        }
+
+        slot.mUsed = 0;
+        slot.mTimelineValue = 0;
+        slot.mHasUnsyncedCopies = false;
+    }
+}   // namespace keplar
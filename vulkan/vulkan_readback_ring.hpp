@@ -0,0 +1,96 @@
+// ────────────────────────────────────────────
+//  File: vulkan_readback_ring.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_command_buffer.hpp"
+#include "utils/inplace_function.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // asynchronous gpu-to-cpu readback without stalls: one persistently mapped host-cached buffer split into a region
+    // per frame in flight, like VulkanUniformArena. readBuffer / readImage record a copy into the recording frame's
+    // region and keep the callback, recordHostBarrier makes the frame's copies visible to the host, and the callbacks
+    // receive the data once the frame's submission completed, i.e. frameCount frames later:
+    // - fence paced: beginFrame(frameIndex), called after the slot's fence wait, delivers what that slot read last time
+    // - timeline paced: markSubmitted tags the frame with the value its submission signals and collect delivers every
+    //   frame whose value completed, before the slot comes around again
+    // the data passed to a callback is only valid during the call. sources must be made readable by the transfer
+    // stage (barrier, image in transfer-src layout) before the copy is recorded
+    class VulkanReadbackRing final
+    {
+        public:
+            static constexpr uint32_t     kCallbackCapacity = 48;
+            static constexpr VkDeviceSize kCopyAlignment    = 16;     // covers every texel size of image copies
+
+            using Callback = InplaceFunction<void(const void* data, VkDeviceSize size), kCallbackCapacity>;
+
+            // creation and destruction
+            VulkanReadbackRing() noexcept;
+            ~VulkanReadbackRing() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanReadbackRing(const VulkanReadbackRing&) = delete;
+            VulkanReadbackRing& operator=(const VulkanReadbackRing&) = delete;
+            VulkanReadbackRing(VulkanReadbackRing&&) = delete;
+            VulkanReadbackRing& operator=(VulkanReadbackRing&&) = delete;
+
+            // frameCapacity is the room one frame's readbacks share, each at kCopyAlignment
+            bool initialize(const VulkanDevice& device, VkDeviceSize frameCapacity, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame
+            bool beginFrame(uint32_t frameIndex) noexcept;
+            bool readBuffer(const VulkanCommandBuffer& commandBuffer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkDeviceSize size, Callback callback) noexcept;
+            bool readImage(const VulkanCommandBuffer& commandBuffer, VkImage srcImage, VkImageLayout srcLayout, const VkBufferImageCopy& region,
+                           VkDeviceSize size, Callback callback) noexcept;
+            void recordHostBarrier(const VulkanCommandBuffer& commandBuffer) noexcept;
+
+            // usage: timeline pacing (call collect with the completed counter, e.g. once per frame)
+            void markSubmitted(uint64_t timelineValue) noexcept;
+            void collect(uint64_t completedValue) noexcept;
+
+            // delivers every pending readback; only valid once the device is idle
+            void flush() noexcept;
+
+            // accessors
+            bool isValid() const noexcept { return m_buffer.getMappedData() != nullptr; }
+            VkDeviceSize getFrameCapacity() const noexcept { return m_frameSize; }
+
+        private:
+            // one copy and where its data lands in the frame region
+            struct Request
+            {
+                VkDeviceSize    mOffset = 0;
+                VkDeviceSize    mSize = 0;
+                Callback        mCallback;
+            };
+
+            // readbacks one frame slot recorded and not yet delivered
+            struct FrameSlot
+            {
+                std::vector<Request>    mRequests;
+                VkDeviceSize            mUsed = 0;
+                uint64_t                mTimelineValue = 0;     // 0 until submitted on a timeline
+                bool                    mHasUnsyncedCopies = false;
+            };
+
+            bool reserve(VkDeviceSize size, VkDeviceSize& offset) noexcept;
+            void deliver(FrameSlot& slot) noexcept;
+
+        private:
+            // persistently mapped host-cached storage of every frame region
+            VulkanBuffer            m_buffer;
+            VkDeviceSize            m_frameSize;
+            std::vector<FrameSlot>  m_slots;
+            uint32_t                m_frameIndex;
+    };
+}   // namespace keplar
@@ -49,7 +49,9 @@ namespace keplar
     bool VulkanRenderPass::initialize(VkDevice vkDevice,
                                 const std::vector<VkAttachmentDescription>& attachments,
                                 const std::vector<VkSubpassDescription>& subpasses,
-                                const std::vector<VkSubpassDependency>& dependencies) noexcept
+                                const std::vector<VkSubpassDependency>& dependencies,
+                                const std::vector<VulkanShadingRateAttachment>& shadingRateAttachments,
+                                uint32_t viewMask) noexcept
     {
         // validate device handle
         if (vkDevice == VK_NULL_HANDLE)
@@ -65,6 +67,21 @@ namespace keplar
             return false;
         }
 
+        // shading rate attachments and multiview need the render pass 2 path
+        if (!shadingRateAttachments.empty() || viewMask != 0)
+        {
+            VkResult vkResult = createRenderPass2(vkDevice, attachments, subpasses, dependencies, shadingRateAttachments, viewMask);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("vkCreateRenderPass2 failed to create render pass : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                return false;
+            }
+
+            m_vkDevice = vkDevice;
+            VK_LOG_DEBUG("vulkan render pass created successfully (shading rate attachments: %zu, view mask: 0x%x)", shadingRateAttachments.size(), viewMask);
+            return true;
+        }
+
         // set up render pass creation info
         VkRenderPassCreateInfo vkRenderPassCreateInfo{};
         vkRenderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -91,6 +108,149 @@ namespace keplar
         return true;
     }
 
+    VkResult VulkanRenderPass::createRenderPass2(VkDevice vkDevice,
+                                                 const std::vector<VkAttachmentDescription>& attachments,
+                                                 const std::vector<VkSubpassDescription>& subpasses,
+                                                 const std::vector<VkSubpassDependency>& dependencies,
+                                                 const std::vector<VulkanShadingRateAttachment>& shadingRateAttachments,
+                                                 uint32_t viewMask) noexcept
+    {
+        auto toReference2 = [](const VkAttachmentReference& reference) -> VkAttachmentReference2
+        {
+            VkAttachmentReference2 reference2{};
+            reference2.sType      = VK_STRUCTURE_TYPE_ATTACHMENT_REFERENCE_2;
+            reference2.pNext      = nullptr;
+            reference2.attachment = reference.attachment;
+            reference2.layout     = reference.layout;
+            reference2.aspectMask = 0;
+            return reference2;
+        };
+
+        std::vector<VkAttachmentDescription2> attachments2(attachments.size());
+        for (size_t i = 0; i < attachments.size(); ++i)
+        {
+            const VkAttachmentDescription& attachment = attachments[i];
+            VkAttachmentDescription2& attachment2 = attachments2[i];
+            attachment2.sType          = VK_STRUCTURE_TYPE_ATTACHMENT_DESCRIPTION_2;
+            attachment2.pNext          = nullptr;
+            attachment2.flags          = attachment.flags;
+            attachment2.format         = attachment.format;
+            attachment2.samples        = attachment.samples;
+            attachment2.loadOp         = attachment.loadOp;
+            attachment2.storeOp        = attachment.storeOp;
+            attachment2.stencilLoadOp  = attachment.stencilLoadOp;
+            attachment2.stencilStoreOp = attachment.stencilStoreOp;
+            attachment2.initialLayout  = attachment.initialLayout;
+            attachment2.finalLayout    = attachment.finalLayout;
+        }
+
+        // references per subpass (sized up front so pointers stay valid)
+        const size_t subpassCount = subpasses.size();
+        std::vector<std::vector<VkAttachmentReference2>> inputReferences(subpassCount);
+        std::vector<std::vector<VkAttachmentReference2>> colorReferences(subpassCount);
+        std::vector<std::vector<VkAttachmentReference2>> resolveReferences(subpassCount);
+        std::vector<VkAttachmentReference2> depthReferences(subpassCount);
+        std::vector<VkAttachmentReference2> shadingRateReferences(subpassCount);
+        std::vector<VkFragmentShadingRateAttachmentInfoKHR> shadingRateInfos(subpassCount);
+        std::vector<VkSubpassDescription2> subpasses2(subpassCount);
+
+        for (size_t i = 0; i < subpassCount; ++i)
+        {
+            const VkSubpassDescription& subpass = subpasses[i];
+            // input attachments name the aspect they read
+            for (uint32_t j = 0; j < subpass.inputAttachmentCount; ++j)
+            {
+                VkAttachmentReference2 reference = toReference2(subpass.pInputAttachments[j]);
+                const VkFormat format = reference.attachment != VK_ATTACHMENT_UNUSED ? attachments[reference.attachment].format : VK_FORMAT_UNDEFINED;
+                const bool isDepth = format == VK_FORMAT_D16_UNORM || format == VK_FORMAT_X8_D24_UNORM_PACK32 || format == VK_FORMAT_D32_SFLOAT ||
+                                     format == VK_FORMAT_D16_UNORM_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+                reference.aspectMask = isDepth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+                inputReferences[i].push_back(reference);
+            }
+            for (uint32_t j = 0; j < subpass.colorAttachmentCount; ++j) { colorReferences[i].push_back(toReference2(subpass.pColorAttachments[j])); }
+            if (subpass.pResolveAttachments)
+            {
+                for (uint32_t j = 0; j < subpass.colorAttachmentCount; ++j) { resolveReferences[i].push_back(toReference2(subpass.pResolveAttachments[j])); }
+            }
+            if (subpass.pDepthStencilAttachment)
+            {
+                depthReferences[i] = toReference2(*subpass.pDepthStencilAttachment);
+            }
+
+            VkSubpassDescription2& subpass2 = subpasses2[i];
+            subpass2.sType                   = VK_STRUCTURE_TYPE_SUBPASS_DESCRIPTION_2;
+            subpass2.pNext                   = nullptr;
+            subpass2.flags                   = subpass.flags;
+            subpass2.pipelineBindPoint       = subpass.pipelineBindPoint;
+            subpass2.viewMask                = viewMask;
+            subpass2.inputAttachmentCount    = static_cast<uint32_t>(inputReferences[i].size());
+            subpass2.pInputAttachments       = inputReferences[i].data();
+            subpass2.colorAttachmentCount    = static_cast<uint32_t>(colorReferences[i].size());
+            subpass2.pColorAttachments       = colorReferences[i].data();
+            subpass2.pResolveAttachments     = resolveReferences[i].empty() ? nullptr : resolveReferences[i].data();
+            subpass2.pDepthStencilAttachment = subpass.pDepthStencilAttachment ? &depthReferences[i] : nullptr;
+            subpass2.preserveAttachmentCount = subpass.preserveAttachmentCount;
+            subpass2.pPreserveAttachments    = subpass.pPreserveAttachments;
+        }
+
+        for (const auto& shadingRateAttachment : shadingRateAttachments)
+        {
+            const uint32_t subpass = shadingRateAttachment.mSubpass;
+            if (subpass >= subpassCount)
+            {
+                VK_LOG_WARN("VulkanRenderPass::initialize : shading rate attachment of subpass %u ignored", subpass);
+                continue;
+            }
+
+            VkAttachmentReference2& reference = shadingRateReferences[subpass];
+            reference.sType      = VK_STRUCTURE_TYPE_ATTACHMENT_REFERENCE_2;
+            reference.pNext      = nullptr;
+            reference.attachment = shadingRateAttachment.mAttachment;
+            reference.layout     = VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+            reference.aspectMask = 0;
+
+            VkFragmentShadingRateAttachmentInfoKHR& shadingRateInfo = shadingRateInfos[subpass];
+            shadingRateInfo.sType                          = VK_STRUCTURE_TYPE_FRAGMENT_SHADING_RATE_ATTACHMENT_INFO_KHR;
+            shadingRateInfo.pNext                          = nullptr;
+            shadingRateInfo.pFragmentShadingRateAttachment = &reference;
+            shadingRateInfo.shadingRateAttachmentTexelSize = shadingRateAttachment.mTexelSize;
+            subpasses2[subpass].pNext = &shadingRateInfo;
+        }
+
+        std::vector<VkSubpassDependency2> dependencies2(dependencies.size());
+        for (size_t i = 0; i < dependencies.size(); ++i)
+        {
+            const VkSubpassDependency& dependency = dependencies[i];
+            VkSubpassDependency2& dependency2 = dependencies2[i];
+            dependency2.sType           = VK_STRUCTURE_TYPE_SUBPASS_DEPENDENCY_2;
+            dependency2.pNext           = nullptr;
+            dependency2.srcSubpass      = dependency.srcSubpass;
+            dependency2.dstSubpass      = dependency.dstSubpass;
+            dependency2.srcStageMask    = dependency.srcStageMask;
+            dependency2.dstStageMask    = dependency.dstStageMask;
+            dependency2.srcAccessMask   = dependency.srcAccessMask;
+            dependency2.dstAccessMask   = dependency.dstAccessMask;
+            dependency2.dependencyFlags = dependency.dependencyFlags;
+            dependency2.viewOffset      = 0;
+        }
+
+        VkRenderPassCreateInfo2 vkRenderPassCreateInfo{};
+        vkRenderPassCreateInfo.sType                   = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO_2;
+        vkRenderPassCreateInfo.pNext                   = nullptr;
+        vkRenderPassCreateInfo.flags                   = 0;
+        vkRenderPassCreateInfo.attachmentCount         = static_cast<uint32_t>(attachments2.size());
+        vkRenderPassCreateInfo.pAttachments            = attachments2.data();
+        vkRenderPassCreateInfo.subpassCount            = static_cast<uint32_t>(subpasses2.size());
+        vkRenderPassCreateInfo.pSubpasses              = subpasses2.data();
+        vkRenderPassCreateInfo.dependencyCount         = static_cast<uint32_t>(dependencies2.size());
+        vkRenderPassCreateInfo.pDependencies           = dependencies2.data();
+        // the views are assumed to see nearly the same geometry (stereo eyes), so the implementation may share work between them
+        vkRenderPassCreateInfo.correlatedViewMaskCount = viewMask != 0 ? 1 : 0;
+        vkRenderPassCreateInfo.pCorrelatedViewMasks    = viewMask != 0 ? &viewMask : nullptr;
+
+        return vkCreateRenderPass2(vkDevice, &vkRenderPassCreateInfo, nullptr, &m_vkRenderPass);
+    }
+
     void VulkanRenderPass::destroy() noexcept
     {
         // destroy render pass
@@ -10,6 +10,15 @@
 
 namespace keplar
 {
+    // fragment shading rate attachment of a subpass (VK_KHR_fragment_shading_rate), referenced in
+    // VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR
+    struct VulkanShadingRateAttachment
+    {
+        uint32_t    mSubpass    = 0;
+        uint32_t    mAttachment = VK_ATTACHMENT_UNUSED;
+        VkExtent2D  mTexelSize{};                       // framebuffer pixels covered by one attachment texel
+    };
+
     class VulkanRenderPass final
     {
         public:
@@ -25,15 +34,28 @@ namespace keplar
             VulkanRenderPass(VulkanRenderPass&&) noexcept;
             VulkanRenderPass& operator=(VulkanRenderPass&&) noexcept;
 
+            // a non-zero viewMask makes every subpass draw each view of the mask (VulkanDevice::isMultiviewEnabled) into
+            // the attachment layer of that index; its framebuffers then have a single layer
             bool initialize(VkDevice vkDevice,
                             const std::vector<VkAttachmentDescription>& attachments,
                             const std::vector<VkSubpassDescription>& subpasses,
-                            const std::vector<VkSubpassDependency>& dependencies = {}) noexcept;
+                            const std::vector<VkSubpassDependency>& dependencies = {},
+                            const std::vector<VulkanShadingRateAttachment>& shadingRateAttachments = {},
+                            uint32_t viewMask = 0) noexcept;
             void destroy() noexcept;
 
             // accessor
             VkRenderPass get() const noexcept { return m_vkRenderPass; }
 
+        private:
+            // shading rate attachments and view masks only exist in the render pass 2 structures
+            VkResult createRenderPass2(VkDevice vkDevice,
+                                       const std::vector<VkAttachmentDescription>& attachments,
+                                       const std::vector<VkSubpassDescription>& subpasses,
+                                       const std::vector<VkSubpassDependency>& dependencies,
+                                       const std::vector<VulkanShadingRateAttachment>& shadingRateAttachments,
+                                       uint32_t viewMask) noexcept;
+
         private:
             // vulkan handles
             VkDevice m_vkDevice;
@@ -0,0 +1,181 @@
+// ────────────────────────────────────────────
+//  File: vulkan_sampler_cache.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_sampler_cache.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    // 64-bit fnv-1a step over one value
+    inline void hashCombine(size_t& hash, uint64_t value) noexcept
+    {
+        hash ^= static_cast<size_t>(value);
+        hash *= static_cast<size_t>(1099511628211ull);
+    }
+
+    inline uint64_t floatBits(float value) noexcept
+    {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}   // namespace
+
+namespace keplar
+{
+    bool VulkanSamplerCache::SamplerKey::operator==(const SamplerKey& other) const noexcept
+    {
+        return mFlags == other.mFlags && mMagFilter == other.mMagFilter && mMinFilter == other.mMinFilter && mMipmapMode == other.mMipmapMode &&
+               mAddressModes[0] == other.mAddressModes[0] && mAddressModes[1] == other.mAddressModes[1] && mAddressModes[2] == other.mAddressModes[2] &&
+               mMipLodBias == other.mMipLodBias && mMaxAnisotropy == other.mMaxAnisotropy && mCompareOp == other.mCompareOp && 
+               mCompareEnable == other.mCompareEnable && mMinLod == other.mMinLod && mMaxLod == other.mMaxLod && 
+               mBorderColor == other.mBorderColor && mUnnormalizedCoordinates == other.mUnnormalizedCoordinates;
+    }
+
+    size_t VulkanSamplerCache::SamplerKeyHash::operator()(const SamplerKey& key) const noexcept
+    {
+        size_t hash = static_cast<size_t>(14695981039346656037ull);
+        hashCombine(hash, (static_cast<uint64_t>(key.mFlags) << 32) | (static_cast<uint64_t>(key.mMagFilter) << 16) | 
+                          (static_cast<uint64_t>(key.mMinFilter) << 8) | static_cast<uint64_t>(key.mMipmapMode));
+        hashCombine(hash, (static_cast<uint64_t>(key.mAddressModes[0]) << 32) | (static_cast<uint64_t>(key.mAddressModes[1]) << 16) | 
+                          static_cast<uint64_t>(key.mAddressModes[2]));
+        hashCombine(hash, (floatBits(key.mMipLodBias) << 32) | floatBits(key.mMaxAnisotropy));
+        hashCombine(hash, (floatBits(key.mMinLod) << 32) | floatBits(key.mMaxLod));
+        hashCombine(hash, (static_cast<uint64_t>(key.mCompareOp) << 32) | (static_cast<uint64_t>(key.mBorderColor) << 8) | 
+                          (key.mCompareEnable ? 2u : 0u) | (key.mUnnormalizedCoordinates ? 1u : 0u));
+        return hash;
+    }
+
+    VulkanSamplerCache::VulkanSamplerCache() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_maxAnisotropy(0.0f)
+    {
+    }
+
+    VulkanSamplerCache::~VulkanSamplerCache()
+    {
+        destroy();
+    }
+
+    bool VulkanSamplerCache::initialize(VkDevice vkDevice, float maxAnisotropy) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanSamplerCache::initialize failed: VkDevice is VK_NULL_HANDLE");
+            return false;
+        }
+
+        destroy();
+        m_vkDevice = vkDevice;
+        m_maxAnisotropy = maxAnisotropy >= 1.0f ? maxAnisotropy : 0.0f;
+        VK_LOG_DEBUG("VulkanSamplerCache::initialize successful (max anisotropy: %.1f)", m_maxAnisotropy);
+        return true;
+    }
+
+    void VulkanSamplerCache::destroy() noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [key, vkSampler] : m_samplers)
+        {
+            vkDestroySampler(m_vkDevice, vkSampler, nullptr);
+        }
+
+        if (!m_samplers.empty())
+        {
+            VK_LOG_DEBUG("VulkanSamplerCache :: destroyed %zu samplers", m_samplers.size());
+        }
+        m_samplers.clear();
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    VkSampler VulkanSamplerCache::getOrCreate(const VkSamplerCreateInfo& createInfo) noexcept
+    {
+        // extensions (ycbcr conversion, reduction modes, custom border colors) would need their own key fields
+        if (createInfo.pNext != nullptr)
+        {
+            VK_LOG_ERROR("VulkanSamplerCache::getOrCreate failed: unsupported pNext chain");
+            return VK_NULL_HANDLE;
+        }
+
+        // key: the state the sampler ends up with, so requests that clamp to the same sampler share it
+        SamplerKey key;
+        key.mFlags                  = createInfo.flags;
+        key.mMagFilter              = createInfo.magFilter;
+        key.mMinFilter              = createInfo.minFilter;
+        key.mMipmapMode             = createInfo.mipmapMode;
+        key.mAddressModes[0]        = createInfo.addressModeU;
+        key.mAddressModes[1]        = createInfo.addressModeV;
+        key.mAddressModes[2]        = createInfo.addressModeW;
+        key.mMipLodBias             = createInfo.mipLodBias;
+        key.mMaxAnisotropy          = (createInfo.anisotropyEnable && isAnisotropyEnabled()) ? std::clamp(createInfo.maxAnisotropy, 1.0f, m_maxAnisotropy) : 1.0f;
+        key.mCompareEnable          = createInfo.compareEnable == VK_TRUE;
+        key.mCompareOp              = key.mCompareEnable ? createInfo.compareOp : VK_COMPARE_OP_NEVER;
+        key.mMinLod                 = createInfo.minLod;
+        key.mMaxLod                 = createInfo.maxLod;
+        key.mUnnormalizedCoordinates = createInfo.unnormalizedCoordinates == VK_TRUE;
+
+        // the border color only matters to clamp-to-border addressing
+        const bool usesBorder = std::any_of(std::begin(key.mAddressModes), std::end(key.mAddressModes), [](VkSamplerAddressMode mode)
+        {
+            return mode == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        });
+        key.mBorderColor            = usesBorder ? createInfo.borderColor : VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanSamplerCache::getOrCreate failed: cache not initialized");
+            return VK_NULL_HANDLE;
+        }
+
+        auto it = m_samplers.find(key);
+        if (it != m_samplers.end())
+        {
+            return it->second;
+        }
+
+        // create from the normalized key
+        VkSamplerCreateInfo samplerCreateInfo{};
+        samplerCreateInfo.sType                     = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerCreateInfo.pNext                     = nullptr;
+        samplerCreateInfo.flags                     = key.mFlags;
+        samplerCreateInfo.magFilter                 = key.mMagFilter;
+        samplerCreateInfo.minFilter                 = key.mMinFilter;
+        samplerCreateInfo.mipmapMode                = key.mMipmapMode;
+        samplerCreateInfo.addressModeU              = key.mAddressModes[0];
+        samplerCreateInfo.addressModeV              = key.mAddressModes[1];
+        samplerCreateInfo.addressModeW              = key.mAddressModes[2];
+        samplerCreateInfo.mipLodBias                = key.mMipLodBias;
+        samplerCreateInfo.anisotropyEnable          = key.mMaxAnisotropy > 1.0f ? VK_TRUE : VK_FALSE;
+        samplerCreateInfo.maxAnisotropy             = key.mMaxAnisotropy;
+        samplerCreateInfo.compareEnable             = key.mCompareEnable ? VK_TRUE : VK_FALSE;
+        samplerCreateInfo.compareOp                 = key.mCompareOp;
+        samplerCreateInfo.minLod                    = key.mMinLod;
+        samplerCreateInfo.maxLod                    = key.mMaxLod;
+        samplerCreateInfo.borderColor               = key.mBorderColor;
+        samplerCreateInfo.unnormalizedCoordinates   = key.mUnnormalizedCoordinates ? VK_TRUE : VK_FALSE;
+
+        VkSampler vkSampler = VK_NULL_HANDLE;
+        VkResult vkResult = vkCreateSampler(m_vkDevice, &samplerCreateInfo, nullptr, &vkSampler);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("VulkanSamplerCache :: vkCreateSampler failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return VK_NULL_HANDLE;
+        }
+
+        m_samplers.emplace(key, vkSampler);
+        return vkSampler;
+    }
+
+    size_t VulkanSamplerCache::getSamplerCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_samplers.size();
+    }
+}   // namespace keplar
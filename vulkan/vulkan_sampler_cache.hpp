@@ -0,0 +1,77 @@
+// ────────────────────────────────────────────
+//  File: vulkan_sampler_cache.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // device-wide cache of immutable samplers keyed by their create info. every texture asking for the same filtering,
+    // wrapping and lod state gets the same handle, so per-texture samplers cost one object per distinct state.
+    // anisotropy is clamped to what the device enabled, which folds requests the device cannot honor into their
+    // plain counterparts. samplers live until the cache is destroyed with the device; callers never destroy them.
+    // internally synchronized
+    class VulkanSamplerCache final
+    {
+        public:
+            // creation and destruction
+            VulkanSamplerCache() noexcept;
+            ~VulkanSamplerCache();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanSamplerCache(const VulkanSamplerCache&) = delete;
+            VulkanSamplerCache& operator=(const VulkanSamplerCache&) = delete;
+            VulkanSamplerCache(VulkanSamplerCache&&) = delete;
+            VulkanSamplerCache& operator=(VulkanSamplerCache&&) = delete;
+
+            // maxAnisotropy of 0 (or a device without samplerAnisotropy) disables anisotropic filtering
+            bool initialize(VkDevice vkDevice, float maxAnisotropy) noexcept;
+            void destroy() noexcept;
+
+            // usage: pNext chains are not supported. returns VK_NULL_HANDLE on failure
+            VkSampler getOrCreate(const VkSamplerCreateInfo& createInfo) noexcept;
+
+            // accessors
+            bool isAnisotropyEnabled() const noexcept { return m_maxAnisotropy >= 1.0f; }
+            float getMaxAnisotropy() const noexcept { return m_maxAnisotropy; }
+            size_t getSamplerCount() const noexcept;
+
+        private:
+            // create info fields that define the sampler, after clamping
+            struct SamplerKey
+            {
+                VkSamplerCreateFlags    mFlags = 0;
+                VkFilter                mMagFilter = VK_FILTER_NEAREST;
+                VkFilter                mMinFilter = VK_FILTER_NEAREST;
+                VkSamplerMipmapMode     mMipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+                VkSamplerAddressMode    mAddressModes[3] = {};
+                float                   mMipLodBias = 0.0f;
+                float                   mMaxAnisotropy = 1.0f;      // 1: anisotropy disabled
+                VkCompareOp             mCompareOp = VK_COMPARE_OP_NEVER;
+                bool                    mCompareEnable = false;
+                float                   mMinLod = 0.0f;
+                float                   mMaxLod = 0.0f;
+                VkBorderColor           mBorderColor = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+                bool                    mUnnormalizedCoordinates = false;
+
+                bool operator==(const SamplerKey& other) const noexcept;
+            };
+
+            struct SamplerKeyHash
+            {
+                size_t operator()(const SamplerKey& key) const noexcept;
+            };
+
+        private:
+            // vulkan handles
+            VkDevice                                                    m_vkDevice;
+            float                                                       m_maxAnisotropy;
+            std::unordered_map<SamplerKey, VkSampler, SamplerKeyHash>   m_samplers;
+            mutable std::mutex                                          m_mutex;
+    };
+}   // namespace keplar
@@ -40,7 +40,7 @@ namespace keplar
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
-            m_samplers.fill(VK_NULL_HANDLE);
+            other.m_samplers.fill(VK_NULL_HANDLE);
         }
         
         return *this;
@@ -48,14 +48,13 @@ namespace keplar
 
     bool VulkanSamplers::initialize(const VulkanDevice& device) noexcept
     {
-        // store device handle
+        // store device handle; presets come from the device sampler cache, which also clamps their anisotropy
         m_vkDevice = device.getDevice();
-
-        // query max supported anisotropy 
-        const auto deviceProperties = device.getPhysicalDeviceProperties();
-        const auto enabledFeatures = device.getEnabledFeatures();
-        bool enableAnisotropy = enabledFeatures.samplerAnisotropy;
-        float maxAnisotropy = deviceProperties.limits.maxSamplerAnisotropy;
+        VulkanSamplerCache& samplerCache = device.getSamplerCache();
+        if (!samplerCache.isAnisotropyEnabled())
+        {
+            VK_LOG_WARN("anisotropy is not enabled for the vulkan device : AnisotropicRepeat samples like LinearRepeat");
+        }
 
         // sampler config 
         struct SamplerConfig
@@ -80,13 +79,6 @@ namespace keplar
         {
             const auto& config = samplerConfigs[i];
 
-            // skip if anisotropy feature is not enabled
-            if (config.requestAnisotropy && !enableAnisotropy)
-            {
-                VK_LOG_WARN("sampler creation skipped : anisotropy is not enabled for the vulkan device");
-                continue;
-            }
-
             // sampler creation info structure
             VkSamplerCreateInfo samplerCreateInfo{};
             samplerCreateInfo.sType                     = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -99,8 +91,8 @@ namespace keplar
             samplerCreateInfo.addressModeV              = config.addressMode;
             samplerCreateInfo.addressModeW              = config.addressMode;
             samplerCreateInfo.mipLodBias                = 0.0f;
-            samplerCreateInfo.anisotropyEnable          = (config.requestAnisotropy && enableAnisotropy) ? VK_TRUE : VK_FALSE;
-            samplerCreateInfo.maxAnisotropy             = (config.requestAnisotropy && enableAnisotropy) ? maxAnisotropy : 1.0f;
+            samplerCreateInfo.anisotropyEnable          = config.requestAnisotropy ? VK_TRUE : VK_FALSE;
+            samplerCreateInfo.maxAnisotropy             = config.requestAnisotropy ? samplerCache.getMaxAnisotropy() : 1.0f;
             samplerCreateInfo.compareEnable             = VK_FALSE;
             samplerCreateInfo.compareOp                 = VK_COMPARE_OP_ALWAYS;
             samplerCreateInfo.minLod                    = 0.0f;
@@ -108,11 +100,11 @@ namespace keplar
             samplerCreateInfo.borderColor               = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
             samplerCreateInfo.unnormalizedCoordinates   = VK_FALSE;
 
-            // create vulkan sampler object
-            VkResult vkResult = vkCreateSampler(m_vkDevice, &samplerCreateInfo, nullptr, &m_samplers[i]);
-            if (vkResult != VK_SUCCESS)
+            // shared sampler object, owned by the cache
+            m_samplers[i] = samplerCache.getOrCreate(samplerCreateInfo);
+            if (m_samplers[i] == VK_NULL_HANDLE)
             {
-                VK_LOG_FATAL("vkCreateSampler failed to create sampler for type %d : %s (code: %d)", i, string_VkResult(vkResult), vkResult);
+                VK_LOG_FATAL("failed to create sampler for type %zu", i);
                 return false;
             }
         }
@@ -123,14 +115,8 @@ namespace keplar
 
     void VulkanSamplers::destroy() noexcept
     {
-        // destroy all samplers
-        for (auto& sampler : m_samplers)
-        {
-            if (sampler != VK_NULL_HANDLE)
-            {
-                vkDestroySampler(m_vkDevice, sampler, nullptr);
-                sampler = VK_NULL_HANDLE;
-            }
-        }
+        // the samplers belong to the device sampler cache
+        m_samplers.fill(VK_NULL_HANDLE);
+        m_vkDevice = VK_NULL_HANDLE;
     }
 }   // namespace keplar
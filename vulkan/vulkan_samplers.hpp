@@ -11,6 +11,7 @@
 
 namespace keplar
 {   
+    // common sampler presets, shared through the device sampler cache (which owns them)
     class VulkanSamplers final
     {
         public:
@@ -10,6 +10,7 @@ namespace keplar
     VulkanSemaphore::VulkanSemaphore() noexcept
         : m_vkDevice(VK_NULL_HANDLE)
         , m_vkSemaphore(VK_NULL_HANDLE)
+        , m_isTimeline(false)
     {
     }
 
@@ -19,12 +20,14 @@ namespace keplar
     }
 
     VulkanSemaphore::VulkanSemaphore(VulkanSemaphore&& other) noexcept
-        : m_vkDevice(VK_NULL_HANDLE)
-        , m_vkSemaphore(VK_NULL_HANDLE)
+        : m_vkDevice(other.m_vkDevice)
+        , m_vkSemaphore(other.m_vkSemaphore)
+        , m_isTimeline(other.m_isTimeline)
     {
         // reset the other
         other.m_vkDevice = VK_NULL_HANDLE;
         other.m_vkSemaphore = VK_NULL_HANDLE;
+        other.m_isTimeline = false;
     }
 
     VulkanSemaphore& VulkanSemaphore::operator=(VulkanSemaphore&& other) noexcept
@@ -37,10 +40,12 @@ namespace keplar
             // transfer ownership
             m_vkDevice = other.m_vkDevice;
             m_vkSemaphore = other.m_vkSemaphore;
+            m_isTimeline = other.m_isTimeline;
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
             other.m_vkSemaphore = VK_NULL_HANDLE;
+            other.m_isTimeline = false;
         }
 
         return *this;
@@ -65,10 +70,81 @@ namespace keplar
 
         // store device handle for destruction
         m_vkDevice = vkDevice;
+        m_isTimeline = false;
         VK_LOG_DEBUG("semaphore object created successfully");
         return true;
     }
 
+    bool VulkanSemaphore::initializeTimeline(VkDevice vkDevice, uint64_t initialValue) noexcept
+    {
+        // semaphore type chained into the regular create info
+        VkSemaphoreTypeCreateInfo typeCreateInfo{};
+        typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeCreateInfo.pNext = nullptr;
+        typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeCreateInfo.initialValue = initialValue;
+
+        VkSemaphoreCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeCreateInfo;
+        createInfo.flags = 0;
+
+        if (!initialize(vkDevice, createInfo))
+        {
+            return false;
+        }
+
+        m_isTimeline = true;
+        return true;
+    }
+
+    bool VulkanSemaphore::signal(uint64_t value) const noexcept
+    {
+        VkSemaphoreSignalInfo signalInfo{};
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        signalInfo.pNext = nullptr;
+        signalInfo.semaphore = m_vkSemaphore;
+        signalInfo.value = value;
+
+        VkResult vkResult = vkSignalSemaphore(m_vkDevice, &signalInfo);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkSignalSemaphore failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanSemaphore::wait(uint64_t value, uint64_t timeout) const noexcept
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.pNext = nullptr;
+        waitInfo.flags = 0;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_vkSemaphore;
+        waitInfo.pValues = &value;
+
+        // a timeout is an expected outcome for polling callers, not an error
+        VkResult vkResult = vkWaitSemaphores(m_vkDevice, &waitInfo, timeout);
+        if (vkResult != VK_SUCCESS && vkResult != VK_TIMEOUT)
+        {
+            VK_LOG_ERROR("vkWaitSemaphores failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+        }
+        return vkResult == VK_SUCCESS;
+    }
+
+    bool VulkanSemaphore::getCounterValue(uint64_t& value) const noexcept
+    {
+        VkResult vkResult = vkGetSemaphoreCounterValue(m_vkDevice, m_vkSemaphore, &value);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("vkGetSemaphoreCounterValue failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return true;
+    }
+
     void VulkanSemaphore::destroy() noexcept
     {
         // destroy semaphore
@@ -77,6 +153,7 @@ namespace keplar
             vkDestroySemaphore(m_vkDevice, m_vkSemaphore, nullptr);
             m_vkSemaphore = VK_NULL_HANDLE;
             m_vkDevice = VK_NULL_HANDLE;
+            m_isTimeline = false;
             VK_LOG_DEBUG("semaphore object destroyed successfully");
         }
     }
@@ -25,14 +25,23 @@ namespace keplar
 
             // usage
             bool initialize(VkDevice vkDevice, const VkSemaphoreCreateInfo& createInfo) noexcept;
+            bool initializeTimeline(VkDevice vkDevice, uint64_t initialValue = 0) noexcept;
             void destroy() noexcept;
 
+            // timeline usage (timelineSemaphore feature): host signal, host wait and counter query.
+            // wait returns false on timeout or error; values only ever increase
+            bool signal(uint64_t value) const noexcept;
+            bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const noexcept;
+            bool getCounterValue(uint64_t& value) const noexcept;
+
             // accessor
             VkSemaphore get() const noexcept { return m_vkSemaphore; }
             bool isValid() const noexcept { return m_vkSemaphore != VK_NULL_HANDLE; }
+            bool isTimeline() const noexcept { return m_isTimeline; }
 
         private:
             VkDevice m_vkDevice;
             VkSemaphore m_vkSemaphore;
+            bool m_isTimeline;
     };
 }   // namespace keplar
@@ -4,8 +4,9 @@
 
 #include "vulkan_shader.hpp"
 
-#include <fstream>
 #include "core/keplar_config.hpp"
+#include "utils/asset_pack.hpp"
+#include "utils/async_file_io.hpp"
 #include "utils/logger.hpp"
 
 namespace keplar
@@ -19,8 +20,8 @@ namespace keplar
 
     VulkanShader::~VulkanShader()
     {
-        // destroy shader module
-        if (m_vkShaderModule != VK_NULL_HANDLE)
+        // destroy shader module (a cached one goes with its last shader)
+        if (m_vkShaderModule != VK_NULL_HANDLE && !m_cachedModule)
         {
             vkDestroyShaderModule(m_vkDevice, m_vkShaderModule, nullptr);
             m_vkShaderModule = VK_NULL_HANDLE;
@@ -33,11 +34,15 @@ namespace keplar
         : m_vkDevice(other.m_vkDevice)
         , m_vkShaderModule(other.m_vkShaderModule)
         , m_vkPipelineShaderStageCreateInfo(other.m_vkPipelineShaderStageCreateInfo)
+        , m_reflection(std::move(other.m_reflection))
+        , m_cachedModule(std::move(other.m_cachedModule))
+        , m_code(std::move(other.m_code))
     {
         // reset the other
         other.m_vkDevice = VK_NULL_HANDLE;
         other.m_vkShaderModule = VK_NULL_HANDLE;
         other.m_vkPipelineShaderStageCreateInfo = {};
+        other.m_reflection.clear();
     }
 
     VulkanShader& VulkanShader::operator=(VulkanShader&& other) noexcept
@@ -45,7 +50,7 @@ namespace keplar
         if (this != &other)
         {
             // release current resources
-            if (m_vkShaderModule != VK_NULL_HANDLE)
+            if (m_vkShaderModule != VK_NULL_HANDLE && !m_cachedModule)
             {
                 vkDestroyShaderModule(m_vkDevice, m_vkShaderModule, nullptr);
             }
@@ -54,11 +59,15 @@ namespace keplar
             m_vkDevice = other.m_vkDevice;
             m_vkShaderModule = other.m_vkShaderModule;
             m_vkPipelineShaderStageCreateInfo = other.m_vkPipelineShaderStageCreateInfo;
+            m_reflection = std::move(other.m_reflection);
+            m_cachedModule = std::move(other.m_cachedModule);
+            m_code = std::move(other.m_code);
 
             // reset the other
             other.m_vkDevice = VK_NULL_HANDLE;
             other.m_vkShaderModule = VK_NULL_HANDLE;
             other.m_vkPipelineShaderStageCreateInfo = {};
+            other.m_reflection.clear();
         }
 
         return *this;
@@ -73,6 +82,9 @@ namespace keplar
             return false;
         }
 
+        // the module created below is owned by this shader
+        m_cachedModule.reset();
+
         // build full path to SPIR-V file
         std::filesystem::path filepath = keplar::config::kShaderDir / spirvFile;
 
@@ -84,6 +96,12 @@ namespace keplar
             return false;
         }
 
+        // reflect descriptor bindings; a module the parser cannot read still loads, its layouts are then hand-built
+        if (!m_reflection.reflect(spirvCode.data(), spirvCode.size(), stage))
+        {
+            VK_LOG_WARN("VulkanShader::initialize : failed to reflect SPIR-V file '%s'", spirvFile.c_str());
+        }
+
         // shader module creation info
         VkShaderModuleCreateInfo shaderModuleCreateInfo{};
         shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
@@ -111,27 +129,62 @@ namespace keplar
 
         // store device handle for destruction
         m_vkDevice = vkDevice;
+        m_code = std::move(spirvCode);
         VK_LOG_DEBUG("shader module initialized successfully using SPIR-V file: '%s'.", spirvFile.c_str());
         return true;
     }
 
+    bool VulkanShader::initialize(VulkanShaderCache& shaderCache, VkShaderStageFlagBits stage, const std::string& spirvFile) noexcept
+    {
+        // identical binaries share one module, unchanged files are not read again
+        auto cachedModule = shaderCache.acquire(stage, spirvFile);
+        if (!cachedModule)
+        {
+            VK_LOG_WARN("VulkanShader::initialize failed: SPIR-V file '%s' not available", spirvFile.c_str());
+            return false;
+        }
+
+        // release a module created by an earlier initialize
+        if (m_vkShaderModule != VK_NULL_HANDLE && !m_cachedModule)
+        {
+            vkDestroyShaderModule(m_vkDevice, m_vkShaderModule, nullptr);
+        }
+
+        // setup shader stage info for pipeline
+        m_vkPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        m_vkPipelineShaderStageCreateInfo.pNext = nullptr;
+        m_vkPipelineShaderStageCreateInfo.flags = 0;
+        m_vkPipelineShaderStageCreateInfo.stage = stage;
+        m_vkPipelineShaderStageCreateInfo.module = cachedModule->mModule;
+        m_vkPipelineShaderStageCreateInfo.pName = "main";
+        m_vkPipelineShaderStageCreateInfo.pSpecializationInfo = nullptr;
+
+        m_vkDevice = VK_NULL_HANDLE;
+        m_vkShaderModule = cachedModule->mModule;
+        m_reflection = cachedModule->mReflection;
+        m_cachedModule = std::move(cachedModule);
+        m_code.clear();
+        return true;
+    }
+
     std::vector<uint32_t> VulkanShader::loadSPIRVFile(const std::string& filepath) const noexcept
     {
-        // open file and seek to end to determine file size quickly
-        std::ifstream file(filepath, std::ios::ate | std::ios::binary);
-        if (!file.is_open())
+        // size the word buffer from the file (or its packed copy), then read straight into it
+        size_t fileSize = 0;
+        if (!AssetPack::getFileSize(filepath, fileSize) || fileSize == 0)
         {
             return {};
         }
 
-        // get file size and allocate buffer
-        size_t fileSize = static_cast<size_t>(file.tellg());
         std::vector<uint32_t> buffer(fileSize / sizeof(uint32_t));
-
-        // read entire file into buffer
-        file.seekg(0);
-        file.read(reinterpret_cast<char*>(buffer.data()), fileSize);
-        file.close();
+        FileRead read{};
+        read.mPath        = filepath;
+        read.mDestination = buffer.data();
+        read.mCapacity    = buffer.size() * sizeof(uint32_t);
+        if (buffer.empty() || !AsyncFileIO::getThreadInstance().readFiles(&read, 1))
+        {
+            return {};
+        }
 
         // return SPIR-V binary data
         return buffer;
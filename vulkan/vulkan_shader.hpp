@@ -5,6 +5,8 @@
 #pragma once
 
 #include "vulkan_config.hpp"
+#include "vulkan_shader_reflection.hpp"
+#include "vulkan_shader_cache.hpp"
 
 namespace keplar
 {
@@ -26,11 +28,20 @@ namespace keplar
             // usage
             bool initialize(VkDevice vkDevice, VkShaderStageFlagBits stage, const std::string& spirvFile) noexcept;
 
+            // shares the module of the cache (VulkanDevice::getShaderCache) instead of creating one
+            bool initialize(VulkanShaderCache& shaderCache, VkShaderStageFlagBits stage, const std::string& spirvFile) noexcept;
+
             // accessor
             VkShaderModule get() const noexcept { return m_vkShaderModule; }
             const VkPipelineShaderStageCreateInfo& getShaderStageInfo() const noexcept { return m_vkPipelineShaderStageCreateInfo; }
             bool isValid() const noexcept { return m_vkShaderModule != VK_NULL_HANDLE; }
 
+            // spir-v the module was built from, for shader objects; empty for a cached module unless the cache retains code
+            const std::vector<uint32_t>& getCode() const noexcept { return m_cachedModule ? m_cachedModule->mCode : m_code; }
+
+            // descriptor bindings and push constants declared by the module
+            const ShaderReflection& getReflection() const noexcept { return m_reflection; }
+
         private:
             std::vector<uint32_t> loadSPIRVFile(const std::string& filepath) const noexcept;
         
@@ -39,6 +50,15 @@ namespace keplar
             VkDevice m_vkDevice;
             VkShaderModule m_vkShaderModule;
             VkPipelineShaderStageCreateInfo m_vkPipelineShaderStageCreateInfo;
+
+            // resources reflected from the spir-v at load time
+            ShaderReflection m_reflection;
+
+            // owner of the module when it came from a shader cache
+            std::shared_ptr<const CachedShaderModule> m_cachedModule;
+
+            // spir-v of a module created by this shader
+            std::vector<uint32_t> m_code;
     };
 }   // namespace keplar
 
@@ -0,0 +1,262 @@
+// ────────────────────────────────────────────
+//  File: vulkan_shader_cache.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_shader_cache.hpp"
+
+#include <system_error>
+
+#include "utils/cpu_topology.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    constexpr uint32_t kSpirvMagic = 0x07230203;
+
+    // fnv-1a over the binary, seeded with the stage: reflection records the stage in its bindings
+    uint64_t hashModule(const uint8_t* data, size_t size, VkShaderStageFlagBits stage) noexcept
+    {
+        uint64_t hash = 0xcbf29ce484222325ull ^ static_cast<uint64_t>(stage);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+}   // namespace
+
+namespace keplar
+{
+    CachedShaderModule::~CachedShaderModule()
+    {
+        if (mModule != VK_NULL_HANDLE)
+        {
+            vkDestroyShaderModule(mDevice, mModule, nullptr);
+        }
+    }
+
+    VulkanShaderCache::VulkanShaderCache() noexcept
+        : m_vkDevice(VK_NULL_HANDLE)
+        , m_isCodeRetained(false)
+        , m_stopWatching(false)
+    {
+    }
+
+    VulkanShaderCache::~VulkanShaderCache()
+    {
+        destroy();
+    }
+
+    bool VulkanShaderCache::initialize(VkDevice vkDevice, const std::filesystem::path& shaderDir) noexcept
+    {
+        // validate device handle
+        if (vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanShaderCache::initialize failed: VkDevice is VK_NULL_HANDLE");
+            return false;
+        }
+
+        destroy();
+        m_vkDevice = vkDevice;
+        m_shaderDir = shaderDir;
+        VK_LOG_DEBUG("VulkanShaderCache::initialize successful (shader dir: '%s')", m_shaderDir.string().c_str());
+        return true;
+    }
+
+    void VulkanShaderCache::destroy() noexcept
+    {
+        stopWatching();
+
+        // modules still held by shaders are released by their last owner
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_modules.clear();
+        m_files.clear();
+        m_vkDevice = VK_NULL_HANDLE;
+    }
+
+    std::shared_ptr<const CachedShaderModule> VulkanShaderCache::acquire(VkShaderStageFlagBits stage, const std::string& spirvFile) noexcept
+    {
+        const std::filesystem::path filepath = m_shaderDir / spirvFile;
+        std::error_code errorCode;
+        const auto writeTime = std::filesystem::last_write_time(filepath, errorCode);
+        if (errorCode)
+        {
+            VK_LOG_WARN("VulkanShaderCache::acquire : SPIR-V file '%s' not found", filepath.string().c_str());
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_ERROR("VulkanShaderCache::acquire failed: cache not initialized");
+            return nullptr;
+        }
+
+        // unchanged file whose module is still alive: no read at all
+        auto fileIt = m_files.find(spirvFile);
+        if (fileIt != m_files.end() && fileIt->second.mLoadedTime == writeTime)
+        {
+            auto moduleIt = m_modules.find(fileIt->second.mHash);
+            if (moduleIt != m_modules.end())
+            {
+                if (auto cachedModule = moduleIt->second.lock(); cachedModule && cachedModule->mStage == stage)
+                {
+                    return cachedModule;
+                }
+            }
+        }
+
+        // map the binary; the driver copies it during module creation
+        MappedFile mappedFile;
+        if (!mappedFile.open(filepath) || mappedFile.getSize() < sizeof(uint32_t) * 5 || (mappedFile.getSize() % sizeof(uint32_t)) != 0 ||
+            *reinterpret_cast<const uint32_t*>(mappedFile.getData()) != kSpirvMagic)
+        {
+            VK_LOG_WARN("VulkanShaderCache::acquire : '%s' is empty or not a SPIR-V binary", filepath.string().c_str());
+            return nullptr;
+        }
+
+        const uint64_t hash = hashModule(mappedFile.getData(), mappedFile.getSize(), stage);
+        FileRecord& record = m_files[spirvFile];
+        record.mLoadedTime = writeTime;
+        record.mObservedTime = writeTime;
+        record.mReportedTime = writeTime;
+        record.mHash = hash;
+        record.mIsChanged = false;
+
+        // same contents under another name, or a rewrite that changed nothing
+        auto& cachedEntry = m_modules[hash];
+        if (auto cachedModule = cachedEntry.lock())
+        {
+            return cachedModule;
+        }
+
+        const uint32_t* code = reinterpret_cast<const uint32_t*>(mappedFile.getData());
+        const size_t wordCount = mappedFile.getSize() / sizeof(uint32_t);
+
+        VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+        shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        shaderModuleCreateInfo.pNext = nullptr;
+        shaderModuleCreateInfo.flags = 0;
+        shaderModuleCreateInfo.codeSize = mappedFile.getSize();
+        shaderModuleCreateInfo.pCode = code;
+
+        auto cachedModule = std::make_shared<CachedShaderModule>();
+        VkResult vkResult = vkCreateShaderModule(m_vkDevice, &shaderModuleCreateInfo, nullptr, &cachedModule->mModule);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("VulkanShaderCache :: vkCreateShaderModule failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            m_modules.erase(hash);
+            return nullptr;
+        }
+
+        cachedModule->mDevice = m_vkDevice;
+        cachedModule->mStage = stage;
+        cachedModule->mHash = hash;
+        if (m_isCodeRetained)
+        {
+            cachedModule->mCode.assign(code, code + wordCount);
+        }
+        if (!cachedModule->mReflection.reflect(code, wordCount, stage))
+        {
+            VK_LOG_WARN("VulkanShaderCache::acquire : failed to reflect SPIR-V file '%s'", spirvFile.c_str());
+        }
+
+        // drop entries of modules every shader has released
+        for (auto it = m_modules.begin(); it != m_modules.end();)
+        {
+            it = it->second.expired() && it->first != hash ? m_modules.erase(it) : std::next(it);
+        }
+
+        m_modules[hash] = cachedModule;
+        VK_LOG_DEBUG("VulkanShaderCache :: created shader module for '%s' (hash: %016llx)", spirvFile.c_str(), static_cast<unsigned long long>(hash));
+        return cachedModule;
+    }
+
+    bool VulkanShaderCache::startWatching(std::chrono::milliseconds interval) noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE || isWatching())
+        {
+            return isWatching();
+        }
+
+        m_stopWatching = false;
+        m_watchThread = std::thread([this, interval]()
+        {
+            setCurrentThreadName("shader watch");
+            watchLoop(interval);
+        });
+        VK_LOG_INFO("VulkanShaderCache :: watching '%s' for shader changes", m_shaderDir.string().c_str());
+        return true;
+    }
+
+    void VulkanShaderCache::stopWatching() noexcept
+    {
+        if (!m_watchThread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopWatching = true;
+        }
+        m_watchCondition.notify_all();
+        m_watchThread.join();
+        m_stopWatching = false;
+    }
+
+    std::vector<std::string> VulkanShaderCache::collectChangedFiles() noexcept
+    {
+        std::vector<std::string> changedFiles;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [spirvFile, record] : m_files)
+        {
+            if (record.mIsChanged)
+            {
+                record.mIsChanged = false;
+                changedFiles.push_back(spirvFile);
+            }
+        }
+        return changedFiles;
+    }
+
+    size_t VulkanShaderCache::getModuleCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t moduleCount = 0;
+        for (const auto& [hash, cachedModule] : m_modules)
+        {
+            moduleCount += cachedModule.expired() ? 0 : 1;
+        }
+        return moduleCount;
+    }
+
+    void VulkanShaderCache::watchLoop(std::chrono::milliseconds interval) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_watchCondition.wait_for(lock, interval, [this]() { return m_stopWatching; }))
+        {
+            // a handful of stat calls per poll; acquire() only waits on this for the same handful
+            for (auto& [spirvFile, record] : m_files)
+            {
+                std::error_code errorCode;
+                const auto writeTime = std::filesystem::last_write_time(m_shaderDir / spirvFile, errorCode);
+                if (errorCode)
+                {
+                    continue;
+                }
+
+                // report a new write time once it survived a full interval
+                if (writeTime == record.mObservedTime && writeTime != record.mReportedTime)
+                {
+                    record.mReportedTime = writeTime;
+                    record.mIsChanged = true;
+                    VK_LOG_INFO("VulkanShaderCache :: '%s' changed on disk", spirvFile.c_str());
+                }
+                record.mObservedTime = writeTime;
+            }
+        }
+    }
+}   // namespace keplar
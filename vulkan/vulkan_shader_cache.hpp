@@ -0,0 +1,104 @@
+// ────────────────────────────────────────────
+//  File: vulkan_shader_cache.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "vulkan_config.hpp"
+#include "vulkan_shader_reflection.hpp"
+
+namespace keplar
+{
+    // shader module built from one spir-v binary, shared by every shader that loads the same contents for a stage
+    struct CachedShaderModule
+    {
+        VkDevice                mDevice     = VK_NULL_HANDLE;
+        VkShaderModule          mModule     = VK_NULL_HANDLE;
+        VkShaderStageFlagBits   mStage      = VK_SHADER_STAGE_ALL;
+        ShaderReflection        mReflection;
+        uint64_t                mHash       = 0;
+        std::vector<uint32_t>   mCode;                  // only while the cache retains code (shader objects)
+
+        ~CachedShaderModule();
+    };
+
+    // device-wide cache of shader modules keyed by the hash of their spir-v. files are memory mapped instead of
+    // streamed, a file whose write time has not changed is not read again, and identical binaries share one module.
+    // modules live as long as a shader holds them.
+    //
+    // hot reload (debug builds): a watcher thread polls the write times of every file acquired so far and reports
+    // the ones rewritten since; a file is only reported once its write time held still for one poll, so a compiler
+    // still writing it is not picked up half way
+    class VulkanShaderCache final
+    {
+        public:
+            static constexpr std::chrono::milliseconds kDefaultWatchInterval{ 250 };
+
+            // creation and destruction
+            VulkanShaderCache() noexcept;
+            ~VulkanShaderCache();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanShaderCache(const VulkanShaderCache&) = delete;
+            VulkanShaderCache& operator=(const VulkanShaderCache&) = delete;
+            VulkanShaderCache(VulkanShaderCache&&) = delete;
+            VulkanShaderCache& operator=(VulkanShaderCache&&) = delete;
+
+            bool initialize(VkDevice vkDevice, const std::filesystem::path& shaderDir) noexcept;
+            void destroy() noexcept;
+
+            // usage: module of a file relative to the shader directory; nullptr when missing or not spir-v
+            std::shared_ptr<const CachedShaderModule> acquire(VkShaderStageFlagBits stage, const std::string& spirvFile) noexcept;
+
+            // usage: hot reload. changed files are named as they were passed to acquire, which then reads them again
+            bool startWatching(std::chrono::milliseconds interval = kDefaultWatchInterval) noexcept;
+            void stopWatching() noexcept;
+            std::vector<std::string> collectChangedFiles() noexcept;
+
+            // usage: keep the spir-v of modules created from now on, for shader objects built from it
+            void setCodeRetained(bool isRetained) noexcept { m_isCodeRetained = isRetained; }
+
+            // accessors
+            bool isWatching() const noexcept { return m_watchThread.joinable(); }
+            size_t getModuleCount() const noexcept;
+
+        private:
+            // last contents read from a file, and what the watcher saw of it
+            struct FileRecord
+            {
+                std::filesystem::file_time_type     mLoadedTime;        // write time of the hashed contents
+                std::filesystem::file_time_type     mObservedTime;      // write time at the previous poll
+                std::filesystem::file_time_type     mReportedTime;      // write time last reported as changed
+                uint64_t                            mHash = 0;          // stage and content hash
+                bool                                mIsChanged = false;
+            };
+
+            void watchLoop(std::chrono::milliseconds interval) noexcept;
+
+        private:
+            // vulkan handles
+            VkDevice                                                            m_vkDevice;
+            std::filesystem::path                                               m_shaderDir;
+
+            // modules by hash, files by name
+            std::unordered_map<uint64_t, std::weak_ptr<CachedShaderModule>>     m_modules;
+            std::unordered_map<std::string, FileRecord>                         m_files;
+            mutable std::mutex                                                  m_mutex;
+            bool                                                                m_isCodeRetained;
+
+            // watcher
+            std::thread                                                         m_watchThread;
+            std::condition_variable                                             m_watchCondition;
+            bool                                                                m_stopWatching;
+    };
+}   // namespace keplar
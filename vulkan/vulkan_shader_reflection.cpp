@@ -0,0 +1,503 @@
+// ────────────────────────────────────────────
+//  File: vulkan_shader_reflection.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_shader_reflection.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "utils/logger.hpp"
+
+namespace
+{
+    // spir-v binary layout (spir-v specification, section 2.3 and 3)
+    constexpr uint32_t kSpirvMagic              = 0x07230203;
+    constexpr size_t   kHeaderWordCount         = 5;
+
+    // opcodes
+    constexpr uint32_t kOpTypeInt               = 21;
+    constexpr uint32_t kOpTypeFloat             = 22;
+    constexpr uint32_t kOpTypeVector            = 23;
+    constexpr uint32_t kOpTypeMatrix            = 24;
+    constexpr uint32_t kOpTypeImage             = 25;
+    constexpr uint32_t kOpTypeSampler           = 26;
+    constexpr uint32_t kOpTypeSampledImage      = 27;
+    constexpr uint32_t kOpTypeArray             = 28;
+    constexpr uint32_t kOpTypeRuntimeArray      = 29;
+    constexpr uint32_t kOpTypeStruct            = 30;
+    constexpr uint32_t kOpTypePointer           = 32;
+    constexpr uint32_t kOpConstant              = 43;
+    constexpr uint32_t kOpSpecConstant          = 50;
+    constexpr uint32_t kOpVariable              = 59;
+    constexpr uint32_t kOpDecorate              = 71;
+    constexpr uint32_t kOpMemberDecorate        = 72;
+    constexpr uint32_t kOpTypeAccelerationStructure = 5341;
+
+    // decorations
+    constexpr uint32_t kDecorationBlock         = 2;
+    constexpr uint32_t kDecorationBufferBlock   = 3;
+    constexpr uint32_t kDecorationArrayStride   = 6;
+    constexpr uint32_t kDecorationMatrixStride  = 7;
+    constexpr uint32_t kDecorationBinding       = 33;
+    constexpr uint32_t kDecorationDescriptorSet = 34;
+    constexpr uint32_t kDecorationOffset        = 35;
+
+    // storage classes
+    constexpr uint32_t kStorageUniformConstant  = 0;
+    constexpr uint32_t kStorageUniform          = 2;
+    constexpr uint32_t kStoragePushConstant     = 9;
+    constexpr uint32_t kStorageStorageBuffer    = 12;
+
+    // image dimensions and sampled modes
+    constexpr uint32_t kDimBuffer               = 5;
+    constexpr uint32_t kDimSubpassData          = 6;
+    constexpr uint32_t kImageSampled            = 1;
+
+    // the ids the reflection needs: types, constants, decorations and variables
+    struct SpirvId
+    {
+        uint32_t                mOpcode         = 0;
+        std::vector<uint32_t>   mOperands;                  // operands after the result id
+        uint32_t                mSet            = UINT32_MAX;
+        uint32_t                mBinding        = UINT32_MAX;
+        uint32_t                mArrayStride    = 0;
+        bool                    mIsBlock        = false;
+        bool                    mIsBufferBlock  = false;
+        std::vector<uint32_t>   mMemberOffsets;
+        std::vector<uint32_t>   mMemberMatrixStrides;
+    };
+
+    using SpirvIds = std::unordered_map<uint32_t, SpirvId>;
+
+    void setMemberDecoration(std::vector<uint32_t>& values, uint32_t member, uint32_t value) noexcept
+    {
+        if (values.size() <= member)
+        {
+            values.resize(member + 1, 0);
+        }
+        values[member] = value;
+    }
+
+    const SpirvId* findId(const SpirvIds& ids, uint32_t id) noexcept
+    {
+        auto it = ids.find(id);
+        return (it != ids.end()) ? &it->second : nullptr;
+    }
+
+    // byte size of a type inside a block, runtime arrays count as empty; matrixStride comes from the enclosing struct member
+    uint32_t getTypeSize(const SpirvIds& ids, uint32_t typeId, uint32_t matrixStride = 0) noexcept
+    {
+        const SpirvId* type = findId(ids, typeId);
+        if (type == nullptr)
+        {
+            return 0;
+        }
+
+        switch (type->mOpcode)
+        {
+            case kOpTypeInt:
+            case kOpTypeFloat:
+                return type->mOperands.empty() ? 0 : type->mOperands[0] / 8;
+
+            case kOpTypeVector:
+                return type->mOperands.size() < 2 ? 0 : getTypeSize(ids, type->mOperands[0]) * type->mOperands[1];
+
+            case kOpTypeMatrix:
+                if (type->mOperands.size() < 2)
+                {
+                    return 0;
+                }
+                return (matrixStride ? matrixStride : getTypeSize(ids, type->mOperands[0])) * type->mOperands[1];
+
+            case kOpTypeArray:
+            {
+                const SpirvId* length = type->mOperands.size() < 2 ? nullptr : findId(ids, type->mOperands[1]);
+                const uint32_t count = (length && length->mOperands.size() >= 2) ? length->mOperands[1] : 0;
+                const uint32_t stride = type->mArrayStride ? type->mArrayStride : getTypeSize(ids, type->mOperands[0], matrixStride);
+                return stride * count;
+            }
+
+            case kOpTypeStruct:
+            {
+                // the last member decides the size, members are laid out by their offsets
+                uint32_t size = 0;
+                for (size_t member = 0; member < type->mOperands.size(); ++member)
+                {
+                    const uint32_t offset = member < type->mMemberOffsets.size() ? type->mMemberOffsets[member] : 0;
+                    const uint32_t stride = member < type->mMemberMatrixStrides.size() ? type->mMemberMatrixStrides[member] : 0;
+                    size = std::max(size, offset + getTypeSize(ids, type->mOperands[member], stride));
+                }
+                return size;
+            }
+
+            default:
+                return 0;
+        }
+    }
+
+    // descriptor type and array size of a resource variable's pointee
+    bool getDescriptorType(const SpirvIds& ids, uint32_t storageClass, uint32_t typeId, VkDescriptorType& descriptorType, uint32_t& count) noexcept
+    {
+        count = 1;
+        const SpirvId* type = findId(ids, typeId);
+
+        // arrays of resources, runtime-sized ones count as 0
+        while (type && (type->mOpcode == kOpTypeArray || type->mOpcode == kOpTypeRuntimeArray) && !type->mOperands.empty())
+        {
+            if (type->mOpcode == kOpTypeRuntimeArray)
+            {
+                count = 0;
+            }
+            else
+            {
+                const SpirvId* length = type->mOperands.size() < 2 ? nullptr : findId(ids, type->mOperands[1]);
+                count *= (length && length->mOperands.size() >= 2) ? length->mOperands[1] : 1;
+            }
+            type = findId(ids, type->mOperands[0]);
+        }
+
+        if (type == nullptr)
+        {
+            return false;
+        }
+
+        switch (type->mOpcode)
+        {
+            case kOpTypeSampler:
+                descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+                return true;
+
+            case kOpTypeSampledImage:
+                descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                return true;
+
+            case kOpTypeImage:
+            {
+                // operands: sampled type, dim, depth, arrayed, ms, sampled, format
+                if (type->mOperands.size() < 6)
+                {
+                    return false;
+                }
+                const uint32_t dim = type->mOperands[1];
+                const bool isSampled = type->mOperands[5] == kImageSampled;
+                if (dim == kDimSubpassData)
+                {
+                    descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                }
+                else if (dim == kDimBuffer)
+                {
+                    descriptorType = isSampled ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+                }
+                else
+                {
+                    descriptorType = isSampled ? VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                }
+                return true;
+            }
+
+            case kOpTypeAccelerationStructure:
+                descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+                return true;
+
+            case kOpTypeStruct:
+                // storage buffers are StorageBuffer blocks, or Uniform BufferBlocks in older spir-v
+                if (storageClass == kStorageStorageBuffer || type->mIsBufferBlock)
+                {
+                    descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                    return true;
+                }
+                if (storageClass == kStorageUniform && type->mIsBlock)
+                {
+                    descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                    return true;
+                }
+                return false;
+
+            default:
+                return false;
+        }
+    }
+}   // namespace
+
+namespace keplar
+{
+    bool ShaderReflection::reflect(const uint32_t* code, size_t wordCount, VkShaderStageFlagBits stage) noexcept
+    {
+        clear();
+        m_stage = stage;
+
+        // validate header
+        if (code == nullptr || wordCount < kHeaderWordCount || code[0] != kSpirvMagic)
+        {
+            VK_LOG_ERROR("ShaderReflection::reflect failed: not a spir-v module");
+            return false;
+        }
+
+        // one pass over the instructions collects types, constants, decorations and variables
+        SpirvIds ids;
+        std::vector<uint32_t> variables;
+        for (size_t word = kHeaderWordCount; word < wordCount;)
+        {
+            const uint32_t opcode = code[word] & 0xFFFFu;
+            const uint32_t length = code[word] >> 16;
+            if (length == 0 || word + length > wordCount)
+            {
+                VK_LOG_ERROR("ShaderReflection::reflect failed: truncated instruction at word %zu", word);
+                clear();
+                return false;
+            }
+            const uint32_t* operands = code + word + 1;
+            const uint32_t operandCount = length - 1;
+
+            switch (opcode)
+            {
+                case kOpTypeInt:
+                case kOpTypeFloat:
+                case kOpTypeVector:
+                case kOpTypeMatrix:
+                case kOpTypeImage:
+                case kOpTypeSampler:
+                case kOpTypeSampledImage:
+                case kOpTypeArray:
+                case kOpTypeRuntimeArray:
+                case kOpTypeStruct:
+                case kOpTypePointer:
+                case kOpTypeAccelerationStructure:
+                    if (operandCount >= 1)
+                    {
+                        SpirvId& id = ids[operands[0]];
+                        id.mOpcode = opcode;
+                        id.mOperands.assign(operands + 1, operands + operandCount);
+                    }
+                    break;
+
+                case kOpConstant:
+                case kOpSpecConstant:
+                case kOpVariable:
+                    // result type first, then the result id: operands keep the type and the value or storage class
+                    if (operandCount >= 3)
+                    {
+                        SpirvId& id = ids[operands[1]];
+                        id.mOpcode = opcode;
+                        id.mOperands = { operands[0], operands[2] };
+                        if (opcode == kOpVariable)
+                        {
+                            variables.push_back(operands[1]);
+                        }
+                    }
+                    break;
+
+                case kOpDecorate:
+                    if (operandCount >= 2)
+                    {
+                        SpirvId& id = ids[operands[0]];
+                        const uint32_t value = operandCount >= 3 ? operands[2] : 0;
+                        switch (operands[1])
+                        {
+                            case kDecorationBlock:          id.mIsBlock = true; break;
+                            case kDecorationBufferBlock:    id.mIsBufferBlock = true; break;
+                            case kDecorationArrayStride:    id.mArrayStride = value; break;
+                            case kDecorationBinding:        id.mBinding = value; break;
+                            case kDecorationDescriptorSet:  id.mSet = value; break;
+                            default: break;
+                        }
+                    }
+                    break;
+
+                case kOpMemberDecorate:
+                    if (operandCount >= 4)
+                    {
+                        SpirvId& id = ids[operands[0]];
+                        if (operands[2] == kDecorationOffset)
+                        {
+                            setMemberDecoration(id.mMemberOffsets, operands[1], operands[3]);
+                        }
+                        else if (operands[2] == kDecorationMatrixStride)
+                        {
+                            setMemberDecoration(id.mMemberMatrixStrides, operands[1], operands[3]);
+                        }
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+
+            word += length;
+        }
+
+        // resource variables: pointer type -> pointee, decorated with set and binding
+        for (uint32_t variableId : variables)
+        {
+            const SpirvId& variable = ids[variableId];
+            const uint32_t storageClass = variable.mOperands[1];
+            const SpirvId* pointer = findId(ids, variable.mOperands[0]);
+            if (pointer == nullptr || pointer->mOpcode != kOpTypePointer || pointer->mOperands.size() < 2)
+            {
+                continue;
+            }
+
+            // push constant block: one range from its first member to its end
+            if (storageClass == kStoragePushConstant)
+            {
+                const SpirvId* block = findId(ids, pointer->mOperands[1]);
+                const uint32_t size = getTypeSize(ids, pointer->mOperands[1]);
+                const uint32_t offset = (block && !block->mMemberOffsets.empty()) ?
+                                        *std::min_element(block->mMemberOffsets.begin(), block->mMemberOffsets.end()) : 0;
+                if (size > offset)
+                {
+                    m_pushConstantRange = { static_cast<VkShaderStageFlags>(stage), offset, size - offset };
+                }
+                continue;
+            }
+
+            if (storageClass != kStorageUniformConstant && storageClass != kStorageUniform && storageClass != kStorageStorageBuffer)
+            {
+                continue;
+            }
+            if (variable.mSet == UINT32_MAX || variable.mBinding == UINT32_MAX)
+            {
+                continue;
+            }
+
+            ShaderResourceBinding binding{};
+            binding.mSet = variable.mSet;
+            binding.mBinding = variable.mBinding;
+            binding.mStages = static_cast<VkShaderStageFlags>(stage);
+            if (!getDescriptorType(ids, storageClass, pointer->mOperands[1], binding.mType, binding.mCount))
+            {
+                VK_LOG_WARN("ShaderReflection::reflect :: unsupported resource type at set %u binding %u", binding.mSet, binding.mBinding);
+                continue;
+            }
+            if (binding.mType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || binding.mType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+            {
+                binding.mBlockSize = getTypeSize(ids, pointer->mOperands[1]);
+            }
+            m_bindings.push_back(binding);
+        }
+
+        // stable order for layout building and comparison
+        std::sort(m_bindings.begin(), m_bindings.end(), [](const ShaderResourceBinding& a, const ShaderResourceBinding& b)
+        {
+            return a.mSet != b.mSet ? a.mSet < b.mSet : a.mBinding < b.mBinding;
+        });
+        return true;
+    }
+
+    void ShaderReflection::clear() noexcept
+    {
+        m_bindings.clear();
+        m_pushConstantRange = {};
+        m_stage = VK_SHADER_STAGE_ALL;
+    }
+
+    void ReflectedPipelineLayout::add(const ShaderReflection& reflection) noexcept
+    {
+        for (const ShaderResourceBinding& resource : reflection.getBindings())
+        {
+            if (m_sets.size() <= resource.mSet)
+            {
+                m_sets.resize(resource.mSet + 1);
+            }
+
+            // a binding seen before must agree on type and count, only its stages accumulate
+            Set& set = m_sets[resource.mSet];
+            auto it = std::find_if(set.mBindings.begin(), set.mBindings.end(), [&](const VkDescriptorSetLayoutBinding& binding)
+            {
+                return binding.binding == resource.mBinding;
+            });
+            if (it == set.mBindings.end())
+            {
+                set.mBindings.push_back({ resource.mBinding, resource.mType, resource.mCount, resource.mStages, nullptr });
+                set.mBlockSizes.push_back(resource.mBlockSize);
+            }
+            else if (it->descriptorType == resource.mType && it->descriptorCount == resource.mCount)
+            {
+                // stages may declare a block only up to the members they read
+                it->stageFlags |= resource.mStages;
+                uint32_t& blockSize = set.mBlockSizes[static_cast<size_t>(it - set.mBindings.begin())];
+                blockSize = std::max(blockSize, resource.mBlockSize);
+            }
+            else
+            {
+                VK_LOG_DEBUG("ReflectedPipelineLayout :: set %u binding %u is declared differently by two stages", resource.mSet, resource.mBinding);
+                set.mHasConflict = true;
+            }
+        }
+
+        // push constants merge into one range covering every stage's block
+        if (reflection.hasPushConstants())
+        {
+            const VkPushConstantRange& range = reflection.getPushConstantRange();
+            if (m_pushConstantRanges.empty())
+            {
+                m_pushConstantRanges.push_back(range);
+            }
+            else
+            {
+                VkPushConstantRange& merged = m_pushConstantRanges.front();
+                const uint32_t end = std::max(merged.offset + merged.size, range.offset + range.size);
+                merged.offset = std::min(merged.offset, range.offset);
+                merged.size = end - merged.offset;
+                merged.stageFlags |= range.stageFlags;
+            }
+        }
+    }
+
+    bool ReflectedPipelineLayout::getSetBindings(uint32_t set, std::vector<VkDescriptorSetLayoutBinding>& bindings) const noexcept
+    {
+        bindings.clear();
+        if (set >= m_sets.size())
+        {
+            return true;
+        }
+        if (m_sets[set].mHasConflict)
+        {
+            return false;
+        }
+
+        bindings = m_sets[set].mBindings;
+        std::sort(bindings.begin(), bindings.end(), [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b)
+        {
+            return a.binding < b.binding;
+        });
+        return true;
+    }
+
+    bool ReflectedPipelineLayout::setBindingType(uint32_t set, uint32_t binding, VkDescriptorType type) noexcept
+    {
+        if (set >= m_sets.size())
+        {
+            return false;
+        }
+
+        for (VkDescriptorSetLayoutBinding& layoutBinding : m_sets[set].mBindings)
+        {
+            if (layoutBinding.binding == binding)
+            {
+                layoutBinding.descriptorType = type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t ReflectedPipelineLayout::getBlockSize(uint32_t set, uint32_t binding) const noexcept
+    {
+        if (set >= m_sets.size())
+        {
+            return 0;
+        }
+
+        const Set& reflectedSet = m_sets[set];
+        for (size_t i = 0; i < reflectedSet.mBindings.size(); ++i)
+        {
+            if (reflectedSet.mBindings[i].binding == binding)
+            {
+                return reflectedSet.mBlockSizes[i];
+            }
+        }
+        return 0;
+    }
+}   // namespace keplar
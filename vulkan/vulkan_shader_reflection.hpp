@@ -0,0 +1,79 @@
+// ────────────────────────────────────────────
+//  File: vulkan_shader_reflection.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan_config.hpp"
+
+namespace keplar
+{
+    // descriptor binding declared by a shader module
+    struct ShaderResourceBinding
+    {
+        uint32_t            mSet            = 0;
+        uint32_t            mBinding        = 0;
+        VkDescriptorType    mType           = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        uint32_t            mCount          = 1;        // array size, 0 for runtime-sized arrays
+        VkShaderStageFlags  mStages         = 0;
+        uint32_t            mBlockSize      = 0;        // bytes of a buffer block without its runtime array, 0 for other resources
+    };
+
+    // resources a spir-v module declares: descriptor bindings and its push constant block. read once from the binary
+    // at load time, so descriptor set and pipeline layouts follow the shaders instead of being restated by hand.
+    // the spir-v cannot tell dynamic buffers apart, callers promote those bindings when they build their layouts
+    class ShaderReflection final
+    {
+        public:
+            // usage: false for a malformed module, the reflection is then left empty
+            bool reflect(const uint32_t* code, size_t wordCount, VkShaderStageFlagBits stage) noexcept;
+            void clear() noexcept;
+
+            // accessors
+            const std::vector<ShaderResourceBinding>& getBindings() const noexcept  { return m_bindings; }
+            const VkPushConstantRange& getPushConstantRange() const noexcept        { return m_pushConstantRange; }
+            bool hasPushConstants() const noexcept                                  { return m_pushConstantRange.size > 0; }
+            VkShaderStageFlagBits getStage() const noexcept                         { return m_stage; }
+
+        private:
+            std::vector<ShaderResourceBinding>  m_bindings;
+            VkPushConstantRange                 m_pushConstantRange = {};
+            VkShaderStageFlagBits               m_stage = VK_SHADER_STAGE_ALL;
+    };
+
+    // descriptor set and push constant layout of a pipeline, merged from the reflections of its stages (or of every
+    // pipeline that shares the layouts). a binding declared differently by two stages marks its set as conflicting
+    class ReflectedPipelineLayout final
+    {
+        public:
+            // usage: merge each stage, then read the sets out
+            void add(const ShaderReflection& reflection) noexcept;
+
+            // bindings of one set sorted by binding number; false when the stages disagree about the set
+            bool getSetBindings(uint32_t set, std::vector<VkDescriptorSetLayoutBinding>& bindings) const noexcept;
+
+            // the binding's type in the merged layout, e.g. to promote a uniform buffer to a dynamic one
+            bool setBindingType(uint32_t set, uint32_t binding, VkDescriptorType type) noexcept;
+
+            // largest block any stage declares at a buffer binding (0 if none), to check it against the struct filling it
+            uint32_t getBlockSize(uint32_t set, uint32_t binding) const noexcept;
+
+            // accessors
+            uint32_t getSetCount() const noexcept { return static_cast<uint32_t>(m_sets.size()); }
+            const std::vector<VkPushConstantRange>& getPushConstantRanges() const noexcept { return m_pushConstantRanges; }
+
+        private:
+            struct Set
+            {
+                std::vector<VkDescriptorSetLayoutBinding>   mBindings;
+                std::vector<uint32_t>                       mBlockSizes;    // per entry of mBindings
+                bool                                        mHasConflict = false;
+            };
+
+        private:
+            std::vector<Set>                    m_sets;
+            std::vector<VkPushConstantRange>    m_pushConstantRanges;
+    };
+}   // namespace keplar
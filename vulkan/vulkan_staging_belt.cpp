@@ -0,0 +1,846 @@
+// ────────────────────────────────────────────
+//  File: vulkan_staging_belt.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan_staging_belt.hpp"
+
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace
+{
+    // minimum alignment of staging offsets (buffer-to-image copies need multiples of 4)
+    constexpr VkDeviceSize kMinStagingAlignment = 16;
+
+    // recycled command buffers and fences kept per kind; a burst of batches beyond this frees the rest
+    constexpr size_t kMaxFreeObjects = 8;
+
+    inline VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // transfer-only families may restrict image copies to coarse blocks; only accept texel granularity
+    bool hasTexelCopyGranularity(VkPhysicalDevice vkPhysicalDevice, uint32_t queueFamilyIndex) noexcept
+    {
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(vkPhysicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(vkPhysicalDevice, &queueFamilyCount, queueFamilyProperties.data());
+
+        if (queueFamilyIndex >= queueFamilyCount)
+        {
+            return false;
+        }
+
+        const VkExtent3D& granularity = queueFamilyProperties[queueFamilyIndex].minImageTransferGranularity;
+        return granularity.width == 1 && granularity.height == 1 && granularity.depth == 1;
+    }
+}
+
+namespace keplar
+{
+    VulkanStagingBelt::VulkanStagingBelt() noexcept
+        : m_device(nullptr)
+        , m_vkDevice(VK_NULL_HANDLE)
+        , m_vkQueue(VK_NULL_HANDLE)
+        , m_vkGraphicsQueue(VK_NULL_HANDLE)
+        , m_queueFamilyIndex(0)
+        , m_graphicsQueueFamilyIndex(0)
+        , m_usesTransferQueue(false)
+        , m_mappedData(nullptr)
+        , m_capacity(0)
+        , m_head(0)
+        , m_tail(0)
+        , m_isRecording(false)
+        , m_nextTicket(1)
+    {
+    }
+
+    VulkanStagingBelt::~VulkanStagingBelt()
+    {
+        destroy();
+    }
+
+    bool VulkanStagingBelt::initialize(const VulkanDevice& device, VkDeviceSize capacity) noexcept
+    {
+        if (capacity == 0)
+        {
+            VK_LOG_WARN("VulkanStagingBelt::initialize :: capacity must be non-zero");
+            return false;
+        }
+
+        m_device   = &device;
+        m_vkDevice = device.getDevice();
+        m_capacity = alignUp(capacity, kMinStagingAlignment);
+        m_head     = 0;
+        m_tail     = 0;
+
+        // copies run on the graphics queue unless a separate transfer family is available
+        const QueueFamilyIndices queueFamilyIndices = device.getQueueFamilyIndices();
+        m_vkGraphicsQueue          = device.getGraphicsQueue();
+        m_graphicsQueueFamilyIndex = queueFamilyIndices.mGraphicsFamily.value();
+        m_vkQueue                  = m_vkGraphicsQueue;
+        m_queueFamilyIndex         = m_graphicsQueueFamilyIndex;
+        m_usesTransferQueue        = false;
+
+        if (queueFamilyIndices.mTransferFamily &&
+            queueFamilyIndices.mTransferFamily.value() != m_graphicsQueueFamilyIndex &&
+            device.getTransferQueue() != VK_NULL_HANDLE &&
+            hasTexelCopyGranularity(device.getPhysicalDevice(), queueFamilyIndices.mTransferFamily.value()))
+        {
+            m_vkQueue           = device.getTransferQueue();
+            m_queueFamilyIndex  = queueFamilyIndices.mTransferFamily.value();
+            m_usesTransferQueue = true;
+        }
+
+        // transient pool: batch command buffers are short lived and recycled on retire
+        VkCommandPoolCreateInfo commandPoolCreateInfo{};
+        commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolCreateInfo.pNext = nullptr;
+        commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        commandPoolCreateInfo.queueFamilyIndex = m_queueFamilyIndex;
+
+        if (!m_commandPool.initialize(m_vkDevice, commandPoolCreateInfo))
+        {
+            VK_LOG_ERROR("VulkanStagingBelt::initialize :: failed to initialize command pool");
+            return false;
+        }
+
+        // graphics pool for ownership acquires and graphics-only follow-up work
+        if (m_usesTransferQueue)
+        {
+            commandPoolCreateInfo.queueFamilyIndex = m_graphicsQueueFamilyIndex;
+            if (!m_graphicsCommandPool.initialize(m_vkDevice, commandPoolCreateInfo))
+            {
+                VK_LOG_ERROR("VulkanStagingBelt::initialize :: failed to initialize graphics command pool");
+                return false;
+            }
+        }
+
+        // persistently mapped ring buffer
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.size = m_capacity;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (!m_ringBuffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true, false, VulkanMemoryCategory::kStaging))
+        {
+            VK_LOG_ERROR("VulkanStagingBelt::initialize :: failed to create staging ring buffer");
+            return false;
+        }
+
+        m_mappedData = static_cast<uint8_t*>(m_ringBuffer.getMappedData());
+        VK_LOG_DEBUG("VulkanStagingBelt::initialize successful (capacity: %llu bytes, queue family: %u%s)",
+                     static_cast<unsigned long long>(m_capacity), m_queueFamilyIndex, m_usesTransferQueue ? ", dedicated transfer" : "");
+        return true;
+    }
+
+    void VulkanStagingBelt::destroy() noexcept
+    {
+        if (m_vkDevice == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // submit pending copies and wait for every batch still in flight
+        flush(true);
+
+        // release whatever a failed submission left behind
+        for (auto& submission : m_inFlight)
+        {
+            release(submission);
+        }
+        m_inFlight.clear();
+        m_freeCommandBuffers.clear();
+        m_freeGraphicsCommandBuffers.clear();
+        m_freeFences.clear();
+
+        m_ringBuffer          = VulkanBuffer{};
+        m_graphicsCommandPool = VulkanCommandPool{};
+        m_commandPool         = VulkanCommandPool{};
+        m_commandBuffer       = VulkanCommandBuffer{};
+        m_isRecording         = false;
+        m_copyBarriers.clear();
+        m_pendingCopies.clear();
+        m_pendingRegions.clear();
+        m_releaseBarriers.clear();
+        m_acquireBarriers.clear();
+        m_mappedData          = nullptr;
+        m_capacity            = 0;
+        m_head                = 0;
+        m_tail                = 0;
+        m_vkQueue             = VK_NULL_HANDLE;
+        m_vkGraphicsQueue     = VK_NULL_HANDLE;
+        m_vkDevice            = VK_NULL_HANDLE;
+        m_device              = nullptr;
+    }
+
+    bool VulkanStagingBelt::stage(const void* data, VkDeviceSize size, VkDeviceSize alignment, VkBuffer& srcBuffer, VkDeviceSize& srcOffset) noexcept
+    {
+        if (data == nullptr || size == 0)
+        {
+            VK_LOG_WARN("VulkanStagingBelt::stage invalid input data or size");
+            return false;
+        }
+
+        // uploads that cannot fit the ring get a buffer of their own for this batch
+        if (size > m_capacity)
+        {
+            return stageOversized(data, size, srcBuffer, srcOffset);
+        }
+
+        // honor both the caller's texel alignment and the belt minimum
+        const VkDeviceSize stagingAlignment = std::lcm(std::max<VkDeviceSize>(alignment, 1), kMinStagingAlignment);
+
+        // reserve first: this may submit the current batch to make room
+        VkDeviceSize offset = 0;
+        if (!reserve(size, stagingAlignment, offset))
+        {
+            return false;
+        }
+
+        if (!beginBatch())
+        {
+            return false;
+        }
+
+        std::memcpy(m_mappedData + offset, data, static_cast<size_t>(size));
+        if (!m_ringBuffer.flush(offset, size))
+        {
+            return false;
+        }
+        srcBuffer = m_ringBuffer.get();
+        srcOffset = offset;
+        return true;
+    }
+
+    bool VulkanStagingBelt::uploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset) noexcept
+    {
+        VkBuffer srcBuffer = VK_NULL_HANDLE;
+        VkDeviceSize srcOffset = 0;
+        if (!stage(data, size, 1, srcBuffer, srcOffset))
+        {
+            return false;
+        }
+
+        // record copy from staging region to destination buffer
+        VkBufferCopy vkBufferCopy{};
+        vkBufferCopy.srcOffset = srcOffset;
+        vkBufferCopy.dstOffset = dstOffset;
+        vkBufferCopy.size = size;
+        m_commandBuffer.copyBuffer(srcBuffer, dstBuffer, 1, &vkBufferCopy);
+
+        // destination may be consumed by any graphics stage
+        transferBufferOwnership(dstBuffer, dstOffset, size, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT);
+        return true;
+    }
+
+    VkCommandBuffer VulkanStagingBelt::getCommandBuffer() noexcept
+    {
+        if (!beginBatch())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // direct commands follow every deferred copy; on a single queue the deferred transitions share the buffer as well
+        recordPendingCopies();
+        if (!m_usesTransferQueue)
+        {
+            m_commandBuffer.pipelineBarrier(m_acquireBarriers);
+        }
+        return m_commandBuffer.get();
+    }
+
+    VkCommandBuffer VulkanStagingBelt::getGraphicsCommandBuffer() noexcept
+    {
+        VkCommandBuffer graphicsCommandBuffer = beginGraphicsBatch();
+        if (graphicsCommandBuffer == VK_NULL_HANDLE)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // graphics work reads what was acquired so far (and on a single queue, what the deferred copies wrote)
+        if (!m_usesTransferQueue)
+        {
+            recordPendingCopies();
+        }
+        m_acquireBarriers.flush(graphicsCommandBuffer);
+        return graphicsCommandBuffer;
+    }
+
+    bool VulkanStagingBelt::copyToImage(VkBuffer srcBuffer, VkImage dstImage, const VkImageSubresourceRange& subresourceRange,
+                                        uint32_t regionCount, const VkBufferImageCopy* pRegions) noexcept
+    {
+        if (regionCount == 0 || pRegions == nullptr || !beginBatch())
+        {
+            return false;
+        }
+
+        // an image uploaded again while its barriers are still deferred keeps the order of both uploads
+        if (m_copyBarriers.hasImage(dstImage) || m_releaseBarriers.hasImage(dstImage) || m_acquireBarriers.hasImage(dstImage))
+        {
+            recordPendingBarriers();
+        }
+
+        m_copyBarriers.imageBarrier(dstImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange,
+                                    VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        m_pendingCopies.push_back({ srcBuffer, dstImage, static_cast<uint32_t>(m_pendingRegions.size()), regionCount });
+        m_pendingRegions.insert(m_pendingRegions.end(), pRegions, pRegions + regionCount);
+        return true;
+    }
+
+    void VulkanStagingBelt::transferBufferOwnership(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                                                    VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) noexcept
+    {
+        // single queue: the end-of-batch memory barrier already covers buffer writes
+        if (!m_usesTransferQueue)
+        {
+            return;
+        }
+
+        if (beginGraphicsBatch() == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // release on the transfer queue, acquire on the graphics queue
+        m_releaseBarriers.bufferBarrier(buffer, offset, size, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                        VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, m_queueFamilyIndex, m_graphicsQueueFamilyIndex);
+        m_acquireBarriers.bufferBarrier(buffer, offset, size, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+                                        dstStage, dstAccess, m_queueFamilyIndex, m_graphicsQueueFamilyIndex);
+    }
+
+    void VulkanStagingBelt::transferImageOwnership(VkImage image, const VkImageSubresourceRange& subresourceRange,
+                                                   VkImageLayout oldLayout, VkImageLayout newLayout,
+                                                   VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) noexcept
+    {
+        if (beginGraphicsBatch() == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // single queue: plain layout transition after the copies
+        if (!m_usesTransferQueue)
+        {
+            m_acquireBarriers.imageBarrier(image, oldLayout, newLayout, subresourceRange,
+                                           VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, dstStage, dstAccess);
+            return;
+        }
+
+        // release on the transfer queue, acquire on the graphics queue (the layout transition happens once, shared by both halves)
+        m_releaseBarriers.imageBarrier(image, oldLayout, newLayout, subresourceRange, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                       VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, m_queueFamilyIndex, m_graphicsQueueFamilyIndex);
+        m_acquireBarriers.imageBarrier(image, oldLayout, newLayout, subresourceRange, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+                                       dstStage, dstAccess, m_queueFamilyIndex, m_graphicsQueueFamilyIndex);
+    }
+
+    VulkanStagingBelt::Ticket VulkanStagingBelt::submit() noexcept
+    {
+        // nothing new recorded: the last submission already covers every upload
+        if (!m_isRecording)
+        {
+            return getLastSubmittedTicket();
+        }
+
+        // make transfer writes visible to every later consumer on a single queue, along with the deferred transitions
+        if (!m_usesTransferQueue)
+        {
+            m_acquireBarriers.memoryBarrier(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, 
+                                            VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT);
+        }
+        recordPendingBarriers();
+
+        // take ownership of the recorded batch
+        m_isRecording = false;
+        Submission submission{};
+        submission.mTicket                = m_nextTicket;
+        submission.mCommandBuffer         = m_commandBuffer;
+        submission.mGraphicsCommandBuffer = m_graphicsCommandBuffer;
+        submission.mRingEnd               = m_head;
+        submission.mOversizedBuffers      = std::move(m_oversizedBuffers);
+        m_commandBuffer                   = VulkanCommandBuffer{};
+        m_graphicsCommandBuffer           = VulkanCommandBuffer{};
+        m_oversizedBuffers.clear();
+
+        // end recording commands
+        if (!submission.mCommandBuffer.end() ||
+            (submission.mGraphicsCommandBuffer.isValid() && !submission.mGraphicsCommandBuffer.end()))
+        {
+            release(submission);
+            return kInvalidTicket;
+        }
+
+        // submit the copies; the graphics half follows once they completed
+        if (!submitCommandBuffer(m_vkQueue, submission.mCommandBuffer, submission.mFence))
+        {
+            release(submission);
+            return kInvalidTicket;
+        }
+
+        ++m_nextTicket;
+        m_inFlight.emplace_back(std::move(submission));
+        return m_inFlight.back().mTicket;
+    }
+
+    bool VulkanStagingBelt::flush(bool waitForCompletion) noexcept
+    {
+        const bool hasBatch = m_isRecording;
+        const Ticket ticket = submit();
+        if (hasBatch && ticket == kInvalidTicket)
+        {
+            return false;
+        }
+
+        // optionally block until every outstanding batch has completed
+        if (waitForCompletion && ticket != kInvalidTicket)
+        {
+            return wait(ticket);
+        }
+
+        return true;
+    }
+
+    bool VulkanStagingBelt::wait(Ticket ticket) noexcept
+    {
+        if (ticket == kInvalidTicket || ticket >= m_nextTicket)
+        {
+            VK_LOG_WARN("VulkanStagingBelt::wait :: ticket %llu was not submitted", static_cast<unsigned long long>(ticket));
+            return false;
+        }
+
+        // copies first, in order, so their graphics halves get submitted
+        for (auto& submission : m_inFlight)
+        {
+            if (submission.mTicket > ticket)
+            {
+                break;
+            }
+
+            if (!submission.mIsCopyComplete)
+            {
+                if (!submission.mFence.wait() || !completeCopy(submission))
+                {
+                    VK_LOG_ERROR("VulkanStagingBelt::wait :: failed to complete staging batch %llu", static_cast<unsigned long long>(submission.mTicket));
+                    return false;
+                }
+            }
+        }
+
+        // then the graphics halves
+        for (auto& submission : m_inFlight)
+        {
+            if (submission.mTicket > ticket)
+            {
+                break;
+            }
+
+            if (submission.mGraphicsCommandBuffer.isValid() && !submission.mGraphicsFence.wait())
+            {
+                VK_LOG_ERROR("VulkanStagingBelt::wait :: failed to wait for staging batch %llu", static_cast<unsigned long long>(submission.mTicket));
+                return false;
+            }
+        }
+
+        retire();
+        return true;
+    }
+
+    bool VulkanStagingBelt::isComplete(Ticket ticket) noexcept
+    {
+        retire();
+        if (ticket >= m_nextTicket)
+        {
+            return false;
+        }
+
+        return m_inFlight.empty() || m_inFlight.front().mTicket > ticket;
+    }
+
+    void VulkanStagingBelt::retire() noexcept
+    {
+        // advance finished copies in submission order (recycles ring space, kicks graphics halves)
+        for (auto& submission : m_inFlight)
+        {
+            if (submission.mIsCopyComplete)
+            {
+                continue;
+            }
+
+            if (submission.mFence.isSignaled() != VK_SUCCESS)
+            {
+                break;
+            }
+
+            completeCopy(submission);
+        }
+
+        // drop batches whose graphics half (if any) has completed too
+        while (!m_inFlight.empty())
+        {
+            Submission& submission = m_inFlight.front();
+            if (!submission.mIsCopyComplete ||
+                (submission.mGraphicsCommandBuffer.isValid() && submission.mGraphicsFence.isSignaled() != VK_SUCCESS))
+            {
+                break;
+            }
+
+            release(submission);
+            m_inFlight.pop_front();
+        }
+    }
+
+    bool VulkanStagingBelt::beginBatch() noexcept
+    {
+        if (m_isRecording)
+        {
+            return true;
+        }
+
+        m_commandBuffer = acquireCommandBuffer(false);
+        if (!m_commandBuffer.isValid())
+        {
+            VK_LOG_ERROR("VulkanStagingBelt::beginBatch :: failed to allocate command buffer");
+            return false;
+        }
+
+        // begin resets a recycled buffer (the pool allows per buffer resets)
+        if (!m_commandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+        {
+            m_commandPool.deallocate(m_commandBuffer);
+            m_commandBuffer = VulkanCommandBuffer{};
+            return false;
+        }
+
+        m_isRecording = true;
+        return true;
+    }
+
+    VkCommandBuffer VulkanStagingBelt::beginGraphicsBatch() noexcept
+    {
+        if (!beginBatch())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // copies already run on the graphics queue
+        if (!m_usesTransferQueue)
+        {
+            return m_commandBuffer.get();
+        }
+
+        if (!m_graphicsCommandBuffer.isValid())
+        {
+            m_graphicsCommandBuffer = acquireCommandBuffer(true);
+            if (!m_graphicsCommandBuffer.isValid())
+            {
+                VK_LOG_ERROR("VulkanStagingBelt::beginGraphicsBatch :: failed to allocate command buffer");
+                return VK_NULL_HANDLE;
+            }
+
+            if (!m_graphicsCommandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+            {
+                m_graphicsCommandPool.deallocate(m_graphicsCommandBuffer);
+                m_graphicsCommandBuffer = VulkanCommandBuffer{};
+                return VK_NULL_HANDLE;
+            }
+        }
+
+        return m_graphicsCommandBuffer.get();
+    }
+
+    void VulkanStagingBelt::recordPendingCopies() noexcept
+    {
+        if (m_pendingCopies.empty())
+        {
+            return;
+        }
+
+        // one transition for every destination, then the copies back to back
+        m_commandBuffer.pipelineBarrier(m_copyBarriers);
+        for (const PendingImageCopy& copy : m_pendingCopies)
+        {
+            vkCmdCopyBufferToImage(m_commandBuffer.get(), copy.mSrcBuffer, copy.mDstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   copy.mRegionCount, m_pendingRegions.data() + copy.mFirstRegion);
+        }
+        m_pendingCopies.clear();
+        m_pendingRegions.clear();
+    }
+
+    void VulkanStagingBelt::recordPendingBarriers() noexcept
+    {
+        if (!m_isRecording)
+        {
+            return;
+        }
+
+        recordPendingCopies();
+        m_commandBuffer.pipelineBarrier(m_releaseBarriers);
+
+        // acquires exist on a transfer queue only once the graphics batch was started
+        if (!m_usesTransferQueue)
+        {
+            m_commandBuffer.pipelineBarrier(m_acquireBarriers);
+        }
+        else if (m_graphicsCommandBuffer.isValid())
+        {
+            m_graphicsCommandBuffer.pipelineBarrier(m_acquireBarriers);
+        }
+    }
+
+    bool VulkanStagingBelt::reserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) noexcept
+    {
+        retire();
+        if (tryReserve(size, alignment, offset))
+        {
+            return true;
+        }
+
+        // ring is full: hand the current batch to the gpu, then wait on the oldest copies
+        if (m_isRecording && submit() == kInvalidTicket)
+        {
+            return false;
+        }
+
+        while (hasPendingCopies())
+        {
+            if (!waitOldestCopy())
+            {
+                return false;
+            }
+
+            if (tryReserve(size, alignment, offset))
+            {
+                return true;
+            }
+        }
+
+        // ring is idle, size <= capacity always fits
+        return tryReserve(size, alignment, offset);
+    }
+
+    bool VulkanStagingBelt::tryReserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) noexcept
+    {
+        // nothing references the ring: restart at the front
+        const bool isIdle = !hasPendingCopies() && !m_isRecording;
+        if (isIdle)
+        {
+            m_head = 0;
+            m_tail = 0;
+        }
+
+        VkDeviceSize candidate = alignUp(m_head, alignment);
+        if (isIdle || m_head > m_tail)
+        {
+            // live region is [tail, head): free space at the end, then at the front
+            if (candidate + size > m_capacity)
+            {
+                if (size > m_tail)
+                {
+                    return false;
+                }
+                candidate = 0;
+            }
+        }
+        else if (m_head < m_tail)
+        {
+            // wrapped: free space is [head, tail)
+            if (candidate + size > m_tail)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // head caught up with tail: ring is full
+            return false;
+        }
+
+        offset = candidate;
+        m_head = candidate + size;
+        return true;
+    }
+
+    bool VulkanStagingBelt::stageOversized(const void* data, VkDeviceSize size, VkBuffer& srcBuffer, VkDeviceSize& srcOffset) noexcept
+    {
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.size = size;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VulkanBuffer buffer;
+        if (!buffer.createHostVisible(*m_device, bufferCreateInfo, data, static_cast<size_t>(size), false, false, VulkanMemoryCategory::kStaging))
+        {
+            VK_LOG_ERROR("VulkanStagingBelt::stageOversized :: failed to create staging buffer (%llu bytes)", static_cast<unsigned long long>(size));
+            return false;
+        }
+
+        if (!beginBatch())
+        {
+            return false;
+        }
+
+        VK_LOG_WARN("VulkanStagingBelt::stage :: upload of %llu bytes exceeds ring capacity, using a temporary buffer", static_cast<unsigned long long>(size));
+        srcBuffer = buffer.get();
+        srcOffset = 0;
+
+        // released together with the batch that reads it
+        m_oversizedBuffers.emplace_back(std::move(buffer));
+        return true;
+    }
+
+    bool VulkanStagingBelt::hasPendingCopies() const noexcept
+    {
+        return std::any_of(m_inFlight.begin(), m_inFlight.end(), [](const Submission& submission) { return !submission.mIsCopyComplete; });
+    }
+
+    bool VulkanStagingBelt::waitOldestCopy() noexcept
+    {
+        for (auto& submission : m_inFlight)
+        {
+            if (submission.mIsCopyComplete)
+            {
+                continue;
+            }
+
+            if (!submission.mFence.wait())
+            {
+                VK_LOG_ERROR("VulkanStagingBelt::waitOldestCopy :: failed to wait for staging batch");
+                return false;
+            }
+
+            return completeCopy(submission);
+        }
+
+        return true;
+    }
+
+    bool VulkanStagingBelt::completeCopy(Submission& submission) noexcept
+    {
+        // the ring region and temporary buffers are no longer read
+        submission.mIsCopyComplete = true;
+        m_tail = submission.mRingEnd;
+        submission.mOversizedBuffers.clear();
+        recycleCommandBuffer(submission.mCommandBuffer, false);
+        recycleFence(submission.mFence);
+
+        // copies are done, so the acquire cannot stall the graphics queue
+        if (submission.mGraphicsCommandBuffer.isValid() &&
+            !submitCommandBuffer(m_vkGraphicsQueue, submission.mGraphicsCommandBuffer, submission.mGraphicsFence))
+        {
+            m_graphicsCommandPool.deallocate(submission.mGraphicsCommandBuffer);
+            submission.mGraphicsCommandBuffer = VulkanCommandBuffer{};
+            return false;
+        }
+
+        return true;
+    }
+
+    bool VulkanStagingBelt::submitCommandBuffer(VkQueue vkQueue, const VulkanCommandBuffer& commandBuffer, VulkanFence& fence) noexcept
+    {
+        // fence tracking completion of the batch, reset when it was recycled
+        if (!m_freeFences.empty())
+        {
+            fence = std::move(m_freeFences.back());
+            m_freeFences.pop_back();
+        }
+        else
+        {
+            VkFenceCreateInfo fenceCreateInfo{};
+            fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            fenceCreateInfo.pNext = nullptr;
+            fenceCreateInfo.flags = 0;
+
+            if (!fence.initialize(m_vkDevice, fenceCreateInfo))
+            {
+                VK_LOG_FATAL("VulkanStagingBelt::submitCommandBuffer :: failed to create fence");
+                return false;
+            }
+        }
+
+        // submit info for executing the batch
+        VkCommandBuffer vkCommandBuffer = commandBuffer.get();
+        VkSubmitInfo vkSubmitInfo{};
+        vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        vkSubmitInfo.pNext = nullptr;
+        vkSubmitInfo.commandBufferCount = 1;
+        vkSubmitInfo.pCommandBuffers = &vkCommandBuffer;
+
+        VkResult vkResult = vkQueueSubmit(vkQueue, 1, &vkSubmitInfo, fence.get());
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_FATAL("vkQueueSubmit failed for staging belt batch : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            fence.destroy();
+            return false;
+        }
+
+        return true;
+    }
+
+    void VulkanStagingBelt::release(Submission& submission) noexcept
+    {
+        // called once nothing of the batch is pending (or it never reached the gpu)
+        recycleCommandBuffer(submission.mCommandBuffer, false);
+        recycleCommandBuffer(submission.mGraphicsCommandBuffer, true);
+        submission.mOversizedBuffers.clear();
+        recycleFence(submission.mFence);
+        recycleFence(submission.mGraphicsFence);
+    }
+
+    VulkanCommandBuffer VulkanStagingBelt::acquireCommandBuffer(bool isGraphics) noexcept
+    {
+        std::vector<VulkanCommandBuffer>& freeCommandBuffers = isGraphics ? m_freeGraphicsCommandBuffers : m_freeCommandBuffers;
+        if (freeCommandBuffers.empty())
+        {
+            return isGraphics ? m_graphicsCommandPool.allocatePrimary() : m_commandPool.allocatePrimary();
+        }
+
+        VulkanCommandBuffer commandBuffer = freeCommandBuffers.back();
+        freeCommandBuffers.pop_back();
+        return commandBuffer;
+    }
+
+    void VulkanStagingBelt::recycleCommandBuffer(VulkanCommandBuffer& commandBuffer, bool isGraphics) noexcept
+    {
+        if (!commandBuffer.isValid())
+        {
+            return;
+        }
+
+        std::vector<VulkanCommandBuffer>& freeCommandBuffers = isGraphics ? m_freeGraphicsCommandBuffers : m_freeCommandBuffers;
+        if (freeCommandBuffers.size() < kMaxFreeObjects)
+        {
+            freeCommandBuffers.push_back(commandBuffer);
+        }
+        else
+        {
+            (isGraphics ? m_graphicsCommandPool : m_commandPool).deallocate(commandBuffer);
+        }
+        commandBuffer = VulkanCommandBuffer{};
+    }
+
+    void VulkanStagingBelt::recycleFence(VulkanFence& fence) noexcept
+    {
+        if (!fence.isValid())
+        {
+            return;
+        }
+
+        // a fence that fails to reset is dropped rather than handed to the next batch signaled
+        if (m_freeFences.size() < kMaxFreeObjects && fence.reset())
+        {
+            m_freeFences.emplace_back(std::move(fence));
+        }
+        fence.destroy();
+    }
+}   // namespace keplar
@@ -0,0 +1,179 @@
+// ────────────────────────────────────────────
+//  File: vulkan_staging_belt.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_command_pool.hpp"
+#include "vulkan/vulkan_command_buffer.hpp"
+#include "vulkan/vulkan_barrier_batch.hpp"
+#include "vulkan/vulkan_fence.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // persistently mapped staging ring shared by host-to-device uploads.
+    // copies are recorded into one batch command buffer and submitted on submit() / flush();
+    // ring regions are recycled once the fence of the batch that read them signals.
+    //
+    // when the device exposes a transfer queue family separate from graphics, copies run on
+    // the transfer queue and ownership of the destinations is released to the graphics family.
+    // the matching acquire (plus any graphics-only work such as mip blits) is recorded into
+    // getGraphicsCommandBuffer() and submitted to the graphics queue only after the copies
+    // completed, so rendering never waits on an in-flight upload. call retire() once per frame
+    // to advance batches that are still in flight.
+    //
+    // command buffers and fences of completed batches are kept for the next ones (reset, not freed), so a
+    // one-shot upload or compute pass flushed through the belt costs a submit and no object creation.
+    // a belt is used from one thread at a time; threads that upload concurrently each own a belt
+    //
+    // stage() may submit the current batch to make room, so always stage the data
+    // first and only then record the commands that read it into getCommandBuffer().
+    //
+    // image copies made through copyToImage() and the ownership barriers are deferred: the layout
+    // transitions of every copy in the batch are recorded as one barrier ahead of the copies, and the
+    // releases and acquires as one barrier each after them. getCommandBuffer() and getGraphicsCommandBuffer()
+    // record whatever the commands they return may depend on first.
+    class VulkanStagingBelt final
+    {
+        public:
+            static constexpr VkDeviceSize kDefaultCapacity = 64ull * 1024 * 1024;
+
+            // identifies a submitted batch; batches complete in ticket order
+            using Ticket = uint64_t;
+            static constexpr Ticket kInvalidTicket = 0;
+
+            // creation and destruction
+            VulkanStagingBelt() noexcept;
+            ~VulkanStagingBelt();
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanStagingBelt(const VulkanStagingBelt&) = delete;
+            VulkanStagingBelt& operator=(const VulkanStagingBelt&) = delete;
+            VulkanStagingBelt(VulkanStagingBelt&&) = delete;
+            VulkanStagingBelt& operator=(VulkanStagingBelt&&) = delete;
+
+            bool initialize(const VulkanDevice& device, VkDeviceSize capacity = kDefaultCapacity) noexcept;
+            void destroy() noexcept;
+
+            // usage: staging and recording
+            bool stage(const void* data, VkDeviceSize size, VkDeviceSize alignment, VkBuffer& srcBuffer, VkDeviceSize& srcOffset) noexcept;
+            bool uploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0) noexcept;
+            VkCommandBuffer getCommandBuffer() noexcept;
+            VkCommandBuffer getGraphicsCommandBuffer() noexcept;
+
+            // usage: copy staged data into an image whose range is discarded (undefined -> transfer-dst);
+            // the range is left in transfer-dst for transferImageOwnership()
+            bool copyToImage(VkBuffer srcBuffer, VkImage dstImage, const VkImageSubresourceRange& subresourceRange,
+                             uint32_t regionCount, const VkBufferImageCopy* pRegions) noexcept;
+
+            // usage: hand a resource written by the copy batch over to the graphics queue
+            void transferBufferOwnership(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                                         VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) noexcept;
+            void transferImageOwnership(VkImage image, const VkImageSubresourceRange& subresourceRange,
+                                        VkImageLayout oldLayout, VkImageLayout newLayout,
+                                        VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) noexcept;
+
+            // usage: submission and completion
+            Ticket submit() noexcept;
+            bool flush(bool waitForCompletion = true) noexcept;
+            bool wait(Ticket ticket) noexcept;
+            bool isComplete(Ticket ticket) noexcept;
+            void retire() noexcept;
+
+            // accessors
+            VkDeviceSize getCapacity() const noexcept       { return m_capacity; }
+            bool isRecording() const noexcept               { return m_isRecording; }
+            bool usesTransferQueue() const noexcept         { return m_usesTransferQueue; }
+            Ticket getLastSubmittedTicket() const noexcept  { return m_nextTicket - 1; }
+
+        private:
+            // batch that was submitted and still reads from its ring region
+            struct Submission
+            {
+                Ticket                      mTicket = kInvalidTicket;
+                VulkanCommandBuffer         mCommandBuffer;
+                VulkanCommandBuffer         mGraphicsCommandBuffer;
+                VulkanFence                 mFence;
+                VulkanFence                 mGraphicsFence;
+                VkDeviceSize                mRingEnd = 0;
+                std::vector<VulkanBuffer>   mOversizedBuffers;
+                bool                        mIsCopyComplete = false;
+            };
+
+            // copy recorded once the batch's transitions to transfer-dst are
+            struct PendingImageCopy
+            {
+                VkBuffer                    mSrcBuffer = VK_NULL_HANDLE;
+                VkImage                     mDstImage = VK_NULL_HANDLE;
+                uint32_t                    mFirstRegion = 0;
+                uint32_t                    mRegionCount = 0;
+            };
+
+            bool beginBatch() noexcept;
+            VkCommandBuffer beginGraphicsBatch() noexcept;
+            void recordPendingCopies() noexcept;
+            void recordPendingBarriers() noexcept;
+            bool reserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) noexcept;
+            bool tryReserve(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) noexcept;
+            bool stageOversized(const void* data, VkDeviceSize size, VkBuffer& srcBuffer, VkDeviceSize& srcOffset) noexcept;
+            bool hasPendingCopies() const noexcept;
+            bool waitOldestCopy() noexcept;
+            bool completeCopy(Submission& submission) noexcept;
+            bool submitCommandBuffer(VkQueue vkQueue, const VulkanCommandBuffer& commandBuffer, VulkanFence& fence) noexcept;
+            void release(Submission& submission) noexcept;
+            VulkanCommandBuffer acquireCommandBuffer(bool isGraphics) noexcept;
+            void recycleCommandBuffer(VulkanCommandBuffer& commandBuffer, bool isGraphics) noexcept;
+            void recycleFence(VulkanFence& fence) noexcept;
+
+        private:
+            // vulkan handles
+            const VulkanDevice*         m_device;
+            VkDevice                    m_vkDevice;
+            VkQueue                     m_vkQueue;
+            VkQueue                     m_vkGraphicsQueue;
+            VulkanCommandPool           m_commandPool;
+            VulkanCommandPool           m_graphicsCommandPool;
+
+            // queue families for ownership transfers (equal when no dedicated transfer queue is used)
+            uint32_t                    m_queueFamilyIndex;
+            uint32_t                    m_graphicsQueueFamilyIndex;
+            bool                        m_usesTransferQueue;
+
+            // ring storage and cursors ([tail, head) is in flight, wrapping at capacity)
+            VulkanBuffer                m_ringBuffer;
+            uint8_t*                    m_mappedData;
+            VkDeviceSize                m_capacity;
+            VkDeviceSize                m_head;
+            VkDeviceSize                m_tail;
+
+            // batch currently being recorded
+            VulkanCommandBuffer         m_commandBuffer;
+            VulkanCommandBuffer         m_graphicsCommandBuffer;
+            std::vector<VulkanBuffer>   m_oversizedBuffers;
+            bool                        m_isRecording;
+
+            // deferred work of that batch: transitions and copies, then releases (copy queue) and acquires (graphics queue)
+            VulkanBarrierBatch              m_copyBarriers;
+            std::vector<PendingImageCopy>   m_pendingCopies;
+            std::vector<VkBufferImageCopy>  m_pendingRegions;
+            VulkanBarrierBatch              m_releaseBarriers;
+            VulkanBarrierBatch              m_acquireBarriers;
+
+            // submitted batches, oldest first
+            std::deque<Submission>      m_inFlight;
+            Ticket                      m_nextTicket;
+
+            // objects of completed batches, reused by the next ones
+            std::vector<VulkanCommandBuffer>    m_freeCommandBuffers;
+            std::vector<VulkanCommandBuffer>    m_freeGraphicsCommandBuffers;
+            std::vector<VulkanFence>            m_freeFences;
+    };
+}   // namespace keplar
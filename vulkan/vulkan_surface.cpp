@@ -39,6 +39,13 @@ namespace keplar
         // store the VkInstance for resource creation and destruction
         m_vkInstance = instance.get();
 
+        // headless platforms have nothing to present to: the swapchain renders into offscreen images instead
+        if (platform.isHeadless())
+        {
+            VK_LOG_INFO("headless platform: no presentation surface, rendering offscreen");
+            return true;
+        }
+
         // create platform specific presentation surface 
         m_vkSurfaceKHR = platform.createSurface(m_vkInstance);
         if (m_vkSurfaceKHR == VK_NULL_HANDLE)
@@ -59,6 +66,12 @@ namespace keplar
             return false;
         }
 
+        // without a surface nothing is presented: any queue family qualifies
+        if (!isValid())
+        {
+            return true;
+        }
+
         VkBool32 presentSupport = VK_FALSE;
         VkResult vkResult = vkGetPhysicalDeviceSurfaceSupportKHR(vkPhysicalDevice, queueFamilyIndex, m_vkSurfaceKHR, &presentSupport);
         if (vkResult != VK_SUCCESS)
@@ -128,6 +141,110 @@ namespace keplar
         return presentModes;
     }
 
+    std::vector<VkPresentModeKHR> VulkanSurface::getCompatiblePresentModes(VkPhysicalDevice vkPhysicalDevice, VkPresentModeKHR presentMode) const noexcept
+    {
+        if (vkPhysicalDevice == VK_NULL_HANDLE)
+        {
+            VK_LOG_WARN("getCompatiblePresentModes called with VK_NULL_HANDLE");
+            return {};
+        }
+
+        auto vkGetPhysicalDeviceSurfaceCapabilities2KHR = (PFN_vkGetPhysicalDeviceSurfaceCapabilities2KHR)vkGetInstanceProcAddr(m_vkInstance, "vkGetPhysicalDeviceSurfaceCapabilities2KHR");
+        if (!vkGetPhysicalDeviceSurfaceCapabilities2KHR)
+        {
+            VK_LOG_ERROR("vkGetInstanceProcAddr failed to get vkGetPhysicalDeviceSurfaceCapabilities2KHR function pointer");
+            return {};
+        }
+
+        // the present mode being asked about
+        VkSurfacePresentModeEXT surfacePresentMode{};
+        surfacePresentMode.sType = VK_STRUCTURE_TYPE_SURFACE_PRESENT_MODE_EXT;
+        surfacePresentMode.pNext = nullptr;
+        surfacePresentMode.presentMode = presentMode;
+
+        VkPhysicalDeviceSurfaceInfo2KHR surfaceInfo{};
+        surfaceInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SURFACE_INFO_2_KHR;
+        surfaceInfo.pNext = &surfacePresentMode;
+        surfaceInfo.surface = m_vkSurfaceKHR;
+
+        // query the count of compatible present modes
+        VkSurfacePresentModeCompatibilityEXT compatibility{};
+        compatibility.sType = VK_STRUCTURE_TYPE_SURFACE_PRESENT_MODE_COMPATIBILITY_EXT;
+        compatibility.pNext = nullptr;
+        compatibility.presentModeCount = 0;
+        compatibility.pPresentModes = nullptr;
+
+        VkSurfaceCapabilities2KHR capabilities2{};
+        capabilities2.sType = VK_STRUCTURE_TYPE_SURFACE_CAPABILITIES_2_KHR;
+        capabilities2.pNext = &compatibility;
+
+        VkResult vkResult = vkGetPhysicalDeviceSurfaceCapabilities2KHR(vkPhysicalDevice, &surfaceInfo, &capabilities2);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("failed to query compatible present mode count : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return {};
+        }
+
+        // retrieve the compatible present modes
+        std::vector<VkPresentModeKHR> presentModes(compatibility.presentModeCount);
+        compatibility.pPresentModes = presentModes.data();
+        vkResult = vkGetPhysicalDeviceSurfaceCapabilities2KHR(vkPhysicalDevice, &surfaceInfo, &capabilities2);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("failed to retrieve compatible present modes : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return {};
+        }
+
+        presentModes.resize(compatibility.presentModeCount);
+        return presentModes;
+    }
+
+    bool VulkanSurface::isFullScreenExclusiveSupported(VkPhysicalDevice vkPhysicalDevice, void* monitor) const noexcept
+    {
+    #if defined(VK_USE_PLATFORM_WIN32_KHR)
+        if (vkPhysicalDevice == VK_NULL_HANDLE || monitor == nullptr)
+        {
+            return false;
+        }
+
+        // the same chain the swapchain is created with
+        VkSurfaceFullScreenExclusiveWin32InfoEXT win32Info{};
+        win32Info.sType = VK_STRUCTURE_TYPE_SURFACE_FULL_SCREEN_EXCLUSIVE_WIN32_INFO_EXT;
+        win32Info.pNext = nullptr;
+        win32Info.hmonitor = static_cast<HMONITOR>(monitor);
+
+        VkSurfaceFullScreenExclusiveInfoEXT exclusiveInfo{};
+        exclusiveInfo.sType = VK_STRUCTURE_TYPE_SURFACE_FULL_SCREEN_EXCLUSIVE_INFO_EXT;
+        exclusiveInfo.pNext = &win32Info;
+        exclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_APPLICATION_CONTROLLED_EXT;
+
+        VkPhysicalDeviceSurfaceInfo2KHR surfaceInfo{};
+        surfaceInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SURFACE_INFO_2_KHR;
+        surfaceInfo.pNext = &exclusiveInfo;
+        surfaceInfo.surface = m_vkSurfaceKHR;
+
+        VkSurfaceCapabilitiesFullScreenExclusiveEXT exclusiveCapabilities{};
+        exclusiveCapabilities.sType = VK_STRUCTURE_TYPE_SURFACE_CAPABILITIES_FULL_SCREEN_EXCLUSIVE_EXT;
+        exclusiveCapabilities.pNext = nullptr;
+
+        VkSurfaceCapabilities2KHR capabilities2{};
+        capabilities2.sType = VK_STRUCTURE_TYPE_SURFACE_CAPABILITIES_2_KHR;
+        capabilities2.pNext = &exclusiveCapabilities;
+
+        const VkResult vkResult = vkGetPhysicalDeviceSurfaceCapabilities2KHR(vkPhysicalDevice, &surfaceInfo, &capabilities2);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_ERROR("failed to query exclusive fullscreen support : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return false;
+        }
+        return exclusiveCapabilities.fullScreenExclusiveSupported == VK_TRUE;
+    #else
+        (void)vkPhysicalDevice;
+        (void)monitor;
+        return false;
+    #endif
+    }
+
     VkSurfaceCapabilitiesKHR VulkanSurface::getCapabilities(VkPhysicalDevice vkPhysicalDevice) const noexcept
     {
         VkSurfaceCapabilitiesKHR vkSurfaceCapabilitiesKHR{};
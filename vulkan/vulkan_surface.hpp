@@ -24,7 +24,7 @@ namespace keplar
             VulkanSurface(VulkanSurface&&) = delete;
             VulkanSurface& operator=(VulkanSurface&&) = delete;
 
-            // accessors
+            // accessors (VK_NULL_HANDLE on headless platforms)
             VkSurfaceKHR get() const noexcept { return m_vkSurfaceKHR; }
             bool isValid() const noexcept { return (m_vkSurfaceKHR != VK_NULL_HANDLE); }
 
@@ -34,6 +34,13 @@ namespace keplar
             std::vector<VkPresentModeKHR> getSupportedPresentModes(VkPhysicalDevice vkPhysicalDevice) const noexcept; 
             VkSurfaceCapabilitiesKHR getCapabilities(VkPhysicalDevice vkPhysicalDevice) const noexcept;
 
+            // present modes a swapchain created with presentMode can switch to per present (needs surface_maintenance1)
+            std::vector<VkPresentModeKHR> getCompatiblePresentModes(VkPhysicalDevice vkPhysicalDevice, VkPresentModeKHR presentMode) const noexcept;
+
+            // application controlled exclusive fullscreen on monitor (win32 HMONITOR) is possible for this surface
+            // (needs VK_EXT_full_screen_exclusive enabled on the device; always false elsewhere)
+            bool isFullScreenExclusiveSupported(VkPhysicalDevice vkPhysicalDevice, void* monitor) const noexcept;
+
         private:
             // construction helpers
             VulkanSurface() noexcept;
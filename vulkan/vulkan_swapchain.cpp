@@ -5,14 +5,23 @@
 #include "vulkan_swapchain.hpp"
 
 #include <algorithm>
+#include <iterator>
 
 #include "vulkan_context.hpp"
 #include "vulkan_surface.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_command_buffer.hpp"
+#include "vulkan_barrier_batch.hpp"
+#include "vulkan_deletion_queue.hpp"
 #include "vulkan_utils.hpp"
 #include "utils/logger.hpp"
 
+namespace
+{
+    // offscreen images cycled when the policy leaves the count to the implementation
+    constexpr uint32_t kDefaultOffscreenImageCount = 3;
+}
+
 namespace keplar
 {
     VulkanSwapchain::VulkanSwapchain(std::weak_ptr<VulkanSurface> surface, std::weak_ptr<VulkanDevice> device) noexcept
@@ -24,14 +33,26 @@ namespace keplar
         , m_imageCount(0)
         , m_imageExtent{}
         , m_preTransform(VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR)
+        , m_isLatencyModeEnabled(false)
+        , m_isFullScreenExclusive(false)
+        , m_isFullScreenExclusiveAcquired(false)
+        , m_vkAcquireFullScreenExclusiveModeEXT(nullptr)
+        , m_vkReleaseFullScreenExclusiveModeEXT(nullptr)
+        , m_presentModeInfo{}
+        , m_isOffscreen(false)
+        , m_colorAllocations{}
+        , m_nextOffscreenImage(0)
         , m_depthImage(VK_NULL_HANDLE)
-        , m_depthMemory(VK_NULL_HANDLE)
+        , m_memoryAllocator(nullptr)
+        , m_depthAllocation{}
         , m_depthImageView(VK_NULL_HANDLE)
         , m_depthFormat(VK_FORMAT_UNDEFINED)
+        , m_isDepthAttachmentEnabled(false)
     {
         if (auto deviceLocked = m_device.lock())
         {
             m_vkDevice = deviceLocked->getDevice();
+            m_memoryAllocator = &deviceLocked->getMemoryAllocator();
         }
     }
 
@@ -41,6 +62,23 @@ namespace keplar
     }
 
     bool VulkanSwapchain::initialize(uint32_t width, uint32_t height) noexcept
+    {
+        // the previous swapchain (if any) is retired by the create call, even when it fails
+        const VkSwapchainKHR oldSwapchain = m_vkSwapchainKHR;
+        m_vkSwapchainKHR = VK_NULL_HANDLE;
+        const bool isCreated = createResources(width, height, oldSwapchain);
+
+        // destroy old swapchain (caller guarantees its images are no longer in use)
+        if (oldSwapchain != VK_NULL_HANDLE)
+        {
+            vkDestroySwapchainKHR(m_vkDevice, oldSwapchain, nullptr);
+            VK_LOG_DEBUG("old swapchain destroyed successfully");
+        }
+
+        return isCreated;
+    }
+
+    bool VulkanSwapchain::createResources(uint32_t width, uint32_t height, VkSwapchainKHR oldSwapchain) noexcept
     {
         // get temporary access to surface and device
         auto surface = m_surface.lock();
@@ -58,6 +96,12 @@ namespace keplar
             return false;
         }
 
+        // headless: there is no surface to query or present to, render into owned images instead
+        if (!surface->isValid())
+        {
+            return createOffscreenResources(*device, width, height);
+        }
+
         // select surface format & presentation mode
         if (!chooseSurfaceFormat(*surface, *device))  { return false; }
         if (!choosePresentMode(*surface, *device))    { return false; }
@@ -65,18 +109,36 @@ namespace keplar
         // query surface capabilities and configure swapchain
         const auto& surfaceCapabilities = surface->getCapabilities(device->getPhysicalDevice());
         chooseImageCount(surfaceCapabilities);
-        chooseSwapExtent(surfaceCapabilities, { width, height });
         choosePreTransform(surfaceCapabilities);
+        chooseSwapExtent(surfaceCapabilities, { width, height });
+
+        // exclusive fullscreen: the previous swapchain hands the display back before the new one asks for it
+        releaseFullScreenExclusive(oldSwapchain);
+        m_isFullScreenExclusive = m_policy.mFullScreenExclusive && device->isFullScreenExclusiveEnabled() &&
+                                  surface->isFullScreenExclusiveSupported(device->getPhysicalDevice(), m_policy.mMonitor);
+        if (m_isFullScreenExclusive && m_vkAcquireFullScreenExclusiveModeEXT == nullptr)
+        {
+            m_vkAcquireFullScreenExclusiveModeEXT = vkGetDeviceProcAddr(m_vkDevice, "vkAcquireFullScreenExclusiveModeEXT");
+            m_vkReleaseFullScreenExclusiveModeEXT = vkGetDeviceProcAddr(m_vkDevice, "vkReleaseFullScreenExclusiveModeEXT");
+            if (!m_vkAcquireFullScreenExclusiveModeEXT || !m_vkReleaseFullScreenExclusiveModeEXT)
+            {
+                VK_LOG_ERROR("vkGetDeviceProcAddr failed to get VK_EXT_full_screen_exclusive function pointers");
+                m_isFullScreenExclusive = false;
+            }
+        }
 
         // create swapchain 
-        if (!createSwapchain(surface->get(), device->getQueueFamilyIndices(), m_vkSwapchainKHR)) 
+        m_isLatencyModeEnabled = device->isLatencySleepEnabled();
+        if (!createSwapchain(surface->get(), device->getQueueFamilyIndices(), oldSwapchain)) 
         { 
             return false; 
         }
+        acquireFullScreenExclusive();
 
         // create swapchain attachments
         if (!createColorAttachment())               { return false; }
-        if (!createDepthAttachment(*device))         { return false; }
+        if (!chooseDepthFormat(*device))            { return false; }
+        if (m_isDepthAttachmentEnabled && !createDepthAttachment(*device)) { return false; }
 
         VK_LOG_DEBUG("initialize :: swapchain created successfully.");
         return true;
@@ -98,6 +160,60 @@ namespace keplar
         return true;
     }
 
+    bool VulkanSwapchain::recreate(uint32_t width, uint32_t height, VulkanDeletionQueue& deletionQueue) noexcept
+    {
+        // detach the previous swapchain, views and depth target; frames in flight may still reference them
+        const VkDevice vkDevice                   = m_vkDevice;
+        VulkanMemoryAllocator* memoryAllocator  = m_memoryAllocator;
+        const VkSwapchainKHR oldSwapchain         = m_vkSwapchainKHR;
+        std::vector<VkImageView> colorImageViews  = std::move(m_colorImageViews);
+        std::vector<VkImage> offscreenImages      = m_isOffscreen ? std::move(m_colorImages) : std::vector<VkImage>{};
+        std::vector<VulkanAllocation> offscreenAllocations = std::move(m_colorAllocations);
+        const VkImage depthImage                  = m_depthImage;
+        const VkImageView depthImageView          = m_depthImageView;
+        VulkanAllocation depthAllocation          = m_depthAllocation;
+
+        m_vkSwapchainKHR = VK_NULL_HANDLE;
+        m_colorImages.clear();
+        m_colorImageViews.clear();
+        m_colorAllocations.clear();
+        m_depthImage      = VK_NULL_HANDLE;
+        m_depthImageView  = VK_NULL_HANDLE;
+        m_depthAllocation = VulkanAllocation{};
+
+        // hand presentation over to the new swapchain; the old one is retired even if creation fails
+        const bool isCreated = createResources(width, height, oldSwapchain);
+
+        // release the detached resources once the frames that used them have completed
+        deletionQueue.push([=]() mutable
+        {
+            for (VkImageView imageView : colorImageViews)
+            {
+                vkDestroyImageView(vkDevice, imageView, nullptr);
+            }
+
+            for (size_t i = 0; i < offscreenImages.size(); ++i)
+            {
+                vkDestroyImage(vkDevice, offscreenImages[i], nullptr);
+                if (memoryAllocator && i < offscreenAllocations.size()) { memoryAllocator->free(offscreenAllocations[i]); }
+            }
+
+            if (depthImageView != VK_NULL_HANDLE) { vkDestroyImageView(vkDevice, depthImageView, nullptr); }
+            if (depthImage != VK_NULL_HANDLE)     { vkDestroyImage(vkDevice, depthImage, nullptr); }
+            if (memoryAllocator && depthAllocation.isValid()) { memoryAllocator->free(depthAllocation); }
+            if (oldSwapchain != VK_NULL_HANDLE)   { vkDestroySwapchainKHR(vkDevice, oldSwapchain, nullptr); }
+        });
+
+        if (!isCreated)
+        {
+            VK_LOG_FATAL("recreate :: swapchain re-creation failed.");
+            return false;
+        }
+
+        VK_LOG_DEBUG("recreate :: swapchain created without waiting for the device (old swapchain retired).");
+        return true;
+    }
+
     void VulkanSwapchain::destroy() noexcept
     {
         // destror color and depth-stencil resources
@@ -106,6 +222,7 @@ namespace keplar
         if (m_vkSwapchainKHR != VK_NULL_HANDLE)
         {
             // swapchain images are destroyed when swapchain is destroyed
+            releaseFullScreenExclusive(m_vkSwapchainKHR);
             vkDestroySwapchainKHR(m_vkDevice, m_vkSwapchainKHR, nullptr);
             m_vkSwapchainKHR = VK_NULL_HANDLE;
             m_vkDevice = VK_NULL_HANDLE;
@@ -113,6 +230,58 @@ namespace keplar
         }
     }
 
+    bool VulkanSwapchain::updatePolicy(const VulkanSwapchainPolicy& policy) noexcept
+    {
+        const bool isCreationChanged = policy.mImageCount != m_policy.mImageCount || policy.mDepthPrecision != m_policy.mDepthPrecision ||
+                                       policy.mPreRotation != m_policy.mPreRotation || policy.mFullScreenExclusive != m_policy.mFullScreenExclusive ||
+                                       policy.mMonitor != m_policy.mMonitor;
+        m_policy = policy;
+
+        // nothing created yet, or the image count, depth format or transform changed: applies on the next creation
+        if (m_vkSwapchainKHR == VK_NULL_HANDLE || isCreationChanged)
+        {
+            return false;
+        }
+
+        auto surface = m_surface.lock();
+        auto device  = m_device.lock();
+        if (!surface || !device)
+        {
+            return false;
+        }
+
+        // same mode under the new policy: nothing to do
+        const VkPresentModeKHR presentMode = selectPresentMode(surface->getSupportedPresentModes(device->getPhysicalDevice()));
+        if (presentMode == m_vkPresentModeKHR)
+        {
+            return true;
+        }
+
+        // in place only when the selected mode is one this swapchain was created to switch to
+        if (std::find(m_compatiblePresentModes.begin(), m_compatiblePresentModes.end(), presentMode) == m_compatiblePresentModes.end())
+        {
+            return false;
+        }
+
+        VK_LOG_INFO("updatePolicy :: present mode switched in place to %s", string_VkPresentModeKHR(presentMode));
+        m_vkPresentModeKHR = presentMode;
+        return true;
+    }
+
+    const void* VulkanSwapchain::chainPresentMode(const void* pNext) noexcept
+    {
+        if (!canSwitchPresentMode())
+        {
+            return pNext;
+        }
+
+        m_presentModeInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_MODE_INFO_EXT;
+        m_presentModeInfo.pNext = pNext;
+        m_presentModeInfo.swapchainCount = 1;
+        m_presentModeInfo.pPresentModes = &m_vkPresentModeKHR;
+        return &m_presentModeInfo;
+    }
+
     bool VulkanSwapchain::chooseSurfaceFormat(const VulkanSurface& surface, const VulkanDevice& device) noexcept
     {
         // get supported surface formats
@@ -157,26 +326,51 @@ namespace keplar
             return false;
         }
 
-        // prefer VK_PRESENT_MODE_MAILBOX_KHR if available 
-        for (const auto& presentMode : presentModes)
+        m_vkPresentModeKHR = selectPresentMode(presentModes);
+
+        // modes the swapchain may switch to per present without being recreated
+        m_compatiblePresentModes.clear();
+        if (device.isSwapchainMaintenance1Enabled())
         {
-            if (presentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+            m_compatiblePresentModes = surface.getCompatiblePresentModes(device.getPhysicalDevice(), m_vkPresentModeKHR);
+            if (std::find(m_compatiblePresentModes.begin(), m_compatiblePresentModes.end(), m_vkPresentModeKHR) == m_compatiblePresentModes.end())
             {
-                // mailbox mode provides low latency and avoids tearing 
-                m_vkPresentModeKHR = presentMode;
-                return true;
+                m_compatiblePresentModes.push_back(m_vkPresentModeKHR);
             }
         }
 
-        // fallback: guaranteed to be supported on all vulkan implementations, enables vsync
-        m_vkPresentModeKHR = VK_PRESENT_MODE_FIFO_KHR;
+        VK_LOG_DEBUG("choosePresentMode :: %s (%zu compatible modes)", string_VkPresentModeKHR(m_vkPresentModeKHR), m_compatiblePresentModes.size());
         return true;
     }
 
+    VkPresentModeKHR VulkanSwapchain::selectPresentMode(const std::vector<VkPresentModeKHR>& presentModes) const noexcept
+    {
+        // preference order of the policy; fifo is guaranteed to be supported on all vulkan implementations
+        std::vector<VkPresentModeKHR> preferredModes;
+        switch (m_policy.mPresentPolicy)
+        {
+            case PresentPolicy::kBalanced:    preferredModes = { VK_PRESENT_MODE_MAILBOX_KHR }; break;
+            case PresentPolicy::kLowLatency:  preferredModes = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR }; break;
+            case PresentPolicy::kVSync:       break;
+            case PresentPolicy::kPowerSaving: preferredModes = { VK_PRESENT_MODE_FIFO_RELAXED_KHR }; break;
+        }
+
+        for (const auto& preferredMode : preferredModes)
+        {
+            if (std::find(presentModes.begin(), presentModes.end(), preferredMode) != presentModes.end())
+            {
+                return preferredMode;
+            }
+        }
+
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
     void VulkanSwapchain::chooseImageCount(const VkSurfaceCapabilitiesKHR& surfaceCapabilities) noexcept
     {
-        // start with one more than the minimum image count to enable triple buffering
-        uint32_t desiredImageCount = surfaceCapabilities.minImageCount + 1;
+        // start with one more than the minimum image count to enable triple buffering, unless set explicitly
+        uint32_t desiredImageCount = (m_policy.mImageCount > 0) ? std::max(m_policy.mImageCount, surfaceCapabilities.minImageCount) 
+                                                                : surfaceCapabilities.minImageCount + 1;
 
         // clamp to the maximum supported image count
         if (surfaceCapabilities.maxImageCount > 0 && desiredImageCount > surfaceCapabilities.maxImageCount)
@@ -200,11 +394,26 @@ namespace keplar
             m_imageExtent.width = std::clamp(windowExtent.width, surfaceCapabilities.minImageExtent.width, surfaceCapabilities.maxImageExtent.width);
             m_imageExtent.height = std::clamp(windowExtent.height, surfaceCapabilities.minImageExtent.height, surfaceCapabilities.maxImageExtent.height);
         }
+
+        // pre-rotated by a quarter turn: images are laid out in the native orientation, across the window's
+        if (m_preTransform == VK_SURFACE_TRANSFORM_ROTATE_90_BIT_KHR || m_preTransform == VK_SURFACE_TRANSFORM_ROTATE_270_BIT_KHR)
+        {
+            std::swap(m_imageExtent.width, m_imageExtent.height);
+        }
     }
 
     void VulkanSwapchain::choosePreTransform(const VkSurfaceCapabilitiesKHR& surfaceCapabilities) noexcept
     {
-        if (surfaceCapabilities.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR)
+        // the renderer rotates to the display's current orientation itself; mirrored transforms are left to the compositor
+        constexpr VkSurfaceTransformFlagsKHR kRotations = VK_SURFACE_TRANSFORM_ROTATE_90_BIT_KHR | VK_SURFACE_TRANSFORM_ROTATE_180_BIT_KHR |
+                                                       VK_SURFACE_TRANSFORM_ROTATE_270_BIT_KHR;
+        if (m_policy.mPreRotation && (surfaceCapabilities.currentTransform & kRotations) &&
+            (surfaceCapabilities.supportedTransforms & surfaceCapabilities.currentTransform))
+        {
+            m_preTransform = surfaceCapabilities.currentTransform;
+            VK_LOG_DEBUG("choosePreTransform :: pre-rotating by %.0f degrees", getPreRotation());
+        }
+        else if (surfaceCapabilities.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR)
         {
             m_preTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
         }
@@ -214,6 +423,17 @@ namespace keplar
         }
     }
 
+    float VulkanSwapchain::getPreRotation() const noexcept
+    {
+        switch (m_preTransform)
+        {
+            case VK_SURFACE_TRANSFORM_ROTATE_90_BIT_KHR:    return 90.0f;
+            case VK_SURFACE_TRANSFORM_ROTATE_180_BIT_KHR:   return 180.0f;
+            case VK_SURFACE_TRANSFORM_ROTATE_270_BIT_KHR:   return 270.0f;
+            default:                                        return 0.0f;
+        }
+    }
+
     bool VulkanSwapchain::createSwapchain(VkSurfaceKHR vkSurface, QueueFamilyIndices indices, VkSwapchainKHR oldSwapchain) noexcept
     {
         // setup swapchain create info
@@ -234,6 +454,44 @@ namespace keplar
         vkSwapchainCreateInfoKHR.clipped = VK_TRUE;
         vkSwapchainCreateInfoKHR.oldSwapchain = oldSwapchain;
 
+        // swapchain_maintenance1: declare the modes presents may switch between
+        VkSwapchainPresentModesCreateInfoEXT presentModesCreateInfo{};
+        if (!m_compatiblePresentModes.empty())
+        {
+            presentModesCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_MODES_CREATE_INFO_EXT;
+            presentModesCreateInfo.pNext = nullptr;
+            presentModesCreateInfo.presentModeCount = static_cast<uint32_t>(m_compatiblePresentModes.size());
+            presentModesCreateInfo.pPresentModes = m_compatiblePresentModes.data();
+            vkSwapchainCreateInfoKHR.pNext = &presentModesCreateInfo;
+        }
+
+        // low_latency2: the driver only paces and tracks swapchains created in latency mode
+        VkSwapchainLatencyCreateInfoNV latencyCreateInfo{};
+        if (m_isLatencyModeEnabled)
+        {
+            latencyCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_LATENCY_CREATE_INFO_NV;
+            latencyCreateInfo.pNext = vkSwapchainCreateInfoKHR.pNext;
+            latencyCreateInfo.latencyModeEnable = VK_TRUE;
+            vkSwapchainCreateInfoKHR.pNext = &latencyCreateInfo;
+        }
+
+        // full_screen_exclusive: exclusivity is taken and given back explicitly, and only on the window's monitor
+    #if defined(VK_USE_PLATFORM_WIN32_KHR)
+        VkSurfaceFullScreenExclusiveWin32InfoEXT exclusiveWin32Info{};
+        VkSurfaceFullScreenExclusiveInfoEXT exclusiveInfo{};
+        if (m_isFullScreenExclusive)
+        {
+            exclusiveWin32Info.sType = VK_STRUCTURE_TYPE_SURFACE_FULL_SCREEN_EXCLUSIVE_WIN32_INFO_EXT;
+            exclusiveWin32Info.pNext = vkSwapchainCreateInfoKHR.pNext;
+            exclusiveWin32Info.hmonitor = static_cast<HMONITOR>(m_policy.mMonitor);
+
+            exclusiveInfo.sType = VK_STRUCTURE_TYPE_SURFACE_FULL_SCREEN_EXCLUSIVE_INFO_EXT;
+            exclusiveInfo.pNext = &exclusiveWin32Info;
+            exclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_APPLICATION_CONTROLLED_EXT;
+            vkSwapchainCreateInfoKHR.pNext = &exclusiveInfo;
+        }
+    #endif
+
         // log swapchain creation info
         VK_LOG_DEBUG("swapchain creation info :: image count: %d, extent: %d x %d", m_imageCount, m_imageExtent.width, m_imageExtent.height);
 
@@ -263,18 +521,48 @@ namespace keplar
             return false;
         }
 
-        // destroy old swapchain
-        if (oldSwapchain != VK_NULL_HANDLE)
-        {
-            vkDestroySwapchainKHR(m_vkDevice, oldSwapchain, nullptr);
-            VK_LOG_DEBUG("old swapchain destroyed successfully");
-        }
-
         m_vkSwapchainKHR = swapchain;
         VK_LOG_DEBUG("swapchain created successfully");
         return true;
     }
 
+    void VulkanSwapchain::acquireFullScreenExclusive() noexcept
+    {
+        m_isFullScreenExclusiveAcquired = false;
+        if (!m_isFullScreenExclusive || m_vkSwapchainKHR == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // refused while the window is not in the foreground; presents then go through the compositor until the next
+        // recreate (restoring a minimized window resizes it)
+    #if defined(VK_USE_PLATFORM_WIN32_KHR)
+        const auto acquireMode = reinterpret_cast<PFN_vkAcquireFullScreenExclusiveModeEXT>(m_vkAcquireFullScreenExclusiveModeEXT);
+        const VkResult vkResult = acquireMode(m_vkDevice, m_vkSwapchainKHR);
+        if (vkResult != VK_SUCCESS)
+        {
+            VK_LOG_WARN("vkAcquireFullScreenExclusiveModeEXT failed : %s (code: %d)", string_VkResult(vkResult), vkResult);
+            return;
+        }
+        m_isFullScreenExclusiveAcquired = true;
+        VK_LOG_INFO("swapchain :: exclusive fullscreen acquired");
+    #endif
+    }
+
+    void VulkanSwapchain::releaseFullScreenExclusive(VkSwapchainKHR swapchain) noexcept
+    {
+        if (!m_isFullScreenExclusiveAcquired || swapchain == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+    #if defined(VK_USE_PLATFORM_WIN32_KHR)
+        const auto releaseMode = reinterpret_cast<PFN_vkReleaseFullScreenExclusiveModeEXT>(m_vkReleaseFullScreenExclusiveModeEXT);
+        releaseMode(m_vkDevice, swapchain);
+    #endif
+        m_isFullScreenExclusiveAcquired = false;
+    }
+
     bool VulkanSwapchain::createColorAttachment() noexcept
     {
         // query swapchain image count
@@ -309,7 +597,14 @@ namespace keplar
             VK_LOG_WARN("vkGetSwapchainImagesKHR returned VK_INCOMPLETE; resized swapchain images to %u.", swapchainImageCount);
         }
 
-        m_colorImageViews.resize(swapchainImageCount, VK_NULL_HANDLE);
+        // update swapchain image count
+        m_imageCount = swapchainImageCount;
+        return createColorImageViews();
+    }
+
+    bool VulkanSwapchain::createColorImageViews() noexcept
+    {
+        m_colorImageViews.resize(m_colorImages.size(), VK_NULL_HANDLE);
 
         // create image views 
         VkImageViewCreateInfo vkImageViewCreateInfo{};
@@ -329,7 +624,7 @@ namespace keplar
         vkImageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
 
         // create image views for all retrieved color images 
-        for (uint32_t i = 0; i < swapchainImageCount; i++)
+        for (size_t i = 0; i < m_colorImages.size(); i++)
         {
             vkImageViewCreateInfo.image = m_colorImages[i];
             if (!VK_CHECK(vkCreateImageView(m_vkDevice, &vkImageViewCreateInfo, nullptr, &m_colorImageViews[i])))
@@ -338,27 +633,131 @@ namespace keplar
             }
         }
 
-        // update swapchain image count
-        m_imageCount = swapchainImageCount;
         VK_LOG_DEBUG("swapchain color image views are created successfully : %d", m_imageCount);
         return true;
     }
 
-    bool VulkanSwapchain::createDepthAttachment(const VulkanDevice& device) noexcept
+    bool VulkanSwapchain::createOffscreenResources(const VulkanDevice& device, uint32_t width, uint32_t height) noexcept
+    {
+        // same format and color space the surface path prefers, with no present mode or transform to negotiate
+        m_isOffscreen = true;
+        m_vkSurfaceFormatKHR.format = VK_FORMAT_B8G8R8A8_UNORM;
+        m_vkSurfaceFormatKHR.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+        m_vkPresentModeKHR = VK_PRESENT_MODE_IMMEDIATE_KHR;
+        m_compatiblePresentModes.clear();
+        m_imageCount = (m_policy.mImageCount > 0) ? m_policy.mImageCount : kDefaultOffscreenImageCount;
+        m_imageExtent = { width, height };
+        m_nextOffscreenImage = 0;
+
+        if (!createOffscreenImages())               { return false; }
+        if (!createColorImageViews())               { return false; }
+        if (!chooseDepthFormat(device))             { return false; }
+        if (m_isDepthAttachmentEnabled && !createDepthAttachment(device)) { return false; }
+
+        VK_LOG_DEBUG("initialize :: offscreen targets created successfully (%u images, %u x %u).", m_imageCount, width, height);
+        return true;
+    }
+
+    bool VulkanSwapchain::createOffscreenImages() noexcept
+    {
+        // usage matches the swapchain images so render passes and copies need no special casing
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.pNext = nullptr;
+        imageCreateInfo.flags = 0;
+        imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format = m_vkSurfaceFormatKHR.format;
+        imageCreateInfo.extent.width = m_imageExtent.width;
+        imageCreateInfo.extent.height = m_imageExtent.height;
+        imageCreateInfo.extent.depth = 1;
+        imageCreateInfo.mipLevels = 1;
+        imageCreateInfo.arrayLayers = 1;
+        imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        m_colorImages.assign(m_imageCount, VK_NULL_HANDLE);
+        m_colorAllocations.assign(m_imageCount, VulkanAllocation{});
+        for (uint32_t i = 0; i < m_imageCount; ++i)
+        {
+            VkResult vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &m_colorImages[i]);
+            if (vkResult != VK_SUCCESS)
+            {
+                VK_LOG_FATAL("vkCreateImage failed to create offscreen color image : %s (code: %d)", string_VkResult(vkResult), vkResult);
+                m_colorImages[i] = VK_NULL_HANDLE;
+                return false;
+            }
+
+            if (!m_memoryAllocator->allocateImageMemory(m_colorImages[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_colorAllocations[i], VulkanMemoryCategory::kAttachment))
+            {
+                VK_LOG_FATAL("failed to allocate memory for offscreen color image %u", i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint32_t VulkanSwapchain::acquireOffscreenImage() noexcept
+    {
+        // callers pace on their frame slots: the image handed out was last used imageCount frames ago
+        const uint32_t imageIndex = m_nextOffscreenImage;
+        m_nextOffscreenImage = (m_nextOffscreenImage + 1) % std::max(m_imageCount, 1u);
+        return imageIndex;
+    }
+
+    bool VulkanSwapchain::setDepthAttachment(bool isEnabled) noexcept
+    {
+        m_isDepthAttachmentEnabled = isEnabled;
+        if (!isEnabled)
+        {
+            destroyDepthAttachment();
+            return true;
+        }
+
+        // created with the current images, or by the next creation when there are none yet
+        if (m_depthImage != VK_NULL_HANDLE || m_colorImageViews.empty())
+        {
+            return true;
+        }
+
+        auto device = m_device.lock();
+        return device && createDepthAttachment(*device);
+    }
+
+    bool VulkanSwapchain::chooseDepthFormat(const VulkanDevice& device) noexcept
     {
-        // depth format candidate from best to worst
-        VkFormat depthFormats[] = 
+        // depth format candidates from best to worst under the policy; no renderer reads stencil, so depth-only formats
+        // lead and keep depth compression free of the stencil plane
+        static constexpr VkFormat kCompactFormats[] =
         {
+            VK_FORMAT_X8_D24_UNORM_PACK32,
+            VK_FORMAT_D24_UNORM_S8_UINT,
+            VK_FORMAT_D32_SFLOAT,
             VK_FORMAT_D32_SFLOAT_S8_UINT,
+            VK_FORMAT_D16_UNORM,
+            VK_FORMAT_D16_UNORM_S8_UINT,
+        };
+        static constexpr VkFormat kFloatFormats[] =
+        {
             VK_FORMAT_D32_SFLOAT,
+            VK_FORMAT_D32_SFLOAT_S8_UINT,
+            VK_FORMAT_X8_D24_UNORM_PACK32,
             VK_FORMAT_D24_UNORM_S8_UINT,
-            VK_FORMAT_D16_UNORM_S8_UINT,
             VK_FORMAT_D16_UNORM,
+            VK_FORMAT_D16_UNORM_S8_UINT,
         };
+        const bool isFloat = m_policy.mDepthPrecision == DepthPrecision::kFloat;
+        const VkFormat* depthFormats = isFloat ? kFloatFormats : kCompactFormats;
+        const size_t depthFormatCount = isFloat ? std::size(kFloatFormats) : std::size(kCompactFormats);
 
         // choose depth format  
-        for (auto format : depthFormats)
+        m_depthFormat = VK_FORMAT_UNDEFINED;
+        for (size_t i = 0; i < depthFormatCount; ++i)
         {
+            const VkFormat format = depthFormats[i];
             VkFormatProperties formatProperties{};
             vkGetPhysicalDeviceFormatProperties(device.getPhysicalDevice(), format, &formatProperties);
 
@@ -377,6 +776,11 @@ namespace keplar
             return false;
         }
 
+        return true;
+    }
+
+    bool VulkanSwapchain::createDepthAttachment(const VulkanDevice& device) noexcept
+    {
         // initialize image create info for depth image
         VkImageCreateInfo imageCreateInfo{};
         imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -391,7 +795,7 @@ namespace keplar
         imageCreateInfo.arrayLayers = 1;
         imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-        imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
 
         // create image for depth
         VkResult vkResult = vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &m_depthImage);
@@ -401,42 +805,24 @@ namespace keplar
             return false;
         }
 
-        // memory requirements for depth image to get alignement and region size
+        // depth is cleared and discarded within the pass: prefer lazily allocated memory (tile memory on 
+        // tile-based gpus), fall back to device local
         VkMemoryRequirements memoryRequirements{};
         vkGetImageMemoryRequirements(m_vkDevice, m_depthImage, &memoryRequirements);
 
-        // find suitable memory type
-        auto memoryTypeIndex = device.findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        if (!memoryTypeIndex.has_value())
-        {
-            VK_LOG_ERROR("findMemoryType failed to find suitable memory type for depth image");
-            vkDestroyImage(m_vkDevice, m_depthImage, nullptr);
-            return false;
-        }
-
-        // initialize memory allocation info
-        VkMemoryAllocateInfo allocationInfo{};
-        allocationInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocationInfo.pNext = nullptr;
-        allocationInfo.allocationSize = memoryRequirements.size;
-        allocationInfo.memoryTypeIndex = *memoryTypeIndex;
-
-        // allocate memory for depth image from vulkan heap
-        vkResult = vkAllocateMemory(m_vkDevice, &allocationInfo, nullptr, &m_depthMemory);
-        if (vkResult != VK_SUCCESS)
+        VkMemoryPropertyFlags propertyFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+        if (!device.findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags).has_value())
         {
-            VK_LOG_FATAL("vkAllocateMemory failed to allocate memory for depth image : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkDestroyImage(m_vkDevice, m_depthImage, nullptr);
-            return false;
+            propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
         }
 
-        // bind depth image to device memory
-        vkResult = vkBindImageMemory(m_vkDevice, m_depthImage, m_depthMemory, 0);
-        if (vkResult != VK_SUCCESS)
+        // allocate and bind memory for the depth image
+        m_memoryAllocator = &device.getMemoryAllocator();
+        if (!m_memoryAllocator->allocateImageMemory(m_depthImage, propertyFlags, m_depthAllocation, VulkanMemoryCategory::kAttachment))
         {
-            VK_LOG_FATAL("vkBindImageMemory failed to bind depth image to device memory : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, m_depthMemory, nullptr);
+            VK_LOG_FATAL("failed to allocate memory for depth image");
             vkDestroyImage(m_vkDevice, m_depthImage, nullptr);
+            m_depthImage = VK_NULL_HANDLE;
             return false;
         }
 
@@ -467,8 +853,9 @@ namespace keplar
         if (vkResult != VK_SUCCESS)
         {
             VK_LOG_FATAL("vkCreateImageView failed to create view for depth image : %s (code: %d)", string_VkResult(vkResult), vkResult);
-            vkFreeMemory(m_vkDevice, m_depthMemory, nullptr);
             vkDestroyImage(m_vkDevice, m_depthImage, nullptr);
+            m_depthImage = VK_NULL_HANDLE;
+            m_memoryAllocator->free(m_depthAllocation);
             return false;
         }
 
@@ -477,6 +864,20 @@ namespace keplar
     }
 
     void VulkanSwapchain::transitionForRendering(VulkanCommandBuffer commandBuffer, uint32_t imageIndex) const noexcept
+    {
+        VulkanBarrierBatch barrierBatch;
+        transitionForRendering(barrierBatch, imageIndex);
+        commandBuffer.pipelineBarrier(barrierBatch);
+    }
+    
+    void VulkanSwapchain::transitionForPresentation(VulkanCommandBuffer commandBuffer, uint32_t imageIndex) const noexcept
+    {
+        VulkanBarrierBatch barrierBatch;
+        transitionForPresentation(barrierBatch, imageIndex);
+        commandBuffer.pipelineBarrier(barrierBatch);
+    }
+
+    void VulkanSwapchain::transitionForRendering(VulkanBarrierBatch& barrierBatch, uint32_t imageIndex) const noexcept
     {
         if (imageIndex >= m_imageCount)
         {
@@ -484,10 +885,14 @@ namespace keplar
             return;
         }
 
-        commandBuffer.transitionImageLayout(m_colorImages[imageIndex], VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        // chains onto the acquire semaphore the frame waits on at color output (offscreen images also order after the last copy-out)
+        const VkImageLayout presentLayout = getPresentLayout();
+        barrierBatch.imageBarrier(m_colorImages[imageIndex], presentLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+                                  VulkanBarrierBatch::getSrcScope(presentLayout).mStages | VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE,
+                                  VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
     }
-    
-    void VulkanSwapchain::transitionForPresentation(VulkanCommandBuffer commandBuffer, uint32_t imageIndex) const noexcept
+
+    void VulkanSwapchain::transitionForPresentation(VulkanBarrierBatch& barrierBatch, uint32_t imageIndex) const noexcept
     {
         if (imageIndex >= m_imageCount)
         {
@@ -495,10 +900,10 @@ namespace keplar
             return;
         }
 
-        commandBuffer.transitionImageLayout(m_colorImages[imageIndex], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        barrierBatch.imageTransition(m_colorImages[imageIndex], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, getPresentLayout());
     }
 
-    void VulkanSwapchain::destroyAttachments() noexcept
+    void VulkanSwapchain::destroyDepthAttachment() noexcept
     {
         // destroy depth image view
         if (m_depthImageView != VK_NULL_HANDLE)
@@ -515,24 +920,43 @@ namespace keplar
         }
 
         // free depth memory
-        if (m_depthMemory != VK_NULL_HANDLE)
+        if (m_memoryAllocator && m_depthAllocation.isValid())
         {
-            vkFreeMemory(m_vkDevice, m_depthMemory, nullptr);
-            m_depthMemory = VK_NULL_HANDLE;
+            m_memoryAllocator->free(m_depthAllocation);
         }
+    }
+
+    void VulkanSwapchain::destroyAttachments() noexcept
+    {
+        destroyDepthAttachment();
 
         // destroy color image view
-        for (size_t i = 0; i < m_imageCount; ++i)
+        for (auto& colorImageView : m_colorImageViews)
+        {
+            if (colorImageView != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(m_vkDevice, colorImageView, nullptr);
+                colorImageView = VK_NULL_HANDLE;
+            }
+        }
+
+        // offscreen color images are owned here (swapchain images are destroyed with the swapchain)
+        for (size_t i = 0; i < m_colorAllocations.size(); ++i)
         {
-            if (m_colorImageViews[i] != VK_NULL_HANDLE)
+            if (m_colorImages[i] != VK_NULL_HANDLE)
+            {
+                vkDestroyImage(m_vkDevice, m_colorImages[i], nullptr);
+            }
+
+            if (m_memoryAllocator && m_colorAllocations[i].isValid())
             {
-                vkDestroyImageView(m_vkDevice, m_colorImageViews[i], nullptr);
-                m_colorImageViews[i] = VK_NULL_HANDLE;
+                m_memoryAllocator->free(m_colorAllocations[i]);
             }
         }
 
         // clear vectors
         m_colorImages.clear();
         m_colorImageViews.clear();
+        m_colorAllocations.clear();
     }
 }   // namespace keplar
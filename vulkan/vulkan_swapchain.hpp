@@ -6,6 +6,7 @@
 
 #include <memory>
 #include "vulkan_config.hpp"
+#include "vulkan_memory_allocator.hpp"
 
 namespace keplar
 {
@@ -14,8 +15,44 @@ namespace keplar
     class VulkanSurface;
     class VulkanDevice;
     class VulkanCommandBuffer;
+    class VulkanBarrierBatch;
+    class VulkanDeletionQueue;
     struct QueueFamilyIndices;
 
+    // present mode preference: latency against power and tearing
+    enum class PresentPolicy : uint8_t 
+    { 
+        kBalanced,          // mailbox, fifo
+        kLowLatency,        // mailbox, immediate, fifo
+        kVSync,             // fifo
+        kPowerSaving        // fifo relaxed, fifo
+    };
+
+    // depth format preference: bandwidth against precision
+    enum class DepthPrecision : uint8_t
+    {
+        kCompact,           // d24 first: enough for standard depth over a bounded range; d16 only as a last resort
+        kFloat              // d32 float first: reverse-z keeps its precision only in floating point
+    };
+
+    // swapchain configuration applied on creation; present mode changes can apply in place (updatePolicy)
+    struct VulkanSwapchainPolicy
+    {
+        PresentPolicy  mPresentPolicy  = PresentPolicy::kBalanced;
+        uint32_t       mImageCount     = 0;     // 0: one above the surface minimum, clamped to the surface limits
+        DepthPrecision mDepthPrecision = DepthPrecision::kCompact;
+        bool           mPreRotation    = false;     // images in the display's native orientation, rotated by the renderer (getPreRotation)
+
+        // exclusive fullscreen on mMonitor (win32 HMONITOR of a window covering it, see Platform::getFullscreenMode):
+        // created application controlled and acquired right away where the device and monitor support it, else the
+        // swapchain is presented through the compositor as usual
+        bool           mFullScreenExclusive = false;
+        void*          mMonitor             = nullptr;
+    };
+
+    // presentation images of the surface. without a surface (headless platform) the same interface is backed by
+    // offscreen color images owned by this object: acquireOffscreenImage() replaces vkAcquireNextImageKHR and
+    // nothing is presented, so rendering code only differs in the semaphores it waits on and signals
     class VulkanSwapchain final 
     {
         public:
@@ -31,8 +68,39 @@ namespace keplar
 
             bool initialize(uint32_t width, uint32_t height) noexcept;
             bool recreate(uint32_t width, uint32_t height) noexcept;
+
+            // non-blocking recreate: the new swapchain is created with oldSwapchain and the previous swapchain, views
+            // and depth target are retired into the deletion queue instead of requiring the device to be idle
+            bool recreate(uint32_t width, uint32_t height, VulkanDeletionQueue& deletionQueue) noexcept;
             void destroy() noexcept;
 
+            // the swapchain supplies color only unless a renderer renders depth straight into its extent (no msaa target or
+            // render graph of its own): enabling creates the depth target of the current images, disabling releases it
+            // (neither waits on the device, callers flip it while no frame is in flight). later recreates keep the choice
+            bool setDepthAttachment(bool isEnabled) noexcept;
+            bool hasDepthAttachment() const noexcept                    { return m_isDepthAttachmentEnabled; }
+
+            // policy used by the next creation. returns true when the change took effect on the current swapchain
+            // (present mode switch among swapchain_maintenance1 compatible modes), false when it needs a recreate
+            bool updatePolicy(const VulkanSwapchainPolicy& policy) noexcept;
+            const VulkanSwapchainPolicy& getPolicy() const noexcept     { return m_policy; }
+
+            // present mode of the next vkQueuePresentKHR, chained when switching in place is possible
+            const void* chainPresentMode(const void* pNext) noexcept;
+            bool canSwitchPresentMode() const noexcept                  { return m_compatiblePresentModes.size() > 1; }
+
+            // offscreen mode: images are handed out round robin and never presented
+            uint32_t acquireOffscreenImage() noexcept;
+            bool isOffscreen() const noexcept                           { return m_isOffscreen; }
+
+            // created with VK_NV_low_latency2 latency mode: latency sleep and markers may target this swapchain
+            bool isLatencyModeEnabled() const noexcept                  { return m_isLatencyModeEnabled; }
+
+            // holds the display exclusively: flips bypass the compositor. acquire and present report
+            // VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT once the os took it back (focus change), recreating
+            // acquires it again
+            bool isFullScreenExclusive() const noexcept                 { return m_isFullScreenExclusiveAcquired; }
+
             // accessors
             VkSwapchainKHR                  get() const noexcept                   { return m_vkSwapchainKHR; }
             
@@ -43,24 +111,49 @@ namespace keplar
             uint32_t                        getImageCount() const noexcept         { return m_imageCount; }
             VkExtent2D                      getExtent() const noexcept             { return m_imageExtent; }
             VkFormat                        getColorFormat() const noexcept        { return m_vkSurfaceFormatKHR.format; }
-            VkFormat                        getDepthFormat() const noexcept        { return m_depthFormat; }
+            VkFormat                        getDepthFormat() const noexcept        { return m_depthFormat; }         // selected with or without a depth target
             VkColorSpaceKHR                 getColorSpace() const noexcept         { return m_vkSurfaceFormatKHR.colorSpace; }
             VkPresentModeKHR                getPresentMode() const noexcept        { return m_vkPresentModeKHR; }
+            VkSurfaceTransformFlagBitsKHR   getPreTransform() const noexcept       { return m_preTransform; }
+
+            // pre-rotation: degrees (0, 90, 180 or 270) the renderer rotates clip space by so the presentation engine
+            // scans the images out without a compositor rotation pass. getExtent() is then the native extent, with
+            // width and height swapped from the window's at 90 and 270; viewports and scissors cover it as usual
+            float getPreRotation() const noexcept;
+
+            // layout color images are left in at the end of a frame (offscreen images stay readable for copies)
+            VkImageLayout getPresentLayout() const noexcept 
+            { 
+                return m_isOffscreen ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; 
+            }
 
             // swapchain image layout transition helpers
             void transitionForRendering(VulkanCommandBuffer commandBuffer, uint32_t imageIndex) const noexcept;
             void transitionForPresentation(VulkanCommandBuffer commandBuffer, uint32_t imageIndex) const noexcept;
 
+            // same transitions added to a batch, recorded together with the frame's other attachment barriers
+            void transitionForRendering(VulkanBarrierBatch& barrierBatch, uint32_t imageIndex) const noexcept;
+            void transitionForPresentation(VulkanBarrierBatch& barrierBatch, uint32_t imageIndex) const noexcept;
+
         private:
             // initialization helpers
+            bool createResources(uint32_t width, uint32_t height, VkSwapchainKHR oldSwapchain) noexcept;
             bool chooseSurfaceFormat(const VulkanSurface& surface, const VulkanDevice& device) noexcept;
             bool choosePresentMode(const VulkanSurface& surface, const VulkanDevice& device) noexcept;
+            VkPresentModeKHR selectPresentMode(const std::vector<VkPresentModeKHR>& presentModes) const noexcept;
             void chooseImageCount(const VkSurfaceCapabilitiesKHR& surfaceCapabilities) noexcept;
             void chooseSwapExtent(const VkSurfaceCapabilitiesKHR& surfaceCapabilities, VkExtent2D windowExtent) noexcept;
             void choosePreTransform(const VkSurfaceCapabilitiesKHR& surfaceCapabilities) noexcept;
             bool createSwapchain(VkSurfaceKHR vkSurface, QueueFamilyIndices indices, VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE) noexcept;
+            void acquireFullScreenExclusive() noexcept;
+            void releaseFullScreenExclusive(VkSwapchainKHR swapchain) noexcept;
             bool createColorAttachment() noexcept;
+            bool createColorImageViews() noexcept;
+            bool createOffscreenResources(const VulkanDevice& device, uint32_t width, uint32_t height) noexcept;
+            bool createOffscreenImages() noexcept;
+            bool chooseDepthFormat(const VulkanDevice& device) noexcept;
             bool createDepthAttachment(const VulkanDevice& device) noexcept;
+            void destroyDepthAttachment() noexcept;
             void destroyAttachments() noexcept;
 
         private:
@@ -78,15 +171,34 @@ namespace keplar
             uint32_t                      m_imageCount;
             VkExtent2D                    m_imageExtent;
             VkSurfaceTransformFlagBitsKHR m_preTransform;
+            VulkanSwapchainPolicy         m_policy;
+            bool                          m_isLatencyModeEnabled;
+
+            // full_screen_exclusive: created application controlled, and currently holding the display
+            bool                          m_isFullScreenExclusive;
+            bool                          m_isFullScreenExclusiveAcquired;
+            PFN_vkVoidFunction            m_vkAcquireFullScreenExclusiveModeEXT;
+            PFN_vkVoidFunction            m_vkReleaseFullScreenExclusiveModeEXT;
+
+            // swapchain_maintenance1: modes the current swapchain was created to switch between
+            std::vector<VkPresentModeKHR> m_compatiblePresentModes;
+            VkSwapchainPresentModeInfoEXT m_presentModeInfo;
 
             // color attachments
             std::vector<VkImage>        m_colorImages;
             std::vector<VkImageView>    m_colorImageViews;
 
+            // offscreen mode: color images owned here instead of by a VkSwapchainKHR
+            bool                            m_isOffscreen;
+            std::vector<VulkanAllocation>   m_colorAllocations;
+            uint32_t                        m_nextOffscreenImage;
+
             // depth attachments
             VkImage                     m_depthImage;
-            VkDeviceMemory              m_depthMemory;
+            VulkanMemoryAllocator*      m_memoryAllocator;
+            VulkanAllocation            m_depthAllocation;
             VkImageView                 m_depthImageView;
             VkFormat                    m_depthFormat;
+            bool                        m_isDepthAttachmentEnabled;
     };
 }   // namespace keplar
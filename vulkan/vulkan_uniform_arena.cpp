@@ -0,0 +1,101 @@
+// ────────────────────────────────────────────
+//  File: vulkan_uniform_arena.cpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#include "vulkan/vulkan_uniform_arena.hpp"
+
+#include <limits>
+#include <cstring>
+#include <algorithm>
+
+#include "vulkan/vulkan_device.hpp"
+#include "utils/logger.hpp"
+
+namespace keplar
+{
+    VulkanUniformArena::VulkanUniformArena() noexcept
+        : m_alignment(1)
+        , m_frameSize(0)
+        , m_frameCount(0)
+        , m_frameBase(0)
+        , m_cursor(0)
+    {
+    }
+
+    bool VulkanUniformArena::initialize(const VulkanDevice& device, std::initializer_list<VkDeviceSize> blockSizes, uint32_t frameCount) noexcept
+    {
+        // the alignment is a power of two by the spec, so aligned blocks keep every frame region aligned too
+        m_alignment = std::max<VkDeviceSize>(1, device.getPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment);
+        m_frameSize = 0;
+        for (VkDeviceSize blockSize : blockSizes)
+        {
+            m_frameSize += alignBlock(blockSize);
+        }
+        m_frameCount = frameCount;
+
+        // dynamic offsets are 32-bit
+        const VkDeviceSize totalSize = m_frameSize * frameCount;
+        if (m_frameSize == 0 || frameCount == 0 || totalSize > std::numeric_limits<uint32_t>::max())
+        {
+            VK_LOG_ERROR("VulkanUniformArena::initialize failed: invalid frame size %llu or frame count %u", 
+                         static_cast<unsigned long long>(m_frameSize), frameCount);
+            return false;
+        }
+
+        VkBufferCreateInfo bufferCreateInfo{};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.pNext = nullptr;
+        bufferCreateInfo.flags = 0;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        bufferCreateInfo.size = totalSize;
+        if (!m_buffer.createHostVisible(device, bufferCreateInfo, nullptr, 0, true, true))
+        {
+            VK_LOG_ERROR("VulkanUniformArena::initialize failed to create the arena buffer");
+            return false;
+        }
+
+        m_frameBase = 0;
+        m_cursor = 0;
+        VK_LOG_DEBUG("VulkanUniformArena::initialize successful (%u frames of %llu bytes)", frameCount, static_cast<unsigned long long>(m_frameSize));
+        return true;
+    }
+
+    void VulkanUniformArena::destroy() noexcept
+    {
+        m_buffer = VulkanBuffer();
+        m_frameSize = 0;
+        m_frameCount = 0;
+        m_frameBase = 0;
+        m_cursor = 0;
+    }
+
+    bool VulkanUniformArena::beginFrame(uint32_t frameIndex) noexcept
+    {
+        // validate frame index
+        if (frameIndex >= m_frameCount)
+        {
+            VK_LOG_ERROR("VulkanUniformArena::beginFrame failed: frame index %u out of range (%u frames)", frameIndex, m_frameCount);
+            return false;
+        }
+
+        m_frameBase = m_frameSize * frameIndex;
+        m_cursor = 0;
+        return true;
+    }
+
+    bool VulkanUniformArena::push(const void* data, VkDeviceSize size, uint32_t& dynamicOffset) noexcept
+    {
+        // the frame region is sized up front, running past it would overwrite the next frame
+        const VkDeviceSize blockSize = alignBlock(size);
+        if (!isValid() || data == nullptr || m_cursor + blockSize > m_frameSize)
+        {
+            VK_LOG_ERROR_THROTTLED("VulkanUniformArena::push failed: %llu bytes do not fit the frame region", static_cast<unsigned long long>(size));
+            return false;
+        }
+
+        dynamicOffset = static_cast<uint32_t>(m_frameBase + m_cursor);
+        std::memcpy(static_cast<uint8_t*>(m_buffer.getMappedData()) + dynamicOffset, data, static_cast<size_t>(size));
+        m_cursor += blockSize;
+        return m_buffer.flush(dynamicOffset, size);
+    }
+}   // namespace keplar
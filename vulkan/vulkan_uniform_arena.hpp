@@ -0,0 +1,64 @@
+// ────────────────────────────────────────────
+//  File: vulkan_uniform_arena.hpp · Created by Yash Patel · 10-14-2026
+// ────────────────────────────────────────────
+
+#pragma once
+
+#include <initializer_list>
+
+#include "vulkan/vulkan_config.hpp"
+#include "vulkan/vulkan_buffer.hpp"
+
+namespace keplar
+{
+    // forward declarations
+    class VulkanDevice;
+
+    // per-frame uniform arena: one persistently mapped buffer, in resizable bar memory when the device exposes it,
+    // split into a region per frame in flight. blocks are sub-allocated linearly at minUniformBufferOffsetAlignment
+    // and read through UNIFORM_BUFFER_DYNAMIC descriptors written once with offset 0 and the block size as range; the
+    // dynamic offset push() returns selects both the frame region and the block. beginFrame() rewinds the frame's
+    // cursor, only once that frame's fence signaled
+    class VulkanUniformArena final
+    {
+        public:
+            // creation and destruction
+            VulkanUniformArena() noexcept;
+            ~VulkanUniformArena() = default;
+
+            // disable copy and move semantics to enforce unique ownership
+            VulkanUniformArena(const VulkanUniformArena&) = delete;
+            VulkanUniformArena& operator=(const VulkanUniformArena&) = delete;
+            VulkanUniformArena(VulkanUniformArena&&) = delete;
+            VulkanUniformArena& operator=(VulkanUniformArena&&) = delete;
+
+            // the frame region fits blockSizes, the blocks one frame pushes, each at its aligned size
+            bool initialize(const VulkanDevice& device, std::initializer_list<VkDeviceSize> blockSizes, uint32_t frameCount) noexcept;
+            void destroy() noexcept;
+
+            // usage: per frame
+            bool beginFrame(uint32_t frameIndex) noexcept;
+            bool push(const void* data, VkDeviceSize size, uint32_t& dynamicOffset) noexcept;
+
+            template <typename T>
+            bool push(const T& block, uint32_t& dynamicOffset) noexcept { return push(&block, sizeof(T), dynamicOffset); }
+
+            // block size rounded up to the dynamic offset alignment
+            VkDeviceSize alignBlock(VkDeviceSize size) const noexcept { return (size + m_alignment - 1) & ~(m_alignment - 1); }
+
+            // accessors
+            bool isValid() const noexcept { return m_buffer.getMappedData() != nullptr; }
+            VkBuffer getBuffer() const noexcept { return m_buffer.get(); }
+
+        private:
+            // persistently mapped host-visible storage of every frame region
+            VulkanBuffer    m_buffer;
+            VkDeviceSize    m_alignment;
+            VkDeviceSize    m_frameSize;
+            uint32_t        m_frameCount;
+
+            // linear cursor into the current frame region
+            VkDeviceSize    m_frameBase;
+            VkDeviceSize    m_cursor;
+    };
+}   // namespace keplar